@@ -0,0 +1,1060 @@
+//! Kernel benchmarks with roofline reporting
+//!
+//! Sweeps representative shapes and dtypes of every kernel family, contiguous and
+//! strided inputs, on one thread and on all threads:
+//!
+//! ```bash
+//! cargo bench -p hodu_cpu_kernels --bench kernels -- [FILTER...] [--quick] [--threads 1,8]
+//!     [--json results.json]
+//! ```
+//!
+//! The machine roofline is measured first: peak f32 FMA throughput and memory
+//! bandwidth (large multi-threaded copies) for every thread count. Each case then
+//! reports its median time, GFLOP/s, GB/s and the fraction of the roofline it
+//! reaches: `min(peak, intensity * bandwidth)` for kernels with a FLOP count,
+//! bandwidth alone for data movement. FLOPs are nominal (2*M*N*K for GEMM, one
+//! per element for elementwise ops and reductions) and bytes count every input
+//! read and output written once. The bandwidth is that of main memory, so cases
+//! whose working set stays in cache can exceed 100%.
+//!
+//! Filters match substrings of the case id (`family/kernel/dtype/layout/shape`).
+//! `--json` writes the machine roofline and every result, keyed by a stable
+//! `id` that includes the thread count, for diffing between releases.
+
+use core::ffi::c_void;
+use hodu_cpu_kernels::*;
+use std::fmt::Write as _;
+use std::hint::black_box;
+use std::time::{Duration, Instant};
+
+/// Minimum wall time of one sample; fast kernels repeat within a sample
+const SAMPLE_TIME: Duration = Duration::from_millis(10);
+/// Warm-up time before sampling (caches, page faults, thread pool start)
+const WARMUP_TIME: Duration = Duration::from_millis(50);
+/// Sampling stops early after this, once 3 samples exist
+const CASE_BUDGET: Duration = Duration::from_secs(3);
+
+struct Options {
+    filters: Vec<String>,
+    quick: bool,
+    threads: Vec<usize>,
+    json: Option<String>,
+}
+
+fn parse_options() -> Options {
+    let mut options = Options {
+        filters: Vec::new(),
+        quick: false,
+        threads: Vec::new(),
+        json: None,
+    };
+    let mut args = std::env::args().skip(1);
+    while let Some(arg) = args.next() {
+        match arg.as_str() {
+            // Passed by `cargo bench`
+            "--bench" => {},
+            "--quick" => options.quick = true,
+            "--json" => options.json = Some(args.next().expect("--json needs a path")),
+            "--threads" => {
+                let list = args.next().expect("--threads needs a list such as 1,8");
+                options.threads = list
+                    .split(',')
+                    .map(|t| t.trim().parse().expect("thread count"))
+                    .collect();
+            },
+            _ if arg.starts_with("--") => panic!("unknown option {}", arg),
+            _ => options.filters.push(arg),
+        }
+    }
+    if options.threads.is_empty() {
+        options.threads = vec![1, num_threads()];
+    }
+    options.threads.dedup();
+    options
+}
+
+// ============================================================================
+// MACHINE ROOFLINE
+// ============================================================================
+
+/// Peak f32 GFLOP/s and copy bandwidth (GB/s, read + write) for one thread count
+#[derive(Clone, Copy)]
+struct Roofline {
+    threads: usize,
+    peak_gflops: f64,
+    bandwidth_gbps: f64,
+}
+
+impl Roofline {
+    fn measure(threads: usize) -> Self {
+        Roofline {
+            threads,
+            peak_gflops: peak_gflops(threads),
+            bandwidth_gbps: bandwidth_gbps(threads),
+        }
+    }
+
+    /// Attainable GFLOP/s at `flops / bytes`
+    fn attainable_gflops(&self, flops: f64, bytes: f64) -> f64 {
+        if bytes == 0.0 {
+            return self.peak_gflops;
+        }
+        self.peak_gflops.min(flops / bytes * self.bandwidth_gbps)
+    }
+}
+
+/// Independent accumulator chains of the FMA loops, enough to cover FMA latency x ports
+const FMA_CHAINS: usize = 12;
+
+/// Runs `iters` rounds of FMA_CHAINS vector FMAs and returns the flops per round
+fn fma_loop(iters: usize) -> (f32, usize) {
+    #[cfg(target_arch = "x86_64")]
+    {
+        if std::arch::is_x86_feature_detected!("avx512f") {
+            return (unsafe { fma_avx512(iters) }, FMA_CHAINS * 16 * 2);
+        }
+        if std::arch::is_x86_feature_detected!("avx2") && std::arch::is_x86_feature_detected!("fma") {
+            return (unsafe { fma_avx2(iters) }, FMA_CHAINS * 8 * 2);
+        }
+    }
+    #[cfg(target_arch = "aarch64")]
+    {
+        return (unsafe { fma_neon(iters) }, FMA_CHAINS * 4 * 2);
+    }
+    #[allow(unreachable_code)]
+    (fma_scalar(iters), FMA_CHAINS * 2)
+}
+
+#[cfg(target_arch = "x86_64")]
+#[target_feature(enable = "avx512f")]
+unsafe fn fma_avx512(iters: usize) -> f32 {
+    use std::arch::x86_64::*;
+    let mut acc = [_mm512_set1_ps(0.0); FMA_CHAINS];
+    let a = _mm512_set1_ps(black_box(0.999_999));
+    let b = _mm512_set1_ps(black_box(1e-7));
+    for _ in 0..iters {
+        for v in acc.iter_mut() {
+            *v = _mm512_fmadd_ps(*v, a, b);
+        }
+    }
+    acc.iter().map(|&v| _mm512_reduce_add_ps(v)).sum()
+}
+
+#[cfg(target_arch = "x86_64")]
+#[target_feature(enable = "avx2,fma")]
+unsafe fn fma_avx2(iters: usize) -> f32 {
+    use std::arch::x86_64::*;
+    let mut acc = [_mm256_set1_ps(0.0); FMA_CHAINS];
+    let a = _mm256_set1_ps(black_box(0.999_999));
+    let b = _mm256_set1_ps(black_box(1e-7));
+    for _ in 0..iters {
+        for v in acc.iter_mut() {
+            *v = _mm256_fmadd_ps(*v, a, b);
+        }
+    }
+    let mut lanes = [0.0f32; 8];
+    let mut sum = 0.0;
+    for v in acc {
+        _mm256_storeu_ps(lanes.as_mut_ptr(), v);
+        sum += lanes.iter().sum::<f32>();
+    }
+    sum
+}
+
+#[cfg(target_arch = "aarch64")]
+unsafe fn fma_neon(iters: usize) -> f32 {
+    use std::arch::aarch64::*;
+    let mut acc = [vdupq_n_f32(0.0); FMA_CHAINS];
+    let a = vdupq_n_f32(black_box(0.999_999));
+    let b = vdupq_n_f32(black_box(1e-7));
+    for _ in 0..iters {
+        for v in acc.iter_mut() {
+            *v = vfmaq_f32(b, *v, a);
+        }
+    }
+    acc.iter().map(|&v| vaddvq_f32(v)).sum()
+}
+
+#[allow(dead_code)]
+fn fma_scalar(iters: usize) -> f32 {
+    let mut acc = [0.0f32; FMA_CHAINS];
+    let (a, b) = (black_box(0.999_999f32), black_box(1e-7f32));
+    for _ in 0..iters {
+        for v in acc.iter_mut() {
+            *v = v.mul_add(a, b);
+        }
+    }
+    acc.iter().sum()
+}
+
+/// Best of 5 runs of `f` on `threads` OS threads at once, in seconds
+fn best_parallel_time(threads: usize, f: impl Fn(usize) + Sync) -> f64 {
+    (0..5)
+        .map(|_| {
+            let start = Instant::now();
+            std::thread::scope(|s| {
+                for t in 0..threads {
+                    let f = &f;
+                    s.spawn(move || f(t));
+                }
+            });
+            start.elapsed().as_secs_f64()
+        })
+        .fold(f64::INFINITY, f64::min)
+}
+
+fn peak_gflops(threads: usize) -> f64 {
+    const ITERS: usize = 20_000_000;
+    let flops_per_iter = fma_loop(1).1;
+    let seconds = best_parallel_time(threads, |_| {
+        black_box(fma_loop(black_box(ITERS)));
+    });
+    (threads * ITERS * flops_per_iter) as f64 / seconds * 1e-9
+}
+
+fn bandwidth_gbps(threads: usize) -> f64 {
+    // Source and destination of 512 MiB each, beyond the last-level cache
+    const BYTES: usize = 512 << 20;
+    let chunk = BYTES / 8 / threads;
+    let src: Vec<Vec<u64>> = (0..threads).map(|_| vec![1u64; chunk]).collect();
+    let dst: Vec<std::sync::Mutex<Vec<u64>>> = (0..threads).map(|_| std::sync::Mutex::new(vec![0u64; chunk])).collect();
+    let seconds = best_parallel_time(threads, |t| {
+        dst[t].lock().unwrap().copy_from_slice(&src[t]);
+    });
+    (2 * chunk * 8 * threads) as f64 / seconds * 1e-9
+}
+
+// ============================================================================
+// CASES
+// ============================================================================
+
+type Runner = Box<dyn FnMut()>;
+
+/// One benchmark: what it runs, its nominal work and how to set it up
+struct Case {
+    family: &'static str,
+    kernel: String,
+    dtype: &'static str,
+    layout: &'static str,
+    shape: String,
+    flops: f64,
+    bytes: f64,
+    /// Allocates the buffers and returns the timed closure (run once per iteration)
+    setup: Box<dyn Fn() -> Runner>,
+}
+
+impl Case {
+    fn id(&self) -> String {
+        format!(
+            "{}/{}/{}/{}/{}",
+            self.family, self.kernel, self.dtype, self.layout, self.shape
+        )
+    }
+}
+
+/// Element size in bytes of a dtype suffix
+fn dtype_size(dtype: &str) -> usize {
+    match dtype {
+        "bool" | "u8" | "i8" | "f8e4m3" | "f8e5m2" => 1,
+        "bf16" | "f16" | "u16" | "i16" => 2,
+        "f32" | "u32" | "i32" => 4,
+        _ => 8,
+    }
+}
+
+fn kernel(op: &str, dtype: &str) -> Kernel {
+    Kernel(Box::leak(format!("hodu_cpu_{}_{}", op, dtype).into_boxed_str()))
+}
+
+/// 8-byte aligned buffer of `len` elements of `dtype`, filled with values in about [-1, 1]
+/// (integers in [0, 100))
+struct Buffer(Vec<u64>);
+
+impl Buffer {
+    fn new(dtype: &str, len: usize) -> Self {
+        let mut buf = Buffer(vec![0u64; (len * dtype_size(dtype)).div_ceil(8)]);
+        let mut state = 0x9e37_79b9_7f4a_7c15u64 ^ len as u64;
+        let mut next = move || {
+            state ^= state << 13;
+            state ^= state >> 7;
+            state ^= state << 17;
+            state
+        };
+        let bytes = unsafe { std::slice::from_raw_parts_mut(buf.0.as_mut_ptr() as *mut u8, len * dtype_size(dtype)) };
+        for i in 0..len {
+            let r = next();
+            let unit = (r >> 40) as f32 / (1u64 << 23) as f32 - 1.0;
+            match dtype {
+                "f32" => bytes[i * 4..i * 4 + 4].copy_from_slice(&unit.to_le_bytes()),
+                "f64" => bytes[i * 8..i * 8 + 8].copy_from_slice(&(unit as f64).to_le_bytes()),
+                // Truncated f32 bits
+                "bf16" => bytes[i * 2..i * 2 + 2].copy_from_slice(&((unit.to_bits() >> 16) as u16).to_le_bytes()),
+                // Sign, exponent 12..14 and a random mantissa: magnitudes in [2^-3, 1)
+                "f16" => {
+                    let bits = ((r >> 48) as u16 & 0x8000) | (0x3000 + (r % 0x0c00) as u16);
+                    bytes[i * 2..i * 2 + 2].copy_from_slice(&bits.to_le_bytes());
+                },
+                "i32" => bytes[i * 4..i * 4 + 4].copy_from_slice(&((r % 100) as i32).to_le_bytes()),
+                "i64" => bytes[i * 8..i * 8 + 8].copy_from_slice(&((r % 100) as i64).to_le_bytes()),
+                _ => {
+                    let size = dtype_size(dtype);
+                    bytes[i * size] = (r % 100) as u8;
+                },
+            }
+        }
+        buf
+    }
+
+    fn zeroed(dtype: &str, len: usize) -> Self {
+        Buffer(vec![0u64; (len * dtype_size(dtype)).div_ceil(8)])
+    }
+
+    fn ptr(&self) -> *const c_void {
+        self.0.as_ptr() as *const c_void
+    }
+
+    fn mut_ptr(&mut self) -> *mut c_void {
+        self.0.as_mut_ptr() as *mut c_void
+    }
+}
+
+fn contiguous_strides(shape: &[usize]) -> Vec<usize> {
+    let mut strides = vec![1; shape.len()];
+    for i in (0..shape.len().saturating_sub(1)).rev() {
+        strides[i] = strides[i + 1] * shape[i + 1];
+    }
+    strides
+}
+
+/// Strides of a 2D view that reads a row-major `[cols, rows]` buffer transposed
+fn transposed_strides(shape: &[usize]) -> Vec<usize> {
+    vec![1, shape[0]]
+}
+
+fn view_strides(shape: &[usize], layout: &str) -> Vec<usize> {
+    match layout {
+        "strided" => transposed_strides(shape),
+        _ => contiguous_strides(shape),
+    }
+}
+
+/// `[num_els, num_dims, shape.., strides.., offset]` of unary, cast, scan and norm kernels
+fn layout_metadata(shape: &[usize], strides: &[usize]) -> Vec<usize> {
+    let mut metadata = vec![shape.iter().product(), shape.len()];
+    metadata.extend(shape);
+    metadata.extend(strides);
+    metadata.push(0);
+    metadata
+}
+
+fn shape_str(shape: &[usize]) -> String {
+    shape.iter().map(|d| d.to_string()).collect::<Vec<_>>().join("x")
+}
+
+const LAYOUTS: [&str; 2] = ["contiguous", "strided"];
+
+fn unary_cases(cases: &mut Vec<Case>) {
+    let shape = [2048usize, 2048];
+    let n = (shape[0] * shape[1]) as f64;
+    for (op, dtypes) in [
+        ("relu", &["f32", "bf16", "f16"][..]),
+        ("exp", &["f32", "bf16", "f16"][..]),
+        ("gelu", &["f32"][..]),
+        ("neg", &["i32"][..]),
+    ] {
+        for &dtype in dtypes {
+            for layout in LAYOUTS {
+                let size = dtype_size(dtype) as f64;
+                cases.push(Case {
+                    family: "unary",
+                    kernel: op.to_string(),
+                    dtype,
+                    layout,
+                    shape: shape_str(&shape),
+                    flops: n,
+                    bytes: 2.0 * n * size,
+                    setup: Box::new(move || {
+                        let input = Buffer::new(dtype, shape[0] * shape[1]);
+                        let mut output = Buffer::zeroed(dtype, shape[0] * shape[1]);
+                        let metadata = layout_metadata(&shape, &view_strides(&shape, layout));
+                        let kernel = kernel(op, dtype);
+                        Box::new(move || call_ops_unary(kernel, input.ptr(), output.mut_ptr(), &metadata).unwrap())
+                    }),
+                });
+            }
+        }
+    }
+}
+
+fn binary_cases(cases: &mut Vec<Case>) {
+    let shape = [2048usize, 2048];
+    let n = shape[0] * shape[1];
+    // (layout, rhs shape): same shape, a broadcast row, or a transposed lhs
+    for (layout, rhs_shape) in [("contiguous", shape), ("broadcast", [1, shape[1]]), ("strided", shape)] {
+        for (op, dtype) in [
+            ("add", "f32"),
+            ("mul", "f32"),
+            ("add", "bf16"),
+            ("add", "f16"),
+            ("add", "i32"),
+        ] {
+            if layout != "contiguous" && dtype != "f32" {
+                continue;
+            }
+            let size = dtype_size(dtype) as f64;
+            let rhs_len = rhs_shape[0] * rhs_shape[1];
+            cases.push(Case {
+                family: "binary",
+                kernel: op.to_string(),
+                dtype,
+                layout,
+                shape: format!("{}+{}", shape_str(&shape), shape_str(&rhs_shape)),
+                flops: n as f64,
+                bytes: (2 * n + rhs_len) as f64 * size,
+                setup: Box::new(move || {
+                    let lhs = Buffer::new(dtype, n);
+                    let rhs = Buffer::new(dtype, rhs_len);
+                    let mut output = Buffer::zeroed(dtype, n);
+                    let lhs_strides = if layout == "strided" {
+                        transposed_strides(&shape)
+                    } else {
+                        contiguous_strides(&shape)
+                    };
+                    let mut rhs_strides = contiguous_strides(&rhs_shape);
+                    if rhs_shape[0] == 1 {
+                        rhs_strides[0] = 0;
+                    }
+                    let mut metadata = vec![n, 2];
+                    metadata.extend(shape);
+                    metadata.extend(shape);
+                    metadata.extend(&lhs_strides);
+                    metadata.extend(&rhs_strides);
+                    metadata.extend([0, 0]);
+                    let kernel = kernel(op, dtype);
+                    Box::new(move || {
+                        call_ops_binary(kernel, lhs.ptr(), rhs.ptr(), output.mut_ptr(), &metadata).unwrap()
+                    })
+                }),
+            });
+        }
+    }
+}
+
+fn cast_cases(cases: &mut Vec<Case>) {
+    let shape = [2048usize, 2048];
+    let n = shape[0] * shape[1];
+    for (from, to) in [
+        ("f32", "f16"),
+        ("f32", "bf16"),
+        ("f16", "f32"),
+        ("f32", "i32"),
+        ("u8", "f32"),
+    ] {
+        for layout in LAYOUTS {
+            if layout == "strided" && from != "f32" {
+                continue;
+            }
+            cases.push(Case {
+                family: "cast",
+                kernel: format!("cast_to_{}", to),
+                dtype: from,
+                layout,
+                shape: shape_str(&shape),
+                flops: 0.0,
+                bytes: (n * (dtype_size(from) + dtype_size(to))) as f64,
+                setup: Box::new(move || {
+                    let input = Buffer::new(from, n);
+                    let mut output = Buffer::zeroed(to, n);
+                    let metadata = layout_metadata(&shape, &view_strides(&shape, layout));
+                    let kernel = CastKernel(Box::leak(format!("hodu_cpu_cast_{}_to_{}", from, to).into_boxed_str()));
+                    Box::new(move || call_ops_cast(kernel, input.ptr(), output.mut_ptr(), &metadata).unwrap())
+                }),
+            });
+        }
+    }
+}
+
+fn reduce_cases(cases: &mut Vec<Case>) {
+    let shape = [4096usize, 1024];
+    let n = shape[0] * shape[1];
+    let mut push = |op: &'static str, dtype: &'static str, layout: &'static str, dims: &'static [usize]| {
+        let out_shape: Vec<usize> = (0..2).map(|d| if dims.contains(&d) { 1 } else { shape[d] }).collect();
+        let out_len: usize = out_shape.iter().product();
+        let out_dtype = if op == "argmax" { "i32" } else { dtype };
+        cases.push(Case {
+            family: "reduce",
+            kernel: op.to_string(),
+            dtype,
+            layout,
+            shape: format!("{}/dims{:?}", shape_str(&shape), dims).replace(' ', ""),
+            flops: n as f64,
+            bytes: (n * dtype_size(dtype) + out_len * dtype_size(out_dtype)) as f64,
+            setup: Box::new(move || {
+                let input = Buffer::new(dtype, n);
+                let mut output = Buffer::zeroed(out_dtype, out_len);
+                let mut metadata = vec![2];
+                metadata.extend(shape);
+                metadata.extend(view_strides(&shape, layout));
+                metadata.push(0);
+                metadata.push(2);
+                metadata.extend(&out_shape);
+                metadata.push(dims.len());
+                metadata.extend(dims);
+                metadata.push(1);
+                metadata.push(n / out_len);
+                let kernel = kernel(op, dtype);
+                Box::new(move || call_ops_reduce(kernel, input.ptr(), output.mut_ptr(), &metadata).unwrap())
+            }),
+        });
+    };
+    for dims in [&[1usize][..], &[0][..], &[0, 1][..]] {
+        push("sum", "f32", "contiguous", dims);
+    }
+    push("sum", "f32", "strided", &[1]);
+    push("max", "f32", "contiguous", &[1]);
+    push("var", "f32", "contiguous", &[1]);
+    push("argmax", "f32", "contiguous", &[1]);
+    push("sum", "f16", "contiguous", &[1]);
+    push("sum", "f64", "contiguous", &[1]);
+    push("sum", "i32", "contiguous", &[1]);
+}
+
+/// `(m, k, n)` GEMM shapes: square, decode GEMV and a projection with few rows
+const MATMUL_SHAPES: [(usize, usize, usize); 5] = [
+    (256, 256, 256),
+    (1024, 1024, 1024),
+    (2048, 2048, 2048),
+    (1, 4096, 4096),
+    (64, 4096, 4096),
+];
+
+fn matmul_cases(cases: &mut Vec<Case>, quick: bool) {
+    for (m, k, n) in MATMUL_SHAPES {
+        for (dtype, layout) in [
+            ("f32", "contiguous"),
+            ("f32", "strided"),
+            ("f64", "contiguous"),
+            ("bf16", "contiguous"),
+        ] {
+            // Large shapes in f32 only; --quick skips the largest square
+            if (dtype != "f32" && m != 1024) || (quick && m == 2048) || (layout == "strided" && m == 1) {
+                continue;
+            }
+            let size = dtype_size(dtype) as f64;
+            cases.push(Case {
+                family: "matrix",
+                kernel: "matmul".to_string(),
+                dtype,
+                layout,
+                shape: format!("{}x{}x{}", m, k, n),
+                flops: 2.0 * (m * k * n) as f64,
+                bytes: (m * k + k * n + m * n) as f64 * size,
+                setup: Box::new(move || {
+                    let lhs = Buffer::new(dtype, m * k);
+                    let rhs = Buffer::new(dtype, k * n);
+                    let mut output = Buffer::zeroed(dtype, m * n);
+                    // The strided case reads a transposed [n, k] weight
+                    let rhs_strides = if layout == "strided" { [1, k] } else { [n, 1] };
+                    let mut metadata = vec![m * n, 2, 2, 0, m, k, k, n, k, 1];
+                    metadata.extend(rhs_strides);
+                    metadata.extend([0, 0, m, k, n]);
+                    let kernel = kernel("matmul", dtype);
+                    Box::new(move || {
+                        call_ops_matmul(kernel, lhs.ptr(), rhs.ptr(), output.mut_ptr(), &metadata).unwrap()
+                    })
+                }),
+            });
+        }
+    }
+}
+
+fn conv_cases(cases: &mut Vec<Case>) {
+    // (name, batch, in_c, out_c, size, kernel, stride, padding): ResNet-style layers
+    let layers = [
+        ("stem7x7s2", 1, 3, 64, 224, 7, 2, 3),
+        ("3x3", 1, 64, 64, 56, 3, 1, 1),
+        ("3x3s2", 1, 128, 128, 56, 3, 2, 1),
+        ("1x1", 1, 256, 64, 56, 1, 1, 0),
+        ("3x3b8", 8, 64, 64, 28, 3, 1, 1),
+    ];
+    for (name, batch, ic, oc, size, ks, stride, pad) in layers {
+        for (op, dtype) in [("conv2d", "f32"), ("conv2d_nhwc", "f32"), ("conv2d", "f64")] {
+            if dtype == "f64" && name != "3x3" {
+                continue;
+            }
+            let out = (size + 2 * pad - ks) / stride + 1;
+            let in_len = batch * ic * size * size;
+            let w_len = oc * ic * ks * ks;
+            let out_len = batch * oc * out * out;
+            cases.push(Case {
+                family: "conv",
+                kernel: op.to_string(),
+                dtype,
+                layout: if op == "conv2d" { "nchw" } else { "nhwc" },
+                shape: format!("{}/{}x{}x{}x{}->{}", name, batch, ic, size, size, oc),
+                flops: 2.0 * (out_len * ic * ks * ks) as f64,
+                bytes: ((in_len + w_len + out_len) * dtype_size(dtype)) as f64,
+                setup: Box::new(move || {
+                    let input = Buffer::new(dtype, in_len);
+                    let weight = Buffer::new(dtype, w_len);
+                    let mut output = Buffer::zeroed(dtype, out_len);
+                    let metadata = vec![
+                        out_len, batch, ic, oc, size, size, ks, ks, out, out, stride, stride, pad, pad, 1, 1, 0, 0,
+                    ];
+                    let kernel = kernel(op, dtype);
+                    Box::new(move || {
+                        call_ops_conv(kernel, input.ptr(), weight.ptr(), output.mut_ptr(), &metadata).unwrap()
+                    })
+                }),
+            });
+        }
+    }
+}
+
+fn norm_cases(cases: &mut Vec<Case>) {
+    let shape = [4096usize, 1024];
+    let n = shape[0] * shape[1];
+    for (op, dtype) in [
+        ("softmax", "f32"),
+        ("softmax", "bf16"),
+        ("layer_norm", "f32"),
+        ("rms_norm", "f32"),
+    ] {
+        for layout in LAYOUTS {
+            if layout == "strided" && dtype != "f32" {
+                continue;
+            }
+            cases.push(Case {
+                family: "norm",
+                kernel: op.to_string(),
+                dtype,
+                layout,
+                shape: shape_str(&shape),
+                // Nominal: max or mean, the sum and the normalization
+                flops: 3.0 * n as f64,
+                bytes: (2 * n * dtype_size(dtype)) as f64,
+                setup: Box::new(move || {
+                    let input = Buffer::new(dtype, n);
+                    let weight = Buffer::new(dtype, shape[1]);
+                    let mut output = Buffer::zeroed(dtype, n);
+                    let mut metadata = layout_metadata(&shape, &view_strides(&shape, layout));
+                    metadata.push(1);
+                    let kernel = kernel(op, dtype);
+                    Box::new(move || {
+                        let (input, output) = (input.ptr(), output.mut_ptr());
+                        match op {
+                            "softmax" => call_ops_softmax(kernel, input, output, &metadata),
+                            "layer_norm" => {
+                                call_ops_layer_norm(kernel, input, weight.ptr(), weight.ptr(), output, &metadata, 1e-5)
+                            },
+                            _ => call_ops_rms_norm(kernel, input, weight.ptr(), output, &metadata, 1e-5),
+                        }
+                        .unwrap()
+                    })
+                }),
+            });
+        }
+    }
+}
+
+fn attention_cases(cases: &mut Vec<Case>) {
+    // Prefill: (batch, heads, kv_heads, seq, head_dim, causal)
+    for (batch, heads, kv_heads, seq, dim, causal) in [(1, 16, 16, 512, 64, 1), (1, 32, 8, 1024, 128, 1)] {
+        for dtype in ["f32", "bf16"] {
+            let q_len = batch * heads * seq * dim;
+            let kv_len = batch * kv_heads * seq * dim;
+            let pairs = if causal == 1 { seq * (seq + 1) / 2 } else { seq * seq };
+            cases.push(Case {
+                family: "attention",
+                kernel: "attention".to_string(),
+                dtype,
+                layout: "contiguous",
+                shape: format!(
+                    "b{}h{}kv{}s{}d{}{}",
+                    batch,
+                    heads,
+                    kv_heads,
+                    seq,
+                    dim,
+                    if causal == 1 { "c" } else { "" }
+                ),
+                // QK^T and PV over the visible pairs
+                flops: 4.0 * (batch * heads * pairs * dim) as f64,
+                bytes: ((2 * q_len + 2 * kv_len) * dtype_size(dtype)) as f64,
+                setup: Box::new(move || {
+                    let q = Buffer::new(dtype, q_len);
+                    let k = Buffer::new(dtype, kv_len);
+                    let v = Buffer::new(dtype, kv_len);
+                    let mut output = Buffer::zeroed(dtype, q_len);
+                    let mut metadata = vec![batch, heads, kv_heads, seq, seq, dim];
+                    metadata.extend(contiguous_strides(&[batch, heads, seq, dim]));
+                    metadata.extend(contiguous_strides(&[batch, kv_heads, seq, dim]));
+                    metadata.extend(contiguous_strides(&[batch, kv_heads, seq, dim]));
+                    metadata.extend([0, 0, 0, causal, 0]);
+                    let kernel = kernel("attention", dtype);
+                    let scale = 1.0 / (dim as f32).sqrt();
+                    Box::new(move || {
+                        call_ops_attention(kernel, q.ptr(), k.ptr(), v.ptr(), output.mut_ptr(), &metadata, scale)
+                            .unwrap()
+                    })
+                }),
+            });
+        }
+    }
+
+    // Decode: (batch, heads, kv_heads, cache length, head_dim)
+    for (batch, heads, kv_heads, len, dim) in [(1, 32, 8, 4096, 128), (8, 16, 16, 1024, 64)] {
+        let dtype = "f32";
+        let q_len = batch * heads * dim;
+        let cache_len = batch * kv_heads * len * dim;
+        cases.push(Case {
+            family: "attention",
+            kernel: "attention_decode".to_string(),
+            dtype,
+            layout: "contiguous",
+            shape: format!("b{}h{}kv{}len{}d{}", batch, heads, kv_heads, len, dim),
+            flops: 4.0 * (batch * heads * len * dim) as f64,
+            bytes: ((2 * q_len + 2 * cache_len) * dtype_size(dtype)) as f64,
+            setup: Box::new(move || {
+                let q = Buffer::new(dtype, q_len);
+                let k = Buffer::new(dtype, cache_len);
+                let v = Buffer::new(dtype, cache_len);
+                let mut output = Buffer::zeroed(dtype, q_len);
+                let mut metadata = vec![batch, heads, kv_heads, dim, len];
+                metadata.extend(std::iter::repeat(len).take(batch));
+                let kernel = kernel("attention_decode", dtype);
+                let scale = 1.0 / (dim as f32).sqrt();
+                Box::new(move || {
+                    call_ops_attention_decode(kernel, q.ptr(), k.ptr(), v.ptr(), output.mut_ptr(), &metadata, scale)
+                        .unwrap()
+                })
+            }),
+        });
+    }
+}
+
+fn memory_cases(cases: &mut Vec<Case>) {
+    let shape = [4096usize, 4096];
+    let n = shape[0] * shape[1];
+    for dtype in ["f32", "f16", "u8"] {
+        for layout in LAYOUTS {
+            cases.push(Case {
+                family: "memory",
+                kernel: "contiguous".to_string(),
+                dtype,
+                layout,
+                shape: shape_str(&shape),
+                flops: 0.0,
+                bytes: (2 * n * dtype_size(dtype)) as f64,
+                setup: Box::new(move || {
+                    let input = Buffer::new(dtype, n);
+                    let mut output = Buffer::zeroed(dtype, n);
+                    let metadata = layout_metadata(&shape, &view_strides(&shape, layout));
+                    let kernel = kernel("contiguous", dtype);
+                    Box::new(move || call_ops_contiguous(kernel, input.ptr(), output.mut_ptr(), &metadata).unwrap())
+                }),
+            });
+        }
+    }
+}
+
+fn indexing_cases(cases: &mut Vec<Case>) {
+    // Embedding lookup: rows of a [vocab, hidden] table
+    let (vocab, hidden, tokens) = (32000usize, 1024usize, 4096usize);
+    for dtype in ["f32", "bf16"] {
+        cases.push(Case {
+            family: "indexing",
+            kernel: "index_select".to_string(),
+            dtype,
+            layout: "contiguous",
+            shape: format!("{}x{}[{}]", vocab, hidden, tokens),
+            flops: 0.0,
+            bytes: (2 * tokens * hidden * dtype_size(dtype) + tokens * 4) as f64,
+            setup: Box::new(move || {
+                let input = Buffer::new(dtype, vocab * hidden);
+                let indices: Vec<i32> = (0..tokens).map(|i| ((i * 7919) % vocab) as i32).collect();
+                let mut output = Buffer::zeroed(dtype, tokens * hidden);
+                let mut metadata = layout_metadata(&[vocab, hidden], &[hidden, 1]);
+                metadata[0] = tokens * hidden;
+                metadata.extend([0, tokens]);
+                let kernel = kernel("index_select", dtype);
+                Box::new(move || {
+                    call_ops_index_select(kernel, input.ptr(), indices.as_ptr(), output.mut_ptr(), &metadata).unwrap()
+                })
+            }),
+        });
+    }
+}
+
+fn scan_sort_cases(cases: &mut Vec<Case>) {
+    let shape = [1024usize, 4096];
+    let n = shape[0] * shape[1];
+    for layout in LAYOUTS {
+        cases.push(Case {
+            family: "scan",
+            kernel: "cumsum".to_string(),
+            dtype: "f32",
+            layout,
+            shape: shape_str(&shape),
+            flops: n as f64,
+            bytes: (2 * n * 4) as f64,
+            setup: Box::new(move || {
+                let input = Buffer::new("f32", n);
+                let mut output = Buffer::zeroed("f32", n);
+                let mut metadata = layout_metadata(&shape, &view_strides(&shape, layout));
+                metadata.push(1);
+                Box::new(move || call_ops_cumsum(cumsum::F32, input.ptr(), output.mut_ptr(), &metadata).unwrap())
+            }),
+        });
+    }
+
+    let shape = [1024usize, 1024];
+    let n = shape[0] * shape[1];
+    for dtype in ["f32", "i32"] {
+        cases.push(Case {
+            family: "sort",
+            kernel: "argsort".to_string(),
+            dtype,
+            layout: "contiguous",
+            shape: shape_str(&shape),
+            flops: 0.0,
+            bytes: (n * (dtype_size(dtype) + 4)) as f64,
+            setup: Box::new(move || {
+                let input = Buffer::new(dtype, n);
+                let mut indices = Buffer::zeroed("i32", n);
+                let mut metadata = layout_metadata(&shape, &contiguous_strides(&shape));
+                metadata.extend([1, 0]);
+                let kernel = kernel("argsort", dtype);
+                Box::new(move || call_argsort(kernel, input.ptr(), indices.mut_ptr(), &metadata).unwrap())
+            }),
+        });
+    }
+}
+
+fn pooling_cases(cases: &mut Vec<Case>) {
+    // 3x3 stride-2 max pooling and global average pooling over NCHW
+    let shape = [1usize, 64, 112, 112];
+    for (op, window, stride, pad) in [("reduce_window_max", 3, 2, 1), ("reduce_window_mean", 112, 1, 0)] {
+        let out = (shape[2] + 2 * pad - window) / stride + 1;
+        let out_shape = [shape[0], shape[1], out, out];
+        let in_len: usize = shape.iter().product();
+        let out_len: usize = out_shape.iter().product();
+        cases.push(Case {
+            family: "pooling",
+            kernel: op.to_string(),
+            dtype: "f32",
+            layout: "nchw",
+            shape: format!("{}/{}x{}s{}", shape_str(&shape), window, window, stride),
+            flops: (out_len * window * window) as f64,
+            bytes: ((in_len + out_len) * 4) as f64,
+            setup: Box::new(move || {
+                let input = Buffer::new("f32", in_len);
+                let mut output = Buffer::zeroed("f32", out_len);
+                let mut metadata = layout_metadata(&shape, &contiguous_strides(&shape));
+                metadata[0] = out_len;
+                metadata.extend([1, 1, window, window]);
+                metadata.extend([1, 1, stride, stride]);
+                metadata.extend([0, 0, 0, 0, pad, pad, pad, pad]);
+                metadata.extend(out_shape);
+                let kernel = kernel(op, "f32");
+                Box::new(move || call_ops_reduce_window(kernel, input.ptr(), output.mut_ptr(), &metadata).unwrap())
+            }),
+        });
+    }
+}
+
+fn all_cases(quick: bool) -> Vec<Case> {
+    let mut cases = Vec::new();
+    unary_cases(&mut cases);
+    binary_cases(&mut cases);
+    cast_cases(&mut cases);
+    reduce_cases(&mut cases);
+    matmul_cases(&mut cases, quick);
+    conv_cases(&mut cases);
+    norm_cases(&mut cases);
+    attention_cases(&mut cases);
+    memory_cases(&mut cases);
+    indexing_cases(&mut cases);
+    scan_sort_cases(&mut cases);
+    pooling_cases(&mut cases);
+    cases
+}
+
+// ============================================================================
+// MEASUREMENT AND REPORTING
+// ============================================================================
+
+struct Stats {
+    median: f64,
+    min: f64,
+    samples: usize,
+    iters: usize,
+}
+
+/// Per-iteration seconds of `run`: warm up, pick iterations per sample, take samples
+fn measure(run: &mut Runner, quick: bool) -> Stats {
+    let start = Instant::now();
+    let mut warmup_iters = 0usize;
+    while warmup_iters == 0 || start.elapsed() < WARMUP_TIME {
+        run();
+        warmup_iters += 1;
+    }
+    let estimate = start.elapsed().as_secs_f64() / warmup_iters as f64;
+    let iters = ((SAMPLE_TIME.as_secs_f64() / estimate) as usize).max(1);
+
+    let target = if quick { 5 } else { 15 };
+    let mut times = Vec::with_capacity(target);
+    let sampling = Instant::now();
+    while times.len() < target && (times.len() < 3 || sampling.elapsed() < CASE_BUDGET) {
+        let sample = Instant::now();
+        for _ in 0..iters {
+            run();
+        }
+        times.push(sample.elapsed().as_secs_f64() / iters as f64);
+    }
+    times.sort_by(f64::total_cmp);
+    Stats {
+        median: times[times.len() / 2],
+        min: times[0],
+        samples: times.len(),
+        iters,
+    }
+}
+
+struct Measurement {
+    id: String,
+    case: usize,
+    threads: usize,
+    stats: Stats,
+    gflops: f64,
+    gbps: f64,
+    roofline: f64,
+}
+
+fn json_string(s: &str) -> String {
+    format!("\"{}\"", s.replace('\\', "\\\\").replace('"', "\\\""))
+}
+
+fn write_json(path: &str, rooflines: &[Roofline], cases: &[Case], results: &[Measurement]) {
+    let mut out = String::new();
+    out.push_str("{\n  \"machine\": {\n");
+    writeln!(out, "    \"isa\": {},", json_string(cpu_isa())).unwrap();
+    out.push_str("    \"roofline\": [\n");
+    for (i, r) in rooflines.iter().enumerate() {
+        writeln!(
+            out,
+            "      {{\"threads\": {}, \"peak_gflops\": {:.3}, \"bandwidth_gbps\": {:.3}}}{}",
+            r.threads,
+            r.peak_gflops,
+            r.bandwidth_gbps,
+            if i + 1 < rooflines.len() { "," } else { "" }
+        )
+        .unwrap();
+    }
+    out.push_str("    ]\n  },\n  \"results\": [\n");
+    for (i, r) in results.iter().enumerate() {
+        let case = &cases[r.case];
+        writeln!(
+            out,
+            "    {{\"id\": {}, \"family\": {}, \"kernel\": {}, \"dtype\": {}, \"layout\": {}, \"shape\": {}, \
+             \"threads\": {}, \"median_ns\": {:.1}, \"min_ns\": {:.1}, \"samples\": {}, \"iters\": {}, \
+             \"flops\": {}, \"bytes\": {}, \"gflops\": {:.3}, \"gbps\": {:.3}, \"roofline\": {:.4}}}{}",
+            json_string(&r.id),
+            json_string(case.family),
+            json_string(&case.kernel),
+            json_string(case.dtype),
+            json_string(case.layout),
+            json_string(&case.shape),
+            r.threads,
+            r.stats.median * 1e9,
+            r.stats.min * 1e9,
+            r.stats.samples,
+            r.stats.iters,
+            case.flops,
+            case.bytes,
+            r.gflops,
+            r.gbps,
+            r.roofline,
+            if i + 1 < results.len() { "," } else { "" }
+        )
+        .unwrap();
+    }
+    out.push_str("  ]\n}\n");
+    std::fs::write(path, out).unwrap_or_else(|e| panic!("cannot write {}: {}", path, e));
+}
+
+fn format_time(seconds: f64) -> String {
+    match seconds {
+        s if s < 1e-3 => format!("{:.1} us", s * 1e6),
+        s if s < 1.0 => format!("{:.2} ms", s * 1e3),
+        s => format!("{:.2} s", s),
+    }
+}
+
+fn main() {
+    let options = parse_options();
+
+    println!("isa: {}", cpu_isa());
+    let rooflines: Vec<Roofline> = options.threads.iter().map(|&t| Roofline::measure(t)).collect();
+    for r in &rooflines {
+        println!(
+            "roofline, {} thread(s): {:.1} GFLOP/s f32 peak, {:.1} GB/s copy bandwidth, ridge at {:.1} FLOP/B",
+            r.threads,
+            r.peak_gflops,
+            r.bandwidth_gbps,
+            r.peak_gflops / r.bandwidth_gbps
+        );
+    }
+    println!();
+    println!(
+        "{:<64} {:>3} {:>10} {:>9} {:>8} {:>6}",
+        "case", "thr", "time", "GFLOP/s", "GB/s", "roof%"
+    );
+
+    let cases: Vec<Case> = all_cases(options.quick)
+        .into_iter()
+        .filter(|case| options.filters.is_empty() || options.filters.iter().any(|f| case.id().contains(f.as_str())))
+        .collect();
+    let mut results = Vec::new();
+    for (index, case) in cases.iter().enumerate() {
+        let mut run = (case.setup)();
+        for roof in &rooflines {
+            set_num_threads(roof.threads);
+            let stats = measure(&mut run, options.quick);
+            let gflops = case.flops / stats.median * 1e-9;
+            let gbps = case.bytes / stats.median * 1e-9;
+            let roofline = if case.flops > 0.0 {
+                gflops / roof.attainable_gflops(case.flops, case.bytes)
+            } else {
+                gbps / roof.bandwidth_gbps
+            };
+            let id = format!("{}/t{}", case.id(), roof.threads);
+            println!(
+                "{:<64} {:>3} {:>10} {:>9.2} {:>8.2} {:>5.1}%",
+                case.id(),
+                roof.threads,
+                format_time(stats.median),
+                gflops,
+                gbps,
+                roofline * 100.0
+            );
+            results.push(Measurement {
+                id,
+                case: index,
+                threads: roof.threads,
+                stats,
+                gflops,
+                gbps,
+                roofline,
+            });
+        }
+        drop(run);
+        trim_workspace();
+    }
+    set_num_threads(0);
+
+    if let Some(path) = &options.json {
+        write_json(path, &rooflines, &cases, &results);
+        println!("\nwrote {} results to {}", results.len(), path);
+    }
+}
@@ -1,4 +1,5 @@
 mod build_blas;
+mod build_jit_symbols;
 mod build_openblas;
 
 fn main() {
@@ -6,25 +7,38 @@ fn main() {
 
     // Source files
     build
+        .file("kernels/cpu_features.c")
+        .file("kernels/gemm.c")
+        .file("kernels/ops_attention.c")
         .file("kernels/ops_binary.c")
         .file("kernels/ops_bitwise.c")
         .file("kernels/ops_cast.c")
         .file("kernels/ops_concat_split.c")
         .file("kernels/ops_conv.c")
         .file("kernels/ops_einsum.c")
+        .file("kernels/ops_fused.c")
         .file("kernels/ops_indexing.c")
         .file("kernels/ops_linalg.c")
         .file("kernels/ops_matrix.c")
         .file("kernels/ops_memory.c")
+        .file("kernels/ops_norm.c")
         .file("kernels/ops_padding.c")
         .file("kernels/ops_reduce.c")
         .file("kernels/ops_resize.c")
         .file("kernels/ops_scan.c")
         .file("kernels/ops_shape_memory.c")
         .file("kernels/ops_sort.c")
+        .file("kernels/ops_sparse.c")
         .file("kernels/ops_unary.c")
         .file("kernels/ops_windowing.c")
+        .file("kernels/profile.c")
         .file("kernels/storage.c")
+        .file("kernels/strided_copy.c")
+        .file("kernels/task_queue.c")
+        .file("kernels/thread_pool.c")
+        .file("kernels/tuning.c")
+        .file("kernels/weights.c")
+        .file("kernels/workspace.c")
         .include("kernels");
 
     // BLAS configuration (must be done before adding source files)
@@ -33,18 +47,8 @@ fn main() {
     // BLAS-specific implementations
     add_blas_impl(&mut build);
 
-    // Standard flags
-    build
-        .flag_if_supported("-std=c11")
-        .flag_if_supported("-Wall")
-        .flag_if_supported("-Wextra")
-        .flag_if_supported("-O3")
-        .flag_if_supported("-funroll-loops")
-        .flag_if_supported("-fno-math-errno")
-        .flag_if_supported("-fno-trapping-math")
-        .flag_if_supported("-fvectorize")
-        .flag_if_supported("-fslp-vectorize")
-        .flag_if_supported("-ftree-vectorize");
+    // Standard flags, SIMD and threading defines
+    apply_common_flags(&mut build);
 
     // Platform-specific optimizations
     if std::env::var("HODU_DISABLE_NATIVE").is_err() {
@@ -52,25 +56,16 @@ fn main() {
             .flag_if_supported("-march=native")
             .flag_if_supported("-mtune=native")
             .flag_if_supported("-mcpu=native");
+    } else {
+        // Portable builds: per-ISA variants of the hot kernels, selected at runtime
+        add_isa_variants(&mut build);
     }
 
-    // SIMD auto-detection
-    if std::env::var("HODU_DISABLE_SIMD").is_err() {
-        build.define("ENABLE_SIMD_AUTO", None);
-    }
-
-    // Thread parallelization
-    if std::env::var("HODU_DISABLE_THREADS").is_err() {
-        build.define("ENABLE_THREADS", None);
-    }
-
-    // Embedded-friendly flags
-    build
-        .flag_if_supported("-fno-exceptions")
-        .flag_if_supported("-fno-rtti");
-
     build.compile("hodu_cpu_kernels");
 
+    // Symbol table for src/jit_symbols.rs
+    build_jit_symbols::generate();
+
     // Link pthread
     link_pthread();
 
@@ -82,11 +77,17 @@ fn main() {
     for file in [
         "atomic.h",
         "constants.h",
+        "cpu_features.h",
+        "cpu_features.c",
+        "epilogue.h",
         "math_utils.h",
         "simd_utils.h",
         "thread_utils.h",
+        "thread_pool.h",
         "types.h",
         "utils.h",
+        "ops_attention.h",
+        "ops_attention.c",
         "ops_binary.h",
         "ops_binary.c",
         "ops_cast.h",
@@ -97,12 +98,17 @@ fn main() {
         "ops_conv.c",
         "ops_einsum.h",
         "ops_einsum.c",
+        "ops_fused.h",
+        "ops_fused.c",
         "ops_indexing.h",
         "ops_indexing.c",
         "ops_linalg.h",
         "ops_linalg.c",
+        "ops_linalg_lapack.c",
         "ops_matrix.h",
         "ops_matrix.c",
+        "gemm.h",
+        "gemm.c",
         "ops_matrix_openblas.c",
         "ops_matrix_blas_aarch64_apple_darwin.c",
         "ops_conv_openblas.c",
@@ -111,6 +117,8 @@ fn main() {
         "ops_unary_blas_aarch64_apple_darwin.c",
         "ops_memory.h",
         "ops_memory.c",
+        "ops_norm.h",
+        "ops_norm.c",
         "ops_padding.h",
         "ops_padding.c",
         "ops_reduce.h",
@@ -123,17 +131,130 @@ fn main() {
         "ops_shape_memory.c",
         "ops_sort.h",
         "ops_sort.c",
+        "ops_sparse.h",
+        "ops_sparse.c",
         "ops_unary.h",
         "ops_unary.c",
         "ops_windowing.h",
         "ops_windowing.c",
+        "profile.h",
+        "profile.c",
         "storage.h",
         "storage.c",
+        "strided_copy.h",
+        "strided_copy.c",
+        "task_queue.h",
+        "task_queue.c",
+        "thread_pool.c",
+        "tuning.h",
+        "tuning.c",
+        "weights.h",
+        "weights.c",
+        "workspace.h",
+        "workspace.c",
     ] {
         println!("cargo:rerun-if-changed=kernels/{}", file);
     }
 }
 
+fn apply_common_flags(build: &mut cc::Build) {
+    // Standard flags
+    build
+        .flag_if_supported("-std=c11")
+        .flag_if_supported("-Wall")
+        .flag_if_supported("-Wextra")
+        .flag_if_supported("-O3")
+        .flag_if_supported("-funroll-loops")
+        .flag_if_supported("-fno-math-errno")
+        .flag_if_supported("-fno-trapping-math")
+        .flag_if_supported("-fvectorize")
+        .flag_if_supported("-fslp-vectorize")
+        .flag_if_supported("-ftree-vectorize");
+
+    // SIMD auto-detection
+    if std::env::var("HODU_DISABLE_SIMD").is_err() {
+        build.define("ENABLE_SIMD_AUTO", None);
+    }
+
+    // Thread parallelization
+    if std::env::var("HODU_DISABLE_THREADS").is_err() {
+        build.define("ENABLE_THREADS", None);
+    }
+
+    // Per-kernel profiling counters and trace events (off by default)
+    if std::env::var("HODU_ENABLE_PROFILE").is_ok() {
+        build.define("ENABLE_PROFILE", None);
+    }
+
+    // Embedded-friendly flags
+    build
+        .flag_if_supported("-fno-exceptions")
+        .flag_if_supported("-fno-rtti");
+}
+
+/// Translation units compiled once per ISA in portable builds (see kernels/cpu_features.h)
+const ISA_VARIANT_FILES: &[&str] = &["kernels/gemm.c"];
+
+/// ISA variants in increasing order: symbol suffix, dispatch define and compiler flags
+const ISA_VARIANTS: &[(&str, &str, &[&str])] = &[
+    ("_avx2", "HODU_CPU_DISPATCH_AVX2", &["-mavx2", "-mfma", "-mf16c"]),
+    (
+        "_avx512",
+        "HODU_CPU_DISPATCH_AVX512",
+        &[
+            "-mavx2",
+            "-mfma",
+            "-mf16c",
+            "-mavx512f",
+            "-mavx512bw",
+            "-mavx512dq",
+            "-mavx512vl",
+        ],
+    ),
+];
+
+fn add_isa_variants(build: &mut cc::Build) {
+    let target_arch = std::env::var("CARGO_CFG_TARGET_ARCH").unwrap_or_default();
+    if target_arch != "x86_64"
+        || build.get_compiler().is_like_msvc()
+        || std::env::var("HODU_DISABLE_SIMD").is_ok()
+        || std::env::var("HODU_DISABLE_DISPATCH").is_ok()
+    {
+        return;
+    }
+
+    let out_dir = std::path::PathBuf::from(std::env::var("OUT_DIR").unwrap());
+    let mut dispatch = false;
+    for (suffix, define, flags) in ISA_VARIANTS {
+        let mut variant = cc::Build::new();
+        variant.include("kernels").out_dir(out_dir.join(&suffix[1..]));
+        for file in ISA_VARIANT_FILES {
+            variant.file(file);
+        }
+        apply_common_flags(&mut variant);
+
+        // Each level needs the ones below it, so stop at the first unsupported one
+        if !flags
+            .iter()
+            .all(|flag| variant.is_flag_supported(flag).unwrap_or(false))
+        {
+            break;
+        }
+        for flag in flags.iter() {
+            variant.flag(flag);
+        }
+        variant.define("HODU_ISA_SUFFIX", Some(*suffix));
+
+        build.objects(variant.compile_intermediates());
+        build.define(define, None);
+        dispatch = true;
+    }
+
+    if dispatch {
+        build.define("HODU_CPU_DISPATCH", None);
+    }
+}
+
 fn add_blas_impl(build: &mut cc::Build) {
     #[cfg(feature = "openblas")]
     {
@@ -142,6 +263,9 @@ fn add_blas_impl(build: &mut cc::Build) {
             build.file("kernels/ops_conv_openblas.c");
             build.file("kernels/ops_matrix_openblas.c");
             build.file("kernels/ops_unary_openblas.c");
+            if openblas.lapack {
+                build.file("kernels/ops_linalg_lapack.c");
+            }
             return;
         }
         openblas.warn_if_not_found();
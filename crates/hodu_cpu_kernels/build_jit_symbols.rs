@@ -0,0 +1,286 @@
+//! JIT symbol table generation
+//!
+//! Preprocesses every kernels/*.h header, collects the exported `hodu_cpu_*`
+//! function declarations and writes `$OUT_DIR/jit_symbols_table.rs` for
+//! src/jit_symbols.rs: one extern declaration per symbol, its metadata and a
+//! minimal perfect hash over the names (see `perfect_hash`).
+
+use std::collections::BTreeMap;
+use std::fmt::Write as _;
+use std::path::{Path, PathBuf};
+
+include!("src/jit_hash.rs");
+
+/// Dtype name suffixes and their element sizes in bytes
+const DTYPES: &[(&str, usize)] = &[
+    ("bool", 1),
+    ("f8e4m3", 1),
+    ("f8e5m2", 1),
+    ("bf16", 2),
+    ("f16", 2),
+    ("f32", 4),
+    ("f64", 8),
+    ("u8", 1),
+    ("u16", 2),
+    ("u32", 4),
+    ("u64", 8),
+    ("i8", 1),
+    ("i16", 2),
+    ("i32", 4),
+    ("i64", 8),
+];
+
+/// Unary and binary ops that write bool whatever the input type (ops_unary.h, ops_binary.h)
+const BOOL_OUTPUT_OPS: &[&str] = &[
+    "logical_not",
+    "isnan",
+    "isinf",
+    "isfinite",
+    "eq_scalar",
+    "ne_scalar",
+    "lt_scalar",
+    "le_scalar",
+    "gt_scalar",
+    "ge_scalar",
+    "logical_and",
+    "logical_or",
+    "logical_xor",
+    "eq",
+    "ne",
+    "lt",
+    "le",
+    "gt",
+    "ge",
+];
+
+/// Average number of names per perfect-hash bucket
+const NAMES_PER_BUCKET: usize = 4;
+
+struct Symbol {
+    name: String,
+    category: String,
+    dtypes: Vec<&'static str>,
+    in_place: bool,
+}
+
+pub fn generate() {
+    let out_dir = PathBuf::from(std::env::var("OUT_DIR").unwrap());
+
+    let mut wrapper = String::new();
+    for header in kernel_headers(Path::new("kernels")) {
+        writeln!(wrapper, "#include \"{}\"", header).unwrap();
+    }
+    let wrapper_path = out_dir.join("jit_symbols_headers.c");
+    std::fs::write(&wrapper_path, wrapper).unwrap();
+
+    let expanded = cc::Build::new()
+        .include("kernels")
+        .file(&wrapper_path)
+        .cargo_metadata(false)
+        .expand();
+    let symbols = parse_declarations(&String::from_utf8_lossy(&expanded));
+
+    std::fs::write(out_dir.join("jit_symbols_table.rs"), render(&symbols)).unwrap();
+    println!("cargo:rerun-if-changed=build_jit_symbols.rs");
+    println!("cargo:rerun-if-changed=src/jit_hash.rs");
+}
+
+/// Header file names in kernels/, sorted
+fn kernel_headers(dir: &Path) -> Vec<String> {
+    let mut headers: Vec<String> = std::fs::read_dir(dir)
+        .unwrap()
+        .filter_map(|entry| entry.ok()?.file_name().into_string().ok())
+        .filter(|name| name.ends_with(".h"))
+        .collect();
+    headers.sort();
+    headers
+}
+
+/// Non-static `hodu_cpu_*` function declarations of the preprocessed headers, by name
+///
+/// Line markers (`# 12 "kernels/ops_unary.h"`, or `#line` with MSVC) give the
+/// declaring header. Statements are split on `;` outside braces; bodies of
+/// static inline functions and struct definitions are skipped.
+fn parse_declarations(text: &str) -> Vec<Symbol> {
+    let mut symbols: BTreeMap<String, Symbol> = BTreeMap::new();
+    let mut header = String::new();
+    let mut statement = String::new();
+    let mut depth = 0usize;
+
+    for line in text.lines() {
+        if let Some(marker) = line.trim_start().strip_prefix('#') {
+            if let Some(path) = marker.split('"').nth(1) {
+                header = header_category(path);
+            }
+            continue;
+        }
+        for c in line.chars() {
+            match c {
+                '{' => {
+                    if depth == 0 {
+                        statement.clear();
+                    }
+                    depth += 1;
+                },
+                '}' => depth = depth.saturating_sub(1),
+                ';' if depth == 0 => {
+                    if let Some(name) = declared_function(&statement) {
+                        symbols.entry(name.to_string()).or_insert_with(|| symbol(name, &header));
+                    }
+                    statement.clear();
+                },
+                _ if depth == 0 => statement.push(c),
+                _ => {},
+            }
+        }
+        statement.push(' ');
+    }
+
+    symbols.into_values().collect()
+}
+
+/// Header stem without the `ops_` prefix: "kernels/ops_unary.h" -> "unary"
+fn header_category(path: &str) -> String {
+    let file = path.rsplit(['/', '\\']).next().unwrap_or(path);
+    let stem = file.strip_suffix(".h").unwrap_or(file);
+    stem.strip_prefix("ops_").unwrap_or(stem).to_string()
+}
+
+/// Name of the `hodu_cpu_*` function a top-level statement declares, if any
+fn declared_function(statement: &str) -> Option<&str> {
+    let statement = statement.trim();
+    if matches!(statement.split_whitespace().next(), Some("static" | "typedef")) {
+        return None;
+    }
+
+    let is_ident = |c: char| c.is_ascii_alphanumeric() || c == '_';
+    let mut from = 0;
+    while let Some(pos) = statement[from..].find("hodu_cpu_") {
+        let start = from + pos;
+        let end = statement[start..]
+            .find(|c: char| !is_ident(c))
+            .map_or(statement.len(), |len| start + len);
+        let glued = statement[..start].chars().next_back().is_some_and(is_ident);
+        let pointer = statement[..start].trim_end().strip_suffix('*');
+        let after = statement[end..].trim_start().chars().next();
+        // A whole identifier followed by its parameter list, and not a function pointer
+        // (`(*hodu_cpu_fn)(...)`)
+        if !glued && !pointer.is_some_and(|p| p.trim_end().ends_with('(')) && after == Some('(') {
+            return Some(&statement[start..end]);
+        }
+        from = end;
+    }
+    None
+}
+
+fn symbol(name: &str, category: &str) -> Symbol {
+    let tokens: Vec<&str> = name["hodu_cpu_".len()..].split('_').collect();
+    let dtypes: Vec<&'static str> = tokens
+        .iter()
+        .filter_map(|token| DTYPES.iter().find(|(dtype, _)| dtype == token))
+        .map(|(dtype, _)| *dtype)
+        .collect();
+    let op = tokens
+        .iter()
+        .filter(|token| !DTYPES.iter().any(|(dtype, _)| dtype == *token))
+        .copied()
+        .collect::<Vec<_>>()
+        .join("_");
+    let size = |dtype: &str| DTYPES.iter().find(|(d, _)| *d == dtype).map(|(_, s)| *s);
+
+    // Output may alias the input (see the "In place" notes in the headers)
+    let in_place = match (category, dtypes.as_slice()) {
+        ("unary" | "binary", &[dtype]) => {
+            let output = if BOOL_OUTPUT_OPS.contains(&op.as_str()) {
+                "bool"
+            } else {
+                dtype
+            };
+            size(dtype) == size(output)
+        },
+        ("cast", &[src, dst]) => size(src) == size(dst),
+        ("fused", &[_]) => true,
+        ("indexing", _) => op.starts_with("scatter") || op == "index_put",
+        _ => false,
+    };
+
+    Symbol {
+        name: name.to_string(),
+        category: category.to_string(),
+        dtypes,
+        in_place,
+    }
+}
+
+/// Minimal perfect hash (hash and displace): names hash into buckets with seed 0, and each
+/// bucket, largest first, gets the first seed that sends all its names to free slots
+///
+/// Returns the per-bucket seeds and the slot of every name.
+fn perfect_hash(names: &[&str]) -> (Vec<u32>, Vec<usize>) {
+    let n = names.len();
+    let num_buckets = n.div_ceil(NAMES_PER_BUCKET).max(1);
+    let mut buckets: Vec<Vec<usize>> = vec![Vec::new(); num_buckets];
+    for (i, name) in names.iter().enumerate() {
+        buckets[(jit_hash(name.as_bytes(), 0) % num_buckets as u64) as usize].push(i);
+    }
+    let mut order: Vec<usize> = (0..num_buckets).collect();
+    order.sort_by_key(|&b| std::cmp::Reverse(buckets[b].len()));
+
+    let mut seeds = vec![0u32; num_buckets];
+    let mut slots = vec![usize::MAX; n];
+    let mut taken = vec![false; n];
+    for b in order {
+        if buckets[b].is_empty() {
+            break;
+        }
+        let (seed, bucket_slots) = (1..=u32::MAX)
+            .find_map(|seed| {
+                let mut bucket_slots = Vec::with_capacity(buckets[b].len());
+                for &i in &buckets[b] {
+                    let slot = (jit_hash(names[i].as_bytes(), seed as u64) % n as u64) as usize;
+                    if taken[slot] || bucket_slots.contains(&slot) {
+                        return None;
+                    }
+                    bucket_slots.push(slot);
+                }
+                Some((seed, bucket_slots))
+            })
+            .expect("no perfect hash seed for the JIT symbol table");
+        seeds[b] = seed;
+        for (&i, &slot) in buckets[b].iter().zip(&bucket_slots) {
+            taken[slot] = true;
+            slots[i] = slot;
+        }
+    }
+    (seeds, slots)
+}
+
+fn render(symbols: &[Symbol]) -> String {
+    let names: Vec<&str> = symbols.iter().map(|s| s.name.as_str()).collect();
+    let (seeds, slots) = perfect_hash(&names);
+    let mut by_slot: Vec<&Symbol> = symbols.iter().collect();
+    for (symbol, &slot) in symbols.iter().zip(&slots) {
+        by_slot[slot] = symbol;
+    }
+
+    let mut out = String::new();
+    out.push_str("// Generated by build_jit_symbols.rs from kernels/*.h; do not edit\n\n");
+    out.push_str("extern \"C\" {\n");
+    for name in &names {
+        writeln!(out, "    fn {}();", name).unwrap();
+    }
+    out.push_str("}\n\n");
+
+    writeln!(out, "static HASH_SEEDS: [u32; {}] = {:?};\n", seeds.len(), seeds).unwrap();
+    writeln!(out, "static KERNELS: [KernelInfo; {}] = [", by_slot.len()).unwrap();
+    for s in by_slot {
+        writeln!(
+            out,
+            "    KernelInfo {{ name: {:?}, category: {:?}, dtypes: &{:?}, in_place: {}, ptr: {} }},",
+            s.name, s.category, s.dtypes, s.in_place, s.name
+        )
+        .unwrap();
+    }
+    out.push_str("];\n");
+    out
+}
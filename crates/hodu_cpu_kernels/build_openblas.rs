@@ -4,19 +4,26 @@ pub struct OpenBlasConfig {
     pub available: bool,
     pub include_path: Option<String>,
     pub lib_path: Option<String>,
+    /// LAPACKE is usable (linked from OpenBLAS itself or from a separate liblapacke)
+    pub lapack: bool,
+    pub lapacke_lib: bool,
 }
 
 impl OpenBlasConfig {
     pub fn detect() -> Self {
         if let Some((include_path, lib_path)) = detect_openblas_paths() {
+            let include_path = if include_path.is_empty() {
+                None
+            } else {
+                Some(include_path)
+            };
+            let lapacke = detect_lapacke(include_path.as_deref(), lib_path.as_deref());
             return Self {
                 available: true,
-                include_path: if include_path.is_empty() {
-                    None
-                } else {
-                    Some(include_path)
-                },
+                include_path,
                 lib_path,
+                lapack: lapacke.is_some(),
+                lapacke_lib: lapacke.unwrap_or(false),
             };
         }
 
@@ -28,6 +35,8 @@ impl OpenBlasConfig {
             available: false,
             include_path: None,
             lib_path: None,
+            lapack: false,
+            lapacke_lib: false,
         }
     }
 
@@ -36,6 +45,9 @@ impl OpenBlasConfig {
             return;
         }
         build.define("USE_BLAS", None);
+        if self.lapack {
+            build.define("USE_LAPACK", None);
+        }
         if let Some(ref path) = self.include_path {
             build.include(path);
         }
@@ -62,7 +74,10 @@ impl OpenBlasConfig {
             println!("cargo:rustc-link-search=native={}", path);
         }
 
-        // Link OpenBLAS
+        // Link OpenBLAS (and LAPACKE when OpenBLAS was built without it)
+        if self.lapacke_lib {
+            println!("cargo:rustc-link-lib=lapacke");
+        }
         println!("cargo:rustc-link-lib=openblas");
 
         // Platform dependencies
@@ -209,6 +224,63 @@ int main() {
     }
 }
 
+/// Whether LAPACKE links: `Some(false)` from OpenBLAS alone, `Some(true)` with a separate
+/// liblapacke, `None` if neither works
+fn detect_lapacke(include_path: Option<&str>, lib_path: Option<&str>) -> Option<bool> {
+    use std::fs;
+    use std::io::Write;
+
+    if std::env::var("HODU_DISABLE_LAPACK").is_ok() || is_cross_compile() {
+        return None;
+    }
+
+    let test_code = r#"
+#include <lapacke.h>
+int main() {
+    double a = 2.0, b = 4.0;
+    lapack_int ipiv;
+    return LAPACKE_dgesv(LAPACK_ROW_MAJOR, 1, 1, &a, 1, &ipiv, &b, 1) == 0 ? 0 : 1;
+}
+"#;
+
+    let out_dir = std::env::var("OUT_DIR").ok()?;
+    let test_c = std::path::Path::new(&out_dir).join("test_lapacke.c");
+    let test_exe = std::path::Path::new(&out_dir).join("test_lapacke");
+
+    let mut file = fs::File::create(&test_c).ok()?;
+    file.write_all(test_code.as_bytes()).ok()?;
+    drop(file);
+
+    let mut build = cc::Build::new();
+    build.cargo_warnings(false);
+    if let Some(path) = include_path {
+        build.include(path);
+    }
+    let compiler = build.try_get_compiler().ok()?;
+
+    let links = |extra: &[&str]| {
+        let mut cmd = compiler.to_command();
+        cmd.arg(&test_c).arg("-o").arg(&test_exe);
+        if let Some(path) = lib_path {
+            cmd.arg(format!("-L{}", path));
+        }
+        cmd.args(extra).arg("-lopenblas");
+        cmd.output().map(|o| o.status.success()).unwrap_or(false)
+    };
+
+    let result = if links(&[]) {
+        Some(false)
+    } else if links(&["-llapacke"]) {
+        Some(true)
+    } else {
+        None
+    };
+
+    let _ = fs::remove_file(&test_c);
+    let _ = fs::remove_file(&test_exe);
+    result
+}
+
 fn is_cross_compile() -> bool {
     let target = std::env::var("TARGET").unwrap_or_default();
     let host = std::env::var("HOST").unwrap_or_default();
@@ -0,0 +1,132 @@
+#include "cpu_features.h"
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(HODU_CPU_DISPATCH) && (defined(__x86_64__) || defined(__i386__)) &&                   \
+    (defined(__GNUC__) || defined(__clang__))
+#include <cpuid.h>
+#define CPU_FEATURES_X86_DETECT
+#endif
+
+// ============================================================================
+// CPU FEATURE DETECTION
+// ============================================================================
+
+#ifdef CPU_FEATURES_X86_DETECT
+// XCR0: register state the OS saves on context switches
+static uint64_t cpu_xgetbv(void) {
+    uint32_t eax, edx;
+    __asm__ volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+    return ((uint64_t)edx << 32) | eax;
+}
+
+// Highest level whose instructions the CPU has and the OS enables
+static hodu_cpu_isa_t detect_cpu_isa(void) {
+    unsigned int eax, ebx, ecx, edx;
+    if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx)) {
+        return HODU_CPU_ISA_BASELINE;
+    }
+    const bool fma = (ecx >> 12) & 1;
+    const bool osxsave = (ecx >> 27) & 1;
+    const bool avx = (ecx >> 28) & 1;
+    const bool f16c = (ecx >> 29) & 1;
+    if (!osxsave || !avx) {
+        return HODU_CPU_ISA_BASELINE;
+    }
+
+    const uint64_t xcr0 = cpu_xgetbv();
+    const bool ymm_state = (xcr0 & 0x6) == 0x6;   // SSE + AVX
+    const bool zmm_state = (xcr0 & 0xe6) == 0xe6; // + opmask, ZMM0-15 high, ZMM16-31
+    if (!ymm_state || __get_cpuid_max(0, NULL) < 7) {
+        return HODU_CPU_ISA_BASELINE;
+    }
+
+    __cpuid_count(7, 0, eax, ebx, ecx, edx);
+    const bool avx2 = (ebx >> 5) & 1;
+    const bool avx512 = ((ebx >> 16) & 1) && ((ebx >> 17) & 1) && // F, DQ
+                        ((ebx >> 30) & 1) && ((ebx >> 31) & 1);   // BW, VL
+    if (!avx2 || !fma || !f16c) {
+        return HODU_CPU_ISA_BASELINE;
+    }
+    return (avx512 && zmm_state) ? HODU_CPU_ISA_AVX512 : HODU_CPU_ISA_AVX2;
+}
+#endif
+
+// Level of the compiled-in code: the best dispatch variant, or the build flags
+static hodu_cpu_isa_t compiled_cpu_isa(void) {
+#if defined(HODU_CPU_DISPATCH) && defined(HODU_CPU_DISPATCH_AVX512)
+    return HODU_CPU_ISA_AVX512;
+#elif defined(HODU_CPU_DISPATCH) && defined(HODU_CPU_DISPATCH_AVX2)
+    return HODU_CPU_ISA_AVX2;
+#elif defined(__AVX512F__) && defined(__AVX512BW__) && defined(__AVX512DQ__) &&                   \
+    defined(__AVX512VL__)
+    return HODU_CPU_ISA_AVX512;
+#elif defined(__AVX2__) && defined(__FMA__) && defined(__F16C__)
+    return HODU_CPU_ISA_AVX2;
+#else
+    return HODU_CPU_ISA_BASELINE;
+#endif
+}
+
+#ifdef HODU_CPU_DISPATCH
+// HODU_CPU_ISA cap, or -1 when unset or not recognized
+static int requested_cpu_isa(void) {
+    const char *env = getenv("HODU_CPU_ISA");
+    if (!env) {
+        return -1;
+    }
+    for (int isa = HODU_CPU_ISA_BASELINE; isa <= HODU_CPU_ISA_AVX512; isa++) {
+        if (strcmp(env, hodu_cpu_isa_name((hodu_cpu_isa_t)isa)) == 0) {
+            return isa;
+        }
+    }
+    return -1;
+}
+#endif
+
+static hodu_cpu_isa_t detect_isa(void) {
+    hodu_cpu_isa_t isa = compiled_cpu_isa();
+#ifdef HODU_CPU_DISPATCH
+#ifdef CPU_FEATURES_X86_DETECT
+    hodu_cpu_isa_t cpu = detect_cpu_isa();
+    isa = cpu < isa ? cpu : isa;
+#else
+    isa = HODU_CPU_ISA_BASELINE;
+#endif
+    int requested = requested_cpu_isa();
+    if (requested >= 0 && (hodu_cpu_isa_t)requested < isa) {
+        isa = (hodu_cpu_isa_t)requested;
+    }
+#endif
+    return isa;
+}
+
+// ============================================================================
+// PUBLIC API
+// ============================================================================
+
+// Cached level + 1, 0 = not detected yet (racing first calls detect the same value)
+static atomic_int cached_isa;
+
+hodu_cpu_isa_t hodu_cpu_isa(void) {
+    int cached = atomic_load_explicit(&cached_isa, memory_order_relaxed);
+    if (cached == 0) {
+        cached = (int)detect_isa() + 1;
+        atomic_store_explicit(&cached_isa, cached, memory_order_relaxed);
+    }
+    return (hodu_cpu_isa_t)(cached - 1);
+}
+
+const char *hodu_cpu_isa_name(hodu_cpu_isa_t isa) {
+    switch (isa) {
+    case HODU_CPU_ISA_AVX2:
+        return "avx2";
+    case HODU_CPU_ISA_AVX512:
+        return "avx512";
+    default:
+        return "baseline";
+    }
+}
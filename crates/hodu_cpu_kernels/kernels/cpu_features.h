@@ -0,0 +1,111 @@
+/**
+ * @file cpu_features.h
+ * @brief Runtime CPU feature detection and per-ISA kernel dispatch
+ *
+ * Portable builds (HODU_DISABLE_NATIVE) compile the hot translation units
+ * once per instruction set and pick one variant when the process first calls
+ * them:
+ * - The baseline object is built with HODU_CPU_DISPATCH; its public entry
+ *   points look up a per-function table of ISA variants and forward to the
+ *   variant selected by hodu_cpu_isa()
+ * - Each variant object is built with HODU_ISA_SUFFIX (_avx2, _avx512) and
+ *   the matching -m flags; its public definitions are renamed with
+ *   HODU_ISA_NAME so they link next to the baseline
+ *
+ * Native builds (-march=native) define neither macro: the entry points are
+ * plain functions and hodu_cpu_isa() reports the level they were built for.
+ */
+
+#ifndef HODU_CPU_KERNELS_CPU_FEATURES_H
+#define HODU_CPU_KERNELS_CPU_FEATURES_H
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// Instruction set levels with a compiled kernel variant
+typedef enum {
+    HODU_CPU_ISA_BASELINE = 0, // build flags only (SSE2 on x86_64, NEON on aarch64)
+    HODU_CPU_ISA_AVX2 = 1,     // AVX2 + FMA + F16C
+    HODU_CPU_ISA_AVX512 = 2,   // AVX-512 F/BW/DQ/VL
+} hodu_cpu_isa_t;
+
+// ============================================================================
+// DETECTION
+// ============================================================================
+//
+// The level is detected once (cpuid, plus xgetbv for OS-enabled register
+// state) and cached. It is capped by:
+// - The variants compiled into the library (HODU_CPU_DISPATCH_AVX2/_AVX512)
+// - The HODU_CPU_ISA environment variable (baseline, avx2 or avx512), read
+//   once on first use
+// Without HODU_CPU_DISPATCH the level is fixed by the build flags.
+
+/// Instruction set level the dispatched kernels run on
+hodu_cpu_isa_t hodu_cpu_isa(void);
+
+/// Lower-case name of an ISA level ("baseline", "avx2", "avx512")
+const char *hodu_cpu_isa_name(hodu_cpu_isa_t isa);
+
+// ============================================================================
+// MULTIVERSIONING
+// ============================================================================
+//
+//   void HODU_ISA_NAME(hodu_cpu_foo_f32)(size_t n, const f32_t *x) {
+//       HODU_ISA_DISPATCH(hodu_cpu_foo_f32, (n, x));
+//       ...
+//   }
+//
+// HODU_ISA_DISPATCH tail-calls the selected variant (and returns) before the
+// baseline body runs; HODU_ISA_DISPATCH_VALUE does the same for functions
+// returning a value. Both are empty in variant and native builds.
+
+#define HODU_ISA_CAT_(A, B) A##B
+#define HODU_ISA_CAT(A, B) HODU_ISA_CAT_(A, B)
+
+#if defined(HODU_ISA_SUFFIX)
+#define HODU_ISA_NAME(NAME) HODU_ISA_CAT(NAME, HODU_ISA_SUFFIX)
+#define HODU_ISA_DISPATCH(NAME, ARGS)
+#define HODU_ISA_DISPATCH_VALUE(NAME, ARGS)
+#elif defined(HODU_CPU_DISPATCH)
+#define HODU_ISA_NAME(NAME) NAME
+
+#ifdef HODU_CPU_DISPATCH_AVX512
+#define HODU_ISA_AVX512_VARIANT(NAME) NAME##_avx512
+#else
+#define HODU_ISA_AVX512_VARIANT(NAME) NAME##_avx2
+#endif
+
+/* Table indexed by hodu_cpu_isa_t; the baseline slot stays NULL */
+#define HODU_ISA_SELECT(NAME)                                                                      \
+    extern __typeof__(NAME) NAME##_avx2;                                                           \
+    extern __typeof__(NAME) HODU_ISA_AVX512_VARIANT(NAME);                                         \
+    static __typeof__(NAME) *const hodu_isa_table[] = {NULL, NAME##_avx2,                          \
+                                                       HODU_ISA_AVX512_VARIANT(NAME)};             \
+    __typeof__(NAME) *const hodu_isa_fn = hodu_isa_table[hodu_cpu_isa()]
+
+#define HODU_ISA_DISPATCH(NAME, ARGS)                                                              \
+    HODU_ISA_SELECT(NAME);                                                                         \
+    if (hodu_isa_fn) {                                                                             \
+        hodu_isa_fn ARGS;                                                                          \
+        return;                                                                                    \
+    }
+
+#define HODU_ISA_DISPATCH_VALUE(NAME, ARGS)                                                        \
+    HODU_ISA_SELECT(NAME);                                                                         \
+    if (hodu_isa_fn) {                                                                             \
+        return hodu_isa_fn ARGS;                                                                   \
+    }
+#else
+#define HODU_ISA_NAME(NAME) NAME
+#define HODU_ISA_DISPATCH(NAME, ARGS)
+#define HODU_ISA_DISPATCH_VALUE(NAME, ARGS)
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // HODU_CPU_KERNELS_CPU_FEATURES_H
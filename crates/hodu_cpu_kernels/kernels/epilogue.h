@@ -0,0 +1,44 @@
+/**
+ * @file epilogue.h
+ * @brief Fused output epilogue descriptor
+ *
+ * Describes the element-wise work that fused matmul/conv kernels apply to each
+ * output tile right after it is computed, instead of separate binary/unary
+ * passes over the whole output:
+ *   output = activation(scale * product + bias + residual)
+ */
+
+#ifndef HODU_CPU_KERNELS_EPILOGUE_H
+#define HODU_CPU_KERNELS_EPILOGUE_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// Activation applied last by a fused epilogue
+typedef enum {
+    HODU_CPU_ACTIVATION_NONE = 0,
+    HODU_CPU_ACTIVATION_RELU = 1,
+    HODU_CPU_ACTIVATION_GELU = 2, // tanh approximation, as in ops_unary
+    HODU_CPU_ACTIVATION_SILU = 3,
+    HODU_CPU_ACTIVATION_SIGMOID = 4,
+    HODU_CPU_ACTIVATION_TANH = 5,
+} hodu_cpu_activation_t;
+
+/// Fused epilogue: output = activation(scale * product + bias + residual)
+///
+/// bias and residual use the output element type; NULL skips the term.
+typedef struct {
+    float scale;          // 1.0 leaves the product unscaled
+    const void *bias;     // one value per output column (matmul) / output channel (conv)
+    const void *residual; // same shape and contiguous layout as the output
+    int32_t activation;   // hodu_cpu_activation_t
+} hodu_cpu_epilogue_t;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // HODU_CPU_KERNELS_EPILOGUE_H
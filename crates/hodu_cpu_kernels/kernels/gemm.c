@@ -0,0 +1,1208 @@
+#include "gemm.h"
+#include "cpu_features.h"
+#include "math_utils.h"
+#include "profile.h"
+#include "simd_utils.h"
+#include "thread_utils.h"
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+// ============================================================================
+// GEMM CONFIGURATION
+// ============================================================================
+//
+// Microkernel tile: MR rows x NR = NV * SIMD width columns.
+// With SIMD, 6 x (2 vectors) keeps 12 accumulators plus 2 B vectors and one
+// broadcast A value in the 16 architectural registers of AVX2 (NEON has 32).
+// Without SIMD a 4 x 4 scalar tile is left to the auto-vectorizer.
+//
+// Cache blocking:
+// - KC: depth of a packed slab; one MR x KC A panel plus one KC x NR B panel
+//   stay in L1 while the microkernel runs
+// - MC: rows of a packed A block (MC x KC sized for L2); multiple of 4 and 6
+// - NC: columns of a packed B slab (KC x NC sized for L3)
+
+#if SIMD_F32_WIDTH > 1
+#define GEMM_F32_MR 6
+#define GEMM_F32_NV 2
+typedef simd_f32_t gemm_f32_vec_t;
+#define gemm_f32_load simd_f32_load
+#define gemm_f32_store simd_f32_store
+#define gemm_f32_set1 simd_f32_set1
+#define gemm_f32_add simd_f32_add
+#define gemm_f32_fmadd simd_f32_fmadd
+#else
+#define GEMM_F32_MR 4
+#define GEMM_F32_NV 4
+typedef f32_t gemm_f32_vec_t;
+static inline f32_t gemm_f32_load(const f32_t *p) { return *p; }
+static inline void gemm_f32_store(f32_t *p, f32_t v) { *p = v; }
+static inline f32_t gemm_f32_set1(f32_t v) { return v; }
+static inline f32_t gemm_f32_add(f32_t a, f32_t b) { return a + b; }
+static inline f32_t gemm_f32_fmadd(f32_t a, f32_t b, f32_t c) { return a * b + c; }
+#endif
+
+#if SIMD_F64_WIDTH > 1
+#define GEMM_F64_MR 6
+#define GEMM_F64_NV 2
+typedef simd_f64_t gemm_f64_vec_t;
+#define gemm_f64_load simd_f64_load
+#define gemm_f64_store simd_f64_store
+#define gemm_f64_set1 simd_f64_set1
+#define gemm_f64_add simd_f64_add
+#define gemm_f64_fmadd simd_f64_fmadd
+#else
+#define GEMM_F64_MR 4
+#define GEMM_F64_NV 4
+typedef f64_t gemm_f64_vec_t;
+static inline f64_t gemm_f64_load(const f64_t *p) { return *p; }
+static inline void gemm_f64_store(f64_t *p, f64_t v) { *p = v; }
+static inline f64_t gemm_f64_set1(f64_t v) { return v; }
+static inline f64_t gemm_f64_add(f64_t a, f64_t b) { return a + b; }
+static inline f64_t gemm_f64_fmadd(f64_t a, f64_t b, f64_t c) { return a * b + c; }
+#endif
+
+#define GEMM_F32_MC 96
+#define GEMM_F32_KC 256
+#define GEMM_F32_NC 2048
+
+#define GEMM_F64_MC 48
+#define GEMM_F64_KC 256
+#define GEMM_F64_NC 1024
+
+// Below this many multiply-adds a GEMM runs on the calling thread only
+#define GEMM_MIN_PARALLEL_WORK (1 << 16)
+
+// ============================================================================
+// PACKING BUFFERS
+// ============================================================================
+//
+// Packed panels live in grow-only thread-local buffers: the shared B slab in
+// the dispatching thread's buffer, A blocks in each executing thread's own.
+// Low-precision GEMMs also keep their f32 accumulation block here.
+// Pool threads are persistent, so repeated GEMMs do not touch the allocator.
+
+typedef struct {
+    void *data;
+    size_t capacity;
+} gemm_buffer_t;
+
+static _Thread_local gemm_buffer_t gemm_pack_a;
+static _Thread_local gemm_buffer_t gemm_pack_b;
+static _Thread_local gemm_buffer_t gemm_acc;
+
+static void *gemm_buffer_reserve(gemm_buffer_t *buf, size_t bytes) {
+    if (buf->capacity < bytes) {
+        void *data = malloc(bytes);
+        if (!data) {
+            return NULL;
+        }
+        free(buf->data);
+        buf->data = data;
+        buf->capacity = bytes;
+    }
+    return buf->data;
+}
+
+// ============================================================================
+// GEMM IMPLEMENTATION
+// ============================================================================
+
+/// Macro to implement the register-tiled microkernel for one accumulation type
+///
+/// @param TYPE C type of the packed panels and accumulators
+/// @param TYPE_SUFFIX Suffix for function naming
+/// @param PREFIX Prefix of the vector helpers (gemm_f32 / gemm_f64)
+/// @param WIDTH SIMD width of the vector helpers (1 = scalar)
+/// @param MR Microkernel rows
+/// @param NV Microkernel columns in vectors
+#define GEMM_KERNEL_IMPL(TYPE, TYPE_SUFFIX, PREFIX, WIDTH, MR, NV)                                 \
+    enum { TYPE_SUFFIX##_NR = (NV) * (WIDTH) };                                                    \
+                                                                                                   \
+    /* C[0:mr, 0:nr] (+)= packed A panel (kc x MR) @ packed B panel (kc x NR) */                   \
+    static inline void gemm_##TYPE_SUFFIX##_micro(size_t kc, const TYPE *a, const TYPE *b,         \
+                                                  TYPE *c, size_t ldc, size_t mr, size_t nr,       \
+                                                  bool accumulate) {                               \
+        const size_t NR = TYPE_SUFFIX##_NR;                                                        \
+        PREFIX##_vec_t acc[MR][NV];                                                                \
+        for (size_t i = 0; i < (MR); i++) {                                                        \
+            for (size_t v = 0; v < (NV); v++) {                                                    \
+                acc[i][v] = PREFIX##_set1((TYPE)0);                                                \
+            }                                                                                      \
+        }                                                                                          \
+                                                                                                   \
+        for (size_t p = 0; p < kc; p++) {                                                          \
+            PREFIX##_vec_t bv[NV];                                                                 \
+            for (size_t v = 0; v < (NV); v++) {                                                    \
+                bv[v] = PREFIX##_load(b + p * NR + v * (WIDTH));                                   \
+            }                                                                                      \
+            for (size_t i = 0; i < (MR); i++) {                                                    \
+                PREFIX##_vec_t av = PREFIX##_set1(a[p * (MR) + i]);                                \
+                for (size_t v = 0; v < (NV); v++) {                                                \
+                    acc[i][v] = PREFIX##_fmadd(av, bv[v], acc[i][v]);                              \
+                }                                                                                  \
+            }                                                                                      \
+        }                                                                                          \
+                                                                                                   \
+        if (mr == (MR) && nr == NR) {                                                              \
+            for (size_t i = 0; i < (MR); i++) {                                                    \
+                for (size_t v = 0; v < (NV); v++) {                                                \
+                    TYPE *cp = c + i * ldc + v * (WIDTH);                                          \
+                    PREFIX##_vec_t r = acc[i][v];                                                  \
+                    if (accumulate) {                                                              \
+                        r = PREFIX##_add(r, PREFIX##_load(cp));                                    \
+                    }                                                                              \
+                    PREFIX##_store(cp, r);                                                         \
+                }                                                                                  \
+            }                                                                                      \
+        } else {                                                                                   \
+            /* Edge tile: spill the full tile and copy the valid part */                           \
+            TYPE tile[(MR) * TYPE_SUFFIX##_NR];                                                    \
+            for (size_t i = 0; i < (MR); i++) {                                                    \
+                for (size_t v = 0; v < (NV); v++) {                                                \
+                    PREFIX##_store(tile + i * NR + v * (WIDTH), acc[i][v]);                        \
+                }                                                                                  \
+            }                                                                                      \
+            for (size_t i = 0; i < mr; i++) {                                                      \
+                for (size_t j = 0; j < nr; j++) {                                                  \
+                    TYPE r = tile[i * NR + j];                                                     \
+                    c[i * ldc + j] = accumulate ? c[i * ldc + j] + r : r;                          \
+                }                                                                                  \
+            }                                                                                      \
+        }                                                                                          \
+    }
+
+/// Macro to implement panel packing for one source type
+///
+/// Panels are converted from SRC to the accumulation type while packing, so the
+/// microkernel only ever sees TYPE values.
+///
+/// Generates gemm_<src>_pack_a / gemm_<src>_pack_b: zero-padded, converting panel packing
+///
+/// @param TYPE Accumulation type (packed panels)
+/// @param TYPE_SUFFIX Suffix of the tile constants
+/// @param SRC C type of the packed elements
+/// @param SRC_SUFFIX Suffix for function naming
+/// @param LOAD_FN Conversion from SRC to TYPE
+/// @param MR Microkernel rows
+#define GEMM_PACK_IMPL(TYPE, TYPE_SUFFIX, SRC, SRC_SUFFIX, LOAD_FN, MR)                            \
+    /* Pack A[0:mc, 0:kc] into MR-row panels: panel[p * MR + i] = A[ir + i, p] */                  \
+    static void gemm_##SRC_SUFFIX##_pack_a(size_t mc, size_t kc, const SRC *a, size_t a_rs,        \
+                                            size_t a_cs, TYPE *dst) {                              \
+        for (size_t ir = 0; ir < mc; ir += (MR)) {                                                 \
+            size_t mr = (mc - ir < (MR)) ? (mc - ir) : (MR);                                       \
+            const SRC *src = a + ir * a_rs;                                                        \
+            for (size_t p = 0; p < kc; p++) {                                                      \
+                for (size_t i = 0; i < mr; i++) {                                                  \
+                    dst[i] = LOAD_FN(src[i * a_rs + p * a_cs]);                                    \
+                }                                                                                  \
+                for (size_t i = mr; i < (MR); i++) {                                               \
+                    dst[i] = (TYPE)0;                                                              \
+                }                                                                                  \
+                dst += (MR);                                                                       \
+            }                                                                                      \
+        }                                                                                          \
+    }                                                                                              \
+                                                                                                   \
+    typedef struct {                                                                               \
+        const SRC *b;                                                                              \
+        size_t b_rs, b_cs;                                                                         \
+        size_t kc, nc;                                                                             \
+        TYPE *dst;                                                                                 \
+    } gemm_##SRC_SUFFIX##_pack_b_args_t;                                                           \
+                                                                                                   \
+    /* Pack NR-column panels [start, end) of B[0:kc, 0:nc]: panel[p * NR + j] = B[p, jr + j] */    \
+    static void gemm_##SRC_SUFFIX##_pack_b(size_t start, size_t end, void *arg) {                  \
+        gemm_##SRC_SUFFIX##_pack_b_args_t *args = (gemm_##SRC_SUFFIX##_pack_b_args_t *)arg;        \
+        const size_t NR = TYPE_SUFFIX##_NR;                                                        \
+        for (size_t panel = start; panel < end; panel++) {                                         \
+            size_t jr = panel * NR;                                                                \
+            size_t nr = (args->nc - jr < NR) ? (args->nc - jr) : NR;                               \
+            const SRC *src = args->b + jr * args->b_cs;                                            \
+            TYPE *dst = args->dst + panel * NR * args->kc;                                         \
+            for (size_t p = 0; p < args->kc; p++) {                                                \
+                const SRC *row = src + p * args->b_rs;                                             \
+                if (args->b_cs == 1) {                                                             \
+                    for (size_t j = 0; j < nr; j++) {                                              \
+                        dst[j] = LOAD_FN(row[j]);                                                  \
+                    }                                                                              \
+                } else {                                                                           \
+                    for (size_t j = 0; j < nr; j++) {                                              \
+                        dst[j] = LOAD_FN(row[j * args->b_cs]);                                     \
+                    }                                                                              \
+                }                                                                                  \
+                for (size_t j = nr; j < NR; j++) {                                                 \
+                    dst[j] = (TYPE)0;                                                              \
+                }                                                                                  \
+                dst += NR;                                                                         \
+            }                                                                                      \
+        }                                                                                          \
+    }
+
+/// Macro to implement the blocked driver for one pair of packed source types
+///
+/// Generates gemm_<name>_blocked, distributing tiles over the pool. A and B are packed by
+/// the GEMM_PACK_IMPL functions of their own types, so B may be stored in a narrower type
+/// than A (e.g. f32 activations against bf16 weights) and is only widened into the panels.
+///
+/// @param TYPE Accumulation type (packed panels and C)
+/// @param TYPE_SUFFIX Suffix of the microkernel and tile constants
+/// @param SRC_A, A_SUFFIX C type and packing suffix of A
+/// @param SRC_B, B_SUFFIX C type and packing suffix of B
+/// @param NAME Suffix for function naming
+/// @param MR Microkernel rows
+/// @param MC_BLK Rows per packed A block
+/// @param KC_BLK Depth per packed slab
+/// @param NC_BLK Columns per packed B slab
+#define GEMM_BLOCKED_IMPL(TYPE, TYPE_SUFFIX, SRC_A, A_SUFFIX, SRC_B, B_SUFFIX, NAME, MR, MC_BLK,   \
+                          KC_BLK, NC_BLK)                                                          \
+    typedef struct {                                                                               \
+        const SRC_A *a;                                                                            \
+        size_t a_rs, a_cs;                                                                         \
+        const TYPE *prepacked_a;                                                                   \
+        const TYPE *packed_b;                                                                      \
+        TYPE *c;                                                                                   \
+        size_t ldc;                                                                                \
+        size_t M, kc, nc;                                                                          \
+        size_t mc, nb;                                                                             \
+        size_t n_blocks;                                                                           \
+        bool accumulate;                                                                           \
+        const hodu_cpu_gemm_epilogue_t *ep; /* set on the last K slab only */                      \
+        size_t col0;                        /* column of c within the full C */                    \
+    } gemm_##NAME##_tile_args_t;                                                                   \
+                                                                                                   \
+    /* Tiles [start, end) of the (M / mc) x (nc / nb) grid for one packed B slab */                \
+    static void gemm_##NAME##_tiles(size_t start, size_t end, void *arg) {                         \
+        gemm_##NAME##_tile_args_t *args = (gemm_##NAME##_tile_args_t *)arg;                        \
+        const size_t NR = TYPE_SUFFIX##_NR;                                                        \
+        const size_t kc = args->kc;                                                                \
+        TYPE *packed_a = NULL;                                                                     \
+        if (!args->prepacked_a) {                                                                  \
+            packed_a = (TYPE *)gemm_buffer_reserve(&gemm_pack_a,                                   \
+                                                   (args->mc + (MR)) * kc * sizeof(TYPE));         \
+            if (!packed_a) {                                                                       \
+                return;                                                                            \
+            }                                                                                      \
+        }                                                                                          \
+                                                                                                   \
+        size_t packed_block = (size_t)-1;                                                          \
+        for (size_t t = start; t < end; t++) {                                                     \
+            size_t mi = t / args->n_blocks;                                                        \
+            size_t ni = t % args->n_blocks;                                                        \
+            size_t ic = mi * args->mc;                                                             \
+            size_t mc = (args->M - ic < args->mc) ? (args->M - ic) : args->mc;                     \
+            size_t jb = ni * args->nb;                                                             \
+            if (jb >= args->nc) {                                                                  \
+                continue;                                                                          \
+            }                                                                                      \
+            size_t nb = (args->nc - jb < args->nb) ? (args->nc - jb) : args->nb;                   \
+                                                                                                   \
+            /* Consecutive tiles of one row block reuse the packed A block */                      \
+            const TYPE *pa = packed_a;                                                             \
+            if (args->prepacked_a) {                                                               \
+                pa = args->prepacked_a + ic * kc;                                                  \
+            } else if (packed_block != mi) {                                                       \
+                gemm_##A_SUFFIX##_pack_a(mc, kc, args->a + ic * args->a_rs, args->a_rs,            \
+                                           args->a_cs, packed_a);                                  \
+                packed_block = mi;                                                                 \
+            }                                                                                      \
+                                                                                                   \
+            for (size_t jr = 0; jr < nb; jr += NR) {                                               \
+                size_t nr = (nb - jr < NR) ? (nb - jr) : NR;                                       \
+                const TYPE *pb = args->packed_b + (jb + jr) * kc;                                  \
+                for (size_t ir = 0; ir < mc; ir += (MR)) {                                         \
+                    size_t mr = (mc - ir < (MR)) ? (mc - ir) : (MR);                               \
+                    TYPE *ct = args->c + (ic + ir) * args->ldc + jb + jr;                          \
+                    gemm_##TYPE_SUFFIX##_micro(kc, pa + ir * kc, pb, ct, args->ldc, mr, nr,        \
+                                               args->accumulate);                                  \
+                    if (args->ep) {                                                                \
+                        gemm_##TYPE_SUFFIX##_epilogue(args->ep, ct, args->ldc, ic + ir,            \
+                                                      args->col0 + jb + jr, mr, nr);               \
+                    }                                                                              \
+                }                                                                                  \
+            }                                                                                      \
+        }                                                                                          \
+    }                                                                                              \
+                                                                                                   \
+    /* A or B may be given pre-packed (see GEMM_PREPACK_IMPL); the source is then unused */        \
+    static void gemm_##NAME##_blocked(                                                             \
+        size_t M, size_t N, size_t K, const SRC_A *a, size_t a_rs, size_t a_cs,                    \
+        const TYPE *prepacked_a, const SRC_B *b, size_t b_rs, size_t b_cs,                         \
+        const TYPE *prepacked_b, TYPE *c, size_t ldc, const hodu_cpu_gemm_epilogue_t *ep) {        \
+        const size_t NR = TYPE_SUFFIX##_NR;                                                        \
+        if (M == 0 || N == 0) {                                                                    \
+            return;                                                                                \
+        }                                                                                          \
+        if (K == 0) {                                                                              \
+            for (size_t i = 0; i < M; i++) {                                                       \
+                memset(c + i * ldc, 0, N * sizeof(TYPE));                                          \
+            }                                                                                      \
+            if (ep) {                                                                              \
+                gemm_##TYPE_SUFFIX##_epilogue(ep, c, ldc, 0, 0, M, N);                             \
+            }                                                                                      \
+            return;                                                                                \
+        }                                                                                          \
+        /* The tile is vectors of TYPE when SIMD is available */                                   \
+        if (sizeof(gemm_##TYPE_SUFFIX##_vec_t) > sizeof(TYPE)) {                                   \
+            HODU_PROFILE_PATH(HODU_CPU_PATH_SIMD);                                                 \
+        }                                                                                          \
+                                                                                                   \
+        size_t kc_max = (K < (KC_BLK)) ? K : (KC_BLK);                                             \
+        size_t nc_max = (N < (NC_BLK)) ? N : (NC_BLK);                                             \
+        size_t nc_panels = (nc_max + NR - 1) / NR;                                                 \
+        TYPE *packed_b = NULL;                                                                     \
+        if (!prepacked_b) {                                                                        \
+            packed_b = (TYPE *)gemm_buffer_reserve(&gemm_pack_b,                                   \
+                                                   nc_panels * NR * kc_max * sizeof(TYPE));        \
+            if (!packed_b) {                                                                       \
+                return;                                                                            \
+            }                                                                                      \
+        }                                                                                          \
+        const size_t m_padded = (M + (MR) - 1) / (MR) * (MR);                                      \
+                                                                                                   \
+        /* Split rows first; split columns too when there are fewer row blocks than threads */     \
+        size_t num_threads = get_num_threads();                                                    \
+        bool parallel = num_threads > 1 && M * N * K >= GEMM_MIN_PARALLEL_WORK;                    \
+        size_t mc = (MC_BLK);                                                                      \
+        if (parallel && (M + mc - 1) / mc < num_threads) {                                         \
+            size_t rows = (M + num_threads - 1) / num_threads;                                     \
+            rows = (rows + (MR) - 1) / (MR) * (MR);                                                \
+            mc = (rows < 2 * (MR)) ? 2 * (MR) : rows;                                              \
+            if (mc > (MC_BLK)) {                                                                   \
+                mc = (MC_BLK);                                                                     \
+            }                                                                                      \
+        }                                                                                          \
+        size_t m_blocks = (M + mc - 1) / mc;                                                       \
+                                                                                                   \
+        for (size_t jc = 0; jc < N; jc += (NC_BLK)) {                                              \
+            size_t nc = (N - jc < (NC_BLK)) ? (N - jc) : (NC_BLK);                                 \
+            size_t panels = (nc + NR - 1) / NR;                                                    \
+                                                                                                   \
+            size_t n_blocks = 1;                                                                   \
+            if (parallel && m_blocks < num_threads) {                                              \
+                n_blocks = (num_threads + m_blocks - 1) / m_blocks;                                \
+                if (n_blocks > panels) {                                                           \
+                    n_blocks = panels;                                                             \
+                }                                                                                  \
+            }                                                                                      \
+            size_t nb = (panels + n_blocks - 1) / n_blocks * NR;                                   \
+            size_t num_tiles = m_blocks * n_blocks;                                                \
+                                                                                                   \
+            for (size_t pc = 0; pc < K; pc += (KC_BLK)) {                                          \
+                size_t kc = (K - pc < (KC_BLK)) ? (K - pc) : (KC_BLK);                             \
+                                                                                                   \
+                const TYPE *slab_b = packed_b;                                                     \
+                if (prepacked_b) {                                                                 \
+                    slab_b = prepacked_b + jc * K + pc * panels * NR;                              \
+                } else {                                                                           \
+                    gemm_##B_SUFFIX##_pack_b_args_t pack_args = {                                  \
+                        b + pc * b_rs + jc * b_cs, b_rs, b_cs, kc, nc, packed_b};                  \
+                    parallel_for(0, panels, parallel ? 4 : panels, gemm_##B_SUFFIX##_pack_b,       \
+                                 &pack_args);                                                      \
+                }                                                                                  \
+                                                                                                   \
+                gemm_##NAME##_tile_args_t tile_args = {                                            \
+                    a ? a + pc * a_cs : NULL, a_rs, a_cs,                                          \
+                    prepacked_a ? prepacked_a + pc * m_padded : NULL, slab_b, c + jc, ldc, M, kc,  \
+                    nc, mc, nb, n_blocks, pc > 0, pc + kc == K ? ep : NULL, jc};                   \
+                parallel_for(0, num_tiles, parallel ? 1 : num_tiles, gemm_##NAME##_tiles,          \
+                             &tile_args);                                                          \
+            }                                                                                      \
+        }                                                                                          \
+    }
+
+/// Packing and the blocked driver for one source type (gemm_<src>_pack_a/_b, gemm_<src>_blocked)
+#define GEMM_DRIVER_IMPL(TYPE, TYPE_SUFFIX, SRC, SRC_SUFFIX, LOAD_FN, MR, MC_BLK, KC_BLK, NC_BLK)  \
+    GEMM_PACK_IMPL(TYPE, TYPE_SUFFIX, SRC, SRC_SUFFIX, LOAD_FN, MR)                                \
+    GEMM_BLOCKED_IMPL(TYPE, TYPE_SUFFIX, SRC, SRC_SUFFIX, SRC, SRC_SUFFIX, SRC_SUFFIX, MR, MC_BLK, \
+                      KC_BLK, NC_BLK)
+
+/// Macro to implement a low-precision GEMM with f32 accumulation
+///
+/// A and B are widened to f32 while packing, the product accumulates in an
+/// f32 block (thread-local, grow-only) and is rounded to SRC once on store.
+///
+/// @param SRC C type of A, B and C
+/// @param SRC_SUFFIX Suffix for function naming
+/// @param FROM_F32 Conversion from f32 to SRC
+#define GEMM_MIXED_IMPL(SRC, SRC_SUFFIX, FROM_F32)                                                 \
+    void HODU_ISA_NAME(hodu_cpu_gemm_##SRC_SUFFIX)(size_t M, size_t N, size_t K, const SRC *a,     \
+                                                   size_t a_rs, size_t a_cs, const SRC *b,         \
+                                                   size_t b_rs, size_t b_cs, SRC *c, size_t ldc) { \
+        HODU_ISA_DISPATCH(hodu_cpu_gemm_##SRC_SUFFIX,                                              \
+                          (M, N, K, a, a_rs, a_cs, b, b_rs, b_cs, c, ldc));                        \
+        if (M == 0 || N == 0) {                                                                    \
+            return;                                                                                \
+        }                                                                                          \
+        f32_t *acc = (f32_t *)gemm_buffer_reserve(&gemm_acc, M * N * sizeof(f32_t));               \
+        if (!acc) {                                                                                \
+            return;                                                                                \
+        }                                                                                          \
+                                                                                                   \
+        gemm_##SRC_SUFFIX##_blocked(M, N, K, a, a_rs, a_cs, NULL, b, b_rs, b_cs, NULL, acc, N,     \
+                                    NULL);                                                         \
+        for (size_t i = 0; i < M; i++) {                                                           \
+            for (size_t j = 0; j < N; j++) {                                                       \
+                c[i * ldc + j] = FROM_F32(acc[i * N + j]);                                         \
+            }                                                                                      \
+        }                                                                                          \
+    }
+
+/// Macro to implement weight pre-packing for one floating-point type
+///
+/// Packed operands hold every (NC, KC) slab in the exact layout the blocked
+/// driver packs on the fly, so calls with a pre-packed operand skip packing:
+/// - lhs: KC slabs in order, each ceil(M / MR) MR-row panels of kc x MR
+/// - rhs: NC slabs in order, each holding KC slabs of ceil(nc / NR) kc x NR panels
+/// The layout depends on the SIMD width of the running ISA variant and is not portable.
+///
+/// @param TYPE C type for the operation
+/// @param TYPE_SUFFIX Suffix for function naming
+/// @param MR Microkernel rows
+/// @param KC_BLK Depth per packed slab
+/// @param NC_BLK Columns per packed B slab
+#define GEMM_PREPACK_IMPL(TYPE, TYPE_SUFFIX, MR, KC_BLK, NC_BLK)                                   \
+    uint64_t HODU_ISA_NAME(hodu_cpu_gemm_packed_layout_##TYPE_SUFFIX)(void) {                      \
+        HODU_ISA_DISPATCH_VALUE(hodu_cpu_gemm_packed_layout_##TYPE_SUFFIX, ());                    \
+        return (uint64_t)(MR) | (uint64_t)TYPE_SUFFIX##_NR << 8 | (uint64_t)(KC_BLK) << 16 |       \
+               (uint64_t)(NC_BLK) << 32;                                                           \
+    }                                                                                              \
+                                                                                                   \
+    size_t HODU_ISA_NAME(hodu_cpu_gemm_packed_lhs_size_##TYPE_SUFFIX)(size_t M, size_t K) {        \
+        HODU_ISA_DISPATCH_VALUE(hodu_cpu_gemm_packed_lhs_size_##TYPE_SUFFIX, (M, K));              \
+        return (M + (MR) - 1) / (MR) * (MR) * K;                                                   \
+    }                                                                                              \
+                                                                                                   \
+    size_t HODU_ISA_NAME(hodu_cpu_gemm_packed_rhs_size_##TYPE_SUFFIX)(size_t K, size_t N) {        \
+        HODU_ISA_DISPATCH_VALUE(hodu_cpu_gemm_packed_rhs_size_##TYPE_SUFFIX, (K, N));              \
+        const size_t NR = TYPE_SUFFIX##_NR;                                                        \
+        return (N + NR - 1) / NR * NR * K;                                                         \
+    }                                                                                              \
+                                                                                                   \
+    void HODU_ISA_NAME(hodu_cpu_gemm_pack_lhs_##TYPE_SUFFIX)(size_t M, size_t K, const TYPE *a,    \
+                                                             size_t a_rs, size_t a_cs,             \
+                                                             TYPE *packed) {                       \
+        HODU_ISA_DISPATCH(hodu_cpu_gemm_pack_lhs_##TYPE_SUFFIX, (M, K, a, a_rs, a_cs, packed));    \
+        const size_t m_padded = (M + (MR) - 1) / (MR) * (MR);                                      \
+        for (size_t pc = 0; pc < K; pc += (KC_BLK)) {                                              \
+            size_t kc = (K - pc < (KC_BLK)) ? (K - pc) : (KC_BLK);                                 \
+            gemm_##TYPE_SUFFIX##_pack_a(M, kc, a + pc * a_cs, a_rs, a_cs, packed + pc * m_padded); \
+        }                                                                                          \
+    }                                                                                              \
+                                                                                                   \
+    void HODU_ISA_NAME(hodu_cpu_gemm_pack_rhs_##TYPE_SUFFIX)(size_t K, size_t N, const TYPE *b,    \
+                                                             size_t b_rs, size_t b_cs,             \
+                                                             TYPE *packed) {                       \
+        HODU_ISA_DISPATCH(hodu_cpu_gemm_pack_rhs_##TYPE_SUFFIX, (K, N, b, b_rs, b_cs, packed));    \
+        const size_t NR = TYPE_SUFFIX##_NR;                                                        \
+        for (size_t jc = 0; jc < N; jc += (NC_BLK)) {                                              \
+            size_t nc = (N - jc < (NC_BLK)) ? (N - jc) : (NC_BLK);                                 \
+            size_t panels = (nc + NR - 1) / NR;                                                    \
+            for (size_t pc = 0; pc < K; pc += (KC_BLK)) {                                          \
+                size_t kc = (K - pc < (KC_BLK)) ? (K - pc) : (KC_BLK);                             \
+                gemm_##TYPE_SUFFIX##_pack_b_args_t pack_args = {                                   \
+                    b + pc * b_rs + jc * b_cs, b_rs, b_cs, kc, nc,                                 \
+                    packed + jc * K + pc * panels * NR};                                           \
+                parallel_for(0, panels, 4, gemm_##TYPE_SUFFIX##_pack_b, &pack_args);               \
+            }                                                                                      \
+        }                                                                                          \
+    }                                                                                              \
+                                                                                                   \
+    void HODU_ISA_NAME(hodu_cpu_gemm_packed_lhs_##TYPE_SUFFIX)(                                    \
+        size_t M, size_t N, size_t K, const TYPE *packed_a, const TYPE *b, size_t b_rs,            \
+        size_t b_cs, TYPE *c, size_t ldc, const hodu_cpu_gemm_epilogue_t *ep) {                    \
+        HODU_ISA_DISPATCH(hodu_cpu_gemm_packed_lhs_##TYPE_SUFFIX,                                  \
+                          (M, N, K, packed_a, b, b_rs, b_cs, c, ldc, ep));                         \
+        gemm_##TYPE_SUFFIX##_blocked(M, N, K, NULL, 0, 0, packed_a, b, b_rs, b_cs, NULL, c, ldc,   \
+                                     ep);                                                          \
+    }                                                                                              \
+                                                                                                   \
+    void HODU_ISA_NAME(hodu_cpu_gemm_packed_rhs_##TYPE_SUFFIX)(                                    \
+        size_t M, size_t N, size_t K, const TYPE *a, size_t a_rs, size_t a_cs,                     \
+        const TYPE *packed_b, TYPE *c, size_t ldc, const hodu_cpu_gemm_epilogue_t *ep) {           \
+        HODU_ISA_DISPATCH(hodu_cpu_gemm_packed_rhs_##TYPE_SUFFIX,                                  \
+                          (M, N, K, a, a_rs, a_cs, packed_b, c, ldc, ep));                         \
+        gemm_##TYPE_SUFFIX##_blocked(M, N, K, a, a_rs, a_cs, NULL, NULL, 0, 0, packed_b, c, ldc,   \
+                                     ep);                                                          \
+    }
+
+/// Macro to implement the fused epilogue applied to one finished C tile
+///
+/// C[i, j] = activation(scale * C[i, j] + bias + R[i, j]) for the mr x nr tile
+/// at (row0, col0) of the full C; each term is one streaming pass over the tile.
+///
+/// @param TYPE C type of C, bias and residual
+/// @param TYPE_SUFFIX Suffix for function naming (selects the math_utils helpers)
+/// @param EXP_FN Exponential for TYPE
+/// @param TANH_FN Hyperbolic tangent for TYPE
+#define GEMM_EPILOGUE_IMPL(TYPE, TYPE_SUFFIX, EXP_FN, TANH_FN)                                     \
+    static void gemm_##TYPE_SUFFIX##_epilogue(const hodu_cpu_gemm_epilogue_t *ep, TYPE *c,         \
+                                              size_t ldc, size_t row0, size_t col0, size_t mr,     \
+                                              size_t nr) {                                         \
+        const TYPE scale = (TYPE)ep->scale;                                                        \
+        const TYPE *bias = (const TYPE *)ep->bias;                                                 \
+        const TYPE *residual = (const TYPE *)ep->residual;                                         \
+        for (size_t i = 0; i < mr; i++) {                                                          \
+            TYPE *row = c + i * ldc;                                                               \
+            const TYPE row_bias = (bias && ep->bias_per_row) ? bias[row0 + i] : (TYPE)0;           \
+            for (size_t j = 0; j < nr; j++) {                                                      \
+                row[j] = row[j] * scale + row_bias;                                                \
+            }                                                                                      \
+            if (bias && !ep->bias_per_row) {                                                       \
+                for (size_t j = 0; j < nr; j++) {                                                  \
+                    row[j] += bias[col0 + j];                                                      \
+                }                                                                                  \
+            }                                                                                      \
+            if (residual) {                                                                        \
+                const TYPE *r = residual + (row0 + i) * ep->ldr + col0;                            \
+                for (size_t j = 0; j < nr; j++) {                                                  \
+                    row[j] += r[j];                                                                \
+                }                                                                                  \
+            }                                                                                      \
+            switch (ep->activation) {                                                              \
+            case HODU_CPU_ACTIVATION_RELU:                                                         \
+                for (size_t j = 0; j < nr; j++) {                                                  \
+                    row[j] = row[j] > (TYPE)0 ? row[j] : (TYPE)0;                                  \
+                }                                                                                  \
+                break;                                                                             \
+            case HODU_CPU_ACTIVATION_GELU:                                                         \
+                for (size_t j = 0; j < nr; j++) {                                                  \
+                    row[j] = gelu_helper_##TYPE_SUFFIX(row[j]);                                    \
+                }                                                                                  \
+                break;                                                                             \
+            case HODU_CPU_ACTIVATION_SILU:                                                         \
+                for (size_t j = 0; j < nr; j++) {                                                  \
+                    row[j] = silu_helper_##TYPE_SUFFIX(row[j]);                                    \
+                }                                                                                  \
+                break;                                                                             \
+            case HODU_CPU_ACTIVATION_SIGMOID:                                                      \
+                for (size_t j = 0; j < nr; j++) {                                                  \
+                    row[j] = (TYPE)1 / ((TYPE)1 + EXP_FN(-row[j]));                                \
+                }                                                                                  \
+                break;                                                                             \
+            case HODU_CPU_ACTIVATION_TANH:                                                         \
+                for (size_t j = 0; j < nr; j++) {                                                  \
+                    row[j] = TANH_FN(row[j]);                                                      \
+                }                                                                                  \
+                break;                                                                             \
+            default:                                                                               \
+                break;                                                                             \
+            }                                                                                      \
+        }                                                                                          \
+    }
+
+GEMM_KERNEL_IMPL(f32_t, f32, gemm_f32, SIMD_F32_WIDTH, GEMM_F32_MR, GEMM_F32_NV)
+GEMM_KERNEL_IMPL(f64_t, f64, gemm_f64, SIMD_F64_WIDTH, GEMM_F64_MR, GEMM_F64_NV)
+GEMM_EPILOGUE_IMPL(f32_t, f32, expf, tanhf)
+GEMM_EPILOGUE_IMPL(f64_t, f64, exp, tanh)
+
+static inline f32_t gemm_load_f32(f32_t v) { return v; }
+static inline f64_t gemm_load_f64(f64_t v) { return v; }
+
+GEMM_DRIVER_IMPL(f32_t, f32, f32_t, f32, gemm_load_f32, GEMM_F32_MR, GEMM_F32_MC, GEMM_F32_KC,
+                 GEMM_F32_NC)
+GEMM_DRIVER_IMPL(f64_t, f64, f64_t, f64, gemm_load_f64, GEMM_F64_MR, GEMM_F64_MC, GEMM_F64_KC,
+                 GEMM_F64_NC)
+
+void HODU_ISA_NAME(hodu_cpu_gemm_f32)(size_t M, size_t N, size_t K, const f32_t *a, size_t a_rs,
+                                      size_t a_cs, const f32_t *b, size_t b_rs, size_t b_cs,
+                                      f32_t *c, size_t ldc) {
+    HODU_ISA_DISPATCH(hodu_cpu_gemm_f32, (M, N, K, a, a_rs, a_cs, b, b_rs, b_cs, c, ldc));
+    gemm_f32_blocked(M, N, K, a, a_rs, a_cs, NULL, b, b_rs, b_cs, NULL, c, ldc, NULL);
+}
+
+void HODU_ISA_NAME(hodu_cpu_gemm_fused_f32)(size_t M, size_t N, size_t K, const f32_t *a,
+                                            size_t a_rs, size_t a_cs, const f32_t *b, size_t b_rs,
+                                            size_t b_cs, f32_t *c, size_t ldc,
+                                            const hodu_cpu_gemm_epilogue_t *ep) {
+    HODU_ISA_DISPATCH(hodu_cpu_gemm_fused_f32,
+                      (M, N, K, a, a_rs, a_cs, b, b_rs, b_cs, c, ldc, ep));
+    gemm_f32_blocked(M, N, K, a, a_rs, a_cs, NULL, b, b_rs, b_cs, NULL, c, ldc, ep);
+}
+
+void HODU_ISA_NAME(hodu_cpu_gemm_f64)(size_t M, size_t N, size_t K, const f64_t *a, size_t a_rs,
+                                      size_t a_cs, const f64_t *b, size_t b_rs, size_t b_cs,
+                                      f64_t *c, size_t ldc) {
+    HODU_ISA_DISPATCH(hodu_cpu_gemm_f64, (M, N, K, a, a_rs, a_cs, b, b_rs, b_cs, c, ldc));
+    gemm_f64_blocked(M, N, K, a, a_rs, a_cs, NULL, b, b_rs, b_cs, NULL, c, ldc, NULL);
+}
+
+void HODU_ISA_NAME(hodu_cpu_gemm_fused_f64)(size_t M, size_t N, size_t K, const f64_t *a,
+                                            size_t a_rs, size_t a_cs, const f64_t *b, size_t b_rs,
+                                            size_t b_cs, f64_t *c, size_t ldc,
+                                            const hodu_cpu_gemm_epilogue_t *ep) {
+    HODU_ISA_DISPATCH(hodu_cpu_gemm_fused_f64,
+                      (M, N, K, a, a_rs, a_cs, b, b_rs, b_cs, c, ldc, ep));
+    gemm_f64_blocked(M, N, K, a, a_rs, a_cs, NULL, b, b_rs, b_cs, NULL, c, ldc, ep);
+}
+
+GEMM_PREPACK_IMPL(f32_t, f32, GEMM_F32_MR, GEMM_F32_KC, GEMM_F32_NC)
+GEMM_PREPACK_IMPL(f64_t, f64, GEMM_F64_MR, GEMM_F64_KC, GEMM_F64_NC)
+
+// Low-precision types reuse the f32 microkernel on panels widened during packing
+GEMM_DRIVER_IMPL(f32_t, f32, bf16_t, bf16, bf16_to_float, GEMM_F32_MR, GEMM_F32_MC, GEMM_F32_KC,
+                 GEMM_F32_NC)
+GEMM_DRIVER_IMPL(f32_t, f32, f16_t, f16, f16_to_float, GEMM_F32_MR, GEMM_F32_MC, GEMM_F32_KC,
+                 GEMM_F32_NC)
+GEMM_DRIVER_IMPL(f32_t, f32, f8e4m3_t, f8e4m3, f8e4m3_to_float, GEMM_F32_MR, GEMM_F32_MC,
+                 GEMM_F32_KC, GEMM_F32_NC)
+GEMM_DRIVER_IMPL(f32_t, f32, f8e5m2_t, f8e5m2, f8e5m2_to_float, GEMM_F32_MR, GEMM_F32_MC,
+                 GEMM_F32_KC, GEMM_F32_NC)
+
+GEMM_MIXED_IMPL(bf16_t, bf16, float_to_bf16)
+GEMM_MIXED_IMPL(f16_t, f16, float_to_f16)
+GEMM_MIXED_IMPL(f8e4m3_t, f8e4m3, float_to_f8e4m3)
+GEMM_MIXED_IMPL(f8e5m2_t, f8e5m2, float_to_f8e5m2)
+
+/// Macro to implement an f32 GEMM against a low-precision B (weights cast on load)
+///
+/// A is packed as f32, B is widened from SRC while its panels are packed and C is f32, so
+/// no converted copy of B is ever materialized.
+///
+/// @param SRC C type of B
+/// @param SRC_SUFFIX Suffix for function naming
+#define GEMM_WEIGHT_IMPL(SRC, SRC_SUFFIX)                                                          \
+    GEMM_BLOCKED_IMPL(f32_t, f32, f32_t, f32, SRC, SRC_SUFFIX, f32_##SRC_SUFFIX, GEMM_F32_MR,      \
+                      GEMM_F32_MC, GEMM_F32_KC, GEMM_F32_NC)                                       \
+                                                                                                   \
+    void HODU_ISA_NAME(hodu_cpu_gemm_f32_##SRC_SUFFIX)(size_t M, size_t N, size_t K,               \
+                                                       const f32_t *a, size_t a_rs, size_t a_cs,   \
+                                                       const SRC *b, size_t b_rs, size_t b_cs,     \
+                                                       f32_t *c, size_t ldc) {                     \
+        HODU_ISA_DISPATCH(hodu_cpu_gemm_f32_##SRC_SUFFIX,                                          \
+                          (M, N, K, a, a_rs, a_cs, b, b_rs, b_cs, c, ldc));                        \
+        gemm_f32_##SRC_SUFFIX##_blocked(M, N, K, a, a_rs, a_cs, NULL, b, b_rs, b_cs, NULL, c, ldc, \
+                                        NULL);                                                     \
+    }
+
+GEMM_WEIGHT_IMPL(bf16_t, bf16)
+GEMM_WEIGHT_IMPL(f16_t, f16)
+GEMM_WEIGHT_IMPL(f8e4m3_t, f8e4m3)
+GEMM_WEIGHT_IMPL(f8e5m2_t, f8e5m2)
+
+// ============================================================================
+// QUANTIZED GEMM (u8 x i8 -> i32)
+// ============================================================================
+//
+// K is consumed in groups of QGEMM_KG values so that one multiply-accumulate
+// instruction handles a whole group per output lane:
+// - AVX-512 VNNI: vpdpbusd on u8 x i8 groups of 4
+// - ARM dotprod: sdot on i8 x i8 groups of 4; lhs is shifted by -128 while
+//   packing and 128 * colsum(B) is added back at the end
+// - AVX2: vpmaddwd on i16 x i16 pairs, exact (no vpmaddubsw i16 saturation)
+// - Otherwise: scalar i16 products left to the auto-vectorizer
+//
+// Packed A panels are [k group][MR][KG], packed B panels [k group][NR][KG];
+// both are zero-padded. Blocking and threading follow the float driver.
+
+#if defined(SIMD_AVX512) && defined(__AVX512VNNI__)
+#define QGEMM_KG 4
+#define QGEMM_LANES 16
+#define QGEMM_MR 6
+#define QGEMM_NV 2
+#define QGEMM_A_SHIFT 0
+typedef uint8_t qgemm_a_t;
+typedef int8_t qgemm_b_t;
+typedef __m512i qgemm_vec_t;
+static inline qgemm_vec_t qgemm_zero(void) { return _mm512_setzero_si512(); }
+static inline qgemm_vec_t qgemm_dot(qgemm_vec_t acc, const qgemm_a_t *a, const qgemm_b_t *b) {
+    int32_t a4;
+    memcpy(&a4, a, sizeof(a4));
+    return _mm512_dpbusd_epi32(acc, _mm512_set1_epi32(a4), _mm512_loadu_si512((const void *)b));
+}
+static inline void qgemm_store(int32_t *p, qgemm_vec_t v) { _mm512_storeu_si512((void *)p, v); }
+#define QGEMM_LOAD_A(x) ((qgemm_a_t)(x))
+#elif defined(SIMD_ARM_NEON) && defined(__ARM_FEATURE_DOTPROD)
+#define QGEMM_KG 4
+#define QGEMM_LANES 4
+#define QGEMM_MR 6
+#define QGEMM_NV 4
+#define QGEMM_A_SHIFT 128
+typedef int8_t qgemm_a_t;
+typedef int8_t qgemm_b_t;
+typedef int32x4_t qgemm_vec_t;
+static inline qgemm_vec_t qgemm_zero(void) { return vdupq_n_s32(0); }
+static inline qgemm_vec_t qgemm_dot(qgemm_vec_t acc, const qgemm_a_t *a, const qgemm_b_t *b) {
+    int32_t a4;
+    memcpy(&a4, a, sizeof(a4));
+    return vdotq_s32(acc, vld1q_s8(b), vreinterpretq_s8_s32(vdupq_n_s32(a4)));
+}
+static inline void qgemm_store(int32_t *p, qgemm_vec_t v) { vst1q_s32(p, v); }
+#define QGEMM_LOAD_A(x) ((qgemm_a_t)((x) ^ 0x80))
+#elif defined(SIMD_AVX2)
+#define QGEMM_KG 2
+#define QGEMM_LANES 8
+#define QGEMM_MR 6
+#define QGEMM_NV 2
+#define QGEMM_A_SHIFT 0
+typedef int16_t qgemm_a_t;
+typedef int16_t qgemm_b_t;
+typedef __m256i qgemm_vec_t;
+static inline qgemm_vec_t qgemm_zero(void) { return _mm256_setzero_si256(); }
+static inline qgemm_vec_t qgemm_dot(qgemm_vec_t acc, const qgemm_a_t *a, const qgemm_b_t *b) {
+    int32_t a2;
+    memcpy(&a2, a, sizeof(a2));
+    return _mm256_add_epi32(
+        acc, _mm256_madd_epi16(_mm256_set1_epi32(a2), _mm256_loadu_si256((const __m256i *)b)));
+}
+static inline void qgemm_store(int32_t *p, qgemm_vec_t v) { _mm256_storeu_si256((__m256i *)p, v); }
+#define QGEMM_LOAD_A(x) ((qgemm_a_t)(x))
+#else
+#define QGEMM_KG 1
+#define QGEMM_LANES 1
+#define QGEMM_MR 4
+#define QGEMM_NV 4
+#define QGEMM_A_SHIFT 0
+typedef int16_t qgemm_a_t;
+typedef int16_t qgemm_b_t;
+typedef int32_t qgemm_vec_t;
+static inline qgemm_vec_t qgemm_zero(void) { return 0; }
+static inline qgemm_vec_t qgemm_dot(qgemm_vec_t acc, const qgemm_a_t *a, const qgemm_b_t *b) {
+    return acc + (int32_t)a[0] * b[0];
+}
+static inline void qgemm_store(int32_t *p, qgemm_vec_t v) { *p = v; }
+#define QGEMM_LOAD_A(x) ((qgemm_a_t)(x))
+#endif
+
+#define QGEMM_NR (QGEMM_NV * QGEMM_LANES)
+#define QGEMM_MC 96
+#define QGEMM_KC 1024
+#define QGEMM_NC 1024
+
+/* C[0:mr, 0:nr] (+)= packed A panel (kg groups x MR) @ packed B panel (kg groups x NR) */
+static inline void qgemm_micro(size_t kg, const qgemm_a_t *a, const qgemm_b_t *b, int32_t *c,
+                               size_t ldc, size_t mr, size_t nr, bool accumulate) {
+    qgemm_vec_t acc[QGEMM_MR][QGEMM_NV];
+    for (size_t i = 0; i < QGEMM_MR; i++) {
+        for (size_t v = 0; v < QGEMM_NV; v++) {
+            acc[i][v] = qgemm_zero();
+        }
+    }
+
+    for (size_t p = 0; p < kg; p++) {
+        const qgemm_a_t *ap = a + p * QGEMM_MR * QGEMM_KG;
+        const qgemm_b_t *bp = b + p * QGEMM_NR * QGEMM_KG;
+        for (size_t i = 0; i < QGEMM_MR; i++) {
+            for (size_t v = 0; v < QGEMM_NV; v++) {
+                acc[i][v] = qgemm_dot(acc[i][v], ap + i * QGEMM_KG,
+                                      bp + v * QGEMM_LANES * QGEMM_KG);
+            }
+        }
+    }
+
+    int32_t tile[QGEMM_MR * QGEMM_NR];
+    for (size_t i = 0; i < QGEMM_MR; i++) {
+        for (size_t v = 0; v < QGEMM_NV; v++) {
+            qgemm_store(tile + i * QGEMM_NR + v * QGEMM_LANES, acc[i][v]);
+        }
+    }
+    for (size_t i = 0; i < mr; i++) {
+        for (size_t j = 0; j < nr; j++) {
+            int32_t r = tile[i * QGEMM_NR + j];
+            c[i * ldc + j] = accumulate ? c[i * ldc + j] + r : r;
+        }
+    }
+}
+
+/* Pack A[0:mc, 0:kc] into MR-row panels of K groups: panel[(p * MR + i) * KG + g] */
+static void qgemm_pack_a(size_t mc, size_t kc, const uint8_t *a, size_t a_rs, size_t a_cs,
+                         qgemm_a_t *dst) {
+    const size_t kg = (kc + QGEMM_KG - 1) / QGEMM_KG;
+    for (size_t ir = 0; ir < mc; ir += QGEMM_MR) {
+        size_t mr = (mc - ir < QGEMM_MR) ? (mc - ir) : QGEMM_MR;
+        const uint8_t *src = a + ir * a_rs;
+        for (size_t p = 0; p < kg; p++) {
+            for (size_t i = 0; i < QGEMM_MR; i++) {
+                for (size_t g = 0; g < QGEMM_KG; g++) {
+                    size_t k = p * QGEMM_KG + g;
+                    dst[i * QGEMM_KG + g] =
+                        (i < mr && k < kc) ? QGEMM_LOAD_A(src[i * a_rs + k * a_cs]) : 0;
+                }
+            }
+            dst += QGEMM_MR * QGEMM_KG;
+        }
+    }
+}
+
+typedef struct {
+    const int8_t *b;
+    size_t b_rs, b_cs;
+    size_t kc, nc;
+    qgemm_b_t *dst;
+} qgemm_pack_b_args_t;
+
+/* Pack NR-column panels [start, end) of B[0:kc, 0:nc]: panel[(p * NR + j) * KG + g] */
+static void qgemm_pack_b(size_t start, size_t end, void *arg) {
+    qgemm_pack_b_args_t *args = (qgemm_pack_b_args_t *)arg;
+    const size_t kg = (args->kc + QGEMM_KG - 1) / QGEMM_KG;
+    for (size_t panel = start; panel < end; panel++) {
+        size_t jr = panel * QGEMM_NR;
+        size_t nr = (args->nc - jr < QGEMM_NR) ? (args->nc - jr) : QGEMM_NR;
+        const int8_t *src = args->b + jr * args->b_cs;
+        qgemm_b_t *dst = args->dst + panel * QGEMM_NR * kg * QGEMM_KG;
+        for (size_t p = 0; p < kg; p++) {
+            for (size_t j = 0; j < QGEMM_NR; j++) {
+                for (size_t g = 0; g < QGEMM_KG; g++) {
+                    size_t k = p * QGEMM_KG + g;
+                    dst[j * QGEMM_KG + g] =
+                        (j < nr && k < args->kc) ? src[k * args->b_rs + j * args->b_cs] : 0;
+                }
+            }
+            dst += QGEMM_NR * QGEMM_KG;
+        }
+    }
+}
+
+typedef struct {
+    const uint8_t *a;
+    size_t a_rs, a_cs;
+    const qgemm_b_t *packed_b;
+    int32_t *c;
+    size_t ldc;
+    size_t M, kc, nc;
+    size_t mc, nb;
+    size_t n_blocks;
+    bool accumulate;
+} qgemm_tile_args_t;
+
+/* Tiles [start, end) of the (M / mc) x (nc / nb) grid for one packed B slab */
+static void qgemm_tiles(size_t start, size_t end, void *arg) {
+    qgemm_tile_args_t *args = (qgemm_tile_args_t *)arg;
+    const size_t kg = (args->kc + QGEMM_KG - 1) / QGEMM_KG;
+    qgemm_a_t *packed_a = (qgemm_a_t *)gemm_buffer_reserve(
+        &gemm_pack_a, (args->mc + QGEMM_MR) * kg * QGEMM_KG * sizeof(qgemm_a_t));
+    if (!packed_a) {
+        return;
+    }
+
+    size_t packed_block = (size_t)-1;
+    for (size_t t = start; t < end; t++) {
+        size_t mi = t / args->n_blocks;
+        size_t ni = t % args->n_blocks;
+        size_t ic = mi * args->mc;
+        size_t mc = (args->M - ic < args->mc) ? (args->M - ic) : args->mc;
+        size_t jb = ni * args->nb;
+        if (jb >= args->nc) {
+            continue;
+        }
+        size_t nb = (args->nc - jb < args->nb) ? (args->nc - jb) : args->nb;
+
+        if (packed_block != mi) {
+            qgemm_pack_a(mc, args->kc, args->a + ic * args->a_rs, args->a_rs, args->a_cs,
+                         packed_a);
+            packed_block = mi;
+        }
+
+        for (size_t jr = 0; jr < nb; jr += QGEMM_NR) {
+            size_t nr = (nb - jr < QGEMM_NR) ? (nb - jr) : QGEMM_NR;
+            const qgemm_b_t *pb = args->packed_b + (jb + jr) * kg * QGEMM_KG;
+            for (size_t ir = 0; ir < mc; ir += QGEMM_MR) {
+                size_t mr = (mc - ir < QGEMM_MR) ? (mc - ir) : QGEMM_MR;
+                qgemm_micro(kg, packed_a + ir * kg * QGEMM_KG, pb,
+                            args->c + (ic + ir) * args->ldc + jb + jr, args->ldc, mr, nr,
+                            args->accumulate);
+            }
+        }
+    }
+}
+
+void HODU_ISA_NAME(hodu_cpu_gemm_u8i8_i32)(size_t M, size_t N, size_t K, const uint8_t *a,
+                                           size_t a_rs, size_t a_cs, const int8_t *b, size_t b_rs,
+                                           size_t b_cs, int32_t *c, size_t ldc) {
+    HODU_ISA_DISPATCH(hodu_cpu_gemm_u8i8_i32, (M, N, K, a, a_rs, a_cs, b, b_rs, b_cs, c, ldc));
+    if (M == 0 || N == 0) {
+        return;
+    }
+    if (K == 0) {
+        for (size_t i = 0; i < M; i++) {
+            memset(c + i * ldc, 0, N * sizeof(int32_t));
+        }
+        return;
+    }
+
+    size_t kc_max = (K < QGEMM_KC) ? K : QGEMM_KC;
+    size_t nc_max = (N < QGEMM_NC) ? N : QGEMM_NC;
+    size_t kg_max = (kc_max + QGEMM_KG - 1) / QGEMM_KG;
+    size_t nc_panels = (nc_max + QGEMM_NR - 1) / QGEMM_NR;
+    qgemm_b_t *packed_b = (qgemm_b_t *)gemm_buffer_reserve(
+        &gemm_pack_b, nc_panels * QGEMM_NR * kg_max * QGEMM_KG * sizeof(qgemm_b_t));
+    if (!packed_b) {
+        return;
+    }
+
+    size_t num_threads = get_num_threads();
+    bool parallel = num_threads > 1 && M * N * K >= GEMM_MIN_PARALLEL_WORK;
+    size_t mc = QGEMM_MC;
+    if (parallel && (M + mc - 1) / mc < num_threads) {
+        size_t rows = (M + num_threads - 1) / num_threads;
+        rows = (rows + QGEMM_MR - 1) / QGEMM_MR * QGEMM_MR;
+        mc = (rows < 2 * QGEMM_MR) ? 2 * QGEMM_MR : rows;
+        if (mc > QGEMM_MC) {
+            mc = QGEMM_MC;
+        }
+    }
+    size_t m_blocks = (M + mc - 1) / mc;
+
+    for (size_t jc = 0; jc < N; jc += QGEMM_NC) {
+        size_t nc = (N - jc < QGEMM_NC) ? (N - jc) : QGEMM_NC;
+        size_t panels = (nc + QGEMM_NR - 1) / QGEMM_NR;
+
+        size_t n_blocks = 1;
+        if (parallel && m_blocks < num_threads) {
+            n_blocks = (num_threads + m_blocks - 1) / m_blocks;
+            if (n_blocks > panels) {
+                n_blocks = panels;
+            }
+        }
+        size_t nb = (panels + n_blocks - 1) / n_blocks * QGEMM_NR;
+        size_t num_tiles = m_blocks * n_blocks;
+
+        for (size_t pc = 0; pc < K; pc += QGEMM_KC) {
+            size_t kc = (K - pc < QGEMM_KC) ? (K - pc) : QGEMM_KC;
+
+            qgemm_pack_b_args_t pack_args = {b + pc * b_rs + jc * b_cs, b_rs, b_cs, kc, nc,
+                                             packed_b};
+            parallel_for(0, panels, parallel ? 4 : panels, qgemm_pack_b, &pack_args);
+
+            qgemm_tile_args_t tile_args = {a + pc * a_cs, a_rs, a_cs, packed_b, c + jc, ldc, M,
+                                           kc, nc, mc, nb, n_blocks, pc > 0};
+            parallel_for(0, num_tiles, parallel ? 1 : num_tiles, qgemm_tiles, &tile_args);
+        }
+    }
+
+#if QGEMM_A_SHIFT
+    /* Undo the lhs shift: sum_k a * b = sum_k (a - 128) * b + 128 * sum_k b */
+    int32_t *col_sum = (int32_t *)calloc(N, sizeof(int32_t));
+    if (!col_sum) {
+        return;
+    }
+    for (size_t k = 0; k < K; k++) {
+        for (size_t j = 0; j < N; j++) {
+            col_sum[j] += b[k * b_rs + j * b_cs];
+        }
+    }
+    for (size_t i = 0; i < M; i++) {
+        for (size_t j = 0; j < N; j++) {
+            c[i * ldc + j] += QGEMM_A_SHIFT * col_sum[j];
+        }
+    }
+    free(col_sum);
+#endif
+}
+
+// ============================================================================
+// WEIGHT-ONLY QUANTIZED GEMM (f32 x int4/int8 -> f32)
+// ============================================================================
+//
+// Decode-time matmuls are GEMVs whose cost is reading the weights, so B stays
+// in its int4/int8 form and is never packed or dequantized into memory. Rows
+// are consumed in blocks of WQ_BLOCK weights, widened and dequantized in
+// registers,
+//   w = q * scale + (-zero_point * scale)
+// with one FMA per vector, then multiplied against 1 or 2 rows of A. A tile
+// covers 2 rows (1 for a last odd row) x WQ_NR columns, the independent B rows
+// keeping the FMA pipes busy when M = 1; all row blocks of a column tile run
+// back to back while its B rows are in L1. Column tiles are distributed over
+// the thread pool.
+// - AVX-512 / AVX2: sign/zero-extending byte loads; an int4 block splits into
+//   its low and high nibbles with one mask and one shift
+// - Otherwise: blocks widened through a small stack buffer
+
+#define WQ_BLOCK 32
+#define WQ_NR 4
+#define WQ_GROUP_CHUNK 16
+
+static inline f32_t wq_value_q8(const int8_t *row, size_t k) { return (f32_t)row[k]; }
+
+/* int4 block of 32 values in 16 bytes: value i in the low nibble of byte i % 16 for i < 16,
+ * in the high nibble for i >= 16 */
+static inline f32_t wq_value_q4(const uint8_t *row, size_t k) {
+    uint8_t byte = row[k / WQ_BLOCK * (WQ_BLOCK / 2) + k % (WQ_BLOCK / 2)];
+    return (f32_t)((k % WQ_BLOCK < WQ_BLOCK / 2) ? (byte & 0x0F) : (byte >> 4));
+}
+
+// wq_load_<q>(row, k, v): the WQ_BLOCK weights starting at k (a multiple of
+// WQ_BLOCK) as WQ_VECS vectors of consecutive values
+#if defined(SIMD_AVX512)
+#define WQ_LANES 16
+static inline void wq_load_q8(const int8_t *row, size_t k, simd_f32_t *v) {
+    for (size_t h = 0; h < 2; h++) {
+        __m128i bytes = _mm_loadu_si128((const __m128i *)(row + k + h * 16));
+        v[h] = _mm512_cvtepi32_ps(_mm512_cvtepi8_epi32(bytes));
+    }
+}
+static inline void wq_load_q4(const uint8_t *row, size_t k, simd_f32_t *v) {
+    __m512i x = _mm512_cvtepu8_epi32(_mm_loadu_si128((const __m128i *)(row + k / 2)));
+    v[0] = _mm512_cvtepi32_ps(_mm512_and_si512(x, _mm512_set1_epi32(0x0F)));
+    v[1] = _mm512_cvtepi32_ps(_mm512_srli_epi32(x, 4));
+}
+#elif defined(SIMD_AVX2)
+#define WQ_LANES 8
+static inline void wq_load_q8(const int8_t *row, size_t k, simd_f32_t *v) {
+    for (size_t h = 0; h < 4; h++) {
+        __m128i bytes = _mm_loadl_epi64((const __m128i *)(row + k + h * 8));
+        v[h] = _mm256_cvtepi32_ps(_mm256_cvtepi8_epi32(bytes));
+    }
+}
+static inline void wq_load_q4(const uint8_t *row, size_t k, simd_f32_t *v) {
+    for (size_t h = 0; h < 2; h++) {
+        __m256i x = _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i *)(row + k / 2 + h * 8)));
+        v[h] = _mm256_cvtepi32_ps(_mm256_and_si256(x, _mm256_set1_epi32(0x0F)));
+        v[2 + h] = _mm256_cvtepi32_ps(_mm256_srli_epi32(x, 4));
+    }
+}
+#else
+#define WQ_LANES (SIMD_F32_WIDTH > 1 ? SIMD_F32_WIDTH : 1)
+#define WQ_LOAD_BLOCK(Q_SUFFIX, QTYPE)                                                             \
+    static inline void wq_load_##Q_SUFFIX(const QTYPE *row, size_t k, gemm_f32_vec_t *v) {         \
+        f32_t lanes[WQ_BLOCK];                                                                     \
+        for (size_t l = 0; l < WQ_BLOCK; l++) {                                                    \
+            lanes[l] = wq_value_##Q_SUFFIX(row, k + l);                                            \
+        }                                                                                          \
+        for (size_t h = 0; h < WQ_BLOCK / WQ_LANES; h++) {                                         \
+            v[h] = gemm_f32_load(lanes + h * WQ_LANES);                                            \
+        }                                                                                          \
+    }
+WQ_LOAD_BLOCK(q8, int8_t)
+WQ_LOAD_BLOCK(q4, uint8_t)
+#endif
+#define WQ_VECS (WQ_BLOCK / WQ_LANES)
+
+#if SIMD_F32_WIDTH > 1
+#define wq_reduce simd_f32_reduce_add
+#else
+static inline f32_t wq_reduce(f32_t v) { return v; }
+#endif
+
+typedef struct {
+    size_t M, N, K;
+    const f32_t *a;
+    size_t lda;
+    const void *b;
+    const f16_t *scales;
+    const f16_t *zero_points;
+    size_t group_size;
+    f32_t *c;
+    size_t ldc;
+} wq_args_t;
+
+/// Macro to implement the MR x WQ_NR tile of one weight format
+///
+/// Edge tiles repeat the last row/column so the tile shape stays fixed; only
+/// the valid part is stored.
+///
+/// @param QTYPE C type of the stored weights
+/// @param Q_SUFFIX Suffix for function naming
+/// @param ROW_BYTES Bytes of one weight row for a given K
+/// @param DEFAULT_ZERO Zero point used when zero_points is NULL
+/// @param MR Tile rows
+#define GEMM_WQ_TILE_IMPL(QTYPE, Q_SUFFIX, ROW_BYTES, DEFAULT_ZERO, MR)                            \
+    static void wq_##Q_SUFFIX##_tile_##MR(const wq_args_t *w, size_t i0, size_t j0) {              \
+        const size_t groups = w->K / w->group_size;                                                \
+        const f32_t *a_rows[MR];                                                                   \
+        const QTYPE *b_rows[WQ_NR];                                                                \
+        size_t cols[WQ_NR];                                                                        \
+        for (size_t r = 0; r < (MR); r++) {                                                        \
+            size_t i = (i0 + r < w->M) ? i0 + r : w->M - 1;                                        \
+            a_rows[r] = w->a + i * w->lda;                                                         \
+        }                                                                                          \
+        for (size_t t = 0; t < WQ_NR; t++) {                                                       \
+            cols[t] = (j0 + t < w->N) ? j0 + t : w->N - 1;                                         \
+            b_rows[t] = (const QTYPE *)w->b + cols[t] * ROW_BYTES(w->K);                           \
+        }                                                                                          \
+                                                                                                   \
+        gemm_f32_vec_t acc[MR][WQ_NR];                                                             \
+        for (size_t r = 0; r < (MR); r++) {                                                        \
+            for (size_t t = 0; t < WQ_NR; t++) {                                                   \
+                acc[r][t] = gemm_f32_set1(0.0f);                                                   \
+            }                                                                                      \
+        }                                                                                          \
+                                                                                                   \
+        for (size_t g0 = 0; g0 < groups; g0 += WQ_GROUP_CHUNK) {                                   \
+            /* Scales and offsets (-zero_point * scale) of a chunk of groups, widened at once */   \
+            size_t gn = (groups - g0 < WQ_GROUP_CHUNK) ? groups - g0 : WQ_GROUP_CHUNK;             \
+            f32_t scale[WQ_NR][WQ_GROUP_CHUNK], offset[WQ_NR][WQ_GROUP_CHUNK];                     \
+            for (size_t t = 0; t < WQ_NR; t++) {                                                   \
+                simd_widen_f16(w->scales + cols[t] * groups + g0, scale[t], gn);                   \
+                if (w->zero_points) {                                                              \
+                    simd_widen_f16(w->zero_points + cols[t] * groups + g0, offset[t], gn);         \
+                }                                                                                  \
+                for (size_t g = 0; g < gn; g++) {                                                  \
+                    f32_t zero = w->zero_points ? offset[t][g] : (f32_t)(DEFAULT_ZERO);            \
+                    offset[t][g] = -zero * scale[t][g];                                            \
+                }                                                                                  \
+            }                                                                                      \
+                                                                                                   \
+            for (size_t g = 0; g < gn; g++) {                                                      \
+                const size_t k_end = (g0 + g + 1) * w->group_size;                                 \
+                for (size_t k = (g0 + g) * w->group_size; k < k_end; k += WQ_BLOCK) {              \
+                    for (size_t t = 0; t < WQ_NR; t++) {                                           \
+                        gemm_f32_vec_t vscale = gemm_f32_set1(scale[t][g]);                        \
+                        gemm_f32_vec_t voffset = gemm_f32_set1(offset[t][g]);                      \
+                        gemm_f32_vec_t wv[WQ_VECS];                                                \
+                        wq_load_##Q_SUFFIX(b_rows[t], k, wv);                                      \
+                        for (size_t h = 0; h < WQ_VECS; h++) {                                     \
+                            wv[h] = gemm_f32_fmadd(wv[h], vscale, voffset);                        \
+                            for (size_t r = 0; r < (MR); r++) {                                    \
+                                gemm_f32_vec_t av = gemm_f32_load(a_rows[r] + k + h * WQ_LANES);   \
+                                acc[r][t] = gemm_f32_fmadd(av, wv[h], acc[r][t]);                  \
+                            }                                                                      \
+                        }                                                                          \
+                    }                                                                              \
+                }                                                                                  \
+            }                                                                                      \
+        }                                                                                          \
+                                                                                                   \
+        for (size_t r = 0; r < (MR) && i0 + r < w->M; r++) {                                       \
+            for (size_t t = 0; t < WQ_NR && j0 + t < w->N; t++) {                                  \
+                w->c[(i0 + r) * w->ldc + j0 + t] = wq_reduce(acc[r][t]);                           \
+            }                                                                                      \
+        }                                                                                          \
+    }
+
+/// Macro to implement the weight-only quantized GEMM for one weight format
+///
+/// @param QTYPE C type of the stored weights
+/// @param Q_SUFFIX Suffix for function naming
+/// @param ROW_BYTES Bytes of one weight row for a given K
+/// @param DEFAULT_ZERO Zero point used when zero_points is NULL
+#define GEMM_WQ_IMPL(QTYPE, Q_SUFFIX, ROW_BYTES, DEFAULT_ZERO)                                     \
+    GEMM_WQ_TILE_IMPL(QTYPE, Q_SUFFIX, ROW_BYTES, DEFAULT_ZERO, 1)                                 \
+    GEMM_WQ_TILE_IMPL(QTYPE, Q_SUFFIX, ROW_BYTES, DEFAULT_ZERO, 2)                                 \
+                                                                                                   \
+    /* A single row (decode GEMV) gets its own tile instead of a duplicated one */                 \
+    static void wq_##Q_SUFFIX##_tiles(size_t start, size_t end, void *arg) {                       \
+        const wq_args_t *w = (const wq_args_t *)arg;                                               \
+        for (size_t tile = start; tile < end; tile++) {                                            \
+            size_t i0 = 0;                                                                         \
+            for (; i0 + 2 <= w->M; i0 += 2) {                                                      \
+                wq_##Q_SUFFIX##_tile_2(w, i0, tile * WQ_NR);                                       \
+            }                                                                                      \
+            if (i0 < w->M) {                                                                       \
+                wq_##Q_SUFFIX##_tile_1(w, i0, tile * WQ_NR);                                       \
+            }                                                                                      \
+        }                                                                                          \
+    }                                                                                              \
+                                                                                                   \
+    void HODU_ISA_NAME(hodu_cpu_gemm_f32_##Q_SUFFIX)(                                              \
+        size_t M, size_t N, size_t K, const f32_t *a, size_t lda, const QTYPE *b,                  \
+        const f16_t *scales, const f16_t *zero_points, size_t group_size, f32_t *c, size_t ldc) {  \
+        HODU_ISA_DISPATCH(hodu_cpu_gemm_f32_##Q_SUFFIX,                                            \
+                          (M, N, K, a, lda, b, scales, zero_points, group_size, c, ldc));          \
+        if (M == 0 || N == 0 || group_size == 0 || group_size % WQ_BLOCK != 0 ||                   \
+            K % group_size != 0) {                                                                 \
+            return;                                                                                \
+        }                                                                                          \
+        wq_args_t args = {M, N, K, a, lda, b, scales, zero_points, group_size, c, ldc};            \
+        size_t tiles = (N + WQ_NR - 1) / WQ_NR;                                                    \
+        size_t grain = task_grain(HODU_CPU_COST_FMA, (double)(M * K * WQ_NR));                     \
+        parallel_for(0, tiles, grain, wq_##Q_SUFFIX##_tiles, &args);                               \
+    }
+
+#define WQ_ROW_BYTES_Q4(K) ((K) / 2)
+#define WQ_ROW_BYTES_Q8(K) (K)
+
+GEMM_WQ_IMPL(uint8_t, q4, WQ_ROW_BYTES_Q4, 8)
+GEMM_WQ_IMPL(int8_t, q8, WQ_ROW_BYTES_Q8, 0)
@@ -0,0 +1,194 @@
+/**
+ * @file gemm.h
+ * @brief Native GEMM engine header
+ *
+ * Provides packed, cache-blocked general matrix multiplication used by the
+ * matmul/dot kernels when no BLAS library is available:
+ * - gemm_f32: C = A @ B in f32
+ * - gemm_f64: C = A @ B in f64
+ * - gemm_bf16/f16/f8e4m3/f8e5m2: C = A @ B with f32 accumulation
+ * - gemm_f32_bf16/f16/f8e4m3/f8e5m2: f32 C = f32 A @ low-precision B (cast on load)
+ * - gemm_u8i8_i32: C = A @ B for u8 A and i8 B with exact i32 accumulation
+ * - gemm_f32_q4/q8: f32 C = f32 A @ group-quantized int4/int8 B (dequantized in registers)
+ * - gemm_fused_f32/f64: C = activation(scale * A @ B + bias + R) in one pass
+ *
+ * A and B may have arbitrary row/column strides (transposed and sliced views
+ * are packed directly); C is row-major with leading dimension ldc.
+ *
+ * Portable builds compile the engine once per ISA and every entry point
+ * forwards to the variant selected at runtime (cpu_features.h).
+ */
+
+#ifndef GEMM_H
+#define GEMM_H
+
+#include "epilogue.h"
+#include "types.h"
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// ============================================================================
+// GENERAL MATRIX MULTIPLICATION (GEMM)
+// ============================================================================
+//
+// All gemm operations follow this signature:
+//   void hodu_cpu_gemm_type(size_t M, size_t N, size_t K,
+//                           const type *a, size_t a_rs, size_t a_cs,
+//                           const type *b, size_t b_rs, size_t b_cs,
+//                           type *c, size_t ldc)
+//
+// Computes C[i, j] = sum_k A[i, k] * B[k, j] and overwrites C, where
+//   A[i, k] = a[i * a_rs + k * a_cs]
+//   B[k, j] = b[k * b_rs + j * b_cs]
+//   C[i, j] = c[i * ldc + j]
+//
+// Algorithm (Goto/BLIS blocking):
+// - B is packed into KC x NC slabs of NR-wide column panels (shared)
+// - A is packed into MC x KC blocks of MR-tall row panels (per thread)
+// - An MR x NR register-tiled microkernel built on simd_utils.h runs over the
+//   packed panels; edge tiles are zero-padded during packing
+// - MC x NC tiles of a slab are distributed over the thread pool; K is never
+//   split, so every element of C sums its products in the same order for any
+//   thread count (no extra work in deterministic mode)
+//
+// Low-precision types (bf16, f16, f8e4m3, f8e5m2) are widened to f32 while
+// packing, run on the f32 microkernel and are rounded once when C is stored.
+//
+// Runs inline (single-threaded) when called from inside a pool task.
+
+void hodu_cpu_gemm_f32(size_t M, size_t N, size_t K, const f32_t *a, size_t a_rs, size_t a_cs,
+                       const f32_t *b, size_t b_rs, size_t b_cs, f32_t *c, size_t ldc);
+void hodu_cpu_gemm_f64(size_t M, size_t N, size_t K, const f64_t *a, size_t a_rs, size_t a_cs,
+                       const f64_t *b, size_t b_rs, size_t b_cs, f64_t *c, size_t ldc);
+void hodu_cpu_gemm_bf16(size_t M, size_t N, size_t K, const bf16_t *a, size_t a_rs, size_t a_cs,
+                        const bf16_t *b, size_t b_rs, size_t b_cs, bf16_t *c, size_t ldc);
+void hodu_cpu_gemm_f16(size_t M, size_t N, size_t K, const f16_t *a, size_t a_rs, size_t a_cs,
+                       const f16_t *b, size_t b_rs, size_t b_cs, f16_t *c, size_t ldc);
+void hodu_cpu_gemm_f8e4m3(size_t M, size_t N, size_t K, const f8e4m3_t *a, size_t a_rs,
+                          size_t a_cs, const f8e4m3_t *b, size_t b_rs, size_t b_cs, f8e4m3_t *c,
+                          size_t ldc);
+void hodu_cpu_gemm_f8e5m2(size_t M, size_t N, size_t K, const f8e5m2_t *a, size_t a_rs,
+                          size_t a_cs, const f8e5m2_t *b, size_t b_rs, size_t b_cs, f8e5m2_t *c,
+                          size_t ldc);
+
+// Mixed precision: f32 A and C with B stored as bf16/f16/f8 (typically weights). B is
+// widened to f32 while its panels are packed, so no converted copy of B is needed:
+//   hodu_cpu_gemm_f32_bf16(M, N, K, a, a_rs, a_cs, b_bf16, b_rs, b_cs, c, ldc)
+
+void hodu_cpu_gemm_f32_bf16(size_t M, size_t N, size_t K, const f32_t *a, size_t a_rs,
+                            size_t a_cs, const bf16_t *b, size_t b_rs, size_t b_cs, f32_t *c,
+                            size_t ldc);
+void hodu_cpu_gemm_f32_f16(size_t M, size_t N, size_t K, const f32_t *a, size_t a_rs, size_t a_cs,
+                           const f16_t *b, size_t b_rs, size_t b_cs, f32_t *c, size_t ldc);
+void hodu_cpu_gemm_f32_f8e4m3(size_t M, size_t N, size_t K, const f32_t *a, size_t a_rs,
+                              size_t a_cs, const f8e4m3_t *b, size_t b_rs, size_t b_cs, f32_t *c,
+                              size_t ldc);
+void hodu_cpu_gemm_f32_f8e5m2(size_t M, size_t N, size_t K, const f32_t *a, size_t a_rs,
+                              size_t a_cs, const f8e5m2_t *b, size_t b_rs, size_t b_cs, f32_t *c,
+                              size_t ldc);
+
+// ============================================================================
+// FUSED EPILOGUES
+// ============================================================================
+//
+// The fused variants finish each MR x NR tile with
+//   C[i, j] = activation(scale * (A @ B)[i, j] + bias + R[i, j])
+// right after its last K slab is stored, while the tile is still in L1, so the
+// bias/residual/activation passes never re-read C from memory.
+
+/// Epilogue of one GEMM call (see hodu_cpu_epilogue_t for the ops-level form)
+typedef struct {
+    float scale;
+    const void *bias;     // N entries (per column), or M entries when bias_per_row
+    bool bias_per_row;
+    const void *residual; // R[i, j] = residual[i * ldr + j]
+    size_t ldr;
+    int32_t activation; // hodu_cpu_activation_t
+} hodu_cpu_gemm_epilogue_t;
+
+void hodu_cpu_gemm_fused_f32(size_t M, size_t N, size_t K, const f32_t *a, size_t a_rs,
+                             size_t a_cs, const f32_t *b, size_t b_rs, size_t b_cs, f32_t *c,
+                             size_t ldc, const hodu_cpu_gemm_epilogue_t *ep);
+void hodu_cpu_gemm_fused_f64(size_t M, size_t N, size_t K, const f64_t *a, size_t a_rs,
+                             size_t a_cs, const f64_t *b, size_t b_rs, size_t b_cs, f64_t *c,
+                             size_t ldc, const hodu_cpu_gemm_epilogue_t *ep);
+
+// ============================================================================
+// PRE-PACKED OPERANDS
+// ============================================================================
+//
+// A constant operand (typically a weight) can be packed once into the blocked
+// panel layout used internally and reused by every later GEMM, which then skips
+// all packing and strided reads of that operand:
+//   size = hodu_cpu_gemm_packed_rhs_size_f32(K, N);          // elements
+//   hodu_cpu_gemm_pack_rhs_f32(K, N, b, b_rs, b_cs, packed); // once
+//   hodu_cpu_gemm_packed_rhs_f32(M, N, K, a, a_rs, a_cs, packed, c, ldc, NULL);
+// The _lhs variants pack A instead (M x K). Packed buffers are only valid for
+// the same K/N (or M/K) and are specific to this build (SIMD width). The
+// packed GEMMs take an optional fused epilogue (NULL = plain C = A @ B).
+//
+// hodu_cpu_gemm_packed_layout_* identifies the layout of the running ISA
+// variant (MR | NR << 8 | KC << 16 | NC << 32): buffers packed where it had
+// the same value can be reused, e.g. from a file (see weights.h).
+
+uint64_t hodu_cpu_gemm_packed_layout_f32(void);
+uint64_t hodu_cpu_gemm_packed_layout_f64(void);
+
+size_t hodu_cpu_gemm_packed_lhs_size_f32(size_t M, size_t K);
+size_t hodu_cpu_gemm_packed_rhs_size_f32(size_t K, size_t N);
+void hodu_cpu_gemm_pack_lhs_f32(size_t M, size_t K, const f32_t *a, size_t a_rs, size_t a_cs,
+                                f32_t *packed);
+void hodu_cpu_gemm_pack_rhs_f32(size_t K, size_t N, const f32_t *b, size_t b_rs, size_t b_cs,
+                                f32_t *packed);
+void hodu_cpu_gemm_packed_lhs_f32(size_t M, size_t N, size_t K, const f32_t *packed_a,
+                                  const f32_t *b, size_t b_rs, size_t b_cs, f32_t *c, size_t ldc,
+                                  const hodu_cpu_gemm_epilogue_t *ep);
+void hodu_cpu_gemm_packed_rhs_f32(size_t M, size_t N, size_t K, const f32_t *a, size_t a_rs,
+                                  size_t a_cs, const f32_t *packed_b, f32_t *c, size_t ldc,
+                                  const hodu_cpu_gemm_epilogue_t *ep);
+
+size_t hodu_cpu_gemm_packed_lhs_size_f64(size_t M, size_t K);
+size_t hodu_cpu_gemm_packed_rhs_size_f64(size_t K, size_t N);
+void hodu_cpu_gemm_pack_lhs_f64(size_t M, size_t K, const f64_t *a, size_t a_rs, size_t a_cs,
+                                f64_t *packed);
+void hodu_cpu_gemm_pack_rhs_f64(size_t K, size_t N, const f64_t *b, size_t b_rs, size_t b_cs,
+                                f64_t *packed);
+void hodu_cpu_gemm_packed_lhs_f64(size_t M, size_t N, size_t K, const f64_t *packed_a,
+                                  const f64_t *b, size_t b_rs, size_t b_cs, f64_t *c, size_t ldc,
+                                  const hodu_cpu_gemm_epilogue_t *ep);
+void hodu_cpu_gemm_packed_rhs_f64(size_t M, size_t N, size_t K, const f64_t *a, size_t a_rs,
+                                  size_t a_cs, const f64_t *packed_b, f64_t *c, size_t ldc,
+                                  const hodu_cpu_gemm_epilogue_t *ep);
+
+// Quantized GEMM: u8 A x i8 B -> i32 C (no zero points; see hodu_cpu_qmatmul_*).
+// Uses AVX-512 VNNI or ARM dotprod when available, exact i16 pair products otherwise.
+void hodu_cpu_gemm_u8i8_i32(size_t M, size_t N, size_t K, const uint8_t *a, size_t a_rs,
+                            size_t a_cs, const int8_t *b, size_t b_rs, size_t b_cs, int32_t *c,
+                            size_t ldc);
+
+// Weight-only quantized GEMM: f32 A x int4/int8 B -> f32 C (see hodu_cpu_matmul_f32_q4).
+// A is row-major with leading dimension lda. B is stored transposed, one row of K
+// values per output column: int8 rows take K bytes, int4 rows K / 2 bytes in blocks
+// of 32 values packed into 16 bytes (value i of a block in the low nibble of byte
+// i % 16 for i < 16, in the high nibble otherwise). Every group_size values of a
+// row share an f16 scale and zero point (scales[j * K / group_size + g]):
+//   B[k, j] = scale * (q - zero_point)
+// zero_points may be NULL: 8 for int4 (unsigned 0..15), 0 for int8 (signed).
+// group_size must be a multiple of 32 dividing K. M = 1 runs as a GEMV parallel
+// over N.
+void hodu_cpu_gemm_f32_q4(size_t M, size_t N, size_t K, const f32_t *a, size_t lda,
+                          const uint8_t *b, const f16_t *scales, const f16_t *zero_points,
+                          size_t group_size, f32_t *c, size_t ldc);
+void hodu_cpu_gemm_f32_q8(size_t M, size_t N, size_t K, const f32_t *a, size_t lda,
+                          const int8_t *b, const f16_t *scales, const f16_t *zero_points,
+                          size_t group_size, f32_t *c, size_t ldc);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // GEMM_H
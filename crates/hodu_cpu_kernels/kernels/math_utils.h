@@ -177,9 +177,13 @@ static inline double gelu_helper_f64(double x) {
     return 0.5 * x * (1.0 + tanh(0.7978845608 * (x + 0.044715 * x * x * x)));
 }
 
-static inline float softplus_helper_f32(float x) { return logf(1.0f + expf(x)); }
+// Softplus: log(1 + exp(x)) evaluated as max(x, 0) + log1p(exp(-|x|)) so it neither overflows
+// for large x nor rounds to 0 for very negative x
+static inline float softplus_helper_f32(float x) {
+    return fmaxf(x, 0.0f) + log1pf(expf(-fabsf(x)));
+}
 
-static inline double softplus_helper_f64(double x) { return log(1.0 + exp(x)); }
+static inline double softplus_helper_f64(double x) { return fmax(x, 0.0) + log1p(exp(-fabs(x))); }
 
 static inline float silu_helper_f32(float x) { return x / (1.0f + expf(-x)); }
 
@@ -0,0 +1,535 @@
+#include "ops_attention.h"
+#include "gemm.h"
+#include "profile.h"
+#include "simd_utils.h"
+#include "thread_utils.h"
+#include "types.h"
+#include "workspace.h"
+#include <math.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#define MAX(a, b) ((a) > (b) ? (a) : (b))
+#define MIN(a, b) ((a) < (b) ? (a) : (b))
+
+// ============================================================================
+// FUSED ATTENTION
+// ============================================================================
+//
+// Prefill (flash-attention style): each task owns one (batch, head, query
+// tile) of ATTN_BLOCK_Q rows and streams K/V in blocks of ATTN_BLOCK_KV keys:
+// 1. S = Q_tile K_block^T with the native GEMM (strided Q/K used in place for
+//    f32, blocks widened to f32 for bf16/f16)
+// 2. Per row: scale, apply the causal/padding limit, update the running max m
+//    and sum l online, P = exp(S - m), and rescale the row's accumulator
+// 3. O_tile += P V_block with the native GEMM
+// Only the ATTN_BLOCK_Q x ATTN_BLOCK_KV score tile lives in memory; O is divided
+// by l when the last block has been consumed. Blocks past the tile's last
+// visible key (causal or padded) are never loaded.
+//
+// Decode: one query per (batch, head). The heads sharing a KV head are
+// processed together so every cache row is read once per group; when there
+// are fewer (batch, kv head) pairs than threads the cache length is split
+// into chunks whose partial (m, l, O) are merged afterwards (flash-decoding).
+// Deterministic mode sizes the split by DETERMINISTIC_THREADS instead of the
+// pool, so the merge order does not follow the thread count.
+// Head dims 64 and 128 run tasks compiled for that head dim.
+//
+// Metadata layout: see ops_attention.h
+
+/// Query rows per prefill tile
+#define ATTN_BLOCK_Q 32
+
+/// Keys per streamed K/V block
+#define ATTN_BLOCK_KV 64
+
+/// Minimum cache positions per decode chunk
+#define ATTN_DECODE_CHUNK 256
+
+// ============================================================================
+// VECTOR HELPERS
+// ============================================================================
+
+static inline float attn_dot(const float *a, const float *b, size_t n) {
+    size_t i = 0;
+    float s = 0.0f;
+#if SIMD_F32_WIDTH > 1
+    HODU_PROFILE_PATH(HODU_CPU_PATH_SIMD);
+    const size_t nv = n - n % SIMD_F32_WIDTH;
+    if (nv > 0) {
+        simd_f32_t vs = simd_f32_set1(0.0f);
+        for (; i < nv; i += SIMD_F32_WIDTH) {
+            vs = simd_f32_fmadd(simd_f32_load(a + i), simd_f32_load(b + i), vs);
+        }
+        s = simd_f32_reduce_add(vs);
+    }
+#endif
+    for (; i < n; i++) {
+        s += a[i] * b[i];
+    }
+    return s;
+}
+
+// y = alpha * y + beta * x
+static inline void attn_axpby(float *y, float alpha, float beta, const float *x, size_t n) {
+    size_t i = 0;
+#if SIMD_F32_WIDTH > 1
+    HODU_PROFILE_PATH(HODU_CPU_PATH_SIMD);
+    const simd_f32_t va = simd_f32_set1(alpha);
+    const simd_f32_t vb = simd_f32_set1(beta);
+    const size_t nv = n - n % SIMD_F32_WIDTH;
+    for (; i < nv; i += SIMD_F32_WIDTH) {
+        const simd_f32_t vy = simd_f32_mul(simd_f32_load(y + i), va);
+        simd_f32_store(y + i, simd_f32_fmadd(simd_f32_load(x + i), vb, vy));
+    }
+#endif
+    for (; i < n; i++) {
+        y[i] = alpha * y[i] + beta * x[i];
+    }
+}
+
+static inline void attn_scale(float *y, float alpha, size_t n) {
+    size_t i = 0;
+#if SIMD_F32_WIDTH > 1
+    HODU_PROFILE_PATH(HODU_CPU_PATH_SIMD);
+    const simd_f32_t va = simd_f32_set1(alpha);
+    const size_t nv = n - n % SIMD_F32_WIDTH;
+    for (; i < nv; i += SIMD_F32_WIDTH) {
+        simd_f32_store(y + i, simd_f32_mul(simd_f32_load(y + i), va));
+    }
+#endif
+    for (; i < n; i++) {
+        y[i] *= alpha;
+    }
+}
+
+// ============================================================================
+// PREFILL ATTENTION
+// ============================================================================
+
+/// Arguments shared by the prefill tasks of one call
+typedef struct {
+    const void *q;
+    const void *k;
+    const void *v;
+    void *output;
+    const size_t *metadata;
+    float scale;
+    size_t q_tiles; // query tiles per (batch, head)
+} attn_args_t;
+
+/// Number of leading keys query `row` of batch `b` may see (causal and padding limits)
+static inline size_t attn_row_keys(const size_t *metadata, size_t b, size_t row) {
+    const size_t q_len = metadata[3];
+    const size_t kv_len = metadata[4];
+    size_t keys = kv_len;
+    if (metadata[22]) {
+        keys = MIN(keys, metadata[23 + b]);
+    }
+    if (metadata[21]) {
+        const size_t visible = kv_len + row + 1 > q_len ? kv_len + row + 1 - q_len : 0;
+        keys = MIN(keys, visible);
+    }
+    return keys;
+}
+
+/// Online-softmax update of one score row: scales the `valid` visible scores, replaces
+/// them by exp(s - m) (zeroing the rest up to cols) and rescales the row accumulator
+static inline void attn_softmax_row(float *s, size_t valid, size_t cols, float scale, float *m,
+                                    float *l, float *o, size_t head_dim) {
+    if (valid == 0) {
+        memset(s, 0, cols * sizeof(float));
+        return;
+    }
+    float block_max = -INFINITY;
+    for (size_t j = 0; j < valid; j++) {
+        s[j] *= scale;
+        block_max = s[j] > block_max ? s[j] : block_max;
+    }
+    const float m_new = MAX(*m, block_max);
+    const float alpha = expf(*m - m_new);
+    float sum = 0.0f;
+    size_t j = 0;
+#if SIMD_F32_WIDTH > 1
+    HODU_PROFILE_PATH(HODU_CPU_PATH_SIMD);
+    const simd_f32_t vm = simd_f32_set1(m_new);
+    simd_f32_t vsum = simd_f32_set1(0.0f);
+    for (; j + SIMD_F32_WIDTH <= valid; j += SIMD_F32_WIDTH) {
+        const simd_f32_t p = simd_f32_exp(simd_f32_sub(simd_f32_load(s + j), vm));
+        simd_f32_store(s + j, p);
+        vsum = simd_f32_add(vsum, p);
+    }
+    sum = simd_f32_reduce_add(vsum);
+#endif
+    for (; j < valid; j++) {
+        s[j] = expf(s[j] - m_new);
+        sum += s[j];
+    }
+    for (size_t j = valid; j < cols; j++) {
+        s[j] = 0.0f;
+    }
+    *l = *l * alpha + sum;
+    *m = m_new;
+    if (alpha != 1.0f) {
+        attn_scale(o, alpha, head_dim);
+    }
+}
+
+#ifdef HODU_PROFILE_ACTIVE
+/// Q, K, V and output bytes of a prefill call
+static inline uint64_t attn_profile_bytes(const size_t *metadata, size_t elem_size) {
+    const uint64_t q = (uint64_t)metadata[0] * metadata[1] * metadata[3];
+    const uint64_t kv = (uint64_t)metadata[0] * metadata[2] * metadata[4];
+    return elem_size * metadata[5] * 2 * (q + kv);
+}
+#endif
+
+/// Macro to implement prefill attention for one type
+///
+/// @param TYPE C type of Q/K/V/output
+/// @param TYPE_SUFFIX Suffix for function naming
+/// @param TO_FLOAT Conversion to float
+/// @param FROM_FLOAT Conversion from float
+/// @param NATIVE 1 when TYPE is f32_t (Q/K/V are read in place)
+#define ATTN_OP(TYPE, TYPE_SUFFIX, TO_FLOAT, FROM_FLOAT, NATIVE)                                   \
+    static void attn_task_##TYPE_SUFFIX(size_t start, size_t end, void *ctx) {                     \
+        const attn_args_t *a = (const attn_args_t *)ctx;                                           \
+        const size_t *md = a->metadata;                                                            \
+        const size_t num_heads = md[1];                                                            \
+        const size_t group = num_heads / md[2];                                                    \
+        const size_t q_len = md[3];                                                                \
+        const size_t d = md[5];                                                                    \
+        const size_t *qs = &md[6];                                                                 \
+        const size_t *ks = &md[10];                                                                \
+        const size_t *vs = &md[14];                                                                \
+        const size_t bq = ATTN_BLOCK_Q, bkv = ATTN_BLOCK_KV;                                       \
+        const size_t elems = bq * bkv + 2 * bq * d + 2 * bq + (NATIVE ? 0 : bq * d + 2 * bkv * d); \
+        float *scratch = (float *)workspace_acquire(elems * sizeof(float));                        \
+        if (!scratch) {                                                                            \
+            return;                                                                                \
+        }                                                                                          \
+        float *s = scratch;                                                                        \
+        float *o = s + bq * bkv;                                                                   \
+        float *pv = o + bq * d;                                                                    \
+        float *m = pv + bq * d;                                                                    \
+        float *l = m + bq;                                                                         \
+        float *qbuf = l + bq;                                                                      \
+        float *kbuf = qbuf + bq * d;                                                               \
+        float *vbuf = kbuf + bkv * d;                                                              \
+                                                                                                   \
+        for (size_t u = start; u < end; u++) {                                                     \
+            const size_t tile = u % a->q_tiles;                                                    \
+            const size_t bh = u / a->q_tiles;                                                      \
+            const size_t h = bh % num_heads;                                                       \
+            const size_t b = bh / num_heads;                                                       \
+            const size_t i0 = tile * bq;                                                           \
+            const size_t rows = MIN(bq, q_len - i0);                                               \
+            const TYPE *qp = (const TYPE *)a->q + md[18] + b * qs[0] + h * qs[1] + i0 * qs[2];     \
+            const TYPE *kp = (const TYPE *)a->k + md[19] + b * ks[0] + (h / group) * ks[1];        \
+            const TYPE *vp = (const TYPE *)a->v + md[20] + b * vs[0] + (h / group) * vs[1];        \
+                                                                                                   \
+            const float *qf = (const float *)qp;                                                   \
+            size_t q_rs = qs[2], q_cs = qs[3];                                                     \
+            if (!NATIVE) {                                                                         \
+                for (size_t r = 0; r < rows; r++) {                                                \
+                    for (size_t c = 0; c < d; c++) {                                               \
+                        qbuf[r * d + c] = TO_FLOAT(qp[r * qs[2] + c * qs[3]]);                     \
+                    }                                                                              \
+                }                                                                                  \
+                qf = qbuf;                                                                         \
+                q_rs = d;                                                                          \
+                q_cs = 1;                                                                          \
+            }                                                                                      \
+            for (size_t r = 0; r < rows; r++) {                                                    \
+                m[r] = -INFINITY;                                                                  \
+                l[r] = 0.0f;                                                                       \
+            }                                                                                      \
+            memset(o, 0, rows * d * sizeof(float));                                                \
+                                                                                                   \
+            /* The last row sees the most keys */                                                  \
+            const size_t kv_end = attn_row_keys(md, b, i0 + rows - 1);                             \
+            for (size_t j0 = 0; j0 < kv_end; j0 += bkv) {                                          \
+                const size_t cols = MIN(bkv, kv_end - j0);                                         \
+                const float *kf = (const float *)(kp + j0 * ks[2]);                                \
+                const float *vf = (const float *)(vp + j0 * vs[2]);                                \
+                size_t k_rs = ks[2], k_cs = ks[3], v_rs = vs[2], v_cs = vs[3];                     \
+                if (!NATIVE) {                                                                     \
+                    for (size_t j = 0; j < cols; j++) {                                            \
+                        for (size_t c = 0; c < d; c++) {                                           \
+                            kbuf[j * d + c] = TO_FLOAT(kp[(j0 + j) * ks[2] + c * ks[3]]);          \
+                            vbuf[j * d + c] = TO_FLOAT(vp[(j0 + j) * vs[2] + c * vs[3]]);          \
+                        }                                                                          \
+                    }                                                                              \
+                    kf = kbuf;                                                                     \
+                    vf = vbuf;                                                                     \
+                    k_rs = v_rs = d;                                                               \
+                    k_cs = v_cs = 1;                                                               \
+                }                                                                                  \
+                                                                                                   \
+                /* S = Q K^T: B[k, j] = K[j, k] */                                                 \
+                hodu_cpu_gemm_f32(rows, cols, d, qf, q_rs, q_cs, kf, k_cs, k_rs, s, bkv);          \
+                for (size_t r = 0; r < rows; r++) {                                                \
+                    const size_t keys = attn_row_keys(md, b, i0 + r);                              \
+                    const size_t valid = keys > j0 ? MIN(cols, keys - j0) : 0;                     \
+                    attn_softmax_row(s + r * bkv, valid, cols, a->scale, &m[r], &l[r], o + r * d,  \
+                                     d);                                                           \
+                }                                                                                  \
+                                                                                                   \
+                /* O += P V */                                                                     \
+                hodu_cpu_gemm_f32(rows, d, cols, s, bkv, 1, vf, v_rs, v_cs, pv, d);                \
+                for (size_t r = 0; r < rows; r++) {                                                \
+                    attn_axpby(o + r * d, 1.0f, 1.0f, pv + r * d, d);                              \
+                }                                                                                  \
+            }                                                                                      \
+                                                                                                   \
+            TYPE *op = (TYPE *)a->output + ((b * num_heads + h) * q_len + i0) * d;                 \
+            for (size_t r = 0; r < rows; r++) {                                                    \
+                const float inv = l[r] > 0.0f ? 1.0f / l[r] : 0.0f;                                \
+                for (size_t c = 0; c < d; c++) {                                                   \
+                    op[r * d + c] = FROM_FLOAT(o[r * d + c] * inv);                                \
+                }                                                                                  \
+            }                                                                                      \
+        }                                                                                          \
+        workspace_release(scratch);                                                                \
+    }                                                                                              \
+                                                                                                   \
+    void hodu_cpu_attention_##TYPE_SUFFIX(const void *q, const void *k, const void *v,             \
+                                          void *output, const size_t *metadata, float scale) {     \
+        HODU_PROFILE_KERNEL(attn_profile_bytes(metadata, sizeof(TYPE)));                           \
+        const size_t batch = metadata[0];                                                          \
+        const size_t num_heads = metadata[1];                                                      \
+        const size_t q_len = metadata[3];                                                          \
+        if (batch == 0 || num_heads == 0 || q_len == 0 || metadata[5] == 0) {                      \
+            return;                                                                                \
+        }                                                                                          \
+        attn_args_t args = {q, k, v, output, metadata, scale, 0};                                  \
+        args.q_tiles = (q_len + ATTN_BLOCK_Q - 1) / ATTN_BLOCK_Q;                                  \
+        parallel_for(0, batch * num_heads * args.q_tiles, 1, attn_task_##TYPE_SUFFIX, &args);      \
+    }
+
+// ============================================================================
+// DECODE ATTENTION
+// ============================================================================
+
+/// Arguments shared by the decode tasks of one call
+typedef struct {
+    const void *q;
+    const void *k;
+    const void *v;
+    void *output;
+    const size_t *metadata;
+    float scale;
+    size_t split;    // cache chunks per (batch, kv head)
+    float *partials; // per (chunk, head) [m, l, O...] when split > 1
+} attn_decode_args_t;
+
+#ifdef HODU_PROFILE_ACTIVE
+/// Q and output bytes plus the filled K/V cache rows a decode call reads
+static inline uint64_t attn_decode_profile_bytes(const size_t *metadata, size_t elem_size) {
+    uint64_t positions = 0;
+    for (size_t b = 0; b < metadata[0]; b++) {
+        positions += metadata[5 + b];
+    }
+    return elem_size * metadata[3] * 2 * (metadata[0] * metadata[1] + positions * metadata[2]);
+}
+#endif
+
+/// Macro to implement the decode task of one type for a head dim
+///
+/// D of 0 reads the head dim from the metadata; 64 and 128 (the common head dims) are
+/// compile-time constants, so the per-key dot product and accumulator update unroll into
+/// straight-line vector code.
+///
+/// @param TYPE C type of Q/cache/output
+/// @param TYPE_SUFFIX Suffix for function naming
+/// @param TO_FLOAT Conversion to float
+/// @param FROM_FLOAT Conversion from float
+/// @param NATIVE 1 when TYPE is f32_t (cache rows are read in place)
+/// @param NAME Task name suffix
+/// @param D Head dim, or 0 for any
+#define ATTN_DECODE_TASK(TYPE, TYPE_SUFFIX, TO_FLOAT, FROM_FLOAT, NATIVE, NAME, D)                 \
+    static void attn_decode_task_##TYPE_SUFFIX##NAME(size_t start, size_t end, void *ctx) {        \
+        const attn_decode_args_t *a = (const attn_decode_args_t *)ctx;                             \
+        const size_t *md = a->metadata;                                                            \
+        const size_t num_heads = md[1];                                                            \
+        const size_t num_kv_heads = md[2];                                                         \
+        const size_t group = num_heads / num_kv_heads;                                             \
+        const size_t d = D ? (size_t)D : md[3];                                                    \
+        const size_t capacity = md[4];                                                             \
+        float *scratch = (float *)workspace_acquire((2 * group * d + 2 * group + 2 * d) *          \
+                                                    sizeof(float));                                \
+        if (!scratch) {                                                                            \
+            return;                                                                                \
+        }                                                                                          \
+        float *qf = scratch;                                                                       \
+        float *acc = qf + group * d;                                                               \
+        float *m = acc + group * d;                                                                \
+        float *l = m + group;                                                                      \
+        float *kbuf = l + group;                                                                   \
+        float *vbuf = kbuf + d;                                                                    \
+                                                                                                   \
+        for (size_t u = start; u < end; u++) {                                                     \
+            const size_t unit = u / a->split;                                                      \
+            const size_t chunk = u % a->split;                                                     \
+            const size_t b = unit / num_kv_heads;                                                  \
+            const size_t kvh = unit % num_kv_heads;                                                \
+            const size_t len = MIN(md[5 + b], capacity);                                           \
+            const size_t lo = len * chunk / a->split, hi = len * (chunk + 1) / a->split;           \
+            const TYPE *qp = (const TYPE *)a->q + (b * num_heads + kvh * group) * d;               \
+            const TYPE *kc = (const TYPE *)a->k + (b * num_kv_heads + kvh) * capacity * d;         \
+            const TYPE *vc = (const TYPE *)a->v + (b * num_kv_heads + kvh) * capacity * d;         \
+                                                                                                   \
+            for (size_t i = 0; i < group * d; i++) {                                               \
+                qf[i] = TO_FLOAT(qp[i]) * a->scale;                                                \
+                acc[i] = 0.0f;                                                                     \
+            }                                                                                      \
+            for (size_t g = 0; g < group; g++) {                                                   \
+                m[g] = -INFINITY;                                                                  \
+                l[g] = 0.0f;                                                                       \
+            }                                                                                      \
+                                                                                                   \
+            for (size_t j = lo; j < hi; j++) {                                                     \
+                const float *kr = (const float *)(kc + j * d);                                     \
+                const float *vr = (const float *)(vc + j * d);                                     \
+                if (!NATIVE) {                                                                     \
+                    for (size_t c = 0; c < d; c++) {                                               \
+                        kbuf[c] = TO_FLOAT(kc[j * d + c]);                                         \
+                        vbuf[c] = TO_FLOAT(vc[j * d + c]);                                         \
+                    }                                                                              \
+                    kr = kbuf;                                                                     \
+                    vr = vbuf;                                                                     \
+                }                                                                                  \
+                for (size_t g = 0; g < group; g++) {                                               \
+                    const float score = attn_dot(qf + g * d, kr, d);                               \
+                    if (score > m[g]) {                                                            \
+                        const float alpha = expf(m[g] - score);                                    \
+                        l[g] = l[g] * alpha + 1.0f;                                                \
+                        m[g] = score;                                                              \
+                        attn_axpby(acc + g * d, alpha, 1.0f, vr, d);                               \
+                    } else {                                                                       \
+                        const float p = expf(score - m[g]);                                        \
+                        l[g] += p;                                                                 \
+                        attn_axpby(acc + g * d, 1.0f, p, vr, d);                                   \
+                    }                                                                              \
+                }                                                                                  \
+            }                                                                                      \
+                                                                                                   \
+            if (a->split > 1) {                                                                    \
+                float *part = a->partials + (unit * a->split + chunk) * group * (d + 2);           \
+                for (size_t g = 0; g < group; g++) {                                               \
+                    part[g * (d + 2)] = m[g];                                                      \
+                    part[g * (d + 2) + 1] = l[g];                                                  \
+                    memcpy(part + g * (d + 2) + 2, acc + g * d, d * sizeof(float));                \
+                }                                                                                  \
+                continue;                                                                          \
+            }                                                                                      \
+            TYPE *op = (TYPE *)a->output + (b * num_heads + kvh * group) * d;                      \
+            for (size_t g = 0; g < group; g++) {                                                   \
+                const float inv = l[g] > 0.0f ? 1.0f / l[g] : 0.0f;                                \
+                for (size_t c = 0; c < d; c++) {                                                   \
+                    op[g * d + c] = FROM_FLOAT(acc[g * d + c] * inv);                              \
+                }                                                                                  \
+            }                                                                                      \
+        }                                                                                          \
+        workspace_release(scratch);                                                                \
+    }
+
+/// Macro to implement decode attention for one type
+///
+/// @param TYPE C type of Q/cache/output
+/// @param TYPE_SUFFIX Suffix for function naming
+/// @param TO_FLOAT Conversion to float
+/// @param FROM_FLOAT Conversion from float
+/// @param NATIVE 1 when TYPE is f32_t (cache rows are read in place)
+#define ATTN_DECODE_OP(TYPE, TYPE_SUFFIX, TO_FLOAT, FROM_FLOAT, NATIVE)                            \
+    ATTN_DECODE_TASK(TYPE, TYPE_SUFFIX, TO_FLOAT, FROM_FLOAT, NATIVE, , 0)                         \
+    ATTN_DECODE_TASK(TYPE, TYPE_SUFFIX, TO_FLOAT, FROM_FLOAT, NATIVE, _d64, 64)                    \
+    ATTN_DECODE_TASK(TYPE, TYPE_SUFFIX, TO_FLOAT, FROM_FLOAT, NATIVE, _d128, 128)                  \
+                                                                                                   \
+    void hodu_cpu_attention_decode_##TYPE_SUFFIX(const void *q, const void *k_cache,               \
+                                                 const void *v_cache, void *output,                \
+                                                 const size_t *metadata, float scale) {            \
+        HODU_PROFILE_KERNEL(attn_decode_profile_bytes(metadata, sizeof(TYPE)));                    \
+        const size_t batch = metadata[0];                                                          \
+        const size_t num_heads = metadata[1];                                                      \
+        const size_t num_kv_heads = metadata[2];                                                   \
+        const size_t d = metadata[3];                                                              \
+        if (batch == 0 || num_heads == 0 || d == 0) {                                              \
+            return;                                                                                \
+        }                                                                                          \
+        const size_t group = num_heads / num_kv_heads;                                             \
+        const size_t units = batch * num_kv_heads;                                                 \
+                                                                                                   \
+        /* Split the cache length when the (batch, kv head) pairs cannot fill the pool */          \
+        size_t max_len = 0;                                                                        \
+        for (size_t b = 0; b < batch; b++) {                                                       \
+            max_len = MAX(max_len, MIN(metadata[5 + b], metadata[4]));                             \
+        }                                                                                          \
+        const size_t threads = get_split_threads();                                                \
+        size_t split = 1;                                                                          \
+        if (units < threads) {                                                                     \
+            const size_t chunks = MAX((size_t)1, max_len / ATTN_DECODE_CHUNK);                     \
+            split = MIN((threads + units - 1) / units, chunks);                                    \
+        }                                                                                          \
+        attn_decode_args_t args = {q, k_cache, v_cache, output, metadata, scale, split, NULL};     \
+        if (split > 1) {                                                                           \
+            args.partials =                                                                        \
+                (float *)workspace_acquire(units * split * group * (d + 2) * sizeof(float));       \
+            if (!args.partials) {                                                                  \
+                args.split = split = 1;                                                            \
+            }                                                                                      \
+        }                                                                                          \
+        void (*task)(size_t, size_t, void *) = attn_decode_task_##TYPE_SUFFIX;                     \
+        if (d == 64) {                                                                             \
+            task = attn_decode_task_##TYPE_SUFFIX##_d64;                                           \
+        } else if (d == 128) {                                                                     \
+            task = attn_decode_task_##TYPE_SUFFIX##_d128;                                          \
+        }                                                                                          \
+        parallel_for(0, units * split, 1, task, &args);                                            \
+        if (split == 1) {                                                                          \
+            return;                                                                                \
+        }                                                                                          \
+                                                                                                   \
+        /* Merge the chunk partials: O = sum_c exp(m_c - M) O_c / sum_c exp(m_c - M) l_c */        \
+        for (size_t unit = 0; unit < units; unit++) {                                              \
+            const size_t b = unit / num_kv_heads;                                                  \
+            const size_t kvh = unit % num_kv_heads;                                                \
+            TYPE *op = (TYPE *)output + (b * num_heads + kvh * group) * d;                         \
+            for (size_t g = 0; g < group; g++) {                                                   \
+                float *first = args.partials + unit * split * group * (d + 2) + g * (d + 2);       \
+                const size_t step = group * (d + 2);                                               \
+                float m_all = -INFINITY;                                                           \
+                for (size_t c = 0; c < split; c++) {                                               \
+                    m_all = MAX(m_all, first[c * step]);                                           \
+                }                                                                                  \
+                /* Accumulate into the first chunk's O */                                          \
+                float l_all = 0.0f;                                                                \
+                for (size_t c = 0; c < split; c++) {                                               \
+                    const float *part = first + c * step;                                          \
+                    const float w = part[1] > 0.0f ? expf(part[0] - m_all) : 0.0f;                 \
+                    l_all += part[1] * w;                                                          \
+                    if (c == 0) {                                                                  \
+                        attn_scale(first + 2, w, d);                                               \
+                    } else {                                                                       \
+                        attn_axpby(first + 2, 1.0f, w, part + 2, d);                               \
+                    }                                                                              \
+                }                                                                                  \
+                const float inv = l_all > 0.0f ? 1.0f / l_all : 0.0f;                              \
+                for (size_t i = 0; i < d; i++) {                                                   \
+                    op[g * d + i] = FROM_FLOAT(first[2 + i] * inv);                                \
+                }                                                                                  \
+            }                                                                                      \
+        }                                                                                          \
+        workspace_release(args.partials);                                                          \
+    }
+
+#define ATTN_IDENTITY(x) (x)
+
+ATTN_OP(bf16_t, bf16, bf16_to_float, float_to_bf16, 0)
+ATTN_OP(f16_t, f16, f16_to_float, float_to_f16, 0)
+ATTN_OP(f32_t, f32, ATTN_IDENTITY, ATTN_IDENTITY, 1)
+
+ATTN_DECODE_OP(bf16_t, bf16, bf16_to_float, float_to_bf16, 0)
+ATTN_DECODE_OP(f16_t, f16, f16_to_float, float_to_f16, 0)
+ATTN_DECODE_OP(f32_t, f32, ATTN_IDENTITY, ATTN_IDENTITY, 1)
@@ -0,0 +1,92 @@
+/**
+ * @file ops_attention.h
+ * @brief Fused scaled dot-product attention
+ *
+ * Provides attention in a single kernel instead of matmul + softmax + matmul:
+ * - attention: tiled prefill attention with online softmax; K/V are streamed
+ *   in blocks, so the [q_len, kv_len] score matrix is never materialized
+ * - attention_decode: single-token attention against a KV cache, split across
+ *   the cache length when there are fewer (batch, head) pairs than threads
+ *
+ * Both compute softmax(scale * Q K^T + mask) V with f32 accumulation and
+ * support grouped-query attention (num_heads a multiple of num_kv_heads).
+ */
+
+#ifndef OPS_ATTENTION_H
+#define OPS_ATTENTION_H
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// ============================================================================
+// PREFILL ATTENTION
+// ============================================================================
+//
+// Q: [batch, num_heads, q_len, head_dim], K/V: [batch, num_kv_heads, kv_len, head_dim],
+// each with arbitrary strides (BHSD and BSHD views work without copies).
+// Output: contiguous [batch, num_heads, q_len, head_dim].
+//
+// Masks:
+// - causal: query i sits at key position kv_len - q_len + i (bottom-right
+//   aligned, so a chunk of new queries attends to the whole cached prefix) and
+//   sees keys up to and including that position
+// - padding: keys at positions >= kv_lens[b] are ignored
+// Rows that see no key produce zeros.
+//
+// Metadata layout:
+// - metadata[0]: batch
+// - metadata[1]: num_heads
+// - metadata[2]: num_kv_heads
+// - metadata[3]: q_len
+// - metadata[4]: kv_len
+// - metadata[5]: head_dim
+// - metadata[6..10]: q strides (batch, head, seq, dim)
+// - metadata[10..14]: k strides (batch, head, seq, dim)
+// - metadata[14..18]: v strides (batch, head, seq, dim)
+// - metadata[18]: q offset
+// - metadata[19]: k offset
+// - metadata[20]: v offset
+// - metadata[21]: causal (1 to apply the causal mask, 0 otherwise)
+// - metadata[22]: has_kv_lens (1 if per-batch key lengths follow, 0 otherwise)
+// - metadata[23..23+batch]: kv_lens (valid keys per batch, if has_kv_lens)
+
+void hodu_cpu_attention_bf16(const void *q, const void *k, const void *v, void *output,
+                             const size_t *metadata, float scale);
+void hodu_cpu_attention_f16(const void *q, const void *k, const void *v, void *output,
+                            const size_t *metadata, float scale);
+void hodu_cpu_attention_f32(const void *q, const void *k, const void *v, void *output,
+                            const size_t *metadata, float scale);
+
+// ============================================================================
+// DECODE ATTENTION (KV CACHE)
+// ============================================================================
+//
+// One new query token per sequence against a KV cache that already holds the
+// token's own key/value:
+// Q/output: contiguous [batch, num_heads, head_dim]
+// K/V cache: contiguous [batch, num_kv_heads, capacity, head_dim]
+// The query of sequence b attends to cache positions [0, cache_lens[b]).
+//
+// Metadata layout:
+// - metadata[0]: batch
+// - metadata[1]: num_heads
+// - metadata[2]: num_kv_heads
+// - metadata[3]: head_dim
+// - metadata[4]: capacity (allocated positions per cache head)
+// - metadata[5..5+batch]: cache_lens (filled positions per batch)
+
+void hodu_cpu_attention_decode_bf16(const void *q, const void *k_cache, const void *v_cache,
+                                    void *output, const size_t *metadata, float scale);
+void hodu_cpu_attention_decode_f16(const void *q, const void *k_cache, const void *v_cache,
+                                   void *output, const size_t *metadata, float scale);
+void hodu_cpu_attention_decode_f32(const void *q, const void *k_cache, const void *v_cache,
+                                   void *output, const size_t *metadata, float scale);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -1,22 +1,32 @@
 #include "ops_binary.h"
+#include "profile.h"
 #include "simd_utils.h"
+#include "strided_copy.h"
 #include "t_f8e4m3.h"
 #include "thread_utils.h"
 #include "types.h"
+#include "workspace.h"
 #include <math.h>
+#include <string.h>
 
 // ============================================================================
 // BINARY OPERATION IMPLEMENTATION MACROS
 // ============================================================================
 //
 // This file implements element-wise binary operations for tensors.
-// Operations are optimized by checking tensor contiguity to use faster loops.
 //
-// Four optimization paths:
-// 1. Both tensors contiguous: Simple linear iteration
-// 2. LHS contiguous, RHS strided: Compute RHS indices only
-// 3. LHS strided, RHS contiguous: Compute LHS indices only
-// 4. Both strided: Compute both indices
+// Every operation runs through one broadcast-aware loop:
+// 1. Plan: drop size-1 dims and merge neighbouring dims that both operands walk with
+//    compatible strides, so the output becomes [outer..., inner] with fixed operand strides
+//    (a contiguous pair collapses to one dim, bias [C] over [N, C] stays [N, C] with rhs
+//    strides [0, 1], a per-channel scale over NCHW becomes [N, C, HW] with rhs strides
+//    [0, 1, 0])
+// 2. Split the output elements over the thread pool; each task walks its range row by row
+//    with an incremental index over the outer dims, so no per-element index math remains
+// 3. Each row runs a per-operation row kernel specialized on the inner strides:
+//    - both contiguous: vector-vector
+//    - one operand with inner stride 0 (scalar or column broadcast): vector-scalar
+//    - anything else: strided scalar loop
 //
 // Metadata layout:
 // - metadata[0]: num_els (total number of elements)
@@ -27,10 +37,292 @@
 // - metadata[2+3*num_dims..2+4*num_dims]: rhs_strides
 // - metadata[2+4*num_dims]: lhs_offset
 // - metadata[2+4*num_dims+1]: rhs_offset
+//
+// Broadcast operands arrive expanded to the output shape with stride 0 along the broadcast
+// dims. Operands whose shapes differ (or with more than BINARY_MAX_DIMS dims) take a
+// per-element fallback that decomposes each index against its own shape.
+//
+// In place: the output may equal either operand (or both) when that operand is contiguous at
+// offset 0 and has the output's element size. An operand overlapping the output in any
+// other way is first copied to a contiguous workspace block.
+
+/// Maximum number of dimensions handled by the broadcast plan
+#define BINARY_MAX_DIMS 16
+
+/// Row kernel: n output elements from operands walked with the given element strides
+typedef void (*binary_row_fn_t)(const void *lhs, const void *rhs, void *output, size_t n,
+                                size_t lhs_stride, size_t rhs_stride);
+
+/// Binary loop plan built from the binary metadata
+typedef struct {
+    size_t num_dims;                     // Merged dims, outermost first (at least 1)
+    size_t shape[BINARY_MAX_DIMS];       // Merged dim sizes
+    size_t lhs_strides[BINARY_MAX_DIMS]; // Merged lhs strides
+    size_t rhs_strides[BINARY_MAX_DIMS]; // Merged rhs strides
+    size_t lhs_offset;                   // Starting offset in lhs
+    size_t rhs_offset;                   // Starting offset in rhs
+} binary_plan_t;
+
+/// Build a plan from the binary metadata; returns false if the operand shapes differ
+static bool binary_plan_init(binary_plan_t *plan, const size_t *metadata) {
+    const size_t num_dims = metadata[1];
+    const size_t *lhs_shape = metadata + 2;
+    const size_t *rhs_shape = metadata + 2 + num_dims;
+    const size_t *lhs_strides = metadata + 2 + 2 * num_dims;
+    const size_t *rhs_strides = metadata + 2 + 3 * num_dims;
+
+    if (num_dims > BINARY_MAX_DIMS)
+        return false;
+    plan->lhs_offset = metadata[2 + 4 * num_dims];
+    plan->rhs_offset = metadata[2 + 4 * num_dims + 1];
+    plan->num_dims = 0;
+    for (size_t d = 0; d < num_dims; d++) {
+        if (lhs_shape[d] != rhs_shape[d])
+            return false;
+        const size_t size = lhs_shape[d];
+        if (size == 1)
+            continue;
+        const size_t n = plan->num_dims;
+        if (n > 0 && plan->lhs_strides[n - 1] == size * lhs_strides[d] &&
+            plan->rhs_strides[n - 1] == size * rhs_strides[d]) {
+            plan->shape[n - 1] *= size;
+            plan->lhs_strides[n - 1] = lhs_strides[d];
+            plan->rhs_strides[n - 1] = rhs_strides[d];
+            continue;
+        }
+        plan->shape[n] = size;
+        plan->lhs_strides[n] = lhs_strides[d];
+        plan->rhs_strides[n] = rhs_strides[d];
+        plan->num_dims++;
+    }
+    if (plan->num_dims == 0) {
+        plan->shape[0] = 1;
+        plan->lhs_strides[0] = 0;
+        plan->rhs_strides[0] = 0;
+        plan->num_dims = 1;
+    }
+    return true;
+}
+
+/// Arguments of one binary operation shared by all pool tasks
+typedef struct {
+    const uint8_t *lhs;
+    const uint8_t *rhs;
+    uint8_t *output;
+    size_t elem_size; // Operand element size in bytes
+    size_t out_size;  // Output element size in bytes
+    binary_row_fn_t row;
+    const size_t *metadata;
+    binary_plan_t plan;
+} binary_loop_t;
+
+/// Walk output elements [start, end) of a plan one (partial) row at a time
+static void binary_loop_worker(size_t start, size_t end, void *arg) {
+    const binary_loop_t *loop = (const binary_loop_t *)arg;
+    const binary_plan_t *plan = &loop->plan;
+    const size_t last = plan->num_dims - 1;
+    const size_t inner = plan->shape[last];
+    const size_t lhs_step = plan->lhs_strides[last];
+    const size_t rhs_step = plan->rhs_strides[last];
+
+    size_t index[BINARY_MAX_DIMS];
+    size_t lhs_i = plan->lhs_offset;
+    size_t rhs_i = plan->rhs_offset;
+    size_t pos = start;
+    for (size_t d = plan->num_dims; d-- > 0;) {
+        index[d] = pos % plan->shape[d];
+        lhs_i += index[d] * plan->lhs_strides[d];
+        rhs_i += index[d] * plan->rhs_strides[d];
+        pos /= plan->shape[d];
+    }
+
+    for (size_t i = start; i < end;) {
+        const size_t n = MINIMUM(inner - index[last], end - i);
+        loop->row(loop->lhs + lhs_i * loop->elem_size, loop->rhs + rhs_i * loop->elem_size,
+                  loop->output + i * loop->out_size, n, lhs_step, rhs_step);
+        i += n;
+        index[last] += n;
+        lhs_i += n * lhs_step;
+        rhs_i += n * rhs_step;
+        for (size_t d = last; d > 0 && index[d] == plan->shape[d]; d--) {
+            lhs_i -= plan->shape[d] * plan->lhs_strides[d];
+            rhs_i -= plan->shape[d] * plan->rhs_strides[d];
+            index[d] = 0;
+            index[d - 1]++;
+            lhs_i += plan->lhs_strides[d - 1];
+            rhs_i += plan->rhs_strides[d - 1];
+        }
+    }
+}
+
+/// Fallback for operands with different shapes: walk each operand over its own shape
+static void binary_loop_strided(const binary_loop_t *loop) {
+    const size_t *metadata = loop->metadata;
+    const size_t num_els = metadata[0];
+    const size_t num_dims = metadata[1];
+    const size_t *lhs_shape = metadata + 2;
+    const size_t *rhs_shape = metadata + 2 + num_dims;
+    const size_t *lhs_strides = metadata + 2 + 2 * num_dims;
+    const size_t *rhs_strides = metadata + 2 + 3 * num_dims;
+    const size_t lhs_offset = metadata[2 + 4 * num_dims];
+    const size_t rhs_offset = metadata[2 + 4 * num_dims + 1];
+
+    strided_iter_t lhs_it, rhs_it;
+    strided_iter_init(&lhs_it, num_dims, lhs_shape, lhs_strides, 0);
+    strided_iter_init(&rhs_it, num_dims, rhs_shape, rhs_strides, 0);
+    for (size_t i = 0; i < num_els; i++) {
+        size_t lhs_i = lhs_offset + lhs_it.offset;
+        size_t rhs_i = rhs_offset + rhs_it.offset;
+        strided_iter_next(&lhs_it);
+        strided_iter_next(&rhs_it);
+        loop->row(loop->lhs + lhs_i * loop->elem_size, loop->rhs + rhs_i * loop->elem_size,
+                  loop->output + i * loop->out_size, 1, 0, 0);
+    }
+}
+
+/// Run a row kernel over a binary operation described by metadata
+///
+/// Tasks are sized from the calling kernel's measured cost per element (`cost`).
+static void binary_run(const void *lhs, const void *rhs, void *output, const size_t *metadata,
+                       size_t elem_size, size_t out_size, binary_row_fn_t row,
+                       hodu_cpu_cost_t *cost) {
+    binary_loop_t loop;
+    loop.lhs = (const uint8_t *)lhs;
+    loop.rhs = (const uint8_t *)rhs;
+    loop.output = (uint8_t *)output;
+    loop.elem_size = elem_size;
+    loop.out_size = out_size;
+    loop.row = row;
+    loop.metadata = metadata;
+
+    /* Operands overlapping the output are read from copies unless they sit exactly on it */
+    const size_t num_dims = metadata[1];
+    size_t staged_metadata[2 + 4 * BINARY_MAX_DIMS + 2];
+    void *staged[2] = {NULL, NULL};
+    if (metadata[0] > 0 && num_dims <= BINARY_MAX_DIMS) {
+        const uint8_t **operands[2] = {&loop.lhs, &loop.rhs};
+        for (size_t k = 0; k < 2; k++) {
+            const size_t *shape = metadata + 2 + k * num_dims;
+            const size_t *strides = metadata + 2 + (2 + k) * num_dims;
+            const size_t offset = metadata[2 + 4 * num_dims + k];
+            staged[k] = hodu_cpu_stage_overlapping_view(*operands[k] + offset * elem_size,
+                                                        elem_size, num_dims, shape, strides,
+                                                        output, out_size);
+            if (!staged[k]) {
+                continue;
+            }
+            if (metadata != staged_metadata) {
+                memcpy(staged_metadata, metadata, (2 + 4 * num_dims + 2) * sizeof(size_t));
+                metadata = staged_metadata;
+            }
+            size_t *copy_strides = staged_metadata + 2 + (2 + k) * num_dims;
+            size_t stride = 1;
+            for (size_t d = num_dims; d-- > 0;) {
+                copy_strides[d] = stride;
+                stride *= shape[d];
+            }
+            staged_metadata[2 + 4 * num_dims + k] = 0;
+            *operands[k] = (const uint8_t *)staged[k];
+        }
+    }
+    loop.metadata = metadata;
+
+    if (!binary_plan_init(&loop.plan, metadata)) {
+        binary_loop_strided(&loop);
+    } else {
+        parallel_for_measured(cost, HODU_CPU_COST_ELEMENTWISE, 0, metadata[0], binary_loop_worker,
+                              &loop);
+    }
+    /* Releasing the first block also returns any block taken after it */
+    if (staged[0] || staged[1]) {
+        workspace_release(staged[0] ? staged[0] : staged[1]);
+    }
+}
+
+#define BINARY_PASS(v) (v)
+#define BINARY_TO_U8(v) ((v) ? 1 : 0)
+
+/// Scalar row loops shared by all row kernels
+///
+/// Expects l, r, out, n, ls and rs in scope; binds x and y (of VAL_TYPE, via LOAD) for FUNC
+/// and writes STORE(FUNC). The contiguous and broadcast cases are split out so the compiler
+/// can vectorize them.
+#define BINARY_ROW_LOOPS(VAL_TYPE, FUNC, LOAD, STORE)                                              \
+    if (ls == 1 && rs == 1) {                                                                      \
+        for (size_t i = 0; i < n; i++) {                                                           \
+            VAL_TYPE x = LOAD(l[i]);                                                               \
+            VAL_TYPE y = LOAD(r[i]);                                                               \
+            out[i] = STORE(FUNC);                                                                  \
+        }                                                                                          \
+    } else if (ls == 1 && rs == 0) {                                                               \
+        const VAL_TYPE y = LOAD(r[0]);                                                             \
+        for (size_t i = 0; i < n; i++) {                                                           \
+            VAL_TYPE x = LOAD(l[i]);                                                               \
+            out[i] = STORE(FUNC);                                                                  \
+        }                                                                                          \
+    } else if (ls == 0 && rs == 1) {                                                               \
+        const VAL_TYPE x = LOAD(l[0]);                                                             \
+        for (size_t i = 0; i < n; i++) {                                                           \
+            VAL_TYPE y = LOAD(r[i]);                                                               \
+            out[i] = STORE(FUNC);                                                                  \
+        }                                                                                          \
+    } else {                                                                                       \
+        for (size_t i = 0; i < n; i++) {                                                           \
+            VAL_TYPE x = LOAD(l[i * ls]);                                                          \
+            VAL_TYPE y = LOAD(r[i * rs]);                                                          \
+            out[i] = STORE(FUNC);                                                                  \
+        }                                                                                          \
+    }
+
+/// Elements widened to f32 at a time by the converting variants
+#define BINARY_CONVERT_BLOCK 256
+
+/// Store a block of f32 predicate results (0 or 1) as uint8_t
+static inline void binary_store_bool(const float *src, uint8_t *dst, size_t n) {
+    for (size_t i = 0; i < n; i++)
+        dst[i] = src[i] != 0.0f;
+}
+
+/// Row loop for the converting variants
+///
+/// Expects l, r, out, n, ls and rs in scope. Rows with inner strides of 0 or 1 are widened
+/// to f32 one block at a time (simd_widen_<TYPE_SUFFIX>; a stride-0 operand is widened once),
+/// FUNC is evaluated over the block with x and y bound as floats, and STORE_BLOCK(src, dst, n)
+/// writes the f32 results to out. Other rows take the scalar BINARY_ROW_LOOPS with
+/// TO_FLOAT/STORE.
+#define BINARY_CONVERT_ROW(TYPE_SUFFIX, FUNC, TO_FLOAT, STORE, STORE_BLOCK)                        \
+    if (ls > 1 || rs > 1) {                                                                        \
+        BINARY_ROW_LOOPS(float, FUNC, TO_FLOAT, STORE)                                             \
+        return;                                                                                    \
+    }                                                                                              \
+    float xb[BINARY_CONVERT_BLOCK], yb[BINARY_CONVERT_BLOCK], zb[BINARY_CONVERT_BLOCK];            \
+    if (ls == 0) {                                                                                 \
+        const float xs = TO_FLOAT(l[0]);                                                           \
+        for (size_t j = 0; j < BINARY_CONVERT_BLOCK; j++)                                          \
+            xb[j] = xs;                                                                            \
+    }                                                                                              \
+    if (rs == 0) {                                                                                 \
+        const float ys = TO_FLOAT(r[0]);                                                           \
+        for (size_t j = 0; j < BINARY_CONVERT_BLOCK; j++)                                          \
+            yb[j] = ys;                                                                            \
+    }                                                                                              \
+    for (size_t b = 0; b < n; b += BINARY_CONVERT_BLOCK) {                                         \
+        const size_t bn = MINIMUM((size_t)BINARY_CONVERT_BLOCK, n - b);                            \
+        if (ls)                                                                                    \
+            simd_widen_##TYPE_SUFFIX(l + b, xb, bn);                                               \
+        if (rs)                                                                                    \
+            simd_widen_##TYPE_SUFFIX(r + b, yb, bn);                                               \
+        for (size_t j = 0; j < bn; j++) {                                                          \
+            float x = xb[j];                                                                       \
+            float y = yb[j];                                                                       \
+            zb[j] = FUNC;                                                                          \
+        }                                                                                          \
+        STORE_BLOCK(zb, out + b, bn);                                                              \
+    }
 
 /// Macro to implement a binary operation returning the same type
 ///
-/// Generates optimized implementations with contiguity checks.
+/// Generates a row kernel and an entry point that runs it through binary_run.
 ///
 /// @param TYPE C type for the operation (e.g., f32_t, i32_t)
 /// @param TYPE_SUFFIX Suffix for function naming (e.g., f32, i32)
@@ -42,105 +334,21 @@
 /// - Integer overflow: Not checked for performance; wraps according to C semantics
 /// - Unsigned underflow: Checked explicitly (e.g., sub uses (x > y) ? (x - y) : 0)
 #define IMPL_BINARY_OP(TYPE, TYPE_SUFFIX, OP_NAME, FUNC)                                           \
-    typedef struct {                                                                               \
-        const TYPE *lhs;                                                                           \
-        const TYPE *rhs;                                                                           \
-        TYPE *output;                                                                              \
-        size_t start;                                                                              \
-        size_t end;                                                                                \
-        size_t lhs_offset;                                                                         \
-        size_t rhs_offset;                                                                         \
-    } binary_##OP_NAME##_##TYPE_SUFFIX##_args_t;                                                   \
-                                                                                                   \
-    static void *binary_##OP_NAME##_##TYPE_SUFFIX##_worker(void *arg) {                            \
-        binary_##OP_NAME##_##TYPE_SUFFIX##_args_t *args =                                          \
-            (binary_##OP_NAME##_##TYPE_SUFFIX##_args_t *)arg;                                      \
-        for (size_t i = args->start; i < args->end; i++) {                                         \
-            TYPE x = args->lhs[args->lhs_offset + i];                                              \
-            TYPE y = args->rhs[args->rhs_offset + i];                                              \
-            args->output[i] = FUNC;                                                                \
-        }                                                                                          \
-        return NULL;                                                                               \
-    }                                                                                              \
-                                                                                                   \
-    void hodu_cpu_##OP_NAME##_##TYPE_SUFFIX(const void *lhs, const void *rhs, void *output,        \
-                                            const size_t *metadata) {                              \
+    static void binary_##OP_NAME##_##TYPE_SUFFIX##_row(const void *lhs, const void *rhs,           \
+                                                       void *output, size_t n, size_t ls,          \
+                                                       size_t rs) {                                \
         const TYPE *l = (const TYPE *)lhs;                                                         \
         const TYPE *r = (const TYPE *)rhs;                                                         \
         TYPE *out = (TYPE *)output;                                                                \
+        BINARY_ROW_LOOPS(TYPE, FUNC, BINARY_PASS, BINARY_PASS)                                     \
+    }                                                                                              \
                                                                                                    \
-        const size_t num_els = metadata[0];                                                        \
-        const size_t num_dims = metadata[1];                                                       \
-        const size_t *lhs_shape = metadata + 2;                                                    \
-        const size_t *rhs_shape = metadata + 2 + num_dims;                                         \
-        const size_t *lhs_strides = metadata + 2 + 2 * num_dims;                                   \
-        const size_t *rhs_strides = metadata + 2 + 3 * num_dims;                                   \
-        const size_t lhs_offset = metadata[2 + 4 * num_dims];                                      \
-        const size_t rhs_offset = metadata[2 + 4 * num_dims + 1];                                  \
-                                                                                                   \
-        bool lhs_cont = is_contiguous(num_dims, lhs_shape, lhs_strides);                           \
-        bool rhs_cont = is_contiguous(num_dims, rhs_shape, rhs_strides);                           \
-                                                                                                   \
-        if (lhs_cont && rhs_cont) {                                                                \
-            const size_t min_work_per_thread = 100000;                                             \
-            size_t num_threads = get_optimal_threads(num_els, min_work_per_thread);                \
-                                                                                                   \
-            if (num_threads > 1) {                                                                 \
-                thread_t threads[num_threads];                                                     \
-                binary_##OP_NAME##_##TYPE_SUFFIX##_args_t args[num_threads];                       \
-                                                                                                   \
-                size_t chunk_size = num_els / num_threads;                                         \
-                size_t remaining = num_els % num_threads;                                          \
-                                                                                                   \
-                for (size_t t = 0; t < num_threads; t++) {                                         \
-                    args[t].lhs = l;                                                               \
-                    args[t].rhs = r;                                                               \
-                    args[t].output = out;                                                          \
-                    args[t].lhs_offset = lhs_offset;                                               \
-                    args[t].rhs_offset = rhs_offset;                                               \
-                    args[t].start = t * chunk_size + (t < remaining ? t : remaining);              \
-                    args[t].end = args[t].start + chunk_size + (t < remaining ? 1 : 0);            \
-                    thread_create(&threads[t], binary_##OP_NAME##_##TYPE_SUFFIX##_worker,          \
-                                  &args[t]);                                                       \
-                }                                                                                  \
-                                                                                                   \
-                for (size_t t = 0; t < num_threads; t++) {                                         \
-                    thread_join(threads[t]);                                                       \
-                }                                                                                  \
-            } else {                                                                               \
-                for (size_t i = 0; i < num_els; i++) {                                             \
-                    TYPE x = l[lhs_offset + i];                                                    \
-                    TYPE y = r[rhs_offset + i];                                                    \
-                    out[i] = FUNC;                                                                 \
-                }                                                                                  \
-            }                                                                                      \
-        } else if (lhs_cont) {                                                                     \
-            for (size_t i = 0; i < num_els; i++) {                                                 \
-                size_t rhs_i =                                                                     \
-                    rhs_offset + get_strided_index(i, num_dims, rhs_shape, rhs_strides);           \
-                TYPE x = l[lhs_offset + i];                                                        \
-                TYPE y = r[rhs_i];                                                                 \
-                out[i] = FUNC;                                                                     \
-            }                                                                                      \
-        } else if (rhs_cont) {                                                                     \
-            for (size_t i = 0; i < num_els; i++) {                                                 \
-                size_t lhs_i =                                                                     \
-                    lhs_offset + get_strided_index(i, num_dims, lhs_shape, lhs_strides);           \
-                TYPE x = l[lhs_i];                                                                 \
-                TYPE y = r[rhs_offset + i];                                                        \
-                out[i] = FUNC;                                                                     \
-            }                                                                                      \
-        } else {                                                                                   \
-            for (size_t i = 0; i < num_els; i++) {                                                 \
-                size_t lhs_i =                                                                     \
-                    lhs_offset + get_strided_index(i, num_dims, lhs_shape, lhs_strides);           \
-                size_t rhs_i =                                                                     \
-                    rhs_offset + get_strided_index(i, num_dims, rhs_shape, rhs_strides);           \
-                TYPE x = l[lhs_i];                                                                 \
-                TYPE y = r[rhs_i];                                                                 \
-                out[i] = FUNC;                                                                     \
-            }                                                                                      \
-        }                                                                                          \
+    void hodu_cpu_##OP_NAME##_##TYPE_SUFFIX(const void *lhs, const void *rhs, void *output,        \
+                                            const size_t *metadata) {                              \
+        HODU_PROFILE_KERNEL(metadata[0] * 3 * sizeof(TYPE));                                       \
+        static hodu_cpu_cost_t cost;                                                               \
+        binary_run(lhs, rhs, output, metadata, sizeof(TYPE), sizeof(TYPE),                         \
+                   binary_##OP_NAME##_##TYPE_SUFFIX##_row, &cost);                                 \
     }
 
 /// Macro to implement a binary operation returning boolean (uint8_t)
@@ -153,45 +361,21 @@
 /// @param OP_NAME Operation name
 /// @param FUNC Boolean expression to evaluate (e.g., x < y, x && y)
 #define IMPL_BINARY_TO_BOOL(TYPE, TYPE_SUFFIX, OP_NAME, FUNC)                                      \
-    void hodu_cpu_##OP_NAME##_##TYPE_SUFFIX(const void *lhs, const void *rhs, void *output,        \
-                                            const size_t *metadata) {                              \
+    static void binary_##OP_NAME##_##TYPE_SUFFIX##_row(const void *lhs, const void *rhs,           \
+                                                       void *output, size_t n, size_t ls,          \
+                                                       size_t rs) {                                \
         const TYPE *l = (const TYPE *)lhs;                                                         \
         const TYPE *r = (const TYPE *)rhs;                                                         \
         uint8_t *out = (uint8_t *)output;                                                          \
+        BINARY_ROW_LOOPS(TYPE, FUNC, BINARY_PASS, BINARY_TO_U8)                                    \
+    }                                                                                              \
                                                                                                    \
-        const size_t num_els = metadata[0];                                                        \
-        const size_t num_dims = metadata[1];                                                       \
-        const size_t *lhs_shape = metadata + 2;                                                    \
-        const size_t *rhs_shape = metadata + 2 + num_dims;                                         \
-        const size_t *lhs_strides = metadata + 2 + 2 * num_dims;                                   \
-        const size_t *rhs_strides = metadata + 2 + 3 * num_dims;                                   \
-        const size_t lhs_offset = metadata[2 + 4 * num_dims];                                      \
-        const size_t rhs_offset = metadata[2 + 4 * num_dims + 1];                                  \
-                                                                                                   \
-        bool lhs_cont = (metadata == NULL) || is_contiguous(num_dims, lhs_shape, lhs_strides);     \
-        bool rhs_cont = (metadata == NULL) || is_contiguous(num_dims, rhs_shape, rhs_strides);     \
-                                                                                                   \
-        if (lhs_cont && rhs_cont) {                                                                \
-            for (size_t i = 0; i < num_els; i++) {                                                 \
-                TYPE x = l[lhs_offset + i];                                                        \
-                TYPE y = r[rhs_offset + i];                                                        \
-                out[i] = (FUNC) ? 1 : 0;                                                           \
-            }                                                                                      \
-        } else {                                                                                   \
-            for (size_t i = 0; i < num_els; i++) {                                                 \
-                size_t lhs_i =                                                                     \
-                    lhs_cont                                                                       \
-                        ? (lhs_offset + i)                                                         \
-                        : (lhs_offset + get_strided_index(i, num_dims, lhs_shape, lhs_strides));   \
-                size_t rhs_i =                                                                     \
-                    rhs_cont                                                                       \
-                        ? (rhs_offset + i)                                                         \
-                        : (rhs_offset + get_strided_index(i, num_dims, rhs_shape, rhs_strides));   \
-                TYPE x = l[lhs_i];                                                                 \
-                TYPE y = r[rhs_i];                                                                 \
-                out[i] = (FUNC) ? 1 : 0;                                                           \
-            }                                                                                      \
-        }                                                                                          \
+    void hodu_cpu_##OP_NAME##_##TYPE_SUFFIX(const void *lhs, const void *rhs, void *output,        \
+                                            const size_t *metadata) {                              \
+        HODU_PROFILE_KERNEL(metadata[0] * (2 * sizeof(TYPE) + sizeof(uint8_t)));                   \
+        static hodu_cpu_cost_t cost;                                                               \
+        binary_run(lhs, rhs, output, metadata, sizeof(TYPE), sizeof(uint8_t),                      \
+                   binary_##OP_NAME##_##TYPE_SUFFIX##_row, &cost);                                 \
     }
 
 /// Macro to implement a binary operation with type conversion for reduced-precision floats
@@ -207,57 +391,21 @@
 /// @param FROM_FLOAT Function to convert from float to storage type
 // Macros for f8/f16/BF16 with float conversion
 #define IMPL_BINARY_OP_CONVERT(TYPE, TYPE_SUFFIX, OP_NAME, FUNC, TO_FLOAT, FROM_FLOAT)             \
-    void hodu_cpu_##OP_NAME##_##TYPE_SUFFIX(const void *lhs, const void *rhs, void *output,        \
-                                            const size_t *metadata) {                              \
+    static void binary_##OP_NAME##_##TYPE_SUFFIX##_row(const void *lhs, const void *rhs,           \
+                                                       void *output, size_t n, size_t ls,          \
+                                                       size_t rs) {                                \
         const TYPE *l = (const TYPE *)lhs;                                                         \
         const TYPE *r = (const TYPE *)rhs;                                                         \
         TYPE *out = (TYPE *)output;                                                                \
+        BINARY_CONVERT_ROW(TYPE_SUFFIX, FUNC, TO_FLOAT, FROM_FLOAT, simd_narrow_##TYPE_SUFFIX)     \
+    }                                                                                              \
                                                                                                    \
-        const size_t num_els = metadata[0];                                                        \
-        const size_t num_dims = metadata[1];                                                       \
-        const size_t *lhs_shape = metadata + 2;                                                    \
-        const size_t *rhs_shape = metadata + 2 + num_dims;                                         \
-        const size_t *lhs_strides = metadata + 2 + 2 * num_dims;                                   \
-        const size_t *rhs_strides = metadata + 2 + 3 * num_dims;                                   \
-        const size_t lhs_offset = metadata[2 + 4 * num_dims];                                      \
-        const size_t rhs_offset = metadata[2 + 4 * num_dims + 1];                                  \
-                                                                                                   \
-        bool lhs_cont = (metadata == NULL) || is_contiguous(num_dims, lhs_shape, lhs_strides);     \
-        bool rhs_cont = (metadata == NULL) || is_contiguous(num_dims, rhs_shape, rhs_strides);     \
-                                                                                                   \
-        if (lhs_cont && rhs_cont) {                                                                \
-            for (size_t i = 0; i < num_els; i++) {                                                 \
-                float x = TO_FLOAT(l[lhs_offset + i]);                                             \
-                float y = TO_FLOAT(r[rhs_offset + i]);                                             \
-                out[i] = FROM_FLOAT(FUNC);                                                         \
-            }                                                                                      \
-        } else if (lhs_cont) {                                                                     \
-            for (size_t i = 0; i < num_els; i++) {                                                 \
-                size_t rhs_i =                                                                     \
-                    rhs_offset + get_strided_index(i, num_dims, rhs_shape, rhs_strides);           \
-                float x = TO_FLOAT(l[lhs_offset + i]);                                             \
-                float y = TO_FLOAT(r[rhs_i]);                                                      \
-                out[i] = FROM_FLOAT(FUNC);                                                         \
-            }                                                                                      \
-        } else if (rhs_cont) {                                                                     \
-            for (size_t i = 0; i < num_els; i++) {                                                 \
-                size_t lhs_i =                                                                     \
-                    lhs_offset + get_strided_index(i, num_dims, lhs_shape, lhs_strides);           \
-                float x = TO_FLOAT(l[lhs_i]);                                                      \
-                float y = TO_FLOAT(r[rhs_offset + i]);                                             \
-                out[i] = FROM_FLOAT(FUNC);                                                         \
-            }                                                                                      \
-        } else {                                                                                   \
-            for (size_t i = 0; i < num_els; i++) {                                                 \
-                size_t lhs_i =                                                                     \
-                    lhs_offset + get_strided_index(i, num_dims, lhs_shape, lhs_strides);           \
-                size_t rhs_i =                                                                     \
-                    rhs_offset + get_strided_index(i, num_dims, rhs_shape, rhs_strides);           \
-                float x = TO_FLOAT(l[lhs_i]);                                                      \
-                float y = TO_FLOAT(r[rhs_i]);                                                      \
-                out[i] = FROM_FLOAT(FUNC);                                                         \
-            }                                                                                      \
-        }                                                                                          \
+    void hodu_cpu_##OP_NAME##_##TYPE_SUFFIX(const void *lhs, const void *rhs, void *output,        \
+                                            const size_t *metadata) {                              \
+        HODU_PROFILE_KERNEL(metadata[0] * 3 * sizeof(TYPE));                                       \
+        static hodu_cpu_cost_t cost;                                                               \
+        binary_run(lhs, rhs, output, metadata, sizeof(TYPE), sizeof(TYPE),                         \
+                   binary_##OP_NAME##_##TYPE_SUFFIX##_row, &cost);                                 \
     }
 
 /// Macro to implement a boolean-returning operation with type conversion
@@ -270,47 +418,50 @@
 /// @param FUNC Boolean expression (evaluated in float precision)
 /// @param TO_FLOAT Function to convert from storage type to float
 #define IMPL_BINARY_TO_BOOL_CONVERT(TYPE, TYPE_SUFFIX, OP_NAME, FUNC, TO_FLOAT)                    \
-    void hodu_cpu_##OP_NAME##_##TYPE_SUFFIX(const void *lhs, const void *rhs, void *output,        \
-                                            const size_t *metadata) {                              \
+    static void binary_##OP_NAME##_##TYPE_SUFFIX##_row(const void *lhs, const void *rhs,           \
+                                                       void *output, size_t n, size_t ls,          \
+                                                       size_t rs) {                                \
         const TYPE *l = (const TYPE *)lhs;                                                         \
         const TYPE *r = (const TYPE *)rhs;                                                         \
         uint8_t *out = (uint8_t *)output;                                                          \
+        BINARY_CONVERT_ROW(TYPE_SUFFIX, FUNC, TO_FLOAT, BINARY_TO_U8, binary_store_bool)           \
+    }                                                                                              \
                                                                                                    \
-        const size_t num_els = metadata[0];                                                        \
-        const size_t num_dims = metadata[1];                                                       \
-        const size_t *lhs_shape = metadata + 2;                                                    \
-        const size_t *rhs_shape = metadata + 2 + num_dims;                                         \
-        const size_t *lhs_strides = metadata + 2 + 2 * num_dims;                                   \
-        const size_t *rhs_strides = metadata + 2 + 3 * num_dims;                                   \
-        const size_t lhs_offset = metadata[2 + 4 * num_dims];                                      \
-        const size_t rhs_offset = metadata[2 + 4 * num_dims + 1];                                  \
-                                                                                                   \
-        bool lhs_cont = (metadata == NULL) || is_contiguous(num_dims, lhs_shape, lhs_strides);     \
-        bool rhs_cont = (metadata == NULL) || is_contiguous(num_dims, rhs_shape, rhs_strides);     \
-                                                                                                   \
-        if (lhs_cont && rhs_cont) {                                                                \
-            for (size_t i = 0; i < num_els; i++) {                                                 \
-                float x = TO_FLOAT(l[lhs_offset + i]);                                             \
-                float y = TO_FLOAT(r[rhs_offset + i]);                                             \
-                out[i] = (FUNC) ? 1 : 0;                                                           \
-            }                                                                                      \
-        } else {                                                                                   \
-            for (size_t i = 0; i < num_els; i++) {                                                 \
-                size_t lhs_i =                                                                     \
-                    lhs_cont                                                                       \
-                        ? (lhs_offset + i)                                                         \
-                        : (lhs_offset + get_strided_index(i, num_dims, lhs_shape, lhs_strides));   \
-                size_t rhs_i =                                                                     \
-                    rhs_cont                                                                       \
-                        ? (rhs_offset + i)                                                         \
-                        : (rhs_offset + get_strided_index(i, num_dims, rhs_shape, rhs_strides));   \
-                float x = TO_FLOAT(l[lhs_i]);                                                      \
-                float y = TO_FLOAT(r[rhs_i]);                                                      \
-                out[i] = (FUNC) ? 1 : 0;                                                           \
-            }                                                                                      \
-        }                                                                                          \
+    void hodu_cpu_##OP_NAME##_##TYPE_SUFFIX(const void *lhs, const void *rhs, void *output,        \
+                                            const size_t *metadata) {                              \
+        HODU_PROFILE_KERNEL(metadata[0] * (2 * sizeof(TYPE) + sizeof(uint8_t)));                   \
+        static hodu_cpu_cost_t cost;                                                               \
+        binary_run(lhs, rhs, output, metadata, sizeof(TYPE), sizeof(uint8_t),                      \
+                   binary_##OP_NAME##_##TYPE_SUFFIX##_row, &cost);                                 \
     }
 
+/// Vector loop over the leading full vectors of a row
+///
+/// Covers the contiguous and broadcast (inner stride 0) cases, then advances l, r, out and
+/// n past the processed elements so BINARY_ROW_LOOPS can finish the row. W is the vector
+/// width; PFX is the simd_<type> prefix.
+#define BINARY_ROW_SIMD(PFX, W, SIMD_OP)                                                           \
+    size_t j = 0;                                                                                  \
+    if (ls == 1 && rs == 1) {                                                                      \
+        for (; j + W <= n; j += W)                                                                 \
+            PFX##_store(&out[j], SIMD_OP(PFX##_load(&l[j]), PFX##_load(&r[j])));                   \
+    } else if (ls == 1 && rs == 0) {                                                               \
+        const PFX##_t vb = PFX##_set1(r[0]);                                                       \
+        for (; j + W <= n; j += W)                                                                 \
+            PFX##_store(&out[j], SIMD_OP(PFX##_load(&l[j]), vb));                                  \
+    } else if (ls == 0 && rs == 1) {                                                               \
+        const PFX##_t va = PFX##_set1(l[0]);                                                       \
+        for (; j + W <= n; j += W)                                                                 \
+            PFX##_store(&out[j], SIMD_OP(va, PFX##_load(&r[j])));                                  \
+    }                                                                                              \
+    if (j > 0) {                                                                                   \
+        HODU_PROFILE_PATH(HODU_CPU_PATH_SIMD);                                                     \
+    }                                                                                              \
+    l += j * ls;                                                                                   \
+    r += j * rs;                                                                                   \
+    out += j;                                                                                      \
+    n -= j;
+
 // ============================================================================
 // SIMD-OPTIMIZED F32 OPERATIONS
 // ============================================================================
@@ -320,71 +471,22 @@
 #if SIMD_F32_WIDTH > 1
 
 #define IMPL_BINARY_OP_F32_SIMD(OP_NAME, SIMD_OP, SCALAR_OP)                                       \
-    void hodu_cpu_##OP_NAME##_f32(const void *lhs, const void *rhs, void *output,                  \
-                                  const size_t *metadata) {                                        \
+    static void binary_##OP_NAME##_f32_row(const void *lhs, const void *rhs, void *output,         \
+                                           size_t n, size_t ls, size_t rs) {                       \
         const f32_t *l = (const f32_t *)lhs;                                                       \
         const f32_t *r = (const f32_t *)rhs;                                                       \
         f32_t *out = (f32_t *)output;                                                              \
+        BINARY_ROW_SIMD(simd_f32, SIMD_F32_WIDTH, SIMD_OP)                                         \
+        /* Scalar remainder or strided row */                                                      \
+        BINARY_ROW_LOOPS(f32_t, SCALAR_OP, BINARY_PASS, BINARY_PASS)                               \
+    }                                                                                              \
                                                                                                    \
-        const size_t num_els = metadata[0];                                                        \
-        const size_t num_dims = metadata[1];                                                       \
-        const size_t *lhs_shape = metadata + 2;                                                    \
-        const size_t *rhs_shape = metadata + 2 + num_dims;                                         \
-        const size_t *lhs_strides = metadata + 2 + 2 * num_dims;                                   \
-        const size_t *rhs_strides = metadata + 2 + 3 * num_dims;                                   \
-        const size_t lhs_offset = metadata[2 + 4 * num_dims];                                      \
-        const size_t rhs_offset = metadata[2 + 4 * num_dims + 1];                                  \
-                                                                                                   \
-        bool lhs_cont = is_contiguous(num_dims, lhs_shape, lhs_strides);                           \
-        bool rhs_cont = is_contiguous(num_dims, rhs_shape, rhs_strides);                           \
-                                                                                                   \
-        if (lhs_cont && rhs_cont) {                                                                \
-            /* SIMD path for contiguous data */                                                    \
-            const f32_t *lhs_data = l + lhs_offset;                                                \
-            const f32_t *rhs_data = r + rhs_offset;                                                \
-            size_t i = 0;                                                                          \
-            const size_t simd_end = (num_els / SIMD_F32_WIDTH) * SIMD_F32_WIDTH;                   \
-                                                                                                   \
-            for (; i < simd_end; i += SIMD_F32_WIDTH) {                                            \
-                simd_f32_t va = simd_f32_load(&lhs_data[i]);                                       \
-                simd_f32_t vb = simd_f32_load(&rhs_data[i]);                                       \
-                simd_f32_t vc = SIMD_OP(va, vb);                                                   \
-                simd_f32_store(&out[i], vc);                                                       \
-            }                                                                                      \
-                                                                                                   \
-            /* Scalar remainder */                                                                 \
-            for (; i < num_els; i++) {                                                             \
-                f32_t x = lhs_data[i];                                                             \
-                f32_t y = rhs_data[i];                                                             \
-                out[i] = SCALAR_OP;                                                                \
-            }                                                                                      \
-        } else if (lhs_cont) {                                                                     \
-            for (size_t i = 0; i < num_els; i++) {                                                 \
-                size_t rhs_i =                                                                     \
-                    rhs_offset + get_strided_index(i, num_dims, rhs_shape, rhs_strides);           \
-                f32_t x = l[lhs_offset + i];                                                       \
-                f32_t y = r[rhs_i];                                                                \
-                out[i] = SCALAR_OP;                                                                \
-            }                                                                                      \
-        } else if (rhs_cont) {                                                                     \
-            for (size_t i = 0; i < num_els; i++) {                                                 \
-                size_t lhs_i =                                                                     \
-                    lhs_offset + get_strided_index(i, num_dims, lhs_shape, lhs_strides);           \
-                f32_t x = l[lhs_i];                                                                \
-                f32_t y = r[rhs_offset + i];                                                       \
-                out[i] = SCALAR_OP;                                                                \
-            }                                                                                      \
-        } else {                                                                                   \
-            for (size_t i = 0; i < num_els; i++) {                                                 \
-                size_t lhs_i =                                                                     \
-                    lhs_offset + get_strided_index(i, num_dims, lhs_shape, lhs_strides);           \
-                size_t rhs_i =                                                                     \
-                    rhs_offset + get_strided_index(i, num_dims, rhs_shape, rhs_strides);           \
-                f32_t x = l[lhs_i];                                                                \
-                f32_t y = r[rhs_i];                                                                \
-                out[i] = SCALAR_OP;                                                                \
-            }                                                                                      \
-        }                                                                                          \
+    void hodu_cpu_##OP_NAME##_f32(const void *lhs, const void *rhs, void *output,                  \
+                                  const size_t *metadata) {                                        \
+        HODU_PROFILE_KERNEL(metadata[0] * 3 * sizeof(f32_t));                                      \
+        static hodu_cpu_cost_t cost;                                                               \
+        binary_run(lhs, rhs, output, metadata, sizeof(f32_t), sizeof(f32_t),                       \
+                   binary_##OP_NAME##_f32_row, &cost);                                             \
     }
 
 IMPL_BINARY_OP_F32_SIMD(add, simd_f32_add, x + y)
@@ -422,69 +524,21 @@ IMPL_BINARY_TO_BOOL(f32_t, f32, ge, x >= y)
 #if SIMD_F64_WIDTH > 1
 
 #define IMPL_BINARY_OP_F64_SIMD(OP_NAME, SIMD_OP, SCALAR_OP)                                       \
-    void hodu_cpu_##OP_NAME##_f64(const void *lhs, const void *rhs, void *output,                  \
-                                  const size_t *metadata) {                                        \
+    static void binary_##OP_NAME##_f64_row(const void *lhs, const void *rhs, void *output,         \
+                                           size_t n, size_t ls, size_t rs) {                       \
         const f64_t *l = (const f64_t *)lhs;                                                       \
         const f64_t *r = (const f64_t *)rhs;                                                       \
         f64_t *out = (f64_t *)output;                                                              \
+        BINARY_ROW_SIMD(simd_f64, SIMD_F64_WIDTH, SIMD_OP)                                         \
+        BINARY_ROW_LOOPS(f64_t, SCALAR_OP, BINARY_PASS, BINARY_PASS)                               \
+    }                                                                                              \
                                                                                                    \
-        const size_t num_els = metadata[0];                                                        \
-        const size_t num_dims = metadata[1];                                                       \
-        const size_t *lhs_shape = metadata + 2;                                                    \
-        const size_t *rhs_shape = metadata + 2 + num_dims;                                         \
-        const size_t *lhs_strides = metadata + 2 + 2 * num_dims;                                   \
-        const size_t *rhs_strides = metadata + 2 + 3 * num_dims;                                   \
-        const size_t lhs_offset = metadata[2 + 4 * num_dims];                                      \
-        const size_t rhs_offset = metadata[2 + 4 * num_dims + 1];                                  \
-                                                                                                   \
-        bool lhs_cont = is_contiguous(num_dims, lhs_shape, lhs_strides);                           \
-        bool rhs_cont = is_contiguous(num_dims, rhs_shape, rhs_strides);                           \
-                                                                                                   \
-        if (lhs_cont && rhs_cont) {                                                                \
-            const f64_t *lhs_data = l + lhs_offset;                                                \
-            const f64_t *rhs_data = r + rhs_offset;                                                \
-            size_t i = 0;                                                                          \
-            const size_t simd_end = (num_els / SIMD_F64_WIDTH) * SIMD_F64_WIDTH;                   \
-                                                                                                   \
-            for (; i < simd_end; i += SIMD_F64_WIDTH) {                                            \
-                simd_f64_t va = simd_f64_load(&lhs_data[i]);                                       \
-                simd_f64_t vb = simd_f64_load(&rhs_data[i]);                                       \
-                simd_f64_t vc = SIMD_OP(va, vb);                                                   \
-                simd_f64_store(&out[i], vc);                                                       \
-            }                                                                                      \
-                                                                                                   \
-            for (; i < num_els; i++) {                                                             \
-                f64_t x = lhs_data[i];                                                             \
-                f64_t y = rhs_data[i];                                                             \
-                out[i] = SCALAR_OP;                                                                \
-            }                                                                                      \
-        } else if (lhs_cont) {                                                                     \
-            for (size_t i = 0; i < num_els; i++) {                                                 \
-                size_t rhs_i =                                                                     \
-                    rhs_offset + get_strided_index(i, num_dims, rhs_shape, rhs_strides);           \
-                f64_t x = l[lhs_offset + i];                                                       \
-                f64_t y = r[rhs_i];                                                                \
-                out[i] = SCALAR_OP;                                                                \
-            }                                                                                      \
-        } else if (rhs_cont) {                                                                     \
-            for (size_t i = 0; i < num_els; i++) {                                                 \
-                size_t lhs_i =                                                                     \
-                    lhs_offset + get_strided_index(i, num_dims, lhs_shape, lhs_strides);           \
-                f64_t x = l[lhs_i];                                                                \
-                f64_t y = r[rhs_offset + i];                                                       \
-                out[i] = SCALAR_OP;                                                                \
-            }                                                                                      \
-        } else {                                                                                   \
-            for (size_t i = 0; i < num_els; i++) {                                                 \
-                size_t lhs_i =                                                                     \
-                    lhs_offset + get_strided_index(i, num_dims, lhs_shape, lhs_strides);           \
-                size_t rhs_i =                                                                     \
-                    rhs_offset + get_strided_index(i, num_dims, rhs_shape, rhs_strides);           \
-                f64_t x = l[lhs_i];                                                                \
-                f64_t y = r[rhs_i];                                                                \
-                out[i] = SCALAR_OP;                                                                \
-            }                                                                                      \
-        }                                                                                          \
+    void hodu_cpu_##OP_NAME##_f64(const void *lhs, const void *rhs, void *output,                  \
+                                  const size_t *metadata) {                                        \
+        HODU_PROFILE_KERNEL(metadata[0] * 3 * sizeof(f64_t));                                      \
+        static hodu_cpu_cost_t cost;                                                               \
+        binary_run(lhs, rhs, output, metadata, sizeof(f64_t), sizeof(f64_t),                       \
+                   binary_##OP_NAME##_f64_row, &cost);                                             \
     }
 
 IMPL_BINARY_OP_F64_SIMD(add, simd_f64_add, x + y)
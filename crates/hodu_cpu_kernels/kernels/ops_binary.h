@@ -3,7 +3,7 @@
  * @brief Binary tensor operations header
  *
  * Declares all element-wise binary operations for tensors including:
- * - Arithmetic operations (add, sub, mul, div, pow, maximum, minimum)
+ * - Arithmetic operations (add, sub, mul, div, rem, pow, maximum, minimum)
  * - Logical operations (logical_and, logical_or, logical_xor)
  * - Comparison operations (eq, ne, lt, le, gt, ge)
  *
@@ -43,11 +43,17 @@ extern "C" {
 // - metadata[2+4*num_dims]: lhs_offset
 // - metadata[2+4*num_dims+1]: rhs_offset
 //
-// Note: Broadcasting must be handled by the caller; these functions assume
-// compatible shapes and perform element-wise operations only.
+// Broadcasting: the caller expands both operands to the output shape, giving
+// broadcast dimensions stride 0 (e.g. bias [C] over [N, C] as rhs strides
+// [0, 1]). Such layouts run through a vectorized row loop, not per-element
+// index math.
+//
+// In place: output may be lhs or rhs itself (same offset, row-major view, same
+// element size as the output), e.g. `a += b`; any other overlap between an
+// operand view and the output is staged through a workspace copy first.
 
 /// Macro to declare arithmetic binary operations for a given type
-/// Declares: add, sub, mul, div, pow, maximum, minimum
+/// Declares: add, sub, mul, div, rem, pow, maximum, minimum
 #define DECLARE_BINARY_OP(TYPE_SUFFIX)                                                             \
     void hodu_cpu_add_##TYPE_SUFFIX(const void *lhs, const void *rhs, void *output,                \
                                     const size_t *metadata);                                       \
@@ -57,6 +63,8 @@ extern "C" {
                                     const size_t *metadata);                                       \
     void hodu_cpu_div_##TYPE_SUFFIX(const void *lhs, const void *rhs, void *output,                \
                                     const size_t *metadata);                                       \
+    void hodu_cpu_rem_##TYPE_SUFFIX(const void *lhs, const void *rhs, void *output,                \
+                                    const size_t *metadata);                                       \
     void hodu_cpu_pow_##TYPE_SUFFIX(const void *lhs, const void *rhs, void *output,                \
                                     const size_t *metadata);                                       \
     void hodu_cpu_maximum_##TYPE_SUFFIX(const void *lhs, const void *rhs, void *output,            \
@@ -1,4 +1,5 @@
 #include "ops_bitwise.h"
+#include "profile.h"
 #include "thread_utils.h"
 #include "types.h"
 
@@ -11,25 +12,23 @@
         const TYPE *lhs;                                                                           \
         const TYPE *rhs;                                                                           \
         TYPE *output;                                                                              \
-        size_t start;                                                                              \
-        size_t end;                                                                                \
         size_t lhs_offset;                                                                         \
         size_t rhs_offset;                                                                         \
     } bitwise_##OP_NAME##_##TYPE_SUFFIX##_args_t;                                                  \
                                                                                                    \
-    static void *bitwise_##OP_NAME##_##TYPE_SUFFIX##_worker(void *arg) {                           \
+    static void bitwise_##OP_NAME##_##TYPE_SUFFIX##_worker(size_t start, size_t end, void *arg) {  \
         bitwise_##OP_NAME##_##TYPE_SUFFIX##_args_t *args =                                         \
             (bitwise_##OP_NAME##_##TYPE_SUFFIX##_args_t *)arg;                                     \
-        for (size_t i = args->start; i < args->end; i++) {                                         \
+        for (size_t i = start; i < end; i++) {                                                     \
             TYPE x = args->lhs[args->lhs_offset + i];                                              \
             TYPE y = args->rhs[args->rhs_offset + i];                                              \
             args->output[i] = FUNC;                                                                \
         }                                                                                          \
-        return NULL;                                                                               \
     }                                                                                              \
                                                                                                    \
     void hodu_cpu_##OP_NAME##_##TYPE_SUFFIX(const void *lhs, const void *rhs, void *output,        \
                                             const size_t *metadata) {                              \
+        HODU_PROFILE_KERNEL(metadata[0] * 3 * sizeof(TYPE));                                       \
         const TYPE *l = (const TYPE *)lhs;                                                         \
         const TYPE *r = (const TYPE *)rhs;                                                         \
         TYPE *out = (TYPE *)output;                                                                \
@@ -47,38 +46,9 @@
         bool rhs_cont = is_contiguous(num_dims, rhs_shape, rhs_strides);                           \
                                                                                                    \
         if (lhs_cont && rhs_cont) {                                                                \
-            const size_t min_work_per_thread = 100000;                                             \
-            size_t num_threads = get_optimal_threads(num_els, min_work_per_thread);                \
-                                                                                                   \
-            if (num_threads > 1) {                                                                 \
-                thread_t threads[num_threads];                                                     \
-                bitwise_##OP_NAME##_##TYPE_SUFFIX##_args_t args[num_threads];                      \
-                                                                                                   \
-                size_t chunk_size = num_els / num_threads;                                         \
-                size_t remaining = num_els % num_threads;                                          \
-                                                                                                   \
-                for (size_t t = 0; t < num_threads; t++) {                                         \
-                    args[t].lhs = l;                                                               \
-                    args[t].rhs = r;                                                               \
-                    args[t].output = out;                                                          \
-                    args[t].lhs_offset = lhs_offset;                                               \
-                    args[t].rhs_offset = rhs_offset;                                               \
-                    args[t].start = t * chunk_size;                                                \
-                    args[t].end = (t == num_threads - 1) ? (t + 1) * chunk_size + remaining        \
-                                                         : (t + 1) * chunk_size;                   \
-                    thread_create(&threads[t], bitwise_##OP_NAME##_##TYPE_SUFFIX##_worker,         \
-                                  &args[t]);                                                       \
-                }                                                                                  \
-                for (size_t t = 0; t < num_threads; t++) {                                         \
-                    thread_join(threads[t]);                                                       \
-                }                                                                                  \
-            } else {                                                                               \
-                for (size_t i = 0; i < num_els; i++) {                                             \
-                    TYPE x = l[lhs_offset + i];                                                    \
-                    TYPE y = r[rhs_offset + i];                                                    \
-                    out[i] = FUNC;                                                                 \
-                }                                                                                  \
-            }                                                                                      \
+            bitwise_##OP_NAME##_##TYPE_SUFFIX##_args_t args = {l, r, out, lhs_offset, rhs_offset}; \
+            parallel_for(0, num_els, task_grain(HODU_CPU_COST_ELEMENTWISE, 1),                     \
+                         bitwise_##OP_NAME##_##TYPE_SUFFIX##_worker, &args);                       \
         } else {                                                                                   \
             for (size_t i = 0; i < num_els; i++) {                                                 \
                 size_t lhs_idx = lhs_offset;                                                       \
@@ -105,23 +75,22 @@
     typedef struct {                                                                               \
         const TYPE *input;                                                                         \
         TYPE *output;                                                                              \
-        size_t start;                                                                              \
-        size_t end;                                                                                \
         size_t offset;                                                                             \
     } unary_bitwise_##OP_NAME##_##TYPE_SUFFIX##_args_t;                                            \
                                                                                                    \
-    static void *unary_bitwise_##OP_NAME##_##TYPE_SUFFIX##_worker(void *arg) {                     \
+    static void unary_bitwise_##OP_NAME##_##TYPE_SUFFIX##_worker(size_t start, size_t end,         \
+                                                                 void *arg) {                      \
         unary_bitwise_##OP_NAME##_##TYPE_SUFFIX##_args_t *args =                                   \
             (unary_bitwise_##OP_NAME##_##TYPE_SUFFIX##_args_t *)arg;                               \
-        for (size_t i = args->start; i < args->end; i++) {                                         \
+        for (size_t i = start; i < end; i++) {                                                     \
             TYPE x = args->input[args->offset + i];                                                \
             args->output[i] = FUNC;                                                                \
         }                                                                                          \
-        return NULL;                                                                               \
     }                                                                                              \
                                                                                                    \
     void hodu_cpu_##OP_NAME##_##TYPE_SUFFIX(const void *input, void *output,                       \
                                             const size_t *metadata) {                              \
+        HODU_PROFILE_KERNEL(metadata[0] * 2 * sizeof(TYPE));                                       \
         const TYPE *in = (const TYPE *)input;                                                      \
         TYPE *out = (TYPE *)output;                                                                \
                                                                                                    \
@@ -134,35 +103,9 @@
         bool is_cont = is_contiguous(num_dims, shape, strides);                                    \
                                                                                                    \
         if (is_cont) {                                                                             \
-            const size_t min_work_per_thread = 100000;                                             \
-            size_t num_threads = get_optimal_threads(num_els, min_work_per_thread);                \
-                                                                                                   \
-            if (num_threads > 1) {                                                                 \
-                thread_t threads[num_threads];                                                     \
-                unary_bitwise_##OP_NAME##_##TYPE_SUFFIX##_args_t args[num_threads];                \
-                                                                                                   \
-                size_t chunk_size = num_els / num_threads;                                         \
-                size_t remaining = num_els % num_threads;                                          \
-                                                                                                   \
-                for (size_t t = 0; t < num_threads; t++) {                                         \
-                    args[t].input = in;                                                            \
-                    args[t].output = out;                                                          \
-                    args[t].offset = offset;                                                       \
-                    args[t].start = t * chunk_size;                                                \
-                    args[t].end = (t == num_threads - 1) ? (t + 1) * chunk_size + remaining        \
-                                                         : (t + 1) * chunk_size;                   \
-                    thread_create(&threads[t], unary_bitwise_##OP_NAME##_##TYPE_SUFFIX##_worker,   \
-                                  &args[t]);                                                       \
-                }                                                                                  \
-                for (size_t t = 0; t < num_threads; t++) {                                         \
-                    thread_join(threads[t]);                                                       \
-                }                                                                                  \
-            } else {                                                                               \
-                for (size_t i = 0; i < num_els; i++) {                                             \
-                    TYPE x = in[offset + i];                                                       \
-                    out[i] = FUNC;                                                                 \
-                }                                                                                  \
-            }                                                                                      \
+            unary_bitwise_##OP_NAME##_##TYPE_SUFFIX##_args_t args = {in, out, offset};             \
+            parallel_for(0, num_els, task_grain(HODU_CPU_COST_ELEMENTWISE, 1),                     \
+                         unary_bitwise_##OP_NAME##_##TYPE_SUFFIX##_worker, &args);                 \
         } else {                                                                                   \
             for (size_t i = 0; i < num_els; i++) {                                                 \
                 size_t src_idx = offset;                                                           \
@@ -186,25 +129,24 @@
     typedef struct {                                                                               \
         const TYPE *input;                                                                         \
         TYPE *output;                                                                              \
-        size_t start;                                                                              \
-        size_t end;                                                                                \
         size_t offset;                                                                             \
         u32_t shift;                                                                               \
     } scalar_shift_##OP_NAME##_##TYPE_SUFFIX##_args_t;                                             \
                                                                                                    \
-    static void *scalar_shift_##OP_NAME##_##TYPE_SUFFIX##_worker(void *arg) {                      \
+    static void scalar_shift_##OP_NAME##_##TYPE_SUFFIX##_worker(size_t start, size_t end,          \
+                                                                void *arg) {                       \
         scalar_shift_##OP_NAME##_##TYPE_SUFFIX##_args_t *args =                                    \
             (scalar_shift_##OP_NAME##_##TYPE_SUFFIX##_args_t *)arg;                                \
         u32_t shift = args->shift;                                                                 \
-        for (size_t i = args->start; i < args->end; i++) {                                         \
+        for (size_t i = start; i < end; i++) {                                                     \
             TYPE x = args->input[args->offset + i];                                                \
             args->output[i] = FUNC;                                                                \
         }                                                                                          \
-        return NULL;                                                                               \
     }                                                                                              \
                                                                                                    \
     void hodu_cpu_##OP_NAME##_##TYPE_SUFFIX(const void *input, void *output,                       \
                                             const size_t *metadata, u32_t shift) {                 \
+        HODU_PROFILE_KERNEL(metadata[0] * 2 * sizeof(TYPE));                                       \
         const TYPE *in = (const TYPE *)input;                                                      \
         TYPE *out = (TYPE *)output;                                                                \
                                                                                                    \
@@ -217,36 +159,9 @@
         bool is_cont = is_contiguous(num_dims, shape, strides);                                    \
                                                                                                    \
         if (is_cont) {                                                                             \
-            const size_t min_work_per_thread = 100000;                                             \
-            size_t num_threads = get_optimal_threads(num_els, min_work_per_thread);                \
-                                                                                                   \
-            if (num_threads > 1) {                                                                 \
-                thread_t threads[num_threads];                                                     \
-                scalar_shift_##OP_NAME##_##TYPE_SUFFIX##_args_t args[num_threads];                 \
-                                                                                                   \
-                size_t chunk_size = num_els / num_threads;                                         \
-                size_t remaining = num_els % num_threads;                                          \
-                                                                                                   \
-                for (size_t t = 0; t < num_threads; t++) {                                         \
-                    args[t].input = in;                                                            \
-                    args[t].output = out;                                                          \
-                    args[t].offset = offset;                                                       \
-                    args[t].shift = shift;                                                         \
-                    args[t].start = t * chunk_size;                                                \
-                    args[t].end = (t == num_threads - 1) ? (t + 1) * chunk_size + remaining        \
-                                                         : (t + 1) * chunk_size;                   \
-                    thread_create(&threads[t], scalar_shift_##OP_NAME##_##TYPE_SUFFIX##_worker,    \
-                                  &args[t]);                                                       \
-                }                                                                                  \
-                for (size_t t = 0; t < num_threads; t++) {                                         \
-                    thread_join(threads[t]);                                                       \
-                }                                                                                  \
-            } else {                                                                               \
-                for (size_t i = 0; i < num_els; i++) {                                             \
-                    TYPE x = in[offset + i];                                                       \
-                    out[i] = FUNC;                                                                 \
-                }                                                                                  \
-            }                                                                                      \
+            scalar_shift_##OP_NAME##_##TYPE_SUFFIX##_args_t args = {in, out, offset, shift};       \
+            parallel_for(0, num_els, task_grain(HODU_CPU_COST_ELEMENTWISE, 1),                     \
+                         scalar_shift_##OP_NAME##_##TYPE_SUFFIX##_worker, &args);                  \
         } else {                                                                                   \
             for (size_t i = 0; i < num_els; i++) {                                                 \
                 size_t src_idx = offset;                                                           \
@@ -1,6 +1,11 @@
 #include "ops_cast.h"
+#include "profile.h"
+#include "simd_utils.h"
+#include "strided_copy.h"
 #include "thread_utils.h"
 #include "types.h"
+#include "workspace.h"
+#include <string.h>
 
 // ============================================================================
 // CAST OPERATION IMPLEMENTATION
@@ -8,6 +13,10 @@
 //
 // Type casting operations convert tensor elements from one type to another.
 // All operations support both contiguous and strided tensor access patterns.
+//
+// Between types of the same size the output may equal the input (contiguous, at offset 0):
+// every row reads its inputs before writing the same elements. Any other overlap between
+// the input view and the output is read from a contiguous copy.
 
 // Helper macros for type conversion
 #define TO_FLOAT(TYPE, val)                                                                        \
@@ -28,80 +37,206 @@
         i64_t: (float)(val),                                                                       \
         default: (float)(val))
 
+/// Converts n elements: dst[i] = CONVERT(src[i * stride])
+typedef void (*cast_row_fn_t)(const void *src, size_t stride, void *dst, size_t n);
+
+typedef struct {
+    const char *input; // at the layout offset
+    char *output;
+    size_t num_dims;
+    const size_t *dims;
+    const size_t *strides;
+    size_t in_size, out_size;
+    cast_row_fn_t row;
+} cast_args_t;
+
+/// Output elements [start, end): seek once, then convert whole innermost rows
+static void cast_worker(size_t start, size_t end, void *arg) {
+    const cast_args_t *args = (const cast_args_t *)arg;
+    strided_iter_t it;
+    strided_iter_init(&it, args->num_dims, args->dims, args->strides, start);
+
+    for (size_t i = start; i < end;) {
+        const size_t n = MINIMUM(strided_iter_row(&it), end - i);
+        args->row(args->input + it.offset * args->in_size, it.inner_stride,
+                  args->output + i * args->out_size, n);
+        i += n;
+        strided_iter_advance(&it, n);
+    }
+}
+
+/// Runs ROW over the whole layout on the thread pool; contiguous inputs become a single row
+static void cast_run(const void *input, void *output, const size_t *metadata, size_t in_size,
+                     size_t out_size, cast_row_fn_t row) {
+    const size_t num_els = metadata[0];
+    const size_t num_dims = metadata[1];
+    const size_t *dims = metadata + 2;
+    const size_t *strides = metadata + 2 + num_dims;
+    const size_t offset = (num_dims > 0) ? metadata[2 + 2 * num_dims] : 0;
+    if (num_els == 0) {
+        return;
+    }
+
+    cast_args_t args = {(const char *)input + offset * in_size,
+                        (char *)output,
+                        num_dims,
+                        dims,
+                        strides,
+                        in_size,
+                        out_size,
+                        row};
+
+    /* In place only for same-size casts of a contiguous input; other overlaps read a copy */
+    const size_t unit_stride = 1;
+    void *staged = hodu_cpu_stage_overlapping_view(args.input, in_size, num_dims, dims, strides,
+                                                   output, out_size);
+    if (staged) {
+        args.input = (const char *)staged;
+        args.num_dims = 1;
+        args.dims = &num_els;
+        args.strides = &unit_stride;
+    }
+    // Bandwidth bound: an element costs about a copy of its average size
+    const size_t grain = task_grain(HODU_CPU_COST_COPY, (in_size + out_size) / 2.0);
+    parallel_for(0, num_els, grain, cast_worker, &args);
+    if (staged) {
+        workspace_release(staged);
+    }
+}
+
+/**
+ * @brief Saturating float to integer conversion
+ *
+ * NaN gives 0 and out-of-range values clamp to the integer range (the semantics of Rust
+ * `as`), where a plain C cast would be undefined. Values in range truncate toward zero.
+ */
+#define IMPL_CAST_SATURATE(FLOAT_TYPE, FLOAT_SUFFIX, INT_TYPE, INT_SUFFIX, MIN, MAX)               \
+    static inline INT_TYPE cast_sat_##FLOAT_SUFFIX##_##INT_SUFFIX(FLOAT_TYPE x) {                  \
+        if (x != x) {                                                                              \
+            return 0;                                                                              \
+        }                                                                                          \
+        if (x <= (FLOAT_TYPE)(MIN)) {                                                              \
+            return (MIN);                                                                          \
+        }                                                                                          \
+        /* (FLOAT_TYPE)MAX may round up to 2^bits, which is out of range itself */                 \
+        if (x >= (FLOAT_TYPE)(MAX)) {                                                              \
+            return (MAX);                                                                          \
+        }                                                                                          \
+        return (INT_TYPE)x;                                                                        \
+    }
+
+IMPL_CAST_SATURATE(f32_t, f32, u8_t, u8, 0, UINT8_MAX)
+IMPL_CAST_SATURATE(f32_t, f32, u16_t, u16, 0, UINT16_MAX)
+IMPL_CAST_SATURATE(f32_t, f32, u32_t, u32, 0, UINT32_MAX)
+IMPL_CAST_SATURATE(f32_t, f32, u64_t, u64, 0, UINT64_MAX)
+IMPL_CAST_SATURATE(f32_t, f32, i8_t, i8, INT8_MIN, INT8_MAX)
+IMPL_CAST_SATURATE(f32_t, f32, i16_t, i16, INT16_MIN, INT16_MAX)
+IMPL_CAST_SATURATE(f32_t, f32, i32_t, i32, INT32_MIN, INT32_MAX)
+IMPL_CAST_SATURATE(f32_t, f32, i64_t, i64, INT64_MIN, INT64_MAX)
+IMPL_CAST_SATURATE(f64_t, f64, u8_t, u8, 0, UINT8_MAX)
+IMPL_CAST_SATURATE(f64_t, f64, u16_t, u16, 0, UINT16_MAX)
+IMPL_CAST_SATURATE(f64_t, f64, u32_t, u32, 0, UINT32_MAX)
+IMPL_CAST_SATURATE(f64_t, f64, u64_t, u64, 0, UINT64_MAX)
+IMPL_CAST_SATURATE(f64_t, f64, i8_t, i8, INT8_MIN, INT8_MAX)
+IMPL_CAST_SATURATE(f64_t, f64, i16_t, i16, INT16_MIN, INT16_MAX)
+IMPL_CAST_SATURATE(f64_t, f64, i32_t, i32, INT32_MIN, INT32_MAX)
+IMPL_CAST_SATURATE(f64_t, f64, i64_t, i64, INT64_MIN, INT64_MAX)
+
 /**
  * @brief Macro to implement cast operation from one type to another
+ *
+ * The row function has a unit-stride loop the compiler vectorizes and a strided loop;
+ * cast_run feeds it whole innermost rows from the thread pool.
  */
 #define IMPL_CAST_OP(FROM_TYPE, FROM_SUFFIX, TO_TYPE, TO_SUFFIX, CONVERT)                          \
-    typedef struct {                                                                               \
-        const FROM_TYPE *input;                                                                    \
-        TO_TYPE *output;                                                                           \
-        size_t start;                                                                              \
-        size_t end;                                                                                \
-        size_t offset;                                                                             \
-    } cast_##FROM_SUFFIX##_to_##TO_SUFFIX##_args_t;                                                \
-                                                                                                   \
-    static void *cast_##FROM_SUFFIX##_to_##TO_SUFFIX##_worker(void *arg) {                         \
-        cast_##FROM_SUFFIX##_to_##TO_SUFFIX##_args_t *args =                                       \
-            (cast_##FROM_SUFFIX##_to_##TO_SUFFIX##_args_t *)arg;                                   \
-        for (size_t i = args->start; i < args->end; i++) {                                         \
-            FROM_TYPE x = args->input[args->offset + i];                                           \
-            args->output[i] = CONVERT;                                                             \
+    static void cast_##FROM_SUFFIX##_to_##TO_SUFFIX##_row(const void *src_ptr, size_t stride,      \
+                                                          void *dst_ptr, size_t n) {               \
+        const FROM_TYPE *src = (const FROM_TYPE *)src_ptr;                                         \
+        TO_TYPE *dst = (TO_TYPE *)dst_ptr;                                                         \
+        if (stride == 1) {                                                                         \
+            for (size_t i = 0; i < n; i++) {                                                       \
+                FROM_TYPE x = src[i];                                                              \
+                dst[i] = CONVERT;                                                                  \
+            }                                                                                      \
+        } else {                                                                                   \
+            for (size_t i = 0; i < n; i++) {                                                       \
+                FROM_TYPE x = src[i * stride];                                                     \
+                dst[i] = CONVERT;                                                                  \
+            }                                                                                      \
         }                                                                                          \
-        return NULL;                                                                               \
     }                                                                                              \
                                                                                                    \
     void hodu_cpu_cast_##FROM_SUFFIX##_to_##TO_SUFFIX(const void *input, void *output,             \
                                                       const size_t *metadata) {                    \
-        const size_t num_els = metadata[0];                                                        \
-        const size_t num_dims = metadata[1];                                                       \
-        const FROM_TYPE *in = (const FROM_TYPE *)input;                                            \
-        TO_TYPE *out = (TO_TYPE *)output;                                                          \
-                                                                                                   \
-        const size_t *dims = metadata + 2;                                                         \
-        const size_t *strides = metadata + 2 + num_dims;                                           \
-        const size_t offset = (num_dims > 0) ? metadata[2 + 2 * num_dims] : 0;                     \
-                                                                                                   \
-        bool contiguous = is_contiguous(num_dims, dims, strides);                                  \
-                                                                                                   \
-        if (contiguous) {                                                                          \
-            const size_t min_work_per_thread = 100000;                                             \
-            size_t num_threads = get_optimal_threads(num_els, min_work_per_thread);                \
-                                                                                                   \
-            if (num_threads > 1) {                                                                 \
-                thread_t threads[num_threads];                                                     \
-                cast_##FROM_SUFFIX##_to_##TO_SUFFIX##_args_t args[num_threads];                    \
-                                                                                                   \
-                size_t chunk_size = num_els / num_threads;                                         \
-                size_t remaining = num_els % num_threads;                                          \
-                                                                                                   \
-                for (size_t t = 0; t < num_threads; t++) {                                         \
-                    args[t].input = in;                                                            \
-                    args[t].output = out;                                                          \
-                    args[t].offset = offset;                                                       \
-                    args[t].start = t * chunk_size + (t < remaining ? t : remaining);              \
-                    args[t].end = args[t].start + chunk_size + (t < remaining ? 1 : 0);            \
-                    thread_create(&threads[t], cast_##FROM_SUFFIX##_to_##TO_SUFFIX##_worker,       \
-                                  &args[t]);                                                       \
-                }                                                                                  \
-                                                                                                   \
-                for (size_t t = 0; t < num_threads; t++) {                                         \
-                    thread_join(threads[t]);                                                       \
-                }                                                                                  \
-            } else {                                                                               \
-                for (size_t i = 0; i < num_els; i++) {                                             \
-                    FROM_TYPE x = in[offset + i];                                                  \
-                    out[i] = CONVERT;                                                              \
-                }                                                                                  \
-            }                                                                                      \
+        HODU_PROFILE_KERNEL(metadata[0] * (sizeof(FROM_TYPE) + sizeof(TO_TYPE)));                  \
+        cast_run(input, output, metadata, sizeof(FROM_TYPE), sizeof(TO_TYPE),                      \
+                 cast_##FROM_SUFFIX##_to_##TO_SUFFIX##_row);                                       \
+    }
+
+// Elements converted through an f32 buffer at a time by IMPL_CAST_BLOCK_FN
+#define CAST_BLOCK 256
+
+/**
+ * @brief Macro to implement a contiguous conversion between two non-f32 float types
+ *
+ * Converts through an f32 block: simd_widen_<from> fills the buffer and simd_narrow_<to>
+ * writes it out. Conversions from or to f32 call the simd_narrow/simd_widen helpers directly.
+ */
+#define IMPL_CAST_BLOCK_FN(FROM_TYPE, FROM_SUFFIX, TO_TYPE, TO_SUFFIX)                             \
+    static void cast_block_##FROM_SUFFIX##_to_##TO_SUFFIX(const FROM_TYPE *src, TO_TYPE *dst,      \
+                                                          size_t n) {                              \
+        float buf[CAST_BLOCK];                                                                     \
+        for (size_t b = 0; b < n; b += CAST_BLOCK) {                                               \
+            const size_t bn = MINIMUM((size_t)CAST_BLOCK, n - b);                                  \
+            simd_widen_##FROM_SUFFIX(src + b, buf, bn);                                            \
+            simd_narrow_##TO_SUFFIX(buf, dst + b, bn);                                             \
+        }                                                                                          \
+    }
+
+/**
+ * @brief Macro to implement a cast between float types with a vectorized contiguous path
+ *
+ * Same as IMPL_CAST_OP, but unit-stride rows go through CONVERT_ROW(src, dst, n): a
+ * simd_widen_<type>/simd_narrow_<type> helper or a cast_block_<from>_to_<to> function, so
+ * the bf16/f16/f8 conversions run vectorized. Strided rows use CONVERT per element; both
+ * give identical results.
+ */
+#define IMPL_CAST_OP_VEC(FROM_TYPE, FROM_SUFFIX, TO_TYPE, TO_SUFFIX, CONVERT, CONVERT_ROW)         \
+    static void cast_##FROM_SUFFIX##_to_##TO_SUFFIX##_row(const void *src_ptr, size_t stride,      \
+                                                          void *dst_ptr, size_t n) {               \
+        const FROM_TYPE *src = (const FROM_TYPE *)src_ptr;                                         \
+        TO_TYPE *dst = (TO_TYPE *)dst_ptr;                                                         \
+        if (stride == 1) {                                                                         \
+            CONVERT_ROW(src, dst, n);                                                              \
         } else {                                                                                   \
-            for (size_t i = 0; i < num_els; i++) {                                                 \
-                size_t strided_i = offset + get_strided_index(i, num_dims, dims, strides);         \
-                FROM_TYPE x = in[strided_i];                                                       \
-                out[i] = CONVERT;                                                                  \
+            for (size_t i = 0; i < n; i++) {                                                       \
+                FROM_TYPE x = src[i * stride];                                                     \
+                dst[i] = CONVERT;                                                                  \
             }                                                                                      \
         }                                                                                          \
+    }                                                                                              \
+                                                                                                   \
+    void hodu_cpu_cast_##FROM_SUFFIX##_to_##TO_SUFFIX(const void *input, void *output,             \
+                                                      const size_t *metadata) {                    \
+        HODU_PROFILE_KERNEL(metadata[0] * (sizeof(FROM_TYPE) + sizeof(TO_TYPE)));                  \
+        cast_run(input, output, metadata, sizeof(FROM_TYPE), sizeof(TO_TYPE),                      \
+                 cast_##FROM_SUFFIX##_to_##TO_SUFFIX##_row);                                       \
     }
 
+// Contiguous conversions between the non-f32 float types
+IMPL_CAST_BLOCK_FN(f8e4m3_t, f8e4m3, f8e5m2_t, f8e5m2)
+IMPL_CAST_BLOCK_FN(f8e4m3_t, f8e4m3, bf16_t, bf16)
+IMPL_CAST_BLOCK_FN(f8e4m3_t, f8e4m3, f16_t, f16)
+IMPL_CAST_BLOCK_FN(f8e5m2_t, f8e5m2, f8e4m3_t, f8e4m3)
+IMPL_CAST_BLOCK_FN(f8e5m2_t, f8e5m2, bf16_t, bf16)
+IMPL_CAST_BLOCK_FN(f8e5m2_t, f8e5m2, f16_t, f16)
+IMPL_CAST_BLOCK_FN(bf16_t, bf16, f8e4m3_t, f8e4m3)
+IMPL_CAST_BLOCK_FN(bf16_t, bf16, f8e5m2_t, f8e5m2)
+IMPL_CAST_BLOCK_FN(bf16_t, bf16, f16_t, f16)
+IMPL_CAST_BLOCK_FN(f16_t, f16, f8e4m3_t, f8e4m3)
+IMPL_CAST_BLOCK_FN(f16_t, f16, f8e5m2_t, f8e5m2)
+IMPL_CAST_BLOCK_FN(f16_t, f16, bf16_t, bf16)
+
 // ============================================================================
 // BOOL conversions
 // ============================================================================
@@ -126,76 +261,86 @@ IMPL_CAST_OP(uint8_t, bool, i64_t, i64, (i64_t)(x != 0))
 // ============================================================================
 IMPL_CAST_OP(f8e4m3_t, f8e4m3, uint8_t, bool, (f8e4m3_to_float(x) != 0.0f))
 IMPL_CAST_OP(f8e4m3_t, f8e4m3, f8e4m3_t, f8e4m3, x)
-IMPL_CAST_OP(f8e4m3_t, f8e4m3, f8e5m2_t, f8e5m2, float_to_f8e5m2(f8e4m3_to_float(x)))
-IMPL_CAST_OP(f8e4m3_t, f8e4m3, bf16_t, bf16, float_to_bf16(f8e4m3_to_float(x)))
-IMPL_CAST_OP(f8e4m3_t, f8e4m3, f16_t, f16, float_to_f16(f8e4m3_to_float(x)))
-IMPL_CAST_OP(f8e4m3_t, f8e4m3, f32_t, f32, f8e4m3_to_float(x))
+IMPL_CAST_OP_VEC(f8e4m3_t, f8e4m3, f8e5m2_t, f8e5m2, float_to_f8e5m2(f8e4m3_to_float(x)),
+                 cast_block_f8e4m3_to_f8e5m2)
+IMPL_CAST_OP_VEC(f8e4m3_t, f8e4m3, bf16_t, bf16, float_to_bf16(f8e4m3_to_float(x)),
+                 cast_block_f8e4m3_to_bf16)
+IMPL_CAST_OP_VEC(f8e4m3_t, f8e4m3, f16_t, f16, float_to_f16(f8e4m3_to_float(x)),
+                 cast_block_f8e4m3_to_f16)
+IMPL_CAST_OP_VEC(f8e4m3_t, f8e4m3, f32_t, f32, f8e4m3_to_float(x), simd_widen_f8e4m3)
 IMPL_CAST_OP(f8e4m3_t, f8e4m3, f64_t, f64, (f64_t)f8e4m3_to_float(x))
-IMPL_CAST_OP(f8e4m3_t, f8e4m3, u8_t, u8, (u8_t)f8e4m3_to_float(x))
-IMPL_CAST_OP(f8e4m3_t, f8e4m3, u16_t, u16, (u16_t)f8e4m3_to_float(x))
-IMPL_CAST_OP(f8e4m3_t, f8e4m3, u32_t, u32, (u32_t)f8e4m3_to_float(x))
-IMPL_CAST_OP(f8e4m3_t, f8e4m3, u64_t, u64, (u64_t)f8e4m3_to_float(x))
-IMPL_CAST_OP(f8e4m3_t, f8e4m3, i8_t, i8, (i8_t)f8e4m3_to_float(x))
-IMPL_CAST_OP(f8e4m3_t, f8e4m3, i16_t, i16, (i16_t)f8e4m3_to_float(x))
-IMPL_CAST_OP(f8e4m3_t, f8e4m3, i32_t, i32, (i32_t)f8e4m3_to_float(x))
-IMPL_CAST_OP(f8e4m3_t, f8e4m3, i64_t, i64, (i64_t)f8e4m3_to_float(x))
+IMPL_CAST_OP(f8e4m3_t, f8e4m3, u8_t, u8, cast_sat_f32_u8(f8e4m3_to_float(x)))
+IMPL_CAST_OP(f8e4m3_t, f8e4m3, u16_t, u16, cast_sat_f32_u16(f8e4m3_to_float(x)))
+IMPL_CAST_OP(f8e4m3_t, f8e4m3, u32_t, u32, cast_sat_f32_u32(f8e4m3_to_float(x)))
+IMPL_CAST_OP(f8e4m3_t, f8e4m3, u64_t, u64, cast_sat_f32_u64(f8e4m3_to_float(x)))
+IMPL_CAST_OP(f8e4m3_t, f8e4m3, i8_t, i8, cast_sat_f32_i8(f8e4m3_to_float(x)))
+IMPL_CAST_OP(f8e4m3_t, f8e4m3, i16_t, i16, cast_sat_f32_i16(f8e4m3_to_float(x)))
+IMPL_CAST_OP(f8e4m3_t, f8e4m3, i32_t, i32, cast_sat_f32_i32(f8e4m3_to_float(x)))
+IMPL_CAST_OP(f8e4m3_t, f8e4m3, i64_t, i64, cast_sat_f32_i64(f8e4m3_to_float(x)))
 
 // ============================================================================
 // F8E5M2 conversions
 // ============================================================================
 IMPL_CAST_OP(f8e5m2_t, f8e5m2, uint8_t, bool, (f8e5m2_to_float(x) != 0.0f))
-IMPL_CAST_OP(f8e5m2_t, f8e5m2, f8e4m3_t, f8e4m3, float_to_f8e4m3(f8e5m2_to_float(x)))
+IMPL_CAST_OP_VEC(f8e5m2_t, f8e5m2, f8e4m3_t, f8e4m3, float_to_f8e4m3(f8e5m2_to_float(x)),
+                 cast_block_f8e5m2_to_f8e4m3)
 IMPL_CAST_OP(f8e5m2_t, f8e5m2, f8e5m2_t, f8e5m2, x)
-IMPL_CAST_OP(f8e5m2_t, f8e5m2, bf16_t, bf16, float_to_bf16(f8e5m2_to_float(x)))
-IMPL_CAST_OP(f8e5m2_t, f8e5m2, f16_t, f16, float_to_f16(f8e5m2_to_float(x)))
-IMPL_CAST_OP(f8e5m2_t, f8e5m2, f32_t, f32, f8e5m2_to_float(x))
+IMPL_CAST_OP_VEC(f8e5m2_t, f8e5m2, bf16_t, bf16, float_to_bf16(f8e5m2_to_float(x)),
+                 cast_block_f8e5m2_to_bf16)
+IMPL_CAST_OP_VEC(f8e5m2_t, f8e5m2, f16_t, f16, float_to_f16(f8e5m2_to_float(x)),
+                 cast_block_f8e5m2_to_f16)
+IMPL_CAST_OP_VEC(f8e5m2_t, f8e5m2, f32_t, f32, f8e5m2_to_float(x), simd_widen_f8e5m2)
 IMPL_CAST_OP(f8e5m2_t, f8e5m2, f64_t, f64, (f64_t)f8e5m2_to_float(x))
-IMPL_CAST_OP(f8e5m2_t, f8e5m2, u8_t, u8, (u8_t)f8e5m2_to_float(x))
-IMPL_CAST_OP(f8e5m2_t, f8e5m2, u16_t, u16, (u16_t)f8e5m2_to_float(x))
-IMPL_CAST_OP(f8e5m2_t, f8e5m2, u32_t, u32, (u32_t)f8e5m2_to_float(x))
-IMPL_CAST_OP(f8e5m2_t, f8e5m2, u64_t, u64, (u64_t)f8e5m2_to_float(x))
-IMPL_CAST_OP(f8e5m2_t, f8e5m2, i8_t, i8, (i8_t)f8e5m2_to_float(x))
-IMPL_CAST_OP(f8e5m2_t, f8e5m2, i16_t, i16, (i16_t)f8e5m2_to_float(x))
-IMPL_CAST_OP(f8e5m2_t, f8e5m2, i32_t, i32, (i32_t)f8e5m2_to_float(x))
-IMPL_CAST_OP(f8e5m2_t, f8e5m2, i64_t, i64, (i64_t)f8e5m2_to_float(x))
+IMPL_CAST_OP(f8e5m2_t, f8e5m2, u8_t, u8, cast_sat_f32_u8(f8e5m2_to_float(x)))
+IMPL_CAST_OP(f8e5m2_t, f8e5m2, u16_t, u16, cast_sat_f32_u16(f8e5m2_to_float(x)))
+IMPL_CAST_OP(f8e5m2_t, f8e5m2, u32_t, u32, cast_sat_f32_u32(f8e5m2_to_float(x)))
+IMPL_CAST_OP(f8e5m2_t, f8e5m2, u64_t, u64, cast_sat_f32_u64(f8e5m2_to_float(x)))
+IMPL_CAST_OP(f8e5m2_t, f8e5m2, i8_t, i8, cast_sat_f32_i8(f8e5m2_to_float(x)))
+IMPL_CAST_OP(f8e5m2_t, f8e5m2, i16_t, i16, cast_sat_f32_i16(f8e5m2_to_float(x)))
+IMPL_CAST_OP(f8e5m2_t, f8e5m2, i32_t, i32, cast_sat_f32_i32(f8e5m2_to_float(x)))
+IMPL_CAST_OP(f8e5m2_t, f8e5m2, i64_t, i64, cast_sat_f32_i64(f8e5m2_to_float(x)))
 
 // ============================================================================
 // BF16 conversions
 // ============================================================================
 IMPL_CAST_OP(bf16_t, bf16, uint8_t, bool, (bf16_to_float(x) != 0.0f))
-IMPL_CAST_OP(bf16_t, bf16, f8e4m3_t, f8e4m3, float_to_f8e4m3(bf16_to_float(x)))
-IMPL_CAST_OP(bf16_t, bf16, f8e5m2_t, f8e5m2, float_to_f8e5m2(bf16_to_float(x)))
+IMPL_CAST_OP_VEC(bf16_t, bf16, f8e4m3_t, f8e4m3, float_to_f8e4m3(bf16_to_float(x)),
+                 cast_block_bf16_to_f8e4m3)
+IMPL_CAST_OP_VEC(bf16_t, bf16, f8e5m2_t, f8e5m2, float_to_f8e5m2(bf16_to_float(x)),
+                 cast_block_bf16_to_f8e5m2)
 IMPL_CAST_OP(bf16_t, bf16, bf16_t, bf16, x)
-IMPL_CAST_OP(bf16_t, bf16, f16_t, f16, float_to_f16(bf16_to_float(x)))
-IMPL_CAST_OP(bf16_t, bf16, f32_t, f32, bf16_to_float(x))
+IMPL_CAST_OP_VEC(bf16_t, bf16, f16_t, f16, float_to_f16(bf16_to_float(x)), cast_block_bf16_to_f16)
+IMPL_CAST_OP_VEC(bf16_t, bf16, f32_t, f32, bf16_to_float(x), simd_widen_bf16)
 IMPL_CAST_OP(bf16_t, bf16, f64_t, f64, (f64_t)bf16_to_float(x))
-IMPL_CAST_OP(bf16_t, bf16, u8_t, u8, (u8_t)bf16_to_float(x))
-IMPL_CAST_OP(bf16_t, bf16, u16_t, u16, (u16_t)bf16_to_float(x))
-IMPL_CAST_OP(bf16_t, bf16, u32_t, u32, (u32_t)bf16_to_float(x))
-IMPL_CAST_OP(bf16_t, bf16, u64_t, u64, (u64_t)bf16_to_float(x))
-IMPL_CAST_OP(bf16_t, bf16, i8_t, i8, (i8_t)bf16_to_float(x))
-IMPL_CAST_OP(bf16_t, bf16, i16_t, i16, (i16_t)bf16_to_float(x))
-IMPL_CAST_OP(bf16_t, bf16, i32_t, i32, (i32_t)bf16_to_float(x))
-IMPL_CAST_OP(bf16_t, bf16, i64_t, i64, (i64_t)bf16_to_float(x))
+IMPL_CAST_OP(bf16_t, bf16, u8_t, u8, cast_sat_f32_u8(bf16_to_float(x)))
+IMPL_CAST_OP(bf16_t, bf16, u16_t, u16, cast_sat_f32_u16(bf16_to_float(x)))
+IMPL_CAST_OP(bf16_t, bf16, u32_t, u32, cast_sat_f32_u32(bf16_to_float(x)))
+IMPL_CAST_OP(bf16_t, bf16, u64_t, u64, cast_sat_f32_u64(bf16_to_float(x)))
+IMPL_CAST_OP(bf16_t, bf16, i8_t, i8, cast_sat_f32_i8(bf16_to_float(x)))
+IMPL_CAST_OP(bf16_t, bf16, i16_t, i16, cast_sat_f32_i16(bf16_to_float(x)))
+IMPL_CAST_OP(bf16_t, bf16, i32_t, i32, cast_sat_f32_i32(bf16_to_float(x)))
+IMPL_CAST_OP(bf16_t, bf16, i64_t, i64, cast_sat_f32_i64(bf16_to_float(x)))
 
 // ============================================================================
 // F16 conversions
 // ============================================================================
 IMPL_CAST_OP(f16_t, f16, uint8_t, bool, (f16_to_float(x) != 0.0f))
-IMPL_CAST_OP(f16_t, f16, f8e4m3_t, f8e4m3, float_to_f8e4m3(f16_to_float(x)))
-IMPL_CAST_OP(f16_t, f16, f8e5m2_t, f8e5m2, float_to_f8e5m2(f16_to_float(x)))
-IMPL_CAST_OP(f16_t, f16, bf16_t, bf16, float_to_bf16(f16_to_float(x)))
+IMPL_CAST_OP_VEC(f16_t, f16, f8e4m3_t, f8e4m3, float_to_f8e4m3(f16_to_float(x)),
+                 cast_block_f16_to_f8e4m3)
+IMPL_CAST_OP_VEC(f16_t, f16, f8e5m2_t, f8e5m2, float_to_f8e5m2(f16_to_float(x)),
+                 cast_block_f16_to_f8e5m2)
+IMPL_CAST_OP_VEC(f16_t, f16, bf16_t, bf16, float_to_bf16(f16_to_float(x)), cast_block_f16_to_bf16)
 IMPL_CAST_OP(f16_t, f16, f16_t, f16, x)
-IMPL_CAST_OP(f16_t, f16, f32_t, f32, f16_to_float(x))
+IMPL_CAST_OP_VEC(f16_t, f16, f32_t, f32, f16_to_float(x), simd_widen_f16)
 IMPL_CAST_OP(f16_t, f16, f64_t, f64, (f64_t)f16_to_float(x))
-IMPL_CAST_OP(f16_t, f16, u8_t, u8, (u8_t)f16_to_float(x))
-IMPL_CAST_OP(f16_t, f16, u16_t, u16, (u16_t)f16_to_float(x))
-IMPL_CAST_OP(f16_t, f16, u32_t, u32, (u32_t)f16_to_float(x))
-IMPL_CAST_OP(f16_t, f16, u64_t, u64, (u64_t)f16_to_float(x))
-IMPL_CAST_OP(f16_t, f16, i8_t, i8, (i8_t)f16_to_float(x))
-IMPL_CAST_OP(f16_t, f16, i16_t, i16, (i16_t)f16_to_float(x))
-IMPL_CAST_OP(f16_t, f16, i32_t, i32, (i32_t)f16_to_float(x))
-IMPL_CAST_OP(f16_t, f16, i64_t, i64, (i64_t)f16_to_float(x))
+IMPL_CAST_OP(f16_t, f16, u8_t, u8, cast_sat_f32_u8(f16_to_float(x)))
+IMPL_CAST_OP(f16_t, f16, u16_t, u16, cast_sat_f32_u16(f16_to_float(x)))
+IMPL_CAST_OP(f16_t, f16, u32_t, u32, cast_sat_f32_u32(f16_to_float(x)))
+IMPL_CAST_OP(f16_t, f16, u64_t, u64, cast_sat_f32_u64(f16_to_float(x)))
+IMPL_CAST_OP(f16_t, f16, i8_t, i8, cast_sat_f32_i8(f16_to_float(x)))
+IMPL_CAST_OP(f16_t, f16, i16_t, i16, cast_sat_f32_i16(f16_to_float(x)))
+IMPL_CAST_OP(f16_t, f16, i32_t, i32, cast_sat_f32_i32(f16_to_float(x)))
+IMPL_CAST_OP(f16_t, f16, i64_t, i64, cast_sat_f32_i64(f16_to_float(x)))
 
 // ============================================================================
 // F32 conversions
@@ -203,18 +348,18 @@ IMPL_CAST_OP(f16_t, f16, i64_t, i64, (i64_t)f16_to_float(x))
 IMPL_CAST_OP(f32_t, f32, uint8_t, bool, (x != 0.0f))
 IMPL_CAST_OP(f32_t, f32, f8e4m3_t, f8e4m3, float_to_f8e4m3(x))
 IMPL_CAST_OP(f32_t, f32, f8e5m2_t, f8e5m2, float_to_f8e5m2(x))
-IMPL_CAST_OP(f32_t, f32, bf16_t, bf16, float_to_bf16(x))
-IMPL_CAST_OP(f32_t, f32, f16_t, f16, float_to_f16(x))
+IMPL_CAST_OP_VEC(f32_t, f32, bf16_t, bf16, float_to_bf16(x), simd_narrow_bf16)
+IMPL_CAST_OP_VEC(f32_t, f32, f16_t, f16, float_to_f16(x), simd_narrow_f16)
 IMPL_CAST_OP(f32_t, f32, f32_t, f32, x)
 IMPL_CAST_OP(f32_t, f32, f64_t, f64, (f64_t)x)
-IMPL_CAST_OP(f32_t, f32, u8_t, u8, (u8_t)x)
-IMPL_CAST_OP(f32_t, f32, u16_t, u16, (u16_t)x)
-IMPL_CAST_OP(f32_t, f32, u32_t, u32, (u32_t)x)
-IMPL_CAST_OP(f32_t, f32, u64_t, u64, (u64_t)x)
-IMPL_CAST_OP(f32_t, f32, i8_t, i8, (i8_t)x)
-IMPL_CAST_OP(f32_t, f32, i16_t, i16, (i16_t)x)
-IMPL_CAST_OP(f32_t, f32, i32_t, i32, (i32_t)x)
-IMPL_CAST_OP(f32_t, f32, i64_t, i64, (i64_t)x)
+IMPL_CAST_OP(f32_t, f32, u8_t, u8, cast_sat_f32_u8(x))
+IMPL_CAST_OP(f32_t, f32, u16_t, u16, cast_sat_f32_u16(x))
+IMPL_CAST_OP(f32_t, f32, u32_t, u32, cast_sat_f32_u32(x))
+IMPL_CAST_OP(f32_t, f32, u64_t, u64, cast_sat_f32_u64(x))
+IMPL_CAST_OP(f32_t, f32, i8_t, i8, cast_sat_f32_i8(x))
+IMPL_CAST_OP(f32_t, f32, i16_t, i16, cast_sat_f32_i16(x))
+IMPL_CAST_OP(f32_t, f32, i32_t, i32, cast_sat_f32_i32(x))
+IMPL_CAST_OP(f32_t, f32, i64_t, i64, cast_sat_f32_i64(x))
 
 // ============================================================================
 // F64 conversions
@@ -226,14 +371,14 @@ IMPL_CAST_OP(f64_t, f64, bf16_t, bf16, float_to_bf16((float)x))
 IMPL_CAST_OP(f64_t, f64, f16_t, f16, float_to_f16((float)x))
 IMPL_CAST_OP(f64_t, f64, f32_t, f32, (f32_t)x)
 IMPL_CAST_OP(f64_t, f64, f64_t, f64, x)
-IMPL_CAST_OP(f64_t, f64, u8_t, u8, (u8_t)x)
-IMPL_CAST_OP(f64_t, f64, u16_t, u16, (u16_t)x)
-IMPL_CAST_OP(f64_t, f64, u32_t, u32, (u32_t)x)
-IMPL_CAST_OP(f64_t, f64, u64_t, u64, (u64_t)x)
-IMPL_CAST_OP(f64_t, f64, i8_t, i8, (i8_t)x)
-IMPL_CAST_OP(f64_t, f64, i16_t, i16, (i16_t)x)
-IMPL_CAST_OP(f64_t, f64, i32_t, i32, (i32_t)x)
-IMPL_CAST_OP(f64_t, f64, i64_t, i64, (i64_t)x)
+IMPL_CAST_OP(f64_t, f64, u8_t, u8, cast_sat_f64_u8(x))
+IMPL_CAST_OP(f64_t, f64, u16_t, u16, cast_sat_f64_u16(x))
+IMPL_CAST_OP(f64_t, f64, u32_t, u32, cast_sat_f64_u32(x))
+IMPL_CAST_OP(f64_t, f64, u64_t, u64, cast_sat_f64_u64(x))
+IMPL_CAST_OP(f64_t, f64, i8_t, i8, cast_sat_f64_i8(x))
+IMPL_CAST_OP(f64_t, f64, i16_t, i16, cast_sat_f64_i16(x))
+IMPL_CAST_OP(f64_t, f64, i32_t, i32, cast_sat_f64_i32(x))
+IMPL_CAST_OP(f64_t, f64, i64_t, i64, cast_sat_f64_i64(x))
 
 // ============================================================================
 // U8 conversions
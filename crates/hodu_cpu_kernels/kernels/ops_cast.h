@@ -34,6 +34,13 @@ extern "C" {
 // - metadata[2..2+num_dims]: shape
 // - metadata[2+num_dims..2+2*num_dims]: strides
 // - metadata[2+2*num_dims]: offset
+//
+// Float to integer casts saturate: NaN gives 0 and out-of-range values clamp to the integer
+// range (Rust `as` semantics). Integer to integer casts wrap.
+//
+// In place: a cast between types of the same size (e.g. f32 to i32) may write over its own
+// row-major input; any other overlap between the input view and the output is staged through a
+// workspace copy first.
 
 /**
  * @brief Macro to declare cast operations from one type to all other types
@@ -1,6 +1,13 @@
 #include "ops_concat_split.h"
+#include "profile.h"
+#include "strided_copy.h"
+#include "thread_utils.h"
 #include "types.h"
+#include "utils.h"
+#include "workspace.h"
 #include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
 
 // ============================================================================
 // CONCATENATION OPERATIONS
@@ -18,9 +25,211 @@
 // - ...: input_buffer_offsets (num_inputs elements)
 //
 // Algorithm:
-// For each output element, determine which input tensor it comes from by
-// checking the index along concat_dim, then map to the corresponding input
-// element using the input's shape and strides.
+// The output is viewed as [outer, row], where outer covers the dims before
+// concat_dim and each row is the inputs' blocks (shape[concat_dim] * inner
+// elements each) laid end to end. The pool splits the output into equal
+// element ranges and each task copies the (row, input) pieces of its range:
+// one memcpy for a contiguous input (or one whose dims from concat_dim on are
+// contiguous), otherwise strided runs along the input's innermost dim.
+
+// Dims the per-element paths index (the metadata supports up to this many)
+#define CS_MAX_DIMS 16
+
+/// One input as seen from an output row (the dims from concat_dim on)
+typedef struct {
+    const char *src;       // first element of the view
+    size_t start;          // first output column (in elements) the input fills
+    size_t width;          // columns it fills: shape[concat_dim] * inner
+    bool dense;            // the whole input is row-major: row o starts at o * width
+    bool tail_dense;       // the dims from concat_dim on are row-major
+    const size_t *shape;   // input shape
+    const size_t *strides; // input strides
+} concat_input_t;
+
+typedef struct {
+    const concat_input_t *inputs;
+    size_t num_inputs;
+    size_t num_dims;
+    size_t concat_dim;
+    const size_t *shape; // output shape
+    size_t row;          // elements per output row (dims from concat_dim on)
+    size_t elem_size;
+    char *dst;
+} concat_ctx_t;
+
+/// Copy n elements read with an element stride into contiguous dst
+static void concat_copy_run(const char *src, size_t stride, char *dst, size_t n,
+                            size_t elem_size) {
+    if (stride == 1) {
+        memcpy(dst, src, n * elem_size);
+        return;
+    }
+    switch (elem_size) {
+    case 1:
+        for (size_t i = 0; i < n; i++) {
+            dst[i] = src[i * stride];
+        }
+        break;
+    case 2:
+        for (size_t i = 0; i < n; i++) {
+            ((uint16_t *)dst)[i] = ((const uint16_t *)src)[i * stride];
+        }
+        break;
+    case 4:
+        for (size_t i = 0; i < n; i++) {
+            ((uint32_t *)dst)[i] = ((const uint32_t *)src)[i * stride];
+        }
+        break;
+    case 8:
+        for (size_t i = 0; i < n; i++) {
+            ((uint64_t *)dst)[i] = ((const uint64_t *)src)[i * stride];
+        }
+        break;
+    default:
+        for (size_t i = 0; i < n; i++) {
+            memcpy(dst + i * elem_size, src + i * stride * elem_size, elem_size);
+        }
+        break;
+    }
+}
+
+/// Copy elements [local, local + n) of output row o that come from one input
+static void concat_copy_segment(const concat_ctx_t *ctx, const concat_input_t *in, size_t o,
+                                size_t local, size_t n, char *dst) {
+    const size_t es = ctx->elem_size;
+    if (in->dense) {
+        memcpy(dst, in->src + (o * in->width + local) * es, n * es);
+        return;
+    }
+
+    /* Strided input: seek the row through the outer dims (shared with the output) */
+    size_t off = 0;
+    size_t rem = o;
+    for (size_t d = ctx->concat_dim; d-- > 0;) {
+        off += (rem % ctx->shape[d]) * in->strides[d];
+        rem /= ctx->shape[d];
+    }
+    if (in->tail_dense) {
+        memcpy(dst, in->src + (off + local) * es, n * es);
+        return;
+    }
+
+    /* Then walk the tail dims with an odometer, one innermost run at a time */
+    const size_t last = ctx->num_dims - 1;
+    size_t idx[CS_MAX_DIMS];
+    rem = local;
+    for (size_t d = last + 1; d-- > ctx->concat_dim;) {
+        idx[d] = rem % in->shape[d];
+        rem /= in->shape[d];
+        off += idx[d] * in->strides[d];
+    }
+    const size_t len = in->shape[last];
+    const size_t stride = in->strides[last];
+    while (n > 0) {
+        const size_t run = MINIMUM(len - idx[last], n);
+        concat_copy_run(in->src + off * es, stride, dst, run, es);
+        dst += run * es;
+        n -= run;
+        off -= idx[last] * stride;
+        idx[last] = 0;
+        for (size_t d = last; d-- > ctx->concat_dim;) {
+            off += in->strides[d];
+            if (++idx[d] < in->shape[d]) {
+                break;
+            }
+            off -= in->shape[d] * in->strides[d];
+            idx[d] = 0;
+        }
+    }
+}
+
+/// Output elements [start, end): one block copy per (row, input) piece in the range
+static void concat_worker(size_t start, size_t end, void *arg) {
+    const concat_ctx_t *ctx = (const concat_ctx_t *)arg;
+    const concat_input_t *inputs = ctx->inputs;
+    size_t o = start / ctx->row;
+    size_t c = start % ctx->row;
+    size_t i = 0;
+    while (inputs[i].start + inputs[i].width <= c) {
+        i++;
+    }
+    for (size_t pos = start; pos < end;) {
+        const concat_input_t *in = &inputs[i];
+        const size_t local = c - in->start;
+        const size_t n = MINIMUM(in->width - local, end - pos);
+        concat_copy_segment(ctx, in, o, local, n, ctx->dst + pos * ctx->elem_size);
+        pos += n;
+        c += n;
+        i++;
+        if (c == ctx->row) {
+            c = 0;
+            i = 0;
+            o++;
+        }
+    }
+}
+
+static void concat_run(const void *input_ptr, void *output_ptr, const size_t *metadata,
+                       size_t elem_size) {
+    const char *input = (const char *)input_ptr;
+    const size_t num_els = metadata[0];
+    const size_t num_dims = metadata[1];
+    const size_t *output_shape = metadata + 2;
+    const size_t concat_dim = metadata[2 + num_dims];
+    const size_t num_inputs = metadata[2 + num_dims + 1];
+    const size_t *input_shapes = metadata + 2 + num_dims + 2;
+    const size_t *input_strides = input_shapes + num_inputs * num_dims;
+    const size_t *input_offsets = input_strides + num_inputs * num_dims;
+    const size_t *input_buffer_offsets = input_offsets + num_inputs;
+    if (num_els == 0) {
+        return;
+    }
+
+    size_t inner = 1;
+    for (size_t d = concat_dim + 1; d < num_dims; d++) {
+        inner *= output_shape[d];
+    }
+    concat_input_t *inputs =
+        (concat_input_t *)workspace_acquire(num_inputs * sizeof(concat_input_t));
+    if (!inputs) {
+        return;
+    }
+
+    /* Empty inputs are dropped so that every input fills at least one column */
+    size_t count = 0;
+    size_t column = 0;
+    for (size_t i = 0; i < num_inputs; i++) {
+        const size_t *shape = input_shapes + i * num_dims;
+        const size_t *strides = input_strides + i * num_dims;
+        if (shape[concat_dim] == 0) {
+            continue;
+        }
+        concat_input_t *in = &inputs[count++];
+        in->src = input + (input_buffer_offsets[i] + input_offsets[i]) * elem_size;
+        in->start = column;
+        in->width = shape[concat_dim] * inner;
+        in->shape = shape;
+        in->strides = strides;
+        in->tail_dense = true;
+        in->dense = true;
+        size_t expected = 1;
+        for (size_t d = num_dims; d-- > 0;) {
+            if (shape[d] != 1 && strides[d] != expected) {
+                if (d >= concat_dim) {
+                    in->tail_dense = false;
+                }
+                in->dense = false;
+            }
+            expected *= shape[d];
+        }
+        column += in->width;
+    }
+
+    concat_ctx_t ctx = {inputs, count, num_dims, concat_dim, output_shape, column, elem_size,
+                        (char *)output_ptr};
+    parallel_for(0, num_els, task_grain(HODU_CPU_COST_COPY, elem_size), concat_worker, &ctx);
+    workspace_release(inputs);
+}
 
 /// Macro to implement a concatenation operation
 ///
@@ -28,57 +237,8 @@
 /// @param FN_NAME Function name
 #define CONCAT_OP(TYPENAME, FN_NAME)                                                               \
     void hodu_cpu_##FN_NAME(const void *input_ptr, void *output_ptr, const size_t *metadata) {     \
-        const TYPENAME *input = (const TYPENAME *)input_ptr;                                       \
-        TYPENAME *output = (TYPENAME *)output_ptr;                                                 \
-                                                                                                   \
-        const size_t num_els = metadata[0];                                                        \
-        const size_t num_dims = metadata[1];                                                       \
-        const size_t *output_shape = metadata + 2;                                                 \
-        const size_t concat_dim = metadata[2 + num_dims];                                          \
-        const size_t num_inputs = metadata[2 + num_dims + 1];                                      \
-        const size_t *input_shapes = metadata + 2 + num_dims + 2;                                  \
-        const size_t *input_strides = input_shapes + num_inputs * num_dims;                        \
-        const size_t *input_offsets = input_strides + num_inputs * num_dims;                       \
-        const size_t *input_buffer_offsets = input_offsets + num_inputs;                           \
-                                                                                                   \
-        /* Process each output element */                                                          \
-        for (size_t id = 0; id < num_els; id++) {                                                  \
-            /* Calculate output indices from flat id */                                            \
-            size_t output_indices[16];                                                             \
-            size_t temp = id;                                                                      \
-            for (int d = (int)num_dims - 1; d >= 0; d--) {                                         \
-                output_indices[d] = temp % output_shape[d];                                        \
-                temp /= output_shape[d];                                                           \
-            }                                                                                      \
-                                                                                                   \
-            /* Determine which input tensor to read from */                                        \
-            size_t dim_index = output_indices[concat_dim];                                         \
-            size_t tensor_idx = 0;                                                                 \
-            size_t cumulative_size = 0;                                                            \
-                                                                                                   \
-            for (size_t i = 0; i < num_inputs; i++) {                                              \
-                size_t dim_size = input_shapes[i * num_dims + concat_dim];                         \
-                if (dim_index < cumulative_size + dim_size) {                                      \
-                    tensor_idx = i;                                                                \
-                    break;                                                                         \
-                }                                                                                  \
-                cumulative_size += dim_size;                                                       \
-            }                                                                                      \
-                                                                                                   \
-            /* Calculate input index */                                                            \
-            const size_t *input_stride = input_strides + tensor_idx * num_dims;                    \
-            size_t input_offset = input_offsets[tensor_idx];                                       \
-            size_t buffer_offset = input_buffer_offsets[tensor_idx];                               \
-                                                                                                   \
-            size_t flat_index = input_offset;                                                      \
-            for (size_t i = 0; i < num_dims; i++) {                                                \
-                size_t idx =                                                                       \
-                    (i == concat_dim) ? (dim_index - cumulative_size) : output_indices[i];         \
-                flat_index += idx * input_stride[i];                                               \
-            }                                                                                      \
-                                                                                                   \
-            output[id] = input[buffer_offset + flat_index];                                        \
-        }                                                                                          \
+        HODU_PROFILE_KERNEL(metadata[0] * 2 * sizeof(TYPENAME));                                   \
+        concat_run(input_ptr, output_ptr, metadata, sizeof(TYPENAME));                             \
     }
 
 // Define concat operations for all types
@@ -113,8 +273,32 @@ CONCAT_OP(uint64_t, concat_u64)
 // - metadata[2+2*num_dims+3]: split_offset (offset along split dimension where output starts)
 //
 // Algorithm:
-// For each output element, compute its indices in the output space, then
-// map to the input space by adding split_offset to the index along split_dim.
+// The output is the input view shifted by split_offset along split_dim, so it
+// is copied by the strided copy engine (merged dims, row memcpy, transposes
+// and gathers on the thread pool).
+
+static void split_run(const void *input_ptr, void *output_ptr, const size_t *metadata,
+                      size_t elem_size) {
+    const size_t num_els = metadata[0];
+    const size_t num_dims = metadata[1];
+    const size_t *input_shape = metadata + 2;
+    const size_t *input_strides = metadata + 2 + num_dims;
+    const size_t input_offset = metadata[2 + 2 * num_dims];
+    const size_t split_dim = metadata[2 + 2 * num_dims + 1];
+    const size_t output_size_on_dim = metadata[2 + 2 * num_dims + 2];
+    const size_t split_offset = metadata[2 + 2 * num_dims + 3];
+    if (num_els == 0) {
+        return;
+    }
+
+    size_t output_shape[CS_MAX_DIMS];
+    for (size_t i = 0; i < num_dims; i++) {
+        output_shape[i] = (i == split_dim) ? output_size_on_dim : input_shape[i];
+    }
+    const size_t offset = input_offset + split_offset * input_strides[split_dim];
+    hodu_cpu_strided_copy((const char *)input_ptr + offset * elem_size, output_ptr, elem_size,
+                          num_dims, output_shape, input_strides, NULL);
+}
 
 /// Macro to implement a split operation
 ///
@@ -122,44 +306,8 @@ CONCAT_OP(uint64_t, concat_u64)
 /// @param FN_NAME Function name
 #define SPLIT_OP(TYPENAME, FN_NAME)                                                                \
     void hodu_cpu_##FN_NAME(const void *input_ptr, void *output_ptr, const size_t *metadata) {     \
-        const TYPENAME *input = (const TYPENAME *)input_ptr;                                       \
-        TYPENAME *output = (TYPENAME *)output_ptr;                                                 \
-                                                                                                   \
-        const size_t num_els = metadata[0];                                                        \
-        const size_t num_dims = metadata[1];                                                       \
-        const size_t *input_shape = metadata + 2;                                                  \
-        const size_t *input_strides = metadata + 2 + num_dims;                                     \
-        const size_t input_offset = metadata[2 + 2 * num_dims];                                    \
-        const size_t split_dim = metadata[2 + 2 * num_dims + 1];                                   \
-        const size_t output_size_on_dim = metadata[2 + 2 * num_dims + 2];                          \
-        const size_t split_offset = metadata[2 + 2 * num_dims + 3];                                \
-                                                                                                   \
-        /* Calculate output shape */                                                               \
-        size_t output_shape[16];                                                                   \
-        for (size_t i = 0; i < num_dims; i++) {                                                    \
-            output_shape[i] = (i == split_dim) ? output_size_on_dim : input_shape[i];              \
-        }                                                                                          \
-                                                                                                   \
-        /* Process each output element */                                                          \
-        for (size_t id = 0; id < num_els; id++) {                                                  \
-            /* Calculate output indices from flat id */                                            \
-            size_t output_indices[16];                                                             \
-            size_t temp = id;                                                                      \
-            for (int d = (int)num_dims - 1; d >= 0; d--) {                                         \
-                output_indices[d] = temp % output_shape[d];                                        \
-                temp /= output_shape[d];                                                           \
-            }                                                                                      \
-                                                                                                   \
-            /* Calculate input flat index */                                                       \
-            size_t flat_index = input_offset;                                                      \
-            for (size_t i = 0; i < num_dims; i++) {                                                \
-                size_t idx =                                                                       \
-                    (i == split_dim) ? (output_indices[i] + split_offset) : output_indices[i];     \
-                flat_index += idx * input_strides[i];                                              \
-            }                                                                                      \
-                                                                                                   \
-            output[id] = input[flat_index];                                                        \
-        }                                                                                          \
+        HODU_PROFILE_KERNEL(metadata[0] * 2 * sizeof(TYPENAME));                                   \
+        split_run(input_ptr, output_ptr, metadata, sizeof(TYPENAME));                              \
     }
 
 // Define split operations for all types
@@ -7,7 +7,9 @@
  * - Split a tensor into multiple outputs along a dimension
  *
  * These are inverse operations commonly used in neural networks for
- * combining or dividing feature maps, attention heads, etc.
+ * combining or dividing feature maps, attention heads, etc. Both copy whole
+ * contiguous blocks with memcpy where the layouts allow and split the output
+ * across the thread pool.
  */
 
 #ifndef OPS_CONCAT_SPLIT_H
@@ -1,6 +1,11 @@
 #include "ops_conv.h"
-#include "atomic.h"
+#include "gemm.h"
+#include "profile.h"
+#include "simd_utils.h"
+#include "thread_utils.h"
 #include "types.h"
+#include "workspace.h"
+#include <stdbool.h>
 #include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
@@ -27,55 +32,6 @@
 // - metadata[10]: input_offset
 // - metadata[11]: weight_offset
 
-/// Macro to implement 1D convolution operation
-///
-/// @param TYPE C type for the operation
-/// @param TYPE_SUFFIX Suffix for function naming
-#define CONV1D_OP(TYPE, TYPE_SUFFIX)                                                               \
-    void hodu_cpu_conv1d_##TYPE_SUFFIX(const void *input_ptr, const void *weight_ptr,              \
-                                       void *output_ptr, const size_t *metadata) {                 \
-        const TYPE *input = (const TYPE *)input_ptr;                                               \
-        const TYPE *weight = (const TYPE *)weight_ptr;                                             \
-        TYPE *output = (TYPE *)output_ptr;                                                         \
-                                                                                                   \
-        const size_t num_els = metadata[0];                                                        \
-        const size_t batch = metadata[1];                                                          \
-        const size_t in_channels = metadata[2];                                                    \
-        const size_t out_channels = metadata[3];                                                   \
-        const size_t in_width = metadata[4];                                                       \
-        const size_t kernel_width = metadata[5];                                                   \
-        const size_t out_width = metadata[6];                                                      \
-        const size_t stride = metadata[7];                                                         \
-        const size_t padding = metadata[8];                                                        \
-        const size_t dilation = metadata[9];                                                       \
-        const size_t input_offset = metadata[10];                                                  \
-        const size_t weight_offset = metadata[11];                                                 \
-                                                                                                   \
-        (void)batch; /* Batch is computed from idx, kept for API consistency */                    \
-                                                                                                   \
-        for (size_t idx = 0; idx < num_els; idx++) {                                               \
-            const size_t ow = idx % out_width;                                                     \
-            const size_t oc = (idx / out_width) % out_channels;                                    \
-            const size_t b = idx / (out_width * out_channels);                                     \
-                                                                                                   \
-            TYPE sum = 0;                                                                          \
-            for (size_t ic = 0; ic < in_channels; ic++) {                                          \
-                for (size_t kw = 0; kw < kernel_width; kw++) {                                     \
-                    const int iw = (int)(ow * stride) - (int)padding + (int)(kw * dilation);       \
-                    if (iw >= 0 && iw < (int)in_width) {                                           \
-                        const size_t input_idx =                                                   \
-                            input_offset + b * in_channels * in_width + ic * in_width + iw;        \
-                        const size_t weight_idx = weight_offset +                                  \
-                                                  oc * in_channels * kernel_width +                \
-                                                  ic * kernel_width + kw;                          \
-                        sum += input[input_idx] * weight[weight_idx];                              \
-                    }                                                                              \
-                }                                                                                  \
-            }                                                                                      \
-            output[idx] = sum;                                                                     \
-        }                                                                                          \
-    }
-
 /// Macro to implement 1D convolution operation for exotic types
 ///
 /// @param TYPE C type for the operation
@@ -86,6 +42,7 @@
 #define CONV1D_OP_EXOTIC(TYPE, TYPE_SUFFIX, ZERO, ADD_FN, MUL_FN)                                  \
     void hodu_cpu_conv1d_##TYPE_SUFFIX(const void *input_ptr, const void *weight_ptr,              \
                                        void *output_ptr, const size_t *metadata) {                 \
+        HODU_PROFILE_KERNEL(hodu_cpu_profile_conv_bytes(metadata, 1, sizeof(TYPE)));               \
         const TYPE *input = (const TYPE *)input_ptr;                                               \
         const TYPE *weight = (const TYPE *)weight_ptr;                                             \
         TYPE *output = (TYPE *)output_ptr;                                                         \
@@ -132,8 +89,6 @@ CONV1D_OP_EXOTIC(f8e4m3_t, f8e4m3, F8E4M3_ZERO, f8e4m3_add, f8e4m3_mul)
 CONV1D_OP_EXOTIC(f8e5m2_t, f8e5m2, F8E5M2_ZERO, f8e5m2_add, f8e5m2_mul)
 CONV1D_OP_EXOTIC(bf16_t, bf16, BF16_ZERO, bf16_add, bf16_mul)
 CONV1D_OP_EXOTIC(f16_t, f16, F16_ZERO, f16_add, f16_mul)
-CONV1D_OP(float, f32)
-CONV1D_OP(double, f64)
 
 // ============================================================================
 // IM2COL HELPER FUNCTIONS FOR 2D CONVOLUTION
@@ -172,6 +127,7 @@ CONV1D_OP(double, f64)
 #define CONV2D_OP(TYPE, TYPE_SUFFIX)                                                               \
     void hodu_cpu_conv2d_##TYPE_SUFFIX(const void *input_ptr, const void *weight_ptr,              \
                                        void *output_ptr, const size_t *metadata) {                 \
+        HODU_PROFILE_KERNEL(hodu_cpu_profile_conv_bytes(metadata, 2, sizeof(TYPE)));               \
         const TYPE *input = (const TYPE *)input_ptr;                                               \
         const TYPE *weight = (const TYPE *)weight_ptr;                                             \
         TYPE *output = (TYPE *)output_ptr;                                                         \
@@ -237,6 +193,7 @@ CONV1D_OP(double, f64)
 #define CONV2D_OP_EXOTIC(TYPE, TYPE_SUFFIX, ZERO, ADD_FN, MUL_FN)                                  \
     void hodu_cpu_conv2d_##TYPE_SUFFIX(const void *input_ptr, const void *weight_ptr,              \
                                        void *output_ptr, const size_t *metadata) {                 \
+        HODU_PROFILE_KERNEL(hodu_cpu_profile_conv_bytes(metadata, 2, sizeof(TYPE)));               \
         const TYPE *input = (const TYPE *)input_ptr;                                               \
         const TYPE *weight = (const TYPE *)weight_ptr;                                             \
         TYPE *output = (TYPE *)output_ptr;                                                         \
@@ -301,137 +258,1247 @@ CONV2D_OP_EXOTIC(bf16_t, bf16, BF16_ZERO, bf16_add, bf16_mul)
 CONV2D_OP_EXOTIC(f16_t, f16, F16_ZERO, f16_add, f16_mul)
 
 // ============================================================================
-// 3D CONVOLUTION OPERATIONS
+// FUSED AND PRE-PACKED WEIGHT 2D CONVOLUTION
 // ============================================================================
 //
-// Metadata layout for conv3d:
-// - metadata[0]: num_els (total number of output elements)
-// - metadata[1]: batch
-// - metadata[2]: in_channels
-// - metadata[3]: out_channels
-// - metadata[4]: in_depth
-// - metadata[5]: in_height
-// - metadata[6]: in_width
-// - metadata[7]: kernel_depth
-// - metadata[8]: kernel_height
-// - metadata[9]: kernel_width
-// - metadata[10]: out_depth
-// - metadata[11]: out_height
-// - metadata[12]: out_width
-// - metadata[13]: stride_d
-// - metadata[14]: stride_h
-// - metadata[15]: stride_w
-// - metadata[16]: padding_d
-// - metadata[17]: padding_h
-// - metadata[18]: padding_w
-// - metadata[19]: dilation_d
-// - metadata[20]: dilation_h
-// - metadata[21]: dilation_w
-// - metadata[22]: input_offset
-// - metadata[23]: weight_offset
+// The weight is the [out_channels, in_channels * kh * kw] lhs of an im2col GEMM
+// on the native engine (gemm.c); the epilogue (scale, per-channel bias,
+// residual, activation) is applied by the GEMM to each finished output tile.
+// A weight packed once with hodu_cpu_conv2d_pack_weight_* skips weight packing:
+// every call then only builds the column matrix of each batch element.
 
-/// Macro to implement 3D convolution operation
+/// Macro to implement fused and pre-packed weight conv2d (size query, pack, convolve)
 ///
 /// @param TYPE C type for the operation
 /// @param TYPE_SUFFIX Suffix for function naming
-#define CONV3D_OP(TYPE, TYPE_SUFFIX)                                                               \
-    void hodu_cpu_conv3d_##TYPE_SUFFIX(const void *input_ptr, const void *weight_ptr,              \
-                                       void *output_ptr, const size_t *metadata) {                 \
-        const TYPE *input = (const TYPE *)input_ptr;                                               \
-        const TYPE *weight = (const TYPE *)weight_ptr;                                             \
-        TYPE *output = (TYPE *)output_ptr;                                                         \
+#define CONV2D_FUSED_OP(TYPE, TYPE_SUFFIX)                                                         \
+    /* Row (ic, kh, kw) of the [K, oh * ow] column matrix holds the shifted input plane */         \
+    static void conv2d_im2col_##TYPE_SUFFIX(const TYPE *input, TYPE *col, size_t in_channels,      \
+                                            size_t in_height, size_t in_width,                     \
+                                            size_t kernel_height, size_t kernel_width,             \
+                                            size_t out_height, size_t out_width, size_t stride_h,  \
+                                            size_t stride_w, size_t padding_h, size_t padding_w,   \
+                                            size_t dilation_h, size_t dilation_w) {                \
+        for (size_t ic = 0; ic < in_channels; ic++) {                                              \
+            const TYPE *plane = input + ic * in_height * in_width;                                 \
+            for (size_t kh = 0; kh < kernel_height; kh++) {                                        \
+                for (size_t kw = 0; kw < kernel_width; kw++) {                                     \
+                    const long w_shift = (long)(kw * dilation_w) - (long)padding_w;                \
+                    for (size_t oh = 0; oh < out_height; oh++, col += out_width) {                 \
+                        const long ih = (long)(oh * stride_h) - (long)padding_h +                  \
+                                        (long)(kh * dilation_h);                                   \
+                        if (ih < 0 || ih >= (long)in_height) {                                     \
+                            memset(col, 0, out_width * sizeof(TYPE));                              \
+                            continue;                                                              \
+                        }                                                                          \
+                        const TYPE *row = plane + ih * in_width;                                   \
+                        for (size_t ow = 0; ow < out_width; ow++) {                                \
+                            const long iw = (long)(ow * stride_w) + w_shift;                       \
+                            col[ow] = (iw >= 0 && iw < (long)in_width) ? row[iw] : (TYPE)0;        \
+                        }                                                                          \
+                    }                                                                              \
+                }                                                                                  \
+            }                                                                                      \
+        }                                                                                          \
+    }                                                                                              \
+                                                                                                   \
+    size_t hodu_cpu_conv2d_packed_weight_size_##TYPE_SUFFIX(const size_t *metadata) {              \
+        const size_t K = metadata[2] * metadata[6] * metadata[7];                                  \
+        return hodu_cpu_gemm_packed_lhs_size_##TYPE_SUFFIX(metadata[3], K) * sizeof(TYPE);         \
+    }                                                                                              \
+                                                                                                   \
+    void hodu_cpu_conv2d_pack_weight_##TYPE_SUFFIX(const void *weight_ptr, void *packed_ptr,       \
+                                                   const size_t *metadata) {                       \
+        HODU_PROFILE_KERNEL(2 * metadata[2] * metadata[3] * metadata[6] * metadata[7] *            \
+                            sizeof(TYPE));                                                         \
+        const size_t K = metadata[2] * metadata[6] * metadata[7];                                  \
+        hodu_cpu_gemm_pack_lhs_##TYPE_SUFFIX(metadata[3], K,                                       \
+                                             (const TYPE *)weight_ptr + metadata[17], K, 1,        \
+                                             (TYPE *)packed_ptr);                                  \
+    }                                                                                              \
+                                                                                                   \
+    /* Exactly one of weight / packed is set */                                                    \
+    static void conv2d_gemm_##TYPE_SUFFIX(const TYPE *input, const TYPE *weight,                   \
+                                          const TYPE *packed, TYPE *output,                        \
+                                          const size_t *metadata, const hodu_cpu_epilogue_t *e) {  \
                                                                                                    \
-        const size_t num_els = metadata[0];                                                        \
         const size_t batch = metadata[1];                                                          \
         const size_t in_channels = metadata[2];                                                    \
         const size_t out_channels = metadata[3];                                                   \
-        const size_t in_depth = metadata[4];                                                       \
-        const size_t in_height = metadata[5];                                                      \
-        const size_t in_width = metadata[6];                                                       \
-        const size_t kernel_depth = metadata[7];                                                   \
-        const size_t kernel_height = metadata[8];                                                  \
-        const size_t kernel_width = metadata[9];                                                   \
-        const size_t out_depth = metadata[10];                                                     \
-        const size_t out_height = metadata[11];                                                    \
-        const size_t out_width = metadata[12];                                                     \
-        const size_t stride_d = metadata[13];                                                      \
-        const size_t stride_h = metadata[14];                                                      \
-        const size_t stride_w = metadata[15];                                                      \
-        const size_t padding_d = metadata[16];                                                     \
-        const size_t padding_h = metadata[17];                                                     \
-        const size_t padding_w = metadata[18];                                                     \
-        const size_t dilation_d = metadata[19];                                                    \
-        const size_t dilation_h = metadata[20];                                                    \
-        const size_t dilation_w = metadata[21];                                                    \
-        const size_t input_offset = metadata[22];                                                  \
-        const size_t weight_offset = metadata[23];                                                 \
+        const size_t in_height = metadata[4];                                                      \
+        const size_t in_width = metadata[5];                                                       \
+        const size_t kernel_height = metadata[6];                                                  \
+        const size_t kernel_width = metadata[7];                                                   \
+        const size_t out_height = metadata[8];                                                     \
+        const size_t out_width = metadata[9];                                                      \
+        const size_t stride_h = metadata[10];                                                      \
+        const size_t stride_w = metadata[11];                                                      \
+        const size_t padding_h = metadata[12];                                                     \
+        const size_t padding_w = metadata[13];                                                     \
+        const size_t dilation_h = metadata[14];                                                    \
+        const size_t dilation_w = metadata[15];                                                    \
+        const size_t input_offset = metadata[16];                                                  \
+        const size_t weight_offset = metadata[17];                                                 \
                                                                                                    \
-        (void)batch; /* Batch is computed from idx, kept for API consistency */                    \
+        const size_t M = out_channels;                                                             \
+        const size_t K = in_channels * kernel_height * kernel_width;                               \
+        const size_t N = out_height * out_width;                                                   \
+                                                                                                   \
+        /* A 1x1 stride-1 unpadded kernel reads the input planes as the column matrix */           \
+        const bool direct = kernel_height == 1 && kernel_width == 1 && stride_h == 1 &&            \
+                            stride_w == 1 && padding_h == 0 && padding_w == 0;                     \
+        TYPE *col = NULL;                                                                          \
+        if (!direct) {                                                                             \
+            col = (TYPE *)workspace_acquire(K * N * sizeof(TYPE));                                 \
+            if (!col) {                                                                            \
+                return;                                                                            \
+            }                                                                                      \
+        }                                                                                          \
                                                                                                    \
-        for (size_t idx = 0; idx < num_els; idx++) {                                               \
-            const size_t ow = idx % out_width;                                                     \
-            const size_t oh = (idx / out_width) % out_height;                                      \
-            const size_t od = (idx / (out_width * out_height)) % out_depth;                        \
-            const size_t oc = (idx / (out_width * out_height * out_depth)) % out_channels;         \
-            const size_t b = idx / (out_width * out_height * out_depth * out_channels);            \
+        for (size_t b = 0; b < batch; b++) {                                                       \
+            const TYPE *batch_input =                                                              \
+                input + input_offset + b * in_channels * in_height * in_width;                     \
+            const TYPE *cols = batch_input;                                                        \
+            if (!direct) {                                                                         \
+                conv2d_im2col_##TYPE_SUFFIX(batch_input, col, in_channels, in_height, in_width,    \
+                                            kernel_height, kernel_width, out_height, out_width,    \
+                                            stride_h, stride_w, padding_h, padding_w, dilation_h,  \
+                                            dilation_w);                                           \
+                cols = col;                                                                        \
+            }                                                                                      \
                                                                                                    \
-            TYPE sum = 0;                                                                          \
-            for (size_t ic = 0; ic < in_channels; ic++) {                                          \
-                for (size_t kd = 0; kd < kernel_depth; kd++) {                                     \
-                    for (size_t kh = 0; kh < kernel_height; kh++) {                                \
-                        for (size_t kw = 0; kw < kernel_width; kw++) {                             \
-                            const int id =                                                         \
-                                (int)(od * stride_d) - (int)padding_d + (int)(kd * dilation_d);    \
-                            const int ih =                                                         \
-                                (int)(oh * stride_h) - (int)padding_h + (int)(kh * dilation_h);    \
-                            const int iw =                                                         \
-                                (int)(ow * stride_w) - (int)padding_w + (int)(kw * dilation_w);    \
-                            if (id >= 0 && id < (int)in_depth && ih >= 0 && ih < (int)in_height && \
-                                iw >= 0 && iw < (int)in_width) {                                   \
-                                const size_t input_idx =                                           \
-                                    input_offset +                                                 \
-                                    b * in_channels * in_depth * in_height * in_width +            \
-                                    ic * in_depth * in_height * in_width +                         \
-                                    id * in_height * in_width + ih * in_width + iw;                \
-                                const size_t weight_idx =                                          \
-                                    weight_offset +                                                \
-                                    oc * in_channels * kernel_depth * kernel_height *              \
-                                        kernel_width +                                             \
-                                    ic * kernel_depth * kernel_height * kernel_width +             \
-                                    kd * kernel_height * kernel_width + kh * kernel_width + kw;    \
-                                sum += input[input_idx] * weight[weight_idx];                      \
+            /* Output channels are GEMM rows: the bias is per row */                               \
+            hodu_cpu_gemm_epilogue_t ep;                                                           \
+            if (e) {                                                                               \
+                ep.scale = e->scale;                                                               \
+                ep.bias = e->bias;                                                                 \
+                ep.bias_per_row = true;                                                            \
+                ep.residual = e->residual ? (const TYPE *)e->residual + b * M * N : NULL;          \
+                ep.ldr = N;                                                                        \
+                ep.activation = e->activation;                                                     \
+            }                                                                                      \
+            if (packed) {                                                                          \
+                hodu_cpu_gemm_packed_lhs_##TYPE_SUFFIX(M, N, K, packed, cols, N, 1,                \
+                                                       output + b * M * N, N, e ? &ep : NULL);     \
+            } else {                                                                               \
+                hodu_cpu_gemm_fused_##TYPE_SUFFIX(M, N, K, weight + weight_offset, K, 1, cols, N,  \
+                                                  1, output + b * M * N, N, e ? &ep : NULL);       \
+            }                                                                                      \
+        }                                                                                          \
+                                                                                                   \
+        workspace_release(col);                                                                    \
+    }                                                                                              \
+                                                                                                   \
+    void hodu_cpu_conv2d_fused_##TYPE_SUFFIX(const void *input_ptr, const void *weight_ptr,        \
+                                             void *output_ptr, const size_t *metadata,             \
+                                             const hodu_cpu_epilogue_t *epilogue) {                \
+        HODU_PROFILE_KERNEL(hodu_cpu_profile_conv_bytes(metadata, 2, sizeof(TYPE)));               \
+        conv2d_gemm_##TYPE_SUFFIX((const TYPE *)input_ptr, (const TYPE *)weight_ptr, NULL,         \
+                                  (TYPE *)output_ptr, metadata, epilogue);                         \
+    }                                                                                              \
+                                                                                                   \
+    void hodu_cpu_conv2d_packed_##TYPE_SUFFIX(const void *input_ptr, const void *packed_ptr,       \
+                                              void *output_ptr, const size_t *metadata,            \
+                                              const hodu_cpu_epilogue_t *epilogue) {               \
+        HODU_PROFILE_KERNEL(hodu_cpu_profile_conv_bytes(metadata, 2, sizeof(TYPE)));               \
+        conv2d_gemm_##TYPE_SUFFIX((const TYPE *)input_ptr, NULL, (const TYPE *)packed_ptr,         \
+                                  (TYPE *)output_ptr, metadata, epilogue);                         \
+    }
+
+CONV2D_FUSED_OP(f32_t, f32)
+CONV2D_FUSED_OP(f64_t, f64)
+
+// ============================================================================
+// NATIVE 2D CONVOLUTION ENGINE
+// ============================================================================
+//
+// Without BLAS, hodu_cpu_conv2d_f32/f64 pick an engine from the metadata:
+// - 1x1, stride 1, no padding: one GEMM per batch element on the input planes
+// - 3x3, stride 1, dilation 1 with enough channels: Winograd F(4x4, 3x3), or
+//   F(2x2, 3x3) for outputs smaller than 8x8 (fewer wasted tile outputs)
+// - anything else: direct convolution blocked over output channels
+//
+// Direct convolution repacks the weight as [oc / OCB][ic][kh][kw][OCB] so one
+// input value feeds OCB output channels from a contiguous weight vector. An
+// OCB x OWB block of outputs stays in registers across the whole (ic, kh, kw)
+// reduction; only border columns that touch the padding take a checked path.
+// Work is split over (batch, output-channel block, output row) on the pool.
+// Stride-1 layers run a task with a constant width stride, and 3- or 5-wide
+// undilated kernels one with a constant kernel width (CONV2D_DIRECT_TASK).
+//
+// Winograd computes each m x m output tile as A^T [(G g G^T) . (B^T d B)] A.
+// The element-wise products over all tiles become alpha^2 independent GEMMs
+// (one per transform coordinate) of [oc x ic] @ [ic x tiles], which run on the
+// pool together with the input and output transforms. Tiles are processed in
+// chunks to bound the transform buffers.
+
+#ifndef USE_BLAS
+
+typedef struct {
+    size_t batch, in_channels, out_channels;
+    size_t in_height, in_width, kernel_height, kernel_width, out_height, out_width;
+    size_t stride_h, stride_w, padding_h, padding_w, dilation_h, dilation_w;
+    size_t input_offset, weight_offset;
+} conv2d_params_t;
+
+static void conv2d_parse_params(const size_t *metadata, conv2d_params_t *p) {
+    p->batch = metadata[1];
+    p->in_channels = metadata[2];
+    p->out_channels = metadata[3];
+    p->in_height = metadata[4];
+    p->in_width = metadata[5];
+    p->kernel_height = metadata[6];
+    p->kernel_width = metadata[7];
+    p->out_height = metadata[8];
+    p->out_width = metadata[9];
+    p->stride_h = metadata[10];
+    p->stride_w = metadata[11];
+    p->padding_h = metadata[12];
+    p->padding_w = metadata[13];
+    p->dilation_h = metadata[14];
+    p->dilation_w = metadata[15];
+    p->input_offset = metadata[16];
+    p->weight_offset = metadata[17];
+}
+
+// Output channels per direct-convolution block
+#define CONV2D_DIRECT_OCB 8
+
+// Multiply-adds per parallel chunk of direct convolution
+#define CONV2D_DIRECT_GRAIN_WORK (1 << 15)
+
+// Minimum in_channels * out_channels for Winograd (transforms dominate below)
+#define CONV2D_WINOGRAD_MIN_CHANNELS 64
+
+// Elements of V + M transform buffers per Winograd chunk
+#define CONV2D_WINOGRAD_CHUNK_ELEMS (1 << 21)
+
+/// Winograd F(m x m, 3 x 3) transform matrices (alpha = m + 2)
+typedef struct {
+    size_t m, alpha;
+    const double *bt; // alpha x alpha
+    const double *g;  // alpha x 3
+    const double *at; // m x alpha
+} conv2d_winograd_t;
+
+static const double conv2d_wino2_bt[4][4] = {
+    {1, 0, -1, 0}, {0, 1, 1, 0}, {0, -1, 1, 0}, {0, 1, 0, -1}};
+static const double conv2d_wino2_g[4][3] = {
+    {1, 0, 0}, {0.5, 0.5, 0.5}, {0.5, -0.5, 0.5}, {0, 0, 1}};
+static const double conv2d_wino2_at[2][4] = {{1, 1, 1, 0}, {0, 1, -1, -1}};
+
+static const double conv2d_wino4_bt[6][6] = {
+    {4, 0, -5, 0, 1, 0},  {0, -4, -4, 1, 1, 0}, {0, 4, -4, -1, 1, 0},
+    {0, -2, -1, 2, 1, 0}, {0, 2, -1, -2, 1, 0}, {0, 4, 0, -5, 0, 1}};
+static const double conv2d_wino4_g[6][3] = {
+    {1.0 / 4, 0, 0},
+    {-1.0 / 6, -1.0 / 6, -1.0 / 6},
+    {-1.0 / 6, 1.0 / 6, -1.0 / 6},
+    {1.0 / 24, 1.0 / 12, 1.0 / 6},
+    {1.0 / 24, -1.0 / 12, 1.0 / 6},
+    {0, 0, 1}};
+static const double conv2d_wino4_at[4][6] = {
+    {1, 1, 1, 1, 1, 0}, {0, 1, -1, 2, -2, 0}, {0, 1, 1, 4, 4, 0}, {0, 1, -1, 8, -8, 1}};
+
+static const conv2d_winograd_t conv2d_wino2 = {2, 4, conv2d_wino2_bt[0], conv2d_wino2_g[0],
+                                               conv2d_wino2_at[0]};
+static const conv2d_winograd_t conv2d_wino4 = {4, 6, conv2d_wino4_bt[0], conv2d_wino4_g[0],
+                                               conv2d_wino4_at[0]};
+
+/// Winograd variant for a layer, or NULL when direct/GEMM convolution fits better
+static const conv2d_winograd_t *conv2d_winograd_select(const conv2d_params_t *p) {
+    if (p->kernel_height != 3 || p->kernel_width != 3 || p->stride_h != 1 || p->stride_w != 1 ||
+        p->dilation_h != 1 || p->dilation_w != 1 ||
+        p->in_channels * p->out_channels < CONV2D_WINOGRAD_MIN_CHANNELS) {
+        return NULL;
+    }
+    if (p->out_height >= 8 && p->out_width >= 8) {
+        return &conv2d_wino4;
+    }
+    return (p->out_height >= 2 && p->out_width >= 2) ? &conv2d_wino2 : NULL;
+}
+
+/// Tiles per Winograd chunk
+static size_t conv2d_winograd_chunk(const conv2d_params_t *p, const conv2d_winograd_t *w) {
+    const size_t alpha2 = w->alpha * w->alpha;
+    const size_t total_tiles = p->batch * ((p->out_height + w->m - 1) / w->m) *
+                               ((p->out_width + w->m - 1) / w->m);
+    size_t chunk = CONV2D_WINOGRAD_CHUNK_ELEMS / (alpha2 * (p->in_channels + p->out_channels));
+    chunk = chunk ? chunk : 1;
+    return chunk < total_tiles ? chunk : total_tiles;
+}
+
+/// Scratch bytes of the Winograd U, V and M buffers
+static size_t conv2d_winograd_scratch(const conv2d_params_t *p, const conv2d_winograd_t *w,
+                                      size_t elem_size) {
+    const size_t alpha2 = w->alpha * w->alpha;
+    const size_t chunk = conv2d_winograd_chunk(p, w);
+    return hodu_cpu_workspace_block_size(alpha2 * p->out_channels * p->in_channels * elem_size) +
+           hodu_cpu_workspace_block_size(alpha2 * p->in_channels * chunk * elem_size) +
+           alpha2 * p->out_channels * chunk * elem_size;
+}
+
+/// 1x1 stride-1 unpadded layers are a plain GEMM on the input planes
+static bool conv2d_is_pointwise(const conv2d_params_t *p) {
+    return p->kernel_height == 1 && p->kernel_width == 1 && p->stride_h == 1 && p->stride_w == 1 &&
+           p->padding_h == 0 && p->padding_w == 0;
+}
+
+/// Scratch bytes of the channel-blocked direct convolution weight
+static size_t conv2d_direct_scratch(const conv2d_params_t *p, size_t elem_size) {
+    const size_t oc_blocks = (p->out_channels + CONV2D_DIRECT_OCB - 1) / CONV2D_DIRECT_OCB;
+    return oc_blocks * p->in_channels * p->kernel_height * p->kernel_width * CONV2D_DIRECT_OCB *
+           elem_size;
+}
+
+/// Macro to implement one direct-convolution task for a kernel width and width stride
+///
+/// KW and SW of 0 read kernel_width and stride_w from the params. Constant values are the
+/// specializations picked by conv2d_direct_*: a unit width stride turns the OWB input columns
+/// into one contiguous vector load, and a constant 3 or 5 kernel width also unrolls the kw loop
+/// (those tasks assume dilation 1 along the width). Other strides gain nothing from constant
+/// bounds and run the generic task.
+///
+/// @param TYPE C type for the operation
+/// @param TYPE_SUFFIX Suffix for function naming
+/// @param OWB Output columns per register block
+/// @param NAME Task name suffix
+/// @param KW Kernel width, or 0 for any
+/// @param SW Width stride, or 0 for any
+#define CONV2D_DIRECT_TASK(TYPE, TYPE_SUFFIX, OWB, NAME, KW, SW)                                   \
+    /* Items are (batch, output-channel block, output row) */                                      \
+    static void conv2d_direct_##TYPE_SUFFIX##_task##NAME(size_t start, size_t end, void *ctx) {    \
+        const conv2d_direct_##TYPE_SUFFIX##_args_t *args =                                         \
+            (const conv2d_direct_##TYPE_SUFFIX##_args_t *)ctx;                                     \
+        const conv2d_params_t *p = args->p;                                                        \
+        const size_t ocb_n = CONV2D_DIRECT_OCB;                                                    \
+        const size_t kw_n = KW ? (size_t)KW : p->kernel_width;                                     \
+        const size_t sw = SW ? (size_t)SW : p->stride_w;                                           \
+        const size_t dw = KW ? 1 : p->dilation_w;                                                  \
+        const size_t kernel_size = p->kernel_height * kw_n;                                        \
+        const size_t in_plane = p->in_height * p->in_width;                                        \
+        const size_t out_plane = p->out_height * p->out_width;                                     \
+                                                                                                   \
+        /* Columns whose whole kernel row lies inside the input */                                 \
+        size_t ow_lo = (p->padding_w + sw - 1) / sw;                                               \
+        const long lim = (long)p->in_width - 1 + (long)p->padding_w - (long)((kw_n - 1) * dw);     \
+        size_t ow_hi = lim < 0 ? 0 : (size_t)lim / sw + 1;                                         \
+        ow_hi = ow_hi < p->out_width ? ow_hi : p->out_width;                                       \
+        ow_lo = ow_lo < ow_hi ? ow_lo : ow_hi;                                                     \
+                                                                                                   \
+        for (size_t item = start; item < end; item++) {                                            \
+            const size_t oh = item % p->out_height;                                                \
+            const size_t ocb = (item / p->out_height) % args->oc_blocks;                           \
+            const size_t b = item / (p->out_height * args->oc_blocks);                             \
+            const size_t oc0 = ocb * ocb_n;                                                        \
+            const size_t ocn = p->out_channels - oc0 < ocb_n ? p->out_channels - oc0 : ocb_n;      \
+                                                                                                   \
+            const TYPE *in_b = args->input + p->input_offset + b * p->in_channels * in_plane;      \
+            const TYPE *w_b = args->weight + ocb * p->in_channels * kernel_size * ocb_n;           \
+            TYPE *out =                                                                            \
+                args->output + (b * p->out_channels + oc0) * out_plane + oh * p->out_width;        \
+                                                                                                   \
+            /* Kernel rows that land inside the input for this output row */                       \
+            const long ih0 = (long)(oh * p->stride_h) - (long)p->padding_h;                        \
+            size_t kh_lo = 0;                                                                      \
+            while (kh_lo < p->kernel_height && ih0 + (long)(kh_lo * p->dilation_h) < 0) {          \
+                kh_lo++;                                                                           \
+            }                                                                                      \
+            size_t kh_hi = kh_lo;                                                                  \
+            while (kh_hi < p->kernel_height &&                                                     \
+                   ih0 + (long)(kh_hi * p->dilation_h) < (long)p->in_height) {                     \
+                kh_hi++;                                                                           \
+            }                                                                                      \
+                                                                                                   \
+            size_t ow = 0;                                                                         \
+            while (ow < p->out_width) {                                                            \
+                if (ow >= ow_lo && ow + OWB <= ow_hi) {                                            \
+                    TYPE acc[CONV2D_DIRECT_OCB][OWB] = {{0}};                                      \
+                    const long iw0 = (long)(ow * sw) - (long)p->padding_w;                         \
+                    for (size_t ic = 0; ic < p->in_channels; ic++) {                               \
+                        for (size_t kh = kh_lo; kh < kh_hi; kh++) {                                \
+                            const TYPE *row = in_b + ic * in_plane +                               \
+                                              (size_t)(ih0 + (long)(kh * p->dilation_h)) *         \
+                                                  p->in_width;                                     \
+                            const TYPE *wk = w_b + (ic * kernel_size + kh * kw_n) * ocb_n;         \
+                            for (size_t kw = 0; kw < kw_n; kw++) {                                 \
+                                const TYPE *src = row + iw0 + (long)(kw * dw);                     \
+                                const TYPE *wv = wk + kw * ocb_n;                                  \
+                                TYPE x[OWB];                                                       \
+                                for (size_t w = 0; w < OWB; w++) {                                 \
+                                    x[w] = src[w * sw];                                            \
+                                }                                                                  \
+                                for (size_t o = 0; o < CONV2D_DIRECT_OCB; o++) {                   \
+                                    for (size_t w = 0; w < OWB; w++) {                             \
+                                        acc[o][w] += wv[o] * x[w];                                 \
+                                    }                                                              \
+                                }                                                                  \
+                            }                                                                      \
+                        }                                                                          \
+                    }                                                                              \
+                    for (size_t o = 0; o < ocn; o++) {                                             \
+                        memcpy(out + o * out_plane + ow, acc[o], OWB * sizeof(TYPE));              \
+                    }                                                                              \
+                    ow += OWB;                                                                     \
+                } else {                                                                           \
+                    /* Border or tail column: bounds-checked along the width */                    \
+                    TYPE acc[CONV2D_DIRECT_OCB] = {0};                                             \
+                    const long iw0 = (long)(ow * sw) - (long)p->padding_w;                         \
+                    for (size_t ic = 0; ic < p->in_channels; ic++) {                               \
+                        for (size_t kh = kh_lo; kh < kh_hi; kh++) {                                \
+                            const TYPE *row = in_b + ic * in_plane +                               \
+                                              (size_t)(ih0 + (long)(kh * p->dilation_h)) *         \
+                                                  p->in_width;                                     \
+                            const TYPE *wk = w_b + (ic * kernel_size + kh * kw_n) * ocb_n;         \
+                            for (size_t kw = 0; kw < kw_n; kw++) {                                 \
+                                const long iw = iw0 + (long)(kw * dw);                             \
+                                if (iw < 0 || iw >= (long)p->in_width) {                           \
+                                    continue;                                                      \
+                                }                                                                  \
+                                const TYPE x = row[iw];                                            \
+                                for (size_t o = 0; o < CONV2D_DIRECT_OCB; o++) {                   \
+                                    acc[o] += wk[kw * ocb_n + o] * x;                              \
+                                }                                                                  \
                             }                                                                      \
                         }                                                                          \
                     }                                                                              \
+                    for (size_t o = 0; o < ocn; o++) {                                             \
+                        out[o * out_plane + ow] = acc[o];                                          \
+                    }                                                                              \
+                    ow++;                                                                          \
                 }                                                                                  \
             }                                                                                      \
-            output[idx] = sum;                                                                     \
         }                                                                                          \
     }
 
-/// Macro to implement 3D convolution operation for exotic types
+/// Macro to implement the native conv2d engines and hodu_cpu_conv2d_* dispatch
 ///
 /// @param TYPE C type for the operation
 /// @param TYPE_SUFFIX Suffix for function naming
-/// @param ZERO Zero constant
-/// @param ADD_FN Addition function
-/// @param MUL_FN Multiplication function
-#define CONV3D_OP_EXOTIC(TYPE, TYPE_SUFFIX, ZERO, ADD_FN, MUL_FN)                                  \
-    void hodu_cpu_conv3d_##TYPE_SUFFIX(const void *input_ptr, const void *weight_ptr,              \
+/// @param OWB Output columns per direct-convolution register block
+#define CONV2D_NATIVE_OP(TYPE, TYPE_SUFFIX, OWB)                                                   \
+    typedef struct {                                                                               \
+        const TYPE *input;                                                                         \
+        const TYPE *weight; /* [oc / OCB][ic][kh][kw][OCB], zero padded */                         \
+        TYPE *output;                                                                              \
+        const conv2d_params_t *p;                                                                  \
+        size_t oc_blocks;                                                                          \
+    } conv2d_direct_##TYPE_SUFFIX##_args_t;                                                        \
+                                                                                                   \
+    CONV2D_DIRECT_TASK(TYPE, TYPE_SUFFIX, OWB, , 0, 0)                                             \
+    CONV2D_DIRECT_TASK(TYPE, TYPE_SUFFIX, OWB, _s1, 0, 1)                                          \
+    CONV2D_DIRECT_TASK(TYPE, TYPE_SUFFIX, OWB, _k3s1, 3, 1)                                        \
+    CONV2D_DIRECT_TASK(TYPE, TYPE_SUFFIX, OWB, _k5s1, 5, 1)                                        \
+                                                                                                   \
+    static void conv2d_direct_##TYPE_SUFFIX(const TYPE *input, const TYPE *weight, TYPE *output,   \
+                                            const conv2d_params_t *p) {                            \
+        const size_t ocb_n = CONV2D_DIRECT_OCB;                                                    \
+        const size_t oc_blocks = (p->out_channels + ocb_n - 1) / ocb_n;                            \
+        const size_t kernel_size = p->kernel_height * p->kernel_width;                             \
+                                                                                                   \
+        TYPE *packed = (TYPE *)workspace_acquire(conv2d_direct_scratch(p, sizeof(TYPE)));          \
+        if (!packed) {                                                                             \
+            return;                                                                                \
+        }                                                                                          \
+        const TYPE *w = weight + p->weight_offset;                                                 \
+        for (size_t ocb = 0; ocb < oc_blocks; ocb++) {                                             \
+            for (size_t ick = 0; ick < p->in_channels * kernel_size; ick++) {                      \
+                TYPE *dst = packed + (ocb * p->in_channels * kernel_size + ick) * ocb_n;           \
+                for (size_t o = 0; o < ocb_n; o++) {                                               \
+                    const size_t oc = ocb * ocb_n + o;                                             \
+                    dst[o] = oc < p->out_channels                                                  \
+                                 ? w[oc * p->in_channels * kernel_size + ick]                      \
+                                 : (TYPE)0;                                                        \
+                }                                                                                  \
+            }                                                                                      \
+        }                                                                                          \
+                                                                                                   \
+        conv2d_direct_##TYPE_SUFFIX##_args_t args = {input, packed, output, p, oc_blocks};         \
+        const size_t items = p->batch * oc_blocks * p->out_height;                                 \
+        const size_t item_work = ocb_n * p->out_width * p->in_channels * kernel_size;              \
+        size_t grain = CONV2D_DIRECT_GRAIN_WORK / (item_work ? item_work : 1);                     \
+        grain = grain ? grain : 1;                                                                 \
+        void (*task)(size_t, size_t, void *) = conv2d_direct_##TYPE_SUFFIX##_task;                 \
+        if (p->stride_w == 1) {                                                                    \
+            task = conv2d_direct_##TYPE_SUFFIX##_task_s1;                                          \
+            if (p->dilation_w == 1 && p->kernel_width == 3) {                                      \
+                task = conv2d_direct_##TYPE_SUFFIX##_task_k3s1;                                    \
+            } else if (p->dilation_w == 1 && p->kernel_width == 5) {                               \
+                task = conv2d_direct_##TYPE_SUFFIX##_task_k5s1;                                    \
+            }                                                                                      \
+        }                                                                                          \
+        parallel_for(0, items, grain, task, &args);                                                \
+                                                                                                   \
+        workspace_release(packed);                                                                 \
+    }                                                                                              \
+                                                                                                   \
+    typedef struct {                                                                               \
+        const conv2d_winograd_t *w;                                                                \
+        const conv2d_params_t *p;                                                                  \
+        const TYPE *input;                                                                         \
+        const TYPE *weight;                                                                        \
+        TYPE *output;                                                                              \
+        TYPE *u;       /* [alpha^2][oc][ic] transformed weight */                                  \
+        TYPE *v;       /* [alpha^2][ic][tiles] transformed input of the chunk */                   \
+        TYPE *m;       /* [alpha^2][oc][tiles] transformed products of the chunk */                \
+        size_t tile0;  /* first tile of the chunk (over batch * tiles_h * tiles_w) */              \
+        size_t tiles;  /* tiles in the chunk */                                                    \
+        size_t tiles_w;                                                                            \
+        size_t tiles_per_image;                                                                    \
+    } conv2d_winograd_##TYPE_SUFFIX##_args_t;                                                      \
+                                                                                                   \
+    /* Items are (oc, ic): U = G g G^T */                                                          \
+    static void conv2d_winograd_##TYPE_SUFFIX##_weight_task(size_t start, size_t end,              \
+                                                             void *ctx) {                          \
+        const conv2d_winograd_##TYPE_SUFFIX##_args_t *a =                                          \
+            (const conv2d_winograd_##TYPE_SUFFIX##_args_t *)ctx;                                   \
+        const size_t alpha = a->w->alpha;                                                          \
+        const size_t stride = a->p->out_channels * a->p->in_channels;                              \
+        for (size_t item = start; item < end; item++) {                                            \
+            const TYPE *g = a->weight + a->p->weight_offset + item * 9;                            \
+            double t[6][3];                                                                        \
+            for (size_t i = 0; i < alpha; i++) {                                                   \
+                for (size_t j = 0; j < 3; j++) {                                                   \
+                    t[i][j] = a->w->g[i * 3] * g[j] + a->w->g[i * 3 + 1] * g[3 + j] +              \
+                              a->w->g[i * 3 + 2] * g[6 + j];                                       \
+                }                                                                                  \
+            }                                                                                      \
+            for (size_t i = 0; i < alpha; i++) {                                                   \
+                for (size_t j = 0; j < alpha; j++) {                                               \
+                    const double u = t[i][0] * a->w->g[j * 3] + t[i][1] * a->w->g[j * 3 + 1] +     \
+                                     t[i][2] * a->w->g[j * 3 + 2];                                 \
+                    a->u[(i * alpha + j) * stride + item] = (TYPE)u;                               \
+                }                                                                                  \
+            }                                                                                      \
+        }                                                                                          \
+    }                                                                                              \
+                                                                                                   \
+    /* Items are (ic, tile): V = B^T d B */                                                        \
+    static void conv2d_winograd_##TYPE_SUFFIX##_input_task(size_t start, size_t end, void *ctx) {  \
+        const conv2d_winograd_##TYPE_SUFFIX##_args_t *a =                                          \
+            (const conv2d_winograd_##TYPE_SUFFIX##_args_t *)ctx;                                   \
+        const conv2d_params_t *p = a->p;                                                           \
+        const size_t alpha = a->w->alpha;                                                          \
+        const size_t m = a->w->m;                                                                  \
+        TYPE bt[36];                                                                               \
+        for (size_t i = 0; i < alpha * alpha; i++) {                                               \
+            bt[i] = (TYPE)a->w->bt[i];                                                             \
+        }                                                                                          \
+        for (size_t item = start; item < end; item++) {                                            \
+            const size_t ic = item / a->tiles;                                                     \
+            const size_t t = item % a->tiles;                                                      \
+            const size_t tile = a->tile0 + t;                                                      \
+            const size_t b = tile / a->tiles_per_image;                                            \
+            const size_t ty = (tile % a->tiles_per_image) / a->tiles_w;                            \
+            const size_t tx = tile % a->tiles_w;                                                   \
+            const long ih0 = (long)(ty * m) - (long)p->padding_h;                                  \
+            const long iw0 = (long)(tx * m) - (long)p->padding_w;                                  \
+            const TYPE *plane = a->input + p->input_offset +                                       \
+                                (b * p->in_channels + ic) * p->in_height * p->in_width;            \
+                                                                                                   \
+            TYPE d[6][6];                                                                          \
+            for (size_t i = 0; i < alpha; i++) {                                                   \
+                const long ih = ih0 + (long)i;                                                     \
+                for (size_t j = 0; j < alpha; j++) {                                               \
+                    const long iw = iw0 + (long)j;                                                 \
+                    d[i][j] = (ih >= 0 && ih < (long)p->in_height && iw >= 0 &&                    \
+                               iw < (long)p->in_width)                                             \
+                                  ? plane[ih * (long)p->in_width + iw]                             \
+                                  : (TYPE)0;                                                       \
+                }                                                                                  \
+            }                                                                                      \
+            TYPE t1[6][6];                                                                         \
+            for (size_t i = 0; i < alpha; i++) {                                                   \
+                for (size_t j = 0; j < alpha; j++) {                                               \
+                    TYPE s = 0;                                                                    \
+                    for (size_t k = 0; k < alpha; k++) {                                           \
+                        s += bt[i * alpha + k] * d[k][j];                                          \
+                    }                                                                              \
+                    t1[i][j] = s;                                                                  \
+                }                                                                                  \
+            }                                                                                      \
+            TYPE *v = a->v + ic * a->tiles + t;                                                    \
+            const size_t stride = p->in_channels * a->tiles;                                       \
+            for (size_t i = 0; i < alpha; i++) {                                                   \
+                for (size_t j = 0; j < alpha; j++) {                                               \
+                    TYPE s = 0;                                                                    \
+                    for (size_t k = 0; k < alpha; k++) {                                           \
+                        s += t1[i][k] * bt[j * alpha + k];                                         \
+                    }                                                                              \
+                    v[(i * alpha + j) * stride] = s;                                               \
+                }                                                                                  \
+            }                                                                                      \
+        }                                                                                          \
+    }                                                                                              \
+                                                                                                   \
+    /* Items are transform coordinates: M[xi] = U[xi] @ V[xi] */                                   \
+    static void conv2d_winograd_##TYPE_SUFFIX##_gemm_task(size_t start, size_t end, void *ctx) {   \
+        const conv2d_winograd_##TYPE_SUFFIX##_args_t *a =                                          \
+            (const conv2d_winograd_##TYPE_SUFFIX##_args_t *)ctx;                                   \
+        const size_t oc = a->p->out_channels;                                                      \
+        const size_t ic = a->p->in_channels;                                                       \
+        for (size_t xi = start; xi < end; xi++) {                                                  \
+            hodu_cpu_gemm_##TYPE_SUFFIX(oc, a->tiles, ic, a->u + xi * oc * ic, ic, 1,              \
+                                        a->v + xi * ic * a->tiles, a->tiles, 1,                    \
+                                        a->m + xi * oc * a->tiles, a->tiles);                      \
+        }                                                                                          \
+    }                                                                                              \
+                                                                                                   \
+    /* Items are (oc, tile): Y = A^T M A, clipped to the output */                                 \
+    static void conv2d_winograd_##TYPE_SUFFIX##_output_task(size_t start, size_t end,              \
+                                                             void *ctx) {                          \
+        const conv2d_winograd_##TYPE_SUFFIX##_args_t *a =                                          \
+            (const conv2d_winograd_##TYPE_SUFFIX##_args_t *)ctx;                                   \
+        const conv2d_params_t *p = a->p;                                                           \
+        const size_t alpha = a->w->alpha;                                                          \
+        const size_t m = a->w->m;                                                                  \
+        TYPE at[24];                                                                               \
+        for (size_t i = 0; i < m * alpha; i++) {                                                   \
+            at[i] = (TYPE)a->w->at[i];                                                             \
+        }                                                                                          \
+        const size_t stride = p->out_channels * a->tiles;                                          \
+        for (size_t item = start; item < end; item++) {                                            \
+            const size_t oc = item / a->tiles;                                                     \
+            const size_t t = item % a->tiles;                                                      \
+            const size_t tile = a->tile0 + t;                                                      \
+            const size_t b = tile / a->tiles_per_image;                                            \
+            const size_t oy0 = (tile % a->tiles_per_image) / a->tiles_w * m;                       \
+            const size_t ox0 = tile % a->tiles_w * m;                                              \
+                                                                                                   \
+            const TYPE *src = a->m + oc * a->tiles + t;                                            \
+            TYPE t1[4][6];                                                                         \
+            for (size_t i = 0; i < m; i++) {                                                       \
+                for (size_t j = 0; j < alpha; j++) {                                               \
+                    TYPE s = 0;                                                                    \
+                    for (size_t k = 0; k < alpha; k++) {                                           \
+                        s += at[i * alpha + k] * src[(k * alpha + j) * stride];                    \
+                    }                                                                              \
+                    t1[i][j] = s;                                                                  \
+                }                                                                                  \
+            }                                                                                      \
+            TYPE *out = a->output + (b * p->out_channels + oc) * p->out_height * p->out_width;     \
+            for (size_t i = 0; i < m && oy0 + i < p->out_height; i++) {                            \
+                for (size_t j = 0; j < m && ox0 + j < p->out_width; j++) {                         \
+                    TYPE s = 0;                                                                    \
+                    for (size_t k = 0; k < alpha; k++) {                                           \
+                        s += t1[i][k] * at[j * alpha + k];                                         \
+                    }                                                                              \
+                    out[(oy0 + i) * p->out_width + ox0 + j] = s;                                   \
+                }                                                                                  \
+            }                                                                                      \
+        }                                                                                          \
+    }                                                                                              \
+                                                                                                   \
+    static void conv2d_winograd_##TYPE_SUFFIX(const TYPE *input, const TYPE *weight,               \
+                                              TYPE *output, const conv2d_params_t *p,              \
+                                              const conv2d_winograd_t *w) {                        \
+        const size_t alpha2 = w->alpha * w->alpha;                                                 \
+        const size_t tiles_h = (p->out_height + w->m - 1) / w->m;                                  \
+        const size_t tiles_w = (p->out_width + w->m - 1) / w->m;                                   \
+        const size_t total_tiles = p->batch * tiles_h * tiles_w;                                   \
+        const size_t chunk = conv2d_winograd_chunk(p, w);                                          \
+                                                                                                   \
+        /* U, V and M are carved from one scratch block */                                         \
+        const size_t u_bytes = hodu_cpu_workspace_block_size(alpha2 * p->out_channels *            \
+                                                             p->in_channels * sizeof(TYPE));       \
+        const size_t v_bytes =                                                                     \
+            hodu_cpu_workspace_block_size(alpha2 * p->in_channels * chunk * sizeof(TYPE));         \
+        TYPE *u = (TYPE *)workspace_acquire(conv2d_winograd_scratch(p, w, sizeof(TYPE)));          \
+        if (!u) {                                                                                  \
+            return;                                                                                \
+        }                                                                                          \
+        TYPE *v = (TYPE *)((char *)u + u_bytes);                                                   \
+        TYPE *m = (TYPE *)((char *)v + v_bytes);                                                   \
+                                                                                                   \
+        conv2d_winograd_##TYPE_SUFFIX##_args_t args = {                                            \
+            w, p, input, weight, output, u, v, m, 0, 0, tiles_w, tiles_h * tiles_w};               \
+        parallel_for(0, p->out_channels * p->in_channels, 64,                                      \
+                     conv2d_winograd_##TYPE_SUFFIX##_weight_task, &args);                          \
+                                                                                                   \
+        /* Few large GEMMs parallelize internally; otherwise one GEMM per task */                  \
+        const bool gemm_per_task = get_num_threads() <= alpha2;                                    \
+        for (size_t tile0 = 0; tile0 < total_tiles; tile0 += chunk) {                              \
+            args.tile0 = tile0;                                                                    \
+            args.tiles = total_tiles - tile0 < chunk ? total_tiles - tile0 : chunk;                \
+            parallel_for(0, p->in_channels * args.tiles, 256,                                      \
+                         conv2d_winograd_##TYPE_SUFFIX##_input_task, &args);                       \
+            if (gemm_per_task) {                                                                   \
+                parallel_for(0, alpha2, 1, conv2d_winograd_##TYPE_SUFFIX##_gemm_task, &args);      \
+            } else {                                                                               \
+                conv2d_winograd_##TYPE_SUFFIX##_gemm_task(0, alpha2, &args);                       \
+            }                                                                                      \
+            parallel_for(0, p->out_channels * args.tiles, 256,                                     \
+                         conv2d_winograd_##TYPE_SUFFIX##_output_task, &args);                      \
+        }                                                                                          \
+                                                                                                   \
+        workspace_release(u);                                                                      \
+    }                                                                                              \
+                                                                                                   \
+    void hodu_cpu_conv2d_##TYPE_SUFFIX(const void *input_ptr, const void *weight_ptr,              \
                                        void *output_ptr, const size_t *metadata) {                 \
+        HODU_PROFILE_KERNEL(hodu_cpu_profile_conv_bytes(metadata, 2, sizeof(TYPE)));               \
         const TYPE *input = (const TYPE *)input_ptr;                                               \
         const TYPE *weight = (const TYPE *)weight_ptr;                                             \
         TYPE *output = (TYPE *)output_ptr;                                                         \
                                                                                                    \
-        const size_t num_els = metadata[0];                                                        \
-        const size_t batch = metadata[1];                                                          \
-        const size_t in_channels = metadata[2];                                                    \
-        const size_t out_channels = metadata[3];                                                   \
-        const size_t in_depth = metadata[4];                                                       \
-        const size_t in_height = metadata[5];                                                      \
-        const size_t in_width = metadata[6];                                                       \
-        const size_t kernel_depth = metadata[7];                                                   \
-        const size_t kernel_height = metadata[8];                                                  \
+        conv2d_params_t p;                                                                         \
+        conv2d_parse_params(metadata, &p);                                                         \
+        if (p.batch * p.out_channels * p.out_height * p.out_width == 0) {                          \
+            return;                                                                                \
+        }                                                                                          \
+                                                                                                   \
+        if (conv2d_is_pointwise(&p)) {                                                             \
+            conv2d_gemm_##TYPE_SUFFIX(input, weight, NULL, output, metadata, NULL);                \
+            return;                                                                                \
+        }                                                                                          \
+        const conv2d_winograd_t *w = conv2d_winograd_select(&p);                                   \
+        if (w) {                                                                                   \
+            conv2d_winograd_##TYPE_SUFFIX(input, weight, output, &p, w);                           \
+        } else {                                                                                   \
+            conv2d_direct_##TYPE_SUFFIX(input, weight, output, &p);                                \
+        }                                                                                          \
+    }
+
+CONV2D_NATIVE_OP(f32_t, f32, 16)
+CONV2D_NATIVE_OP(f64_t, f64, 8)
+
+#endif // USE_BLAS
+
+// Scratch bytes of one hodu_cpu_conv2d_* / conv2d_fused_* / conv2d_packed_* call
+static size_t conv2d_workspace_size(const size_t *metadata, size_t elem_size) {
+    const size_t K = metadata[2] * metadata[6] * metadata[7];
+    const size_t N = metadata[8] * metadata[9];
+    const size_t im2col = K * N * elem_size;
+#ifdef USE_BLAS
+    const size_t engine = im2col;
+#else
+    conv2d_params_t p;
+    conv2d_parse_params(metadata, &p);
+    const conv2d_winograd_t *w = conv2d_winograd_select(&p);
+    const size_t engine = conv2d_is_pointwise(&p) ? 0
+                          : w                     ? conv2d_winograd_scratch(&p, w, elem_size)
+                                                  : conv2d_direct_scratch(&p, elem_size);
+#endif
+    const size_t bytes = engine > im2col ? engine : im2col;
+    return hodu_cpu_workspace_block_size(bytes) + HODU_CPU_WORKSPACE_ALIGN;
+}
+
+size_t hodu_cpu_conv2d_workspace_size_f32(const size_t *metadata) {
+    return conv2d_workspace_size(metadata, sizeof(f32_t));
+}
+
+size_t hodu_cpu_conv2d_workspace_size_f64(const size_t *metadata) {
+    return conv2d_workspace_size(metadata, sizeof(f64_t));
+}
+
+// ============================================================================
+// CHANNELS-LAST (NHWC) 2D CONVOLUTION
+// ============================================================================
+//
+// hodu_cpu_conv2d_nhwc_* take the conv2d metadata with channels-last operands:
+// - input:  [batch, in_height, in_width, in_channels]
+// - weight: [out_channels, kernel_height, kernel_width, in_channels] (OHWI)
+// - output: [batch, out_height, out_width, out_channels]
+//
+// Every output pixel is one GEMM row, output[P, oc] = patch[P, K] @ weight^T with
+// K = kh * kw * in_channels. A patch row is kh * kw contiguous runs of in_channels
+// input values, so it is gathered with memcpy and the GEMM vectorizes over channels
+// on both sides; a 1x1 stride-1 unpadded kernel multiplies the input directly.
+// Other kernels gather tiles of patch rows (about CONV2D_NHWC_TILE_BYTES each) per
+// pool task and multiply each tile on the owning thread. All types run on the
+// native GEMM (low-precision types accumulate in f32).
+
+// Target bytes of one tile of patch rows
+#define CONV2D_NHWC_TILE_BYTES (256 * 1024)
+
+// Minimum patch rows per tile
+#define CONV2D_NHWC_MIN_ROWS 16
+
+typedef struct {
+    const void *input;  // input + input_offset
+    const void *weight; // weight + weight_offset
+    void *output;
+    const size_t *metadata;
+    size_t rows;  // output pixels
+    size_t tile;  // patch rows per tile
+    size_t patch; // K
+} conv2d_nhwc_args_t;
+
+// Patch rows per tile so that tiles stay cache-sized and every thread gets one
+static size_t conv2d_nhwc_tile_rows(size_t rows, size_t K, size_t elem) {
+    size_t tile = CONV2D_NHWC_TILE_BYTES / (K * elem + 1);
+    const size_t threads = get_num_threads();
+    const size_t per_thread = (rows + threads - 1) / threads;
+    if (tile > per_thread) {
+        tile = per_thread;
+    }
+    if (tile < CONV2D_NHWC_MIN_ROWS) {
+        tile = CONV2D_NHWC_MIN_ROWS;
+    }
+    return tile < rows ? tile : rows;
+}
+
+// Gather patch rows [p0, p0 + count) of an NHWC input into patch ([count, K], row-major)
+static void conv2d_nhwc_im2row(const char *input, char *patch, const size_t *metadata, size_t p0,
+                               size_t count, size_t elem) {
+    const size_t in_channels = metadata[2];
+    const size_t in_height = metadata[4];
+    const size_t in_width = metadata[5];
+    const size_t kernel_height = metadata[6];
+    const size_t kernel_width = metadata[7];
+    const size_t out_height = metadata[8];
+    const size_t out_width = metadata[9];
+    const size_t run = in_channels * elem;
+
+    for (size_t p = p0; p < p0 + count; p++) {
+        const size_t ow = p % out_width;
+        const size_t oh = (p / out_width) % out_height;
+        const size_t b = p / (out_width * out_height);
+        const long ih0 = (long)(oh * metadata[10]) - (long)metadata[12];
+        const long iw0 = (long)(ow * metadata[11]) - (long)metadata[13];
+        for (size_t kh = 0; kh < kernel_height; kh++) {
+            const long ih = ih0 + (long)(kh * metadata[14]);
+            if (ih < 0 || ih >= (long)in_height) {
+                memset(patch, 0, kernel_width * run);
+                patch += kernel_width * run;
+                continue;
+            }
+            const char *row = input + (b * in_height + (size_t)ih) * in_width * run;
+            for (size_t kw = 0; kw < kernel_width; kw++, patch += run) {
+                const long iw = iw0 + (long)(kw * metadata[15]);
+                if (iw < 0 || iw >= (long)in_width) {
+                    memset(patch, 0, run);
+                } else {
+                    memcpy(patch, row + (size_t)iw * run, run);
+                }
+            }
+        }
+    }
+}
+
+/// Macro to implement channels-last 2D convolution
+///
+/// @param TYPE C type for the operation
+/// @param TYPE_SUFFIX Suffix for function naming (selects hodu_cpu_gemm_<TYPE_SUFFIX>)
+#define CONV2D_NHWC_OP(TYPE, TYPE_SUFFIX)                                                          \
+    static void conv2d_nhwc_task_##TYPE_SUFFIX(size_t start, size_t end, void *ctx) {              \
+        const conv2d_nhwc_args_t *a = (const conv2d_nhwc_args_t *)ctx;                             \
+        const size_t out_channels = a->metadata[3];                                                \
+        TYPE *patch = (TYPE *)workspace_acquire(a->tile * a->patch * sizeof(TYPE));                \
+        if (!patch) {                                                                              \
+            return;                                                                                \
+        }                                                                                          \
+        for (size_t t = start; t < end; t++) {                                                     \
+            const size_t p0 = t * a->tile;                                                         \
+            const size_t count = a->rows - p0 < a->tile ? a->rows - p0 : a->tile;                  \
+            conv2d_nhwc_im2row((const char *)a->input, (char *)patch, a->metadata, p0, count,      \
+                               sizeof(TYPE));                                                      \
+            hodu_cpu_gemm_##TYPE_SUFFIX(count, out_channels, a->patch, patch, a->patch, 1,         \
+                                        (const TYPE *)a->weight, 1, a->patch,                      \
+                                        (TYPE *)a->output + p0 * out_channels, out_channels);      \
+        }                                                                                          \
+        workspace_release(patch);                                                                  \
+    }                                                                                              \
+                                                                                                   \
+    void hodu_cpu_conv2d_nhwc_##TYPE_SUFFIX(const void *input_ptr, const void *weight_ptr,         \
+                                            void *output_ptr, const size_t *metadata) {            \
+        HODU_PROFILE_KERNEL(hodu_cpu_profile_conv_bytes(metadata, 2, sizeof(TYPE)));               \
+        const TYPE *input = (const TYPE *)input_ptr + metadata[16];                                \
+        const TYPE *weight = (const TYPE *)weight_ptr + metadata[17];                              \
+        TYPE *output = (TYPE *)output_ptr;                                                         \
+        const size_t in_channels = metadata[2];                                                    \
+        const size_t out_channels = metadata[3];                                                   \
+        const size_t rows = metadata[1] * metadata[8] * metadata[9];                               \
+        const size_t K = in_channels * metadata[6] * metadata[7];                                  \
+        if (rows == 0 || out_channels == 0) {                                                      \
+            return;                                                                                \
+        }                                                                                          \
+                                                                                                   \
+        /* 1x1 stride-1 unpadded: input pixels are the patch rows */                               \
+        if (metadata[6] == 1 && metadata[7] == 1 && metadata[10] == 1 && metadata[11] == 1 &&      \
+            metadata[12] == 0 && metadata[13] == 0) {                                              \
+            hodu_cpu_gemm_##TYPE_SUFFIX(rows, out_channels, K, input, in_channels, 1, weight, 1,   \
+                                        K, output, out_channels);                                  \
+            return;                                                                                \
+        }                                                                                          \
+                                                                                                   \
+        conv2d_nhwc_args_t args;                                                                   \
+        args.input = input;                                                                        \
+        args.weight = weight;                                                                      \
+        args.output = output;                                                                      \
+        args.metadata = metadata;                                                                  \
+        args.rows = rows;                                                                          \
+        args.patch = K;                                                                            \
+        args.tile = conv2d_nhwc_tile_rows(rows, K, sizeof(TYPE));                                  \
+        /* A single tile runs inline on the caller, so its GEMM still uses the pool */             \
+        parallel_for(0, (rows + args.tile - 1) / args.tile, 1, conv2d_nhwc_task_##TYPE_SUFFIX,     \
+                     &args);                                                                       \
+    }
+
+CONV2D_NHWC_OP(f8e4m3_t, f8e4m3)
+CONV2D_NHWC_OP(f8e5m2_t, f8e5m2)
+CONV2D_NHWC_OP(bf16_t, bf16)
+CONV2D_NHWC_OP(f16_t, f16)
+CONV2D_NHWC_OP(f32_t, f32)
+CONV2D_NHWC_OP(f64_t, f64)
+
+// ============================================================================
+// GROUPED AND DEPTHWISE 2D CONVOLUTION
+// ============================================================================
+//
+// hodu_cpu_conv2d_grouped_* take the conv2d metadata plus metadata[18] = groups.
+// Input channels are split into groups blocks of in_channels / groups, each
+// convolved with its own out_channels / groups filters of the
+// [out_channels, in_channels / groups, kh, kw] weight:
+// - groups == 1: hodu_cpu_conv2d_*
+// - groups == in_channels (depthwise, any channel multiplier): one item per
+//   (batch, channel) plane. The plane is copied to scratch memory zero-padded and
+//   split into stride_w column phases, so every kernel tap reads one contiguous
+//   run of a staged row; output rows are then SIMD FMAs over the width with the
+//   tap weight broadcast.
+// - otherwise: one GEMM per (batch, group) on that group's weight rows and
+//   im2col columns. There are enough of them to split over the pool when
+//   batch * groups >= threads; fewer run one after another with pooled GEMMs.
+// Both skip the zero blocks a dense conv2d with an expanded weight multiplies.
+// Invalid groups (0, or not dividing both channel counts) leave the output
+// untouched. Like conv2d_fused, they always use the native GEMM.
+
+// Output columns per depthwise register tile, in vectors
+#define CONV2D_DEPTHWISE_NV 4
+
+// Zeroed elements after the staged phases, so the last row tile may load whole
+// vectors (at least one vector of any ISA)
+#define CONV2D_DEPTHWISE_SLACK 64
+
+typedef struct {
+    const void *input;
+    const void *weight;
+    void *output;
+    const size_t *metadata;
+    size_t mult;       // output channels per input channel
+    size_t rows;       // staged rows: (oh - 1) * stride_h + (kh - 1) * dilation_h + 1
+    size_t cols;       // padded columns read: (ow - 1) * stride_w + (kw - 1) * dilation_w + 1
+    size_t phase_cols; // columns of one stride phase: ceil(cols / stride_w)
+} conv2d_depthwise_args_t;
+
+/// Stage a (batch, channel) plane: phase ph, row r, column j holds the padded
+/// input at (r, j * stride_w + ph)
+#define CONV2D_DEPTHWISE_STAGE(TYPE, TYPE_SUFFIX)                                                  \
+    static void conv2d_depthwise_stage_##TYPE_SUFFIX(const conv2d_depthwise_args_t *a,             \
+                                                     const TYPE *src, TYPE *staged) {              \
+        const size_t *md = a->metadata;                                                            \
+        const long in_height = (long)md[4], in_width = (long)md[5];                                \
+        const size_t sw = md[11], wq = a->phase_cols;                                              \
+        for (size_t ph = 0; ph < sw; ph++) {                                                       \
+            /* Columns j in [lo, hi) map to input columns first + j * sw */                        \
+            const long first = (long)ph - (long)md[13];                                            \
+            size_t lo = first >= 0 ? 0 : (size_t)((-first + (long)sw - 1) / (long)sw);             \
+            size_t hi = first >= in_width                                                          \
+                            ? 0                                                                    \
+                            : (size_t)((in_width - first + (long)sw - 1) / (long)sw);              \
+            hi = hi < wq ? hi : wq;                                                                \
+            lo = lo < hi ? lo : hi;                                                                \
+            for (size_t r = 0; r < a->rows; r++) {                                                 \
+                TYPE *dst = staged + (ph * a->rows + r) * wq;                                      \
+                const long ih = (long)r - (long)md[12];                                            \
+                if (ih < 0 || ih >= in_height) {                                                   \
+                    memset(dst, 0, wq * sizeof(TYPE));                                             \
+                    continue;                                                                      \
+                }                                                                                  \
+                const TYPE *row = src + ih * in_width;                                             \
+                memset(dst, 0, lo * sizeof(TYPE));                                                 \
+                if (sw == 1) {                                                                     \
+                    memcpy(dst + lo, row + first + (long)lo, (hi - lo) * sizeof(TYPE));            \
+                } else {                                                                           \
+                    for (size_t j = lo; j < hi; j++) {                                             \
+                        dst[j] = row[first + (long)(j * sw)];                                      \
+                    }                                                                              \
+                }                                                                                  \
+                memset(dst + hi, 0, (wq - hi) * sizeof(TYPE));                                     \
+            }                                                                                      \
+        }                                                                                          \
+    }
+
+/// One output row: out[ow] = sum over taps t of w[t] * base[off[t] + ow]
+#define CONV2D_DEPTHWISE_ROW_SIMD(TYPE, TYPE_SUFFIX, W)                                            \
+    static void conv2d_depthwise_row_##TYPE_SUFFIX(const TYPE *base, const size_t *off,            \
+                                                   const TYPE *w, size_t taps, TYPE *out,          \
+                                                   size_t out_width) {                             \
+        HODU_PROFILE_PATH(HODU_CPU_PATH_SIMD);                                                     \
+        size_t ow = 0;                                                                             \
+        for (; ow + CONV2D_DEPTHWISE_NV * W <= out_width; ow += CONV2D_DEPTHWISE_NV * W) {         \
+            simd_##TYPE_SUFFIX##_t acc[CONV2D_DEPTHWISE_NV];                                       \
+            for (int u = 0; u < CONV2D_DEPTHWISE_NV; u++)                                          \
+                acc[u] = simd_##TYPE_SUFFIX##_set1(0);                                             \
+            for (size_t t = 0; t < taps; t++) {                                                    \
+                const simd_##TYPE_SUFFIX##_t wv = simd_##TYPE_SUFFIX##_set1(w[t]);                 \
+                const TYPE *x = base + off[t] + ow;                                                \
+                for (int u = 0; u < CONV2D_DEPTHWISE_NV; u++)                                      \
+                    acc[u] = simd_##TYPE_SUFFIX##_fmadd(wv, simd_##TYPE_SUFFIX##_load(x + u * W),  \
+                                                        acc[u]);                                   \
+            }                                                                                      \
+            for (int u = 0; u < CONV2D_DEPTHWISE_NV; u++)                                          \
+                simd_##TYPE_SUFFIX##_store(out + ow + u * W, acc[u]);                              \
+        }                                                                                          \
+        if (ow < out_width) {                                                                      \
+            /* Whole vectors past the row end read the next row or the staging slack */            \
+            const size_t rem = out_width - ow, nv = (rem + W - 1) / W;                             \
+            simd_##TYPE_SUFFIX##_t acc[CONV2D_DEPTHWISE_NV];                                       \
+            for (int u = 0; u < CONV2D_DEPTHWISE_NV; u++)                                          \
+                acc[u] = simd_##TYPE_SUFFIX##_set1(0);                                             \
+            for (size_t t = 0; t < taps; t++) {                                                    \
+                const simd_##TYPE_SUFFIX##_t wv = simd_##TYPE_SUFFIX##_set1(w[t]);                 \
+                const TYPE *x = base + off[t] + ow;                                                \
+                for (size_t u = 0; u < nv; u++)                                                    \
+                    acc[u] = simd_##TYPE_SUFFIX##_fmadd(wv, simd_##TYPE_SUFFIX##_load(x + u * W),  \
+                                                        acc[u]);                                   \
+            }                                                                                      \
+            for (size_t u = 0; u + 1 < nv; u++)                                                    \
+                simd_##TYPE_SUFFIX##_store(out + ow + u * W, acc[u]);                              \
+            simd_##TYPE_SUFFIX##_store_partial(out + ow + (nv - 1) * W, acc[nv - 1],               \
+                                               rem - (nv - 1) * W);                                \
+        }                                                                                          \
+    }
+
+#define CONV2D_DEPTHWISE_ROW_SCALAR(TYPE, TYPE_SUFFIX)                                             \
+    static void conv2d_depthwise_row_##TYPE_SUFFIX(const TYPE *base, const size_t *off,            \
+                                                   const TYPE *w, size_t taps, TYPE *out,          \
+                                                   size_t out_width) {                             \
+        for (size_t ow = 0; ow < out_width; ow++) {                                                \
+            out[ow] = 0;                                                                           \
+        }                                                                                          \
+        for (size_t t = 0; t < taps; t++) {                                                        \
+            const TYPE wt = w[t];                                                                  \
+            const TYPE *x = base + off[t];                                                         \
+            for (size_t ow = 0; ow < out_width; ow++) {                                            \
+                out[ow] += wt * x[ow];                                                             \
+            }                                                                                      \
+        }                                                                                          \
+    }
+
+typedef struct {
+    const void *input;
+    const void *weight;
+    void *output;
+    const size_t *metadata;
+    size_t groups;
+    bool direct; // 1x1, stride 1, unpadded: the input planes are the GEMM rhs
+} conv2d_group_args_t;
+
+/// Macro to implement grouped conv2d (depthwise task, per-group GEMM task, entry point)
+///
+/// @param TYPE C type for the operation
+/// @param TYPE_SUFFIX Suffix for function naming
+#define CONV2D_GROUPED_OP(TYPE, TYPE_SUFFIX)                                                       \
+    static void conv2d_depthwise_task_##TYPE_SUFFIX(size_t start, size_t end, void *ctx) {         \
+        const conv2d_depthwise_args_t *a = (const conv2d_depthwise_args_t *)ctx;                   \
+        const size_t *md = a->metadata;                                                            \
+        const size_t in_channels = md[2], plane = md[4] * md[5];                                   \
+        const size_t kernel_height = md[6], kernel_width = md[7];                                  \
+        const size_t out_height = md[8], out_width = md[9], out_plane = out_height * out_width;    \
+        const size_t sh = md[10], sw = md[11], dh = md[14], dw = md[15];                           \
+        const size_t taps = kernel_height * kernel_width, wq = a->phase_cols;                      \
+        /* Tap offsets, then the staged phases (aligned like the workspace blocks) */              \
+        const size_t off_bytes = hodu_cpu_workspace_block_size(taps * sizeof(size_t));             \
+        const size_t staged_elems = sw * a->rows * wq;                                             \
+        char *scratch = (char *)workspace_acquire(                                                 \
+            off_bytes + (staged_elems + CONV2D_DEPTHWISE_SLACK) * sizeof(TYPE));                   \
+        if (!scratch) {                                                                            \
+            return;                                                                                \
+        }                                                                                          \
+        size_t *off = (size_t *)scratch;                                                           \
+        TYPE *staged = (TYPE *)(scratch + off_bytes);                                              \
+        memset(staged + staged_elems, 0, CONV2D_DEPTHWISE_SLACK * sizeof(TYPE));                   \
+        for (size_t kh = 0; kh < kernel_height; kh++) {                                            \
+            for (size_t kw = 0; kw < kernel_width; kw++) {                                         \
+                const size_t col = kw * dw;                                                        \
+                off[kh * kernel_width + kw] = (col % sw * a->rows + kh * dh) * wq + col / sw;      \
+            }                                                                                      \
+        }                                                                                          \
+                                                                                                   \
+        for (size_t item = start; item < end; item++) {                                            \
+            const size_t b = item / in_channels, ic = item % in_channels;                          \
+            conv2d_depthwise_stage_##TYPE_SUFFIX(                                                  \
+                a, (const TYPE *)a->input + md[16] + item * plane, staged);                        \
+            for (size_t m = 0; m < a->mult; m++) {                                                 \
+                const size_t oc = ic * a->mult + m;                                                \
+                const TYPE *w = (const TYPE *)a->weight + md[17] + oc * taps;                      \
+                TYPE *out = (TYPE *)a->output + (b * in_channels * a->mult + oc) * out_plane;      \
+                for (size_t oh = 0; oh < out_height; oh++) {                                       \
+                    conv2d_depthwise_row_##TYPE_SUFFIX(staged + oh * sh * wq, off, w, taps,        \
+                                                       out + oh * out_width, out_width);           \
+                }                                                                                  \
+            }                                                                                      \
+        }                                                                                          \
+        workspace_release(scratch);                                                                \
+    }                                                                                              \
+                                                                                                   \
+    static void conv2d_group_task_##TYPE_SUFFIX(size_t start, size_t end, void *ctx) {             \
+        const conv2d_group_args_t *a = (const conv2d_group_args_t *)ctx;                           \
+        const size_t *md = a->metadata;                                                            \
+        const size_t groups = a->groups;                                                           \
+        const size_t icpg = md[2] / groups, ocpg = md[3] / groups;                                 \
+        const size_t K = icpg * md[6] * md[7];                                                     \
+        const size_t N = md[8] * md[9];                                                            \
+        TYPE *col = NULL;                                                                          \
+        if (!a->direct) {                                                                          \
+            col = (TYPE *)workspace_acquire(K * N * sizeof(TYPE));                                 \
+            if (!col) {                                                                            \
+                return;                                                                            \
+            }                                                                                      \
+        }                                                                                          \
+        for (size_t item = start; item < end; item++) {                                            \
+            const size_t b = item / groups, g = item % groups;                                     \
+            const TYPE *group_input =                                                              \
+                (const TYPE *)a->input + md[16] + (b * md[2] + g * icpg) * md[4] * md[5];          \
+            const TYPE *cols = group_input;                                                        \
+            if (!a->direct) {                                                                      \
+                conv2d_im2col_##TYPE_SUFFIX(group_input, col, icpg, md[4], md[5], md[6], md[7],    \
+                                            md[8], md[9], md[10], md[11], md[12], md[13], md[14],  \
+                                            md[15]);                                               \
+                cols = col;                                                                        \
+            }                                                                                      \
+            const TYPE *group_weight = (const TYPE *)a->weight + md[17] + g * ocpg * K;            \
+            hodu_cpu_gemm_##TYPE_SUFFIX(ocpg, N, K, group_weight, K, 1, cols, N, 1,                \
+                                        (TYPE *)a->output + (b * md[3] + g * ocpg) * N, N);        \
+        }                                                                                          \
+        workspace_release(col);                                                                    \
+    }                                                                                              \
+                                                                                                   \
+    void hodu_cpu_conv2d_grouped_##TYPE_SUFFIX(const void *input_ptr, const void *weight_ptr,      \
+                                               void *output_ptr, const size_t *metadata) {         \
+        HODU_PROFILE_KERNEL(conv2d_grouped_profile_bytes(metadata, sizeof(TYPE)));                 \
+        const size_t batch = metadata[1];                                                          \
+        const size_t in_channels = metadata[2];                                                    \
+        const size_t out_channels = metadata[3];                                                   \
+        const size_t groups = metadata[18];                                                        \
+        if (groups == 0 || in_channels % groups != 0 || out_channels % groups != 0) {              \
+            return;                                                                                \
+        }                                                                                          \
+        if (groups == 1) {                                                                         \
+            hodu_cpu_conv2d_##TYPE_SUFFIX(input_ptr, weight_ptr, output_ptr, metadata);            \
+            return;                                                                                \
+        }                                                                                          \
+        if (batch * out_channels * metadata[8] * metadata[9] == 0) {                               \
+            return;                                                                                \
+        }                                                                                          \
+                                                                                                   \
+        if (groups == in_channels) {                                                               \
+            conv2d_depthwise_args_t args;                                                          \
+            args.input = input_ptr;                                                                \
+            args.weight = weight_ptr;                                                              \
+            args.output = output_ptr;                                                              \
+            args.metadata = metadata;                                                              \
+            args.mult = out_channels / in_channels;                                                \
+            args.rows = (metadata[8] - 1) * metadata[10] + (metadata[6] - 1) * metadata[14] + 1;   \
+            args.cols = (metadata[9] - 1) * metadata[11] + (metadata[7] - 1) * metadata[15] + 1;   \
+            args.phase_cols = (args.cols + metadata[11] - 1) / metadata[11];                       \
+            const double fmas = (double)(args.mult * metadata[6] * metadata[7] * metadata[8] *     \
+                                         metadata[9]);                                             \
+            parallel_for(0, batch * in_channels, task_grain(HODU_CPU_COST_FMA, fmas),              \
+                         conv2d_depthwise_task_##TYPE_SUFFIX, &args);                              \
+            return;                                                                                \
+        }                                                                                          \
+                                                                                                   \
+        conv2d_group_args_t args;                                                                  \
+        args.input = input_ptr;                                                                    \
+        args.weight = weight_ptr;                                                                  \
+        args.output = output_ptr;                                                                  \
+        args.metadata = metadata;                                                                  \
+        args.groups = groups;                                                                      \
+        args.direct = metadata[6] == 1 && metadata[7] == 1 && metadata[10] == 1 &&                 \
+                      metadata[11] == 1 && metadata[12] == 0 && metadata[13] == 0;                 \
+        if (batch * groups >= get_num_threads()) {                                                 \
+            parallel_for(0, batch * groups, 1, conv2d_group_task_##TYPE_SUFFIX, &args);            \
+        } else {                                                                                   \
+            conv2d_group_task_##TYPE_SUFFIX(0, batch * groups, &args);                             \
+        }                                                                                          \
+    }
+
+#ifdef HODU_PROFILE_ACTIVE
+// Input, weight and output bytes of a grouped conv2d (the weight is 1 / groups of a dense one)
+static uint64_t conv2d_grouped_profile_bytes(const size_t *metadata, size_t elem_size) {
+    const size_t groups = metadata[18] ? metadata[18] : 1;
+    const uint64_t in = (uint64_t)metadata[1] * metadata[2] * metadata[4] * metadata[5];
+    const uint64_t weight =
+        (uint64_t)metadata[2] / groups * metadata[3] * metadata[6] * metadata[7];
+    const uint64_t out = (uint64_t)metadata[1] * metadata[3] * metadata[8] * metadata[9];
+    return elem_size * (in + weight + out);
+}
+#endif
+
+CONV2D_DEPTHWISE_STAGE(f32_t, f32)
+CONV2D_DEPTHWISE_STAGE(f64_t, f64)
+
+#if SIMD_F32_WIDTH > 1
+CONV2D_DEPTHWISE_ROW_SIMD(f32_t, f32, SIMD_F32_WIDTH)
+#else
+CONV2D_DEPTHWISE_ROW_SCALAR(f32_t, f32)
+#endif
+
+#if SIMD_F64_WIDTH > 1
+CONV2D_DEPTHWISE_ROW_SIMD(f64_t, f64, SIMD_F64_WIDTH)
+#else
+CONV2D_DEPTHWISE_ROW_SCALAR(f64_t, f64)
+#endif
+
+CONV2D_GROUPED_OP(f32_t, f32)
+CONV2D_GROUPED_OP(f64_t, f64)
+
+// ============================================================================
+// 3D CONVOLUTION OPERATIONS
+// ============================================================================
+//
+// Metadata layout for conv3d:
+// - metadata[0]: num_els (total number of output elements)
+// - metadata[1]: batch
+// - metadata[2]: in_channels
+// - metadata[3]: out_channels
+// - metadata[4]: in_depth
+// - metadata[5]: in_height
+// - metadata[6]: in_width
+// - metadata[7]: kernel_depth
+// - metadata[8]: kernel_height
+// - metadata[9]: kernel_width
+// - metadata[10]: out_depth
+// - metadata[11]: out_height
+// - metadata[12]: out_width
+// - metadata[13]: stride_d
+// - metadata[14]: stride_h
+// - metadata[15]: stride_w
+// - metadata[16]: padding_d
+// - metadata[17]: padding_h
+// - metadata[18]: padding_w
+// - metadata[19]: dilation_d
+// - metadata[20]: dilation_h
+// - metadata[21]: dilation_w
+// - metadata[22]: input_offset
+// - metadata[23]: weight_offset
+
+/// Macro to implement 3D convolution operation for exotic types
+///
+/// @param TYPE C type for the operation
+/// @param TYPE_SUFFIX Suffix for function naming
+/// @param ZERO Zero constant
+/// @param ADD_FN Addition function
+/// @param MUL_FN Multiplication function
+#define CONV3D_OP_EXOTIC(TYPE, TYPE_SUFFIX, ZERO, ADD_FN, MUL_FN)                                  \
+    void hodu_cpu_conv3d_##TYPE_SUFFIX(const void *input_ptr, const void *weight_ptr,              \
+                                       void *output_ptr, const size_t *metadata) {                 \
+        HODU_PROFILE_KERNEL(hodu_cpu_profile_conv_bytes(metadata, 3, sizeof(TYPE)));               \
+        const TYPE *input = (const TYPE *)input_ptr;                                               \
+        const TYPE *weight = (const TYPE *)weight_ptr;                                             \
+        TYPE *output = (TYPE *)output_ptr;                                                         \
+                                                                                                   \
+        const size_t num_els = metadata[0];                                                        \
+        const size_t batch = metadata[1];                                                          \
+        const size_t in_channels = metadata[2];                                                    \
+        const size_t out_channels = metadata[3];                                                   \
+        const size_t in_depth = metadata[4];                                                       \
+        const size_t in_height = metadata[5];                                                      \
+        const size_t in_width = metadata[6];                                                       \
+        const size_t kernel_depth = metadata[7];                                                   \
+        const size_t kernel_height = metadata[8];                                                  \
         const size_t kernel_width = metadata[9];                                                   \
         const size_t out_depth = metadata[10];                                                     \
         const size_t out_height = metadata[11];                                                    \
@@ -495,8 +1562,6 @@ CONV3D_OP_EXOTIC(f8e4m3_t, f8e4m3, F8E4M3_ZERO, f8e4m3_add, f8e4m3_mul)
 CONV3D_OP_EXOTIC(f8e5m2_t, f8e5m2, F8E5M2_ZERO, f8e5m2_add, f8e5m2_mul)
 CONV3D_OP_EXOTIC(bf16_t, bf16, BF16_ZERO, bf16_add, bf16_mul)
 CONV3D_OP_EXOTIC(f16_t, f16, F16_ZERO, f16_add, f16_mul)
-CONV3D_OP(float, f32)
-CONV3D_OP(double, f64)
 
 // ============================================================================
 // 1D TRANSPOSED CONVOLUTION OPERATIONS
@@ -509,57 +1574,6 @@ CONV3D_OP(double, f64)
 // output_padding is used only for calculating out_width at the Rust level,
 // not needed in the kernel as it's already reflected in out_width
 
-/// Macro to implement 1D transposed convolution operation
-///
-/// @param TYPE C type for the operation
-/// @param TYPE_SUFFIX Suffix for function naming
-#define CONV_TRANSPOSE1D_OP(TYPE, TYPE_SUFFIX)                                                     \
-    void hodu_cpu_conv_transpose1d_##TYPE_SUFFIX(const void *input_ptr, const void *weight_ptr,    \
-                                                 void *output_ptr, const size_t *metadata) {       \
-        const TYPE *input = (const TYPE *)input_ptr;                                               \
-        const TYPE *weight = (const TYPE *)weight_ptr;                                             \
-        TYPE *output = (TYPE *)output_ptr;                                                         \
-                                                                                                   \
-        const size_t num_els = metadata[0];                                                        \
-                                                                                                   \
-        memset(output, 0, num_els * sizeof(TYPE));                                                 \
-                                                                                                   \
-        const size_t batch = metadata[1];                                                          \
-        const size_t in_channels = metadata[2];                                                    \
-        const size_t out_channels = metadata[3];                                                   \
-        const size_t in_width = metadata[4];                                                       \
-        const size_t kernel_width = metadata[5];                                                   \
-        const size_t out_width = metadata[6];                                                      \
-        const size_t stride = metadata[7];                                                         \
-        const size_t padding = metadata[8];                                                        \
-        const size_t dilation = metadata[9];                                                       \
-        const size_t input_offset = metadata[10];                                                  \
-        const size_t weight_offset = metadata[11];                                                 \
-                                                                                                   \
-        for (size_t b = 0; b < batch; b++) {                                                       \
-            for (size_t ic = 0; ic < in_channels; ic++) {                                          \
-                for (size_t iw = 0; iw < in_width; iw++) {                                         \
-                    for (size_t kw = 0; kw < kernel_width; kw++) {                                 \
-                        const int ow = (int)(iw * stride) - (int)padding + (int)(kw * dilation);   \
-                        if (ow >= 0 && ow < (int)out_width) {                                      \
-                            for (size_t oc = 0; oc < out_channels; oc++) {                         \
-                                const size_t input_idx = input_offset +                            \
-                                                         b * in_channels * in_width +              \
-                                                         ic * in_width + iw;                       \
-                                const size_t weight_idx = weight_offset +                          \
-                                                          ic * out_channels * kernel_width +       \
-                                                          oc * kernel_width + kw;                  \
-                                const size_t output_idx =                                          \
-                                    b * out_channels * out_width + oc * out_width + ow;            \
-                                output[output_idx] += input[input_idx] * weight[weight_idx];       \
-                            }                                                                      \
-                        }                                                                          \
-                    }                                                                              \
-                }                                                                                  \
-            }                                                                                      \
-        }                                                                                          \
-    }
-
 /// Macro to implement 1D transposed convolution operation for exotic types
 ///
 /// @param TYPE C type for the operation
@@ -570,6 +1584,7 @@ CONV3D_OP(double, f64)
 #define CONV_TRANSPOSE1D_OP_EXOTIC(TYPE, TYPE_SUFFIX, ZERO, ADD_FN, MUL_FN)                        \
     void hodu_cpu_conv_transpose1d_##TYPE_SUFFIX(const void *input_ptr, const void *weight_ptr,    \
                                                  void *output_ptr, const size_t *metadata) {       \
+        HODU_PROFILE_KERNEL(hodu_cpu_profile_conv_bytes(metadata, 1, sizeof(TYPE)));               \
         const TYPE *input = (const TYPE *)input_ptr;                                               \
         const TYPE *weight = (const TYPE *)weight_ptr;                                             \
         TYPE *output = (TYPE *)output_ptr;                                                         \
@@ -621,8 +1636,6 @@ CONV_TRANSPOSE1D_OP_EXOTIC(f8e4m3_t, f8e4m3, F8E4M3_ZERO, f8e4m3_add, f8e4m3_mul
 CONV_TRANSPOSE1D_OP_EXOTIC(f8e5m2_t, f8e5m2, F8E5M2_ZERO, f8e5m2_add, f8e5m2_mul)
 CONV_TRANSPOSE1D_OP_EXOTIC(bf16_t, bf16, BF16_ZERO, bf16_add, bf16_mul)
 CONV_TRANSPOSE1D_OP_EXOTIC(f16_t, f16, F16_ZERO, f16_add, f16_mul)
-CONV_TRANSPOSE1D_OP(float, f32)
-CONV_TRANSPOSE1D_OP(double, f64)
 
 // ============================================================================
 // 2D TRANSPOSED CONVOLUTION OPERATIONS
@@ -632,20 +1645,25 @@ CONV_TRANSPOSE1D_OP(double, f64)
 // output_padding is used only for calculating out_height/out_width at the Rust level,
 // not needed in the kernel as it's already reflected in out_height/out_width
 
-/// Macro to implement 2D transposed convolution operation
+/// Macro to implement 2D transposed convolution operation for exotic types
 ///
 /// @param TYPE C type for the operation
 /// @param TYPE_SUFFIX Suffix for function naming
-#define CONV_TRANSPOSE2D_OP(TYPE, TYPE_SUFFIX)                                                     \
+/// @param ZERO Zero constant
+/// @param ADD_FN Addition function
+/// @param MUL_FN Multiplication function
+#define CONV_TRANSPOSE2D_OP_EXOTIC(TYPE, TYPE_SUFFIX, ZERO, ADD_FN, MUL_FN)                        \
     void hodu_cpu_conv_transpose2d_##TYPE_SUFFIX(const void *input_ptr, const void *weight_ptr,    \
                                                  void *output_ptr, const size_t *metadata) {       \
+        HODU_PROFILE_KERNEL(hodu_cpu_profile_conv_bytes(metadata, 2, sizeof(TYPE)));               \
         const TYPE *input = (const TYPE *)input_ptr;                                               \
         const TYPE *weight = (const TYPE *)weight_ptr;                                             \
         TYPE *output = (TYPE *)output_ptr;                                                         \
                                                                                                    \
         const size_t num_els = metadata[0];                                                        \
                                                                                                    \
-        memset(output, 0, num_els * sizeof(TYPE));                                                 \
+        for (size_t i = 0; i < num_els; i++)                                                       \
+            output[i] = ZERO;                                                                      \
                                                                                                    \
         const size_t batch = metadata[1];                                                          \
         const size_t in_channels = metadata[2];                                                    \
@@ -690,8 +1708,9 @@ CONV_TRANSPOSE1D_OP(double, f64)
                                         const size_t output_idx =                                  \
                                             b * out_channels * out_height * out_width +            \
                                             oc * out_height * out_width + oh * out_width + ow;     \
-                                        output[output_idx] +=                                      \
-                                            input[input_idx] * weight[weight_idx];                 \
+                                        output[output_idx] =                                       \
+                                            ADD_FN(output[output_idx],                             \
+                                                   MUL_FN(input[input_idx], weight[weight_idx]));  \
                                     }                                                              \
                                 }                                                                  \
                             }                                                                      \
@@ -702,16 +1721,28 @@ CONV_TRANSPOSE1D_OP(double, f64)
         }                                                                                          \
     }
 
-/// Macro to implement 2D transposed convolution operation for exotic types
+CONV_TRANSPOSE2D_OP_EXOTIC(f8e4m3_t, f8e4m3, F8E4M3_ZERO, f8e4m3_add, f8e4m3_mul)
+CONV_TRANSPOSE2D_OP_EXOTIC(f8e5m2_t, f8e5m2, F8E5M2_ZERO, f8e5m2_add, f8e5m2_mul)
+CONV_TRANSPOSE2D_OP_EXOTIC(bf16_t, bf16, BF16_ZERO, bf16_add, bf16_mul)
+CONV_TRANSPOSE2D_OP_EXOTIC(f16_t, f16, F16_ZERO, f16_add, f16_mul)
+
+// ============================================================================
+// 3D TRANSPOSED CONVOLUTION OPERATIONS
+// ============================================================================
+//
+// Metadata layout: Same as conv3d
+
+/// Macro to implement 3D transposed convolution operation for exotic types
 ///
 /// @param TYPE C type for the operation
 /// @param TYPE_SUFFIX Suffix for function naming
 /// @param ZERO Zero constant
 /// @param ADD_FN Addition function
 /// @param MUL_FN Multiplication function
-#define CONV_TRANSPOSE2D_OP_EXOTIC(TYPE, TYPE_SUFFIX, ZERO, ADD_FN, MUL_FN)                        \
-    void hodu_cpu_conv_transpose2d_##TYPE_SUFFIX(const void *input_ptr, const void *weight_ptr,    \
+#define CONV_TRANSPOSE3D_OP_EXOTIC(TYPE, TYPE_SUFFIX, ZERO, ADD_FN, MUL_FN)                        \
+    void hodu_cpu_conv_transpose3d_##TYPE_SUFFIX(const void *input_ptr, const void *weight_ptr,    \
                                                  void *output_ptr, const size_t *metadata) {       \
+        HODU_PROFILE_KERNEL(hodu_cpu_profile_conv_bytes(metadata, 3, sizeof(TYPE)));               \
         const TYPE *input = (const TYPE *)input_ptr;                                               \
         const TYPE *weight = (const TYPE *)weight_ptr;                                             \
         TYPE *output = (TYPE *)output_ptr;                                                         \
@@ -724,90 +1755,6 @@ CONV_TRANSPOSE1D_OP(double, f64)
         const size_t batch = metadata[1];                                                          \
         const size_t in_channels = metadata[2];                                                    \
         const size_t out_channels = metadata[3];                                                   \
-        const size_t in_height = metadata[4];                                                      \
-        const size_t in_width = metadata[5];                                                       \
-        const size_t kernel_height = metadata[6];                                                  \
-        const size_t kernel_width = metadata[7];                                                   \
-        const size_t out_height = metadata[8];                                                     \
-        const size_t out_width = metadata[9];                                                      \
-        const size_t stride_h = metadata[10];                                                      \
-        const size_t stride_w = metadata[11];                                                      \
-        const size_t padding_h = metadata[12];                                                     \
-        const size_t padding_w = metadata[13];                                                     \
-        const size_t dilation_h = metadata[14];                                                    \
-        const size_t dilation_w = metadata[15];                                                    \
-        const size_t input_offset = metadata[16];                                                  \
-        const size_t weight_offset = metadata[17];                                                 \
-                                                                                                   \
-        for (size_t b = 0; b < batch; b++) {                                                       \
-            for (size_t ic = 0; ic < in_channels; ic++) {                                          \
-                for (size_t ih = 0; ih < in_height; ih++) {                                        \
-                    for (size_t iw = 0; iw < in_width; iw++) {                                     \
-                        for (size_t kh = 0; kh < kernel_height; kh++) {                            \
-                            for (size_t kw = 0; kw < kernel_width; kw++) {                         \
-                                const int oh = (int)(ih * stride_h) - (int)padding_h +             \
-                                               (int)(kh * dilation_h);                             \
-                                const int ow = (int)(iw * stride_w) - (int)padding_w +             \
-                                               (int)(kw * dilation_w);                             \
-                                if (oh >= 0 && oh < (int)out_height && ow >= 0 &&                  \
-                                    ow < (int)out_width) {                                         \
-                                    for (size_t oc = 0; oc < out_channels; oc++) {                 \
-                                        const size_t input_idx =                                   \
-                                            input_offset +                                         \
-                                            b * in_channels * in_height * in_width +               \
-                                            ic * in_height * in_width + ih * in_width + iw;        \
-                                        const size_t weight_idx =                                  \
-                                            weight_offset +                                        \
-                                            ic * out_channels * kernel_height * kernel_width +     \
-                                            oc * kernel_height * kernel_width +                    \
-                                            kh * kernel_width + kw;                                \
-                                        const size_t output_idx =                                  \
-                                            b * out_channels * out_height * out_width +            \
-                                            oc * out_height * out_width + oh * out_width + ow;     \
-                                        output[output_idx] =                                       \
-                                            ADD_FN(output[output_idx],                             \
-                                                   MUL_FN(input[input_idx], weight[weight_idx]));  \
-                                    }                                                              \
-                                }                                                                  \
-                            }                                                                      \
-                        }                                                                          \
-                    }                                                                              \
-                }                                                                                  \
-            }                                                                                      \
-        }                                                                                          \
-    }
-
-CONV_TRANSPOSE2D_OP_EXOTIC(f8e4m3_t, f8e4m3, F8E4M3_ZERO, f8e4m3_add, f8e4m3_mul)
-CONV_TRANSPOSE2D_OP_EXOTIC(f8e5m2_t, f8e5m2, F8E5M2_ZERO, f8e5m2_add, f8e5m2_mul)
-CONV_TRANSPOSE2D_OP_EXOTIC(bf16_t, bf16, BF16_ZERO, bf16_add, bf16_mul)
-CONV_TRANSPOSE2D_OP_EXOTIC(f16_t, f16, F16_ZERO, f16_add, f16_mul)
-CONV_TRANSPOSE2D_OP(float, f32)
-CONV_TRANSPOSE2D_OP(double, f64)
-
-// ============================================================================
-// 3D TRANSPOSED CONVOLUTION OPERATIONS
-// ============================================================================
-//
-// Metadata layout: Same as conv3d
-
-/// Macro to implement 3D transposed convolution operation
-///
-/// @param TYPE C type for the operation
-/// @param TYPE_SUFFIX Suffix for function naming
-#define CONV_TRANSPOSE3D_OP(TYPE, TYPE_SUFFIX)                                                     \
-    void hodu_cpu_conv_transpose3d_##TYPE_SUFFIX(const void *input_ptr, const void *weight_ptr,    \
-                                                 void *output_ptr, const size_t *metadata) {       \
-        const TYPE *input = (const TYPE *)input_ptr;                                               \
-        const TYPE *weight = (const TYPE *)weight_ptr;                                             \
-        TYPE *output = (TYPE *)output_ptr;                                                         \
-                                                                                                   \
-        const size_t num_els = metadata[0];                                                        \
-                                                                                                   \
-        memset(output, 0, num_els * sizeof(TYPE));                                                 \
-                                                                                                   \
-        const size_t batch = metadata[1];                                                          \
-        const size_t in_channels = metadata[2];                                                    \
-        const size_t out_channels = metadata[3];                                                   \
         const size_t in_depth = metadata[4];                                                       \
         const size_t in_height = metadata[5];                                                      \
         const size_t in_width = metadata[6];                                                       \
@@ -868,8 +1815,9 @@ CONV_TRANSPOSE2D_OP(double, f64)
                                                     oc * out_depth * out_height * out_width +      \
                                                     od * out_height * out_width + oh * out_width + \
                                                     ow;                                            \
-                                                output[output_idx] +=                              \
-                                                    input[input_idx] * weight[weight_idx];         \
+                                                output[output_idx] = ADD_FN(                       \
+                                                    output[output_idx],                            \
+                                                    MUL_FN(input[input_idx], weight[weight_idx])); \
                                             }                                                      \
                                         }                                                          \
                                     }                                                              \
@@ -882,116 +1830,631 @@ CONV_TRANSPOSE2D_OP(double, f64)
         }                                                                                          \
     }
 
-/// Macro to implement 3D transposed convolution operation for exotic types
+CONV_TRANSPOSE3D_OP_EXOTIC(f8e4m3_t, f8e4m3, F8E4M3_ZERO, f8e4m3_add, f8e4m3_mul)
+CONV_TRANSPOSE3D_OP_EXOTIC(f8e5m2_t, f8e5m2, F8E5M2_ZERO, f8e5m2_add, f8e5m2_mul)
+CONV_TRANSPOSE3D_OP_EXOTIC(bf16_t, bf16, BF16_ZERO, bf16_add, bf16_mul)
+CONV_TRANSPOSE3D_OP_EXOTIC(f16_t, f16, F16_ZERO, f16_add, f16_mul)
+
+// ============================================================================
+// GEMM-LOWERED CONV1D / CONV3D / TRANSPOSED CONVOLUTION
+// ============================================================================
+//
+// f32/f64 conv1d and conv3d run one GEMM per batch element on a column matrix
+// (im2col / vol2col), like the pointwise and fused conv2d paths:
+//   output[oc, P] = weight[oc, K] @ col[K, P], K = in_channels * kernel volume
+// Transposed convolutions (1D, 2D and 3D) multiply the other way round and
+// scatter the columns back onto the output (col2im / col2vol):
+//   col[(oc, k), Q] = weight[ic, (oc, k)]^T @ input[ic, Q]
+//   output[oc, q * stride - padding + k * dilation] += col[(oc, k), q]
+// Both directions are 3D problems (1D and 2D ones with unit leading dims):
+// column row (c, k) holds one value per "outer" position x, tapped at
+// x * stride - padding + k * dilation in the "inner" extents (outer = output
+// and inner = input for conv, the reverse for conv_transpose). Unit kernels
+// with stride 1 and no padding use the input or output as the column matrix.
+// Batches with an element per thread run one element per pool task; smaller
+// ones build and scatter the columns on the pool around pooled GEMMs.
+
+typedef struct {
+    size_t batch, in_channels, out_channels;
+    size_t in[3], kernel[3], out[3], stride[3], padding[3], dilation[3];
+    size_t input_offset, weight_offset;
+    size_t in_size, kernel_size, out_size; // spatial volumes
+    bool transposed;
+} conv_gemm_params_t;
+
+/// Read the conv{1,2,3}d / conv_transpose{1,2,3}d metadata of `spatial_dims` dims
+static void conv_gemm_parse(const size_t *metadata, size_t spatial_dims, bool transposed,
+                            conv_gemm_params_t *p) {
+    const size_t lead = 3 - spatial_dims;
+    p->batch = metadata[1];
+    p->in_channels = metadata[2];
+    p->out_channels = metadata[3];
+    p->in_size = p->kernel_size = p->out_size = 1;
+    for (size_t d = 0; d < 3; d++) {
+        p->in[d] = p->kernel[d] = p->out[d] = p->stride[d] = p->dilation[d] = 1;
+        p->padding[d] = 0;
+        if (d >= lead) {
+            const size_t *m = metadata + 4 + (d - lead);
+            p->in[d] = m[0];
+            p->kernel[d] = m[spatial_dims];
+            p->out[d] = m[2 * spatial_dims];
+            p->stride[d] = m[3 * spatial_dims];
+            p->padding[d] = m[4 * spatial_dims];
+            p->dilation[d] = m[5 * spatial_dims];
+        }
+        p->in_size *= p->in[d];
+        p->kernel_size *= p->kernel[d];
+        p->out_size *= p->out[d];
+    }
+    p->input_offset = metadata[4 + 6 * spatial_dims];
+    p->weight_offset = metadata[5 + 6 * spatial_dims];
+    p->transposed = transposed;
+}
+
+// Unit kernel, stride 1, no padding, same extents: the columns are the input (conv)
+// or the output (conv_transpose)
+static bool conv_gemm_is_pointwise(const conv_gemm_params_t *p) {
+    for (size_t d = 0; d < 3; d++) {
+        if (p->kernel[d] != 1 || p->stride[d] != 1 || p->padding[d] != 0 || p->in[d] != p->out[d])
+            return false;
+    }
+    return true;
+}
+
+// Outer positions [*lo, *hi) of `count` whose tapped position pos * stride + shift lies in
+// [0, limit)
+static inline void conv_tap_range(size_t count, size_t stride, long shift, size_t limit,
+                                  size_t *lo, size_t *hi) {
+    const long s = (long)stride;
+    const long first = shift >= 0 ? 0 : (-shift + s - 1) / s;
+    const long span = (long)limit - shift;
+    long last = span > 0 ? (span + s - 1) / s : 0;
+    if (last > (long)count)
+        last = (long)count;
+    *lo = (size_t)(first < last ? first : last);
+    *hi = (size_t)last;
+}
+
+/// Column geometry of one batch element
+typedef struct {
+    const conv_gemm_params_t *p;
+    const size_t *outer; // column positions: out (conv) or in (conv_transpose) extents
+    const size_t *inner; // tapped extents: in (conv) or out (conv_transpose)
+    size_t outer_size, inner_size;
+    const void *src; // vol2col: input planes
+    void *dst;       // col2vol: output planes
+    void *col;       // [channels * kernel volume, outer volume]
+} conv_gemm_cols_t;
+
+// Kernel tap `tap` of the column geometry: tap offsets and the outer ranges that hit
+static void conv_gemm_tap(const conv_gemm_cols_t *c, size_t tap, long shift[3], size_t lo[3],
+                          size_t hi[3]) {
+    const conv_gemm_params_t *p = c->p;
+    const size_t k[3] = {tap / (p->kernel[1] * p->kernel[2]), tap / p->kernel[2] % p->kernel[1],
+                         tap % p->kernel[2]};
+    for (size_t d = 0; d < 3; d++) {
+        shift[d] = (long)(k[d] * p->dilation[d]) - (long)p->padding[d];
+        conv_tap_range(c->outer[d], p->stride[d], shift[d], c->inner[d], &lo[d], &hi[d]);
+    }
+}
+
+/// Macro to implement the GEMM-lowered conv / conv_transpose engine for one type
 ///
 /// @param TYPE C type for the operation
 /// @param TYPE_SUFFIX Suffix for function naming
-/// @param ZERO Zero constant
-/// @param ADD_FN Addition function
-/// @param MUL_FN Multiplication function
-#define CONV_TRANSPOSE3D_OP_EXOTIC(TYPE, TYPE_SUFFIX, ZERO, ADD_FN, MUL_FN)                        \
-    void hodu_cpu_conv_transpose3d_##TYPE_SUFFIX(const void *input_ptr, const void *weight_ptr,    \
-                                                 void *output_ptr, const size_t *metadata) {       \
-        const TYPE *input = (const TYPE *)input_ptr;                                               \
-        const TYPE *weight = (const TYPE *)weight_ptr;                                             \
-        TYPE *output = (TYPE *)output_ptr;                                                         \
+#define CONV_GEMM_OP(TYPE, TYPE_SUFFIX)                                                            \
+    /* Column rows [start, end): row (ic, tap) gathers the tapped input plane */                   \
+    static void conv_vol2col_task_##TYPE_SUFFIX(size_t start, size_t end, void *ctx) {             \
+        const conv_gemm_cols_t *c = (const conv_gemm_cols_t *)ctx;                                 \
+        const conv_gemm_params_t *p = c->p;                                                        \
+        const size_t *outer = c->outer, *inner = c->inner;                                         \
+        const size_t sw = p->stride[2];                                                            \
+        for (size_t r = start; r < end; r++) {                                                     \
+            const TYPE *plane = (const TYPE *)c->src + r / p->kernel_size * c->inner_size;         \
+            TYPE *row = (TYPE *)c->col + r * c->outer_size;                                        \
+            long shift[3];                                                                         \
+            size_t lo[3], hi[3];                                                                   \
+            conv_gemm_tap(c, r % p->kernel_size, shift, lo, hi);                                   \
+            for (size_t x0 = 0; x0 < outer[0]; x0++) {                                             \
+                for (size_t x1 = 0; x1 < outer[1]; x1++) {                                         \
+                    TYPE *dst = row + (x0 * outer[1] + x1) * outer[2];                             \
+                    if (x0 < lo[0] || x0 >= hi[0] || x1 < lo[1] || x1 >= hi[1]) {                  \
+                        memset(dst, 0, outer[2] * sizeof(TYPE));                                   \
+                        continue;                                                                  \
+                    }                                                                              \
+                    const long i0 = (long)(x0 * p->stride[0]) + shift[0];                          \
+                    const long i1 = (long)(x1 * p->stride[1]) + shift[1];                          \
+                    const TYPE *line = plane + ((size_t)i0 * inner[1] + (size_t)i1) * inner[2];    \
+                    memset(dst, 0, lo[2] * sizeof(TYPE));                                          \
+                    if (sw == 1) {                                                                 \
+                        memcpy(dst + lo[2], line + (long)lo[2] + shift[2],                         \
+                               (hi[2] - lo[2]) * sizeof(TYPE));                                    \
+                    } else {                                                                       \
+                        for (size_t x2 = lo[2]; x2 < hi[2]; x2++)                                  \
+                            dst[x2] = line[(long)(x2 * sw) + shift[2]];                            \
+                    }                                                                              \
+                    memset(dst + hi[2], 0, (outer[2] - hi[2]) * sizeof(TYPE));                     \
+                }                                                                                  \
+            }                                                                                      \
+        }                                                                                          \
+    }                                                                                              \
+                                                                                                   \
+    /* Output channels [start, end): each plane accumulates its kernel_size column rows */         \
+    static void conv_col2vol_task_##TYPE_SUFFIX(size_t start, size_t end, void *ctx) {             \
+        const conv_gemm_cols_t *c = (const conv_gemm_cols_t *)ctx;                                 \
+        const conv_gemm_params_t *p = c->p;                                                        \
+        const size_t *outer = c->outer, *inner = c->inner;                                         \
+        const size_t sw = p->stride[2];                                                            \
+        for (size_t oc = start; oc < end; oc++) {                                                  \
+            TYPE *plane = (TYPE *)c->dst + oc * c->inner_size;                                     \
+            memset(plane, 0, c->inner_size * sizeof(TYPE));                                        \
+            for (size_t tap = 0; tap < p->kernel_size; tap++) {                                    \
+                const TYPE *row =                                                                  \
+                    (const TYPE *)c->col + (oc * p->kernel_size + tap) * c->outer_size;            \
+                long shift[3];                                                                     \
+                size_t lo[3], hi[3];                                                               \
+                conv_gemm_tap(c, tap, shift, lo, hi);                                              \
+                for (size_t x0 = lo[0]; x0 < hi[0]; x0++) {                                        \
+                    for (size_t x1 = lo[1]; x1 < hi[1]; x1++) {                                    \
+                        const TYPE *src = row + (x0 * outer[1] + x1) * outer[2];                   \
+                        const long o0 = (long)(x0 * p->stride[0]) + shift[0];                      \
+                        const long o1 = (long)(x1 * p->stride[1]) + shift[1];                      \
+                        TYPE *line = plane + ((size_t)o0 * inner[1] + (size_t)o1) * inner[2];      \
+                        for (size_t x2 = lo[2]; x2 < hi[2]; x2++)                                  \
+                            line[(long)(x2 * sw) + shift[2]] += src[x2];                           \
+                    }                                                                              \
+                }                                                                                  \
+            }                                                                                      \
+        }                                                                                          \
+    }                                                                                              \
+                                                                                                   \
+    typedef struct {                                                                               \
+        const conv_gemm_params_t *p;                                                               \
+        const TYPE *input;                                                                         \
+        const TYPE *weight;                                                                        \
+        TYPE *output;                                                                              \
+        bool pointwise;                                                                            \
+    } conv_gemm_##TYPE_SUFFIX##_args_t;                                                            \
+                                                                                                   \
+    /* One batch element; `pooled` spreads the column passes over the pool */                      \
+    static void conv_gemm_sample_##TYPE_SUFFIX(const conv_gemm_##TYPE_SUFFIX##_args_t *a,          \
+                                               size_t b, TYPE *col, bool pooled) {                 \
+        const conv_gemm_params_t *p = a->p;                                                        \
+        const TYPE *input = a->input + b * p->in_channels * p->in_size;                            \
+        TYPE *output = a->output + b * p->out_channels * p->out_size;                              \
+        conv_gemm_cols_t c;                                                                        \
+        c.p = p;                                                                                   \
+        c.outer = p->transposed ? p->in : p->out;                                                  \
+        c.inner = p->transposed ? p->out : p->in;                                                  \
+        c.outer_size = p->transposed ? p->in_size : p->out_size;                                   \
+        c.inner_size = p->transposed ? p->out_size : p->in_size;                                   \
+        c.src = input;                                                                             \
+        c.dst = output;                                                                            \
+        c.col = col;                                                                               \
+        const size_t N = c.outer_size;                                                             \
+                                                                                                   \
+        if (!p->transposed) {                                                                      \
+            const size_t K = p->in_channels * p->kernel_size;                                      \
+            if (!a->pointwise) {                                                                   \
+                if (pooled) {                                                                      \
+                    parallel_for(0, K, task_grain(HODU_CPU_COST_COPY, (double)(N * sizeof(TYPE))), \
+                                 conv_vol2col_task_##TYPE_SUFFIX, &c);                             \
+                } else {                                                                           \
+                    conv_vol2col_task_##TYPE_SUFFIX(0, K, &c);                                     \
+                }                                                                                  \
+            }                                                                                      \
+            hodu_cpu_gemm_##TYPE_SUFFIX(p->out_channels, N, K, a->weight, K, 1,                    \
+                                        a->pointwise ? input : col, N, 1, output, N);              \
+            return;                                                                                \
+        }                                                                                          \
                                                                                                    \
-        const size_t num_els = metadata[0];                                                        \
+        /* weight is [ic, oc * kernel_size]: its transpose is a column-major lhs */                \
+        const size_t M = p->out_channels * p->kernel_size;                                         \
+        hodu_cpu_gemm_##TYPE_SUFFIX(M, N, p->in_channels, a->weight, 1, M, input, N, 1,            \
+                                    a->pointwise ? output : col, N);                               \
+        if (!a->pointwise) {                                                                       \
+            if (pooled) {                                                                          \
+                parallel_for(0, p->out_channels,                                                   \
+                             task_grain(HODU_CPU_COST_ELEMENTWISE, (double)(p->kernel_size * N)),  \
+                             conv_col2vol_task_##TYPE_SUFFIX, &c);                                 \
+            } else {                                                                               \
+                conv_col2vol_task_##TYPE_SUFFIX(0, p->out_channels, &c);                           \
+            }                                                                                      \
+        }                                                                                          \
+    }                                                                                              \
+                                                                                                   \
+    static void conv_gemm_task_##TYPE_SUFFIX(size_t start, size_t end, void *ctx) {                \
+        const conv_gemm_##TYPE_SUFFIX##_args_t *a = (const conv_gemm_##TYPE_SUFFIX##_args_t *)ctx; \
+        const conv_gemm_params_t *p = a->p;                                                        \
+        TYPE *col = NULL;                                                                          \
+        if (!a->pointwise) {                                                                       \
+            const size_t rows = p->kernel_size * (p->transposed ? p->out_channels                  \
+                                                                : p->in_channels);                 \
+            col = (TYPE *)workspace_acquire(rows * (p->transposed ? p->in_size : p->out_size) *    \
+                                            sizeof(TYPE));                                         \
+            if (!col) {                                                                            \
+                return;                                                                            \
+            }                                                                                      \
+        }                                                                                          \
+        /* A range of one element runs on the caller: its column passes use the pool */            \
+        for (size_t b = start; b < end; b++) {                                                     \
+            conv_gemm_sample_##TYPE_SUFFIX(a, b, col, end - start == 1);                           \
+        }                                                                                          \
+        workspace_release(col);                                                                    \
+    }                                                                                              \
+                                                                                                   \
+    static void conv_gemm_##TYPE_SUFFIX(const void *input_ptr, const void *weight_ptr,             \
+                                        void *output_ptr, const size_t *metadata,                  \
+                                        size_t spatial_dims, bool transposed) {                    \
+        conv_gemm_params_t p;                                                                      \
+        conv_gemm_parse(metadata, spatial_dims, transposed, &p);                                   \
+        if (p.batch * p.out_channels * p.out_size == 0) {                                          \
+            return;                                                                                \
+        }                                                                                          \
+        conv_gemm_##TYPE_SUFFIX##_args_t args;                                                     \
+        args.p = &p;                                                                               \
+        args.input = (const TYPE *)input_ptr + p.input_offset;                                     \
+        args.weight = (const TYPE *)weight_ptr + p.weight_offset;                                  \
+        args.output = (TYPE *)output_ptr;                                                          \
+        args.pointwise = conv_gemm_is_pointwise(&p);                                               \
+        if (p.batch >= get_num_threads()) {                                                        \
+            parallel_for(0, p.batch, 1, conv_gemm_task_##TYPE_SUFFIX, &args);                      \
+        } else {                                                                                   \
+            for (size_t b = 0; b < p.batch; b++) {                                                 \
+                conv_gemm_task_##TYPE_SUFFIX(b, b + 1, &args);                                     \
+            }                                                                                      \
+        }                                                                                          \
+    }                                                                                              \
                                                                                                    \
-        for (size_t i = 0; i < num_els; i++)                                                       \
-            output[i] = ZERO;                                                                      \
+    void hodu_cpu_conv1d_##TYPE_SUFFIX(const void *input_ptr, const void *weight_ptr,              \
+                                       void *output_ptr, const size_t *metadata) {                 \
+        HODU_PROFILE_KERNEL(hodu_cpu_profile_conv_bytes(metadata, 1, sizeof(TYPE)));               \
+        conv_gemm_##TYPE_SUFFIX(input_ptr, weight_ptr, output_ptr, metadata, 1, false);            \
+    }                                                                                              \
                                                                                                    \
-        const size_t batch = metadata[1];                                                          \
-        const size_t in_channels = metadata[2];                                                    \
-        const size_t out_channels = metadata[3];                                                   \
-        const size_t in_depth = metadata[4];                                                       \
-        const size_t in_height = metadata[5];                                                      \
-        const size_t in_width = metadata[6];                                                       \
-        const size_t kernel_depth = metadata[7];                                                   \
-        const size_t kernel_height = metadata[8];                                                  \
-        const size_t kernel_width = metadata[9];                                                   \
-        const size_t out_depth = metadata[10];                                                     \
-        const size_t out_height = metadata[11];                                                    \
-        const size_t out_width = metadata[12];                                                     \
-        const size_t stride_d = metadata[13];                                                      \
-        const size_t stride_h = metadata[14];                                                      \
-        const size_t stride_w = metadata[15];                                                      \
-        const size_t padding_d = metadata[16];                                                     \
-        const size_t padding_h = metadata[17];                                                     \
-        const size_t padding_w = metadata[18];                                                     \
-        const size_t dilation_d = metadata[19];                                                    \
-        const size_t dilation_h = metadata[20];                                                    \
-        const size_t dilation_w = metadata[21];                                                    \
-        const size_t input_offset = metadata[22];                                                  \
-        const size_t weight_offset = metadata[23];                                                 \
+    void hodu_cpu_conv3d_##TYPE_SUFFIX(const void *input_ptr, const void *weight_ptr,              \
+                                       void *output_ptr, const size_t *metadata) {                 \
+        HODU_PROFILE_KERNEL(hodu_cpu_profile_conv_bytes(metadata, 3, sizeof(TYPE)));               \
+        conv_gemm_##TYPE_SUFFIX(input_ptr, weight_ptr, output_ptr, metadata, 3, false);            \
+    }                                                                                              \
                                                                                                    \
-        for (size_t b = 0; b < batch; b++) {                                                       \
-            for (size_t ic = 0; ic < in_channels; ic++) {                                          \
-                for (size_t id = 0; id < in_depth; id++) {                                         \
-                    for (size_t ih = 0; ih < in_height; ih++) {                                    \
-                        for (size_t iw = 0; iw < in_width; iw++) {                                 \
-                            for (size_t kd = 0; kd < kernel_depth; kd++) {                         \
-                                for (size_t kh = 0; kh < kernel_height; kh++) {                    \
-                                    for (size_t kw = 0; kw < kernel_width; kw++) {                 \
-                                        const int od = (int)(id * stride_d) - (int)padding_d +     \
-                                                       (int)(kd * dilation_d);                     \
-                                        const int oh = (int)(ih * stride_h) - (int)padding_h +     \
-                                                       (int)(kh * dilation_h);                     \
-                                        const int ow = (int)(iw * stride_w) - (int)padding_w +     \
-                                                       (int)(kw * dilation_w);                     \
-                                        if (od >= 0 && od < (int)out_depth && oh >= 0 &&           \
-                                            oh < (int)out_height && ow >= 0 &&                     \
-                                            ow < (int)out_width) {                                 \
-                                            for (size_t oc = 0; oc < out_channels; oc++) {         \
-                                                const size_t input_idx =                           \
-                                                    input_offset +                                 \
-                                                    b * in_channels * in_depth * in_height *       \
-                                                        in_width +                                 \
-                                                    ic * in_depth * in_height * in_width +         \
-                                                    id * in_height * in_width + ih * in_width +    \
-                                                    iw;                                            \
-                                                const size_t weight_idx =                          \
-                                                    weight_offset +                                \
-                                                    ic * out_channels * kernel_depth *             \
-                                                        kernel_height * kernel_width +             \
-                                                    oc * kernel_depth * kernel_height *            \
-                                                        kernel_width +                             \
-                                                    kd * kernel_height * kernel_width +            \
-                                                    kh * kernel_width + kw;                        \
-                                                const size_t output_idx =                          \
-                                                    b * out_channels * out_depth * out_height *    \
-                                                        out_width +                                \
-                                                    oc * out_depth * out_height * out_width +      \
-                                                    od * out_height * out_width + oh * out_width + \
-                                                    ow;                                            \
-                                                output[output_idx] = ADD_FN(                       \
-                                                    output[output_idx],                            \
-                                                    MUL_FN(input[input_idx], weight[weight_idx])); \
-                                            }                                                      \
-                                        }                                                          \
-                                    }                                                              \
-                                }                                                                  \
+    void hodu_cpu_conv_transpose1d_##TYPE_SUFFIX(const void *input_ptr, const void *weight_ptr,    \
+                                                 void *output_ptr, const size_t *metadata) {       \
+        HODU_PROFILE_KERNEL(hodu_cpu_profile_conv_bytes(metadata, 1, sizeof(TYPE)));               \
+        conv_gemm_##TYPE_SUFFIX(input_ptr, weight_ptr, output_ptr, metadata, 1, true);             \
+    }                                                                                              \
+                                                                                                   \
+    void hodu_cpu_conv_transpose2d_##TYPE_SUFFIX(const void *input_ptr, const void *weight_ptr,    \
+                                                 void *output_ptr, const size_t *metadata) {       \
+        HODU_PROFILE_KERNEL(hodu_cpu_profile_conv_bytes(metadata, 2, sizeof(TYPE)));               \
+        conv_gemm_##TYPE_SUFFIX(input_ptr, weight_ptr, output_ptr, metadata, 2, true);             \
+    }                                                                                              \
+                                                                                                   \
+    void hodu_cpu_conv_transpose3d_##TYPE_SUFFIX(const void *input_ptr, const void *weight_ptr,    \
+                                                 void *output_ptr, const size_t *metadata) {       \
+        HODU_PROFILE_KERNEL(hodu_cpu_profile_conv_bytes(metadata, 3, sizeof(TYPE)));               \
+        conv_gemm_##TYPE_SUFFIX(input_ptr, weight_ptr, output_ptr, metadata, 3, true);             \
+    }
+
+CONV_GEMM_OP(f32_t, f32)
+CONV_GEMM_OP(f64_t, f64)
+
+// ============================================================================
+// CONVOLUTION GRADIENT WEIGHT ENGINE
+// ============================================================================
+//
+// Every conv*_grad_weight kernel computes, for each filter (w0, w1) and tap k,
+//   grad_weight[w0, w1, k] = sum_b sum_p outer[b, w0, p] * inner[b, w1, p * stride - padding +
+//                                                                k * dilation]
+// over every outer position p whose tapped inner position is in bounds, where
+// - conv:           outer = grad_output (w0 = oc), inner = input (w1 = ic)
+// - conv_transpose: outer = input (w0 = ic), inner = grad_output (w1 = oc)
+//
+// Filters are split over the thread pool and each one is owned by a single
+// task, which accumulates its taps in a register and stores every weight once:
+// there is no shared accumulator, so no atomics and no reduction pass.
+// Low-precision types are widened once into contiguous f32 copies, run on the
+// f32 kernel of the same op (GEMM for conv2d) and rounded once per weight;
+// if the copies cannot be allocated they accumulate in f32 registers instead.
+// 1D and 2D problems run as 3D ones with unit leading dimensions.
+
+// Multiply-adds per pool chunk
+#define CONV_GRAD_WEIGHT_GRAIN_WORK (1 << 16)
+
+#define CONV_GRAD_WEIGHT_IDENTITY(x) (x)
+
+/// Strided [batch, channels, d, h, w] view of one grad_weight operand
+typedef struct {
+    size_t offset;
+    size_t strides[5]; // batch, channel, d, h, w (0 for unit dims)
+    size_t shape[3];   // d, h, w (1 for unit dims)
+} conv_grad_weight_view_t;
+
+/// Parsed conv*_grad_weight problem shared by every type
+typedef struct {
+    const void *outer_data;
+    const void *inner_data;
+    void *grad_weight;
+    conv_grad_weight_view_t outer;
+    conv_grad_weight_view_t inner;
+    size_t batch;
+    size_t inner_channels; // extent of weight dim 1
+    size_t kernel[3];
+    size_t stride[3];
+    size_t padding[3];
+    size_t dilation[3];
+    size_t grain; // filters per pool chunk
+} conv_grad_weight_params_t;
+
+static void conv_grad_weight_view_init(conv_grad_weight_view_t *v, const size_t *shape,
+                                       const size_t *strides, size_t offset, size_t ndim) {
+    const size_t lead = 5 - ndim;
+    v->offset = offset;
+    v->strides[0] = strides[0];
+    v->strides[1] = strides[1];
+    for (size_t d = 0; d < 3; d++) {
+        const bool unit = d < lead;
+        v->shape[d] = unit ? 1 : shape[2 + d - lead];
+        v->strides[2 + d] = unit ? 0 : strides[2 + d - lead];
+    }
+}
+
+// Parse conv*_grad_weight metadata; returns the number of filters (weight dims 0 and 1)
+static size_t conv_grad_weight_parse(const size_t *metadata, bool transposed, const void *input,
+                                     const void *grad_output, void *grad_weight,
+                                     conv_grad_weight_params_t *p) {
+    const size_t ndim = metadata[1];
+    const size_t spatial_dims = metadata[2];
+    const size_t *input_shape = metadata + 3;
+    const size_t *grad_output_shape = metadata + 3 + ndim;
+    const size_t *weight_shape = metadata + 3 + 2 * ndim;
+    const size_t *input_strides = metadata + 3 + 3 * ndim;
+    const size_t *grad_output_strides = metadata + 3 + 4 * ndim;
+    const size_t *offsets = metadata + 3 + 5 * ndim;
+    const size_t *conv_params = offsets + 2;
+    const size_t lead = 3 - spatial_dims;
+
+    conv_grad_weight_view_t input_view, grad_output_view;
+    conv_grad_weight_view_init(&input_view, input_shape, input_strides, offsets[0], ndim);
+    conv_grad_weight_view_init(&grad_output_view, grad_output_shape, grad_output_strides,
+                               offsets[1], ndim);
+
+    for (size_t d = 0; d < 3; d++) {
+        const bool unit = d < lead;
+        p->kernel[d] = unit ? 1 : weight_shape[2 + d - lead];
+        p->stride[d] = unit ? 1 : conv_params[d - lead];
+        p->padding[d] = unit ? 0 : conv_params[spatial_dims + d - lead];
+        p->dilation[d] = unit ? 1 : conv_params[2 * spatial_dims + d - lead];
+    }
+
+    p->grad_weight = grad_weight;
+    p->batch = input_shape[0];
+    if (transposed) {
+        p->outer_data = input;
+        p->outer = input_view;
+        p->inner_data = grad_output;
+        p->inner = grad_output_view;
+        p->inner_channels = grad_output_shape[1];
+    } else {
+        p->outer_data = grad_output;
+        p->outer = grad_output_view;
+        p->inner_data = input;
+        p->inner = input_view;
+        p->inner_channels = input_shape[1];
+    }
+
+    const size_t filters = weight_shape[0] * weight_shape[1];
+    const size_t work = p->batch * p->outer.shape[0] * p->outer.shape[1] * p->outer.shape[2] *
+                        p->kernel[0] * p->kernel[1] * p->kernel[2];
+    p->grain = work > 0 && work < CONV_GRAD_WEIGHT_GRAIN_WORK ? CONV_GRAD_WEIGHT_GRAIN_WORK / work
+                                                               : 1;
+    return filters;
+}
+
+// Copy of conv*_grad_weight metadata for contiguous operands at offset 0, with the
+// element counts of the input, grad_output and weight
+static void conv_grad_weight_contiguous(const size_t *metadata, size_t *contiguous,
+                                        size_t counts[3]) {
+    const size_t ndim = metadata[1];
+    const size_t len = 3 + 5 * ndim + 2 + 3 * metadata[2];
+    memcpy(contiguous, metadata, len * sizeof(size_t));
+    for (size_t t = 0; t < 3; t++) {
+        const size_t *shape = metadata + 3 + t * ndim;
+        size_t count = 1;
+        for (size_t d = ndim; d-- > 0;) {
+            if (t < 2)
+                contiguous[3 + (3 + t) * ndim + d] = count;
+            count *= shape[d];
+        }
+        counts[t] = count;
+    }
+    contiguous[3 + 5 * ndim] = 0;
+    contiguous[3 + 5 * ndim + 1] = 0;
+}
+
+/// Macro to implement the grad_weight engine (task and driver) for one type
+///
+/// @param TYPE C type for the operation
+/// @param TYPE_SUFFIX Suffix for function naming
+/// @param ACC_TYPE Accumulator type
+/// @param TO_ACC Conversion from TYPE to ACC_TYPE
+/// @param FROM_ACC Conversion from ACC_TYPE to TYPE
+#define CONV_GRAD_WEIGHT_ENGINE(TYPE, TYPE_SUFFIX, ACC_TYPE, TO_ACC, FROM_ACC)                     \
+    /* Filters [start, end): one register accumulator per tap */                                   \
+    static void conv_grad_weight_##TYPE_SUFFIX##_task(size_t start, size_t end, void *ctx) {       \
+        const conv_grad_weight_params_t *p = (const conv_grad_weight_params_t *)ctx;               \
+        const conv_grad_weight_view_t *o = &p->outer;                                              \
+        const conv_grad_weight_view_t *n = &p->inner;                                              \
+        const TYPE *outer = (const TYPE *)p->outer_data + o->offset;                               \
+        const TYPE *inner = (const TYPE *)p->inner_data + n->offset;                               \
+        const size_t taps = p->kernel[0] * p->kernel[1] * p->kernel[2];                            \
+                                                                                                   \
+        for (size_t item = start; item < end; item++) {                                            \
+            const size_t w0 = item / p->inner_channels;                                            \
+            const size_t w1 = item % p->inner_channels;                                            \
+            TYPE *grad_weight = (TYPE *)p->grad_weight + item * taps;                              \
+                                                                                                   \
+            for (size_t tap = 0; tap < taps; tap++) {                                              \
+                const size_t k[3] = {tap / (p->kernel[1] * p->kernel[2]),                          \
+                                     tap / p->kernel[2] % p->kernel[1], tap % p->kernel[2]};       \
+                long shift[3];                                                                     \
+                size_t lo[3], hi[3];                                                               \
+                for (size_t d = 0; d < 3; d++) {                                                   \
+                    shift[d] = (long)(k[d] * p->dilation[d]) - (long)p->padding[d];                \
+                    conv_tap_range(o->shape[d], p->stride[d], shift[d], n->shape[d], &lo[d],       \
+                                   &hi[d]);                                                        \
+                }                                                                                  \
+                                                                                                   \
+                ACC_TYPE acc = 0;                                                                  \
+                for (size_t b = 0; b < p->batch; b++) {                                            \
+                    const TYPE *ob = outer + b * o->strides[0] + w0 * o->strides[1];               \
+                    const TYPE *nb = inner + b * n->strides[0] + w1 * n->strides[1];               \
+                    for (size_t pd = lo[0]; pd < hi[0]; pd++) {                                    \
+                        const size_t qd = (size_t)((long)(pd * p->stride[0]) + shift[0]);          \
+                        for (size_t ph = lo[1]; ph < hi[1]; ph++) {                                \
+                            const size_t qh = (size_t)((long)(ph * p->stride[1]) + shift[1]);      \
+                            const TYPE *orow = ob + pd * o->strides[2] + ph * o->strides[3];       \
+                            const TYPE *nrow = nb + qd * n->strides[2] + qh * n->strides[3];       \
+                            for (size_t pw = lo[2]; pw < hi[2]; pw++) {                            \
+                                const size_t qw = (size_t)((long)(pw * p->stride[2]) + shift[2]);  \
+                                acc += (ACC_TYPE)TO_ACC(orow[pw * o->strides[4]]) *                \
+                                       (ACC_TYPE)TO_ACC(nrow[qw * n->strides[4]]);                 \
                             }                                                                      \
                         }                                                                          \
                     }                                                                              \
                 }                                                                                  \
+                grad_weight[tap] = FROM_ACC(acc);                                                  \
             }                                                                                      \
         }                                                                                          \
+    }                                                                                              \
+                                                                                                   \
+    static void conv_grad_weight_##TYPE_SUFFIX(const void *input, const void *grad_output,         \
+                                               void *grad_weight, const size_t *metadata,          \
+                                               bool transposed) {                                  \
+        conv_grad_weight_params_t p;                                                               \
+        const size_t filters =                                                                     \
+            conv_grad_weight_parse(metadata, transposed, input, grad_output, grad_weight, &p);     \
+        parallel_for(0, filters, p.grain, conv_grad_weight_##TYPE_SUFFIX##_task, &p);              \
     }
 
-CONV_TRANSPOSE3D_OP_EXOTIC(f8e4m3_t, f8e4m3, F8E4M3_ZERO, f8e4m3_add, f8e4m3_mul)
-CONV_TRANSPOSE3D_OP_EXOTIC(f8e5m2_t, f8e5m2, F8E5M2_ZERO, f8e5m2_add, f8e5m2_mul)
-CONV_TRANSPOSE3D_OP_EXOTIC(bf16_t, bf16, BF16_ZERO, bf16_add, bf16_mul)
-CONV_TRANSPOSE3D_OP_EXOTIC(f16_t, f16, F16_ZERO, f16_add, f16_mul)
-CONV_TRANSPOSE3D_OP(float, f32)
-CONV_TRANSPOSE3D_OP(double, f64)
+CONV_GRAD_WEIGHT_ENGINE(f8e4m3_t, f8e4m3, float, f8e4m3_to_float, float_to_f8e4m3)
+CONV_GRAD_WEIGHT_ENGINE(f8e5m2_t, f8e5m2, float, f8e5m2_to_float, float_to_f8e5m2)
+CONV_GRAD_WEIGHT_ENGINE(bf16_t, bf16, float, bf16_to_float, float_to_bf16)
+CONV_GRAD_WEIGHT_ENGINE(f16_t, f16, float, f16_to_float, float_to_f16)
+CONV_GRAD_WEIGHT_ENGINE(f32_t, f32, f32_t, CONV_GRAD_WEIGHT_IDENTITY, CONV_GRAD_WEIGHT_IDENTITY)
+CONV_GRAD_WEIGHT_ENGINE(f64_t, f64, f64_t, CONV_GRAD_WEIGHT_IDENTITY, CONV_GRAD_WEIGHT_IDENTITY)
+
+/// Macro to implement f32 widening for a low-precision grad_weight type
+///
+/// @param TYPE C type for the operation
+/// @param TYPE_SUFFIX Suffix for function naming
+/// @param TO_FLOAT Conversion from TYPE to float
+/// @param FROM_FLOAT Conversion from float to TYPE
+#define CONV_GRAD_WEIGHT_WIDEN(TYPE, TYPE_SUFFIX, TO_FLOAT, FROM_FLOAT)                            \
+    /* Copy a strided tensor into a contiguous f32 buffer */                                       \
+    static void conv_grad_weight_widen_##TYPE_SUFFIX(const TYPE *src, const size_t *shape,         \
+                                                     const size_t *strides, size_t ndim,           \
+                                                     float *dst, size_t count) {                   \
+        size_t idx[5] = {0};                                                                       \
+        size_t offset = 0;                                                                         \
+        for (size_t i = 0; i < count; i++) {                                                       \
+            dst[i] = TO_FLOAT(src[offset]);                                                        \
+            for (size_t d = ndim; d-- > 0;) {                                                      \
+                offset += strides[d];                                                              \
+                if (++idx[d] < shape[d])                                                           \
+                    break;                                                                         \
+                offset -= idx[d] * strides[d];                                                     \
+                idx[d] = 0;                                                                        \
+            }                                                                                      \
+        }                                                                                          \
+    }                                                                                              \
+                                                                                                   \
+    /* Run f32_kernel on widened copies; in-type engine if they cannot be allocated */             \
+    static void conv_grad_weight_widened_##TYPE_SUFFIX(                                            \
+        void (*f32_kernel)(const void *, const void *, void *, const size_t *), const void *input, \
+        const void *grad_output, void *grad_weight, const size_t *metadata, bool transposed) {     \
+        const size_t ndim = metadata[1];                                                           \
+        size_t contiguous[64];                                                                     \
+        size_t counts[3];                                                                          \
+        if (ndim > 5) {                                                                            \
+            conv_grad_weight_##TYPE_SUFFIX(input, grad_output, grad_weight, metadata, transposed); \
+            return;                                                                                \
+        }                                                                                          \
+        conv_grad_weight_contiguous(metadata, contiguous, counts);                                 \
+                                                                                                   \
+        const size_t input_bytes = hodu_cpu_workspace_block_size(counts[0] * sizeof(float));       \
+        const size_t grad_output_bytes = hodu_cpu_workspace_block_size(counts[1] * sizeof(float)); \
+        const size_t grad_weight_bytes = counts[2] * sizeof(float);                                \
+        float *wide_input =                                                                        \
+            (float *)workspace_acquire(input_bytes + grad_output_bytes + grad_weight_bytes);       \
+        if (!wide_input) {                                                                         \
+            conv_grad_weight_##TYPE_SUFFIX(input, grad_output, grad_weight, metadata, transposed); \
+            return;                                                                                \
+        }                                                                                          \
+        float *wide_grad_output = (float *)((char *)wide_input + input_bytes);                     \
+        float *wide_grad_weight = (float *)((char *)wide_grad_output + grad_output_bytes);         \
+                                                                                                   \
+        const size_t *offsets = metadata + 3 + 5 * ndim;                                           \
+        conv_grad_weight_widen_##TYPE_SUFFIX((const TYPE *)input + offsets[0], metadata + 3,       \
+                                             metadata + 3 + 3 * ndim, ndim, wide_input,            \
+                                             counts[0]);                                           \
+        conv_grad_weight_widen_##TYPE_SUFFIX((const TYPE *)grad_output + offsets[1],               \
+                                             metadata + 3 + ndim, metadata + 3 + 4 * ndim, ndim,   \
+                                             wide_grad_output, counts[1]);                         \
+        f32_kernel(wide_input, wide_grad_output, wide_grad_weight, contiguous);                    \
+        for (size_t i = 0; i < counts[2]; i++)                                                     \
+            ((TYPE *)grad_weight)[i] = FROM_FLOAT(wide_grad_weight[i]);                            \
+                                                                                                   \
+        workspace_release(wide_input);                                                             \
+    }
+
+CONV_GRAD_WEIGHT_WIDEN(f8e4m3_t, f8e4m3, f8e4m3_to_float, float_to_f8e4m3)
+CONV_GRAD_WEIGHT_WIDEN(f8e5m2_t, f8e5m2, f8e5m2_to_float, float_to_f8e5m2)
+CONV_GRAD_WEIGHT_WIDEN(bf16_t, bf16, bf16_to_float, float_to_bf16)
+CONV_GRAD_WEIGHT_WIDEN(f16_t, f16, f16_to_float, float_to_f16)
+
+// Spatial dims of a convolution op name: the digit before "d" (conv1d -> 1, conv_transpose3d -> 3)
+#define CONV_SPATIAL_DIMS(OP) ((size_t)(#OP[sizeof(#OP) - 3] - '0'))
+
+/// Macro to implement an exported grad_weight kernel on the engine
+///
+/// @param OP Operation name (conv1d, conv_transpose2d, ...)
+/// @param TYPE_SUFFIX Engine type suffix
+/// @param FN_SUFFIX Suffix for function naming
+/// @param TRANSPOSED Whether OP is a transposed convolution
+#define CONV_GRAD_WEIGHT_OP(OP, TYPE_SUFFIX, FN_SUFFIX, TRANSPOSED)                                \
+    void hodu_cpu_##OP##_grad_weight_##FN_SUFFIX(const void *input_ptr,                            \
+                                                 const void *grad_output_ptr,                      \
+                                                 void *grad_weight_ptr, const size_t *metadata) {  \
+        HODU_PROFILE_KERNEL(hodu_cpu_profile_conv_bytes(metadata, CONV_SPATIAL_DIMS(OP),           \
+                                                        sizeof(TYPE_SUFFIX##_t)));                 \
+        conv_grad_weight_##TYPE_SUFFIX(input_ptr, grad_output_ptr, grad_weight_ptr, metadata,      \
+                                       TRANSPOSED);                                                \
+    }
+
+/// Macro to implement an exported low-precision grad_weight kernel (f32 widening)
+///
+/// @param OP Operation name (conv1d, conv_transpose2d, ...)
+/// @param TYPE_SUFFIX Suffix for function naming
+/// @param TRANSPOSED Whether OP is a transposed convolution
+#define CONV_GRAD_WEIGHT_OP_EXOTIC(OP, TYPE_SUFFIX, TRANSPOSED)                                    \
+    void hodu_cpu_##OP##_grad_weight_##TYPE_SUFFIX(const void *input_ptr,                          \
+                                                   const void *grad_output_ptr,                    \
+                                                   void *grad_weight_ptr,                          \
+                                                   const size_t *metadata) {                       \
+        HODU_PROFILE_KERNEL(hodu_cpu_profile_conv_bytes(metadata, CONV_SPATIAL_DIMS(OP),           \
+                                                        sizeof(TYPE_SUFFIX##_t)));                 \
+        conv_grad_weight_widened_##TYPE_SUFFIX(hodu_cpu_##OP##_grad_weight_f32, input_ptr,         \
+                                               grad_output_ptr, grad_weight_ptr, metadata,         \
+                                               TRANSPOSED);                                        \
+    }
 
 // ============================================================================
 // 1D CONVOLUTION GRADIENT WEIGHT OPERATIONS
 // ============================================================================
 //
 // Computes gradients with respect to convolution weights for backpropagation.
-// Uses atomic operations to handle concurrent updates from multiple threads.
+// All grad_weight kernels run on the engine above.
 //
 // Metadata layout for conv1d_grad_weight:
 // - metadata[0]: num_els (total number of grad_weight elements)
@@ -1007,149 +2470,12 @@ CONV_TRANSPOSE3D_OP(double, f64)
 // - metadata[10]: input_offset
 // - metadata[11]: grad_output_offset
 
-/// Macro to implement 1D convolution gradient weight operation
-///
-/// @param TYPE C type for the operation
-/// @param TYPE_SUFFIX Suffix for function naming
-/// @param ATOMIC_ADD_FN Atomic addition function for thread-safe updates
-#define CONV1D_GRAD_WEIGHT_OP(TYPE, TYPE_SUFFIX, ATOMIC_ADD_FN)                                    \
-    void hodu_cpu_conv1d_grad_weight_##TYPE_SUFFIX(                                                \
-        const void *input_ptr, const void *grad_output_ptr, void *grad_weight_ptr,                 \
-        const size_t *metadata) {                                                                  \
-        const TYPE *input = (const TYPE *)input_ptr;                                               \
-        const TYPE *grad_output = (const TYPE *)grad_output_ptr;                                   \
-        TYPE *grad_weight = (TYPE *)grad_weight_ptr;                                               \
-                                                                                                   \
-        /* Parse generic metadata: Conv1D has input_ndim=3, spatial_dims=1 */                      \
-        const size_t num_els = metadata[0];                                                        \
-        const size_t input_ndim = metadata[1];                                                     \
-        const size_t spatial_dims = metadata[2];                                                   \
-        const size_t batch = metadata[3];                                                          \
-        const size_t in_channels = metadata[4];                                                    \
-        const size_t in_width = metadata[5];                                                       \
-        const size_t grad_output_base = 3 + input_ndim;                                            \
-        const size_t out_channels = metadata[grad_output_base + 1];                                \
-        const size_t out_width = metadata[grad_output_base + 2];                                   \
-        const size_t weight_base = 3 + 2 * input_ndim;                                             \
-        const size_t kernel_width = metadata[weight_base + 2];                                     \
-        const size_t grad_output_stride_base = 3 + 4 * input_ndim;                                 \
-        const size_t grad_output_stride_batch = metadata[grad_output_stride_base];                 \
-        const size_t grad_output_stride_channel = metadata[grad_output_stride_base + 1];           \
-        const size_t grad_output_stride_w = metadata[grad_output_stride_base + 2];                 \
-        const size_t offsets_base = 3 + 5 * input_ndim;                                            \
-        const size_t input_offset = metadata[offsets_base];                                        \
-        const size_t grad_output_offset = metadata[offsets_base + 1];                              \
-        const size_t conv_params_base = offsets_base + 2;                                          \
-        const size_t stride = metadata[conv_params_base];                                          \
-        const size_t padding = metadata[conv_params_base + spatial_dims];                          \
-        const size_t dilation = metadata[conv_params_base + 2 * spatial_dims];                     \
-                                                                                                   \
-        memset(grad_weight, 0, num_els * sizeof(TYPE));                                            \
-                                                                                                   \
-        for (size_t b = 0; b < batch; b++) {                                                       \
-            for (size_t oc = 0; oc < out_channels; oc++) {                                         \
-                for (size_t ow = 0; ow < out_width; ow++) {                                        \
-                    const size_t grad_output_idx =                                                 \
-                        grad_output_offset + b * grad_output_stride_batch +                        \
-                        oc * grad_output_stride_channel + ow * grad_output_stride_w;               \
-                    const TYPE grad_out_val = grad_output[grad_output_idx];                        \
-                                                                                                   \
-                    for (size_t ic = 0; ic < in_channels; ic++) {                                  \
-                        for (size_t kw = 0; kw < kernel_width; kw++) {                             \
-                            const int iw =                                                         \
-                                (int)(ow * stride) - (int)padding + (int)(kw * dilation);          \
-                            if (iw >= 0 && iw < (int)in_width) {                                   \
-                                const size_t input_idx = input_offset +                            \
-                                                         b * in_channels * in_width +              \
-                                                         ic * in_width + iw;                       \
-                                const size_t weight_idx =                                          \
-                                    oc * in_channels * kernel_width + ic * kernel_width + kw;      \
-                                const TYPE contribution = input[input_idx] * grad_out_val;         \
-                                ATOMIC_ADD_FN(&grad_weight[weight_idx], contribution);             \
-                            }                                                                      \
-                        }                                                                          \
-                    }                                                                              \
-                }                                                                                  \
-            }                                                                                      \
-        }                                                                                          \
-    }
-
-/// Macro to implement 1D convolution gradient weight operation for exotic types
-///
-/// @param TYPE C type for the operation
-/// @param TYPE_SUFFIX Suffix for function naming
-/// @param ZERO Zero constant
-/// @param MUL_FN Multiplication function
-/// @param ATOMIC_ADD_FN Atomic addition function for thread-safe updates
-#define CONV1D_GRAD_WEIGHT_OP_EXOTIC(TYPE, TYPE_SUFFIX, ZERO, MUL_FN, ATOMIC_ADD_FN)               \
-    void hodu_cpu_conv1d_grad_weight_##TYPE_SUFFIX(                                                \
-        const void *input_ptr, const void *grad_output_ptr, void *grad_weight_ptr,                 \
-        const size_t *metadata) {                                                                  \
-        const TYPE *input = (const TYPE *)input_ptr;                                               \
-        const TYPE *grad_output = (const TYPE *)grad_output_ptr;                                   \
-        TYPE *grad_weight = (TYPE *)grad_weight_ptr;                                               \
-                                                                                                   \
-        /* Parse generic metadata: Conv1D has input_ndim=3, spatial_dims=1 */                      \
-        const size_t num_els = metadata[0];                                                        \
-        const size_t input_ndim = metadata[1];                                                     \
-        const size_t spatial_dims = metadata[2];                                                   \
-        const size_t batch = metadata[3];                                                          \
-        const size_t in_channels = metadata[4];                                                    \
-        const size_t in_width = metadata[5];                                                       \
-        const size_t grad_output_base = 3 + input_ndim;                                            \
-        const size_t out_channels = metadata[grad_output_base + 1];                                \
-        const size_t out_width = metadata[grad_output_base + 2];                                   \
-        const size_t weight_base = 3 + 2 * input_ndim;                                             \
-        const size_t kernel_width = metadata[weight_base + 2];                                     \
-        const size_t grad_output_stride_base = 3 + 4 * input_ndim;                                 \
-        const size_t grad_output_stride_batch = metadata[grad_output_stride_base];                 \
-        const size_t grad_output_stride_channel = metadata[grad_output_stride_base + 1];           \
-        const size_t grad_output_stride_w = metadata[grad_output_stride_base + 2];                 \
-        const size_t offsets_base = 3 + 5 * input_ndim;                                            \
-        const size_t input_offset = metadata[offsets_base];                                        \
-        const size_t grad_output_offset = metadata[offsets_base + 1];                              \
-        const size_t conv_params_base = offsets_base + 2;                                          \
-        const size_t stride = metadata[conv_params_base];                                          \
-        const size_t padding = metadata[conv_params_base + spatial_dims];                          \
-        const size_t dilation = metadata[conv_params_base + 2 * spatial_dims];                     \
-                                                                                                   \
-        for (size_t i = 0; i < num_els; i++)                                                       \
-            grad_weight[i] = ZERO;                                                                 \
-                                                                                                   \
-        for (size_t b = 0; b < batch; b++) {                                                       \
-            for (size_t oc = 0; oc < out_channels; oc++) {                                         \
-                for (size_t ow = 0; ow < out_width; ow++) {                                        \
-                    const size_t grad_output_idx =                                                 \
-                        grad_output_offset + b * grad_output_stride_batch +                        \
-                        oc * grad_output_stride_channel + ow * grad_output_stride_w;               \
-                    const TYPE grad_out_val = grad_output[grad_output_idx];                        \
-                                                                                                   \
-                    for (size_t ic = 0; ic < in_channels; ic++) {                                  \
-                        for (size_t kw = 0; kw < kernel_width; kw++) {                             \
-                            const int iw =                                                         \
-                                (int)(ow * stride) - (int)padding + (int)(kw * dilation);          \
-                            if (iw >= 0 && iw < (int)in_width) {                                   \
-                                const size_t input_idx = input_offset +                            \
-                                                         b * in_channels * in_width +              \
-                                                         ic * in_width + iw;                       \
-                                const size_t weight_idx =                                          \
-                                    oc * in_channels * kernel_width + ic * kernel_width + kw;      \
-                                const TYPE contribution = MUL_FN(input[input_idx], grad_out_val);  \
-                                ATOMIC_ADD_FN(&grad_weight[weight_idx], contribution);             \
-                            }                                                                      \
-                        }                                                                          \
-                    }                                                                              \
-                }                                                                                  \
-            }                                                                                      \
-        }                                                                                          \
-    }
-
-CONV1D_GRAD_WEIGHT_OP_EXOTIC(f8e4m3_t, f8e4m3, F8E4M3_ZERO, f8e4m3_mul, atomic_add_f8e4m3)
-CONV1D_GRAD_WEIGHT_OP_EXOTIC(f8e5m2_t, f8e5m2, F8E5M2_ZERO, f8e5m2_mul, atomic_add_f8e5m2)
-CONV1D_GRAD_WEIGHT_OP_EXOTIC(bf16_t, bf16, BF16_ZERO, bf16_mul, atomic_add_bf16)
-CONV1D_GRAD_WEIGHT_OP_EXOTIC(f16_t, f16, F16_ZERO, f16_mul, atomic_add_f16)
-CONV1D_GRAD_WEIGHT_OP(float, f32, atomic_add_f32)
-CONV1D_GRAD_WEIGHT_OP(double, f64, atomic_add_f64)
+CONV_GRAD_WEIGHT_OP_EXOTIC(conv1d, f8e4m3, false)
+CONV_GRAD_WEIGHT_OP_EXOTIC(conv1d, f8e5m2, false)
+CONV_GRAD_WEIGHT_OP_EXOTIC(conv1d, bf16, false)
+CONV_GRAD_WEIGHT_OP_EXOTIC(conv1d, f16, false)
+CONV_GRAD_WEIGHT_OP(conv1d, f32, f32, false)
+CONV_GRAD_WEIGHT_OP(conv1d, f64, f64, false)
 
 // ============================================================================
 // 2D CONVOLUTION GRADIENT WEIGHT OPERATIONS
@@ -1175,187 +2501,212 @@ CONV1D_GRAD_WEIGHT_OP(double, f64, atomic_add_f64)
 // - metadata[16]: input_offset
 // - metadata[17]: grad_output_offset
 
-/// Macro to implement 2D convolution gradient weight operation
+CONV_GRAD_WEIGHT_OP_EXOTIC(conv2d, f8e4m3, false)
+CONV_GRAD_WEIGHT_OP_EXOTIC(conv2d, f8e5m2, false)
+CONV_GRAD_WEIGHT_OP_EXOTIC(conv2d, bf16, false)
+CONV_GRAD_WEIGHT_OP_EXOTIC(conv2d, f16, false)
+CONV_GRAD_WEIGHT_OP(conv2d, f32, f32_fallback, false)
+CONV_GRAD_WEIGHT_OP(conv2d, f64, f64_fallback, false)
+
+#ifndef USE_BLAS
+// Without BLAS, f32/f64 conv2d_grad_weight with a contiguous input and
+// row-contiguous grad_output planes runs as GEMMs over the im2col'd input:
+//   grad_weight[oc, k] = sum_b sum_n grad_output[b, oc, n] * col_b[k, n]
+// With at least one sample per thread, samples are split into one chunk per
+// thread; each chunk accumulates a private [oc, K] partial (chunk 0 directly in
+// grad_weight) with single-threaded GEMMs, and the partials are then summed in
+// a fixed pairwise tree, so the result does not depend on scheduling. Smaller
+// batches run one pool-parallel GEMM per sample. Other layouts, and scratch
+// allocation failures, use the engine above.
+
+// Elements of grad_weight per reduction chunk
+#define CONV2D_GRAD_WEIGHT_REDUCE_GRAIN 4096
+
+// Read conv2d_grad_weight metadata as conv2d parameters (weight_offset holds the
+// grad_output offset); false when the layout does not suit the GEMM path
+static bool conv2d_grad_weight_gemm_params(const size_t *metadata, conv2d_params_t *p,
+                                           size_t *grad_output_strides) {
+    if (metadata[1] != 4 || metadata[2] != 2)
+        return false;
+    const size_t *input_shape = metadata + 3;
+    const size_t *grad_output_shape = metadata + 7;
+    const size_t *weight_shape = metadata + 11;
+    const size_t *input_strides = metadata + 15;
+    const size_t *offsets = metadata + 23;
+    const size_t *conv_params = metadata + 25;
+    grad_output_strides[0] = metadata[19];
+    grad_output_strides[1] = metadata[20];
+
+    p->batch = input_shape[0];
+    p->in_channels = input_shape[1];
+    p->out_channels = grad_output_shape[1];
+    p->in_height = input_shape[2];
+    p->in_width = input_shape[3];
+    p->kernel_height = weight_shape[2];
+    p->kernel_width = weight_shape[3];
+    p->out_height = grad_output_shape[2];
+    p->out_width = grad_output_shape[3];
+    p->stride_h = conv_params[0];
+    p->stride_w = conv_params[1];
+    p->padding_h = conv_params[2];
+    p->padding_w = conv_params[3];
+    p->dilation_h = conv_params[4];
+    p->dilation_w = conv_params[5];
+    p->input_offset = offsets[0];
+    p->weight_offset = offsets[1];
+
+    // im2col reads each sample as contiguous planes; the GEMM reads grad_output rows
+    size_t expected = 1;
+    for (size_t d = 4; d-- > 0;) {
+        if (input_shape[d] != 1 && input_strides[d] != expected)
+            return false;
+        expected *= input_shape[d];
+    }
+    const size_t grad_output_h = metadata[21];
+    const size_t grad_output_w = metadata[22];
+    return (p->out_width == 1 || grad_output_w == 1) &&
+           (p->out_height == 1 || grad_output_h == p->out_width);
+}
+
+/// Macro to implement GEMM-based conv2d_grad_weight
 ///
 /// @param TYPE C type for the operation
 /// @param TYPE_SUFFIX Suffix for function naming
-/// @param ATOMIC_ADD_FN Atomic addition function for thread-safe updates
-#define CONV2D_GRAD_WEIGHT_OP(TYPE, TYPE_SUFFIX, ATOMIC_ADD_FN)                                    \
-    void hodu_cpu_conv2d_grad_weight_##TYPE_SUFFIX(                                                \
-        const void *input_ptr, const void *grad_output_ptr, void *grad_weight_ptr,                 \
-        const size_t *metadata) {                                                                  \
-        const TYPE *input = (const TYPE *)input_ptr;                                               \
-        const TYPE *grad_output = (const TYPE *)grad_output_ptr;                                   \
-        TYPE *grad_weight = (TYPE *)grad_weight_ptr;                                               \
-                                                                                                   \
-        /* Parse generic metadata: Conv2D has input_ndim=4, spatial_dims=2 */                      \
-        const size_t num_els = metadata[0];                                                        \
-        const size_t input_ndim = metadata[1];                                                     \
-        const size_t spatial_dims = metadata[2];                                                   \
-        const size_t batch = metadata[3];                                                          \
-        const size_t in_channels = metadata[4];                                                    \
-        const size_t in_height = metadata[5];                                                      \
-        const size_t in_width = metadata[6];                                                       \
-        const size_t grad_output_base = 3 + input_ndim;                                            \
-        const size_t out_channels = metadata[grad_output_base + 1];                                \
-        const size_t out_height = metadata[grad_output_base + 2];                                  \
-        const size_t out_width = metadata[grad_output_base + 3];                                   \
-        const size_t weight_base = 3 + 2 * input_ndim;                                             \
-        const size_t kernel_height = metadata[weight_base + 2];                                    \
-        const size_t kernel_width = metadata[weight_base + 3];                                     \
-        const size_t grad_output_stride_base = 3 + 4 * input_ndim;                                 \
-        const size_t grad_output_stride_batch = metadata[grad_output_stride_base];                 \
-        const size_t grad_output_stride_channel = metadata[grad_output_stride_base + 1];           \
-        const size_t grad_output_stride_h = metadata[grad_output_stride_base + 2];                 \
-        const size_t grad_output_stride_w = metadata[grad_output_stride_base + 3];                 \
-        const size_t offsets_base = 3 + 5 * input_ndim;                                            \
-        const size_t input_offset = metadata[offsets_base];                                        \
-        const size_t grad_output_offset = metadata[offsets_base + 1];                              \
-        const size_t conv_params_base = offsets_base + 2;                                          \
-        const size_t stride_h = metadata[conv_params_base];                                        \
-        const size_t stride_w = metadata[conv_params_base + 1];                                    \
-        const size_t padding_h = metadata[conv_params_base + spatial_dims];                        \
-        const size_t padding_w = metadata[conv_params_base + spatial_dims + 1];                    \
-        const size_t dilation_h = metadata[conv_params_base + 2 * spatial_dims];                   \
-        const size_t dilation_w = metadata[conv_params_base + 2 * spatial_dims + 1];               \
-                                                                                                   \
-        memset(grad_weight, 0, num_els * sizeof(TYPE));                                            \
-                                                                                                   \
-        for (size_t b = 0; b < batch; b++) {                                                       \
-            for (size_t oc = 0; oc < out_channels; oc++) {                                         \
-                for (size_t oh = 0; oh < out_height; oh++) {                                       \
-                    for (size_t ow = 0; ow < out_width; ow++) {                                    \
-                        const size_t grad_output_idx =                                             \
-                            grad_output_offset + b * grad_output_stride_batch +                    \
-                            oc * grad_output_stride_channel + oh * grad_output_stride_h +          \
-                            ow * grad_output_stride_w;                                             \
-                        const TYPE grad_out_val = grad_output[grad_output_idx];                    \
-                                                                                                   \
-                        for (size_t ic = 0; ic < in_channels; ic++) {                              \
-                            for (size_t kh = 0; kh < kernel_height; kh++) {                        \
-                                for (size_t kw = 0; kw < kernel_width; kw++) {                     \
-                                    const int ih = (int)(oh * stride_h) - (int)padding_h +         \
-                                                   (int)(kh * dilation_h);                         \
-                                    const int iw = (int)(ow * stride_w) - (int)padding_w +         \
-                                                   (int)(kw * dilation_w);                         \
-                                    if (ih >= 0 && ih < (int)in_height && iw >= 0 &&               \
-                                        iw < (int)in_width) {                                      \
-                                        const size_t input_idx =                                   \
-                                            input_offset +                                         \
-                                            b * in_channels * in_height * in_width +               \
-                                            ic * in_height * in_width + ih * in_width + iw;        \
-                                        const size_t weight_idx =                                  \
-                                            oc * in_channels * kernel_height * kernel_width +      \
-                                            ic * kernel_height * kernel_width +                    \
-                                            kh * kernel_width + kw;                                \
-                                        const TYPE contribution = input[input_idx] * grad_out_val; \
-                                        ATOMIC_ADD_FN(&grad_weight[weight_idx], contribution);     \
-                                    }                                                              \
-                                }                                                                  \
-                            }                                                                      \
-                        }                                                                          \
-                    }                                                                              \
+#define CONV2D_GRAD_WEIGHT_GEMM_OP(TYPE, TYPE_SUFFIX)                                              \
+    typedef struct {                                                                               \
+        conv2d_params_t p;                                                                         \
+        const TYPE *input;       /* sample 0 */                                                    \
+        const TYPE *grad_output; /* sample 0 */                                                    \
+        TYPE *grad_weight;                                                                         \
+        TYPE *partials;        /* chunks - 1 partials of M * K */                                  \
+        unsigned char *failed; /* per chunk: scratch allocation failed */                          \
+        size_t grad_output_strides[2];                                                             \
+        size_t chunks, M, K, N;                                                                    \
+    } conv2d_grad_weight_gemm_##TYPE_SUFFIX##_args_t;                                              \
+                                                                                                   \
+    /* Chunks [start, end): accumulate the samples of each chunk into its partial */               \
+    static void conv2d_grad_weight_gemm_##TYPE_SUFFIX##_task(size_t start, size_t end,             \
+                                                             void *ctx) {                          \
+        const conv2d_grad_weight_gemm_##TYPE_SUFFIX##_args_t *a =                                  \
+            (const conv2d_grad_weight_gemm_##TYPE_SUFFIX##_args_t *)ctx;                           \
+        const conv2d_params_t *p = &a->p;                                                          \
+        const size_t MK = a->M * a->K;                                                             \
+        const size_t col_bytes = hodu_cpu_workspace_block_size(a->K * a->N * sizeof(TYPE));        \
+                                                                                                   \
+        /* Column matrix [K, N] and, for multi-sample chunks, a [M, K] product */                  \
+        TYPE *col = (TYPE *)workspace_acquire(col_bytes + MK * sizeof(TYPE));                      \
+        TYPE *product = (TYPE *)((char *)col + col_bytes);                                         \
+        for (size_t c = start; c < end && col; c++) {                                              \
+            TYPE *acc = c == 0 ? a->grad_weight : a->partials + (c - 1) * MK;                      \
+            const size_t b0 = c * p->batch / a->chunks;                                            \
+            const size_t b1 = (c + 1) * p->batch / a->chunks;                                      \
+            for (size_t b = b0; b < b1; b++) {                                                     \
+                conv2d_im2col_##TYPE_SUFFIX(                                                       \
+                    a->input + b * p->in_channels * p->in_height * p->in_width, col,               \
+                    p->in_channels, p->in_height, p->in_width, p->kernel_height, p->kernel_width,  \
+                    p->out_height, p->out_width, p->stride_h, p->stride_w, p->padding_h,           \
+                    p->padding_w, p->dilation_h, p->dilation_w);                                   \
+                TYPE *dst = b == b0 ? acc : product;                                               \
+                hodu_cpu_gemm_##TYPE_SUFFIX(a->M, a->K, a->N,                                      \
+                                            a->grad_output + b * a->grad_output_strides[0],        \
+                                            a->grad_output_strides[1], 1, col, 1, a->N, dst,       \
+                                            a->K);                                                 \
+                if (dst == product) {                                                              \
+                    for (size_t i = 0; i < MK; i++)                                                \
+                        acc[i] += product[i];                                                      \
                 }                                                                                  \
             }                                                                                      \
         }                                                                                          \
-    }
-
-/// Macro to implement 2D convolution gradient weight operation for exotic types
-///
-/// @param TYPE C type for the operation
-/// @param TYPE_SUFFIX Suffix for function naming
-/// @param ZERO Zero constant
-/// @param MUL_FN Multiplication function
-/// @param ATOMIC_ADD_FN Atomic addition function for thread-safe updates
-#define CONV2D_GRAD_WEIGHT_OP_EXOTIC(TYPE, TYPE_SUFFIX, ZERO, MUL_FN, ATOMIC_ADD_FN)               \
-    void hodu_cpu_conv2d_grad_weight_##TYPE_SUFFIX(                                                \
-        const void *input_ptr, const void *grad_output_ptr, void *grad_weight_ptr,                 \
-        const size_t *metadata) {                                                                  \
-        const TYPE *input = (const TYPE *)input_ptr;                                               \
-        const TYPE *grad_output = (const TYPE *)grad_output_ptr;                                   \
-        TYPE *grad_weight = (TYPE *)grad_weight_ptr;                                               \
-                                                                                                   \
-        /* Parse generic metadata: Conv2D has input_ndim=4, spatial_dims=2 */                      \
-        const size_t num_els = metadata[0];                                                        \
-        const size_t input_ndim = metadata[1];                                                     \
-        const size_t spatial_dims = metadata[2];                                                   \
-        const size_t batch = metadata[3];                                                          \
-        const size_t in_channels = metadata[4];                                                    \
-        const size_t in_height = metadata[5];                                                      \
-        const size_t in_width = metadata[6];                                                       \
-        const size_t grad_output_base = 3 + input_ndim;                                            \
-        const size_t out_channels = metadata[grad_output_base + 1];                                \
-        const size_t out_height = metadata[grad_output_base + 2];                                  \
-        const size_t out_width = metadata[grad_output_base + 3];                                   \
-        const size_t weight_base = 3 + 2 * input_ndim;                                             \
-        const size_t kernel_height = metadata[weight_base + 2];                                    \
-        const size_t kernel_width = metadata[weight_base + 3];                                     \
-        const size_t grad_output_stride_base = 3 + 4 * input_ndim;                                 \
-        const size_t grad_output_stride_batch = metadata[grad_output_stride_base];                 \
-        const size_t grad_output_stride_channel = metadata[grad_output_stride_base + 1];           \
-        const size_t grad_output_stride_h = metadata[grad_output_stride_base + 2];                 \
-        const size_t grad_output_stride_w = metadata[grad_output_stride_base + 3];                 \
-        const size_t offsets_base = 3 + 5 * input_ndim;                                            \
-        const size_t input_offset = metadata[offsets_base];                                        \
-        const size_t grad_output_offset = metadata[offsets_base + 1];                              \
-        const size_t conv_params_base = offsets_base + 2;                                          \
-        const size_t stride_h = metadata[conv_params_base];                                        \
-        const size_t stride_w = metadata[conv_params_base + 1];                                    \
-        const size_t padding_h = metadata[conv_params_base + spatial_dims];                        \
-        const size_t padding_w = metadata[conv_params_base + spatial_dims + 1];                    \
-        const size_t dilation_h = metadata[conv_params_base + 2 * spatial_dims];                   \
-        const size_t dilation_w = metadata[conv_params_base + 2 * spatial_dims + 1];               \
+        if (!col) {                                                                                \
+            memset(a->failed + start, 1, end - start);                                             \
+        }                                                                                          \
+        workspace_release(col);                                                                    \
+    }                                                                                              \
+                                                                                                   \
+    /* Elements [start, end): pairwise tree sum of the chunk partials into grad_weight */          \
+    static void conv2d_grad_weight_reduce_##TYPE_SUFFIX##_task(size_t start, size_t end,           \
+                                                               void *ctx) {                        \
+        const conv2d_grad_weight_gemm_##TYPE_SUFFIX##_args_t *a =                                  \
+            (const conv2d_grad_weight_gemm_##TYPE_SUFFIX##_args_t *)ctx;                           \
+        const size_t MK = a->M * a->K;                                                             \
+        for (size_t step = 1; step < a->chunks; step *= 2) {                                       \
+            for (size_t c = 0; c + step < a->chunks; c += 2 * step) {                              \
+                TYPE *dst = c == 0 ? a->grad_weight : a->partials + (c - 1) * MK;                  \
+                const TYPE *src = a->partials + (c + step - 1) * MK;                               \
+                for (size_t i = start; i < end; i++)                                               \
+                    dst[i] += src[i];                                                              \
+            }                                                                                      \
+        }                                                                                          \
+    }                                                                                              \
+                                                                                                   \
+    void hodu_cpu_conv2d_grad_weight_##TYPE_SUFFIX(const void *input_ptr,                          \
+                                                   const void *grad_output_ptr,                    \
+                                                   void *grad_weight_ptr,                          \
+                                                   const size_t *metadata) {                       \
+        HODU_PROFILE_KERNEL(hodu_cpu_profile_conv_bytes(metadata, 2, sizeof(TYPE)));               \
+        conv2d_grad_weight_gemm_##TYPE_SUFFIX##_args_t a;                                          \
+        if (!conv2d_grad_weight_gemm_params(metadata, &a.p, a.grad_output_strides)) {              \
+            hodu_cpu_conv2d_grad_weight_##TYPE_SUFFIX##_fallback(input_ptr, grad_output_ptr,       \
+                                                                 grad_weight_ptr, metadata);       \
+            return;                                                                                \
+        }                                                                                          \
+        const conv2d_params_t *p = &a.p;                                                           \
+        a.M = p->out_channels;                                                                     \
+        a.K = p->in_channels * p->kernel_height * p->kernel_width;                                 \
+        a.N = p->out_height * p->out_width;                                                        \
+        a.input = (const TYPE *)input_ptr + p->input_offset;                                       \
+        a.grad_output = (const TYPE *)grad_output_ptr + p->weight_offset;                          \
+        a.grad_weight = (TYPE *)grad_weight_ptr;                                                   \
+        const size_t MK = a.M * a.K;                                                               \
+        if (MK == 0)                                                                               \
+            return;                                                                                \
+        if (p->batch == 0 || a.N == 0) {                                                           \
+            memset(grad_weight_ptr, 0, MK * sizeof(TYPE));                                         \
+            return;                                                                                \
+        }                                                                                          \
                                                                                                    \
-        for (size_t i = 0; i < num_els; i++)                                                       \
-            grad_weight[i] = ZERO;                                                                 \
+        /* Deterministic mode: chunks (and the merge tree) fixed by the batch size */              \
+        const size_t threads = get_num_threads();                                                  \
+        if (is_deterministic()) {                                                                  \
+            a.chunks = p->batch < DETERMINISTIC_THREADS ? p->batch : DETERMINISTIC_THREADS;        \
+        } else {                                                                                   \
+            a.chunks = p->batch >= threads ? threads : 1;                                          \
+        }                                                                                          \
+        const size_t partial_bytes =                                                               \
+            hodu_cpu_workspace_block_size((a.chunks - 1) * MK * sizeof(TYPE));                     \
+        void *scratch = workspace_acquire(partial_bytes + a.chunks);                               \
+        if (!scratch) {                                                                            \
+            hodu_cpu_conv2d_grad_weight_##TYPE_SUFFIX##_fallback(input_ptr, grad_output_ptr,       \
+                                                                 grad_weight_ptr, metadata);       \
+            return;                                                                                \
+        }                                                                                          \
+        a.partials = (TYPE *)scratch;                                                              \
+        a.failed = (unsigned char *)scratch + partial_bytes;                                       \
+        memset(a.failed, 0, a.chunks);                                                             \
+                                                                                                   \
+        if (a.chunks > 1) {                                                                        \
+            parallel_for(0, a.chunks, 1, conv2d_grad_weight_gemm_##TYPE_SUFFIX##_task, &a);        \
+        } else {                                                                                   \
+            conv2d_grad_weight_gemm_##TYPE_SUFFIX##_task(0, 1, &a);                                \
+        }                                                                                          \
+        bool failed = false;                                                                       \
+        for (size_t c = 0; c < a.chunks; c++)                                                      \
+            failed = failed || a.failed[c];                                                        \
+        if (!failed && a.chunks > 1) {                                                             \
+            parallel_for(0, MK, CONV2D_GRAD_WEIGHT_REDUCE_GRAIN,                                   \
+                         conv2d_grad_weight_reduce_##TYPE_SUFFIX##_task, &a);                      \
+        }                                                                                          \
+        workspace_release(scratch);                                                                \
                                                                                                    \
-        for (size_t b = 0; b < batch; b++) {                                                       \
-            for (size_t oc = 0; oc < out_channels; oc++) {                                         \
-                for (size_t oh = 0; oh < out_height; oh++) {                                       \
-                    for (size_t ow = 0; ow < out_width; ow++) {                                    \
-                        const size_t grad_output_idx =                                             \
-                            grad_output_offset + b * grad_output_stride_batch +                    \
-                            oc * grad_output_stride_channel + oh * grad_output_stride_h +          \
-                            ow * grad_output_stride_w;                                             \
-                        const TYPE grad_out_val = grad_output[grad_output_idx];                    \
-                                                                                                   \
-                        for (size_t ic = 0; ic < in_channels; ic++) {                              \
-                            for (size_t kh = 0; kh < kernel_height; kh++) {                        \
-                                for (size_t kw = 0; kw < kernel_width; kw++) {                     \
-                                    const int ih = (int)(oh * stride_h) - (int)padding_h +         \
-                                                   (int)(kh * dilation_h);                         \
-                                    const int iw = (int)(ow * stride_w) - (int)padding_w +         \
-                                                   (int)(kw * dilation_w);                         \
-                                    if (ih >= 0 && ih < (int)in_height && iw >= 0 &&               \
-                                        iw < (int)in_width) {                                      \
-                                        const size_t input_idx =                                   \
-                                            input_offset +                                         \
-                                            b * in_channels * in_height * in_width +               \
-                                            ic * in_height * in_width + ih * in_width + iw;        \
-                                        const size_t weight_idx =                                  \
-                                            oc * in_channels * kernel_height * kernel_width +      \
-                                            ic * kernel_height * kernel_width +                    \
-                                            kh * kernel_width + kw;                                \
-                                        const TYPE contribution =                                  \
-                                            MUL_FN(input[input_idx], grad_out_val);                \
-                                        ATOMIC_ADD_FN(&grad_weight[weight_idx], contribution);     \
-                                    }                                                              \
-                                }                                                                  \
-                            }                                                                      \
-                        }                                                                          \
-                    }                                                                              \
-                }                                                                                  \
-            }                                                                                      \
+        if (failed) {                                                                              \
+            hodu_cpu_conv2d_grad_weight_##TYPE_SUFFIX##_fallback(input_ptr, grad_output_ptr,       \
+                                                                 grad_weight_ptr, metadata);       \
         }                                                                                          \
     }
 
-CONV2D_GRAD_WEIGHT_OP(f32_t, f32_fallback, atomic_add_f32)
-CONV2D_GRAD_WEIGHT_OP(f64_t, f64_fallback, atomic_add_f64)
-
-CONV2D_GRAD_WEIGHT_OP_EXOTIC(f8e4m3_t, f8e4m3, F8E4M3_ZERO, f8e4m3_mul, atomic_add_f8e4m3)
-CONV2D_GRAD_WEIGHT_OP_EXOTIC(f8e5m2_t, f8e5m2, F8E5M2_ZERO, f8e5m2_mul, atomic_add_f8e5m2)
-CONV2D_GRAD_WEIGHT_OP_EXOTIC(bf16_t, bf16, BF16_ZERO, bf16_mul, atomic_add_bf16)
-CONV2D_GRAD_WEIGHT_OP_EXOTIC(f16_t, f16, F16_ZERO, f16_mul, atomic_add_f16)
+CONV2D_GRAD_WEIGHT_GEMM_OP(f32_t, f32)
+CONV2D_GRAD_WEIGHT_GEMM_OP(f64_t, f64)
+#endif // USE_BLAS
 
 // ============================================================================
 // 3D CONVOLUTION GRADIENT WEIGHT OPERATIONS
@@ -1387,229 +2738,12 @@ CONV2D_GRAD_WEIGHT_OP_EXOTIC(f16_t, f16, F16_ZERO, f16_mul, atomic_add_f16)
 // - metadata[22]: input_offset
 // - metadata[23]: grad_output_offset
 
-/// Macro to implement 3D convolution gradient weight operation
-///
-/// @param TYPE C type for the operation
-/// @param TYPE_SUFFIX Suffix for function naming
-/// @param ATOMIC_ADD_FN Atomic addition function for thread-safe updates
-#define CONV3D_GRAD_WEIGHT_OP(TYPE, TYPE_SUFFIX, ATOMIC_ADD_FN)                                    \
-    void hodu_cpu_conv3d_grad_weight_##TYPE_SUFFIX(                                                \
-        const void *input_ptr, const void *grad_output_ptr, void *grad_weight_ptr,                 \
-        const size_t *metadata) {                                                                  \
-        const TYPE *input = (const TYPE *)input_ptr;                                               \
-        const TYPE *grad_output = (const TYPE *)grad_output_ptr;                                   \
-        TYPE *grad_weight = (TYPE *)grad_weight_ptr;                                               \
-                                                                                                   \
-        /* Parse generic metadata: Conv3D has input_ndim=5, spatial_dims=3 */                      \
-        const size_t num_els = metadata[0];                                                        \
-        const size_t input_ndim = metadata[1];                                                     \
-        const size_t spatial_dims = metadata[2];                                                   \
-        const size_t batch = metadata[3];                                                          \
-        const size_t in_channels = metadata[4];                                                    \
-        const size_t in_depth = metadata[5];                                                       \
-        const size_t in_height = metadata[6];                                                      \
-        const size_t in_width = metadata[7];                                                       \
-        const size_t grad_output_base = 3 + input_ndim;                                            \
-        const size_t out_channels = metadata[grad_output_base + 1];                                \
-        const size_t out_depth = metadata[grad_output_base + 2];                                   \
-        const size_t out_height = metadata[grad_output_base + 3];                                  \
-        const size_t out_width = metadata[grad_output_base + 4];                                   \
-        const size_t weight_base = 3 + 2 * input_ndim;                                             \
-        const size_t kernel_depth = metadata[weight_base + 2];                                     \
-        const size_t kernel_height = metadata[weight_base + 3];                                    \
-        const size_t kernel_width = metadata[weight_base + 4];                                     \
-        const size_t grad_output_stride_base = 3 + 4 * input_ndim;                                 \
-        const size_t grad_output_stride_batch = metadata[grad_output_stride_base];                 \
-        const size_t grad_output_stride_channel = metadata[grad_output_stride_base + 1];           \
-        const size_t grad_output_stride_d = metadata[grad_output_stride_base + 2];                 \
-        const size_t grad_output_stride_h = metadata[grad_output_stride_base + 3];                 \
-        const size_t grad_output_stride_w = metadata[grad_output_stride_base + 4];                 \
-        const size_t offsets_base = 3 + 5 * input_ndim;                                            \
-        const size_t input_offset = metadata[offsets_base];                                        \
-        const size_t grad_output_offset = metadata[offsets_base + 1];                              \
-        const size_t conv_params_base = offsets_base + 2;                                          \
-        const size_t stride_d = metadata[conv_params_base];                                        \
-        const size_t stride_h = metadata[conv_params_base + 1];                                    \
-        const size_t stride_w = metadata[conv_params_base + 2];                                    \
-        const size_t padding_d = metadata[conv_params_base + spatial_dims];                        \
-        const size_t padding_h = metadata[conv_params_base + spatial_dims + 1];                    \
-        const size_t padding_w = metadata[conv_params_base + spatial_dims + 2];                    \
-        const size_t dilation_d = metadata[conv_params_base + 2 * spatial_dims];                   \
-        const size_t dilation_h = metadata[conv_params_base + 2 * spatial_dims + 1];               \
-        const size_t dilation_w = metadata[conv_params_base + 2 * spatial_dims + 2];               \
-                                                                                                   \
-        memset(grad_weight, 0, num_els * sizeof(TYPE));                                            \
-                                                                                                   \
-        for (size_t b = 0; b < batch; b++) {                                                       \
-            for (size_t oc = 0; oc < out_channels; oc++) {                                         \
-                for (size_t od = 0; od < out_depth; od++) {                                        \
-                    for (size_t oh = 0; oh < out_height; oh++) {                                   \
-                        for (size_t ow = 0; ow < out_width; ow++) {                                \
-                            const size_t grad_output_idx =                                         \
-                                grad_output_offset + b * grad_output_stride_batch +                \
-                                oc * grad_output_stride_channel + od * grad_output_stride_d +      \
-                                oh * grad_output_stride_h + ow * grad_output_stride_w;             \
-                            const TYPE grad_out_val = grad_output[grad_output_idx];                \
-                                                                                                   \
-                            for (size_t ic = 0; ic < in_channels; ic++) {                          \
-                                for (size_t kd = 0; kd < kernel_depth; kd++) {                     \
-                                    for (size_t kh = 0; kh < kernel_height; kh++) {                \
-                                        for (size_t kw = 0; kw < kernel_width; kw++) {             \
-                                            const int id = (int)(od * stride_d) - (int)padding_d + \
-                                                           (int)(kd * dilation_d);                 \
-                                            const int ih = (int)(oh * stride_h) - (int)padding_h + \
-                                                           (int)(kh * dilation_h);                 \
-                                            const int iw = (int)(ow * stride_w) - (int)padding_w + \
-                                                           (int)(kw * dilation_w);                 \
-                                            if (id >= 0 && id < (int)in_depth && ih >= 0 &&        \
-                                                ih < (int)in_height && iw >= 0 &&                  \
-                                                iw < (int)in_width) {                              \
-                                                const size_t input_idx =                           \
-                                                    input_offset +                                 \
-                                                    b * in_channels * in_depth * in_height *       \
-                                                        in_width +                                 \
-                                                    ic * in_depth * in_height * in_width +         \
-                                                    id * in_height * in_width + ih * in_width +    \
-                                                    iw;                                            \
-                                                const size_t weight_idx =                          \
-                                                    oc * in_channels * kernel_depth *              \
-                                                        kernel_height * kernel_width +             \
-                                                    ic * kernel_depth * kernel_height *            \
-                                                        kernel_width +                             \
-                                                    kd * kernel_height * kernel_width +            \
-                                                    kh * kernel_width + kw;                        \
-                                                const TYPE contribution =                          \
-                                                    input[input_idx] * grad_out_val;               \
-                                                ATOMIC_ADD_FN(&grad_weight[weight_idx],            \
-                                                              contribution);                       \
-                                            }                                                      \
-                                        }                                                          \
-                                    }                                                              \
-                                }                                                                  \
-                            }                                                                      \
-                        }                                                                          \
-                    }                                                                              \
-                }                                                                                  \
-            }                                                                                      \
-        }                                                                                          \
-    }
-
-/// Macro to implement 3D convolution gradient weight operation for exotic types
-///
-/// @param TYPE C type for the operation
-/// @param TYPE_SUFFIX Suffix for function naming
-/// @param ZERO Zero constant
-/// @param MUL_FN Multiplication function
-/// @param ATOMIC_ADD_FN Atomic addition function for thread-safe updates
-#define CONV3D_GRAD_WEIGHT_OP_EXOTIC(TYPE, TYPE_SUFFIX, ZERO, MUL_FN, ATOMIC_ADD_FN)               \
-    void hodu_cpu_conv3d_grad_weight_##TYPE_SUFFIX(                                                \
-        const void *input_ptr, const void *grad_output_ptr, void *grad_weight_ptr,                 \
-        const size_t *metadata) {                                                                  \
-        const TYPE *input = (const TYPE *)input_ptr;                                               \
-        const TYPE *grad_output = (const TYPE *)grad_output_ptr;                                   \
-        TYPE *grad_weight = (TYPE *)grad_weight_ptr;                                               \
-                                                                                                   \
-        /* Parse generic metadata: Conv3D has input_ndim=5, spatial_dims=3 */                      \
-        const size_t num_els = metadata[0];                                                        \
-        const size_t input_ndim = metadata[1];                                                     \
-        const size_t spatial_dims = metadata[2];                                                   \
-        const size_t batch = metadata[3];                                                          \
-        const size_t in_channels = metadata[4];                                                    \
-        const size_t in_depth = metadata[5];                                                       \
-        const size_t in_height = metadata[6];                                                      \
-        const size_t in_width = metadata[7];                                                       \
-        const size_t grad_output_base = 3 + input_ndim;                                            \
-        const size_t out_channels = metadata[grad_output_base + 1];                                \
-        const size_t out_depth = metadata[grad_output_base + 2];                                   \
-        const size_t out_height = metadata[grad_output_base + 3];                                  \
-        const size_t out_width = metadata[grad_output_base + 4];                                   \
-        const size_t weight_base = 3 + 2 * input_ndim;                                             \
-        const size_t kernel_depth = metadata[weight_base + 2];                                     \
-        const size_t kernel_height = metadata[weight_base + 3];                                    \
-        const size_t kernel_width = metadata[weight_base + 4];                                     \
-        const size_t grad_output_stride_base = 3 + 4 * input_ndim;                                 \
-        const size_t grad_output_stride_batch = metadata[grad_output_stride_base];                 \
-        const size_t grad_output_stride_channel = metadata[grad_output_stride_base + 1];           \
-        const size_t grad_output_stride_d = metadata[grad_output_stride_base + 2];                 \
-        const size_t grad_output_stride_h = metadata[grad_output_stride_base + 3];                 \
-        const size_t grad_output_stride_w = metadata[grad_output_stride_base + 4];                 \
-        const size_t offsets_base = 3 + 5 * input_ndim;                                            \
-        const size_t input_offset = metadata[offsets_base];                                        \
-        const size_t grad_output_offset = metadata[offsets_base + 1];                              \
-        const size_t conv_params_base = offsets_base + 2;                                          \
-        const size_t stride_d = metadata[conv_params_base];                                        \
-        const size_t stride_h = metadata[conv_params_base + 1];                                    \
-        const size_t stride_w = metadata[conv_params_base + 2];                                    \
-        const size_t padding_d = metadata[conv_params_base + spatial_dims];                        \
-        const size_t padding_h = metadata[conv_params_base + spatial_dims + 1];                    \
-        const size_t padding_w = metadata[conv_params_base + spatial_dims + 2];                    \
-        const size_t dilation_d = metadata[conv_params_base + 2 * spatial_dims];                   \
-        const size_t dilation_h = metadata[conv_params_base + 2 * spatial_dims + 1];               \
-        const size_t dilation_w = metadata[conv_params_base + 2 * spatial_dims + 2];               \
-                                                                                                   \
-        for (size_t i = 0; i < num_els; i++)                                                       \
-            grad_weight[i] = ZERO;                                                                 \
-                                                                                                   \
-        for (size_t b = 0; b < batch; b++) {                                                       \
-            for (size_t oc = 0; oc < out_channels; oc++) {                                         \
-                for (size_t od = 0; od < out_depth; od++) {                                        \
-                    for (size_t oh = 0; oh < out_height; oh++) {                                   \
-                        for (size_t ow = 0; ow < out_width; ow++) {                                \
-                            const size_t grad_output_idx =                                         \
-                                grad_output_offset + b * grad_output_stride_batch +                \
-                                oc * grad_output_stride_channel + od * grad_output_stride_d +      \
-                                oh * grad_output_stride_h + ow * grad_output_stride_w;             \
-                            const TYPE grad_out_val = grad_output[grad_output_idx];                \
-                                                                                                   \
-                            for (size_t ic = 0; ic < in_channels; ic++) {                          \
-                                for (size_t kd = 0; kd < kernel_depth; kd++) {                     \
-                                    for (size_t kh = 0; kh < kernel_height; kh++) {                \
-                                        for (size_t kw = 0; kw < kernel_width; kw++) {             \
-                                            const int id = (int)(od * stride_d) - (int)padding_d + \
-                                                           (int)(kd * dilation_d);                 \
-                                            const int ih = (int)(oh * stride_h) - (int)padding_h + \
-                                                           (int)(kh * dilation_h);                 \
-                                            const int iw = (int)(ow * stride_w) - (int)padding_w + \
-                                                           (int)(kw * dilation_w);                 \
-                                            if (id >= 0 && id < (int)in_depth && ih >= 0 &&        \
-                                                ih < (int)in_height && iw >= 0 &&                  \
-                                                iw < (int)in_width) {                              \
-                                                const size_t input_idx =                           \
-                                                    input_offset +                                 \
-                                                    b * in_channels * in_depth * in_height *       \
-                                                        in_width +                                 \
-                                                    ic * in_depth * in_height * in_width +         \
-                                                    id * in_height * in_width + ih * in_width +    \
-                                                    iw;                                            \
-                                                const size_t weight_idx =                          \
-                                                    oc * in_channels * kernel_depth *              \
-                                                        kernel_height * kernel_width +             \
-                                                    ic * kernel_depth * kernel_height *            \
-                                                        kernel_width +                             \
-                                                    kd * kernel_height * kernel_width +            \
-                                                    kh * kernel_width + kw;                        \
-                                                const TYPE contribution =                          \
-                                                    MUL_FN(input[input_idx], grad_out_val);        \
-                                                ATOMIC_ADD_FN(&grad_weight[weight_idx],            \
-                                                              contribution);                       \
-                                            }                                                      \
-                                        }                                                          \
-                                    }                                                              \
-                                }                                                                  \
-                            }                                                                      \
-                        }                                                                          \
-                    }                                                                              \
-                }                                                                                  \
-            }                                                                                      \
-        }                                                                                          \
-    }
-
-CONV3D_GRAD_WEIGHT_OP_EXOTIC(f8e4m3_t, f8e4m3, F8E4M3_ZERO, f8e4m3_mul, atomic_add_f8e4m3)
-CONV3D_GRAD_WEIGHT_OP_EXOTIC(f8e5m2_t, f8e5m2, F8E5M2_ZERO, f8e5m2_mul, atomic_add_f8e5m2)
-CONV3D_GRAD_WEIGHT_OP_EXOTIC(bf16_t, bf16, BF16_ZERO, bf16_mul, atomic_add_bf16)
-CONV3D_GRAD_WEIGHT_OP_EXOTIC(f16_t, f16, F16_ZERO, f16_mul, atomic_add_f16)
-CONV3D_GRAD_WEIGHT_OP(float, f32, atomic_add_f32)
-CONV3D_GRAD_WEIGHT_OP(double, f64, atomic_add_f64)
+CONV_GRAD_WEIGHT_OP_EXOTIC(conv3d, f8e4m3, false)
+CONV_GRAD_WEIGHT_OP_EXOTIC(conv3d, f8e5m2, false)
+CONV_GRAD_WEIGHT_OP_EXOTIC(conv3d, bf16, false)
+CONV_GRAD_WEIGHT_OP_EXOTIC(conv3d, f16, false)
+CONV_GRAD_WEIGHT_OP(conv3d, f32, f32, false)
+CONV_GRAD_WEIGHT_OP(conv3d, f64, f64, false)
 
 // ============================================================================
 // 1D TRANSPOSED CONVOLUTION GRADIENT WEIGHT OPERATIONS
@@ -1617,149 +2751,12 @@ CONV3D_GRAD_WEIGHT_OP(double, f64, atomic_add_f64)
 //
 // Metadata layout: Same as conv_transpose1d
 
-/// Macro to implement 1D transposed convolution gradient weight operation
-///
-/// @param TYPE C type for the operation
-/// @param TYPE_SUFFIX Suffix for function naming
-/// @param ATOMIC_ADD_FN Atomic addition function for thread-safe updates
-#define CONV_TRANSPOSE1D_GRAD_WEIGHT_OP(TYPE, TYPE_SUFFIX, ATOMIC_ADD_FN)                          \
-    void hodu_cpu_conv_transpose1d_grad_weight_##TYPE_SUFFIX(                                      \
-        const void *input_ptr, const void *grad_output_ptr, void *grad_weight_ptr,                 \
-        const size_t *metadata) {                                                                  \
-        const TYPE *input = (const TYPE *)input_ptr;                                               \
-        const TYPE *grad_output = (const TYPE *)grad_output_ptr;                                   \
-        TYPE *grad_weight = (TYPE *)grad_weight_ptr;                                               \
-                                                                                                   \
-        /* Parse generic metadata: ConvTranspose1D has input_ndim=3, spatial_dims=1 */             \
-        const size_t num_els = metadata[0];                                                        \
-        const size_t input_ndim = metadata[1];                                                     \
-        const size_t spatial_dims = metadata[2];                                                   \
-        const size_t batch = metadata[3];                                                          \
-        const size_t in_channels = metadata[4];                                                    \
-        const size_t in_width = metadata[5];                                                       \
-        const size_t grad_output_base = 3 + input_ndim;                                            \
-        const size_t out_channels = metadata[grad_output_base + 1];                                \
-        const size_t out_width = metadata[grad_output_base + 2];                                   \
-        const size_t weight_base = 3 + 2 * input_ndim;                                             \
-        const size_t kernel_width = metadata[weight_base + 2];                                     \
-        const size_t grad_output_stride_base = 3 + 4 * input_ndim;                                 \
-        const size_t grad_output_stride_batch = metadata[grad_output_stride_base];                 \
-        const size_t grad_output_stride_channel = metadata[grad_output_stride_base + 1];           \
-        const size_t grad_output_stride_w = metadata[grad_output_stride_base + 2];                 \
-        const size_t offsets_base = 3 + 5 * input_ndim;                                            \
-        const size_t input_offset = metadata[offsets_base];                                        \
-        const size_t grad_output_offset = metadata[offsets_base + 1];                              \
-        const size_t conv_params_base = offsets_base + 2;                                          \
-        const size_t stride = metadata[conv_params_base];                                          \
-        const size_t padding = metadata[conv_params_base + spatial_dims];                          \
-        const size_t dilation = metadata[conv_params_base + 2 * spatial_dims];                     \
-                                                                                                   \
-        memset(grad_weight, 0, num_els * sizeof(TYPE));                                            \
-                                                                                                   \
-        for (size_t b = 0; b < batch; b++) {                                                       \
-            for (size_t ic = 0; ic < in_channels; ic++) {                                          \
-                for (size_t iw = 0; iw < in_width; iw++) {                                         \
-                    const size_t input_idx =                                                       \
-                        input_offset + b * in_channels * in_width + ic * in_width + iw;            \
-                    const TYPE input_val = input[input_idx];                                       \
-                                                                                                   \
-                    for (size_t oc = 0; oc < out_channels; oc++) {                                 \
-                        for (size_t kw = 0; kw < kernel_width; kw++) {                             \
-                            const int ow =                                                         \
-                                (int)(iw * stride) - (int)padding + (int)(kw * dilation);          \
-                            if (ow >= 0 && ow < (int)out_width) {                                  \
-                                const size_t grad_output_idx =                                     \
-                                    grad_output_offset + b * grad_output_stride_batch +            \
-                                    oc * grad_output_stride_channel + ow * grad_output_stride_w;   \
-                                const size_t weight_idx =                                          \
-                                    ic * out_channels * kernel_width + oc * kernel_width + kw;     \
-                                const TYPE contribution =                                          \
-                                    input_val * grad_output[grad_output_idx];                      \
-                                ATOMIC_ADD_FN(&grad_weight[weight_idx], contribution);             \
-                            }                                                                      \
-                        }                                                                          \
-                    }                                                                              \
-                }                                                                                  \
-            }                                                                                      \
-        }                                                                                          \
-    }
-
-/// Macro to implement 1D transposed convolution gradient weight operation for exotic types
-///
-/// @param TYPE C type for the operation
-/// @param TYPE_SUFFIX Suffix for function naming
-/// @param ZERO Zero constant
-/// @param MUL_FN Multiplication function
-/// @param ATOMIC_ADD_FN Atomic addition function for thread-safe updates
-#define CONV_TRANSPOSE1D_GRAD_WEIGHT_OP_EXOTIC(TYPE, TYPE_SUFFIX, ZERO, MUL_FN, ATOMIC_ADD_FN)     \
-    void hodu_cpu_conv_transpose1d_grad_weight_##TYPE_SUFFIX(                                      \
-        const void *input_ptr, const void *grad_output_ptr, void *grad_weight_ptr,                 \
-        const size_t *metadata) {                                                                  \
-        const TYPE *input = (const TYPE *)input_ptr;                                               \
-        const TYPE *grad_output = (const TYPE *)grad_output_ptr;                                   \
-        TYPE *grad_weight = (TYPE *)grad_weight_ptr;                                               \
-                                                                                                   \
-        /* Parse generic metadata: ConvTranspose1D has input_ndim=3, spatial_dims=1 */             \
-        const size_t num_els = metadata[0];                                                        \
-        const size_t input_ndim = metadata[1];                                                     \
-        const size_t spatial_dims = metadata[2];                                                   \
-        const size_t batch = metadata[3];                                                          \
-        const size_t in_channels = metadata[4];                                                    \
-        const size_t in_width = metadata[5];                                                       \
-        const size_t grad_output_base = 3 + input_ndim;                                            \
-        const size_t out_channels = metadata[grad_output_base + 1];                                \
-        const size_t out_width = metadata[grad_output_base + 2];                                   \
-        const size_t weight_base = 3 + 2 * input_ndim;                                             \
-        const size_t kernel_width = metadata[weight_base + 2];                                     \
-        const size_t grad_output_stride_base = 3 + 4 * input_ndim;                                 \
-        const size_t grad_output_stride_batch = metadata[grad_output_stride_base];                 \
-        const size_t grad_output_stride_channel = metadata[grad_output_stride_base + 1];           \
-        const size_t grad_output_stride_w = metadata[grad_output_stride_base + 2];                 \
-        const size_t offsets_base = 3 + 5 * input_ndim;                                            \
-        const size_t input_offset = metadata[offsets_base];                                        \
-        const size_t grad_output_offset = metadata[offsets_base + 1];                              \
-        const size_t conv_params_base = offsets_base + 2;                                          \
-        const size_t stride = metadata[conv_params_base];                                          \
-        const size_t padding = metadata[conv_params_base + spatial_dims];                          \
-        const size_t dilation = metadata[conv_params_base + 2 * spatial_dims];                     \
-                                                                                                   \
-        for (size_t i = 0; i < num_els; i++)                                                       \
-            grad_weight[i] = ZERO;                                                                 \
-                                                                                                   \
-        for (size_t b = 0; b < batch; b++) {                                                       \
-            for (size_t ic = 0; ic < in_channels; ic++) {                                          \
-                for (size_t iw = 0; iw < in_width; iw++) {                                         \
-                    const size_t input_idx =                                                       \
-                        input_offset + b * in_channels * in_width + ic * in_width + iw;            \
-                    const TYPE input_val = input[input_idx];                                       \
-                                                                                                   \
-                    for (size_t oc = 0; oc < out_channels; oc++) {                                 \
-                        for (size_t kw = 0; kw < kernel_width; kw++) {                             \
-                            const int ow =                                                         \
-                                (int)(iw * stride) - (int)padding + (int)(kw * dilation);          \
-                            if (ow >= 0 && ow < (int)out_width) {                                  \
-                                const size_t grad_output_idx =                                     \
-                                    grad_output_offset + b * grad_output_stride_batch +            \
-                                    oc * grad_output_stride_channel + ow * grad_output_stride_w;   \
-                                const size_t weight_idx =                                          \
-                                    ic * out_channels * kernel_width + oc * kernel_width + kw;     \
-                                const TYPE contribution =                                          \
-                                    MUL_FN(input_val, grad_output[grad_output_idx]);               \
-                                ATOMIC_ADD_FN(&grad_weight[weight_idx], contribution);             \
-                            }                                                                      \
-                        }                                                                          \
-                    }                                                                              \
-                }                                                                                  \
-            }                                                                                      \
-        }                                                                                          \
-    }
-
-CONV_TRANSPOSE1D_GRAD_WEIGHT_OP_EXOTIC(f8e4m3_t, f8e4m3, F8E4M3_ZERO, f8e4m3_mul, atomic_add_f8e4m3)
-CONV_TRANSPOSE1D_GRAD_WEIGHT_OP_EXOTIC(f8e5m2_t, f8e5m2, F8E5M2_ZERO, f8e5m2_mul, atomic_add_f8e5m2)
-CONV_TRANSPOSE1D_GRAD_WEIGHT_OP_EXOTIC(bf16_t, bf16, BF16_ZERO, bf16_mul, atomic_add_bf16)
-CONV_TRANSPOSE1D_GRAD_WEIGHT_OP_EXOTIC(f16_t, f16, F16_ZERO, f16_mul, atomic_add_f16)
-CONV_TRANSPOSE1D_GRAD_WEIGHT_OP(float, f32, atomic_add_f32)
-CONV_TRANSPOSE1D_GRAD_WEIGHT_OP(double, f64, atomic_add_f64)
+CONV_GRAD_WEIGHT_OP_EXOTIC(conv_transpose1d, f8e4m3, true)
+CONV_GRAD_WEIGHT_OP_EXOTIC(conv_transpose1d, f8e5m2, true)
+CONV_GRAD_WEIGHT_OP_EXOTIC(conv_transpose1d, bf16, true)
+CONV_GRAD_WEIGHT_OP_EXOTIC(conv_transpose1d, f16, true)
+CONV_GRAD_WEIGHT_OP(conv_transpose1d, f32, f32, true)
+CONV_GRAD_WEIGHT_OP(conv_transpose1d, f64, f64, true)
 
 // ============================================================================
 // 2D TRANSPOSED CONVOLUTION GRADIENT WEIGHT OPERATIONS
@@ -1767,185 +2764,12 @@ CONV_TRANSPOSE1D_GRAD_WEIGHT_OP(double, f64, atomic_add_f64)
 //
 // Metadata layout: Same as conv_transpose2d
 
-/// Macro to implement 2D transposed convolution gradient weight operation
-///
-/// @param TYPE C type for the operation
-/// @param TYPE_SUFFIX Suffix for function naming
-/// @param ATOMIC_ADD_FN Atomic addition function for thread-safe updates
-#define CONV_TRANSPOSE2D_GRAD_WEIGHT_OP(TYPE, TYPE_SUFFIX, ATOMIC_ADD_FN)                          \
-    void hodu_cpu_conv_transpose2d_grad_weight_##TYPE_SUFFIX(                                      \
-        const void *input_ptr, const void *grad_output_ptr, void *grad_weight_ptr,                 \
-        const size_t *metadata) {                                                                  \
-        const TYPE *input = (const TYPE *)input_ptr;                                               \
-        const TYPE *grad_output = (const TYPE *)grad_output_ptr;                                   \
-        TYPE *grad_weight = (TYPE *)grad_weight_ptr;                                               \
-                                                                                                   \
-        /* Parse generic metadata: ConvTranspose2D has input_ndim=4, spatial_dims=2 */             \
-        const size_t num_els = metadata[0];                                                        \
-        const size_t input_ndim = metadata[1];                                                     \
-        const size_t spatial_dims = metadata[2];                                                   \
-        const size_t batch = metadata[3];                                                          \
-        const size_t in_channels = metadata[4];                                                    \
-        const size_t in_height = metadata[5];                                                      \
-        const size_t in_width = metadata[6];                                                       \
-        const size_t grad_output_base = 3 + input_ndim;                                            \
-        const size_t out_channels = metadata[grad_output_base + 1];                                \
-        const size_t out_height = metadata[grad_output_base + 2];                                  \
-        const size_t out_width = metadata[grad_output_base + 3];                                   \
-        const size_t weight_base = 3 + 2 * input_ndim;                                             \
-        const size_t kernel_height = metadata[weight_base + 2];                                    \
-        const size_t kernel_width = metadata[weight_base + 3];                                     \
-        const size_t grad_output_stride_base = 3 + 4 * input_ndim;                                 \
-        const size_t grad_output_stride_batch = metadata[grad_output_stride_base];                 \
-        const size_t grad_output_stride_channel = metadata[grad_output_stride_base + 1];           \
-        const size_t grad_output_stride_h = metadata[grad_output_stride_base + 2];                 \
-        const size_t grad_output_stride_w = metadata[grad_output_stride_base + 3];                 \
-        const size_t offsets_base = 3 + 5 * input_ndim;                                            \
-        const size_t input_offset = metadata[offsets_base];                                        \
-        const size_t grad_output_offset = metadata[offsets_base + 1];                              \
-        const size_t conv_params_base = offsets_base + 2;                                          \
-        const size_t stride_h = metadata[conv_params_base];                                        \
-        const size_t stride_w = metadata[conv_params_base + 1];                                    \
-        const size_t padding_h = metadata[conv_params_base + spatial_dims];                        \
-        const size_t padding_w = metadata[conv_params_base + spatial_dims + 1];                    \
-        const size_t dilation_h = metadata[conv_params_base + 2 * spatial_dims];                   \
-        const size_t dilation_w = metadata[conv_params_base + 2 * spatial_dims + 1];               \
-                                                                                                   \
-        memset(grad_weight, 0, num_els * sizeof(TYPE));                                            \
-                                                                                                   \
-        for (size_t b = 0; b < batch; b++) {                                                       \
-            for (size_t ic = 0; ic < in_channels; ic++) {                                          \
-                for (size_t ih = 0; ih < in_height; ih++) {                                        \
-                    for (size_t iw = 0; iw < in_width; iw++) {                                     \
-                        const size_t input_idx = input_offset +                                    \
-                                                 b * in_channels * in_height * in_width +          \
-                                                 ic * in_height * in_width + ih * in_width + iw;   \
-                        const TYPE input_val = input[input_idx];                                   \
-                                                                                                   \
-                        for (size_t oc = 0; oc < out_channels; oc++) {                             \
-                            for (size_t kh = 0; kh < kernel_height; kh++) {                        \
-                                for (size_t kw = 0; kw < kernel_width; kw++) {                     \
-                                    const int oh = (int)(ih * stride_h) - (int)padding_h +         \
-                                                   (int)(kh * dilation_h);                         \
-                                    const int ow = (int)(iw * stride_w) - (int)padding_w +         \
-                                                   (int)(kw * dilation_w);                         \
-                                    if (oh >= 0 && oh < (int)out_height && ow >= 0 &&              \
-                                        ow < (int)out_width) {                                     \
-                                        const size_t grad_output_idx =                             \
-                                            grad_output_offset + b * grad_output_stride_batch +    \
-                                            oc * grad_output_stride_channel +                      \
-                                            oh * grad_output_stride_h + ow * grad_output_stride_w; \
-                                        const size_t weight_idx =                                  \
-                                            ic * out_channels * kernel_height * kernel_width +     \
-                                            oc * kernel_height * kernel_width +                    \
-                                            kh * kernel_width + kw;                                \
-                                        const TYPE contribution =                                  \
-                                            input_val * grad_output[grad_output_idx];              \
-                                        ATOMIC_ADD_FN(&grad_weight[weight_idx], contribution);     \
-                                    }                                                              \
-                                }                                                                  \
-                            }                                                                      \
-                        }                                                                          \
-                    }                                                                              \
-                }                                                                                  \
-            }                                                                                      \
-        }                                                                                          \
-    }
-
-/// Macro to implement 2D transposed convolution gradient weight operation for exotic types
-///
-/// @param TYPE C type for the operation
-/// @param TYPE_SUFFIX Suffix for function naming
-/// @param ZERO Zero constant
-/// @param MUL_FN Multiplication function
-/// @param ATOMIC_ADD_FN Atomic addition function for thread-safe updates
-#define CONV_TRANSPOSE2D_GRAD_WEIGHT_OP_EXOTIC(TYPE, TYPE_SUFFIX, ZERO, MUL_FN, ATOMIC_ADD_FN)     \
-    void hodu_cpu_conv_transpose2d_grad_weight_##TYPE_SUFFIX(                                      \
-        const void *input_ptr, const void *grad_output_ptr, void *grad_weight_ptr,                 \
-        const size_t *metadata) {                                                                  \
-        const TYPE *input = (const TYPE *)input_ptr;                                               \
-        const TYPE *grad_output = (const TYPE *)grad_output_ptr;                                   \
-        TYPE *grad_weight = (TYPE *)grad_weight_ptr;                                               \
-                                                                                                   \
-        /* Parse generic metadata: ConvTranspose2D has input_ndim=4, spatial_dims=2 */             \
-        const size_t num_els = metadata[0];                                                        \
-        const size_t input_ndim = metadata[1];                                                     \
-        const size_t spatial_dims = metadata[2];                                                   \
-        const size_t batch = metadata[3];                                                          \
-        const size_t in_channels = metadata[4];                                                    \
-        const size_t in_height = metadata[5];                                                      \
-        const size_t in_width = metadata[6];                                                       \
-        const size_t grad_output_base = 3 + input_ndim;                                            \
-        const size_t out_channels = metadata[grad_output_base + 1];                                \
-        const size_t out_height = metadata[grad_output_base + 2];                                  \
-        const size_t out_width = metadata[grad_output_base + 3];                                   \
-        const size_t weight_base = 3 + 2 * input_ndim;                                             \
-        const size_t kernel_height = metadata[weight_base + 2];                                    \
-        const size_t kernel_width = metadata[weight_base + 3];                                     \
-        const size_t grad_output_stride_base = 3 + 4 * input_ndim;                                 \
-        const size_t grad_output_stride_batch = metadata[grad_output_stride_base];                 \
-        const size_t grad_output_stride_channel = metadata[grad_output_stride_base + 1];           \
-        const size_t grad_output_stride_h = metadata[grad_output_stride_base + 2];                 \
-        const size_t grad_output_stride_w = metadata[grad_output_stride_base + 3];                 \
-        const size_t offsets_base = 3 + 5 * input_ndim;                                            \
-        const size_t input_offset = metadata[offsets_base];                                        \
-        const size_t grad_output_offset = metadata[offsets_base + 1];                              \
-        const size_t conv_params_base = offsets_base + 2;                                          \
-        const size_t stride_h = metadata[conv_params_base];                                        \
-        const size_t stride_w = metadata[conv_params_base + 1];                                    \
-        const size_t padding_h = metadata[conv_params_base + spatial_dims];                        \
-        const size_t padding_w = metadata[conv_params_base + spatial_dims + 1];                    \
-        const size_t dilation_h = metadata[conv_params_base + 2 * spatial_dims];                   \
-        const size_t dilation_w = metadata[conv_params_base + 2 * spatial_dims + 1];               \
-                                                                                                   \
-        for (size_t i = 0; i < num_els; i++)                                                       \
-            grad_weight[i] = ZERO;                                                                 \
-                                                                                                   \
-        for (size_t b = 0; b < batch; b++) {                                                       \
-            for (size_t ic = 0; ic < in_channels; ic++) {                                          \
-                for (size_t ih = 0; ih < in_height; ih++) {                                        \
-                    for (size_t iw = 0; iw < in_width; iw++) {                                     \
-                        const size_t input_idx = input_offset +                                    \
-                                                 b * in_channels * in_height * in_width +          \
-                                                 ic * in_height * in_width + ih * in_width + iw;   \
-                        const TYPE input_val = input[input_idx];                                   \
-                                                                                                   \
-                        for (size_t oc = 0; oc < out_channels; oc++) {                             \
-                            for (size_t kh = 0; kh < kernel_height; kh++) {                        \
-                                for (size_t kw = 0; kw < kernel_width; kw++) {                     \
-                                    const int oh = (int)(ih * stride_h) - (int)padding_h +         \
-                                                   (int)(kh * dilation_h);                         \
-                                    const int ow = (int)(iw * stride_w) - (int)padding_w +         \
-                                                   (int)(kw * dilation_w);                         \
-                                    if (oh >= 0 && oh < (int)out_height && ow >= 0 &&              \
-                                        ow < (int)out_width) {                                     \
-                                        const size_t grad_output_idx =                             \
-                                            grad_output_offset + b * grad_output_stride_batch +    \
-                                            oc * grad_output_stride_channel +                      \
-                                            oh * grad_output_stride_h + ow * grad_output_stride_w; \
-                                        const size_t weight_idx =                                  \
-                                            ic * out_channels * kernel_height * kernel_width +     \
-                                            oc * kernel_height * kernel_width +                    \
-                                            kh * kernel_width + kw;                                \
-                                        const TYPE contribution =                                  \
-                                            MUL_FN(input_val, grad_output[grad_output_idx]);       \
-                                        ATOMIC_ADD_FN(&grad_weight[weight_idx], contribution);     \
-                                    }                                                              \
-                                }                                                                  \
-                            }                                                                      \
-                        }                                                                          \
-                    }                                                                              \
-                }                                                                                  \
-            }                                                                                      \
-        }                                                                                          \
-    }
-
-CONV_TRANSPOSE2D_GRAD_WEIGHT_OP_EXOTIC(f8e4m3_t, f8e4m3, F8E4M3_ZERO, f8e4m3_mul, atomic_add_f8e4m3)
-CONV_TRANSPOSE2D_GRAD_WEIGHT_OP_EXOTIC(f8e5m2_t, f8e5m2, F8E5M2_ZERO, f8e5m2_mul, atomic_add_f8e5m2)
-CONV_TRANSPOSE2D_GRAD_WEIGHT_OP_EXOTIC(bf16_t, bf16, BF16_ZERO, bf16_mul, atomic_add_bf16)
-CONV_TRANSPOSE2D_GRAD_WEIGHT_OP_EXOTIC(f16_t, f16, F16_ZERO, f16_mul, atomic_add_f16)
-CONV_TRANSPOSE2D_GRAD_WEIGHT_OP(float, f32, atomic_add_f32)
-CONV_TRANSPOSE2D_GRAD_WEIGHT_OP(double, f64, atomic_add_f64)
+CONV_GRAD_WEIGHT_OP_EXOTIC(conv_transpose2d, f8e4m3, true)
+CONV_GRAD_WEIGHT_OP_EXOTIC(conv_transpose2d, f8e5m2, true)
+CONV_GRAD_WEIGHT_OP_EXOTIC(conv_transpose2d, bf16, true)
+CONV_GRAD_WEIGHT_OP_EXOTIC(conv_transpose2d, f16, true)
+CONV_GRAD_WEIGHT_OP(conv_transpose2d, f32, f32, true)
+CONV_GRAD_WEIGHT_OP(conv_transpose2d, f64, f64, true)
 
 // ============================================================================
 // 3D TRANSPOSED CONVOLUTION GRADIENT WEIGHT OPERATIONS
@@ -1953,226 +2777,9 @@ CONV_TRANSPOSE2D_GRAD_WEIGHT_OP(double, f64, atomic_add_f64)
 //
 // Metadata layout: Same as conv_transpose3d
 
-/// Macro to implement 3D transposed convolution gradient weight operation
-///
-/// @param TYPE C type for the operation
-/// @param TYPE_SUFFIX Suffix for function naming
-/// @param ATOMIC_ADD_FN Atomic addition function for thread-safe updates
-#define CONV_TRANSPOSE3D_GRAD_WEIGHT_OP(TYPE, TYPE_SUFFIX, ATOMIC_ADD_FN)                          \
-    void hodu_cpu_conv_transpose3d_grad_weight_##TYPE_SUFFIX(                                      \
-        const void *input_ptr, const void *grad_output_ptr, void *grad_weight_ptr,                 \
-        const size_t *metadata) {                                                                  \
-        const TYPE *input = (const TYPE *)input_ptr;                                               \
-        const TYPE *grad_output = (const TYPE *)grad_output_ptr;                                   \
-        TYPE *grad_weight = (TYPE *)grad_weight_ptr;                                               \
-                                                                                                   \
-        /* Parse generic metadata: ConvTranspose3D has input_ndim=5, spatial_dims=3 */             \
-        const size_t num_els = metadata[0];                                                        \
-        const size_t input_ndim = metadata[1];                                                     \
-        const size_t spatial_dims = metadata[2];                                                   \
-        const size_t batch = metadata[3];                                                          \
-        const size_t in_channels = metadata[4];                                                    \
-        const size_t in_depth = metadata[5];                                                       \
-        const size_t in_height = metadata[6];                                                      \
-        const size_t in_width = metadata[7];                                                       \
-        const size_t grad_output_base = 3 + input_ndim;                                            \
-        const size_t out_channels = metadata[grad_output_base + 1];                                \
-        const size_t out_depth = metadata[grad_output_base + 2];                                   \
-        const size_t out_height = metadata[grad_output_base + 3];                                  \
-        const size_t out_width = metadata[grad_output_base + 4];                                   \
-        const size_t weight_base = 3 + 2 * input_ndim;                                             \
-        const size_t kernel_depth = metadata[weight_base + 2];                                     \
-        const size_t kernel_height = metadata[weight_base + 3];                                    \
-        const size_t kernel_width = metadata[weight_base + 4];                                     \
-        const size_t grad_output_stride_base = 3 + 4 * input_ndim;                                 \
-        const size_t grad_output_stride_batch = metadata[grad_output_stride_base];                 \
-        const size_t grad_output_stride_channel = metadata[grad_output_stride_base + 1];           \
-        const size_t grad_output_stride_d = metadata[grad_output_stride_base + 2];                 \
-        const size_t grad_output_stride_h = metadata[grad_output_stride_base + 3];                 \
-        const size_t grad_output_stride_w = metadata[grad_output_stride_base + 4];                 \
-        const size_t offsets_base = 3 + 5 * input_ndim;                                            \
-        const size_t input_offset = metadata[offsets_base];                                        \
-        const size_t grad_output_offset = metadata[offsets_base + 1];                              \
-        const size_t conv_params_base = offsets_base + 2;                                          \
-        const size_t stride_d = metadata[conv_params_base];                                        \
-        const size_t stride_h = metadata[conv_params_base + 1];                                    \
-        const size_t stride_w = metadata[conv_params_base + 2];                                    \
-        const size_t padding_d = metadata[conv_params_base + spatial_dims];                        \
-        const size_t padding_h = metadata[conv_params_base + spatial_dims + 1];                    \
-        const size_t padding_w = metadata[conv_params_base + spatial_dims + 2];                    \
-        const size_t dilation_d = metadata[conv_params_base + 2 * spatial_dims];                   \
-        const size_t dilation_h = metadata[conv_params_base + 2 * spatial_dims + 1];               \
-        const size_t dilation_w = metadata[conv_params_base + 2 * spatial_dims + 2];               \
-                                                                                                   \
-        memset(grad_weight, 0, num_els * sizeof(TYPE));                                            \
-                                                                                                   \
-        for (size_t b = 0; b < batch; b++) {                                                       \
-            for (size_t ic = 0; ic < in_channels; ic++) {                                          \
-                for (size_t id = 0; id < in_depth; id++) {                                         \
-                    for (size_t ih = 0; ih < in_height; ih++) {                                    \
-                        for (size_t iw = 0; iw < in_width; iw++) {                                 \
-                            const size_t input_idx =                                               \
-                                input_offset + b * in_channels * in_depth * in_height * in_width + \
-                                ic * in_depth * in_height * in_width + id * in_height * in_width + \
-                                ih * in_width + iw;                                                \
-                            const TYPE input_val = input[input_idx];                               \
-                                                                                                   \
-                            for (size_t oc = 0; oc < out_channels; oc++) {                         \
-                                for (size_t kd = 0; kd < kernel_depth; kd++) {                     \
-                                    for (size_t kh = 0; kh < kernel_height; kh++) {                \
-                                        for (size_t kw = 0; kw < kernel_width; kw++) {             \
-                                            const int od = (int)(id * stride_d) - (int)padding_d + \
-                                                           (int)(kd * dilation_d);                 \
-                                            const int oh = (int)(ih * stride_h) - (int)padding_h + \
-                                                           (int)(kh * dilation_h);                 \
-                                            const int ow = (int)(iw * stride_w) - (int)padding_w + \
-                                                           (int)(kw * dilation_w);                 \
-                                            if (od >= 0 && od < (int)out_depth && oh >= 0 &&       \
-                                                oh < (int)out_height && ow >= 0 &&                 \
-                                                ow < (int)out_width) {                             \
-                                                const size_t grad_output_idx =                     \
-                                                    grad_output_offset +                           \
-                                                    b * grad_output_stride_batch +                 \
-                                                    oc * grad_output_stride_channel +              \
-                                                    od * grad_output_stride_d +                    \
-                                                    oh * grad_output_stride_h +                    \
-                                                    ow * grad_output_stride_w;                     \
-                                                const size_t weight_idx =                          \
-                                                    ic * out_channels * kernel_depth *             \
-                                                        kernel_height * kernel_width +             \
-                                                    oc * kernel_depth * kernel_height *            \
-                                                        kernel_width +                             \
-                                                    kd * kernel_height * kernel_width +            \
-                                                    kh * kernel_width + kw;                        \
-                                                const TYPE contribution =                          \
-                                                    input_val * grad_output[grad_output_idx];      \
-                                                ATOMIC_ADD_FN(&grad_weight[weight_idx],            \
-                                                              contribution);                       \
-                                            }                                                      \
-                                        }                                                          \
-                                    }                                                              \
-                                }                                                                  \
-                            }                                                                      \
-                        }                                                                          \
-                    }                                                                              \
-                }                                                                                  \
-            }                                                                                      \
-        }                                                                                          \
-    }
-
-/// Macro to implement 3D transposed convolution gradient weight operation for exotic types
-///
-/// @param TYPE C type for the operation
-/// @param TYPE_SUFFIX Suffix for function naming
-/// @param ZERO Zero constant
-/// @param MUL_FN Multiplication function
-/// @param ATOMIC_ADD_FN Atomic addition function for thread-safe updates
-#define CONV_TRANSPOSE3D_GRAD_WEIGHT_OP_EXOTIC(TYPE, TYPE_SUFFIX, ZERO, MUL_FN, ATOMIC_ADD_FN)     \
-    void hodu_cpu_conv_transpose3d_grad_weight_##TYPE_SUFFIX(                                      \
-        const void *input_ptr, const void *grad_output_ptr, void *grad_weight_ptr,                 \
-        const size_t *metadata) {                                                                  \
-        const TYPE *input = (const TYPE *)input_ptr;                                               \
-        const TYPE *grad_output = (const TYPE *)grad_output_ptr;                                   \
-        TYPE *grad_weight = (TYPE *)grad_weight_ptr;                                               \
-                                                                                                   \
-        /* Parse generic metadata: ConvTranspose3D has input_ndim=5, spatial_dims=3 */             \
-        const size_t num_els = metadata[0];                                                        \
-        const size_t input_ndim = metadata[1];                                                     \
-        const size_t spatial_dims = metadata[2];                                                   \
-        const size_t batch = metadata[3];                                                          \
-        const size_t in_channels = metadata[4];                                                    \
-        const size_t in_depth = metadata[5];                                                       \
-        const size_t in_height = metadata[6];                                                      \
-        const size_t in_width = metadata[7];                                                       \
-        const size_t grad_output_base = 3 + input_ndim;                                            \
-        const size_t out_channels = metadata[grad_output_base + 1];                                \
-        const size_t out_depth = metadata[grad_output_base + 2];                                   \
-        const size_t out_height = metadata[grad_output_base + 3];                                  \
-        const size_t out_width = metadata[grad_output_base + 4];                                   \
-        const size_t weight_base = 3 + 2 * input_ndim;                                             \
-        const size_t kernel_depth = metadata[weight_base + 2];                                     \
-        const size_t kernel_height = metadata[weight_base + 3];                                    \
-        const size_t kernel_width = metadata[weight_base + 4];                                     \
-        const size_t grad_output_stride_base = 3 + 4 * input_ndim;                                 \
-        const size_t grad_output_stride_batch = metadata[grad_output_stride_base];                 \
-        const size_t grad_output_stride_channel = metadata[grad_output_stride_base + 1];           \
-        const size_t grad_output_stride_d = metadata[grad_output_stride_base + 2];                 \
-        const size_t grad_output_stride_h = metadata[grad_output_stride_base + 3];                 \
-        const size_t grad_output_stride_w = metadata[grad_output_stride_base + 4];                 \
-        const size_t offsets_base = 3 + 5 * input_ndim;                                            \
-        const size_t input_offset = metadata[offsets_base];                                        \
-        const size_t grad_output_offset = metadata[offsets_base + 1];                              \
-        const size_t conv_params_base = offsets_base + 2;                                          \
-        const size_t stride_d = metadata[conv_params_base];                                        \
-        const size_t stride_h = metadata[conv_params_base + 1];                                    \
-        const size_t stride_w = metadata[conv_params_base + 2];                                    \
-        const size_t padding_d = metadata[conv_params_base + spatial_dims];                        \
-        const size_t padding_h = metadata[conv_params_base + spatial_dims + 1];                    \
-        const size_t padding_w = metadata[conv_params_base + spatial_dims + 2];                    \
-        const size_t dilation_d = metadata[conv_params_base + 2 * spatial_dims];                   \
-        const size_t dilation_h = metadata[conv_params_base + 2 * spatial_dims + 1];               \
-        const size_t dilation_w = metadata[conv_params_base + 2 * spatial_dims + 2];               \
-                                                                                                   \
-        for (size_t i = 0; i < num_els; i++)                                                       \
-            grad_weight[i] = ZERO;                                                                 \
-                                                                                                   \
-        for (size_t b = 0; b < batch; b++) {                                                       \
-            for (size_t ic = 0; ic < in_channels; ic++) {                                          \
-                for (size_t id = 0; id < in_depth; id++) {                                         \
-                    for (size_t ih = 0; ih < in_height; ih++) {                                    \
-                        for (size_t iw = 0; iw < in_width; iw++) {                                 \
-                            const size_t input_idx =                                               \
-                                input_offset + b * in_channels * in_depth * in_height * in_width + \
-                                ic * in_depth * in_height * in_width + id * in_height * in_width + \
-                                ih * in_width + iw;                                                \
-                            const TYPE input_val = input[input_idx];                               \
-                                                                                                   \
-                            for (size_t oc = 0; oc < out_channels; oc++) {                         \
-                                for (size_t kd = 0; kd < kernel_depth; kd++) {                     \
-                                    for (size_t kh = 0; kh < kernel_height; kh++) {                \
-                                        for (size_t kw = 0; kw < kernel_width; kw++) {             \
-                                            const int od = (int)(id * stride_d) - (int)padding_d + \
-                                                           (int)(kd * dilation_d);                 \
-                                            const int oh = (int)(ih * stride_h) - (int)padding_h + \
-                                                           (int)(kh * dilation_h);                 \
-                                            const int ow = (int)(iw * stride_w) - (int)padding_w + \
-                                                           (int)(kw * dilation_w);                 \
-                                            if (od >= 0 && od < (int)out_depth && oh >= 0 &&       \
-                                                oh < (int)out_height && ow >= 0 &&                 \
-                                                ow < (int)out_width) {                             \
-                                                const size_t grad_output_idx =                     \
-                                                    grad_output_offset +                           \
-                                                    b * grad_output_stride_batch +                 \
-                                                    oc * grad_output_stride_channel +              \
-                                                    od * grad_output_stride_d +                    \
-                                                    oh * grad_output_stride_h +                    \
-                                                    ow * grad_output_stride_w;                     \
-                                                const size_t weight_idx =                          \
-                                                    ic * out_channels * kernel_depth *             \
-                                                        kernel_height * kernel_width +             \
-                                                    oc * kernel_depth * kernel_height *            \
-                                                        kernel_width +                             \
-                                                    kd * kernel_height * kernel_width +            \
-                                                    kh * kernel_width + kw;                        \
-                                                const TYPE contribution = MUL_FN(                  \
-                                                    input_val, grad_output[grad_output_idx]);      \
-                                                ATOMIC_ADD_FN(&grad_weight[weight_idx],            \
-                                                              contribution);                       \
-                                            }                                                      \
-                                        }                                                          \
-                                    }                                                              \
-                                }                                                                  \
-                            }                                                                      \
-                        }                                                                          \
-                    }                                                                              \
-                }                                                                                  \
-            }                                                                                      \
-        }                                                                                          \
-    }
-
-CONV_TRANSPOSE3D_GRAD_WEIGHT_OP_EXOTIC(f8e4m3_t, f8e4m3, F8E4M3_ZERO, f8e4m3_mul, atomic_add_f8e4m3)
-CONV_TRANSPOSE3D_GRAD_WEIGHT_OP_EXOTIC(f8e5m2_t, f8e5m2, F8E5M2_ZERO, f8e5m2_mul, atomic_add_f8e5m2)
-CONV_TRANSPOSE3D_GRAD_WEIGHT_OP_EXOTIC(bf16_t, bf16, BF16_ZERO, bf16_mul, atomic_add_bf16)
-CONV_TRANSPOSE3D_GRAD_WEIGHT_OP_EXOTIC(f16_t, f16, F16_ZERO, f16_mul, atomic_add_f16)
-CONV_TRANSPOSE3D_GRAD_WEIGHT_OP(float, f32, atomic_add_f32)
-CONV_TRANSPOSE3D_GRAD_WEIGHT_OP(double, f64, atomic_add_f64)
+CONV_GRAD_WEIGHT_OP_EXOTIC(conv_transpose3d, f8e4m3, true)
+CONV_GRAD_WEIGHT_OP_EXOTIC(conv_transpose3d, f8e5m2, true)
+CONV_GRAD_WEIGHT_OP_EXOTIC(conv_transpose3d, bf16, true)
+CONV_GRAD_WEIGHT_OP_EXOTIC(conv_transpose3d, f16, true)
+CONV_GRAD_WEIGHT_OP(conv_transpose3d, f32, f32, true)
+CONV_GRAD_WEIGHT_OP(conv_transpose3d, f64, f64, true)
@@ -16,6 +16,7 @@
 #ifndef OPS_CONV_H
 #define OPS_CONV_H
 
+#include "epilogue.h"
 #include <stddef.h>
 #include <stdint.h>
 
@@ -95,7 +96,8 @@ extern "C" {
 // - metadata[22]: weight_offset
 
 // 1D Convolution operations
-
+// f32/f64 conv1d and conv3d run one GEMM per batch element on an im2col / vol2col
+// column matrix (native GEMM and thread pool, with or without BLAS).
 void hodu_cpu_conv1d_f8e4m3(const void *input, const void *weight, void *output,
                             const size_t *metadata);
 void hodu_cpu_conv1d_f8e5m2(const void *input, const void *weight, void *output,
@@ -110,6 +112,11 @@ void hodu_cpu_conv1d_f64(const void *input, const void *weight, void *output,
                          const size_t *metadata);
 
 // 2D Convolution operations
+// Without BLAS, f32/f64 use a thread-pooled native engine: Winograd F(4x4, 3x3) /
+// F(2x2, 3x3) for 3x3 stride-1 layers, GEMM for 1x1, and output-channel-blocked
+// direct convolution otherwise. With BLAS, f32/f64 feed cache-sized im2col column
+// tiles to GEMM, running samples in parallel when the batch is large and the spatial
+// size small.
 void hodu_cpu_conv2d_f8e4m3(const void *input, const void *weight, void *output,
                             const size_t *metadata);
 void hodu_cpu_conv2d_f8e5m2(const void *input, const void *weight, void *output,
@@ -123,6 +130,38 @@ void hodu_cpu_conv2d_f32(const void *input, const void *weight, void *output,
 void hodu_cpu_conv2d_f64(const void *input, const void *weight, void *output,
                          const size_t *metadata);
 
+// Scratch bytes one f32/f64 conv2d, conv2d_fused or conv2d_packed call takes from
+// the calling thread's workspace (see workspace.h)
+size_t hodu_cpu_conv2d_workspace_size_f32(const size_t *metadata);
+size_t hodu_cpu_conv2d_workspace_size_f64(const size_t *metadata);
+
+// Channels-last 2D convolution: the conv2d metadata with an [N, H, W, C] input, an
+// [out_channels, kh, kw, in_channels] weight and an [N, OH, OW, out_channels] output.
+// Runs as one GEMM over output pixels with memcpy-gathered patch rows.
+void hodu_cpu_conv2d_nhwc_f8e4m3(const void *input, const void *weight, void *output,
+                                 const size_t *metadata);
+void hodu_cpu_conv2d_nhwc_f8e5m2(const void *input, const void *weight, void *output,
+                                 const size_t *metadata);
+void hodu_cpu_conv2d_nhwc_bf16(const void *input, const void *weight, void *output,
+                               const size_t *metadata);
+void hodu_cpu_conv2d_nhwc_f16(const void *input, const void *weight, void *output,
+                              const size_t *metadata);
+void hodu_cpu_conv2d_nhwc_f32(const void *input, const void *weight, void *output,
+                              const size_t *metadata);
+void hodu_cpu_conv2d_nhwc_f64(const void *input, const void *weight, void *output,
+                              const size_t *metadata);
+
+// Grouped 2D convolution: the conv2d metadata plus metadata[18] = groups, with a
+// [out_channels, in_channels / groups, kh, kw] weight. groups == in_channels
+// (depthwise, optionally with a channel multiplier) runs a SIMD kernel over the
+// output width per (batch, channel) plane; other groups run one GEMM per
+// (batch, group). groups == 1 is hodu_cpu_conv2d_*. Groups that do not divide
+// both channel counts leave the output untouched.
+void hodu_cpu_conv2d_grouped_f32(const void *input, const void *weight, void *output,
+                                 const size_t *metadata);
+void hodu_cpu_conv2d_grouped_f64(const void *input, const void *weight, void *output,
+                                 const size_t *metadata);
+
 // 3D Convolution operations
 void hodu_cpu_conv3d_f8e4m3(const void *input, const void *weight, void *output,
                             const size_t *metadata);
@@ -142,7 +181,9 @@ void hodu_cpu_conv3d_f64(const void *input, const void *weight, void *output,
 // ============================================================================
 //
 // Transposed convolutions (deconvolutions) follow same metadata layouts
-// as their forward counterparts.
+// as their forward counterparts, with an [in_channels, out_channels, kernel...]
+// weight. f32/f64 run weight^T @ input as one GEMM per batch element and
+// scatter-add the columns onto the output (col2im / col2vol).
 
 // 1D Transposed Convolution operations
 void hodu_cpu_conv_transpose1d_f8e4m3(const void *input, const void *weight, void *output,
@@ -202,6 +243,10 @@ void hodu_cpu_conv_transpose3d_f64(const void *input, const void *weight, void *
 //   grad_output - Pointer to gradient tensor from next layer
 //   grad_weight - Pointer to output gradient weight buffer
 //   metadata    - Array describing convolution parameters (same as forward)
+//
+// Each filter is accumulated by a single pool task, without atomics. Without
+// BLAS, f32/f64 conv2d runs GEMMs over the im2col'd input with per-thread
+// partials; low-precision types run on widened f32 copies.
 
 // 1D Convolution gradient weight operations
 void hodu_cpu_conv1d_grad_weight_f8e4m3(const void *input, const void *grad_output,
@@ -287,6 +332,48 @@ void hodu_cpu_conv_transpose3d_grad_weight_f32(const void *input, const void *gr
 void hodu_cpu_conv_transpose3d_grad_weight_f64(const void *input, const void *grad_output,
                                                void *grad_weight, const size_t *metadata);
 
+// ============================================================================
+// FUSED CONVOLUTION (EPILOGUES)
+// ============================================================================
+//
+// conv2d followed by the element-wise epilogue of a conv layer, without
+// separate passes over the output (see epilogue.h):
+//   output = activation(scale * conv2d(input, weight) + bias + residual)
+//
+// Metadata layout: same as conv2d. bias holds out_channels values and residual
+// has the contiguous output shape. A NULL epilogue computes the plain
+// convolution. The convolution runs as im2col + native GEMM.
+
+void hodu_cpu_conv2d_fused_f32(const void *input, const void *weight, void *output,
+                               const size_t *metadata, const hodu_cpu_epilogue_t *epilogue);
+void hodu_cpu_conv2d_fused_f64(const void *input, const void *weight, void *output,
+                               const size_t *metadata, const hodu_cpu_epilogue_t *epilogue);
+
+// ============================================================================
+// PRE-PACKED WEIGHT CONVOLUTION
+// ============================================================================
+//
+// A constant conv2d weight [out_channels, in_channels, kernel_h, kernel_w] can
+// be packed once into the blocked GEMM layout and reused by every later call:
+//   bytes = hodu_cpu_conv2d_packed_weight_size_f32(metadata);
+//   hodu_cpu_conv2d_pack_weight_f32(weight, packed, metadata);             // once
+//   hodu_cpu_conv2d_packed_f32(input, packed, output, metadata, NULL);     // per call
+//
+// All three take the regular conv2d metadata; packing reads only the channel
+// and kernel sizes and weight_offset, so the packed weight can be reused for
+// any input size, stride, padding or dilation. hodu_cpu_conv2d_packed_* takes
+// the same optional epilogue as hodu_cpu_conv2d_fused_*. Packed buffers depend
+// on the build (SIMD width); weights.h stores them in files checked against it.
+
+size_t hodu_cpu_conv2d_packed_weight_size_f32(const size_t *metadata);
+size_t hodu_cpu_conv2d_packed_weight_size_f64(const size_t *metadata);
+void hodu_cpu_conv2d_pack_weight_f32(const void *weight, void *packed, const size_t *metadata);
+void hodu_cpu_conv2d_pack_weight_f64(const void *weight, void *packed, const size_t *metadata);
+void hodu_cpu_conv2d_packed_f32(const void *input, const void *packed_weight, void *output,
+                                const size_t *metadata, const hodu_cpu_epilogue_t *epilogue);
+void hodu_cpu_conv2d_packed_f64(const void *input, const void *packed_weight, void *output,
+                                const size_t *metadata, const hodu_cpu_epilogue_t *epilogue);
+
 #ifdef __cplusplus
 }
 #endif
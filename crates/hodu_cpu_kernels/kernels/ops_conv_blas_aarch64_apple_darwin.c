@@ -1,6 +1,9 @@
 #include "atomic.h"
 #include "ops_conv.h"
+#include "profile.h"
+#include "thread_utils.h"
 #include "types.h"
+#include "workspace.h"
 #include <cblas_new.h>
 #include <stdint.h>
 #include <stdlib.h>
@@ -18,185 +21,284 @@ extern void hodu_cpu_conv2d_grad_weight_f64_fallback(const void *input_ptr,
                                                      const void *grad_output_ptr,
                                                      void *grad_weight_ptr, const size_t *metadata);
 
-// Im2col for f32: Transform image patches to columns for GEMM-based convolution
-static inline void im2col_f32(const float *input, float *col_buffer, size_t in_channels,
-                              size_t in_height, size_t in_width, size_t kernel_height,
-                              size_t kernel_width, size_t out_height, size_t out_width,
-                              size_t stride_h, size_t stride_w, size_t padding_h, size_t padding_w,
-                              size_t dilation_h, size_t dilation_w) {
-    size_t col_idx = 0;
-    for (size_t oh = 0; oh < out_height; oh++) {
-        for (size_t ow = 0; ow < out_width; ow++) {
-            for (size_t ic = 0; ic < in_channels; ic++) {
-                for (size_t kh = 0; kh < kernel_height; kh++) {
-                    for (size_t kw = 0; kw < kernel_width; kw++) {
-                        const int ih =
-                            (int)(oh * stride_h) - (int)padding_h + (int)(kh * dilation_h);
-                        const int iw =
-                            (int)(ow * stride_w) - (int)padding_w + (int)(kw * dilation_w);
-
-                        if (ih >= 0 && ih < (int)in_height && iw >= 0 && iw < (int)in_width) {
-                            const size_t input_idx = ic * in_height * in_width + ih * in_width + iw;
-                            col_buffer[col_idx] = input[input_idx];
-                        } else {
-                            col_buffer[col_idx] = 0.0f; // Padding
-                        }
-                        col_idx++;
+// Column tiles: im2col fills [K, tile] slices of the [K, N] column matrix that stay
+// in L2 while the GEMM consumes them, instead of materializing all N columns
+#define CONV2D_BLAS_TILE_BYTES (256 * 1024)
+#define CONV2D_BLAS_MIN_TILE 64
+
+// Samples run in parallel on the thread pool (one single-threaded GEMM per task) when
+// the batch is large and each sample's GEMM is too small for BLAS to thread well
+#define CONV2D_BLAS_BATCH_MIN 2
+#define CONV2D_BLAS_BATCH_MAX_N 1024
+
+/// Im2col problem shape shared by conv2d and conv2d_grad_weight
+typedef struct {
+    size_t in_channels;
+    size_t in_height;
+    size_t in_width;
+    size_t kernel_height;
+    size_t kernel_width;
+    size_t out_height;
+    size_t out_width;
+    size_t stride_h;
+    size_t stride_w;
+    size_t padding_h;
+    size_t padding_w;
+    size_t dilation_h;
+    size_t dilation_w;
+} im2col_shape_t;
+
+// Number of output columns per im2col tile for K rows of elem_size bytes
+static inline size_t im2col_tile_cols(size_t K, size_t N, size_t elem_size) {
+    if (K == 0)
+        return N;
+    size_t tile = CONV2D_BLAS_TILE_BYTES / (K * elem_size);
+    tile = tile / 16 * 16;
+    if (tile < CONV2D_BLAS_MIN_TILE)
+        tile = CONV2D_BLAS_MIN_TILE;
+    return tile < N ? tile : N;
+}
+
+// Im2col for f32: fills output columns [col_start, col_start + cols) of the [K, N]
+// column matrix into col_buffer as a [K, cols] tile. Row (ic, kh, kw) holds the input
+// plane shifted by that kernel tap, so the GEMM reads the tile with leading dimension cols
+static inline void im2col_f32(const float *input, float *col_buffer, const im2col_shape_t *s,
+                              size_t col_start, size_t cols) {
+    const size_t oh_start = col_start / s->out_width;
+    const size_t ow_start = col_start % s->out_width;
+    for (size_t ic = 0; ic < s->in_channels; ic++) {
+        const float *plane = input + ic * s->in_height * s->in_width;
+        for (size_t kh = 0; kh < s->kernel_height; kh++) {
+            for (size_t kw = 0; kw < s->kernel_width; kw++) {
+                const long kh_off = (long)(kh * s->dilation_h) - (long)s->padding_h;
+                const long kw_off = (long)(kw * s->dilation_w) - (long)s->padding_w;
+                size_t oh = oh_start, ow = ow_start;
+                for (size_t n = 0; n < cols; n++) {
+                    const long ih = (long)(oh * s->stride_h) + kh_off;
+                    const long iw = (long)(ow * s->stride_w) + kw_off;
+                    if (ih >= 0 && ih < (long)s->in_height && iw >= 0 && iw < (long)s->in_width) {
+                        col_buffer[n] = plane[(size_t)ih * s->in_width + (size_t)iw];
+                    } else {
+                        col_buffer[n] = 0.0f; // Padding
+                    }
+                    if (++ow == s->out_width) {
+                        ow = 0;
+                        oh++;
                     }
                 }
+                col_buffer += cols;
             }
         }
     }
 }
 
-// Im2col for f64: Transform image patches to columns for GEMM-based convolution
-static inline void im2col_f64(const double *input, double *col_buffer, size_t in_channels,
-                              size_t in_height, size_t in_width, size_t kernel_height,
-                              size_t kernel_width, size_t out_height, size_t out_width,
-                              size_t stride_h, size_t stride_w, size_t padding_h, size_t padding_w,
-                              size_t dilation_h, size_t dilation_w) {
-    size_t col_idx = 0;
-    for (size_t oh = 0; oh < out_height; oh++) {
-        for (size_t ow = 0; ow < out_width; ow++) {
-            for (size_t ic = 0; ic < in_channels; ic++) {
-                for (size_t kh = 0; kh < kernel_height; kh++) {
-                    for (size_t kw = 0; kw < kernel_width; kw++) {
-                        const int ih =
-                            (int)(oh * stride_h) - (int)padding_h + (int)(kh * dilation_h);
-                        const int iw =
-                            (int)(ow * stride_w) - (int)padding_w + (int)(kw * dilation_w);
-
-                        if (ih >= 0 && ih < (int)in_height && iw >= 0 && iw < (int)in_width) {
-                            const size_t input_idx = ic * in_height * in_width + ih * in_width + iw;
-                            col_buffer[col_idx] = input[input_idx];
-                        } else {
-                            col_buffer[col_idx] = 0.0; // Padding
-                        }
-                        col_idx++;
+// Im2col for f64: fills output columns [col_start, col_start + cols) of the [K, N]
+// column matrix into col_buffer as a [K, cols] tile. Row (ic, kh, kw) holds the input
+// plane shifted by that kernel tap, so the GEMM reads the tile with leading dimension cols
+static inline void im2col_f64(const double *input, double *col_buffer, const im2col_shape_t *s,
+                              size_t col_start, size_t cols) {
+    const size_t oh_start = col_start / s->out_width;
+    const size_t ow_start = col_start % s->out_width;
+    for (size_t ic = 0; ic < s->in_channels; ic++) {
+        const double *plane = input + ic * s->in_height * s->in_width;
+        for (size_t kh = 0; kh < s->kernel_height; kh++) {
+            for (size_t kw = 0; kw < s->kernel_width; kw++) {
+                const long kh_off = (long)(kh * s->dilation_h) - (long)s->padding_h;
+                const long kw_off = (long)(kw * s->dilation_w) - (long)s->padding_w;
+                size_t oh = oh_start, ow = ow_start;
+                for (size_t n = 0; n < cols; n++) {
+                    const long ih = (long)(oh * s->stride_h) + kh_off;
+                    const long iw = (long)(ow * s->stride_w) + kw_off;
+                    if (ih >= 0 && ih < (long)s->in_height && iw >= 0 && iw < (long)s->in_width) {
+                        col_buffer[n] = plane[(size_t)ih * s->in_width + (size_t)iw];
+                    } else {
+                        col_buffer[n] = 0.0; // Padding
+                    }
+                    if (++ow == s->out_width) {
+                        ow = 0;
+                        oh++;
                     }
                 }
+                col_buffer += cols;
             }
         }
     }
 }
 
-// Accelerate BLAS-optimized conv2d for f32 using im2col + GEMM
+/// Per-call state of the f32 conv2d batch loop
+typedef struct {
+    const float *input;  // first element of sample 0
+    const float *weight; // [M, K] weights
+    float *output;
+    const size_t *metadata; // for the fallback on allocation failure
+    im2col_shape_t shape;
+    size_t M, K, N, tile;
+} conv2d_blas_f32_args_t;
+
+// Samples [start, end): im2col one column tile at a time and multiply it into the output
+static void conv2d_blas_f32_task(size_t start, size_t end, void *ctx) {
+    const conv2d_blas_f32_args_t *a = (const conv2d_blas_f32_args_t *)ctx;
+    const size_t sample_in = a->shape.in_channels * a->shape.in_height * a->shape.in_width;
+    const size_t sample_out = a->M * a->N;
+
+    // Column tile [K, tile] from this thread's scratch workspace
+    float *col_buffer = (float *)workspace_acquire(a->K * a->tile * sizeof(float));
+    if (!col_buffer) {
+        // Fallback to naive implementation for these samples if allocation fails
+        size_t sub[18];
+        memcpy(sub, a->metadata, sizeof(sub));
+        sub[0] = (end - start) * sample_out;
+        sub[1] = end - start;
+        sub[16] += start * sample_in;
+        hodu_cpu_conv2d_f32_fallback(a->input - a->metadata[16], a->weight - a->metadata[17],
+                                     a->output + start * sample_out, sub);
+        return;
+    }
+
+    for (size_t b = start; b < end; b++) {
+        const float *batch_input = a->input + b * sample_in;
+        float *batch_output = a->output + b * sample_out;
+        for (size_t n0 = 0; n0 < a->N; n0 += a->tile) {
+            const size_t cols = a->N - n0 < a->tile ? a->N - n0 : a->tile;
+            im2col_f32(batch_input, col_buffer, &a->shape, n0, cols);
+
+            HODU_PROFILE_PATH(HODU_CPU_PATH_BLAS);
+            // GEMM: output[:, n0:n0+cols] = weight × col_buffer
+            cblas_sgemm(CblasRowMajor, CblasNoTrans, CblasNoTrans, a->M, cols, a->K, 1.0f,
+                        a->weight, a->K, col_buffer, cols, 0.0f, batch_output + n0, a->N);
+        }
+    }
+
+    workspace_release(col_buffer);
+}
+
+// Accelerate BLAS-optimized conv2d for f32 using tiled im2col + GEMM
 void hodu_cpu_conv2d_f32(const void *input_ptr, const void *weight_ptr, void *output_ptr,
                          const size_t *metadata) {
-    const float *input = (const float *)input_ptr;
-    const float *weight = (const float *)weight_ptr;
-    float *output = (float *)output_ptr;
+    HODU_PROFILE_KERNEL(hodu_cpu_profile_conv_bytes(metadata, 2, sizeof(f32_t)));
+    conv2d_blas_f32_args_t args;
+    args.shape.in_channels = metadata[2];
+    args.shape.in_height = metadata[4];
+    args.shape.in_width = metadata[5];
+    args.shape.kernel_height = metadata[6];
+    args.shape.kernel_width = metadata[7];
+    args.shape.out_height = metadata[8];
+    args.shape.out_width = metadata[9];
+    args.shape.stride_h = metadata[10];
+    args.shape.stride_w = metadata[11];
+    args.shape.padding_h = metadata[12];
+    args.shape.padding_w = metadata[13];
+    args.shape.dilation_h = metadata[14];
+    args.shape.dilation_w = metadata[15];
 
     const size_t batch = metadata[1];
-    const size_t in_channels = metadata[2];
-    const size_t out_channels = metadata[3];
-    const size_t in_height = metadata[4];
-    const size_t in_width = metadata[5];
-    const size_t kernel_height = metadata[6];
-    const size_t kernel_width = metadata[7];
-    const size_t out_height = metadata[8];
-    const size_t out_width = metadata[9];
-    const size_t stride_h = metadata[10];
-    const size_t stride_w = metadata[11];
-    const size_t padding_h = metadata[12];
-    const size_t padding_w = metadata[13];
-    const size_t dilation_h = metadata[14];
-    const size_t dilation_w = metadata[15];
-    const size_t input_offset = metadata[16];
-    const size_t weight_offset = metadata[17];
-
-    // Use im2col + GEMM for optimized convolution
-    const size_t K = in_channels * kernel_height * kernel_width;
-    const size_t N = out_height * out_width;
-    const size_t M = out_channels;
+    args.input = (const float *)input_ptr + metadata[16];
+    args.weight = (const float *)weight_ptr + metadata[17];
+    args.output = (float *)output_ptr;
+    args.metadata = metadata;
+    args.M = metadata[3];
+    args.K = args.shape.in_channels * args.shape.kernel_height * args.shape.kernel_width;
+    args.N = args.shape.out_height * args.shape.out_width;
+    if (args.M == 0 || args.N == 0 || batch == 0)
+        return;
+    args.tile = im2col_tile_cols(args.K, args.N, sizeof(float));
 
-    // Allocate column buffer: [K, N]
-    float *col_buffer = (float *)malloc(K * N * sizeof(float));
+    if (batch >= CONV2D_BLAS_BATCH_MIN && args.N <= CONV2D_BLAS_BATCH_MAX_N) {
+        parallel_for(0, batch, 1, conv2d_blas_f32_task, &args);
+    } else {
+        conv2d_blas_f32_task(0, batch, &args);
+    }
+}
+
+/// Per-call state of the f64 conv2d batch loop
+typedef struct {
+    const double *input;  // first element of sample 0
+    const double *weight; // [M, K] weights
+    double *output;
+    const size_t *metadata; // for the fallback on allocation failure
+    im2col_shape_t shape;
+    size_t M, K, N, tile;
+} conv2d_blas_f64_args_t;
+
+// Samples [start, end): im2col one column tile at a time and multiply it into the output
+static void conv2d_blas_f64_task(size_t start, size_t end, void *ctx) {
+    const conv2d_blas_f64_args_t *a = (const conv2d_blas_f64_args_t *)ctx;
+    const size_t sample_in = a->shape.in_channels * a->shape.in_height * a->shape.in_width;
+    const size_t sample_out = a->M * a->N;
+
+    // Column tile [K, tile] from this thread's scratch workspace
+    double *col_buffer = (double *)workspace_acquire(a->K * a->tile * sizeof(double));
     if (!col_buffer) {
-        // Fallback to naive implementation if allocation fails
-        hodu_cpu_conv2d_f32_fallback(input_ptr, weight_ptr, output_ptr, metadata);
+        // Fallback to naive implementation for these samples if allocation fails
+        size_t sub[18];
+        memcpy(sub, a->metadata, sizeof(sub));
+        sub[0] = (end - start) * sample_out;
+        sub[1] = end - start;
+        sub[16] += start * sample_in;
+        hodu_cpu_conv2d_f64_fallback(a->input - a->metadata[16], a->weight - a->metadata[17],
+                                     a->output + start * sample_out, sub);
         return;
     }
 
-    // Process each batch element
-    for (size_t b = 0; b < batch; b++) {
-        // Im2col: Transform input patches to columns
-        const float *batch_input = input + input_offset + b * in_channels * in_height * in_width;
-        im2col_f32(batch_input, col_buffer, in_channels, in_height, in_width, kernel_height,
-                   kernel_width, out_height, out_width, stride_h, stride_w, padding_h, padding_w,
-                   dilation_h, dilation_w);
-
-        // GEMM: output = weight × col_buffer
-        float *batch_output = output + b * out_channels * out_height * out_width;
-        const float *batch_weight = weight + weight_offset;
-
-        cblas_sgemm(CblasRowMajor, CblasNoTrans, CblasNoTrans, M, N, K, 1.0f, batch_weight, K,
-                    col_buffer, N, 0.0f, batch_output, N);
+    for (size_t b = start; b < end; b++) {
+        const double *batch_input = a->input + b * sample_in;
+        double *batch_output = a->output + b * sample_out;
+        for (size_t n0 = 0; n0 < a->N; n0 += a->tile) {
+            const size_t cols = a->N - n0 < a->tile ? a->N - n0 : a->tile;
+            im2col_f64(batch_input, col_buffer, &a->shape, n0, cols);
+
+            HODU_PROFILE_PATH(HODU_CPU_PATH_BLAS);
+            // GEMM: output[:, n0:n0+cols] = weight × col_buffer
+            cblas_dgemm(CblasRowMajor, CblasNoTrans, CblasNoTrans, a->M, cols, a->K, 1.0,
+                        a->weight, a->K, col_buffer, cols, 0.0, batch_output + n0, a->N);
+        }
     }
 
-    free(col_buffer);
+    workspace_release(col_buffer);
 }
 
-// Accelerate BLAS-optimized conv2d for f64 using im2col + GEMM
+// Accelerate BLAS-optimized conv2d for f64 using tiled im2col + GEMM
 void hodu_cpu_conv2d_f64(const void *input_ptr, const void *weight_ptr, void *output_ptr,
                          const size_t *metadata) {
-    const double *input = (const double *)input_ptr;
-    const double *weight = (const double *)weight_ptr;
-    double *output = (double *)output_ptr;
+    HODU_PROFILE_KERNEL(hodu_cpu_profile_conv_bytes(metadata, 2, sizeof(f64_t)));
+    conv2d_blas_f64_args_t args;
+    args.shape.in_channels = metadata[2];
+    args.shape.in_height = metadata[4];
+    args.shape.in_width = metadata[5];
+    args.shape.kernel_height = metadata[6];
+    args.shape.kernel_width = metadata[7];
+    args.shape.out_height = metadata[8];
+    args.shape.out_width = metadata[9];
+    args.shape.stride_h = metadata[10];
+    args.shape.stride_w = metadata[11];
+    args.shape.padding_h = metadata[12];
+    args.shape.padding_w = metadata[13];
+    args.shape.dilation_h = metadata[14];
+    args.shape.dilation_w = metadata[15];
 
     const size_t batch = metadata[1];
-    const size_t in_channels = metadata[2];
-    const size_t out_channels = metadata[3];
-    const size_t in_height = metadata[4];
-    const size_t in_width = metadata[5];
-    const size_t kernel_height = metadata[6];
-    const size_t kernel_width = metadata[7];
-    const size_t out_height = metadata[8];
-    const size_t out_width = metadata[9];
-    const size_t stride_h = metadata[10];
-    const size_t stride_w = metadata[11];
-    const size_t padding_h = metadata[12];
-    const size_t padding_w = metadata[13];
-    const size_t dilation_h = metadata[14];
-    const size_t dilation_w = metadata[15];
-    const size_t input_offset = metadata[16];
-    const size_t weight_offset = metadata[17];
-
-    // Use im2col + GEMM for optimized convolution
-    const size_t K = in_channels * kernel_height * kernel_width;
-    const size_t N = out_height * out_width;
-    const size_t M = out_channels;
-
-    // Allocate column buffer: [K, N]
-    double *col_buffer = (double *)malloc(K * N * sizeof(double));
-    if (!col_buffer) {
-        // Fallback to naive implementation if allocation fails
-        hodu_cpu_conv2d_f64_fallback(input_ptr, weight_ptr, output_ptr, metadata);
+    args.input = (const double *)input_ptr + metadata[16];
+    args.weight = (const double *)weight_ptr + metadata[17];
+    args.output = (double *)output_ptr;
+    args.metadata = metadata;
+    args.M = metadata[3];
+    args.K = args.shape.in_channels * args.shape.kernel_height * args.shape.kernel_width;
+    args.N = args.shape.out_height * args.shape.out_width;
+    if (args.M == 0 || args.N == 0 || batch == 0)
         return;
-    }
+    args.tile = im2col_tile_cols(args.K, args.N, sizeof(double));
 
-    // Process each batch element
-    for (size_t b = 0; b < batch; b++) {
-        // Im2col: Transform input patches to columns
-        const double *batch_input = input + input_offset + b * in_channels * in_height * in_width;
-        im2col_f64(batch_input, col_buffer, in_channels, in_height, in_width, kernel_height,
-                   kernel_width, out_height, out_width, stride_h, stride_w, padding_h, padding_w,
-                   dilation_h, dilation_w);
-
-        // GEMM: output = weight × col_buffer
-        double *batch_output = output + b * out_channels * out_height * out_width;
-        const double *batch_weight = weight + weight_offset;
-
-        cblas_dgemm(CblasRowMajor, CblasNoTrans, CblasNoTrans, M, N, K, 1.0, batch_weight, K,
-                    col_buffer, N, 0.0, batch_output, N);
+    if (batch >= CONV2D_BLAS_BATCH_MIN && args.N <= CONV2D_BLAS_BATCH_MAX_N) {
+        parallel_for(0, batch, 1, conv2d_blas_f64_task, &args);
+    } else {
+        conv2d_blas_f64_task(0, batch, &args);
     }
-
-    free(col_buffer);
 }
 
 // Accelerate BLAS-optimized conv2d_grad_weight for f32 using im2col + GEMM
 void hodu_cpu_conv2d_grad_weight_f32(const void *input_ptr, const void *grad_output_ptr,
                                      void *grad_weight_ptr, const size_t *metadata) {
+    HODU_PROFILE_KERNEL(hodu_cpu_profile_conv_bytes(metadata, 2, sizeof(f32_t)));
     const float *input = (const float *)input_ptr;
     const float *grad_output = (const float *)grad_output_ptr;
     float *grad_weight = (float *)grad_weight_ptr;
@@ -254,8 +356,13 @@ void hodu_cpu_conv2d_grad_weight_f32(const void *input_ptr, const void *grad_out
     const size_t N = out_height * out_width;
     const size_t M = out_channels;
 
-    // Allocate column buffer: [K, N]
-    float *col_buffer = (float *)malloc(K * N * sizeof(float));
+    const im2col_shape_t shape = {
+        in_channels, in_height, in_width,  kernel_height, kernel_width, out_height, out_width,
+        stride_h,    stride_w,  padding_h, padding_w,     dilation_h,   dilation_w};
+    const size_t tile = im2col_tile_cols(K, N, sizeof(float));
+
+    // Column tile [K, tile] from the scratch workspace
+    float *col_buffer = (float *)workspace_acquire(K * tile * sizeof(float));
     if (!col_buffer) {
         hodu_cpu_conv2d_grad_weight_f32_fallback(input_ptr, grad_output_ptr, grad_weight_ptr,
                                                  metadata);
@@ -264,26 +371,29 @@ void hodu_cpu_conv2d_grad_weight_f32(const void *input_ptr, const void *grad_out
 
     // Process each batch element and accumulate gradients
     for (size_t b = 0; b < batch; b++) {
-        // Im2col: Transform input patches to columns
         const float *batch_input = input + input_offset + b * in_channels * in_height * in_width;
-        im2col_f32(batch_input, col_buffer, in_channels, in_height, in_width, kernel_height,
-                   kernel_width, out_height, out_width, stride_h, stride_w, padding_h, padding_w,
-                   dilation_h, dilation_w);
-
-        // GEMM: grad_weight += grad_output × col_buffer^T
         const float *batch_grad_output =
             grad_output + grad_output_offset + b * out_channels * out_height * out_width;
 
-        cblas_sgemm(CblasRowMajor, CblasNoTrans, CblasTrans, M, K, N, 1.0f, batch_grad_output, N,
-                    col_buffer, N, 1.0f, grad_weight, K);
+        for (size_t n0 = 0; n0 < N; n0 += tile) {
+            // Im2col: Transform the input patches of output columns [n0, n0 + cols)
+            const size_t cols = N - n0 < tile ? N - n0 : tile;
+            im2col_f32(batch_input, col_buffer, &shape, n0, cols);
+
+            HODU_PROFILE_PATH(HODU_CPU_PATH_BLAS);
+            // GEMM: grad_weight += grad_output[:, n0:n0+cols] × col_buffer^T
+            cblas_sgemm(CblasRowMajor, CblasNoTrans, CblasTrans, M, K, cols, 1.0f,
+                        batch_grad_output + n0, N, col_buffer, cols, 1.0f, grad_weight, K);
+        }
     }
 
-    free(col_buffer);
+    workspace_release(col_buffer);
 }
 
 // Accelerate BLAS-optimized conv2d_grad_weight for f64 using im2col + GEMM
 void hodu_cpu_conv2d_grad_weight_f64(const void *input_ptr, const void *grad_output_ptr,
                                      void *grad_weight_ptr, const size_t *metadata) {
+    HODU_PROFILE_KERNEL(hodu_cpu_profile_conv_bytes(metadata, 2, sizeof(f64_t)));
     const double *input = (const double *)input_ptr;
     const double *grad_output = (const double *)grad_output_ptr;
     double *grad_weight = (double *)grad_weight_ptr;
@@ -341,8 +451,13 @@ void hodu_cpu_conv2d_grad_weight_f64(const void *input_ptr, const void *grad_out
     const size_t N = out_height * out_width;
     const size_t M = out_channels;
 
-    // Allocate column buffer: [K, N]
-    double *col_buffer = (double *)malloc(K * N * sizeof(double));
+    const im2col_shape_t shape = {
+        in_channels, in_height, in_width,  kernel_height, kernel_width, out_height, out_width,
+        stride_h,    stride_w,  padding_h, padding_w,     dilation_h,   dilation_w};
+    const size_t tile = im2col_tile_cols(K, N, sizeof(double));
+
+    // Column tile [K, tile] from the scratch workspace
+    double *col_buffer = (double *)workspace_acquire(K * tile * sizeof(double));
     if (!col_buffer) {
         hodu_cpu_conv2d_grad_weight_f64_fallback(input_ptr, grad_output_ptr, grad_weight_ptr,
                                                  metadata);
@@ -351,19 +466,21 @@ void hodu_cpu_conv2d_grad_weight_f64(const void *input_ptr, const void *grad_out
 
     // Process each batch element and accumulate gradients
     for (size_t b = 0; b < batch; b++) {
-        // Im2col: Transform input patches to columns
         const double *batch_input = input + input_offset + b * in_channels * in_height * in_width;
-        im2col_f64(batch_input, col_buffer, in_channels, in_height, in_width, kernel_height,
-                   kernel_width, out_height, out_width, stride_h, stride_w, padding_h, padding_w,
-                   dilation_h, dilation_w);
-
-        // GEMM: grad_weight += grad_output × col_buffer^T
         const double *batch_grad_output =
             grad_output + grad_output_offset + b * out_channels * out_height * out_width;
 
-        cblas_dgemm(CblasRowMajor, CblasNoTrans, CblasTrans, M, K, N, 1.0, batch_grad_output, N,
-                    col_buffer, N, 1.0, grad_weight, K);
+        for (size_t n0 = 0; n0 < N; n0 += tile) {
+            // Im2col: Transform the input patches of output columns [n0, n0 + cols)
+            const size_t cols = N - n0 < tile ? N - n0 : tile;
+            im2col_f64(batch_input, col_buffer, &shape, n0, cols);
+
+            HODU_PROFILE_PATH(HODU_CPU_PATH_BLAS);
+            // GEMM: grad_weight += grad_output[:, n0:n0+cols] × col_buffer^T
+            cblas_dgemm(CblasRowMajor, CblasNoTrans, CblasTrans, M, K, cols, 1.0,
+                        batch_grad_output + n0, N, col_buffer, cols, 1.0, grad_weight, K);
+        }
     }
 
-    free(col_buffer);
+    workspace_release(col_buffer);
 }
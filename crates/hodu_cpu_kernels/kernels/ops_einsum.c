@@ -1,5 +1,12 @@
 #include "ops_einsum.h"
+#include "gemm.h"
+#include "profile.h"
+#include "strided_copy.h"
+#include "thread_utils.h"
 #include "types.h"
+#include "workspace.h"
+#include <stdbool.h>
+#include <string.h>
 
 #define MAX_INPUTS 4
 #define MAX_INDICES 16
@@ -69,120 +76,639 @@ static void parse_metadata(const size_t *metadata, EinsumMeta *meta) {
     }
 }
 
-#define IMPL_EINSUM(TYPE, TYPE_SUFFIX)                                                             \
-    void hodu_cpu_einsum_##TYPE_SUFFIX(const void **inputs, void *output,                          \
-                                       const size_t *metadata) {                                   \
-        EinsumMeta meta;                                                                           \
-        parse_metadata(metadata, &meta);                                                           \
-                                                                                                   \
-        TYPE *out = (TYPE *)output;                                                                \
-                                                                                                   \
-        size_t num_contraction_els = 1;                                                            \
-        for (size_t i = 0; i < meta.num_contraction_indices; i++) {                                \
-            num_contraction_els *= meta.index_sizes[meta.contraction_index_ids[i]];                \
-        }                                                                                          \
-                                                                                                   \
-        for (size_t out_idx = 0; out_idx < meta.num_output_els; out_idx++) {                       \
-            size_t index_values[MAX_INDICES] = {0};                                                \
-                                                                                                   \
-            size_t tmp = out_idx;                                                                  \
-            for (int d = (int)meta.output_ndim - 1; d >= 0; d--) {                                 \
-                size_t coord = tmp % meta.output_shape[d];                                         \
-                tmp /= meta.output_shape[d];                                                       \
-                index_values[meta.output_index_ids[d]] = coord;                                    \
-            }                                                                                      \
-                                                                                                   \
-            TYPE sum = (TYPE)0;                                                                    \
-                                                                                                   \
-            for (size_t c_idx = 0; c_idx < num_contraction_els; c_idx++) {                         \
-                size_t tmp_c = c_idx;                                                              \
-                for (int i = (int)meta.num_contraction_indices - 1; i >= 0; i--) {                 \
-                    size_t idx_id = meta.contraction_index_ids[i];                                 \
-                    size_t sz = meta.index_sizes[idx_id];                                          \
-                    index_values[idx_id] = tmp_c % sz;                                             \
-                    tmp_c /= sz;                                                                   \
-                }                                                                                  \
-                                                                                                   \
-                TYPE product = (TYPE)1;                                                            \
-                for (size_t inp = 0; inp < meta.num_inputs; inp++) {                               \
-                    const TYPE *in = (const TYPE *)inputs[inp] + meta.inputs[inp].offset;          \
-                    size_t in_idx = 0;                                                             \
-                    for (size_t d = 0; d < meta.inputs[inp].ndim; d++) {                           \
-                        size_t idx_id = meta.inputs[inp].dim_to_index[d];                          \
-                        in_idx += index_values[idx_id] * meta.inputs[inp].strides[d];              \
-                    }                                                                              \
-                    product *= in[in_idx];                                                         \
-                }                                                                                  \
-                sum += product;                                                                    \
-            }                                                                                      \
-                                                                                                   \
-            out[out_idx] = sum;                                                                    \
-        }                                                                                          \
+#ifdef HODU_PROFILE_ACTIVE
+/// Input and output bytes of an einsum call (walks the layout parse_metadata reads)
+static inline uint64_t einsum_profile_bytes(const size_t *metadata, size_t elem_size) {
+    uint64_t elems = metadata[0];
+    size_t pos = 5 + metadata[4];
+    for (size_t inp = 0; inp < metadata[1]; inp++) {
+        const size_t ndim = metadata[pos];
+        elems += hodu_cpu_profile_numel(metadata + pos + 1, ndim);
+        pos += 2 + 3 * ndim;
     }
+    return elems * elem_size;
+}
+#endif
 
-IMPL_EINSUM(f32_t, f32)
-IMPL_EINSUM(f64_t, f64)
-IMPL_EINSUM(u8_t, u8)
-IMPL_EINSUM(u16_t, u16)
-IMPL_EINSUM(u32_t, u32)
-IMPL_EINSUM(u64_t, u64)
-IMPL_EINSUM(i8_t, i8)
-IMPL_EINSUM(i16_t, i16)
-IMPL_EINSUM(i32_t, i32)
-IMPL_EINSUM(i64_t, i64)
+// ============================================================================
+// CONTRACTION PLANNER
+// ============================================================================
+//
+// Operands are viewed as one stride per distinct index (an index repeated
+// within an operand, as in "ii->i", becomes a diagonal view whose stride is
+// the sum of the repeated dims' strides). Then:
+// - one operand without summed indices is a permuted/diagonal copy and goes
+//   to the strided-copy engine
+// - more than two operands are contracted pairwise, greedily picking the pair
+//   with the smallest intermediate; intermediates are laid out batch x m x n
+// - each pair is lowered to batched GEMM: indices in both operands and the
+//   result are batch dims, indices in one operand and the result are M or N,
+//   indices in both operands only are K. Indices summed within a single
+//   operand are reduced first; operands whose M/N/K dims do not collapse to a
+//   single stride are packed once with the strided-copy engine, and a result
+//   order other than batch x M x N (or batch x N x M, by swapping operands) is
+//   produced in scratch and permuted into place
+// Integer types have no GEMM engine and contract each pair (and single-operand
+// reductions) with a sum-of-products loop over the result on the thread pool.
+// Low-precision intermediates are rounded to their type between pairwise
+// steps.
 
-#define IMPL_EINSUM_CONVERT(TYPE, TYPE_SUFFIX, TO_FLOAT, FROM_FLOAT)                               \
-    void hodu_cpu_einsum_##TYPE_SUFFIX(const void **inputs, void *output,                          \
-                                       const size_t *metadata) {                                   \
-        EinsumMeta meta;                                                                           \
-        parse_metadata(metadata, &meta);                                                           \
-                                                                                                   \
-        TYPE *out = (TYPE *)output;                                                                \
-                                                                                                   \
-        size_t num_contraction_els = 1;                                                            \
-        for (size_t i = 0; i < meta.num_contraction_indices; i++) {                                \
-            num_contraction_els *= meta.index_sizes[meta.contraction_index_ids[i]];                \
-        }                                                                                          \
-                                                                                                   \
-        for (size_t out_idx = 0; out_idx < meta.num_output_els; out_idx++) {                       \
-            size_t index_values[MAX_INDICES] = {0};                                                \
-                                                                                                   \
+// Batched GEMMs below this much work run batches in parallel instead of one
+// parallel GEMM after another
+#define EINSUM_BATCH_PARALLEL_WORK ((size_t)1 << 20)
+// Minimum multiply-adds per loop task
+#define EINSUM_TASK_WORK ((size_t)1 << 14)
+
+/// An operand: one stride (in elements) per distinct index
+typedef struct {
+    const char *data;
+    size_t ndim;
+    size_t ids[MAX_INDICES];
+    size_t strides[MAX_INDICES];
+} einsum_view_t;
+
+typedef void (*einsum_gemm_fn_t)(size_t M, size_t N, size_t K, const void *a, size_t a_rs,
+                                 size_t a_cs, const void *b, size_t b_rs, size_t b_cs, void *c,
+                                 size_t ldc);
+
+/// Sum-of-products loop over the result of up to MAX_INPUTS operands
+typedef struct {
+    size_t num_inputs;
+    const char *data[MAX_INPUTS];
+    size_t strides[MAX_INPUTS][MAX_INDICES]; // stride of each index id, 0 if absent
+    size_t out_ndim;
+    size_t out_ids[MAX_INDICES];
+    size_t num_sum;
+    size_t sum_ids[MAX_INDICES];
+    const size_t *index_sizes;
+    void *out;
+} einsum_loop_t;
+
+typedef struct {
+    size_t elem_size;
+    einsum_gemm_fn_t gemm; // NULL: loop only
+    parallel_for_fn loop_worker;
+} einsum_type_t;
+
+static bool einsum_has(const size_t *ids, size_t n, size_t id) {
+    for (size_t i = 0; i < n; i++) {
+        if (ids[i] == id) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static size_t einsum_stride(const einsum_view_t *v, size_t id) {
+    for (size_t i = 0; i < v->ndim; i++) {
+        if (v->ids[i] == id) {
+            return v->strides[i];
+        }
+    }
+    return 0;
+}
+
+static size_t einsum_numel(const size_t *ids, size_t n, const size_t *index_sizes) {
+    size_t numel = 1;
+    for (size_t i = 0; i < n; i++) {
+        numel *= index_sizes[ids[i]];
+    }
+    return numel;
+}
+
+/// Sum of products of the views into a contiguous result in out_ids order
+static void einsum_loop(const einsum_type_t *t, const einsum_view_t *views, size_t num_views,
+                        size_t out_ndim, const size_t *out_ids, const size_t *index_sizes,
+                        void *out) {
+    einsum_loop_t loop;
+    memset(&loop, 0, sizeof(loop));
+    loop.num_inputs = num_views;
+    loop.out_ndim = out_ndim;
+    memcpy(loop.out_ids, out_ids, out_ndim * sizeof(size_t));
+    loop.index_sizes = index_sizes;
+    loop.out = out;
+    for (size_t v = 0; v < num_views; v++) {
+        loop.data[v] = views[v].data;
+        for (size_t i = 0; i < views[v].ndim; i++) {
+            const size_t id = views[v].ids[i];
+            loop.strides[v][id] = views[v].strides[i];
+            if (!einsum_has(out_ids, out_ndim, id) && !einsum_has(loop.sum_ids, loop.num_sum, id)) {
+                loop.sum_ids[loop.num_sum++] = id;
+            }
+        }
+    }
+    const size_t out_els = einsum_numel(out_ids, out_ndim, index_sizes);
+    const size_t sum_els = einsum_numel(loop.sum_ids, loop.num_sum, index_sizes);
+    if (sum_els == 0) {
+        memset(out, 0, out_els * t->elem_size);
+        return;
+    }
+    parallel_for(0, out_els, EINSUM_TASK_WORK / (sum_els * num_views) + 1, t->loop_worker, &loop);
+}
+
+/// Whether the view's dims for ids (outermost first) collapse to one stride; returns it in *stride
+static bool einsum_collapse(const einsum_view_t *v, const size_t *ids, size_t n,
+                            const size_t *index_sizes, size_t *stride) {
+    size_t extent = 0;
+    bool found = false;
+    *stride = 1;
+    for (size_t i = n; i-- > 0;) {
+        const size_t size = index_sizes[ids[i]];
+        if (size == 1) {
+            continue;
+        }
+        const size_t s = einsum_stride(v, ids[i]);
+        if (!found) {
+            *stride = s;
+            found = true;
+        } else if (s != extent) {
+            return false;
+        }
+        extent = s * size;
+    }
+    return true;
+}
+
+/// Copy the view dims for ids (outermost first) into contiguous dst and point v at it
+static void einsum_pack(const einsum_type_t *t, einsum_view_t *v, const size_t *ids, size_t n,
+                        const size_t *index_sizes, char *dst) {
+    size_t shape[MAX_INDICES] = {0}, strides[MAX_INDICES] = {0};
+    for (size_t i = 0; i < n; i++) {
+        shape[i] = index_sizes[ids[i]];
+        strides[i] = einsum_stride(v, ids[i]);
+    }
+    hodu_cpu_strided_copy(v->data, dst, t->elem_size, n, shape, strides, NULL);
+    v->data = dst;
+    v->ndim = n;
+    size_t s = 1;
+    for (size_t i = n; i-- > 0;) {
+        v->ids[i] = ids[i];
+        v->strides[i] = s;
+        s *= shape[i];
+    }
+}
+
+typedef struct {
+    einsum_gemm_fn_t gemm;
+    size_t elem_size;
+    const char *a;
+    const char *b;
+    char *c;
+    size_t num_batch;
+    size_t batch_sizes[MAX_INDICES];
+    size_t a_batch[MAX_INDICES];
+    size_t b_batch[MAX_INDICES];
+    size_t batch_ndim;
+    size_t M, N, K;
+    size_t a_m, a_k, b_k, b_n;
+    bool swap; // C is batch x N x M
+} einsum_gemm_args_t;
+
+static void einsum_gemm_batches(size_t start, size_t end, void *ctx) {
+    const einsum_gemm_args_t *g = (const einsum_gemm_args_t *)ctx;
+    const size_t es = g->elem_size;
+    for (size_t batch = start; batch < end; batch++) {
+        size_t a_off = 0, b_off = 0, rem = batch;
+        for (size_t d = g->batch_ndim; d-- > 0;) {
+            const size_t coord = rem % g->batch_sizes[d];
+            rem /= g->batch_sizes[d];
+            a_off += coord * g->a_batch[d];
+            b_off += coord * g->b_batch[d];
+        }
+        const char *a = g->a + a_off * es;
+        const char *b = g->b + b_off * es;
+        char *c = g->c + batch * g->M * g->N * es;
+        if (g->swap) {
+            g->gemm(g->N, g->M, g->K, b, g->b_n, g->b_k, a, g->a_k, g->a_m, c, g->M);
+        } else {
+            g->gemm(g->M, g->N, g->K, a, g->a_m, g->a_k, b, g->b_k, g->b_n, c, g->N);
+        }
+    }
+}
+
+/// Reduce the indices of v that are absent from keep (of n ids) into scratch; returns the bytes
+/// taken from cursor
+static size_t einsum_reduce_private(const einsum_type_t *t, einsum_view_t *v, const size_t *keep,
+                                    size_t n, const size_t *index_sizes, char *cursor) {
+    size_t ids[MAX_INDICES], num_ids = 0;
+    for (size_t i = 0; i < v->ndim; i++) {
+        if (einsum_has(keep, n, v->ids[i])) {
+            ids[num_ids++] = v->ids[i];
+        }
+    }
+    if (num_ids == v->ndim) {
+        return 0;
+    }
+    einsum_loop(t, v, 1, num_ids, ids, index_sizes, cursor);
+    v->data = cursor;
+    v->ndim = num_ids;
+    size_t s = 1;
+    for (size_t i = num_ids; i-- > 0;) {
+        v->ids[i] = ids[i];
+        v->strides[i] = s;
+        s *= index_sizes[ids[i]];
+    }
+    return hodu_cpu_workspace_block_size(s * t->elem_size);
+}
+
+/// Contract two views into a contiguous result in out_ids order
+static void einsum_pair(const einsum_type_t *t, einsum_view_t a, einsum_view_t b,
+                        size_t out_ndim, const size_t *out_ids, const size_t *index_sizes,
+                        void *out) {
+    if (!t->gemm) {
+        const einsum_view_t views[2] = {a, b};
+        einsum_loop(t, views, 2, out_ndim, out_ids, index_sizes, out);
+        return;
+    }
+    const size_t es = t->elem_size;
+    const size_t out_els = einsum_numel(out_ids, out_ndim, index_sizes);
+    if (out_els == 0) {
+        return;
+    }
+
+    // Scratch bound: reduced or packed copies of both operands and a permuted result
+    size_t bytes = hodu_cpu_workspace_block_size(out_els * es);
+    size_t a_els = 1, b_els = 1;
+    for (size_t i = 0; i < a.ndim; i++) {
+        a_els *= index_sizes[a.ids[i]];
+    }
+    for (size_t i = 0; i < b.ndim; i++) {
+        b_els *= index_sizes[b.ids[i]];
+    }
+    bytes += 2 * hodu_cpu_workspace_block_size(a_els * es);
+    bytes += 2 * hodu_cpu_workspace_block_size(b_els * es);
+    char *scratch = (char *)workspace_acquire(bytes);
+    if (!scratch) {
+        const einsum_view_t views[2] = {a, b};
+        einsum_loop(t, views, 2, out_ndim, out_ids, index_sizes, out);
+        return;
+    }
+    char *cursor = scratch;
+
+    // An index kept by a is in b or the result
+    size_t keep[2 * MAX_INDICES], num_keep = 0;
+    for (size_t i = 0; i < out_ndim; i++) {
+        keep[num_keep++] = out_ids[i];
+    }
+    for (size_t i = 0; i < b.ndim; i++) {
+        keep[num_keep++] = b.ids[i];
+    }
+    cursor += einsum_reduce_private(t, &a, keep, num_keep, index_sizes, cursor);
+    num_keep = out_ndim;
+    for (size_t i = 0; i < a.ndim; i++) {
+        keep[num_keep++] = a.ids[i];
+    }
+    cursor += einsum_reduce_private(t, &b, keep, num_keep, index_sizes, cursor);
+
+    // Classify: batch and M/N in result order, K in a's order
+    size_t batch[MAX_INDICES], m[MAX_INDICES], n[MAX_INDICES], k[MAX_INDICES];
+    size_t nb = 0, nm = 0, nn = 0, nk = 0;
+    for (size_t i = 0; i < out_ndim; i++) {
+        const size_t id = out_ids[i];
+        const bool in_a = einsum_has(a.ids, a.ndim, id), in_b = einsum_has(b.ids, b.ndim, id);
+        if (in_a && in_b) {
+            batch[nb++] = id;
+        } else if (in_a) {
+            m[nm++] = id;
+        } else {
+            n[nn++] = id;
+        }
+    }
+    for (size_t i = 0; i < a.ndim; i++) {
+        if (!einsum_has(out_ids, out_ndim, a.ids[i])) {
+            k[nk++] = a.ids[i];
+        }
+    }
+
+    einsum_gemm_args_t g;
+    g.gemm = t->gemm;
+    g.elem_size = es;
+    g.batch_ndim = nb;
+    g.num_batch = einsum_numel(batch, nb, index_sizes);
+    g.M = einsum_numel(m, nm, index_sizes);
+    g.N = einsum_numel(n, nn, index_sizes);
+    g.K = einsum_numel(k, nk, index_sizes);
+
+    // The result order is batch x M x N, batch x N x M, or needs a permuted copy
+    size_t order[MAX_INDICES];
+    memcpy(order, batch, nb * sizeof(size_t));
+    memcpy(order + nb, m, nm * sizeof(size_t));
+    memcpy(order + nb + nm, n, nn * sizeof(size_t));
+    g.swap = false;
+    bool direct = memcmp(order, out_ids, out_ndim * sizeof(size_t)) == 0;
+    if (!direct) {
+        memcpy(order + nb, n, nn * sizeof(size_t));
+        memcpy(order + nb + nn, m, nm * sizeof(size_t));
+        direct = g.swap = memcmp(order, out_ids, out_ndim * sizeof(size_t)) == 0;
+    }
+    if (!direct) {
+        memcpy(order + nb, m, nm * sizeof(size_t));
+        memcpy(order + nb + nm, n, nn * sizeof(size_t));
+        g.c = cursor;
+        cursor += hodu_cpu_workspace_block_size(out_els * es);
+    } else {
+        g.c = (char *)out;
+    }
+
+    if (g.K == 0) {
+        memset(g.c, 0, out_els * es);
+    } else {
+        // Collapse M/K (a) and K/N (b) to single strides, packing an operand when they do not
+        if (!einsum_collapse(&a, m, nm, index_sizes, &g.a_m) ||
+            !einsum_collapse(&a, k, nk, index_sizes, &g.a_k)) {
+            size_t ids[MAX_INDICES];
+            memcpy(ids, batch, nb * sizeof(size_t));
+            memcpy(ids + nb, m, nm * sizeof(size_t));
+            memcpy(ids + nb + nm, k, nk * sizeof(size_t));
+            einsum_pack(t, &a, ids, nb + nm + nk, index_sizes, cursor);
+            cursor += hodu_cpu_workspace_block_size(g.num_batch * g.M * g.K * es);
+            einsum_collapse(&a, m, nm, index_sizes, &g.a_m);
+            einsum_collapse(&a, k, nk, index_sizes, &g.a_k);
+        }
+        if (!einsum_collapse(&b, k, nk, index_sizes, &g.b_k) ||
+            !einsum_collapse(&b, n, nn, index_sizes, &g.b_n)) {
+            size_t ids[MAX_INDICES];
+            memcpy(ids, batch, nb * sizeof(size_t));
+            memcpy(ids + nb, k, nk * sizeof(size_t));
+            memcpy(ids + nb + nk, n, nn * sizeof(size_t));
+            einsum_pack(t, &b, ids, nb + nk + nn, index_sizes, cursor);
+            cursor += hodu_cpu_workspace_block_size(g.num_batch * g.K * g.N * es);
+            einsum_collapse(&b, k, nk, index_sizes, &g.b_k);
+            einsum_collapse(&b, n, nn, index_sizes, &g.b_n);
+        }
+        for (size_t i = 0; i < nb; i++) {
+            g.batch_sizes[i] = index_sizes[batch[i]];
+            g.a_batch[i] = einsum_stride(&a, batch[i]);
+            g.b_batch[i] = einsum_stride(&b, batch[i]);
+        }
+        g.a = a.data;
+        g.b = b.data;
+
+        const size_t batch_work = g.M * g.N * g.K;
+        if (g.num_batch > 1 &&
+            (g.num_batch >= get_num_threads() || batch_work < EINSUM_BATCH_PARALLEL_WORK)) {
+            const size_t grain = batch_work >= 65536 ? 1 : 65536 / (batch_work + 1) + 1;
+            parallel_for(0, g.num_batch, grain, einsum_gemm_batches, &g);
+        } else {
+            einsum_gemm_batches(0, g.num_batch, &g);
+        }
+    }
+
+    if (!direct) {
+        // g.c holds batch x M x N; read it in result order
+        size_t shape[MAX_INDICES], strides[MAX_INDICES], pos_stride[MAX_INDICES];
+        size_t s = 1;
+        for (size_t i = out_ndim; i-- > 0;) {
+            pos_stride[i] = s;
+            s *= index_sizes[order[i]];
+        }
+        for (size_t i = 0; i < out_ndim; i++) {
+            shape[i] = index_sizes[out_ids[i]];
+            for (size_t j = 0; j < out_ndim; j++) {
+                if (order[j] == out_ids[i]) {
+                    strides[i] = pos_stride[j];
+                }
+            }
+        }
+        hodu_cpu_strided_copy(g.c, out, es, out_ndim, shape, strides, NULL);
+    }
+    workspace_release(scratch);
+}
+
+/// Indices of views[i] and views[j] needed after contracting them, in batch, a-only, b-only order
+static size_t einsum_pair_result(const einsum_view_t *views, size_t num_views, size_t i, size_t j,
+                                 const size_t *out_ids, size_t out_ndim, size_t *ids) {
+    size_t n = 0;
+    for (size_t pass = 0; pass < 3; pass++) {
+        const einsum_view_t *v = pass == 2 ? &views[j] : &views[i];
+        for (size_t d = 0; d < v->ndim; d++) {
+            const size_t id = v->ids[d];
+            const bool in_other = pass == 2 ? einsum_has(views[i].ids, views[i].ndim, id)
+                                            : einsum_has(views[j].ids, views[j].ndim, id);
+            if ((pass == 0) != in_other) {
+                continue;
+            }
+            bool needed = einsum_has(out_ids, out_ndim, id);
+            for (size_t w = 0; w < num_views && !needed; w++) {
+                needed = w != i && w != j && einsum_has(views[w].ids, views[w].ndim, id);
+            }
+            if (needed) {
+                ids[n++] = id;
+            }
+        }
+    }
+    return n;
+}
+
+static void einsum_run(const void **inputs, void *output, const size_t *metadata,
+                       const einsum_type_t *t) {
+    EinsumMeta meta;
+    parse_metadata(metadata, &meta);
+    if (meta.num_output_els == 0) {
+        return;
+    }
+    const size_t *sizes = meta.index_sizes;
+
+    einsum_view_t views[MAX_INPUTS];
+    const size_t num_views = meta.num_inputs;
+    for (size_t inp = 0; inp < num_views; inp++) {
+        einsum_view_t *v = &views[inp];
+        v->data = (const char *)inputs[inp] + meta.inputs[inp].offset * t->elem_size;
+        v->ndim = 0;
+        for (size_t d = 0; d < meta.inputs[inp].ndim; d++) {
+            const size_t id = meta.inputs[inp].dim_to_index[d];
+            size_t i = 0;
+            while (i < v->ndim && v->ids[i] != id) {
+                i++;
+            }
+            if (i == v->ndim) {
+                v->ids[v->ndim] = id;
+                v->strides[v->ndim++] = 0;
+            }
+            v->strides[i] += meta.inputs[inp].strides[d];
+        }
+    }
+
+    if (num_views == 1) {
+        bool copy = true;
+        for (size_t i = 0; i < views[0].ndim; i++) {
+            copy = copy && einsum_has(meta.output_index_ids, meta.output_ndim, views[0].ids[i]);
+        }
+        if (!copy) {
+            einsum_loop(t, views, 1, meta.output_ndim, meta.output_index_ids, sizes, output);
+            return;
+        }
+        size_t shape[MAX_DIMS], strides[MAX_DIMS];
+        for (size_t i = 0; i < meta.output_ndim; i++) {
+            shape[i] = sizes[meta.output_index_ids[i]];
+            strides[i] = einsum_stride(&views[0], meta.output_index_ids[i]);
+        }
+        hodu_cpu_strided_copy(views[0].data, output, t->elem_size, meta.output_ndim, shape,
+                              strides, NULL);
+        return;
+    }
+
+    // Greedy pairwise order, smallest intermediate first; intermediates share one block
+    size_t live = num_views;
+    size_t pairs[MAX_INPUTS][2], result_ids[MAX_INPUTS][MAX_INDICES], result_ndim[MAX_INPUTS];
+    size_t bytes = 0;
+    einsum_view_t plan[MAX_INPUTS];
+    memcpy(plan, views, sizeof(views));
+    size_t steps = 0;
+    while (live > 2) {
+        size_t best = SIZE_MAX;
+        for (size_t i = 0; i < live; i++) {
+            for (size_t j = i + 1; j < live; j++) {
+                size_t ids[MAX_INDICES];
+                const size_t n = einsum_pair_result(plan, live, i, j, meta.output_index_ids,
+                                                    meta.output_ndim, ids);
+                const size_t numel = einsum_numel(ids, n, sizes);
+                if (numel < best) {
+                    best = numel;
+                    pairs[steps][0] = i;
+                    pairs[steps][1] = j;
+                    result_ndim[steps] = n;
+                    memcpy(result_ids[steps], ids, n * sizeof(size_t));
+                }
+            }
+        }
+        bytes += hodu_cpu_workspace_block_size(best * t->elem_size);
+        // Replace the pair by its result (strides are filled in when it is computed)
+        einsum_view_t *r = &plan[pairs[steps][0]];
+        r->ndim = result_ndim[steps];
+        memcpy(r->ids, result_ids[steps], r->ndim * sizeof(size_t));
+        plan[pairs[steps][1]] = plan[--live];
+        steps++;
+    }
+
+    char *scratch = NULL, *cursor = NULL;
+    if (steps > 0) {
+        scratch = cursor = (char *)workspace_acquire(bytes);
+        if (!scratch) {
+            einsum_loop(t, views, num_views, meta.output_ndim, meta.output_index_ids, sizes,
+                        output);
+            return;
+        }
+    }
+    live = num_views;
+    for (size_t s = 0; s < steps; s++) {
+        const size_t i = pairs[s][0], j = pairs[s][1];
+        const size_t n = result_ndim[s];
+        einsum_pair(t, views[i], views[j], n, result_ids[s], sizes, cursor);
+        einsum_view_t *r = &views[i];
+        r->data = cursor;
+        r->ndim = n;
+        size_t stride = 1;
+        for (size_t d = n; d-- > 0;) {
+            r->ids[d] = result_ids[s][d];
+            r->strides[d] = stride;
+            stride *= sizes[result_ids[s][d]];
+        }
+        cursor += hodu_cpu_workspace_block_size(stride * t->elem_size);
+        views[j] = views[--live];
+    }
+    einsum_pair(t, views[0], views[1], meta.output_ndim, meta.output_index_ids, sizes, output);
+    if (scratch) {
+        workspace_release(scratch);
+    }
+}
+
+/**
+ * @brief Macro to implement einsum for one type
+ *
+ * @param TYPE C type of the elements
+ * @param TYPE_SUFFIX Function name suffix
+ * @param ACC Accumulator type of the sum-of-products loop
+ * @param TO_ACC Conversion from TYPE to ACC
+ * @param FROM_ACC Conversion from ACC to TYPE
+ * @param GEMM GEMM wrapper (einsum_gemm_fn_t), or NULL
+ */
+#define IMPL_EINSUM(TYPE, TYPE_SUFFIX, ACC, TO_ACC, FROM_ACC, GEMM)                                \
+    static void einsum_loop_##TYPE_SUFFIX(size_t start, size_t end, void *ctx) {                   \
+        const einsum_loop_t *l = (const einsum_loop_t *)ctx;                                       \
+        TYPE *out = (TYPE *)l->out;                                                                \
+        for (size_t out_idx = start; out_idx < end; out_idx++) {                                   \
+            size_t offsets[MAX_INPUTS] = {0};                                                      \
             size_t tmp = out_idx;                                                                  \
-            for (int d = (int)meta.output_ndim - 1; d >= 0; d--) {                                 \
-                size_t coord = tmp % meta.output_shape[d];                                         \
-                tmp /= meta.output_shape[d];                                                       \
-                index_values[meta.output_index_ids[d]] = coord;                                    \
+            for (size_t d = l->out_ndim; d-- > 0;) {                                               \
+                const size_t id = l->out_ids[d];                                                   \
+                const size_t coord = tmp % l->index_sizes[id];                                     \
+                tmp /= l->index_sizes[id];                                                         \
+                for (size_t inp = 0; inp < l->num_inputs; inp++) {                                 \
+                    offsets[inp] += coord * l->strides[inp][id];                                   \
+                }                                                                                  \
             }                                                                                      \
                                                                                                    \
-            float sum = 0.0f;                                                                      \
-                                                                                                   \
-            for (size_t c_idx = 0; c_idx < num_contraction_els; c_idx++) {                         \
-                size_t tmp_c = c_idx;                                                              \
-                for (int i = (int)meta.num_contraction_indices - 1; i >= 0; i--) {                 \
-                    size_t idx_id = meta.contraction_index_ids[i];                                 \
-                    size_t sz = meta.index_sizes[idx_id];                                          \
-                    index_values[idx_id] = tmp_c % sz;                                             \
-                    tmp_c /= sz;                                                                   \
+            /* Odometer over the summed indices */                                                 \
+            size_t coords[MAX_INDICES] = {0};                                                      \
+            ACC sum = (ACC)0;                                                                      \
+            for (;;) {                                                                             \
+                ACC product = (ACC)1;                                                              \
+                for (size_t inp = 0; inp < l->num_inputs; inp++) {                                 \
+                    product *= TO_ACC(((const TYPE *)l->data[inp])[offsets[inp]]);                 \
                 }                                                                                  \
-                                                                                                   \
-                float product = 1.0f;                                                              \
-                for (size_t inp = 0; inp < meta.num_inputs; inp++) {                               \
-                    const TYPE *in = (const TYPE *)inputs[inp] + meta.inputs[inp].offset;          \
-                    size_t in_idx = 0;                                                             \
-                    for (size_t d = 0; d < meta.inputs[inp].ndim; d++) {                           \
-                        size_t idx_id = meta.inputs[inp].dim_to_index[d];                          \
-                        in_idx += index_values[idx_id] * meta.inputs[inp].strides[d];              \
+                sum += product;                                                                    \
+                size_t i = l->num_sum;                                                             \
+                while (i-- > 0) {                                                                  \
+                    const size_t id = l->sum_ids[i];                                               \
+                    for (size_t inp = 0; inp < l->num_inputs; inp++) {                             \
+                        offsets[inp] += l->strides[inp][id];                                       \
+                    }                                                                              \
+                    if (++coords[i] < l->index_sizes[id]) {                                        \
+                        break;                                                                     \
                     }                                                                              \
-                    product *= TO_FLOAT(in[in_idx]);                                               \
+                    for (size_t inp = 0; inp < l->num_inputs; inp++) {                             \
+                        offsets[inp] -= coords[i] * l->strides[inp][id];                           \
+                    }                                                                              \
+                    coords[i] = 0;                                                                 \
+                }                                                                                  \
+                if (i == SIZE_MAX) {                                                               \
+                    break;                                                                         \
                 }                                                                                  \
-                sum += product;                                                                    \
             }                                                                                      \
-                                                                                                   \
-            out[out_idx] = FROM_FLOAT(sum);                                                        \
+            out[out_idx] = FROM_ACC(sum);                                                          \
         }                                                                                          \
+    }                                                                                              \
+                                                                                                   \
+    static const einsum_type_t einsum_type_##TYPE_SUFFIX = {sizeof(TYPE), GEMM,                    \
+                                                            einsum_loop_##TYPE_SUFFIX};            \
+                                                                                                   \
+    void hodu_cpu_einsum_##TYPE_SUFFIX(const void **inputs, void *output,                          \
+                                       const size_t *metadata) {                                   \
+        HODU_PROFILE_KERNEL(einsum_profile_bytes(metadata, sizeof(TYPE)));                         \
+        einsum_run(inputs, output, metadata, &einsum_type_##TYPE_SUFFIX);                          \
     }
 
-IMPL_EINSUM_CONVERT(bf16_t, bf16, bf16_to_float, float_to_bf16)
-IMPL_EINSUM_CONVERT(f16_t, f16, f16_to_float, float_to_f16)
-IMPL_EINSUM_CONVERT(f8e4m3_t, f8e4m3, f8e4m3_to_float, float_to_f8e4m3)
-IMPL_EINSUM_CONVERT(f8e5m2_t, f8e5m2, f8e5m2_to_float, float_to_f8e5m2)
+/// Adapt a typed gemm.h entry point to einsum_gemm_fn_t
+#define EINSUM_GEMM(TYPE, TYPE_SUFFIX, GEMM_FN)                                                    \
+    static void einsum_gemm_##TYPE_SUFFIX(size_t M, size_t N, size_t K, const void *a,             \
+                                          size_t a_rs, size_t a_cs, const void *b, size_t b_rs,    \
+                                          size_t b_cs, void *c, size_t ldc) {                      \
+        GEMM_FN(M, N, K, (const TYPE *)a, a_rs, a_cs, (const TYPE *)b, b_rs, b_cs, (TYPE *)c,      \
+                ldc);                                                                              \
+    }
+
+#define EINSUM_SAME(x) (x)
+
+EINSUM_GEMM(f32_t, f32, hodu_cpu_gemm_f32)
+EINSUM_GEMM(f64_t, f64, hodu_cpu_gemm_f64)
+EINSUM_GEMM(bf16_t, bf16, hodu_cpu_gemm_bf16)
+EINSUM_GEMM(f16_t, f16, hodu_cpu_gemm_f16)
+EINSUM_GEMM(f8e4m3_t, f8e4m3, hodu_cpu_gemm_f8e4m3)
+EINSUM_GEMM(f8e5m2_t, f8e5m2, hodu_cpu_gemm_f8e5m2)
+
+IMPL_EINSUM(f32_t, f32, f32_t, EINSUM_SAME, EINSUM_SAME, einsum_gemm_f32)
+IMPL_EINSUM(f64_t, f64, f64_t, EINSUM_SAME, EINSUM_SAME, einsum_gemm_f64)
+IMPL_EINSUM(u8_t, u8, u8_t, EINSUM_SAME, EINSUM_SAME, NULL)
+IMPL_EINSUM(u16_t, u16, u16_t, EINSUM_SAME, EINSUM_SAME, NULL)
+IMPL_EINSUM(u32_t, u32, u32_t, EINSUM_SAME, EINSUM_SAME, NULL)
+IMPL_EINSUM(u64_t, u64, u64_t, EINSUM_SAME, EINSUM_SAME, NULL)
+IMPL_EINSUM(i8_t, i8, i8_t, EINSUM_SAME, EINSUM_SAME, NULL)
+IMPL_EINSUM(i16_t, i16, i16_t, EINSUM_SAME, EINSUM_SAME, NULL)
+IMPL_EINSUM(i32_t, i32, i32_t, EINSUM_SAME, EINSUM_SAME, NULL)
+IMPL_EINSUM(i64_t, i64, i64_t, EINSUM_SAME, EINSUM_SAME, NULL)
+
+IMPL_EINSUM(bf16_t, bf16, float, bf16_to_float, float_to_bf16, einsum_gemm_bf16)
+IMPL_EINSUM(f16_t, f16, float, f16_to_float, float_to_f16, einsum_gemm_f16)
+IMPL_EINSUM(f8e4m3_t, f8e4m3, float, f8e4m3_to_float, float_to_f8e4m3, einsum_gemm_f8e4m3)
+IMPL_EINSUM(f8e5m2_t, f8e5m2, float, f8e5m2_to_float, float_to_f8e5m2, einsum_gemm_f8e5m2)
@@ -0,0 +1,568 @@
+#include "ops_fused.h"
+#include "profile.h"
+#include "simd_utils.h"
+#include "strided_copy.h"
+#include "t_f8e4m3.h"
+#include "thread_utils.h"
+#include "types.h"
+#include "workspace.h"
+#include <math.h>
+#include <string.h>
+
+// ============================================================================
+// FUSED ELEMENTWISE IMPLEMENTATION
+// ============================================================================
+//
+// A fused program is interpreted once per tile of FUSED_TILE output elements, not once per
+// element:
+// 1. Plan: validate the program, note which inputs it loads and which registers only ever
+//    hold one CONST (filled once per task instead of once per tile)
+// 2. Split the output elements over the thread pool; each task keeps one strided iterator per
+//    loaded input
+// 3. Per tile, gather each loaded input into a compute-type buffer (a contiguous f32 / f64 run
+//    is used in place), run every instruction over the whole tile with SIMD, and store the
+//    result register (narrowing 8/16-bit float types)
+//
+// A register holds FUSED_TILE values, so with FUSED_TILE = 256 the registers of an f32
+// program stay within 16 KiB and the chain runs out of L1 between the single read of each
+// input and the single write of the output.
+
+#define FUSED_TILE 256
+
+/// Plan of one fused call shared by all pool tasks
+typedef struct {
+    const hodu_cpu_fused_inst_t *program;
+    size_t num_insts;
+    size_t num_dims;
+    const size_t *shape;
+    const uint8_t *inputs[HODU_CPU_FUSED_MAX_INPUTS]; // First element of each view
+    const size_t *strides[HODU_CPU_FUSED_MAX_INPUTS]; // Element strides of each view
+    uint32_t loaded;                                  // Bit k: input k is loaded
+    uint32_t uniform;                                 // Bit r: r holds one CONST throughout
+    int32_t result;                                   // Register stored to the output
+    uint8_t *output;
+    size_t contiguous[STRIDED_ITER_MAX_DIMS]; // Strides of staged (contiguous) inputs
+} fused_loop_t;
+
+/// Source registers read by an op (0 for LOAD / CONST), or -1 for an unknown op
+static int fused_arity(int32_t op) {
+    if (op == HODU_CPU_FUSED_LOAD || op == HODU_CPU_FUSED_CONST)
+        return 0;
+    if (op >= HODU_CPU_FUSED_NEG && op <= HODU_CPU_FUSED_ERF)
+        return 1;
+    if (op >= HODU_CPU_FUSED_ADD && op <= HODU_CPU_FUSED_POW)
+        return 2;
+    if (op == HODU_CPU_FUSED_MUL_ADD)
+        return 3;
+    return -1;
+}
+
+/// Whether an op costs about a transcendental rather than a cheap elementwise op
+static bool fused_is_transcendental(int32_t op) {
+    switch (op) {
+    case HODU_CPU_FUSED_SIGMOID:
+    case HODU_CPU_FUSED_TANH:
+    case HODU_CPU_FUSED_GELU:
+    case HODU_CPU_FUSED_SILU:
+    case HODU_CPU_FUSED_EXP:
+    case HODU_CPU_FUSED_LN:
+    case HODU_CPU_FUSED_ERF:
+    case HODU_CPU_FUSED_POW:
+        return true;
+    default:
+        return false;
+    }
+}
+
+/// Validate a program against the metadata and fill the plan; returns false if it is invalid
+static bool fused_plan_init(fused_loop_t *loop, const hodu_cpu_fused_inst_t *program,
+                            size_t num_insts, const size_t *metadata) {
+    const size_t num_inputs = metadata[2];
+    if (!program || num_insts == 0 || num_insts > HODU_CPU_FUSED_MAX_INSTS ||
+        num_inputs > HODU_CPU_FUSED_MAX_INPUTS)
+        return false;
+
+    uint32_t written = 0, consts = 0;
+    unsigned writes[HODU_CPU_FUSED_MAX_REGS] = {0};
+    loop->loaded = 0;
+    for (size_t i = 0; i < num_insts; i++) {
+        const hodu_cpu_fused_inst_t *inst = &program[i];
+        const int arity = fused_arity(inst->op);
+        if (arity < 0 || inst->dst < 0 || inst->dst >= HODU_CPU_FUSED_MAX_REGS)
+            return false;
+        if (inst->op == HODU_CPU_FUSED_LOAD) {
+            if (inst->a < 0 || (size_t)inst->a >= num_inputs)
+                return false;
+            loop->loaded |= 1u << inst->a;
+        } else if (inst->op == HODU_CPU_FUSED_CONST) {
+            consts |= 1u << inst->dst;
+        }
+        const int32_t sources[3] = {inst->a, inst->b, inst->c};
+        for (int s = 0; s < arity; s++) {
+            if (sources[s] < 0 || sources[s] >= HODU_CPU_FUSED_MAX_REGS ||
+                !(written & (1u << sources[s])))
+                return false;
+        }
+        written |= 1u << inst->dst;
+        writes[inst->dst]++;
+    }
+
+    loop->uniform = 0;
+    for (int r = 0; r < HODU_CPU_FUSED_MAX_REGS; r++) {
+        if ((consts & (1u << r)) && writes[r] == 1)
+            loop->uniform |= 1u << r;
+    }
+    loop->program = program;
+    loop->num_insts = num_insts;
+    loop->result = program[num_insts - 1].dst;
+    loop->num_dims = metadata[1];
+    loop->shape = metadata + 3;
+    return true;
+}
+
+/// Point the plan at the input views, staging any that overlap the output
+///
+/// Returns the first staged block (release it after the call), or NULL.
+static void *fused_stage_inputs(fused_loop_t *loop, const void **inputs, const size_t *metadata,
+                                void *output, size_t elem_size) {
+    const size_t num_dims = metadata[1];
+    const size_t num_inputs = metadata[2];
+    void *first = NULL;
+    loop->output = (uint8_t *)output;
+
+    for (size_t k = 0; k < num_inputs; k++) {
+        const size_t *strides = metadata + 3 + num_dims + k * (num_dims + 1);
+        loop->inputs[k] = (const uint8_t *)inputs[k] + strides[num_dims] * elem_size;
+        loop->strides[k] = strides;
+        if (!(loop->loaded & (1u << k)) || metadata[0] == 0 || num_dims > STRIDED_ITER_MAX_DIMS)
+            continue;
+
+        void *staged = hodu_cpu_stage_overlapping_view(loop->inputs[k], elem_size, num_dims,
+                                                       loop->shape, strides, output, elem_size);
+        if (!staged)
+            continue;
+        if (!first) {
+            size_t stride = 1;
+            for (size_t d = num_dims; d-- > 0;) {
+                loop->contiguous[d] = stride;
+                stride *= loop->shape[d];
+            }
+            first = staged;
+        }
+        loop->inputs[k] = (const uint8_t *)staged;
+        loop->strides[k] = loop->contiguous;
+    }
+    return first;
+}
+
+/// Output elements per task: the program's cheap and transcendental ops against the task target
+static size_t fused_grain(const fused_loop_t *loop) {
+    double cheap = 1.0; // the store
+    double heavy = 0.0;
+    for (size_t i = 0; i < loop->num_insts; i++) {
+        const hodu_cpu_fused_inst_t *inst = &loop->program[i];
+        if (inst->op == HODU_CPU_FUSED_CONST && (loop->uniform & (1u << inst->dst)))
+            continue;
+        if (fused_is_transcendental(inst->op))
+            heavy += 1.0;
+        else
+            cheap += 1.0;
+    }
+
+    double grain = (double)task_grain(HODU_CPU_COST_ELEMENTWISE, cheap);
+    if (heavy > 0.0) {
+        /* Per-element costs add up, so the item counts combine harmonically */
+        const double heavy_grain = (double)task_grain(HODU_CPU_COST_TRANSCENDENTAL, heavy);
+        grain = grain * heavy_grain / (grain + heavy_grain);
+    }
+    return grain > FUSED_TILE ? (size_t)grain : FUSED_TILE;
+}
+
+// ============================================================================
+// INSTRUCTION LOOPS
+// ============================================================================
+//
+// One instruction over a tile: d[0, n) = op(a, b, c). Operands may alias d (an instruction
+// whose destination is also a source), which is safe as every lane is read before it is
+// written. Vector bodies end in a partial vector, so a tile never mixes vector and scalar
+// roundings.
+
+#if SIMD_F32_WIDTH > 1
+#define FUSED_F32_LOOP(LOADS, SIMD_EXPR, SCALAR_EXPR)                                              \
+    for (; i + SIMD_F32_WIDTH <= n; i += SIMD_F32_WIDTH) {                                         \
+        const size_t rem = SIMD_F32_WIDTH;                                                         \
+        LOADS;                                                                                     \
+        simd_f32_store(d + i, SIMD_EXPR);                                                          \
+    }                                                                                              \
+    if (i < n) {                                                                                   \
+        const size_t rem = n - i;                                                                  \
+        LOADS;                                                                                     \
+        simd_f32_store_partial(d + i, SIMD_EXPR, rem);                                             \
+    }
+#define FUSED_F32_V(NAME, SRC)                                                                     \
+    const simd_f32_t NAME = rem == SIMD_F32_WIDTH                                                  \
+                                ? simd_f32_load(SRC + i)                                           \
+                                : simd_f32_load_partial(SRC + i, rem, simd_f32_set1(0.0f))
+#define FUSED_F32_UNARY(SIMD_EXPR, SCALAR_EXPR)                                                    \
+    FUSED_F32_LOOP(FUSED_F32_V(v, a), SIMD_EXPR, SCALAR_EXPR)
+#define FUSED_F32_BINARY(SIMD_EXPR, SCALAR_EXPR)                                                   \
+    FUSED_F32_LOOP(FUSED_F32_V(v, a); FUSED_F32_V(w, b), SIMD_EXPR, SCALAR_EXPR)
+#define FUSED_F32_TERNARY(SIMD_EXPR, SCALAR_EXPR)                                                  \
+    FUSED_F32_LOOP(FUSED_F32_V(v, a); FUSED_F32_V(w, b); FUSED_F32_V(u, c), SIMD_EXPR,             \
+                   SCALAR_EXPR)
+#else
+#define FUSED_F32_UNARY(SIMD_EXPR, SCALAR_EXPR)                                                    \
+    for (; i < n; i++) {                                                                           \
+        const float x = a[i];                                                                      \
+        d[i] = SCALAR_EXPR;                                                                        \
+    }
+#define FUSED_F32_BINARY(SIMD_EXPR, SCALAR_EXPR)                                                   \
+    for (; i < n; i++) {                                                                           \
+        const float x = a[i], y = b[i];                                                            \
+        d[i] = SCALAR_EXPR;                                                                        \
+    }
+#define FUSED_F32_TERNARY(SIMD_EXPR, SCALAR_EXPR)                                                  \
+    for (; i < n; i++) {                                                                           \
+        const float x = a[i], y = b[i], z = c[i];                                                  \
+        d[i] = SCALAR_EXPR;                                                                        \
+    }
+#endif
+
+#if SIMD_F64_WIDTH > 1
+#define FUSED_F64_LOOP(LOADS, SIMD_EXPR)                                                           \
+    for (; i + SIMD_F64_WIDTH <= n; i += SIMD_F64_WIDTH) {                                         \
+        const size_t rem = SIMD_F64_WIDTH;                                                         \
+        LOADS;                                                                                     \
+        simd_f64_store(d + i, SIMD_EXPR);                                                          \
+    }                                                                                              \
+    if (i < n) {                                                                                   \
+        const size_t rem = n - i;                                                                  \
+        LOADS;                                                                                     \
+        simd_f64_store_partial(d + i, SIMD_EXPR, rem);                                             \
+    }
+#define FUSED_F64_V(NAME, SRC)                                                                     \
+    const simd_f64_t NAME = rem == SIMD_F64_WIDTH                                                  \
+                                ? simd_f64_load(SRC + i)                                           \
+                                : simd_f64_load_partial(SRC + i, rem, simd_f64_set1(0.0))
+#define FUSED_F64_UNARY(SIMD_EXPR, SCALAR_EXPR) FUSED_F64_LOOP(FUSED_F64_V(v, a), SIMD_EXPR)
+#define FUSED_F64_BINARY(SIMD_EXPR, SCALAR_EXPR)                                                   \
+    FUSED_F64_LOOP(FUSED_F64_V(v, a); FUSED_F64_V(w, b), SIMD_EXPR)
+#define FUSED_F64_TERNARY(SIMD_EXPR, SCALAR_EXPR)                                                  \
+    FUSED_F64_LOOP(FUSED_F64_V(v, a); FUSED_F64_V(w, b); FUSED_F64_V(u, c), SIMD_EXPR)
+#else
+#define FUSED_F64_UNARY(SIMD_EXPR, SCALAR_EXPR) FUSED_SCALAR_UNARY(double, SCALAR_EXPR)
+#define FUSED_F64_BINARY(SIMD_EXPR, SCALAR_EXPR) FUSED_SCALAR_BINARY(double, SCALAR_EXPR)
+#define FUSED_F64_TERNARY(SIMD_EXPR, SCALAR_EXPR)                                                  \
+    for (; i < n; i++) {                                                                           \
+        const double x = a[i], y = b[i], z = c[i];                                                 \
+        d[i] = SCALAR_EXPR;                                                                        \
+    }
+#endif
+
+/// Ops without a vector form (the compiler may still vectorize the simple ones)
+#define FUSED_SCALAR_UNARY(CT, SCALAR_EXPR)                                                        \
+    for (; i < n; i++) {                                                                           \
+        const CT x = a[i];                                                                         \
+        d[i] = SCALAR_EXPR;                                                                        \
+    }
+#define FUSED_SCALAR_BINARY(CT, SCALAR_EXPR)                                                       \
+    for (; i < n; i++) {                                                                           \
+        const CT x = a[i], y = b[i];                                                               \
+        d[i] = SCALAR_EXPR;                                                                        \
+    }
+
+static void fused_eval_f32(int32_t op, const float *a, const float *b, const float *c, float *d,
+                           size_t n) {
+    size_t i = 0;
+#if SIMD_F32_WIDTH > 1
+    const simd_f32_t zero = simd_f32_set1(0.0f);
+    const simd_f32_t one = simd_f32_set1(1.0f);
+#endif
+    switch (op) {
+    case HODU_CPU_FUSED_NEG:
+        FUSED_F32_UNARY(simd_f32_neg(v), -x);
+        break;
+    case HODU_CPU_FUSED_ABS:
+        FUSED_F32_UNARY(simd_f32_abs(v), fabsf(x));
+        break;
+    case HODU_CPU_FUSED_SQUARE:
+        FUSED_F32_UNARY(simd_f32_mul(v, v), x * x);
+        break;
+    case HODU_CPU_FUSED_SQRT:
+        FUSED_F32_UNARY(simd_f32_sqrt(v), sqrtf(x));
+        break;
+    case HODU_CPU_FUSED_RECIP:
+        FUSED_F32_UNARY(simd_f32_div(one, v), 1.0f / x);
+        break;
+    case HODU_CPU_FUSED_RELU:
+        FUSED_F32_UNARY(simd_f32_select(simd_f32_cmplt(zero, v), v, zero), x > 0.0f ? x : 0.0f);
+        break;
+    case HODU_CPU_FUSED_SIGMOID:
+        FUSED_F32_UNARY(simd_f32_sigmoid(v), 1.0f / (1.0f + expf(-x)));
+        break;
+    case HODU_CPU_FUSED_TANH:
+        FUSED_F32_UNARY(simd_f32_tanh(v), tanhf(x));
+        break;
+    case HODU_CPU_FUSED_GELU:
+        FUSED_F32_UNARY(simd_f32_gelu(v), gelu_helper_f32(x));
+        break;
+    case HODU_CPU_FUSED_SILU:
+        FUSED_F32_UNARY(simd_f32_silu(v), silu_helper_f32(x));
+        break;
+    case HODU_CPU_FUSED_EXP:
+        FUSED_F32_UNARY(simd_f32_exp(v), expf(x));
+        break;
+    case HODU_CPU_FUSED_LN:
+        FUSED_F32_UNARY(simd_f32_log(v), logf(x));
+        break;
+    case HODU_CPU_FUSED_ERF:
+        FUSED_F32_UNARY(simd_f32_erf(v), erff(x));
+        break;
+    case HODU_CPU_FUSED_ADD:
+        FUSED_F32_BINARY(simd_f32_add(v, w), x + y);
+        break;
+    case HODU_CPU_FUSED_SUB:
+        FUSED_F32_BINARY(simd_f32_sub(v, w), x - y);
+        break;
+    case HODU_CPU_FUSED_MUL:
+        FUSED_F32_BINARY(simd_f32_mul(v, w), x * y);
+        break;
+    case HODU_CPU_FUSED_DIV:
+        FUSED_F32_BINARY(simd_f32_div(v, w), x / y);
+        break;
+    case HODU_CPU_FUSED_MAXIMUM:
+        FUSED_F32_BINARY(simd_f32_select(simd_f32_cmplt(w, v), v, w), MAXIMUM(x, y));
+        break;
+    case HODU_CPU_FUSED_MINIMUM:
+        FUSED_F32_BINARY(simd_f32_select(simd_f32_cmplt(v, w), v, w), MINIMUM(x, y));
+        break;
+    case HODU_CPU_FUSED_POW:
+        FUSED_SCALAR_BINARY(float, powf_opt(x, y));
+        break;
+    case HODU_CPU_FUSED_MUL_ADD:
+        FUSED_F32_TERNARY(simd_f32_fmadd(v, w, u), x * y + z);
+        break;
+    default:
+        break;
+    }
+}
+
+static void fused_eval_f64(int32_t op, const double *a, const double *b, const double *c,
+                           double *d, size_t n) {
+    size_t i = 0;
+#if SIMD_F64_WIDTH > 1
+    const simd_f64_t one = simd_f64_set1(1.0);
+#endif
+    switch (op) {
+    case HODU_CPU_FUSED_NEG:
+        FUSED_F64_UNARY(simd_f64_neg(v), -x);
+        break;
+    case HODU_CPU_FUSED_ABS:
+        FUSED_F64_UNARY(simd_f64_abs(v), fabs(x));
+        break;
+    case HODU_CPU_FUSED_SQUARE:
+        FUSED_F64_UNARY(simd_f64_mul(v, v), x * x);
+        break;
+    case HODU_CPU_FUSED_SQRT:
+        FUSED_F64_UNARY(simd_f64_sqrt(v), sqrt(x));
+        break;
+    case HODU_CPU_FUSED_RECIP:
+        FUSED_F64_UNARY(simd_f64_div(one, v), 1.0 / x);
+        break;
+    case HODU_CPU_FUSED_RELU:
+        FUSED_SCALAR_UNARY(double, x > 0.0 ? x : 0.0);
+        break;
+    case HODU_CPU_FUSED_SIGMOID:
+        FUSED_SCALAR_UNARY(double, 1.0 / (1.0 + exp(-x)));
+        break;
+    case HODU_CPU_FUSED_TANH:
+        FUSED_SCALAR_UNARY(double, tanh(x));
+        break;
+    case HODU_CPU_FUSED_GELU:
+        FUSED_SCALAR_UNARY(double, gelu_helper_f64(x));
+        break;
+    case HODU_CPU_FUSED_SILU:
+        FUSED_SCALAR_UNARY(double, silu_helper_f64(x));
+        break;
+    case HODU_CPU_FUSED_EXP:
+        FUSED_SCALAR_UNARY(double, exp(x));
+        break;
+    case HODU_CPU_FUSED_LN:
+        FUSED_SCALAR_UNARY(double, log(x));
+        break;
+    case HODU_CPU_FUSED_ERF:
+        FUSED_SCALAR_UNARY(double, erf(x));
+        break;
+    case HODU_CPU_FUSED_ADD:
+        FUSED_F64_BINARY(simd_f64_add(v, w), x + y);
+        break;
+    case HODU_CPU_FUSED_SUB:
+        FUSED_F64_BINARY(simd_f64_sub(v, w), x - y);
+        break;
+    case HODU_CPU_FUSED_MUL:
+        FUSED_F64_BINARY(simd_f64_mul(v, w), x * y);
+        break;
+    case HODU_CPU_FUSED_DIV:
+        FUSED_F64_BINARY(simd_f64_div(v, w), x / y);
+        break;
+    case HODU_CPU_FUSED_MAXIMUM:
+        FUSED_SCALAR_BINARY(double, MAXIMUM(x, y));
+        break;
+    case HODU_CPU_FUSED_MINIMUM:
+        FUSED_SCALAR_BINARY(double, MINIMUM(x, y));
+        break;
+    case HODU_CPU_FUSED_POW:
+        FUSED_SCALAR_BINARY(double, pow_opt(x, y));
+        break;
+    case HODU_CPU_FUSED_MUL_ADD:
+        FUSED_F64_TERNARY(simd_f64_fmadd(v, w, u), x * y + z);
+        break;
+    default:
+        break;
+    }
+}
+
+// ============================================================================
+// TILE LOOP
+// ============================================================================
+
+/// Copy between a compute buffer and same-type memory (no-op when they coincide)
+static inline void fused_copy_f32(const float *src, float *dst, size_t n) {
+    if (src != dst)
+        memcpy(dst, src, n * sizeof(float));
+}
+
+static inline void fused_copy_f64(const double *src, double *dst, size_t n) {
+    if (src != dst)
+        memcpy(dst, src, n * sizeof(double));
+}
+
+/**
+ * @brief Macro implementing the fused elementwise kernel for one storage type
+ *
+ * @param TYPE Storage element type
+ * @param TYPE_SUFFIX Type suffix for function naming
+ * @param CT Compute type (float or double)
+ * @param CT_SUFFIX Compute type suffix (f32 or f64) selecting fused_eval_*
+ * @param TO_CT Scalar conversion TYPE -> CT
+ * @param WIDEN Block conversion TYPE[n] -> CT[n]
+ * @param NARROW Block conversion CT[n] -> TYPE[n]
+ * @param IN_PLACE 1 if TYPE is CT, so contiguous input runs are read without a copy
+ * @param HAS_SIMD Whether CT has vector instruction loops
+ */
+#define IMPL_FUSED_ELEMENTWISE(TYPE, TYPE_SUFFIX, CT, CT_SUFFIX, TO_CT, WIDEN, NARROW, IN_PLACE,   \
+                               HAS_SIMD)                                                           \
+    /* Next n elements of an input view as CT values, advancing its iterator */                    \
+    static const CT *fused_gather_##TYPE_SUFFIX(strided_iter_t *it, const TYPE *base, size_t n,    \
+                                                CT *buf) {                                         \
+        if (IN_PLACE && it->inner_stride == 1 && strided_iter_row(it) >= n) {                      \
+            const CT *run = (const CT *)(const void *)(base + it->offset);                         \
+            strided_iter_advance(it, n);                                                           \
+            return run;                                                                            \
+        }                                                                                          \
+        for (size_t done = 0; done < n;) {                                                         \
+            const size_t row = MINIMUM(strided_iter_row(it), n - done);                            \
+            const TYPE *src = base + it->offset;                                                   \
+            const size_t stride = it->inner_stride;                                                \
+            if (stride == 1) {                                                                     \
+                WIDEN(src, buf + done, row);                                                       \
+            } else if (stride == 0) {                                                              \
+                const CT value = TO_CT(src[0]);                                                    \
+                for (size_t j = 0; j < row; j++)                                                   \
+                    buf[done + j] = value;                                                         \
+            } else {                                                                               \
+                for (size_t j = 0; j < row; j++)                                                   \
+                    buf[done + j] = TO_CT(src[j * stride]);                                        \
+            }                                                                                      \
+            strided_iter_advance(it, row);                                                         \
+            done += row;                                                                           \
+        }                                                                                          \
+        return buf;                                                                                \
+    }                                                                                              \
+                                                                                                   \
+    static void fused_worker_##TYPE_SUFFIX(size_t start, size_t end, void *arg) {                  \
+        const fused_loop_t *loop = (const fused_loop_t *)arg;                                      \
+        CT regs[HODU_CPU_FUSED_MAX_REGS][FUSED_TILE];                                              \
+        CT gathered[HODU_CPU_FUSED_MAX_INPUTS][FUSED_TILE];                                        \
+        const CT *r[HODU_CPU_FUSED_MAX_REGS];                                                      \
+        const CT *src[HODU_CPU_FUSED_MAX_INPUTS];                                                  \
+        strided_iter_t it[HODU_CPU_FUSED_MAX_INPUTS];                                              \
+        TYPE *out = (TYPE *)loop->output;                                                          \
+                                                                                                   \
+        for (size_t k = 0; k < HODU_CPU_FUSED_MAX_INPUTS; k++) {                                   \
+            if (loop->loaded & (1u << k))                                                          \
+                strided_iter_init(&it[k], loop->num_dims, loop->shape, loop->strides[k], start);   \
+        }                                                                                          \
+        for (size_t p = 0; p < loop->num_insts; p++) {                                             \
+            const hodu_cpu_fused_inst_t *inst = &loop->program[p];                                 \
+            if (inst->op == HODU_CPU_FUSED_CONST && (loop->uniform & (1u << inst->dst))) {         \
+                for (size_t j = 0; j < FUSED_TILE; j++)                                            \
+                    regs[inst->dst][j] = (CT)inst->imm;                                            \
+                r[inst->dst] = regs[inst->dst];                                                    \
+            }                                                                                      \
+        }                                                                                          \
+                                                                                                   \
+        for (size_t i = start; i < end;) {                                                         \
+            const size_t n = MINIMUM((size_t)FUSED_TILE, end - i);                                 \
+            for (size_t k = 0; k < HODU_CPU_FUSED_MAX_INPUTS; k++) {                               \
+                if (loop->loaded & (1u << k))                                                      \
+                    src[k] = fused_gather_##TYPE_SUFFIX(&it[k], (const TYPE *)loop->inputs[k], n,  \
+                                                        gathered[k]);                              \
+            }                                                                                      \
+            for (size_t p = 0; p < loop->num_insts; p++) {                                         \
+                const hodu_cpu_fused_inst_t *inst = &loop->program[p];                             \
+                CT *dst = regs[inst->dst];                                                         \
+                switch (inst->op) {                                                                \
+                case HODU_CPU_FUSED_LOAD:                                                          \
+                    r[inst->dst] = src[inst->a];                                                   \
+                    continue;                                                                      \
+                case HODU_CPU_FUSED_CONST:                                                         \
+                    if (!(loop->uniform & (1u << inst->dst))) {                                    \
+                        for (size_t j = 0; j < n; j++)                                             \
+                            dst[j] = (CT)inst->imm;                                                \
+                        r[inst->dst] = dst;                                                        \
+                    }                                                                              \
+                    continue;                                                                      \
+                default:                                                                           \
+                    break;                                                                         \
+                }                                                                                  \
+                const int arity = fused_arity(inst->op);                                           \
+                fused_eval_##CT_SUFFIX(inst->op, r[inst->a], arity > 1 ? r[inst->b] : NULL,        \
+                                       arity > 2 ? r[inst->c] : NULL, dst, n);                     \
+                r[inst->dst] = dst;                                                                \
+            }                                                                                      \
+            NARROW(r[loop->result], out + i, n);                                                   \
+            i += n;                                                                                \
+        }                                                                                          \
+    }                                                                                              \
+                                                                                                   \
+    void hodu_cpu_fused_elementwise_##TYPE_SUFFIX(const void **inputs, void *output,               \
+                                                  const size_t *metadata,                          \
+                                                  const hodu_cpu_fused_inst_t *program,            \
+                                                  size_t num_insts) {                              \
+        HODU_PROFILE_KERNEL(metadata[0] * (metadata[2] + 1) * sizeof(TYPE));                       \
+        fused_loop_t loop;                                                                         \
+        if (!fused_plan_init(&loop, program, num_insts, metadata))                                 \
+            return;                                                                                \
+        void *staged = fused_stage_inputs(&loop, inputs, metadata, output, sizeof(TYPE));          \
+        if (HAS_SIMD)                                                                              \
+            HODU_PROFILE_PATH(HODU_CPU_PATH_SIMD);                                                 \
+        parallel_for(0, metadata[0], fused_grain(&loop), fused_worker_##TYPE_SUFFIX, &loop);       \
+        if (staged)                                                                                \
+            workspace_release(staged);                                                             \
+    }
+
+#define FUSED_PASS(x) (x)
+
+IMPL_FUSED_ELEMENTWISE(f8e4m3_t, f8e4m3, float, f32, f8e4m3_to_float, simd_widen_f8e4m3,
+                       simd_narrow_f8e4m3, 0, SIMD_F32_WIDTH > 1)
+IMPL_FUSED_ELEMENTWISE(f8e5m2_t, f8e5m2, float, f32, f8e5m2_to_float, simd_widen_f8e5m2,
+                       simd_narrow_f8e5m2, 0, SIMD_F32_WIDTH > 1)
+IMPL_FUSED_ELEMENTWISE(bf16_t, bf16, float, f32, bf16_to_float, simd_widen_bf16, simd_narrow_bf16,
+                       0, SIMD_F32_WIDTH > 1)
+IMPL_FUSED_ELEMENTWISE(f16_t, f16, float, f32, f16_to_float, simd_widen_f16, simd_narrow_f16, 0,
+                       SIMD_F32_WIDTH > 1)
+IMPL_FUSED_ELEMENTWISE(f32_t, f32, float, f32, FUSED_PASS, fused_copy_f32, fused_copy_f32, 1,
+                       SIMD_F32_WIDTH > 1)
+IMPL_FUSED_ELEMENTWISE(f64_t, f64, double, f64, FUSED_PASS, fused_copy_f64, fused_copy_f64, 1,
+                       SIMD_F64_WIDTH > 1)
@@ -0,0 +1,133 @@
+/**
+ * @file ops_fused.h
+ * @brief Fused elementwise chains header
+ *
+ * Evaluates a chain of unary/binary elementwise ops, given as a small register
+ * program, in one pass over the output: e.g. `(x * scale + shift).sigmoid() * x`
+ * reads x once and writes the output once instead of running four kernels with
+ * three full-size intermediates.
+ *
+ * The output is processed in tiles of a few hundred elements. Each tile gathers
+ * the inputs it needs (broadcasting and widening 8/16-bit floats to f32), runs
+ * every instruction over the tile with SIMD while the registers stay in L1, and
+ * stores the result register. Tiles are split across the thread pool.
+ */
+
+#ifndef HODU_CPU_KERNELS_OPS_FUSED_H
+#define HODU_CPU_KERNELS_OPS_FUSED_H
+
+#include "utils.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// Limits of a fused program
+#define HODU_CPU_FUSED_MAX_INPUTS 8
+#define HODU_CPU_FUSED_MAX_REGS 16
+#define HODU_CPU_FUSED_MAX_INSTS 64
+
+/// Instructions of a fused program
+///
+/// Values compute in f32 (f64 for f64 kernels) and match the standalone kernels of
+/// the same name: sigmoid, tanh, gelu (tanh approximation), silu, exp, ln and erf
+/// use the SIMD approximations of ops_unary for f32; maximum/minimum return the
+/// first operand unless the second is larger/smaller; relu maps NaN to 0 like
+/// the f32 relu kernel.
+typedef enum {
+    // Data: r[dst] = inputs[a] / r[dst] = imm
+    HODU_CPU_FUSED_LOAD = 0,
+    HODU_CPU_FUSED_CONST = 1,
+    // Unary: r[dst] = f(r[a])
+    HODU_CPU_FUSED_NEG = 2,
+    HODU_CPU_FUSED_ABS = 3,
+    HODU_CPU_FUSED_SQUARE = 4,
+    HODU_CPU_FUSED_SQRT = 5,
+    HODU_CPU_FUSED_RECIP = 6,
+    HODU_CPU_FUSED_RELU = 7,
+    HODU_CPU_FUSED_SIGMOID = 8,
+    HODU_CPU_FUSED_TANH = 9,
+    HODU_CPU_FUSED_GELU = 10,
+    HODU_CPU_FUSED_SILU = 11,
+    HODU_CPU_FUSED_EXP = 12,
+    HODU_CPU_FUSED_LN = 13,
+    HODU_CPU_FUSED_ERF = 14,
+    // Binary: r[dst] = r[a] op r[b]
+    HODU_CPU_FUSED_ADD = 15,
+    HODU_CPU_FUSED_SUB = 16,
+    HODU_CPU_FUSED_MUL = 17,
+    HODU_CPU_FUSED_DIV = 18,
+    HODU_CPU_FUSED_MAXIMUM = 19,
+    HODU_CPU_FUSED_MINIMUM = 20,
+    HODU_CPU_FUSED_POW = 21,
+    // Ternary: r[dst] = r[a] * r[b] + r[c] (rounded once where the target has FMA)
+    HODU_CPU_FUSED_MUL_ADD = 22,
+    HODU_CPU_FUSED_NUM_OPS,
+} hodu_cpu_fused_op_t;
+
+/// One instruction: registers are 0..HODU_CPU_FUSED_MAX_REGS-1, unused operands are ignored
+typedef struct {
+    int32_t op;  // hodu_cpu_fused_op_t
+    int32_t dst; // destination register
+    int32_t a;   // first source register (LOAD: input index)
+    int32_t b;   // second source register
+    int32_t c;   // third source register (MUL_ADD)
+    double imm;  // CONST value (rounded to the compute type)
+} hodu_cpu_fused_inst_t;
+
+// ============================================================================
+// FUSED ELEMENTWISE FUNCTION SIGNATURES
+// ============================================================================
+//
+//   void hodu_cpu_fused_elementwise_type(const void **inputs, void *output,
+//                                        const size_t *metadata,
+//                                        const hodu_cpu_fused_inst_t *program,
+//                                        size_t num_insts)
+//
+// Parameters:
+//   inputs    - Input tensors, all of the kernel's element type
+//   output    - Contiguous output buffer (pre-allocated)
+//   metadata  - Array describing the layouts (see below)
+//   program   - Instructions, run in order for every element
+//   num_insts - Number of instructions (1..HODU_CPU_FUSED_MAX_INSTS)
+//
+// The output is the register written by the last instruction. Registers must be
+// written before they are read. Invalid programs (unknown ops, registers or
+// inputs out of range, reads of unwritten registers) leave the output untouched.
+//
+// Metadata layout:
+// - metadata[0]: num_els (total number of output elements)
+// - metadata[1]: num_dims (number of dimensions)
+// - metadata[2]: num_inputs (at most HODU_CPU_FUSED_MAX_INPUTS)
+// - metadata[3..3+num_dims]: output shape
+// - per input k, at base = 3 + num_dims + k * (num_dims + 1):
+//   - metadata[base..base+num_dims]: strides
+//   - metadata[base+num_dims]: offset
+//
+// Broadcasting: inputs are expanded to the output shape, with stride 0 along
+// broadcast dims (as for binary ops).
+//
+// In place: the output may be an input that is contiguous at offset 0; any
+// other overlap between an input view and the output is staged through a
+// workspace copy first.
+//
+// Type support: f8e4m3, f8e5m2, bf16, f16 (computed in f32), f32, f64.
+
+void hodu_cpu_fused_elementwise_f8e4m3(const void **inputs, void *output, const size_t *metadata,
+                                       const hodu_cpu_fused_inst_t *program, size_t num_insts);
+void hodu_cpu_fused_elementwise_f8e5m2(const void **inputs, void *output, const size_t *metadata,
+                                       const hodu_cpu_fused_inst_t *program, size_t num_insts);
+void hodu_cpu_fused_elementwise_bf16(const void **inputs, void *output, const size_t *metadata,
+                                     const hodu_cpu_fused_inst_t *program, size_t num_insts);
+void hodu_cpu_fused_elementwise_f16(const void **inputs, void *output, const size_t *metadata,
+                                    const hodu_cpu_fused_inst_t *program, size_t num_insts);
+void hodu_cpu_fused_elementwise_f32(const void **inputs, void *output, const size_t *metadata,
+                                    const hodu_cpu_fused_inst_t *program, size_t num_insts);
+void hodu_cpu_fused_elementwise_f64(const void **inputs, void *output, const size_t *metadata,
+                                    const hodu_cpu_fused_inst_t *program, size_t num_insts);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // HODU_CPU_KERNELS_OPS_FUSED_H
@@ -1,9 +1,205 @@
 #include "ops_indexing.h"
+#include "profile.h"
+#include "simd_utils.h"
+#include "strided_copy.h"
+#include "thread_utils.h"
 #include "types.h"
+#include "utils.h"
+#include "workspace.h"
 #include <stdbool.h>
 #include <stdlib.h>
 #include <string.h>
 
+// Bytes of an index_select block or gather row chunk (the items tasks are made of)
+#define INDEX_TASK_BYTES ((size_t)1 << 16)
+
+// ============================================================================
+// GATHER ROW KERNELS
+// ============================================================================
+//
+// Shared by index_select and gather. A row kernel reads n elements
+//   dst[k] = src[k * step + sel_k * sel_stride],  sel_k = indices[k * idx_stride]
+// where sel_k is resolved against `limit` (negative counts from the end) and
+// out-of-range selections write zero. 4- and 8-byte rows with contiguous indices
+// use masked hardware gathers on AVX2/AVX-512 when the offsets fit in int32.
+
+typedef void (*gather_row_fn_t)(const char *src, size_t step, size_t sel_stride,
+                                const int32_t *indices, size_t idx_stride, size_t limit,
+                                char *dst, size_t n);
+
+/// Copies n elements: dst[k] = src[k * stride]
+typedef void (*index_copy_fn_t)(const char *src, size_t stride, char *dst, size_t n);
+
+/// Resolve an index along a dim of size limit; -1 when out of range
+static inline ptrdiff_t index_resolve(int32_t idx, size_t limit) {
+    ptrdiff_t i = idx;
+    if (i < 0) {
+        i += (ptrdiff_t)limit;
+    }
+    return (i < 0 || (size_t)i >= limit) ? -1 : i;
+}
+
+/// Whether every offset of a vector-gathered row fits the int32 lane indices
+static inline bool gather_fits_i32(size_t n, size_t step, size_t sel_stride, size_t limit) {
+    const uint64_t max = INT32_MAX;
+    if (n == 0 || limit == 0 || n > max || limit > max || step > max || sel_stride > max) {
+        return false;
+    }
+    return (uint64_t)(n - 1) * step + (uint64_t)(limit - 1) * sel_stride <= max;
+}
+
+#if defined(SIMD_AVX2)
+/// Lanes of i32 indices resolved against limit; invalid lanes are cleared in *valid
+static inline __m256i gather_resolve_i32x8(__m256i i, __m256i vlimit, __m256i *valid) {
+    const __m256i zero = _mm256_setzero_si256();
+    i = _mm256_add_epi32(i, _mm256_and_si256(_mm256_cmpgt_epi32(zero, i), vlimit));
+    *valid = _mm256_andnot_si256(_mm256_cmpgt_epi32(zero, i), _mm256_cmpgt_epi32(vlimit, i));
+    return i;
+}
+#endif
+
+/**
+ * @brief Macro to implement the scalar gather and copy rows for one element size
+ */
+#define IMPL_GATHER_ROW_TAIL(TYPE, BYTES)                                                          \
+    static inline void gather_row_##BYTES##_tail(const TYPE *s, size_t step, size_t sel_stride,    \
+                                                 const int32_t *indices, size_t idx_stride,        \
+                                                 size_t limit, TYPE *d, size_t k, size_t n) {      \
+        for (; k < n; k++) {                                                                       \
+            const ptrdiff_t sel = index_resolve(indices[k * idx_stride], limit);                   \
+            d[k] = sel < 0 ? (TYPE)0 : s[k * step + (size_t)sel * sel_stride];                     \
+        }                                                                                          \
+    }                                                                                              \
+                                                                                                   \
+    static void index_copy_##BYTES(const char *src, size_t stride, char *dst, size_t n) {          \
+        const TYPE *s = (const TYPE *)src;                                                         \
+        TYPE *d = (TYPE *)dst;                                                                     \
+        for (size_t k = 0; k < n; k++) {                                                           \
+            d[k] = s[k * stride];                                                                  \
+        }                                                                                          \
+    }
+
+IMPL_GATHER_ROW_TAIL(uint8_t, 1)
+IMPL_GATHER_ROW_TAIL(uint16_t, 2)
+IMPL_GATHER_ROW_TAIL(uint32_t, 4)
+IMPL_GATHER_ROW_TAIL(uint64_t, 8)
+
+static void gather_row_1(const char *src, size_t step, size_t sel_stride, const int32_t *indices,
+                         size_t idx_stride, size_t limit, char *dst, size_t n) {
+    gather_row_1_tail((const uint8_t *)src, step, sel_stride, indices, idx_stride, limit,
+                      (uint8_t *)dst, 0, n);
+}
+
+static void gather_row_2(const char *src, size_t step, size_t sel_stride, const int32_t *indices,
+                         size_t idx_stride, size_t limit, char *dst, size_t n) {
+    gather_row_2_tail((const uint16_t *)src, step, sel_stride, indices, idx_stride, limit,
+                      (uint16_t *)dst, 0, n);
+}
+
+static void gather_row_4(const char *src, size_t step, size_t sel_stride, const int32_t *indices,
+                         size_t idx_stride, size_t limit, char *dst, size_t n) {
+    const uint32_t *s = (const uint32_t *)src;
+    uint32_t *d = (uint32_t *)dst;
+    size_t k = 0;
+#if defined(SIMD_AVX2)
+    if (idx_stride == 1 && n >= 8 && gather_fits_i32(n, step, sel_stride, limit)) {
+#if defined(SIMD_AVX512)
+        const __m512i vlimit16 = _mm512_set1_epi32((int32_t)limit);
+        const __m512i vsel16 = _mm512_set1_epi32((int32_t)sel_stride);
+        __m512i vk16 = _mm512_mullo_epi32(
+            _mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15),
+            _mm512_set1_epi32((int32_t)step));
+        const __m512i vkstep16 = _mm512_set1_epi32((int32_t)(16 * step));
+        for (; k + 16 <= n; k += 16) {
+            __m512i i = _mm512_loadu_si512((const void *)(indices + k));
+            const __mmask16 neg = _mm512_cmplt_epi32_mask(i, _mm512_setzero_si512());
+            i = _mm512_mask_add_epi32(i, neg, i, vlimit16);
+            const __mmask16 valid = _mm512_cmpge_epi32_mask(i, _mm512_setzero_si512()) &
+                                    _mm512_cmplt_epi32_mask(i, vlimit16);
+            const __m512i off = _mm512_add_epi32(vk16, _mm512_mullo_epi32(i, vsel16));
+            const __m512i v =
+                _mm512_mask_i32gather_epi32(_mm512_setzero_si512(), valid, off, (const void *)s, 4);
+            _mm512_storeu_si512((void *)(d + k), v);
+            vk16 = _mm512_add_epi32(vk16, vkstep16);
+        }
+#endif
+        const __m256i vlimit = _mm256_set1_epi32((int32_t)limit);
+        const __m256i vsel = _mm256_set1_epi32((int32_t)sel_stride);
+        __m256i vk = _mm256_mullo_epi32(_mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7),
+                                        _mm256_set1_epi32((int32_t)step));
+        vk = _mm256_add_epi32(vk, _mm256_set1_epi32((int32_t)(k * step)));
+        const __m256i vkstep = _mm256_set1_epi32((int32_t)(8 * step));
+        for (; k + 8 <= n; k += 8) {
+            __m256i valid;
+            const __m256i i = gather_resolve_i32x8(
+                _mm256_loadu_si256((const __m256i *)(indices + k)), vlimit, &valid);
+            const __m256i off = _mm256_add_epi32(vk, _mm256_mullo_epi32(i, vsel));
+            const __m256i v = _mm256_mask_i32gather_epi32(_mm256_setzero_si256(), (const int *)s,
+                                                          off, valid, 4);
+            _mm256_storeu_si256((__m256i *)(d + k), v);
+            vk = _mm256_add_epi32(vk, vkstep);
+        }
+    }
+#endif
+    gather_row_4_tail(s, step, sel_stride, indices, idx_stride, limit, d, k, n);
+}
+
+static void gather_row_8(const char *src, size_t step, size_t sel_stride, const int32_t *indices,
+                         size_t idx_stride, size_t limit, char *dst, size_t n) {
+    const uint64_t *s = (const uint64_t *)src;
+    uint64_t *d = (uint64_t *)dst;
+    size_t k = 0;
+#if defined(SIMD_AVX2)
+    if (idx_stride == 1 && n >= 8 && gather_fits_i32(n, step, sel_stride, limit)) {
+        const __m256i vlimit = _mm256_set1_epi32((int32_t)limit);
+        const __m256i vsel = _mm256_set1_epi32((int32_t)sel_stride);
+        __m256i vk = _mm256_mullo_epi32(_mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7),
+                                        _mm256_set1_epi32((int32_t)step));
+        const __m256i vkstep = _mm256_set1_epi32((int32_t)(8 * step));
+        for (; k + 8 <= n; k += 8) {
+            __m256i valid;
+            const __m256i i = gather_resolve_i32x8(
+                _mm256_loadu_si256((const __m256i *)(indices + k)), vlimit, &valid);
+            const __m256i off = _mm256_add_epi32(vk, _mm256_mullo_epi32(i, vsel));
+            const __m256i lo_mask = _mm256_cvtepi32_epi64(_mm256_castsi256_si128(valid));
+            const __m256i hi_mask = _mm256_cvtepi32_epi64(_mm256_extracti128_si256(valid, 1));
+            const __m256i lo = _mm256_mask_i32gather_epi64(
+                _mm256_setzero_si256(), (const long long *)s, _mm256_castsi256_si128(off),
+                lo_mask, 8);
+            const __m256i hi = _mm256_mask_i32gather_epi64(
+                _mm256_setzero_si256(), (const long long *)s, _mm256_extracti128_si256(off, 1),
+                hi_mask, 8);
+            _mm256_storeu_si256((__m256i *)(d + k), lo);
+            _mm256_storeu_si256((__m256i *)(d + k + 4), hi);
+            vk = _mm256_add_epi32(vk, vkstep);
+        }
+    }
+#endif
+    gather_row_8_tail(s, step, sel_stride, indices, idx_stride, limit, d, k, n);
+}
+
+/// Row kernels for an element size (all indexing types are 1, 2, 4 or 8 bytes)
+static void gather_kernels(size_t elem_size, gather_row_fn_t *gather, index_copy_fn_t *copy) {
+    switch (elem_size) {
+    case 1:
+        *gather = gather_row_1;
+        *copy = index_copy_1;
+        break;
+    case 2:
+        *gather = gather_row_2;
+        *copy = index_copy_2;
+        break;
+    case 4:
+        *gather = gather_row_4;
+        *copy = index_copy_4;
+        break;
+    default:
+        *gather = gather_row_8;
+        *copy = index_copy_8;
+        break;
+    }
+}
+
 // ============================================================================
 // INDEX SELECT OPERATIONS
 // ============================================================================
@@ -20,9 +216,122 @@
 // - metadata[2+2*num_dims+2]: num_indices (number of indices)
 //
 // Algorithm:
-// For each output element, compute its multi-dimensional index, lookup the
-// corresponding index value along the select dimension, and read from input.
-// Supports negative indices (Python-style).
+// The output is (outer dims) x num_indices x (inner dims). Tasks cover an outer
+// position and a block of indices; each selected slice is one memcpy when the
+// inner dims are contiguous (embedding lookups), a row gather when selecting
+// along the innermost dim, and a strided walk otherwise. Negative indices count
+// from the end (Python-style); out-of-range indices select zeros.
+
+typedef struct {
+    const char *input; // at the input offset
+    const int32_t *indices;
+    char *output;
+    size_t elem_size;
+    size_t num_dims;
+    const size_t *shape;
+    const size_t *strides;
+    size_t dim;
+    size_t num_indices;
+    size_t inner;           // elements per selected slice (dims after dim)
+    bool inner_contiguous;  // slices are single memcpy runs
+    size_t block;           // indices per task
+    size_t blocks;          // tasks per outer position
+    gather_row_fn_t gather;
+    index_copy_fn_t copy;
+} index_select_args_t;
+
+/// Tasks [start, end): item = (outer position, block of indices)
+static void index_select_worker(size_t start, size_t end, void *arg) {
+    const index_select_args_t *args = (const index_select_args_t *)arg;
+    const size_t es = args->elem_size;
+    const size_t dim = args->dim;
+    const size_t limit = args->shape[dim];
+    const size_t sel_stride = args->strides[dim];
+    const size_t slice_bytes = args->inner * es;
+
+    for (size_t item = start; item < end; item++) {
+        const size_t outer = item / args->blocks;
+        const size_t j0 = (item % args->blocks) * args->block;
+        const size_t j1 = MINIMUM(args->num_indices, j0 + args->block);
+
+        size_t rem = outer;
+        size_t src_off = 0;
+        for (size_t d = dim; d-- > 0;) {
+            src_off += (rem % args->shape[d]) * args->strides[d];
+            rem /= args->shape[d];
+        }
+        const char *src = args->input + src_off * es;
+        char *dst = args->output + (outer * args->num_indices + j0) * slice_bytes;
+
+        if (args->inner == 1) {
+            /* Selecting along the innermost dim: one gathered row */
+            args->gather(src, 0, sel_stride, args->indices + j0, 1, limit, dst, j1 - j0);
+            continue;
+        }
+        for (size_t j = j0; j < j1; j++, dst += slice_bytes) {
+            const ptrdiff_t sel = index_resolve(args->indices[j], limit);
+            if (sel < 0) {
+                memset(dst, 0, slice_bytes);
+                continue;
+            }
+            const char *slice = src + (size_t)sel * sel_stride * es;
+            if (args->inner_contiguous) {
+                /* Embedding-style lookup: the selected slice is one contiguous run */
+                memcpy(dst, slice, slice_bytes);
+                continue;
+            }
+            strided_iter_t it;
+            strided_iter_init(&it, args->num_dims - dim - 1, args->shape + dim + 1,
+                              args->strides + dim + 1, 0);
+            for (size_t k = 0; k < args->inner;) {
+                const size_t n = strided_iter_row(&it);
+                args->copy(slice + it.offset * es, it.inner_stride, dst + k * es, n);
+                k += n;
+                strided_iter_advance(&it, n);
+            }
+        }
+    }
+}
+
+/// index_select for any element size: parallel over (outer position, index block)
+static void index_select_run(const void *input, const int32_t *indices, void *output,
+                             const size_t *metadata, size_t elem_size) {
+    const size_t num_els = metadata[0];
+    const size_t num_dims = metadata[1];
+    const size_t *shape = metadata + 2;
+    const size_t *strides = metadata + 2 + num_dims;
+    const size_t input_offset = metadata[2 + 2 * num_dims];
+    const size_t dim = metadata[2 + 2 * num_dims + 1];
+    const size_t num_indices = metadata[2 + 2 * num_dims + 2];
+    if (num_els == 0 || num_indices == 0) {
+        return;
+    }
+
+    index_select_args_t args;
+    args.input = (const char *)input + input_offset * elem_size;
+    args.indices = indices;
+    args.output = (char *)output;
+    args.elem_size = elem_size;
+    args.num_dims = num_dims;
+    args.shape = shape;
+    args.strides = strides;
+    args.dim = dim;
+    args.num_indices = num_indices;
+    args.inner = 1;
+    for (size_t d = dim + 1; d < num_dims; d++) {
+        args.inner *= shape[d];
+    }
+    args.inner_contiguous =
+        is_contiguous(num_dims - dim - 1, shape + dim + 1, strides + dim + 1);
+    args.block = MINIMUM(num_indices, INDEX_TASK_BYTES / (args.inner * elem_size) + 1);
+    args.blocks = (num_indices + args.block - 1) / args.block;
+    gather_kernels(elem_size, &args.gather, &args.copy);
+
+    const size_t outer = num_els / (num_indices * args.inner);
+    const size_t item_bytes = args.block * args.inner * elem_size;
+    parallel_for(0, outer * args.blocks, task_grain(HODU_CPU_COST_COPY, item_bytes),
+                 index_select_worker, &args);
+}
 
 /// Macro to implement index_select operation
 ///
@@ -31,56 +340,8 @@
 #define INDEX_SELECT_OP(TYPENAME, FN_NAME)                                                         \
     void hodu_cpu_##FN_NAME(const void *input_ptr, const int32_t *indices, void *output_ptr,       \
                             const size_t *metadata) {                                              \
-        const TYPENAME *input = (const TYPENAME *)input_ptr;                                       \
-        TYPENAME *output = (TYPENAME *)output_ptr;                                                 \
-                                                                                                   \
-        const size_t num_els = metadata[0];                                                        \
-        const size_t num_dims = metadata[1];                                                       \
-        const size_t *input_shape = metadata + 2;                                                  \
-        const size_t *input_strides = metadata + 2 + num_dims;                                     \
-        const size_t input_offset = metadata[2 + 2 * num_dims];                                    \
-        const size_t dim = metadata[2 + 2 * num_dims + 1];                                         \
-        const size_t num_indices = metadata[2 + 2 * num_dims + 2];                                 \
-                                                                                                   \
-        for (size_t id = 0; id < num_els; id++) {                                                  \
-            size_t temp = id;                                                                      \
-            size_t idx_at_dim = 0;                                                                 \
-                                                                                                   \
-            size_t temp2 = id;                                                                     \
-            for (int d = (int)num_dims - 1; d >= 0; d--) {                                         \
-                size_t output_shape_d = (d == (int)dim) ? num_indices : input_shape[d];            \
-                if (d == (int)dim) {                                                               \
-                    idx_at_dim = temp2 % output_shape_d;                                           \
-                }                                                                                  \
-                temp2 /= output_shape_d;                                                           \
-            }                                                                                      \
-                                                                                                   \
-            int32_t selected_idx = indices[idx_at_dim];                                            \
-                                                                                                   \
-            if (selected_idx < 0) {                                                                \
-                selected_idx += (int32_t)input_shape[dim];                                         \
-            }                                                                                      \
-                                                                                                   \
-            if (selected_idx < 0 || (size_t)selected_idx >= input_shape[dim]) {                    \
-                output[id] = (TYPENAME)0;                                                          \
-                continue;                                                                          \
-            }                                                                                      \
-                                                                                                   \
-            size_t flat_index = input_offset;                                                      \
-            temp = id;                                                                             \
-            for (int d = (int)num_dims - 1; d >= 0; d--) {                                         \
-                size_t output_shape_d = (d == (int)dim) ? num_indices : input_shape[d];            \
-                size_t idx = temp % output_shape_d;                                                \
-                temp /= output_shape_d;                                                            \
-                if (d == (int)dim) {                                                               \
-                    flat_index += ((size_t)selected_idx) * input_strides[d];                       \
-                } else {                                                                           \
-                    flat_index += idx * input_strides[d];                                          \
-                }                                                                                  \
-            }                                                                                      \
-                                                                                                   \
-            output[id] = input[flat_index];                                                        \
-        }                                                                                          \
+        HODU_PROFILE_KERNEL(metadata[0] * 2 * sizeof(TYPENAME));                                   \
+        index_select_run(input_ptr, indices, output_ptr, metadata, sizeof(TYPENAME));              \
     }
 
 INDEX_SELECT_OP(bool, index_select_bool)
@@ -117,9 +378,156 @@ INDEX_SELECT_OP(uint64_t, index_select_u64)
 // - metadata[2+3*num_dims+3]: num_indices
 //
 // Algorithm:
-// For each output position, check if its index along the write dimension
-// matches any index in the indices array. If so, write from values tensor;
-// otherwise, copy from input tensor.
+// The input is copied to the output (skipped when output is the input itself,
+// see indexing_copy_input), then every distinct target position along dim
+// gets its values slice: for each outer position one block of inner elements
+// (the dims after dim), a memcpy for row-major values. Targets are resolved
+// once: negative indices wrap once, out-of-range ones are skipped and for a
+// repeated target the first index wins. The (outer, target) blocks run on the
+// thread pool.
+
+/// Copy an input view into the output unless the output already holds it
+///
+/// Nothing is copied when the view sits exactly on the output (in place); a view that
+/// overlaps the output in any other way is staged through a contiguous copy first.
+static void indexing_copy_input(const char *input, void *output, size_t elem_size,
+                                size_t num_dims, const size_t *shape, const size_t *strides) {
+    void *staged = hodu_cpu_stage_overlapping_view(input, elem_size, num_dims, shape, strides,
+                                                   output, elem_size);
+    if (staged) {
+        size_t num_els = 1;
+        for (size_t d = 0; d < num_dims; d++) {
+            num_els *= shape[d];
+        }
+        memcpy(output, staged, num_els * elem_size);
+        workspace_release(staged);
+    } else if ((const void *)input != output) {
+        hodu_cpu_strided_copy(input, output, elem_size, num_dims, shape, strides, NULL);
+    }
+}
+
+typedef struct {
+    const char *values; // at values_offset
+    char *output;
+    size_t elem_size;
+    size_t num_dims;
+    size_t dim;
+    const size_t *shape; // input (and output) shape
+    const size_t *values_strides;
+    size_t inner; // elements per block: the dims after dim
+    bool values_dense; // the values dims after dim are row-major
+    const size_t *targets; // distinct positions along dim
+    const size_t *sources; // values index along dim written to each target
+    size_t num_targets;
+} index_put_args_t;
+
+/// Blocks [start, end): block k writes target k % num_targets of outer position k / num_targets
+static void index_put_worker(size_t start, size_t end, void *arg) {
+    const index_put_args_t *a = (const index_put_args_t *)arg;
+    const size_t es = a->elem_size;
+    const size_t limit = a->shape[a->dim];
+    for (size_t k = start; k < end; k++) {
+        const size_t o = k / a->num_targets;
+        const size_t t = k % a->num_targets;
+        char *dst = a->output + ((o * limit + a->targets[t]) * a->inner) * es;
+        size_t off = a->sources[t] * a->values_strides[a->dim];
+        size_t rem = o;
+        for (size_t d = a->dim; d-- > 0;) {
+            off += (rem % a->shape[d]) * a->values_strides[d];
+            rem /= a->shape[d];
+        }
+        if (a->values_dense) {
+            memcpy(dst, a->values + off * es, a->inner * es);
+        } else {
+            hodu_cpu_strided_copy(a->values + off * es, dst, es, a->num_dims - a->dim - 1,
+                                  a->shape + a->dim + 1, a->values_strides + a->dim + 1, NULL);
+        }
+    }
+}
+
+static void index_put_run(const void *input, const int32_t *indices, const void *values,
+                          void *output, const size_t *metadata, size_t elem_size) {
+    const size_t num_els = metadata[0];
+    const size_t num_dims = metadata[1];
+    const size_t *input_shape = metadata + 2;
+    const size_t *input_strides = metadata + 2 + num_dims;
+    const size_t *values_strides = metadata + 2 + 2 * num_dims;
+    const size_t input_offset = metadata[2 + 3 * num_dims];
+    const size_t values_offset = metadata[2 + 3 * num_dims + 1];
+    const size_t dim = metadata[2 + 3 * num_dims + 2];
+    const size_t num_indices = metadata[2 + 3 * num_dims + 3];
+    if (num_els == 0) {
+        return;
+    }
+
+    indexing_copy_input((const char *)input + input_offset * elem_size, output, elem_size,
+                        num_dims, input_shape, input_strides);
+    if (dim >= num_dims || num_indices == 0) {
+        return;
+    }
+
+    const size_t limit = input_shape[dim];
+    const size_t pairs_bytes = hodu_cpu_workspace_block_size(2 * num_indices * sizeof(size_t));
+    char *scratch = (char *)workspace_acquire(pairs_bytes + limit * sizeof(size_t));
+    if (!scratch) {
+        return;
+    }
+    size_t *targets = (size_t *)scratch;
+    size_t *sources = targets + num_indices;
+    size_t *first = (size_t *)(scratch + pairs_bytes);
+
+    /* first[t]: lowest index i writing position t (num_indices if none) */
+    for (size_t t = 0; t < limit; t++) {
+        first[t] = num_indices;
+    }
+    for (size_t i = num_indices; i-- > 0;) {
+        int64_t t = indices[i];
+        if (t < 0) {
+            t += (int64_t)limit;
+        }
+        if (t >= 0 && (size_t)t < limit) {
+            first[t] = i;
+        }
+    }
+    size_t num_targets = 0;
+    for (size_t t = 0; t < limit; t++) {
+        if (first[t] < num_indices) {
+            targets[num_targets] = t;
+            sources[num_targets] = first[t];
+            num_targets++;
+        }
+    }
+
+    size_t inner = 1;
+    size_t expected = 1;
+    bool values_dense = true;
+    for (size_t d = num_dims; d-- > dim + 1;) {
+        if (input_shape[d] != 1 && values_strides[d] != expected) {
+            values_dense = false;
+        }
+        expected *= input_shape[d];
+        inner *= input_shape[d];
+    }
+
+    if (num_targets > 0 && inner > 0) {
+        index_put_args_t args = {(const char *)values + values_offset * elem_size,
+                                 (char *)output,
+                                 elem_size,
+                                 num_dims,
+                                 dim,
+                                 input_shape,
+                                 values_strides,
+                                 inner,
+                                 values_dense,
+                                 targets,
+                                 sources,
+                                 num_targets};
+        const size_t blocks = num_els / (limit * inner) * num_targets;
+        parallel_for(0, blocks, task_grain(HODU_CPU_COST_COPY, inner * elem_size),
+                     index_put_worker, &args);
+    }
+    workspace_release(scratch);
+}
 
 /// Macro to implement index_put operation
 ///
@@ -128,70 +536,8 @@ INDEX_SELECT_OP(uint64_t, index_select_u64)
 #define INDEX_PUT_OP(TYPENAME, FN_NAME)                                                            \
     void hodu_cpu_##FN_NAME(const void *input_ptr, const int32_t *indices, const void *values_ptr, \
                             void *output_ptr, const size_t *metadata) {                            \
-        const TYPENAME *input = (const TYPENAME *)input_ptr;                                       \
-        const TYPENAME *values = (const TYPENAME *)values_ptr;                                     \
-        TYPENAME *output = (TYPENAME *)output_ptr;                                                 \
-                                                                                                   \
-        const size_t num_els = metadata[0];                                                        \
-        const size_t num_dims = metadata[1];                                                       \
-                                                                                                   \
-        const size_t *input_shape = metadata + 2;                                                  \
-        const size_t *input_strides = metadata + 2 + num_dims;                                     \
-        const size_t *values_strides = metadata + 2 + 2 * num_dims;                                \
-        const size_t input_offset = metadata[2 + 3 * num_dims];                                    \
-        const size_t values_offset = metadata[2 + 3 * num_dims + 1];                               \
-        const size_t dim = metadata[2 + 3 * num_dims + 2];                                         \
-        const size_t num_indices = metadata[2 + 3 * num_dims + 3];                                 \
-                                                                                                   \
-        for (size_t id = 0; id < num_els; id++) {                                                  \
-            size_t temp = id;                                                                      \
-            size_t idx_at_dim = 0;                                                                 \
-            for (int d = (int)num_dims - 1; d >= 0; d--) {                                         \
-                size_t idx = temp % input_shape[d];                                                \
-                if (d == (int)dim) {                                                               \
-                    idx_at_dim = idx;                                                              \
-                }                                                                                  \
-                temp /= input_shape[d];                                                            \
-            }                                                                                      \
-                                                                                                   \
-            int found = 0;                                                                         \
-            size_t values_idx_in_dim = 0;                                                          \
-            for (size_t i = 0; i < num_indices; i++) {                                             \
-                int32_t target_idx = indices[i];                                                   \
-                if (target_idx < 0) {                                                              \
-                    target_idx += (int32_t)input_shape[dim];                                       \
-                }                                                                                  \
-                if (target_idx >= 0 && (size_t)target_idx == idx_at_dim) {                         \
-                    found = 1;                                                                     \
-                    values_idx_in_dim = i;                                                         \
-                    break;                                                                         \
-                }                                                                                  \
-            }                                                                                      \
-                                                                                                   \
-            if (found) {                                                                           \
-                size_t values_flat_idx = values_offset;                                            \
-                temp = id;                                                                         \
-                for (int d = (int)num_dims - 1; d >= 0; d--) {                                     \
-                    size_t idx = temp % input_shape[d];                                            \
-                    temp /= input_shape[d];                                                        \
-                    if (d == (int)dim) {                                                           \
-                        values_flat_idx += values_idx_in_dim * values_strides[d];                  \
-                    } else {                                                                       \
-                        values_flat_idx += idx * values_strides[d];                                \
-                    }                                                                              \
-                }                                                                                  \
-                output[id] = values[values_flat_idx];                                              \
-            } else {                                                                               \
-                size_t input_flat_idx = input_offset;                                              \
-                temp = id;                                                                         \
-                for (int d = (int)num_dims - 1; d >= 0; d--) {                                     \
-                    size_t idx = temp % input_shape[d];                                            \
-                    temp /= input_shape[d];                                                        \
-                    input_flat_idx += idx * input_strides[d];                                      \
-                }                                                                                  \
-                output[id] = input[input_flat_idx];                                                \
-            }                                                                                      \
-        }                                                                                          \
+        HODU_PROFILE_KERNEL(metadata[0] * 2 * sizeof(TYPENAME));                                   \
+        index_put_run(input_ptr, indices, values_ptr, output_ptr, metadata, sizeof(TYPENAME));     \
     }
 
 INDEX_PUT_OP(bool, index_put_bool)
@@ -228,8 +574,87 @@ INDEX_PUT_OP(uint64_t, index_put_u64)
 // - metadata[2+4*num_dims+2]: dim (dimension along which to gather)
 //
 // Algorithm:
-// Similar to index_select but indices can be multi-dimensional. For each
-// output element, lookup the index from the indices tensor and gather from input.
+// Similar to index_select but indices can be multi-dimensional. Output rows
+// (split into chunks for long rows) run on the thread pool; each row reads its
+// indices and gathers from input with the shared row kernels.
+
+typedef struct {
+    const char *input;      // at the input offset
+    const int32_t *indices; // at the indices offset
+    char *output;
+    size_t elem_size;
+    size_t num_dims;
+    const size_t *output_shape;
+    const size_t *input_shape;
+    const size_t *input_strides;
+    const size_t *indices_strides;
+    size_t dim;
+    size_t chunk;  // output elements per task along the last dim
+    size_t chunks; // tasks per output row
+    gather_row_fn_t gather;
+} gather_args_t;
+
+/// Tasks [start, end): item = (output row, chunk of the last dim)
+static void gather_worker(size_t start, size_t end, void *arg) {
+    const gather_args_t *args = (const gather_args_t *)arg;
+    const size_t es = args->elem_size;
+    const size_t last = args->num_dims - 1;
+    const size_t dim = args->dim;
+    const size_t row_len = args->output_shape[last];
+    const size_t step = (dim == last) ? 0 : args->input_strides[last];
+
+    for (size_t item = start; item < end; item++) {
+        const size_t row = item / args->chunks;
+        const size_t k0 = (item % args->chunks) * args->chunk;
+        const size_t n = MINIMUM(row_len - k0, args->chunk);
+
+        /* Coordinates of the row over the outer dims; `dim` comes from the indices */
+        size_t rem = row;
+        size_t in_off = k0 * step;
+        size_t idx_off = k0 * args->indices_strides[last];
+        for (size_t d = last; d-- > 0;) {
+            const size_t c = rem % args->output_shape[d];
+            rem /= args->output_shape[d];
+            idx_off += c * args->indices_strides[d];
+            if (d != dim) {
+                in_off += c * args->input_strides[d];
+            }
+        }
+        args->gather(args->input + in_off * es, step, args->input_strides[dim],
+                     args->indices + idx_off, args->indices_strides[last],
+                     args->input_shape[dim], args->output + (row * row_len + k0) * es, n);
+    }
+}
+
+/// gather for any element size: parallel over output rows split into chunks
+static void gather_run(const void *input, const int32_t *indices, void *output,
+                       const size_t *metadata, size_t elem_size) {
+    const size_t num_els = metadata[0];
+    const size_t num_dims = metadata[1];
+    if (num_els == 0 || num_dims == 0) {
+        return;
+    }
+
+    gather_args_t args;
+    args.output_shape = metadata + 2;
+    args.input_shape = metadata + 2 + num_dims;
+    args.input_strides = metadata + 2 + 2 * num_dims;
+    args.indices_strides = metadata + 2 + 3 * num_dims;
+    args.input = (const char *)input + metadata[2 + 4 * num_dims] * elem_size;
+    args.indices = indices + metadata[2 + 4 * num_dims + 1];
+    args.output = (char *)output;
+    args.elem_size = elem_size;
+    args.num_dims = num_dims;
+    args.dim = metadata[2 + 4 * num_dims + 2];
+
+    index_copy_fn_t copy;
+    gather_kernels(elem_size, &args.gather, &copy);
+    const size_t row_len = args.output_shape[num_dims - 1];
+    args.chunk = MINIMUM(row_len, INDEX_TASK_BYTES / elem_size);
+    args.chunks = (row_len + args.chunk - 1) / args.chunk;
+    const size_t grain = task_grain(HODU_CPU_COST_COPY, args.chunk * elem_size);
+    parallel_for(0, num_els / row_len * args.chunks, grain, gather_worker, &args);
+}
 
 /// Macro to implement gather operation
 ///
@@ -238,53 +663,8 @@ INDEX_PUT_OP(uint64_t, index_put_u64)
 #define GATHER_OP(TYPENAME, FN_NAME)                                                               \
     void hodu_cpu_##FN_NAME(const void *input_ptr, const int32_t *indices, void *output_ptr,       \
                             const size_t *metadata) {                                              \
-        const TYPENAME *input = (const TYPENAME *)input_ptr;                                       \
-        TYPENAME *output = (TYPENAME *)output_ptr;                                                 \
-                                                                                                   \
-        const size_t num_els = metadata[0];                                                        \
-        const size_t num_dims = metadata[1];                                                       \
-        const size_t *output_shape = metadata + 2;                                                 \
-        const size_t *input_shape = metadata + 2 + num_dims;                                       \
-        const size_t *input_strides = metadata + 2 + 2 * num_dims;                                 \
-        const size_t *indices_strides = metadata + 2 + 3 * num_dims;                               \
-        const size_t input_offset = metadata[2 + 4 * num_dims];                                    \
-        const size_t indices_offset = metadata[2 + 4 * num_dims + 1];                              \
-        const size_t dim = metadata[2 + 4 * num_dims + 2];                                         \
-                                                                                                   \
-        for (size_t id = 0; id < num_els; id++) {                                                  \
-            size_t temp = id;                                                                      \
-            size_t output_indices[num_dims];                                                       \
-            for (int d = (int)num_dims - 1; d >= 0; d--) {                                         \
-                output_indices[d] = temp % output_shape[d];                                        \
-                temp /= output_shape[d];                                                           \
-            }                                                                                      \
-                                                                                                   \
-            size_t indices_flat_idx = indices_offset;                                              \
-            for (size_t d = 0; d < num_dims; d++) {                                                \
-                indices_flat_idx += output_indices[d] * indices_strides[d];                        \
-            }                                                                                      \
-            int32_t selected_idx = indices[indices_flat_idx];                                      \
-                                                                                                   \
-            if (selected_idx < 0) {                                                                \
-                selected_idx += (int32_t)input_shape[dim];                                         \
-            }                                                                                      \
-                                                                                                   \
-            if (selected_idx < 0 || (size_t)selected_idx >= input_shape[dim]) {                    \
-                output[id] = (TYPENAME)0;                                                          \
-                continue;                                                                          \
-            }                                                                                      \
-                                                                                                   \
-            size_t input_flat_idx = input_offset;                                                  \
-            for (size_t d = 0; d < num_dims; d++) {                                                \
-                if (d == dim) {                                                                    \
-                    input_flat_idx += ((size_t)selected_idx) * input_strides[d];                   \
-                } else {                                                                           \
-                    input_flat_idx += output_indices[d] * input_strides[d];                        \
-                }                                                                                  \
-            }                                                                                      \
-                                                                                                   \
-            output[id] = input[input_flat_idx];                                                    \
-        }                                                                                          \
+        HODU_PROFILE_KERNEL(metadata[0] * (2 * sizeof(TYPENAME) + sizeof(int32_t)));               \
+        gather_run(input_ptr, indices, output_ptr, metadata, sizeof(TYPENAME));                    \
     }
 
 GATHER_OP(bool, gather_bool)
@@ -303,6 +683,289 @@ GATHER_OP(uint16_t, gather_u16)
 GATHER_OP(uint32_t, gather_u32)
 GATHER_OP(uint64_t, gather_u64)
 
+// ============================================================================
+// SCATTER REDUCE ENGINE
+// ============================================================================
+//
+// Shared by scatter, scatter_add, scatter_max and scatter_min. The input is
+// first copied to the output (nothing to copy when the output is the input);
+// every src element then resolves to a pair (output element, src offset), and a
+// per-type segment kernel combines a run of pairs into the output in order.
+//
+// Large scatters run in three passes on the thread pool instead of with atomics
+// (duplicate-heavy index sets would serialize on CAS loops):
+// 1. Chunks of src resolve their pairs and count them per bucket, where a
+//    bucket is the high bits of the output element (radix partitioning)
+// 2. A prefix sum over (bucket, chunk) gives each chunk's slot in each bucket
+//    and the chunks scatter their pairs there, a stable counting sort
+// 3. Each bucket is reduced on its own task
+// Buckets own disjoint output ranges and keep their pairs in src order, so
+// every output sees exactly the serial sequence of updates: results are
+// bit-identical to the serial loop for any thread count.
+
+// Dims supported by scatter (as the serial kernels always assumed)
+#define SCATTER_MAX_DIMS 32
+// Pairs resolved per step when reducing without partitioning
+#define SCATTER_BLOCK 256
+// Upper bound on partition buckets and on src chunks
+#define SCATTER_MAX_BUCKETS 256
+#define SCATTER_MAX_CHUNKS 64
+// Minimum src elements per chunk, and per call to partition at all
+#define SCATTER_CHUNK_MIN ((size_t)1 << 13)
+
+typedef struct {
+    size_t dst; // output element
+    size_t src; // src element offset
+} scatter_pair_t;
+
+/// Combines n pairs into output, in order: output[dst] = op(output[dst], src[src])
+typedef void (*scatter_reduce_fn_t)(void *output, const void *src, const scatter_pair_t *pairs,
+                                    size_t n);
+
+typedef struct {
+    const int32_t *indices;
+    const void *src;
+    void *output;
+    scatter_reduce_fn_t reduce;
+    size_t num_els;
+    size_t num_dims;
+    const size_t *src_shape;
+    const size_t *src_strides;
+    const size_t *indices_strides;
+    size_t out_strides[SCATTER_MAX_DIMS]; // contiguous output strides, 0 along dim
+    size_t out_dim_stride;
+    size_t out_total;
+    size_t limit; // input_shape[dim]
+    size_t src_offset;
+    size_t indices_offset;
+    /* Partitioned passes */
+    size_t chunk;
+    size_t num_chunks;
+    size_t num_buckets;
+    unsigned shift;
+    scatter_pair_t *resolved; // per-chunk runs of resolved pairs
+    scatter_pair_t *sorted;   // pairs grouped by bucket
+    size_t *valid;            // resolved pairs per chunk
+    size_t *slots;            // [chunk][bucket] counts, then write positions
+    size_t *bucket_start;     // num_buckets + 1 offsets into sorted
+} scatter_args_t;
+
+/// Resolve src elements [start, start + count) into pairs; returns the number kept
+///
+/// Elements whose index is out of range (after wrapping negatives) or whose
+/// output element lies past the output are dropped.
+static size_t scatter_resolve(const scatter_args_t *a, size_t start, size_t count,
+                              scatter_pair_t *pairs) {
+    const size_t nd = a->num_dims;
+    size_t idx[SCATTER_MAX_DIMS];
+    size_t src_off = a->src_offset;
+    size_t ind_off = a->indices_offset;
+    size_t out_off = 0;
+    size_t temp = start;
+    for (size_t d = nd; d-- > 0;) {
+        idx[d] = temp % a->src_shape[d];
+        temp /= a->src_shape[d];
+        src_off += idx[d] * a->src_strides[d];
+        ind_off += idx[d] * a->indices_strides[d];
+        out_off += idx[d] * a->out_strides[d];
+    }
+
+    size_t n = 0;
+    for (size_t k = 0; k < count; k++) {
+        const ptrdiff_t target = index_resolve(a->indices[ind_off], a->limit);
+        if (target >= 0) {
+            const size_t dst = out_off + (size_t)target * a->out_dim_stride;
+            if (dst < a->out_total) {
+                pairs[n].dst = dst;
+                pairs[n].src = src_off;
+                n++;
+            }
+        }
+        // Odometer step; offsets wrap modulo SIZE_MAX + 1 when a dim rolls over
+        for (size_t d = nd; d-- > 0;) {
+            if (++idx[d] < a->src_shape[d]) {
+                src_off += a->src_strides[d];
+                ind_off += a->indices_strides[d];
+                out_off += a->out_strides[d];
+                break;
+            }
+            idx[d] = 0;
+            src_off -= (a->src_shape[d] - 1) * a->src_strides[d];
+            ind_off -= (a->src_shape[d] - 1) * a->indices_strides[d];
+            out_off -= (a->src_shape[d] - 1) * a->out_strides[d];
+        }
+    }
+    return n;
+}
+
+/// Pass 1: resolve each chunk into its run and count its pairs per bucket
+static void scatter_count_worker(size_t start, size_t end, void *ctx) {
+    const scatter_args_t *a = (const scatter_args_t *)ctx;
+    for (size_t c = start; c < end; c++) {
+        const size_t first = c * a->chunk;
+        const size_t count = MINIMUM(a->chunk, a->num_els - first);
+        scatter_pair_t *run = a->resolved + first;
+        size_t *counts = a->slots + c * a->num_buckets;
+        const size_t n = scatter_resolve(a, first, count, run);
+        memset(counts, 0, a->num_buckets * sizeof(size_t));
+        for (size_t k = 0; k < n; k++) {
+            counts[run[k].dst >> a->shift]++;
+        }
+        a->valid[c] = n;
+    }
+}
+
+/// Pass 2: move each chunk's pairs to its slots in the buckets, keeping order
+static void scatter_partition_worker(size_t start, size_t end, void *ctx) {
+    const scatter_args_t *a = (const scatter_args_t *)ctx;
+    for (size_t c = start; c < end; c++) {
+        const scatter_pair_t *run = a->resolved + c * a->chunk;
+        size_t *pos = a->slots + c * a->num_buckets;
+        for (size_t k = 0; k < a->valid[c]; k++) {
+            a->sorted[pos[run[k].dst >> a->shift]++] = run[k];
+        }
+    }
+}
+
+/// Pass 3: reduce each bucket's pairs into its output range
+static void scatter_bucket_worker(size_t start, size_t end, void *ctx) {
+    const scatter_args_t *a = (const scatter_args_t *)ctx;
+    for (size_t b = start; b < end; b++) {
+        const size_t first = a->bucket_start[b];
+        a->reduce(a->output, a->src, a->sorted + first, a->bucket_start[b + 1] - first);
+    }
+}
+
+/// Scratch layout of a partitioned scatter over num_els src elements
+static size_t scatter_partition_bytes(size_t num_els, size_t *pairs_bytes) {
+    // slots, valid and bucket_start share the last block
+    const size_t counters =
+        SCATTER_MAX_CHUNKS * (SCATTER_MAX_BUCKETS + 1) + SCATTER_MAX_BUCKETS + 1;
+    *pairs_bytes = hodu_cpu_workspace_block_size(num_els * sizeof(scatter_pair_t));
+    return 2 * *pairs_bytes + hodu_cpu_workspace_block_size(counters * sizeof(size_t));
+}
+
+/// Copy input to output, then combine every src element into it with reduce
+static void scatter_reduce_run(const void *input, const int32_t *indices, const void *src,
+                               void *output, const size_t *metadata, size_t elem_size,
+                               scatter_reduce_fn_t reduce) {
+    const size_t num_els = metadata[0];
+    const size_t num_dims = metadata[1];
+    const size_t *input_shape = metadata + 2;
+    const size_t *input_strides = metadata + 2 + num_dims;
+    const size_t input_offset = metadata[2 + 5 * num_dims];
+    const size_t dim = metadata[2 + 5 * num_dims + 3];
+
+    indexing_copy_input((const char *)input + input_offset * elem_size, output, elem_size,
+                        num_dims, input_shape, input_strides);
+
+    if (num_dims == 0 || num_dims > SCATTER_MAX_DIMS || dim >= num_dims || num_els == 0) {
+        return;
+    }
+
+    scatter_args_t args;
+    args.indices = indices;
+    args.src = src;
+    args.output = output;
+    args.reduce = reduce;
+    args.num_els = num_els;
+    args.num_dims = num_dims;
+    args.src_shape = metadata + 2 + 2 * num_dims;
+    args.src_strides = metadata + 2 + 3 * num_dims;
+    args.indices_strides = metadata + 2 + 4 * num_dims;
+    args.src_offset = metadata[2 + 5 * num_dims + 1];
+    args.indices_offset = metadata[2 + 5 * num_dims + 2];
+    args.limit = input_shape[dim];
+    size_t stride = 1;
+    for (size_t d = num_dims; d-- > 0;) {
+        args.out_strides[d] = d == dim ? 0 : stride;
+        if (d == dim) {
+            args.out_dim_stride = stride;
+        }
+        stride *= input_shape[d];
+    }
+    args.out_total = stride;
+    if (args.out_total == 0) {
+        return;
+    }
+
+    size_t pairs_bytes = 0;
+    char *scratch = NULL;
+    if (num_els >= 2 * SCATTER_CHUNK_MIN && get_num_threads() > 1) {
+        scratch = (char *)workspace_acquire(scatter_partition_bytes(num_els, &pairs_bytes));
+    }
+
+    if (!scratch) {
+        // Serial: resolve and reduce in small blocks of pairs
+        scatter_pair_t pairs[SCATTER_BLOCK];
+        for (size_t first = 0; first < num_els; first += SCATTER_BLOCK) {
+            const size_t n =
+                scatter_resolve(&args, first, MINIMUM(SCATTER_BLOCK, num_els - first), pairs);
+            reduce(output, src, pairs, n);
+        }
+        return;
+    }
+
+    args.resolved = (scatter_pair_t *)scratch;
+    args.sorted = (scatter_pair_t *)(scratch + pairs_bytes);
+    args.slots = (size_t *)(scratch + 2 * pairs_bytes);
+    args.valid = args.slots + SCATTER_MAX_CHUNKS * SCATTER_MAX_BUCKETS;
+    args.bucket_start = args.valid + SCATTER_MAX_CHUNKS;
+
+    args.num_chunks = MINIMUM(SCATTER_MAX_CHUNKS, num_els / SCATTER_CHUNK_MIN);
+    args.chunk = (num_els + args.num_chunks - 1) / args.num_chunks;
+    args.num_chunks = (num_els + args.chunk - 1) / args.chunk;
+    args.shift = 0;
+    while (((args.out_total - 1) >> args.shift) >= SCATTER_MAX_BUCKETS) {
+        args.shift++;
+    }
+    args.num_buckets = ((args.out_total - 1) >> args.shift) + 1;
+
+    parallel_for(0, args.num_chunks, 1, scatter_count_worker, &args);
+
+    // Bucket-major prefix sum: chunk c writes bucket b after chunks 0..c-1
+    size_t pos = 0;
+    for (size_t b = 0; b < args.num_buckets; b++) {
+        args.bucket_start[b] = pos;
+        for (size_t c = 0; c < args.num_chunks; c++) {
+            size_t *slot = args.slots + c * args.num_buckets + b;
+            const size_t count = *slot;
+            *slot = pos;
+            pos += count;
+        }
+    }
+    args.bucket_start[args.num_buckets] = pos;
+
+    parallel_for(0, args.num_chunks, 1, scatter_partition_worker, &args);
+    parallel_for(0, args.num_buckets, 1, scatter_bucket_worker, &args);
+
+    workspace_release(scratch);
+}
+
+size_t hodu_cpu_scatter_workspace_size(const size_t *metadata) {
+    size_t pairs_bytes;
+    return scatter_partition_bytes(metadata[0], &pairs_bytes) + HODU_CPU_WORKSPACE_ALIGN;
+}
+
+/**
+ * @brief Macro to implement the segment kernel of one scatter mode and type
+ *
+ * @param TYPE C type of the elements
+ * @param NAME Kernel suffix (scatter_reduce_NAME)
+ * @param COMBINE Statement updating `*out` with `val`
+ */
+#define IMPL_SCATTER_REDUCE(TYPE, NAME, COMBINE)                                                   \
+    static void scatter_reduce_##NAME(void *output_ptr, const void *src_ptr,                       \
+                                      const scatter_pair_t *pairs, size_t n) {                     \
+        TYPE *output = (TYPE *)output_ptr;                                                         \
+        const TYPE *src = (const TYPE *)src_ptr;                                                   \
+        for (size_t k = 0; k < n; k++) {                                                           \
+            TYPE *out = output + pairs[k].dst;                                                     \
+            const TYPE val = src[pairs[k].src];                                                    \
+            COMBINE;                                                                               \
+        }                                                                                          \
+    }
+
 // ============================================================================
 // SCATTER OPERATIONS
 // ============================================================================
@@ -325,95 +988,22 @@ GATHER_OP(uint64_t, gather_u64)
 // Algorithm:
 // First copy input to output. Then for each src element, lookup the target
 // index from indices tensor and write src value to the computed output position.
+// Runs on the scatter reduce engine: when several src elements hit the same
+// position, the last one in src order wins, as in a serial loop.
 
 /// Macro to implement scatter operation (overwrite mode)
 ///
 /// @param TYPENAME C type for the operation
 /// @param FN_NAME Function name
 #define SCATTER_OP(TYPENAME, FN_NAME)                                                              \
+    IMPL_SCATTER_REDUCE(TYPENAME, FN_NAME, *out = val)                                             \
     void hodu_cpu_##FN_NAME(const void *input_ptr, const int32_t *indices, const void *src_ptr,    \
                             void *output_ptr, const size_t *metadata) {                            \
-        const TYPENAME *input = (const TYPENAME *)input_ptr;                                       \
-        const TYPENAME *src = (const TYPENAME *)src_ptr;                                           \
-        TYPENAME *output = (TYPENAME *)output_ptr;                                                 \
-                                                                                                   \
-        const size_t num_els = metadata[0];                                                        \
-        const size_t num_dims = metadata[1];                                                       \
-        const size_t *input_shape = metadata + 2;                                                  \
-        const size_t *input_strides = metadata + 2 + num_dims;                                     \
-        const size_t *src_shape = metadata + 2 + 2 * num_dims;                                     \
-        const size_t *src_strides = metadata + 2 + 3 * num_dims;                                   \
-        const size_t *indices_strides = metadata + 2 + 4 * num_dims;                               \
-        const size_t input_offset = metadata[2 + 5 * num_dims];                                    \
-        const size_t src_offset = metadata[2 + 5 * num_dims + 1];                                  \
-        const size_t indices_offset = metadata[2 + 5 * num_dims + 2];                              \
-        const size_t dim = metadata[2 + 5 * num_dims + 3];                                         \
-                                                                                                   \
-        size_t input_total_els = 1;                                                                \
-        for (size_t i = 0; i < num_dims; i++) {                                                    \
-            input_total_els *= input_shape[i];                                                     \
-        }                                                                                          \
-        for (size_t i = 0; i < input_total_els; i++) {                                             \
-            size_t flat_idx = input_offset;                                                        \
-            size_t temp = i;                                                                       \
-            for (int d = (int)num_dims - 1; d >= 0; d--) {                                         \
-                size_t idx_in_dim = temp % input_shape[d];                                         \
-                temp /= input_shape[d];                                                            \
-                flat_idx += idx_in_dim * input_strides[d];                                         \
-            }                                                                                      \
-            output[i] = input[flat_idx];                                                           \
-        }                                                                                          \
-                                                                                                   \
-        for (size_t id = 0; id < num_els; id++) {                                                  \
-            size_t indices_flat_idx = indices_offset;                                              \
-            size_t temp = id;                                                                      \
-            for (int d = (int)num_dims - 1; d >= 0; d--) {                                         \
-                size_t src_idx = temp % src_shape[d];                                              \
-                temp /= src_shape[d];                                                              \
-                indices_flat_idx += src_idx * indices_strides[d];                                  \
-            }                                                                                      \
-                                                                                                   \
-            int32_t target_idx = indices[indices_flat_idx];                                        \
-                                                                                                   \
-            if (target_idx < 0) {                                                                  \
-                target_idx += (int32_t)input_shape[dim];                                           \
-            }                                                                                      \
-                                                                                                   \
-            if (target_idx < 0 || (size_t)target_idx >= input_shape[dim]) {                        \
-                continue;                                                                          \
-            }                                                                                      \
-                                                                                                   \
-            size_t multi_idx[32];                                                                  \
-            temp = id;                                                                             \
-            for (int d = (int)num_dims - 1; d >= 0; d--) {                                         \
-                multi_idx[d] = temp % src_shape[d];                                                \
-                temp /= src_shape[d];                                                              \
-            }                                                                                      \
-            multi_idx[dim] = (size_t)target_idx;                                                   \
-                                                                                                   \
-            size_t output_flat_idx = 0;                                                            \
-            for (size_t d = 0; d < num_dims; d++) {                                                \
-                size_t stride = 1;                                                                 \
-                for (size_t dd = d + 1; dd < num_dims; dd++) {                                     \
-                    stride *= input_shape[dd];                                                     \
-                }                                                                                  \
-                output_flat_idx += multi_idx[d] * stride;                                          \
-            }                                                                                      \
-                                                                                                   \
-            if (output_flat_idx >= input_total_els) {                                              \
-                continue;                                                                          \
-            }                                                                                      \
-                                                                                                   \
-            size_t src_flat_idx = src_offset;                                                      \
-            temp = id;                                                                             \
-            for (int d = (int)num_dims - 1; d >= 0; d--) {                                         \
-                size_t src_idx = temp % src_shape[d];                                              \
-                temp /= src_shape[d];                                                              \
-                src_flat_idx += src_idx * src_strides[d];                                          \
-            }                                                                                      \
-                                                                                                   \
-            output[output_flat_idx] = src[src_flat_idx];                                           \
-        }                                                                                          \
+        HODU_PROFILE_KERNEL(2 * hodu_cpu_profile_numel(metadata +                                  \
+                            2, metadata[1]) * sizeof(TYPENAME) + metadata[0] * (sizeof(TYPENAME) + \
+                            sizeof(int32_t)));                                                     \
+        scatter_reduce_run(input_ptr, indices, src_ptr, output_ptr, metadata, sizeof(TYPENAME),    \
+                           scatter_reduce_##FN_NAME);                                              \
     }
 
 SCATTER_OP(bool, scatter_bool)
@@ -444,180 +1034,29 @@ SCATTER_OP(uint64_t, scatter_u64)
 // Useful when multiple src elements map to the same output position.
 
 /// Macro to implement scatter_add operation (accumulation mode)
-///
-/// @param TYPENAME C type for the operation
-/// @param FN_NAME Function name
-#define SCATTER_ADD_OP(TYPENAME, FN_NAME)                                                          \
-    void hodu_cpu_##FN_NAME(const void *input_ptr, const int32_t *indices, const void *src_ptr,    \
-                            void *output_ptr, const size_t *metadata) {                            \
-        const TYPENAME *input = (const TYPENAME *)input_ptr;                                       \
-        const TYPENAME *src = (const TYPENAME *)src_ptr;                                           \
-        TYPENAME *output = (TYPENAME *)output_ptr;                                                 \
-                                                                                                   \
-        const size_t num_els = metadata[0];                                                        \
-        const size_t num_dims = metadata[1];                                                       \
-        const size_t *input_shape = metadata + 2;                                                  \
-        const size_t *input_strides = metadata + 2 + num_dims;                                     \
-        const size_t *src_shape = metadata + 2 + 2 * num_dims;                                     \
-        const size_t *src_strides = metadata + 2 + 3 * num_dims;                                   \
-        const size_t *indices_strides = metadata + 2 + 4 * num_dims;                               \
-        const size_t input_offset = metadata[2 + 5 * num_dims];                                    \
-        const size_t src_offset = metadata[2 + 5 * num_dims + 1];                                  \
-        const size_t indices_offset = metadata[2 + 5 * num_dims + 2];                              \
-        const size_t dim = metadata[2 + 5 * num_dims + 3];                                         \
-                                                                                                   \
-        size_t input_total_els = 1;                                                                \
-        for (size_t i = 0; i < num_dims; i++) {                                                    \
-            input_total_els *= input_shape[i];                                                     \
-        }                                                                                          \
-        for (size_t i = 0; i < input_total_els; i++) {                                             \
-            size_t flat_idx = input_offset;                                                        \
-            size_t temp = i;                                                                       \
-            for (int d = (int)num_dims - 1; d >= 0; d--) {                                         \
-                size_t idx_in_dim = temp % input_shape[d];                                         \
-                temp /= input_shape[d];                                                            \
-                flat_idx += idx_in_dim * input_strides[d];                                         \
-            }                                                                                      \
-            output[i] = input[flat_idx];                                                           \
-        }                                                                                          \
-                                                                                                   \
-        for (size_t id = 0; id < num_els; id++) {                                                  \
-            size_t indices_flat_idx = indices_offset;                                              \
-            size_t temp = id;                                                                      \
-            for (int d = (int)num_dims - 1; d >= 0; d--) {                                         \
-                size_t src_idx = temp % src_shape[d];                                              \
-                temp /= src_shape[d];                                                              \
-                indices_flat_idx += src_idx * indices_strides[d];                                  \
-            }                                                                                      \
-                                                                                                   \
-            int32_t target_idx = indices[indices_flat_idx];                                        \
-                                                                                                   \
-            if (target_idx < 0) {                                                                  \
-                target_idx += (int32_t)input_shape[dim];                                           \
-            }                                                                                      \
-                                                                                                   \
-            if (target_idx < 0 || (size_t)target_idx >= input_shape[dim]) {                        \
-                continue;                                                                          \
-            }                                                                                      \
-                                                                                                   \
-            size_t multi_idx[32];                                                                  \
-            temp = id;                                                                             \
-            for (int d = (int)num_dims - 1; d >= 0; d--) {                                         \
-                multi_idx[d] = temp % src_shape[d];                                                \
-                temp /= src_shape[d];                                                              \
-            }                                                                                      \
-            multi_idx[dim] = (size_t)target_idx;                                                   \
-                                                                                                   \
-            size_t output_flat_idx = 0;                                                            \
-            for (size_t d = 0; d < num_dims; d++) {                                                \
-                size_t stride = 1;                                                                 \
-                for (size_t dd = d + 1; dd < num_dims; dd++) {                                     \
-                    stride *= input_shape[dd];                                                     \
-                }                                                                                  \
-                output_flat_idx += multi_idx[d] * stride;                                          \
-            }                                                                                      \
-                                                                                                   \
-            if (output_flat_idx >= input_total_els) {                                              \
-                continue;                                                                          \
-            }                                                                                      \
-                                                                                                   \
-            size_t src_flat_idx = src_offset;                                                      \
-            temp = id;                                                                             \
-            for (int d = (int)num_dims - 1; d >= 0; d--) {                                         \
-                size_t src_idx = temp % src_shape[d];                                              \
-                temp /= src_shape[d];                                                              \
-                src_flat_idx += src_idx * src_strides[d];                                          \
-            }                                                                                      \
-                                                                                                   \
-            output[output_flat_idx] += src[src_flat_idx];                                          \
-        }                                                                                          \
-    }
-
-// Exotic floating-point scatter_add (uses proper float arithmetic)
-#define SCATTER_ADD_OP_EXOTIC(TYPE, FN_NAME, ADD_FN)                                               \
-    void hodu_cpu_##FN_NAME(const void *input_ptr, const int32_t *indices, const void *src_ptr,    \
-                            void *output_ptr, const size_t *metadata) {                            \
-        const TYPE *input = (const TYPE *)input_ptr;                                               \
-        const TYPE *src = (const TYPE *)src_ptr;                                                   \
-        TYPE *output = (TYPE *)output_ptr;                                                         \
-                                                                                                   \
-        const size_t num_els = metadata[0];                                                        \
-        const size_t num_dims = metadata[1];                                                       \
-        const size_t *input_shape = metadata + 2;                                                  \
-        const size_t *input_strides = metadata + 2 + num_dims;                                     \
-        const size_t *src_shape = metadata + 2 + 2 * num_dims;                                     \
-        const size_t *src_strides = metadata + 2 + 3 * num_dims;                                   \
-        const size_t *indices_strides = metadata + 2 + 4 * num_dims;                               \
-        const size_t input_offset = metadata[2 + 5 * num_dims];                                    \
-        const size_t src_offset = metadata[2 + 5 * num_dims + 1];                                  \
-        const size_t indices_offset = metadata[2 + 5 * num_dims + 2];                              \
-        const size_t dim = metadata[2 + 5 * num_dims + 3];                                         \
-                                                                                                   \
-        size_t input_total_els = 1;                                                                \
-        for (size_t i = 0; i < num_dims; i++) {                                                    \
-            input_total_els *= input_shape[i];                                                     \
-        }                                                                                          \
-        for (size_t i = 0; i < input_total_els; i++) {                                             \
-            size_t flat_idx = input_offset;                                                        \
-            size_t temp = i;                                                                       \
-            for (int d = (int)num_dims - 1; d >= 0; d--) {                                         \
-                size_t idx_in_dim = temp % input_shape[d];                                         \
-                temp /= input_shape[d];                                                            \
-                flat_idx += idx_in_dim * input_strides[d];                                         \
-            }                                                                                      \
-            output[i] = input[flat_idx];                                                           \
-        }                                                                                          \
-                                                                                                   \
-        for (size_t id = 0; id < num_els; id++) {                                                  \
-            size_t indices_flat_idx = indices_offset;                                              \
-            size_t temp = id;                                                                      \
-            for (int d = (int)num_dims - 1; d >= 0; d--) {                                         \
-                size_t src_idx = temp % src_shape[d];                                              \
-                temp /= src_shape[d];                                                              \
-                indices_flat_idx += src_idx * indices_strides[d];                                  \
-            }                                                                                      \
-                                                                                                   \
-            int32_t target_idx = indices[indices_flat_idx];                                        \
-                                                                                                   \
-            if (target_idx < 0) {                                                                  \
-                target_idx += (int32_t)input_shape[dim];                                           \
-            }                                                                                      \
-                                                                                                   \
-            if (target_idx < 0 || (size_t)target_idx >= input_shape[dim]) {                        \
-                continue;                                                                          \
-            }                                                                                      \
-                                                                                                   \
-            size_t multi_idx[32];                                                                  \
-            temp = id;                                                                             \
-            for (int d = (int)num_dims - 1; d >= 0; d--) {                                         \
-                multi_idx[d] = temp % src_shape[d];                                                \
-                temp /= src_shape[d];                                                              \
-            }                                                                                      \
-            multi_idx[dim] = (size_t)target_idx;                                                   \
-                                                                                                   \
-            size_t output_flat_idx = 0;                                                            \
-            for (size_t d = 0; d < num_dims; d++) {                                                \
-                size_t stride = 1;                                                                 \
-                for (size_t dd = d + 1; dd < num_dims; dd++) {                                     \
-                    stride *= input_shape[dd];                                                     \
-                }                                                                                  \
-                output_flat_idx += multi_idx[d] * stride;                                          \
-            }                                                                                      \
-                                                                                                   \
-            if (output_flat_idx >= input_total_els) {                                              \
-                continue;                                                                          \
-            }                                                                                      \
-                                                                                                   \
-            size_t src_flat_idx = src_offset;                                                      \
-            temp = id;                                                                             \
-            for (int d = (int)num_dims - 1; d >= 0; d--) {                                         \
-                size_t src_idx = temp % src_shape[d];                                              \
-                temp /= src_shape[d];                                                              \
-                src_flat_idx += src_idx * src_strides[d];                                          \
-            }                                                                                      \
-                                                                                                   \
-            output[output_flat_idx] = ADD_FN(output[output_flat_idx], src[src_flat_idx]);          \
-        }                                                                                          \
+///
+/// @param TYPENAME C type for the operation
+/// @param FN_NAME Function name
+#define SCATTER_ADD_OP(TYPENAME, FN_NAME)                                                          \
+    IMPL_SCATTER_REDUCE(TYPENAME, FN_NAME, *out += val)                                            \
+    void hodu_cpu_##FN_NAME(const void *input_ptr, const int32_t *indices, const void *src_ptr,    \
+                            void *output_ptr, const size_t *metadata) {                            \
+        HODU_PROFILE_KERNEL(2 * hodu_cpu_profile_numel(metadata +                                  \
+                            2, metadata[1]) * sizeof(TYPENAME) + metadata[0] * (sizeof(TYPENAME) + \
+                            sizeof(int32_t)));                                                     \
+        scatter_reduce_run(input_ptr, indices, src_ptr, output_ptr, metadata, sizeof(TYPENAME),    \
+                           scatter_reduce_##FN_NAME);                                              \
+    }
+
+// Exotic floating-point scatter_add (uses proper float arithmetic)
+#define SCATTER_ADD_OP_EXOTIC(TYPE, FN_NAME, ADD_FN)                                               \
+    IMPL_SCATTER_REDUCE(TYPE, FN_NAME, *out = ADD_FN(*out, val))                                   \
+    void hodu_cpu_##FN_NAME(const void *input_ptr, const int32_t *indices, const void *src_ptr,    \
+                            void *output_ptr, const size_t *metadata) {                            \
+        HODU_PROFILE_KERNEL(2 * hodu_cpu_profile_numel(metadata + 2, metadata[1]) * sizeof(TYPE) + \
+                            metadata[0] * (sizeof(TYPE) + sizeof(int32_t)));                       \
+        scatter_reduce_run(input_ptr, indices, src_ptr, output_ptr, metadata, sizeof(TYPE),        \
+                           scatter_reduce_##FN_NAME);                                              \
     }
 
 SCATTER_ADD_OP_EXOTIC(f8e4m3_t, scatter_add_f8e4m3, f8e4m3_add)
@@ -649,92 +1088,14 @@ SCATTER_ADD_OP(uint64_t, scatter_add_u64)
 /// @param TYPENAME C type for the operation
 /// @param FN_NAME Function name
 #define SCATTER_MAX_OP(TYPENAME, FN_NAME)                                                          \
+    IMPL_SCATTER_REDUCE(TYPENAME, FN_NAME, if (val > *out) *out = val)                             \
     void hodu_cpu_##FN_NAME(const void *input_ptr, const int32_t *indices, const void *src_ptr,    \
                             void *output_ptr, const size_t *metadata) {                            \
-        const TYPENAME *input = (const TYPENAME *)input_ptr;                                       \
-        const TYPENAME *src = (const TYPENAME *)src_ptr;                                           \
-        TYPENAME *output = (TYPENAME *)output_ptr;                                                 \
-                                                                                                   \
-        const size_t num_els = metadata[0];                                                        \
-        const size_t num_dims = metadata[1];                                                       \
-        const size_t *input_shape = metadata + 2;                                                  \
-        const size_t *input_strides = metadata + 2 + num_dims;                                     \
-        const size_t *src_shape = metadata + 2 + 2 * num_dims;                                     \
-        const size_t *src_strides = metadata + 2 + 3 * num_dims;                                   \
-        const size_t *indices_strides = metadata + 2 + 4 * num_dims;                               \
-        const size_t input_offset = metadata[2 + 5 * num_dims];                                    \
-        const size_t src_offset = metadata[2 + 5 * num_dims + 1];                                  \
-        const size_t indices_offset = metadata[2 + 5 * num_dims + 2];                              \
-        const size_t dim = metadata[2 + 5 * num_dims + 3];                                         \
-                                                                                                   \
-        size_t input_total_els = 1;                                                                \
-        for (size_t i = 0; i < num_dims; i++) {                                                    \
-            input_total_els *= input_shape[i];                                                     \
-        }                                                                                          \
-        for (size_t i = 0; i < input_total_els; i++) {                                             \
-            size_t flat_idx = input_offset;                                                        \
-            size_t temp = i;                                                                       \
-            for (int d = (int)num_dims - 1; d >= 0; d--) {                                         \
-                size_t idx_in_dim = temp % input_shape[d];                                         \
-                temp /= input_shape[d];                                                            \
-                flat_idx += idx_in_dim * input_strides[d];                                         \
-            }                                                                                      \
-            output[i] = input[flat_idx];                                                           \
-        }                                                                                          \
-                                                                                                   \
-        for (size_t id = 0; id < num_els; id++) {                                                  \
-            size_t indices_flat_idx = indices_offset;                                              \
-            size_t temp = id;                                                                      \
-            for (int d = (int)num_dims - 1; d >= 0; d--) {                                         \
-                size_t src_idx = temp % src_shape[d];                                              \
-                temp /= src_shape[d];                                                              \
-                indices_flat_idx += src_idx * indices_strides[d];                                  \
-            }                                                                                      \
-                                                                                                   \
-            int32_t target_idx = indices[indices_flat_idx];                                        \
-                                                                                                   \
-            if (target_idx < 0) {                                                                  \
-                target_idx += (int32_t)input_shape[dim];                                           \
-            }                                                                                      \
-                                                                                                   \
-            if (target_idx < 0 || (size_t)target_idx >= input_shape[dim]) {                        \
-                continue;                                                                          \
-            }                                                                                      \
-                                                                                                   \
-            size_t multi_idx[32];                                                                  \
-            temp = id;                                                                             \
-            for (int d = (int)num_dims - 1; d >= 0; d--) {                                         \
-                multi_idx[d] = temp % src_shape[d];                                                \
-                temp /= src_shape[d];                                                              \
-            }                                                                                      \
-            multi_idx[dim] = (size_t)target_idx;                                                   \
-                                                                                                   \
-            size_t output_flat_idx = 0;                                                            \
-            for (size_t d = 0; d < num_dims; d++) {                                                \
-                size_t stride = 1;                                                                 \
-                for (size_t dd = d + 1; dd < num_dims; dd++) {                                     \
-                    stride *= input_shape[dd];                                                     \
-                }                                                                                  \
-                output_flat_idx += multi_idx[d] * stride;                                          \
-            }                                                                                      \
-                                                                                                   \
-            if (output_flat_idx >= input_total_els) {                                              \
-                continue;                                                                          \
-            }                                                                                      \
-                                                                                                   \
-            size_t src_flat_idx = src_offset;                                                      \
-            temp = id;                                                                             \
-            for (int d = (int)num_dims - 1; d >= 0; d--) {                                         \
-                size_t src_idx = temp % src_shape[d];                                              \
-                temp /= src_shape[d];                                                              \
-                src_flat_idx += src_idx * src_strides[d];                                          \
-            }                                                                                      \
-                                                                                                   \
-            TYPENAME src_val = src[src_flat_idx];                                                  \
-            if (src_val > output[output_flat_idx]) {                                               \
-                output[output_flat_idx] = src_val;                                                 \
-            }                                                                                      \
-        }                                                                                          \
+        HODU_PROFILE_KERNEL(2 * hodu_cpu_profile_numel(metadata +                                  \
+                            2, metadata[1]) * sizeof(TYPENAME) + metadata[0] * (sizeof(TYPENAME) + \
+                            sizeof(int32_t)));                                                     \
+        scatter_reduce_run(input_ptr, indices, src_ptr, output_ptr, metadata, sizeof(TYPENAME),    \
+                           scatter_reduce_##FN_NAME);                                              \
     }
 
 SCATTER_MAX_OP(f8e4m3_t, scatter_max_f8e4m3)
@@ -766,92 +1127,14 @@ SCATTER_MAX_OP(uint64_t, scatter_max_u64)
 /// @param TYPENAME C type for the operation
 /// @param FN_NAME Function name
 #define SCATTER_MIN_OP(TYPENAME, FN_NAME)                                                          \
+    IMPL_SCATTER_REDUCE(TYPENAME, FN_NAME, if (val < *out) *out = val)                             \
     void hodu_cpu_##FN_NAME(const void *input_ptr, const int32_t *indices, const void *src_ptr,    \
                             void *output_ptr, const size_t *metadata) {                            \
-        const TYPENAME *input = (const TYPENAME *)input_ptr;                                       \
-        const TYPENAME *src = (const TYPENAME *)src_ptr;                                           \
-        TYPENAME *output = (TYPENAME *)output_ptr;                                                 \
-                                                                                                   \
-        const size_t num_els = metadata[0];                                                        \
-        const size_t num_dims = metadata[1];                                                       \
-        const size_t *input_shape = metadata + 2;                                                  \
-        const size_t *input_strides = metadata + 2 + num_dims;                                     \
-        const size_t *src_shape = metadata + 2 + 2 * num_dims;                                     \
-        const size_t *src_strides = metadata + 2 + 3 * num_dims;                                   \
-        const size_t *indices_strides = metadata + 2 + 4 * num_dims;                               \
-        const size_t input_offset = metadata[2 + 5 * num_dims];                                    \
-        const size_t src_offset = metadata[2 + 5 * num_dims + 1];                                  \
-        const size_t indices_offset = metadata[2 + 5 * num_dims + 2];                              \
-        const size_t dim = metadata[2 + 5 * num_dims + 3];                                         \
-                                                                                                   \
-        size_t input_total_els = 1;                                                                \
-        for (size_t i = 0; i < num_dims; i++) {                                                    \
-            input_total_els *= input_shape[i];                                                     \
-        }                                                                                          \
-        for (size_t i = 0; i < input_total_els; i++) {                                             \
-            size_t flat_idx = input_offset;                                                        \
-            size_t temp = i;                                                                       \
-            for (int d = (int)num_dims - 1; d >= 0; d--) {                                         \
-                size_t idx_in_dim = temp % input_shape[d];                                         \
-                temp /= input_shape[d];                                                            \
-                flat_idx += idx_in_dim * input_strides[d];                                         \
-            }                                                                                      \
-            output[i] = input[flat_idx];                                                           \
-        }                                                                                          \
-                                                                                                   \
-        for (size_t id = 0; id < num_els; id++) {                                                  \
-            size_t indices_flat_idx = indices_offset;                                              \
-            size_t temp = id;                                                                      \
-            for (int d = (int)num_dims - 1; d >= 0; d--) {                                         \
-                size_t src_idx = temp % src_shape[d];                                              \
-                temp /= src_shape[d];                                                              \
-                indices_flat_idx += src_idx * indices_strides[d];                                  \
-            }                                                                                      \
-                                                                                                   \
-            int32_t target_idx = indices[indices_flat_idx];                                        \
-                                                                                                   \
-            if (target_idx < 0) {                                                                  \
-                target_idx += (int32_t)input_shape[dim];                                           \
-            }                                                                                      \
-                                                                                                   \
-            if (target_idx < 0 || (size_t)target_idx >= input_shape[dim]) {                        \
-                continue;                                                                          \
-            }                                                                                      \
-                                                                                                   \
-            size_t multi_idx[32];                                                                  \
-            temp = id;                                                                             \
-            for (int d = (int)num_dims - 1; d >= 0; d--) {                                         \
-                multi_idx[d] = temp % src_shape[d];                                                \
-                temp /= src_shape[d];                                                              \
-            }                                                                                      \
-            multi_idx[dim] = (size_t)target_idx;                                                   \
-                                                                                                   \
-            size_t output_flat_idx = 0;                                                            \
-            for (size_t d = 0; d < num_dims; d++) {                                                \
-                size_t stride = 1;                                                                 \
-                for (size_t dd = d + 1; dd < num_dims; dd++) {                                     \
-                    stride *= input_shape[dd];                                                     \
-                }                                                                                  \
-                output_flat_idx += multi_idx[d] * stride;                                          \
-            }                                                                                      \
-                                                                                                   \
-            if (output_flat_idx >= input_total_els) {                                              \
-                continue;                                                                          \
-            }                                                                                      \
-                                                                                                   \
-            size_t src_flat_idx = src_offset;                                                      \
-            temp = id;                                                                             \
-            for (int d = (int)num_dims - 1; d >= 0; d--) {                                         \
-                size_t src_idx = temp % src_shape[d];                                              \
-                temp /= src_shape[d];                                                              \
-                src_flat_idx += src_idx * src_strides[d];                                          \
-            }                                                                                      \
-                                                                                                   \
-            TYPENAME src_val = src[src_flat_idx];                                                  \
-            if (src_val < output[output_flat_idx]) {                                               \
-                output[output_flat_idx] = src_val;                                                 \
-            }                                                                                      \
-        }                                                                                          \
+        HODU_PROFILE_KERNEL(2 * hodu_cpu_profile_numel(metadata +                                  \
+                            2, metadata[1]) * sizeof(TYPENAME) + metadata[0] * (sizeof(TYPENAME) + \
+                            sizeof(int32_t)));                                                     \
+        scatter_reduce_run(input_ptr, indices, src_ptr, output_ptr, metadata, sizeof(TYPENAME),    \
+                           scatter_reduce_##FN_NAME);                                              \
     }
 
 SCATTER_MIN_OP(f8e4m3_t, scatter_min_f8e4m3)
@@ -894,6 +1177,7 @@ SCATTER_MIN_OP(uint64_t, scatter_min_u64)
 /// @param ZERO_VALUE The value representing "0" for this type
 #define ONEHOT_OP(OUT_TYPENAME, FN_NAME, ONE_VALUE, ZERO_VALUE)                                    \
     void hodu_cpu_##FN_NAME(const int32_t *indices, void *output_ptr, const size_t *metadata) {    \
+        HODU_PROFILE_KERNEL(metadata[1] * sizeof(int32_t) + metadata[0] * sizeof(OUT_TYPENAME));   \
         OUT_TYPENAME *output = (OUT_TYPENAME *)output_ptr;                                         \
                                                                                                    \
         const size_t num_els = metadata[0];                                                        \
@@ -979,6 +1263,78 @@ ONEHOT_OP(uint16_t, onehot_u16, 1, 0)
 ONEHOT_OP(uint32_t, onehot_u32, 1, 0)
 ONEHOT_OP(uint64_t, onehot_u64, 1, 0)
 
+// ============================================================================
+// STREAM COMPACTION
+// ============================================================================
+//
+// nonzero and compress write a data-dependent number of outputs. Large inputs
+// are split into chunks that count their outputs in parallel; an exclusive
+// prefix sum over the chunk counts gives every chunk its first output slot, and
+// the chunks then write their outputs in parallel. Output order is the serial
+// order for any thread count.
+
+// Upper bound on compaction chunks, and minimum inputs per chunk
+#define COMPACT_MAX_CHUNKS 256
+#define COMPACT_CHUNK_MIN ((size_t)1 << 14)
+
+/// Number of outputs produced by inputs [start, end)
+typedef size_t (*compact_count_fn_t)(const void *ctx, size_t start, size_t end);
+
+/// Write the outputs of inputs [start, end) from output slot out_pos; returns how many
+typedef size_t (*compact_fill_fn_t)(const void *ctx, size_t start, size_t end, size_t out_pos);
+
+typedef struct {
+    const void *ctx;
+    compact_count_fn_t count;
+    compact_fill_fn_t fill;
+    size_t n;
+    size_t chunk;
+    size_t pos[COMPACT_MAX_CHUNKS]; // chunk counts, then first output slots
+} compact_args_t;
+
+static void compact_count_worker(size_t start, size_t end, void *ctx) {
+    compact_args_t *a = (compact_args_t *)ctx;
+    for (size_t c = start; c < end; c++) {
+        a->pos[c] = a->count(a->ctx, c * a->chunk, MINIMUM(a->n, (c + 1) * a->chunk));
+    }
+}
+
+static void compact_fill_worker(size_t start, size_t end, void *ctx) {
+    const compact_args_t *a = (const compact_args_t *)ctx;
+    for (size_t c = start; c < end; c++) {
+        a->fill(a->ctx, c * a->chunk, MINIMUM(a->n, (c + 1) * a->chunk), a->pos[c]);
+    }
+}
+
+/// Count the outputs of n inputs and, when fill is non-NULL, write them; returns the count
+static size_t compact_run(const void *ctx, size_t n, compact_count_fn_t count,
+                          compact_fill_fn_t fill) {
+    if (n < 2 * COMPACT_CHUNK_MIN || get_num_threads() <= 1) {
+        return fill ? fill(ctx, 0, n, 0) : count(ctx, 0, n);
+    }
+
+    compact_args_t args;
+    args.ctx = ctx;
+    args.count = count;
+    args.fill = fill;
+    args.n = n;
+    const size_t chunks = MINIMUM(COMPACT_MAX_CHUNKS, n / COMPACT_CHUNK_MIN);
+    args.chunk = (n + chunks - 1) / chunks;
+    const size_t num_chunks = (n + args.chunk - 1) / args.chunk;
+
+    parallel_for(0, num_chunks, 1, compact_count_worker, &args);
+    size_t total = 0;
+    for (size_t c = 0; c < num_chunks; c++) {
+        const size_t chunk_count = args.pos[c];
+        args.pos[c] = total;
+        total += chunk_count;
+    }
+    if (fill) {
+        parallel_for(0, num_chunks, 1, compact_fill_worker, &args);
+    }
+    return total;
+}
+
 // ============================================================================
 // NONZERO OPERATIONS
 // ============================================================================
@@ -994,6 +1350,31 @@ ONEHOT_OP(uint64_t, onehot_u64, 1, 0)
 //
 // Output: [N, ndim] tensor where N is the count of non-zero elements.
 // Each row contains the multi-dimensional indices of a non-zero element.
+//
+// Algorithm:
+// Both passes run as a stream compaction; chunks walk their range with a
+// strided iterator, and the fill pass carries coordinates alongside it.
+
+typedef struct {
+    const void *input;
+    int32_t *output;
+    size_t num_dims;
+    const size_t *shape;
+    const size_t *strides;
+    size_t offset;
+} nonzero_ctx_t;
+
+static inline nonzero_ctx_t nonzero_ctx(const void *input, int32_t *output,
+                                        const size_t *metadata) {
+    nonzero_ctx_t ctx;
+    ctx.input = input;
+    ctx.output = output;
+    ctx.num_dims = metadata[1];
+    ctx.shape = metadata + 2;
+    ctx.strides = metadata + 2 + ctx.num_dims;
+    ctx.offset = metadata[2 + 2 * ctx.num_dims];
+    return ctx;
+}
 
 /// Macro to implement nonzero count operation (first pass)
 /// Returns the count of non-zero elements
@@ -1002,31 +1383,31 @@ ONEHOT_OP(uint64_t, onehot_u64, 1, 0)
 /// @param FN_NAME Function name
 /// @param IS_NONZERO Expression to check if value is non-zero
 #define NONZERO_COUNT_OP(TYPENAME, FN_NAME, IS_NONZERO)                                            \
-    size_t hodu_cpu_##FN_NAME(const void *input_ptr, const size_t *metadata) {                     \
-        const TYPENAME *input = (const TYPENAME *)input_ptr;                                       \
-                                                                                                   \
-        const size_t num_els = metadata[0];                                                        \
-        const size_t num_dims = metadata[1];                                                       \
-        const size_t *input_shape = metadata + 2;                                                  \
-        const size_t *input_strides = metadata + 2 + num_dims;                                     \
-        const size_t input_offset = metadata[2 + 2 * num_dims];                                    \
+    static size_t FN_NAME##_range(const void *ctx_ptr, size_t start, size_t end) {                 \
+        const nonzero_ctx_t *ctx = (const nonzero_ctx_t *)ctx_ptr;                                 \
+        const TYPENAME *input = (const TYPENAME *)ctx->input + ctx->offset;                        \
                                                                                                    \
         size_t count = 0;                                                                          \
-        for (size_t id = 0; id < num_els; id++) {                                                  \
-            /* Compute flat index from strided layout */                                           \
-            size_t flat_idx = input_offset;                                                        \
-            size_t temp = id;                                                                      \
-            for (int d = (int)num_dims - 1; d >= 0; d--) {                                         \
-                size_t idx = temp % input_shape[d];                                                \
-                temp /= input_shape[d];                                                            \
-                flat_idx += idx * input_strides[d];                                                \
-            }                                                                                      \
-            TYPENAME val = input[flat_idx];                                                        \
-            if (IS_NONZERO) {                                                                      \
-                count++;                                                                           \
-            }                                                                                      \
+        strided_iter_t it;                                                                         \
+        strided_iter_init(&it, ctx->num_dims, ctx->shape, ctx->strides, start);                    \
+        for (size_t id = start; id < end;) {                                                       \
+            const size_t row_len = MINIMUM(strided_iter_row(&it), end - id);                       \
+            const TYPENAME *row = input + it.offset;                                               \
+            const size_t row_stride = it.inner_stride;                                             \
+            for (size_t k = 0; k < row_len; k++) {                                                 \
+                TYPENAME val = row[k * row_stride];                                                \
+                count += (IS_NONZERO) ? 1 : 0;                                                     \
+            }                                                                                      \
+            strided_iter_advance(&it, row_len);                                                    \
+            id += row_len;                                                                         \
         }                                                                                          \
         return count;                                                                              \
+    }                                                                                              \
+                                                                                                   \
+    size_t hodu_cpu_##FN_NAME(const void *input_ptr, const size_t *metadata) {                     \
+        HODU_PROFILE_KERNEL(metadata[0] * sizeof(TYPENAME));                                       \
+        const nonzero_ctx_t ctx = nonzero_ctx(input_ptr, NULL, metadata);                          \
+        return compact_run(&ctx, metadata[0], FN_NAME##_range, NULL);                              \
     }
 
 /// Macro to implement nonzero fill operation (second pass)
@@ -1034,29 +1415,27 @@ ONEHOT_OP(uint64_t, onehot_u64, 1, 0)
 ///
 /// @param TYPENAME C type for the operation
 /// @param FN_NAME Function name
+/// @param COUNT_FN Range counter of the matching nonzero_count operation
 /// @param IS_NONZERO Expression to check if value is non-zero
-#define NONZERO_FILL_OP(TYPENAME, FN_NAME, IS_NONZERO)                                             \
-    void hodu_cpu_##FN_NAME(const void *input_ptr, int32_t *output, const size_t *metadata) {      \
-        const TYPENAME *input = (const TYPENAME *)input_ptr;                                       \
-                                                                                                   \
-        const size_t num_els = metadata[0];                                                        \
-        const size_t num_dims = metadata[1];                                                       \
-        const size_t *input_shape = metadata + 2;                                                  \
-        const size_t *input_strides = metadata + 2 + num_dims;                                     \
-        const size_t input_offset = metadata[2 + 2 * num_dims];                                    \
+#define NONZERO_FILL_OP(TYPENAME, FN_NAME, COUNT_FN, IS_NONZERO)                                   \
+    static size_t FN_NAME##_range(const void *ctx_ptr, size_t start, size_t end,                   \
+                                  size_t out_pos) {                                                \
+        const nonzero_ctx_t *ctx = (const nonzero_ctx_t *)ctx_ptr;                                 \
+        const TYPENAME *input = (const TYPENAME *)ctx->input + ctx->offset;                        \
+        const size_t num_dims = ctx->num_dims;                                                     \
+        int32_t *output = ctx->output + out_pos * num_dims;                                        \
                                                                                                    \
         size_t out_idx = 0;                                                                        \
-        for (size_t id = 0; id < num_els; id++) {                                                  \
-            /* Compute flat index from strided layout */                                           \
-            size_t flat_idx = input_offset;                                                        \
-            size_t temp = id;                                                                      \
-            size_t multi_idx[32];                                                                  \
-            for (int d = (int)num_dims - 1; d >= 0; d--) {                                         \
-                multi_idx[d] = temp % input_shape[d];                                              \
-                temp /= input_shape[d];                                                            \
-                flat_idx += multi_idx[d] * input_strides[d];                                       \
-            }                                                                                      \
-            TYPENAME val = input[flat_idx];                                                        \
+        size_t multi_idx[32];                                                                      \
+        size_t temp = start;                                                                       \
+        for (size_t d = num_dims; d-- > 0;) {                                                      \
+            multi_idx[d] = temp % ctx->shape[d];                                                   \
+            temp /= ctx->shape[d];                                                                 \
+        }                                                                                          \
+        strided_iter_t it;                                                                         \
+        strided_iter_init(&it, num_dims, ctx->shape, ctx->strides, start);                         \
+        for (size_t id = start; id < end; id++, strided_iter_next(&it)) {                          \
+            TYPENAME val = input[it.offset];                                                       \
             if (IS_NONZERO) {                                                                      \
                 /* Write multi-dimensional indices to output */                                    \
                 for (size_t d = 0; d < num_dims; d++) {                                            \
@@ -1064,7 +1443,21 @@ ONEHOT_OP(uint64_t, onehot_u64, 1, 0)
                 }                                                                                  \
                 out_idx++;                                                                         \
             }                                                                                      \
+            /* Carry the coordinates alongside the iterator */                                     \
+            for (size_t d = num_dims; d-- > 0;) {                                                  \
+                if (++multi_idx[d] < ctx->shape[d]) {                                              \
+                    break;                                                                         \
+                }                                                                                  \
+                multi_idx[d] = 0;                                                                  \
+            }                                                                                      \
         }                                                                                          \
+        return out_idx;                                                                            \
+    }                                                                                              \
+                                                                                                   \
+    void hodu_cpu_##FN_NAME(const void *input_ptr, int32_t *output, const size_t *metadata) {      \
+        HODU_PROFILE_KERNEL(metadata[0] * sizeof(TYPENAME));                                       \
+        const nonzero_ctx_t ctx = nonzero_ctx(input_ptr, output, metadata);                        \
+        compact_run(&ctx, metadata[0], COUNT_FN##_range, FN_NAME##_range);                         \
     }
 
 // Count operations
@@ -1085,21 +1478,21 @@ NONZERO_COUNT_OP(uint32_t, nonzero_count_u32, val != 0)
 NONZERO_COUNT_OP(uint64_t, nonzero_count_u64, val != 0)
 
 // Fill operations
-NONZERO_FILL_OP(bool, nonzero_fill_bool, val)
-NONZERO_FILL_OP(f8e4m3_t, nonzero_fill_f8e4m3, f8e4m3_to_float(val) != 0.0f)
-NONZERO_FILL_OP(f8e5m2_t, nonzero_fill_f8e5m2, f8e5m2_to_float(val) != 0.0f)
-NONZERO_FILL_OP(bf16_t, nonzero_fill_bf16, bf16_to_float(val) != 0.0f)
-NONZERO_FILL_OP(f16_t, nonzero_fill_f16, f16_to_float(val) != 0.0f)
-NONZERO_FILL_OP(float, nonzero_fill_f32, val != 0.0f)
-NONZERO_FILL_OP(double, nonzero_fill_f64, val != 0.0)
-NONZERO_FILL_OP(int8_t, nonzero_fill_i8, val != 0)
-NONZERO_FILL_OP(int16_t, nonzero_fill_i16, val != 0)
-NONZERO_FILL_OP(int32_t, nonzero_fill_i32, val != 0)
-NONZERO_FILL_OP(int64_t, nonzero_fill_i64, val != 0)
-NONZERO_FILL_OP(uint8_t, nonzero_fill_u8, val != 0)
-NONZERO_FILL_OP(uint16_t, nonzero_fill_u16, val != 0)
-NONZERO_FILL_OP(uint32_t, nonzero_fill_u32, val != 0)
-NONZERO_FILL_OP(uint64_t, nonzero_fill_u64, val != 0)
+NONZERO_FILL_OP(bool, nonzero_fill_bool, nonzero_count_bool, val)
+NONZERO_FILL_OP(f8e4m3_t, nonzero_fill_f8e4m3, nonzero_count_f8e4m3, f8e4m3_to_float(val) != 0.0f)
+NONZERO_FILL_OP(f8e5m2_t, nonzero_fill_f8e5m2, nonzero_count_f8e5m2, f8e5m2_to_float(val) != 0.0f)
+NONZERO_FILL_OP(bf16_t, nonzero_fill_bf16, nonzero_count_bf16, bf16_to_float(val) != 0.0f)
+NONZERO_FILL_OP(f16_t, nonzero_fill_f16, nonzero_count_f16, f16_to_float(val) != 0.0f)
+NONZERO_FILL_OP(float, nonzero_fill_f32, nonzero_count_f32, val != 0.0f)
+NONZERO_FILL_OP(double, nonzero_fill_f64, nonzero_count_f64, val != 0.0)
+NONZERO_FILL_OP(int8_t, nonzero_fill_i8, nonzero_count_i8, val != 0)
+NONZERO_FILL_OP(int16_t, nonzero_fill_i16, nonzero_count_i16, val != 0)
+NONZERO_FILL_OP(int32_t, nonzero_fill_i32, nonzero_count_i32, val != 0)
+NONZERO_FILL_OP(int64_t, nonzero_fill_i64, nonzero_count_i64, val != 0)
+NONZERO_FILL_OP(uint8_t, nonzero_fill_u8, nonzero_count_u8, val != 0)
+NONZERO_FILL_OP(uint16_t, nonzero_fill_u16, nonzero_count_u16, val != 0)
+NONZERO_FILL_OP(uint32_t, nonzero_fill_u32, nonzero_count_u32, val != 0)
+NONZERO_FILL_OP(uint64_t, nonzero_fill_u64, nonzero_count_u64, val != 0)
 
 // ============================================================================
 // UNIQUE OPERATIONS
@@ -1119,116 +1512,190 @@ NONZERO_FILL_OP(uint64_t, nonzero_fill_u64, val != 0)
 // - inverse: index into values for each input element [num_els]
 // - counts: count of each unique value [unique_count]
 // Returns: unique_count
+//
+// Algorithm:
+// Every element gets an order-preserving integer key (sign bit flipped for
+// signed integers, sign-magnitude flipped for floats with -0 folded into +0;
+// NaNs with the same bits are one value). Large inputs first try a hash table
+// of keys; when the distinct keys stay few, only those are sorted and the
+// inverse is remapped to their ranks. Otherwise (and for small inputs) the
+// keys are LSD radix sorted, 8 bits per pass, skipping bytes shared by every
+// key, and equal runs become the outputs.
 
-// Helper struct for sorting with original index
+// Inputs from which the hash path is tried first
+#define UNIQUE_HASH_MIN ((size_t)1 << 12)
+// Most distinct keys the hash path accepts before falling back to the sort
+#define UNIQUE_HASH_MAX_KEYS ((size_t)1 << 16)
+
+// Sort key of one element and its position (or hash id)
 typedef struct {
-    size_t orig_idx;
-    size_t sort_key; // Used for integer comparison
-} IndexPair;
-
-// Comparison function for qsort (by sort_key)
-static int compare_index_pairs(const void *a, const void *b) {
-    const IndexPair *pa = (const IndexPair *)a;
-    const IndexPair *pb = (const IndexPair *)b;
-    if (pa->sort_key < pb->sort_key)
-        return -1;
-    if (pa->sort_key > pb->sort_key)
-        return 1;
-    return 0;
+    uint64_t key;
+    size_t idx;
+} unique_item_t;
+
+/// Order-preserving key of a float; -0 and +0 share a key
+static inline uint64_t unique_f32_key(float f) {
+    if (f == 0.0f) {
+        f = 0.0f;
+    }
+    uint32_t u;
+    memcpy(&u, &f, sizeof(u));
+    return (u >> 31) ? (uint32_t)~u : (u | 0x80000000u);
 }
 
-// For float types, we need a different comparison
-typedef struct {
-    size_t orig_idx;
-    double sort_key;
-} IndexPairFloat;
-
-static int compare_index_pairs_float(const void *a, const void *b) {
-    const IndexPairFloat *pa = (const IndexPairFloat *)a;
-    const IndexPairFloat *pb = (const IndexPairFloat *)b;
-    if (pa->sort_key < pb->sort_key)
-        return -1;
-    if (pa->sort_key > pb->sort_key)
-        return 1;
-    return 0;
+/// Order-preserving key of a double; -0 and +0 share a key
+static inline uint64_t unique_f64_key(double f) {
+    if (f == 0.0) {
+        f = 0.0;
+    }
+    uint64_t u;
+    memcpy(&u, &f, sizeof(u));
+    return (u >> 63) ? ~u : (u | 0x8000000000000000ull);
 }
 
-/// Macro to implement unique operation for integer types
-#define UNIQUE_OP_INT(TYPENAME, FN_NAME)                                                           \
-    size_t hodu_cpu_##FN_NAME(const void *input_ptr, void *values_ptr, int32_t *inverse,           \
-                              int32_t *counts, const size_t *metadata) {                           \
-        const TYPENAME *input = (const TYPENAME *)input_ptr;                                       \
-        TYPENAME *values = (TYPENAME *)values_ptr;                                                 \
-                                                                                                   \
-        const size_t num_els = metadata[0];                                                        \
-        const size_t num_dims = metadata[1];                                                       \
-        const size_t *input_shape = metadata + 2;                                                  \
-        const size_t *input_strides = metadata + 2 + num_dims;                                     \
-        const size_t input_offset = metadata[2 + 2 * num_dims];                                    \
-                                                                                                   \
-        if (num_els == 0)                                                                          \
-            return 0;                                                                              \
-                                                                                                   \
-        /* Allocate temp array for sorting */                                                      \
-        IndexPair *pairs = (IndexPair *)malloc(num_els * sizeof(IndexPair));                       \
-        TYPENAME *input_values = (TYPENAME *)malloc(num_els * sizeof(TYPENAME));                   \
-                                                                                                   \
-        /* Read input values */                                                                    \
-        for (size_t id = 0; id < num_els; id++) {                                                  \
-            size_t flat_idx = input_offset;                                                        \
-            size_t temp = id;                                                                      \
-            for (int d = (int)num_dims - 1; d >= 0; d--) {                                         \
-                size_t idx = temp % input_shape[d];                                                \
-                temp /= input_shape[d];                                                            \
-                flat_idx += idx * input_strides[d];                                                \
-            }                                                                                      \
-            input_values[id] = input[flat_idx];                                                    \
-            pairs[id].orig_idx = id;                                                               \
-            pairs[id].sort_key = (size_t)input[flat_idx];                                          \
-        }                                                                                          \
-                                                                                                   \
-        /* Sort by value */                                                                        \
-        qsort(pairs, num_els, sizeof(IndexPair), compare_index_pairs);                             \
-                                                                                                   \
-        /* Build outputs */                                                                        \
-        size_t unique_count = 0;                                                                   \
-        int32_t current_count = 0;                                                                 \
-                                                                                                   \
-        for (size_t i = 0; i < num_els; i++) {                                                     \
-            size_t orig_idx = pairs[i].orig_idx;                                                   \
-            TYPENAME val = input_values[orig_idx];                                                 \
-                                                                                                   \
-            if (i == 0) {                                                                          \
-                values[unique_count] = val;                                                        \
-                current_count = 1;                                                                 \
-            } else {                                                                               \
-                size_t prev_orig_idx = pairs[i - 1].orig_idx;                                      \
-                TYPENAME prev_val = input_values[prev_orig_idx];                                   \
-                if (val != prev_val) {                                                             \
-                    counts[unique_count] = current_count;                                          \
-                    unique_count++;                                                                \
-                    values[unique_count] = val;                                                    \
-                    current_count = 1;                                                             \
-                } else {                                                                           \
-                    current_count++;                                                               \
-                }                                                                                  \
-            }                                                                                      \
-            inverse[orig_idx] = (int32_t)unique_count;                                             \
-        }                                                                                          \
-        counts[unique_count] = current_count;                                                      \
-        unique_count++;                                                                            \
-                                                                                                   \
-        free(pairs);                                                                               \
-        free(input_values);                                                                        \
-        return unique_count;                                                                       \
+/// LSD radix sort of n items by key; tmp holds n items; returns the sorted buffer
+static unique_item_t *unique_radix_sort(unique_item_t *items, unique_item_t *tmp, size_t n) {
+    size_t hist[8][256];
+    memset(hist, 0, sizeof(hist));
+    for (size_t i = 0; i < n; i++) {
+        const uint64_t key = items[i].key;
+        for (int p = 0; p < 8; p++) {
+            hist[p][(key >> (8 * p)) & 0xff]++;
+        }
+    }
+    for (int p = 0; p < 8; p++) {
+        size_t *pos = hist[p];
+        if (n == 0 || pos[(items[0].key >> (8 * p)) & 0xff] == n) {
+            continue; // every key has this byte
+        }
+        size_t sum = 0;
+        for (int b = 0; b < 256; b++) {
+            const size_t count = pos[b];
+            pos[b] = sum;
+            sum += count;
+        }
+        for (size_t i = 0; i < n; i++) {
+            tmp[pos[(items[i].key >> (8 * p)) & 0xff]++] = items[i];
+        }
+        unique_item_t *swap = items;
+        items = tmp;
+        tmp = swap;
+    }
+    return items;
+}
+
+/// Hash path: ids by first appearance, then ranks from the sorted distinct keys
+///
+/// tmp offers n items of scratch. Returns the unique count, or 0 when the input
+/// has more distinct keys than the path accepts (nothing is written then).
+static size_t unique_hash(const unique_item_t *items, unique_item_t *tmp, size_t n,
+                          const char *vals, size_t elem_size, char *values, int32_t *inverse,
+                          int32_t *counts) {
+    const size_t limit = MINIMUM(UNIQUE_HASH_MAX_KEYS, n / 16);
+    unsigned bits = 1;
+    while (((size_t)1 << bits) < 2 * limit) {
+        bits++;
+    }
+    const size_t cap = (size_t)1 << bits;
+    const size_t mask = cap - 1;
+
+    // tmp: table (cap items) | distinct keys (limit items) | sort scratch (limit items)
+    unique_item_t *table = tmp;
+    unique_item_t *distinct = table + cap;
+    unique_item_t *sort_tmp = distinct + limit;
+    for (size_t s = 0; s < cap; s++) {
+        table[s].idx = SIZE_MAX;
+    }
+
+    size_t k = 0;
+    for (size_t i = 0; i < n; i++) {
+        const uint64_t key = items[i].key;
+        size_t s = (size_t)((key * 0x9E3779B97F4A7C15ull) >> (64 - bits));
+        while (table[s].idx != SIZE_MAX && table[s].key != key) {
+            s = (s + 1) & mask;
+        }
+        if (table[s].idx == SIZE_MAX) {
+            if (k == limit) {
+                return 0;
+            }
+            table[s].key = key;
+            table[s].idx = k;
+            distinct[k].key = key;
+            distinct[k].idx = i; // first appearance, also the id order
+            k++;
+        }
+        inverse[i] = (int32_t)table[s].idx;
+    }
+
+    // Sort the distinct keys (carrying their first positions) and rank the ids
+    const unique_item_t *sorted = unique_radix_sort(distinct, sort_tmp, k);
+    int32_t *rank = (int32_t *)table; // ids are dense once hashing is done
+    int32_t *id_counts = rank + k;
+    for (size_t r = 0; r < k; r++) {
+        const size_t id = (size_t)inverse[sorted[r].idx];
+        rank[id] = (int32_t)r;
+        id_counts[id] = 0;
+        memcpy(values + r * elem_size, vals + sorted[r].idx * elem_size, elem_size);
+    }
+    for (size_t i = 0; i < n; i++) {
+        const int32_t id = inverse[i];
+        id_counts[id]++;
+        inverse[i] = rank[id];
+    }
+    for (size_t id = 0; id < k; id++) {
+        counts[rank[id]] = id_counts[id];
+    }
+    return k;
+}
+
+/// Scratch: items[n] | tmp[n] | values[n]
+static size_t unique_scratch_bytes(size_t n, size_t elem_size, size_t *items_bytes) {
+    *items_bytes = hodu_cpu_workspace_block_size(n * sizeof(unique_item_t));
+    return 2 * *items_bytes + n * elem_size;
+}
+
+/// Group keyed items into values, inverse and counts; releases the scratch
+static size_t unique_run(unique_item_t *items, size_t items_bytes, size_t n, size_t elem_size,
+                         char *values, int32_t *inverse, int32_t *counts) {
+    unique_item_t *tmp = (unique_item_t *)((char *)items + items_bytes);
+    const char *vals = (const char *)items + 2 * items_bytes;
+
+    size_t unique_count = 0;
+    if (n >= UNIQUE_HASH_MIN) {
+        unique_count = unique_hash(items, tmp, n, vals, elem_size, values, inverse, counts);
+    }
+    if (unique_count == 0) {
+        const unique_item_t *sorted = unique_radix_sort(items, tmp, n);
+        int32_t current_count = 0;
+        for (size_t i = 0; i < n; i++) {
+            if (i > 0 && sorted[i].key != sorted[i - 1].key) {
+                counts[unique_count++] = current_count;
+                current_count = 0;
+            }
+            if (current_count == 0) {
+                memcpy(values + unique_count * elem_size, vals + sorted[i].idx * elem_size,
+                       elem_size);
+            }
+            current_count++;
+            inverse[sorted[i].idx] = (int32_t)unique_count;
+        }
+        counts[unique_count++] = current_count;
     }
 
-/// Macro to implement unique operation for float types
-#define UNIQUE_OP_FLOAT(TYPENAME, FN_NAME, TO_DOUBLE)                                              \
+    workspace_release(items);
+    return unique_count;
+}
+
+/// Macro to implement unique operation
+///
+/// @param TYPENAME C type for the operation
+/// @param FN_NAME Function name
+/// @param KEY Order-preserving uint64_t key of `val`
+#define UNIQUE_OP(TYPENAME, FN_NAME, KEY)                                                          \
     size_t hodu_cpu_##FN_NAME(const void *input_ptr, void *values_ptr, int32_t *inverse,           \
                               int32_t *counts, const size_t *metadata) {                           \
+        HODU_PROFILE_KERNEL(metadata[0] * (sizeof(TYPENAME) + sizeof(int32_t)));                   \
         const TYPENAME *input = (const TYPENAME *)input_ptr;                                       \
-        TYPENAME *values = (TYPENAME *)values_ptr;                                                 \
                                                                                                    \
         const size_t num_els = metadata[0];                                                        \
         const size_t num_dims = metadata[1];                                                       \
@@ -1239,80 +1706,54 @@ static int compare_index_pairs_float(const void *a, const void *b) {
         if (num_els == 0)                                                                          \
             return 0;                                                                              \
                                                                                                    \
-        /* Allocate temp array for sorting */                                                      \
-        IndexPairFloat *pairs = (IndexPairFloat *)malloc(num_els * sizeof(IndexPairFloat));        \
-        TYPENAME *input_values = (TYPENAME *)malloc(num_els * sizeof(TYPENAME));                   \
-                                                                                                   \
-        /* Read input values */                                                                    \
-        for (size_t id = 0; id < num_els; id++) {                                                  \
-            size_t flat_idx = input_offset;                                                        \
-            size_t temp = id;                                                                      \
-            for (int d = (int)num_dims - 1; d >= 0; d--) {                                         \
-                size_t idx = temp % input_shape[d];                                                \
-                temp /= input_shape[d];                                                            \
-                flat_idx += idx * input_strides[d];                                                \
-            }                                                                                      \
-            input_values[id] = input[flat_idx];                                                    \
-            pairs[id].orig_idx = id;                                                               \
-            pairs[id].sort_key = (double)(TO_DOUBLE);                                              \
-        }                                                                                          \
-                                                                                                   \
-        /* Sort by value */                                                                        \
-        qsort(pairs, num_els, sizeof(IndexPairFloat), compare_index_pairs_float);                  \
-                                                                                                   \
-        /* Build outputs */                                                                        \
-        size_t unique_count = 0;                                                                   \
-        int32_t current_count = 0;                                                                 \
-                                                                                                   \
-        for (size_t i = 0; i < num_els; i++) {                                                     \
-            size_t orig_idx = pairs[i].orig_idx;                                                   \
-            TYPENAME val = input_values[orig_idx];                                                 \
-            double val_d = pairs[i].sort_key;                                                      \
-                                                                                                   \
-            if (i == 0) {                                                                          \
-                values[unique_count] = val;                                                        \
-                current_count = 1;                                                                 \
-            } else {                                                                               \
-                double prev_val_d = pairs[i - 1].sort_key;                                         \
-                if (val_d != prev_val_d) {                                                         \
-                    counts[unique_count] = current_count;                                          \
-                    unique_count++;                                                                \
-                    values[unique_count] = val;                                                    \
-                    current_count = 1;                                                             \
-                } else {                                                                           \
-                    current_count++;                                                               \
-                }                                                                                  \
-            }                                                                                      \
-            inverse[orig_idx] = (int32_t)unique_count;                                             \
+        /* Keyed items, sort scratch and gathered values share one scratch block */                \
+        size_t items_bytes;                                                                        \
+        unique_item_t *items = (unique_item_t *)workspace_acquire(                                 \
+            unique_scratch_bytes(num_els, sizeof(TYPENAME), &items_bytes));                        \
+        if (!items)                                                                                \
+            return 0;                                                                              \
+        TYPENAME *input_values = (TYPENAME *)((char *)items + 2 * items_bytes);                    \
+                                                                                                   \
+        strided_iter_t it;                                                                         \
+        strided_iter_init(&it, num_dims, input_shape, input_strides, 0);                           \
+        for (size_t id = 0; id < num_els; id++, strided_iter_next(&it)) {                          \
+            const TYPENAME val = input[input_offset + it.offset];                                  \
+            input_values[id] = val;                                                                \
+            items[id].key = (uint64_t)(KEY);                                                       \
+            items[id].idx = id;                                                                    \
         }                                                                                          \
-        counts[unique_count] = current_count;                                                      \
-        unique_count++;                                                                            \
                                                                                                    \
-        free(pairs);                                                                               \
-        free(input_values);                                                                        \
-        return unique_count;                                                                       \
+        return unique_run(items, items_bytes, num_els, sizeof(TYPENAME), (char *)values_ptr,       \
+                          inverse, counts);                                                        \
     }
 
+size_t hodu_cpu_unique_workspace_size(const size_t *metadata) {
+    size_t items_bytes;
+    return hodu_cpu_workspace_block_size(
+               unique_scratch_bytes(metadata[0], sizeof(uint64_t), &items_bytes)) +
+           HODU_CPU_WORKSPACE_ALIGN;
+}
+
 // Bool unique
-UNIQUE_OP_INT(bool, unique_bool)
+UNIQUE_OP(bool, unique_bool, val)
 
 // Float types
-UNIQUE_OP_FLOAT(f8e4m3_t, unique_f8e4m3, f8e4m3_to_float(input[flat_idx]))
-UNIQUE_OP_FLOAT(f8e5m2_t, unique_f8e5m2, f8e5m2_to_float(input[flat_idx]))
-UNIQUE_OP_FLOAT(bf16_t, unique_bf16, bf16_to_float(input[flat_idx]))
-UNIQUE_OP_FLOAT(f16_t, unique_f16, f16_to_float(input[flat_idx]))
-UNIQUE_OP_FLOAT(float, unique_f32, input[flat_idx])
-UNIQUE_OP_FLOAT(double, unique_f64, input[flat_idx])
-
-// Integer types
-UNIQUE_OP_INT(int8_t, unique_i8)
-UNIQUE_OP_INT(int16_t, unique_i16)
-UNIQUE_OP_INT(int32_t, unique_i32)
-UNIQUE_OP_INT(int64_t, unique_i64)
-UNIQUE_OP_INT(uint8_t, unique_u8)
-UNIQUE_OP_INT(uint16_t, unique_u16)
-UNIQUE_OP_INT(uint32_t, unique_u32)
-UNIQUE_OP_INT(uint64_t, unique_u64)
+UNIQUE_OP(f8e4m3_t, unique_f8e4m3, unique_f32_key(f8e4m3_to_float(val)))
+UNIQUE_OP(f8e5m2_t, unique_f8e5m2, unique_f32_key(f8e5m2_to_float(val)))
+UNIQUE_OP(bf16_t, unique_bf16, unique_f32_key(bf16_to_float(val)))
+UNIQUE_OP(f16_t, unique_f16, unique_f32_key(f16_to_float(val)))
+UNIQUE_OP(float, unique_f32, unique_f32_key(val))
+UNIQUE_OP(double, unique_f64, unique_f64_key(val))
+
+// Integer types (signed keys flip the sign bit so that they sort numerically)
+UNIQUE_OP(int8_t, unique_i8, (uint8_t)val ^ 0x80u)
+UNIQUE_OP(int16_t, unique_i16, (uint16_t)val ^ 0x8000u)
+UNIQUE_OP(int32_t, unique_i32, (uint32_t)val ^ 0x80000000u)
+UNIQUE_OP(int64_t, unique_i64, (uint64_t)val ^ 0x8000000000000000ull)
+UNIQUE_OP(uint8_t, unique_u8, val)
+UNIQUE_OP(uint16_t, unique_u16, val)
+UNIQUE_OP(uint32_t, unique_u32, val)
+UNIQUE_OP(uint64_t, unique_u64, val)
 
 // ============================================================================
 // COMPRESS OPERATIONS
@@ -1334,94 +1775,159 @@ UNIQUE_OP_INT(uint64_t, unique_u64)
 // Two-pass operation:
 //   1. compress_count - counts True values in condition (done in Rust)
 //   2. compress_fill - copies selected elements to output
+//
+// Algorithm:
+// Flatten mode is a stream compaction over the condition; chunks count their
+// True entries, then gather the selected elements along a strided iterator.
+// Axis mode lists the selected indices and copies each (outer, selected) slice
+// as its own task, row by row along the inner dims.
+
+typedef struct {
+    const char *input; // first element (offset applied)
+    const bool *condition;
+    char *output;
+    size_t elem_size;
+    size_t num_dims;
+    const size_t *shape;
+    const size_t *strides;
+    /* Axis mode */
+    size_t axis;
+    size_t slice_size;
+    size_t num_selected;
+    const size_t *selected;
+    index_copy_fn_t copy;
+} compress_ctx_t;
+
+static size_t compress_count_range(const void *ctx_ptr, size_t start, size_t end) {
+    const bool *condition = ((const compress_ctx_t *)ctx_ptr)->condition;
+    size_t count = 0;
+    for (size_t i = start; i < end; i++) {
+        count += condition[i] ? 1 : 0;
+    }
+    return count;
+}
+
+/// Axis mode: copy the slices of (outer, selected) items [start, end)
+static void compress_axis_worker(size_t start, size_t end, void *ctx_ptr) {
+    const compress_ctx_t *ctx = (const compress_ctx_t *)ctx_ptr;
+    const size_t es = ctx->elem_size;
+    const size_t inner_dims = ctx->num_dims - ctx->axis - 1;
+    for (size_t item = start; item < end; item++) {
+        size_t temp = item / ctx->num_selected;
+        size_t base = ctx->selected[item % ctx->num_selected] * ctx->strides[ctx->axis];
+        for (size_t d = ctx->axis; d-- > 0;) {
+            base += (temp % ctx->shape[d]) * ctx->strides[d];
+            temp /= ctx->shape[d];
+        }
+        const char *src = ctx->input + base * es;
+        char *dst = ctx->output + item * ctx->slice_size * es;
+
+        strided_iter_t it;
+        strided_iter_init(&it, inner_dims, ctx->shape + ctx->axis + 1,
+                          ctx->strides + ctx->axis + 1, 0);
+        for (size_t i = 0; i < ctx->slice_size;) {
+            const size_t row_len = strided_iter_row(&it);
+            if (it.inner_stride == 1) {
+                memcpy(dst + i * es, src + it.offset * es, row_len * es);
+            } else {
+                ctx->copy(src + it.offset * es, it.inner_stride, dst + i * es, row_len);
+            }
+            strided_iter_advance(&it, row_len);
+            i += row_len;
+        }
+    }
+}
+
+/// Axis mode of compress
+static void compress_axis_run(compress_ctx_t *ctx, size_t condition_size) {
+    size_t outer_size = 1;
+    for (size_t d = 0; d < ctx->axis; d++) {
+        outer_size *= ctx->shape[d];
+    }
+    ctx->slice_size = 1;
+    for (size_t d = ctx->axis + 1; d < ctx->num_dims; d++) {
+        ctx->slice_size *= ctx->shape[d];
+    }
+    if (outer_size == 0 || ctx->slice_size == 0 || condition_size == 0) {
+        return;
+    }
+
+    size_t *selected = (size_t *)workspace_acquire(condition_size * sizeof(size_t));
+    if (!selected) {
+        return;
+    }
+    size_t num_selected = 0;
+    for (size_t i = 0; i < condition_size; i++) {
+        if (ctx->condition[i]) {
+            selected[num_selected++] = i;
+        }
+    }
+    if (num_selected > 0) {
+        gather_row_fn_t gather;
+        gather_kernels(ctx->elem_size, &gather, &ctx->copy);
+        ctx->selected = selected;
+        ctx->num_selected = num_selected;
+        const size_t grain = task_grain(HODU_CPU_COST_COPY, ctx->slice_size * ctx->elem_size);
+        parallel_for(0, outer_size * num_selected, grain, compress_axis_worker, ctx);
+    }
+    workspace_release(selected);
+}
 
 /// Macro to implement compress operation with axis
 ///
 /// @param TYPENAME C type for the operation
 /// @param FN_NAME Function name
 #define COMPRESS_OP(TYPENAME, FN_NAME)                                                             \
+    static size_t FN_NAME##_range(const void *ctx_ptr, size_t start, size_t end,                   \
+                                  size_t out_pos) {                                                \
+        const compress_ctx_t *ctx = (const compress_ctx_t *)ctx_ptr;                               \
+        const TYPENAME *input = (const TYPENAME *)ctx->input;                                      \
+        TYPENAME *output = (TYPENAME *)ctx->output + out_pos;                                      \
+                                                                                                   \
+        size_t out_idx = 0;                                                                        \
+        strided_iter_t it;                                                                         \
+        strided_iter_init(&it, ctx->num_dims, ctx->shape, ctx->strides, start);                    \
+        for (size_t i = start; i < end;) {                                                         \
+            const size_t row_len = MINIMUM(strided_iter_row(&it), end - i);                        \
+            const TYPENAME *row = input + it.offset;                                               \
+            const size_t row_stride = it.inner_stride;                                             \
+            for (size_t k = 0; k < row_len; k++) {                                                 \
+                if (ctx->condition[i + k]) {                                                       \
+                    output[out_idx++] = row[k * row_stride];                                       \
+                }                                                                                  \
+            }                                                                                      \
+            strided_iter_advance(&it, row_len);                                                    \
+            i += row_len;                                                                          \
+        }                                                                                          \
+        return out_idx;                                                                            \
+    }                                                                                              \
+                                                                                                   \
     void hodu_cpu_##FN_NAME(const void *input_ptr, const bool *condition, void *output_ptr,        \
                             const size_t *metadata) {                                              \
-        const TYPENAME *input = (const TYPENAME *)input_ptr;                                       \
-        TYPENAME *output = (TYPENAME *)output_ptr;                                                 \
-                                                                                                   \
+        HODU_PROFILE_KERNEL(metadata[0] * sizeof(TYPENAME));                                       \
         const size_t num_input_els = metadata[0];                                                  \
         const size_t num_dims = metadata[1];                                                       \
-        const size_t *input_shape = metadata + 2;                                                  \
-        const size_t *input_strides = metadata + 2 + num_dims;                                     \
         const size_t input_offset = metadata[2 + 2 * num_dims];                                    \
         const size_t condition_size = metadata[2 + 2 * num_dims + 1];                              \
         const size_t axis_flag = metadata[2 + 2 * num_dims + 2];                                   \
-        const size_t axis = metadata[2 + 2 * num_dims + 3];                                        \
                                                                                                    \
-        size_t out_idx = 0;                                                                        \
+        compress_ctx_t ctx;                                                                        \
+        ctx.input = (const char *)((const TYPENAME *)input_ptr + input_offset);                    \
+        ctx.condition = condition;                                                                 \
+        ctx.output = (char *)output_ptr;                                                           \
+        ctx.elem_size = sizeof(TYPENAME);                                                          \
+        ctx.num_dims = num_dims;                                                                   \
+        ctx.shape = metadata + 2;                                                                  \
+        ctx.strides = metadata + 2 + num_dims;                                                     \
                                                                                                    \
         if (axis_flag == 0) {                                                                      \
             /* Flatten mode: select elements where condition[i] is True */                         \
-            for (size_t i = 0; i < condition_size && i < num_input_els; i++) {                     \
-                if (condition[i]) {                                                                \
-                    /* Compute flat index from strided layout */                                   \
-                    size_t flat_idx = input_offset;                                                \
-                    size_t temp = i;                                                               \
-                    for (int d = (int)num_dims - 1; d >= 0; d--) {                                 \
-                        size_t idx = temp % input_shape[d];                                        \
-                        temp /= input_shape[d];                                                    \
-                        flat_idx += idx * input_strides[d];                                        \
-                    }                                                                              \
-                    output[out_idx++] = input[flat_idx];                                           \
-                }                                                                                  \
-            }                                                                                      \
+            compact_run(&ctx, MINIMUM(condition_size, num_input_els), compress_count_range,        \
+                        FN_NAME##_range);                                                          \
         } else {                                                                                   \
             /* Axis mode: select slices along axis where condition[i] is True */                   \
-            /* Compute slice size (product of dims after axis) */                                  \
-            size_t slice_size = 1;                                                                 \
-            for (size_t d = axis + 1; d < num_dims; d++) {                                         \
-                slice_size *= input_shape[d];                                                      \
-            }                                                                                      \
-                                                                                                   \
-            /* Compute outer size (product of dims before axis) */                                 \
-            size_t outer_size = 1;                                                                 \
-            for (size_t d = 0; d < axis; d++) {                                                    \
-                outer_size *= input_shape[d];                                                      \
-            }                                                                                      \
-                                                                                                   \
-            /* Iterate over all combinations of outer and inner dimensions */                      \
-            for (size_t outer = 0; outer < outer_size; outer++) {                                  \
-                for (size_t cond_idx = 0; cond_idx < condition_size; cond_idx++) {                 \
-                    if (!condition[cond_idx])                                                      \
-                        continue;                                                                  \
-                                                                                                   \
-                    for (size_t inner = 0; inner < slice_size; inner++) {                          \
-                        /* Compute multi-dim indices */                                            \
-                        size_t multi_idx[32];                                                      \
-                                                                                                   \
-                        /* Outer indices */                                                        \
-                        size_t temp = outer;                                                       \
-                        for (int d = (int)axis - 1; d >= 0; d--) {                                 \
-                            multi_idx[d] = temp % input_shape[d];                                  \
-                            temp /= input_shape[d];                                                \
-                        }                                                                          \
-                                                                                                   \
-                        /* Axis index */                                                           \
-                        multi_idx[axis] = cond_idx;                                                \
-                                                                                                   \
-                        /* Inner indices */                                                        \
-                        temp = inner;                                                              \
-                        for (int d = (int)num_dims - 1; d > (int)axis; d--) {                      \
-                            multi_idx[d] = temp % input_shape[d];                                  \
-                            temp /= input_shape[d];                                                \
-                        }                                                                          \
-                                                                                                   \
-                        /* Compute flat input index */                                             \
-                        size_t flat_idx = input_offset;                                            \
-                        for (size_t d = 0; d < num_dims; d++) {                                    \
-                            flat_idx += multi_idx[d] * input_strides[d];                           \
-                        }                                                                          \
-                                                                                                   \
-                        output[out_idx++] = input[flat_idx];                                       \
-                    }                                                                              \
-                }                                                                                  \
-            }                                                                                      \
+            ctx.axis = metadata[2 + 2 * num_dims + 3];                                             \
+            compress_axis_run(&ctx, condition_size);                                               \
         }                                                                                          \
     }
 
@@ -105,6 +105,11 @@ void hodu_cpu_index_select_u64(const void *input, const int32_t *indices, void *
 // - metadata[2+3*num_dims+1]: values_offset
 // - metadata[2+3*num_dims+2]: dim (dimension along which to write)
 // - metadata[2+3*num_dims+3]: num_indices
+//
+// Negative indices wrap once, out-of-range indices are skipped and for a
+// repeated index the first one wins. output may be input itself (same offset,
+// row-major view), which skips the input copy; values and indices must not
+// overlap the output.
 
 void hodu_cpu_index_put_bool(const void *input, const int32_t *indices, const void *values,
                              void *output, const size_t *metadata);
@@ -224,6 +229,13 @@ void hodu_cpu_gather_u64(const void *input, const int32_t *indices, void *output
 // - metadata[2+5*num_dims+1]: src_offset
 // - metadata[2+5*num_dims+2]: indices_offset
 // - metadata[2+5*num_dims+3]: dim (dimension along which to scatter)
+//
+// Large scatters run on the thread pool without atomics: updates are bucketed
+// by output position and each output receives them in src order, so results
+// (including float sums) are identical to a serial loop for any thread count.
+//
+// output may be input itself (same offset, row-major view), which skips the
+// input copy; src and indices must not overlap the output.
 
 void hodu_cpu_scatter_bool(const void *input, const int32_t *indices, const void *src, void *output,
                            const size_t *metadata);
@@ -365,6 +377,10 @@ void hodu_cpu_scatter_min_u32(const void *input, const int32_t *indices, const v
 void hodu_cpu_scatter_min_u64(const void *input, const int32_t *indices, const void *src,
                               void *output, const size_t *metadata);
 
+/// Scratch bytes a scatter, scatter_add, scatter_max or scatter_min call takes from the
+/// workspace (bound for any dtype; see workspace.h)
+size_t hodu_cpu_scatter_workspace_size(const size_t *metadata);
+
 // ============================================================================
 // ONEHOT OPERATIONS
 // ============================================================================
@@ -522,6 +538,9 @@ size_t hodu_cpu_unique_u32(const void *input, void *values, int32_t *inverse, in
 size_t hodu_cpu_unique_u64(const void *input, void *values, int32_t *inverse, int32_t *counts,
                            const size_t *metadata);
 
+/// Scratch bytes a unique call takes from the workspace (bound for any dtype; see workspace.h)
+size_t hodu_cpu_unique_workspace_size(const size_t *metadata);
+
 // ============================================================================
 // COMPRESS OPERATIONS
 // ============================================================================
@@ -1,9 +1,506 @@
 #include "ops_linalg.h"
+#include "gemm.h"
+#include "profile.h"
+#include "thread_utils.h"
 #include "types.h"
+#include "utils.h"
+#include "workspace.h"
 #include <stdbool.h>
 #include <stdint.h>
 #include <stdlib.h>
 
+// Arguments shared by the batch-parallel det/inv workers
+typedef struct {
+    const void *input;
+    void *output;
+    const size_t *metadata;
+} linalg_batch_args_t;
+
+// Matrices per scheduling task: group small matrices so a task costs ~n^3 >= 4096 ops.
+// Large or pivot-heavy matrices get one task each and are balanced by work stealing.
+static inline size_t linalg_batch_grain(size_t n) {
+    size_t work = n * n * n;
+    return work >= 4096 ? 1 : 4096 / (work ? work : 1);
+}
+
+// Offset of matrix `batch` of a [..., rows, cols] view (batch dims unravelled over shape)
+static inline size_t linalg_matrix_offset(size_t ndim, const size_t *shape, const size_t *strides,
+                                          size_t offset, size_t batch) {
+    for (size_t d = ndim >= 2 ? ndim - 2 : 0; d-- > 0;) {
+        offset += (batch % shape[d]) * strides[d];
+        batch /= shape[d];
+    }
+    return offset;
+}
+
+// Offset of matrix `batch` in the strided input (det/inv metadata layout)
+static inline size_t linalg_batch_offset(const size_t *metadata, size_t batch) {
+    const size_t ndim = metadata[2];
+    return linalg_matrix_offset(ndim, metadata + 3, metadata + 3 + ndim, metadata[3 + 2 * ndim],
+                                batch);
+}
+
+// ============================================================================
+// FLOAT FAST PATHS (f32, f64)
+// ============================================================================
+//
+// - 4 <= n <= LINALG_SMALL_MAX: matrices are transposed into lanes of
+//   LINALG_LANES (one 64-byte vector) and eliminated together by kernels
+//   generated per size, so every loop has a constant trip count and runs
+//   across the batch; pivot search and row swaps become per-lane selects.
+//   Arithmetic matches the per-matrix elimination below
+// - n >= LINALG_BLOCKED_MIN: blocked right-looking LU with partial pivoting;
+//   each LINALG_BLOCK-wide panel is factored, U12 solved, and the trailing
+//   matrix updated with the native GEMM. The inverse then solves
+//   L U X = P I with blocked triangular solves whose updates are also GEMMs
+// - Batches run on the thread pool. Blocked matrices go one per task when
+//   there are enough of them, otherwise one at a time with GEMM parallel
+// Other sizes use the per-matrix kernels of DET_OP/INV_OP.
+
+#define LINALG_SMALL_MAX 8
+#define LINALG_BLOCK 64
+#define LINALG_BLOCKED_MIN 128
+#define LINALG_LANES(TYPE) (64 / sizeof(TYPE))
+
+/// Macro for the fixed-size batched det/inv kernels of one float type and size
+///
+/// Lane l of a[(i * N + j) * W + l] holds element (i, j) of matrix batch0 + l;
+/// lanes past count hold the identity.
+///
+/// @param TYPE C type of the elements
+/// @param TYPE_SUFFIX Suffix for function naming
+/// @param N Matrix size (literal)
+#define LINALG_SMALL_OP(TYPE, TYPE_SUFFIX, N)                                                      \
+    static void linalg_gather_##TYPE_SUFFIX##_##N(const TYPE *input, const size_t *metadata,       \
+                                                  size_t batch0, size_t count, size_t cols,        \
+                                                  TYPE *a) {                                       \
+        enum { W = LINALG_LANES(TYPE) };                                                           \
+        const size_t ndim = metadata[2];                                                           \
+        const size_t *strides = metadata + 3 + ndim;                                               \
+        const size_t row_stride = (ndim >= 2) ? strides[ndim - 2] : N;                             \
+        const size_t col_stride = (ndim >= 1) ? strides[ndim - 1] : 1;                             \
+        for (size_t l = 0; l < W; l++) {                                                           \
+            if (l < count) {                                                                       \
+                const size_t off = linalg_batch_offset(metadata, batch0 + l);                      \
+                for (size_t i = 0; i < N; i++) {                                                   \
+                    for (size_t j = 0; j < N; j++) {                                               \
+                        a[(i * cols + j) * W + l] = input[off + i * row_stride + j * col_stride];  \
+                    }                                                                              \
+                }                                                                                  \
+            } else {                                                                               \
+                for (size_t i = 0; i < N; i++) {                                                   \
+                    for (size_t j = 0; j < N; j++) {                                               \
+                        a[(i * cols + j) * W + l] = i == j ? (TYPE)1 : (TYPE)0;                    \
+                    }                                                                              \
+                }                                                                                  \
+            }                                                                                      \
+        }                                                                                          \
+    }                                                                                              \
+                                                                                                   \
+    /* Pivot row of column k per lane (first maximum of |a[i][k]|, i >= k), stored in p */         \
+    static inline void linalg_pivot_##TYPE_SUFFIX##_##N(const TYPE *a, size_t cols, size_t k,      \
+                                                        size_t *p) {                               \
+        enum { W = LINALG_LANES(TYPE) };                                                           \
+        TYPE max_val[W];                                                                           \
+        for (size_t l = 0; l < W; l++) {                                                           \
+            const TYPE v = a[(k * cols + k) * W + l];                                              \
+            max_val[l] = v < 0 ? -v : v;                                                           \
+            p[l] = k;                                                                              \
+        }                                                                                          \
+        for (size_t i = k + 1; i < N; i++) {                                                       \
+            for (size_t l = 0; l < W; l++) {                                                       \
+                TYPE v = a[(i * cols + k) * W + l];                                                \
+                v = v < 0 ? -v : v;                                                                \
+                const bool gt = v > max_val[l];                                                    \
+                max_val[l] = gt ? v : max_val[l];                                                  \
+                p[l] = gt ? i : p[l];                                                              \
+            }                                                                                      \
+        }                                                                                          \
+    }                                                                                              \
+                                                                                                   \
+    /* Swap row k with row p[l] in columns [j0, cols) of every lane */                             \
+    static inline void linalg_swap_##TYPE_SUFFIX##_##N(TYPE *a, size_t cols, size_t k,             \
+                                                       const size_t *p, size_t j0) {               \
+        enum { W = LINALG_LANES(TYPE) };                                                           \
+        for (size_t l = 0; l < W; l++) {                                                           \
+            if (p[l] == k) {                                                                       \
+                continue;                                                                          \
+            }                                                                                      \
+            for (size_t j = j0; j < cols; j++) {                                                   \
+                const TYPE t = a[(k * cols + j) * W + l];                                          \
+                a[(k * cols + j) * W + l] = a[(p[l] * cols + j) * W + l];                          \
+                a[(p[l] * cols + j) * W + l] = t;                                                  \
+            }                                                                                      \
+        }                                                                                          \
+    }                                                                                              \
+                                                                                                   \
+    static void det_small_##TYPE_SUFFIX##_##N(const TYPE *input, TYPE *output,                     \
+                                              const size_t *metadata, size_t batch0,               \
+                                              size_t count) {                                      \
+        enum { W = LINALG_LANES(TYPE) };                                                           \
+        TYPE a[N * N * W];                                                                         \
+        TYPE det[W];                                                                               \
+        bool negate[W], singular[W];                                                               \
+        size_t p[W];                                                                               \
+        linalg_gather_##TYPE_SUFFIX##_##N(input, metadata, batch0, count, N, a);                   \
+        for (size_t l = 0; l < W; l++) {                                                           \
+            det[l] = (TYPE)1;                                                                      \
+            negate[l] = singular[l] = false;                                                       \
+        }                                                                                          \
+        for (size_t k = 0; k < N; k++) {                                                           \
+            linalg_pivot_##TYPE_SUFFIX##_##N(a, N, k, p);                                          \
+            linalg_swap_##TYPE_SUFFIX##_##N(a, N, k, p, k);                                        \
+            const TYPE *pivot = a + (k * N + k) * W;                                               \
+            for (size_t l = 0; l < W; l++) {                                                       \
+                const TYPE abs_pivot = pivot[l] < 0 ? -pivot[l] : pivot[l];                        \
+                negate[l] ^= p[l] != k;                                                            \
+                singular[l] |= abs_pivot < (TYPE)1e-15;                                            \
+                det[l] *= pivot[l];                                                                \
+            }                                                                                      \
+            for (size_t i = k + 1; i < N; i++) {                                                   \
+                TYPE factor[W];                                                                    \
+                for (size_t l = 0; l < W; l++) {                                                   \
+                    factor[l] = a[(i * N + k) * W + l] / pivot[l];                                 \
+                }                                                                                  \
+                for (size_t j = k; j < N; j++) {                                                   \
+                    for (size_t l = 0; l < W; l++) {                                               \
+                        a[(i * N + j) * W + l] -= factor[l] * a[(k * N + j) * W + l];              \
+                    }                                                                              \
+                }                                                                                  \
+            }                                                                                      \
+        }                                                                                          \
+        for (size_t l = 0; l < count; l++) {                                                       \
+            output[batch0 + l] = singular[l] ? (TYPE)0 : negate[l] ? -det[l] : det[l];             \
+        }                                                                                          \
+    }                                                                                              \
+                                                                                                   \
+    /* Gauss-Jordan on [A | I], as in INV_OP */                                                    \
+    static void inv_small_##TYPE_SUFFIX##_##N(const TYPE *input, TYPE *output,                     \
+                                              const size_t *metadata, size_t batch0,               \
+                                              size_t count) {                                      \
+        enum { W = LINALG_LANES(TYPE) };                                                           \
+        TYPE a[N * 2 * N * W];                                                                     \
+        size_t p[W];                                                                               \
+        linalg_gather_##TYPE_SUFFIX##_##N(input, metadata, batch0, count, 2 * N, a);               \
+        for (size_t i = 0; i < N; i++) {                                                           \
+            for (size_t j = 0; j < N; j++) {                                                       \
+                for (size_t l = 0; l < W; l++) {                                                   \
+                    a[(i * 2 * N + N + j) * W + l] = i == j ? (TYPE)1 : (TYPE)0;                   \
+                }                                                                                  \
+            }                                                                                      \
+        }                                                                                          \
+        for (size_t k = 0; k < N; k++) {                                                           \
+            linalg_pivot_##TYPE_SUFFIX##_##N(a, 2 * N, k, p);                                      \
+            linalg_swap_##TYPE_SUFFIX##_##N(a, 2 * N, k, p, 0);                                    \
+            TYPE pivot[W];                                                                         \
+            for (size_t l = 0; l < W; l++) {                                                       \
+                pivot[l] = a[(k * 2 * N + k) * W + l];                                             \
+            }                                                                                      \
+            for (size_t j = 0; j < 2 * N; j++) {                                                   \
+                for (size_t l = 0; l < W; l++) {                                                   \
+                    a[(k * 2 * N + j) * W + l] /= pivot[l];                                        \
+                }                                                                                  \
+            }                                                                                      \
+            for (size_t i = 0; i < N; i++) {                                                       \
+                if (i == k) {                                                                      \
+                    continue;                                                                      \
+                }                                                                                  \
+                TYPE factor[W];                                                                    \
+                for (size_t l = 0; l < W; l++) {                                                   \
+                    factor[l] = a[(i * 2 * N + k) * W + l];                                        \
+                }                                                                                  \
+                for (size_t j = 0; j < 2 * N; j++) {                                               \
+                    for (size_t l = 0; l < W; l++) {                                               \
+                        a[(i * 2 * N + j) * W + l] -= factor[l] * a[(k * 2 * N + j) * W + l];      \
+                    }                                                                              \
+                }                                                                                  \
+            }                                                                                      \
+        }                                                                                          \
+        for (size_t l = 0; l < count; l++) {                                                       \
+            TYPE *out = output + (batch0 + l) * N * N;                                             \
+            for (size_t i = 0; i < N; i++) {                                                       \
+                for (size_t j = 0; j < N; j++) {                                                   \
+                    out[i * N + j] = a[(i * 2 * N + N + j) * W + l];                               \
+                }                                                                                  \
+            }                                                                                      \
+        }                                                                                          \
+    }
+
+typedef struct {
+    const void *input;
+    void *output;
+    const size_t *metadata;
+    bool inverse;
+} linalg_fast_args_t;
+
+// Scratch of one blocked det/inv task: LU and GEMM blocks of n x n f64, and the permutation
+static inline size_t linalg_blocked_workspace_size(size_t n) {
+    return hodu_cpu_workspace_block_size(2 * hodu_cpu_workspace_block_size(n * n * sizeof(f64_t)) +
+                                         n * sizeof(size_t));
+}
+
+/// Macro for the blocked LU and the det/inv fast-path entries of one float type
+///
+/// @param TYPE C type of the elements
+/// @param TYPE_SUFFIX Suffix for function naming
+/// @param GEMM_FN Native GEMM of TYPE (gemm.h)
+#define LINALG_FAST_OP(TYPE, TYPE_SUFFIX, GEMM_FN)                                                 \
+    LINALG_SMALL_OP(TYPE, TYPE_SUFFIX, 4)                                                          \
+    LINALG_SMALL_OP(TYPE, TYPE_SUFFIX, 5)                                                          \
+    LINALG_SMALL_OP(TYPE, TYPE_SUFFIX, 6)                                                          \
+    LINALG_SMALL_OP(TYPE, TYPE_SUFFIX, 7)                                                          \
+    LINALG_SMALL_OP(TYPE, TYPE_SUFFIX, 8)                                                          \
+                                                                                                   \
+    static void linalg_small_##TYPE_SUFFIX##_worker(size_t start, size_t end, void *arg) {         \
+        const linalg_fast_args_t *args = (const linalg_fast_args_t *)arg;                          \
+        const TYPE *input = (const TYPE *)args->input;                                             \
+        TYPE *output = (TYPE *)args->output;                                                       \
+        const size_t batch_size = args->metadata[0];                                               \
+        const size_t W = LINALG_LANES(TYPE);                                                       \
+        for (size_t g = start; g < end; g++) {                                                     \
+            const size_t batch0 = g * W;                                                           \
+            const size_t count = MINIMUM(W, batch_size - batch0);                                  \
+            switch (args->metadata[1] * 2 + args->inverse) {                                       \
+            case 8:                                                                                \
+                det_small_##TYPE_SUFFIX##_4(input, output, args->metadata, batch0, count);         \
+                break;                                                                             \
+            case 9:                                                                                \
+                inv_small_##TYPE_SUFFIX##_4(input, output, args->metadata, batch0, count);         \
+                break;                                                                             \
+            case 10:                                                                               \
+                det_small_##TYPE_SUFFIX##_5(input, output, args->metadata, batch0, count);         \
+                break;                                                                             \
+            case 11:                                                                               \
+                inv_small_##TYPE_SUFFIX##_5(input, output, args->metadata, batch0, count);         \
+                break;                                                                             \
+            case 12:                                                                               \
+                det_small_##TYPE_SUFFIX##_6(input, output, args->metadata, batch0, count);         \
+                break;                                                                             \
+            case 13:                                                                               \
+                inv_small_##TYPE_SUFFIX##_6(input, output, args->metadata, batch0, count);         \
+                break;                                                                             \
+            case 14:                                                                               \
+                det_small_##TYPE_SUFFIX##_7(input, output, args->metadata, batch0, count);         \
+                break;                                                                             \
+            case 15:                                                                               \
+                inv_small_##TYPE_SUFFIX##_7(input, output, args->metadata, batch0, count);         \
+                break;                                                                             \
+            case 16:                                                                               \
+                det_small_##TYPE_SUFFIX##_8(input, output, args->metadata, batch0, count);         \
+                break;                                                                             \
+            default:                                                                               \
+                inv_small_##TYPE_SUFFIX##_8(input, output, args->metadata, batch0, count);         \
+                break;                                                                             \
+            }                                                                                      \
+        }                                                                                          \
+    }                                                                                              \
+                                                                                                   \
+    /* Blocked LU with partial pivoting of the row-major n x n matrix a, in place. Returns the */  \
+    /* number of row swaps, or -1 if stop_singular and a pivot is below 1e-15. perm (optional) */  \
+    /* receives the source row of every row; tmp holds (n - LINALG_BLOCK)^2 elements */            \
+    static long lu_blocked_##TYPE_SUFFIX(TYPE *a, size_t n, size_t *perm, TYPE *tmp,               \
+                                         bool stop_singular) {                                     \
+        long swaps = 0;                                                                            \
+        if (perm) {                                                                                \
+            for (size_t i = 0; i < n; i++) {                                                       \
+                perm[i] = i;                                                                       \
+            }                                                                                      \
+        }                                                                                          \
+        for (size_t kb = 0; kb < n; kb += LINALG_BLOCK) {                                          \
+            const size_t ke = MINIMUM(kb + LINALG_BLOCK, n);                                       \
+            /* Panel: columns [kb, ke), full rows swapped */                                       \
+            for (size_t k = kb; k < ke; k++) {                                                     \
+                size_t pivot_row = k;                                                              \
+                TYPE max_val = a[k * n + k] < 0 ? -a[k * n + k] : a[k * n + k];                    \
+                for (size_t i = k + 1; i < n; i++) {                                               \
+                    const TYPE v = a[i * n + k] < 0 ? -a[i * n + k] : a[i * n + k];                \
+                    if (v > max_val) {                                                             \
+                        max_val = v;                                                               \
+                        pivot_row = i;                                                             \
+                    }                                                                              \
+                }                                                                                  \
+                if (pivot_row != k) {                                                              \
+                    for (size_t j = 0; j < n; j++) {                                               \
+                        const TYPE t = a[k * n + j];                                               \
+                        a[k * n + j] = a[pivot_row * n + j];                                       \
+                        a[pivot_row * n + j] = t;                                                  \
+                    }                                                                              \
+                    if (perm) {                                                                    \
+                        const size_t t = perm[k];                                                  \
+                        perm[k] = perm[pivot_row];                                                 \
+                        perm[pivot_row] = t;                                                       \
+                    }                                                                              \
+                    swaps++;                                                                       \
+                }                                                                                  \
+                const TYPE pivot = a[k * n + k];                                                   \
+                if (stop_singular && (pivot < 0 ? -pivot : pivot) < (TYPE)1e-15) {                 \
+                    return -1;                                                                     \
+                }                                                                                  \
+                for (size_t i = k + 1; i < n; i++) {                                               \
+                    const TYPE factor = a[i * n + k] / pivot;                                      \
+                    a[i * n + k] = factor;                                                         \
+                    for (size_t j = k + 1; j < ke; j++) {                                          \
+                        a[i * n + j] -= factor * a[k * n + j];                                     \
+                    }                                                                              \
+                }                                                                                  \
+            }                                                                                      \
+            if (ke == n) {                                                                         \
+                break;                                                                             \
+            }                                                                                      \
+            /* U12 = L11^-1 A12 */                                                                 \
+            for (size_t k = kb; k < ke; k++) {                                                     \
+                for (size_t i = k + 1; i < ke; i++) {                                              \
+                    const TYPE factor = a[i * n + k];                                              \
+                    for (size_t j = ke; j < n; j++) {                                              \
+                        a[i * n + j] -= factor * a[k * n + j];                                     \
+                    }                                                                              \
+                }                                                                                  \
+            }                                                                                      \
+            /* A22 -= L21 U12 */                                                                   \
+            const size_t m = n - ke;                                                               \
+            GEMM_FN(m, m, ke - kb, a + ke * n + kb, n, 1, a + kb * n + ke, n, 1, tmp, m);          \
+            for (size_t i = 0; i < m; i++) {                                                       \
+                TYPE *row = a + (ke + i) * n + ke;                                                 \
+                for (size_t j = 0; j < m; j++) {                                                   \
+                    row[j] -= tmp[i * m + j];                                                      \
+                }                                                                                  \
+            }                                                                                      \
+        }                                                                                          \
+        return swaps;                                                                              \
+    }                                                                                              \
+                                                                                                   \
+    /* Solve L U X = X in place for the n x k row-major x, which holds P B on entry (blocked */    \
+    /* triangular solves; off-diagonal updates are GEMMs). tmp holds LINALG_BLOCK * k elements */  \
+    static void lu_solve_##TYPE_SUFFIX(const TYPE *lu, size_t n, size_t k, TYPE *x, TYPE *tmp) {   \
+        for (size_t ib = 0; ib < n; ib += LINALG_BLOCK) {                                          \
+            const size_t ie = MINIMUM(ib + LINALG_BLOCK, n);                                       \
+            if (ib > 0) {                                                                          \
+                GEMM_FN(ie - ib, k, ib, lu + ib * n, n, 1, x, k, 1, tmp, k);                       \
+                for (size_t i = 0; i < (ie - ib) * k; i++) {                                       \
+                    x[ib * k + i] -= tmp[i];                                                       \
+                }                                                                                  \
+            }                                                                                      \
+            for (size_t i = ib; i < ie; i++) {                                                     \
+                for (size_t p = ib; p < i; p++) {                                                  \
+                    const TYPE factor = lu[i * n + p];                                             \
+                    for (size_t j = 0; j < k; j++) {                                               \
+                        x[i * k + j] -= factor * x[p * k + j];                                     \
+                    }                                                                              \
+                }                                                                                  \
+            }                                                                                      \
+        }                                                                                          \
+        for (size_t ib = (n - 1) / LINALG_BLOCK * LINALG_BLOCK;; ib -= LINALG_BLOCK) {             \
+            const size_t ie = MINIMUM(ib + LINALG_BLOCK, n);                                       \
+            if (ie < n) {                                                                          \
+                GEMM_FN(ie - ib, k, n - ie, lu + ib * n + ie, n, 1, x + ie * k, k, 1, tmp, k);     \
+                for (size_t i = 0; i < (ie - ib) * k; i++) {                                       \
+                    x[ib * k + i] -= tmp[i];                                                       \
+                }                                                                                  \
+            }                                                                                      \
+            for (size_t i = ie; i-- > ib;) {                                                       \
+                for (size_t p = i + 1; p < ie; p++) {                                              \
+                    const TYPE factor = lu[i * n + p];                                             \
+                    for (size_t j = 0; j < k; j++) {                                               \
+                        x[i * k + j] -= factor * x[p * k + j];                                     \
+                    }                                                                              \
+                }                                                                                  \
+                const TYPE pivot = lu[i * n + i];                                                  \
+                for (size_t j = 0; j < k; j++) {                                                   \
+                    x[i * k + j] /= pivot;                                                         \
+                }                                                                                  \
+            }                                                                                      \
+            if (ib == 0) {                                                                         \
+                break;                                                                             \
+            }                                                                                      \
+        }                                                                                          \
+    }                                                                                              \
+    static void linalg_blocked_##TYPE_SUFFIX##_worker(size_t start, size_t end, void *arg) {       \
+        const linalg_fast_args_t *args = (const linalg_fast_args_t *)arg;                          \
+        const TYPE *input = (const TYPE *)args->input;                                             \
+        TYPE *output = (TYPE *)args->output;                                                       \
+        const size_t *metadata = args->metadata;                                                   \
+        const size_t n = metadata[1];                                                              \
+        const size_t ndim = metadata[2];                                                           \
+        const size_t *strides = metadata + 3 + ndim;                                               \
+        const size_t row_stride = (ndim >= 2) ? strides[ndim - 2] : n;                             \
+        const size_t col_stride = (ndim >= 1) ? strides[ndim - 1] : 1;                             \
+        const size_t lu_bytes = hodu_cpu_workspace_block_size(n * n * sizeof(TYPE));               \
+        const size_t tmp_bytes = hodu_cpu_workspace_block_size(n * n * sizeof(TYPE));              \
+        char *ws = (char *)workspace_acquire(lu_bytes + tmp_bytes + n * sizeof(size_t));           \
+        if (!ws) {                                                                                 \
+            return;                                                                                \
+        }                                                                                          \
+        TYPE *lu = (TYPE *)ws;                                                                     \
+        TYPE *tmp = (TYPE *)(ws + lu_bytes);                                                       \
+        size_t *perm = (size_t *)(ws + lu_bytes + tmp_bytes);                                      \
+        for (size_t batch = start; batch < end; batch++) {                                         \
+            const size_t off = linalg_batch_offset(metadata, batch);                               \
+            for (size_t i = 0; i < n; i++) {                                                       \
+                for (size_t j = 0; j < n; j++) {                                                   \
+                    lu[i * n + j] = input[off + i * row_stride + j * col_stride];                  \
+                }                                                                                  \
+            }                                                                                      \
+            if (args->inverse) {                                                                   \
+                TYPE *x = output + batch * n * n;                                                  \
+                lu_blocked_##TYPE_SUFFIX(lu, n, perm, tmp, false);                                 \
+                for (size_t i = 0; i < n; i++) {                                                   \
+                    for (size_t j = 0; j < n; j++) {                                               \
+                        x[i * n + j] = j == perm[i] ? (TYPE)1 : (TYPE)0;                           \
+                    }                                                                              \
+                }                                                                                  \
+                lu_solve_##TYPE_SUFFIX(lu, n, n, x, tmp);                                          \
+            } else {                                                                               \
+                const long swaps = lu_blocked_##TYPE_SUFFIX(lu, n, NULL, tmp, true);               \
+                TYPE det = swaps < 0 ? (TYPE)0 : (TYPE)1;                                          \
+                for (size_t i = 0; swaps >= 0 && i < n; i++) {                                     \
+                    det *= lu[i * n + i];                                                          \
+                }                                                                                  \
+                output[batch] = swaps > 0 && swaps % 2 == 1 ? -det : det;                          \
+            }                                                                                      \
+        }                                                                                          \
+        workspace_release(ws);                                                                     \
+    }                                                                                              \
+                                                                                                   \
+    /* Run det (inverse = false) or inv on a fast path; false if n has none */                     \
+    static bool linalg_fast_##TYPE_SUFFIX(const void *input, void *output,                         \
+                                          const size_t *metadata, bool inverse) {                  \
+        const size_t batch_size = metadata[0];                                                     \
+        const size_t n = metadata[1];                                                              \
+        linalg_fast_args_t args = {input, output, metadata, inverse};                              \
+        if (n >= 4 && n <= LINALG_SMALL_MAX) {                                                     \
+            const size_t W = LINALG_LANES(TYPE);                                                   \
+            const size_t groups = (batch_size + W - 1) / W;                                        \
+            parallel_for(0, groups, linalg_batch_grain(n) / W + 1,                                 \
+                         linalg_small_##TYPE_SUFFIX##_worker, &args);                              \
+            return true;                                                                           \
+        }                                                                                          \
+        if (n >= LINALG_BLOCKED_MIN) {                                                             \
+            if (batch_size > 1 && batch_size >= get_num_threads()) {                               \
+                parallel_for(0, batch_size, 1, linalg_blocked_##TYPE_SUFFIX##_worker, &args);      \
+            } else {                                                                               \
+                linalg_blocked_##TYPE_SUFFIX##_worker(0, batch_size, &args);                       \
+            }                                                                                      \
+            return true;                                                                           \
+        }                                                                                          \
+        return false;                                                                              \
+    }                                                                                              \
+                                                                                                   \
+    static bool det_fast_##TYPE_SUFFIX(const void *input, void *output,                            \
+                                       const size_t *metadata) {                                   \
+        return linalg_fast_##TYPE_SUFFIX(input, output, metadata, false);                          \
+    }                                                                                              \
+                                                                                                   \
+    static bool inv_fast_##TYPE_SUFFIX(const void *input, void *output,                            \
+                                       const size_t *metadata) {                                   \
+        return linalg_fast_##TYPE_SUFFIX(input, output, metadata, true);                           \
+    }
+
+LINALG_FAST_OP(f32_t, f32, hodu_cpu_gemm_f32)
+LINALG_FAST_OP(f64_t, f64, hodu_cpu_gemm_f64)
+
+/// No fast path (integer types)
+#define LINALG_NO_FAST(input, output, metadata) false
+
 // ============================================================================
 // MATRIX DETERMINANT (DET)
 // ============================================================================
@@ -34,13 +531,13 @@
     ((input)[(batch_offset) + (row) * (row_stride) + (col) * (col_stride)])
 
 /// Macro for determinant operation
-#define DET_OP(TYPE, TYPE_SUFFIX)                                                                  \
-    void hodu_cpu_det_##TYPE_SUFFIX(const void *input_ptr, void *output_ptr,                       \
-                                    const size_t *metadata) {                                      \
-        const TYPE *input = (const TYPE *)input_ptr;                                               \
-        TYPE *output = (TYPE *)output_ptr;                                                         \
+#define DET_OP(TYPE, TYPE_SUFFIX, FAST)                                                            \
+    static void det_##TYPE_SUFFIX##_worker(size_t batch_start, size_t batch_end, void *arg) {      \
+        const linalg_batch_args_t *args = (const linalg_batch_args_t *)arg;                        \
+        const TYPE *input = (const TYPE *)args->input;                                             \
+        TYPE *output = (TYPE *)args->output;                                                       \
+        const size_t *metadata = args->metadata;                                                   \
                                                                                                    \
-        const size_t batch_size = metadata[0];                                                     \
         const size_t n = metadata[1];                                                              \
         const size_t ndim = metadata[2];                                                           \
         const size_t *strides = metadata + 3 + ndim;                                               \
@@ -50,7 +547,13 @@
         const size_t row_stride = (ndim >= 2) ? strides[ndim - 2] : n;                             \
         const size_t col_stride = (ndim >= 1) ? strides[ndim - 1] : 1;                             \
                                                                                                    \
-        for (size_t batch = 0; batch < batch_size; batch++) {                                      \
+        /* Scratch matrix for n > 3, reused by every matrix of this task */                        \
+        TYPE *lu = n > 3 ? (TYPE *)workspace_acquire(n * n * sizeof(TYPE)) : NULL;                 \
+        if (n > 3 && !lu) {                                                                        \
+            return;                                                                                \
+        }                                                                                          \
+                                                                                                   \
+        for (size_t batch = batch_start; batch < batch_end; batch++) {                             \
             /* Calculate batch offset using strides */                                             \
             size_t batch_offset = offset;                                                          \
             if (ndim > 2) {                                                                        \
@@ -88,9 +591,6 @@
                 det = a * (e * i - f * h) - b * (d_val * i - f * g) + c * (d_val * h - e * g);     \
             } else {                                                                               \
                 /* LU decomposition with partial pivoting for NxN */                               \
-                /* Allocate temporary matrix */                                                    \
-                TYPE *lu = (TYPE *)malloc(n * n * sizeof(TYPE));                                   \
-                                                                                                   \
                 /* Copy input to LU matrix */                                                      \
                 for (size_t i = 0; i < n; i++) {                                                   \
                     for (size_t j = 0; j < n; j++) {                                               \
@@ -138,7 +638,6 @@
                         abs_pivot = -abs_pivot;                                                    \
                     if (abs_pivot < (TYPE)1e-15) {                                                 \
                         det = 0;                                                                   \
-                        free(lu);                                                                  \
                         goto store_result_##TYPE_SUFFIX;                                           \
                     }                                                                              \
                                                                                                    \
@@ -157,23 +656,33 @@
                 if (swaps % 2 != 0) {                                                              \
                     det = -det;                                                                    \
                 }                                                                                  \
-                                                                                                   \
-                free(lu);                                                                          \
             }                                                                                      \
                                                                                                    \
             store_result_##TYPE_SUFFIX : output[batch] = det;                                      \
         }                                                                                          \
+        workspace_release(lu);                                                                     \
+    }                                                                                              \
+                                                                                                   \
+    void hodu_cpu_det_##TYPE_SUFFIX(const void *input_ptr, void *output_ptr,                       \
+                                    const size_t *metadata) {                                      \
+        HODU_PROFILE_KERNEL(metadata[0] * (metadata[1] * metadata[1] + 1) * sizeof(TYPE));         \
+        if (FAST(input_ptr, output_ptr, metadata)) {                                               \
+            return;                                                                                \
+        }                                                                                          \
+        linalg_batch_args_t args = {input_ptr, output_ptr, metadata};                              \
+        parallel_for(0, metadata[0], linalg_batch_grain(metadata[1]),                              \
+                     det_##TYPE_SUFFIX##_worker, &args);                                           \
     }
 
 /// Macro for determinant operation with exotic types
 #define DET_OP_EXOTIC(TYPE, TYPE_SUFFIX, ZERO, ONE, ADD_FN, SUB_FN, MUL_FN, DIV_FN, NEG_FN,        \
                       ABS_FN, LT_FN)                                                               \
-    void hodu_cpu_det_##TYPE_SUFFIX(const void *input_ptr, void *output_ptr,                       \
-                                    const size_t *metadata) {                                      \
-        const TYPE *input = (const TYPE *)input_ptr;                                               \
-        TYPE *output = (TYPE *)output_ptr;                                                         \
+    static void det_##TYPE_SUFFIX##_worker(size_t batch_start, size_t batch_end, void *arg) {      \
+        const linalg_batch_args_t *args = (const linalg_batch_args_t *)arg;                        \
+        const TYPE *input = (const TYPE *)args->input;                                             \
+        TYPE *output = (TYPE *)args->output;                                                       \
+        const size_t *metadata = args->metadata;                                                   \
                                                                                                    \
-        const size_t batch_size = metadata[0];                                                     \
         const size_t n = metadata[1];                                                              \
         const size_t ndim = metadata[2];                                                           \
         const size_t *strides = metadata + 3 + ndim;                                               \
@@ -182,7 +691,13 @@
         const size_t row_stride = (ndim >= 2) ? strides[ndim - 2] : n;                             \
         const size_t col_stride = (ndim >= 1) ? strides[ndim - 1] : 1;                             \
                                                                                                    \
-        for (size_t batch = 0; batch < batch_size; batch++) {                                      \
+        /* Scratch matrix for n > 3, reused by every matrix of this task */                        \
+        TYPE *lu = n > 3 ? (TYPE *)workspace_acquire(n * n * sizeof(TYPE)) : NULL;                 \
+        if (n > 3 && !lu) {                                                                        \
+            return;                                                                                \
+        }                                                                                          \
+                                                                                                   \
+        for (size_t batch = batch_start; batch < batch_end; batch++) {                             \
             size_t batch_offset = offset;                                                          \
             if (ndim > 2) {                                                                        \
                 size_t temp = batch;                                                               \
@@ -221,7 +736,6 @@
                 det = ADD_FN(SUB_FN(t1, t2), t3);                                                  \
             } else {                                                                               \
                 /* LU decomposition for exotic types */                                            \
-                TYPE *lu = (TYPE *)malloc(n * n * sizeof(TYPE));                                   \
                 for (size_t i = 0; i < n; i++) {                                                   \
                     for (size_t j = 0; j < n; j++) {                                               \
                         lu[i * n + j] =                                                            \
@@ -267,17 +781,33 @@
                 if (swaps % 2 != 0) {                                                              \
                     det = NEG_FN(det);                                                             \
                 }                                                                                  \
-                                                                                                   \
-                free(lu);                                                                          \
             }                                                                                      \
                                                                                                    \
             output[batch] = det;                                                                   \
         }                                                                                          \
+        workspace_release(lu);                                                                     \
+    }                                                                                              \
+                                                                                                   \
+    void hodu_cpu_det_##TYPE_SUFFIX(const void *input_ptr, void *output_ptr,                       \
+                                    const size_t *metadata) {                                      \
+        HODU_PROFILE_KERNEL(metadata[0] * (metadata[1] * metadata[1] + 1) * sizeof(TYPE));         \
+        linalg_batch_args_t args = {input_ptr, output_ptr, metadata};                              \
+        parallel_for(0, metadata[0], linalg_batch_grain(metadata[1]),                              \
+                     det_##TYPE_SUFFIX##_worker, &args);                                           \
     }
 
 // Generate det implementations
-DET_OP(f32_t, f32)
-DET_OP(f64_t, f64)
+size_t hodu_cpu_det_workspace_size(const size_t *metadata) {
+    const size_t n = metadata[1];
+    if (n >= LINALG_BLOCKED_MIN) {
+        return linalg_blocked_workspace_size(n) + HODU_CPU_WORKSPACE_ALIGN;
+    }
+    return n > 3 ? hodu_cpu_workspace_block_size(n * n * sizeof(f64_t)) + HODU_CPU_WORKSPACE_ALIGN
+                 : 0;
+}
+
+DET_OP(f32_t, f32, det_fast_f32)
+DET_OP(f64_t, f64, det_fast_f64)
 DET_OP_EXOTIC(f8e4m3_t, f8e4m3, F8E4M3_ZERO, F8E4M3_ONE, f8e4m3_add, f8e4m3_sub, f8e4m3_mul,
               f8e4m3_div, f8e4m3_neg, f8e4m3_abs, f8e4m3_lt)
 DET_OP_EXOTIC(f8e5m2_t, f8e5m2, F8E5M2_ZERO, F8E5M2_ONE, f8e5m2_add, f8e5m2_sub, f8e5m2_mul,
@@ -286,14 +816,14 @@ DET_OP_EXOTIC(bf16_t, bf16, BF16_ZERO, BF16_ONE, bf16_add, bf16_sub, bf16_mul, b
               bf16_abs, bf16_lt)
 DET_OP_EXOTIC(f16_t, f16, F16_ZERO, F16_ONE, f16_add, f16_sub, f16_mul, f16_div, f16_neg, f16_abs,
               f16_lt)
-DET_OP(int8_t, i8)
-DET_OP(int16_t, i16)
-DET_OP(int32_t, i32)
-DET_OP(int64_t, i64)
-DET_OP(uint8_t, u8)
-DET_OP(uint16_t, u16)
-DET_OP(uint32_t, u32)
-DET_OP(uint64_t, u64)
+DET_OP(int8_t, i8, LINALG_NO_FAST)
+DET_OP(int16_t, i16, LINALG_NO_FAST)
+DET_OP(int32_t, i32, LINALG_NO_FAST)
+DET_OP(int64_t, i64, LINALG_NO_FAST)
+DET_OP(uint8_t, u8, LINALG_NO_FAST)
+DET_OP(uint16_t, u16, LINALG_NO_FAST)
+DET_OP(uint32_t, u32, LINALG_NO_FAST)
+DET_OP(uint64_t, u64, LINALG_NO_FAST)
 
 // ============================================================================
 // MATRIX INVERSE (INV)
@@ -318,13 +848,13 @@ DET_OP(uint64_t, u64)
     ((output)[(batch_offset) + (row) * (n) + (col)] = (value))
 
 /// Macro for matrix inverse operation
-#define INV_OP(TYPE, TYPE_SUFFIX)                                                                  \
-    void hodu_cpu_inv_##TYPE_SUFFIX(const void *input_ptr, void *output_ptr,                       \
-                                    const size_t *metadata) {                                      \
-        const TYPE *input = (const TYPE *)input_ptr;                                               \
-        TYPE *output = (TYPE *)output_ptr;                                                         \
+#define INV_OP(TYPE, TYPE_SUFFIX, FAST)                                                            \
+    static void inv_##TYPE_SUFFIX##_worker(size_t batch_start, size_t batch_end, void *arg) {      \
+        const linalg_batch_args_t *args = (const linalg_batch_args_t *)arg;                        \
+        const TYPE *input = (const TYPE *)args->input;                                             \
+        TYPE *output = (TYPE *)args->output;                                                       \
+        const size_t *metadata = args->metadata;                                                   \
                                                                                                    \
-        const size_t batch_size = metadata[0];                                                     \
         const size_t n = metadata[1];                                                              \
         const size_t ndim = metadata[2];                                                           \
         const size_t *strides = metadata + 3 + ndim;                                               \
@@ -333,7 +863,13 @@ DET_OP(uint64_t, u64)
         const size_t row_stride = (ndim >= 2) ? strides[ndim - 2] : n;                             \
         const size_t col_stride = (ndim >= 1) ? strides[ndim - 1] : 1;                             \
                                                                                                    \
-        for (size_t batch = 0; batch < batch_size; batch++) {                                      \
+        /* Scratch matrix for n > 3, reused by every matrix of this task */                        \
+        TYPE *aug = n > 3 ? (TYPE *)workspace_acquire(n * 2 * n * sizeof(TYPE)) : NULL;            \
+        if (n > 3 && !aug) {                                                                       \
+            return;                                                                                \
+        }                                                                                          \
+                                                                                                   \
+        for (size_t batch = batch_start; batch < batch_end; batch++) {                             \
             size_t batch_offset = offset;                                                          \
             if (ndim > 2) {                                                                        \
                 size_t temp = batch;                                                               \
@@ -390,8 +926,6 @@ DET_OP(uint64_t, u64)
                 INV_SET(output, out_batch_offset, 2, 2, n, (a * e - b * d_val) * inv_det);         \
             } else {                                                                               \
                 /* Gauss-Jordan elimination for NxN */                                             \
-                TYPE *aug = (TYPE *)malloc(n * 2 * n * sizeof(TYPE));                              \
-                                                                                                   \
                 /* Initialize augmented matrix [A | I] */                                          \
                 for (size_t ii = 0; ii < n; ii++) {                                                \
                     for (size_t jj = 0; jj < n; jj++) {                                            \
@@ -451,21 +985,31 @@ DET_OP(uint64_t, u64)
                         INV_SET(output, out_batch_offset, ii, jj, n, aug[ii * 2 * n + n + jj]);    \
                     }                                                                              \
                 }                                                                                  \
-                                                                                                   \
-                free(aug);                                                                         \
             }                                                                                      \
         }                                                                                          \
+        workspace_release(aug);                                                                    \
+    }                                                                                              \
+                                                                                                   \
+    void hodu_cpu_inv_##TYPE_SUFFIX(const void *input_ptr, void *output_ptr,                       \
+                                    const size_t *metadata) {                                      \
+        HODU_PROFILE_KERNEL(metadata[0] * 2 * metadata[1] * metadata[1] * sizeof(TYPE));           \
+        if (FAST(input_ptr, output_ptr, metadata)) {                                               \
+            return;                                                                                \
+        }                                                                                          \
+        linalg_batch_args_t args = {input_ptr, output_ptr, metadata};                              \
+        parallel_for(0, metadata[0], linalg_batch_grain(metadata[1]),                              \
+                     inv_##TYPE_SUFFIX##_worker, &args);                                           \
     }
 
 /// Macro for matrix inverse with exotic types
 #define INV_OP_EXOTIC(TYPE, TYPE_SUFFIX, ZERO, ONE, ADD_FN, SUB_FN, MUL_FN, DIV_FN, NEG_FN,        \
                       ABS_FN, LT_FN)                                                               \
-    void hodu_cpu_inv_##TYPE_SUFFIX(const void *input_ptr, void *output_ptr,                       \
-                                    const size_t *metadata) {                                      \
-        const TYPE *input = (const TYPE *)input_ptr;                                               \
-        TYPE *output = (TYPE *)output_ptr;                                                         \
+    static void inv_##TYPE_SUFFIX##_worker(size_t batch_start, size_t batch_end, void *arg) {      \
+        const linalg_batch_args_t *args = (const linalg_batch_args_t *)arg;                        \
+        const TYPE *input = (const TYPE *)args->input;                                             \
+        TYPE *output = (TYPE *)args->output;                                                       \
+        const size_t *metadata = args->metadata;                                                   \
                                                                                                    \
-        const size_t batch_size = metadata[0];                                                     \
         const size_t n = metadata[1];                                                              \
         const size_t ndim = metadata[2];                                                           \
         const size_t *strides = metadata + 3 + ndim;                                               \
@@ -474,7 +1018,13 @@ DET_OP(uint64_t, u64)
         const size_t row_stride = (ndim >= 2) ? strides[ndim - 2] : n;                             \
         const size_t col_stride = (ndim >= 1) ? strides[ndim - 1] : 1;                             \
                                                                                                    \
-        for (size_t batch = 0; batch < batch_size; batch++) {                                      \
+        /* Scratch matrix for n > 3, reused by every matrix of this task */                        \
+        TYPE *aug = n > 3 ? (TYPE *)workspace_acquire(n * 2 * n * sizeof(TYPE)) : NULL;            \
+        if (n > 3 && !aug) {                                                                       \
+            return;                                                                                \
+        }                                                                                          \
+                                                                                                   \
+        for (size_t batch = batch_start; batch < batch_end; batch++) {                             \
             size_t batch_offset = offset;                                                          \
             if (ndim > 2) {                                                                        \
                 size_t temp = batch;                                                               \
@@ -540,7 +1090,6 @@ DET_OP(uint64_t, u64)
                         MUL_FN(SUB_FN(MUL_FN(a, e), MUL_FN(b, d_val)), inv_det));                  \
             } else {                                                                               \
                 /* Gauss-Jordan for exotic types - work in native format */                        \
-                TYPE *aug = (TYPE *)malloc(n * 2 * n * sizeof(TYPE));                              \
                                                                                                    \
                 for (size_t ii = 0; ii < n; ii++) {                                                \
                     for (size_t jj = 0; jj < n; jj++) {                                            \
@@ -591,15 +1140,32 @@ DET_OP(uint64_t, u64)
                         INV_SET(output, out_batch_offset, ii, jj, n, aug[ii * 2 * n + n + jj]);    \
                     }                                                                              \
                 }                                                                                  \
-                                                                                                   \
-                free(aug);                                                                         \
             }                                                                                      \
         }                                                                                          \
+        workspace_release(aug);                                                                    \
+    }                                                                                              \
+                                                                                                   \
+    void hodu_cpu_inv_##TYPE_SUFFIX(const void *input_ptr, void *output_ptr,                       \
+                                    const size_t *metadata) {                                      \
+        HODU_PROFILE_KERNEL(metadata[0] * 2 * metadata[1] * metadata[1] * sizeof(TYPE));           \
+        linalg_batch_args_t args = {input_ptr, output_ptr, metadata};                              \
+        parallel_for(0, metadata[0], linalg_batch_grain(metadata[1]),                              \
+                     inv_##TYPE_SUFFIX##_worker, &args);                                           \
     }
 
 // Generate inv implementations
-INV_OP(f32_t, f32)
-INV_OP(f64_t, f64)
+size_t hodu_cpu_inv_workspace_size(const size_t *metadata) {
+    const size_t n = metadata[1];
+    if (n >= LINALG_BLOCKED_MIN) {
+        return linalg_blocked_workspace_size(n) + HODU_CPU_WORKSPACE_ALIGN;
+    }
+    return n > 3 ? hodu_cpu_workspace_block_size(n * 2 * n * sizeof(f64_t)) +
+                       HODU_CPU_WORKSPACE_ALIGN
+                 : 0;
+}
+
+INV_OP(f32_t, f32, inv_fast_f32)
+INV_OP(f64_t, f64, inv_fast_f64)
 INV_OP_EXOTIC(f8e4m3_t, f8e4m3, F8E4M3_ZERO, F8E4M3_ONE, f8e4m3_add, f8e4m3_sub, f8e4m3_mul,
               f8e4m3_div, f8e4m3_neg, f8e4m3_abs, f8e4m3_lt)
 INV_OP_EXOTIC(f8e5m2_t, f8e5m2, F8E5M2_ZERO, F8E5M2_ONE, f8e5m2_add, f8e5m2_sub, f8e5m2_mul,
@@ -608,14 +1174,549 @@ INV_OP_EXOTIC(bf16_t, bf16, BF16_ZERO, BF16_ONE, bf16_add, bf16_sub, bf16_mul, b
               bf16_abs, bf16_lt)
 INV_OP_EXOTIC(f16_t, f16, F16_ZERO, F16_ONE, f16_add, f16_sub, f16_mul, f16_div, f16_neg, f16_abs,
               f16_lt)
-INV_OP(int8_t, i8)
-INV_OP(int16_t, i16)
-INV_OP(int32_t, i32)
-INV_OP(int64_t, i64)
-INV_OP(uint8_t, u8)
-INV_OP(uint16_t, u16)
-INV_OP(uint32_t, u32)
-INV_OP(uint64_t, u64)
+INV_OP(int8_t, i8, LINALG_NO_FAST)
+INV_OP(int16_t, i16, LINALG_NO_FAST)
+INV_OP(int32_t, i32, LINALG_NO_FAST)
+INV_OP(int64_t, i64, LINALG_NO_FAST)
+INV_OP(uint8_t, u8, LINALG_NO_FAST)
+INV_OP(uint16_t, u16, LINALG_NO_FAST)
+INV_OP(uint32_t, u32, LINALG_NO_FAST)
+INV_OP(uint64_t, u64, LINALG_NO_FAST)
+
+// ============================================================================
+// LINEAR SOLVE (SOLVE)
+// ============================================================================
+//
+// Solves A X = B for square A with batch support (f32, f64).
+// A: [..., N, N], B: [..., N, K] -> X: [..., N, K] (contiguous)
+//
+// Blocked LU with partial pivoting (as for det/inv), then forward and back
+// substitution on the K right-hand sides. A singular A yields inf/NaN like inv.
+// With USE_LAPACK, ops_linalg_lapack.c provides the public entry points
+// (gesv) and calls the _fallback kernels below for small matrices.
+//
+// Metadata layout:
+// - metadata[0]: batch_size (product of batch dimensions)
+// - metadata[1]: n (A is N×N)
+// - metadata[2]: k (number of right-hand sides)
+// - metadata[3]: ndim (of A and of B)
+// - metadata[4..4+ndim]: a_shape
+// - metadata[4+ndim..4+2*ndim]: a_strides
+// - metadata[4+2*ndim]: a_offset
+// - metadata[5+2*ndim..5+3*ndim]: b_shape
+// - metadata[5+3*ndim..5+4*ndim]: b_strides
+// - metadata[5+4*ndim]: b_offset
+
+// Batches of matrices below LINALG_BLOCKED_MIN (or enough large ones for every thread) run in
+// parallel; otherwise matrices go one at a time and their GEMM updates use the pool
+static void linalg_dispatch(size_t batch_size, size_t n, parallel_for_fn worker, void *args) {
+    if (n >= LINALG_BLOCKED_MIN && (batch_size <= 1 || batch_size < get_num_threads())) {
+        worker(0, batch_size, args);
+    } else {
+        parallel_for(0, batch_size, n >= LINALG_BLOCKED_MIN ? 1 : linalg_batch_grain(n), worker,
+                     args);
+    }
+}
+
+typedef struct {
+    const void *a;
+    const void *b;
+    void *output;
+    void *output2;
+    const size_t *metadata;
+} linalg_args_t;
+
+/// Macro for linear solve of one float type
+///
+/// @param TYPE C type of the elements
+/// @param TYPE_SUFFIX Suffix for function naming
+#define SOLVE_OP(TYPE, TYPE_SUFFIX)                                                                \
+    static void solve_##TYPE_SUFFIX##_worker(size_t start, size_t end, void *arg) {                \
+        const linalg_args_t *args = (const linalg_args_t *)arg;                                    \
+        const TYPE *a = (const TYPE *)args->a;                                                     \
+        const TYPE *b = (const TYPE *)args->b;                                                     \
+        TYPE *output = (TYPE *)args->output;                                                       \
+        const size_t *metadata = args->metadata;                                                   \
+        const size_t n = metadata[1];                                                              \
+        const size_t k = metadata[2];                                                              \
+        const size_t ndim = metadata[3];                                                           \
+        const size_t *a_shape = metadata + 4;                                                      \
+        const size_t *a_strides = a_shape + ndim;                                                  \
+        const size_t a_offset = a_strides[ndim];                                                   \
+        const size_t *b_strides = a_strides + 2 * ndim + 1;                                        \
+        const size_t b_offset = b_strides[ndim];                                                   \
+        const size_t a_rs = a_strides[ndim - 2], a_cs = a_strides[ndim - 1];                       \
+        const size_t b_rs = b_strides[ndim - 2], b_cs = b_strides[ndim - 1];                       \
+                                                                                                   \
+        const size_t lu_bytes = hodu_cpu_workspace_block_size(n * n * sizeof(TYPE));               \
+        const size_t tmp_bytes =                                                                   \
+            hodu_cpu_workspace_block_size(MAXIMUM(n * n, LINALG_BLOCK * k) * sizeof(TYPE));        \
+        char *ws = (char *)workspace_acquire(lu_bytes + tmp_bytes + n * sizeof(size_t));           \
+        if (!ws) {                                                                                 \
+            return;                                                                                \
+        }                                                                                          \
+        TYPE *lu = (TYPE *)ws;                                                                     \
+        TYPE *tmp = (TYPE *)(ws + lu_bytes);                                                       \
+        size_t *perm = (size_t *)(ws + lu_bytes + tmp_bytes);                                      \
+        for (size_t batch = start; batch < end; batch++) {                                         \
+            const TYPE *am = a + linalg_matrix_offset(ndim, a_shape, a_strides, a_offset, batch);  \
+            const TYPE *bm = b + linalg_matrix_offset(ndim, a_shape, b_strides, b_offset, batch);  \
+            TYPE *x = output + batch * n * k;                                                      \
+            for (size_t i = 0; i < n; i++) {                                                       \
+                for (size_t j = 0; j < n; j++) {                                                   \
+                    lu[i * n + j] = am[i * a_rs + j * a_cs];                                       \
+                }                                                                                  \
+            }                                                                                      \
+            lu_blocked_##TYPE_SUFFIX(lu, n, perm, tmp, false);                                     \
+            for (size_t i = 0; i < n; i++) {                                                       \
+                for (size_t j = 0; j < k; j++) {                                                   \
+                    x[i * k + j] = bm[perm[i] * b_rs + j * b_cs];                                  \
+                }                                                                                  \
+            }                                                                                      \
+            lu_solve_##TYPE_SUFFIX(lu, n, k, x, tmp);                                              \
+        }                                                                                          \
+        workspace_release(ws);                                                                     \
+    }                                                                                              \
+                                                                                                   \
+    void hodu_cpu_solve_##TYPE_SUFFIX##_fallback(const void *a, const void *b, void *output,       \
+                                                 const size_t *metadata) {                         \
+        if (metadata[1] == 0 || metadata[2] == 0) {                                                \
+            return;                                                                                \
+        }                                                                                          \
+        linalg_args_t args = {a, b, output, NULL, metadata};                                       \
+        linalg_dispatch(metadata[0], metadata[1], solve_##TYPE_SUFFIX##_worker, &args);            \
+    }
+
+size_t hodu_cpu_solve_workspace_size(const size_t *metadata) {
+    const size_t n = metadata[1];
+    const size_t k = metadata[2];
+    const size_t lu_bytes = hodu_cpu_workspace_block_size(n * n * sizeof(f64_t));
+    const size_t tmp_bytes =
+        hodu_cpu_workspace_block_size(MAXIMUM(n * n, LINALG_BLOCK * k) * sizeof(f64_t));
+    return hodu_cpu_workspace_block_size(lu_bytes + tmp_bytes + n * sizeof(size_t)) +
+           HODU_CPU_WORKSPACE_ALIGN;
+}
+
+SOLVE_OP(f32_t, f32)
+SOLVE_OP(f64_t, f64)
+
+// ============================================================================
+// CHOLESKY DECOMPOSITION
+// ============================================================================
+//
+// Factors symmetric positive-definite matrices as A = L L^T with batch support
+// (f32, f64). Only the lower triangle of A is read.
+// Input: [..., N, N] -> Output: L [..., N, N] (contiguous, zero above the diagonal)
+//
+// Blocked right-looking algorithm: each LINALG_BLOCK-wide diagonal block is
+// factored, the panel below it solved against it, and the trailing lower
+// triangle updated one block column at a time with GEMM. A matrix that is not
+// positive definite yields an all-NaN L.
+//
+// Metadata layout (same as det/inv):
+// - metadata[0]: batch_size
+// - metadata[1]: n (matrix size, N×N)
+// - metadata[2]: ndim
+// - metadata[3..3+ndim]: shape
+// - metadata[3+ndim..3+2*ndim]: strides
+// - metadata[3+2*ndim]: offset
+
+/// Macro for Cholesky decomposition of one float type
+///
+/// @param TYPE C type of the elements
+/// @param TYPE_SUFFIX Suffix for function naming
+/// @param GEMM_FN Native GEMM of TYPE (gemm.h)
+/// @param SQRT_FN Square root of TYPE
+#define CHOLESKY_OP(TYPE, TYPE_SUFFIX, GEMM_FN, SQRT_FN)                                           \
+    /* In-place Cholesky of the row-major n x n lower triangle of l; false if not positive */      \
+    /* definite. tmp holds (n - LINALG_BLOCK) * LINALG_BLOCK elements */                           \
+    static bool cholesky_blocked_##TYPE_SUFFIX(TYPE *l, size_t n, TYPE *tmp) {                     \
+        for (size_t kb = 0; kb < n; kb += LINALG_BLOCK) {                                          \
+            const size_t ke = MINIMUM(kb + LINALG_BLOCK, n);                                       \
+            /* Diagonal block, then the rows below it, against L11 */                              \
+            for (size_t j = kb; j < ke; j++) {                                                     \
+                TYPE d = l[j * n + j];                                                             \
+                for (size_t p = kb; p < j; p++) {                                                  \
+                    d -= l[j * n + p] * l[j * n + p];                                              \
+                }                                                                                  \
+                if (!(d > (TYPE)0)) {                                                              \
+                    return false;                                                                  \
+                }                                                                                  \
+                const TYPE ljj = SQRT_FN(d);                                                       \
+                l[j * n + j] = ljj;                                                                \
+                for (size_t i = j + 1; i < n; i++) {                                               \
+                    TYPE s = l[i * n + j];                                                         \
+                    for (size_t p = kb; p < j; p++) {                                              \
+                        s -= l[i * n + p] * l[j * n + p];                                          \
+                    }                                                                              \
+                    l[i * n + j] = s / ljj;                                                        \
+                }                                                                                  \
+            }                                                                                      \
+            /* A22 -= L21 L21^T, lower triangle, one block column at a time */                     \
+            for (size_t jb = ke; jb < n; jb += LINALG_BLOCK) {                                     \
+                const size_t je = MINIMUM(jb + LINALG_BLOCK, n);                                   \
+                const size_t rows = n - jb, cols = je - jb;                                        \
+                GEMM_FN(rows, cols, ke - kb, l + jb * n + kb, n, 1, l + jb * n + kb, 1, n, tmp,    \
+                        cols);                                                                     \
+                for (size_t i = 0; i < rows; i++) {                                                \
+                    TYPE *row = l + (jb + i) * n + jb;                                             \
+                    const size_t width = MINIMUM(cols, i + 1);                                     \
+                    for (size_t j = 0; j < width; j++) {                                           \
+                        row[j] -= tmp[i * cols + j];                                               \
+                    }                                                                              \
+                }                                                                                  \
+            }                                                                                      \
+        }                                                                                          \
+        return true;                                                                               \
+    }                                                                                              \
+                                                                                                   \
+    static void cholesky_##TYPE_SUFFIX##_worker(size_t start, size_t end, void *arg) {             \
+        const linalg_args_t *args = (const linalg_args_t *)arg;                                    \
+        const TYPE *input = (const TYPE *)args->a;                                                 \
+        TYPE *output = (TYPE *)args->output;                                                       \
+        const size_t *metadata = args->metadata;                                                   \
+        const size_t n = metadata[1];                                                              \
+        const size_t ndim = metadata[2];                                                           \
+        const size_t *strides = metadata + 3 + ndim;                                               \
+        const size_t row_stride = (ndim >= 2) ? strides[ndim - 2] : n;                             \
+        const size_t col_stride = (ndim >= 1) ? strides[ndim - 1] : 1;                             \
+        TYPE *tmp = NULL;                                                                          \
+        if (n > LINALG_BLOCK) {                                                                    \
+            tmp = (TYPE *)workspace_acquire(n * LINALG_BLOCK * sizeof(TYPE));                      \
+            if (!tmp) {                                                                            \
+                return;                                                                            \
+            }                                                                                      \
+        }                                                                                          \
+        for (size_t batch = start; batch < end; batch++) {                                         \
+            const TYPE *am = input + linalg_batch_offset(metadata, batch);                         \
+            TYPE *l = output + batch * n * n;                                                      \
+            for (size_t i = 0; i < n; i++) {                                                       \
+                for (size_t j = 0; j < n; j++) {                                                   \
+                    l[i * n + j] = j <= i ? am[i * row_stride + j * col_stride] : (TYPE)0;         \
+                }                                                                                  \
+            }                                                                                      \
+            if (!cholesky_blocked_##TYPE_SUFFIX(l, n, tmp)) {                                      \
+                for (size_t i = 0; i < n * n; i++) {                                               \
+                    l[i] = (TYPE)NAN;                                                              \
+                }                                                                                  \
+            }                                                                                      \
+        }                                                                                          \
+        if (tmp) {                                                                                 \
+            workspace_release(tmp);                                                                \
+        }                                                                                          \
+    }                                                                                              \
+                                                                                                   \
+    void hodu_cpu_cholesky_##TYPE_SUFFIX##_fallback(const void *input, void *output,               \
+                                                    const size_t *metadata) {                      \
+        linalg_args_t args = {input, NULL, output, NULL, metadata};                                \
+        linalg_dispatch(metadata[0], metadata[1], cholesky_##TYPE_SUFFIX##_worker, &args);         \
+    }
+
+size_t hodu_cpu_cholesky_workspace_size(const size_t *metadata) {
+    const size_t n = metadata[1];
+    return n > LINALG_BLOCK
+               ? hodu_cpu_workspace_block_size(n * LINALG_BLOCK * sizeof(f64_t)) +
+                     HODU_CPU_WORKSPACE_ALIGN
+               : 0;
+}
+
+CHOLESKY_OP(f32_t, f32, hodu_cpu_gemm_f32, sqrtf)
+CHOLESKY_OP(f64_t, f64, hodu_cpu_gemm_f64, sqrt)
+
+// ============================================================================
+// QR DECOMPOSITION
+// ============================================================================
+//
+// Reduced QR factorization A = Q R with batch support (f32, f64).
+// Input: [..., M, N] -> Q: [..., M, K], R: [..., K, N] (contiguous), K = min(M, N)
+//
+// Blocked Householder QR (LAPACK geqrf/orgqr conventions: R may have negative
+// diagonal entries). Each LINALG_BLOCK-wide panel is factored column by column,
+// its reflectors are combined into I - V T V^T, and that block reflector is
+// applied to the trailing columns -- and later, in reverse panel order, to Q --
+// with two GEMMs and a small triangular product.
+//
+// Metadata layout:
+// - metadata[0]: batch_size (product of batch dimensions)
+// - metadata[1]: m (rows)
+// - metadata[2]: n (columns)
+// - metadata[3]: ndim
+// - metadata[4..4+ndim]: shape
+// - metadata[4+ndim..4+2*ndim]: strides
+// - metadata[4+2*ndim]: offset
+
+// Block reflector products at least this large (rows * cols * panel width) use GEMM
+#define QR_GEMM_WORK ((size_t)1 << 15)
+
+/// Macro for QR decomposition of one float type
+///
+/// @param TYPE C type of the elements
+/// @param TYPE_SUFFIX Suffix for function naming
+/// @param GEMM_FN Native GEMM of TYPE (gemm.h)
+/// @param SQRT_FN Square root of TYPE
+#define QR_OP(TYPE, TYPE_SUFFIX, GEMM_FN, SQRT_FN)                                                 \
+    /* Copy the reflectors of panel [kb, kb + nb) of a (lda n) into v (rows x nb, unit lower) */   \
+    /* and form the upper triangular t (nb x nb) with H_kb ... H_kb+nb-1 = I - V T V^T */          \
+    static void qr_block_reflector_##TYPE_SUFFIX(const TYPE *a, size_t n, size_t kb, size_t nb,    \
+                                                 size_t rows, const TYPE *tau, TYPE *v,            \
+                                                 TYPE *t) {                                        \
+        for (size_t i = 0; i < rows; i++) {                                                        \
+            for (size_t c = 0; c < nb; c++) {                                                      \
+                v[i * nb + c] = i == c ? (TYPE)1 : i > c ? a[(kb + i) * n + kb + c] : (TYPE)0;     \
+            }                                                                                      \
+        }                                                                                          \
+        for (size_t c = 0; c < nb; c++) {                                                          \
+            /* t[0:c, c] = -tau_c T[0:c, 0:c] (V[:, 0:c]^T v_c) */                                 \
+            for (size_t r = 0; r < c; r++) {                                                       \
+                TYPE y = (TYPE)0;                                                                  \
+                for (size_t i = c; i < rows; i++) {                                                \
+                    y += v[i * nb + r] * v[i * nb + c];                                            \
+                }                                                                                  \
+                t[r * nb + c] = y;                                                                 \
+            }                                                                                      \
+            for (size_t r = 0; r < c; r++) {                                                       \
+                TYPE s = (TYPE)0;                                                                  \
+                for (size_t q = r; q < c; q++) {                                                   \
+                    s += t[r * nb + q] * t[q * nb + c];                                            \
+                }                                                                                  \
+                t[r * nb + c] = -tau[c] * s;                                                       \
+            }                                                                                      \
+            t[c * nb + c] = tau[c];                                                                \
+            for (size_t r = c + 1; r < nb; r++) {                                                  \
+                t[r * nb + c] = (TYPE)0;                                                           \
+            }                                                                                      \
+        }                                                                                          \
+    }                                                                                              \
+                                                                                                   \
+    /* C -= V op(T) V^T C for the rows x cols block c (ldc), op(T) = T^T if transpose; */          \
+    /* w holds nb * cols and tmp rows * cols elements */                                           \
+    static void qr_apply_##TYPE_SUFFIX(const TYPE *v, const TYPE *t, size_t nb, size_t rows,       \
+                                       size_t cols, TYPE *c, size_t ldc, bool transpose, TYPE *w,  \
+                                       TYPE *tmp) {                                                \
+        const bool gemm = rows * cols * nb >= QR_GEMM_WORK;                                        \
+        /* w = V^T C */                                                                            \
+        if (gemm) {                                                                                \
+            GEMM_FN(nb, cols, rows, v, 1, nb, c, ldc, 1, w, cols);                                 \
+        } else {                                                                                   \
+            for (size_t r = 0; r < nb * cols; r++) {                                               \
+                w[r] = (TYPE)0;                                                                    \
+            }                                                                                      \
+            for (size_t i = 0; i < rows; i++) {                                                    \
+                for (size_t r = 0; r < nb; r++) {                                                  \
+                    const TYPE vir = v[i * nb + r];                                                \
+                    for (size_t j = 0; j < cols; j++) {                                            \
+                        w[r * cols + j] += vir * c[i * ldc + j];                                   \
+                    }                                                                              \
+                }                                                                                  \
+            }                                                                                      \
+        }                                                                                          \
+        /* w = op(T) w, in place: T^T is lower (rows descending), T upper (ascending) */           \
+        for (size_t s = 0; s < nb; s++) {                                                          \
+            const size_t r = transpose ? nb - 1 - s : s;                                           \
+            for (size_t j = 0; j < cols; j++) {                                                    \
+                TYPE acc = (TYPE)0;                                                                \
+                if (transpose) {                                                                   \
+                    for (size_t q = 0; q <= r; q++) {                                              \
+                        acc += t[q * nb + r] * w[q * cols + j];                                    \
+                    }                                                                              \
+                } else {                                                                           \
+                    for (size_t q = r; q < nb; q++) {                                              \
+                        acc += t[r * nb + q] * w[q * cols + j];                                    \
+                    }                                                                              \
+                }                                                                                  \
+                tmp[j] = acc;                                                                      \
+            }                                                                                      \
+            for (size_t j = 0; j < cols; j++) {                                                    \
+                w[r * cols + j] = tmp[j];                                                          \
+            }                                                                                      \
+        }                                                                                          \
+        /* C -= V w */                                                                             \
+        if (gemm) {                                                                                \
+            GEMM_FN(rows, cols, nb, v, nb, 1, w, cols, 1, tmp, cols);                              \
+            for (size_t i = 0; i < rows; i++) {                                                    \
+                for (size_t j = 0; j < cols; j++) {                                                \
+                    c[i * ldc + j] -= tmp[i * cols + j];                                           \
+                }                                                                                  \
+            }                                                                                      \
+        } else {                                                                                   \
+            for (size_t i = 0; i < rows; i++) {                                                    \
+                for (size_t r = 0; r < nb; r++) {                                                  \
+                    const TYPE vir = v[i * nb + r];                                                \
+                    for (size_t j = 0; j < cols; j++) {                                            \
+                        c[i * ldc + j] -= vir * w[r * cols + j];                                   \
+                    }                                                                              \
+                }                                                                                  \
+            }                                                                                      \
+        }                                                                                          \
+    }                                                                                              \
+                                                                                                   \
+    static void qr_##TYPE_SUFFIX##_worker(size_t start, size_t end, void *arg) {                   \
+        const linalg_args_t *args = (const linalg_args_t *)arg;                                    \
+        const TYPE *input = (const TYPE *)args->a;                                                 \
+        TYPE *q_out = (TYPE *)args->output;                                                        \
+        TYPE *r_out = (TYPE *)args->output2;                                                       \
+        const size_t *metadata = args->metadata;                                                   \
+        const size_t m = metadata[1];                                                              \
+        const size_t n = metadata[2];                                                              \
+        const size_t ndim = metadata[3];                                                           \
+        const size_t *shape = metadata + 4;                                                        \
+        const size_t *strides = shape + ndim;                                                      \
+        const size_t offset = strides[ndim];                                                       \
+        const size_t rs = strides[ndim - 2], cs = strides[ndim - 1];                               \
+        const size_t k = MINIMUM(m, n);                                                            \
+        const size_t nbmax = MINIMUM(k, LINALG_BLOCK);                                             \
+                                                                                                   \
+        const size_t a_bytes = hodu_cpu_workspace_block_size(m * n * sizeof(TYPE));                \
+        const size_t v_bytes = hodu_cpu_workspace_block_size(m * nbmax * sizeof(TYPE));            \
+        const size_t t_bytes = hodu_cpu_workspace_block_size(nbmax * nbmax * sizeof(TYPE));        \
+        const size_t w_bytes = hodu_cpu_workspace_block_size(nbmax * n * sizeof(TYPE));            \
+        char *ws = (char *)workspace_acquire(2 * a_bytes + v_bytes + t_bytes + w_bytes +           \
+                                             k * sizeof(TYPE));                                    \
+        if (!ws) {                                                                                 \
+            return;                                                                                \
+        }                                                                                          \
+        TYPE *a = (TYPE *)ws;                                                                      \
+        TYPE *tmp = (TYPE *)(ws + a_bytes);                                                        \
+        TYPE *v = (TYPE *)(ws + 2 * a_bytes);                                                      \
+        TYPE *t = (TYPE *)(ws + 2 * a_bytes + v_bytes);                                            \
+        TYPE *w = (TYPE *)(ws + 2 * a_bytes + v_bytes + t_bytes);                                  \
+        TYPE *tau = (TYPE *)(ws + 2 * a_bytes + v_bytes + t_bytes + w_bytes);                      \
+                                                                                                   \
+        for (size_t batch = start; batch < end; batch++) {                                         \
+            const TYPE *am = input + linalg_matrix_offset(ndim, shape, strides, offset, batch);    \
+            for (size_t i = 0; i < m; i++) {                                                       \
+                for (size_t j = 0; j < n; j++) {                                                   \
+                    a[i * n + j] = am[i * rs + j * cs];                                            \
+                }                                                                                  \
+            }                                                                                      \
+                                                                                                   \
+            for (size_t kb = 0; kb < k; kb += LINALG_BLOCK) {                                      \
+                const size_t ke = MINIMUM(kb + LINALG_BLOCK, k);                                   \
+                /* Panel: Householder reflectors for columns [kb, ke) */                           \
+                for (size_t j = kb; j < ke; j++) {                                                 \
+                    const TYPE alpha = a[j * n + j];                                               \
+                    TYPE xnorm2 = (TYPE)0;                                                         \
+                    for (size_t i = j + 1; i < m; i++) {                                           \
+                        xnorm2 += a[i * n + j] * a[i * n + j];                                     \
+                    }                                                                              \
+                    if (xnorm2 == (TYPE)0) {                                                       \
+                        tau[j] = (TYPE)0;                                                          \
+                        continue;                                                                  \
+                    }                                                                              \
+                    TYPE beta = SQRT_FN(alpha * alpha + xnorm2);                                   \
+                    beta = alpha >= (TYPE)0 ? -beta : beta;                                        \
+                    tau[j] = (beta - alpha) / beta;                                                \
+                    const TYPE scale = (TYPE)1 / (alpha - beta);                                   \
+                    for (size_t i = j + 1; i < m; i++) {                                           \
+                        a[i * n + j] *= scale;                                                     \
+                    }                                                                              \
+                    a[j * n + j] = beta;                                                           \
+                    for (size_t c = j + 1; c < ke; c++) {                                          \
+                        TYPE s = a[j * n + c];                                                     \
+                        for (size_t i = j + 1; i < m; i++) {                                       \
+                            s += a[i * n + j] * a[i * n + c];                                      \
+                        }                                                                          \
+                        s *= tau[j];                                                               \
+                        a[j * n + c] -= s;                                                         \
+                        for (size_t i = j + 1; i < m; i++) {                                       \
+                            a[i * n + c] -= s * a[i * n + j];                                      \
+                        }                                                                          \
+                    }                                                                              \
+                }                                                                                  \
+                if (ke < n) {                                                                      \
+                    qr_block_reflector_##TYPE_SUFFIX(a, n, kb, ke - kb, m - kb, tau + kb, v, t);   \
+                    qr_apply_##TYPE_SUFFIX(v, t, ke - kb, m - kb, n - ke, a + kb * n + ke, n,      \
+                                           true, w, tmp);                                          \
+                }                                                                                  \
+            }                                                                                      \
+                                                                                                   \
+            TYPE *r = r_out + batch * k * n;                                                       \
+            for (size_t i = 0; i < k; i++) {                                                       \
+                for (size_t j = 0; j < n; j++) {                                                   \
+                    r[i * n + j] = j >= i ? a[i * n + j] : (TYPE)0;                                \
+                }                                                                                  \
+            }                                                                                      \
+                                                                                                   \
+            /* Q = H_0 ... H_k-1 I[:, :k], panels applied in reverse */                            \
+            TYPE *q = q_out + batch * m * k;                                                       \
+            for (size_t i = 0; i < m; i++) {                                                       \
+                for (size_t j = 0; j < k; j++) {                                                   \
+                    q[i * k + j] = i == j ? (TYPE)1 : (TYPE)0;                                     \
+                }                                                                                  \
+            }                                                                                      \
+            for (size_t kb = (k - 1) / LINALG_BLOCK * LINALG_BLOCK;; kb -= LINALG_BLOCK) {         \
+                const size_t ke = MINIMUM(kb + LINALG_BLOCK, k);                                   \
+                qr_block_reflector_##TYPE_SUFFIX(a, n, kb, ke - kb, m - kb, tau + kb, v, t);       \
+                qr_apply_##TYPE_SUFFIX(v, t, ke - kb, m - kb, k - kb, q + kb * k + kb, k, false,   \
+                                       w, tmp);                                                    \
+                if (kb == 0) {                                                                     \
+                    break;                                                                         \
+                }                                                                                  \
+            }                                                                                      \
+        }                                                                                          \
+        workspace_release(ws);                                                                     \
+    }                                                                                              \
+                                                                                                   \
+    void hodu_cpu_qr_##TYPE_SUFFIX##_fallback(const void *input, void *q, void *r,                 \
+                                              const size_t *metadata) {                            \
+        if (metadata[1] == 0 || metadata[2] == 0) {                                                \
+            return;                                                                                \
+        }                                                                                          \
+        linalg_args_t args = {input, NULL, q, r, metadata};                                        \
+        linalg_dispatch(metadata[0], MAXIMUM(metadata[1], metadata[2]),                            \
+                        qr_##TYPE_SUFFIX##_worker, &args);                                         \
+    }
+
+size_t hodu_cpu_qr_workspace_size(const size_t *metadata) {
+    const size_t m = metadata[1];
+    const size_t n = metadata[2];
+    const size_t k = MINIMUM(m, n);
+    const size_t nb = MINIMUM(k, LINALG_BLOCK);
+    const size_t bytes = 2 * hodu_cpu_workspace_block_size(m * n * sizeof(f64_t)) +
+                         hodu_cpu_workspace_block_size(m * nb * sizeof(f64_t)) +
+                         hodu_cpu_workspace_block_size(nb * nb * sizeof(f64_t)) +
+                         hodu_cpu_workspace_block_size(nb * n * sizeof(f64_t)) +
+                         k * sizeof(f64_t);
+    return hodu_cpu_workspace_block_size(bytes) + HODU_CPU_WORKSPACE_ALIGN;
+}
+
+QR_OP(f32_t, f32, hodu_cpu_gemm_f32, sqrtf)
+QR_OP(f64_t, f64, hodu_cpu_gemm_f64, sqrt)
+
+#ifndef USE_LAPACK
+// Without LAPACK the native kernels are the public entry points
+void hodu_cpu_solve_f32(const void *a, const void *b, void *output, const size_t *metadata) {
+    HODU_PROFILE_KERNEL(metadata[0] * metadata[1] * (metadata[1] + 2 * metadata[2]) *
+                        sizeof(f32_t));
+    hodu_cpu_solve_f32_fallback(a, b, output, metadata);
+}
+
+void hodu_cpu_solve_f64(const void *a, const void *b, void *output, const size_t *metadata) {
+    HODU_PROFILE_KERNEL(metadata[0] * metadata[1] * (metadata[1] + 2 * metadata[2]) *
+                        sizeof(f64_t));
+    hodu_cpu_solve_f64_fallback(a, b, output, metadata);
+}
+
+void hodu_cpu_cholesky_f32(const void *input, void *output, const size_t *metadata) {
+    HODU_PROFILE_KERNEL(metadata[0] * 2 * metadata[1] * metadata[1] * sizeof(f32_t));
+    hodu_cpu_cholesky_f32_fallback(input, output, metadata);
+}
+
+void hodu_cpu_cholesky_f64(const void *input, void *output, const size_t *metadata) {
+    HODU_PROFILE_KERNEL(metadata[0] * 2 * metadata[1] * metadata[1] * sizeof(f64_t));
+    hodu_cpu_cholesky_f64_fallback(input, output, metadata);
+}
+
+void hodu_cpu_qr_f32(const void *input, void *q, void *r, const size_t *metadata) {
+    HODU_PROFILE_KERNEL(hodu_cpu_profile_qr_bytes(metadata, sizeof(f32_t)));
+    hodu_cpu_qr_f32_fallback(input, q, r, metadata);
+}
+
+void hodu_cpu_qr_f64(const void *input, void *q, void *r, const size_t *metadata) {
+    HODU_PROFILE_KERNEL(hodu_cpu_profile_qr_bytes(metadata, sizeof(f64_t)));
+    hodu_cpu_qr_f64_fallback(input, q, r, metadata);
+}
+#endif // USE_LAPACK
 
 // ============================================================================
 // MATRIX TRACE
@@ -636,6 +1737,7 @@ INV_OP(uint64_t, u64)
 #define TRACE_OP(TYPE, TYPE_SUFFIX)                                                                \
     void hodu_cpu_trace_##TYPE_SUFFIX(const void *input_ptr, void *output_ptr,                     \
                                       const size_t *metadata) {                                    \
+        HODU_PROFILE_KERNEL(metadata[0] * (metadata[1] + 1) * sizeof(TYPE));                       \
         const TYPE *input = (const TYPE *)input_ptr;                                               \
         TYPE *output = (TYPE *)output_ptr;                                                         \
                                                                                                    \
@@ -677,6 +1779,7 @@ INV_OP(uint64_t, u64)
 #define TRACE_OP_EXOTIC(TYPE, TYPE_SUFFIX, ZERO, ADD_FN)                                           \
     void hodu_cpu_trace_##TYPE_SUFFIX(const void *input_ptr, void *output_ptr,                     \
                                       const size_t *metadata) {                                    \
+        HODU_PROFILE_KERNEL(metadata[0] * (metadata[1] + 1) * sizeof(TYPE));                       \
         const TYPE *input = (const TYPE *)input_ptr;                                               \
         TYPE *output = (TYPE *)output_ptr;                                                         \
                                                                                                    \
@@ -6,6 +6,9 @@
  * - det: Matrix determinant computation
  * - inv: Matrix inverse computation
  * - trace: Matrix trace computation (sum of diagonal)
+ * - solve: Linear system solve (A X = B)
+ * - cholesky: Cholesky decomposition (A = L L^T)
+ * - qr: Reduced QR decomposition (A = Q R)
  */
 
 #ifndef OPS_LINALG_H
@@ -54,6 +57,10 @@ void hodu_cpu_det_u16(const void *input, void *output, const size_t *metadata);
 void hodu_cpu_det_u32(const void *input, void *output, const size_t *metadata);
 void hodu_cpu_det_u64(const void *input, void *output, const size_t *metadata);
 
+/// Scratch bytes a det call takes from the calling thread's workspace (any dtype;
+/// see workspace.h). Batch tasks on pool workers use the workers' own arenas.
+size_t hodu_cpu_det_workspace_size(const size_t *metadata);
+
 // ============================================================================
 // MATRIX INVERSE (INV)
 // ============================================================================
@@ -94,6 +101,9 @@ void hodu_cpu_inv_u16(const void *input, void *output, const size_t *metadata);
 void hodu_cpu_inv_u32(const void *input, void *output, const size_t *metadata);
 void hodu_cpu_inv_u64(const void *input, void *output, const size_t *metadata);
 
+/// Scratch bytes an inv call takes from the calling thread's workspace (any dtype; see det)
+size_t hodu_cpu_inv_workspace_size(const size_t *metadata);
+
 // ============================================================================
 // MATRIX TRACE
 // ============================================================================
@@ -131,6 +141,100 @@ void hodu_cpu_trace_u16(const void *input, void *output, const size_t *metadata)
 void hodu_cpu_trace_u32(const void *input, void *output, const size_t *metadata);
 void hodu_cpu_trace_u64(const void *input, void *output, const size_t *metadata);
 
+// ============================================================================
+// LINEAR SOLVE (SOLVE)
+// ============================================================================
+//
+// Solves A X = B for square A with optional batch dimensions (f32, f64).
+// Uses blocked LU with partial pivoting, or LAPACK gesv when built with a
+// LAPACK-enabled OpenBLAS.
+//
+// All solve operations follow this signature:
+//   void hodu_cpu_solve_type(const void *a, const void *b, void *output,
+//                            const size_t *metadata)
+//
+// Parameters:
+//   a        - Pointer to A [..., N, N]
+//   b        - Pointer to B [..., N, K] (same batch shape as A)
+//   output   - Pointer to contiguous X [..., N, K]
+//   metadata - Array describing operation (see below)
+//
+// Metadata layout:
+// - metadata[0]: batch_size (product of batch dimensions)
+// - metadata[1]: n (A is N×N)
+// - metadata[2]: k (number of right-hand sides)
+// - metadata[3]: ndim (of A and of B)
+// - metadata[4..4+ndim]: a_shape
+// - metadata[4+ndim..4+2*ndim]: a_strides
+// - metadata[4+2*ndim]: a_offset
+// - metadata[5+2*ndim..5+3*ndim]: b_shape
+// - metadata[5+3*ndim..5+4*ndim]: b_strides
+// - metadata[5+4*ndim]: b_offset
+//
+// Note: For singular A, the output will contain inf/nan values.
+
+void hodu_cpu_solve_f32(const void *a, const void *b, void *output, const size_t *metadata);
+void hodu_cpu_solve_f64(const void *a, const void *b, void *output, const size_t *metadata);
+
+/// Scratch bytes a solve call takes from the calling thread's workspace (any dtype; see det)
+size_t hodu_cpu_solve_workspace_size(const size_t *metadata);
+
+// ============================================================================
+// CHOLESKY DECOMPOSITION
+// ============================================================================
+//
+// Computes the lower Cholesky factor L (A = L L^T) of symmetric positive-definite
+// matrices with optional batch dimensions (f32, f64). Only the lower triangle of
+// A is read; the upper triangle of L is zero.
+//
+// All cholesky operations follow this signature:
+//   void hodu_cpu_cholesky_type(const void *input, void *output, const size_t *metadata)
+//
+// Parameters:
+//   input    - Pointer to input tensor data (square matrix)
+//   output   - Pointer to contiguous L (same shape as input)
+//   metadata - Array describing operation (same as det/inv)
+//
+// Note: A matrix that is not positive definite yields an all-NaN L.
+
+void hodu_cpu_cholesky_f32(const void *input, void *output, const size_t *metadata);
+void hodu_cpu_cholesky_f64(const void *input, void *output, const size_t *metadata);
+
+/// Scratch bytes a cholesky call takes from the calling thread's workspace (any dtype; see det)
+size_t hodu_cpu_cholesky_workspace_size(const size_t *metadata);
+
+// ============================================================================
+// QR DECOMPOSITION
+// ============================================================================
+//
+// Computes the reduced QR factorization of M×N matrices with optional batch
+// dimensions (f32, f64), K = min(M, N). Householder reflectors follow the LAPACK
+// sign convention, so diagonal entries of R may be negative.
+//
+// All qr operations follow this signature:
+//   void hodu_cpu_qr_type(const void *input, void *q, void *r, const size_t *metadata)
+//
+// Parameters:
+//   input    - Pointer to input tensor data [..., M, N]
+//   q        - Pointer to contiguous Q [..., M, K] (orthonormal columns)
+//   r        - Pointer to contiguous R [..., K, N] (upper triangular)
+//   metadata - Array describing operation (see below)
+//
+// Metadata layout:
+// - metadata[0]: batch_size (product of batch dimensions)
+// - metadata[1]: m (rows)
+// - metadata[2]: n (columns)
+// - metadata[3]: ndim (total number of dimensions)
+// - metadata[4..4+ndim]: shape
+// - metadata[4+ndim..4+2*ndim]: strides
+// - metadata[4+2*ndim]: offset
+
+void hodu_cpu_qr_f32(const void *input, void *q, void *r, const size_t *metadata);
+void hodu_cpu_qr_f64(const void *input, void *q, void *r, const size_t *metadata);
+
+/// Scratch bytes a qr call takes from the calling thread's workspace (any dtype; see det)
+size_t hodu_cpu_qr_workspace_size(const size_t *metadata);
+
 #ifdef __cplusplus
 }
 #endif
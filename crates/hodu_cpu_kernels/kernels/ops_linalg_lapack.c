@@ -0,0 +1,202 @@
+#include "ops_linalg.h"
+#include "profile.h"
+#include "types.h"
+#include "utils.h"
+#include "workspace.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <lapacke.h>
+
+// Forward declarations for fallback implementations
+extern void hodu_cpu_solve_f32_fallback(const void *a, const void *b, void *output,
+                                        const size_t *metadata);
+extern void hodu_cpu_solve_f64_fallback(const void *a, const void *b, void *output,
+                                        const size_t *metadata);
+extern void hodu_cpu_cholesky_f32_fallback(const void *input, void *output,
+                                           const size_t *metadata);
+extern void hodu_cpu_cholesky_f64_fallback(const void *input, void *output,
+                                           const size_t *metadata);
+extern void hodu_cpu_qr_f32_fallback(const void *input, void *q, void *r, const size_t *metadata);
+extern void hodu_cpu_qr_f64_fallback(const void *input, void *q, void *r, const size_t *metadata);
+
+// Below this size the native kernels win: they run whole batches on the thread pool, while the
+// LAPACK calls here go one matrix at a time (each one threaded inside OpenBLAS)
+#define LAPACK_MIN_N 32
+
+// Offset of matrix `batch` given the leading (batch) dims of a strided operand
+static inline size_t lapack_matrix_offset(size_t ndim, const size_t *shape, const size_t *strides,
+                                          size_t offset, size_t batch) {
+    for (size_t d = ndim >= 2 ? ndim - 2 : 0; d-- > 0;) {
+        offset += (batch % shape[d]) * strides[d];
+        batch /= shape[d];
+    }
+    return offset;
+}
+
+/// Macro for the LAPACK-backed solve/cholesky/qr of one float type
+///
+/// Operands are gathered into contiguous row-major buffers (scratch from the workspace, within
+/// the native kernels' workspace sizes) and passed to LAPACKE with LAPACK_ROW_MAJOR; outputs
+/// match the native kernels, including NaN for a matrix that is not positive definite.
+///
+/// @param TYPE C type of the elements
+/// @param TYPE_SUFFIX Suffix for function naming
+/// @param P LAPACK precision prefix (s or d)
+#define LAPACK_LINALG_OP(TYPE, TYPE_SUFFIX, P)                                                     \
+    /* LAPACK gesv: LU with partial pivoting, then forward/back substitution */                    \
+    void hodu_cpu_solve_##TYPE_SUFFIX(const void *a_ptr, const void *b_ptr, void *output_ptr,      \
+                                      const size_t *metadata) {                                    \
+        HODU_PROFILE_KERNEL(metadata[0] * metadata[1] * (metadata[1] + 2 * metadata[2]) *          \
+                            sizeof(TYPE));                                                         \
+        const size_t batch_size = metadata[0];                                                     \
+        const size_t n = metadata[1];                                                              \
+        const size_t k = metadata[2];                                                              \
+        if (n < LAPACK_MIN_N && batch_size > 1) {                                                  \
+            hodu_cpu_solve_##TYPE_SUFFIX##_fallback(a_ptr, b_ptr, output_ptr, metadata);           \
+            return;                                                                                \
+        }                                                                                          \
+        if (n == 0 || k == 0) {                                                                    \
+            return;                                                                                \
+        }                                                                                          \
+        const TYPE *a = (const TYPE *)a_ptr;                                                       \
+        const TYPE *b = (const TYPE *)b_ptr;                                                       \
+        TYPE *output = (TYPE *)output_ptr;                                                         \
+        const size_t ndim = metadata[3];                                                           \
+        const size_t *a_shape = metadata + 4;                                                      \
+        const size_t *a_strides = a_shape + ndim;                                                  \
+        const size_t a_offset = a_strides[ndim];                                                   \
+        const size_t *b_strides = a_strides + 2 * ndim + 1;                                        \
+        const size_t b_offset = b_strides[ndim];                                                   \
+        const size_t a_rs = a_strides[ndim - 2], a_cs = a_strides[ndim - 1];                       \
+        const size_t b_rs = b_strides[ndim - 2], b_cs = b_strides[ndim - 1];                       \
+                                                                                                   \
+        const size_t lu_bytes = hodu_cpu_workspace_block_size(n * n * sizeof(TYPE));               \
+        char *ws = (char *)workspace_acquire(lu_bytes + n * sizeof(lapack_int));                   \
+        if (!ws) {                                                                                 \
+            return;                                                                                \
+        }                                                                                          \
+        TYPE *lu = (TYPE *)ws;                                                                     \
+        lapack_int *ipiv = (lapack_int *)(ws + lu_bytes);                                          \
+        HODU_PROFILE_PATH(HODU_CPU_PATH_BLAS);                                                     \
+        for (size_t batch = 0; batch < batch_size; batch++) {                                      \
+            const TYPE *am = a + lapack_matrix_offset(ndim, a_shape, a_strides, a_offset, batch);  \
+            const TYPE *bm = b + lapack_matrix_offset(ndim, a_shape, b_strides, b_offset, batch);  \
+            TYPE *x = output + batch * n * k;                                                      \
+            for (size_t i = 0; i < n; i++) {                                                       \
+                for (size_t j = 0; j < n; j++) {                                                   \
+                    lu[i * n + j] = am[i * a_rs + j * a_cs];                                       \
+                }                                                                                  \
+                for (size_t j = 0; j < k; j++) {                                                   \
+                    x[i * k + j] = bm[i * b_rs + j * b_cs];                                        \
+                }                                                                                  \
+            }                                                                                      \
+            if (LAPACKE_##P##gesv(LAPACK_ROW_MAJOR, (lapack_int)n, (lapack_int)k, lu,              \
+                                  (lapack_int)n, ipiv, x, (lapack_int)k) > 0) {                    \
+                /* Exactly singular: LAPACK stops before solving; match the native inf/NaN */      \
+                for (size_t i = 0; i < n * k; i++) {                                               \
+                    x[i] = (TYPE)NAN;                                                              \
+                }                                                                                  \
+            }                                                                                      \
+        }                                                                                          \
+        workspace_release(ws);                                                                     \
+    }                                                                                              \
+                                                                                                   \
+    /* LAPACK potrf on the lower triangle, factored in place in the output */                      \
+    void hodu_cpu_cholesky_##TYPE_SUFFIX(const void *input_ptr, void *output_ptr,                  \
+                                         const size_t *metadata) {                                 \
+        HODU_PROFILE_KERNEL(metadata[0] * 2 * metadata[1] * metadata[1] * sizeof(TYPE));           \
+        const size_t batch_size = metadata[0];                                                     \
+        const size_t n = metadata[1];                                                              \
+        if (n < LAPACK_MIN_N && batch_size > 1) {                                                  \
+            hodu_cpu_cholesky_##TYPE_SUFFIX##_fallback(input_ptr, output_ptr, metadata);           \
+            return;                                                                                \
+        }                                                                                          \
+        const TYPE *input = (const TYPE *)input_ptr;                                               \
+        TYPE *output = (TYPE *)output_ptr;                                                         \
+        const size_t ndim = metadata[2];                                                           \
+        const size_t *shape = metadata + 3;                                                        \
+        const size_t *strides = shape + ndim;                                                      \
+        const size_t offset = strides[ndim];                                                       \
+        const size_t rs = (ndim >= 2) ? strides[ndim - 2] : n;                                     \
+        const size_t cs = (ndim >= 1) ? strides[ndim - 1] : 1;                                     \
+        HODU_PROFILE_PATH(HODU_CPU_PATH_BLAS);                                                     \
+        for (size_t batch = 0; batch < batch_size; batch++) {                                      \
+            const TYPE *am = input + lapack_matrix_offset(ndim, shape, strides, offset, batch);    \
+            TYPE *l = output + batch * n * n;                                                      \
+            for (size_t i = 0; i < n; i++) {                                                       \
+                for (size_t j = 0; j < n; j++) {                                                   \
+                    l[i * n + j] = j <= i ? am[i * rs + j * cs] : (TYPE)0;                         \
+                }                                                                                  \
+            }                                                                                      \
+            if (n > 0 &&                                                                           \
+                LAPACKE_##P##potrf(LAPACK_ROW_MAJOR, 'L', (lapack_int)n, l, (lapack_int)n) != 0) { \
+                for (size_t i = 0; i < n * n; i++) {                                               \
+                    l[i] = (TYPE)NAN;                                                              \
+                }                                                                                  \
+            }                                                                                      \
+        }                                                                                          \
+    }                                                                                              \
+                                                                                                   \
+    /* LAPACK geqrf, then orgqr for the first min(m, n) columns of Q */                            \
+    void hodu_cpu_qr_##TYPE_SUFFIX(const void *input_ptr, void *q_ptr, void *r_ptr,                \
+                                   const size_t *metadata) {                                       \
+        HODU_PROFILE_KERNEL(hodu_cpu_profile_qr_bytes(metadata, sizeof(TYPE)));                    \
+        const size_t batch_size = metadata[0];                                                     \
+        const size_t m = metadata[1];                                                              \
+        const size_t n = metadata[2];                                                              \
+        if (MAXIMUM(m, n) < LAPACK_MIN_N && batch_size > 1) {                                      \
+            hodu_cpu_qr_##TYPE_SUFFIX##_fallback(input_ptr, q_ptr, r_ptr, metadata);               \
+            return;                                                                                \
+        }                                                                                          \
+        if (m == 0 || n == 0) {                                                                    \
+            return;                                                                                \
+        }                                                                                          \
+        const TYPE *input = (const TYPE *)input_ptr;                                               \
+        TYPE *q_out = (TYPE *)q_ptr;                                                               \
+        TYPE *r_out = (TYPE *)r_ptr;                                                               \
+        const size_t ndim = metadata[3];                                                           \
+        const size_t *shape = metadata + 4;                                                        \
+        const size_t *strides = shape + ndim;                                                      \
+        const size_t offset = strides[ndim];                                                       \
+        const size_t rs = strides[ndim - 2], cs = strides[ndim - 1];                               \
+        const size_t k = MINIMUM(m, n);                                                            \
+                                                                                                   \
+        const size_t a_bytes = hodu_cpu_workspace_block_size(m * n * sizeof(TYPE));                \
+        char *ws = (char *)workspace_acquire(a_bytes + k * sizeof(TYPE));                          \
+        if (!ws) {                                                                                 \
+            return;                                                                                \
+        }                                                                                          \
+        TYPE *a = (TYPE *)ws;                                                                      \
+        TYPE *tau = (TYPE *)(ws + a_bytes);                                                        \
+        HODU_PROFILE_PATH(HODU_CPU_PATH_BLAS);                                                     \
+        for (size_t batch = 0; batch < batch_size; batch++) {                                      \
+            const TYPE *am = input + lapack_matrix_offset(ndim, shape, strides, offset, batch);    \
+            for (size_t i = 0; i < m; i++) {                                                       \
+                for (size_t j = 0; j < n; j++) {                                                   \
+                    a[i * n + j] = am[i * rs + j * cs];                                            \
+                }                                                                                  \
+            }                                                                                      \
+            LAPACKE_##P##geqrf(LAPACK_ROW_MAJOR, (lapack_int)m, (lapack_int)n, a, (lapack_int)n,   \
+                               tau);                                                               \
+            TYPE *r = r_out + batch * k * n;                                                       \
+            for (size_t i = 0; i < k; i++) {                                                       \
+                for (size_t j = 0; j < n; j++) {                                                   \
+                    r[i * n + j] = j >= i ? a[i * n + j] : (TYPE)0;                                \
+                }                                                                                  \
+            }                                                                                      \
+            /* The reflectors live in the first k columns; expand them in place with lda n */      \
+            LAPACKE_##P##orgqr(LAPACK_ROW_MAJOR, (lapack_int)m, (lapack_int)k, (lapack_int)k, a,   \
+                               (lapack_int)n, tau);                                                \
+            TYPE *q = q_out + batch * m * k;                                                       \
+            for (size_t i = 0; i < m; i++) {                                                       \
+                for (size_t j = 0; j < k; j++) {                                                   \
+                    q[i * k + j] = a[i * n + j];                                                   \
+                }                                                                                  \
+            }                                                                                      \
+        }                                                                                          \
+        workspace_release(ws);                                                                     \
+    }
+
+LAPACK_LINALG_OP(f32_t, f32, s)
+LAPACK_LINALG_OP(f64_t, f64, d)
@@ -1,8 +1,11 @@
 #include "ops_matrix.h"
+#include "gemm.h"
+#include "profile.h"
 #include "thread_utils.h"
 #include "types.h"
 #include <stdbool.h>
 #include <stdint.h>
+#include <stdlib.h>
 #include <string.h>
 
 // ============================================================================
@@ -29,17 +32,86 @@
 // - metadata[...+4]: N (cols of rhs matrix)
 //
 // Algorithm:
-// For each output element (batch_idx, i, j):
-// 1. Decompose flat batch_idx into multi-dimensional batch indices
-// 2. Map batch indices to lhs/rhs with broadcasting (size 1 dims stay at 0)
-// 3. Compute dot product: sum_k lhs[batch, i, k] * rhs[batch, k, j]
+// For each output batch:
+// 1. Decompose flat batch index into multi-dimensional batch indices (once per batch)
+// 2. Map batch indices to lhs/rhs offsets with broadcasting (size 1 dims stay at 0)
+// 3. Compute the MxKxN block: packed GEMM for floats, row-parallel i-k-j loop for integers
+//    (batches and rows of all batches are spread across pool threads)
 //
 // Broadcasting:
 // Batch dimensions of size 1 are broadcast by using index 0 for that dimension.
 
+/// Matmul metadata unpacked once per call
+typedef struct {
+    size_t num_batches;
+    size_t M, K, N;
+    size_t batch_ndim, lhs_batch_ndim, rhs_batch_ndim;
+    const size_t *lhs_shape, *rhs_shape, *batch_shape;
+    const size_t *lhs_strides, *rhs_strides;
+    size_t lhs_offset, rhs_offset;
+    size_t lhs_rs, lhs_cs, rhs_rs, rhs_cs;
+} matmul_layout_t;
+
+static void matmul_parse_layout(const size_t *metadata, matmul_layout_t *l) {
+    const size_t num_els = metadata[0];
+    const size_t lhs_ndim = metadata[1];
+    const size_t rhs_ndim = metadata[2];
+    l->batch_ndim = metadata[3];
+
+    l->lhs_shape = metadata + 4;
+    l->rhs_shape = l->lhs_shape + lhs_ndim;
+    l->batch_shape = l->rhs_shape + rhs_ndim;
+    l->lhs_strides = l->batch_shape + l->batch_ndim;
+    l->rhs_strides = l->lhs_strides + lhs_ndim;
+    l->lhs_offset = *(l->rhs_strides + rhs_ndim);
+    l->rhs_offset = *(l->rhs_strides + rhs_ndim + 1);
+    l->M = *(l->rhs_strides + rhs_ndim + 2);
+    l->K = *(l->rhs_strides + rhs_ndim + 3);
+    l->N = *(l->rhs_strides + rhs_ndim + 4);
+
+    l->lhs_batch_ndim = lhs_ndim - 2;
+    l->rhs_batch_ndim = rhs_ndim - 2;
+    l->lhs_rs = l->lhs_strides[lhs_ndim - 2];
+    l->lhs_cs = l->lhs_strides[lhs_ndim - 1];
+    l->rhs_rs = l->rhs_strides[rhs_ndim - 2];
+    l->rhs_cs = l->rhs_strides[rhs_ndim - 1];
+    l->num_batches = (l->M == 0 || l->N == 0) ? 0 : num_els / (l->M * l->N);
+}
+
+/// Map an output batch index to lhs/rhs element offsets (size 1 dims broadcast)
+static inline void matmul_batch_offsets(const matmul_layout_t *l, size_t batch, size_t *lhs_off,
+                                        size_t *rhs_off) {
+    size_t lhs_batch_offset = l->lhs_offset;
+    size_t rhs_batch_offset = l->rhs_offset;
+    size_t temp = batch;
+    for (int d = (int)l->batch_ndim - 1; d >= 0; d--) {
+        size_t idx = temp % l->batch_shape[d];
+        temp /= l->batch_shape[d];
+
+        int lhs_d = d - (int)(l->batch_ndim - l->lhs_batch_ndim);
+        if (lhs_d >= 0 && l->lhs_shape[lhs_d] != 1) {
+            lhs_batch_offset += idx * l->lhs_strides[lhs_d];
+        }
+        int rhs_d = d - (int)(l->batch_ndim - l->rhs_batch_ndim);
+        if (rhs_d >= 0 && l->rhs_shape[rhs_d] != 1) {
+            rhs_batch_offset += idx * l->rhs_strides[rhs_d];
+        }
+    }
+    *lhs_off = lhs_batch_offset;
+    *rhs_off = rhs_batch_offset;
+}
+
+/// Rows per task for the generic row-parallel matmul (K * N multiply-adds per row)
+static inline size_t matmul_row_grain(const matmul_layout_t *l) {
+    return task_grain(HODU_CPU_COST_FMA, (double)l->K * l->N);
+}
+
+/// Per-batch M*K*N below which batches are spread over threads instead of each GEMM
+#define MATMUL_BATCH_PARALLEL_WORK ((size_t)1 << 20)
+
 /// Optimized macro for batched matrix multiplication
-/// - Fast path for contiguous non-batched case with parallel execution
-/// - Scalar accumulation for better register usage
+/// - Rows of all batches form one parallel range; batch offsets recomputed only on batch change
+/// - Each output row accumulates in i-k-j order (unit-stride inner loop vectorizes)
 ///
 /// @param TYPE C type for the operation
 /// @param TYPE_SUFFIX Suffix for function naming
@@ -48,310 +120,157 @@
         const TYPE *lhs;                                                                           \
         const TYPE *rhs;                                                                           \
         TYPE *output;                                                                              \
-        size_t start_row;                                                                          \
-        size_t end_row;                                                                            \
-        size_t M, K, N;                                                                            \
+        const matmul_layout_t *layout;                                                             \
     } matmul_##TYPE_SUFFIX##_args_t;                                                               \
                                                                                                    \
-    static void *matmul_##TYPE_SUFFIX##_worker(void *arg) {                                        \
+    /* Output rows [start, end) across batches: row r is (batch r / M, i = r % M) */               \
+    static void matmul_##TYPE_SUFFIX##_worker(size_t start, size_t end, void *arg) {               \
         matmul_##TYPE_SUFFIX##_args_t *args = (matmul_##TYPE_SUFFIX##_args_t *)arg;                \
-        for (size_t i = args->start_row; i < args->end_row; i++) {                                 \
-            for (size_t j = 0; j < args->N; j++) {                                                 \
-                TYPE sum = 0;                                                                      \
-                for (size_t k = 0; k < args->K; k++) {                                             \
-                    sum += args->lhs[i * args->K + k] * args->rhs[k * args->N + j];                \
-                }                                                                                  \
-                args->output[i * args->N + j] = sum;                                               \
+        const matmul_layout_t *l = args->layout;                                                   \
+        const size_t K = l->K, N = l->N;                                                           \
+        size_t batch = (size_t)-1;                                                                 \
+        const TYPE *lhs = NULL;                                                                    \
+        const TYPE *rhs = NULL;                                                                    \
+                                                                                                   \
+        for (size_t r = start; r < end; r++) {                                                     \
+            if (r / l->M != batch) {                                                               \
+                size_t lhs_off, rhs_off;                                                           \
+                batch = r / l->M;                                                                  \
+                matmul_batch_offsets(l, batch, &lhs_off, &rhs_off);                                \
+                lhs = args->lhs + lhs_off;                                                         \
+                rhs = args->rhs + rhs_off;                                                         \
             }                                                                                      \
-        }                                                                                          \
-        return NULL;                                                                               \
-    }                                                                                              \
-                                                                                                   \
-    void hodu_cpu_matmul_##TYPE_SUFFIX(const void *lhs_ptr, const void *rhs_ptr, void *output_ptr, \
-                                       const size_t *metadata) {                                   \
-        const TYPE *lhs = (const TYPE *)lhs_ptr;                                                   \
-        const TYPE *rhs = (const TYPE *)rhs_ptr;                                                   \
-        TYPE *output = (TYPE *)output_ptr;                                                         \
+            const TYPE *a_row = lhs + (r % l->M) * l->lhs_rs;                                      \
+            TYPE *out = args->output + r * N;                                                      \
                                                                                                    \
-        const size_t num_els = metadata[0];                                                        \
-        const size_t lhs_ndim = metadata[1];                                                       \
-        const size_t rhs_ndim = metadata[2];                                                       \
-        const size_t batch_ndim = metadata[3];                                                     \
-                                                                                                   \
-        const size_t *lhs_shape = metadata + 4;                                                    \
-        const size_t *rhs_shape = lhs_shape + lhs_ndim;                                            \
-        const size_t *batch_shape = rhs_shape + rhs_ndim;                                          \
-        const size_t *lhs_strides = batch_shape + batch_ndim;                                      \
-        const size_t *rhs_strides = lhs_strides + lhs_ndim;                                        \
-        const size_t lhs_offset = *(rhs_strides + rhs_ndim);                                       \
-        const size_t rhs_offset = *(rhs_strides + rhs_ndim + 1);                                   \
-        const size_t M = *(rhs_strides + rhs_ndim + 2);                                            \
-        const size_t K = *(rhs_strides + rhs_ndim + 3);                                            \
-        const size_t N = *(rhs_strides + rhs_ndim + 4);                                            \
-                                                                                                   \
-        size_t lhs_batch_ndim = lhs_ndim - 2;                                                      \
-        size_t rhs_batch_ndim = rhs_ndim - 2;                                                      \
-                                                                                                   \
-        /* Check for contiguous fast path */                                                       \
-        bool is_contiguous = (lhs_strides[lhs_ndim - 1] == 1 && rhs_strides[rhs_ndim - 1] == 1 &&  \
-                              lhs_strides[lhs_ndim - 2] == K && rhs_strides[rhs_ndim - 2] == N &&  \
-                              lhs_offset == 0 && rhs_offset == 0);                                 \
-                                                                                                   \
-        if (is_contiguous && batch_ndim == 0) {                                                    \
-            /* Fast path: no batching, contiguous - use parallel execution */                      \
-            size_t num_threads = get_optimal_threads(M, 128);                                      \
-                                                                                                   \
-            if (num_threads > 1) {                                                                 \
-                /* Parallel execution */                                                           \
-                thread_t threads[32];                                                              \
-                matmul_##TYPE_SUFFIX##_args_t thread_args[32];                                     \
-                if (num_threads > 32)                                                              \
-                    num_threads = 32;                                                              \
-                                                                                                   \
-                size_t rows_per_thread = M / num_threads;                                          \
-                size_t remaining_rows = M % num_threads;                                           \
-                                                                                                   \
-                for (size_t t = 0; t < num_threads; t++) {                                         \
-                    thread_args[t].lhs = lhs;                                                      \
-                    thread_args[t].rhs = rhs;                                                      \
-                    thread_args[t].output = output;                                                \
-                    thread_args[t].M = M;                                                          \
-                    thread_args[t].K = K;                                                          \
-                    thread_args[t].N = N;                                                          \
-                    thread_args[t].start_row = t * rows_per_thread;                                \
-                    thread_args[t].end_row = (t + 1) * rows_per_thread;                            \
-                    if (t == num_threads - 1)                                                      \
-                        thread_args[t].end_row += remaining_rows;                                  \
-                                                                                                   \
-                    thread_create(&threads[t], matmul_##TYPE_SUFFIX##_worker, &thread_args[t]);    \
-                }                                                                                  \
-                                                                                                   \
-                for (size_t t = 0; t < num_threads; t++) {                                         \
-                    thread_join(threads[t]);                                                       \
-                }                                                                                  \
-            } else {                                                                               \
-                /* Single-threaded execution */                                                    \
-                for (size_t i = 0; i < M; i++) {                                                   \
-                    for (size_t j = 0; j < N; j++) {                                               \
-                        TYPE sum = 0;                                                              \
-                        for (size_t k = 0; k < K; k++) {                                           \
-                            sum += lhs[i * K + k] * rhs[k * N + j];                                \
-                        }                                                                          \
-                        output[i * N + j] = sum;                                                   \
-                    }                                                                              \
-                }                                                                                  \
+            for (size_t j = 0; j < N; j++) {                                                       \
+                out[j] = 0;                                                                        \
             }                                                                                      \
-        } else {                                                                                   \
-            /* General path with batching/striding */                                              \
-            for (size_t idx = 0; idx < num_els; idx++) {                                           \
-                size_t mn = idx % (M * N);                                                         \
-                size_t batch_idx = idx / (M * N);                                                  \
-                size_t i = mn / N;                                                                 \
-                size_t j = mn % N;                                                                 \
-                                                                                                   \
-                size_t batch_indices[16];                                                          \
-                size_t temp = batch_idx;                                                           \
-                for (int d = (int)batch_ndim - 1; d >= 0; d--) {                                   \
-                    batch_indices[d] = temp % batch_shape[d];                                      \
-                    temp /= batch_shape[d];                                                        \
-                }                                                                                  \
-                                                                                                   \
-                size_t lhs_batch_indices[16];                                                      \
-                for (size_t d = 0; d < lhs_batch_ndim; d++) {                                      \
-                    size_t batch_dim_idx = batch_ndim - lhs_batch_ndim + d;                        \
-                    lhs_batch_indices[d] = (lhs_shape[d] == 1) ? 0 : batch_indices[batch_dim_idx]; \
-                }                                                                                  \
-                                                                                                   \
-                size_t rhs_batch_indices[16];                                                      \
-                for (size_t d = 0; d < rhs_batch_ndim; d++) {                                      \
-                    size_t batch_dim_idx = batch_ndim - rhs_batch_ndim + d;                        \
-                    rhs_batch_indices[d] = (rhs_shape[d] == 1) ? 0 : batch_indices[batch_dim_idx]; \
-                }                                                                                  \
-                                                                                                   \
-                TYPE sum = 0;                                                                      \
-                for (size_t k = 0; k < K; k++) {                                                   \
-                    size_t lhs_idx = lhs_offset;                                                   \
-                    for (size_t d = 0; d < lhs_batch_ndim; d++) {                                  \
-                        lhs_idx += lhs_batch_indices[d] * lhs_strides[d];                          \
+            for (size_t k = 0; k < K; k++) {                                                       \
+                const TYPE a = a_row[k * l->lhs_cs];                                               \
+                const TYPE *b_row = rhs + k * l->rhs_rs;                                           \
+                if (l->rhs_cs == 1) {                                                              \
+                    for (size_t j = 0; j < N; j++) {                                               \
+                        out[j] += a * b_row[j];                                                    \
                     }                                                                              \
-                    lhs_idx += i * lhs_strides[lhs_ndim - 2];                                      \
-                    lhs_idx += k * lhs_strides[lhs_ndim - 1];                                      \
-                                                                                                   \
-                    size_t rhs_idx = rhs_offset;                                                   \
-                    for (size_t d = 0; d < rhs_batch_ndim; d++) {                                  \
-                        rhs_idx += rhs_batch_indices[d] * rhs_strides[d];                          \
+                } else {                                                                           \
+                    for (size_t j = 0; j < N; j++) {                                               \
+                        out[j] += a * b_row[j * l->rhs_cs];                                        \
                     }                                                                              \
-                    rhs_idx += k * rhs_strides[rhs_ndim - 2];                                      \
-                    rhs_idx += j * rhs_strides[rhs_ndim - 1];                                      \
-                                                                                                   \
-                    sum += lhs[lhs_idx] * rhs[rhs_idx];                                            \
                 }                                                                                  \
-                                                                                                   \
-                output[idx] = sum;                                                                 \
             }                                                                                      \
         }                                                                                          \
+    }                                                                                              \
+                                                                                                   \
+    void hodu_cpu_matmul_##TYPE_SUFFIX(const void *lhs_ptr, const void *rhs_ptr, void *output_ptr, \
+                                       const size_t *metadata) {                                   \
+        HODU_PROFILE_KERNEL(hodu_cpu_profile_matmul_bytes(metadata, sizeof(TYPE), sizeof(TYPE)));  \
+        matmul_layout_t layout;                                                                    \
+        matmul_parse_layout(metadata, &layout);                                                    \
+        if (layout.num_batches == 0) {                                                             \
+            return;                                                                                \
+        }                                                                                          \
+                                                                                                   \
+        matmul_##TYPE_SUFFIX##_args_t args = {(const TYPE *)lhs_ptr, (const TYPE *)rhs_ptr,        \
+                                              (TYPE *)output_ptr, &layout};                        \
+        parallel_for(0, layout.num_batches * layout.M, matmul_row_grain(&layout),                  \
+                     matmul_##TYPE_SUFFIX##_worker, &args);                                        \
     }
 
-// Exotic floating-point matmul (same as MATMUL_OP but with proper float arithmetic)
-#define MATMUL_OP_EXOTIC(TYPE, TYPE_SUFFIX, ZERO, ADD_FN, MUL_FN)                                  \
+/// Macro for floating-point batched matrix multiplication on the packed GEMM engine
+/// - lhs and rhs may have different types when GEMM_FN converts while packing
+/// - Accepts any lhs/rhs strides (transposed views are packed directly)
+/// - Batch offsets are resolved once per batch, then the MxKxN block goes to GEMM
+/// - Many or small batches are spread across threads (each GEMM runs single-threaded);
+///   few large batches run in order and parallelize inside GEMM
+///
+/// @param LHS_TYPE C type of lhs
+/// @param RHS_TYPE C type of rhs
+/// @param TYPE C type of the output
+/// @param TYPE_SUFFIX Suffix for function naming
+/// @param GEMM_FN GEMM implementation from gemm.h
+#define MATMUL_OP_GEMM_MIXED(LHS_TYPE, RHS_TYPE, TYPE, TYPE_SUFFIX, GEMM_FN)                       \
     typedef struct {                                                                               \
-        const TYPE *lhs;                                                                           \
-        const TYPE *rhs;                                                                           \
+        const LHS_TYPE *lhs;                                                                       \
+        const RHS_TYPE *rhs;                                                                       \
         TYPE *output;                                                                              \
-        size_t start_row;                                                                          \
-        size_t end_row;                                                                            \
-        size_t M, K, N;                                                                            \
+        const matmul_layout_t *layout;                                                             \
     } matmul_##TYPE_SUFFIX##_args_t;                                                               \
                                                                                                    \
-    static void *matmul_##TYPE_SUFFIX##_worker(void *arg) {                                        \
+    static void matmul_##TYPE_SUFFIX##_batches(size_t start, size_t end, void *arg) {              \
         matmul_##TYPE_SUFFIX##_args_t *args = (matmul_##TYPE_SUFFIX##_args_t *)arg;                \
-        for (size_t i = args->start_row; i < args->end_row; i++) {                                 \
-            for (size_t j = 0; j < args->N; j++) {                                                 \
-                TYPE sum = ZERO;                                                                   \
-                for (size_t k = 0; k < args->K; k++) {                                             \
-                    sum = ADD_FN(sum,                                                              \
-                                 MUL_FN(args->lhs[i * args->K + k], args->rhs[k * args->N + j]));  \
-                }                                                                                  \
-                args->output[i * args->N + j] = sum;                                               \
-            }                                                                                      \
+        const matmul_layout_t *l = args->layout;                                                   \
+        for (size_t batch = start; batch < end; batch++) {                                         \
+            size_t lhs_off, rhs_off;                                                               \
+            matmul_batch_offsets(l, batch, &lhs_off, &rhs_off);                                    \
+            GEMM_FN(l->M, l->N, l->K, args->lhs + lhs_off, l->lhs_rs, l->lhs_cs,                   \
+                    args->rhs + rhs_off, l->rhs_rs, l->rhs_cs, args->output + batch * l->M * l->N, \
+                    l->N);                                                                         \
         }                                                                                          \
-        return NULL;                                                                               \
     }                                                                                              \
                                                                                                    \
     void hodu_cpu_matmul_##TYPE_SUFFIX(const void *lhs_ptr, const void *rhs_ptr, void *output_ptr, \
                                        const size_t *metadata) {                                   \
-        const TYPE *lhs = (const TYPE *)lhs_ptr;                                                   \
-        const TYPE *rhs = (const TYPE *)rhs_ptr;                                                   \
-        TYPE *output = (TYPE *)output_ptr;                                                         \
-                                                                                                   \
-        const size_t num_els = metadata[0];                                                        \
-        const size_t lhs_ndim = metadata[1];                                                       \
-        const size_t rhs_ndim = metadata[2];                                                       \
-        const size_t batch_ndim = metadata[3];                                                     \
-                                                                                                   \
-        const size_t *lhs_shape = metadata + 4;                                                    \
-        const size_t *rhs_shape = lhs_shape + lhs_ndim;                                            \
-        const size_t *batch_shape = rhs_shape + rhs_ndim;                                          \
-        const size_t *lhs_strides = batch_shape + batch_ndim;                                      \
-        const size_t *rhs_strides = lhs_strides + lhs_ndim;                                        \
-        const size_t lhs_offset = *(rhs_strides + rhs_ndim);                                       \
-        const size_t rhs_offset = *(rhs_strides + rhs_ndim + 1);                                   \
-        const size_t M = *(rhs_strides + rhs_ndim + 2);                                            \
-        const size_t K = *(rhs_strides + rhs_ndim + 3);                                            \
-        const size_t N = *(rhs_strides + rhs_ndim + 4);                                            \
-                                                                                                   \
-        size_t lhs_batch_ndim = lhs_ndim - 2;                                                      \
-        size_t rhs_batch_ndim = rhs_ndim - 2;                                                      \
-                                                                                                   \
-        bool is_contiguous = (lhs_strides[lhs_ndim - 1] == 1 && rhs_strides[rhs_ndim - 1] == 1 &&  \
-                              lhs_strides[lhs_ndim - 2] == K && rhs_strides[rhs_ndim - 2] == N &&  \
-                              lhs_offset == 0 && rhs_offset == 0);                                 \
-                                                                                                   \
-        if (is_contiguous && batch_ndim == 0) {                                                    \
-            size_t num_threads = get_optimal_threads(M, 128);                                      \
-                                                                                                   \
-            if (num_threads > 1) {                                                                 \
-                thread_t threads[32];                                                              \
-                matmul_##TYPE_SUFFIX##_args_t thread_args[32];                                     \
-                if (num_threads > 32)                                                              \
-                    num_threads = 32;                                                              \
-                                                                                                   \
-                size_t rows_per_thread = M / num_threads;                                          \
-                size_t remaining_rows = M % num_threads;                                           \
-                                                                                                   \
-                for (size_t t = 0; t < num_threads; t++) {                                         \
-                    thread_args[t].lhs = lhs;                                                      \
-                    thread_args[t].rhs = rhs;                                                      \
-                    thread_args[t].output = output;                                                \
-                    thread_args[t].M = M;                                                          \
-                    thread_args[t].K = K;                                                          \
-                    thread_args[t].N = N;                                                          \
-                    thread_args[t].start_row = t * rows_per_thread;                                \
-                    thread_args[t].end_row = (t + 1) * rows_per_thread;                            \
-                    if (t == num_threads - 1)                                                      \
-                        thread_args[t].end_row += remaining_rows;                                  \
-                                                                                                   \
-                    thread_create(&threads[t], matmul_##TYPE_SUFFIX##_worker, &thread_args[t]);    \
-                }                                                                                  \
+        HODU_PROFILE_KERNEL(                                                                       \
+            hodu_cpu_profile_matmul_bytes(metadata, sizeof(LHS_TYPE), sizeof(RHS_TYPE)));          \
+        matmul_layout_t layout;                                                                    \
+        matmul_parse_layout(metadata, &layout);                                                    \
+        if (layout.num_batches == 0) {                                                             \
+            return;                                                                                \
+        }                                                                                          \
                                                                                                    \
-                for (size_t t = 0; t < num_threads; t++) {                                         \
-                    thread_join(threads[t]);                                                       \
-                }                                                                                  \
-            } else {                                                                               \
-                for (size_t i = 0; i < M; i++) {                                                   \
-                    for (size_t j = 0; j < N; j++) {                                               \
-                        TYPE sum = ZERO;                                                           \
-                        for (size_t k = 0; k < K; k++) {                                           \
-                            sum = ADD_FN(sum, MUL_FN(lhs[i * K + k], rhs[k * N + j]));             \
-                        }                                                                          \
-                        output[i * N + j] = sum;                                                   \
-                    }                                                                              \
-                }                                                                                  \
-            }                                                                                      \
+        matmul_##TYPE_SUFFIX##_args_t args = {(const LHS_TYPE *)lhs_ptr,                           \
+                                              (const RHS_TYPE *)rhs_ptr, (TYPE *)output_ptr,       \
+                                              &layout};                                            \
+        const size_t batch_work = layout.M * layout.N * layout.K;                                  \
+        if (layout.num_batches > 1 && (layout.num_batches >= get_num_threads() ||                  \
+                                       batch_work < MATMUL_BATCH_PARALLEL_WORK)) {                 \
+            size_t grain = task_grain(HODU_CPU_COST_FMA, (double)batch_work);                      \
+            parallel_for(0, layout.num_batches, grain, matmul_##TYPE_SUFFIX##_batches, &args);     \
         } else {                                                                                   \
-            for (size_t idx = 0; idx < num_els; idx++) {                                           \
-                size_t mn = idx % (M * N);                                                         \
-                size_t batch_idx = idx / (M * N);                                                  \
-                size_t i = mn / N;                                                                 \
-                size_t j = mn % N;                                                                 \
-                                                                                                   \
-                size_t batch_indices[16];                                                          \
-                size_t temp = batch_idx;                                                           \
-                for (int d = (int)batch_ndim - 1; d >= 0; d--) {                                   \
-                    batch_indices[d] = temp % batch_shape[d];                                      \
-                    temp /= batch_shape[d];                                                        \
-                }                                                                                  \
-                                                                                                   \
-                size_t lhs_batch_indices[16];                                                      \
-                for (size_t d = 0; d < lhs_batch_ndim; d++) {                                      \
-                    size_t batch_dim_idx = batch_ndim - lhs_batch_ndim + d;                        \
-                    lhs_batch_indices[d] = (lhs_shape[d] == 1) ? 0 : batch_indices[batch_dim_idx]; \
-                }                                                                                  \
-                                                                                                   \
-                size_t rhs_batch_indices[16];                                                      \
-                for (size_t d = 0; d < rhs_batch_ndim; d++) {                                      \
-                    size_t batch_dim_idx = batch_ndim - rhs_batch_ndim + d;                        \
-                    rhs_batch_indices[d] = (rhs_shape[d] == 1) ? 0 : batch_indices[batch_dim_idx]; \
-                }                                                                                  \
-                                                                                                   \
-                TYPE sum = ZERO;                                                                   \
-                for (size_t k = 0; k < K; k++) {                                                   \
-                    size_t lhs_idx = lhs_offset;                                                   \
-                    for (size_t d = 0; d < lhs_batch_ndim; d++) {                                  \
-                        lhs_idx += lhs_batch_indices[d] * lhs_strides[d];                          \
-                    }                                                                              \
-                    lhs_idx += i * lhs_strides[lhs_ndim - 2];                                      \
-                    lhs_idx += k * lhs_strides[lhs_ndim - 1];                                      \
-                                                                                                   \
-                    size_t rhs_idx = rhs_offset;                                                   \
-                    for (size_t d = 0; d < rhs_batch_ndim; d++) {                                  \
-                        rhs_idx += rhs_batch_indices[d] * rhs_strides[d];                          \
-                    }                                                                              \
-                    rhs_idx += k * rhs_strides[rhs_ndim - 2];                                      \
-                    rhs_idx += j * rhs_strides[rhs_ndim - 1];                                      \
-                                                                                                   \
-                    sum = ADD_FN(sum, MUL_FN(lhs[lhs_idx], rhs[rhs_idx]));                         \
-                }                                                                                  \
-                                                                                                   \
-                output[idx] = sum;                                                                 \
-            }                                                                                      \
+            matmul_##TYPE_SUFFIX##_batches(0, layout.num_batches, &args);                          \
         }                                                                                          \
     }
 
+/// Same-type floating-point matmul on the packed GEMM engine (see MATMUL_OP_GEMM_MIXED)
+#define MATMUL_OP_GEMM(TYPE, TYPE_SUFFIX, GEMM_FN)                                                 \
+    MATMUL_OP_GEMM_MIXED(TYPE, TYPE, TYPE, TYPE_SUFFIX, GEMM_FN)
+
 // Generate fallback implementations for all types first
-MATMUL_OP(f32_t, f32_fallback)
-MATMUL_OP(f64_t, f64_fallback)
+MATMUL_OP_GEMM(f32_t, f32_fallback, hodu_cpu_gemm_f32)
+MATMUL_OP_GEMM(f64_t, f64_fallback, hodu_cpu_gemm_f64)
 
 // F32/F64 matmul implementations are in separate BLAS-specific files:
 // - ops_matrix_openblas.c (OpenBLAS with thread control)
 // - ops_matrix_blas_aarch64_apple_darwin.c (Accelerate framework)
 // These files provide matmul_f32() and matmul_f64() implementations
 
-// Exotic floating-point types use proper arithmetic
-MATMUL_OP_EXOTIC(f8e4m3_t, f8e4m3, F8E4M3_ZERO, f8e4m3_add, f8e4m3_mul)
-MATMUL_OP_EXOTIC(f8e5m2_t, f8e5m2, F8E5M2_ZERO, f8e5m2_add, f8e5m2_mul)
-MATMUL_OP_EXOTIC(bf16_t, bf16, BF16_ZERO, bf16_add, bf16_mul)
-MATMUL_OP_EXOTIC(f16_t, f16, F16_ZERO, f16_add, f16_mul)
+#ifndef USE_BLAS
+// Non-BLAS version just calls fallback (native GEMM)
+void hodu_cpu_matmul_f32(const void *lhs_ptr, const void *rhs_ptr, void *output_ptr,
+                         const size_t *metadata) {
+    HODU_PROFILE_KERNEL(hodu_cpu_profile_matmul_bytes(metadata, sizeof(f32_t), sizeof(f32_t)));
+    hodu_cpu_matmul_f32_fallback(lhs_ptr, rhs_ptr, output_ptr, metadata);
+}
+
+void hodu_cpu_matmul_f64(const void *lhs_ptr, const void *rhs_ptr, void *output_ptr,
+                         const size_t *metadata) {
+    HODU_PROFILE_KERNEL(hodu_cpu_profile_matmul_bytes(metadata, sizeof(f64_t), sizeof(f64_t)));
+    hodu_cpu_matmul_f64_fallback(lhs_ptr, rhs_ptr, output_ptr, metadata);
+}
+#endif
+
+// Exotic floating-point types accumulate in f32 on the packed GEMM engine
+MATMUL_OP_GEMM(f8e4m3_t, f8e4m3, hodu_cpu_gemm_f8e4m3)
+MATMUL_OP_GEMM(f8e5m2_t, f8e5m2, hodu_cpu_gemm_f8e5m2)
+MATMUL_OP_GEMM(bf16_t, bf16, hodu_cpu_gemm_bf16)
+MATMUL_OP_GEMM(f16_t, f16, hodu_cpu_gemm_f16)
+
+// f32 lhs against low-precision rhs (weights), cast to f32 while B panels are packed
+MATMUL_OP_GEMM_MIXED(f32_t, bf16_t, f32_t, f32_bf16, hodu_cpu_gemm_f32_bf16)
+MATMUL_OP_GEMM_MIXED(f32_t, f16_t, f32_t, f32_f16, hodu_cpu_gemm_f32_f16)
+MATMUL_OP_GEMM_MIXED(f32_t, f8e4m3_t, f32_t, f32_f8e4m3, hodu_cpu_gemm_f32_f8e4m3)
+MATMUL_OP_GEMM_MIXED(f32_t, f8e5m2_t, f32_t, f32_f8e5m2, hodu_cpu_gemm_f32_f8e5m2)
 MATMUL_OP(int8_t, i8)
 MATMUL_OP(int16_t, i16)
 MATMUL_OP(int32_t, i32)
@@ -380,14 +299,14 @@ MATMUL_OP(uint64_t, u64)
 // - metadata[8]: rhs_offset (starting offset in rhs)
 //
 // Algorithm:
-// Simple triple-nested loop over (row, col, k) for matrix multiplication.
-// No tiling or cache optimization as CPU doesn't benefit from shared memory
-// tiling like GPUs do.
+// Floating-point types use the packed GEMM engine (gemm.c) unless a BLAS library
+// handles f32/f64; bf16/f16/f8 accumulate in f32 and round once on store.
+// Integer types use a cache-blocked loop over (row, k, col).
 
 /// Macro to implement highly optimized 2D matrix multiplication with parallel execution
 ///
 /// Optimizations:
-/// - Parallel execution with pthread for large matrices
+/// - Parallel execution on the shared thread pool for large matrices
 /// - Cache blocking (32x32x256 blocks for L1 cache)
 /// - Register blocking (4x4 micro-kernels)
 /// - Loop unrolling (4x inner loop)
@@ -401,27 +320,67 @@ MATMUL_OP(uint64_t, u64)
         const TYPE *lhs;                                                                           \
         const TYPE *rhs;                                                                           \
         TYPE *output;                                                                              \
-        size_t start_row;                                                                          \
-        size_t end_row;                                                                            \
         size_t M, K, N;                                                                            \
     } dot_##TYPE_SUFFIX##_args_t;                                                                  \
                                                                                                    \
-    static void *dot_##TYPE_SUFFIX##_worker(void *arg) {                                           \
+    /* Cache-blocked kernel over output rows [start, end) of contiguous matrices */                \
+    static void dot_##TYPE_SUFFIX##_worker(size_t start, size_t end, void *arg) {                  \
         dot_##TYPE_SUFFIX##_args_t *args = (dot_##TYPE_SUFFIX##_args_t *)arg;                      \
-        for (size_t i = args->start_row; i < args->end_row; i++) {                                 \
-            for (size_t j = 0; j < args->N; j++) {                                                 \
-                TYPE sum = 0;                                                                      \
-                for (size_t k = 0; k < args->K; k++) {                                             \
-                    sum += args->lhs[i * args->K + k] * args->rhs[k * args->N + j];                \
+        const TYPE *lhs = args->lhs;                                                               \
+        const TYPE *rhs = args->rhs;                                                               \
+        TYPE *output = args->output;                                                               \
+        const size_t K = args->K;                                                                  \
+        const size_t N = args->N;                                                                  \
+                                                                                                   \
+        const size_t BLOCK_M = 32;                                                                 \
+        const size_t BLOCK_N = 32;                                                                 \
+        const size_t BLOCK_K = 256;                                                                \
+        const size_t REG_M = 4;                                                                    \
+        const size_t REG_N = 4;                                                                    \
+                                                                                                   \
+        for (size_t ii = start; ii < end; ii += BLOCK_M) {                                         \
+            size_t i_end = (ii + BLOCK_M < end) ? (ii + BLOCK_M) : end;                            \
+            for (size_t kk = 0; kk < K; kk += BLOCK_K) {                                           \
+                size_t k_end = (kk + BLOCK_K < K) ? (kk + BLOCK_K) : K;                            \
+                for (size_t jj = 0; jj < N; jj += BLOCK_N) {                                       \
+                    size_t j_end = (jj + BLOCK_N < N) ? (jj + BLOCK_N) : N;                        \
+                    /* Register blocking with 4x4 micro-kernels */                                 \
+                    for (size_t i = ii; i < i_end; i += REG_M) {                                   \
+                        size_t i_reg_end = (i + REG_M < i_end) ? (i + REG_M) : i_end;              \
+                        for (size_t j = jj; j < j_end; j += REG_N) {                               \
+                            size_t j_reg_end = (j + REG_N < j_end) ? (j + REG_N) : j_end;          \
+                            /* Accumulate 4x4 block in registers */                                \
+                            TYPE acc[4][4] = {{0}};                                                \
+                            for (size_t ir = 0; ir < (i_reg_end - i); ir++) {                      \
+                                for (size_t jr = 0; jr < (j_reg_end - j); jr++) {                  \
+                                    acc[ir][jr] = output[(i + ir) * N + (j + jr)];                 \
+                                }                                                                  \
+                            }                                                                      \
+                            /* Compute 4x4 micro-kernel */                                         \
+                            for (size_t k = kk; k < k_end; k++) {                                  \
+                                for (size_t ir = 0; ir < (i_reg_end - i); ir++) {                  \
+                                    TYPE a_val = lhs[(i + ir) * K + k];                            \
+                                    for (size_t jr = 0; jr < (j_reg_end - j); jr++) {              \
+                                acc[ir][jr] += a_val * rhs[k * N + (j + jr)];                      \
+                                    }                                                              \
+                                }                                                                  \
+                            }                                                                      \
+                            /* Store back */                                                       \
+                            for (size_t ir = 0; ir < (i_reg_end - i); ir++) {                      \
+                                for (size_t jr = 0; jr < (j_reg_end - j); jr++) {                  \
+                                    output[(i + ir) * N + (j + jr)] = acc[ir][jr];                 \
+                                }                                                                  \
+                            }                                                                      \
+                        }                                                                          \
+                    }                                                                              \
                 }                                                                                  \
-                args->output[i * args->N + j] = sum;                                               \
             }                                                                                      \
         }                                                                                          \
-        return NULL;                                                                               \
     }                                                                                              \
                                                                                                    \
     void hodu_cpu_dot_##TYPE_SUFFIX(const void *lhs_ptr, const void *rhs_ptr, void *output_ptr,    \
                                     const size_t *metadata) {                                      \
+        HODU_PROFILE_KERNEL(hodu_cpu_profile_dot_bytes(metadata, sizeof(TYPE)));                   \
         const TYPE *lhs = (const TYPE *)lhs_ptr;                                                   \
         const TYPE *rhs = (const TYPE *)rhs_ptr;                                                   \
         TYPE *output = (TYPE *)output_ptr;                                                         \
@@ -439,12 +398,10 @@ MATMUL_OP(uint64_t, u64)
         /* Initialize output to zero */                                                            \
         memset(output, 0, M * N * sizeof(TYPE));                                                   \
                                                                                                    \
-        /* Optimized blocking parameters for L1 cache */                                           \
+        /* Blocking parameters for the strided path */                                             \
         const size_t BLOCK_M = 32;                                                                 \
         const size_t BLOCK_N = 32;                                                                 \
         const size_t BLOCK_K = 256;                                                                \
-        const size_t REG_M = 4;                                                                    \
-        const size_t REG_N = 4;                                                                    \
                                                                                                    \
         /* Check if contiguous for fast path */                                                    \
         bool is_contiguous =                                                                       \
@@ -452,77 +409,9 @@ MATMUL_OP(uint64_t, u64)
                                                                                                    \
         if (is_contiguous && lhs_offset == 0 && rhs_offset == 0) {                                 \
             /* Fast path: contiguous matrices - use parallel execution for large matrices */       \
-            size_t num_threads = get_optimal_threads(M, 256);                                      \
-                                                                                                   \
-            if (num_threads > 1) {                                                                 \
-                /* Parallel execution */                                                           \
-                thread_t threads[32];                                                              \
-                dot_##TYPE_SUFFIX##_args_t thread_args[32];                                        \
-                if (num_threads > 32)                                                              \
-                    num_threads = 32;                                                              \
-                                                                                                   \
-                size_t rows_per_thread = M / num_threads;                                          \
-                size_t remaining_rows = M % num_threads;                                           \
-                                                                                                   \
-                for (size_t t = 0; t < num_threads; t++) {                                         \
-                    thread_args[t].lhs = lhs;                                                      \
-                    thread_args[t].rhs = rhs;                                                      \
-                    thread_args[t].output = output;                                                \
-                    thread_args[t].M = M;                                                          \
-                    thread_args[t].K = K;                                                          \
-                    thread_args[t].N = N;                                                          \
-                    thread_args[t].start_row = t * rows_per_thread;                                \
-                    thread_args[t].end_row = (t + 1) * rows_per_thread;                            \
-                    if (t == num_threads - 1)                                                      \
-                        thread_args[t].end_row += remaining_rows;                                  \
-                                                                                                   \
-                    thread_create(&threads[t], dot_##TYPE_SUFFIX##_worker, &thread_args[t]);       \
-                }                                                                                  \
-                                                                                                   \
-                for (size_t t = 0; t < num_threads; t++) {                                         \
-                    thread_join(threads[t]);                                                       \
-                }                                                                                  \
-            } else {                                                                               \
-                /* Single-threaded execution with cache blocking */                                \
-                for (size_t ii = 0; ii < M; ii += BLOCK_M) {                                       \
-                    size_t i_end = (ii + BLOCK_M < M) ? (ii + BLOCK_M) : M;                        \
-                    for (size_t kk = 0; kk < K; kk += BLOCK_K) {                                   \
-                        size_t k_end = (kk + BLOCK_K < K) ? (kk + BLOCK_K) : K;                    \
-                        for (size_t jj = 0; jj < N; jj += BLOCK_N) {                               \
-                            size_t j_end = (jj + BLOCK_N < N) ? (jj + BLOCK_N) : N;                \
-                            /* Register blocking with 4x4 micro-kernels */                         \
-                            for (size_t i = ii; i < i_end; i += REG_M) {                           \
-                                size_t i_reg_end = (i + REG_M < i_end) ? (i + REG_M) : i_end;      \
-                                for (size_t j = jj; j < j_end; j += REG_N) {                       \
-                                    size_t j_reg_end = (j + REG_N < j_end) ? (j + REG_N) : j_end;  \
-                                    /* Accumulate 4x4 block in registers */                        \
-                                    TYPE acc[4][4] = {{0}};                                        \
-                                    for (size_t ir = 0; ir < (i_reg_end - i); ir++) {              \
-                                        for (size_t jr = 0; jr < (j_reg_end - j); jr++) {          \
-                                            acc[ir][jr] = output[(i + ir) * N + (j + jr)];         \
-                                        }                                                          \
-                                    }                                                              \
-                                    /* Compute 4x4 micro-kernel */                                 \
-                                    for (size_t k = kk; k < k_end; k++) {                          \
-                                        for (size_t ir = 0; ir < (i_reg_end - i); ir++) {          \
-                                            TYPE a_val = lhs[(i + ir) * K + k];                    \
-                                            for (size_t jr = 0; jr < (j_reg_end - j); jr++) {      \
-                                                acc[ir][jr] += a_val * rhs[k * N + (j + jr)];      \
-                                            }                                                      \
-                                        }                                                          \
-                                    }                                                              \
-                                    /* Store back */                                               \
-                                    for (size_t ir = 0; ir < (i_reg_end - i); ir++) {              \
-                                        for (size_t jr = 0; jr < (j_reg_end - j); jr++) {          \
-                                            output[(i + ir) * N + (j + jr)] = acc[ir][jr];         \
-                                        }                                                          \
-                                    }                                                              \
-                                }                                                                  \
-                            }                                                                      \
-                        }                                                                          \
-                    }                                                                              \
-                }                                                                                  \
-            }                                                                                      \
+            dot_##TYPE_SUFFIX##_args_t args = {lhs, rhs, output, M, K, N};                         \
+            parallel_for(0, M, task_grain(HODU_CPU_COST_FMA, (double)K * N),                       \
+                         dot_##TYPE_SUFFIX##_worker, &args);                                       \
         } else {                                                                                   \
             /* Strided path with basic optimization */                                             \
             for (size_t ii = 0; ii < M; ii += BLOCK_M) {                                           \
@@ -552,37 +441,16 @@ MATMUL_OP(uint64_t, u64)
 // DOT IMPLEMENTATIONS
 // ============================================================================
 
-// Exotic dot (same as DOT_OP but with proper float arithmetic)
-#define DOT_OP_EXOTIC(TYPE, TYPE_SUFFIX, ZERO, ADD_FN, MUL_FN)                                     \
-    typedef struct {                                                                               \
-        const TYPE *lhs;                                                                           \
-        const TYPE *rhs;                                                                           \
-        TYPE *output;                                                                              \
-        size_t start_row;                                                                          \
-        size_t end_row;                                                                            \
-        size_t M, K, N;                                                                            \
-    } dot_##TYPE_SUFFIX##_args_t;                                                                  \
-                                                                                                   \
-    static void *dot_##TYPE_SUFFIX##_worker(void *arg) {                                           \
-        dot_##TYPE_SUFFIX##_args_t *args = (dot_##TYPE_SUFFIX##_args_t *)arg;                      \
-        for (size_t i = args->start_row; i < args->end_row; i++) {                                 \
-            for (size_t j = 0; j < args->N; j++) {                                                 \
-                TYPE sum = ZERO;                                                                   \
-                for (size_t k = 0; k < args->K; k++) {                                             \
-                    sum = ADD_FN(sum,                                                              \
-                                 MUL_FN(args->lhs[i * args->K + k], args->rhs[k * args->N + j]));  \
-                }                                                                                  \
-                args->output[i * args->N + j] = sum;                                               \
-            }                                                                                      \
-        }                                                                                          \
-        return NULL;                                                                               \
-    }                                                                                              \
-                                                                                                   \
+/// Macro for floating-point 2D matrix multiplication on the packed GEMM engine
+///
+/// @param TYPE C type for the operation
+/// @param TYPE_SUFFIX Suffix for function naming
+/// @param GEMM_FN GEMM implementation from gemm.h
+#define DOT_OP_GEMM(TYPE, TYPE_SUFFIX, GEMM_FN)                                                    \
     void hodu_cpu_dot_##TYPE_SUFFIX(const void *lhs_ptr, const void *rhs_ptr, void *output_ptr,    \
                                     const size_t *metadata) {                                      \
         const TYPE *lhs = (const TYPE *)lhs_ptr;                                                   \
         const TYPE *rhs = (const TYPE *)rhs_ptr;                                                   \
-        TYPE *output = (TYPE *)output_ptr;                                                         \
                                                                                                    \
         const size_t M = metadata[0];                                                              \
         const size_t K = metadata[1];                                                              \
@@ -594,126 +462,40 @@ MATMUL_OP(uint64_t, u64)
         const size_t lhs_offset = metadata[7];                                                     \
         const size_t rhs_offset = metadata[8];                                                     \
                                                                                                    \
-        for (size_t i = 0; i < M * N; i++) {                                                       \
-            output[i] = ZERO;                                                                      \
-        }                                                                                          \
-                                                                                                   \
-        const size_t BLOCK_M = 32;                                                                 \
-        const size_t BLOCK_N = 32;                                                                 \
-        const size_t BLOCK_K = 256;                                                                \
-        const size_t REG_M = 4;                                                                    \
-        const size_t REG_N = 4;                                                                    \
-                                                                                                   \
-        bool is_contiguous =                                                                       \
-            (lhs_stride_k == 1 && rhs_stride_n == 1 && lhs_stride_m == K && rhs_stride_k == N);    \
-                                                                                                   \
-        if (is_contiguous && lhs_offset == 0 && rhs_offset == 0) {                                 \
-            size_t num_threads = get_optimal_threads(M, 256);                                      \
-                                                                                                   \
-            if (num_threads > 1) {                                                                 \
-                thread_t threads[32];                                                              \
-                dot_##TYPE_SUFFIX##_args_t thread_args[32];                                        \
-                if (num_threads > 32)                                                              \
-                    num_threads = 32;                                                              \
-                                                                                                   \
-                size_t rows_per_thread = M / num_threads;                                          \
-                size_t remaining_rows = M % num_threads;                                           \
-                                                                                                   \
-                for (size_t t = 0; t < num_threads; t++) {                                         \
-                    thread_args[t].lhs = lhs;                                                      \
-                    thread_args[t].rhs = rhs;                                                      \
-                    thread_args[t].output = output;                                                \
-                    thread_args[t].M = M;                                                          \
-                    thread_args[t].K = K;                                                          \
-                    thread_args[t].N = N;                                                          \
-                    thread_args[t].start_row = t * rows_per_thread;                                \
-                    thread_args[t].end_row = (t + 1) * rows_per_thread;                            \
-                    if (t == num_threads - 1)                                                      \
-                        thread_args[t].end_row += remaining_rows;                                  \
-                                                                                                   \
-                    thread_create(&threads[t], dot_##TYPE_SUFFIX##_worker, &thread_args[t]);       \
-                }                                                                                  \
-                                                                                                   \
-                for (size_t t = 0; t < num_threads; t++) {                                         \
-                    thread_join(threads[t]);                                                       \
-                }                                                                                  \
-            } else {                                                                               \
-                for (size_t ii = 0; ii < M; ii += BLOCK_M) {                                       \
-                    size_t i_end = (ii + BLOCK_M < M) ? (ii + BLOCK_M) : M;                        \
-                    for (size_t kk = 0; kk < K; kk += BLOCK_K) {                                   \
-                        size_t k_end = (kk + BLOCK_K < K) ? (kk + BLOCK_K) : K;                    \
-                        for (size_t jj = 0; jj < N; jj += BLOCK_N) {                               \
-                            size_t j_end = (jj + BLOCK_N < N) ? (jj + BLOCK_N) : N;                \
-                            for (size_t i = ii; i < i_end; i += REG_M) {                           \
-                                size_t i_reg_end = (i + REG_M < i_end) ? (i + REG_M) : i_end;      \
-                                for (size_t j = jj; j < j_end; j += REG_N) {                       \
-                                    size_t j_reg_end = (j + REG_N < j_end) ? (j + REG_N) : j_end;  \
-                                    TYPE acc[4][4];                                                \
-                                    for (size_t ir = 0; ir < (i_reg_end - i); ir++) {              \
-                                        for (size_t jr = 0; jr < (j_reg_end - j); jr++) {          \
-                                            acc[ir][jr] = output[(i + ir) * N + (j + jr)];         \
-                                        }                                                          \
-                                    }                                                              \
-                                    for (size_t k = kk; k < k_end; k++) {                          \
-                                        for (size_t ir = 0; ir < (i_reg_end - i); ir++) {          \
-                                            TYPE a_val = lhs[(i + ir) * K + k];                    \
-                                            for (size_t jr = 0; jr < (j_reg_end - j); jr++) {      \
-                                                acc[ir][jr] =                                      \
-                                                    ADD_FN(acc[ir][jr],                            \
-                                                           MUL_FN(a_val, rhs[k * N + (j + jr)]));  \
-                                            }                                                      \
-                                        }                                                          \
-                                    }                                                              \
-                                    for (size_t ir = 0; ir < (i_reg_end - i); ir++) {              \
-                                        for (size_t jr = 0; jr < (j_reg_end - j); jr++) {          \
-                                            output[(i + ir) * N + (j + jr)] = acc[ir][jr];         \
-                                        }                                                          \
-                                    }                                                              \
-                                }                                                                  \
-                            }                                                                      \
-                        }                                                                          \
-                    }                                                                              \
-                }                                                                                  \
-            }                                                                                      \
-        } else {                                                                                   \
-            for (size_t ii = 0; ii < M; ii += BLOCK_M) {                                           \
-                size_t i_end = (ii + BLOCK_M < M) ? (ii + BLOCK_M) : M;                            \
-                for (size_t kk = 0; kk < K; kk += BLOCK_K) {                                       \
-                    size_t k_end = (kk + BLOCK_K < K) ? (kk + BLOCK_K) : K;                        \
-                    for (size_t jj = 0; jj < N; jj += BLOCK_N) {                                   \
-                        size_t j_end = (jj + BLOCK_N < N) ? (jj + BLOCK_N) : N;                    \
-                        for (size_t i = ii; i < i_end; i++) {                                      \
-                            for (size_t k = kk; k < k_end; k++) {                                  \
-                                size_t lhs_idx = lhs_offset + i * lhs_stride_m + k * lhs_stride_k; \
-                                TYPE a_val = lhs[lhs_idx];                                         \
-                                for (size_t j = jj; j < j_end; j++) {                              \
-                                    size_t rhs_idx =                                               \
-                                        rhs_offset + k * rhs_stride_k + j * rhs_stride_n;          \
-                                    output[i * N + j] =                                            \
-                                        ADD_FN(output[i * N + j], MUL_FN(a_val, rhs[rhs_idx]));    \
-                                }                                                                  \
-                            }                                                                      \
-                        }                                                                          \
-                    }                                                                              \
-                }                                                                                  \
-            }                                                                                      \
-        }                                                                                          \
+        GEMM_FN(M, N, K, lhs + lhs_offset, lhs_stride_m, lhs_stride_k, rhs + rhs_offset,           \
+                rhs_stride_k, rhs_stride_n, (TYPE *)output_ptr, N);                                \
     }
 
+
 // Generate fallback implementations for all types first
-DOT_OP(f32_t, f32_fallback)
-DOT_OP(f64_t, f64_fallback)
+DOT_OP_GEMM(f32_t, f32_fallback, hodu_cpu_gemm_f32)
+DOT_OP_GEMM(f64_t, f64_fallback, hodu_cpu_gemm_f64)
 
 // F32/F64 dot implementations are in separate BLAS-specific files:
 // - ops_matrix_openblas.c (OpenBLAS)
 // - ops_matrix_blas_aarch64_apple_darwin.c (Accelerate framework)
 // These files provide dot_f32() and dot_f64() implementations
 
-// Exotic floating-point types use simple correct implementation
-DOT_OP_EXOTIC(f8e4m3_t, f8e4m3, F8E4M3_ZERO, f8e4m3_add, f8e4m3_mul)
-DOT_OP_EXOTIC(f8e5m2_t, f8e5m2, F8E5M2_ZERO, f8e5m2_add, f8e5m2_mul)
-DOT_OP_EXOTIC(bf16_t, bf16, BF16_ZERO, bf16_add, bf16_mul)
-DOT_OP_EXOTIC(f16_t, f16, F16_ZERO, f16_add, f16_mul)
+#ifndef USE_BLAS
+// Non-BLAS version just calls fallback (native GEMM)
+void hodu_cpu_dot_f32(const void *lhs_ptr, const void *rhs_ptr, void *output_ptr,
+                      const size_t *metadata) {
+    HODU_PROFILE_KERNEL(hodu_cpu_profile_dot_bytes(metadata, sizeof(f32_t)));
+    hodu_cpu_dot_f32_fallback(lhs_ptr, rhs_ptr, output_ptr, metadata);
+}
+
+void hodu_cpu_dot_f64(const void *lhs_ptr, const void *rhs_ptr, void *output_ptr,
+                      const size_t *metadata) {
+    HODU_PROFILE_KERNEL(hodu_cpu_profile_dot_bytes(metadata, sizeof(f64_t)));
+    hodu_cpu_dot_f64_fallback(lhs_ptr, rhs_ptr, output_ptr, metadata);
+}
+#endif
+
+// Exotic floating-point types accumulate in f32 on the packed GEMM engine
+DOT_OP_GEMM(f8e4m3_t, f8e4m3, hodu_cpu_gemm_f8e4m3)
+DOT_OP_GEMM(f8e5m2_t, f8e5m2, hodu_cpu_gemm_f8e5m2)
+DOT_OP_GEMM(bf16_t, bf16, hodu_cpu_gemm_bf16)
+DOT_OP_GEMM(f16_t, f16, hodu_cpu_gemm_f16)
 DOT_OP(int8_t, i8)
 DOT_OP(int16_t, i16)
 DOT_OP(int32_t, i32)
@@ -722,3 +504,359 @@ DOT_OP(uint8_t, u8)
 DOT_OP(uint16_t, u16)
 DOT_OP(uint32_t, u32)
 DOT_OP(uint64_t, u64)
+
+// ============================================================================
+// QUANTIZED MATRIX MULTIPLICATION (QMATMUL)
+// ============================================================================
+//
+// The raw u8 x i8 product comes from hodu_cpu_gemm_u8i8_i32; zero points are
+// folded in afterwards with row/column sums:
+//   sum_k (a - za)(b - zb) = sum_k a*b - za * colsum(b) - zb * rowsum(a) + K * za * zb
+// The correction and the output conversion run in one row-parallel pass.
+
+typedef struct {
+    const int32_t *acc;
+    void *output;
+    const int32_t *row_sum; // NULL when rhs is symmetric
+    const int32_t *col_sum; // NULL when lhs_zero_point == 0
+    size_t K, N;
+    const hodu_cpu_qparams_t *params;
+} qmatmul_args_t;
+
+static inline int32_t qmatmul_rhs_zero_point(const hodu_cpu_qparams_t *p, size_t j) {
+    if (!p->rhs_zero_points) {
+        return 0;
+    }
+    return p->rhs_zero_points[p->rhs_channels > 1 ? j : 0];
+}
+
+static inline float qmatmul_rhs_scale(const hodu_cpu_qparams_t *p, size_t j) {
+    if (!p->rhs_scales) {
+        return 1.0f;
+    }
+    return p->rhs_scales[p->rhs_channels > 1 ? j : 0];
+}
+
+/// Zero-point corrected i32 result for output element (i, j)
+static inline int32_t qmatmul_value(const qmatmul_args_t *args, size_t i, size_t j) {
+    const hodu_cpu_qparams_t *p = args->params;
+    const int32_t zb = qmatmul_rhs_zero_point(p, j);
+    int32_t v = args->acc[i * args->N + j];
+    if (args->col_sum) {
+        v -= p->lhs_zero_point * args->col_sum[j];
+    }
+    if (args->row_sum) {
+        v -= zb * args->row_sum[i];
+    }
+    return v + (int32_t)args->K * p->lhs_zero_point * zb;
+}
+
+static inline int32_t qmatmul_to_i32(const hodu_cpu_qparams_t *p, size_t j, int32_t v) {
+    (void)p;
+    (void)j;
+    return v;
+}
+
+static inline float qmatmul_to_f32(const hodu_cpu_qparams_t *p, size_t j, int32_t v) {
+    return (float)v * p->lhs_scale * qmatmul_rhs_scale(p, j);
+}
+
+static inline int8_t qmatmul_to_i8(const hodu_cpu_qparams_t *p, size_t j, int32_t v) {
+    float q = nearbyintf(qmatmul_to_f32(p, j, v) / p->output_scale) + (float)p->output_zero_point;
+    if (q < -128.0f) {
+        return -128;
+    }
+    if (q > 127.0f) {
+        return 127;
+    }
+    return (int8_t)q;
+}
+
+/// Compute the raw product and the sums needed for the zero-point correction
+///
+/// @return false if a temporary buffer could not be allocated
+static bool qmatmul_accumulate(const uint8_t *lhs, const int8_t *rhs, int32_t *acc,
+                               const size_t *metadata, const hodu_cpu_qparams_t *params,
+                               int32_t **row_sum, int32_t **col_sum) {
+    const size_t M = metadata[0];
+    const size_t K = metadata[1];
+    const size_t N = metadata[2];
+    const size_t lhs_stride_m = metadata[3];
+    const size_t lhs_stride_k = metadata[4];
+    const size_t rhs_stride_k = metadata[5];
+    const size_t rhs_stride_n = metadata[6];
+    lhs += metadata[7];
+    rhs += metadata[8];
+
+    *row_sum = NULL;
+    *col_sum = NULL;
+    if (params->rhs_zero_points) {
+        *row_sum = (int32_t *)calloc(M, sizeof(int32_t));
+        if (!*row_sum) {
+            return false;
+        }
+        for (size_t i = 0; i < M; i++) {
+            int32_t sum = 0;
+            for (size_t k = 0; k < K; k++) {
+                sum += lhs[i * lhs_stride_m + k * lhs_stride_k];
+            }
+            (*row_sum)[i] = sum;
+        }
+    }
+    if (params->lhs_zero_point != 0) {
+        *col_sum = (int32_t *)calloc(N, sizeof(int32_t));
+        if (!*col_sum) {
+            free(*row_sum);
+            return false;
+        }
+        for (size_t k = 0; k < K; k++) {
+            for (size_t j = 0; j < N; j++) {
+                (*col_sum)[j] += rhs[k * rhs_stride_k + j * rhs_stride_n];
+            }
+        }
+    }
+
+    hodu_cpu_gemm_u8i8_i32(M, N, K, lhs, lhs_stride_m, lhs_stride_k, rhs, rhs_stride_k,
+                           rhs_stride_n, acc, N);
+    return true;
+}
+
+/// Macro to implement a quantized matmul with a given output conversion
+///
+/// @param OUT_TYPE C type of the output elements
+/// @param OUT_SUFFIX Suffix for function naming
+/// @param CONVERT Conversion from the corrected i32 result
+/// @param IN_PLACE 1 if the i32 accumulator can live in the output buffer
+#define QMATMUL_OP(OUT_TYPE, OUT_SUFFIX, CONVERT, IN_PLACE)                                        \
+    static void qmatmul_##OUT_SUFFIX##_worker(size_t start, size_t end, void *arg) {               \
+        qmatmul_args_t *args = (qmatmul_args_t *)arg;                                              \
+        OUT_TYPE *out = (OUT_TYPE *)args->output;                                                  \
+        for (size_t i = start; i < end; i++) {                                                     \
+            for (size_t j = 0; j < args->N; j++) {                                                 \
+                int32_t v = qmatmul_value(args, i, j);                                             \
+                out[i * args->N + j] = CONVERT(args->params, j, v);                                \
+            }                                                                                      \
+        }                                                                                          \
+    }                                                                                              \
+                                                                                                   \
+    void hodu_cpu_qmatmul_u8i8_##OUT_SUFFIX(const void *lhs_ptr, const void *rhs_ptr,              \
+                                            void *output_ptr, const size_t *metadata,              \
+                                            const hodu_cpu_qparams_t *params) {                    \
+        HODU_PROFILE_KERNEL(metadata[0] * metadata[1] + metadata[1] * metadata[2] +                \
+                            metadata[0] * metadata[2] * sizeof(OUT_TYPE));                         \
+        const size_t M = metadata[0];                                                              \
+        const size_t K = metadata[1];                                                              \
+        const size_t N = metadata[2];                                                              \
+        if (M == 0 || N == 0) {                                                                    \
+            return;                                                                                \
+        }                                                                                          \
+                                                                                                   \
+        int32_t *acc = IN_PLACE ? (int32_t *)output_ptr                                            \
+                                : (int32_t *)malloc(M * N * sizeof(int32_t));                      \
+        if (!acc) {                                                                                \
+            return;                                                                                \
+        }                                                                                          \
+        int32_t *row_sum, *col_sum;                                                                \
+        if (qmatmul_accumulate((const uint8_t *)lhs_ptr, (const int8_t *)rhs_ptr, acc, metadata,   \
+                               params, &row_sum, &col_sum)) {                                      \
+            qmatmul_args_t args = {acc, output_ptr, row_sum, col_sum, K, N, params};               \
+            size_t grain = task_grain(HODU_CPU_COST_ELEMENTWISE, N);                               \
+            parallel_for(0, M, grain, qmatmul_##OUT_SUFFIX##_worker, &args);                       \
+            free(row_sum);                                                                         \
+            free(col_sum);                                                                         \
+        }                                                                                          \
+        if (!IN_PLACE) {                                                                           \
+            free(acc);                                                                             \
+        }                                                                                          \
+    }
+
+QMATMUL_OP(int32_t, i32, qmatmul_to_i32, 1)
+QMATMUL_OP(f32_t, f32, qmatmul_to_f32, 0)
+QMATMUL_OP(int8_t, i8, qmatmul_to_i8, 0)
+
+// ============================================================================
+// WEIGHT-ONLY QUANTIZED MATMUL
+// ============================================================================
+//
+// The int weights go straight to hodu_cpu_gemm_f32_q4/q8. Activations that are
+// not contiguous f32 rows (bf16 or strided views) are first widened into a
+// contiguous f32 copy, which is small next to the weights for decode shapes;
+// bf16 results are computed in f32 and rounded once.
+
+static inline f32_t matmul_wq_identity(f32_t v) { return v; }
+
+/// Macro to implement a weight-only quantized matmul for one activation type
+///
+/// @param TYPE C type of the activations and output
+/// @param TYPE_SUFFIX Suffix of the activation type
+/// @param IS_F32 1 if TYPE is f32 (contiguous rows are used in place)
+/// @param TO_F32 Conversion from TYPE to f32
+/// @param FROM_F32 Conversion from f32 to TYPE
+/// @param QTYPE C type of the stored weights
+/// @param Q_SUFFIX Suffix of the weight format
+/// @param BITS Bits per stored weight
+#define MATMUL_WQ_OP(TYPE, TYPE_SUFFIX, IS_F32, TO_F32, FROM_F32, QTYPE, Q_SUFFIX, BITS)            \
+    void hodu_cpu_matmul_##TYPE_SUFFIX##_##Q_SUFFIX(const void *lhs_ptr, const void *rhs_ptr,      \
+                                                    void *output_ptr, const size_t *metadata,      \
+                                                    const hodu_cpu_group_qparams_t *params) {      \
+        const size_t M = metadata[0];                                                              \
+        const size_t K = metadata[1];                                                              \
+        const size_t N = metadata[2];                                                              \
+        const size_t lhs_stride_m = metadata[3];                                                   \
+        const size_t lhs_stride_k = metadata[4];                                                   \
+        const size_t gs = params->group_size;                                                      \
+        HODU_PROFILE_KERNEL((M * K + M * N) * sizeof(TYPE) + N * K * (BITS) / 8 +                  \
+                            (gs ? N * (K / gs) * sizeof(uint16_t) : 0));                           \
+        if (M == 0 || N == 0 || gs == 0 || gs % 32 != 0 || K % gs != 0) {                          \
+            return;                                                                                \
+        }                                                                                          \
+                                                                                                   \
+        const TYPE *lhs = (const TYPE *)lhs_ptr + metadata[5];                                     \
+        const f32_t *a = (const f32_t *)(const void *)lhs;                                         \
+        size_t lda = lhs_stride_m;                                                                 \
+        f32_t *a_copy = NULL;                                                                      \
+        if (!(IS_F32) || lhs_stride_k != 1) {                                                      \
+            a_copy = (f32_t *)malloc((M * K + 1) * sizeof(f32_t));                                 \
+            if (!a_copy) {                                                                         \
+                return;                                                                            \
+            }                                                                                      \
+            for (size_t i = 0; i < M; i++) {                                                       \
+                for (size_t k = 0; k < K; k++) {                                                   \
+                    a_copy[i * K + k] = TO_F32(lhs[i * lhs_stride_m + k * lhs_stride_k]);          \
+                }                                                                                  \
+            }                                                                                      \
+            a = a_copy;                                                                            \
+            lda = K;                                                                               \
+        }                                                                                          \
+                                                                                                   \
+        f32_t *c = (IS_F32) ? (f32_t *)output_ptr : (f32_t *)malloc(M * N * sizeof(f32_t));        \
+        if (c) {                                                                                   \
+            hodu_cpu_gemm_f32_##Q_SUFFIX(M, N, K, a, lda, (const QTYPE *)rhs_ptr, params->scales,  \
+                                         params->zero_points, gs, c, N);                           \
+            if (!(IS_F32)) {                                                                       \
+                TYPE *out = (TYPE *)output_ptr;                                                    \
+                for (size_t i = 0; i < M * N; i++) {                                               \
+                    out[i] = FROM_F32(c[i]);                                                       \
+                }                                                                                  \
+                free(c);                                                                           \
+            }                                                                                      \
+        }                                                                                          \
+        free(a_copy);                                                                              \
+    }
+
+MATMUL_WQ_OP(f32_t, f32, 1, matmul_wq_identity, matmul_wq_identity, uint8_t, q4, 4)
+MATMUL_WQ_OP(f32_t, f32, 1, matmul_wq_identity, matmul_wq_identity, int8_t, q8, 8)
+MATMUL_WQ_OP(bf16_t, bf16, 0, bf16_to_float, float_to_bf16, uint8_t, q4, 4)
+MATMUL_WQ_OP(bf16_t, bf16, 0, bf16_to_float, float_to_bf16, int8_t, q8, 8)
+
+// ============================================================================
+// FUSED AND PRE-PACKED WEIGHT MATMUL
+// ============================================================================
+//
+// Both run every batch on the native GEMM engine (gemm.c), whose tile loop
+// applies the epilogue (scale, per-column bias, residual, activation) to each
+// output tile as soon as it is final. A rhs packed once with
+// hodu_cpu_matmul_pack_rhs_* is reused directly by every batch. Batches are
+// scheduled like MATMUL_OP_GEMM.
+
+/// Macro to implement fused matmul and pre-packed rhs matmul (size query, pack, multiply)
+///
+/// @param TYPE C type for the operation
+/// @param TYPE_SUFFIX Suffix for function naming
+#define MATMUL_FUSED_OP(TYPE, TYPE_SUFFIX)                                                         \
+    size_t hodu_cpu_matmul_packed_rhs_size_##TYPE_SUFFIX(size_t K, size_t N) {                     \
+        return hodu_cpu_gemm_packed_rhs_size_##TYPE_SUFFIX(K, N) * sizeof(TYPE);                   \
+    }                                                                                              \
+                                                                                                   \
+    void hodu_cpu_matmul_pack_rhs_##TYPE_SUFFIX(const void *rhs_ptr, void *packed_ptr,             \
+                                                const size_t *metadata) {                          \
+        HODU_PROFILE_KERNEL(metadata[0] * metadata[1] * 2 * sizeof(TYPE));                         \
+        hodu_cpu_gemm_pack_rhs_##TYPE_SUFFIX(metadata[0], metadata[1],                             \
+                                             (const TYPE *)rhs_ptr + metadata[4], metadata[2],     \
+                                             metadata[3], (TYPE *)packed_ptr);                     \
+    }                                                                                              \
+                                                                                                   \
+    typedef struct {                                                                               \
+        const TYPE *lhs;                                                                           \
+        const TYPE *rhs;        /* NULL when packed_rhs is used */                                 \
+        const TYPE *packed_rhs; /* shared by every batch */                                        \
+        TYPE *output;                                                                              \
+        const matmul_layout_t *layout;                                                             \
+        const hodu_cpu_epilogue_t *epilogue;                                                       \
+    } matmul_fused_##TYPE_SUFFIX##_args_t;                                                         \
+                                                                                                   \
+    static void matmul_fused_##TYPE_SUFFIX##_batches(size_t start, size_t end, void *arg) {        \
+        matmul_fused_##TYPE_SUFFIX##_args_t *args = (matmul_fused_##TYPE_SUFFIX##_args_t *)arg;    \
+        const matmul_layout_t *l = args->layout;                                                   \
+        const hodu_cpu_epilogue_t *e = args->epilogue;                                             \
+        for (size_t batch = start; batch < end; batch++) {                                         \
+            size_t lhs_off, rhs_off;                                                               \
+            matmul_batch_offsets(l, batch, &lhs_off, &rhs_off);                                    \
+            TYPE *out = args->output + batch * l->M * l->N;                                        \
+                                                                                                   \
+            hodu_cpu_gemm_epilogue_t ep;                                                           \
+            if (e) {                                                                               \
+                ep.scale = e->scale;                                                               \
+                ep.bias = e->bias;                                                                 \
+                ep.bias_per_row = false;                                                           \
+                ep.residual = e->residual ? (const TYPE *)e->residual + batch * l->M * l->N        \
+                                          : NULL;                                                  \
+                ep.ldr = l->N;                                                                     \
+                ep.activation = e->activation;                                                     \
+            }                                                                                      \
+                                                                                                   \
+            if (args->packed_rhs) {                                                                \
+                hodu_cpu_gemm_packed_rhs_##TYPE_SUFFIX(l->M, l->N, l->K, args->lhs + lhs_off,      \
+                                                       l->lhs_rs, l->lhs_cs, args->packed_rhs,     \
+                                                       out, l->N, e ? &ep : NULL);                 \
+            } else {                                                                               \
+                hodu_cpu_gemm_fused_##TYPE_SUFFIX(l->M, l->N, l->K, args->lhs + lhs_off,           \
+                                                  l->lhs_rs, l->lhs_cs, args->rhs + rhs_off,       \
+                                                  l->rhs_rs, l->rhs_cs, out, l->N,                 \
+                                                  e ? &ep : NULL);                                 \
+            }                                                                                      \
+        }                                                                                          \
+    }                                                                                              \
+                                                                                                   \
+    static void matmul_fused_##TYPE_SUFFIX##_run(matmul_fused_##TYPE_SUFFIX##_args_t *args,        \
+                                                 const size_t *metadata) {                         \
+        matmul_layout_t layout;                                                                    \
+        matmul_parse_layout(metadata, &layout);                                                    \
+        if (layout.num_batches == 0) {                                                             \
+            return;                                                                                \
+        }                                                                                          \
+                                                                                                   \
+        args->layout = &layout;                                                                    \
+        const size_t batch_work = layout.M * layout.N * layout.K;                                  \
+        if (layout.num_batches > 1 && (layout.num_batches >= get_num_threads() ||                  \
+                                       batch_work < MATMUL_BATCH_PARALLEL_WORK)) {                 \
+            size_t grain = task_grain(HODU_CPU_COST_FMA, (double)batch_work);                      \
+            parallel_for(0, layout.num_batches, grain, matmul_fused_##TYPE_SUFFIX##_batches,       \
+                         args);                                                                    \
+        } else {                                                                                   \
+            matmul_fused_##TYPE_SUFFIX##_batches(0, layout.num_batches, args);                     \
+        }                                                                                          \
+    }                                                                                              \
+                                                                                                   \
+    void hodu_cpu_matmul_fused_##TYPE_SUFFIX(const void *lhs_ptr, const void *rhs_ptr,             \
+                                             void *output_ptr, const size_t *metadata,             \
+                                             const hodu_cpu_epilogue_t *epilogue) {                \
+        HODU_PROFILE_KERNEL(hodu_cpu_profile_matmul_bytes(metadata, sizeof(TYPE), sizeof(TYPE)));  \
+        matmul_fused_##TYPE_SUFFIX##_args_t args = {(const TYPE *)lhs_ptr, (const TYPE *)rhs_ptr,  \
+                                                    NULL, (TYPE *)output_ptr, NULL, epilogue};     \
+        matmul_fused_##TYPE_SUFFIX##_run(&args, metadata);                                         \
+    }                                                                                              \
+                                                                                                   \
+    void hodu_cpu_matmul_packed_##TYPE_SUFFIX(const void *lhs_ptr, const void *packed_rhs_ptr,     \
+                                              void *output_ptr, const size_t *metadata,            \
+                                              const hodu_cpu_epilogue_t *epilogue) {               \
+        HODU_PROFILE_KERNEL(hodu_cpu_profile_matmul_bytes(metadata, sizeof(TYPE), sizeof(TYPE)));  \
+        matmul_fused_##TYPE_SUFFIX##_args_t args = {(const TYPE *)lhs_ptr, NULL,                   \
+                                                    (const TYPE *)packed_rhs_ptr,                  \
+                                                    (TYPE *)output_ptr, NULL, epilogue};           \
+        matmul_fused_##TYPE_SUFFIX##_run(&args, metadata);                                         \
+    }
+
+
+MATMUL_FUSED_OP(f32_t, f32)
+MATMUL_FUSED_OP(f64_t, f64)
@@ -5,6 +5,8 @@
  * Provides matrix multiplication operations:
  * - matmul: Batched matrix multiplication with broadcasting
  * - dot: Simple 2D matrix multiplication
+ * - qmatmul: Quantized u8 x i8 2D matrix multiplication with i32 accumulation
+ * - matmul_<act>_q4/q8: f32/bf16 activations x group-quantized int4/int8 weights
  *
  * Both operations implement C = A @ B for compatible matrix dimensions.
  */
@@ -12,7 +14,9 @@
 #ifndef OPS_MATRIX_H
 #define OPS_MATRIX_H
 
+#include "epilogue.h"
 #include <stddef.h>
+#include <stdint.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -68,6 +72,19 @@ void hodu_cpu_matmul_u16(const void *lhs, const void *rhs, void *output, const s
 void hodu_cpu_matmul_u32(const void *lhs, const void *rhs, void *output, const size_t *metadata);
 void hodu_cpu_matmul_u64(const void *lhs, const void *rhs, void *output, const size_t *metadata);
 
+// Mixed precision: f32 lhs and output, rhs stored as bf16/f16/f8 (typically weights). The
+// rhs is converted while GEMM packs it, replacing a separate cast pass and its temporary.
+// Same metadata as matmul; named hodu_cpu_matmul_f32_<rhs type>.
+
+void hodu_cpu_matmul_f32_bf16(const void *lhs, const void *rhs, void *output,
+                              const size_t *metadata);
+void hodu_cpu_matmul_f32_f16(const void *lhs, const void *rhs, void *output,
+                             const size_t *metadata);
+void hodu_cpu_matmul_f32_f8e4m3(const void *lhs, const void *rhs, void *output,
+                                const size_t *metadata);
+void hodu_cpu_matmul_f32_f8e5m2(const void *lhs, const void *rhs, void *output,
+                                const size_t *metadata);
+
 // ============================================================================
 // 2D MATRIX MULTIPLICATION (DOT)
 // ============================================================================
@@ -109,6 +126,149 @@ void hodu_cpu_dot_u16(const void *lhs, const void *rhs, void *output, const size
 void hodu_cpu_dot_u32(const void *lhs, const void *rhs, void *output, const size_t *metadata);
 void hodu_cpu_dot_u64(const void *lhs, const void *rhs, void *output, const size_t *metadata);
 
+// ============================================================================
+// QUANTIZED MATRIX MULTIPLICATION (QMATMUL)
+// ============================================================================
+//
+// Performs 2D matrix multiplication of u8 activations (lhs) with i8 weights
+// (rhs), accumulating exactly in i32. Real values follow the affine scheme
+//   real = scale * (q - zero_point)
+// with a per-tensor lhs scale/zero point and per-tensor or per-output-column
+// rhs scales/zero points.
+//
+// All qmatmul operations follow this signature:
+//   void hodu_cpu_qmatmul_u8i8_out(const void *lhs, const void *rhs, void *output,
+//                                  const size_t *metadata, const hodu_cpu_qparams_t *params)
+//
+// Outputs:
+// - i32: sum_k (lhs - lhs_zp) * (rhs - rhs_zp[j]); scales are ignored
+// - f32: lhs_scale * rhs_scale[j] * i32 result
+// - i8:  f32 result requantized with output_scale/output_zero_point
+//        (round half to even, saturated to [-128, 127])
+//
+// Metadata layout: same as dot (M, K, N, strides, offsets).
+
+/// Quantization parameters for hodu_cpu_qmatmul_*
+typedef struct {
+    float lhs_scale;
+    int32_t lhs_zero_point;
+    const float *rhs_scales;        // rhs_channels entries
+    const int32_t *rhs_zero_points; // rhs_channels entries, NULL for symmetric weights
+    size_t rhs_channels;            // 1 = per-tensor, N = per output column
+    float output_scale;             // i8 output only
+    int32_t output_zero_point;      // i8 output only
+} hodu_cpu_qparams_t;
+
+void hodu_cpu_qmatmul_u8i8_i32(const void *lhs, const void *rhs, void *output,
+                               const size_t *metadata, const hodu_cpu_qparams_t *params);
+void hodu_cpu_qmatmul_u8i8_f32(const void *lhs, const void *rhs, void *output,
+                               const size_t *metadata, const hodu_cpu_qparams_t *params);
+void hodu_cpu_qmatmul_u8i8_i8(const void *lhs, const void *rhs, void *output,
+                              const size_t *metadata, const hodu_cpu_qparams_t *params);
+
+// ============================================================================
+// WEIGHT-ONLY QUANTIZED MATMUL
+// ============================================================================
+//
+// Multiplies f32/bf16 activations (lhs) by int4/int8 weights (rhs) quantized
+// in groups along K, for memory-bound decode GEMVs (M = 1) where reading int4
+// weights moves 8x fewer bytes than f32. Weights are dequantized in registers
+// (see hodu_cpu_gemm_f32_q4):
+//   rhs[k, j] = scale[j, g] * (q[j, k] - zero_point[j, g]),  g = k / group_size
+//
+// All weight-only quantized operations follow this signature:
+//   void hodu_cpu_matmul_<act>_<q>(const void *lhs, const void *rhs, void *output,
+//                                  const size_t *metadata,
+//                                  const hodu_cpu_group_qparams_t *params)
+//
+// The rhs is stored transposed, one row of K values per output column:
+// - q8: int8_t[N][K], signed
+// - q4: uint8_t[N][K / 2], unsigned 0..15, in blocks of 32 values packed into
+//   16 bytes: value i of a block in the low nibble of byte i for i < 16 and in
+//   the high nibble of byte i - 16 otherwise (the GGML Q4_0 nibble order)
+// The output is a contiguous [M, N] matrix of the activation type.
+//
+// Metadata layout:
+// - metadata[0]: M (rows of lhs)
+// - metadata[1]: K (cols of lhs / weights per output column)
+// - metadata[2]: N (output columns)
+// - metadata[3]: lhs_stride_m (stride for lhs rows)
+// - metadata[4]: lhs_stride_k (stride for lhs cols)
+// - metadata[5]: lhs_offset (starting offset in lhs)
+//
+// group_size must be a multiple of 32 dividing K (typically 32, 64 or 128);
+// calls with an invalid group size leave the output untouched.
+
+/// Per-group quantization parameters for hodu_cpu_matmul_<act>_q4/q8
+typedef struct {
+    const uint16_t *scales;      // f16 bits, [N][K / group_size]
+    const uint16_t *zero_points; // f16 bits, [N][K / group_size]; NULL = 8 (q4) / 0 (q8)
+    size_t group_size;           // K values sharing one scale and zero point
+} hodu_cpu_group_qparams_t;
+
+void hodu_cpu_matmul_f32_q4(const void *lhs, const void *rhs, void *output,
+                            const size_t *metadata, const hodu_cpu_group_qparams_t *params);
+void hodu_cpu_matmul_f32_q8(const void *lhs, const void *rhs, void *output,
+                            const size_t *metadata, const hodu_cpu_group_qparams_t *params);
+void hodu_cpu_matmul_bf16_q4(const void *lhs, const void *rhs, void *output,
+                             const size_t *metadata, const hodu_cpu_group_qparams_t *params);
+void hodu_cpu_matmul_bf16_q8(const void *lhs, const void *rhs, void *output,
+                             const size_t *metadata, const hodu_cpu_group_qparams_t *params);
+
+// ============================================================================
+// FUSED MATMUL (EPILOGUES)
+// ============================================================================
+//
+// Matmul followed by the element-wise epilogue of a dense layer, without
+// separate passes over the output (see epilogue.h):
+//   output = activation(scale * (lhs @ rhs) + bias + residual)
+//
+//   void hodu_cpu_matmul_fused_type(const void *lhs, const void *rhs, void *output,
+//                                   const size_t *metadata,
+//                                   const hodu_cpu_epilogue_t *epilogue)
+//
+// Metadata layout: same as matmul. bias holds N values (one per output column)
+// and residual has the contiguous output shape. A NULL epilogue computes the
+// plain product. Fused matmul always uses the native GEMM engine.
+
+void hodu_cpu_matmul_fused_f32(const void *lhs, const void *rhs, void *output,
+                               const size_t *metadata, const hodu_cpu_epilogue_t *epilogue);
+void hodu_cpu_matmul_fused_f64(const void *lhs, const void *rhs, void *output,
+                               const size_t *metadata, const hodu_cpu_epilogue_t *epilogue);
+
+// ============================================================================
+// PRE-PACKED WEIGHT MATMUL
+// ============================================================================
+//
+// A constant rhs (weight) can be packed once into the blocked GEMM layout and
+// reused by every later call, which then skips repacking and strided reads:
+//   bytes = hodu_cpu_matmul_packed_rhs_size_f32(K, N);
+//   hodu_cpu_matmul_pack_rhs_f32(rhs, packed, pack_metadata);                // once
+//   hodu_cpu_matmul_packed_f32(lhs, packed, output, matmul_metadata, NULL); // per call
+//
+// Pack metadata layout:
+// - metadata[0]: K (rows of rhs)
+// - metadata[1]: N (cols of rhs)
+// - metadata[2]: rhs_stride_k (stride for rhs rows)
+// - metadata[3]: rhs_stride_n (stride for rhs cols)
+// - metadata[4]: rhs_offset (starting offset in rhs)
+//
+// hodu_cpu_matmul_packed_* takes the regular matmul metadata and applies the
+// single packed [K, N] matrix to every batch; rhs shape, strides and offset are
+// ignored. It accepts the same optional epilogue as hodu_cpu_matmul_fused_*.
+// Packed buffers depend on the build (SIMD width); weights.h stores them in
+// files checked against that layout. Packed matmul always uses the native GEMM
+// engine.
+
+size_t hodu_cpu_matmul_packed_rhs_size_f32(size_t K, size_t N);
+size_t hodu_cpu_matmul_packed_rhs_size_f64(size_t K, size_t N);
+void hodu_cpu_matmul_pack_rhs_f32(const void *rhs, void *packed, const size_t *metadata);
+void hodu_cpu_matmul_pack_rhs_f64(const void *rhs, void *packed, const size_t *metadata);
+void hodu_cpu_matmul_packed_f32(const void *lhs, const void *packed_rhs, void *output,
+                                const size_t *metadata, const hodu_cpu_epilogue_t *epilogue);
+void hodu_cpu_matmul_packed_f64(const void *lhs, const void *packed_rhs, void *output,
+                                const size_t *metadata, const hodu_cpu_epilogue_t *epilogue);
+
 #ifdef __cplusplus
 }
 #endif
@@ -1,4 +1,5 @@
 #include "ops_matrix.h"
+#include "profile.h"
 #include "types.h"
 #include <stdbool.h>
 #include <stdint.h>
@@ -18,6 +19,7 @@ extern void hodu_cpu_dot_f64_fallback(const void *lhs_ptr, const void *rhs_ptr,
 /// F32 matmul using Accelerate cblas_sgemm
 void hodu_cpu_matmul_f32(const void *lhs_ptr, const void *rhs_ptr, void *output_ptr,
                          const size_t *metadata) {
+    HODU_PROFILE_KERNEL(hodu_cpu_profile_matmul_bytes(metadata, sizeof(f32_t), sizeof(f32_t)));
     const f32_t *lhs = (const f32_t *)lhs_ptr;
     const f32_t *rhs = (const f32_t *)rhs_ptr;
     f32_t *output = (f32_t *)output_ptr;
@@ -78,6 +80,7 @@ void hodu_cpu_matmul_f32(const void *lhs_ptr, const void *rhs_ptr, void *output_
         }
 
         if (batch_ndim == 0) {
+            HODU_PROFILE_PATH(HODU_CPU_PATH_BLAS);
             // No batching - single BLAS call
             cblas_sgemm(CblasRowMajor, trans_lhs, trans_rhs, M, N, K, 1.0f, lhs, lda, rhs, ldb,
                         0.0f, output, ldc);
@@ -112,6 +115,7 @@ void hodu_cpu_matmul_f32(const void *lhs_ptr, const void *rhs_ptr, void *output_
                 const f32_t *rhs_batch = rhs + rhs_batch_offset;
                 f32_t *out_batch = output + batch_idx * out_batch_stride;
 
+                HODU_PROFILE_PATH(HODU_CPU_PATH_BLAS);
                 cblas_sgemm(CblasRowMajor, trans_lhs, trans_rhs, M, N, K, 1.0f, lhs_batch, lda,
                             rhs_batch, ldb, 0.0f, out_batch, ldc);
             }
@@ -125,6 +129,7 @@ void hodu_cpu_matmul_f32(const void *lhs_ptr, const void *rhs_ptr, void *output_
 /// F64 matmul using Accelerate cblas_dgemm
 void hodu_cpu_matmul_f64(const void *lhs_ptr, const void *rhs_ptr, void *output_ptr,
                          const size_t *metadata) {
+    HODU_PROFILE_KERNEL(hodu_cpu_profile_matmul_bytes(metadata, sizeof(f64_t), sizeof(f64_t)));
     const f64_t *lhs = (const f64_t *)lhs_ptr;
     const f64_t *rhs = (const f64_t *)rhs_ptr;
     f64_t *output = (f64_t *)output_ptr;
@@ -179,6 +184,7 @@ void hodu_cpu_matmul_f64(const void *lhs_ptr, const void *rhs_ptr, void *output_
         }
 
         if (batch_ndim == 0) {
+            HODU_PROFILE_PATH(HODU_CPU_PATH_BLAS);
             // No batching - single BLAS call
             cblas_dgemm(CblasRowMajor, trans_lhs, trans_rhs, M, N, K, 1.0, lhs, lda, rhs, ldb, 0.0,
                         output, ldc);
@@ -213,6 +219,7 @@ void hodu_cpu_matmul_f64(const void *lhs_ptr, const void *rhs_ptr, void *output_
                 const f64_t *rhs_batch = rhs + rhs_batch_offset;
                 f64_t *out_batch = output + batch_idx * out_batch_stride;
 
+                HODU_PROFILE_PATH(HODU_CPU_PATH_BLAS);
                 cblas_dgemm(CblasRowMajor, trans_lhs, trans_rhs, M, N, K, 1.0, lhs_batch, lda,
                             rhs_batch, ldb, 0.0, out_batch, ldc);
             }
@@ -226,6 +233,7 @@ void hodu_cpu_matmul_f64(const void *lhs_ptr, const void *rhs_ptr, void *output_
 /// F32 dot product using Accelerate cblas_sgemm
 void hodu_cpu_dot_f32(const void *lhs_ptr, const void *rhs_ptr, void *output_ptr,
                       const size_t *metadata) {
+    HODU_PROFILE_KERNEL(hodu_cpu_profile_dot_bytes(metadata, sizeof(f32_t)));
     const f32_t *lhs = (const f32_t *)lhs_ptr;
     const f32_t *rhs = (const f32_t *)rhs_ptr;
     f32_t *output = (f32_t *)output_ptr;
@@ -272,6 +280,7 @@ void hodu_cpu_dot_f32(const void *lhs_ptr, const void *rhs_ptr, void *output_ptr
                 ldb = K;
         }
 
+        HODU_PROFILE_PATH(HODU_CPU_PATH_BLAS);
         cblas_sgemm(CblasRowMajor, trans_lhs, trans_rhs, M, N, K, 1.0f, lhs, lda, rhs, ldb, 0.0f,
                     output, N);
     } else {
@@ -283,6 +292,7 @@ void hodu_cpu_dot_f32(const void *lhs_ptr, const void *rhs_ptr, void *output_ptr
 /// F64 dot product using Accelerate cblas_dgemm
 void hodu_cpu_dot_f64(const void *lhs_ptr, const void *rhs_ptr, void *output_ptr,
                       const size_t *metadata) {
+    HODU_PROFILE_KERNEL(hodu_cpu_profile_dot_bytes(metadata, sizeof(f64_t)));
     const f64_t *lhs = (const f64_t *)lhs_ptr;
     const f64_t *rhs = (const f64_t *)rhs_ptr;
     f64_t *output = (f64_t *)output_ptr;
@@ -330,6 +340,7 @@ void hodu_cpu_dot_f64(const void *lhs_ptr, const void *rhs_ptr, void *output_ptr
                 ldb = K;
         }
 
+        HODU_PROFILE_PATH(HODU_CPU_PATH_BLAS);
         cblas_dgemm(CblasRowMajor, trans_lhs, trans_rhs, M, N, K, 1.0, lhs, lda, rhs, ldb, 0.0,
                     output, N);
     } else {
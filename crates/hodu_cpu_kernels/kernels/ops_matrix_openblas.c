@@ -1,4 +1,5 @@
 #include "ops_matrix.h"
+#include "profile.h"
 #include "types.h"
 #include <stdbool.h>
 #include <stdint.h>
@@ -18,6 +19,7 @@ extern void hodu_cpu_dot_f64_fallback(const void *lhs_ptr, const void *rhs_ptr,
 /// F32 matmul using OpenBLAS cblas_sgemm with thread control
 void hodu_cpu_matmul_f32(const void *lhs_ptr, const void *rhs_ptr, void *output_ptr,
                          const size_t *metadata) {
+    HODU_PROFILE_KERNEL(hodu_cpu_profile_matmul_bytes(metadata, sizeof(f32_t), sizeof(f32_t)));
     const f32_t *lhs = (const f32_t *)lhs_ptr;
     const f32_t *rhs = (const f32_t *)rhs_ptr;
     f32_t *output = (f32_t *)output_ptr;
@@ -88,11 +90,13 @@ void hodu_cpu_matmul_f32(const void *lhs_ptr, const void *rhs_ptr, void *output_
                 int saved_threads = openblas_get_num_threads();
                 openblas_set_num_threads(1);
 
+                HODU_PROFILE_PATH(HODU_CPU_PATH_BLAS);
                 cblas_sgemm(CblasRowMajor, trans_lhs, trans_rhs, M, N, K, 1.0f, lhs, lda, rhs, ldb,
                             0.0f, output, ldc);
 
                 openblas_set_num_threads(saved_threads);
             } else {
+                HODU_PROFILE_PATH(HODU_CPU_PATH_BLAS);
                 cblas_sgemm(CblasRowMajor, trans_lhs, trans_rhs, M, N, K, 1.0f, lhs, lda, rhs, ldb,
                             0.0f, output, ldc);
             }
@@ -138,6 +142,7 @@ void hodu_cpu_matmul_f32(const void *lhs_ptr, const void *rhs_ptr, void *output_
                 const f32_t *rhs_batch = rhs + rhs_batch_offset;
                 f32_t *out_batch = output + batch_idx * out_batch_stride;
 
+                HODU_PROFILE_PATH(HODU_CPU_PATH_BLAS);
                 cblas_sgemm(CblasRowMajor, trans_lhs, trans_rhs, M, N, K, 1.0f, lhs_batch, lda,
                             rhs_batch, ldb, 0.0f, out_batch, ldc);
             }
@@ -155,6 +160,7 @@ void hodu_cpu_matmul_f32(const void *lhs_ptr, const void *rhs_ptr, void *output_
 /// F64 matmul using OpenBLAS cblas_dgemm with thread control
 void hodu_cpu_matmul_f64(const void *lhs_ptr, const void *rhs_ptr, void *output_ptr,
                          const size_t *metadata) {
+    HODU_PROFILE_KERNEL(hodu_cpu_profile_matmul_bytes(metadata, sizeof(f64_t), sizeof(f64_t)));
     const f64_t *lhs = (const f64_t *)lhs_ptr;
     const f64_t *rhs = (const f64_t *)rhs_ptr;
     f64_t *output = (f64_t *)output_ptr;
@@ -218,11 +224,13 @@ void hodu_cpu_matmul_f64(const void *lhs_ptr, const void *rhs_ptr, void *output_
                 int saved_threads = openblas_get_num_threads();
                 openblas_set_num_threads(1);
 
+                HODU_PROFILE_PATH(HODU_CPU_PATH_BLAS);
                 cblas_dgemm(CblasRowMajor, trans_lhs, trans_rhs, M, N, K, 1.0, lhs, lda, rhs, ldb,
                             0.0, output, ldc);
 
                 openblas_set_num_threads(saved_threads);
             } else {
+                HODU_PROFILE_PATH(HODU_CPU_PATH_BLAS);
                 cblas_dgemm(CblasRowMajor, trans_lhs, trans_rhs, M, N, K, 1.0, lhs, lda, rhs, ldb,
                             0.0, output, ldc);
             }
@@ -268,6 +276,7 @@ void hodu_cpu_matmul_f64(const void *lhs_ptr, const void *rhs_ptr, void *output_
                 const f64_t *rhs_batch = rhs + rhs_batch_offset;
                 f64_t *out_batch = output + batch_idx * out_batch_stride;
 
+                HODU_PROFILE_PATH(HODU_CPU_PATH_BLAS);
                 cblas_dgemm(CblasRowMajor, trans_lhs, trans_rhs, M, N, K, 1.0, lhs_batch, lda,
                             rhs_batch, ldb, 0.0, out_batch, ldc);
             }
@@ -285,6 +294,7 @@ void hodu_cpu_matmul_f64(const void *lhs_ptr, const void *rhs_ptr, void *output_
 /// F32 dot product using OpenBLAS cblas_sgemm
 void hodu_cpu_dot_f32(const void *lhs_ptr, const void *rhs_ptr, void *output_ptr,
                       const size_t *metadata) {
+    HODU_PROFILE_KERNEL(hodu_cpu_profile_dot_bytes(metadata, sizeof(f32_t)));
     const f32_t *lhs = (const f32_t *)lhs_ptr;
     const f32_t *rhs = (const f32_t *)rhs_ptr;
     f32_t *output = (f32_t *)output_ptr;
@@ -331,6 +341,7 @@ void hodu_cpu_dot_f32(const void *lhs_ptr, const void *rhs_ptr, void *output_ptr
                 ldb = K;
         }
 
+        HODU_PROFILE_PATH(HODU_CPU_PATH_BLAS);
         cblas_sgemm(CblasRowMajor, trans_lhs, trans_rhs, M, N, K, 1.0f, lhs, lda, rhs, ldb, 0.0f,
                     output, N);
     } else {
@@ -342,6 +353,7 @@ void hodu_cpu_dot_f32(const void *lhs_ptr, const void *rhs_ptr, void *output_ptr
 /// F64 dot product using OpenBLAS cblas_dgemm
 void hodu_cpu_dot_f64(const void *lhs_ptr, const void *rhs_ptr, void *output_ptr,
                       const size_t *metadata) {
+    HODU_PROFILE_KERNEL(hodu_cpu_profile_dot_bytes(metadata, sizeof(f64_t)));
     const f64_t *lhs = (const f64_t *)lhs_ptr;
     const f64_t *rhs = (const f64_t *)rhs_ptr;
     f64_t *output = (f64_t *)output_ptr;
@@ -389,6 +401,7 @@ void hodu_cpu_dot_f64(const void *lhs_ptr, const void *rhs_ptr, void *output_ptr
                 ldb = K;
         }
 
+        HODU_PROFILE_PATH(HODU_CPU_PATH_BLAS);
         cblas_dgemm(CblasRowMajor, trans_lhs, trans_rhs, M, N, K, 1.0, lhs, lda, rhs, ldb, 0.0,
                     output, N);
     } else {
@@ -1,5 +1,6 @@
 #include "ops_memory.h"
-#include "thread_utils.h"
+#include "profile.h"
+#include "strided_copy.h"
 #include "types.h"
 #include <string.h>
 
@@ -14,27 +15,13 @@
  * @brief Macro to implement contiguous copy operation
  *
  * Copies tensor data from potentially strided layout to contiguous memory.
- * Optimizes for already-contiguous tensors with memcpy.
+ * Already-contiguous tensors are a single memcpy; any other layout goes through
+ * the strided copy engine (merged dims, row memcpy, blocked transpose).
  */
 #define IMPL_CONTIGUOUS_OP(TYPE, TYPE_SUFFIX)                                                      \
-    typedef struct {                                                                               \
-        const TYPE *input;                                                                         \
-        TYPE *output;                                                                              \
-        size_t start;                                                                              \
-        size_t end;                                                                                \
-        size_t offset;                                                                             \
-    } contiguous_##TYPE_SUFFIX##_args_t;                                                           \
-                                                                                                   \
-    static void *contiguous_##TYPE_SUFFIX##_worker(void *arg) {                                    \
-        contiguous_##TYPE_SUFFIX##_args_t *args = (contiguous_##TYPE_SUFFIX##_args_t *)arg;        \
-        for (size_t i = args->start; i < args->end; i++) {                                         \
-            args->output[i] = args->input[args->offset + i];                                       \
-        }                                                                                          \
-        return NULL;                                                                               \
-    }                                                                                              \
-                                                                                                   \
     void hodu_cpu_contiguous_##TYPE_SUFFIX(const void *input, void *output,                        \
                                            const size_t *metadata) {                               \
+        HODU_PROFILE_KERNEL(metadata[0] * 2 * sizeof(TYPE));                                       \
         const size_t num_els = metadata[0];                                                        \
         const size_t num_dims = metadata[1];                                                       \
         const TYPE *in = (const TYPE *)input;                                                      \
@@ -50,37 +37,7 @@
             /* Fast path: already contiguous, use memcpy */                                        \
             memcpy(out, in + offset, num_els * sizeof(TYPE));                                      \
         } else {                                                                                   \
-            /* Slow path: strided access */                                                        \
-            const size_t min_work_per_thread = 100000;                                             \
-            size_t num_threads = get_optimal_threads(num_els, min_work_per_thread);                \
-                                                                                                   \
-            if (num_threads > 1 && contiguous) {                                                   \
-                /* Multi-threaded contiguous copy (won't reach here, but for completeness) */      \
-                thread_t threads[num_threads];                                                     \
-                contiguous_##TYPE_SUFFIX##_args_t args[num_threads];                               \
-                                                                                                   \
-                size_t chunk_size = num_els / num_threads;                                         \
-                size_t remaining = num_els % num_threads;                                          \
-                                                                                                   \
-                for (size_t t = 0; t < num_threads; t++) {                                         \
-                    args[t].input = in;                                                            \
-                    args[t].output = out;                                                          \
-                    args[t].offset = offset;                                                       \
-                    args[t].start = t * chunk_size + (t < remaining ? t : remaining);              \
-                    args[t].end = args[t].start + chunk_size + (t < remaining ? 1 : 0);            \
-                    thread_create(&threads[t], contiguous_##TYPE_SUFFIX##_worker, &args[t]);       \
-                }                                                                                  \
-                                                                                                   \
-                for (size_t t = 0; t < num_threads; t++) {                                         \
-                    thread_join(threads[t]);                                                       \
-                }                                                                                  \
-            } else {                                                                               \
-                /* Single-threaded strided copy */                                                 \
-                for (size_t i = 0; i < num_els; i++) {                                             \
-                    size_t strided_i = offset + get_strided_index(i, num_dims, dims, strides);     \
-                    out[i] = in[strided_i];                                                        \
-                }                                                                                  \
-            }                                                                                      \
+            hodu_cpu_strided_copy(in + offset, out, sizeof(TYPE), num_dims, dims, strides, NULL);  \
         }                                                                                          \
     }
 
@@ -0,0 +1,537 @@
+#include "ops_norm.h"
+#include "profile.h"
+#include "simd_utils.h"
+#include "thread_utils.h"
+#include "types.h"
+#include "workspace.h"
+#include <math.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#define MAX(a, b) ((a) > (b) ? (a) : (b))
+#define MIN(a, b) ((a) < (b) ? (a) : (b))
+
+// ============================================================================
+// FUSED ROW-WISE NORMALIZATION
+// ============================================================================
+//
+// Each operation reads one row (the elements along dim) and writes the
+// normalized row, instead of the separate max/sub/exp/sum/div or
+// mean/var/sub/div/mul/add kernels (each a full pass over the tensor):
+// - softmax: rows are taken in blocks of NORM_BLOCK elements; every block's
+//   max is found with SIMD, exp(x - block_max) is written straight to the
+//   output and the running (max, sum) is rescaled online. A second sweep over
+//   the output (still in cache) applies exp(block_max - max) / sum per block,
+//   so the input is read once
+// - log_softmax: the same online (max, sum), then x - (max + log(sum))
+// - layer_norm: SIMD sum and corrected two-pass variance of the row, then one
+//   fused normalize + affine sweep
+// - rms_norm: SIMD sum of squares, then one fused scale + weight sweep
+//
+// Rows with a contiguous dim are processed in place (f32/f64); strided rows
+// and exotic types are gathered into a per-thread scratch row first.
+//
+// Metadata layout: see ops_norm.h
+
+/// Elements per block of the online softmax
+#define NORM_BLOCK 256
+
+/// Minimum elements per parallel task
+#define NORM_PARALLEL_WORK 32768
+
+/// Normalization computed by a row kernel
+typedef enum {
+    NORM_SOFTMAX,
+    NORM_LOG_SOFTMAX,
+    NORM_LAYER,
+    NORM_RMS,
+} norm_kind_t;
+
+// ============================================================================
+// VECTOR HELPERS
+// ============================================================================
+
+/// Macro to implement SIMD row helpers for f32/f64
+///
+/// @param TYPE C float type
+/// @param SFX simd_utils suffix (f32 or f64)
+/// @param WIDTH SIMD width of TYPE
+#define NORM_VEC_SIMD(TYPE, SFX, WIDTH)                                                            \
+    /* Maximum of n >= 1 elements */                                                               \
+    static inline TYPE norm_max_##SFX(const TYPE *x, size_t n) {                                   \
+        size_t i = 0;                                                                              \
+        TYPE m = x[0];                                                                             \
+        if (n >= WIDTH) {                                                                          \
+            simd_##SFX##_t vm = simd_##SFX##_load(x);                                              \
+            for (i = WIDTH; i + WIDTH <= n; i += WIDTH) {                                          \
+                vm = simd_##SFX##_max(vm, simd_##SFX##_load(x + i));                               \
+            }                                                                                      \
+            m = simd_##SFX##_reduce_max(vm);                                                       \
+        }                                                                                          \
+        for (; i < n; i++) {                                                                       \
+            m = x[i] > m ? x[i] : m;                                                               \
+        }                                                                                          \
+        return m;                                                                                  \
+    }                                                                                              \
+                                                                                                   \
+    static inline TYPE norm_sum_##SFX(const TYPE *x, size_t n) {                                   \
+        size_t i = 0;                                                                              \
+        TYPE s = 0;                                                                                \
+        if (n >= WIDTH) {                                                                          \
+            simd_##SFX##_t vs = simd_##SFX##_set1(0);                                              \
+            for (; i + WIDTH <= n; i += WIDTH) {                                                   \
+                vs = simd_##SFX##_add(vs, simd_##SFX##_load(x + i));                               \
+            }                                                                                      \
+            s = simd_##SFX##_reduce_add(vs);                                                       \
+        }                                                                                          \
+        for (; i < n; i++) {                                                                       \
+            s += x[i];                                                                             \
+        }                                                                                          \
+        return s;                                                                                  \
+    }                                                                                              \
+                                                                                                   \
+    static inline TYPE norm_sumsq_##SFX(const TYPE *x, size_t n) {                                 \
+        size_t i = 0;                                                                              \
+        TYPE s = 0;                                                                                \
+        if (n >= WIDTH) {                                                                          \
+            simd_##SFX##_t vs = simd_##SFX##_set1(0);                                              \
+            for (; i + WIDTH <= n; i += WIDTH) {                                                   \
+                const simd_##SFX##_t v = simd_##SFX##_load(x + i);                                 \
+                vs = simd_##SFX##_fmadd(v, v, vs);                                                 \
+            }                                                                                      \
+            s = simd_##SFX##_reduce_add(vs);                                                       \
+        }                                                                                          \
+        for (; i < n; i++) {                                                                       \
+            s += x[i] * x[i];                                                                      \
+        }                                                                                          \
+        return s;                                                                                  \
+    }                                                                                              \
+                                                                                                   \
+    /* Sum of squared deviations from mean; *dev receives the sum of deviations */                 \
+    static inline TYPE norm_sqdev_##SFX(const TYPE *x, size_t n, TYPE mean, TYPE *dev) {           \
+        size_t i = 0;                                                                              \
+        TYPE s = 0, d = 0;                                                                         \
+        if (n >= WIDTH) {                                                                          \
+            const simd_##SFX##_t vmean = simd_##SFX##_set1(mean);                                  \
+            simd_##SFX##_t vs = simd_##SFX##_set1(0);                                              \
+            simd_##SFX##_t vd = simd_##SFX##_set1(0);                                              \
+            for (; i + WIDTH <= n; i += WIDTH) {                                                   \
+                const simd_##SFX##_t v = simd_##SFX##_sub(simd_##SFX##_load(x + i), vmean);        \
+                vd = simd_##SFX##_add(vd, v);                                                      \
+                vs = simd_##SFX##_fmadd(v, v, vs);                                                 \
+            }                                                                                      \
+            s = simd_##SFX##_reduce_add(vs);                                                       \
+            d = simd_##SFX##_reduce_add(vd);                                                       \
+        }                                                                                          \
+        for (; i < n; i++) {                                                                       \
+            const TYPE v = x[i] - mean;                                                            \
+            d += v;                                                                                \
+            s += v * v;                                                                            \
+        }                                                                                          \
+        *dev = d;                                                                                  \
+        return s;                                                                                  \
+    }                                                                                              \
+                                                                                                   \
+    /* y = (x - shift - resid) * scale * w + b (w/b NULL skip the term; y may alias x) */          \
+    static inline void norm_apply_##SFX(const TYPE *x, TYPE *y, size_t n, TYPE shift, TYPE resid,  \
+                                        TYPE scale, const TYPE *w, const TYPE *b) {                \
+        size_t i = 0;                                                                              \
+        const simd_##SFX##_t vshift = simd_##SFX##_set1(shift);                                    \
+        const simd_##SFX##_t vresid = simd_##SFX##_set1(resid);                                    \
+        const simd_##SFX##_t vscale = simd_##SFX##_set1(scale);                                    \
+        const simd_##SFX##_t vzero = simd_##SFX##_set1(0);                                         \
+        if (w) {                                                                                   \
+            for (; i + WIDTH <= n; i += WIDTH) {                                                   \
+                const simd_##SFX##_t v =                                                           \
+                    simd_##SFX##_sub(simd_##SFX##_sub(simd_##SFX##_load(x + i), vshift), vresid);  \
+                const simd_##SFX##_t vw = simd_##SFX##_mul(simd_##SFX##_load(w + i), vscale);      \
+                const simd_##SFX##_t vb = b ? simd_##SFX##_load(b + i) : vzero;                    \
+                simd_##SFX##_store(y + i, simd_##SFX##_fmadd(v, vw, vb));                          \
+            }                                                                                      \
+        } else if (b) {                                                                            \
+            for (; i + WIDTH <= n; i += WIDTH) {                                                   \
+                const simd_##SFX##_t v =                                                           \
+                    simd_##SFX##_sub(simd_##SFX##_sub(simd_##SFX##_load(x + i), vshift), vresid);  \
+                const simd_##SFX##_t vb = simd_##SFX##_load(b + i);                                \
+                simd_##SFX##_store(y + i, simd_##SFX##_fmadd(v, vscale, vb));                      \
+            }                                                                                      \
+        } else {                                                                                   \
+            for (; i + WIDTH <= n; i += WIDTH) {                                                   \
+                const simd_##SFX##_t v =                                                           \
+                    simd_##SFX##_sub(simd_##SFX##_sub(simd_##SFX##_load(x + i), vshift), vresid);  \
+                simd_##SFX##_store(y + i, simd_##SFX##_mul(v, vscale));                            \
+            }                                                                                      \
+        }                                                                                          \
+        for (; i < n; i++) {                                                                       \
+            y[i] = (x[i] - shift - resid) * scale * (w ? w[i] : (TYPE)1) + (b ? b[i] : (TYPE)0);   \
+        }                                                                                          \
+    }
+
+/// Macro to implement scalar row helpers (no SIMD for TYPE)
+///
+/// @param TYPE C float type
+/// @param SFX Suffix for naming (f32 or f64)
+#define NORM_VEC_SCALAR(TYPE, SFX)                                                                 \
+    static inline TYPE norm_max_##SFX(const TYPE *x, size_t n) {                                   \
+        TYPE m = x[0];                                                                             \
+        for (size_t i = 1; i < n; i++) {                                                           \
+            m = x[i] > m ? x[i] : m;                                                               \
+        }                                                                                          \
+        return m;                                                                                  \
+    }                                                                                              \
+                                                                                                   \
+    static inline TYPE norm_sum_##SFX(const TYPE *x, size_t n) {                                   \
+        TYPE s = 0;                                                                                \
+        for (size_t i = 0; i < n; i++) {                                                           \
+            s += x[i];                                                                             \
+        }                                                                                          \
+        return s;                                                                                  \
+    }                                                                                              \
+                                                                                                   \
+    static inline TYPE norm_sumsq_##SFX(const TYPE *x, size_t n) {                                 \
+        TYPE s = 0;                                                                                \
+        for (size_t i = 0; i < n; i++) {                                                           \
+            s += x[i] * x[i];                                                                      \
+        }                                                                                          \
+        return s;                                                                                  \
+    }                                                                                              \
+                                                                                                   \
+    static inline TYPE norm_sqdev_##SFX(const TYPE *x, size_t n, TYPE mean, TYPE *dev) {           \
+        TYPE s = 0, d = 0;                                                                         \
+        for (size_t i = 0; i < n; i++) {                                                           \
+            const TYPE v = x[i] - mean;                                                            \
+            d += v;                                                                                \
+            s += v * v;                                                                            \
+        }                                                                                          \
+        *dev = d;                                                                                  \
+        return s;                                                                                  \
+    }                                                                                              \
+                                                                                                   \
+    static inline void norm_apply_##SFX(const TYPE *x, TYPE *y, size_t n, TYPE shift, TYPE resid,  \
+                                        TYPE scale, const TYPE *w, const TYPE *b) {                \
+        for (size_t i = 0; i < n; i++) {                                                           \
+            y[i] = (x[i] - shift - resid) * scale * (w ? w[i] : (TYPE)1) + (b ? b[i] : (TYPE)0);   \
+        }                                                                                          \
+    }
+
+/// Macro to implement the scalar sum of exp(x - shift)
+///
+/// @param TYPE C float type
+/// @param SFX Suffix for naming (f32 or f64)
+/// @param EXP_FN Exponential function
+#define NORM_EXP_SUM_SCALAR(TYPE, SFX, EXP_FN)                                                     \
+    /* Sum of exp(x - shift), also stored to y unless y is NULL (y may alias x) */                 \
+    static inline TYPE norm_exp_sum_##SFX(const TYPE *x, TYPE *y, size_t n, TYPE shift) {          \
+        TYPE s = 0;                                                                                \
+        for (size_t i = 0; i < n; i++) {                                                           \
+            const TYPE e = EXP_FN(x[i] - shift);                                                   \
+            if (y) {                                                                               \
+                y[i] = e;                                                                          \
+            }                                                                                      \
+            s += e;                                                                                \
+        }                                                                                          \
+        return s;                                                                                  \
+    }
+
+#if SIMD_F32_WIDTH > 1
+NORM_VEC_SIMD(f32_t, f32, SIMD_F32_WIDTH)
+
+// Sum of exp(x - shift) with the polynomial simd_f32_exp, also stored to y unless y is NULL
+static inline f32_t norm_exp_sum_f32(const f32_t *x, f32_t *y, size_t n, f32_t shift) {
+    const simd_f32_t vshift = simd_f32_set1(shift);
+    simd_f32_t vs = simd_f32_set1(0.0f);
+    size_t i = 0;
+    for (; i + SIMD_F32_WIDTH <= n; i += SIMD_F32_WIDTH) {
+        const simd_f32_t e = simd_f32_exp(simd_f32_sub(simd_f32_load(x + i), vshift));
+        if (y) {
+            simd_f32_store(y + i, e);
+        }
+        vs = simd_f32_add(vs, e);
+    }
+    f32_t s = simd_f32_reduce_add(vs);
+    for (; i < n; i++) {
+        const f32_t e = expf(x[i] - shift);
+        if (y) {
+            y[i] = e;
+        }
+        s += e;
+    }
+    return s;
+}
+#else
+NORM_VEC_SCALAR(f32_t, f32)
+NORM_EXP_SUM_SCALAR(f32_t, f32, expf)
+#endif
+#if SIMD_F64_WIDTH > 1
+NORM_VEC_SIMD(f64_t, f64, SIMD_F64_WIDTH)
+#else
+NORM_VEC_SCALAR(f64_t, f64)
+#endif
+NORM_EXP_SUM_SCALAR(f64_t, f64, exp)
+
+// ============================================================================
+// ROW KERNELS
+// ============================================================================
+
+/// Macro to implement the row kernels for a compute type
+///
+/// @param TYPE C float type rows are computed in
+/// @param SFX Suffix for naming (f32 or f64)
+/// @param EXP_FN Exponential function
+/// @param LOG_FN Natural logarithm function
+/// @param SQRT_FN Square root function
+#define NORM_ROWS(TYPE, SFX, EXP_FN, LOG_FN, SQRT_FN)                                              \
+    /* Online (max, sum of exp(x - max)) of a row; with y != NULL, exp(x - block_max) is   */      \
+    /* stored to y and each block's max to block_max                                      */       \
+    static inline void norm_online_##SFX(const TYPE *x, TYPE *y, size_t n, TYPE *block_max,        \
+                                         TYPE *max_out, TYPE *sum_out) {                           \
+        TYPE m = -INFINITY, s = 0;                                                                 \
+        for (size_t i = 0, blk = 0; i < n; i += NORM_BLOCK, blk++) {                               \
+            const size_t len = MIN((size_t)NORM_BLOCK, n - i);                                     \
+            const TYPE bm = norm_max_##SFX(x + i, len);                                            \
+            TYPE bs = 0;                                                                           \
+            if (y) {                                                                               \
+                block_max[blk] = bm;                                                               \
+            }                                                                                      \
+            if (bm != -INFINITY) {                                                                 \
+                bs = norm_exp_sum_##SFX(x + i, y ? y + i : NULL, len, bm);                         \
+            } else if (y) {                                                                        \
+                for (size_t j = 0; j < len; j++) {                                                 \
+                    y[i + j] = 0;                                                                  \
+                }                                                                                  \
+            }                                                                                      \
+            if (bm == -INFINITY) {                                                                 \
+                continue;                                                                          \
+            }                                                                                      \
+            if (bm > m) {                                                                          \
+                s = s * EXP_FN(m - bm) + bs;                                                       \
+                m = bm;                                                                            \
+            } else {                                                                               \
+                s += bs * EXP_FN(bm - m);                                                          \
+            }                                                                                      \
+        }                                                                                          \
+        *max_out = m;                                                                              \
+        *sum_out = s;                                                                              \
+    }                                                                                              \
+                                                                                                   \
+    static inline void norm_softmax_row_##SFX(const TYPE *x, TYPE *y, size_t n, TYPE *block_max) { \
+        TYPE m, s;                                                                                 \
+        norm_online_##SFX(x, y, n, block_max, &m, &s);                                             \
+        const TYPE inv = (TYPE)1 / s;                                                              \
+        for (size_t i = 0, blk = 0; i < n; i += NORM_BLOCK, blk++) {                               \
+            const size_t len = MIN((size_t)NORM_BLOCK, n - i);                                     \
+            const TYPE f = block_max[blk] == -INFINITY ? (TYPE)0 : EXP_FN(block_max[blk] - m);     \
+            norm_apply_##SFX(y + i, y + i, len, 0, 0, f * inv, NULL, NULL);                        \
+        }                                                                                          \
+    }                                                                                              \
+                                                                                                   \
+    static inline void norm_log_softmax_row_##SFX(const TYPE *x, TYPE *y, size_t n) {              \
+        TYPE m, s;                                                                                 \
+        norm_online_##SFX(x, NULL, n, NULL, &m, &s);                                               \
+        norm_apply_##SFX(x, y, n, m, LOG_FN(s), 1, NULL, NULL);                                    \
+    }                                                                                              \
+                                                                                                   \
+    /* Corrected two-pass statistics: the residual mean of the deviations restores the */          \
+    /* rounding of the first-pass mean                                                 */          \
+    static inline void norm_layer_row_##SFX(const TYPE *x, TYPE *y, size_t n, const TYPE *w,       \
+                                            const TYPE *b, TYPE eps) {                             \
+        const TYPE mean = norm_sum_##SFX(x, n) / (TYPE)n;                                          \
+        TYPE dev;                                                                                  \
+        const TYPE m2 = norm_sqdev_##SFX(x, n, mean, &dev);                                        \
+        const TYPE var = MAX((m2 - dev * dev / (TYPE)n) / (TYPE)n, (TYPE)0);                       \
+        norm_apply_##SFX(x, y, n, mean, dev / (TYPE)n, (TYPE)1 / SQRT_FN(var + eps), w, b);        \
+    }                                                                                              \
+                                                                                                   \
+    static inline void norm_rms_row_##SFX(const TYPE *x, TYPE *y, size_t n, const TYPE *w,         \
+                                          TYPE eps) {                                              \
+        const TYPE ms = norm_sumsq_##SFX(x, n) / (TYPE)n;                                          \
+        norm_apply_##SFX(x, y, n, 0, 0, (TYPE)1 / SQRT_FN(ms + eps), w, NULL);                     \
+    }                                                                                              \
+                                                                                                   \
+    static inline void norm_row_##SFX(norm_kind_t kind, const TYPE *x, TYPE *y, size_t n,          \
+                                      const TYPE *w, const TYPE *b, TYPE eps, TYPE *block_max) {   \
+        switch (kind) {                                                                            \
+        case NORM_SOFTMAX:                                                                         \
+            norm_softmax_row_##SFX(x, y, n, block_max);                                            \
+            break;                                                                                 \
+        case NORM_LOG_SOFTMAX:                                                                     \
+            norm_log_softmax_row_##SFX(x, y, n);                                                   \
+            break;                                                                                 \
+        case NORM_LAYER:                                                                           \
+            norm_layer_row_##SFX(x, y, n, w, b, eps);                                              \
+            break;                                                                                 \
+        case NORM_RMS:                                                                             \
+            norm_rms_row_##SFX(x, y, n, w, eps);                                                   \
+            break;                                                                                 \
+        }                                                                                          \
+    }
+
+NORM_ROWS(f32_t, f32, expf, logf, sqrtf)
+NORM_ROWS(f64_t, f64, exp, log, sqrt)
+
+// ============================================================================
+// DRIVER
+// ============================================================================
+
+/// Arguments shared by the row tasks of one call
+typedef struct {
+    const void *input;
+    void *output;
+    const size_t *metadata;
+    const void *weight; // compute-type affine weight, NULL if absent
+    const void *bias;   // compute-type affine bias, NULL if absent
+    float eps;
+    norm_kind_t kind;
+    size_t n;     // elements per row (shape[dim])
+    size_t inner; // product of the dims after dim (output stride along dim)
+} norm_args_t;
+
+/// Input offset of the first element of a row; *out_base receives the output offset
+static inline size_t norm_row_offset(const size_t *metadata, size_t row, size_t n, size_t inner,
+                                     size_t *out_base) {
+    const size_t num_dims = metadata[1];
+    const size_t *shape = &metadata[2];
+    const size_t *strides = &metadata[2 + num_dims];
+    size_t offset = metadata[2 + 2 * num_dims];
+    if (num_dims == 0) {
+        *out_base = 0;
+        return offset;
+    }
+    const size_t dim = metadata[3 + 2 * num_dims];
+    size_t outer = row / inner;
+    size_t in = row % inner;
+    *out_base = outer * n * inner + in;
+    for (size_t d = num_dims; d-- > dim + 1;) {
+        offset += (in % shape[d]) * strides[d];
+        in /= shape[d];
+    }
+    for (size_t d = dim; d-- > 0;) {
+        offset += (outer % shape[d]) * strides[d];
+        outer /= shape[d];
+    }
+    return offset;
+}
+
+/// Macro to implement the row task and entry points for one type
+///
+/// @param TYPE C type of the tensor
+/// @param TYPE_SUFFIX Suffix for function naming
+/// @param CTYPE C float type rows are computed in (f32_t or f64_t)
+/// @param CSFX Suffix of the compute type (f32 or f64)
+/// @param TO_CORE Conversion from TYPE to CTYPE
+/// @param FROM_CORE Conversion from CTYPE to TYPE
+/// @param NATIVE 1 when TYPE is CTYPE (contiguous rows are used in place)
+#define NORM_OPS(TYPE, TYPE_SUFFIX, CTYPE, CSFX, TO_CORE, FROM_CORE, NATIVE)                       \
+    static void norm_task_##TYPE_SUFFIX(size_t start, size_t end, void *ctx) {                     \
+        const norm_args_t *a = (const norm_args_t *)ctx;                                           \
+        const size_t num_dims = a->metadata[1];                                                    \
+        const size_t n = a->n;                                                                     \
+        const size_t dim = num_dims ? a->metadata[3 + 2 * num_dims] : 0;                           \
+        const size_t stride = num_dims ? a->metadata[2 + num_dims + dim] : 1;                      \
+        const bool direct = NATIVE && stride == 1 && a->inner == 1;                                \
+        const size_t row_elems = direct ? 0 : 2 * n;                                               \
+        CTYPE *scratch =                                                                           \
+            (CTYPE *)workspace_acquire((row_elems + n / NORM_BLOCK + 1) * sizeof(CTYPE));          \
+        if (!scratch) {                                                                            \
+            return;                                                                                \
+        }                                                                                          \
+        const TYPE *in = (const TYPE *)a->input;                                                   \
+        TYPE *out = (TYPE *)a->output;                                                             \
+        CTYPE *x = scratch;                                                                        \
+        CTYPE *y = scratch + n;                                                                    \
+        CTYPE *block_max = scratch + row_elems;                                                    \
+        for (size_t r = start; r < end; r++) {                                                     \
+            size_t out_base;                                                                       \
+            const size_t in_base = norm_row_offset(a->metadata, r, n, a->inner, &out_base);        \
+            if (direct) {                                                                          \
+                norm_row_##CSFX(a->kind, (const CTYPE *)(in + in_base), (CTYPE *)(out + out_base), \
+                                n, (const CTYPE *)a->weight, (const CTYPE *)a->bias,               \
+                                (CTYPE)a->eps, block_max);                                         \
+                continue;                                                                          \
+            }                                                                                      \
+            for (size_t j = 0; j < n; j++) {                                                       \
+                x[j] = TO_CORE(in[in_base + j * stride]);                                          \
+            }                                                                                      \
+            norm_row_##CSFX(a->kind, x, y, n, (const CTYPE *)a->weight, (const CTYPE *)a->bias,    \
+                            (CTYPE)a->eps, block_max);                                             \
+            for (size_t j = 0; j < n; j++) {                                                       \
+                out[out_base + j * a->inner] = FROM_CORE(y[j]);                                    \
+            }                                                                                      \
+        }                                                                                          \
+        workspace_release(scratch);                                                                \
+    }                                                                                              \
+                                                                                                   \
+    static void norm_run_##TYPE_SUFFIX(const void *input, const void *weight, const void *bias,    \
+                                       void *output, const size_t *metadata, float eps,            \
+                                       norm_kind_t kind) {                                         \
+        const size_t num_els = metadata[0];                                                        \
+        const size_t num_dims = metadata[1];                                                       \
+        size_t n = 1, inner = 1;                                                                   \
+        if (num_dims > 0) {                                                                        \
+            const size_t dim = metadata[3 + 2 * num_dims];                                         \
+            n = metadata[2 + dim];                                                                 \
+            for (size_t d = dim + 1; d < num_dims; d++) {                                          \
+                inner *= metadata[2 + d];                                                          \
+            }                                                                                      \
+        }                                                                                          \
+        if (num_els == 0 || n == 0) {                                                              \
+            return;                                                                                \
+        }                                                                                          \
+                                                                                                   \
+        /* Affine parameters in the compute type, shared by every row */                           \
+        CTYPE *params = NULL;                                                                      \
+        if (!NATIVE && (weight || bias)) {                                                         \
+            params = (CTYPE *)workspace_acquire(2 * n * sizeof(CTYPE));                            \
+            if (!params) {                                                                         \
+                return;                                                                            \
+            }                                                                                      \
+            for (size_t j = 0; j < n; j++) {                                                       \
+                params[j] = weight ? TO_CORE(((const TYPE *)weight)[j]) : (CTYPE)1;                \
+                params[n + j] = bias ? TO_CORE(((const TYPE *)bias)[j]) : (CTYPE)0;                \
+            }                                                                                      \
+        }                                                                                          \
+                                                                                                   \
+        norm_args_t args = {input, output, metadata, weight, bias, eps, kind, n, inner};           \
+        if (params) {                                                                              \
+            args.weight = weight ? params : NULL;                                                  \
+            args.bias = bias ? params + n : NULL;                                                  \
+        }                                                                                          \
+        parallel_for(0, num_els / n, MAX((size_t)1, NORM_PARALLEL_WORK / n),                       \
+                     norm_task_##TYPE_SUFFIX, &args);                                              \
+        if (params) {                                                                              \
+            workspace_release(params);                                                             \
+        }                                                                                          \
+    }                                                                                              \
+                                                                                                   \
+    void hodu_cpu_softmax_##TYPE_SUFFIX(const void *input, void *output, const size_t *metadata) { \
+        HODU_PROFILE_KERNEL(metadata[0] * 2 * sizeof(TYPE));                                       \
+        norm_run_##TYPE_SUFFIX(input, NULL, NULL, output, metadata, 0.0f, NORM_SOFTMAX);           \
+    }                                                                                              \
+                                                                                                   \
+    void hodu_cpu_log_softmax_##TYPE_SUFFIX(const void *input, void *output,                       \
+                                            const size_t *metadata) {                              \
+        HODU_PROFILE_KERNEL(metadata[0] * 2 * sizeof(TYPE));                                       \
+        norm_run_##TYPE_SUFFIX(input, NULL, NULL, output, metadata, 0.0f, NORM_LOG_SOFTMAX);       \
+    }                                                                                              \
+                                                                                                   \
+    void hodu_cpu_layer_norm_##TYPE_SUFFIX(const void *input, const void *weight,                  \
+                                           const void *bias, void *output,                         \
+                                           const size_t *metadata, float eps) {                    \
+        HODU_PROFILE_KERNEL(metadata[0] * 2 * sizeof(TYPE));                                       \
+        norm_run_##TYPE_SUFFIX(input, weight, bias, output, metadata, eps, NORM_LAYER);            \
+    }                                                                                              \
+                                                                                                   \
+    void hodu_cpu_rms_norm_##TYPE_SUFFIX(const void *input, const void *weight, void *output,      \
+                                         const size_t *metadata, float eps) {                      \
+        HODU_PROFILE_KERNEL(metadata[0] * 2 * sizeof(TYPE));                                       \
+        norm_run_##TYPE_SUFFIX(input, weight, NULL, output, metadata, eps, NORM_RMS);              \
+    }
+
+#define NORM_IDENTITY(x) (x)
+
+NORM_OPS(f8e4m3_t, f8e4m3, f32_t, f32, f8e4m3_to_float, float_to_f8e4m3, 0)
+NORM_OPS(f8e5m2_t, f8e5m2, f32_t, f32, f8e5m2_to_float, float_to_f8e5m2, 0)
+NORM_OPS(bf16_t, bf16, f32_t, f32, bf16_to_float, float_to_bf16, 0)
+NORM_OPS(f16_t, f16, f32_t, f32, f16_to_float, float_to_f16, 0)
+NORM_OPS(f32_t, f32, f32_t, f32, NORM_IDENTITY, NORM_IDENTITY, 1)
+NORM_OPS(f64_t, f64, f64_t, f64, NORM_IDENTITY, NORM_IDENTITY, 1)
@@ -0,0 +1,91 @@
+/**
+ * @file ops_norm.h
+ * @brief Fused row-wise normalization operations
+ *
+ * Provides single-kernel versions of the normalizations that would otherwise
+ * be assembled from reduce, binary and unary passes:
+ * - softmax / log_softmax: online max and sum in one read of each row
+ * - layer_norm: (x - mean) / sqrt(var + eps), optionally * weight + bias
+ * - rms_norm: x / sqrt(mean(x²) + eps), optionally * weight
+ *
+ * Every operation normalizes along one dimension. Rows are processed
+ * independently on the thread pool; exotic types compute in f32.
+ */
+
+#ifndef OPS_NORM_H
+#define OPS_NORM_H
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Metadata layout (same for all operations):
+// - metadata[0]: num_els (total number of elements)
+// - metadata[1]: num_dims (number of dimensions)
+// - metadata[2..2+num_dims]: shape
+// - metadata[2+num_dims..2+2*num_dims]: strides
+// - metadata[2+2*num_dims]: offset
+// - metadata[3+2*num_dims]: dim (dimension to normalize along)
+//
+// The output is contiguous with the input shape. weight and bias hold
+// shape[dim] contiguous values of the tensor type; NULL skips the term.
+
+// ============================================================================
+// SOFTMAX
+// ============================================================================
+
+void hodu_cpu_softmax_f8e4m3(const void *input, void *output, const size_t *metadata);
+void hodu_cpu_softmax_f8e5m2(const void *input, void *output, const size_t *metadata);
+void hodu_cpu_softmax_bf16(const void *input, void *output, const size_t *metadata);
+void hodu_cpu_softmax_f16(const void *input, void *output, const size_t *metadata);
+void hodu_cpu_softmax_f32(const void *input, void *output, const size_t *metadata);
+void hodu_cpu_softmax_f64(const void *input, void *output, const size_t *metadata);
+
+void hodu_cpu_log_softmax_f8e4m3(const void *input, void *output, const size_t *metadata);
+void hodu_cpu_log_softmax_f8e5m2(const void *input, void *output, const size_t *metadata);
+void hodu_cpu_log_softmax_bf16(const void *input, void *output, const size_t *metadata);
+void hodu_cpu_log_softmax_f16(const void *input, void *output, const size_t *metadata);
+void hodu_cpu_log_softmax_f32(const void *input, void *output, const size_t *metadata);
+void hodu_cpu_log_softmax_f64(const void *input, void *output, const size_t *metadata);
+
+// ============================================================================
+// LAYER NORM / RMS NORM
+// ============================================================================
+//
+// layer_norm: output = (x - mean) / sqrt(var + eps) * weight + bias
+// rms_norm:   output = x / sqrt(mean(x²) + eps) * weight
+// (population variance, statistics taken along dim)
+
+void hodu_cpu_layer_norm_f8e4m3(const void *input, const void *weight, const void *bias,
+                                void *output, const size_t *metadata, float eps);
+void hodu_cpu_layer_norm_f8e5m2(const void *input, const void *weight, const void *bias,
+                                void *output, const size_t *metadata, float eps);
+void hodu_cpu_layer_norm_bf16(const void *input, const void *weight, const void *bias,
+                              void *output, const size_t *metadata, float eps);
+void hodu_cpu_layer_norm_f16(const void *input, const void *weight, const void *bias,
+                             void *output, const size_t *metadata, float eps);
+void hodu_cpu_layer_norm_f32(const void *input, const void *weight, const void *bias,
+                             void *output, const size_t *metadata, float eps);
+void hodu_cpu_layer_norm_f64(const void *input, const void *weight, const void *bias,
+                             void *output, const size_t *metadata, float eps);
+
+void hodu_cpu_rms_norm_f8e4m3(const void *input, const void *weight, void *output,
+                              const size_t *metadata, float eps);
+void hodu_cpu_rms_norm_f8e5m2(const void *input, const void *weight, void *output,
+                              const size_t *metadata, float eps);
+void hodu_cpu_rms_norm_bf16(const void *input, const void *weight, void *output,
+                            const size_t *metadata, float eps);
+void hodu_cpu_rms_norm_f16(const void *input, const void *weight, void *output,
+                           const size_t *metadata, float eps);
+void hodu_cpu_rms_norm_f32(const void *input, const void *weight, void *output,
+                           const size_t *metadata, float eps);
+void hodu_cpu_rms_norm_f64(const void *input, const void *weight, void *output,
+                           const size_t *metadata, float eps);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -1,5 +1,14 @@
 #include "ops_padding.h"
+#include "profile.h"
+#include "thread_utils.h"
 #include "types.h"
+#include "workspace.h"
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+// Dims the planner handles (the other kernels' metadata limit)
+#define PAD_MAX_DIMS 16
 
 static inline size_t reflect_index(long idx, size_t size) {
     if (idx < 0) {
@@ -34,145 +43,311 @@ static inline size_t circular_index(long idx, size_t size) {
     return (size_t)result;
 }
 
+// ============================================================================
+// PADDING ENGINE
+// ============================================================================
+//
+// Trailing dims without padding are merged into a unit of `inner` elements,
+// so the output is [rows, out_shape[p]] units where p is the last padded dim.
+// Each output row is one source row (found through per-dim source-index maps
+// built once per call) copied with a single memcpy, plus the borders: constant
+// borders are filled with memset or a broadcast store loop, the other modes
+// copy the units their maps point at. The pool splits the output into equal
+// unit ranges, so a few long rows are shared between threads too.
+
+// Marks an out-of-bounds coordinate in a constant-mode map
+#define PAD_OUTSIDE SIZE_MAX
+
+typedef enum { PAD_CONSTANT, PAD_REFLECT, PAD_REPLICATE, PAD_CIRCULAR } pad_mode_t;
+
+typedef struct {
+    const char *in;
+    char *out;
+    size_t elem_size;
+    size_t inner;          // elements per unit (merged unpadded trailing dims)
+    size_t dim;            // p: the row dimension
+    const size_t *shape;   // output shape
+    const size_t *in_rows; // input element stride of each dim before p
+    const size_t *maps;    // concatenated source-index maps of dims 0..p
+    const size_t *map_at;  // start of each dim's map in maps
+    size_t in_len;         // input units per row
+    size_t before;         // units before the source row
+    size_t out_len;        // output units per row
+    const char *value;     // constant mode: the pad value
+    bool zero;             // constant mode: the pad value is all zero bytes
+    bool constant;
+} pad_ctx_t;
+
+/// Fill n elements with the pad value
+static void pad_fill(const pad_ctx_t *ctx, char *dst, size_t n) {
+    if (ctx->zero) {
+        memset(dst, 0, n * ctx->elem_size);
+        return;
+    }
+    switch (ctx->elem_size) {
+    case 1:
+        memset(dst, ctx->value[0], n);
+        break;
+    case 2: {
+        uint16_t v;
+        memcpy(&v, ctx->value, sizeof(v));
+        for (size_t i = 0; i < n; i++) {
+            ((uint16_t *)dst)[i] = v;
+        }
+        break;
+    }
+    case 4: {
+        uint32_t v;
+        memcpy(&v, ctx->value, sizeof(v));
+        for (size_t i = 0; i < n; i++) {
+            ((uint32_t *)dst)[i] = v;
+        }
+        break;
+    }
+    case 8: {
+        uint64_t v;
+        memcpy(&v, ctx->value, sizeof(v));
+        for (size_t i = 0; i < n; i++) {
+            ((uint64_t *)dst)[i] = v;
+        }
+        break;
+    }
+    default:
+        for (size_t i = 0; i < n; i++) {
+            memcpy(dst + i * ctx->elem_size, ctx->value, ctx->elem_size);
+        }
+        break;
+    }
+}
+
+/// Copy n units from a source row by index map (reflect/replicate/circular borders)
+static void pad_gather(char *dst, const char *src, const size_t *map, size_t n, size_t unit) {
+    switch (unit) {
+    case 1:
+        for (size_t i = 0; i < n; i++) {
+            dst[i] = src[map[i]];
+        }
+        break;
+    case 2:
+        for (size_t i = 0; i < n; i++) {
+            ((uint16_t *)dst)[i] = ((const uint16_t *)src)[map[i]];
+        }
+        break;
+    case 4:
+        for (size_t i = 0; i < n; i++) {
+            ((uint32_t *)dst)[i] = ((const uint32_t *)src)[map[i]];
+        }
+        break;
+    case 8:
+        for (size_t i = 0; i < n; i++) {
+            ((uint64_t *)dst)[i] = ((const uint64_t *)src)[map[i]];
+        }
+        break;
+    default:
+        for (size_t i = 0; i < n; i++) {
+            memcpy(dst + i * unit, src + map[i] * unit, unit);
+        }
+        break;
+    }
+}
+
+/// Units [u0, u1) of the output row at outer coordinates idx
+static void pad_row(const pad_ctx_t *ctx, const size_t *idx, char *dst, size_t u0, size_t u1) {
+    const size_t unit = ctx->inner * ctx->elem_size;
+
+    /* Source row: every outer coordinate through its dim's map */
+    size_t src_row = 0;
+    for (size_t d = 0; d < ctx->dim; d++) {
+        const size_t s = ctx->maps[ctx->map_at[d] + idx[d]];
+        if (s == PAD_OUTSIDE) {
+            pad_fill(ctx, dst, (u1 - u0) * ctx->inner);
+            return;
+        }
+        src_row += s * ctx->in_rows[d];
+    }
+    const char *src = ctx->in + src_row * ctx->elem_size;
+    const size_t *row_map = ctx->maps + ctx->map_at[ctx->dim];
+    const size_t mid = ctx->before;
+    const size_t right = ctx->before + ctx->in_len;
+
+    /* Left border, source row, right border: each clipped to [u0, u1) */
+    if (u0 < mid) {
+        const size_t n = MINIMUM(u1, mid) - u0;
+        if (ctx->constant) {
+            pad_fill(ctx, dst, n * ctx->inner);
+        } else {
+            pad_gather(dst, src, row_map + u0, n, unit);
+        }
+    }
+    const size_t m0 = MAXIMUM(u0, mid);
+    const size_t m1 = MINIMUM(u1, right);
+    if (m0 < m1) {
+        memcpy(dst + (m0 - u0) * unit, src + (m0 - mid) * unit, (m1 - m0) * unit);
+    }
+    if (u1 > right) {
+        const size_t r0 = MAXIMUM(u0, right);
+        if (ctx->constant) {
+            pad_fill(ctx, dst + (r0 - u0) * unit, (u1 - r0) * ctx->inner);
+        } else {
+            pad_gather(dst + (r0 - u0) * unit, src, row_map + r0, u1 - r0, unit);
+        }
+    }
+}
+
+/// Output units [start, end): whole rows, plus partial rows at the ends of the range
+static void pad_worker(size_t start, size_t end, void *arg) {
+    const pad_ctx_t *ctx = (const pad_ctx_t *)arg;
+    const size_t unit = ctx->inner * ctx->elem_size;
+
+    size_t idx[PAD_MAX_DIMS];
+    size_t rem = start / ctx->out_len;
+    for (size_t d = ctx->dim; d-- > 0;) {
+        idx[d] = rem % ctx->shape[d];
+        rem /= ctx->shape[d];
+    }
+
+    size_t u = start % ctx->out_len;
+    for (size_t pos = start; pos < end;) {
+        const size_t n = MINIMUM(ctx->out_len - u, end - pos);
+        pad_row(ctx, idx, ctx->out + pos * unit, u, u + n);
+        pos += n;
+        u = 0;
+        for (size_t d = ctx->dim; d-- > 0;) {
+            if (++idx[d] < ctx->shape[d]) {
+                break;
+            }
+            idx[d] = 0;
+        }
+    }
+}
+
+static void pad_run(const void *input, void *output, const void *pad_value,
+                    const size_t *metadata, size_t elem_size, pad_mode_t mode) {
+    const size_t num_els = metadata[0];
+    const size_t num_dims = metadata[1];
+    const size_t *input_shape = metadata + 2;
+    const size_t *output_shape = metadata + 2 + num_dims;
+    const size_t *pad_before = metadata + 2 + 2 * num_dims;
+    if (num_els == 0 || num_dims > PAD_MAX_DIMS) {
+        return;
+    }
+    if (num_dims == 0) {
+        memcpy(output, input, elem_size);
+        return;
+    }
+    for (size_t d = 0; d < num_dims; d++) {
+        if (input_shape[d] == 0 && mode != PAD_CONSTANT) {
+            /* Nothing to reflect, replicate or wrap */
+            memset(output, 0, num_els * elem_size);
+            return;
+        }
+    }
+
+    /* p: last padded dim (the innermost one if nothing is padded) */
+    size_t p = num_dims - 1;
+    size_t inner = 1;
+    while (p > 0 && input_shape[p] == output_shape[p]) {
+        inner *= output_shape[p];
+        p--;
+    }
+
+    size_t map_at[PAD_MAX_DIMS];
+    size_t in_rows[PAD_MAX_DIMS];
+    size_t map_len = 0;
+    size_t stride = inner * input_shape[p];
+    for (size_t d = p + 1; d-- > 0;) {
+        map_at[d] = map_len;
+        map_len += output_shape[d];
+        if (d < p) {
+            in_rows[d] = stride;
+            stride *= input_shape[d];
+        }
+    }
+    size_t *maps = (size_t *)workspace_acquire(map_len * sizeof(size_t));
+    if (!maps) {
+        return;
+    }
+    for (size_t d = 0; d <= p; d++) {
+        size_t *map = maps + map_at[d];
+        /* Outer maps hold input coordinates; the row dim's holds units of its source row */
+        for (size_t j = 0; j < output_shape[d]; j++) {
+            const long coord = (long)j - (long)pad_before[d];
+            switch (mode) {
+            case PAD_CONSTANT:
+                map[j] = (coord < 0 || (size_t)coord >= input_shape[d]) ? PAD_OUTSIDE
+                                                                         : (size_t)coord;
+                break;
+            case PAD_REFLECT:
+                map[j] = reflect_index(coord, input_shape[d]);
+                break;
+            case PAD_REPLICATE:
+                map[j] = replicate_index(coord, input_shape[d]);
+                break;
+            case PAD_CIRCULAR:
+                map[j] = circular_index(coord, input_shape[d]);
+                break;
+            }
+        }
+    }
+
+    bool zero = true;
+    if (mode == PAD_CONSTANT) {
+        for (size_t b = 0; b < elem_size; b++) {
+            zero = zero && ((const unsigned char *)pad_value)[b] == 0;
+        }
+    }
+    pad_ctx_t ctx = {
+        .in = (const char *)input,
+        .out = (char *)output,
+        .elem_size = elem_size,
+        .inner = inner,
+        .dim = p,
+        .shape = output_shape,
+        .in_rows = in_rows,
+        .maps = maps,
+        .map_at = map_at,
+        .in_len = input_shape[p],
+        .before = pad_before[p],
+        .out_len = output_shape[p],
+        .value = (const char *)pad_value,
+        .zero = zero,
+        .constant = mode == PAD_CONSTANT,
+    };
+    const size_t units = num_els / inner;
+    parallel_for(0, units, task_grain(HODU_CPU_COST_COPY, inner * elem_size), pad_worker, &ctx);
+    workspace_release(maps);
+}
+
 #define IMPL_PAD_CONSTANT_OP(TYPE, TYPE_SUFFIX)                                                    \
     void hodu_cpu_pad_constant_##TYPE_SUFFIX(const void *input, void *output,                      \
                                              const void *pad_value, const size_t *metadata) {      \
-        const size_t num_els = metadata[0];                                                        \
-        const size_t num_dims = metadata[1];                                                       \
-        const size_t *input_shape = metadata + 2;                                                  \
-        const size_t *output_shape = metadata + 2 + num_dims;                                      \
-        const size_t *pad_before = metadata + 2 + 2 * num_dims;                                    \
-                                                                                                   \
-        const TYPE *in = (const TYPE *)input;                                                      \
-        TYPE *out = (TYPE *)output;                                                                \
-        TYPE pv = *(const TYPE *)pad_value;                                                        \
-                                                                                                   \
-        for (size_t i = 0; i < num_els; i++) {                                                     \
-            size_t remaining = i;                                                                  \
-            bool in_bounds = true;                                                                 \
-            size_t input_idx = 0;                                                                  \
-                                                                                                   \
-            for (size_t d = num_dims; d-- > 0;) {                                                  \
-                size_t out_coord = remaining % output_shape[d];                                    \
-                remaining /= output_shape[d];                                                      \
-                                                                                                   \
-                long in_coord = (long)out_coord - (long)pad_before[d];                             \
-                if (in_coord < 0 || (size_t)in_coord >= input_shape[d]) {                          \
-                    in_bounds = false;                                                             \
-                    break;                                                                         \
-                }                                                                                  \
-                                                                                                   \
-                size_t in_stride = 1;                                                              \
-                for (size_t k = d + 1; k < num_dims; k++) {                                        \
-                    in_stride *= input_shape[k];                                                   \
-                }                                                                                  \
-                input_idx += (size_t)in_coord * in_stride;                                         \
-            }                                                                                      \
-                                                                                                   \
-            out[i] = in_bounds ? in[input_idx] : pv;                                               \
-        }                                                                                          \
+        HODU_PROFILE_KERNEL((hodu_cpu_profile_numel(metadata + 2, metadata[1]) +                   \
+                             metadata[0]) * sizeof(TYPE));                                         \
+        pad_run(input, output, pad_value, metadata, sizeof(TYPE), PAD_CONSTANT);                   \
     }
 
 #define IMPL_PAD_REFLECT_OP(TYPE, TYPE_SUFFIX)                                                     \
     void hodu_cpu_pad_reflect_##TYPE_SUFFIX(const void *input, void *output,                       \
                                             const size_t *metadata) {                              \
-        const size_t num_els = metadata[0];                                                        \
-        const size_t num_dims = metadata[1];                                                       \
-        const size_t *input_shape = metadata + 2;                                                  \
-        const size_t *output_shape = metadata + 2 + num_dims;                                      \
-        const size_t *pad_before = metadata + 2 + 2 * num_dims;                                    \
-                                                                                                   \
-        const TYPE *in = (const TYPE *)input;                                                      \
-        TYPE *out = (TYPE *)output;                                                                \
-                                                                                                   \
-        for (size_t i = 0; i < num_els; i++) {                                                     \
-            size_t remaining = i;                                                                  \
-            size_t input_idx = 0;                                                                  \
-                                                                                                   \
-            for (size_t d = num_dims; d-- > 0;) {                                                  \
-                size_t out_coord = remaining % output_shape[d];                                    \
-                remaining /= output_shape[d];                                                      \
-                                                                                                   \
-                long in_coord = (long)out_coord - (long)pad_before[d];                             \
-                size_t reflected = reflect_index(in_coord, input_shape[d]);                        \
-                                                                                                   \
-                size_t in_stride = 1;                                                              \
-                for (size_t k = d + 1; k < num_dims; k++) {                                        \
-                    in_stride *= input_shape[k];                                                   \
-                }                                                                                  \
-                input_idx += reflected * in_stride;                                                \
-            }                                                                                      \
-                                                                                                   \
-            out[i] = in[input_idx];                                                                \
-        }                                                                                          \
+        HODU_PROFILE_KERNEL((hodu_cpu_profile_numel(metadata + 2, metadata[1]) +                   \
+                             metadata[0]) * sizeof(TYPE));                                         \
+        pad_run(input, output, NULL, metadata, sizeof(TYPE), PAD_REFLECT);                         \
     }
 
 #define IMPL_PAD_REPLICATE_OP(TYPE, TYPE_SUFFIX)                                                   \
     void hodu_cpu_pad_replicate_##TYPE_SUFFIX(const void *input, void *output,                     \
                                               const size_t *metadata) {                            \
-        const size_t num_els = metadata[0];                                                        \
-        const size_t num_dims = metadata[1];                                                       \
-        const size_t *input_shape = metadata + 2;                                                  \
-        const size_t *output_shape = metadata + 2 + num_dims;                                      \
-        const size_t *pad_before = metadata + 2 + 2 * num_dims;                                    \
-                                                                                                   \
-        const TYPE *in = (const TYPE *)input;                                                      \
-        TYPE *out = (TYPE *)output;                                                                \
-                                                                                                   \
-        for (size_t i = 0; i < num_els; i++) {                                                     \
-            size_t remaining = i;                                                                  \
-            size_t input_idx = 0;                                                                  \
-                                                                                                   \
-            for (size_t d = num_dims; d-- > 0;) {                                                  \
-                size_t out_coord = remaining % output_shape[d];                                    \
-                remaining /= output_shape[d];                                                      \
-                                                                                                   \
-                long in_coord = (long)out_coord - (long)pad_before[d];                             \
-                size_t clamped = replicate_index(in_coord, input_shape[d]);                        \
-                                                                                                   \
-                size_t in_stride = 1;                                                              \
-                for (size_t k = d + 1; k < num_dims; k++) {                                        \
-                    in_stride *= input_shape[k];                                                   \
-                }                                                                                  \
-                input_idx += clamped * in_stride;                                                  \
-            }                                                                                      \
-                                                                                                   \
-            out[i] = in[input_idx];                                                                \
-        }                                                                                          \
+        HODU_PROFILE_KERNEL((hodu_cpu_profile_numel(metadata + 2, metadata[1]) +                   \
+                             metadata[0]) * sizeof(TYPE));                                         \
+        pad_run(input, output, NULL, metadata, sizeof(TYPE), PAD_REPLICATE);                       \
     }
 
 #define IMPL_PAD_CIRCULAR_OP(TYPE, TYPE_SUFFIX)                                                    \
     void hodu_cpu_pad_circular_##TYPE_SUFFIX(const void *input, void *output,                      \
                                              const size_t *metadata) {                             \
-        const size_t num_els = metadata[0];                                                        \
-        const size_t num_dims = metadata[1];                                                       \
-        const size_t *input_shape = metadata + 2;                                                  \
-        const size_t *output_shape = metadata + 2 + num_dims;                                      \
-        const size_t *pad_before = metadata + 2 + 2 * num_dims;                                    \
-                                                                                                   \
-        const TYPE *in = (const TYPE *)input;                                                      \
-        TYPE *out = (TYPE *)output;                                                                \
-                                                                                                   \
-        for (size_t i = 0; i < num_els; i++) {                                                     \
-            size_t remaining = i;                                                                  \
-            size_t input_idx = 0;                                                                  \
-                                                                                                   \
-            for (size_t d = num_dims; d-- > 0;) {                                                  \
-                size_t out_coord = remaining % output_shape[d];                                    \
-                remaining /= output_shape[d];                                                      \
-                                                                                                   \
-                long in_coord = (long)out_coord - (long)pad_before[d];                             \
-                size_t wrapped = circular_index(in_coord, input_shape[d]);                         \
-                                                                                                   \
-                size_t in_stride = 1;                                                              \
-                for (size_t k = d + 1; k < num_dims; k++) {                                        \
-                    in_stride *= input_shape[k];                                                   \
-                }                                                                                  \
-                input_idx += wrapped * in_stride;                                                  \
-            }                                                                                      \
-                                                                                                   \
-            out[i] = in[input_idx];                                                                \
-        }                                                                                          \
+        HODU_PROFILE_KERNEL((hodu_cpu_profile_numel(metadata + 2, metadata[1]) +                   \
+                             metadata[0]) * sizeof(TYPE));                                         \
+        pad_run(input, output, NULL, metadata, sizeof(TYPE), PAD_CIRCULAR);                        \
     }
 
 IMPL_PAD_CONSTANT_OP(uint8_t, bool)
@@ -1,7 +1,10 @@
 #include "ops_reduce.h"
 #include "math_utils.h"
+#include "profile.h"
 #include "simd_utils.h"
+#include "thread_utils.h"
 #include "types.h"
+#include "workspace.h"
 #include <float.h>
 #include <math.h>
 #include <stdbool.h>
@@ -28,320 +31,521 @@
 // - metadata[...+1]: reduce_size (total elements to reduce per output)
 //
 // Algorithm:
-// For each output element:
-// 1. Compute output multi-dimensional indices
-// 2. Map to input indices (accounting for keep_dim and reduced dimensions)
-// 3. Iterate over all reduced dimension combinations
-// 4. Accumulate values according to the reduction operation
+// 1. Build a reduction plan: drop size-1 dimensions, split the rest into kept dimensions
+//    (output order) and reduced dimensions (reduce_dims order), and merge neighbours of the
+//    same kind whose strides line up
+// 2. Classify the plan:
+//    - inner: the reduced elements of an output form one contiguous run
+//    - outer: the innermost kept dimension is contiguous, so REDUCE_LANE_BLOCK neighbouring
+//      outputs are accumulated together (vectorized across the output dimension)
+//    - mixed: anything else; contiguous runs of the innermost reduced dimension are reduced
+//      in one go and the remaining positions are walked with an incremental cursor
+// 3. Run outputs (inner/mixed) or lane blocks (outer) in parallel; when there are fewer of
+//    them than threads, split the reduced positions instead (split-K) and merge the chunk
+//    partials with a pairwise tree. In deterministic mode (hodu_cpu_set_deterministic) the
+//    split assumes DETERMINISTIC_THREADS threads whatever the pool size, so the blocking and
+//    the tree, and with them the rounding, are the same for any thread count
 //
 // keep_dim behavior:
 // - If keep_dim=true: output shape matches input but reduced dims have size 1
 // - If keep_dim=false: reduced dimensions are squeezed out of output
+// Both enumerate outputs in the order of the kept input dimensions, so the plan ignores it.
+
+/// Neighbouring outputs accumulated together on the outer path
+#define REDUCE_LANE_BLOCK 64
+
+/// Minimum input elements per task before a reduction is spread over the pool
+#define REDUCE_PARALLEL_WORK 32768
+
+#define REDUCE_ADD(a, b) ((a) + (b))
+#define REDUCE_GT(a, b) ((a) > (b))
+#define REDUCE_LT(a, b) ((a) < (b))
+
+/// Reduction plan built from the generic reduction metadata
+typedef struct {
+    size_t offset;           // Starting offset in input
+    size_t num_outputs;      // Number of output elements
+    size_t reduce_size;      // Reduced positions per output
+    size_t num_kept;         // Kept dims, outermost first
+    size_t kept_shape[16];   // Kept dim sizes (merged)
+    size_t kept_strides[16]; // Kept dim strides (merged)
+    size_t num_red;          // Reduced dims in reduce_dims order, last varies fastest
+    size_t red_shape[16];    // Reduced dim sizes (merged)
+    size_t red_strides[16];  // Reduced dim strides (merged)
+    size_t arg_div;          // Positions per step along reduce_dims[0] (argmax/argmin)
+    bool outer;              // Innermost kept dim is contiguous: vectorize across outputs
+} reduce_plan_t;
+
+#ifdef HODU_PROFILE_ACTIVE
+/// Input and output bytes of a reduction call
+static inline uint64_t reduce_profile_bytes(const size_t *metadata, size_t in_size,
+                                            size_t out_size) {
+    const size_t num_dims = metadata[0];
+    const size_t *output_shape = metadata + 3 + 2 * num_dims;
+    return in_size * hodu_cpu_profile_numel(metadata + 1, num_dims) +
+           out_size * hodu_cpu_profile_numel(output_shape, metadata[2 + 2 * num_dims]);
+}
+#endif
 
-/// Macro to implement a generic reduction operation
-///
-/// @param IN_TYPE Input C type
-/// @param OUT_TYPE Output C type (same as input for most ops)
-/// @param TYPE_SUFFIX Suffix for function naming
-/// @param INIT_VAL Initial accumulator value
-/// @param ACCUMULATE Expression to accumulate values (e.g., acc += val)
-#define REDUCE_OP(IN_TYPE, OUT_TYPE, TYPE_SUFFIX, INIT_VAL, ACCUMULATE)                            \
-    void hodu_cpu_##TYPE_SUFFIX(const void *input_ptr, void *output_ptr, const size_t *metadata) { \
-        const IN_TYPE *input = (const IN_TYPE *)input_ptr;                                         \
-        OUT_TYPE *output = (OUT_TYPE *)output_ptr;                                                 \
-                                                                                                   \
-        const size_t num_dims = metadata[0];                                                       \
-        const size_t *dims = metadata + 1;                                                         \
-        const size_t *strides = metadata + 1 + num_dims;                                           \
-        const size_t offset = metadata[1 + 2 * num_dims];                                          \
-        const size_t output_shape_len = metadata[2 + 2 * num_dims];                                \
-        const size_t *output_shape = metadata + 3 + 2 * num_dims;                                  \
-        const size_t num_reduce_dims = metadata[3 + 2 * num_dims + output_shape_len];              \
-        const size_t *reduce_dims = metadata + 4 + 2 * num_dims + output_shape_len;                \
-        const size_t keep_dim_val =                                                                \
-            metadata[4 + 2 * num_dims + output_shape_len + num_reduce_dims];                       \
-        const bool keep_dim = (keep_dim_val != 0);                                                 \
-        const size_t reduce_size =                                                                 \
-            metadata[5 + 2 * num_dims + output_shape_len + num_reduce_dims];                       \
-        size_t num_els = 1;                                                                        \
-        for (size_t i = 0; i < output_shape_len; i++) {                                            \
-            num_els *= output_shape[i];                                                            \
-        }                                                                                          \
-                                                                                                   \
-        for (size_t output_idx = 0; output_idx < num_els; output_idx++) {                          \
-            OUT_TYPE acc = INIT_VAL;                                                               \
-                                                                                                   \
-            size_t output_indices[16];                                                             \
-            size_t temp = output_idx;                                                              \
-            for (int d = (int)output_shape_len - 1; d >= 0; d--) {                                 \
-                output_indices[d] = temp % output_shape[d];                                        \
-                temp /= output_shape[d];                                                           \
-            }                                                                                      \
-                                                                                                   \
-            size_t input_indices[16];                                                              \
-            if (keep_dim) {                                                                        \
-                for (size_t i = 0; i < num_dims; i++) {                                            \
-                    input_indices[i] = output_indices[i];                                          \
-                }                                                                                  \
-            } else {                                                                               \
-                size_t out_idx = 0;                                                                \
-                for (size_t in_dim = 0; in_dim < num_dims; in_dim++) {                             \
-                    bool is_reduced = false;                                                       \
-                    for (size_t r = 0; r < num_reduce_dims; r++) {                                 \
-                        if (reduce_dims[r] == in_dim) {                                            \
-                            is_reduced = true;                                                     \
-                            break;                                                                 \
-                        }                                                                          \
-                    }                                                                              \
-                    if (is_reduced) {                                                              \
-                        input_indices[in_dim] = 0;                                                 \
-                    } else {                                                                       \
-                        input_indices[in_dim] =                                                    \
-                            (out_idx < output_shape_len) ? output_indices[out_idx] : 0;            \
-                        out_idx++;                                                                 \
-                    }                                                                              \
-                }                                                                                  \
-            }                                                                                      \
-                                                                                                   \
-            for (size_t reduced_idx = 0; reduced_idx < reduce_size; reduced_idx++) {               \
-                size_t temp_reduced = reduced_idx;                                                 \
-                for (int i = (int)num_reduce_dims - 1; i >= 0; i--) {                              \
-                    size_t dim = reduce_dims[i];                                                   \
-                    input_indices[dim] = temp_reduced % dims[dim];                                 \
-                    temp_reduced /= dims[dim];                                                     \
-                }                                                                                  \
-                                                                                                   \
-                size_t flat_index = offset;                                                        \
-                for (size_t i = 0; i < num_dims; i++) {                                            \
-                    flat_index += input_indices[i] * strides[i];                                   \
-                }                                                                                  \
-                                                                                                   \
-                IN_TYPE val = input[flat_index];                                                   \
-                ACCUMULATE;                                                                        \
-            }                                                                                      \
-                                                                                                   \
-            output[output_idx] = acc;                                                              \
-        }                                                                                          \
+/// Append a dimension to a plan dimension list, merging it into the previous one if possible
+static void reduce_plan_push(size_t *count, size_t *shape, size_t *strides, size_t size,
+                             size_t stride) {
+    if (size == 1)
+        return;
+    if (*count > 0 && strides[*count - 1] == size * stride) {
+        shape[*count - 1] *= size;
+        strides[*count - 1] = stride;
+        return;
     }
+    shape[*count] = size;
+    strides[*count] = stride;
+    (*count)++;
+}
 
-REDUCE_OP(f8e4m3_t, f8e4m3_t, sum_f8e4m3, F8E4M3_ZERO, acc = f8e4m3_add(acc, val))
-REDUCE_OP(f8e5m2_t, f8e5m2_t, sum_f8e5m2, F8E5M2_ZERO, acc = f8e5m2_add(acc, val))
-REDUCE_OP(bf16_t, bf16_t, sum_bf16, BF16_ZERO, acc = bf16_add(acc, val))
-REDUCE_OP(f16_t, f16_t, sum_f16, F16_ZERO, acc = f16_add(acc, val))
-
-// SIMD-optimized sum_f32
-void hodu_cpu_sum_f32(const void *input_ptr, void *output_ptr, const size_t *metadata) {
-    const f32_t *input = (const f32_t *)input_ptr;
-    f32_t *output = (f32_t *)output_ptr;
-
+/// Build a reduction plan from the generic reduction metadata
+static void reduce_plan_init(reduce_plan_t *plan, const size_t *metadata) {
     const size_t num_dims = metadata[0];
     const size_t *dims = metadata + 1;
     const size_t *strides = metadata + 1 + num_dims;
-    const size_t offset = metadata[1 + 2 * num_dims];
     const size_t output_shape_len = metadata[2 + 2 * num_dims];
-    const size_t *output_shape = metadata + 3 + 2 * num_dims;
     const size_t num_reduce_dims = metadata[3 + 2 * num_dims + output_shape_len];
     const size_t *reduce_dims = metadata + 4 + 2 * num_dims + output_shape_len;
-    const size_t keep_dim_val = metadata[4 + 2 * num_dims + output_shape_len + num_reduce_dims];
-    const bool keep_dim = (keep_dim_val != 0);
-    const size_t reduce_size = metadata[5 + 2 * num_dims + output_shape_len + num_reduce_dims];
 
-    size_t num_els = 1;
-    for (size_t i = 0; i < output_shape_len; i++) {
-        num_els *= output_shape[i];
+    bool reduced[16] = {false};
+    plan->offset = metadata[1 + 2 * num_dims];
+    plan->reduce_size = 1;
+    plan->arg_div = 1;
+    plan->num_red = 0;
+    for (size_t r = 0; r < num_reduce_dims; r++) {
+        const size_t d = reduce_dims[r];
+        reduced[d] = true;
+        plan->reduce_size *= dims[d];
+        if (r > 0)
+            plan->arg_div *= dims[d];
+        reduce_plan_push(&plan->num_red, plan->red_shape, plan->red_strides, dims[d], strides[d]);
+    }
+    if (plan->num_red == 0) {
+        plan->red_shape[0] = 1;
+        plan->red_strides[0] = 1;
+        plan->num_red = 1;
+    }
+
+    plan->num_outputs = 1;
+    plan->num_kept = 0;
+    for (size_t d = 0; d < num_dims; d++) {
+        if (reduced[d])
+            continue;
+        plan->num_outputs *= dims[d];
+        reduce_plan_push(&plan->num_kept, plan->kept_shape, plan->kept_strides, dims[d],
+                         strides[d]);
     }
 
-    for (size_t output_idx = 0; output_idx < num_els; output_idx++) {
-        f32_t acc = 0.0f;
-
-        size_t output_indices[16];
-        size_t temp = output_idx;
-        for (int d = (int)output_shape_len - 1; d >= 0; d--) {
-            output_indices[d] = temp % output_shape[d];
-            temp /= output_shape[d];
-        }
-
-        size_t input_indices[16];
-        if (keep_dim) {
-            for (size_t i = 0; i < num_dims; i++) {
-                input_indices[i] = output_indices[i];
-            }
-        } else {
-            size_t out_idx = 0;
-            for (size_t in_dim = 0; in_dim < num_dims; in_dim++) {
-                bool is_reduced = false;
-                for (size_t r = 0; r < num_reduce_dims; r++) {
-                    if (reduce_dims[r] == in_dim) {
-                        is_reduced = true;
-                        break;
-                    }
-                }
-                if (is_reduced) {
-                    input_indices[in_dim] = 0;
-                } else {
-                    input_indices[in_dim] =
-                        (out_idx < output_shape_len) ? output_indices[out_idx] : 0;
-                    out_idx++;
-                }
-            }
-        }
+    const bool inner = plan->num_red == 1 && plan->red_strides[0] == 1;
+    plan->outer = !inner && plan->num_kept > 0 && plan->kept_strides[plan->num_kept - 1] == 1;
+}
 
-#if SIMD_F32_WIDTH > 1
-        // SIMD path: Check if we're reducing contiguous data (last dimension with stride 1)
-        bool use_simd = (num_reduce_dims == 1) && (reduce_dims[0] == num_dims - 1) &&
-                        (strides[num_dims - 1] == 1) && (reduce_size >= SIMD_F32_WIDTH);
-
-        if (use_simd) {
-            size_t flat_base = offset;
-            for (size_t i = 0; i < num_dims - 1; i++) {
-                flat_base += input_indices[i] * strides[i];
-            }
-
-            simd_f32_t vacc = simd_f32_set1(0.0f);
-            const size_t simd_end = (reduce_size / SIMD_F32_WIDTH) * SIMD_F32_WIDTH;
-
-            for (size_t i = 0; i < simd_end; i += SIMD_F32_WIDTH) {
-                simd_f32_t v = simd_f32_load(&input[flat_base + i]);
-                vacc = simd_f32_add(vacc, v);
-            }
-            acc = simd_f32_reduce_add(vacc);
-
-            // Handle remainder
-            for (size_t i = simd_end; i < reduce_size; i++) {
-                acc += input[flat_base + i];
-            }
-        } else
-#endif
-        {
-            // Fallback path
-            for (size_t reduced_idx = 0; reduced_idx < reduce_size; reduced_idx++) {
-                size_t temp_reduced = reduced_idx;
-                for (int i = (int)num_reduce_dims - 1; i >= 0; i--) {
-                    size_t dim = reduce_dims[i];
-                    input_indices[dim] = temp_reduced % dims[dim];
-                    temp_reduced /= dims[dim];
-                }
-
-                size_t flat_index = offset;
-                for (size_t i = 0; i < num_dims; i++) {
-                    flat_index += input_indices[i] * strides[i];
-                }
-
-                f32_t val = input[flat_index];
-                acc += val;
-            }
-        }
-
-        output[output_idx] = acc;
+/// Number of work units of a plan: outputs, or lane blocks on the outer path
+static size_t reduce_plan_units(const reduce_plan_t *plan) {
+    if (!plan->outer)
+        return plan->num_outputs;
+    const size_t inner = plan->kept_shape[plan->num_kept - 1];
+    const size_t blocks = (inner + REDUCE_LANE_BLOCK - 1) / REDUCE_LANE_BLOCK;
+    return plan->num_outputs / inner * blocks;
+}
+
+/// Number of split-K chunks to use (1 when parallelizing over units is enough)
+///
+/// Deterministic mode sizes the split by DETERMINISTIC_THREADS, so the chunk boundaries and
+/// the merge tree only depend on the shape.
+static size_t reduce_plan_chunks(const reduce_plan_t *plan, size_t units) {
+    const size_t threads = get_split_threads();
+    if (threads <= 1 || units >= threads)
+        return 1;
+    size_t chunks = plan->num_outputs * plan->reduce_size / REDUCE_PARALLEL_WORK;
+    chunks = MIN(chunks, threads);
+    chunks = MIN(chunks, plan->reduce_size);
+    return chunks > 1 ? chunks : 1;
+}
+
+/// Input offset of kept index `index`, decomposed over the first `num_kept` kept dims
+static inline size_t reduce_plan_base(const reduce_plan_t *plan, size_t index, size_t num_kept) {
+    size_t base = plan->offset;
+    for (size_t d = num_kept; d-- > 0;) {
+        base += (index % plan->kept_shape[d]) * plan->kept_strides[d];
+        index /= plan->kept_shape[d];
     }
+    return base;
 }
 
-// SIMD-optimized sum_f64
-void hodu_cpu_sum_f64(const void *input_ptr, void *output_ptr, const size_t *metadata) {
-    const f64_t *input = (const f64_t *)input_ptr;
-    f64_t *output = (f64_t *)output_ptr;
+/// Incremental position over the reduced dims of a plan
+typedef struct {
+    size_t index[16]; // Coordinate along each reduced dim
+    size_t offset;    // Input offset relative to the output's first reduced element
+} reduce_cursor_t;
+
+static inline void reduce_cursor_seek(reduce_cursor_t *cur, const reduce_plan_t *plan,
+                                      size_t pos) {
+    cur->offset = 0;
+    for (size_t d = plan->num_red; d-- > 0;) {
+        cur->index[d] = pos % plan->red_shape[d];
+        cur->offset += cur->index[d] * plan->red_strides[d];
+        pos /= plan->red_shape[d];
+    }
+}
 
-    const size_t num_dims = metadata[0];
-    const size_t *dims = metadata + 1;
-    const size_t *strides = metadata + 1 + num_dims;
-    const size_t offset = metadata[1 + 2 * num_dims];
-    const size_t output_shape_len = metadata[2 + 2 * num_dims];
-    const size_t *output_shape = metadata + 3 + 2 * num_dims;
-    const size_t num_reduce_dims = metadata[3 + 2 * num_dims + output_shape_len];
-    const size_t *reduce_dims = metadata + 4 + 2 * num_dims + output_shape_len;
-    const size_t keep_dim_val = metadata[4 + 2 * num_dims + output_shape_len + num_reduce_dims];
-    const bool keep_dim = (keep_dim_val != 0);
-    const size_t reduce_size = metadata[5 + 2 * num_dims + output_shape_len + num_reduce_dims];
+/// Move the cursor `steps` positions forward, at most up to the end of the innermost dim
+static inline void reduce_cursor_advance(reduce_cursor_t *cur, const reduce_plan_t *plan,
+                                         size_t steps) {
+    size_t d = plan->num_red - 1;
+    cur->index[d] += steps;
+    cur->offset += steps * plan->red_strides[d];
+    while (d > 0 && cur->index[d] == plan->red_shape[d]) {
+        cur->offset -= plan->red_shape[d] * plan->red_strides[d];
+        cur->index[d] = 0;
+        d--;
+        cur->index[d]++;
+        cur->offset += plan->red_strides[d];
+    }
+}
+
+/// Macro to implement the scalar inner-run hook of a reduction
+///
+/// NAME##_row folds a contiguous run of n elements (reduced positions pos, pos + 1, ...) into
+/// one accumulator.
+///
+/// @param NAME Reduction name (e.g. sum_i32)
+/// @param IN_TYPE Input C type
+/// @param ACC_TYPE Accumulator C type
+/// @param STEP Statement folding `val` at reduced position `pos` into `acc`
+#define REDUCE_SCALAR_ROW_HOOK(NAME, IN_TYPE, ACC_TYPE, STEP)                                      \
+    static inline void reduce_##NAME##_row(ACC_TYPE *acc_ptr, const IN_TYPE *input, size_t n,      \
+                                           size_t pos, const reduce_plan_t *plan) {                \
+        ACC_TYPE acc = *acc_ptr;                                                                   \
+        for (size_t i = 0; i < n; i++, pos++) {                                                    \
+            const IN_TYPE val = input[i];                                                          \
+            STEP;                                                                                  \
+        }                                                                                          \
+        *acc_ptr = acc;                                                                            \
+        (void)plan;                                                                                \
+    }
 
-    size_t num_els = 1;
-    for (size_t i = 0; i < output_shape_len; i++) {
-        num_els *= output_shape[i];
+/// Macro to implement the scalar lane hook of a reduction
+///
+/// NAME##_lanes folds element i of a contiguous run into accumulator i (n neighbouring
+/// outputs at reduced position pos).
+///
+/// @param NAME Reduction name (e.g. sum_i32)
+/// @param IN_TYPE Input C type
+/// @param ACC_TYPE Accumulator C type
+/// @param STEP Statement folding `val` at reduced position `pos` into `acc`
+#define REDUCE_SCALAR_LANES_HOOK(NAME, IN_TYPE, ACC_TYPE, STEP)                                    \
+    static inline void reduce_##NAME##_lanes(ACC_TYPE *acc_ptr, const IN_TYPE *input, size_t n,    \
+                                             size_t pos, const reduce_plan_t *plan) {              \
+        for (size_t i = 0; i < n; i++) {                                                           \
+            ACC_TYPE acc = acc_ptr[i];                                                             \
+            const IN_TYPE val = input[i];                                                          \
+            STEP;                                                                                  \
+            acc_ptr[i] = acc;                                                                      \
+        }                                                                                          \
+        (void)pos;                                                                                 \
+        (void)plan;                                                                                \
     }
 
-    for (size_t output_idx = 0; output_idx < num_els; output_idx++) {
-        f64_t acc = 0.0;
-
-        size_t output_indices[16];
-        size_t temp = output_idx;
-        for (int d = (int)output_shape_len - 1; d >= 0; d--) {
-            output_indices[d] = temp % output_shape[d];
-            temp /= output_shape[d];
-        }
-
-        size_t input_indices[16];
-        if (keep_dim) {
-            for (size_t i = 0; i < num_dims; i++) {
-                input_indices[i] = output_indices[i];
-            }
-        } else {
-            size_t out_idx = 0;
-            for (size_t in_dim = 0; in_dim < num_dims; in_dim++) {
-                bool is_reduced = false;
-                for (size_t r = 0; r < num_reduce_dims; r++) {
-                    if (reduce_dims[r] == in_dim) {
-                        is_reduced = true;
-                        break;
-                    }
-                }
-                if (is_reduced) {
-                    input_indices[in_dim] = 0;
-                } else {
-                    input_indices[in_dim] =
-                        (out_idx < output_shape_len) ? output_indices[out_idx] : 0;
-                    out_idx++;
-                }
-            }
-        }
+/// Macro to implement the scalar inner-run and lane hooks of a reduction
+///
+/// Both are written so the compiler can vectorize them for plain arithmetic STEPs.
+///
+/// @param NAME Reduction name (e.g. sum_i32)
+/// @param IN_TYPE Input C type
+/// @param ACC_TYPE Accumulator C type
+/// @param STEP Statement folding `val` at reduced position `pos` into `acc`
+#define REDUCE_SCALAR_HOOKS(NAME, IN_TYPE, ACC_TYPE, STEP)                                         \
+    REDUCE_SCALAR_ROW_HOOK(NAME, IN_TYPE, ACC_TYPE, STEP)                                          \
+    REDUCE_SCALAR_LANES_HOOK(NAME, IN_TYPE, ACC_TYPE, STEP)
 
+/// Macro to implement SIMD inner-run and lane hooks for an f32/f64 sum/max/min/norm
+///
+/// Rows (from 4 elements) and lane blocks end in one masked partial vector
+/// filled with INIT, so short rows and tails stay in vector registers.
+///
+/// @param NAME Reduction name (e.g. sum_f32)
+/// @param TYPE C float type
+/// @param SFX simd_utils suffix (f32 or f64)
+/// @param WIDTH SIMD width of TYPE
+/// @param INIT Identity of the reduction (0, -INFINITY, INFINITY)
+/// @param VOP simd_utils combine operation (add, max, min)
+/// @param HRED simd_utils horizontal reduction (reduce_add, reduce_max, reduce_min)
+/// @param COMBINE Scalar combine macro (REDUCE_ADD, MAX, MIN)
+/// @param SQUARE 1 to accumulate squares (L2 norm), 0 otherwise
+#define REDUCE_SIMD_HOOKS(NAME, TYPE, SFX, WIDTH, INIT, VOP, HRED, COMBINE, SQUARE)                \
+    static inline simd_##SFX##_t reduce_##NAME##_vstep(simd_##SFX##_t acc, simd_##SFX##_t x) {     \
+        return SQUARE ? simd_##SFX##_fmadd(x, x, acc) : simd_##SFX##_##VOP(acc, x);                \
+    }                                                                                              \
+                                                                                                   \
+    static inline void reduce_##NAME##_row(TYPE *acc, const TYPE *input, size_t n, size_t pos,     \
+                                           const reduce_plan_t *plan) {                            \
+        if (n < 4) { /* a horizontal reduction costs more than a few scalar steps */               \
+            for (size_t i = 0; i < n; i++) {                                                       \
+                *acc = COMBINE(*acc, SQUARE ? input[i] * input[i] : input[i]);                     \
+            }                                                                                      \
+            return;                                                                                \
+        }                                                                                          \
+        const simd_##SFX##_t ident = simd_##SFX##_set1((TYPE)(INIT));                              \
+        HODU_PROFILE_PATH(HODU_CPU_PATH_SIMD);                                                     \
+        simd_##SFX##_t v0 = ident;                                                                 \
+        simd_##SFX##_t v1 = ident;                                                                 \
+        size_t i = 0;                                                                              \
+        for (; i + 2 * WIDTH <= n; i += 2 * WIDTH) {                                               \
+            v0 = reduce_##NAME##_vstep(v0, simd_##SFX##_load(input + i));                          \
+            v1 = reduce_##NAME##_vstep(v1, simd_##SFX##_load(input + i + WIDTH));                  \
+        }                                                                                          \
+        if (i + WIDTH <= n) {                                                                      \
+            v0 = reduce_##NAME##_vstep(v0, simd_##SFX##_load(input + i));                          \
+            i += WIDTH;                                                                            \
+        }                                                                                          \
+        if (i < n) {                                                                               \
+            v1 = reduce_##NAME##_vstep(v1, simd_##SFX##_load_partial(input + i, n - i, ident));    \
+        }                                                                                          \
+        *acc = COMBINE(*acc, simd_##SFX##_##HRED(simd_##SFX##_##VOP(v0, v1)));                     \
+        (void)pos;                                                                                 \
+        (void)plan;                                                                                \
+    }                                                                                              \
+                                                                                                   \
+    static inline void reduce_##NAME##_lanes(TYPE *acc, const TYPE *input, size_t n, size_t pos,   \
+                                             const reduce_plan_t *plan) {                          \
+        size_t i = 0;                                                                              \
+        for (; i + WIDTH <= n; i += WIDTH) {                                                       \
+            simd_##SFX##_t v = simd_##SFX##_load(acc + i);                                         \
+            simd_##SFX##_store(acc + i, reduce_##NAME##_vstep(v, simd_##SFX##_load(input + i)));   \
+        }                                                                                          \
+        if (i < n) {                                                                               \
+            const simd_##SFX##_t ident = simd_##SFX##_set1((TYPE)(INIT));                          \
+        HODU_PROFILE_PATH(HODU_CPU_PATH_SIMD);                                                     \
+            simd_##SFX##_t v = simd_##SFX##_load_partial(acc + i, n - i, ident);                   \
+            simd_##SFX##_t x = simd_##SFX##_load_partial(input + i, n - i, ident);                 \
+            simd_##SFX##_store_partial(acc + i, reduce_##NAME##_vstep(v, x), n - i);               \
+        }                                                                                          \
+        (void)pos;                                                                                 \
+        (void)plan;                                                                                \
+    }
+
+// Hooks for f32/f64 sum/max/min/norm: SIMD where available, scalar otherwise
+#if SIMD_F32_WIDTH > 1
+#define REDUCE_F32_HOOKS(NAME, INIT, VOP, HRED, COMBINE, SQUARE)                                   \
+    REDUCE_SIMD_HOOKS(NAME, f32_t, f32, SIMD_F32_WIDTH, INIT, VOP, HRED, COMBINE, SQUARE)
+#else
+#define REDUCE_F32_HOOKS(NAME, INIT, VOP, HRED, COMBINE, SQUARE)                                   \
+    REDUCE_SCALAR_HOOKS(NAME, f32_t, f32_t, acc = COMBINE(acc, (SQUARE) ? val * val : val))
+#endif
 #if SIMD_F64_WIDTH > 1
-        // SIMD path: Check if we're reducing contiguous data (last dimension with stride 1)
-        bool use_simd = (num_reduce_dims == 1) && (reduce_dims[0] == num_dims - 1) &&
-                        (strides[num_dims - 1] == 1) && (reduce_size >= SIMD_F64_WIDTH);
-
-        if (use_simd) {
-            size_t flat_base = offset;
-            for (size_t i = 0; i < num_dims - 1; i++) {
-                flat_base += input_indices[i] * strides[i];
-            }
-
-            simd_f64_t vacc = simd_f64_set1(0.0);
-            const size_t simd_end = (reduce_size / SIMD_F64_WIDTH) * SIMD_F64_WIDTH;
-
-            for (size_t i = 0; i < simd_end; i += SIMD_F64_WIDTH) {
-                simd_f64_t v = simd_f64_load(&input[flat_base + i]);
-                vacc = simd_f64_add(vacc, v);
-            }
-            acc = simd_f64_reduce_add(vacc);
-
-            // Handle remainder
-            for (size_t i = simd_end; i < reduce_size; i++) {
-                acc += input[flat_base + i];
-            }
-        } else
+#define REDUCE_F64_HOOKS(NAME, INIT, VOP, HRED, COMBINE, SQUARE)                                   \
+    REDUCE_SIMD_HOOKS(NAME, f64_t, f64, SIMD_F64_WIDTH, INIT, VOP, HRED, COMBINE, SQUARE)
+#else
+#define REDUCE_F64_HOOKS(NAME, INIT, VOP, HRED, COMBINE, SQUARE)                                   \
+    REDUCE_SCALAR_HOOKS(NAME, f64_t, f64_t, acc = COMBINE(acc, (SQUARE) ? val * val : val))
 #endif
-        {
-            // Fallback path
-            for (size_t reduced_idx = 0; reduced_idx < reduce_size; reduced_idx++) {
-                size_t temp_reduced = reduced_idx;
-                for (int i = (int)num_reduce_dims - 1; i >= 0; i--) {
-                    size_t dim = reduce_dims[i];
-                    input_indices[dim] = temp_reduced % dims[dim];
-                    temp_reduced /= dims[dim];
-                }
-
-                size_t flat_index = offset;
-                for (size_t i = 0; i < num_dims; i++) {
-                    flat_index += input_indices[i] * strides[i];
-                }
-
-                f64_t val = input[flat_index];
-                acc += val;
-            }
-        }
-
-        output[output_idx] = acc;
+
+/// Macro to implement a reduction on top of the reduction plan
+///
+/// The accumulator protocol works on named variables: STEP folds `val` (the element at reduced
+/// position `pos`; `plan` is in scope) into `acc`, MERGE folds `other` (a partial over later
+/// positions) into `acc`, and FINAL turns `acc` into the output value (`plan` is in scope). The
+/// reduce_##NAME##_row and reduce_##NAME##_lanes hooks must be defined first (REDUCE_SCALAR_HOOKS
+/// or custom ones).
+///
+/// @param NAME Reduction name; defines hodu_cpu_##NAME
+/// @param IN_TYPE Input C type
+/// @param OUT_TYPE Output C type
+/// @param ACC_TYPE Accumulator C type
+/// @param INIT Initial accumulator value
+/// @param STEP Statement folding `val` into `acc`
+/// @param MERGE Statement folding `other` into `acc`
+/// @param FINAL Expression producing the output value from `acc`
+#define REDUCE_ENGINE(NAME, IN_TYPE, OUT_TYPE, ACC_TYPE, INIT, STEP, MERGE, FINAL)                 \
+    typedef struct {                                                                               \
+        const IN_TYPE *input;                                                                      \
+        OUT_TYPE *output;                                                                          \
+        ACC_TYPE *partials; /* Split-K: [chunks, num_outputs] */                                   \
+        size_t chunks;                                                                             \
+        reduce_plan_t plan;                                                                        \
+    } reduce_##NAME##_args_t;                                                                      \
+                                                                                                   \
+    /* Positions [p0, p1) of one output whose first reduced element is at input */                 \
+    static void reduce_##NAME##_span(ACC_TYPE *acc_ptr, const IN_TYPE *input, size_t p0,           \
+                                     size_t p1, const reduce_plan_t *plan) {                       \
+        const size_t last = plan->num_red - 1;                                                     \
+        const size_t stride = plan->red_strides[last];                                             \
+        reduce_cursor_t cur;                                                                       \
+        reduce_cursor_seek(&cur, plan, p0);                                                        \
+        for (size_t p = p0; p < p1;) {                                                             \
+            const size_t run = MIN(plan->red_shape[last] - cur.index[last], p1 - p);               \
+            const IN_TYPE *src = input + cur.offset;                                               \
+            if (stride == 1) {                                                                     \
+                reduce_##NAME##_row(acc_ptr, src, run, p, plan);                                   \
+            } else {                                                                               \
+                ACC_TYPE acc = *acc_ptr;                                                           \
+                for (size_t i = 0; i < run; i++) {                                                 \
+                    const size_t pos = p + i;                                                      \
+                    const IN_TYPE val = src[i * stride];                                           \
+                    STEP;                                                                          \
+                    (void)pos;                                                                     \
+                }                                                                                  \
+                *acc_ptr = acc;                                                                    \
+            }                                                                                      \
+            p += run;                                                                              \
+            if (p < p1)                                                                            \
+                reduce_cursor_advance(&cur, plan, run);                                            \
+        }                                                                                          \
+    }                                                                                              \
+                                                                                                   \
+    /* Positions [p0, p1) of n neighbouring outputs whose first elements are at input */           \
+    static void reduce_##NAME##_block(ACC_TYPE *acc, const IN_TYPE *input, size_t n, size_t p0,    \
+                                      size_t p1, const reduce_plan_t *plan) {                      \
+        reduce_cursor_t cur;                                                                       \
+        reduce_cursor_seek(&cur, plan, p0);                                                        \
+        for (size_t p = p0; p < p1; p++) {                                                         \
+            reduce_##NAME##_lanes(acc, input + cur.offset, n, p, plan);                            \
+            if (p + 1 < p1)                                                                        \
+                reduce_cursor_advance(&cur, plan, 1);                                              \
+        }                                                                                          \
+    }                                                                                              \
+                                                                                                   \
+    /* Accumulate unit u over positions [p0, p1); returns its output count and first index */      \
+    static size_t reduce_##NAME##_unit(const reduce_##NAME##_args_t *a, size_t u, size_t p0,       \
+                                       size_t p1, ACC_TYPE *acc, size_t *first) {                  \
+        const reduce_plan_t *plan = &a->plan;                                                      \
+        if (!plan->outer) {                                                                        \
+            acc[0] = INIT;                                                                         \
+            *first = u;                                                                            \
+            reduce_##NAME##_span(acc, a->input + reduce_plan_base(plan, u, plan->num_kept), p0,    \
+                                 p1, plan);                                                        \
+            return 1;                                                                              \
+        }                                                                                          \
+        const size_t inner = plan->kept_shape[plan->num_kept - 1];                                 \
+        const size_t blocks = (inner + REDUCE_LANE_BLOCK - 1) / REDUCE_LANE_BLOCK;                 \
+        const size_t row = u / blocks;                                                             \
+        const size_t col = (u % blocks) * REDUCE_LANE_BLOCK;                                       \
+        const size_t n = MIN(REDUCE_LANE_BLOCK, inner - col);                                      \
+        for (size_t i = 0; i < n; i++) {                                                           \
+            acc[i] = INIT;                                                                         \
+        }                                                                                          \
+        *first = row * inner + col;                                                                \
+        const IN_TYPE *input = a->input + reduce_plan_base(plan, row, plan->num_kept - 1) + col;   \
+        reduce_##NAME##_block(acc, input, n, p0, p1, plan);                                        \
+        return n;                                                                                  \
+    }                                                                                              \
+                                                                                                   \
+    /* Units [start, end): full reductions written straight to the output */                       \
+    static void reduce_##NAME##_task(size_t start, size_t end, void *ctx) {                        \
+        const reduce_##NAME##_args_t *a = (const reduce_##NAME##_args_t *)ctx;                     \
+        const reduce_plan_t *plan = &a->plan;                                                      \
+        ACC_TYPE accs[REDUCE_LANE_BLOCK];                                                          \
+        for (size_t u = start; u < end; u++) {                                                     \
+            size_t first;                                                                          \
+            const size_t n = reduce_##NAME##_unit(a, u, 0, a->plan.reduce_size, accs, &first);     \
+            for (size_t i = 0; i < n; i++) {                                                       \
+                ACC_TYPE acc = accs[i];                                                            \
+                a->output[first + i] = FINAL;                                                      \
+            }                                                                                      \
+        }                                                                                          \
+        (void)plan;                                                                                \
+    }                                                                                              \
+                                                                                                   \
+    /* Chunks [start, end): partials of every unit over the chunk's reduced positions */           \
+    static void reduce_##NAME##_split_task(size_t start, size_t end, void *ctx) {                  \
+        const reduce_##NAME##_args_t *a = (const reduce_##NAME##_args_t *)ctx;                     \
+        const size_t units = reduce_plan_units(&a->plan);                                          \
+        const size_t reduce_size = a->plan.reduce_size;                                            \
+        ACC_TYPE accs[REDUCE_LANE_BLOCK];                                                          \
+        for (size_t c = start; c < end; c++) {                                                     \
+            const size_t p0 = c * reduce_size / a->chunks;                                         \
+            const size_t p1 = (c + 1) * reduce_size / a->chunks;                                   \
+            ACC_TYPE *partial = a->partials + c * a->plan.num_outputs;                             \
+            for (size_t u = 0; u < units; u++) {                                                   \
+                size_t first;                                                                      \
+                const size_t n = reduce_##NAME##_unit(a, u, p0, p1, accs, &first);                 \
+                memcpy(partial + first, accs, n * sizeof(ACC_TYPE));                               \
+            }                                                                                      \
+        }                                                                                          \
+    }                                                                                              \
+                                                                                                   \
+    void hodu_cpu_##NAME(const void *input_ptr, void *output_ptr, const size_t *metadata) {        \
+        HODU_PROFILE_KERNEL(reduce_profile_bytes(metadata, sizeof(IN_TYPE), sizeof(OUT_TYPE)));    \
+        reduce_##NAME##_args_t a;                                                                  \
+        reduce_plan_init(&a.plan, metadata);                                                       \
+        a.input = (const IN_TYPE *)input_ptr;                                                      \
+        a.output = (OUT_TYPE *)output_ptr;                                                         \
+        a.partials = NULL;                                                                         \
+        a.chunks = 1;                                                                              \
+        const size_t num_outputs = a.plan.num_outputs;                                             \
+        const size_t units = reduce_plan_units(&a.plan);                                           \
+        if (units == 0)                                                                            \
+            return;                                                                                \
+                                                                                                   \
+        const size_t chunks = reduce_plan_chunks(&a.plan, units);                                  \
+        if (chunks > 1) {                                                                          \
+            a.partials = (ACC_TYPE *)workspace_acquire(chunks * num_outputs * sizeof(ACC_TYPE));   \
+        }                                                                                          \
+        if (a.partials) {                                                                          \
+            a.chunks = chunks;                                                                     \
+            parallel_for(0, chunks, 1, reduce_##NAME##_split_task, &a);                            \
+            for (size_t step = 1; step < chunks; step *= 2) {                                      \
+                for (size_t c = 0; c + step < chunks; c += 2 * step) {                             \
+                    ACC_TYPE *dst = a.partials + c * num_outputs;                                  \
+                    const ACC_TYPE *src = a.partials + (c + step) * num_outputs;                   \
+                    for (size_t i = 0; i < num_outputs; i++) {                                     \
+                        ACC_TYPE acc = dst[i];                                                     \
+                        const ACC_TYPE other = src[i];                                             \
+                        MERGE;                                                                     \
+                        dst[i] = acc;                                                              \
+                    }                                                                              \
+                }                                                                                  \
+            }                                                                                      \
+            const reduce_plan_t *plan = &a.plan;                                                   \
+            for (size_t i = 0; i < num_outputs; i++) {                                             \
+                ACC_TYPE acc = a.partials[i];                                                      \
+                a.output[i] = FINAL;                                                               \
+            }                                                                                      \
+            (void)plan;                                                                            \
+            workspace_release(a.partials);                                                         \
+            return;                                                                                \
+        }                                                                                          \
+                                                                                                   \
+        const size_t lanes = a.plan.outer ? REDUCE_LANE_BLOCK : 1;                                 \
+        const size_t unit_work = MAX(a.plan.reduce_size, 1) * lanes;                               \
+        const size_t grain = MAX(REDUCE_PARALLEL_WORK / unit_work, 1);                             \
+        parallel_for(0, units, grain, reduce_##NAME##_task, &a);                                   \
     }
-}
+
+/// Macro to implement a generic reduction operation
+///
+/// @param IN_TYPE Input C type
+/// @param OUT_TYPE Output C type (same as input for most ops)
+/// @param TYPE_SUFFIX Suffix for function naming
+/// @param INIT_VAL Initial accumulator value
+/// @param ACCUMULATE Expression to accumulate values (e.g., acc += val); also used to merge
+///        partial results, so it must be associative
+#define REDUCE_OP(IN_TYPE, OUT_TYPE, TYPE_SUFFIX, INIT_VAL, ACCUMULATE)                            \
+    REDUCE_SCALAR_HOOKS(TYPE_SUFFIX, IN_TYPE, OUT_TYPE, ACCUMULATE)                                \
+    REDUCE_ENGINE(TYPE_SUFFIX, IN_TYPE, OUT_TYPE, OUT_TYPE, INIT_VAL, ACCUMULATE,                  \
+                  { const OUT_TYPE val = other; ACCUMULATE; }, acc)
+
+/// Macro to implement an f32/f64 sum/max/min reduction with SIMD hooks
+///
+/// @param TYPE C float type
+/// @param TYPE_SUFFIX Suffix for function naming
+/// @param HOOKS REDUCE_F32_HOOKS or REDUCE_F64_HOOKS
+/// @param INIT_VAL Initial accumulator value
+/// @param VOP simd_utils combine operation (add, max, min)
+/// @param HRED simd_utils horizontal reduction (reduce_add, reduce_max, reduce_min)
+/// @param COMBINE Scalar combine macro (REDUCE_ADD, MAX, MIN)
+#define REDUCE_OP_SIMD(TYPE, TYPE_SUFFIX, HOOKS, INIT_VAL, VOP, HRED, COMBINE)                     \
+    HOOKS(TYPE_SUFFIX, INIT_VAL, VOP, HRED, COMBINE, 0)                                            \
+    REDUCE_ENGINE(TYPE_SUFFIX, TYPE, TYPE, TYPE, INIT_VAL, acc = COMBINE(acc, val),                \
+                  acc = COMBINE(acc, other), acc)
+
+REDUCE_OP_SIMD(f32_t, sum_f32, REDUCE_F32_HOOKS, 0.0f, add, reduce_add, REDUCE_ADD)
+REDUCE_OP_SIMD(f64_t, sum_f64, REDUCE_F64_HOOKS, 0.0, add, reduce_add, REDUCE_ADD)
 REDUCE_OP(int8_t, int8_t, sum_i8, 0, acc += val)
 REDUCE_OP(int16_t, int16_t, sum_i16, 0, acc += val)
 REDUCE_OP(int32_t, int32_t, sum_i32, 0, acc += val)
@@ -351,221 +555,85 @@ REDUCE_OP(uint16_t, uint16_t, sum_u16, 0u, acc += val)
 REDUCE_OP(uint32_t, uint32_t, sum_u32, 0u, acc += val)
 REDUCE_OP(uint64_t, uint64_t, sum_u64, 0u, acc += val)
 
+// Low-precision sums (bf16/f16/f8) accumulate in f32: contiguous runs are widened to f32 in
+// blocks of REDUCE_WIDEN_BLOCK elements and summed with the f32 hooks, block sums and strided
+// elements go into a Kahan-compensated f32 accumulator, and only the result is rounded back to
+// the storage type.
+
+/// Elements widened to f32 per block of a low-precision row
+#define REDUCE_WIDEN_BLOCK 256
+
+/// Kahan-compensated f32 accumulator
+typedef struct {
+    float sum;  /* Running sum */
+    float comp; /* Low-order bits lost from sum (subtracted from the next addend) */
+} reduce_kahan_f32_t;
+
+static inline void reduce_kahan_f32_add(reduce_kahan_f32_t *acc, float x) {
+    const float y = x - acc->comp;
+    const float t = acc->sum + y;
+    acc->comp = (t - acc->sum) - y;
+    acc->sum = t;
+}
+
+static inline void reduce_kahan_f32_merge(reduce_kahan_f32_t *acc, reduce_kahan_f32_t other) {
+    reduce_kahan_f32_add(acc, other.sum);
+    reduce_kahan_f32_add(acc, -other.comp);
+}
+
+/// Macro to implement a low-precision sum-of-terms reduction with f32 accumulation
+///
+/// @param NAME Reduction name (e.g. sum_bf16)
+/// @param TYPE C storage type
+/// @param SFX Storage suffix (simd_widen_##SFX, SFX##_to_float)
+/// @param BASE f32 reduction whose row hook sums a widened block (sum_f32, norm_f32)
+/// @param SQUARE 1 to accumulate squares (L2 norm), 0 otherwise
+/// @param FINAL Expression producing the output value from the f32 total `acc.sum`
+#define REDUCE_WIDEN_OP(NAME, TYPE, SFX, BASE, SQUARE, FINAL)                                      \
+    static inline void reduce_##NAME##_row(reduce_kahan_f32_t *acc, const TYPE *input, size_t n,   \
+                                           size_t pos, const reduce_plan_t *plan) {                \
+        float buf[REDUCE_WIDEN_BLOCK];                                                             \
+        for (size_t i = 0; i < n; i += REDUCE_WIDEN_BLOCK) {                                       \
+            const size_t m = MIN((size_t)REDUCE_WIDEN_BLOCK, n - i);                               \
+            float block = 0.0f;                                                                    \
+            simd_widen_##SFX(input + i, buf, m);                                                   \
+            reduce_##BASE##_row(&block, buf, m, 0, NULL);                                          \
+            reduce_kahan_f32_add(acc, block);                                                      \
+        }                                                                                          \
+        (void)pos;                                                                                 \
+        (void)plan;                                                                                \
+    }                                                                                              \
+                                                                                                   \
+    static inline void reduce_##NAME##_lanes(reduce_kahan_f32_t *acc, const TYPE *input,           \
+                                             size_t n, size_t pos, const reduce_plan_t *plan) {    \
+        float buf[REDUCE_LANE_BLOCK];                                                              \
+        simd_widen_##SFX(input, buf, n);                                                           \
+        for (size_t i = 0; i < n; i++) {                                                           \
+            reduce_kahan_f32_add(&acc[i], SQUARE ? buf[i] * buf[i] : buf[i]);                      \
+        }                                                                                          \
+        (void)pos;                                                                                 \
+        (void)plan;                                                                                \
+    }                                                                                              \
+                                                                                                   \
+    REDUCE_ENGINE(NAME, TYPE, TYPE, reduce_kahan_f32_t, ((reduce_kahan_f32_t){0}),                 \
+                  {                                                                                \
+                      const float x_ = SFX##_to_float(val);                                        \
+                      reduce_kahan_f32_add(&acc, SQUARE ? x_ * x_ : x_);                           \
+                  },                                                                               \
+                  reduce_kahan_f32_merge(&acc, other), FINAL)
+
+REDUCE_WIDEN_OP(sum_f8e4m3, f8e4m3_t, f8e4m3, sum_f32, 0, float_to_f8e4m3(acc.sum))
+REDUCE_WIDEN_OP(sum_f8e5m2, f8e5m2_t, f8e5m2, sum_f32, 0, float_to_f8e5m2(acc.sum))
+REDUCE_WIDEN_OP(sum_bf16, bf16_t, bf16, sum_f32, 0, float_to_bf16(acc.sum))
+REDUCE_WIDEN_OP(sum_f16, f16_t, f16, sum_f32, 0, float_to_f16(acc.sum))
+
 // Max reduction operations
 REDUCE_OP(f8e4m3_t, f8e4m3_t, max_f8e4m3, F8E4M3_NEG_INF, acc = f8e4m3_max(acc, val))
 REDUCE_OP(f8e5m2_t, f8e5m2_t, max_f8e5m2, F8E5M2_NEG_INF, acc = f8e5m2_max(acc, val))
 REDUCE_OP(bf16_t, bf16_t, max_bf16, BF16_NEG_INF, acc = bf16_max(acc, val))
 REDUCE_OP(f16_t, f16_t, max_f16, F16_NEG_INF, acc = f16_max(acc, val))
-
-// SIMD-optimized max_f32
-void hodu_cpu_max_f32(const void *input_ptr, void *output_ptr, const size_t *metadata) {
-    const f32_t *input = (const f32_t *)input_ptr;
-    f32_t *output = (f32_t *)output_ptr;
-
-    const size_t num_dims = metadata[0];
-    const size_t *dims = metadata + 1;
-    const size_t *strides = metadata + 1 + num_dims;
-    const size_t offset = metadata[1 + 2 * num_dims];
-    const size_t output_shape_len = metadata[2 + 2 * num_dims];
-    const size_t *output_shape = metadata + 3 + 2 * num_dims;
-    const size_t num_reduce_dims = metadata[3 + 2 * num_dims + output_shape_len];
-    const size_t *reduce_dims = metadata + 4 + 2 * num_dims + output_shape_len;
-    const size_t keep_dim_val = metadata[4 + 2 * num_dims + output_shape_len + num_reduce_dims];
-    const bool keep_dim = (keep_dim_val != 0);
-    const size_t reduce_size = metadata[5 + 2 * num_dims + output_shape_len + num_reduce_dims];
-
-    size_t num_els = 1;
-    for (size_t i = 0; i < output_shape_len; i++) {
-        num_els *= output_shape[i];
-    }
-
-    for (size_t output_idx = 0; output_idx < num_els; output_idx++) {
-        f32_t acc = -INFINITY;
-
-        size_t output_indices[16];
-        size_t temp = output_idx;
-        for (int d = (int)output_shape_len - 1; d >= 0; d--) {
-            output_indices[d] = temp % output_shape[d];
-            temp /= output_shape[d];
-        }
-
-        size_t input_indices[16];
-        if (keep_dim) {
-            for (size_t i = 0; i < num_dims; i++) {
-                input_indices[i] = output_indices[i];
-            }
-        } else {
-            size_t out_idx = 0;
-            for (size_t in_dim = 0; in_dim < num_dims; in_dim++) {
-                bool is_reduced = false;
-                for (size_t r = 0; r < num_reduce_dims; r++) {
-                    if (reduce_dims[r] == in_dim) {
-                        is_reduced = true;
-                        break;
-                    }
-                }
-                if (is_reduced) {
-                    input_indices[in_dim] = 0;
-                } else {
-                    input_indices[in_dim] =
-                        (out_idx < output_shape_len) ? output_indices[out_idx] : 0;
-                    out_idx++;
-                }
-            }
-        }
-
-#if SIMD_F32_WIDTH > 1
-        bool use_simd = (num_reduce_dims == 1) && (reduce_dims[0] == num_dims - 1) &&
-                        (strides[num_dims - 1] == 1) && (reduce_size >= SIMD_F32_WIDTH);
-
-        if (use_simd) {
-            size_t flat_base = offset;
-            for (size_t i = 0; i < num_dims - 1; i++) {
-                flat_base += input_indices[i] * strides[i];
-            }
-
-            simd_f32_t vmax = simd_f32_set1(-INFINITY);
-            const size_t simd_end = (reduce_size / SIMD_F32_WIDTH) * SIMD_F32_WIDTH;
-
-            for (size_t i = 0; i < simd_end; i += SIMD_F32_WIDTH) {
-                simd_f32_t v = simd_f32_load(&input[flat_base + i]);
-                vmax = simd_f32_max(vmax, v);
-            }
-            acc = simd_f32_reduce_max(vmax);
-
-            for (size_t i = simd_end; i < reduce_size; i++) {
-                f32_t val = input[flat_base + i];
-                acc = MAX(acc, val);
-            }
-        } else
-#endif
-        {
-            for (size_t reduced_idx = 0; reduced_idx < reduce_size; reduced_idx++) {
-                size_t temp_reduced = reduced_idx;
-                for (int i = (int)num_reduce_dims - 1; i >= 0; i--) {
-                    size_t dim = reduce_dims[i];
-                    input_indices[dim] = temp_reduced % dims[dim];
-                    temp_reduced /= dims[dim];
-                }
-
-                size_t flat_index = offset;
-                for (size_t i = 0; i < num_dims; i++) {
-                    flat_index += input_indices[i] * strides[i];
-                }
-
-                f32_t val = input[flat_index];
-                acc = MAX(acc, val);
-            }
-        }
-
-        output[output_idx] = acc;
-    }
-}
-
-// SIMD-optimized max_f64
-void hodu_cpu_max_f64(const void *input_ptr, void *output_ptr, const size_t *metadata) {
-    const f64_t *input = (const f64_t *)input_ptr;
-    f64_t *output = (f64_t *)output_ptr;
-
-    const size_t num_dims = metadata[0];
-    const size_t *dims = metadata + 1;
-    const size_t *strides = metadata + 1 + num_dims;
-    const size_t offset = metadata[1 + 2 * num_dims];
-    const size_t output_shape_len = metadata[2 + 2 * num_dims];
-    const size_t *output_shape = metadata + 3 + 2 * num_dims;
-    const size_t num_reduce_dims = metadata[3 + 2 * num_dims + output_shape_len];
-    const size_t *reduce_dims = metadata + 4 + 2 * num_dims + output_shape_len;
-    const size_t keep_dim_val = metadata[4 + 2 * num_dims + output_shape_len + num_reduce_dims];
-    const bool keep_dim = (keep_dim_val != 0);
-    const size_t reduce_size = metadata[5 + 2 * num_dims + output_shape_len + num_reduce_dims];
-
-    size_t num_els = 1;
-    for (size_t i = 0; i < output_shape_len; i++) {
-        num_els *= output_shape[i];
-    }
-
-    for (size_t output_idx = 0; output_idx < num_els; output_idx++) {
-        f64_t acc = -INFINITY;
-
-        size_t output_indices[16];
-        size_t temp = output_idx;
-        for (int d = (int)output_shape_len - 1; d >= 0; d--) {
-            output_indices[d] = temp % output_shape[d];
-            temp /= output_shape[d];
-        }
-
-        size_t input_indices[16];
-        if (keep_dim) {
-            for (size_t i = 0; i < num_dims; i++) {
-                input_indices[i] = output_indices[i];
-            }
-        } else {
-            size_t out_idx = 0;
-            for (size_t in_dim = 0; in_dim < num_dims; in_dim++) {
-                bool is_reduced = false;
-                for (size_t r = 0; r < num_reduce_dims; r++) {
-                    if (reduce_dims[r] == in_dim) {
-                        is_reduced = true;
-                        break;
-                    }
-                }
-                if (is_reduced) {
-                    input_indices[in_dim] = 0;
-                } else {
-                    input_indices[in_dim] =
-                        (out_idx < output_shape_len) ? output_indices[out_idx] : 0;
-                    out_idx++;
-                }
-            }
-        }
-
-#if SIMD_F64_WIDTH > 1
-        bool use_simd = (num_reduce_dims == 1) && (reduce_dims[0] == num_dims - 1) &&
-                        (strides[num_dims - 1] == 1) && (reduce_size >= SIMD_F64_WIDTH);
-
-        if (use_simd) {
-            size_t flat_base = offset;
-            for (size_t i = 0; i < num_dims - 1; i++) {
-                flat_base += input_indices[i] * strides[i];
-            }
-
-            simd_f64_t vmax = simd_f64_set1(-INFINITY);
-            const size_t simd_end = (reduce_size / SIMD_F64_WIDTH) * SIMD_F64_WIDTH;
-
-            for (size_t i = 0; i < simd_end; i += SIMD_F64_WIDTH) {
-                simd_f64_t v = simd_f64_load(&input[flat_base + i]);
-                vmax = simd_f64_max(vmax, v);
-            }
-            acc = simd_f64_reduce_max(vmax);
-
-            for (size_t i = simd_end; i < reduce_size; i++) {
-                f64_t val = input[flat_base + i];
-                acc = MAX(acc, val);
-            }
-        } else
-#endif
-        {
-            for (size_t reduced_idx = 0; reduced_idx < reduce_size; reduced_idx++) {
-                size_t temp_reduced = reduced_idx;
-                for (int i = (int)num_reduce_dims - 1; i >= 0; i--) {
-                    size_t dim = reduce_dims[i];
-                    input_indices[dim] = temp_reduced % dims[dim];
-                    temp_reduced /= dims[dim];
-                }
-
-                size_t flat_index = offset;
-                for (size_t i = 0; i < num_dims; i++) {
-                    flat_index += input_indices[i] * strides[i];
-                }
-
-                f64_t val = input[flat_index];
-                acc = MAX(acc, val);
-            }
-        }
-
-        output[output_idx] = acc;
-    }
-}
+REDUCE_OP_SIMD(f32_t, max_f32, REDUCE_F32_HOOKS, -INFINITY, max, reduce_max, MAX)
+REDUCE_OP_SIMD(f64_t, max_f64, REDUCE_F64_HOOKS, -INFINITY, max, reduce_max, MAX)
 REDUCE_OP(int8_t, int8_t, max_i8, INT8_MIN, acc = MAX(acc, val))
 REDUCE_OP(int16_t, int16_t, max_i16, INT16_MIN, acc = MAX(acc, val))
 REDUCE_OP(int32_t, int32_t, max_i32, INT32_MIN, acc = MAX(acc, val))
@@ -580,216 +648,8 @@ REDUCE_OP(f8e4m3_t, f8e4m3_t, min_f8e4m3, F8E4M3_POS_INF, acc = f8e4m3_min(acc,
 REDUCE_OP(f8e5m2_t, f8e5m2_t, min_f8e5m2, F8E5M2_POS_INF, acc = f8e5m2_min(acc, val))
 REDUCE_OP(bf16_t, bf16_t, min_bf16, BF16_POS_INF, acc = bf16_min(acc, val))
 REDUCE_OP(f16_t, f16_t, min_f16, F16_POS_INF, acc = f16_min(acc, val))
-
-// SIMD-optimized min_f32
-void hodu_cpu_min_f32(const void *input_ptr, void *output_ptr, const size_t *metadata) {
-    const f32_t *input = (const f32_t *)input_ptr;
-    f32_t *output = (f32_t *)output_ptr;
-
-    const size_t num_dims = metadata[0];
-    const size_t *dims = metadata + 1;
-    const size_t *strides = metadata + 1 + num_dims;
-    const size_t offset = metadata[1 + 2 * num_dims];
-    const size_t output_shape_len = metadata[2 + 2 * num_dims];
-    const size_t *output_shape = metadata + 3 + 2 * num_dims;
-    const size_t num_reduce_dims = metadata[3 + 2 * num_dims + output_shape_len];
-    const size_t *reduce_dims = metadata + 4 + 2 * num_dims + output_shape_len;
-    const size_t keep_dim_val = metadata[4 + 2 * num_dims + output_shape_len + num_reduce_dims];
-    const bool keep_dim = (keep_dim_val != 0);
-    const size_t reduce_size = metadata[5 + 2 * num_dims + output_shape_len + num_reduce_dims];
-
-    size_t num_els = 1;
-    for (size_t i = 0; i < output_shape_len; i++) {
-        num_els *= output_shape[i];
-    }
-
-    for (size_t output_idx = 0; output_idx < num_els; output_idx++) {
-        f32_t acc = INFINITY;
-
-        size_t output_indices[16];
-        size_t temp = output_idx;
-        for (int d = (int)output_shape_len - 1; d >= 0; d--) {
-            output_indices[d] = temp % output_shape[d];
-            temp /= output_shape[d];
-        }
-
-        size_t input_indices[16];
-        if (keep_dim) {
-            for (size_t i = 0; i < num_dims; i++) {
-                input_indices[i] = output_indices[i];
-            }
-        } else {
-            size_t out_idx = 0;
-            for (size_t in_dim = 0; in_dim < num_dims; in_dim++) {
-                bool is_reduced = false;
-                for (size_t r = 0; r < num_reduce_dims; r++) {
-                    if (reduce_dims[r] == in_dim) {
-                        is_reduced = true;
-                        break;
-                    }
-                }
-                if (is_reduced) {
-                    input_indices[in_dim] = 0;
-                } else {
-                    input_indices[in_dim] =
-                        (out_idx < output_shape_len) ? output_indices[out_idx] : 0;
-                    out_idx++;
-                }
-            }
-        }
-
-#if SIMD_F32_WIDTH > 1
-        bool use_simd = (num_reduce_dims == 1) && (reduce_dims[0] == num_dims - 1) &&
-                        (strides[num_dims - 1] == 1) && (reduce_size >= SIMD_F32_WIDTH);
-
-        if (use_simd) {
-            size_t flat_base = offset;
-            for (size_t i = 0; i < num_dims - 1; i++) {
-                flat_base += input_indices[i] * strides[i];
-            }
-
-            simd_f32_t vmin = simd_f32_set1(INFINITY);
-            const size_t simd_end = (reduce_size / SIMD_F32_WIDTH) * SIMD_F32_WIDTH;
-
-            for (size_t i = 0; i < simd_end; i += SIMD_F32_WIDTH) {
-                simd_f32_t v = simd_f32_load(&input[flat_base + i]);
-                vmin = simd_f32_min(vmin, v);
-            }
-            acc = simd_f32_reduce_min(vmin);
-
-            for (size_t i = simd_end; i < reduce_size; i++) {
-                f32_t val = input[flat_base + i];
-                acc = MIN(acc, val);
-            }
-        } else
-#endif
-        {
-            for (size_t reduced_idx = 0; reduced_idx < reduce_size; reduced_idx++) {
-                size_t temp_reduced = reduced_idx;
-                for (int i = (int)num_reduce_dims - 1; i >= 0; i--) {
-                    size_t dim = reduce_dims[i];
-                    input_indices[dim] = temp_reduced % dims[dim];
-                    temp_reduced /= dims[dim];
-                }
-
-                size_t flat_index = offset;
-                for (size_t i = 0; i < num_dims; i++) {
-                    flat_index += input_indices[i] * strides[i];
-                }
-
-                f32_t val = input[flat_index];
-                acc = MIN(acc, val);
-            }
-        }
-
-        output[output_idx] = acc;
-    }
-}
-
-// SIMD-optimized min_f64
-void hodu_cpu_min_f64(const void *input_ptr, void *output_ptr, const size_t *metadata) {
-    const f64_t *input = (const f64_t *)input_ptr;
-    f64_t *output = (f64_t *)output_ptr;
-
-    const size_t num_dims = metadata[0];
-    const size_t *dims = metadata + 1;
-    const size_t *strides = metadata + 1 + num_dims;
-    const size_t offset = metadata[1 + 2 * num_dims];
-    const size_t output_shape_len = metadata[2 + 2 * num_dims];
-    const size_t *output_shape = metadata + 3 + 2 * num_dims;
-    const size_t num_reduce_dims = metadata[3 + 2 * num_dims + output_shape_len];
-    const size_t *reduce_dims = metadata + 4 + 2 * num_dims + output_shape_len;
-    const size_t keep_dim_val = metadata[4 + 2 * num_dims + output_shape_len + num_reduce_dims];
-    const bool keep_dim = (keep_dim_val != 0);
-    const size_t reduce_size = metadata[5 + 2 * num_dims + output_shape_len + num_reduce_dims];
-
-    size_t num_els = 1;
-    for (size_t i = 0; i < output_shape_len; i++) {
-        num_els *= output_shape[i];
-    }
-
-    for (size_t output_idx = 0; output_idx < num_els; output_idx++) {
-        f64_t acc = INFINITY;
-
-        size_t output_indices[16];
-        size_t temp = output_idx;
-        for (int d = (int)output_shape_len - 1; d >= 0; d--) {
-            output_indices[d] = temp % output_shape[d];
-            temp /= output_shape[d];
-        }
-
-        size_t input_indices[16];
-        if (keep_dim) {
-            for (size_t i = 0; i < num_dims; i++) {
-                input_indices[i] = output_indices[i];
-            }
-        } else {
-            size_t out_idx = 0;
-            for (size_t in_dim = 0; in_dim < num_dims; in_dim++) {
-                bool is_reduced = false;
-                for (size_t r = 0; r < num_reduce_dims; r++) {
-                    if (reduce_dims[r] == in_dim) {
-                        is_reduced = true;
-                        break;
-                    }
-                }
-                if (is_reduced) {
-                    input_indices[in_dim] = 0;
-                } else {
-                    input_indices[in_dim] =
-                        (out_idx < output_shape_len) ? output_indices[out_idx] : 0;
-                    out_idx++;
-                }
-            }
-        }
-
-#if SIMD_F64_WIDTH > 1
-        bool use_simd = (num_reduce_dims == 1) && (reduce_dims[0] == num_dims - 1) &&
-                        (strides[num_dims - 1] == 1) && (reduce_size >= SIMD_F64_WIDTH);
-
-        if (use_simd) {
-            size_t flat_base = offset;
-            for (size_t i = 0; i < num_dims - 1; i++) {
-                flat_base += input_indices[i] * strides[i];
-            }
-
-            simd_f64_t vmin = simd_f64_set1(INFINITY);
-            const size_t simd_end = (reduce_size / SIMD_F64_WIDTH) * SIMD_F64_WIDTH;
-
-            for (size_t i = 0; i < simd_end; i += SIMD_F64_WIDTH) {
-                simd_f64_t v = simd_f64_load(&input[flat_base + i]);
-                vmin = simd_f64_min(vmin, v);
-            }
-            acc = simd_f64_reduce_min(vmin);
-
-            for (size_t i = simd_end; i < reduce_size; i++) {
-                f64_t val = input[flat_base + i];
-                acc = MIN(acc, val);
-            }
-        } else
-#endif
-        {
-            for (size_t reduced_idx = 0; reduced_idx < reduce_size; reduced_idx++) {
-                size_t temp_reduced = reduced_idx;
-                for (int i = (int)num_reduce_dims - 1; i >= 0; i--) {
-                    size_t dim = reduce_dims[i];
-                    input_indices[dim] = temp_reduced % dims[dim];
-                    temp_reduced /= dims[dim];
-                }
-
-                size_t flat_index = offset;
-                for (size_t i = 0; i < num_dims; i++) {
-                    flat_index += input_indices[i] * strides[i];
-                }
-
-                f64_t val = input[flat_index];
-                acc = MIN(acc, val);
-            }
-        }
-
-        output[output_idx] = acc;
-    }
-}
+REDUCE_OP_SIMD(f32_t, min_f32, REDUCE_F32_HOOKS, INFINITY, min, reduce_min, MIN)
+REDUCE_OP_SIMD(f64_t, min_f64, REDUCE_F64_HOOKS, INFINITY, min, reduce_min, MIN)
 REDUCE_OP(int8_t, int8_t, min_i8, INT8_MAX, acc = MIN(acc, val))
 REDUCE_OP(int16_t, int16_t, min_i16, INT16_MAX, acc = MIN(acc, val))
 REDUCE_OP(int32_t, int32_t, min_i32, INT32_MAX, acc = MIN(acc, val))
@@ -816,632 +676,276 @@ REDUCE_OP(uint32_t, uint32_t, prod_u32, 1u, acc *= val)
 REDUCE_OP(uint64_t, uint64_t, prod_u64, 1u, acc *= val)
 
 // ============================================================================
-// STANDARD DEVIATION REDUCTION
+// VARIANCE / STANDARD DEVIATION REDUCTION
 // ============================================================================
 //
-// Computes population standard deviation: sqrt(E[X²] - E[X]²)
-// Two-pass algorithm: accumulate sum and sum of squares, then compute std.
+// Computes population variance Var[X] = M2 / n and std = sqrt(Var[X]) from the central
+// moments (count n, mean, M2 = sum((x - mean)²)) rather than E[X²] - E[X]², which cancels
+// catastrophically for inputs with a large mean.
+// - Contiguous runs are taken in blocks of REDUCE_MOMENTS_BLOCK elements: a two-pass SIMD
+//   sweep (block mean, then deviations and squared deviations, with the corrected two-pass
+//   residual) whose result is merged into the moments
+// - Strided elements and lane blocks use Welford's single-element update on values shifted by
+//   the first element seen, so the running mean stays small and keeps its precision
+// - Partials (blocks, split-K chunks) are combined with Chan's parallel merge
+// Exotic types accumulate their moments in f32.
 //
 // Metadata layout: Same as generic reduction operations
 
-/// Macro to implement standard deviation reduction (float types only)
-///
-/// @param TYPE C float type
-/// @param TYPE_SUFFIX Suffix for function naming
-#define REDUCE_STD_OP(TYPE, TYPE_SUFFIX)                                                           \
-    void hodu_cpu_std_##TYPE_SUFFIX(const void *input_ptr, void *output_ptr,                       \
-                                    const size_t *metadata) {                                      \
-        const TYPE *input = (const TYPE *)input_ptr;                                               \
-        TYPE *output = (TYPE *)output_ptr;                                                         \
-                                                                                                   \
-        const size_t num_dims = metadata[0];                                                       \
-        const size_t *dims = metadata + 1;                                                         \
-        const size_t *strides = metadata + 1 + num_dims;                                           \
-        const size_t offset = metadata[1 + 2 * num_dims];                                          \
-        const size_t output_shape_len = metadata[2 + 2 * num_dims];                                \
-        const size_t *output_shape = metadata + 3 + 2 * num_dims;                                  \
-        const size_t num_reduce_dims = metadata[3 + 2 * num_dims + output_shape_len];              \
-        const size_t *reduce_dims = metadata + 4 + 2 * num_dims + output_shape_len;                \
-        const size_t keep_dim_val =                                                                \
-            metadata[4 + 2 * num_dims + output_shape_len + num_reduce_dims];                       \
-        const bool keep_dim = (keep_dim_val != 0);                                                 \
-        const size_t reduce_size =                                                                 \
-            metadata[5 + 2 * num_dims + output_shape_len + num_reduce_dims];                       \
-        size_t num_els = 1;                                                                        \
-        for (size_t i = 0; i < output_shape_len; i++) {                                            \
-            num_els *= output_shape[i];                                                            \
-        }                                                                                          \
-                                                                                                   \
-        for (size_t output_idx = 0; output_idx < num_els; output_idx++) {                          \
-            TYPE sum = 0;                                                                          \
-            TYPE sum_squares = 0;                                                                  \
-                                                                                                   \
-            size_t output_indices[16];                                                             \
-            size_t temp = output_idx;                                                              \
-            for (int d = (int)output_shape_len - 1; d >= 0; d--) {                                 \
-                output_indices[d] = temp % output_shape[d];                                        \
-                temp /= output_shape[d];                                                           \
-            }                                                                                      \
-                                                                                                   \
-            size_t input_indices[16];                                                              \
-            if (keep_dim) {                                                                        \
-                for (size_t i = 0; i < num_dims; i++) {                                            \
-                    input_indices[i] = output_indices[i];                                          \
-                }                                                                                  \
-            } else {                                                                               \
-                size_t out_idx = 0;                                                                \
-                for (size_t in_dim = 0; in_dim < num_dims; in_dim++) {                             \
-                    bool is_reduced = false;                                                       \
-                    for (size_t r = 0; r < num_reduce_dims; r++) {                                 \
-                        if (reduce_dims[r] == in_dim) {                                            \
-                            is_reduced = true;                                                     \
-                            break;                                                                 \
-                        }                                                                          \
-                    }                                                                              \
-                    if (is_reduced) {                                                              \
-                        input_indices[in_dim] = 0;                                                 \
-                    } else {                                                                       \
-                        input_indices[in_dim] =                                                    \
-                            (out_idx < output_shape_len) ? output_indices[out_idx] : 0;            \
-                        out_idx++;                                                                 \
-                    }                                                                              \
-                }                                                                                  \
-            }                                                                                      \
-                                                                                                   \
-            for (size_t reduced_idx = 0; reduced_idx < reduce_size; reduced_idx++) {               \
-                size_t temp_reduced = reduced_idx;                                                 \
-                for (int i = (int)num_reduce_dims - 1; i >= 0; i--) {                              \
-                    size_t dim = reduce_dims[i];                                                   \
-                    input_indices[dim] = temp_reduced % dims[dim];                                 \
-                    temp_reduced /= dims[dim];                                                     \
-                }                                                                                  \
-                                                                                                   \
-                size_t flat_index = offset;                                                        \
-                for (size_t i = 0; i < num_dims; i++) {                                            \
-                    flat_index += input_indices[i] * strides[i];                                   \
-                }                                                                                  \
-                                                                                                   \
-                TYPE val = input[flat_index];                                                      \
-                sum += val;                                                                        \
-                sum_squares += val * val;                                                          \
-            }                                                                                      \
-                                                                                                   \
-            TYPE mean = sum / (TYPE)reduce_size;                                                   \
-            TYPE variance = (sum_squares / (TYPE)reduce_size) - (mean * mean);                     \
-            output[output_idx] = sqrt(variance);                                                   \
-        }                                                                                          \
-    }
+/// Elements per block of the blocked two-pass moments update
+#define REDUCE_MOMENTS_BLOCK 256
 
-/// Macro to implement standard deviation reduction for exotic types
+/// Macro to implement a SIMD sum of deviations and squared deviations from a given mean
 ///
-/// @param TYPE C float type
-/// @param TYPE_SUFFIX Suffix for function naming
-/// @param ZERO Zero constant for the type
-/// @param ADD_FN Addition function
-/// @param MUL_FN Multiplication function
-/// @param DIV_FN Division function
-/// @param SUB_FN Subtraction function
-/// @param SQRT_FN Square root function
-#define REDUCE_STD_OP_EXOTIC(TYPE, TYPE_SUFFIX, ZERO, ADD_FN, MUL_FN, DIV_FN, SUB_FN, SQRT_FN)     \
-    void hodu_cpu_std_##TYPE_SUFFIX(const void *input_ptr, void *output_ptr,                       \
-                                    const size_t *metadata) {                                      \
-        const TYPE *input = (const TYPE *)input_ptr;                                               \
-        TYPE *output = (TYPE *)output_ptr;                                                         \
-                                                                                                   \
-        const size_t num_dims = metadata[0];                                                       \
-        const size_t *dims = metadata + 1;                                                         \
-        const size_t *strides = metadata + 1 + num_dims;                                           \
-        const size_t offset = metadata[1 + 2 * num_dims];                                          \
-        const size_t output_shape_len = metadata[2 + 2 * num_dims];                                \
-        const size_t *output_shape = metadata + 3 + 2 * num_dims;                                  \
-        const size_t num_reduce_dims = metadata[3 + 2 * num_dims + output_shape_len];              \
-        const size_t *reduce_dims = metadata + 4 + 2 * num_dims + output_shape_len;                \
-        const size_t keep_dim_val =                                                                \
-            metadata[4 + 2 * num_dims + output_shape_len + num_reduce_dims];                       \
-        const bool keep_dim = (keep_dim_val != 0);                                                 \
-        const size_t reduce_size =                                                                 \
-            metadata[5 + 2 * num_dims + output_shape_len + num_reduce_dims];                       \
-        size_t num_els = 1;                                                                        \
-        for (size_t i = 0; i < output_shape_len; i++) {                                            \
-            num_els *= output_shape[i];                                                            \
-        }                                                                                          \
-                                                                                                   \
-        for (size_t output_idx = 0; output_idx < num_els; output_idx++) {                          \
-            TYPE sum = ZERO;                                                                       \
-            TYPE sum_squares = ZERO;                                                               \
-                                                                                                   \
-            size_t output_indices[16];                                                             \
-            size_t temp = output_idx;                                                              \
-            for (int d = (int)output_shape_len - 1; d >= 0; d--) {                                 \
-                output_indices[d] = temp % output_shape[d];                                        \
-                temp /= output_shape[d];                                                           \
-            }                                                                                      \
-                                                                                                   \
-            size_t input_indices[16];                                                              \
-            if (keep_dim) {                                                                        \
-                for (size_t i = 0; i < num_dims; i++) {                                            \
-                    input_indices[i] = output_indices[i];                                          \
-                }                                                                                  \
-            } else {                                                                               \
-                size_t out_idx = 0;                                                                \
-                for (size_t in_dim = 0; in_dim < num_dims; in_dim++) {                             \
-                    bool is_reduced = false;                                                       \
-                    for (size_t r = 0; r < num_reduce_dims; r++) {                                 \
-                        if (reduce_dims[r] == in_dim) {                                            \
-                            is_reduced = true;                                                     \
-                            break;                                                                 \
-                        }                                                                          \
-                    }                                                                              \
-                    if (is_reduced) {                                                              \
-                        input_indices[in_dim] = 0;                                                 \
-                    } else {                                                                       \
-                        input_indices[in_dim] =                                                    \
-                            (out_idx < output_shape_len) ? output_indices[out_idx] : 0;            \
-                        out_idx++;                                                                 \
-                    }                                                                              \
-                }                                                                                  \
-            }                                                                                      \
-                                                                                                   \
-            for (size_t reduced_idx = 0; reduced_idx < reduce_size; reduced_idx++) {               \
-                size_t temp_reduced = reduced_idx;                                                 \
-                for (int i = (int)num_reduce_dims - 1; i >= 0; i--) {                              \
-                    size_t dim = reduce_dims[i];                                                   \
-                    input_indices[dim] = temp_reduced % dims[dim];                                 \
-                    temp_reduced /= dims[dim];                                                     \
-                }                                                                                  \
-                                                                                                   \
-                size_t flat_index = offset;                                                        \
-                for (size_t i = 0; i < num_dims; i++) {                                            \
-                    flat_index += input_indices[i] * strides[i];                                   \
-                }                                                                                  \
-                                                                                                   \
-                TYPE val = input[flat_index];                                                      \
-                sum = ADD_FN(sum, val);                                                            \
-                sum_squares = ADD_FN(sum_squares, MUL_FN(val, val));                               \
-            }                                                                                      \
-                                                                                                   \
-            float reduce_size_f = (float)reduce_size;                                              \
-            TYPE reduce_size_typed = float_to_##TYPE_SUFFIX(reduce_size_f);                        \
-            TYPE mean = DIV_FN(sum, reduce_size_typed);                                            \
-            TYPE variance = SUB_FN(DIV_FN(sum_squares, reduce_size_typed), MUL_FN(mean, mean));    \
-            output[output_idx] = SQRT_FN(variance);                                                \
-        }                                                                                          \
-    }
-
-REDUCE_STD_OP_EXOTIC(f8e4m3_t, f8e4m3, F8E4M3_ZERO, f8e4m3_add, f8e4m3_mul, f8e4m3_div, f8e4m3_sub,
-                     f8e4m3_sqrt)
-REDUCE_STD_OP_EXOTIC(f8e5m2_t, f8e5m2, F8E5M2_ZERO, f8e5m2_add, f8e5m2_mul, f8e5m2_div, f8e5m2_sub,
-                     f8e5m2_sqrt)
-REDUCE_STD_OP_EXOTIC(bf16_t, bf16, BF16_ZERO, bf16_add, bf16_mul, bf16_div, bf16_sub, bf16_sqrt)
-REDUCE_STD_OP_EXOTIC(f16_t, f16, F16_ZERO, f16_add, f16_mul, f16_div, f16_sub, f16_sqrt)
-REDUCE_STD_OP(f32_t, f32)
-REDUCE_STD_OP(f64_t, f64)
-
-// ============================================================================
-// VARIANCE REDUCTION
-// ============================================================================
-//
-// Computes population variance: E[X²] - E[X]²
-// Same as std but without the sqrt.
-//
-// Metadata layout: Same as generic reduction operations
-
-/// Macro to implement variance reduction (float types only)
-///
-/// @param TYPE C float type
-/// @param TYPE_SUFFIX Suffix for function naming
-#define REDUCE_VAR_OP(TYPE, TYPE_SUFFIX)                                                           \
-    void hodu_cpu_var_##TYPE_SUFFIX(const void *input_ptr, void *output_ptr,                       \
-                                    const size_t *metadata) {                                      \
-        const TYPE *input = (const TYPE *)input_ptr;                                               \
-        TYPE *output = (TYPE *)output_ptr;                                                         \
-                                                                                                   \
-        const size_t num_dims = metadata[0];                                                       \
-        const size_t *dims = metadata + 1;                                                         \
-        const size_t *strides = metadata + 1 + num_dims;                                           \
-        const size_t offset = metadata[1 + 2 * num_dims];                                          \
-        const size_t output_shape_len = metadata[2 + 2 * num_dims];                                \
-        const size_t *output_shape = metadata + 3 + 2 * num_dims;                                  \
-        const size_t num_reduce_dims = metadata[3 + 2 * num_dims + output_shape_len];              \
-        const size_t *reduce_dims = metadata + 4 + 2 * num_dims + output_shape_len;                \
-        const size_t keep_dim_val =                                                                \
-            metadata[4 + 2 * num_dims + output_shape_len + num_reduce_dims];                       \
-        const bool keep_dim = (keep_dim_val != 0);                                                 \
-        const size_t reduce_size =                                                                 \
-            metadata[5 + 2 * num_dims + output_shape_len + num_reduce_dims];                       \
-        size_t num_els = 1;                                                                        \
-        for (size_t i = 0; i < output_shape_len; i++) {                                            \
-            num_els *= output_shape[i];                                                            \
-        }                                                                                          \
-                                                                                                   \
-        for (size_t output_idx = 0; output_idx < num_els; output_idx++) {                          \
-            TYPE sum = 0;                                                                          \
-            TYPE sum_squares = 0;                                                                  \
-                                                                                                   \
-            size_t output_indices[16];                                                             \
-            size_t temp = output_idx;                                                              \
-            for (int d = (int)output_shape_len - 1; d >= 0; d--) {                                 \
-                output_indices[d] = temp % output_shape[d];                                        \
-                temp /= output_shape[d];                                                           \
-            }                                                                                      \
-                                                                                                   \
-            size_t input_indices[16];                                                              \
-            if (keep_dim) {                                                                        \
-                for (size_t i = 0; i < num_dims; i++) {                                            \
-                    input_indices[i] = output_indices[i];                                          \
-                }                                                                                  \
-            } else {                                                                               \
-                size_t out_idx = 0;                                                                \
-                for (size_t in_dim = 0; in_dim < num_dims; in_dim++) {                             \
-                    bool is_reduced = false;                                                       \
-                    for (size_t r = 0; r < num_reduce_dims; r++) {                                 \
-                        if (reduce_dims[r] == in_dim) {                                            \
-                            is_reduced = true;                                                     \
-                            break;                                                                 \
-                        }                                                                          \
-                    }                                                                              \
-                    if (is_reduced) {                                                              \
-                        input_indices[in_dim] = 0;                                                 \
-                    } else {                                                                       \
-                        input_indices[in_dim] =                                                    \
-                            (out_idx < output_shape_len) ? output_indices[out_idx] : 0;            \
-                        out_idx++;                                                                 \
-                    }                                                                              \
-                }                                                                                  \
-            }                                                                                      \
-                                                                                                   \
-            for (size_t reduced_idx = 0; reduced_idx < reduce_size; reduced_idx++) {               \
-                size_t temp_reduced = reduced_idx;                                                 \
-                for (int i = (int)num_reduce_dims - 1; i >= 0; i--) {                              \
-                    size_t dim = reduce_dims[i];                                                   \
-                    input_indices[dim] = temp_reduced % dims[dim];                                 \
-                    temp_reduced /= dims[dim];                                                     \
-                }                                                                                  \
-                                                                                                   \
-                size_t flat_index = offset;                                                        \
-                for (size_t i = 0; i < num_dims; i++) {                                            \
-                    flat_index += input_indices[i] * strides[i];                                   \
-                }                                                                                  \
-                                                                                                   \
-                TYPE val = input[flat_index];                                                      \
-                sum += val;                                                                        \
-                sum_squares += val * val;                                                          \
-            }                                                                                      \
-                                                                                                   \
-            TYPE mean = sum / (TYPE)reduce_size;                                                   \
-            output[output_idx] = (sum_squares / (TYPE)reduce_size) - (mean * mean);                \
-        }                                                                                          \
-    }
-
-/// Macro to implement variance reduction for exotic types
-///
-/// @param TYPE C float type
-/// @param TYPE_SUFFIX Suffix for function naming
-/// @param ZERO Zero constant for the type
-/// @param ADD_FN Addition function
-/// @param MUL_FN Multiplication function
-/// @param DIV_FN Division function
-/// @param SUB_FN Subtraction function
-#define REDUCE_VAR_OP_EXOTIC(TYPE, TYPE_SUFFIX, ZERO, ADD_FN, MUL_FN, DIV_FN, SUB_FN)              \
-    void hodu_cpu_var_##TYPE_SUFFIX(const void *input_ptr, void *output_ptr,                       \
-                                    const size_t *metadata) {                                      \
-        const TYPE *input = (const TYPE *)input_ptr;                                               \
-        TYPE *output = (TYPE *)output_ptr;                                                         \
-                                                                                                   \
-        const size_t num_dims = metadata[0];                                                       \
-        const size_t *dims = metadata + 1;                                                         \
-        const size_t *strides = metadata + 1 + num_dims;                                           \
-        const size_t offset = metadata[1 + 2 * num_dims];                                          \
-        const size_t output_shape_len = metadata[2 + 2 * num_dims];                                \
-        const size_t *output_shape = metadata + 3 + 2 * num_dims;                                  \
-        const size_t num_reduce_dims = metadata[3 + 2 * num_dims + output_shape_len];              \
-        const size_t *reduce_dims = metadata + 4 + 2 * num_dims + output_shape_len;                \
-        const size_t keep_dim_val =                                                                \
-            metadata[4 + 2 * num_dims + output_shape_len + num_reduce_dims];                       \
-        const bool keep_dim = (keep_dim_val != 0);                                                 \
-        const size_t reduce_size =                                                                 \
-            metadata[5 + 2 * num_dims + output_shape_len + num_reduce_dims];                       \
-        size_t num_els = 1;                                                                        \
-        for (size_t i = 0; i < output_shape_len; i++) {                                            \
-            num_els *= output_shape[i];                                                            \
-        }                                                                                          \
-                                                                                                   \
-        for (size_t output_idx = 0; output_idx < num_els; output_idx++) {                          \
-            TYPE sum = ZERO;                                                                       \
-            TYPE sum_squares = ZERO;                                                               \
-                                                                                                   \
-            size_t output_indices[16];                                                             \
-            size_t temp = output_idx;                                                              \
-            for (int d = (int)output_shape_len - 1; d >= 0; d--) {                                 \
-                output_indices[d] = temp % output_shape[d];                                        \
-                temp /= output_shape[d];                                                           \
-            }                                                                                      \
-                                                                                                   \
-            size_t input_indices[16];                                                              \
-            if (keep_dim) {                                                                        \
-                for (size_t i = 0; i < num_dims; i++) {                                            \
-                    input_indices[i] = output_indices[i];                                          \
-                }                                                                                  \
-            } else {                                                                               \
-                size_t out_idx = 0;                                                                \
-                for (size_t in_dim = 0; in_dim < num_dims; in_dim++) {                             \
-                    bool is_reduced = false;                                                       \
-                    for (size_t r = 0; r < num_reduce_dims; r++) {                                 \
-                        if (reduce_dims[r] == in_dim) {                                            \
-                            is_reduced = true;                                                     \
-                            break;                                                                 \
-                        }                                                                          \
-                    }                                                                              \
-                    if (is_reduced) {                                                              \
-                        input_indices[in_dim] = 0;                                                 \
-                    } else {                                                                       \
-                        input_indices[in_dim] =                                                    \
-                            (out_idx < output_shape_len) ? output_indices[out_idx] : 0;            \
-                        out_idx++;                                                                 \
-                    }                                                                              \
-                }                                                                                  \
-            }                                                                                      \
-                                                                                                   \
-            for (size_t reduced_idx = 0; reduced_idx < reduce_size; reduced_idx++) {               \
-                size_t temp_reduced = reduced_idx;                                                 \
-                for (int i = (int)num_reduce_dims - 1; i >= 0; i--) {                              \
-                    size_t dim = reduce_dims[i];                                                   \
-                    input_indices[dim] = temp_reduced % dims[dim];                                 \
-                    temp_reduced /= dims[dim];                                                     \
-                }                                                                                  \
-                                                                                                   \
-                size_t flat_index = offset;                                                        \
-                for (size_t i = 0; i < num_dims; i++) {                                            \
-                    flat_index += input_indices[i] * strides[i];                                   \
-                }                                                                                  \
-                                                                                                   \
-                TYPE val = input[flat_index];                                                      \
-                sum = ADD_FN(sum, val);                                                            \
-                sum_squares = ADD_FN(sum_squares, MUL_FN(val, val));                               \
-            }                                                                                      \
-                                                                                                   \
-            float reduce_size_f = (float)reduce_size;                                              \
-            TYPE reduce_size_typed = float_to_##TYPE_SUFFIX(reduce_size_f);                        \
-            TYPE mean = DIV_FN(sum, reduce_size_typed);                                            \
-            output[output_idx] =                                                                   \
-                SUB_FN(DIV_FN(sum_squares, reduce_size_typed), MUL_FN(mean, mean));                \
-        }                                                                                          \
-    }
-
-REDUCE_VAR_OP_EXOTIC(f8e4m3_t, f8e4m3, F8E4M3_ZERO, f8e4m3_add, f8e4m3_mul, f8e4m3_div, f8e4m3_sub)
-REDUCE_VAR_OP_EXOTIC(f8e5m2_t, f8e5m2, F8E5M2_ZERO, f8e5m2_add, f8e5m2_mul, f8e5m2_div, f8e5m2_sub)
-REDUCE_VAR_OP_EXOTIC(bf16_t, bf16, BF16_ZERO, bf16_add, bf16_mul, bf16_div, bf16_sub)
-REDUCE_VAR_OP_EXOTIC(f16_t, f16, F16_ZERO, f16_add, f16_mul, f16_div, f16_sub)
-
-// SIMD-optimized var_f32 (variance: E[X^2] - E[X]^2)
-void hodu_cpu_var_f32(const void *input_ptr, void *output_ptr, const size_t *metadata) {
-    const f32_t *input = (const f32_t *)input_ptr;
-    f32_t *output = (f32_t *)output_ptr;
-
-    const size_t num_dims = metadata[0];
-    const size_t *dims = metadata + 1;
-    const size_t *strides = metadata + 1 + num_dims;
-    const size_t offset = metadata[1 + 2 * num_dims];
-    const size_t output_shape_len = metadata[2 + 2 * num_dims];
-    const size_t *output_shape = metadata + 3 + 2 * num_dims;
-    const size_t num_reduce_dims = metadata[3 + 2 * num_dims + output_shape_len];
-    const size_t *reduce_dims = metadata + 4 + 2 * num_dims + output_shape_len;
-    const size_t keep_dim_val = metadata[4 + 2 * num_dims + output_shape_len + num_reduce_dims];
-    const bool keep_dim = (keep_dim_val != 0);
-    const size_t reduce_size = metadata[5 + 2 * num_dims + output_shape_len + num_reduce_dims];
-
-    size_t num_els = 1;
-    for (size_t i = 0; i < output_shape_len; i++) {
-        num_els *= output_shape[i];
+/// @param TYPE C float type
+/// @param SFX simd_utils suffix (f32 or f64)
+/// @param WIDTH SIMD width of TYPE
+#define REDUCE_SQDEV_SIMD(TYPE, SFX, WIDTH)                                                        \
+    static inline TYPE reduce_sqdev_##SFX(const TYPE *input, size_t n, TYPE mean, TYPE *dev) {     \
+        size_t i = 0;                                                                              \
+        TYPE acc = 0, sum = 0;                                                                     \
+        if (n >= WIDTH) {                                                                          \
+            const simd_##SFX##_t vmean = simd_##SFX##_set1(mean);                                  \
+            simd_##SFX##_t vacc = simd_##SFX##_set1(0);                                            \
+            simd_##SFX##_t vsum = simd_##SFX##_set1(0);                                            \
+            for (; i + WIDTH <= n; i += WIDTH) {                                                   \
+                const simd_##SFX##_t d = simd_##SFX##_sub(simd_##SFX##_load(input + i), vmean);    \
+                vsum = simd_##SFX##_add(vsum, d);                                                  \
+                vacc = simd_##SFX##_fmadd(d, d, vacc);                                             \
+            }                                                                                      \
+            sum = simd_##SFX##_reduce_add(vsum);                                                   \
+            acc = simd_##SFX##_reduce_add(vacc);                                                   \
+        }                                                                                          \
+        for (; i < n; i++) {                                                                       \
+            const TYPE d = input[i] - mean;                                                        \
+            sum += d;                                                                              \
+            acc += d * d;                                                                          \
+        }                                                                                          \
+        *dev = sum;                                                                                \
+        return acc;                                                                                \
     }
 
-    for (size_t output_idx = 0; output_idx < num_els; output_idx++) {
-        f32_t sum = 0.0f;
-        f32_t sum_squares = 0.0f;
-
-        size_t output_indices[16];
-        size_t temp = output_idx;
-        for (int d = (int)output_shape_len - 1; d >= 0; d--) {
-            output_indices[d] = temp % output_shape[d];
-            temp /= output_shape[d];
-        }
-
-        size_t input_indices[16];
-        if (keep_dim) {
-            for (size_t i = 0; i < num_dims; i++) {
-                input_indices[i] = output_indices[i];
-            }
-        } else {
-            size_t out_idx = 0;
-            for (size_t in_dim = 0; in_dim < num_dims; in_dim++) {
-                bool is_reduced = false;
-                for (size_t r = 0; r < num_reduce_dims; r++) {
-                    if (reduce_dims[r] == in_dim) {
-                        is_reduced = true;
-                        break;
-                    }
-                }
-                if (is_reduced) {
-                    input_indices[in_dim] = 0;
-                } else {
-                    input_indices[in_dim] =
-                        (out_idx < output_shape_len) ? output_indices[out_idx] : 0;
-                    out_idx++;
-                }
-            }
-        }
+/// Macro to implement a scalar sum of deviations and squared deviations from a given mean
+///
+/// @param TYPE C float type
+/// @param SFX Suffix for naming (f32 or f64)
+#define REDUCE_SQDEV_SCALAR(TYPE, SFX)                                                             \
+    static inline TYPE reduce_sqdev_##SFX(const TYPE *input, size_t n, TYPE mean, TYPE *dev) {     \
+        TYPE acc = 0, sum = 0;                                                                     \
+        for (size_t i = 0; i < n; i++) {                                                           \
+            const TYPE d = input[i] - mean;                                                        \
+            sum += d;                                                                              \
+            acc += d * d;                                                                          \
+        }                                                                                          \
+        *dev = sum;                                                                                \
+        return acc;                                                                                \
+    }
 
 #if SIMD_F32_WIDTH > 1
-        bool use_simd = (num_reduce_dims == 1) && (reduce_dims[0] == num_dims - 1) &&
-                        (strides[num_dims - 1] == 1) && (reduce_size >= SIMD_F32_WIDTH);
-
-        if (use_simd) {
-            size_t flat_base = offset;
-            for (size_t i = 0; i < num_dims - 1; i++) {
-                flat_base += input_indices[i] * strides[i];
-            }
-
-            simd_f32_t vsum = simd_f32_set1(0.0f);
-            simd_f32_t vsum_sq = simd_f32_set1(0.0f);
-            const size_t simd_end = (reduce_size / SIMD_F32_WIDTH) * SIMD_F32_WIDTH;
-
-            for (size_t i = 0; i < simd_end; i += SIMD_F32_WIDTH) {
-                simd_f32_t v = simd_f32_load(&input[flat_base + i]);
-                vsum = simd_f32_add(vsum, v);
-                vsum_sq = simd_f32_fmadd(v, v, vsum_sq); // v*v + vsum_sq
-            }
-            sum = simd_f32_reduce_add(vsum);
-            sum_squares = simd_f32_reduce_add(vsum_sq);
-
-            for (size_t i = simd_end; i < reduce_size; i++) {
-                f32_t val = input[flat_base + i];
-                sum += val;
-                sum_squares += val * val;
-            }
-        } else
+REDUCE_SQDEV_SIMD(f32_t, f32, SIMD_F32_WIDTH)
+#else
+REDUCE_SQDEV_SCALAR(f32_t, f32)
 #endif
-        {
-            for (size_t reduced_idx = 0; reduced_idx < reduce_size; reduced_idx++) {
-                size_t temp_reduced = reduced_idx;
-                for (int i = (int)num_reduce_dims - 1; i >= 0; i--) {
-                    size_t dim = reduce_dims[i];
-                    input_indices[dim] = temp_reduced % dims[dim];
-                    temp_reduced /= dims[dim];
-                }
-
-                size_t flat_index = offset;
-                for (size_t i = 0; i < num_dims; i++) {
-                    flat_index += input_indices[i] * strides[i];
-                }
-
-                f32_t val = input[flat_index];
-                sum += val;
-                sum_squares += val * val;
-            }
-        }
-
-        f32_t mean = sum / (f32_t)reduce_size;
-        output[output_idx] = (sum_squares / (f32_t)reduce_size) - (mean * mean);
+#if SIMD_F64_WIDTH > 1
+REDUCE_SQDEV_SIMD(f64_t, f64, SIMD_F64_WIDTH)
+#else
+REDUCE_SQDEV_SCALAR(f64_t, f64)
+#endif
+
+/// Macro to implement the central-moments accumulator (count, mean, M2) for a float type
+///
+/// @param TYPE C float type used for accumulation
+/// @param SFX Suffix for naming (f32 or f64)
+#define REDUCE_MOMENTS_ACC(TYPE, SFX)                                                              \
+    typedef struct {                                                                               \
+        size_t n;   /* Elements seen */                                                            \
+        TYPE shift; /* Offset subtracted from every element (first value seen) */                  \
+        TYPE mean;  /* Mean of the shifted elements seen */                                        \
+        TYPE m2;    /* Sum of squared deviations from the mean */                                  \
+    } reduce_moments_##SFX##_t;                                                                    \
+                                                                                                   \
+    /* Welford update with one element */                                                          \
+    static inline void reduce_moments_##SFX##_push(reduce_moments_##SFX##_t *acc, TYPE x) {        \
+        if (acc->n == 0)                                                                           \
+            acc->shift = x;                                                                        \
+        x -= acc->shift;                                                                           \
+        acc->n++;                                                                                  \
+        const TYPE d = x - acc->mean;                                                              \
+        acc->mean += d / (TYPE)acc->n;                                                             \
+        acc->m2 += d * (x - acc->mean);                                                            \
+    }                                                                                              \
+                                                                                                   \
+    /* Chan et al. merge of two partials */                                                        \
+    static inline void reduce_moments_##SFX##_merge(reduce_moments_##SFX##_t *acc,                 \
+                                                    reduce_moments_##SFX##_t other) {              \
+        if (other.n == 0)                                                                          \
+            return;                                                                                \
+        if (acc->n == 0) {                                                                         \
+            *acc = other;                                                                          \
+            return;                                                                                \
+        }                                                                                          \
+        const TYPE na = (TYPE)acc->n;                                                              \
+        const TYPE nb = (TYPE)other.n;                                                             \
+        const TYPE d = (other.shift - acc->shift) + (other.mean - acc->mean);                      \
+        acc->mean += d * (nb / (na + nb));                                                         \
+        acc->m2 += other.m2 + d * d * (na * nb / (na + nb));                                       \
+        acc->n += other.n;                                                                         \
+    }                                                                                              \
+                                                                                                   \
+    /* Blocked corrected two-pass update with a contiguous run: the rounded block mean becomes */  \
+    /* the shift and the residual mean of the deviations keeps the lost low-order bits */          \
+    static inline void reduce_moments_##SFX##_row(reduce_moments_##SFX##_t *acc,                   \
+                                                  const TYPE *input, size_t n) {                   \
+        for (size_t i = 0; i < n; i += REDUCE_MOMENTS_BLOCK) {                                     \
+            const size_t m = MIN((size_t)REDUCE_MOMENTS_BLOCK, n - i);                             \
+            TYPE sum = 0;                                                                          \
+            reduce_sum_##SFX##_row(&sum, input + i, m, 0, NULL);                                   \
+            reduce_moments_##SFX##_t block = {m, sum / (TYPE)m, 0, 0};                             \
+            TYPE dev;                                                                              \
+            block.m2 = reduce_sqdev_##SFX(input + i, m, block.shift, &dev);                        \
+            block.mean = dev / (TYPE)m;                                                            \
+            block.m2 -= dev * block.mean;                                                          \
+            reduce_moments_##SFX##_merge(acc, block);                                              \
+        }                                                                                          \
+    }                                                                                              \
+                                                                                                   \
+    /* Welford update of n accumulators that have all seen the same number of elements */          \
+    static inline void reduce_moments_##SFX##_lanes(reduce_moments_##SFX##_t *acc,                 \
+                                                    const TYPE *input, size_t n) {                 \
+        if (n == 0)                                                                                \
+            return;                                                                                \
+        if (acc[0].n == 0)                                                                         \
+            for (size_t i = 0; i < n; i++)                                                         \
+                acc[i].shift = input[i];                                                           \
+        const TYPE inv = (TYPE)1 / (TYPE)(acc[0].n + 1);                                           \
+        for (size_t i = 0; i < n; i++) {                                                           \
+            const TYPE x = input[i] - acc[i].shift;                                                \
+            const TYPE d = x - acc[i].mean;                                                        \
+            acc[i].n++;                                                                            \
+            acc[i].mean += d * inv;                                                                \
+            acc[i].m2 += d * (x - acc[i].mean);                                                    \
+        }                                                                                          \
     }
-}
 
-// SIMD-optimized var_f64 (variance: E[X^2] - E[X]^2)
-void hodu_cpu_var_f64(const void *input_ptr, void *output_ptr, const size_t *metadata) {
-    const f64_t *input = (const f64_t *)input_ptr;
-    f64_t *output = (f64_t *)output_ptr;
+REDUCE_MOMENTS_ACC(f32_t, f32)
+REDUCE_MOMENTS_ACC(f64_t, f64)
 
-    const size_t num_dims = metadata[0];
-    const size_t *dims = metadata + 1;
-    const size_t *strides = metadata + 1 + num_dims;
-    const size_t offset = metadata[1 + 2 * num_dims];
-    const size_t output_shape_len = metadata[2 + 2 * num_dims];
-    const size_t *output_shape = metadata + 3 + 2 * num_dims;
-    const size_t num_reduce_dims = metadata[3 + 2 * num_dims + output_shape_len];
-    const size_t *reduce_dims = metadata + 4 + 2 * num_dims + output_shape_len;
-    const size_t keep_dim_val = metadata[4 + 2 * num_dims + output_shape_len + num_reduce_dims];
-    const bool keep_dim = (keep_dim_val != 0);
-    const size_t reduce_size = metadata[5 + 2 * num_dims + output_shape_len + num_reduce_dims];
+/// Macro to implement a central-moments reduction for f32/f64
+///
+/// @param NAME Reduction name (e.g. var_f32)
+/// @param TYPE C float type
+/// @param SFX Moments suffix (f32 or f64)
+/// @param FINAL Expression producing the output value from the moments `acc`
+#define REDUCE_MOMENTS_OP(NAME, TYPE, SFX, FINAL)                                                  \
+    static inline void reduce_##NAME##_row(reduce_moments_##SFX##_t *acc, const TYPE *input,       \
+                                           size_t n, size_t pos, const reduce_plan_t *plan) {      \
+        reduce_moments_##SFX##_row(acc, input, n);                                                 \
+        (void)pos;                                                                                 \
+        (void)plan;                                                                                \
+    }                                                                                              \
+                                                                                                   \
+    static inline void reduce_##NAME##_lanes(reduce_moments_##SFX##_t *acc, const TYPE *input,     \
+                                             size_t n, size_t pos, const reduce_plan_t *plan) {    \
+        reduce_moments_##SFX##_lanes(acc, input, n);                                               \
+        (void)pos;                                                                                 \
+        (void)plan;                                                                                \
+    }                                                                                              \
+                                                                                                   \
+    REDUCE_ENGINE(NAME, TYPE, TYPE, reduce_moments_##SFX##_t, ((reduce_moments_##SFX##_t){0}),     \
+                  reduce_moments_##SFX##_push(&acc, val),                                          \
+                  reduce_moments_##SFX##_merge(&acc, other), FINAL)
+
+/// Macro to implement a central-moments reduction for exotic types (f32 moments)
+///
+/// @param NAME Reduction name (e.g. var_bf16)
+/// @param TYPE C float type
+/// @param TO_FLOAT_FN Conversion to float function
+/// @param FINAL Expression producing the output value from the moments `acc`
+#define REDUCE_MOMENTS_OP_EXOTIC(NAME, TYPE, TO_FLOAT_FN, FINAL)                                   \
+    static inline void reduce_##NAME##_row(reduce_moments_f32_t *acc, const TYPE *input, size_t n, \
+                                           size_t pos, const reduce_plan_t *plan) {                \
+        float buf[REDUCE_MOMENTS_BLOCK];                                                           \
+        for (size_t i = 0; i < n; i += REDUCE_MOMENTS_BLOCK) {                                     \
+            const size_t m = MIN((size_t)REDUCE_MOMENTS_BLOCK, n - i);                             \
+            for (size_t j = 0; j < m; j++) {                                                       \
+                buf[j] = TO_FLOAT_FN(input[i + j]);                                                \
+            }                                                                                      \
+            reduce_moments_f32_row(acc, buf, m);                                                   \
+        }                                                                                          \
+        (void)pos;                                                                                 \
+        (void)plan;                                                                                \
+    }                                                                                              \
+                                                                                                   \
+    static inline void reduce_##NAME##_lanes(reduce_moments_f32_t *acc, const TYPE *input,         \
+                                             size_t n, size_t pos, const reduce_plan_t *plan) {    \
+        float buf[REDUCE_LANE_BLOCK];                                                              \
+        for (size_t i = 0; i < n; i++) {                                                           \
+            buf[i] = TO_FLOAT_FN(input[i]);                                                        \
+        }                                                                                          \
+        reduce_moments_f32_lanes(acc, buf, n);                                                     \
+        (void)pos;                                                                                 \
+        (void)plan;                                                                                \
+    }                                                                                              \
+                                                                                                   \
+    REDUCE_ENGINE(NAME, TYPE, TYPE, reduce_moments_f32_t, ((reduce_moments_f32_t){0}),             \
+                  reduce_moments_f32_push(&acc, TO_FLOAT_FN(val)),                                 \
+                  reduce_moments_f32_merge(&acc, other), FINAL)
 
-    size_t num_els = 1;
-    for (size_t i = 0; i < output_shape_len; i++) {
-        num_els *= output_shape[i];
-    }
+/// Macro to implement variance reduction (float types only)
+///
+/// @param TYPE C float type
+/// @param TYPE_SUFFIX Suffix for function naming
+#define REDUCE_VAR_OP(TYPE, TYPE_SUFFIX)                                                           \
+    REDUCE_MOMENTS_OP(var_##TYPE_SUFFIX, TYPE, TYPE_SUFFIX, acc.m2 / (TYPE)acc.n)
 
-    for (size_t output_idx = 0; output_idx < num_els; output_idx++) {
-        f64_t sum = 0.0;
-        f64_t sum_squares = 0.0;
-
-        size_t output_indices[16];
-        size_t temp = output_idx;
-        for (int d = (int)output_shape_len - 1; d >= 0; d--) {
-            output_indices[d] = temp % output_shape[d];
-            temp /= output_shape[d];
-        }
-
-        size_t input_indices[16];
-        if (keep_dim) {
-            for (size_t i = 0; i < num_dims; i++) {
-                input_indices[i] = output_indices[i];
-            }
-        } else {
-            size_t out_idx = 0;
-            for (size_t in_dim = 0; in_dim < num_dims; in_dim++) {
-                bool is_reduced = false;
-                for (size_t r = 0; r < num_reduce_dims; r++) {
-                    if (reduce_dims[r] == in_dim) {
-                        is_reduced = true;
-                        break;
-                    }
-                }
-                if (is_reduced) {
-                    input_indices[in_dim] = 0;
-                } else {
-                    input_indices[in_dim] =
-                        (out_idx < output_shape_len) ? output_indices[out_idx] : 0;
-                    out_idx++;
-                }
-            }
-        }
+/// Macro to implement standard deviation reduction (float types only)
+///
+/// @param TYPE C float type
+/// @param TYPE_SUFFIX Suffix for function naming
+/// @param SQRT_FN Square root function
+#define REDUCE_STD_OP(TYPE, TYPE_SUFFIX, SQRT_FN)                                                  \
+    REDUCE_MOMENTS_OP(std_##TYPE_SUFFIX, TYPE, TYPE_SUFFIX, SQRT_FN(acc.m2 / (TYPE)acc.n))
 
-#if SIMD_F64_WIDTH > 1
-        bool use_simd = (num_reduce_dims == 1) && (reduce_dims[0] == num_dims - 1) &&
-                        (strides[num_dims - 1] == 1) && (reduce_size >= SIMD_F64_WIDTH);
-
-        if (use_simd) {
-            size_t flat_base = offset;
-            for (size_t i = 0; i < num_dims - 1; i++) {
-                flat_base += input_indices[i] * strides[i];
-            }
-
-            simd_f64_t vsum = simd_f64_set1(0.0);
-            simd_f64_t vsum_sq = simd_f64_set1(0.0);
-            const size_t simd_end = (reduce_size / SIMD_F64_WIDTH) * SIMD_F64_WIDTH;
-
-            for (size_t i = 0; i < simd_end; i += SIMD_F64_WIDTH) {
-                simd_f64_t v = simd_f64_load(&input[flat_base + i]);
-                vsum = simd_f64_add(vsum, v);
-                vsum_sq = simd_f64_fmadd(v, v, vsum_sq); // v*v + vsum_sq
-            }
-            sum = simd_f64_reduce_add(vsum);
-            sum_squares = simd_f64_reduce_add(vsum_sq);
-
-            for (size_t i = simd_end; i < reduce_size; i++) {
-                f64_t val = input[flat_base + i];
-                sum += val;
-                sum_squares += val * val;
-            }
-        } else
-#endif
-        {
-            for (size_t reduced_idx = 0; reduced_idx < reduce_size; reduced_idx++) {
-                size_t temp_reduced = reduced_idx;
-                for (int i = (int)num_reduce_dims - 1; i >= 0; i--) {
-                    size_t dim = reduce_dims[i];
-                    input_indices[dim] = temp_reduced % dims[dim];
-                    temp_reduced /= dims[dim];
-                }
-
-                size_t flat_index = offset;
-                for (size_t i = 0; i < num_dims; i++) {
-                    flat_index += input_indices[i] * strides[i];
-                }
-
-                f64_t val = input[flat_index];
-                sum += val;
-                sum_squares += val * val;
-            }
-        }
-
-        f64_t mean = sum / (f64_t)reduce_size;
-        output[output_idx] = (sum_squares / (f64_t)reduce_size) - (mean * mean);
-    }
-}
+/// Macro to implement variance reduction for exotic types
+///
+/// @param TYPE C float type
+/// @param TYPE_SUFFIX Suffix for function naming
+/// @param TO_FLOAT_FN Conversion to float function
+/// @param FROM_FLOAT_FN Conversion from float function
+#define REDUCE_VAR_OP_EXOTIC(TYPE, TYPE_SUFFIX, TO_FLOAT_FN, FROM_FLOAT_FN)                        \
+    REDUCE_MOMENTS_OP_EXOTIC(var_##TYPE_SUFFIX, TYPE, TO_FLOAT_FN,                                 \
+                             FROM_FLOAT_FN(acc.m2 / (float)acc.n))
+
+/// Macro to implement standard deviation reduction for exotic types
+///
+/// @param TYPE C float type
+/// @param TYPE_SUFFIX Suffix for function naming
+/// @param TO_FLOAT_FN Conversion to float function
+/// @param FROM_FLOAT_FN Conversion from float function
+#define REDUCE_STD_OP_EXOTIC(TYPE, TYPE_SUFFIX, TO_FLOAT_FN, FROM_FLOAT_FN)                        \
+    REDUCE_MOMENTS_OP_EXOTIC(std_##TYPE_SUFFIX, TYPE, TO_FLOAT_FN,                                 \
+                             FROM_FLOAT_FN(sqrtf(acc.m2 / (float)acc.n)))
+
+REDUCE_STD_OP_EXOTIC(f8e4m3_t, f8e4m3, f8e4m3_to_float, float_to_f8e4m3)
+REDUCE_STD_OP_EXOTIC(f8e5m2_t, f8e5m2, f8e5m2_to_float, float_to_f8e5m2)
+REDUCE_STD_OP_EXOTIC(bf16_t, bf16, bf16_to_float, float_to_bf16)
+REDUCE_STD_OP_EXOTIC(f16_t, f16, f16_to_float, float_to_f16)
+REDUCE_STD_OP(f32_t, f32, sqrtf)
+REDUCE_STD_OP(f64_t, f64, sqrt)
+
+REDUCE_VAR_OP_EXOTIC(f8e4m3_t, f8e4m3, f8e4m3_to_float, float_to_f8e4m3)
+REDUCE_VAR_OP_EXOTIC(f8e5m2_t, f8e5m2, f8e5m2_to_float, float_to_f8e5m2)
+REDUCE_VAR_OP_EXOTIC(bf16_t, bf16, bf16_to_float, float_to_bf16)
+REDUCE_VAR_OP_EXOTIC(f16_t, f16, f16_to_float, float_to_f16)
+REDUCE_VAR_OP(f32_t, f32)
+REDUCE_VAR_OP(f64_t, f64)
 
 // ============================================================================
 // MEAN REDUCTION
 // ============================================================================
 //
-// Computes arithmetic mean by calling sum and dividing by reduce_size.
+// Computes arithmetic mean by calling sum and dividing by reduce_size. Exotic types divide the
+// f32 sum before rounding once to the storage type.
 //
 // Metadata layout: Same as generic reduction operations
 
@@ -1452,6 +956,7 @@ void hodu_cpu_var_f64(const void *input_ptr, void *output_ptr, const size_t *met
 #define REDUCE_MEAN_OP(TYPE, TYPE_SUFFIX)                                                          \
     void hodu_cpu_mean_##TYPE_SUFFIX(const void *input_ptr, void *output_ptr,                      \
                                      const size_t *metadata) {                                     \
+        HODU_PROFILE_KERNEL(reduce_profile_bytes(metadata, sizeof(TYPE), sizeof(TYPE)));           \
         const size_t num_dims = metadata[0];                                                       \
         const size_t output_shape_len = metadata[2 + 2 * num_dims];                                \
         const size_t *output_shape = metadata + 3 + 2 * num_dims;                                  \
@@ -1469,37 +974,18 @@ void hodu_cpu_var_f64(const void *input_ptr, void *output_ptr, const size_t *met
         }                                                                                          \
     }
 
-/// Macro to implement mean reduction for exotic types
+/// Macro to implement mean reduction for exotic types (f32 accumulation, one final rounding)
 ///
 /// @param TYPE C float type
 /// @param TYPE_SUFFIX Suffix for function naming
-/// @param DIV_FN Division function
-#define REDUCE_MEAN_OP_EXOTIC(TYPE, TYPE_SUFFIX, DIV_FN)                                           \
-    void hodu_cpu_mean_##TYPE_SUFFIX(const void *input_ptr, void *output_ptr,                      \
-                                     const size_t *metadata) {                                     \
-        const size_t num_dims = metadata[0];                                                       \
-        const size_t output_shape_len = metadata[2 + 2 * num_dims];                                \
-        const size_t *output_shape = metadata + 3 + 2 * num_dims;                                  \
-        const size_t num_reduce_dims = metadata[3 + 2 * num_dims + output_shape_len];              \
-        const size_t reduce_size =                                                                 \
-            metadata[5 + 2 * num_dims + output_shape_len + num_reduce_dims];                       \
-        size_t num_els = 1;                                                                        \
-        for (size_t i = 0; i < output_shape_len; i++) {                                            \
-            num_els *= output_shape[i];                                                            \
-        }                                                                                          \
-        hodu_cpu_sum_##TYPE_SUFFIX(input_ptr, output_ptr, metadata);                               \
-        TYPE *output = (TYPE *)output_ptr;                                                         \
-        float reduce_size_f = (float)reduce_size;                                                  \
-        TYPE reduce_size_typed = float_to_##TYPE_SUFFIX(reduce_size_f);                            \
-        for (size_t i = 0; i < num_els; i++) {                                                     \
-            output[i] = DIV_FN(output[i], reduce_size_typed);                                      \
-        }                                                                                          \
-    }
-
-REDUCE_MEAN_OP_EXOTIC(f8e4m3_t, f8e4m3, f8e4m3_div)
-REDUCE_MEAN_OP_EXOTIC(f8e5m2_t, f8e5m2, f8e5m2_div)
-REDUCE_MEAN_OP_EXOTIC(bf16_t, bf16, bf16_div)
-REDUCE_MEAN_OP_EXOTIC(f16_t, f16, f16_div)
+#define REDUCE_MEAN_OP_EXOTIC(TYPE, TYPE_SUFFIX)                                                   \
+    REDUCE_WIDEN_OP(mean_##TYPE_SUFFIX, TYPE, TYPE_SUFFIX, sum_f32, 0,                             \
+                    float_to_##TYPE_SUFFIX(acc.sum / (float)plan->reduce_size))
+
+REDUCE_MEAN_OP_EXOTIC(f8e4m3_t, f8e4m3)
+REDUCE_MEAN_OP_EXOTIC(f8e5m2_t, f8e5m2)
+REDUCE_MEAN_OP_EXOTIC(bf16_t, bf16)
+REDUCE_MEAN_OP_EXOTIC(f16_t, f16)
 REDUCE_MEAN_OP(f32_t, f32)
 REDUCE_MEAN_OP(f64_t, f64)
 
@@ -1511,392 +997,32 @@ REDUCE_MEAN_OP(f64_t, f64)
 //
 // Metadata layout: Same as generic reduction operations
 
-/// Macro to implement L2 norm reduction (float types only)
+/// Macro to implement L2 norm reduction for f32/f64 (SIMD hooks where available)
 ///
 /// @param TYPE C float type
 /// @param TYPE_SUFFIX Suffix for function naming
-#define REDUCE_NORM_OP(TYPE, TYPE_SUFFIX)                                                          \
-    void hodu_cpu_norm_##TYPE_SUFFIX(const void *input_ptr, void *output_ptr,                      \
-                                     const size_t *metadata) {                                     \
-        const TYPE *input = (const TYPE *)input_ptr;                                               \
-        TYPE *output = (TYPE *)output_ptr;                                                         \
-                                                                                                   \
-        const size_t num_dims = metadata[0];                                                       \
-        const size_t *dims = metadata + 1;                                                         \
-        const size_t *strides = metadata + 1 + num_dims;                                           \
-        const size_t offset = metadata[1 + 2 * num_dims];                                          \
-        const size_t output_shape_len = metadata[2 + 2 * num_dims];                                \
-        const size_t *output_shape = metadata + 3 + 2 * num_dims;                                  \
-        const size_t num_reduce_dims = metadata[3 + 2 * num_dims + output_shape_len];              \
-        const size_t *reduce_dims = metadata + 4 + 2 * num_dims + output_shape_len;                \
-        const size_t keep_dim_val =                                                                \
-            metadata[4 + 2 * num_dims + output_shape_len + num_reduce_dims];                       \
-        const bool keep_dim = (keep_dim_val != 0);                                                 \
-        const size_t reduce_size =                                                                 \
-            metadata[5 + 2 * num_dims + output_shape_len + num_reduce_dims];                       \
-        size_t num_els = 1;                                                                        \
-        for (size_t i = 0; i < output_shape_len; i++) {                                            \
-            num_els *= output_shape[i];                                                            \
-        }                                                                                          \
-                                                                                                   \
-        for (size_t output_idx = 0; output_idx < num_els; output_idx++) {                          \
-            TYPE sum_squares = 0;                                                                  \
-                                                                                                   \
-            size_t output_indices[16];                                                             \
-            size_t temp = output_idx;                                                              \
-            for (int d = (int)output_shape_len - 1; d >= 0; d--) {                                 \
-                output_indices[d] = temp % output_shape[d];                                        \
-                temp /= output_shape[d];                                                           \
-            }                                                                                      \
-                                                                                                   \
-            size_t input_indices[16];                                                              \
-            if (keep_dim) {                                                                        \
-                for (size_t i = 0; i < num_dims; i++) {                                            \
-                    input_indices[i] = output_indices[i];                                          \
-                }                                                                                  \
-            } else {                                                                               \
-                size_t out_idx = 0;                                                                \
-                for (size_t in_dim = 0; in_dim < num_dims; in_dim++) {                             \
-                    bool is_reduced = false;                                                       \
-                    for (size_t r = 0; r < num_reduce_dims; r++) {                                 \
-                        if (reduce_dims[r] == in_dim) {                                            \
-                            is_reduced = true;                                                     \
-                            break;                                                                 \
-                        }                                                                          \
-                    }                                                                              \
-                    if (is_reduced) {                                                              \
-                        input_indices[in_dim] = 0;                                                 \
-                    } else {                                                                       \
-                        input_indices[in_dim] =                                                    \
-                            (out_idx < output_shape_len) ? output_indices[out_idx] : 0;            \
-                        out_idx++;                                                                 \
-                    }                                                                              \
-                }                                                                                  \
-            }                                                                                      \
-                                                                                                   \
-            for (size_t reduced_idx = 0; reduced_idx < reduce_size; reduced_idx++) {               \
-                size_t temp_reduced = reduced_idx;                                                 \
-                for (int i = (int)num_reduce_dims - 1; i >= 0; i--) {                              \
-                    size_t dim = reduce_dims[i];                                                   \
-                    input_indices[dim] = temp_reduced % dims[dim];                                 \
-                    temp_reduced /= dims[dim];                                                     \
-                }                                                                                  \
-                                                                                                   \
-                size_t flat_index = offset;                                                        \
-                for (size_t i = 0; i < num_dims; i++) {                                            \
-                    flat_index += input_indices[i] * strides[i];                                   \
-                }                                                                                  \
-                                                                                                   \
-                TYPE val = input[flat_index];                                                      \
-                sum_squares += val * val;                                                          \
-            }                                                                                      \
-                                                                                                   \
-            output[output_idx] = (TYPE)sqrt((float)sum_squares);                                   \
-        }                                                                                          \
-    }
+/// @param HOOKS REDUCE_F32_HOOKS or REDUCE_F64_HOOKS
+/// @param SQRT_FN Square root function
+#define REDUCE_NORM_OP(TYPE, TYPE_SUFFIX, HOOKS, SQRT_FN)                                          \
+    HOOKS(norm_##TYPE_SUFFIX, 0, add, reduce_add, REDUCE_ADD, 1)                                   \
+    REDUCE_ENGINE(norm_##TYPE_SUFFIX, TYPE, TYPE, TYPE, 0, acc += val * val, acc += other,         \
+                  SQRT_FN(acc))
 
-/// Macro to implement L2 norm reduction for exotic types
+REDUCE_NORM_OP(f32_t, f32, REDUCE_F32_HOOKS, sqrtf)
+REDUCE_NORM_OP(f64_t, f64, REDUCE_F64_HOOKS, sqrt)
+
+/// Macro to implement L2 norm reduction for exotic types (f32 accumulation, one final rounding)
 ///
 /// @param TYPE C float type
 /// @param TYPE_SUFFIX Suffix for function naming
-/// @param ZERO Zero constant for the type
-/// @param ADD_FN Addition function
-/// @param MUL_FN Multiplication function
-/// @param SQRT_FN Square root function
-#define REDUCE_NORM_OP_EXOTIC(TYPE, TYPE_SUFFIX, ZERO, ADD_FN, MUL_FN, SQRT_FN)                    \
-    void hodu_cpu_norm_##TYPE_SUFFIX(const void *input_ptr, void *output_ptr,                      \
-                                     const size_t *metadata) {                                     \
-        const TYPE *input = (const TYPE *)input_ptr;                                               \
-        TYPE *output = (TYPE *)output_ptr;                                                         \
-                                                                                                   \
-        const size_t num_dims = metadata[0];                                                       \
-        const size_t *dims = metadata + 1;                                                         \
-        const size_t *strides = metadata + 1 + num_dims;                                           \
-        const size_t offset = metadata[1 + 2 * num_dims];                                          \
-        const size_t output_shape_len = metadata[2 + 2 * num_dims];                                \
-        const size_t *output_shape = metadata + 3 + 2 * num_dims;                                  \
-        const size_t num_reduce_dims = metadata[3 + 2 * num_dims + output_shape_len];              \
-        const size_t *reduce_dims = metadata + 4 + 2 * num_dims + output_shape_len;                \
-        const size_t keep_dim_val =                                                                \
-            metadata[4 + 2 * num_dims + output_shape_len + num_reduce_dims];                       \
-        const bool keep_dim = (keep_dim_val != 0);                                                 \
-        const size_t reduce_size =                                                                 \
-            metadata[5 + 2 * num_dims + output_shape_len + num_reduce_dims];                       \
-        size_t num_els = 1;                                                                        \
-        for (size_t i = 0; i < output_shape_len; i++) {                                            \
-            num_els *= output_shape[i];                                                            \
-        }                                                                                          \
-                                                                                                   \
-        for (size_t output_idx = 0; output_idx < num_els; output_idx++) {                          \
-            TYPE sum_squares = ZERO;                                                               \
-                                                                                                   \
-            size_t output_indices[16];                                                             \
-            size_t temp = output_idx;                                                              \
-            for (int d = (int)output_shape_len - 1; d >= 0; d--) {                                 \
-                output_indices[d] = temp % output_shape[d];                                        \
-                temp /= output_shape[d];                                                           \
-            }                                                                                      \
-                                                                                                   \
-            size_t input_indices[16];                                                              \
-            if (keep_dim) {                                                                        \
-                for (size_t i = 0; i < num_dims; i++) {                                            \
-                    input_indices[i] = output_indices[i];                                          \
-                }                                                                                  \
-            } else {                                                                               \
-                size_t out_idx = 0;                                                                \
-                for (size_t in_dim = 0; in_dim < num_dims; in_dim++) {                             \
-                    bool is_reduced = false;                                                       \
-                    for (size_t r = 0; r < num_reduce_dims; r++) {                                 \
-                        if (reduce_dims[r] == in_dim) {                                            \
-                            is_reduced = true;                                                     \
-                            break;                                                                 \
-                        }                                                                          \
-                    }                                                                              \
-                    if (is_reduced) {                                                              \
-                        input_indices[in_dim] = 0;                                                 \
-                    } else {                                                                       \
-                        input_indices[in_dim] =                                                    \
-                            (out_idx < output_shape_len) ? output_indices[out_idx] : 0;            \
-                        out_idx++;                                                                 \
-                    }                                                                              \
-                }                                                                                  \
-            }                                                                                      \
-                                                                                                   \
-            for (size_t reduced_idx = 0; reduced_idx < reduce_size; reduced_idx++) {               \
-                size_t temp_reduced = reduced_idx;                                                 \
-                for (int i = (int)num_reduce_dims - 1; i >= 0; i--) {                              \
-                    size_t dim = reduce_dims[i];                                                   \
-                    input_indices[dim] = temp_reduced % dims[dim];                                 \
-                    temp_reduced /= dims[dim];                                                     \
-                }                                                                                  \
-                                                                                                   \
-                size_t flat_index = offset;                                                        \
-                for (size_t i = 0; i < num_dims; i++) {                                            \
-                    flat_index += input_indices[i] * strides[i];                                   \
-                }                                                                                  \
-                                                                                                   \
-                TYPE val = input[flat_index];                                                      \
-                sum_squares = ADD_FN(sum_squares, MUL_FN(val, val));                               \
-            }                                                                                      \
-                                                                                                   \
-            output[output_idx] = SQRT_FN(sum_squares);                                             \
-        }                                                                                          \
-    }
-
-REDUCE_NORM_OP_EXOTIC(f8e4m3_t, f8e4m3, F8E4M3_ZERO, f8e4m3_add, f8e4m3_mul, f8e4m3_sqrt)
-REDUCE_NORM_OP_EXOTIC(f8e5m2_t, f8e5m2, F8E5M2_ZERO, f8e5m2_add, f8e5m2_mul, f8e5m2_sqrt)
-REDUCE_NORM_OP_EXOTIC(bf16_t, bf16, BF16_ZERO, bf16_add, bf16_mul, bf16_sqrt)
-REDUCE_NORM_OP_EXOTIC(f16_t, f16, F16_ZERO, f16_add, f16_mul, f16_sqrt)
-
-// SIMD-optimized norm_f32 (L2 norm: sqrt(sum(x^2)))
-void hodu_cpu_norm_f32(const void *input_ptr, void *output_ptr, const size_t *metadata) {
-    const f32_t *input = (const f32_t *)input_ptr;
-    f32_t *output = (f32_t *)output_ptr;
-
-    const size_t num_dims = metadata[0];
-    const size_t *dims = metadata + 1;
-    const size_t *strides = metadata + 1 + num_dims;
-    const size_t offset = metadata[1 + 2 * num_dims];
-    const size_t output_shape_len = metadata[2 + 2 * num_dims];
-    const size_t *output_shape = metadata + 3 + 2 * num_dims;
-    const size_t num_reduce_dims = metadata[3 + 2 * num_dims + output_shape_len];
-    const size_t *reduce_dims = metadata + 4 + 2 * num_dims + output_shape_len;
-    const size_t keep_dim_val = metadata[4 + 2 * num_dims + output_shape_len + num_reduce_dims];
-    const bool keep_dim = (keep_dim_val != 0);
-    const size_t reduce_size = metadata[5 + 2 * num_dims + output_shape_len + num_reduce_dims];
-
-    size_t num_els = 1;
-    for (size_t i = 0; i < output_shape_len; i++) {
-        num_els *= output_shape[i];
-    }
-
-    for (size_t output_idx = 0; output_idx < num_els; output_idx++) {
-        f32_t sum_squares = 0.0f;
-
-        size_t output_indices[16];
-        size_t temp = output_idx;
-        for (int d = (int)output_shape_len - 1; d >= 0; d--) {
-            output_indices[d] = temp % output_shape[d];
-            temp /= output_shape[d];
-        }
-
-        size_t input_indices[16];
-        if (keep_dim) {
-            for (size_t i = 0; i < num_dims; i++) {
-                input_indices[i] = output_indices[i];
-            }
-        } else {
-            size_t out_idx = 0;
-            for (size_t in_dim = 0; in_dim < num_dims; in_dim++) {
-                bool is_reduced = false;
-                for (size_t r = 0; r < num_reduce_dims; r++) {
-                    if (reduce_dims[r] == in_dim) {
-                        is_reduced = true;
-                        break;
-                    }
-                }
-                if (is_reduced) {
-                    input_indices[in_dim] = 0;
-                } else {
-                    input_indices[in_dim] =
-                        (out_idx < output_shape_len) ? output_indices[out_idx] : 0;
-                    out_idx++;
-                }
-            }
-        }
-
-#if SIMD_F32_WIDTH > 1
-        bool use_simd = (num_reduce_dims == 1) && (reduce_dims[0] == num_dims - 1) &&
-                        (strides[num_dims - 1] == 1) && (reduce_size >= SIMD_F32_WIDTH);
-
-        if (use_simd) {
-            size_t flat_base = offset;
-            for (size_t i = 0; i < num_dims - 1; i++) {
-                flat_base += input_indices[i] * strides[i];
-            }
-
-            simd_f32_t vsum_sq = simd_f32_set1(0.0f);
-            const size_t simd_end = (reduce_size / SIMD_F32_WIDTH) * SIMD_F32_WIDTH;
-
-            for (size_t i = 0; i < simd_end; i += SIMD_F32_WIDTH) {
-                simd_f32_t v = simd_f32_load(&input[flat_base + i]);
-                vsum_sq = simd_f32_fmadd(v, v, vsum_sq); // v*v + vsum_sq
-            }
-            sum_squares = simd_f32_reduce_add(vsum_sq);
-
-            for (size_t i = simd_end; i < reduce_size; i++) {
-                f32_t val = input[flat_base + i];
-                sum_squares += val * val;
-            }
-        } else
-#endif
-        {
-            for (size_t reduced_idx = 0; reduced_idx < reduce_size; reduced_idx++) {
-                size_t temp_reduced = reduced_idx;
-                for (int i = (int)num_reduce_dims - 1; i >= 0; i--) {
-                    size_t dim = reduce_dims[i];
-                    input_indices[dim] = temp_reduced % dims[dim];
-                    temp_reduced /= dims[dim];
-                }
-
-                size_t flat_index = offset;
-                for (size_t i = 0; i < num_dims; i++) {
-                    flat_index += input_indices[i] * strides[i];
-                }
-
-                f32_t val = input[flat_index];
-                sum_squares += val * val;
-            }
-        }
-
-        output[output_idx] = sqrtf(sum_squares);
-    }
-}
-
-// SIMD-optimized norm_f64 (L2 norm: sqrt(sum(x^2)))
-void hodu_cpu_norm_f64(const void *input_ptr, void *output_ptr, const size_t *metadata) {
-    const f64_t *input = (const f64_t *)input_ptr;
-    f64_t *output = (f64_t *)output_ptr;
-
-    const size_t num_dims = metadata[0];
-    const size_t *dims = metadata + 1;
-    const size_t *strides = metadata + 1 + num_dims;
-    const size_t offset = metadata[1 + 2 * num_dims];
-    const size_t output_shape_len = metadata[2 + 2 * num_dims];
-    const size_t *output_shape = metadata + 3 + 2 * num_dims;
-    const size_t num_reduce_dims = metadata[3 + 2 * num_dims + output_shape_len];
-    const size_t *reduce_dims = metadata + 4 + 2 * num_dims + output_shape_len;
-    const size_t keep_dim_val = metadata[4 + 2 * num_dims + output_shape_len + num_reduce_dims];
-    const bool keep_dim = (keep_dim_val != 0);
-    const size_t reduce_size = metadata[5 + 2 * num_dims + output_shape_len + num_reduce_dims];
-
-    size_t num_els = 1;
-    for (size_t i = 0; i < output_shape_len; i++) {
-        num_els *= output_shape[i];
-    }
-
-    for (size_t output_idx = 0; output_idx < num_els; output_idx++) {
-        f64_t sum_squares = 0.0;
-
-        size_t output_indices[16];
-        size_t temp = output_idx;
-        for (int d = (int)output_shape_len - 1; d >= 0; d--) {
-            output_indices[d] = temp % output_shape[d];
-            temp /= output_shape[d];
-        }
-
-        size_t input_indices[16];
-        if (keep_dim) {
-            for (size_t i = 0; i < num_dims; i++) {
-                input_indices[i] = output_indices[i];
-            }
-        } else {
-            size_t out_idx = 0;
-            for (size_t in_dim = 0; in_dim < num_dims; in_dim++) {
-                bool is_reduced = false;
-                for (size_t r = 0; r < num_reduce_dims; r++) {
-                    if (reduce_dims[r] == in_dim) {
-                        is_reduced = true;
-                        break;
-                    }
-                }
-                if (is_reduced) {
-                    input_indices[in_dim] = 0;
-                } else {
-                    input_indices[in_dim] =
-                        (out_idx < output_shape_len) ? output_indices[out_idx] : 0;
-                    out_idx++;
-                }
-            }
-        }
+#define REDUCE_NORM_OP_EXOTIC(TYPE, TYPE_SUFFIX)                                                   \
+    REDUCE_WIDEN_OP(norm_##TYPE_SUFFIX, TYPE, TYPE_SUFFIX, norm_f32, 1,                            \
+                    float_to_##TYPE_SUFFIX(sqrtf(acc.sum)))
 
-#if SIMD_F64_WIDTH > 1
-        bool use_simd = (num_reduce_dims == 1) && (reduce_dims[0] == num_dims - 1) &&
-                        (strides[num_dims - 1] == 1) && (reduce_size >= SIMD_F64_WIDTH);
-
-        if (use_simd) {
-            size_t flat_base = offset;
-            for (size_t i = 0; i < num_dims - 1; i++) {
-                flat_base += input_indices[i] * strides[i];
-            }
-
-            simd_f64_t vsum_sq = simd_f64_set1(0.0);
-            const size_t simd_end = (reduce_size / SIMD_F64_WIDTH) * SIMD_F64_WIDTH;
-
-            for (size_t i = 0; i < simd_end; i += SIMD_F64_WIDTH) {
-                simd_f64_t v = simd_f64_load(&input[flat_base + i]);
-                vsum_sq = simd_f64_fmadd(v, v, vsum_sq); // v*v + vsum_sq
-            }
-            sum_squares = simd_f64_reduce_add(vsum_sq);
-
-            for (size_t i = simd_end; i < reduce_size; i++) {
-                f64_t val = input[flat_base + i];
-                sum_squares += val * val;
-            }
-        } else
-#endif
-        {
-            for (size_t reduced_idx = 0; reduced_idx < reduce_size; reduced_idx++) {
-                size_t temp_reduced = reduced_idx;
-                for (int i = (int)num_reduce_dims - 1; i >= 0; i--) {
-                    size_t dim = reduce_dims[i];
-                    input_indices[dim] = temp_reduced % dims[dim];
-                    temp_reduced /= dims[dim];
-                }
-
-                size_t flat_index = offset;
-                for (size_t i = 0; i < num_dims; i++) {
-                    flat_index += input_indices[i] * strides[i];
-                }
-
-                f64_t val = input[flat_index];
-                sum_squares += val * val;
-            }
-        }
-
-        output[output_idx] = sqrt(sum_squares);
-    }
-}
+REDUCE_NORM_OP_EXOTIC(f8e4m3_t, f8e4m3)
+REDUCE_NORM_OP_EXOTIC(f8e5m2_t, f8e5m2)
+REDUCE_NORM_OP_EXOTIC(bf16_t, bf16)
+REDUCE_NORM_OP_EXOTIC(f16_t, f16)
 
 // ============================================================================
 // LOGSUM REDUCTION
@@ -1916,6 +1042,7 @@ void hodu_cpu_norm_f64(const void *input_ptr, void *output_ptr, const size_t *me
 #define REDUCE_LOGSUM_OP_EXOTIC(TYPE, TYPE_SUFFIX, TO_FLOAT_FN, FROM_FLOAT_FN)                     \
     void hodu_cpu_logsum_##TYPE_SUFFIX(const void *input_ptr, void *output_ptr,                    \
                                        const size_t *metadata) {                                   \
+        HODU_PROFILE_KERNEL(reduce_profile_bytes(metadata, sizeof(TYPE), sizeof(TYPE)));           \
         const size_t num_dims = metadata[0];                                                       \
         const size_t output_shape_len = metadata[2 + 2 * num_dims];                                \
         const size_t *output_shape = metadata + 3 + 2 * num_dims;                                  \
@@ -1938,6 +1065,7 @@ void hodu_cpu_norm_f64(const void *input_ptr, void *output_ptr, const size_t *me
 #define REDUCE_LOGSUM_OP(TYPE, TYPE_SUFFIX)                                                        \
     void hodu_cpu_logsum_##TYPE_SUFFIX(const void *input_ptr, void *output_ptr,                    \
                                        const size_t *metadata) {                                   \
+        HODU_PROFILE_KERNEL(reduce_profile_bytes(metadata, sizeof(TYPE), sizeof(TYPE)));           \
         const size_t num_dims = metadata[0];                                                       \
         const size_t output_shape_len = metadata[2 + 2 * num_dims];                                \
         const size_t *output_shape = metadata + 3 + 2 * num_dims;                                  \
@@ -1964,324 +1092,261 @@ REDUCE_LOGSUM_OP(f64_t, f64)
 // ============================================================================
 //
 // Computes log(sum(exp(X))) along specified dimensions.
-// Uses the numerically stable formula: max(X) + log(sum(exp(X - max(X))))
+// Uses the numerically stable formula max(X) + log(sum(exp(X - max(X)))) in a single pass:
+// the accumulator keeps the running max and rescales the running sum when the max grows.
 //
 // Metadata layout: Same as generic reduction operations
 
-/// Macro to implement logsumexp reduction for exotic types (via float conversion)
-///
-/// @param TYPE C float type
-/// @param TYPE_SUFFIX Suffix for function naming
-/// @param TO_FLOAT_FN Conversion to float function
-/// @param FROM_FLOAT_FN Conversion from float function
-#define REDUCE_LOGSUMEXP_OP_EXOTIC(TYPE, TYPE_SUFFIX, TO_FLOAT_FN, FROM_FLOAT_FN)                  \
-    void hodu_cpu_logsumexp_##TYPE_SUFFIX(const void *input_ptr, void *output_ptr,                 \
-                                          const size_t *metadata) {                                \
-        const TYPE *input = (const TYPE *)input_ptr;                                               \
-        TYPE *output = (TYPE *)output_ptr;                                                         \
-                                                                                                   \
-        const size_t num_dims = metadata[0];                                                       \
-        const size_t *dims = metadata + 1;                                                         \
-        const size_t *strides = metadata + 1 + num_dims;                                           \
-        const size_t offset = metadata[1 + 2 * num_dims];                                          \
-        const size_t output_shape_len = metadata[2 + 2 * num_dims];                                \
-        const size_t *output_shape = metadata + 3 + 2 * num_dims;                                  \
-        const size_t num_reduce_dims = metadata[3 + 2 * num_dims + output_shape_len];              \
-        const size_t *reduce_dims = metadata + 4 + 2 * num_dims + output_shape_len;                \
-        const size_t keep_dim_val =                                                                \
-            metadata[4 + 2 * num_dims + output_shape_len + num_reduce_dims];                       \
-        const bool keep_dim = (keep_dim_val != 0);                                                 \
-        const size_t reduce_size =                                                                 \
-            metadata[5 + 2 * num_dims + output_shape_len + num_reduce_dims];                       \
-                                                                                                   \
-        size_t num_els = 1;                                                                        \
-        for (size_t i = 0; i < output_shape_len; i++) {                                            \
-            num_els *= output_shape[i];                                                            \
-        }                                                                                          \
-                                                                                                   \
-        for (size_t output_idx = 0; output_idx < num_els; output_idx++) {                          \
-            size_t output_indices[16];                                                             \
-            size_t temp = output_idx;                                                              \
-            for (int d = (int)output_shape_len - 1; d >= 0; d--) {                                 \
-                output_indices[d] = temp % output_shape[d];                                        \
-                temp /= output_shape[d];                                                           \
-            }                                                                                      \
-                                                                                                   \
-            size_t input_indices[16];                                                              \
-            if (keep_dim) {                                                                        \
-                for (size_t i = 0; i < num_dims; i++) {                                            \
-                    input_indices[i] = output_indices[i];                                          \
-                }                                                                                  \
-            } else {                                                                               \
-                size_t out_idx = 0;                                                                \
-                for (size_t in_dim = 0; in_dim < num_dims; in_dim++) {                             \
-                    bool is_reduced = false;                                                       \
-                    for (size_t r = 0; r < num_reduce_dims; r++) {                                 \
-                        if (reduce_dims[r] == in_dim) {                                            \
-                            is_reduced = true;                                                     \
-                            break;                                                                 \
-                        }                                                                          \
-                    }                                                                              \
-                    if (is_reduced) {                                                              \
-                        input_indices[in_dim] = 0;                                                 \
-                    } else {                                                                       \
-                        input_indices[in_dim] =                                                    \
-                            (out_idx < output_shape_len) ? output_indices[out_idx] : 0;            \
-                        out_idx++;                                                                 \
-                    }                                                                              \
-                }                                                                                  \
-            }                                                                                      \
-                                                                                                   \
-            /* First pass: find max */                                                             \
-            float max_val = -FLT_MAX;                                                              \
-            for (size_t reduced_idx = 0; reduced_idx < reduce_size; reduced_idx++) {               \
-                size_t temp_reduced = reduced_idx;                                                 \
-                for (int i = (int)num_reduce_dims - 1; i >= 0; i--) {                              \
-                    size_t dim = reduce_dims[i];                                                   \
-                    input_indices[dim] = temp_reduced % dims[dim];                                 \
-                    temp_reduced /= dims[dim];                                                     \
-                }                                                                                  \
-                size_t flat_index = offset;                                                        \
-                for (size_t i = 0; i < num_dims; i++) {                                            \
-                    flat_index += input_indices[i] * strides[i];                                   \
-                }                                                                                  \
-                float val = TO_FLOAT_FN(input[flat_index]);                                        \
-                if (val > max_val) {                                                               \
-                    max_val = val;                                                                 \
-                }                                                                                  \
-            }                                                                                      \
-                                                                                                   \
-            /* Second pass: sum exp(x - max) */                                                    \
-            float sum_exp = 0.0f;                                                                  \
-            for (size_t reduced_idx = 0; reduced_idx < reduce_size; reduced_idx++) {               \
-                size_t temp_reduced = reduced_idx;                                                 \
-                for (int i = (int)num_reduce_dims - 1; i >= 0; i--) {                              \
-                    size_t dim = reduce_dims[i];                                                   \
-                    input_indices[dim] = temp_reduced % dims[dim];                                 \
-                    temp_reduced /= dims[dim];                                                     \
-                }                                                                                  \
-                size_t flat_index = offset;                                                        \
-                for (size_t i = 0; i < num_dims; i++) {                                            \
-                    flat_index += input_indices[i] * strides[i];                                   \
-                }                                                                                  \
-                float val = TO_FLOAT_FN(input[flat_index]);                                        \
-                sum_exp += expf(val - max_val);                                                    \
-            }                                                                                      \
-                                                                                                   \
-            output[output_idx] = FROM_FLOAT_FN(max_val + logf(sum_exp));                           \
-        }                                                                                          \
-    }
-
-/// Macro to implement logsumexp reduction for standard types
+/// Macro to implement the online logsumexp accumulator for a float type
 ///
-/// @param TYPE C float type
-/// @param TYPE_SUFFIX Suffix for function naming
-/// @param NEG_INF Negative infinity value
-#define REDUCE_LOGSUMEXP_OP(TYPE, TYPE_SUFFIX, NEG_INF)                                            \
-    void hodu_cpu_logsumexp_##TYPE_SUFFIX(const void *input_ptr, void *output_ptr,                 \
-                                          const size_t *metadata) {                                \
-        const TYPE *input = (const TYPE *)input_ptr;                                               \
-        TYPE *output = (TYPE *)output_ptr;                                                         \
-                                                                                                   \
-        const size_t num_dims = metadata[0];                                                       \
-        const size_t *dims = metadata + 1;                                                         \
-        const size_t *strides = metadata + 1 + num_dims;                                           \
-        const size_t offset = metadata[1 + 2 * num_dims];                                          \
-        const size_t output_shape_len = metadata[2 + 2 * num_dims];                                \
-        const size_t *output_shape = metadata + 3 + 2 * num_dims;                                  \
-        const size_t num_reduce_dims = metadata[3 + 2 * num_dims + output_shape_len];              \
-        const size_t *reduce_dims = metadata + 4 + 2 * num_dims + output_shape_len;                \
-        const size_t keep_dim_val =                                                                \
-            metadata[4 + 2 * num_dims + output_shape_len + num_reduce_dims];                       \
-        const bool keep_dim = (keep_dim_val != 0);                                                 \
-        const size_t reduce_size =                                                                 \
-            metadata[5 + 2 * num_dims + output_shape_len + num_reduce_dims];                       \
-                                                                                                   \
-        size_t num_els = 1;                                                                        \
-        for (size_t i = 0; i < output_shape_len; i++) {                                            \
-            num_els *= output_shape[i];                                                            \
+/// @param TYPE C float type used for accumulation
+/// @param SFX Suffix for naming (f32 or f64)
+/// @param EXP_FN Exponential function for TYPE
+#define REDUCE_LSE_ACC(TYPE, SFX, EXP_FN)                                                          \
+    typedef struct {                                                                               \
+        TYPE max; /* Running max */                                                                \
+        TYPE sum; /* Running sum of exp(x - max) */                                                \
+    } reduce_lse_##SFX##_t;                                                                        \
+                                                                                                   \
+    static inline void reduce_lse_##SFX##_step(reduce_lse_##SFX##_t *acc, TYPE x) {                \
+        if (x > acc->max) {                                                                        \
+            acc->sum = acc->sum * EXP_FN(acc->max - x) + 1;                                        \
+            acc->max = x;                                                                          \
+        } else {                                                                                   \
+            acc->sum += EXP_FN(x - acc->max);                                                      \
         }                                                                                          \
-                                                                                                   \
-        for (size_t output_idx = 0; output_idx < num_els; output_idx++) {                          \
-            size_t output_indices[16];                                                             \
-            size_t temp = output_idx;                                                              \
-            for (int d = (int)output_shape_len - 1; d >= 0; d--) {                                 \
-                output_indices[d] = temp % output_shape[d];                                        \
-                temp /= output_shape[d];                                                           \
-            }                                                                                      \
-                                                                                                   \
-            size_t input_indices[16];                                                              \
-            if (keep_dim) {                                                                        \
-                for (size_t i = 0; i < num_dims; i++) {                                            \
-                    input_indices[i] = output_indices[i];                                          \
-                }                                                                                  \
-            } else {                                                                               \
-                size_t out_idx = 0;                                                                \
-                for (size_t in_dim = 0; in_dim < num_dims; in_dim++) {                             \
-                    bool is_reduced = false;                                                       \
-                    for (size_t r = 0; r < num_reduce_dims; r++) {                                 \
-                        if (reduce_dims[r] == in_dim) {                                            \
-                            is_reduced = true;                                                     \
-                            break;                                                                 \
-                        }                                                                          \
-                    }                                                                              \
-                    if (is_reduced) {                                                              \
-                        input_indices[in_dim] = 0;                                                 \
-                    } else {                                                                       \
-                        input_indices[in_dim] =                                                    \
-                            (out_idx < output_shape_len) ? output_indices[out_idx] : 0;            \
-                        out_idx++;                                                                 \
-                    }                                                                              \
-                }                                                                                  \
-            }                                                                                      \
-                                                                                                   \
-            /* First pass: find max */                                                             \
-            TYPE max_val = NEG_INF;                                                                \
-            for (size_t reduced_idx = 0; reduced_idx < reduce_size; reduced_idx++) {               \
-                size_t temp_reduced = reduced_idx;                                                 \
-                for (int i = (int)num_reduce_dims - 1; i >= 0; i--) {                              \
-                    size_t dim = reduce_dims[i];                                                   \
-                    input_indices[dim] = temp_reduced % dims[dim];                                 \
-                    temp_reduced /= dims[dim];                                                     \
-                }                                                                                  \
-                size_t flat_index = offset;                                                        \
-                for (size_t i = 0; i < num_dims; i++) {                                            \
-                    flat_index += input_indices[i] * strides[i];                                   \
-                }                                                                                  \
-                TYPE val = input[flat_index];                                                      \
-                if (val > max_val) {                                                               \
-                    max_val = val;                                                                 \
-                }                                                                                  \
-            }                                                                                      \
-                                                                                                   \
-            /* Second pass: sum exp(x - max) */                                                    \
-            TYPE sum_exp = 0;                                                                      \
-            for (size_t reduced_idx = 0; reduced_idx < reduce_size; reduced_idx++) {               \
-                size_t temp_reduced = reduced_idx;                                                 \
-                for (int i = (int)num_reduce_dims - 1; i >= 0; i--) {                              \
-                    size_t dim = reduce_dims[i];                                                   \
-                    input_indices[dim] = temp_reduced % dims[dim];                                 \
-                    temp_reduced /= dims[dim];                                                     \
-                }                                                                                  \
-                size_t flat_index = offset;                                                        \
-                for (size_t i = 0; i < num_dims; i++) {                                            \
-                    flat_index += input_indices[i] * strides[i];                                   \
-                }                                                                                  \
-                TYPE val = input[flat_index];                                                      \
-                sum_exp += exp(val - max_val);                                                     \
-            }                                                                                      \
-                                                                                                   \
-            output[output_idx] = max_val + log(sum_exp);                                           \
+    }                                                                                              \
+                                                                                                   \
+    static inline void reduce_lse_##SFX##_merge(reduce_lse_##SFX##_t *acc,                         \
+                                                reduce_lse_##SFX##_t other) {                      \
+        if (other.max > acc->max) {                                                                \
+            acc->sum = acc->sum * EXP_FN(acc->max - other.max) + other.sum;                        \
+            acc->max = other.max;                                                                  \
+        } else {                                                                                   \
+            acc->sum += other.sum * EXP_FN(other.max - acc->max);                                  \
         }                                                                                          \
     }
 
+REDUCE_LSE_ACC(float, f32, expf)
+REDUCE_LSE_ACC(double, f64, exp)
+
+/// Macro to implement logsumexp reduction for exotic types (via float conversion)
+///
+/// @param TYPE C float type
+/// @param TYPE_SUFFIX Suffix for function naming
+/// @param TO_FLOAT_FN Conversion to float function
+/// @param FROM_FLOAT_FN Conversion from float function
+#define REDUCE_LOGSUMEXP_OP_EXOTIC(TYPE, TYPE_SUFFIX, TO_FLOAT_FN, FROM_FLOAT_FN)                  \
+    REDUCE_SCALAR_HOOKS(logsumexp_##TYPE_SUFFIX, TYPE, reduce_lse_f32_t,                           \
+                        reduce_lse_f32_step(&acc, TO_FLOAT_FN(val)))                               \
+    REDUCE_ENGINE(logsumexp_##TYPE_SUFFIX, TYPE, TYPE, reduce_lse_f32_t,                           \
+                  ((reduce_lse_f32_t){-FLT_MAX, 0.0f}),                                            \
+                  reduce_lse_f32_step(&acc, TO_FLOAT_FN(val)), reduce_lse_f32_merge(&acc, other),  \
+                  FROM_FLOAT_FN(acc.max + logf(acc.sum)))
+
+/// Macro to implement logsumexp reduction for standard types
+///
+/// @param TYPE C float type
+/// @param TYPE_SUFFIX Suffix for function naming (f32 or f64)
+/// @param NEG_INF Initial running max
+/// @param LOG_FN Logarithm function
+#define REDUCE_LOGSUMEXP_OP(TYPE, TYPE_SUFFIX, NEG_INF, LOG_FN)                                    \
+    REDUCE_SCALAR_HOOKS(logsumexp_##TYPE_SUFFIX, TYPE, reduce_lse_##TYPE_SUFFIX##_t,               \
+                        reduce_lse_##TYPE_SUFFIX##_step(&acc, val))                                \
+    REDUCE_ENGINE(logsumexp_##TYPE_SUFFIX, TYPE, TYPE, reduce_lse_##TYPE_SUFFIX##_t,               \
+                  ((reduce_lse_##TYPE_SUFFIX##_t){NEG_INF, 0}),                                    \
+                  reduce_lse_##TYPE_SUFFIX##_step(&acc, val),                                      \
+                  reduce_lse_##TYPE_SUFFIX##_merge(&acc, other), acc.max + LOG_FN(acc.sum))
+
 REDUCE_LOGSUMEXP_OP_EXOTIC(f8e4m3_t, f8e4m3, f8e4m3_to_float, float_to_f8e4m3)
 REDUCE_LOGSUMEXP_OP_EXOTIC(f8e5m2_t, f8e5m2, f8e5m2_to_float, float_to_f8e5m2)
 REDUCE_LOGSUMEXP_OP_EXOTIC(bf16_t, bf16, bf16_to_float, float_to_bf16)
 REDUCE_LOGSUMEXP_OP_EXOTIC(f16_t, f16, f16_to_float, float_to_f16)
-REDUCE_LOGSUMEXP_OP(f32_t, f32, -FLT_MAX)
-REDUCE_LOGSUMEXP_OP(f64_t, f64, -DBL_MAX)
+REDUCE_LOGSUMEXP_OP(f32_t, f32, -FLT_MAX, logf)
+REDUCE_LOGSUMEXP_OP(f64_t, f64, -DBL_MAX, log)
 
 // ============================================================================
-// ARGMAX REDUCTION
+// ARGMAX / ARGMIN REDUCTION
 // ============================================================================
 //
-// Returns the index of the maximum value along the first reduce dimension.
-// Output type is always int32.
+// Returns the index of the maximum (minimum) value along the first reduce dimension; the
+// first occurrence wins on ties. Output type is always int32.
 //
 // Metadata layout: Same as generic reduction operations
 
-/// Macro to implement argmax reduction (returns int32 indices)
+/// Macro to implement the accumulator of an index-returning reduction
 ///
+/// @param NAME Reduction name (e.g. argmax_f32)
 /// @param IN_TYPE Input C type
-/// @param TYPE_SUFFIX Suffix for function naming
-#define REDUCE_ARGMAX_OP(IN_TYPE, TYPE_SUFFIX)                                                     \
-    void hodu_cpu_argmax_##TYPE_SUFFIX(const void *input_ptr, void *output_ptr,                    \
-                                       const size_t *metadata) {                                   \
-        const IN_TYPE *input = (const IN_TYPE *)input_ptr;                                         \
-        int32_t *output = (int32_t *)output_ptr;                                                   \
-                                                                                                   \
-        const size_t num_dims = metadata[0];                                                       \
-        const size_t *dims = metadata + 1;                                                         \
-        const size_t *strides = metadata + 1 + num_dims;                                           \
-        const size_t offset = metadata[1 + 2 * num_dims];                                          \
-        const size_t output_shape_len = metadata[2 + 2 * num_dims];                                \
-        const size_t *output_shape = metadata + 3 + 2 * num_dims;                                  \
-        const size_t num_reduce_dims = metadata[3 + 2 * num_dims + output_shape_len];              \
-        const size_t *reduce_dims = metadata + 4 + 2 * num_dims + output_shape_len;                \
-        const size_t keep_dim_val =                                                                \
-            metadata[4 + 2 * num_dims + output_shape_len + num_reduce_dims];                       \
-        const bool keep_dim = (keep_dim_val != 0);                                                 \
-        const size_t reduce_size =                                                                 \
-            metadata[5 + 2 * num_dims + output_shape_len + num_reduce_dims];                       \
-        size_t num_els = 1;                                                                        \
-        for (size_t i = 0; i < output_shape_len; i++) {                                            \
-            num_els *= output_shape[i];                                                            \
+/// @param BETTER_FN Comparison: BETTER_FN(a, b) is true when a strictly beats b
+#define REDUCE_ARG_STATE(NAME, IN_TYPE, BETTER_FN)                                                 \
+    typedef struct {                                                                               \
+        IN_TYPE val; /* Best value so far */                                                       \
+        int32_t idx; /* Its index along reduce_dims[0] */                                          \
+        bool set;    /* Whether any element has been seen */                                       \
+    } reduce_##NAME##_acc_t;                                                                       \
+                                                                                                   \
+    static inline void reduce_##NAME##_step(reduce_##NAME##_acc_t *acc, IN_TYPE val, size_t pos,   \
+                                            const reduce_plan_t *plan) {                           \
+        if (!acc->set || BETTER_FN(val, acc->val)) {                                               \
+            acc->val = val;                                                                        \
+            acc->idx = (int32_t)(pos / plan->arg_div);                                             \
+            acc->set = true;                                                                       \
         }                                                                                          \
+    }                                                                                              \
                                                                                                    \
-        for (size_t output_idx = 0; output_idx < num_els; output_idx++) {                          \
-            IN_TYPE max_val = 0;                                                                   \
-            int32_t max_idx = 0;                                                                   \
-            bool first = true;                                                                     \
+    /* other covers later positions, so it only wins when strictly better */                       \
+    static inline void reduce_##NAME##_merge(reduce_##NAME##_acc_t *acc,                           \
+                                             reduce_##NAME##_acc_t other) {                        \
+        if (other.set && (!acc->set || BETTER_FN(other.val, acc->val)))                            \
+            *acc = other;                                                                          \
+    }
+
+/// Macro to implement the engine of an index-returning reduction on top of REDUCE_ARG_STATE
+///
+/// @param NAME Reduction name (e.g. argmax_f32)
+/// @param IN_TYPE Input C type
+#define REDUCE_ARG_ENGINE(NAME, IN_TYPE)                                                           \
+    REDUCE_ENGINE(NAME, IN_TYPE, int32_t, reduce_##NAME##_acc_t, ((reduce_##NAME##_acc_t){0}),     \
+                  reduce_##NAME##_step(&acc, val, pos, plan),                                      \
+                  reduce_##NAME##_merge(&acc, other), acc.idx)
+
+/// Macro to implement an index-returning reduction (returns int32 indices)
+///
+/// @param NAME Reduction name (e.g. argmax_f32)
+/// @param IN_TYPE Input C type
+/// @param BETTER_FN Comparison: BETTER_FN(a, b) is true when a strictly beats b
+#define REDUCE_ARG_OP(NAME, IN_TYPE, BETTER_FN)                                                    \
+    REDUCE_ARG_STATE(NAME, IN_TYPE, BETTER_FN)                                                     \
+    REDUCE_SCALAR_HOOKS(NAME, IN_TYPE, reduce_##NAME##_acc_t,                                      \
+                        reduce_##NAME##_step(&acc, val, pos, plan))                                \
+    REDUCE_ARG_ENGINE(NAME, IN_TYPE)
+
+#if SIMD_F32_WIDTH > 1
+// Elements per SIMD argmax/argmin pass: lane positions are tracked as f32, exact up to 2^24
+#define REDUCE_ARG_CHUNK ((size_t)1 << 24)
+
+// Vector forms of REDUCE_GT / REDUCE_LT (false for NaN, like the scalar comparisons)
+#define REDUCE_VGT(a, b) simd_f32_cmplt(b, a)
+#define REDUCE_VLT(a, b) simd_f32_cmplt(a, b)
+
+/// Fold vector V into running lane bests BEST (at vector positions AT) when strictly better
+#define REDUCE_ARG_VSTEP(VBETTER_FN, BEST, AT, V, BASE)                                            \
+    do {                                                                                           \
+        const simd_f32_t x_ = (V);                                                                 \
+        const simd_f32_t m_ = VBETTER_FN(x_, BEST);                                                \
+        BEST = simd_f32_select(m_, x_, BEST);                                                      \
+        AT = simd_f32_select(m_, BASE, AT);                                                        \
+    } while (0)
+
+/// Macro to implement a SIMD f32 index-returning reduction (returns int32 indices)
+///
+/// Contiguous runs keep four vectors of per-lane bests with the positions they were seen at
+/// and merge the lanes once per pass; only elements strictly beating the running best are
+/// taken, so the first occurrence still wins and NaN is only kept as the first element.
+///
+/// @param NAME Reduction name (e.g. argmax_f32)
+/// @param BETTER_FN Scalar comparison (REDUCE_GT, REDUCE_LT)
+/// @param VBETTER_FN Matching vector comparison (REDUCE_VGT, REDUCE_VLT)
+#define REDUCE_ARG_SIMD_OP(NAME, BETTER_FN, VBETTER_FN)                                            \
+    REDUCE_ARG_STATE(NAME, f32_t, BETTER_FN)                                                       \
+                                                                                                   \
+    /* Offset of the first best element of x[0, n) if it strictly beats bound */                   \
+    static bool reduce_##NAME##_locate(const f32_t *x, size_t n, f32_t bound, size_t *off) {       \
+        const size_t w = SIMD_F32_WIDTH;                                                           \
+        const simd_f32_t vb = simd_f32_set1(bound);                                                \
+        const simd_f32_t step = simd_f32_set1((f32_t)w);                                           \
+        simd_f32_t b0 = vb, b1 = vb, b2 = vb, b3 = vb;                                             \
+        simd_f32_t p0 = simd_f32_set1(-1.0f), p1 = p0, p2 = p0, p3 = p0;                           \
+        simd_f32_t base = simd_f32_set1(0.0f);                                                     \
+        size_t i = 0;                                                                              \
+        for (; i + 4 * w <= n; i += 4 * w) {                                                       \
+            const simd_f32_t base1 = simd_f32_add(base, step);                                     \
+            const simd_f32_t base2 = simd_f32_add(base1, step);                                    \
+            const simd_f32_t base3 = simd_f32_add(base2, step);                                    \
+            REDUCE_ARG_VSTEP(VBETTER_FN, b0, p0, simd_f32_load(x + i), base);                      \
+            REDUCE_ARG_VSTEP(VBETTER_FN, b1, p1, simd_f32_load(x + i + w), base1);                 \
+            REDUCE_ARG_VSTEP(VBETTER_FN, b2, p2, simd_f32_load(x + i + 2 * w), base2);             \
+            REDUCE_ARG_VSTEP(VBETTER_FN, b3, p3, simd_f32_load(x + i + 3 * w), base3);             \
+            base = simd_f32_add(base3, step);                                                      \
+        }                                                                                          \
+        for (; i + w <= n; i += w) {                                                               \
+            REDUCE_ARG_VSTEP(VBETTER_FN, b0, p0, simd_f32_load(x + i), base);                      \
+            base = simd_f32_add(base, step);                                                       \
+        }                                                                                          \
+        if (i < n) {                                                                               \
+            REDUCE_ARG_VSTEP(VBETTER_FN, b1, p1, simd_f32_load_partial(x + i, n - i, vb), base);   \
+        }                                                                                          \
                                                                                                    \
-            size_t output_indices[16];                                                             \
-            size_t temp = output_idx;                                                              \
-            for (int d = (int)output_shape_len - 1; d >= 0; d--) {                                 \
-                output_indices[d] = temp % output_shape[d];                                        \
-                temp /= output_shape[d];                                                           \
+        /* Lanes hold the first position of their best; ties go to the lowest position */          \
+        f32_t vals[4 * SIMD_F32_WIDTH];                                                            \
+        f32_t at[4 * SIMD_F32_WIDTH];                                                              \
+        simd_f32_store(vals, b0);                                                                  \
+        simd_f32_store(vals + w, b1);                                                              \
+        simd_f32_store(vals + 2 * w, b2);                                                          \
+        simd_f32_store(vals + 3 * w, b3);                                                          \
+        simd_f32_store(at, p0);                                                                    \
+        simd_f32_store(at + w, p1);                                                                \
+        simd_f32_store(at + 2 * w, p2);                                                            \
+        simd_f32_store(at + 3 * w, p3);                                                            \
+        bool found = false;                                                                        \
+        f32_t best = bound;                                                                        \
+        for (size_t l = 0; l < 4 * w; l++) {                                                       \
+            if (at[l] < 0.0f)                                                                      \
+                continue;                                                                          \
+            const size_t p = (size_t)at[l] + l % w;                                                \
+            if (!found || BETTER_FN(vals[l], best) || (vals[l] == best && p < *off)) {             \
+                found = true;                                                                      \
+                best = vals[l];                                                                    \
+                *off = p;                                                                          \
             }                                                                                      \
-                                                                                                   \
-            size_t input_indices[16];                                                              \
-            if (keep_dim) {                                                                        \
-                for (size_t i = 0; i < num_dims; i++) {                                            \
-                    input_indices[i] = output_indices[i];                                          \
-                }                                                                                  \
-            } else {                                                                               \
-                size_t out_idx = 0;                                                                \
-                for (size_t in_dim = 0; in_dim < num_dims; in_dim++) {                             \
-                    bool is_reduced = false;                                                       \
-                    for (size_t r = 0; r < num_reduce_dims; r++) {                                 \
-                        if (reduce_dims[r] == in_dim) {                                            \
-                            is_reduced = true;                                                     \
-                            break;                                                                 \
-                        }                                                                          \
-                    }                                                                              \
-                    if (is_reduced) {                                                              \
-                        input_indices[in_dim] = 0;                                                 \
-                    } else {                                                                       \
-                        input_indices[in_dim] =                                                    \
-                            (out_idx < output_shape_len) ? output_indices[out_idx] : 0;            \
-                        out_idx++;                                                                 \
-                    }                                                                              \
-                }                                                                                  \
+        }                                                                                          \
+        return found;                                                                              \
+    }                                                                                              \
+                                                                                                   \
+    static inline void reduce_##NAME##_row(reduce_##NAME##_acc_t *acc, const f32_t *input,         \
+                                           size_t n, size_t pos, const reduce_plan_t *plan) {      \
+        if (n > 0 && !acc->set) {                                                                  \
+            reduce_##NAME##_step(acc, input[0], pos, plan);                                        \
+            input++;                                                                               \
+            n--;                                                                                   \
+            pos++;                                                                                 \
+        }                                                                                          \
+        if (acc->val != acc->val) /* a leading NaN is never beaten */                              \
+            return;                                                                                \
+        if (n < 2 * SIMD_F32_WIDTH) {                                                              \
+            for (size_t i = 0; i < n; i++) {                                                       \
+                reduce_##NAME##_step(acc, input[i], pos + i, plan);                                \
             }                                                                                      \
-                                                                                                   \
-            for (size_t reduced_idx = 0; reduced_idx < reduce_size; reduced_idx++) {               \
-                size_t temp_reduced = reduced_idx;                                                 \
-                for (int i = (int)num_reduce_dims - 1; i >= 0; i--) {                              \
-                    size_t dim = reduce_dims[i];                                                   \
-                    input_indices[dim] = temp_reduced % dims[dim];                                 \
-                    temp_reduced /= dims[dim];                                                     \
-                }                                                                                  \
-                                                                                                   \
-                size_t actual_dim_idx = input_indices[reduce_dims[0]];                             \
-                                                                                                   \
-                size_t flat_index = offset;                                                        \
-                for (size_t i = 0; i < num_dims; i++) {                                            \
-                    flat_index += input_indices[i] * strides[i];                                   \
-                }                                                                                  \
-                                                                                                   \
-                IN_TYPE val = input[flat_index];                                                   \
-                if (first || val > max_val) {                                                      \
-                    max_val = val;                                                                 \
-                    max_idx = (int32_t)actual_dim_idx;                                             \
-                    first = false;                                                                 \
-                }                                                                                  \
+            return;                                                                                \
+        }                                                                                          \
+        HODU_PROFILE_PATH(HODU_CPU_PATH_SIMD);                                                     \
+        for (size_t c = 0; c < n; c += REDUCE_ARG_CHUNK) {                                         \
+            size_t off = 0;                                                                        \
+            const size_t m = MIN(REDUCE_ARG_CHUNK, n - c);                                         \
+            if (reduce_##NAME##_locate(input + c, m, acc->val, &off)) {                            \
+                acc->val = input[c + off];                                                         \
+                acc->idx = (int32_t)((pos + c + off) / plan->arg_div);                             \
             }                                                                                      \
-                                                                                                   \
-            output[output_idx] = max_idx;                                                          \
         }                                                                                          \
-    }
+    }                                                                                              \
+                                                                                                   \
+    REDUCE_SCALAR_LANES_HOOK(NAME, f32_t, reduce_##NAME##_acc_t,                                   \
+                             reduce_##NAME##_step(&acc, val, pos, plan))                           \
+    REDUCE_ARG_ENGINE(NAME, f32_t)
+
+#define REDUCE_ARG_F32_OP(NAME, BETTER_FN, VBETTER_FN)                                             \
+    REDUCE_ARG_SIMD_OP(NAME, BETTER_FN, VBETTER_FN)
+#else
+#define REDUCE_ARG_F32_OP(NAME, BETTER_FN, VBETTER_FN) REDUCE_ARG_OP(NAME, f32_t, BETTER_FN)
+#endif
+
+/// Macro to implement argmax reduction (returns int32 indices)
+///
+/// @param IN_TYPE Input C type
+/// @param TYPE_SUFFIX Suffix for function naming
+#define REDUCE_ARGMAX_OP(IN_TYPE, TYPE_SUFFIX)                                                     \
+    REDUCE_ARG_OP(argmax_##TYPE_SUFFIX, IN_TYPE, REDUCE_GT)
 
 /// Macro to implement argmax reduction for exotic types (returns int32 indices)
 ///
@@ -2289,193 +1354,14 @@ REDUCE_LOGSUMEXP_OP(f64_t, f64, -DBL_MAX)
 /// @param TYPE_SUFFIX Suffix for function naming
 /// @param GT_FN Greater-than comparison function
 #define REDUCE_ARGMAX_OP_EXOTIC(IN_TYPE, TYPE_SUFFIX, GT_FN)                                       \
-    void hodu_cpu_argmax_##TYPE_SUFFIX(const void *input_ptr, void *output_ptr,                    \
-                                       const size_t *metadata) {                                   \
-        const IN_TYPE *input = (const IN_TYPE *)input_ptr;                                         \
-        int32_t *output = (int32_t *)output_ptr;                                                   \
-                                                                                                   \
-        const size_t num_dims = metadata[0];                                                       \
-        const size_t *dims = metadata + 1;                                                         \
-        const size_t *strides = metadata + 1 + num_dims;                                           \
-        const size_t offset = metadata[1 + 2 * num_dims];                                          \
-        const size_t output_shape_len = metadata[2 + 2 * num_dims];                                \
-        const size_t *output_shape = metadata + 3 + 2 * num_dims;                                  \
-        const size_t num_reduce_dims = metadata[3 + 2 * num_dims + output_shape_len];              \
-        const size_t *reduce_dims = metadata + 4 + 2 * num_dims + output_shape_len;                \
-        const size_t keep_dim_val =                                                                \
-            metadata[4 + 2 * num_dims + output_shape_len + num_reduce_dims];                       \
-        const bool keep_dim = (keep_dim_val != 0);                                                 \
-        const size_t reduce_size =                                                                 \
-            metadata[5 + 2 * num_dims + output_shape_len + num_reduce_dims];                       \
-        size_t num_els = 1;                                                                        \
-        for (size_t i = 0; i < output_shape_len; i++) {                                            \
-            num_els *= output_shape[i];                                                            \
-        }                                                                                          \
-                                                                                                   \
-        for (size_t output_idx = 0; output_idx < num_els; output_idx++) {                          \
-            IN_TYPE max_val;                                                                       \
-            int32_t max_idx = 0;                                                                   \
-            bool first = true;                                                                     \
-                                                                                                   \
-            size_t output_indices[16];                                                             \
-            size_t temp = output_idx;                                                              \
-            for (int d = (int)output_shape_len - 1; d >= 0; d--) {                                 \
-                output_indices[d] = temp % output_shape[d];                                        \
-                temp /= output_shape[d];                                                           \
-            }                                                                                      \
-                                                                                                   \
-            size_t input_indices[16];                                                              \
-            if (keep_dim) {                                                                        \
-                for (size_t i = 0; i < num_dims; i++) {                                            \
-                    input_indices[i] = output_indices[i];                                          \
-                }                                                                                  \
-            } else {                                                                               \
-                size_t out_idx = 0;                                                                \
-                for (size_t in_dim = 0; in_dim < num_dims; in_dim++) {                             \
-                    bool is_reduced = false;                                                       \
-                    for (size_t r = 0; r < num_reduce_dims; r++) {                                 \
-                        if (reduce_dims[r] == in_dim) {                                            \
-                            is_reduced = true;                                                     \
-                            break;                                                                 \
-                        }                                                                          \
-                    }                                                                              \
-                    if (is_reduced) {                                                              \
-                        input_indices[in_dim] = 0;                                                 \
-                    } else {                                                                       \
-                        input_indices[in_dim] =                                                    \
-                            (out_idx < output_shape_len) ? output_indices[out_idx] : 0;            \
-                        out_idx++;                                                                 \
-                    }                                                                              \
-                }                                                                                  \
-            }                                                                                      \
-                                                                                                   \
-            for (size_t reduced_idx = 0; reduced_idx < reduce_size; reduced_idx++) {               \
-                size_t temp_reduced = reduced_idx;                                                 \
-                for (int i = (int)num_reduce_dims - 1; i >= 0; i--) {                              \
-                    size_t dim = reduce_dims[i];                                                   \
-                    input_indices[dim] = temp_reduced % dims[dim];                                 \
-                    temp_reduced /= dims[dim];                                                     \
-                }                                                                                  \
-                                                                                                   \
-                size_t actual_dim_idx = input_indices[reduce_dims[0]];                             \
-                                                                                                   \
-                size_t flat_index = offset;                                                        \
-                for (size_t i = 0; i < num_dims; i++) {                                            \
-                    flat_index += input_indices[i] * strides[i];                                   \
-                }                                                                                  \
-                                                                                                   \
-                IN_TYPE val = input[flat_index];                                                   \
-                if (first || GT_FN(val, max_val)) {                                                \
-                    max_val = val;                                                                 \
-                    max_idx = (int32_t)actual_dim_idx;                                             \
-                    first = false;                                                                 \
-                }                                                                                  \
-            }                                                                                      \
-                                                                                                   \
-            output[output_idx] = max_idx;                                                          \
-        }                                                                                          \
-    }
-
-// ============================================================================
-// ARGMIN REDUCTION
-// ============================================================================
-//
-// Returns the index of the minimum value along the first reduce dimension.
-// Output type is always int32.
-//
-// Metadata layout: Same as generic reduction operations
+    REDUCE_ARG_OP(argmax_##TYPE_SUFFIX, IN_TYPE, GT_FN)
 
 /// Macro to implement argmin reduction (returns int32 indices)
 ///
 /// @param IN_TYPE Input C type
 /// @param TYPE_SUFFIX Suffix for function naming
 #define REDUCE_ARGMIN_OP(IN_TYPE, TYPE_SUFFIX)                                                     \
-    void hodu_cpu_argmin_##TYPE_SUFFIX(const void *input_ptr, void *output_ptr,                    \
-                                       const size_t *metadata) {                                   \
-        const IN_TYPE *input = (const IN_TYPE *)input_ptr;                                         \
-        int32_t *output = (int32_t *)output_ptr;                                                   \
-                                                                                                   \
-        const size_t num_dims = metadata[0];                                                       \
-        const size_t *dims = metadata + 1;                                                         \
-        const size_t *strides = metadata + 1 + num_dims;                                           \
-        const size_t offset = metadata[1 + 2 * num_dims];                                          \
-        const size_t output_shape_len = metadata[2 + 2 * num_dims];                                \
-        const size_t *output_shape = metadata + 3 + 2 * num_dims;                                  \
-        const size_t num_reduce_dims = metadata[3 + 2 * num_dims + output_shape_len];              \
-        const size_t *reduce_dims = metadata + 4 + 2 * num_dims + output_shape_len;                \
-        const size_t keep_dim_val =                                                                \
-            metadata[4 + 2 * num_dims + output_shape_len + num_reduce_dims];                       \
-        const bool keep_dim = (keep_dim_val != 0);                                                 \
-        const size_t reduce_size =                                                                 \
-            metadata[5 + 2 * num_dims + output_shape_len + num_reduce_dims];                       \
-        size_t num_els = 1;                                                                        \
-        for (size_t i = 0; i < output_shape_len; i++) {                                            \
-            num_els *= output_shape[i];                                                            \
-        }                                                                                          \
-                                                                                                   \
-        for (size_t output_idx = 0; output_idx < num_els; output_idx++) {                          \
-            IN_TYPE min_val = 0;                                                                   \
-            int32_t min_idx = 0;                                                                   \
-            bool first = true;                                                                     \
-                                                                                                   \
-            size_t output_indices[16];                                                             \
-            size_t temp = output_idx;                                                              \
-            for (int d = (int)output_shape_len - 1; d >= 0; d--) {                                 \
-                output_indices[d] = temp % output_shape[d];                                        \
-                temp /= output_shape[d];                                                           \
-            }                                                                                      \
-                                                                                                   \
-            size_t input_indices[16];                                                              \
-            if (keep_dim) {                                                                        \
-                for (size_t i = 0; i < num_dims; i++) {                                            \
-                    input_indices[i] = output_indices[i];                                          \
-                }                                                                                  \
-            } else {                                                                               \
-                size_t out_idx = 0;                                                                \
-                for (size_t in_dim = 0; in_dim < num_dims; in_dim++) {                             \
-                    bool is_reduced = false;                                                       \
-                    for (size_t r = 0; r < num_reduce_dims; r++) {                                 \
-                        if (reduce_dims[r] == in_dim) {                                            \
-                            is_reduced = true;                                                     \
-                            break;                                                                 \
-                        }                                                                          \
-                    }                                                                              \
-                    if (is_reduced) {                                                              \
-                        input_indices[in_dim] = 0;                                                 \
-                    } else {                                                                       \
-                        input_indices[in_dim] =                                                    \
-                            (out_idx < output_shape_len) ? output_indices[out_idx] : 0;            \
-                        out_idx++;                                                                 \
-                    }                                                                              \
-                }                                                                                  \
-            }                                                                                      \
-                                                                                                   \
-            for (size_t reduced_idx = 0; reduced_idx < reduce_size; reduced_idx++) {               \
-                size_t temp_reduced = reduced_idx;                                                 \
-                for (int i = (int)num_reduce_dims - 1; i >= 0; i--) {                              \
-                    size_t dim = reduce_dims[i];                                                   \
-                    input_indices[dim] = temp_reduced % dims[dim];                                 \
-                    temp_reduced /= dims[dim];                                                     \
-                }                                                                                  \
-                                                                                                   \
-                size_t actual_dim_idx = input_indices[reduce_dims[0]];                             \
-                                                                                                   \
-                size_t flat_index = offset;                                                        \
-                for (size_t i = 0; i < num_dims; i++) {                                            \
-                    flat_index += input_indices[i] * strides[i];                                   \
-                }                                                                                  \
-                                                                                                   \
-                IN_TYPE val = input[flat_index];                                                   \
-                if (first || val < min_val) {                                                      \
-                    min_val = val;                                                                 \
-                    min_idx = (int32_t)actual_dim_idx;                                             \
-                    first = false;                                                                 \
-                }                                                                                  \
-            }                                                                                      \
-                                                                                                   \
-            output[output_idx] = min_idx;                                                          \
-        }                                                                                          \
-    }
+    REDUCE_ARG_OP(argmin_##TYPE_SUFFIX, IN_TYPE, REDUCE_LT)
 
 /// Macro to implement argmin reduction for exotic types (returns int32 indices)
 ///
@@ -2483,99 +1369,14 @@ REDUCE_LOGSUMEXP_OP(f64_t, f64, -DBL_MAX)
 /// @param TYPE_SUFFIX Suffix for function naming
 /// @param LT_FN Less-than comparison function
 #define REDUCE_ARGMIN_OP_EXOTIC(IN_TYPE, TYPE_SUFFIX, LT_FN)                                       \
-    void hodu_cpu_argmin_##TYPE_SUFFIX(const void *input_ptr, void *output_ptr,                    \
-                                       const size_t *metadata) {                                   \
-        const IN_TYPE *input = (const IN_TYPE *)input_ptr;                                         \
-        int32_t *output = (int32_t *)output_ptr;                                                   \
-                                                                                                   \
-        const size_t num_dims = metadata[0];                                                       \
-        const size_t *dims = metadata + 1;                                                         \
-        const size_t *strides = metadata + 1 + num_dims;                                           \
-        const size_t offset = metadata[1 + 2 * num_dims];                                          \
-        const size_t output_shape_len = metadata[2 + 2 * num_dims];                                \
-        const size_t *output_shape = metadata + 3 + 2 * num_dims;                                  \
-        const size_t num_reduce_dims = metadata[3 + 2 * num_dims + output_shape_len];              \
-        const size_t *reduce_dims = metadata + 4 + 2 * num_dims + output_shape_len;                \
-        const size_t keep_dim_val =                                                                \
-            metadata[4 + 2 * num_dims + output_shape_len + num_reduce_dims];                       \
-        const bool keep_dim = (keep_dim_val != 0);                                                 \
-        const size_t reduce_size =                                                                 \
-            metadata[5 + 2 * num_dims + output_shape_len + num_reduce_dims];                       \
-        size_t num_els = 1;                                                                        \
-        for (size_t i = 0; i < output_shape_len; i++) {                                            \
-            num_els *= output_shape[i];                                                            \
-        }                                                                                          \
-                                                                                                   \
-        for (size_t output_idx = 0; output_idx < num_els; output_idx++) {                          \
-            IN_TYPE min_val;                                                                       \
-            int32_t min_idx = 0;                                                                   \
-            bool first = true;                                                                     \
-                                                                                                   \
-            size_t output_indices[16];                                                             \
-            size_t temp = output_idx;                                                              \
-            for (int d = (int)output_shape_len - 1; d >= 0; d--) {                                 \
-                output_indices[d] = temp % output_shape[d];                                        \
-                temp /= output_shape[d];                                                           \
-            }                                                                                      \
-                                                                                                   \
-            size_t input_indices[16];                                                              \
-            if (keep_dim) {                                                                        \
-                for (size_t i = 0; i < num_dims; i++) {                                            \
-                    input_indices[i] = output_indices[i];                                          \
-                }                                                                                  \
-            } else {                                                                               \
-                size_t out_idx = 0;                                                                \
-                for (size_t in_dim = 0; in_dim < num_dims; in_dim++) {                             \
-                    bool is_reduced = false;                                                       \
-                    for (size_t r = 0; r < num_reduce_dims; r++) {                                 \
-                        if (reduce_dims[r] == in_dim) {                                            \
-                            is_reduced = true;                                                     \
-                            break;                                                                 \
-                        }                                                                          \
-                    }                                                                              \
-                    if (is_reduced) {                                                              \
-                        input_indices[in_dim] = 0;                                                 \
-                    } else {                                                                       \
-                        input_indices[in_dim] =                                                    \
-                            (out_idx < output_shape_len) ? output_indices[out_idx] : 0;            \
-                        out_idx++;                                                                 \
-                    }                                                                              \
-                }                                                                                  \
-            }                                                                                      \
-                                                                                                   \
-            for (size_t reduced_idx = 0; reduced_idx < reduce_size; reduced_idx++) {               \
-                size_t temp_reduced = reduced_idx;                                                 \
-                for (int i = (int)num_reduce_dims - 1; i >= 0; i--) {                              \
-                    size_t dim = reduce_dims[i];                                                   \
-                    input_indices[dim] = temp_reduced % dims[dim];                                 \
-                    temp_reduced /= dims[dim];                                                     \
-                }                                                                                  \
-                                                                                                   \
-                size_t actual_dim_idx = input_indices[reduce_dims[0]];                             \
-                                                                                                   \
-                size_t flat_index = offset;                                                        \
-                for (size_t i = 0; i < num_dims; i++) {                                            \
-                    flat_index += input_indices[i] * strides[i];                                   \
-                }                                                                                  \
-                                                                                                   \
-                IN_TYPE val = input[flat_index];                                                   \
-                if (first || LT_FN(val, min_val)) {                                                \
-                    min_val = val;                                                                 \
-                    min_idx = (int32_t)actual_dim_idx;                                             \
-                    first = false;                                                                 \
-                }                                                                                  \
-            }                                                                                      \
-                                                                                                   \
-            output[output_idx] = min_idx;                                                          \
-        }                                                                                          \
-    }
+    REDUCE_ARG_OP(argmin_##TYPE_SUFFIX, IN_TYPE, LT_FN)
 
 REDUCE_ARGMAX_OP(bool, bool)
 REDUCE_ARGMAX_OP_EXOTIC(f8e4m3_t, f8e4m3, f8e4m3_gt)
 REDUCE_ARGMAX_OP_EXOTIC(f8e5m2_t, f8e5m2, f8e5m2_gt)
 REDUCE_ARGMAX_OP_EXOTIC(bf16_t, bf16, bf16_gt)
 REDUCE_ARGMAX_OP_EXOTIC(f16_t, f16, f16_gt)
-REDUCE_ARGMAX_OP(f32_t, f32)
+REDUCE_ARG_F32_OP(argmax_f32, REDUCE_GT, REDUCE_VGT)
 REDUCE_ARGMAX_OP(f64_t, f64)
 REDUCE_ARGMAX_OP(int8_t, i8)
 REDUCE_ARGMAX_OP(int16_t, i16)
@@ -2591,7 +1392,7 @@ REDUCE_ARGMIN_OP_EXOTIC(f8e4m3_t, f8e4m3, f8e4m3_lt)
 REDUCE_ARGMIN_OP_EXOTIC(f8e5m2_t, f8e5m2, f8e5m2_lt)
 REDUCE_ARGMIN_OP_EXOTIC(bf16_t, bf16, bf16_lt)
 REDUCE_ARGMIN_OP_EXOTIC(f16_t, f16, f16_lt)
-REDUCE_ARGMIN_OP(f32_t, f32)
+REDUCE_ARG_F32_OP(argmin_f32, REDUCE_LT, REDUCE_VLT)
 REDUCE_ARGMIN_OP(f64_t, f64)
 REDUCE_ARGMIN_OP(int8_t, i8)
 REDUCE_ARGMIN_OP(int16_t, i16)
@@ -2603,203 +1404,135 @@ REDUCE_ARGMIN_OP(uint32_t, u32)
 REDUCE_ARGMIN_OP(uint64_t, u64)
 
 // ============================================================================
-// ANY REDUCTION (LOGICAL OR)
+// ANY / ALL REDUCTION (LOGICAL OR / AND)
 // ============================================================================
 //
-// Returns true if any element is non-zero along reduce dimensions.
-// Output type is always bool. Short-circuits on first true value.
+// any: true if any element is non-zero along reduce dimensions.
+// all: true if every element is non-zero along reduce dimensions.
+// Output type is always bool. Contiguous runs stop as soon as the result is decided.
 //
 // Metadata layout: Same as generic reduction operations
 
 #define IS_NONZERO(val) ((val) != 0)
 
-/// Macro to implement any reduction (logical OR, returns bool)
+// Elements tested between early-exit checks in contiguous runs
+#define REDUCE_BOOL_BLOCK 256
+
+/// Macro to implement the lane hook and engine of a logical reduction (returns bool)
 ///
+/// @param NAME Reduction name (e.g. any_f32)
 /// @param IN_TYPE Input C type
-/// @param TYPE_SUFFIX Suffix for function naming
-#define REDUCE_ANY_OP(IN_TYPE, TYPE_SUFFIX)                                                        \
-    void hodu_cpu_any_##TYPE_SUFFIX(const void *input_ptr, void *output_ptr,                       \
-                                    const size_t *metadata) {                                      \
-        const IN_TYPE *input = (const IN_TYPE *)input_ptr;                                         \
-        bool *output = (bool *)output_ptr;                                                         \
-                                                                                                   \
-        const size_t num_dims = metadata[0];                                                       \
-        const size_t *dims = metadata + 1;                                                         \
-        const size_t *strides = metadata + 1 + num_dims;                                           \
-        const size_t offset = metadata[1 + 2 * num_dims];                                          \
-        const size_t output_shape_len = metadata[2 + 2 * num_dims];                                \
-        const size_t *output_shape = metadata + 3 + 2 * num_dims;                                  \
-        const size_t num_reduce_dims = metadata[3 + 2 * num_dims + output_shape_len];              \
-        const size_t *reduce_dims = metadata + 4 + 2 * num_dims + output_shape_len;                \
-        const size_t keep_dim_val =                                                                \
-            metadata[4 + 2 * num_dims + output_shape_len + num_reduce_dims];                       \
-        const bool keep_dim = (keep_dim_val != 0);                                                 \
-        const size_t reduce_size =                                                                 \
-            metadata[5 + 2 * num_dims + output_shape_len + num_reduce_dims];                       \
-        size_t num_els = 1;                                                                        \
-        for (size_t i = 0; i < output_shape_len; i++) {                                            \
-            num_els *= output_shape[i];                                                            \
+/// @param DECIDED Result that, once reached, no further element can change
+#define REDUCE_BOOL_ENGINE(NAME, IN_TYPE, DECIDED)                                                 \
+    static inline void reduce_##NAME##_lanes(bool *acc, const IN_TYPE *input, size_t n,            \
+                                             size_t pos, const reduce_plan_t *plan) {              \
+        for (size_t i = 0; i < n; i++) {                                                           \
+            if (IS_NONZERO(input[i]) == DECIDED)                                                   \
+                acc[i] = DECIDED;                                                                  \
         }                                                                                          \
+        (void)pos;                                                                                 \
+        (void)plan;                                                                                \
+    }                                                                                              \
                                                                                                    \
-        for (size_t output_idx = 0; output_idx < num_els; output_idx++) {                          \
-            bool result = false;                                                                   \
-                                                                                                   \
-            size_t output_indices[16];                                                             \
-            size_t temp = output_idx;                                                              \
-            for (int d = (int)output_shape_len - 1; d >= 0; d--) {                                 \
-                output_indices[d] = temp % output_shape[d];                                        \
-                temp /= output_shape[d];                                                           \
-            }                                                                                      \
-                                                                                                   \
-            size_t input_indices[16];                                                              \
-            if (keep_dim) {                                                                        \
-                for (size_t i = 0; i < num_dims; i++) {                                            \
-                    input_indices[i] = output_indices[i];                                          \
-                }                                                                                  \
-            } else {                                                                               \
-                size_t out_idx = 0;                                                                \
-                for (size_t in_dim = 0; in_dim < num_dims; in_dim++) {                             \
-                    bool is_reduced = false;                                                       \
-                    for (size_t r = 0; r < num_reduce_dims; r++) {                                 \
-                        if (reduce_dims[r] == in_dim) {                                            \
-                            is_reduced = true;                                                     \
-                            break;                                                                 \
-                        }                                                                          \
-                    }                                                                              \
-                    if (is_reduced) {                                                              \
-                        input_indices[in_dim] = 0;                                                 \
-                    } else {                                                                       \
-                        input_indices[in_dim] =                                                    \
-                            (out_idx < output_shape_len) ? output_indices[out_idx] : 0;            \
-                        out_idx++;                                                                 \
-                    }                                                                              \
-                }                                                                                  \
-            }                                                                                      \
-                                                                                                   \
-            for (size_t reduced_idx = 0; reduced_idx < reduce_size; reduced_idx++) {               \
-                size_t temp_reduced = reduced_idx;                                                 \
-                for (int i = (int)num_reduce_dims - 1; i >= 0; i--) {                              \
-                    size_t dim = reduce_dims[i];                                                   \
-                    input_indices[dim] = temp_reduced % dims[dim];                                 \
-                    temp_reduced /= dims[dim];                                                     \
-                }                                                                                  \
-                                                                                                   \
-                size_t flat_index = offset;                                                        \
-                for (size_t i = 0; i < num_dims; i++) {                                            \
-                    flat_index += input_indices[i] * strides[i];                                   \
-                }                                                                                  \
-                                                                                                   \
-                if (IS_NONZERO(input[flat_index])) {                                               \
-                    result = true;                                                                 \
-                    break;                                                                         \
-                }                                                                                  \
+    REDUCE_ENGINE(NAME, IN_TYPE, bool, bool, !(DECIDED),                                           \
+                  acc = IS_NONZERO(val) == DECIDED ? DECIDED : acc,                                \
+                  acc = other == DECIDED ? DECIDED : acc, acc)
+
+/// Macro to implement a logical reduction (returns bool)
+///
+/// Runs are tested in branch-free blocks of REDUCE_BOOL_BLOCK elements, stopping after the
+/// first block that decides the result.
+///
+/// @param NAME Reduction name (e.g. any_f32)
+/// @param IN_TYPE Input C type
+/// @param DECIDED Result that, once reached, no further element can change (true for any,
+///        false for all)
+#define REDUCE_BOOL_OP(NAME, IN_TYPE, DECIDED)                                                     \
+    static inline void reduce_##NAME##_row(bool *acc, const IN_TYPE *input, size_t n, size_t pos,  \
+                                           const reduce_plan_t *plan) {                            \
+        for (size_t i = 0; i < n && *acc != DECIDED; i += REDUCE_BOOL_BLOCK) {                     \
+            const size_t m = MIN(REDUCE_BOOL_BLOCK, n - i);                                        \
+            bool hit = false;                                                                      \
+            for (size_t j = 0; j < m; j++) {                                                       \
+                hit |= IS_NONZERO(input[i + j]) == DECIDED;                                        \
             }                                                                                      \
+            if (hit)                                                                               \
+                *acc = DECIDED;                                                                    \
+        }                                                                                          \
+        (void)pos;                                                                                 \
+        (void)plan;                                                                                \
+    }                                                                                              \
                                                                                                    \
-            output[output_idx] = result;                                                           \
+    REDUCE_BOOL_ENGINE(NAME, IN_TYPE, DECIDED)
+
+#if SIMD_F32_WIDTH > 1
+/// Macro to implement a SIMD f32 logical reduction (returns bool)
+///
+/// Runs compare four vectors at a time against zero and stop as soon as one lane of the
+/// combined mask decides the result; NaN counts as non-zero, as in IS_NONZERO.
+///
+/// @param NAME Reduction name (e.g. any_f32)
+/// @param DECIDED Result that, once reached, no further element can change
+#define REDUCE_BOOL_SIMD_OP(NAME, DECIDED)                                                         \
+    static inline simd_f32_t reduce_##NAME##_vhit(const f32_t *x, simd_f32_t zero,                 \
+                                                  simd_f32_t on_zero, simd_f32_t on_nonzero) {     \
+        return simd_f32_select(simd_f32_cmpeq(simd_f32_load(x), zero), on_zero, on_nonzero);       \
+    }                                                                                              \
+                                                                                                   \
+    static inline void reduce_##NAME##_row(bool *acc, const f32_t *input, size_t n, size_t pos,    \
+                                           const reduce_plan_t *plan) {                            \
+        const size_t w = SIMD_F32_WIDTH;                                                           \
+        const simd_f32_t zero = simd_f32_set1(0.0f);                                               \
+        const simd_f32_t on_zero = simd_f32_set1((DECIDED) ? 0.0f : 1.0f);                         \
+        const simd_f32_t on_nonzero = simd_f32_set1((DECIDED) ? 1.0f : 0.0f);                      \
+        size_t i = 0;                                                                              \
+        if (n >= 4 * w && *acc != DECIDED) {                                                       \
+            HODU_PROFILE_PATH(HODU_CPU_PATH_SIMD);                                                 \
         }                                                                                          \
-    }
+        for (; i + 4 * w <= n && *acc != DECIDED; i += 4 * w) {                                    \
+            const simd_f32_t h0 = reduce_##NAME##_vhit(input + i, zero, on_zero, on_nonzero);      \
+            const simd_f32_t h1 = reduce_##NAME##_vhit(input + i + w, zero, on_zero, on_nonzero);  \
+            const simd_f32_t h2 =                                                                  \
+                reduce_##NAME##_vhit(input + i + 2 * w, zero, on_zero, on_nonzero);                \
+            const simd_f32_t h3 =                                                                  \
+                reduce_##NAME##_vhit(input + i + 3 * w, zero, on_zero, on_nonzero);                \
+            const simd_f32_t h = simd_f32_max(simd_f32_max(h0, h1), simd_f32_max(h2, h3));         \
+            if (simd_f32_reduce_max(h) > 0.0f)                                                     \
+                *acc = DECIDED;                                                                    \
+        }                                                                                          \
+        for (; i < n && *acc != DECIDED; i++) {                                                    \
+            if (IS_NONZERO(input[i]) == DECIDED)                                                   \
+                *acc = DECIDED;                                                                    \
+        }                                                                                          \
+        (void)pos;                                                                                 \
+        (void)plan;                                                                                \
+    }                                                                                              \
+                                                                                                   \
+    REDUCE_BOOL_ENGINE(NAME, f32_t, DECIDED)
 
-// ============================================================================
-// ALL REDUCTION (LOGICAL AND)
-// ============================================================================
-//
-// Returns true if all elements are non-zero along reduce dimensions.
-// Output type is always bool. Short-circuits on first false value.
-//
-// Metadata layout: Same as generic reduction operations
+#define REDUCE_BOOL_F32_OP(NAME, DECIDED) REDUCE_BOOL_SIMD_OP(NAME, DECIDED)
+#else
+#define REDUCE_BOOL_F32_OP(NAME, DECIDED) REDUCE_BOOL_OP(NAME, f32_t, DECIDED)
+#endif
+
+/// Macro to implement any reduction (logical OR, returns bool)
+///
+/// @param IN_TYPE Input C type
+/// @param TYPE_SUFFIX Suffix for function naming
+#define REDUCE_ANY_OP(IN_TYPE, TYPE_SUFFIX) REDUCE_BOOL_OP(any_##TYPE_SUFFIX, IN_TYPE, true)
 
 /// Macro to implement all reduction (logical AND, returns bool)
 ///
 /// @param IN_TYPE Input C type
 /// @param TYPE_SUFFIX Suffix for function naming
-#define REDUCE_ALL_OP(IN_TYPE, TYPE_SUFFIX)                                                        \
-    void hodu_cpu_all_##TYPE_SUFFIX(const void *input_ptr, void *output_ptr,                       \
-                                    const size_t *metadata) {                                      \
-        const IN_TYPE *input = (const IN_TYPE *)input_ptr;                                         \
-        bool *output = (bool *)output_ptr;                                                         \
-                                                                                                   \
-        const size_t num_dims = metadata[0];                                                       \
-        const size_t *dims = metadata + 1;                                                         \
-        const size_t *strides = metadata + 1 + num_dims;                                           \
-        const size_t offset = metadata[1 + 2 * num_dims];                                          \
-        const size_t output_shape_len = metadata[2 + 2 * num_dims];                                \
-        const size_t *output_shape = metadata + 3 + 2 * num_dims;                                  \
-        const size_t num_reduce_dims = metadata[3 + 2 * num_dims + output_shape_len];              \
-        const size_t *reduce_dims = metadata + 4 + 2 * num_dims + output_shape_len;                \
-        const size_t keep_dim_val =                                                                \
-            metadata[4 + 2 * num_dims + output_shape_len + num_reduce_dims];                       \
-        const bool keep_dim = (keep_dim_val != 0);                                                 \
-        const size_t reduce_size =                                                                 \
-            metadata[5 + 2 * num_dims + output_shape_len + num_reduce_dims];                       \
-        size_t num_els = 1;                                                                        \
-        for (size_t i = 0; i < output_shape_len; i++) {                                            \
-            num_els *= output_shape[i];                                                            \
-        }                                                                                          \
-                                                                                                   \
-        for (size_t output_idx = 0; output_idx < num_els; output_idx++) {                          \
-            bool result = true;                                                                    \
-                                                                                                   \
-            size_t output_indices[16];                                                             \
-            size_t temp = output_idx;                                                              \
-            for (int d = (int)output_shape_len - 1; d >= 0; d--) {                                 \
-                output_indices[d] = temp % output_shape[d];                                        \
-                temp /= output_shape[d];                                                           \
-            }                                                                                      \
-                                                                                                   \
-            size_t input_indices[16];                                                              \
-            if (keep_dim) {                                                                        \
-                for (size_t i = 0; i < num_dims; i++) {                                            \
-                    input_indices[i] = output_indices[i];                                          \
-                }                                                                                  \
-            } else {                                                                               \
-                size_t out_idx = 0;                                                                \
-                for (size_t in_dim = 0; in_dim < num_dims; in_dim++) {                             \
-                    bool is_reduced = false;                                                       \
-                    for (size_t r = 0; r < num_reduce_dims; r++) {                                 \
-                        if (reduce_dims[r] == in_dim) {                                            \
-                            is_reduced = true;                                                     \
-                            break;                                                                 \
-                        }                                                                          \
-                    }                                                                              \
-                    if (is_reduced) {                                                              \
-                        input_indices[in_dim] = 0;                                                 \
-                    } else {                                                                       \
-                        input_indices[in_dim] =                                                    \
-                            (out_idx < output_shape_len) ? output_indices[out_idx] : 0;            \
-                        out_idx++;                                                                 \
-                    }                                                                              \
-                }                                                                                  \
-            }                                                                                      \
-                                                                                                   \
-            for (size_t reduced_idx = 0; reduced_idx < reduce_size; reduced_idx++) {               \
-                size_t temp_reduced = reduced_idx;                                                 \
-                for (int i = (int)num_reduce_dims - 1; i >= 0; i--) {                              \
-                    size_t dim = reduce_dims[i];                                                   \
-                    input_indices[dim] = temp_reduced % dims[dim];                                 \
-                    temp_reduced /= dims[dim];                                                     \
-                }                                                                                  \
-                                                                                                   \
-                size_t flat_index = offset;                                                        \
-                for (size_t i = 0; i < num_dims; i++) {                                            \
-                    flat_index += input_indices[i] * strides[i];                                   \
-                }                                                                                  \
-                                                                                                   \
-                if (!IS_NONZERO(input[flat_index])) {                                              \
-                    result = false;                                                                \
-                    break;                                                                         \
-                }                                                                                  \
-            }                                                                                      \
-                                                                                                   \
-            output[output_idx] = result;                                                           \
-        }                                                                                          \
-    }
+#define REDUCE_ALL_OP(IN_TYPE, TYPE_SUFFIX) REDUCE_BOOL_OP(all_##TYPE_SUFFIX, IN_TYPE, false)
 
 REDUCE_ANY_OP(bool, bool)
 REDUCE_ANY_OP(f8e4m3_t, f8e4m3)
 REDUCE_ANY_OP(f8e5m2_t, f8e5m2)
 REDUCE_ANY_OP(bf16_t, bf16)
 REDUCE_ANY_OP(f16_t, f16)
-REDUCE_ANY_OP(f32_t, f32)
+REDUCE_BOOL_F32_OP(any_f32, true)
 REDUCE_ANY_OP(f64_t, f64)
 REDUCE_ANY_OP(int8_t, i8)
 REDUCE_ANY_OP(int16_t, i16)
@@ -2815,7 +1548,7 @@ REDUCE_ALL_OP(f8e4m3_t, f8e4m3)
 REDUCE_ALL_OP(f8e5m2_t, f8e5m2)
 REDUCE_ALL_OP(bf16_t, bf16)
 REDUCE_ALL_OP(f16_t, f16)
-REDUCE_ALL_OP(f32_t, f32)
+REDUCE_BOOL_F32_OP(all_f32, false)
 REDUCE_ALL_OP(f64_t, f64)
 REDUCE_ALL_OP(int8_t, i8)
 REDUCE_ALL_OP(int16_t, i16)
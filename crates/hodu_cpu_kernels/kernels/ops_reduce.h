@@ -114,7 +114,7 @@ void hodu_cpu_prod_u32(const void *input, void *output, const size_t *metadata);
 void hodu_cpu_prod_u64(const void *input, void *output, const size_t *metadata);
 
 // Standard deviation operations (population std, float types only)
-// Computes: sqrt(E[X²] - E[X]²)
+// Computes: sqrt(M2 / n) from Welford/Chan central moments (no E[X²] - E[X]² cancellation)
 void hodu_cpu_std_f8e4m3(const void *input, void *output, const size_t *metadata);
 void hodu_cpu_std_f8e5m2(const void *input, void *output, const size_t *metadata);
 void hodu_cpu_std_bf16(const void *input, void *output, const size_t *metadata);
@@ -123,7 +123,7 @@ void hodu_cpu_std_f32(const void *input, void *output, const size_t *metadata);
 void hodu_cpu_std_f64(const void *input, void *output, const size_t *metadata);
 
 // Variance operations (population variance, float types only)
-// Computes: E[X²] - E[X]²
+// Computes: M2 / n from Welford/Chan central moments (no E[X²] - E[X]² cancellation)
 void hodu_cpu_var_f8e4m3(const void *input, void *output, const size_t *metadata);
 void hodu_cpu_var_f8e5m2(const void *input, void *output, const size_t *metadata);
 void hodu_cpu_var_bf16(const void *input, void *output, const size_t *metadata);
@@ -204,7 +204,7 @@ void hodu_cpu_argmin_i64(const void *input, void *output, const size_t *metadata
 // Returns true if any element is non-zero
 void hodu_cpu_any_bool(const void *input_ptr, void *output_ptr, const size_t *metadata);
 void hodu_cpu_any_f8e4m3(const void *input_ptr, void *output_ptr, const size_t *metadata);
-void hodu_cpu_any_f8e5m4(const void *input_ptr, void *output_ptr, const size_t *metadata);
+void hodu_cpu_any_f8e5m2(const void *input_ptr, void *output_ptr, const size_t *metadata);
 void hodu_cpu_any_bf16(const void *input_ptr, void *output_ptr, const size_t *metadata);
 void hodu_cpu_any_f16(const void *input_ptr, void *output_ptr, const size_t *metadata);
 void hodu_cpu_any_f32(const void *input_ptr, void *output_ptr, const size_t *metadata);
@@ -222,7 +222,7 @@ void hodu_cpu_any_i64(const void *input_ptr, void *output_ptr, const size_t *met
 // Returns true if all elements are non-zero
 void hodu_cpu_all_bool(const void *input_ptr, void *output_ptr, const size_t *metadata);
 void hodu_cpu_all_f8e4m3(const void *input_ptr, void *output_ptr, const size_t *metadata);
-void hodu_cpu_all_f8e5m4(const void *input_ptr, void *output_ptr, const size_t *metadata);
+void hodu_cpu_all_f8e5m2(const void *input_ptr, void *output_ptr, const size_t *metadata);
 void hodu_cpu_all_bf16(const void *input_ptr, void *output_ptr, const size_t *metadata);
 void hodu_cpu_all_f16(const void *input_ptr, void *output_ptr, const size_t *metadata);
 void hodu_cpu_all_f32(const void *input_ptr, void *output_ptr, const size_t *metadata);
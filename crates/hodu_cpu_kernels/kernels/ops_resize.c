@@ -1,6 +1,14 @@
 #include "ops_resize.h"
+#include "profile.h"
+#include "simd_utils.h"
+#include "thread_utils.h"
 #include "types.h"
+#include "utils.h"
+#include "workspace.h"
 #include <math.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
 
 // Metadata layout:
 // [0]: output_size (total elements)
@@ -66,15 +74,6 @@ static inline size_t round_nearest(float coord, size_t max_idx, int nearest_mode
     return (size_t)rounded;
 }
 
-static inline float cubic_interp(float p0, float p1, float p2, float p3, float t) {
-    // Cubic interpolation using Catmull-Rom spline
-    float a = -0.5f * p0 + 1.5f * p1 - 1.5f * p2 + 0.5f * p3;
-    float b = p0 - 2.5f * p1 + 2.0f * p2 - 0.5f * p3;
-    float c = -0.5f * p0 + 0.5f * p2;
-    float d = p1;
-    return a * t * t * t + b * t * t + c * t + d;
-}
-
 static inline size_t clamp_idx(int idx, size_t max_idx) {
     if (idx < 0)
         return 0;
@@ -83,334 +82,588 @@ static inline size_t clamp_idx(int idx, size_t max_idx) {
     return (size_t)idx;
 }
 
-#define IMPL_RESIZE(TYPE, TYPE_SUFFIX)                                                             \
-    void hodu_cpu_resize_##TYPE_SUFFIX(const void *input, void *output, const size_t *metadata) {  \
-        const size_t output_size = metadata[0];                                                    \
-        const size_t num_dims = metadata[1];                                                       \
-        const size_t *in_shape = &metadata[2];                                                     \
-        const size_t *in_strides = &metadata[2 + num_dims];                                        \
-        const size_t offset = metadata[2 + 2 * num_dims];                                          \
-        const size_t *out_shape = &metadata[3 + 2 * num_dims];                                     \
-        const int mode = (int)metadata[3 + 3 * num_dims];                                          \
-        const int coord_transform = (int)metadata[4 + 3 * num_dims];                               \
-        const int nearest_mode = (int)metadata[5 + 3 * num_dims];                                  \
-                                                                                                   \
-        const TYPE *in = (const TYPE *)input + offset;                                             \
-        TYPE *out = (TYPE *)output;                                                                \
-                                                                                                   \
-        /* Compute output strides */                                                               \
-        size_t out_strides[16];                                                                    \
-        out_strides[num_dims - 1] = 1;                                                             \
-        for (size_t d = num_dims - 1; d > 0; d--) {                                                \
-            out_strides[d - 1] = out_strides[d] * out_shape[d];                                    \
-        }                                                                                          \
-                                                                                                   \
-        /* For NCHW format: N=0, C=1, spatial dims start at 2 */                                   \
-        const size_t spatial_start = 2;                                                            \
-        const size_t num_spatial = num_dims - spatial_start;                                       \
-                                                                                                   \
-        for (size_t out_idx = 0; out_idx < output_size; out_idx++) {                               \
-            /* Compute output coordinates */                                                       \
-            size_t out_coords[16];                                                                 \
-            size_t tmp = out_idx;                                                                  \
-            for (size_t d = num_dims; d > 0; d--) {                                                \
-                out_coords[d - 1] = tmp % out_shape[d - 1];                                        \
-                tmp /= out_shape[d - 1];                                                           \
+// Channels-last tensors ([N, spatial..., C]) are planned through their channels-first view:
+// shapes and strides are rotated to [N, C, spatial...] order, and the plan then keeps C
+// innermost in every row so the output is written channels-last.
+typedef struct {
+    size_t in_shape[16];
+    size_t in_strides[16];
+    size_t out_shape[16];
+} resize_view_t;
+
+// Move the last of dims[1..num_dims) to position 1
+static inline void resize_rotate_channels(size_t *dims, size_t num_dims) {
+    if (num_dims < 3) {
+        return;
+    }
+    const size_t channels = dims[num_dims - 1];
+    memmove(dims + 2, dims + 1, (num_dims - 2) * sizeof(size_t));
+    dims[1] = channels;
+}
+
+static void resize_view_channels_first(resize_view_t *view, const size_t *in_shape,
+                                       const size_t *in_strides, const size_t *out_shape,
+                                       size_t num_dims) {
+    memcpy(view->in_shape, in_shape, num_dims * sizeof(size_t));
+    memcpy(view->in_strides, in_strides, num_dims * sizeof(size_t));
+    memcpy(view->out_shape, out_shape, num_dims * sizeof(size_t));
+    resize_rotate_channels(view->in_shape, num_dims);
+    resize_rotate_channels(view->in_strides, num_dims);
+    resize_rotate_channels(view->out_shape, num_dims);
+}
+
+
+// ============================================================================
+// SEPARABLE RESIZE ENGINE
+// ============================================================================
+//
+// Every output element is a weighted sum over a few taps per spatial axis (1 for
+// nearest, 2 for linear, 4 for cubic), so the plan precomputes once per axis the
+// input offsets and weights of every output coordinate. The innermost spatial axis
+// runs first: each input row an output row needs is resampled to the output width
+// ("horizontal" pass). The other axes then combine whole resampled rows ("vertical"
+// pass, SIMD over the contiguous output row). Resampled rows are cached, so an input
+// row is resampled once for all the consecutive output rows that read it.
+//
+// Output rows of all planes run on the thread pool. A plane is one (n, c) image for
+// channels-first tensors and one n for channels-last ones, whose rows hold W * C
+// elements with each tap moving C channels.
+//
+// Float types accumulate in f32 in the order of the per-axis formulas (bilinear and
+// trilinear match the direct 2x2 / 2x2x2 evaluation exactly). u8 uses RESIZE_Q_BITS
+// fixed-point weights with 16-bit intermediate rows and rounds to nearest. Nearest
+// (and modes without an interpolating kernel for the rank) copies elements as is.
+
+#define RESIZE_MAX_TAPS 4
+#define RESIZE_CACHE_SLOTS 8
+// u8 weights: Q14; horizontal sums are narrowed to Q6 (RESIZE_H_SHIFT) 16-bit rows
+#define RESIZE_Q_BITS 14
+#define RESIZE_H_SHIFT 8
+#define RESIZE_ROW_BITS (RESIZE_Q_BITS - RESIZE_H_SHIFT)
+// Target element-taps per pool task
+#define RESIZE_TASK_WORK ((size_t)1 << 16)
+
+typedef struct {
+    size_t out_size;
+    size_t taps;
+    const size_t *offset; // [out_size * taps] input element offsets (index * stride)
+    const float *weight;  // [out_size * taps]
+    const int16_t *weight_q; // [out_size * taps] Q RESIZE_Q_BITS, each set summing to one
+} resize_axis_t;
+
+typedef struct {
+    const void *in; // input + offset
+    void *out;
+    size_t elem_size;
+    size_t planes;
+    size_t plane_channels; // channels per batch in the plane index (1 when channels-last)
+    size_t batch_stride;
+    size_t channel_stride;
+    size_t channels; // channels per row element (1 when channels-first)
+    size_t rows;     // output rows per plane
+    size_t row_len;  // out_width * channels
+    size_t row_axes; // spatial axes above the innermost; axis[row_axes] is the width
+    resize_axis_t axis[16];
+} resize_plan_t;
+
+// Input offset of plane p
+static inline size_t resize_plane_offset(const resize_plan_t *plan, size_t p) {
+    return (p / plan->plane_channels) * plan->batch_stride +
+           (p % plan->plane_channels) * plan->channel_stride;
+}
+
+// Tap offsets and weights for one axis
+static void resize_axis_init(size_t *offset, float *weight, int16_t *weight_q, size_t in_size,
+                             size_t out_size, size_t stride, int mode, int coord_transform,
+                             int nearest_mode) {
+    const size_t taps = mode == RESIZE_MODE_CUBIC ? 4 : mode == RESIZE_MODE_LINEAR ? 2 : 1;
+    for (size_t o = 0; o < out_size; o++) {
+        const float coord = transform_coord((float)o, in_size, out_size, coord_transform);
+        size_t *off = offset + o * taps;
+        float *w = weight + o * taps;
+        if (taps == 1) {
+            off[0] = round_nearest(coord, in_size - 1, nearest_mode) * stride;
+            w[0] = 1.0f;
+        } else {
+            const int i0 = (int)floorf(coord);
+            const float t = coord - (float)i0;
+            if (taps == 2) {
+                w[0] = 1.0f - t;
+                w[1] = t;
+            } else {
+                /* Catmull-Rom (a = -0.5) */
+                w[0] = ((-0.5f * t + 1.0f) * t - 0.5f) * t;
+                w[1] = (1.5f * t - 2.5f) * t * t + 1.0f;
+                w[2] = ((-1.5f * t + 2.0f) * t + 0.5f) * t;
+                w[3] = (0.5f * t - 0.5f) * t * t;
+            }
+            const int first = taps == 2 ? i0 : i0 - 1;
+            for (size_t k = 0; k < taps; k++) {
+                off[k] = clamp_idx(first + (int)k, in_size - 1) * stride;
+            }
+        }
+        // Fixed-point weights, rounding error folded into the largest tap
+        int16_t *wq = weight_q + o * taps;
+        int sum = 0;
+        size_t big = 0;
+        for (size_t k = 0; k < taps; k++) {
+            wq[k] = (int16_t)lrintf(w[k] * (float)(1 << RESIZE_Q_BITS));
+            sum += wq[k];
+            big = fabsf(w[k]) > fabsf(w[big]) ? k : big;
+        }
+        wq[big] = (int16_t)(wq[big] + (1 << RESIZE_Q_BITS) - sum);
+    }
+}
+
+// Output row r of a plane -> coordinates of the row axes (outermost first)
+static inline void resize_row_coords(const resize_plan_t *plan, size_t r, size_t *coords) {
+    for (size_t a = plan->row_axes; a-- > 0;) {
+        coords[a] = r % plan->axis[a].out_size;
+        r /= plan->axis[a].out_size;
+    }
+}
+
+// Small cache of resampled rows keyed by input row offset. Each output row advances the
+// clock; slots stamped with the current clock are in use and never evicted.
+typedef struct {
+    size_t key[RESIZE_CACHE_SLOTS];
+    size_t stamp[RESIZE_CACHE_SLOTS];
+    size_t slots;
+    size_t clock;
+} resize_cache_t;
+
+static inline void resize_cache_init(resize_cache_t *cache, size_t slots) {
+    cache->slots = slots;
+    cache->clock = 1;
+    for (size_t s = 0; s < slots; s++) {
+        cache->key[s] = SIZE_MAX;
+        cache->stamp[s] = 0;
+    }
+}
+
+// Slot holding row `key`; *hit is false when the caller must fill it
+static inline size_t resize_cache_slot(resize_cache_t *cache, size_t key, bool *hit) {
+    size_t victim = 0;
+    for (size_t s = 0; s < cache->slots; s++) {
+        if (cache->key[s] == key) {
+            cache->stamp[s] = cache->clock;
+            *hit = true;
+            return s;
+        }
+        if (cache->stamp[s] < cache->stamp[victim]) {
+            victim = s;
+        }
+    }
+    cache->key[victim] = key;
+    cache->stamp[victim] = cache->clock;
+    *hit = false;
+    return victim;
+}
+
+// dst = sum_t w[t] * rows[t], in tap order
+static void resize_combine_f32(const float *const *rows, const float *w, size_t taps, size_t n,
+                               float *dst) {
+    size_t i = 0;
+#if SIMD_F32_WIDTH > 1
+    for (; i + SIMD_F32_WIDTH <= n; i += SIMD_F32_WIDTH) {
+        simd_f32_t acc = simd_f32_mul(simd_f32_set1(w[0]), simd_f32_load(rows[0] + i));
+        for (size_t t = 1; t < taps; t++) {
+            acc = simd_f32_add(acc, simd_f32_mul(simd_f32_set1(w[t]), simd_f32_load(rows[t] + i)));
+        }
+        simd_f32_store(dst + i, acc);
+    }
+#endif
+    for (; i < n; i++) {
+        float acc = w[0] * rows[0][i];
+        for (size_t t = 1; t < taps; t++) {
+            acc += w[t] * rows[t][i];
+        }
+        dst[i] = acc;
+    }
+}
+
+// dst = sum_t w[t] * rows[t] on Q RESIZE_ROW_BITS rows, narrowed back to Q RESIZE_ROW_BITS
+// (2 or 4 taps)
+static void resize_combine_q(const int16_t *const *rows, const int16_t *w, size_t taps, size_t n,
+                             int16_t *restrict dst) {
+    const int16_t *restrict r0 = rows[0], *restrict r1 = rows[1];
+    const int32_t w0 = w[0], w1 = w[1];
+    const int32_t half = (int32_t)1 << (RESIZE_Q_BITS - 1);
+    if (taps == 2) {
+        for (size_t i = 0; i < n; i++) {
+            dst[i] = (int16_t)((w0 * r0[i] + w1 * r1[i] + half) >> RESIZE_Q_BITS);
+        }
+        return;
+    }
+    const int16_t *restrict r2 = rows[2], *restrict r3 = rows[3];
+    const int32_t w2 = w[2], w3 = w[3];
+    for (size_t i = 0; i < n; i++) {
+        dst[i] =
+            (int16_t)((w0 * r0[i] + w1 * r1[i] + w2 * r2[i] + w3 * r3[i] + half) >> RESIZE_Q_BITS);
+    }
+}
+
+// Same as resize_combine_q, rounded to u8 with saturation
+static void resize_combine_u8(const int16_t *const *rows, const int16_t *w, size_t taps, size_t n,
+                              uint8_t *restrict dst) {
+    const int shift = RESIZE_Q_BITS + RESIZE_ROW_BITS;
+    const int16_t *restrict r0 = rows[0], *restrict r1 = rows[1];
+    const int32_t w0 = w[0], w1 = w[1];
+    const int32_t half = (int32_t)1 << (shift - 1);
+    if (taps == 2) {
+        for (size_t i = 0; i < n; i++) {
+            const int32_t v = (w0 * r0[i] + w1 * r1[i] + half) >> shift;
+            dst[i] = (uint8_t)(v < 0 ? 0 : v > 255 ? 255 : v);
+        }
+        return;
+    }
+    const int16_t *restrict r2 = rows[2], *restrict r3 = rows[3];
+    const int32_t w2 = w[2], w3 = w[3];
+    for (size_t i = 0; i < n; i++) {
+        const int32_t v = (w0 * r0[i] + w1 * r1[i] + w2 * r2[i] + w3 * r3[i] + half) >> shift;
+        dst[i] = (uint8_t)(v < 0 ? 0 : v > 255 ? 255 : v);
+    }
+}
+
+// Copies the selected element of every output position (nearest, any element size)
+#define RESIZE_GATHER(T)                                                                           \
+    do {                                                                                           \
+        const T *src = (const T *)plan->in + row_off;                                              \
+        T *dst = (T *)plan->out + g * plan->row_len;                                               \
+        if (ch == 1) {                                                                             \
+            for (size_t x = 0; x < wa->out_size; x++) {                                            \
+                dst[x] = src[wa->offset[x]];                                                       \
             }                                                                                      \
-                                                                                                   \
-            /* Batch and channel indices stay the same */                                          \
-            size_t base_in_idx = out_coords[0] * in_strides[0] + out_coords[1] * in_strides[1];    \
-                                                                                                   \
-            if (mode == RESIZE_MODE_NEAREST) {                                                     \
-                size_t in_idx = base_in_idx;                                                       \
-                for (size_t s = 0; s < num_spatial; s++) {                                         \
-                    size_t d = spatial_start + s;                                                  \
-                    float coord = transform_coord((float)out_coords[d], in_shape[d], out_shape[d], \
-                                                  coord_transform);                                \
-                    size_t src_idx = round_nearest(coord, in_shape[d] - 1, nearest_mode);          \
-                    in_idx += src_idx * in_strides[d];                                             \
+        } else {                                                                                   \
+            for (size_t x = 0; x < wa->out_size; x++) {                                            \
+                for (size_t c = 0; c < ch; c++) {                                                  \
+                    dst[x * ch + c] = src[wa->offset[x] + c * cs];                                 \
                 }                                                                                  \
-                out[out_idx] = in[in_idx];                                                         \
-            } else if (mode == RESIZE_MODE_LINEAR && num_spatial == 2) {                           \
-                /* Bilinear interpolation for 2D */                                                \
-                float y_coord = transform_coord((float)out_coords[2], in_shape[2], out_shape[2],   \
-                                                coord_transform);                                  \
-                float x_coord = transform_coord((float)out_coords[3], in_shape[3], out_shape[3],   \
-                                                coord_transform);                                  \
-                                                                                                   \
-                int y0 = (int)floorf(y_coord);                                                     \
-                int x0 = (int)floorf(x_coord);                                                     \
-                int y1 = y0 + 1;                                                                   \
-                int x1 = x0 + 1;                                                                   \
-                                                                                                   \
-                float fy = y_coord - (float)y0;                                                    \
-                float fx = x_coord - (float)x0;                                                    \
-                                                                                                   \
-                size_t y0c = clamp_idx(y0, in_shape[2] - 1);                                       \
-                size_t y1c = clamp_idx(y1, in_shape[2] - 1);                                       \
-                size_t x0c = clamp_idx(x0, in_shape[3] - 1);                                       \
-                size_t x1c = clamp_idx(x1, in_shape[3] - 1);                                       \
-                                                                                                   \
-                TYPE v00 = in[base_in_idx + y0c * in_strides[2] + x0c * in_strides[3]];            \
-                TYPE v01 = in[base_in_idx + y0c * in_strides[2] + x1c * in_strides[3]];            \
-                TYPE v10 = in[base_in_idx + y1c * in_strides[2] + x0c * in_strides[3]];            \
-                TYPE v11 = in[base_in_idx + y1c * in_strides[2] + x1c * in_strides[3]];            \
-                                                                                                   \
-                TYPE result = (TYPE)((1.0f - fy) * ((1.0f - fx) * (float)v00 + fx * (float)v01) +  \
-                                     fy * ((1.0f - fx) * (float)v10 + fx * (float)v11));           \
-                out[out_idx] = result;                                                             \
-            } else if (mode == RESIZE_MODE_LINEAR && num_spatial == 3) {                           \
-                /* Trilinear interpolation for 3D */                                               \
-                float d_coord = transform_coord((float)out_coords[2], in_shape[2], out_shape[2],   \
-                                                coord_transform);                                  \
-                float h_coord = transform_coord((float)out_coords[3], in_shape[3], out_shape[3],   \
-                                                coord_transform);                                  \
-                float w_coord = transform_coord((float)out_coords[4], in_shape[4], out_shape[4],   \
-                                                coord_transform);                                  \
-                                                                                                   \
-                int d0 = (int)floorf(d_coord);                                                     \
-                int h0 = (int)floorf(h_coord);                                                     \
-                int w0 = (int)floorf(w_coord);                                                     \
-                int d1 = d0 + 1, h1 = h0 + 1, w1 = w0 + 1;                                         \
-                                                                                                   \
-                float fd = d_coord - (float)d0;                                                    \
-                float fh = h_coord - (float)h0;                                                    \
-                float fw = w_coord - (float)w0;                                                    \
-                                                                                                   \
-                size_t d0c = clamp_idx(d0, in_shape[2] - 1);                                       \
-                size_t d1c = clamp_idx(d1, in_shape[2] - 1);                                       \
-                size_t h0c = clamp_idx(h0, in_shape[3] - 1);                                       \
-                size_t h1c = clamp_idx(h1, in_shape[3] - 1);                                       \
-                size_t w0c = clamp_idx(w0, in_shape[4] - 1);                                       \
-                size_t w1c = clamp_idx(w1, in_shape[4] - 1);                                       \
-                                                                                                   \
-                TYPE v000 = in[base_in_idx + d0c * in_strides[2] + h0c * in_strides[3] +           \
-                               w0c * in_strides[4]];                                               \
-                TYPE v001 = in[base_in_idx + d0c * in_strides[2] + h0c * in_strides[3] +           \
-                               w1c * in_strides[4]];                                               \
-                TYPE v010 = in[base_in_idx + d0c * in_strides[2] + h1c * in_strides[3] +           \
-                               w0c * in_strides[4]];                                               \
-                TYPE v011 = in[base_in_idx + d0c * in_strides[2] + h1c * in_strides[3] +           \
-                               w1c * in_strides[4]];                                               \
-                TYPE v100 = in[base_in_idx + d1c * in_strides[2] + h0c * in_strides[3] +           \
-                               w0c * in_strides[4]];                                               \
-                TYPE v101 = in[base_in_idx + d1c * in_strides[2] + h0c * in_strides[3] +           \
-                               w1c * in_strides[4]];                                               \
-                TYPE v110 = in[base_in_idx + d1c * in_strides[2] + h1c * in_strides[3] +           \
-                               w0c * in_strides[4]];                                               \
-                TYPE v111 = in[base_in_idx + d1c * in_strides[2] + h1c * in_strides[3] +           \
-                               w1c * in_strides[4]];                                               \
-                                                                                                   \
-                float c00 = (1.0f - fw) * (float)v000 + fw * (float)v001;                          \
-                float c01 = (1.0f - fw) * (float)v010 + fw * (float)v011;                          \
-                float c10 = (1.0f - fw) * (float)v100 + fw * (float)v101;                          \
-                float c11 = (1.0f - fw) * (float)v110 + fw * (float)v111;                          \
-                float c0 = (1.0f - fh) * c00 + fh * c01;                                           \
-                float c1 = (1.0f - fh) * c10 + fh * c11;                                           \
-                out[out_idx] = (TYPE)((1.0f - fd) * c0 + fd * c1);                                 \
-            } else if (mode == RESIZE_MODE_CUBIC && num_spatial == 2) {                            \
-                /* Bicubic interpolation for 2D */                                                 \
-                float y_coord = transform_coord((float)out_coords[2], in_shape[2], out_shape[2],   \
-                                                coord_transform);                                  \
-                float x_coord = transform_coord((float)out_coords[3], in_shape[3], out_shape[3],   \
-                                                coord_transform);                                  \
-                                                                                                   \
-                int y0 = (int)floorf(y_coord);                                                     \
-                int x0 = (int)floorf(x_coord);                                                     \
-                float fy = y_coord - (float)y0;                                                    \
-                float fx = x_coord - (float)x0;                                                    \
-                                                                                                   \
-                float cols[4];                                                                     \
-                for (int j = -1; j <= 2; j++) {                                                    \
-                    size_t yc = clamp_idx(y0 + j, in_shape[2] - 1);                                \
-                    float p0 = (float)in[base_in_idx + yc * in_strides[2] +                        \
-                                         clamp_idx(x0 - 1, in_shape[3] - 1) * in_strides[3]];      \
-                    float p1 = (float)in[base_in_idx + yc * in_strides[2] +                        \
-                                         clamp_idx(x0, in_shape[3] - 1) * in_strides[3]];          \
-                    float p2 = (float)in[base_in_idx + yc * in_strides[2] +                        \
-                                         clamp_idx(x0 + 1, in_shape[3] - 1) * in_strides[3]];      \
-                    float p3 = (float)in[base_in_idx + yc * in_strides[2] +                        \
-                                         clamp_idx(x0 + 2, in_shape[3] - 1) * in_strides[3]];      \
-                    cols[j + 1] = cubic_interp(p0, p1, p2, p3, fx);                                \
+            }                                                                                      \
+        }                                                                                          \
+    } while (0)
+
+static void resize_nearest_worker(size_t start, size_t end, void *arg) {
+    const resize_plan_t *plan = (const resize_plan_t *)arg;
+    const resize_axis_t *wa = &plan->axis[plan->row_axes];
+    const size_t ch = plan->channels;
+    const size_t cs = plan->channel_stride;
+    size_t coords[16];
+    for (size_t g = start; g < end; g++) {
+        resize_row_coords(plan, g % plan->rows, coords);
+        size_t row_off = resize_plane_offset(plan, g / plan->rows);
+        for (size_t a = 0; a < plan->row_axes; a++) {
+            row_off += plan->axis[a].offset[coords[a]];
+        }
+        switch (plan->elem_size) {
+        case 1:
+            RESIZE_GATHER(uint8_t);
+            break;
+        case 2:
+            RESIZE_GATHER(uint16_t);
+            break;
+        case 4:
+            RESIZE_GATHER(uint32_t);
+            break;
+        default:
+            RESIZE_GATHER(uint64_t);
+            break;
+        }
+    }
+}
+
+/// Interpolating worker of one row type (2 or 3 spatial axes: one or two row axes)
+///
+/// @param NAME Worker name suffix
+/// @param TYPE Element type
+/// @param ROW_T Resampled row element (float, or Q RESIZE_ROW_BITS int16_t for u8)
+/// @param HROW Horizontal pass: HROW(src, wa, ch, cs, dst)
+/// @param COMBINE Row combine into a ROW_T row: COMBINE(rows, w, taps, n, dst)
+/// @param FINISH Last combine into the output row:
+///        FINISH(rows, w, taps, n, (TYPE *)dst_row, (ROW_T *)tmp)
+/// @param WEIGHT Axis weight table (weight or weight_q)
+#define RESIZE_INTERP_WORKER(NAME, TYPE, ROW_T, HROW, COMBINE, FINISH, WEIGHT)                     \
+    static void resize_interp_##NAME##_worker(size_t start, size_t end, void *arg) {               \
+        const resize_plan_t *plan = (const resize_plan_t *)arg;                                    \
+        const TYPE *in = (const TYPE *)plan->in;                                                   \
+        TYPE *out = (TYPE *)plan->out;                                                             \
+        const size_t len = plan->row_len;                                                          \
+        const resize_axis_t *wa = &plan->axis[plan->row_axes];                                     \
+        const resize_axis_t *ha = &plan->axis[plan->row_axes - 1];                                 \
+        const resize_axis_t *da = plan->row_axes == 2 ? &plan->axis[0] : NULL;                     \
+        const size_t th = ha->taps;                                                                \
+        const size_t td = da ? da->taps : 1;                                                       \
+        const size_t slots = MINIMUM(2 * th * td, (size_t)RESIZE_CACHE_SLOTS);                     \
+        /* Row stride keeps every row 64-byte aligned for the vector loads */                      \
+        const size_t stride =                                                                      \
+            hodu_cpu_workspace_block_size(len * sizeof(ROW_T)) / sizeof(ROW_T);                    \
+        ROW_T *ws = (ROW_T *)workspace_acquire((slots + td + 1) * stride * sizeof(ROW_T));         \
+        if (!ws) {                                                                                 \
+            return;                                                                                \
+        }                                                                                          \
+        ROW_T *stage = ws + slots * stride;                                                        \
+        ROW_T *tmp = stage + td * stride;                                                          \
+        resize_cache_t cache;                                                                      \
+        resize_cache_init(&cache, slots);                                                          \
+                                                                                                   \
+        for (size_t g = start; g < end; g++) {                                                     \
+            const size_t r = g % plan->rows;                                                       \
+            const size_t oh = r % ha->out_size;                                                    \
+            const size_t od = r / ha->out_size;                                                    \
+            const size_t plane_off = resize_plane_offset(plan, g / plan->rows);                    \
+            const ROW_T *stage_rows[RESIZE_MAX_TAPS] = {0};                                        \
+            cache.clock++;                                                                         \
+            for (size_t j = 0; j < td; j++) {                                                      \
+                const size_t base = plane_off + (da ? da->offset[od * td + j] : 0);                \
+                const ROW_T *rows[RESIZE_MAX_TAPS] = {0};                                          \
+                for (size_t t = 0; t < th; t++) {                                                  \
+                    const size_t key = base + ha->offset[oh * th + t];                             \
+                    bool hit;                                                                      \
+                    ROW_T *row = ws + resize_cache_slot(&cache, key, &hit) * stride;               \
+                    if (!hit) {                                                                    \
+                        HROW(in + key, wa, plan->channels, plan->channel_stride, row);             \
+                    }                                                                              \
+                    rows[t] = row;                                                                 \
                 }                                                                                  \
-                out[out_idx] = (TYPE)cubic_interp(cols[0], cols[1], cols[2], cols[3], fy);         \
-            } else {                                                                               \
-                /* Fallback: nearest neighbor */                                                   \
-                size_t in_idx = base_in_idx;                                                       \
-                for (size_t s = 0; s < num_spatial; s++) {                                         \
-                    size_t d = spatial_start + s;                                                  \
-                    float coord = transform_coord((float)out_coords[d], in_shape[d], out_shape[d], \
-                                                  coord_transform);                                \
-                    size_t src_idx = round_nearest(coord, in_shape[d] - 1, nearest_mode);          \
-                    in_idx += src_idx * in_strides[d];                                             \
+                if (td == 1) {                                                                     \
+                    FINISH(rows, ha->WEIGHT + oh * th, th, len, out + g * len, tmp);               \
+                } else {                                                                           \
+                    COMBINE(rows, ha->WEIGHT + oh * th, th, len, stage + j * stride);              \
+                    stage_rows[j] = stage + j * stride;                                            \
                 }                                                                                  \
-                out[out_idx] = in[in_idx];                                                         \
+            }                                                                                      \
+            if (td > 1) {                                                                          \
+                FINISH(stage_rows, da->WEIGHT + od * td, td, len, out + g * len, tmp);             \
             }                                                                                      \
         }                                                                                          \
+        workspace_release(ws);                                                                     \
     }
 
-IMPL_RESIZE(f32_t, f32)
-IMPL_RESIZE(f64_t, f64)
+static void resize_run(const void *input, void *output, const size_t *metadata,
+                       bool channels_last, size_t elem_size, parallel_for_fn interp_worker) {
+    const size_t output_size = metadata[0];
+    const size_t num_dims = metadata[1];
+    const size_t *in_shape = &metadata[2];
+    const size_t *in_strides = &metadata[2 + num_dims];
+    const size_t offset = metadata[2 + 2 * num_dims];
+    const size_t *out_shape = &metadata[3 + 2 * num_dims];
+    const int mode = (int)metadata[3 + 3 * num_dims];
+    const int coord_transform = (int)metadata[4 + 3 * num_dims];
+    const int nearest_mode = (int)metadata[5 + 3 * num_dims];
+    if (output_size == 0 || num_dims < 2) {
+        return;
+    }
 
-#define IMPL_RESIZE_CONVERT(TYPE, TYPE_SUFFIX, TO_FLOAT, FROM_FLOAT)                               \
-    void hodu_cpu_resize_##TYPE_SUFFIX(const void *input, void *output, const size_t *metadata) {  \
-        const size_t output_size = metadata[0];                                                    \
-        const size_t num_dims = metadata[1];                                                       \
-        const size_t *in_shape = &metadata[2];                                                     \
-        const size_t *in_strides = &metadata[2 + num_dims];                                        \
-        const size_t offset = metadata[2 + 2 * num_dims];                                          \
-        const size_t *out_shape = &metadata[3 + 2 * num_dims];                                     \
-        const int mode = (int)metadata[3 + 3 * num_dims];                                          \
-        const int coord_transform = (int)metadata[4 + 3 * num_dims];                               \
-        const int nearest_mode = (int)metadata[5 + 3 * num_dims];                                  \
-                                                                                                   \
-        const TYPE *in = (const TYPE *)input + offset;                                             \
-        TYPE *out = (TYPE *)output;                                                                \
-                                                                                                   \
-        size_t out_strides[16];                                                                    \
-        out_strides[num_dims - 1] = 1;                                                             \
-        for (size_t d = num_dims - 1; d > 0; d--) {                                                \
-            out_strides[d - 1] = out_strides[d] * out_shape[d];                                    \
-        }                                                                                          \
-                                                                                                   \
-        const size_t spatial_start = 2;                                                            \
-        const size_t num_spatial = num_dims - spatial_start;                                       \
-                                                                                                   \
-        for (size_t out_idx = 0; out_idx < output_size; out_idx++) {                               \
-            size_t out_coords[16];                                                                 \
-            size_t tmp = out_idx;                                                                  \
-            for (size_t d = num_dims; d > 0; d--) {                                                \
-                out_coords[d - 1] = tmp % out_shape[d - 1];                                        \
-                tmp /= out_shape[d - 1];                                                           \
+    resize_view_t view;
+    if (channels_last) {
+        resize_view_channels_first(&view, in_shape, in_strides, out_shape, num_dims);
+        in_shape = view.in_shape;
+        in_strides = view.in_strides;
+        out_shape = view.out_shape;
+    }
+
+    /* For NCHW format: N=0, C=1, spatial dims start at 2 */
+    const size_t num_spatial = num_dims - 2;
+    const bool interp = (mode == RESIZE_MODE_LINEAR && (num_spatial == 2 || num_spatial == 3)) ||
+                        (mode == RESIZE_MODE_CUBIC && num_spatial == 2);
+    const int axis_mode = interp ? mode : RESIZE_MODE_NEAREST;
+    const size_t taps =
+        axis_mode == RESIZE_MODE_CUBIC ? 4 : axis_mode == RESIZE_MODE_LINEAR ? 2 : 1;
+
+    resize_plan_t plan;
+    plan.in = (const char *)input + offset * elem_size;
+    plan.out = output;
+    plan.elem_size = elem_size;
+    plan.planes = out_shape[0] * (channels_last ? 1 : out_shape[1]);
+    plan.plane_channels = channels_last ? 1 : out_shape[1];
+    plan.batch_stride = in_strides[0];
+    plan.channel_stride = in_strides[1];
+    plan.channels = channels_last ? out_shape[1] : 1;
+    plan.row_axes = num_spatial > 0 ? num_spatial - 1 : 0;
+
+    // One table block for all axes; without spatial dims the width is a single tap at 0
+    size_t entries = num_spatial > 0 ? 0 : 1;
+    for (size_t d = 2; d < num_dims; d++) {
+        entries += out_shape[d] * taps;
+    }
+    const size_t off_bytes = hodu_cpu_workspace_block_size(entries * sizeof(size_t));
+    const size_t w_bytes = hodu_cpu_workspace_block_size(entries * sizeof(float));
+    char *tables = (char *)workspace_acquire(off_bytes + w_bytes + entries * sizeof(int16_t));
+    if (!tables) {
+        return;
+    }
+    size_t *offsets = (size_t *)tables;
+    float *weights = (float *)(tables + off_bytes);
+    int16_t *weights_q = (int16_t *)(tables + off_bytes + w_bytes);
+    if (num_spatial == 0) {
+        offsets[0] = 0;
+        weights[0] = 1.0f;
+        weights_q[0] = 1 << RESIZE_Q_BITS;
+        plan.axis[0] = (resize_axis_t){1, 1, offsets, weights, weights_q};
+    }
+    for (size_t d = 2, a = 0; d < num_dims; d++, a++) {
+        resize_axis_init(offsets, weights, weights_q, in_shape[d], out_shape[d], in_strides[d],
+                         axis_mode, coord_transform, nearest_mode);
+        plan.axis[a] = (resize_axis_t){out_shape[d], taps, offsets, weights, weights_q};
+        offsets += out_shape[d] * taps;
+        weights += out_shape[d] * taps;
+        weights_q += out_shape[d] * taps;
+    }
+    plan.rows = 1;
+    for (size_t a = 0; a < plan.row_axes; a++) {
+        plan.rows *= plan.axis[a].out_size;
+    }
+    plan.row_len = plan.axis[plan.row_axes].out_size * plan.channels;
+
+    const size_t total_rows = plan.planes * plan.rows;
+    const size_t row_work = plan.row_len * (interp ? 2 * taps : 1);
+    parallel_for(0, total_rows, RESIZE_TASK_WORK / row_work + 1,
+                 interp ? interp_worker : resize_nearest_worker, &plan);
+    workspace_release(tables);
+}
+
+/// Horizontal pass and output stores of one float type (f32 accumulation)
+///
+/// @param TYPE Element type
+/// @param TYPE_SUFFIX Suffix for function naming
+/// @param TO_FLOAT Element to float conversion
+/// @param FROM_FLOAT Float to element conversion
+/// @param DIRECT 1 when TYPE is f32: the last combine writes the output row itself
+#define IMPL_RESIZE(TYPE, TYPE_SUFFIX, TO_FLOAT, FROM_FLOAT, DIRECT)                               \
+    static void resize_hrow_##TYPE_SUFFIX(const TYPE *src, const resize_axis_t *wa, size_t ch,     \
+                                          size_t cs, float *dst) {                                 \
+        const size_t taps = wa->taps;                                                              \
+        const size_t *off = wa->offset;                                                            \
+        const float *w = wa->weight;                                                               \
+        if (ch == 1 && taps == 2) {                                                                \
+            for (size_t x = 0; x < wa->out_size; x++) {                                            \
+                dst[x] = w[2 * x] * TO_FLOAT(src[off[2 * x]]) +                                    \
+                         w[2 * x + 1] * TO_FLOAT(src[off[2 * x + 1]]);                             \
             }                                                                                      \
-                                                                                                   \
-            size_t base_in_idx = out_coords[0] * in_strides[0] + out_coords[1] * in_strides[1];    \
-                                                                                                   \
-            if (mode == RESIZE_MODE_NEAREST) {                                                     \
-                size_t in_idx = base_in_idx;                                                       \
-                for (size_t s = 0; s < num_spatial; s++) {                                         \
-                    size_t d = spatial_start + s;                                                  \
-                    float coord = transform_coord((float)out_coords[d], in_shape[d], out_shape[d], \
-                                                  coord_transform);                                \
-                    size_t src_idx = round_nearest(coord, in_shape[d] - 1, nearest_mode);          \
-                    in_idx += src_idx * in_strides[d];                                             \
+        } else if (ch == 1) {                                                                      \
+            for (size_t x = 0; x < wa->out_size; x++) {                                            \
+                const size_t *o = off + x * taps;                                                  \
+                const float *wx = w + x * taps;                                                    \
+                float acc = wx[0] * TO_FLOAT(src[o[0]]);                                           \
+                for (size_t t = 1; t < taps; t++) {                                                \
+                    acc += wx[t] * TO_FLOAT(src[o[t]]);                                            \
                 }                                                                                  \
-                out[out_idx] = in[in_idx];                                                         \
-            } else if (mode == RESIZE_MODE_LINEAR && num_spatial == 2) {                           \
-                float y_coord = transform_coord((float)out_coords[2], in_shape[2], out_shape[2],   \
-                                                coord_transform);                                  \
-                float x_coord = transform_coord((float)out_coords[3], in_shape[3], out_shape[3],   \
-                                                coord_transform);                                  \
-                                                                                                   \
-                int y0 = (int)floorf(y_coord);                                                     \
-                int x0 = (int)floorf(x_coord);                                                     \
-                int y1 = y0 + 1;                                                                   \
-                int x1 = x0 + 1;                                                                   \
-                                                                                                   \
-                float fy = y_coord - (float)y0;                                                    \
-                float fx = x_coord - (float)x0;                                                    \
-                                                                                                   \
-                size_t y0c = clamp_idx(y0, in_shape[2] - 1);                                       \
-                size_t y1c = clamp_idx(y1, in_shape[2] - 1);                                       \
-                size_t x0c = clamp_idx(x0, in_shape[3] - 1);                                       \
-                size_t x1c = clamp_idx(x1, in_shape[3] - 1);                                       \
-                                                                                                   \
-                float v00 = TO_FLOAT(in[base_in_idx + y0c * in_strides[2] + x0c * in_strides[3]]); \
-                float v01 = TO_FLOAT(in[base_in_idx + y0c * in_strides[2] + x1c * in_strides[3]]); \
-                float v10 = TO_FLOAT(in[base_in_idx + y1c * in_strides[2] + x0c * in_strides[3]]); \
-                float v11 = TO_FLOAT(in[base_in_idx + y1c * in_strides[2] + x1c * in_strides[3]]); \
-                                                                                                   \
-                float result = (1.0f - fy) * ((1.0f - fx) * v00 + fx * v01) +                      \
-                               fy * ((1.0f - fx) * v10 + fx * v11);                                \
-                out[out_idx] = FROM_FLOAT(result);                                                 \
-            } else if (mode == RESIZE_MODE_LINEAR && num_spatial == 3) {                           \
-                float d_coord = transform_coord((float)out_coords[2], in_shape[2], out_shape[2],   \
-                                                coord_transform);                                  \
-                float h_coord = transform_coord((float)out_coords[3], in_shape[3], out_shape[3],   \
-                                                coord_transform);                                  \
-                float w_coord = transform_coord((float)out_coords[4], in_shape[4], out_shape[4],   \
-                                                coord_transform);                                  \
-                                                                                                   \
-                int d0 = (int)floorf(d_coord);                                                     \
-                int h0 = (int)floorf(h_coord);                                                     \
-                int w0 = (int)floorf(w_coord);                                                     \
-                int d1 = d0 + 1, h1 = h0 + 1, w1 = w0 + 1;                                         \
-                                                                                                   \
-                float fd = d_coord - (float)d0;                                                    \
-                float fh = h_coord - (float)h0;                                                    \
-                float fw = w_coord - (float)w0;                                                    \
-                                                                                                   \
-                size_t d0c = clamp_idx(d0, in_shape[2] - 1);                                       \
-                size_t d1c = clamp_idx(d1, in_shape[2] - 1);                                       \
-                size_t h0c = clamp_idx(h0, in_shape[3] - 1);                                       \
-                size_t h1c = clamp_idx(h1, in_shape[3] - 1);                                       \
-                size_t w0c = clamp_idx(w0, in_shape[4] - 1);                                       \
-                size_t w1c = clamp_idx(w1, in_shape[4] - 1);                                       \
-                                                                                                   \
-                float v000 = TO_FLOAT(in[base_in_idx + d0c * in_strides[2] + h0c * in_strides[3] + \
-                                         w0c * in_strides[4]]);                                    \
-                float v001 = TO_FLOAT(in[base_in_idx + d0c * in_strides[2] + h0c * in_strides[3] + \
-                                         w1c * in_strides[4]]);                                    \
-                float v010 = TO_FLOAT(in[base_in_idx + d0c * in_strides[2] + h1c * in_strides[3] + \
-                                         w0c * in_strides[4]]);                                    \
-                float v011 = TO_FLOAT(in[base_in_idx + d0c * in_strides[2] + h1c * in_strides[3] + \
-                                         w1c * in_strides[4]]);                                    \
-                float v100 = TO_FLOAT(in[base_in_idx + d1c * in_strides[2] + h0c * in_strides[3] + \
-                                         w0c * in_strides[4]]);                                    \
-                float v101 = TO_FLOAT(in[base_in_idx + d1c * in_strides[2] + h0c * in_strides[3] + \
-                                         w1c * in_strides[4]]);                                    \
-                float v110 = TO_FLOAT(in[base_in_idx + d1c * in_strides[2] + h1c * in_strides[3] + \
-                                         w0c * in_strides[4]]);                                    \
-                float v111 = TO_FLOAT(in[base_in_idx + d1c * in_strides[2] + h1c * in_strides[3] + \
-                                         w1c * in_strides[4]]);                                    \
-                                                                                                   \
-                float c00 = (1.0f - fw) * v000 + fw * v001;                                        \
-                float c01 = (1.0f - fw) * v010 + fw * v011;                                        \
-                float c10 = (1.0f - fw) * v100 + fw * v101;                                        \
-                float c11 = (1.0f - fw) * v110 + fw * v111;                                        \
-                float c0 = (1.0f - fh) * c00 + fh * c01;                                           \
-                float c1 = (1.0f - fh) * c10 + fh * c11;                                           \
-                out[out_idx] = FROM_FLOAT((1.0f - fd) * c0 + fd * c1);                             \
-            } else if (mode == RESIZE_MODE_CUBIC && num_spatial == 2) {                            \
-                float y_coord = transform_coord((float)out_coords[2], in_shape[2], out_shape[2],   \
-                                                coord_transform);                                  \
-                float x_coord = transform_coord((float)out_coords[3], in_shape[3], out_shape[3],   \
-                                                coord_transform);                                  \
-                                                                                                   \
-                int y0 = (int)floorf(y_coord);                                                     \
-                int x0 = (int)floorf(x_coord);                                                     \
-                float fy = y_coord - (float)y0;                                                    \
-                float fx = x_coord - (float)x0;                                                    \
-                                                                                                   \
-                float cols[4];                                                                     \
-                for (int j = -1; j <= 2; j++) {                                                    \
-                    size_t yc = clamp_idx(y0 + j, in_shape[2] - 1);                                \
-                    float p0 = TO_FLOAT(in[base_in_idx + yc * in_strides[2] +                      \
-                                           clamp_idx(x0 - 1, in_shape[3] - 1) * in_strides[3]]);   \
-                    float p1 = TO_FLOAT(in[base_in_idx + yc * in_strides[2] +                      \
-                                           clamp_idx(x0, in_shape[3] - 1) * in_strides[3]]);       \
-                    float p2 = TO_FLOAT(in[base_in_idx + yc * in_strides[2] +                      \
-                                           clamp_idx(x0 + 1, in_shape[3] - 1) * in_strides[3]]);   \
-                    float p3 = TO_FLOAT(in[base_in_idx + yc * in_strides[2] +                      \
-                                           clamp_idx(x0 + 2, in_shape[3] - 1) * in_strides[3]]);   \
-                    cols[j + 1] = cubic_interp(p0, p1, p2, p3, fx);                                \
+                dst[x] = acc;                                                                      \
+            }                                                                                      \
+        } else {                                                                                   \
+            /* Channels-last: every tap moves a run of channels */                                 \
+            for (size_t x = 0; x < wa->out_size; x++) {                                            \
+                const size_t *o = off + x * taps;                                                  \
+                const float *wx = w + x * taps;                                                    \
+                float *d = dst + x * ch;                                                           \
+                for (size_t c = 0; c < ch; c++) {                                                  \
+                    d[c] = wx[0] * TO_FLOAT(src[o[0] + c * cs]);                                   \
                 }                                                                                  \
-                out[out_idx] = FROM_FLOAT(cubic_interp(cols[0], cols[1], cols[2], cols[3], fy));   \
-            } else {                                                                               \
-                size_t in_idx = base_in_idx;                                                       \
-                for (size_t s = 0; s < num_spatial; s++) {                                         \
-                    size_t d = spatial_start + s;                                                  \
-                    float coord = transform_coord((float)out_coords[d], in_shape[d], out_shape[d], \
-                                                  coord_transform);                                \
-                    size_t src_idx = round_nearest(coord, in_shape[d] - 1, nearest_mode);          \
-                    in_idx += src_idx * in_strides[d];                                             \
+                for (size_t t = 1; t < taps; t++) {                                                \
+                    for (size_t c = 0; c < ch; c++) {                                              \
+                        d[c] += wx[t] * TO_FLOAT(src[o[t] + c * cs]);                              \
+                    }                                                                              \
                 }                                                                                  \
-                out[out_idx] = in[in_idx];                                                         \
             }                                                                                      \
         }                                                                                          \
+    }                                                                                              \
+                                                                                                   \
+    static void resize_finish_##TYPE_SUFFIX(const float *const *rows, const float *w,              \
+                                            size_t taps, size_t n, TYPE *dst, float *tmp) {        \
+        if (DIRECT) {                                                                              \
+            resize_combine_f32(rows, w, taps, n, (float *)(void *)dst);                            \
+            return;                                                                                \
+        }                                                                                          \
+        resize_combine_f32(rows, w, taps, n, tmp);                                                 \
+        for (size_t i = 0; i < n; i++) {                                                           \
+            dst[i] = FROM_FLOAT(tmp[i]);                                                           \
+        }                                                                                          \
+    }                                                                                              \
+                                                                                                   \
+    RESIZE_INTERP_WORKER(TYPE_SUFFIX, TYPE, float, resize_hrow_##TYPE_SUFFIX,                      \
+                         resize_combine_f32, resize_finish_##TYPE_SUFFIX, weight)                  \
+                                                                                                   \
+    void hodu_cpu_resize_##TYPE_SUFFIX(const void *input, void *output, const size_t *metadata) {  \
+        HODU_PROFILE_KERNEL((hodu_cpu_profile_numel(metadata + 2, metadata[1]) +                   \
+                             metadata[0]) * sizeof(TYPE));                                         \
+        resize_run(input, output, metadata, false, sizeof(TYPE),                                   \
+                   resize_interp_##TYPE_SUFFIX##_worker);                                          \
+    }                                                                                              \
+                                                                                                   \
+    void hodu_cpu_resize_nhwc_##TYPE_SUFFIX(const void *input, void *output,                       \
+                                            const size_t *metadata) {                              \
+        HODU_PROFILE_KERNEL((hodu_cpu_profile_numel(metadata + 2, metadata[1]) +                   \
+                             metadata[0]) * sizeof(TYPE));                                         \
+        resize_run(input, output, metadata, true, sizeof(TYPE),                                    \
+                   resize_interp_##TYPE_SUFFIX##_worker);                                          \
     }
 
-IMPL_RESIZE_CONVERT(f8e4m3_t, f8e4m3, f8e4m3_to_float, float_to_f8e4m3)
-IMPL_RESIZE_CONVERT(f8e5m2_t, f8e5m2, f8e5m2_to_float, float_to_f8e5m2)
-IMPL_RESIZE_CONVERT(bf16_t, bf16, bf16_to_float, float_to_bf16)
-IMPL_RESIZE_CONVERT(f16_t, f16, f16_to_float, float_to_f16)
+#define RESIZE_F32_ID(x) (x)
+#define RESIZE_TO_F32(x) ((float)(x))
+#define RESIZE_F32_TO_F64(x) ((f64_t)(x))
+
+IMPL_RESIZE(f32_t, f32, RESIZE_F32_ID, RESIZE_F32_ID, 1)
+IMPL_RESIZE(f64_t, f64, RESIZE_TO_F32, RESIZE_F32_TO_F64, 0)
+IMPL_RESIZE(f8e4m3_t, f8e4m3, f8e4m3_to_float, float_to_f8e4m3, 0)
+IMPL_RESIZE(f8e5m2_t, f8e5m2, f8e5m2_to_float, float_to_f8e5m2, 0)
+IMPL_RESIZE(bf16_t, bf16, bf16_to_float, float_to_bf16, 0)
+IMPL_RESIZE(f16_t, f16, f16_to_float, float_to_f16, 0)
+
+// u8: Q RESIZE_Q_BITS weights, horizontal sums narrowed to Q RESIZE_ROW_BITS rows
+static void resize_hrow_u8(const uint8_t *src, const resize_axis_t *wa, size_t ch, size_t cs,
+                           int16_t *dst) {
+    const size_t taps = wa->taps;
+    const size_t *off = wa->offset;
+    const int16_t *w = wa->weight_q;
+    const int32_t half = (int32_t)1 << (RESIZE_H_SHIFT - 1);
+    if (ch == 1 && taps == 2) {
+        for (size_t x = 0; x < wa->out_size; x++) {
+            dst[x] = (int16_t)((w[2 * x] * src[off[2 * x]] + w[2 * x + 1] * src[off[2 * x + 1]] +
+                                half) >>
+                               RESIZE_H_SHIFT);
+        }
+        return;
+    }
+    if (ch == 1 && taps == 4) {
+        for (size_t x = 0; x < wa->out_size; x++) {
+            const size_t *o = off + 4 * x;
+            const int16_t *wx = w + 4 * x;
+            dst[x] = (int16_t)((wx[0] * src[o[0]] + wx[1] * src[o[1]] + wx[2] * src[o[2]] +
+                                wx[3] * src[o[3]] + half) >>
+                               RESIZE_H_SHIFT);
+        }
+        return;
+    }
+    for (size_t x = 0; x < wa->out_size; x++) {
+        const size_t *o = off + x * taps;
+        const int16_t *wx = w + x * taps;
+        for (size_t c = 0; c < ch; c++) {
+            int32_t acc = half;
+            for (size_t t = 0; t < taps; t++) {
+                acc += (int32_t)wx[t] * src[o[t] + c * cs];
+            }
+            dst[x * ch + c] = (int16_t)(acc >> RESIZE_H_SHIFT);
+        }
+    }
+}
+
+static void resize_finish_u8(const int16_t *const *rows, const int16_t *w, size_t taps, size_t n,
+                             uint8_t *dst, int16_t *tmp) {
+    (void)tmp;
+    resize_combine_u8(rows, w, taps, n, dst);
+}
+
+RESIZE_INTERP_WORKER(u8, uint8_t, int16_t, resize_hrow_u8, resize_combine_q, resize_finish_u8,
+                     weight_q)
+
+void hodu_cpu_resize_u8(const void *input, void *output, const size_t *metadata) {
+    HODU_PROFILE_KERNEL((hodu_cpu_profile_numel(metadata + 2, metadata[1]) +
+                         metadata[0]) * sizeof(uint8_t));
+    resize_run(input, output, metadata, false, sizeof(uint8_t), resize_interp_u8_worker);
+}
+
+void hodu_cpu_resize_nhwc_u8(const void *input, void *output, const size_t *metadata) {
+    HODU_PROFILE_KERNEL((hodu_cpu_profile_numel(metadata + 2, metadata[1]) +
+                         metadata[0]) * sizeof(uint8_t));
+    resize_run(input, output, metadata, true, sizeof(uint8_t), resize_interp_u8_worker);
+}
@@ -30,6 +30,18 @@ void hodu_cpu_resize_bf16(const void *input, void *output, const size_t *metadat
 void hodu_cpu_resize_f16(const void *input, void *output, const size_t *metadata);
 void hodu_cpu_resize_f32(const void *input, void *output, const size_t *metadata);
 void hodu_cpu_resize_f64(const void *input, void *output, const size_t *metadata);
+// u8 images: fixed-point interpolation weights, results rounded to nearest and saturated
+void hodu_cpu_resize_u8(const void *input, void *output, const size_t *metadata);
+
+// Channels-last resize: same metadata with shapes/strides given as [N, spatial..., C]
+// (e.g. NHWC); the output is written in the same channels-last order.
+void hodu_cpu_resize_nhwc_f8e4m3(const void *input, void *output, const size_t *metadata);
+void hodu_cpu_resize_nhwc_f8e5m2(const void *input, void *output, const size_t *metadata);
+void hodu_cpu_resize_nhwc_bf16(const void *input, void *output, const size_t *metadata);
+void hodu_cpu_resize_nhwc_f16(const void *input, void *output, const size_t *metadata);
+void hodu_cpu_resize_nhwc_f32(const void *input, void *output, const size_t *metadata);
+void hodu_cpu_resize_nhwc_f64(const void *input, void *output, const size_t *metadata);
+void hodu_cpu_resize_nhwc_u8(const void *input, void *output, const size_t *metadata);
 
 #ifdef __cplusplus
 }
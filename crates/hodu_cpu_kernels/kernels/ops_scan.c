@@ -1,286 +1,423 @@
 #include "ops_scan.h"
+#include "profile.h"
+#include "thread_utils.h"
 #include "types.h"
+#include "utils.h"
+#include "workspace.h"
+#include <math.h>
+#include <stdbool.h>
+#include <stdint.h>
 
-#define IMPL_CUMSUM(TYPE, TYPE_SUFFIX)                                                             \
-    void hodu_cpu_cumsum_##TYPE_SUFFIX(const void *input, void *output, const size_t *metadata) {  \
-        const size_t num_dims = metadata[1];                                                       \
-        const size_t *shape = &metadata[2];                                                        \
-        const size_t *strides = &metadata[2 + num_dims];                                           \
-        const size_t offset = metadata[2 + 2 * num_dims];                                          \
-        const size_t dim = metadata[3 + 2 * num_dims];                                             \
-                                                                                                   \
-        const TYPE *in = (const TYPE *)input + offset;                                             \
-        TYPE *out = (TYPE *)output;                                                                \
-                                                                                                   \
-        if (num_dims == 0) {                                                                       \
-            out[0] = in[0];                                                                        \
-            return;                                                                                \
-        }                                                                                          \
-                                                                                                   \
-        /* Compute output strides (contiguous row-major) */                                        \
-        size_t out_strides[16];                                                                    \
-        out_strides[num_dims - 1] = 1;                                                             \
-        for (size_t d = num_dims - 1; d > 0; d--) {                                                \
-            out_strides[d - 1] = out_strides[d] * shape[d];                                        \
-        }                                                                                          \
-                                                                                                   \
-        size_t outer_size = 1;                                                                     \
-        for (size_t d = 0; d < dim; d++) {                                                         \
-            outer_size *= shape[d];                                                                \
-        }                                                                                          \
-        size_t inner_size = 1;                                                                     \
-        for (size_t d = dim + 1; d < num_dims; d++) {                                              \
-            inner_size *= shape[d];                                                                \
-        }                                                                                          \
-        const size_t scan_size = shape[dim];                                                       \
-        const size_t scan_stride = strides[dim];                                                   \
-                                                                                                   \
-        for (size_t outer = 0; outer < outer_size; outer++) {                                      \
-            for (size_t inner = 0; inner < inner_size; inner++) {                                  \
-                TYPE acc = (TYPE)0;                                                                \
-                for (size_t s = 0; s < scan_size; s++) {                                           \
-                    size_t in_idx = 0;                                                             \
-                    size_t out_idx = 0;                                                            \
-                    size_t tmp_outer = outer;                                                      \
-                    for (size_t d = 0; d < dim; d++) {                                             \
-                        size_t coord = tmp_outer % shape[d];                                       \
-                        tmp_outer /= shape[d];                                                     \
-                        in_idx += coord * strides[d];                                              \
-                        out_idx += coord * out_strides[d];                                         \
-                    }                                                                              \
-                    in_idx += s * scan_stride;                                                     \
-                    out_idx += s * out_strides[dim];                                               \
-                    size_t tmp_inner = inner;                                                      \
-                    for (size_t d = num_dims - 1; d > dim; d--) {                                  \
-                        size_t coord = tmp_inner % shape[d];                                       \
-                        tmp_inner /= shape[d];                                                     \
-                        in_idx += coord * strides[d];                                              \
-                        out_idx += coord * out_strides[d];                                         \
-                    }                                                                              \
-                    acc += in[in_idx];                                                             \
-                    out[out_idx] = acc;                                                            \
-                }                                                                                  \
-            }                                                                                      \
-        }                                                                                          \
+// ============================================================================
+// SCAN ENGINE
+// ============================================================================
+//
+// A scan along dim is planned as outer x n x inner: each of the outer * inner
+// lanes is an independent scan of n steps. Lanes that are adjacent along the
+// inner dims are scanned together in blocks of SCAN_LANES, so a scan over a
+// non-trailing axis streams whole inner rows (vectorized across lanes) instead
+// of walking each lane with the dim stride. Tasks are (outer, lane block)
+// pairs on the thread pool.
+//
+// When there are few lane blocks and the scan is long, it is cut into chunks
+// along dim and run in two passes: each chunk's total, a serial exclusive scan
+// of the chunk totals per lane, then each chunk's scan seeded with its carry.
+// The split depends on the shape only, so results do not depend on the thread
+// count.
+
+// Lanes scanned together per task
+#define SCAN_LANES 256
+// Two-pass split when fewer lane blocks than this and each chunk keeps
+// SCAN_CHUNK_ELEMS elements
+#define SCAN_SPLIT_TASKS 16
+#define SCAN_CHUNK_ELEMS ((size_t)1 << 15)
+#define SCAN_MAX_CHUNKS 256
+// Minimum elements per task
+#define SCAN_TASK_ELEMS ((size_t)1 << 14)
+
+#define SCAN_EXCLUSIVE 1
+#define SCAN_REVERSE 2
+
+typedef struct scan_args scan_args_t;
+
+/// Scans steps [s0, s1) of nl lanes starting from carry (identity when NULL). With out NULL it
+/// only reduces and writes the lanes' totals (combined with carry) to total.
+typedef void (*scan_lane_fn_t)(const scan_args_t *a, const void *in, void *out, size_t nl,
+                               const size_t *offs, size_t s0, size_t s1, const void *carry,
+                               void *total);
+
+/// Turns per-chunk totals [outer][chunks][inner] into per-chunk carries, in scan order
+typedef void (*scan_carry_fn_t)(const scan_args_t *a, void *totals);
+
+struct scan_args {
+    const char *input;
+    char *output;
+    scan_lane_fn_t lane_fn;
+    size_t elem_size;
+    size_t acc_size;
+    bool exclusive;
+    bool reverse;
+    size_t num_dims;
+    size_t dim;
+    const size_t *shape;
+    const size_t *strides;
+    size_t outer;
+    size_t n;
+    size_t inner;
+    size_t dim_stride;
+    size_t lane_stride; // input stride between adjacent lanes, 0 = per-lane offsets
+    size_t blocks;      // lane blocks per outer index
+    size_t chunks;
+    size_t chunk;       // steps per chunk
+    char *totals;       // [outer][chunks][inner] accumulators, chunked scans only
+};
+
+/// Input offset (in elements) of outer index o
+static size_t scan_outer_offset(const scan_args_t *a, size_t o) {
+    size_t offset = 0;
+    for (size_t d = a->dim; d-- > 0;) {
+        offset += (o % a->shape[d]) * a->strides[d];
+        o /= a->shape[d];
     }
+    return offset;
+}
 
-IMPL_CUMSUM(f32_t, f32)
-IMPL_CUMSUM(f64_t, f64)
-IMPL_CUMSUM(u8_t, u8)
-IMPL_CUMSUM(u16_t, u16)
-IMPL_CUMSUM(u32_t, u32)
-IMPL_CUMSUM(u64_t, u64)
-IMPL_CUMSUM(i8_t, i8)
-IMPL_CUMSUM(i16_t, i16)
-IMPL_CUMSUM(i32_t, i32)
-IMPL_CUMSUM(i64_t, i64)
+/// Input offsets (in elements) of inner lanes [i0, i0 + nl)
+static void scan_lane_offsets(const scan_args_t *a, size_t i0, size_t nl, size_t *offs) {
+    for (size_t j = 0; j < nl; j++) {
+        size_t i = i0 + j;
+        size_t offset = 0;
+        for (size_t d = a->num_dims; d-- > a->dim + 1;) {
+            offset += (i % a->shape[d]) * a->strides[d];
+            i /= a->shape[d];
+        }
+        offs[j] = offset;
+    }
+}
 
-#define IMPL_CUMSUM_CONVERT(TYPE, TYPE_SUFFIX, TO_FLOAT, FROM_FLOAT)                               \
-    void hodu_cpu_cumsum_##TYPE_SUFFIX(const void *input, void *output, const size_t *metadata) {  \
-        const size_t num_dims = metadata[1];                                                       \
-        const size_t *shape = &metadata[2];                                                        \
-        const size_t *strides = &metadata[2 + num_dims];                                           \
-        const size_t offset = metadata[2 + 2 * num_dims];                                          \
-        const size_t dim = metadata[3 + 2 * num_dims];                                             \
-                                                                                                   \
-        const TYPE *in = (const TYPE *)input + offset;                                             \
-        TYPE *out = (TYPE *)output;                                                                \
-                                                                                                   \
-        if (num_dims == 0) {                                                                       \
-            out[0] = in[0];                                                                        \
-            return;                                                                                \
-        }                                                                                          \
-                                                                                                   \
-        /* Compute output strides (contiguous row-major) */                                        \
-        size_t out_strides[16];                                                                    \
-        out_strides[num_dims - 1] = 1;                                                             \
-        for (size_t d = num_dims - 1; d > 0; d--) {                                                \
-            out_strides[d - 1] = out_strides[d] * shape[d];                                        \
-        }                                                                                          \
-                                                                                                   \
-        size_t outer_size = 1;                                                                     \
-        for (size_t d = 0; d < dim; d++) {                                                         \
-            outer_size *= shape[d];                                                                \
-        }                                                                                          \
-        size_t inner_size = 1;                                                                     \
-        for (size_t d = dim + 1; d < num_dims; d++) {                                              \
-            inner_size *= shape[d];                                                                \
+/// Input stride between adjacent inner lanes when the inner dims merge into one, else 0
+static size_t scan_lane_stride(const scan_args_t *a) {
+    size_t stride = 1, extent = 0;
+    bool found = false;
+    for (size_t d = a->num_dims; d-- > a->dim + 1;) {
+        if (a->shape[d] == 1) {
+            continue;
+        }
+        if (!found) {
+            stride = a->strides[d];
+            found = true;
+        } else if (a->strides[d] != extent) {
+            return 0;
+        }
+        extent = a->strides[d] * a->shape[d];
+    }
+    return stride;
+}
+
+/// Task t = (outer index, lane block, chunk); pass 1 writes totals, pass 2 writes outputs
+static void scan_task(const scan_args_t *a, size_t t, bool reduce) {
+    const size_t c = t % a->chunks;
+    const size_t b = (t / a->chunks) % a->blocks;
+    const size_t o = t / (a->chunks * a->blocks);
+    const size_t i0 = b * SCAN_LANES;
+    const size_t nl = MINIMUM(SCAN_LANES, a->inner - i0);
+    const size_t s0 = c * a->chunk;
+    const size_t s1 = MINIMUM(a->n, s0 + a->chunk);
+    size_t offs[SCAN_LANES];
+    const char *in = a->input + scan_outer_offset(a, o) * a->elem_size;
+    if (a->lane_stride) {
+        in += i0 * a->lane_stride * a->elem_size;
+    } else {
+        scan_lane_offsets(a, i0, nl, offs);
+    }
+    char *carry = NULL;
+    if (a->chunks > 1) {
+        carry = a->totals + ((o * a->chunks + c) * a->inner + i0) * a->acc_size;
+    }
+    if (reduce) {
+        a->lane_fn(a, in, NULL, nl, a->lane_stride ? NULL : offs, s0, s1, NULL, carry);
+    } else {
+        char *out = a->output + (o * a->n * a->inner + i0) * a->elem_size;
+        a->lane_fn(a, in, out, nl, a->lane_stride ? NULL : offs, s0, s1, carry, NULL);
+    }
+}
+
+static void scan_reduce_worker(size_t start, size_t end, void *ctx) {
+    for (size_t t = start; t < end; t++) {
+        scan_task((const scan_args_t *)ctx, t, true);
+    }
+}
+
+static void scan_worker(size_t start, size_t end, void *ctx) {
+    for (size_t t = start; t < end; t++) {
+        scan_task((const scan_args_t *)ctx, t, false);
+    }
+}
+
+static void scan_run(const void *input, void *output, const size_t *metadata, size_t elem_size,
+                     size_t acc_size, scan_lane_fn_t lane_fn, scan_carry_fn_t carry_fn,
+                     unsigned flags) {
+    static const size_t scalar_shape[1] = {1};
+    static const size_t scalar_strides[1] = {1};
+    scan_args_t args;
+    args.num_dims = metadata[1];
+    args.shape = &metadata[2];
+    args.strides = &metadata[2 + args.num_dims];
+    args.dim = metadata[3 + 2 * args.num_dims];
+    args.input = (const char *)input + metadata[2 + 2 * args.num_dims] * elem_size;
+    if (args.num_dims == 0) {
+        args.num_dims = 1;
+        args.shape = scalar_shape;
+        args.strides = scalar_strides;
+        args.dim = 0;
+    }
+    args.output = (char *)output;
+    args.lane_fn = lane_fn;
+    args.elem_size = elem_size;
+    args.acc_size = acc_size;
+    args.exclusive = (flags & SCAN_EXCLUSIVE) != 0;
+    args.reverse = (flags & SCAN_REVERSE) != 0;
+    args.outer = 1;
+    for (size_t d = 0; d < args.dim; d++) {
+        args.outer *= args.shape[d];
+    }
+    args.inner = 1;
+    for (size_t d = args.dim + 1; d < args.num_dims; d++) {
+        args.inner *= args.shape[d];
+    }
+    args.n = args.shape[args.dim];
+    args.dim_stride = args.strides[args.dim];
+    if (args.outer == 0 || args.inner == 0 || args.n == 0) {
+        return;
+    }
+    args.lane_stride = scan_lane_stride(&args);
+    args.blocks = (args.inner + SCAN_LANES - 1) / SCAN_LANES;
+    args.chunks = 1;
+    args.chunk = args.n;
+    args.totals = NULL;
+
+    const size_t lanes = MINIMUM(args.inner, SCAN_LANES);
+    const size_t lane_tasks = args.outer * args.blocks;
+    if (lane_tasks < SCAN_SPLIT_TASKS && args.n * lanes >= 2 * SCAN_CHUNK_ELEMS) {
+        const size_t chunks = MINIMUM(SCAN_MAX_CHUNKS, args.n * lanes / SCAN_CHUNK_ELEMS);
+        args.totals = (char *)workspace_acquire(args.outer * chunks * args.inner * acc_size);
+        if (args.totals) {
+            args.chunk = (args.n + chunks - 1) / chunks;
+            args.chunks = (args.n + args.chunk - 1) / args.chunk;
+        }
+    }
+
+    const size_t tasks = lane_tasks * args.chunks;
+    const size_t task_elems = args.chunk * lanes;
+    const size_t grain = SCAN_TASK_ELEMS / task_elems + 1;
+    if (args.chunks > 1) {
+        parallel_for(0, tasks, grain, scan_reduce_worker, &args);
+        carry_fn(&args, args.totals);
+    }
+    parallel_for(0, tasks, grain, scan_worker, &args);
+    if (args.totals) {
+        workspace_release(args.totals);
+    }
+}
+
+size_t hodu_cpu_scan_workspace_size(const size_t *metadata) {
+    size_t num_dims = metadata[1];
+    const size_t *shape = &metadata[2];
+    const size_t dim = metadata[3 + 2 * num_dims];
+    if (num_dims == 0) {
+        return 0;
+    }
+    size_t outer = 1, inner = 1;
+    for (size_t d = 0; d < dim; d++) {
+        outer *= shape[d];
+    }
+    for (size_t d = dim + 1; d < num_dims; d++) {
+        inner *= shape[d];
+    }
+    const size_t n = shape[dim];
+    const size_t lanes = MINIMUM(inner, SCAN_LANES);
+    const size_t lane_tasks = outer * ((inner + SCAN_LANES - 1) / SCAN_LANES);
+    if (n == 0 || lanes == 0 || lane_tasks >= SCAN_SPLIT_TASKS ||
+        n * lanes < 2 * SCAN_CHUNK_ELEMS) {
+        return 0;
+    }
+    const size_t chunks = MINIMUM(SCAN_MAX_CHUNKS, n * lanes / SCAN_CHUNK_ELEMS);
+    // Accumulators are at most 8 bytes
+    return hodu_cpu_workspace_block_size(outer * chunks * inner * 8) + HODU_CPU_WORKSPACE_ALIGN;
+}
+
+// Combine operations: (acc, x) -> new acc. max/min propagate NaN.
+#define SCAN_ADD(acc, x) ((acc) + (x))
+#define SCAN_MUL(acc, x) ((acc) * (x))
+#define SCAN_MAX(acc, x) (((x) > (acc) || (x) != (x)) ? (x) : (acc))
+#define SCAN_MIN(acc, x) (((x) < (acc) || (x) != (x)) ? (x) : (acc))
+
+// Identity-preserving conversions for types accumulated in their own type
+#define SCAN_SAME(x) (x)
+
+/**
+ * @brief Macro to implement one scan operation for one type
+ *
+ * Generates the inclusive, exclusive, reverse and reverse exclusive entry points
+ * hodu_cpu_<NAME>[_reverse][_exclusive]_<TYPE_SUFFIX>.
+ *
+ * @param NAME Operation name (cumsum, cumprod, cummax, cummin)
+ * @param TYPE C type of the elements
+ * @param TYPE_SUFFIX Function name suffix
+ * @param ACC Accumulator type
+ * @param IDENT Identity of COMBINE in ACC
+ * @param COMBINE Combine macro (acc, x) -> acc
+ * @param TO_ACC Conversion from TYPE to ACC
+ * @param FROM_ACC Conversion from ACC to TYPE
+ */
+#define IMPL_SCAN(NAME, TYPE, TYPE_SUFFIX, ACC, IDENT, COMBINE, TO_ACC, FROM_ACC)                  \
+    static void NAME##_lanes_##TYPE_SUFFIX(const scan_args_t *a, const void *in_ptr,               \
+                                           void *out_ptr, size_t nl, const size_t *offs,           \
+                                           size_t s0, size_t s1, const void *carry,                \
+                                           void *total) {                                          \
+        const TYPE *in = (const TYPE *)in_ptr;                                                     \
+        TYPE *out = (TYPE *)out_ptr;                                                               \
+        const size_t sd = a->dim_stride;                                                           \
+        const size_t ls = a->lane_stride;                                                          \
+        const size_t inner = a->inner;                                                             \
+        const bool exclusive = a->exclusive;                                                       \
+        ACC acc[SCAN_LANES];                                                                       \
+        for (size_t j = 0; j < nl; j++) {                                                          \
+            acc[j] = carry ? ((const ACC *)carry)[j] : (ACC)(IDENT);                               \
         }                                                                                          \
-        const size_t scan_size = shape[dim];                                                       \
-        const size_t scan_stride = strides[dim];                                                   \
-                                                                                                   \
-        for (size_t outer = 0; outer < outer_size; outer++) {                                      \
-            for (size_t inner = 0; inner < inner_size; inner++) {                                  \
-                float acc = 0.0f;                                                                  \
-                for (size_t s = 0; s < scan_size; s++) {                                           \
-                    size_t in_idx = 0;                                                             \
-                    size_t out_idx = 0;                                                            \
-                    size_t tmp_outer = outer;                                                      \
-                    for (size_t d = 0; d < dim; d++) {                                             \
-                        size_t coord = tmp_outer % shape[d];                                       \
-                        tmp_outer /= shape[d];                                                     \
-                        in_idx += coord * strides[d];                                              \
-                        out_idx += coord * out_strides[d];                                         \
+        if (nl == 1 && offs == NULL) {                                                             \
+            /* A single lane: plain strided scan */                                                \
+            ACC r = acc[0];                                                                        \
+            if (!out) {                                                                            \
+                for (size_t s = s0; s < s1; s++) {                                                 \
+                    r = COMBINE(r, TO_ACC(in[s * sd]));                                            \
+                }                                                                                  \
+            } else if (!a->reverse && !exclusive) {                                                \
+                for (size_t s = s0; s < s1; s++) {                                                 \
+                    r = COMBINE(r, TO_ACC(in[s * sd]));                                            \
+                    out[s * inner] = FROM_ACC(r);                                                  \
+                }                                                                                  \
+            } else {                                                                               \
+                for (size_t k = 0; k < s1 - s0; k++) {                                             \
+                    const size_t s = a->reverse ? s1 - 1 - k : s0 + k;                             \
+                    const ACC x = TO_ACC(in[s * sd]);                                              \
+                    if (exclusive) {                                                               \
+                        out[s * inner] = FROM_ACC(r);                                              \
+                        r = COMBINE(r, x);                                                         \
+                    } else {                                                                       \
+                        r = COMBINE(r, x);                                                         \
+                        out[s * inner] = FROM_ACC(r);                                              \
+                    }                                                                              \
+                }                                                                                  \
+            }                                                                                      \
+            acc[0] = r;                                                                            \
+        } else {                                                                                   \
+            for (size_t k = 0; k < s1 - s0; k++) {                                                 \
+                const size_t s = a->reverse ? s1 - 1 - k : s0 + k;                                 \
+                const TYPE *row = in + s * sd;                                                     \
+                TYPE *orow = out ? out + s * inner : NULL;                                         \
+                if (orow && exclusive) {                                                           \
+                    for (size_t j = 0; j < nl; j++) {                                              \
+                        orow[j] = FROM_ACC(acc[j]);                                                \
+                    }                                                                              \
+                }                                                                                  \
+                if (offs) {                                                                        \
+                    for (size_t j = 0; j < nl; j++) {                                              \
+                        acc[j] = COMBINE(acc[j], TO_ACC(row[offs[j]]));                            \
+                    }                                                                              \
+                } else if (ls == 1) {                                                              \
+                    for (size_t j = 0; j < nl; j++) {                                              \
+                        acc[j] = COMBINE(acc[j], TO_ACC(row[j]));                                  \
+                    }                                                                              \
+                } else {                                                                           \
+                    for (size_t j = 0; j < nl; j++) {                                              \
+                        acc[j] = COMBINE(acc[j], TO_ACC(row[j * ls]));                             \
                     }                                                                              \
-                    in_idx += s * scan_stride;                                                     \
-                    out_idx += s * out_strides[dim];                                               \
-                    size_t tmp_inner = inner;                                                      \
-                    for (size_t d = num_dims - 1; d > dim; d--) {                                  \
-                        size_t coord = tmp_inner % shape[d];                                       \
-                        tmp_inner /= shape[d];                                                     \
-                        in_idx += coord * strides[d];                                              \
-                        out_idx += coord * out_strides[d];                                         \
+                }                                                                                  \
+                if (orow && !exclusive) {                                                          \
+                    for (size_t j = 0; j < nl; j++) {                                              \
+                        orow[j] = FROM_ACC(acc[j]);                                                \
                     }                                                                              \
-                    acc += TO_FLOAT(in[in_idx]);                                                   \
-                    out[out_idx] = FROM_FLOAT(acc);                                                \
                 }                                                                                  \
             }                                                                                      \
         }                                                                                          \
-    }
-
-IMPL_CUMSUM_CONVERT(f8e4m3_t, f8e4m3, f8e4m3_to_float, float_to_f8e4m3)
-IMPL_CUMSUM_CONVERT(f8e5m2_t, f8e5m2, f8e5m2_to_float, float_to_f8e5m2)
-IMPL_CUMSUM_CONVERT(bf16_t, bf16, bf16_to_float, float_to_bf16)
-IMPL_CUMSUM_CONVERT(f16_t, f16, f16_to_float, float_to_f16)
-
-#define IMPL_CUMPROD(TYPE, TYPE_SUFFIX)                                                            \
-    void hodu_cpu_cumprod_##TYPE_SUFFIX(const void *input, void *output, const size_t *metadata) { \
-        const size_t num_dims = metadata[1];                                                       \
-        const size_t *shape = &metadata[2];                                                        \
-        const size_t *strides = &metadata[2 + num_dims];                                           \
-        const size_t offset = metadata[2 + 2 * num_dims];                                          \
-        const size_t dim = metadata[3 + 2 * num_dims];                                             \
-                                                                                                   \
-        const TYPE *in = (const TYPE *)input + offset;                                             \
-        TYPE *out = (TYPE *)output;                                                                \
-                                                                                                   \
-        if (num_dims == 0) {                                                                       \
-            out[0] = in[0];                                                                        \
-            return;                                                                                \
-        }                                                                                          \
-                                                                                                   \
-        /* Compute output strides (contiguous row-major) */                                        \
-        size_t out_strides[16];                                                                    \
-        out_strides[num_dims - 1] = 1;                                                             \
-        for (size_t d = num_dims - 1; d > 0; d--) {                                                \
-            out_strides[d - 1] = out_strides[d] * shape[d];                                        \
-        }                                                                                          \
-                                                                                                   \
-        size_t outer_size = 1;                                                                     \
-        for (size_t d = 0; d < dim; d++) {                                                         \
-            outer_size *= shape[d];                                                                \
-        }                                                                                          \
-        size_t inner_size = 1;                                                                     \
-        for (size_t d = dim + 1; d < num_dims; d++) {                                              \
-            inner_size *= shape[d];                                                                \
+        if (total) {                                                                               \
+            for (size_t j = 0; j < nl; j++) {                                                      \
+                ((ACC *)total)[j] = acc[j];                                                        \
+            }                                                                                      \
         }                                                                                          \
-        const size_t scan_size = shape[dim];                                                       \
-        const size_t scan_stride = strides[dim];                                                   \
+    }                                                                                              \
                                                                                                    \
-        for (size_t outer = 0; outer < outer_size; outer++) {                                      \
-            for (size_t inner = 0; inner < inner_size; inner++) {                                  \
-                TYPE acc = (TYPE)1;                                                                \
-                for (size_t s = 0; s < scan_size; s++) {                                           \
-                    size_t in_idx = 0;                                                             \
-                    size_t out_idx = 0;                                                            \
-                    size_t tmp_outer = outer;                                                      \
-                    for (size_t d = 0; d < dim; d++) {                                             \
-                        size_t coord = tmp_outer % shape[d];                                       \
-                        tmp_outer /= shape[d];                                                     \
-                        in_idx += coord * strides[d];                                              \
-                        out_idx += coord * out_strides[d];                                         \
-                    }                                                                              \
-                    in_idx += s * scan_stride;                                                     \
-                    out_idx += s * out_strides[dim];                                               \
-                    size_t tmp_inner = inner;                                                      \
-                    for (size_t d = num_dims - 1; d > dim; d--) {                                  \
-                        size_t coord = tmp_inner % shape[d];                                       \
-                        tmp_inner /= shape[d];                                                     \
-                        in_idx += coord * strides[d];                                              \
-                        out_idx += coord * out_strides[d];                                         \
-                    }                                                                              \
-                    acc *= in[in_idx];                                                             \
-                    out[out_idx] = acc;                                                            \
+    static void NAME##_carry_##TYPE_SUFFIX(const scan_args_t *a, void *totals_ptr) {               \
+        ACC *totals = (ACC *)totals_ptr;                                                           \
+        for (size_t o = 0; o < a->outer; o++) {                                                    \
+            for (size_t i = 0; i < a->inner; i++) {                                                \
+                ACC r = (ACC)(IDENT);                                                              \
+                for (size_t k = 0; k < a->chunks; k++) {                                           \
+                    const size_t c = a->reverse ? a->chunks - 1 - k : k;                           \
+                    ACC *t = &totals[(o * a->chunks + c) * a->inner + i];                          \
+                    const ACC chunk_total = *t;                                                    \
+                    *t = r;                                                                        \
+                    r = COMBINE(r, chunk_total);                                                   \
                 }                                                                                  \
             }                                                                                      \
         }                                                                                          \
-    }
-
-IMPL_CUMPROD(f32_t, f32)
-IMPL_CUMPROD(f64_t, f64)
-IMPL_CUMPROD(u8_t, u8)
-IMPL_CUMPROD(u16_t, u16)
-IMPL_CUMPROD(u32_t, u32)
-IMPL_CUMPROD(u64_t, u64)
-IMPL_CUMPROD(i8_t, i8)
-IMPL_CUMPROD(i16_t, i16)
-IMPL_CUMPROD(i32_t, i32)
-IMPL_CUMPROD(i64_t, i64)
-
-#define IMPL_CUMPROD_CONVERT(TYPE, TYPE_SUFFIX, TO_FLOAT, FROM_FLOAT)                              \
-    void hodu_cpu_cumprod_##TYPE_SUFFIX(const void *input, void *output, const size_t *metadata) { \
-        const size_t num_dims = metadata[1];                                                       \
-        const size_t *shape = &metadata[2];                                                        \
-        const size_t *strides = &metadata[2 + num_dims];                                           \
-        const size_t offset = metadata[2 + 2 * num_dims];                                          \
-        const size_t dim = metadata[3 + 2 * num_dims];                                             \
-                                                                                                   \
-        const TYPE *in = (const TYPE *)input + offset;                                             \
-        TYPE *out = (TYPE *)output;                                                                \
+    }                                                                                              \
                                                                                                    \
-        if (num_dims == 0) {                                                                       \
-            out[0] = in[0];                                                                        \
-            return;                                                                                \
-        }                                                                                          \
+    void hodu_cpu_##NAME##_##TYPE_SUFFIX(const void *input, void *output,                          \
+                                         const size_t *metadata) {                                 \
+        HODU_PROFILE_KERNEL(metadata[0] * 2 * sizeof(TYPE));                                       \
+        scan_run(input, output, metadata, sizeof(TYPE), sizeof(ACC), NAME##_lanes_##TYPE_SUFFIX,   \
+                 NAME##_carry_##TYPE_SUFFIX, 0);                                                   \
+    }                                                                                              \
                                                                                                    \
-        /* Compute output strides (contiguous row-major) */                                        \
-        size_t out_strides[16];                                                                    \
-        out_strides[num_dims - 1] = 1;                                                             \
-        for (size_t d = num_dims - 1; d > 0; d--) {                                                \
-            out_strides[d - 1] = out_strides[d] * shape[d];                                        \
-        }                                                                                          \
+    void hodu_cpu_##NAME##_exclusive_##TYPE_SUFFIX(const void *input, void *output,                \
+                                                   const size_t *metadata) {                       \
+        HODU_PROFILE_KERNEL(metadata[0] * 2 * sizeof(TYPE));                                       \
+        scan_run(input, output, metadata, sizeof(TYPE), sizeof(ACC), NAME##_lanes_##TYPE_SUFFIX,   \
+                 NAME##_carry_##TYPE_SUFFIX, SCAN_EXCLUSIVE);                                      \
+    }                                                                                              \
                                                                                                    \
-        size_t outer_size = 1;                                                                     \
-        for (size_t d = 0; d < dim; d++) {                                                         \
-            outer_size *= shape[d];                                                                \
-        }                                                                                          \
-        size_t inner_size = 1;                                                                     \
-        for (size_t d = dim + 1; d < num_dims; d++) {                                              \
-            inner_size *= shape[d];                                                                \
-        }                                                                                          \
-        const size_t scan_size = shape[dim];                                                       \
-        const size_t scan_stride = strides[dim];                                                   \
+    void hodu_cpu_##NAME##_reverse_##TYPE_SUFFIX(const void *input, void *output,                  \
+                                                 const size_t *metadata) {                         \
+        HODU_PROFILE_KERNEL(metadata[0] * 2 * sizeof(TYPE));                                       \
+        scan_run(input, output, metadata, sizeof(TYPE), sizeof(ACC), NAME##_lanes_##TYPE_SUFFIX,   \
+                 NAME##_carry_##TYPE_SUFFIX, SCAN_REVERSE);                                        \
+    }                                                                                              \
                                                                                                    \
-        for (size_t outer = 0; outer < outer_size; outer++) {                                      \
-            for (size_t inner = 0; inner < inner_size; inner++) {                                  \
-                float acc = 1.0f;                                                                  \
-                for (size_t s = 0; s < scan_size; s++) {                                           \
-                    size_t in_idx = 0;                                                             \
-                    size_t out_idx = 0;                                                            \
-                    size_t tmp_outer = outer;                                                      \
-                    for (size_t d = 0; d < dim; d++) {                                             \
-                        size_t coord = tmp_outer % shape[d];                                       \
-                        tmp_outer /= shape[d];                                                     \
-                        in_idx += coord * strides[d];                                              \
-                        out_idx += coord * out_strides[d];                                         \
-                    }                                                                              \
-                    in_idx += s * scan_stride;                                                     \
-                    out_idx += s * out_strides[dim];                                               \
-                    size_t tmp_inner = inner;                                                      \
-                    for (size_t d = num_dims - 1; d > dim; d--) {                                  \
-                        size_t coord = tmp_inner % shape[d];                                       \
-                        tmp_inner /= shape[d];                                                     \
-                        in_idx += coord * strides[d];                                              \
-                        out_idx += coord * out_strides[d];                                         \
-                    }                                                                              \
-                    acc *= TO_FLOAT(in[in_idx]);                                                   \
-                    out[out_idx] = FROM_FLOAT(acc);                                                \
-                }                                                                                  \
-            }                                                                                      \
-        }                                                                                          \
+    void hodu_cpu_##NAME##_reverse_exclusive_##TYPE_SUFFIX(const void *input, void *output,        \
+                                                           const size_t *metadata) {               \
+        HODU_PROFILE_KERNEL(metadata[0] * 2 * sizeof(TYPE));                                       \
+        scan_run(input, output, metadata, sizeof(TYPE), sizeof(ACC), NAME##_lanes_##TYPE_SUFFIX,   \
+                 NAME##_carry_##TYPE_SUFFIX, SCAN_EXCLUSIVE | SCAN_REVERSE);                       \
     }
 
-IMPL_CUMPROD_CONVERT(f8e4m3_t, f8e4m3, f8e4m3_to_float, float_to_f8e4m3)
-IMPL_CUMPROD_CONVERT(f8e5m2_t, f8e5m2, f8e5m2_to_float, float_to_f8e5m2)
-IMPL_CUMPROD_CONVERT(bf16_t, bf16, bf16_to_float, float_to_bf16)
-IMPL_CUMPROD_CONVERT(f16_t, f16, f16_to_float, float_to_f16)
+/// Instantiate every scan operation for a type accumulated in itself
+#define IMPL_SCAN_ALL(TYPE, TYPE_SUFFIX, LOWEST, HIGHEST)                                          \
+    IMPL_SCAN(cumsum, TYPE, TYPE_SUFFIX, TYPE, 0, SCAN_ADD, SCAN_SAME, SCAN_SAME)                  \
+    IMPL_SCAN(cumprod, TYPE, TYPE_SUFFIX, TYPE, 1, SCAN_MUL, SCAN_SAME, SCAN_SAME)                 \
+    IMPL_SCAN(cummax, TYPE, TYPE_SUFFIX, TYPE, LOWEST, SCAN_MAX, SCAN_SAME, SCAN_SAME)             \
+    IMPL_SCAN(cummin, TYPE, TYPE_SUFFIX, TYPE, HIGHEST, SCAN_MIN, SCAN_SAME, SCAN_SAME)
+
+/// Instantiate every scan operation for a low-precision float type accumulated in f32
+#define IMPL_SCAN_ALL_CONVERT(TYPE, TYPE_SUFFIX, TO_FLOAT, FROM_FLOAT)                             \
+    IMPL_SCAN(cumsum, TYPE, TYPE_SUFFIX, float, 0.0f, SCAN_ADD, TO_FLOAT, FROM_FLOAT)              \
+    IMPL_SCAN(cumprod, TYPE, TYPE_SUFFIX, float, 1.0f, SCAN_MUL, TO_FLOAT, FROM_FLOAT)             \
+    IMPL_SCAN(cummax, TYPE, TYPE_SUFFIX, float, -INFINITY, SCAN_MAX, TO_FLOAT, FROM_FLOAT)         \
+    IMPL_SCAN(cummin, TYPE, TYPE_SUFFIX, float, INFINITY, SCAN_MIN, TO_FLOAT, FROM_FLOAT)
+
+IMPL_SCAN_ALL(f32_t, f32, -INFINITY, INFINITY)
+IMPL_SCAN_ALL(f64_t, f64, -INFINITY, INFINITY)
+IMPL_SCAN_ALL(u8_t, u8, 0, UINT8_MAX)
+IMPL_SCAN_ALL(u16_t, u16, 0, UINT16_MAX)
+IMPL_SCAN_ALL(u32_t, u32, 0, UINT32_MAX)
+IMPL_SCAN_ALL(u64_t, u64, 0, UINT64_MAX)
+IMPL_SCAN_ALL(i8_t, i8, INT8_MIN, INT8_MAX)
+IMPL_SCAN_ALL(i16_t, i16, INT16_MIN, INT16_MAX)
+IMPL_SCAN_ALL(i32_t, i32, INT32_MIN, INT32_MAX)
+IMPL_SCAN_ALL(i64_t, i64, INT64_MIN, INT64_MAX)
+
+IMPL_SCAN_ALL_CONVERT(f8e4m3_t, f8e4m3, f8e4m3_to_float, float_to_f8e4m3)
+IMPL_SCAN_ALL_CONVERT(f8e5m2_t, f8e5m2, f8e5m2_to_float, float_to_f8e5m2)
+IMPL_SCAN_ALL_CONVERT(bf16_t, bf16, bf16_to_float, float_to_bf16)
+IMPL_SCAN_ALL_CONVERT(f16_t, f16, f16_to_float, float_to_f16)
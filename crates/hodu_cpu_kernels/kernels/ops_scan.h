@@ -7,7 +7,8 @@
 extern "C" {
 #endif
 
-// Cumulative sum operations
+// Scan operations: cumsum, cumprod, cummax and cummin, each inclusive or exclusive and forward
+// or reverse (hodu_cpu_<op>[_reverse][_exclusive]_<dtype>)
 // Metadata layout:
 // - metadata[0]: num_els (total number of elements)
 // - metadata[1]: num_dims (number of dimensions)
@@ -15,6 +16,10 @@ extern "C" {
 // - metadata[2+num_dims..2+2*num_dims]: strides
 // - metadata[2+2*num_dims]: offset
 // - metadata[3+2*num_dims]: dim (dimension to scan along)
+//
+// The output is contiguous with the input's shape. Exclusive scans start from the identity
+// (0, 1, lowest, highest), reverse scans run from the end of dim. cummax/cummin propagate NaN;
+// bf16/f16/f8 accumulate in f32.
 
 void hodu_cpu_cumsum_f8e4m3(const void *input, void *output, const size_t *metadata);
 void hodu_cpu_cumsum_f8e5m2(const void *input, void *output, const size_t *metadata);
@@ -31,6 +36,256 @@ void hodu_cpu_cumsum_i16(const void *input, void *output, const size_t *metadata
 void hodu_cpu_cumsum_i32(const void *input, void *output, const size_t *metadata);
 void hodu_cpu_cumsum_i64(const void *input, void *output, const size_t *metadata);
 
+void hodu_cpu_cumsum_exclusive_f8e4m3(const void *input, void *output, const size_t *metadata);
+void hodu_cpu_cumsum_exclusive_f8e5m2(const void *input, void *output, const size_t *metadata);
+void hodu_cpu_cumsum_exclusive_bf16(const void *input, void *output, const size_t *metadata);
+void hodu_cpu_cumsum_exclusive_f16(const void *input, void *output, const size_t *metadata);
+void hodu_cpu_cumsum_exclusive_f32(const void *input, void *output, const size_t *metadata);
+void hodu_cpu_cumsum_exclusive_f64(const void *input, void *output, const size_t *metadata);
+void hodu_cpu_cumsum_exclusive_u8(const void *input, void *output, const size_t *metadata);
+void hodu_cpu_cumsum_exclusive_u16(const void *input, void *output, const size_t *metadata);
+void hodu_cpu_cumsum_exclusive_u32(const void *input, void *output, const size_t *metadata);
+void hodu_cpu_cumsum_exclusive_u64(const void *input, void *output, const size_t *metadata);
+void hodu_cpu_cumsum_exclusive_i8(const void *input, void *output, const size_t *metadata);
+void hodu_cpu_cumsum_exclusive_i16(const void *input, void *output, const size_t *metadata);
+void hodu_cpu_cumsum_exclusive_i32(const void *input, void *output, const size_t *metadata);
+void hodu_cpu_cumsum_exclusive_i64(const void *input, void *output, const size_t *metadata);
+
+void hodu_cpu_cumsum_reverse_f8e4m3(const void *input, void *output, const size_t *metadata);
+void hodu_cpu_cumsum_reverse_f8e5m2(const void *input, void *output, const size_t *metadata);
+void hodu_cpu_cumsum_reverse_bf16(const void *input, void *output, const size_t *metadata);
+void hodu_cpu_cumsum_reverse_f16(const void *input, void *output, const size_t *metadata);
+void hodu_cpu_cumsum_reverse_f32(const void *input, void *output, const size_t *metadata);
+void hodu_cpu_cumsum_reverse_f64(const void *input, void *output, const size_t *metadata);
+void hodu_cpu_cumsum_reverse_u8(const void *input, void *output, const size_t *metadata);
+void hodu_cpu_cumsum_reverse_u16(const void *input, void *output, const size_t *metadata);
+void hodu_cpu_cumsum_reverse_u32(const void *input, void *output, const size_t *metadata);
+void hodu_cpu_cumsum_reverse_u64(const void *input, void *output, const size_t *metadata);
+void hodu_cpu_cumsum_reverse_i8(const void *input, void *output, const size_t *metadata);
+void hodu_cpu_cumsum_reverse_i16(const void *input, void *output, const size_t *metadata);
+void hodu_cpu_cumsum_reverse_i32(const void *input, void *output, const size_t *metadata);
+void hodu_cpu_cumsum_reverse_i64(const void *input, void *output, const size_t *metadata);
+
+void hodu_cpu_cumsum_reverse_exclusive_f8e4m3(const void *input, void *output,
+                                              const size_t *metadata);
+void hodu_cpu_cumsum_reverse_exclusive_f8e5m2(const void *input, void *output,
+                                              const size_t *metadata);
+void hodu_cpu_cumsum_reverse_exclusive_bf16(const void *input, void *output,
+                                            const size_t *metadata);
+void hodu_cpu_cumsum_reverse_exclusive_f16(const void *input, void *output, const size_t *metadata);
+void hodu_cpu_cumsum_reverse_exclusive_f32(const void *input, void *output, const size_t *metadata);
+void hodu_cpu_cumsum_reverse_exclusive_f64(const void *input, void *output, const size_t *metadata);
+void hodu_cpu_cumsum_reverse_exclusive_u8(const void *input, void *output, const size_t *metadata);
+void hodu_cpu_cumsum_reverse_exclusive_u16(const void *input, void *output, const size_t *metadata);
+void hodu_cpu_cumsum_reverse_exclusive_u32(const void *input, void *output, const size_t *metadata);
+void hodu_cpu_cumsum_reverse_exclusive_u64(const void *input, void *output, const size_t *metadata);
+void hodu_cpu_cumsum_reverse_exclusive_i8(const void *input, void *output, const size_t *metadata);
+void hodu_cpu_cumsum_reverse_exclusive_i16(const void *input, void *output, const size_t *metadata);
+void hodu_cpu_cumsum_reverse_exclusive_i32(const void *input, void *output, const size_t *metadata);
+void hodu_cpu_cumsum_reverse_exclusive_i64(const void *input, void *output, const size_t *metadata);
+
+void hodu_cpu_cumprod_f8e4m3(const void *input, void *output, const size_t *metadata);
+void hodu_cpu_cumprod_f8e5m2(const void *input, void *output, const size_t *metadata);
+void hodu_cpu_cumprod_bf16(const void *input, void *output, const size_t *metadata);
+void hodu_cpu_cumprod_f16(const void *input, void *output, const size_t *metadata);
+void hodu_cpu_cumprod_f32(const void *input, void *output, const size_t *metadata);
+void hodu_cpu_cumprod_f64(const void *input, void *output, const size_t *metadata);
+void hodu_cpu_cumprod_u8(const void *input, void *output, const size_t *metadata);
+void hodu_cpu_cumprod_u16(const void *input, void *output, const size_t *metadata);
+void hodu_cpu_cumprod_u32(const void *input, void *output, const size_t *metadata);
+void hodu_cpu_cumprod_u64(const void *input, void *output, const size_t *metadata);
+void hodu_cpu_cumprod_i8(const void *input, void *output, const size_t *metadata);
+void hodu_cpu_cumprod_i16(const void *input, void *output, const size_t *metadata);
+void hodu_cpu_cumprod_i32(const void *input, void *output, const size_t *metadata);
+void hodu_cpu_cumprod_i64(const void *input, void *output, const size_t *metadata);
+
+void hodu_cpu_cumprod_exclusive_f8e4m3(const void *input, void *output, const size_t *metadata);
+void hodu_cpu_cumprod_exclusive_f8e5m2(const void *input, void *output, const size_t *metadata);
+void hodu_cpu_cumprod_exclusive_bf16(const void *input, void *output, const size_t *metadata);
+void hodu_cpu_cumprod_exclusive_f16(const void *input, void *output, const size_t *metadata);
+void hodu_cpu_cumprod_exclusive_f32(const void *input, void *output, const size_t *metadata);
+void hodu_cpu_cumprod_exclusive_f64(const void *input, void *output, const size_t *metadata);
+void hodu_cpu_cumprod_exclusive_u8(const void *input, void *output, const size_t *metadata);
+void hodu_cpu_cumprod_exclusive_u16(const void *input, void *output, const size_t *metadata);
+void hodu_cpu_cumprod_exclusive_u32(const void *input, void *output, const size_t *metadata);
+void hodu_cpu_cumprod_exclusive_u64(const void *input, void *output, const size_t *metadata);
+void hodu_cpu_cumprod_exclusive_i8(const void *input, void *output, const size_t *metadata);
+void hodu_cpu_cumprod_exclusive_i16(const void *input, void *output, const size_t *metadata);
+void hodu_cpu_cumprod_exclusive_i32(const void *input, void *output, const size_t *metadata);
+void hodu_cpu_cumprod_exclusive_i64(const void *input, void *output, const size_t *metadata);
+
+void hodu_cpu_cumprod_reverse_f8e4m3(const void *input, void *output, const size_t *metadata);
+void hodu_cpu_cumprod_reverse_f8e5m2(const void *input, void *output, const size_t *metadata);
+void hodu_cpu_cumprod_reverse_bf16(const void *input, void *output, const size_t *metadata);
+void hodu_cpu_cumprod_reverse_f16(const void *input, void *output, const size_t *metadata);
+void hodu_cpu_cumprod_reverse_f32(const void *input, void *output, const size_t *metadata);
+void hodu_cpu_cumprod_reverse_f64(const void *input, void *output, const size_t *metadata);
+void hodu_cpu_cumprod_reverse_u8(const void *input, void *output, const size_t *metadata);
+void hodu_cpu_cumprod_reverse_u16(const void *input, void *output, const size_t *metadata);
+void hodu_cpu_cumprod_reverse_u32(const void *input, void *output, const size_t *metadata);
+void hodu_cpu_cumprod_reverse_u64(const void *input, void *output, const size_t *metadata);
+void hodu_cpu_cumprod_reverse_i8(const void *input, void *output, const size_t *metadata);
+void hodu_cpu_cumprod_reverse_i16(const void *input, void *output, const size_t *metadata);
+void hodu_cpu_cumprod_reverse_i32(const void *input, void *output, const size_t *metadata);
+void hodu_cpu_cumprod_reverse_i64(const void *input, void *output, const size_t *metadata);
+
+void hodu_cpu_cumprod_reverse_exclusive_f8e4m3(const void *input, void *output,
+                                               const size_t *metadata);
+void hodu_cpu_cumprod_reverse_exclusive_f8e5m2(const void *input, void *output,
+                                               const size_t *metadata);
+void hodu_cpu_cumprod_reverse_exclusive_bf16(const void *input, void *output,
+                                             const size_t *metadata);
+void hodu_cpu_cumprod_reverse_exclusive_f16(const void *input, void *output,
+                                            const size_t *metadata);
+void hodu_cpu_cumprod_reverse_exclusive_f32(const void *input, void *output,
+                                            const size_t *metadata);
+void hodu_cpu_cumprod_reverse_exclusive_f64(const void *input, void *output,
+                                            const size_t *metadata);
+void hodu_cpu_cumprod_reverse_exclusive_u8(const void *input, void *output, const size_t *metadata);
+void hodu_cpu_cumprod_reverse_exclusive_u16(const void *input, void *output,
+                                            const size_t *metadata);
+void hodu_cpu_cumprod_reverse_exclusive_u32(const void *input, void *output,
+                                            const size_t *metadata);
+void hodu_cpu_cumprod_reverse_exclusive_u64(const void *input, void *output,
+                                            const size_t *metadata);
+void hodu_cpu_cumprod_reverse_exclusive_i8(const void *input, void *output, const size_t *metadata);
+void hodu_cpu_cumprod_reverse_exclusive_i16(const void *input, void *output,
+                                            const size_t *metadata);
+void hodu_cpu_cumprod_reverse_exclusive_i32(const void *input, void *output,
+                                            const size_t *metadata);
+void hodu_cpu_cumprod_reverse_exclusive_i64(const void *input, void *output,
+                                            const size_t *metadata);
+
+void hodu_cpu_cummax_f8e4m3(const void *input, void *output, const size_t *metadata);
+void hodu_cpu_cummax_f8e5m2(const void *input, void *output, const size_t *metadata);
+void hodu_cpu_cummax_bf16(const void *input, void *output, const size_t *metadata);
+void hodu_cpu_cummax_f16(const void *input, void *output, const size_t *metadata);
+void hodu_cpu_cummax_f32(const void *input, void *output, const size_t *metadata);
+void hodu_cpu_cummax_f64(const void *input, void *output, const size_t *metadata);
+void hodu_cpu_cummax_u8(const void *input, void *output, const size_t *metadata);
+void hodu_cpu_cummax_u16(const void *input, void *output, const size_t *metadata);
+void hodu_cpu_cummax_u32(const void *input, void *output, const size_t *metadata);
+void hodu_cpu_cummax_u64(const void *input, void *output, const size_t *metadata);
+void hodu_cpu_cummax_i8(const void *input, void *output, const size_t *metadata);
+void hodu_cpu_cummax_i16(const void *input, void *output, const size_t *metadata);
+void hodu_cpu_cummax_i32(const void *input, void *output, const size_t *metadata);
+void hodu_cpu_cummax_i64(const void *input, void *output, const size_t *metadata);
+
+void hodu_cpu_cummax_exclusive_f8e4m3(const void *input, void *output, const size_t *metadata);
+void hodu_cpu_cummax_exclusive_f8e5m2(const void *input, void *output, const size_t *metadata);
+void hodu_cpu_cummax_exclusive_bf16(const void *input, void *output, const size_t *metadata);
+void hodu_cpu_cummax_exclusive_f16(const void *input, void *output, const size_t *metadata);
+void hodu_cpu_cummax_exclusive_f32(const void *input, void *output, const size_t *metadata);
+void hodu_cpu_cummax_exclusive_f64(const void *input, void *output, const size_t *metadata);
+void hodu_cpu_cummax_exclusive_u8(const void *input, void *output, const size_t *metadata);
+void hodu_cpu_cummax_exclusive_u16(const void *input, void *output, const size_t *metadata);
+void hodu_cpu_cummax_exclusive_u32(const void *input, void *output, const size_t *metadata);
+void hodu_cpu_cummax_exclusive_u64(const void *input, void *output, const size_t *metadata);
+void hodu_cpu_cummax_exclusive_i8(const void *input, void *output, const size_t *metadata);
+void hodu_cpu_cummax_exclusive_i16(const void *input, void *output, const size_t *metadata);
+void hodu_cpu_cummax_exclusive_i32(const void *input, void *output, const size_t *metadata);
+void hodu_cpu_cummax_exclusive_i64(const void *input, void *output, const size_t *metadata);
+
+void hodu_cpu_cummax_reverse_f8e4m3(const void *input, void *output, const size_t *metadata);
+void hodu_cpu_cummax_reverse_f8e5m2(const void *input, void *output, const size_t *metadata);
+void hodu_cpu_cummax_reverse_bf16(const void *input, void *output, const size_t *metadata);
+void hodu_cpu_cummax_reverse_f16(const void *input, void *output, const size_t *metadata);
+void hodu_cpu_cummax_reverse_f32(const void *input, void *output, const size_t *metadata);
+void hodu_cpu_cummax_reverse_f64(const void *input, void *output, const size_t *metadata);
+void hodu_cpu_cummax_reverse_u8(const void *input, void *output, const size_t *metadata);
+void hodu_cpu_cummax_reverse_u16(const void *input, void *output, const size_t *metadata);
+void hodu_cpu_cummax_reverse_u32(const void *input, void *output, const size_t *metadata);
+void hodu_cpu_cummax_reverse_u64(const void *input, void *output, const size_t *metadata);
+void hodu_cpu_cummax_reverse_i8(const void *input, void *output, const size_t *metadata);
+void hodu_cpu_cummax_reverse_i16(const void *input, void *output, const size_t *metadata);
+void hodu_cpu_cummax_reverse_i32(const void *input, void *output, const size_t *metadata);
+void hodu_cpu_cummax_reverse_i64(const void *input, void *output, const size_t *metadata);
+
+void hodu_cpu_cummax_reverse_exclusive_f8e4m3(const void *input, void *output,
+                                              const size_t *metadata);
+void hodu_cpu_cummax_reverse_exclusive_f8e5m2(const void *input, void *output,
+                                              const size_t *metadata);
+void hodu_cpu_cummax_reverse_exclusive_bf16(const void *input, void *output,
+                                            const size_t *metadata);
+void hodu_cpu_cummax_reverse_exclusive_f16(const void *input, void *output, const size_t *metadata);
+void hodu_cpu_cummax_reverse_exclusive_f32(const void *input, void *output, const size_t *metadata);
+void hodu_cpu_cummax_reverse_exclusive_f64(const void *input, void *output, const size_t *metadata);
+void hodu_cpu_cummax_reverse_exclusive_u8(const void *input, void *output, const size_t *metadata);
+void hodu_cpu_cummax_reverse_exclusive_u16(const void *input, void *output, const size_t *metadata);
+void hodu_cpu_cummax_reverse_exclusive_u32(const void *input, void *output, const size_t *metadata);
+void hodu_cpu_cummax_reverse_exclusive_u64(const void *input, void *output, const size_t *metadata);
+void hodu_cpu_cummax_reverse_exclusive_i8(const void *input, void *output, const size_t *metadata);
+void hodu_cpu_cummax_reverse_exclusive_i16(const void *input, void *output, const size_t *metadata);
+void hodu_cpu_cummax_reverse_exclusive_i32(const void *input, void *output, const size_t *metadata);
+void hodu_cpu_cummax_reverse_exclusive_i64(const void *input, void *output, const size_t *metadata);
+
+void hodu_cpu_cummin_f8e4m3(const void *input, void *output, const size_t *metadata);
+void hodu_cpu_cummin_f8e5m2(const void *input, void *output, const size_t *metadata);
+void hodu_cpu_cummin_bf16(const void *input, void *output, const size_t *metadata);
+void hodu_cpu_cummin_f16(const void *input, void *output, const size_t *metadata);
+void hodu_cpu_cummin_f32(const void *input, void *output, const size_t *metadata);
+void hodu_cpu_cummin_f64(const void *input, void *output, const size_t *metadata);
+void hodu_cpu_cummin_u8(const void *input, void *output, const size_t *metadata);
+void hodu_cpu_cummin_u16(const void *input, void *output, const size_t *metadata);
+void hodu_cpu_cummin_u32(const void *input, void *output, const size_t *metadata);
+void hodu_cpu_cummin_u64(const void *input, void *output, const size_t *metadata);
+void hodu_cpu_cummin_i8(const void *input, void *output, const size_t *metadata);
+void hodu_cpu_cummin_i16(const void *input, void *output, const size_t *metadata);
+void hodu_cpu_cummin_i32(const void *input, void *output, const size_t *metadata);
+void hodu_cpu_cummin_i64(const void *input, void *output, const size_t *metadata);
+
+void hodu_cpu_cummin_exclusive_f8e4m3(const void *input, void *output, const size_t *metadata);
+void hodu_cpu_cummin_exclusive_f8e5m2(const void *input, void *output, const size_t *metadata);
+void hodu_cpu_cummin_exclusive_bf16(const void *input, void *output, const size_t *metadata);
+void hodu_cpu_cummin_exclusive_f16(const void *input, void *output, const size_t *metadata);
+void hodu_cpu_cummin_exclusive_f32(const void *input, void *output, const size_t *metadata);
+void hodu_cpu_cummin_exclusive_f64(const void *input, void *output, const size_t *metadata);
+void hodu_cpu_cummin_exclusive_u8(const void *input, void *output, const size_t *metadata);
+void hodu_cpu_cummin_exclusive_u16(const void *input, void *output, const size_t *metadata);
+void hodu_cpu_cummin_exclusive_u32(const void *input, void *output, const size_t *metadata);
+void hodu_cpu_cummin_exclusive_u64(const void *input, void *output, const size_t *metadata);
+void hodu_cpu_cummin_exclusive_i8(const void *input, void *output, const size_t *metadata);
+void hodu_cpu_cummin_exclusive_i16(const void *input, void *output, const size_t *metadata);
+void hodu_cpu_cummin_exclusive_i32(const void *input, void *output, const size_t *metadata);
+void hodu_cpu_cummin_exclusive_i64(const void *input, void *output, const size_t *metadata);
+
+void hodu_cpu_cummin_reverse_f8e4m3(const void *input, void *output, const size_t *metadata);
+void hodu_cpu_cummin_reverse_f8e5m2(const void *input, void *output, const size_t *metadata);
+void hodu_cpu_cummin_reverse_bf16(const void *input, void *output, const size_t *metadata);
+void hodu_cpu_cummin_reverse_f16(const void *input, void *output, const size_t *metadata);
+void hodu_cpu_cummin_reverse_f32(const void *input, void *output, const size_t *metadata);
+void hodu_cpu_cummin_reverse_f64(const void *input, void *output, const size_t *metadata);
+void hodu_cpu_cummin_reverse_u8(const void *input, void *output, const size_t *metadata);
+void hodu_cpu_cummin_reverse_u16(const void *input, void *output, const size_t *metadata);
+void hodu_cpu_cummin_reverse_u32(const void *input, void *output, const size_t *metadata);
+void hodu_cpu_cummin_reverse_u64(const void *input, void *output, const size_t *metadata);
+void hodu_cpu_cummin_reverse_i8(const void *input, void *output, const size_t *metadata);
+void hodu_cpu_cummin_reverse_i16(const void *input, void *output, const size_t *metadata);
+void hodu_cpu_cummin_reverse_i32(const void *input, void *output, const size_t *metadata);
+void hodu_cpu_cummin_reverse_i64(const void *input, void *output, const size_t *metadata);
+
+void hodu_cpu_cummin_reverse_exclusive_f8e4m3(const void *input, void *output,
+                                              const size_t *metadata);
+void hodu_cpu_cummin_reverse_exclusive_f8e5m2(const void *input, void *output,
+                                              const size_t *metadata);
+void hodu_cpu_cummin_reverse_exclusive_bf16(const void *input, void *output,
+                                            const size_t *metadata);
+void hodu_cpu_cummin_reverse_exclusive_f16(const void *input, void *output, const size_t *metadata);
+void hodu_cpu_cummin_reverse_exclusive_f32(const void *input, void *output, const size_t *metadata);
+void hodu_cpu_cummin_reverse_exclusive_f64(const void *input, void *output, const size_t *metadata);
+void hodu_cpu_cummin_reverse_exclusive_u8(const void *input, void *output, const size_t *metadata);
+void hodu_cpu_cummin_reverse_exclusive_u16(const void *input, void *output, const size_t *metadata);
+void hodu_cpu_cummin_reverse_exclusive_u32(const void *input, void *output, const size_t *metadata);
+void hodu_cpu_cummin_reverse_exclusive_u64(const void *input, void *output, const size_t *metadata);
+void hodu_cpu_cummin_reverse_exclusive_i8(const void *input, void *output, const size_t *metadata);
+void hodu_cpu_cummin_reverse_exclusive_i16(const void *input, void *output, const size_t *metadata);
+void hodu_cpu_cummin_reverse_exclusive_i32(const void *input, void *output, const size_t *metadata);
+void hodu_cpu_cummin_reverse_exclusive_i64(const void *input, void *output, const size_t *metadata);
+
+/// Scratch bytes a scan call takes from the workspace (any op, dtype or variant; see
+/// workspace.h)
+size_t hodu_cpu_scan_workspace_size(const size_t *metadata);
+
 #ifdef __cplusplus
 }
 #endif
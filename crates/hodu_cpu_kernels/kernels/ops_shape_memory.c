@@ -1,4 +1,6 @@
 #include "ops_shape_memory.h"
+#include "profile.h"
+#include "strided_copy.h"
 #include "types.h"
 #include <stdbool.h>
 
@@ -12,30 +14,13 @@
 
 #define IMPL_FLIP_OP(TYPE, TYPE_SUFFIX)                                                            \
     void hodu_cpu_flip_##TYPE_SUFFIX(const void *input, void *output, const size_t *metadata) {    \
-        const size_t num_els = metadata[0];                                                        \
+        HODU_PROFILE_KERNEL(2 * hodu_cpu_profile_numel(metadata + 2, metadata[1]) * sizeof(TYPE)); \
         const size_t num_dims = metadata[1];                                                       \
         const size_t *shape = metadata + 2;                                                        \
         const size_t *flip_mask = metadata + 2 + num_dims;                                         \
                                                                                                    \
-        const TYPE *in = (const TYPE *)input;                                                      \
-        TYPE *out = (TYPE *)output;                                                                \
-                                                                                                   \
-        for (size_t i = 0; i < num_els; i++) {                                                     \
-            size_t remaining = i;                                                                  \
-            size_t input_idx = 0;                                                                  \
-            size_t in_stride = 1;                                                                  \
-                                                                                                   \
-            for (size_t d = num_dims; d-- > 0;) {                                                  \
-                size_t coord = remaining % shape[d];                                               \
-                remaining /= shape[d];                                                             \
-                                                                                                   \
-                size_t in_coord = flip_mask[d] ? (shape[d] - 1 - coord) : coord;                   \
-                input_idx += in_coord * in_stride;                                                 \
-                in_stride *= shape[d];                                                             \
-            }                                                                                      \
-                                                                                                   \
-            out[i] = in[input_idx];                                                                \
-        }                                                                                          \
+        /* Flipped dims become negative strides; unflipped inner runs stay memcpy */               \
+        hodu_cpu_strided_copy(input, output, sizeof(TYPE), num_dims, shape, NULL, flip_mask);      \
     }
 
 IMPL_FLIP_OP(bool, bool)
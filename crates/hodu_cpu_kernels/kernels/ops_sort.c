@@ -1,154 +1,866 @@
 #include "ops_sort.h"
+#include "profile.h"
+#include "thread_utils.h"
 #include "types.h"
-#include <stdlib.h>
+#include "utils.h"
+#include "workspace.h"
+#include <stdbool.h>
+#include <string.h>
+
+// ============================================================================
+// SORT KEYS
+// ============================================================================
+//
+// Elements are compared through order-preserving unsigned keys of their own
+// width instead of being converted to float, so 64-bit integers and doubles
+// keep their exact order:
+// - unsigned integers are their own key
+// - signed integers flip the sign bit
+// - floating-point bit patterns (sign-magnitude) flip the sign bit when
+//   positive and every bit when negative; -0 is folded into +0 and every NaN
+//   maps to the largest key, so NaNs rank above +inf
+
+/**
+ * @brief Macro to define the key of a floating-point bit pattern
+ *
+ * @param NAME Function name
+ * @param UTYPE Unsigned type of the bit pattern
+ * @param SIGN Sign bit
+ * @param INF Magnitude bits of infinity (of the largest finite value for f8e4m3); larger
+ *            magnitudes are NaN
+ */
+#define SORT_FLOAT_KEY(NAME, UTYPE, SIGN, INF)                                                     \
+    static inline uint64_t NAME(UTYPE b) {                                                         \
+        if ((UTYPE)(b & ~(UTYPE)SIGN) > (UTYPE)(INF)) {                                            \
+            return (UTYPE)~(UTYPE)0;                                                               \
+        }                                                                                          \
+        if (b == (UTYPE)(SIGN)) {                                                                  \
+            b = 0;                                                                                 \
+        }                                                                                          \
+        return (b & (UTYPE)(SIGN)) ? (UTYPE)~b : (UTYPE)(b | (UTYPE)(SIGN));                       \
+    }
+
+SORT_FLOAT_KEY(sort_key_f8e4m3, uint8_t, 0x80u, 0x7eu)
+SORT_FLOAT_KEY(sort_key_f8e5m2, uint8_t, 0x80u, 0x7cu)
+SORT_FLOAT_KEY(sort_key_bf16, uint16_t, 0x8000u, 0x7f80u)
+SORT_FLOAT_KEY(sort_key_f16, uint16_t, 0x8000u, 0x7c00u)
+SORT_FLOAT_KEY(sort_key_bits32, uint32_t, 0x80000000u, 0x7f800000u)
+SORT_FLOAT_KEY(sort_key_bits64, uint64_t, 0x8000000000000000ull, 0x7ff0000000000000ull)
+
+static inline uint64_t sort_key_f32(f32_t f) {
+    uint32_t b;
+    memcpy(&b, &f, sizeof(b));
+    return sort_key_bits32(b);
+}
+
+static inline uint64_t sort_key_f64(f64_t f) {
+    uint64_t b;
+    memcpy(&b, &f, sizeof(b));
+    return sort_key_bits64(b);
+}
+
+// ============================================================================
+// TOP-K ENGINE
+// ============================================================================
+//
+// Selection runs on (key, index) items and always picks the k "first" items:
+// larger key first, ties to the lower index. For smallest the keys are
+// complemented.
+//
+// Per row:
+// - k small relative to the row: a bounded heap of the best k so far (worst
+//   at the root). Keys are computed a block at a time and compared against the
+//   root's key, so most elements cost one compare
+// - otherwise: introselect over all items, then an introsort of the first k
+//   when sorted output is requested (or k covers the row)
+// Rows run in parallel. When there are fewer rows than threads, long rows are
+// split into chunks whose heaps are merged, so a single large-vocab row still
+// uses every core. Scratch comes from each thread's workspace and is reused
+// across the rows of a task.
+
+// Keys computed per step of the heap scan
+#define TOPK_BLOCK 256
+// Heap path when k * TOPK_HEAP_RATIO <= row length
+#define TOPK_HEAP_RATIO 16
+// Minimum elements per chunk of a split row, and most chunks per row
+#define TOPK_SPLIT_MIN ((size_t)1 << 15)
+#define TOPK_MAX_CHUNKS 64
+// Minimum elements per row task
+#define TOPK_TASK_ELEMS ((size_t)1 << 14)
+// Ranges at most this long are finished with insertion sort
+#define TOPK_INSERTION 16
 
-// Helper struct for sorting with indices
 typedef struct {
-    float value;
-    i32_t index;
-} ValueIndex;
-
-// Comparison functions for qsort
-static int cmp_largest(const void *a, const void *b) {
-    float va = ((ValueIndex *)a)->value;
-    float vb = ((ValueIndex *)b)->value;
-    if (va > vb)
-        return -1;
-    if (va < vb)
-        return 1;
-    return 0;
+    uint64_t key;
+    uint32_t idx;
+} sort_item_t;
+
+/// Writes the keys of row[start .. start + n) to keys, complemented when !largest
+typedef void (*topk_key_fn_t)(const void *row, size_t start, size_t n, bool largest,
+                              uint64_t *keys);
+
+/// Whether a ranks before b
+static inline bool topk_before(const sort_item_t *a, const sort_item_t *b) {
+    return a->key > b->key || (a->key == b->key && a->idx < b->idx);
 }
 
-static int cmp_smallest(const void *a, const void *b) {
-    float va = ((ValueIndex *)a)->value;
-    float vb = ((ValueIndex *)b)->value;
-    if (va < vb)
-        return -1;
-    if (va > vb)
-        return 1;
-    return 0;
+static inline void topk_swap(sort_item_t *a, sort_item_t *b) {
+    const sort_item_t t = *a;
+    *a = *b;
+    *b = t;
 }
 
-// Partition for quickselect
-static size_t partition(ValueIndex *arr, size_t left, size_t right, int largest) {
-    float pivot = arr[right].value;
-    size_t i = left;
-    for (size_t j = left; j < right; j++) {
-        int should_swap = largest ? (arr[j].value > pivot) : (arr[j].value < pivot);
-        if (should_swap) {
-            ValueIndex tmp = arr[i];
-            arr[i] = arr[j];
-            arr[j] = tmp;
-            i++;
+/// Restore the heap (every parent ranks after its children) below position i
+static void topk_sift_down(sort_item_t *heap, size_t n, size_t i) {
+    const sort_item_t item = heap[i];
+    for (;;) {
+        size_t c = 2 * i + 1;
+        if (c >= n) {
+            break;
+        }
+        if (c + 1 < n && topk_before(&heap[c], &heap[c + 1])) {
+            c++;
         }
+        if (!topk_before(&item, &heap[c])) {
+            break;
+        }
+        heap[i] = heap[c];
+        i = c;
     }
-    ValueIndex tmp = arr[i];
-    arr[i] = arr[right];
-    arr[right] = tmp;
-    return i;
+    heap[i] = item;
 }
 
-// QuickSelect to find k-th element and partition array
-static void quickselect_k(ValueIndex *arr, size_t n, size_t k, int largest) {
-    if (n <= 1 || k == 0)
-        return;
+static void topk_sift_up(sort_item_t *heap, size_t i) {
+    const sort_item_t item = heap[i];
+    while (i > 0) {
+        const size_t p = (i - 1) / 2;
+        if (!topk_before(&heap[p], &item)) {
+            break;
+        }
+        heap[i] = heap[p];
+        i = p;
+    }
+    heap[i] = item;
+}
 
-    size_t left = 0;
-    size_t right = n - 1;
+/// Offer an item to a heap of at most k items holding *size
+static inline void topk_offer(sort_item_t *heap, size_t *size, size_t k, sort_item_t item) {
+    if (*size < k) {
+        heap[*size] = item;
+        topk_sift_up(heap, (*size)++);
+    } else if (topk_before(&item, &heap[0])) {
+        heap[0] = item;
+        topk_sift_down(heap, k, 0);
+    }
+}
 
-    while (left < right) {
-        size_t pivot_idx = partition(arr, left, right, largest);
-        if (pivot_idx == k - 1) {
-            break;
-        } else if (pivot_idx < k - 1) {
-            left = pivot_idx + 1;
+/// Sort a heap of n items into first-to-last order
+static void topk_heap_sort(sort_item_t *heap, size_t n) {
+    for (size_t m = n; m > 1; m--) {
+        topk_swap(&heap[0], &heap[m - 1]);
+        topk_sift_down(heap, m - 1, 0);
+    }
+}
+
+static void topk_insertion_sort(sort_item_t *a, size_t n) {
+    for (size_t i = 1; i < n; i++) {
+        const sort_item_t item = a[i];
+        size_t j = i;
+        while (j > 0 && topk_before(&item, &a[j - 1])) {
+            a[j] = a[j - 1];
+            j--;
+        }
+        a[j] = item;
+    }
+}
+
+/// Partition around a median-of-three pivot; returns its final position
+static size_t topk_partition(sort_item_t *a, size_t n) {
+    const size_t mid = n / 2;
+    if (topk_before(&a[mid], &a[0])) {
+        topk_swap(&a[mid], &a[0]);
+    }
+    if (topk_before(&a[n - 1], &a[0])) {
+        topk_swap(&a[n - 1], &a[0]);
+    }
+    if (topk_before(&a[n - 1], &a[mid])) {
+        topk_swap(&a[n - 1], &a[mid]);
+    }
+    // a[0] <= a[mid] <= a[n - 1] in rank order: use the median as pivot
+    topk_swap(&a[mid], &a[n - 2]);
+    const sort_item_t pivot = a[n - 2];
+    size_t i = 1;
+    for (size_t j = 1; j < n - 2; j++) {
+        if (topk_before(&a[j], &pivot)) {
+            topk_swap(&a[i++], &a[j]);
+        }
+    }
+    topk_swap(&a[i], &a[n - 2]);
+    return i;
+}
+
+static size_t topk_depth_limit(size_t n) {
+    size_t depth = 0;
+    while (n > 1) {
+        n >>= 1;
+        depth += 2;
+    }
+    return depth;
+}
+
+/// Introsort: quicksort, heapsort once the depth limit is hit, insertion sort for short ranges
+static void topk_sort(sort_item_t *a, size_t n, size_t depth) {
+    while (n > TOPK_INSERTION) {
+        if (depth == 0) {
+            for (size_t i = n / 2; i-- > 0;) {
+                topk_sift_down(a, n, i);
+            }
+            topk_heap_sort(a, n);
+            return;
+        }
+        depth--;
+        const size_t p = topk_partition(a, n);
+        // Recurse into the smaller side, loop on the larger
+        if (p < n - p - 1) {
+            topk_sort(a, p, depth);
+            a += p + 1;
+            n -= p + 1;
         } else {
-            right = pivot_idx - 1;
+            topk_sort(a + p + 1, n - p - 1, depth);
+            n = p;
         }
     }
+    topk_insertion_sort(a, n);
 }
 
-// Select top-k elements using partial sort
-static void topk_select(ValueIndex *arr, size_t n, size_t k, int largest, int sorted) {
-    if (k >= n) {
-        // If k >= n, just sort everything
-        if (largest) {
-            qsort(arr, n, sizeof(ValueIndex), cmp_largest);
+/// Introselect: move the first k items of a (in rank order) to a[0 .. k), unordered
+static void topk_select(sort_item_t *a, size_t n, size_t k) {
+    size_t lo = 0, hi = n;
+    size_t depth = topk_depth_limit(n);
+    while (hi - lo > TOPK_INSERTION) {
+        if (depth-- == 0) {
+            topk_sort(a + lo, hi - lo, 0);
+            return;
+        }
+        const size_t p = lo + topk_partition(a + lo, hi - lo);
+        if (p == k || p + 1 == k) {
+            return;
+        }
+        if (p > k) {
+            hi = p;
         } else {
-            qsort(arr, n, sizeof(ValueIndex), cmp_smallest);
+            lo = p + 1;
         }
-        return;
     }
+    topk_insertion_sort(a + lo, hi - lo);
+}
 
-    // Use quickselect to partition first k elements
-    quickselect_k(arr, n, k, largest);
+/// Heap of the best k items of row[start, end); returns its size
+static size_t topk_heap_scan(const void *row, topk_key_fn_t key_fn, bool largest, size_t start,
+                             size_t end, size_t k, sort_item_t *heap) {
+    uint64_t keys[TOPK_BLOCK];
+    size_t size = 0;
+    for (size_t b = start; b < end; b += TOPK_BLOCK) {
+        const size_t n = MINIMUM(TOPK_BLOCK, end - b);
+        key_fn(row, b, n, largest, keys);
+        size_t i = 0;
+        for (; i < n && size < k; i++) {
+            const sort_item_t item = {keys[i], (uint32_t)(b + i)};
+            topk_offer(heap, &size, k, item);
+        }
+        if (i == n) {
+            continue;
+        }
+        // Full heap: indices only grow, so an item needs a key above the root's to enter
+        uint64_t threshold = heap[0].key;
+        for (; i < n; i++) {
+            if (keys[i] > threshold) {
+                heap[0].key = keys[i];
+                heap[0].idx = (uint32_t)(b + i);
+                topk_sift_down(heap, k, 0);
+                threshold = heap[0].key;
+            }
+        }
+    }
+    return size;
+}
 
-    // Sort the first k elements if sorted is requested
-    if (sorted) {
-        if (largest) {
-            qsort(arr, k, sizeof(ValueIndex), cmp_largest);
+typedef struct {
+    const char *input;
+    char *values;
+    int32_t *indices;
+    topk_key_fn_t key_fn;
+    size_t elem_size;
+    size_t k;
+    size_t n;
+    bool largest;
+    bool sorted;
+    bool heap;
+    /* Split rows */
+    size_t chunks;
+    size_t chunk;
+    sort_item_t *candidates; // [row][chunk][k]
+    size_t *counts;          // [row][chunk]
+} topk_args_t;
+
+/// Write m selected items of row r to the outputs
+static void topk_emit(const topk_args_t *a, size_t r, const sort_item_t *items, size_t m) {
+    const char *row = a->input + r * a->n * a->elem_size;
+    char *val_row = a->values + r * a->k * a->elem_size;
+    int32_t *idx_row = a->indices + r * a->k;
+    for (size_t i = 0; i < m; i++) {
+        idx_row[i] = (int32_t)items[i].idx;
+        memcpy(val_row + i * a->elem_size, row + items[i].idx * a->elem_size, a->elem_size);
+    }
+}
+
+static void topk_row_worker(size_t start, size_t end, void *ctx) {
+    const topk_args_t *a = (const topk_args_t *)ctx;
+    const size_t k = MINIMUM(a->k, a->n);
+    sort_item_t *items = (sort_item_t *)workspace_acquire((a->heap ? k : a->n) *
+                                                          sizeof(sort_item_t));
+    if (!items) {
+        return;
+    }
+    for (size_t r = start; r < end; r++) {
+        const char *row = a->input + r * a->n * a->elem_size;
+        if (a->heap) {
+            const size_t m = topk_heap_scan(row, a->key_fn, a->largest, 0, a->n, k, items);
+            topk_heap_sort(items, m);
         } else {
-            qsort(arr, k, sizeof(ValueIndex), cmp_smallest);
+            uint64_t keys[TOPK_BLOCK];
+            for (size_t b = 0; b < a->n; b += TOPK_BLOCK) {
+                const size_t n = MINIMUM(TOPK_BLOCK, a->n - b);
+                a->key_fn(row, b, n, a->largest, keys);
+                for (size_t i = 0; i < n; i++) {
+                    items[b + i].key = keys[i];
+                    items[b + i].idx = (uint32_t)(b + i);
+                }
+            }
+            if (k < a->n) {
+                topk_select(items, a->n, k);
+            }
+            if (a->sorted || k == a->n) {
+                topk_sort(items, k, topk_depth_limit(k));
+            }
         }
+        topk_emit(a, r, items, k);
     }
+    workspace_release(items);
 }
 
-#define IMPL_TOPK(TYPE, TYPE_SUFFIX, TO_FLOAT)                                                     \
-    void hodu_cpu_topk_##TYPE_SUFFIX(const void *input, void *values, void *indices,               \
-                                     const size_t *metadata) {                                     \
-        const size_t k = metadata[1];                                                              \
-        const size_t last_dim_size = metadata[2];                                                  \
-        const size_t outer_size = metadata[3];                                                     \
-        const int largest = (int)metadata[4];                                                      \
-        const int sorted = (int)metadata[5];                                                       \
-        const size_t offset = metadata[6];                                                         \
-                                                                                                   \
-        const TYPE *in = (const TYPE *)input + offset;                                             \
-        TYPE *val_out = (TYPE *)values;                                                            \
-        i32_t *idx_out = (i32_t *)indices;                                                         \
-                                                                                                   \
-        /* Allocate temporary buffer for sorting */                                                \
-        ValueIndex *temp = (ValueIndex *)malloc(last_dim_size * sizeof(ValueIndex));               \
-        if (!temp)                                                                                 \
-            return;                                                                                \
-                                                                                                   \
-        for (size_t outer = 0; outer < outer_size; outer++) {                                      \
-            const TYPE *row = in + outer * last_dim_size;                                          \
-                                                                                                   \
-            /* Fill temporary buffer with values and indices */                                    \
-            for (size_t i = 0; i < last_dim_size; i++) {                                           \
-                temp[i].value = TO_FLOAT(row[i]);                                                  \
-                temp[i].index = (i32_t)i;                                                          \
+/// Split rows, pass 1: heap of each (row, chunk)
+static void topk_chunk_worker(size_t start, size_t end, void *ctx) {
+    const topk_args_t *a = (const topk_args_t *)ctx;
+    for (size_t t = start; t < end; t++) {
+        const size_t r = t / a->chunks;
+        const size_t first = (t % a->chunks) * a->chunk;
+        const size_t last = MINIMUM(a->n, first + a->chunk);
+        const char *row = a->input + r * a->n * a->elem_size;
+        a->counts[t] = topk_heap_scan(row, a->key_fn, a->largest, first, last, a->k,
+                                      a->candidates + t * a->k);
+    }
+}
+
+/// Split rows, pass 2: merge the chunk heaps of each row
+static void topk_merge_worker(size_t start, size_t end, void *ctx) {
+    const topk_args_t *a = (const topk_args_t *)ctx;
+    for (size_t r = start; r < end; r++) {
+        sort_item_t *best = a->candidates + r * a->chunks * a->k;
+        size_t size = a->counts[r * a->chunks];
+        for (size_t c = 1; c < a->chunks; c++) {
+            const sort_item_t *cand = a->candidates + (r * a->chunks + c) * a->k;
+            for (size_t i = 0; i < a->counts[r * a->chunks + c]; i++) {
+                topk_offer(best, &size, a->k, cand[i]);
+            }
+        }
+        topk_heap_sort(best, size);
+        topk_emit(a, r, best, size);
+    }
+}
+
+/// Chunks per row when splitting rows across threads (1 = no split)
+static size_t topk_num_chunks(size_t n, size_t k, size_t outer) {
+    const size_t threads = get_num_threads();
+    if (k * TOPK_HEAP_RATIO > n || outer >= threads || n < 2 * TOPK_SPLIT_MIN) {
+        return 1;
+    }
+    return MINIMUM(TOPK_MAX_CHUNKS, MINIMUM(n / TOPK_SPLIT_MIN, (threads + outer - 1) / outer));
+}
+
+static void topk_run(const void *input, void *values, void *indices, const size_t *metadata,
+                     size_t elem_size, topk_key_fn_t key_fn) {
+    topk_args_t args;
+    args.k = metadata[1];
+    args.n = metadata[2];
+    const size_t outer = metadata[3];
+    args.largest = metadata[4] != 0;
+    args.sorted = metadata[5] != 0;
+    args.input = (const char *)input + metadata[6] * elem_size;
+    args.values = (char *)values;
+    args.indices = (int32_t *)indices;
+    args.key_fn = key_fn;
+    args.elem_size = elem_size;
+    if (args.k == 0 || args.n == 0 || outer == 0) {
+        return;
+    }
+    args.heap = args.k * TOPK_HEAP_RATIO <= args.n;
+
+    args.chunks = topk_num_chunks(args.n, args.k, outer);
+    if (args.chunks > 1) {
+        const size_t tasks = outer * args.chunks;
+        const size_t cand_bytes =
+            hodu_cpu_workspace_block_size(tasks * args.k * sizeof(sort_item_t));
+        args.candidates = (sort_item_t *)workspace_acquire(cand_bytes + tasks * sizeof(size_t));
+        if (args.candidates) {
+            args.counts = (size_t *)((char *)args.candidates + cand_bytes);
+            args.chunk = (args.n + args.chunks - 1) / args.chunks;
+            parallel_for(0, tasks, 1, topk_chunk_worker, &args);
+            parallel_for(0, outer, 1, topk_merge_worker, &args);
+            workspace_release(args.candidates);
+            return;
+        }
+    }
+    parallel_for(0, outer, TOPK_TASK_ELEMS / args.n + 1, topk_row_worker, &args);
+}
+
+size_t hodu_cpu_topk_workspace_size(const size_t *metadata) {
+    const size_t k = metadata[1];
+    const size_t n = metadata[2];
+    const size_t outer = metadata[3];
+    const size_t chunks = topk_num_chunks(n, k, outer);
+    if (chunks > 1) {
+        const size_t tasks = outer * chunks;
+        return hodu_cpu_workspace_block_size(
+                   hodu_cpu_workspace_block_size(tasks * k * sizeof(sort_item_t)) +
+                   tasks * sizeof(size_t)) +
+               HODU_CPU_WORKSPACE_ALIGN;
+    }
+    return hodu_cpu_workspace_block_size(n * sizeof(sort_item_t)) + HODU_CPU_WORKSPACE_ALIGN;
+}
+
+/**
+ * @brief Macro to implement topk for one type
+ *
+ * @param TYPE C type of the elements
+ * @param TYPE_SUFFIX Function name suffix
+ * @param KEY Order-preserving unsigned key of `val`
+ */
+#define IMPL_TOPK(TYPE, TYPE_SUFFIX, KEY)                                                          \
+    static void topk_keys_##TYPE_SUFFIX(const void *row_ptr, size_t start, size_t n,               \
+                                        bool largest, uint64_t *keys) {                            \
+        const TYPE *row = (const TYPE *)row_ptr + start;                                           \
+        if (largest) {                                                                             \
+            for (size_t i = 0; i < n; i++) {                                                       \
+                const TYPE val = row[i];                                                           \
+                keys[i] = (uint64_t)(KEY);                                                         \
             }                                                                                      \
-                                                                                                   \
-            /* Select top-k elements */                                                            \
-            topk_select(temp, last_dim_size, k, largest, sorted);                                  \
-                                                                                                   \
-            /* Copy top-k results to output */                                                     \
-            TYPE *val_row = val_out + outer * k;                                                   \
-            i32_t *idx_row = idx_out + outer * k;                                                  \
-            for (size_t i = 0; i < k; i++) {                                                       \
-                val_row[i] = row[temp[i].index];                                                   \
-                idx_row[i] = temp[i].index;                                                        \
+        } else {                                                                                   \
+            for (size_t i = 0; i < n; i++) {                                                       \
+                const TYPE val = row[i];                                                           \
+                keys[i] = ~(uint64_t)(KEY);                                                        \
             }                                                                                      \
         }                                                                                          \
+    }                                                                                              \
                                                                                                    \
-        free(temp);                                                                                \
-    }
-
-#define IDENTITY(x) (x)
-
-IMPL_TOPK(f32_t, f32, IDENTITY)
-IMPL_TOPK(f64_t, f64, IDENTITY)
-IMPL_TOPK(u8_t, u8, IDENTITY)
-IMPL_TOPK(u16_t, u16, IDENTITY)
-IMPL_TOPK(u32_t, u32, IDENTITY)
-IMPL_TOPK(u64_t, u64, IDENTITY)
-IMPL_TOPK(i8_t, i8, IDENTITY)
-IMPL_TOPK(i16_t, i16, IDENTITY)
-IMPL_TOPK(i32_t, i32, IDENTITY)
-IMPL_TOPK(i64_t, i64, IDENTITY)
-IMPL_TOPK(bf16_t, bf16, bf16_to_float)
-IMPL_TOPK(f16_t, f16, f16_to_float)
-IMPL_TOPK(f8e4m3_t, f8e4m3, f8e4m3_to_float)
-IMPL_TOPK(f8e5m2_t, f8e5m2, f8e5m2_to_float)
+    void hodu_cpu_topk_##TYPE_SUFFIX(const void *input, void *values, void *indices,               \
+                                     const size_t *metadata) {                                     \
+        HODU_PROFILE_KERNEL(metadata[3] * metadata[2] * sizeof(TYPE) +                             \
+                            metadata[3] * metadata[1] * (sizeof(TYPE) + sizeof(int32_t)));         \
+        topk_run(input, values, indices, metadata, sizeof(TYPE), topk_keys_##TYPE_SUFFIX);         \
+    }
+
+IMPL_TOPK(f32_t, f32, sort_key_f32(val))
+IMPL_TOPK(f64_t, f64, sort_key_f64(val))
+IMPL_TOPK(u8_t, u8, val)
+IMPL_TOPK(u16_t, u16, val)
+IMPL_TOPK(u32_t, u32, val)
+IMPL_TOPK(u64_t, u64, val)
+IMPL_TOPK(i8_t, i8, (uint8_t)val ^ 0x80u)
+IMPL_TOPK(i16_t, i16, (uint16_t)val ^ 0x8000u)
+IMPL_TOPK(i32_t, i32, (uint32_t)val ^ 0x80000000u)
+IMPL_TOPK(i64_t, i64, (uint64_t)val ^ 0x8000000000000000ull)
+IMPL_TOPK(bf16_t, bf16, sort_key_bf16(val))
+IMPL_TOPK(f16_t, f16, sort_key_f16(val))
+IMPL_TOPK(f8e4m3_t, f8e4m3, sort_key_f8e4m3(val))
+IMPL_TOPK(f8e5m2_t, f8e5m2, sort_key_f8e5m2(val))
+
+// ============================================================================
+// SORT ENGINE
+// ============================================================================
+//
+// sort/argsort are stable along any dim: items carry the same order-preserving
+// keys as topk (xor-ed with a width mask for descending) and are LSD radix
+// sorted a byte at a time, skipping bytes that are constant across the row.
+// Short rows use insertion sort. Rows run in parallel; when there are fewer
+// rows than threads, each long row is cut into chunks that are radix sorted in
+// parallel and then merged pairwise, every merge split across threads by
+// merge-path co-ranks.
+
+// Rows at most this long use insertion sort
+#define SORT_INSERTION 32
+// Minimum elements per chunk of a split row, and most chunks per row
+#define SORT_SPLIT_MIN ((size_t)1 << 15)
+#define SORT_MAX_CHUNKS 64
+// Minimum elements per row task
+#define SORT_TASK_ELEMS ((size_t)1 << 14)
+
+/// Fills items[i] = {key(row[(start + i) * stride]) ^ mask, start + i} for i < n
+typedef void (*sort_key_fn_t)(const void *row, size_t stride, size_t start, size_t n,
+                              uint64_t mask, sort_item_t *items);
+
+static void sort_insertion(sort_item_t *a, size_t n) {
+    for (size_t i = 1; i < n; i++) {
+        const sort_item_t item = a[i];
+        size_t j = i;
+        while (j > 0 && item.key < a[j - 1].key) {
+            a[j] = a[j - 1];
+            j--;
+        }
+        a[j] = item;
+    }
+}
+
+/// Stable sort of a by key over the low width bytes; returns the buffer (a or tmp) holding it
+static sort_item_t *sort_radix(sort_item_t *a, sort_item_t *tmp, size_t n, size_t width) {
+    if (n <= SORT_INSERTION) {
+        sort_insertion(a, n);
+        return a;
+    }
+    uint32_t hist[8][256];
+    memset(hist, 0, width * sizeof(hist[0]));
+    for (size_t i = 0; i < n; i++) {
+        const uint64_t key = a[i].key;
+        for (size_t d = 0; d < width; d++) {
+            hist[d][(key >> (8 * d)) & 0xff]++;
+        }
+    }
+    for (size_t d = 0; d < width; d++) {
+        uint32_t *h = hist[d];
+        const unsigned shift = (unsigned)(8 * d);
+        if (h[(a[0].key >> shift) & 0xff] == n) {
+            continue;
+        }
+        uint32_t sum = 0;
+        for (size_t b = 0; b < 256; b++) {
+            const uint32_t c = h[b];
+            h[b] = sum;
+            sum += c;
+        }
+        for (size_t i = 0; i < n; i++) {
+            tmp[h[(a[i].key >> shift) & 0xff]++] = a[i];
+        }
+        sort_item_t *t = a;
+        a = tmp;
+        tmp = t;
+    }
+    return a;
+}
+
+/// Number of items of run a among the first i outputs of the stable merge of a and b
+static size_t sort_co_rank(const sort_item_t *a, size_t na, const sort_item_t *b, size_t nb,
+                           size_t i) {
+    size_t lo = i > nb ? i - nb : 0;
+    size_t hi = MINIMUM(i, na);
+    while (lo < hi) {
+        const size_t j = lo + (hi - lo) / 2;
+        if (b[i - j - 1].key < a[j].key) {
+            hi = j;
+        } else {
+            lo = j + 1;
+        }
+    }
+    return lo;
+}
+
+typedef struct {
+    const char *input;
+    char *values;     // NULL for argsort
+    int32_t *indices;
+    sort_key_fn_t key_fn;
+    size_t elem_size;
+    size_t width;
+    uint64_t mask;
+    size_t n;
+    size_t dim_stride;
+    size_t inner;
+    size_t num_dims;
+    size_t dim;
+    const size_t *shape;
+    const size_t *strides;
+    /* Split rows */
+    const char *row;
+    size_t out_base;
+    sort_item_t *buf[2];
+    size_t chunk;
+    size_t *bounds; // [runs + 1]
+    size_t runs;
+    size_t src;
+    size_t parts;
+} sort_args_t;
+
+/// Input offset (in elements) of row t, i.e. of its first element along dim
+static size_t sort_row_offset(const sort_args_t *a, size_t t) {
+    size_t offset = 0;
+    for (size_t d = a->num_dims; d-- > 0;) {
+        if (d == a->dim) {
+            continue;
+        }
+        offset += (t % a->shape[d]) * a->strides[d];
+        t /= a->shape[d];
+    }
+    return offset;
+}
+
+/// Output offset (in elements) of row t
+static inline size_t sort_out_offset(const sort_args_t *a, size_t t) {
+    return (t / a->inner) * a->n * a->inner + t % a->inner;
+}
+
+/// Write sorted positions [start, end) of a row to the outputs
+static void sort_emit(const sort_args_t *a, const char *row, size_t out, const sort_item_t *items,
+                      size_t start, size_t end) {
+    const size_t inner = a->inner;
+    for (size_t i = start; i < end; i++) {
+        a->indices[out + i * inner] = (int32_t)items[i].idx;
+    }
+    if (!a->values) {
+        return;
+    }
+    const size_t stride = a->dim_stride;
+    switch (a->elem_size) {
+    case 1:
+        for (size_t i = start; i < end; i++) {
+            a->values[out + i * inner] = row[items[i].idx * stride];
+        }
+        break;
+    case 2:
+        for (size_t i = start; i < end; i++) {
+            ((uint16_t *)a->values)[out + i * inner] =
+                ((const uint16_t *)row)[items[i].idx * stride];
+        }
+        break;
+    case 4:
+        for (size_t i = start; i < end; i++) {
+            ((uint32_t *)a->values)[out + i * inner] =
+                ((const uint32_t *)row)[items[i].idx * stride];
+        }
+        break;
+    default:
+        for (size_t i = start; i < end; i++) {
+            ((uint64_t *)a->values)[out + i * inner] =
+                ((const uint64_t *)row)[items[i].idx * stride];
+        }
+        break;
+    }
+}
+
+static void sort_row_worker(size_t start, size_t end, void *ctx) {
+    const sort_args_t *a = (const sort_args_t *)ctx;
+    sort_item_t *items = (sort_item_t *)workspace_acquire(2 * a->n * sizeof(sort_item_t));
+    if (!items) {
+        return;
+    }
+    for (size_t t = start; t < end; t++) {
+        const char *row = a->input + sort_row_offset(a, t) * a->elem_size;
+        a->key_fn(row, a->dim_stride, 0, a->n, a->mask, items);
+        const sort_item_t *sorted = sort_radix(items, items + a->n, a->n, a->width);
+        sort_emit(a, row, sort_out_offset(a, t), sorted, 0, a->n);
+    }
+    workspace_release(items);
+}
+
+/// Split rows, pass 1: radix sort each chunk into buf[0]
+static void sort_chunk_worker(size_t start, size_t end, void *ctx) {
+    const sort_args_t *a = (const sort_args_t *)ctx;
+    for (size_t c = start; c < end; c++) {
+        const size_t first = a->bounds[c];
+        const size_t n = a->bounds[c + 1] - first;
+        sort_item_t *items = a->buf[0] + first;
+        a->key_fn(a->row, a->dim_stride, first, n, a->mask, items);
+        const sort_item_t *sorted = sort_radix(items, a->buf[1] + first, n, a->width);
+        if (sorted != items) {
+            memcpy(items, sorted, n * sizeof(sort_item_t));
+        }
+    }
+}
+
+/// Split rows, pass 2: one part of the merge of runs 2p and 2p + 1 (or the copy of an odd last run)
+static void sort_merge_worker(size_t start, size_t end, void *ctx) {
+    const sort_args_t *a = (const sort_args_t *)ctx;
+    const sort_item_t *src = a->buf[a->src];
+    sort_item_t *dst = a->buf[a->src ^ 1];
+    for (size_t t = start; t < end; t++) {
+        const size_t p = t / a->parts;
+        const size_t q = t % a->parts;
+        const size_t lo = a->bounds[2 * p];
+        const size_t mid = a->bounds[MINIMUM(2 * p + 1, a->runs)];
+        const size_t hi = a->bounds[MINIMUM(2 * p + 2, a->runs)];
+        const size_t len = hi - lo;
+        const size_t o0 = lo + len * q / a->parts;
+        const size_t o1 = lo + len * (q + 1) / a->parts;
+        const sort_item_t *ra = src + lo;
+        const sort_item_t *rb = src + mid;
+        const size_t na = mid - lo, nb = hi - mid;
+        size_t i = sort_co_rank(ra, na, rb, nb, o0 - lo);
+        size_t j = o0 - lo - i;
+        const size_t i1 = sort_co_rank(ra, na, rb, nb, o1 - lo);
+        const size_t j1 = o1 - lo - i1;
+        sort_item_t *out = dst + o0;
+        while (i < i1 && j < j1) {
+            *out++ = rb[j].key < ra[i].key ? rb[j++] : ra[i++];
+        }
+        while (i < i1) {
+            *out++ = ra[i++];
+        }
+        while (j < j1) {
+            *out++ = rb[j++];
+        }
+    }
+}
+
+static void sort_emit_worker(size_t start, size_t end, void *ctx) {
+    const sort_args_t *a = (const sort_args_t *)ctx;
+    sort_emit(a, a->row, a->out_base, a->buf[a->src], start, end);
+}
+
+/// Chunks per row when splitting rows across threads (1 = no split)
+static size_t sort_num_chunks(size_t n, size_t rows) {
+    const size_t threads = get_num_threads();
+    if (rows >= threads || n < 2 * SORT_SPLIT_MIN) {
+        return 1;
+    }
+    return MINIMUM(SORT_MAX_CHUNKS, MINIMUM(n / SORT_SPLIT_MIN, threads));
+}
+
+/// Sort each long row across all threads, one row at a time
+static bool sort_split_rows(sort_args_t *a, size_t rows, size_t chunks) {
+    const size_t n = a->n;
+    const size_t buf_bytes = hodu_cpu_workspace_block_size(n * sizeof(sort_item_t));
+    char *scratch = (char *)workspace_acquire(2 * buf_bytes + (chunks + 1) * sizeof(size_t));
+    if (!scratch) {
+        return false;
+    }
+    a->buf[0] = (sort_item_t *)scratch;
+    a->buf[1] = (sort_item_t *)(scratch + buf_bytes);
+    a->bounds = (size_t *)(scratch + 2 * buf_bytes);
+    const size_t threads = get_num_threads();
+    for (size_t t = 0; t < rows; t++) {
+        a->row = a->input + sort_row_offset(a, t) * a->elem_size;
+        a->out_base = sort_out_offset(a, t);
+        for (size_t c = 0; c <= chunks; c++) {
+            a->bounds[c] = n * c / chunks;
+        }
+        parallel_for(0, chunks, 1, sort_chunk_worker, a);
+        a->src = 0;
+        for (a->runs = chunks; a->runs > 1; a->runs = (a->runs + 1) / 2) {
+            const size_t pairs = (a->runs + 1) / 2;
+            a->parts = (threads + pairs - 1) / pairs;
+            parallel_for(0, pairs * a->parts, 1, sort_merge_worker, a);
+            for (size_t p = 0; p < pairs; p++) {
+                a->bounds[p] = a->bounds[2 * p];
+            }
+            a->bounds[pairs] = n;
+            a->src ^= 1;
+        }
+        parallel_for(0, n, SORT_TASK_ELEMS, sort_emit_worker, a);
+    }
+    workspace_release(scratch);
+    return true;
+}
+
+static void sort_run(const void *input, void *values, void *indices, const size_t *metadata,
+                     size_t elem_size, sort_key_fn_t key_fn) {
+    sort_args_t args;
+    const size_t num_els = metadata[0];
+    args.num_dims = metadata[1];
+    args.shape = &metadata[2];
+    args.strides = &metadata[2 + args.num_dims];
+    args.dim = metadata[3 + 2 * args.num_dims];
+    const bool descending = metadata[4 + 2 * args.num_dims] != 0;
+    args.input = (const char *)input + metadata[2 + 2 * args.num_dims] * elem_size;
+    args.values = (char *)values;
+    args.indices = (int32_t *)indices;
+    args.key_fn = key_fn;
+    args.elem_size = elem_size;
+    args.width = elem_size;
+    args.mask = descending ? (~(uint64_t)0 >> (64 - 8 * elem_size)) : 0;
+    args.n = args.shape[args.dim];
+    args.dim_stride = args.strides[args.dim];
+    if (num_els == 0) {
+        return;
+    }
+    args.inner = 1;
+    for (size_t d = args.dim + 1; d < args.num_dims; d++) {
+        args.inner *= args.shape[d];
+    }
+    const size_t rows = num_els / args.n;
+
+    const size_t chunks = sort_num_chunks(args.n, rows);
+    if (chunks > 1 && sort_split_rows(&args, rows, chunks)) {
+        return;
+    }
+    parallel_for(0, rows, SORT_TASK_ELEMS / args.n + 1, sort_row_worker, &args);
+}
+
+size_t hodu_cpu_sort_workspace_size(const size_t *metadata) {
+    const size_t num_els = metadata[0];
+    const size_t num_dims = metadata[1];
+    const size_t n = metadata[2 + metadata[3 + 2 * num_dims]];
+    if (num_els == 0) {
+        return 0;
+    }
+    const size_t chunks = sort_num_chunks(n, num_els / n);
+    size_t bytes = 2 * n * sizeof(sort_item_t);
+    if (chunks > 1) {
+        bytes = 2 * hodu_cpu_workspace_block_size(n * sizeof(sort_item_t)) +
+                (chunks + 1) * sizeof(size_t);
+    }
+    return hodu_cpu_workspace_block_size(bytes) + HODU_CPU_WORKSPACE_ALIGN;
+}
+
+/**
+ * @brief Macro to implement sort and argsort for one type
+ *
+ * @param TYPE C type of the elements
+ * @param TYPE_SUFFIX Function name suffix
+ * @param KEY Order-preserving unsigned key of `val`, at most sizeof(TYPE) bytes wide
+ */
+#define IMPL_SORT(TYPE, TYPE_SUFFIX, KEY)                                                          \
+    static void sort_keys_##TYPE_SUFFIX(const void *row_ptr, size_t stride, size_t start,          \
+                                        size_t n, uint64_t mask, sort_item_t *items) {             \
+        const TYPE *row = (const TYPE *)row_ptr;                                                   \
+        for (size_t i = start; i < start + n; i++) {                                               \
+            const TYPE val = row[i * stride];                                                      \
+            items[i - start].key = (uint64_t)(KEY) ^ mask;                                         \
+            items[i - start].idx = (uint32_t)i;                                                    \
+        }                                                                                          \
+    }                                                                                              \
+                                                                                                   \
+    void hodu_cpu_sort_##TYPE_SUFFIX(const void *input, void *values, void *indices,               \
+                                     const size_t *metadata) {                                     \
+        HODU_PROFILE_KERNEL(metadata[0] * (2 * sizeof(TYPE) + sizeof(int32_t)));                   \
+        sort_run(input, values, indices, metadata, sizeof(TYPE), sort_keys_##TYPE_SUFFIX);         \
+    }                                                                                              \
+                                                                                                   \
+    void hodu_cpu_argsort_##TYPE_SUFFIX(const void *input, void *indices,                          \
+                                        const size_t *metadata) {                                  \
+        HODU_PROFILE_KERNEL(metadata[0] * (sizeof(TYPE) + sizeof(int32_t)));                       \
+        sort_run(input, NULL, indices, metadata, sizeof(TYPE), sort_keys_##TYPE_SUFFIX);           \
+    }
+
+IMPL_SORT(bool, bool, (uint8_t)val)
+IMPL_SORT(f32_t, f32, sort_key_f32(val))
+IMPL_SORT(f64_t, f64, sort_key_f64(val))
+IMPL_SORT(u8_t, u8, val)
+IMPL_SORT(u16_t, u16, val)
+IMPL_SORT(u32_t, u32, val)
+IMPL_SORT(u64_t, u64, val)
+IMPL_SORT(i8_t, i8, (uint8_t)val ^ 0x80u)
+IMPL_SORT(i16_t, i16, (uint16_t)val ^ 0x8000u)
+IMPL_SORT(i32_t, i32, (uint32_t)val ^ 0x80000000u)
+IMPL_SORT(i64_t, i64, (uint64_t)val ^ 0x8000000000000000ull)
+IMPL_SORT(bf16_t, bf16, sort_key_bf16(val))
+IMPL_SORT(f16_t, f16, sort_key_f16(val))
+IMPL_SORT(f8e4m3_t, f8e4m3, sort_key_f8e4m3(val))
+IMPL_SORT(f8e5m2_t, f8e5m2, sort_key_f8e5m2(val))
@@ -18,4 +18,55 @@ void hodu_cpu_topk_f16(const void *input, void *values, void *indices, const siz
 void hodu_cpu_topk_f8e4m3(const void *input, void *values, void *indices, const size_t *metadata);
 void hodu_cpu_topk_f8e5m2(const void *input, void *values, void *indices, const size_t *metadata);
 
+/// Scratch bytes a topk call takes from the workspace (any dtype; see workspace.h)
+size_t hodu_cpu_topk_workspace_size(const size_t *metadata);
+
+// Stable sort and argsort along one dim
+// Metadata layout:
+// - metadata[0]: num_els (total number of elements)
+// - metadata[1]: num_dims (number of dimensions)
+// - metadata[2..2+num_dims]: shape
+// - metadata[2+num_dims..2+2*num_dims]: strides
+// - metadata[2+2*num_dims]: offset
+// - metadata[3+2*num_dims]: dim (dimension to sort along)
+// - metadata[4+2*num_dims]: descending (1 = descending, 0 = ascending)
+//
+// values (same dtype) and indices (i32) are contiguous with the input's shape. Equal elements
+// keep their input order; NaNs sort above +inf and -0 equals +0.
+
+void hodu_cpu_sort_bool(const void *input, void *values, void *indices, const size_t *metadata);
+void hodu_cpu_sort_f8e4m3(const void *input, void *values, void *indices, const size_t *metadata);
+void hodu_cpu_sort_f8e5m2(const void *input, void *values, void *indices, const size_t *metadata);
+void hodu_cpu_sort_bf16(const void *input, void *values, void *indices, const size_t *metadata);
+void hodu_cpu_sort_f16(const void *input, void *values, void *indices, const size_t *metadata);
+void hodu_cpu_sort_f32(const void *input, void *values, void *indices, const size_t *metadata);
+void hodu_cpu_sort_f64(const void *input, void *values, void *indices, const size_t *metadata);
+void hodu_cpu_sort_u8(const void *input, void *values, void *indices, const size_t *metadata);
+void hodu_cpu_sort_u16(const void *input, void *values, void *indices, const size_t *metadata);
+void hodu_cpu_sort_u32(const void *input, void *values, void *indices, const size_t *metadata);
+void hodu_cpu_sort_u64(const void *input, void *values, void *indices, const size_t *metadata);
+void hodu_cpu_sort_i8(const void *input, void *values, void *indices, const size_t *metadata);
+void hodu_cpu_sort_i16(const void *input, void *values, void *indices, const size_t *metadata);
+void hodu_cpu_sort_i32(const void *input, void *values, void *indices, const size_t *metadata);
+void hodu_cpu_sort_i64(const void *input, void *values, void *indices, const size_t *metadata);
+
+void hodu_cpu_argsort_bool(const void *input, void *indices, const size_t *metadata);
+void hodu_cpu_argsort_f8e4m3(const void *input, void *indices, const size_t *metadata);
+void hodu_cpu_argsort_f8e5m2(const void *input, void *indices, const size_t *metadata);
+void hodu_cpu_argsort_bf16(const void *input, void *indices, const size_t *metadata);
+void hodu_cpu_argsort_f16(const void *input, void *indices, const size_t *metadata);
+void hodu_cpu_argsort_f32(const void *input, void *indices, const size_t *metadata);
+void hodu_cpu_argsort_f64(const void *input, void *indices, const size_t *metadata);
+void hodu_cpu_argsort_u8(const void *input, void *indices, const size_t *metadata);
+void hodu_cpu_argsort_u16(const void *input, void *indices, const size_t *metadata);
+void hodu_cpu_argsort_u32(const void *input, void *indices, const size_t *metadata);
+void hodu_cpu_argsort_u64(const void *input, void *indices, const size_t *metadata);
+void hodu_cpu_argsort_i8(const void *input, void *indices, const size_t *metadata);
+void hodu_cpu_argsort_i16(const void *input, void *indices, const size_t *metadata);
+void hodu_cpu_argsort_i32(const void *input, void *indices, const size_t *metadata);
+void hodu_cpu_argsort_i64(const void *input, void *indices, const size_t *metadata);
+
+/// Scratch bytes a sort or argsort call takes from the workspace (any dtype; see workspace.h)
+size_t hodu_cpu_sort_workspace_size(const size_t *metadata);
+
 #endif // OPS_SORT_H
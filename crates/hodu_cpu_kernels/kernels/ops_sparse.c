@@ -0,0 +1,357 @@
+#include "ops_sparse.h"
+#include "profile.h"
+#include "simd_utils.h"
+#include "strided_copy.h"
+#include "thread_utils.h"
+#include "types.h"
+#include "utils.h"
+#include "workspace.h"
+#include <stdbool.h>
+
+// ============================================================================
+// SPARSE x DENSE MATMUL
+// ============================================================================
+//
+// Every block row of the lhs is one parallel_for item. Its output rows are
+// produced a register tile at a time: SPARSE_NV vectors of one row, or
+// SPARSE_NV / 2 vectors of four rows of a block at once (one rhs load then
+// feeds four FMAs). Tiles accumulate over the stored blocks of the block row
+// and are stored once; the last columns use partial vectors.
+
+/// Output vectors per single-row register tile
+#define SPARSE_NV 4
+
+typedef struct {
+    const hodu_cpu_sparse_t *a;
+    const void *b; // rhs rows with unit column stride
+    size_t ldb;
+    void *c;
+    size_t N;
+} sparse_args_t;
+
+/// Whether lhs describes a matrix the kernels can walk
+static bool sparse_valid(const hodu_cpu_sparse_t *a) {
+    if (!a || a->block_rows == 0 || a->block_cols == 0 || a->rows % a->block_rows != 0 ||
+        a->cols % a->block_cols != 0 || !a->row_ptr)
+        return false;
+    return a->row_ptr[a->rows / a->block_rows] == 0 || (a->col_idx && a->values);
+}
+
+#ifdef HODU_PROFILE_ACTIVE
+/// Bytes a call moves: stored blocks, rhs and output
+static inline uint64_t sparse_profile_bytes(const hodu_cpu_sparse_t *a, size_t N,
+                                            size_t elem_size) {
+    if (!sparse_valid(a))
+        return 0;
+    const size_t blocks = a->row_ptr[a->rows / a->block_rows];
+    return blocks * (a->block_rows * a->block_cols * elem_size + sizeof(uint32_t)) +
+           (a->cols + a->rows) * N * elem_size;
+}
+#endif
+
+/**
+ * @brief Macro implementing the scalar row loop of one type
+ *
+ * Overwrites output columns [n0, N) of row r of block row br. Used for every
+ * row without SIMD and for single-column (matrix-vector) products.
+ */
+#define SPARSE_SCALAR_IMPL(TYPE, SFX)                                                              \
+    static void sparse_row_scalar_##SFX(const sparse_args_t *p, size_t br, size_t r, size_t n0) {  \
+        const hodu_cpu_sparse_t *a = p->a;                                                         \
+        const size_t C = a->block_cols, bsize = a->block_rows * C, N = p->N, ldb = p->ldb;         \
+        const TYPE *values = (const TYPE *)a->values + r * C;                                      \
+        const TYPE *b = (const TYPE *)p->b;                                                        \
+        TYPE *out = (TYPE *)p->c + (br * a->block_rows + r) * N;                                   \
+        if (N - n0 == 1) {                                                                         \
+            /* Four independent sums hide the add latency of short rows */                         \
+            const uint32_t *cols = a->col_idx;                                                     \
+            const TYPE *x = b + n0;                                                                \
+            const size_t end = a->row_ptr[br + 1];                                                 \
+            size_t blk = a->row_ptr[br];                                                           \
+            TYPE acc[4] = {0, 0, 0, 0};                                                            \
+            if (C == 1) {                                                                          \
+                for (; blk + 4 <= end; blk += 4)                                                   \
+                    for (size_t u = 0; u < 4; u++)                                                 \
+                        acc[u] += values[(blk + u) * bsize] * x[cols[blk + u] * ldb];              \
+            }                                                                                      \
+            for (; blk + 4 <= end; blk += 4) {                                                     \
+                for (size_t u = 0; u < 4; u++) {                                                   \
+                    const TYPE *v = values + (blk + u) * bsize;                                    \
+                    const TYPE *col = x + (size_t)cols[blk + u] * C * ldb;                         \
+                    for (size_t c = 0; c < C; c++)                                                 \
+                        acc[u] += v[c] * col[c * ldb];                                             \
+                }                                                                                  \
+            }                                                                                      \
+            for (; blk < end; blk++) {                                                             \
+                const TYPE *v = values + blk * bsize;                                              \
+                const TYPE *col = x + (size_t)cols[blk] * C * ldb;                                 \
+                for (size_t c = 0; c < C; c++)                                                     \
+                    acc[0] += v[c] * col[c * ldb];                                                 \
+            }                                                                                      \
+            out[n0] = (acc[0] + acc[1]) + (acc[2] + acc[3]);                                       \
+            return;                                                                                \
+        }                                                                                          \
+        for (size_t n = n0; n < N; n++)                                                            \
+            out[n] = 0;                                                                            \
+        for (size_t blk = a->row_ptr[br]; blk < a->row_ptr[br + 1]; blk++) {                       \
+            const TYPE *v = values + blk * bsize;                                                  \
+            const TYPE *rows = b + (size_t)a->col_idx[blk] * C * ldb;                              \
+            for (size_t c = 0; c < C; c++) {                                                       \
+                const TYPE w = v[c];                                                               \
+                const TYPE *x = rows + c * ldb;                                                    \
+                for (size_t n = n0; n < N; n++)                                                    \
+                    out[n] += w * x[n];                                                            \
+            }                                                                                      \
+        }                                                                                          \
+    }
+
+/**
+ * @brief Macro implementing the SIMD register tiles and block row loop of one type
+ *
+ * @param TYPE Element type
+ * @param SFX Type suffix, also selecting the simd_<SFX>_* operations
+ * @param W SIMD width of TYPE
+ */
+#define SPARSE_SIMD_IMPL(TYPE, SFX, W)                                                             \
+    /* Row r of block row br, output columns [n0, n0 + SPARSE_NV * W) */                           \
+    static void sparse_row_##SFX(const sparse_args_t *p, size_t br, size_t r, size_t n0) {         \
+        const hodu_cpu_sparse_t *a = p->a;                                                         \
+        const size_t C = a->block_cols, bsize = a->block_rows * C, ldb = p->ldb;                   \
+        const TYPE *values = (const TYPE *)a->values + r * C;                                      \
+        const TYPE *b = (const TYPE *)p->b + n0;                                                   \
+        simd_##SFX##_t acc[SPARSE_NV];                                                             \
+        for (int u = 0; u < SPARSE_NV; u++)                                                        \
+            acc[u] = simd_##SFX##_set1(0);                                                         \
+        for (size_t blk = a->row_ptr[br]; blk < a->row_ptr[br + 1]; blk++) {                       \
+            const TYPE *v = values + blk * bsize;                                                  \
+            const TYPE *rows = b + (size_t)a->col_idx[blk] * C * ldb;                              \
+            for (size_t c = 0; c < C; c++) {                                                       \
+                const simd_##SFX##_t w = simd_##SFX##_set1(v[c]);                                  \
+                const TYPE *x = rows + c * ldb;                                                    \
+                for (int u = 0; u < SPARSE_NV; u++)                                                \
+                    acc[u] = simd_##SFX##_fmadd(w, simd_##SFX##_load(x + u * W), acc[u]);          \
+            }                                                                                      \
+        }                                                                                          \
+        TYPE *out = (TYPE *)p->c + (br * a->block_rows + r) * p->N + n0;                           \
+        for (int u = 0; u < SPARSE_NV; u++)                                                        \
+            simd_##SFX##_store(out + u * W, acc[u]);                                               \
+    }                                                                                              \
+                                                                                                   \
+    /* Rows r0 .. r0 + 3 of block row br, output columns [n0, n0 + SPARSE_NV / 2 * W) */           \
+    static void sparse_rows4_##SFX(const sparse_args_t *p, size_t br, size_t r0, size_t n0) {      \
+        const hodu_cpu_sparse_t *a = p->a;                                                         \
+        const size_t C = a->block_cols, bsize = a->block_rows * C, ldb = p->ldb;                   \
+        const TYPE *values = (const TYPE *)a->values + r0 * C;                                     \
+        const TYPE *b = (const TYPE *)p->b + n0;                                                   \
+        simd_##SFX##_t acc[4][SPARSE_NV / 2];                                                      \
+        for (int r = 0; r < 4; r++)                                                                \
+            for (int u = 0; u < SPARSE_NV / 2; u++)                                                \
+                acc[r][u] = simd_##SFX##_set1(0);                                                  \
+        for (size_t blk = a->row_ptr[br]; blk < a->row_ptr[br + 1]; blk++) {                       \
+            const TYPE *v = values + blk * bsize;                                                  \
+            const TYPE *rows = b + (size_t)a->col_idx[blk] * C * ldb;                              \
+            for (size_t c = 0; c < C; c++) {                                                       \
+                simd_##SFX##_t x[SPARSE_NV / 2];                                                   \
+                for (int u = 0; u < SPARSE_NV / 2; u++)                                            \
+                    x[u] = simd_##SFX##_load(rows + c * ldb + u * W);                              \
+                for (int r = 0; r < 4; r++) {                                                      \
+                    const simd_##SFX##_t w = simd_##SFX##_set1(v[r * C + c]);                      \
+                    for (int u = 0; u < SPARSE_NV / 2; u++)                                        \
+                        acc[r][u] = simd_##SFX##_fmadd(w, x[u], acc[r][u]);                        \
+                }                                                                                  \
+            }                                                                                      \
+        }                                                                                          \
+        TYPE *out = (TYPE *)p->c + (br * a->block_rows + r0) * p->N + n0;                          \
+        for (int r = 0; r < 4; r++)                                                                \
+            for (int u = 0; u < SPARSE_NV / 2; u++)                                                \
+                simd_##SFX##_store(out + r * p->N + u * W, acc[r][u]);                             \
+    }                                                                                              \
+                                                                                                   \
+    /* Row r of block row br, output columns [n0, n0 + count), count <= W */                       \
+    static void sparse_row_tail_##SFX(const sparse_args_t *p, size_t br, size_t r, size_t n0,      \
+                                      size_t count) {                                              \
+        const hodu_cpu_sparse_t *a = p->a;                                                         \
+        const size_t C = a->block_cols, bsize = a->block_rows * C, ldb = p->ldb;                   \
+        const TYPE *values = (const TYPE *)a->values + r * C;                                      \
+        const TYPE *b = (const TYPE *)p->b + n0;                                                   \
+        const simd_##SFX##_t zero = simd_##SFX##_set1(0);                                          \
+        simd_##SFX##_t acc = zero;                                                                 \
+        for (size_t blk = a->row_ptr[br]; blk < a->row_ptr[br + 1]; blk++) {                       \
+            const TYPE *v = values + blk * bsize;                                                  \
+            const TYPE *rows = b + (size_t)a->col_idx[blk] * C * ldb;                              \
+            for (size_t c = 0; c < C; c++)                                                         \
+                acc = simd_##SFX##_fmadd(simd_##SFX##_set1(v[c]),                                  \
+                                         simd_##SFX##_load_partial(rows + c * ldb, count, zero),   \
+                                         acc);                                                     \
+        }                                                                                          \
+        TYPE *out = (TYPE *)p->c + (br * a->block_rows + r) * p->N + n0;                           \
+        simd_##SFX##_store_partial(out, acc, count);                                               \
+    }                                                                                              \
+                                                                                                   \
+    static void sparse_block_row_##SFX(const sparse_args_t *p, size_t br) {                        \
+        const size_t R = p->a->block_rows, N = p->N;                                               \
+        size_t r = 0;                                                                              \
+        if (N == 1) {                                                                              \
+            for (; r < R; r++)                                                                     \
+                sparse_row_scalar_##SFX(p, br, r, 0);                                              \
+            return;                                                                                \
+        }                                                                                          \
+        for (; r + 4 <= R; r += 4) {                                                               \
+            size_t n0 = 0;                                                                         \
+            for (; n0 + SPARSE_NV / 2 * W <= N; n0 += SPARSE_NV / 2 * W)                           \
+                sparse_rows4_##SFX(p, br, r, n0);                                                  \
+            for (size_t q = r; q < r + 4; q++)                                                     \
+                for (size_t n = n0; n < N; n += W)                                                 \
+                    sparse_row_tail_##SFX(p, br, q, n, MINIMUM((size_t)W, N - n));                 \
+        }                                                                                          \
+        for (; r < R; r++) {                                                                       \
+            size_t n0 = 0;                                                                         \
+            for (; n0 + SPARSE_NV * W <= N; n0 += SPARSE_NV * W)                                   \
+                sparse_row_##SFX(p, br, r, n0);                                                    \
+            for (; n0 < N; n0 += W)                                                                \
+                sparse_row_tail_##SFX(p, br, r, n0, MINIMUM((size_t)W, N - n0));                   \
+        }                                                                                          \
+    }
+
+/// Block row loop without SIMD
+#define SPARSE_BLOCK_ROW_SCALAR(SFX)                                                               \
+    static void sparse_block_row_##SFX(const sparse_args_t *p, size_t br) {                        \
+        for (size_t r = 0; r < p->a->block_rows; r++)                                              \
+            sparse_row_scalar_##SFX(p, br, r, 0);                                                  \
+    }
+
+/**
+ * @brief Macro implementing the exported sparse matmul of one type
+ *
+ * @param TYPE Element type
+ * @param SFX Type suffix for function naming
+ * @param HAS_SIMD Whether the block row loop is vectorized
+ */
+#define SPARSE_MATMUL_IMPL(TYPE, SFX, HAS_SIMD)                                                    \
+    static void sparse_worker_##SFX(size_t start, size_t end, void *arg) {                         \
+        const sparse_args_t *p = (const sparse_args_t *)arg;                                       \
+        for (size_t br = start; br < end; br++)                                                    \
+            sparse_block_row_##SFX(p, br);                                                         \
+    }                                                                                              \
+                                                                                                   \
+    void hodu_cpu_sparse_matmul_##SFX(const hodu_cpu_sparse_t *lhs, const void *rhs, void *output, \
+                                      const size_t *metadata) {                                    \
+        HODU_PROFILE_KERNEL(sparse_profile_bytes(lhs, metadata[0], sizeof(TYPE)));                 \
+        const size_t N = metadata[0];                                                              \
+        if (!sparse_valid(lhs) || lhs->rows == 0 || N == 0)                                        \
+            return;                                                                                \
+                                                                                                   \
+        sparse_args_t args = {lhs, (const TYPE *)rhs + metadata[3], metadata[1], output, N};       \
+        void *staged = NULL;                                                                       \
+        if (N > 1 && metadata[2] != 1 && lhs->cols > 0) {                                          \
+            staged = workspace_acquire(lhs->cols * N * sizeof(TYPE));                              \
+            if (!staged)                                                                           \
+                return;                                                                            \
+            const size_t shape[2] = {lhs->cols, N};                                                \
+            const size_t strides[2] = {metadata[1], metadata[2]};                                  \
+            hodu_cpu_strided_copy(args.b, staged, sizeof(TYPE), 2, shape, strides, NULL);          \
+            args.b = staged;                                                                       \
+            args.ldb = N;                                                                          \
+        }                                                                                          \
+                                                                                                   \
+        const size_t block_rows = lhs->rows / lhs->block_rows;                                     \
+        const double blocks = (double)lhs->row_ptr[block_rows];                                    \
+        const double fmas_per_block_row =                                                          \
+            blocks * (double)(lhs->block_rows * lhs->block_cols * N) / (double)block_rows;         \
+        if (HAS_SIMD && N > 1)                                                                     \
+            HODU_PROFILE_PATH(HODU_CPU_PATH_SIMD);                                                 \
+        parallel_for(0, block_rows, task_grain(HODU_CPU_COST_FMA, fmas_per_block_row + N),         \
+                     sparse_worker_##SFX, &args);                                                  \
+        if (staged)                                                                                \
+            workspace_release(staged);                                                             \
+    }
+
+SPARSE_SCALAR_IMPL(f32_t, f32)
+SPARSE_SCALAR_IMPL(f64_t, f64)
+
+#if SIMD_F32_WIDTH > 1
+SPARSE_SIMD_IMPL(f32_t, f32, SIMD_F32_WIDTH)
+#else
+SPARSE_BLOCK_ROW_SCALAR(f32)
+#endif
+
+#if SIMD_F64_WIDTH > 1
+SPARSE_SIMD_IMPL(f64_t, f64, SIMD_F64_WIDTH)
+#else
+SPARSE_BLOCK_ROW_SCALAR(f64)
+#endif
+
+SPARSE_MATMUL_IMPL(f32_t, f32, SIMD_F32_WIDTH > 1)
+SPARSE_MATMUL_IMPL(f64_t, f64, SIMD_F64_WIDTH > 1)
+
+// ============================================================================
+// DENSE TO SPARSE CONVERSION
+// ============================================================================
+
+/// Whether conversion metadata has blocks tiling the matrix
+static bool sparse_blocks_valid(const size_t *metadata) {
+    const size_t rows = metadata[0], cols = metadata[1];
+    const size_t block_rows = metadata[5], block_cols = metadata[6];
+    return block_rows > 0 && block_cols > 0 && rows % block_rows == 0 && cols % block_cols == 0;
+}
+
+/**
+ * @brief Macro implementing the dense to BSR conversion of one type
+ *
+ * @param TYPE Element type
+ * @param SFX Type suffix for function naming
+ */
+#define SPARSE_FROM_DENSE_IMPL(TYPE, SFX)                                                          \
+    /* Whether the block at (bi, bj) has a non-zero element */                                     \
+    static bool sparse_block_nonzero_##SFX(const TYPE *dense, const size_t *metadata, size_t bi,   \
+                                           size_t bj) {                                            \
+        const size_t R = metadata[5], C = metadata[6];                                             \
+        for (size_t r = 0; r < R; r++) {                                                           \
+            const TYPE *row = dense + (bi * R + r) * metadata[2] + bj * C * metadata[3];           \
+            for (size_t c = 0; c < C; c++) {                                                       \
+                if (row[c * metadata[3]] != 0)                                                     \
+                    return true;                                                                   \
+            }                                                                                      \
+        }                                                                                          \
+        return false;                                                                              \
+    }                                                                                              \
+                                                                                                   \
+    size_t hodu_cpu_sparse_count_##SFX(const void *dense, const size_t *metadata) {                \
+        HODU_PROFILE_KERNEL(metadata[0] * metadata[1] * sizeof(TYPE));                             \
+        if (!sparse_blocks_valid(metadata))                                                        \
+            return 0;                                                                              \
+        const TYPE *src = (const TYPE *)dense + metadata[4];                                       \
+        size_t count = 0;                                                                          \
+        for (size_t bi = 0; bi < metadata[0] / metadata[5]; bi++)                                  \
+            for (size_t bj = 0; bj < metadata[1] / metadata[6]; bj++)                              \
+                count += sparse_block_nonzero_##SFX(src, metadata, bi, bj);                        \
+        return count;                                                                              \
+    }                                                                                              \
+                                                                                                   \
+    void hodu_cpu_sparse_from_dense_##SFX(const void *dense, uint32_t *row_ptr, uint32_t *col_idx, \
+                                          void *values, const size_t *metadata) {                  \
+        HODU_PROFILE_KERNEL(metadata[0] * metadata[1] * sizeof(TYPE) * 2);                         \
+        if (!sparse_blocks_valid(metadata))                                                        \
+            return;                                                                                \
+        const size_t R = metadata[5], C = metadata[6];                                             \
+        const TYPE *src = (const TYPE *)dense + metadata[4];                                       \
+        TYPE *dst = (TYPE *)values;                                                                \
+        uint32_t count = 0;                                                                        \
+        row_ptr[0] = 0;                                                                            \
+        for (size_t bi = 0; bi < metadata[0] / R; bi++) {                                          \
+            for (size_t bj = 0; bj < metadata[1] / C; bj++) {                                      \
+                if (!sparse_block_nonzero_##SFX(src, metadata, bi, bj))                            \
+                    continue;                                                                      \
+                for (size_t r = 0; r < R; r++) {                                                   \
+                    const TYPE *row = src + (bi * R + r) * metadata[2] + bj * C * metadata[3];     \
+                    for (size_t c = 0; c < C; c++)                                                 \
+                        *dst++ = row[c * metadata[3]];                                             \
+                }                                                                                  \
+                col_idx[count++] = (uint32_t)bj;                                                   \
+            }                                                                                      \
+            row_ptr[bi + 1] = count;                                                               \
+        }                                                                                          \
+    }
+
+SPARSE_FROM_DENSE_IMPL(f32_t, f32)
+SPARSE_FROM_DENSE_IMPL(f64_t, f64)
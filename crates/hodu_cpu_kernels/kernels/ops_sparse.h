@@ -0,0 +1,106 @@
+/**
+ * @file ops_sparse.h
+ * @brief Sparse x dense matrix multiplication header
+ *
+ * Provides matrix multiplication with a sparse lhs, typically a pruned weight:
+ * - sparse_matmul: C = A @ B for block-sparse (BSR) A and dense B; CSR is the
+ *   1x1 block case
+ * - sparse_count / sparse_from_dense: Build the BSR/CSR arrays of a dense matrix
+ *
+ * Only stored blocks are multiplied, so the cost scales with the number of
+ * non-zero blocks instead of M * K. Blocks of several rows (e.g. 4x4) reuse
+ * every loaded rhs row for all rows of the block; 1x4 blocks keep CSR's
+ * granularity with a quarter of its column indices.
+ */
+
+#ifndef HODU_CPU_KERNELS_OPS_SPARSE_H
+#define HODU_CPU_KERNELS_OPS_SPARSE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// Block compressed sparse row (BSR) matrix; block_rows = block_cols = 1 is CSR
+///
+/// The rows x cols matrix is split into block_rows x block_cols blocks (both must
+/// divide the matrix dims). Block row i stores blocks row_ptr[i] .. row_ptr[i + 1]:
+/// block b covers columns col_idx[b] * block_cols .. + block_cols and its values
+/// are values[b * block_rows * block_cols ...], row-major within the block.
+/// Blocks of a block row should be ordered by column (the result does not depend
+/// on it, but rhs reads are then sequential).
+typedef struct {
+    size_t rows;
+    size_t cols;
+    size_t block_rows;
+    size_t block_cols;
+    const uint32_t *row_ptr; // rows / block_rows + 1 block offsets, row_ptr[0] = 0
+    const uint32_t *col_idx; // block column of every stored block
+    const void *values;      // block_rows * block_cols elements per stored block
+} hodu_cpu_sparse_t;
+
+// ============================================================================
+// SPARSE x DENSE MATMUL
+// ============================================================================
+//
+// Computes output = lhs @ rhs for a sparse [M, K] lhs and a dense [K, N] rhs:
+//   void hodu_cpu_sparse_matmul_type(const hodu_cpu_sparse_t *lhs, const void *rhs,
+//                                    void *output, const size_t *metadata)
+//
+// M and K come from lhs. The output is a contiguous [M, N] matrix and is
+// overwritten (rows without stored blocks become zero).
+//
+// Metadata layout:
+// - metadata[0]: N (cols of rhs and output)
+// - metadata[1]: rhs_stride_k (stride for rhs rows)
+// - metadata[2]: rhs_stride_n (stride for rhs cols)
+// - metadata[3]: rhs_offset (starting offset in rhs)
+//
+// Block rows are distributed over the thread pool. Each task keeps a register
+// tile of output columns per block row and streams the rhs rows named by the
+// stored blocks through it with SIMD FMAs; a rhs that is not contiguous along N
+// is first copied into workspace memory. Calls with a malformed lhs (blocks not
+// dividing the dims, missing arrays) leave the output untouched.
+
+void hodu_cpu_sparse_matmul_f32(const hodu_cpu_sparse_t *lhs, const void *rhs, void *output,
+                                const size_t *metadata);
+void hodu_cpu_sparse_matmul_f64(const hodu_cpu_sparse_t *lhs, const void *rhs, void *output,
+                                const size_t *metadata);
+
+// ============================================================================
+// DENSE TO SPARSE CONVERSION
+// ============================================================================
+//
+// Two calls convert a dense matrix: sparse_count returns the number of blocks
+// with at least one non-zero element (NaN counts as non-zero), the caller
+// allocates row_ptr (rows / block_rows + 1), col_idx (count) and values
+// (count * block_rows * block_cols), and sparse_from_dense fills them with the
+// blocks in column order:
+//   size_t count = hodu_cpu_sparse_count_f32(dense, metadata);
+//   hodu_cpu_sparse_from_dense_f32(dense, row_ptr, col_idx, values, metadata);
+//
+// Metadata layout:
+// - metadata[0]: rows
+// - metadata[1]: cols
+// - metadata[2]: stride_rows (stride for dense rows)
+// - metadata[3]: stride_cols (stride for dense cols)
+// - metadata[4]: offset (starting offset in dense)
+// - metadata[5]: block_rows (1 for CSR)
+// - metadata[6]: block_cols (1 for CSR)
+//
+// Block sizes that do not divide the dims count 0 blocks and write nothing.
+
+size_t hodu_cpu_sparse_count_f32(const void *dense, const size_t *metadata);
+size_t hodu_cpu_sparse_count_f64(const void *dense, const size_t *metadata);
+void hodu_cpu_sparse_from_dense_f32(const void *dense, uint32_t *row_ptr, uint32_t *col_idx,
+                                    void *values, const size_t *metadata);
+void hodu_cpu_sparse_from_dense_f64(const void *dense, uint32_t *row_ptr, uint32_t *col_idx,
+                                    void *values, const size_t *metadata);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // HODU_CPU_KERNELS_OPS_SPARSE_H
@@ -1,7 +1,10 @@
 #include "ops_unary.h"
+#include "profile.h"
 #include "simd_utils.h"
+#include "strided_copy.h"
 #include "thread_utils.h"
 #include "types.h"
+#include "workspace.h"
 #include <math.h>
 
 // BLAS-specific implementations are in separate files:
@@ -24,6 +27,25 @@
 //
 // The implementation optimizes for contiguous tensors with a fast path.
 
+// In place: output may equal input for the same-size kernels when the input view is
+// contiguous at offset 0 (or input is NULL). Any other input view overlapping the output is
+// first copied to a contiguous workspace block (hodu_cpu_stage_overlapping_view).
+
+/// Point `in` at a staged copy of an input view that overlaps `out` (see above); expects in,
+/// out, offset, contiguous, num_dims, dims and strides in scope, binds `staged`
+#define UNARY_STAGE_INPUT(TYPE, OUT_TYPE)                                                          \
+    void *staged = in ? hodu_cpu_stage_overlapping_view(in + offset, sizeof(TYPE), num_dims,       \
+                                                        dims, strides, out, sizeof(OUT_TYPE))      \
+                      : NULL;                                                                      \
+    in = staged ? (const TYPE *)staged : in;                                                       \
+    offset = staged ? 0 : offset;                                                                  \
+    contiguous = contiguous || staged
+
+/// Return the block taken by UNARY_STAGE_INPUT
+#define UNARY_RELEASE_INPUT                                                                        \
+    if (staged)                                                                                    \
+        workspace_release(staged)
+
 /**
  * @brief Macro to implement standard unary operations
  *
@@ -39,30 +61,28 @@
     typedef struct {                                                                               \
         const TYPE *input;                                                                         \
         TYPE *output;                                                                              \
-        size_t start;                                                                              \
-        size_t end;                                                                                \
         size_t offset;                                                                             \
     } unary_##OP_NAME##_##TYPE_SUFFIX##_args_t;                                                    \
                                                                                                    \
-    static void *unary_##OP_NAME##_##TYPE_SUFFIX##_worker(void *arg) {                             \
+    static void unary_##OP_NAME##_##TYPE_SUFFIX##_worker(size_t start, size_t end, void *arg) {    \
         unary_##OP_NAME##_##TYPE_SUFFIX##_args_t *args =                                           \
             (unary_##OP_NAME##_##TYPE_SUFFIX##_args_t *)arg;                                       \
         if (args->input) {                                                                         \
-            for (size_t i = args->start; i < args->end; i++) {                                     \
+            for (size_t i = start; i < end; i++) {                                                 \
                 TYPE x = args->input[args->offset + i];                                            \
                 args->output[i] = FUNC;                                                            \
             }                                                                                      \
         } else {                                                                                   \
-            for (size_t i = args->start; i < args->end; i++) {                                     \
+            for (size_t i = start; i < end; i++) {                                                 \
                 TYPE x = args->output[i];                                                          \
                 args->output[i] = FUNC;                                                            \
             }                                                                                      \
         }                                                                                          \
-        return NULL;                                                                               \
     }                                                                                              \
                                                                                                    \
     void hodu_cpu_##OP_NAME##_##TYPE_SUFFIX(const void *input, void *output,                       \
                                             const size_t *metadata) {                              \
+        HODU_PROFILE_KERNEL(metadata[0] * 2 * sizeof(TYPE));                                       \
         const size_t num_els = metadata[0];                                                        \
         const size_t num_dims = metadata[1];                                                       \
         const TYPE *in = (const TYPE *)input;                                                      \
@@ -70,54 +90,33 @@
                                                                                                    \
         const size_t *dims = metadata + 2;                                                         \
         const size_t *strides = metadata ? metadata + 2 + num_dims : NULL;                         \
-        const size_t offset = (metadata && num_dims > 0) ? metadata[2 + 2 * num_dims] : 0;         \
+        size_t offset = (metadata && num_dims > 0) ? metadata[2 + 2 * num_dims] : 0;               \
                                                                                                    \
         bool contiguous = (metadata == NULL) || is_contiguous(num_dims, dims, strides);            \
+        UNARY_STAGE_INPUT(TYPE, TYPE);                                                             \
                                                                                                    \
         if (contiguous) {                                                                          \
-            const size_t min_work_per_thread = 100000;                                             \
-            size_t num_threads = get_optimal_threads(num_els, min_work_per_thread);                \
-                                                                                                   \
-            if (num_threads > 1) {                                                                 \
-                thread_t threads[num_threads];                                                     \
-                unary_##OP_NAME##_##TYPE_SUFFIX##_args_t args[num_threads];                        \
-                                                                                                   \
-                size_t chunk_size = num_els / num_threads;                                         \
-                size_t remaining = num_els % num_threads;                                          \
-                                                                                                   \
-                for (size_t t = 0; t < num_threads; t++) {                                         \
-                    args[t].input = in;                                                            \
-                    args[t].output = out;                                                          \
-                    args[t].offset = offset;                                                       \
-                    args[t].start = t * chunk_size + (t < remaining ? t : remaining);              \
-                    args[t].end = args[t].start + chunk_size + (t < remaining ? 1 : 0);            \
-                    thread_create(&threads[t], unary_##OP_NAME##_##TYPE_SUFFIX##_worker,           \
-                                  &args[t]);                                                       \
-                }                                                                                  \
-                                                                                                   \
-                for (size_t t = 0; t < num_threads; t++) {                                         \
-                    thread_join(threads[t]);                                                       \
-                }                                                                                  \
-            } else {                                                                               \
-                if (in) {                                                                          \
-                    for (size_t i = 0; i < num_els; i++) {                                         \
-                        TYPE x = in[offset + i];                                                   \
-                        out[i] = FUNC;                                                             \
-                    }                                                                              \
-                } else {                                                                           \
-                    for (size_t i = 0; i < num_els; i++) {                                         \
-                        TYPE x = out[i];                                                           \
-                        out[i] = FUNC;                                                             \
-                    }                                                                              \
-                }                                                                                  \
-            }                                                                                      \
+            static hodu_cpu_cost_t cost;                                                           \
+            unary_##OP_NAME##_##TYPE_SUFFIX##_args_t args = {in, out, offset};                     \
+            parallel_for_measured(&cost, HODU_CPU_COST_ELEMENTWISE, 0, num_els,                    \
+                                  unary_##OP_NAME##_##TYPE_SUFFIX##_worker, &args);                \
         } else {                                                                                   \
-            for (size_t i = 0; i < num_els; i++) {                                                 \
-                size_t strided_i = offset + get_strided_index(i, num_dims, dims, strides);         \
-                TYPE x = in ? in[strided_i] : out[i];                                              \
-                out[i] = FUNC;                                                                     \
+            strided_iter_t it;                                                                     \
+            strided_iter_init(&it, num_dims, dims, strides, 0);                                    \
+            for (size_t i = 0; i < num_els;) {                                                     \
+                /* One innermost row per step: unit-stride rows vectorize */                       \
+                const size_t row_len = strided_iter_row(&it);                                      \
+                const size_t row_offset = offset + it.offset;                                      \
+                const size_t row_stride = it.inner_stride;                                         \
+                for (size_t k = 0; k < row_len; k++, i++) {                                        \
+                    size_t strided_i = row_offset + k * row_stride;                                \
+                    TYPE x = in ? in[strided_i] : out[i];                                          \
+                    out[i] = FUNC;                                                                 \
+                }                                                                                  \
+                strided_iter_advance(&it, row_len);                                                \
             }                                                                                      \
         }                                                                                          \
+        UNARY_RELEASE_INPUT;                                                                       \
     }
 
 /**
@@ -136,31 +135,30 @@
         const TYPE *input;                                                                         \
         TYPE *output;                                                                              \
         TYPE const_val;                                                                            \
-        size_t start;                                                                              \
-        size_t end;                                                                                \
         size_t offset;                                                                             \
     } unary_scalar_##OP_NAME##_##TYPE_SUFFIX##_args_t;                                             \
                                                                                                    \
-    static void *unary_scalar_##OP_NAME##_##TYPE_SUFFIX##_worker(void *arg) {                      \
+    static void unary_scalar_##OP_NAME##_##TYPE_SUFFIX##_worker(size_t start, size_t end,          \
+                                                                void *arg) {                       \
         unary_scalar_##OP_NAME##_##TYPE_SUFFIX##_args_t *args =                                    \
             (unary_scalar_##OP_NAME##_##TYPE_SUFFIX##_args_t *)arg;                                \
         TYPE const_val = args->const_val;                                                          \
         if (args->input) {                                                                         \
-            for (size_t i = args->start; i < args->end; i++) {                                     \
+            for (size_t i = start; i < end; i++) {                                                 \
                 TYPE x = args->input[args->offset + i];                                            \
                 args->output[i] = FUNC;                                                            \
             }                                                                                      \
         } else {                                                                                   \
-            for (size_t i = args->start; i < args->end; i++) {                                     \
+            for (size_t i = start; i < end; i++) {                                                 \
                 TYPE x = args->output[i];                                                          \
                 args->output[i] = FUNC;                                                            \
             }                                                                                      \
         }                                                                                          \
-        return NULL;                                                                               \
     }                                                                                              \
                                                                                                    \
     void hodu_cpu_##OP_NAME##_##TYPE_SUFFIX(const void *input, void *output,                       \
                                             const size_t *metadata, const void *scalar) {          \
+        HODU_PROFILE_KERNEL(metadata[0] * 2 * sizeof(TYPE));                                       \
         const size_t num_els = metadata[0];                                                        \
         const size_t num_dims = metadata[1];                                                       \
         const TYPE *in = (const TYPE *)input;                                                      \
@@ -169,55 +167,33 @@
                                                                                                    \
         const size_t *dims = metadata + 2;                                                         \
         const size_t *strides = metadata ? metadata + 2 + num_dims : NULL;                         \
-        const size_t offset = (metadata && num_dims > 0) ? metadata[2 + 2 * num_dims] : 0;         \
+        size_t offset = (metadata && num_dims > 0) ? metadata[2 + 2 * num_dims] : 0;               \
                                                                                                    \
         bool contiguous = (metadata == NULL) || is_contiguous(num_dims, dims, strides);            \
+        UNARY_STAGE_INPUT(TYPE, TYPE);                                                             \
                                                                                                    \
         if (contiguous) {                                                                          \
-            const size_t min_work_per_thread = 100000;                                             \
-            size_t num_threads = get_optimal_threads(num_els, min_work_per_thread);                \
-                                                                                                   \
-            if (num_threads > 1) {                                                                 \
-                thread_t threads[num_threads];                                                     \
-                unary_scalar_##OP_NAME##_##TYPE_SUFFIX##_args_t args[num_threads];                 \
-                                                                                                   \
-                size_t chunk_size = num_els / num_threads;                                         \
-                size_t remaining = num_els % num_threads;                                          \
-                                                                                                   \
-                for (size_t t = 0; t < num_threads; t++) {                                         \
-                    args[t].input = in;                                                            \
-                    args[t].output = out;                                                          \
-                    args[t].const_val = const_val;                                                 \
-                    args[t].offset = offset;                                                       \
-                    args[t].start = t * chunk_size + (t < remaining ? t : remaining);              \
-                    args[t].end = args[t].start + chunk_size + (t < remaining ? 1 : 0);            \
-                    thread_create(&threads[t], unary_scalar_##OP_NAME##_##TYPE_SUFFIX##_worker,    \
-                                  &args[t]);                                                       \
-                }                                                                                  \
-                                                                                                   \
-                for (size_t t = 0; t < num_threads; t++) {                                         \
-                    thread_join(threads[t]);                                                       \
-                }                                                                                  \
-            } else {                                                                               \
-                if (in) {                                                                          \
-                    for (size_t i = 0; i < num_els; i++) {                                         \
-                        TYPE x = in[offset + i];                                                   \
-                        out[i] = FUNC;                                                             \
-                    }                                                                              \
-                } else {                                                                           \
-                    for (size_t i = 0; i < num_els; i++) {                                         \
-                        TYPE x = out[i];                                                           \
-                        out[i] = FUNC;                                                             \
-                    }                                                                              \
-                }                                                                                  \
-            }                                                                                      \
+            static hodu_cpu_cost_t cost;                                                           \
+            unary_scalar_##OP_NAME##_##TYPE_SUFFIX##_args_t args = {in, out, const_val, offset};   \
+            parallel_for_measured(&cost, HODU_CPU_COST_ELEMENTWISE, 0, num_els,                    \
+                                  unary_scalar_##OP_NAME##_##TYPE_SUFFIX##_worker, &args);         \
         } else {                                                                                   \
-            for (size_t i = 0; i < num_els; i++) {                                                 \
-                size_t strided_i = offset + get_strided_index(i, num_dims, dims, strides);         \
-                TYPE x = in ? in[strided_i] : out[i];                                              \
-                out[i] = FUNC;                                                                     \
+            strided_iter_t it;                                                                     \
+            strided_iter_init(&it, num_dims, dims, strides, 0);                                    \
+            for (size_t i = 0; i < num_els;) {                                                     \
+                /* One innermost row per step: unit-stride rows vectorize */                       \
+                const size_t row_len = strided_iter_row(&it);                                      \
+                const size_t row_offset = offset + it.offset;                                      \
+                const size_t row_stride = it.inner_stride;                                         \
+                for (size_t k = 0; k < row_len; k++, i++) {                                        \
+                    size_t strided_i = row_offset + k * row_stride;                                \
+                    TYPE x = in ? in[strided_i] : out[i];                                          \
+                    out[i] = FUNC;                                                                 \
+                }                                                                                  \
+                strided_iter_advance(&it, row_len);                                                \
             }                                                                                      \
         }                                                                                          \
+        UNARY_RELEASE_INPUT;                                                                       \
     }
 
 /**
@@ -234,6 +210,7 @@
 #define IMPL_UNARY_TO_BOOL(TYPE, TYPE_SUFFIX, OP_NAME, FUNC)                                       \
     void hodu_cpu_##OP_NAME##_##TYPE_SUFFIX(const void *input, void *output,                       \
                                             const size_t *metadata) {                              \
+        HODU_PROFILE_KERNEL(metadata[0] * (sizeof(TYPE) + sizeof(uint8_t)));                       \
         const size_t num_els = metadata[0];                                                        \
         const size_t num_dims = metadata[1];                                                       \
         const TYPE *in = (const TYPE *)input;                                                      \
@@ -241,9 +218,10 @@
                                                                                                    \
         const size_t *dims = metadata + 2;                                                         \
         const size_t *strides = metadata ? metadata + 2 + num_dims : NULL;                         \
-        const size_t offset = (metadata && num_dims > 0) ? metadata[2 + 2 * num_dims] : 0;         \
+        size_t offset = (metadata && num_dims > 0) ? metadata[2 + 2 * num_dims] : 0;               \
                                                                                                    \
         bool contiguous = (metadata == NULL) || is_contiguous(num_dims, dims, strides);            \
+        UNARY_STAGE_INPUT(TYPE, uint8_t);                                                          \
                                                                                                    \
         if (contiguous) {                                                                          \
             for (size_t i = 0; i < num_els; i++) {                                                 \
@@ -251,12 +229,22 @@
                 out[i] = (FUNC) ? 1 : 0;                                                           \
             }                                                                                      \
         } else {                                                                                   \
-            for (size_t i = 0; i < num_els; i++) {                                                 \
-                size_t strided_i = offset + get_strided_index(i, num_dims, dims, strides);         \
-                TYPE x = in[strided_i];                                                            \
-                out[i] = (FUNC) ? 1 : 0;                                                           \
+            strided_iter_t it;                                                                     \
+            strided_iter_init(&it, num_dims, dims, strides, 0);                                    \
+            for (size_t i = 0; i < num_els;) {                                                     \
+                /* One innermost row per step: unit-stride rows vectorize */                       \
+                const size_t row_len = strided_iter_row(&it);                                      \
+                const size_t row_offset = offset + it.offset;                                      \
+                const size_t row_stride = it.inner_stride;                                         \
+                for (size_t k = 0; k < row_len; k++, i++) {                                        \
+                    size_t strided_i = row_offset + k * row_stride;                                \
+                    TYPE x = in[strided_i];                                                        \
+                    out[i] = (FUNC) ? 1 : 0;                                                       \
+                }                                                                                  \
+                strided_iter_advance(&it, row_len);                                                \
             }                                                                                      \
         }                                                                                          \
+        UNARY_RELEASE_INPUT;                                                                       \
     }
 
 /**
@@ -274,6 +262,7 @@
 #define IMPL_UNARY_CMP_SCALAR_TO_BOOL(TYPE, TYPE_SUFFIX, OP_NAME, FUNC)                            \
     void hodu_cpu_##OP_NAME##_##TYPE_SUFFIX(const void *input, void *output,                       \
                                             const size_t *metadata, const void *scalar) {          \
+        HODU_PROFILE_KERNEL(metadata[0] * (sizeof(TYPE) + sizeof(uint8_t)));                       \
         const size_t num_els = metadata[0];                                                        \
         const size_t num_dims = metadata[1];                                                       \
         const TYPE *in = (const TYPE *)input;                                                      \
@@ -282,9 +271,10 @@
                                                                                                    \
         const size_t *dims = metadata + 2;                                                         \
         const size_t *strides = metadata ? metadata + 2 + num_dims : NULL;                         \
-        const size_t offset = (metadata && num_dims > 0) ? metadata[2 + 2 * num_dims] : 0;         \
+        size_t offset = (metadata && num_dims > 0) ? metadata[2 + 2 * num_dims] : 0;               \
                                                                                                    \
         bool contiguous = (metadata == NULL) || is_contiguous(num_dims, dims, strides);            \
+        UNARY_STAGE_INPUT(TYPE, uint8_t);                                                          \
                                                                                                    \
         if (contiguous) {                                                                          \
             for (size_t i = 0; i < num_els; i++) {                                                 \
@@ -292,12 +282,53 @@
                 out[i] = (FUNC) ? 1 : 0;                                                           \
             }                                                                                      \
         } else {                                                                                   \
-            for (size_t i = 0; i < num_els; i++) {                                                 \
-                size_t strided_i = offset + get_strided_index(i, num_dims, dims, strides);         \
-                TYPE x = in ? in[strided_i] : ((TYPE *)out)[i];                                    \
-                out[i] = (FUNC) ? 1 : 0;                                                           \
+            strided_iter_t it;                                                                     \
+            strided_iter_init(&it, num_dims, dims, strides, 0);                                    \
+            for (size_t i = 0; i < num_els;) {                                                     \
+                /* One innermost row per step: unit-stride rows vectorize */                       \
+                const size_t row_len = strided_iter_row(&it);                                      \
+                const size_t row_offset = offset + it.offset;                                      \
+                const size_t row_stride = it.inner_stride;                                         \
+                for (size_t k = 0; k < row_len; k++, i++) {                                        \
+                    size_t strided_i = row_offset + k * row_stride;                                \
+                    TYPE x = in ? in[strided_i] : ((TYPE *)out)[i];                                \
+                    out[i] = (FUNC) ? 1 : 0;                                                       \
+                }                                                                                  \
+                strided_iter_advance(&it, row_len);                                                \
             }                                                                                      \
         }                                                                                          \
+        UNARY_RELEASE_INPUT;                                                                       \
+    }
+
+// Elements widened to f32 at a time by the converting variants
+#define UNARY_CONVERT_BLOCK 256
+
+/// Contiguous loop for the converting variants: widens SRC[0..N) to f32 one block at a time
+/// (simd_widen_<TYPE_SUFFIX>), evaluates FUNC with each element bound to the float 'x' and
+/// narrows the results into DST (simd_narrow_<TYPE_SUFFIX>). SRC and DST may alias: a block
+/// is fully read before it is written.
+#define UNARY_CONVERT_BLOCKS(TYPE_SUFFIX, SRC, DST, N, FUNC)                                       \
+    for (size_t b = 0; b < N; b += UNARY_CONVERT_BLOCK) {                                          \
+        const size_t bn = MINIMUM((size_t)UNARY_CONVERT_BLOCK, N - b);                             \
+        float buf[UNARY_CONVERT_BLOCK];                                                            \
+        simd_widen_##TYPE_SUFFIX(SRC + b, buf, bn);                                                \
+        for (size_t j = 0; j < bn; j++) {                                                          \
+            float x = buf[j];                                                                      \
+            buf[j] = FUNC;                                                                         \
+        }                                                                                          \
+        simd_narrow_##TYPE_SUFFIX(buf, DST + b, bn);                                               \
+    }
+
+/// Same as UNARY_CONVERT_BLOCKS for predicates: writes (FUNC) ? 1 : 0 to the uint8_t DST
+#define UNARY_CONVERT_BLOCKS_TO_BOOL(TYPE_SUFFIX, SRC, DST, N, FUNC)                               \
+    for (size_t b = 0; b < N; b += UNARY_CONVERT_BLOCK) {                                          \
+        const size_t bn = MINIMUM((size_t)UNARY_CONVERT_BLOCK, N - b);                             \
+        float buf[UNARY_CONVERT_BLOCK];                                                            \
+        simd_widen_##TYPE_SUFFIX(SRC + b, buf, bn);                                                \
+        for (size_t j = 0; j < bn; j++) {                                                          \
+            float x = buf[j];                                                                      \
+            DST[b + j] = (FUNC) ? 1 : 0;                                                           \
+        }                                                                                          \
     }
 
 /**
@@ -317,6 +348,7 @@
 #define IMPL_UNARY_OP_CONVERT(TYPE, TYPE_SUFFIX, OP_NAME, FUNC, TO_FLOAT, FROM_FLOAT)              \
     void hodu_cpu_##OP_NAME##_##TYPE_SUFFIX(const void *input, void *output,                       \
                                             const size_t *metadata) {                              \
+        HODU_PROFILE_KERNEL(metadata[0] * 2 * sizeof(TYPE));                                       \
         const size_t num_els = metadata[0];                                                        \
         const size_t num_dims = metadata[1];                                                       \
         const TYPE *in = (const TYPE *)input;                                                      \
@@ -324,34 +356,43 @@
                                                                                                    \
         const size_t *dims = metadata + 2;                                                         \
         const size_t *strides = metadata ? metadata + 2 + num_dims : NULL;                         \
-        const size_t offset = (metadata && num_dims > 0) ? metadata[2 + 2 * num_dims] : 0;         \
+        size_t offset = (metadata && num_dims > 0) ? metadata[2 + 2 * num_dims] : 0;               \
                                                                                                    \
         bool contiguous = (metadata == NULL) || is_contiguous(num_dims, dims, strides);            \
+        UNARY_STAGE_INPUT(TYPE, TYPE);                                                             \
                                                                                                    \
         if (contiguous) {                                                                          \
-            if (in) {                                                                              \
-                for (size_t i = 0; i < num_els; i++) {                                             \
-                    float x = TO_FLOAT(in[offset + i]);                                            \
-                    out[i] = FROM_FLOAT(FUNC);                                                     \
-                }                                                                                  \
-            } else {                                                                               \
-                for (size_t i = 0; i < num_els; i++) {                                             \
-                    float x = TO_FLOAT(out[i]);                                                    \
-                    out[i] = FROM_FLOAT(FUNC);                                                     \
-                }                                                                                  \
-            }                                                                                      \
+            const TYPE *src = in ? in + offset : out;                                              \
+            UNARY_CONVERT_BLOCKS(TYPE_SUFFIX, src, out, num_els, FUNC)                             \
         } else {                                                                                   \
-            for (size_t i = 0; i < num_els; i++) {                                                 \
-                size_t strided_i = offset + get_strided_index(i, num_dims, dims, strides);         \
-                float x = in ? TO_FLOAT(in[strided_i]) : TO_FLOAT(out[i]);                         \
-                out[i] = FROM_FLOAT(FUNC);                                                         \
+            strided_iter_t it;                                                                     \
+            strided_iter_init(&it, num_dims, dims, strides, 0);                                    \
+            for (size_t i = 0; i < num_els;) {                                                     \
+                /* One innermost row per step: unit-stride rows vectorize */                       \
+                const size_t row_len = strided_iter_row(&it);                                      \
+                const size_t row_offset = offset + it.offset;                                      \
+                const size_t row_stride = it.inner_stride;                                         \
+                if (in && row_stride == 1) {                                                       \
+                    /* Unit-stride row: convert through f32 blocks */                              \
+                    UNARY_CONVERT_BLOCKS(TYPE_SUFFIX, in + row_offset, out + i, row_len, FUNC)     \
+                    i += row_len;                                                                  \
+                } else {                                                                           \
+                    for (size_t k = 0; k < row_len; k++, i++) {                                    \
+                        size_t strided_i = row_offset + k * row_stride;                            \
+                        float x = in ? TO_FLOAT(in[strided_i]) : TO_FLOAT(out[i]);                 \
+                        out[i] = FROM_FLOAT(FUNC);                                                 \
+                    }                                                                              \
+                }                                                                                  \
+                strided_iter_advance(&it, row_len);                                                \
             }                                                                                      \
         }                                                                                          \
+        UNARY_RELEASE_INPUT;                                                                       \
     }
 
 #define IMPL_UNARY_WITH_SCALAR_CONVERT(TYPE, TYPE_SUFFIX, OP_NAME, FUNC, TO_FLOAT, FROM_FLOAT)     \
     void hodu_cpu_##OP_NAME##_##TYPE_SUFFIX(const void *input, void *output,                       \
                                             const size_t *metadata, const void *scalar) {          \
+        HODU_PROFILE_KERNEL(metadata[0] * 2 * sizeof(TYPE));                                       \
         const size_t num_els = metadata[0];                                                        \
         const size_t num_dims = metadata[1];                                                       \
         const TYPE *in = (const TYPE *)input;                                                      \
@@ -360,34 +401,37 @@
                                                                                                    \
         const size_t *dims = metadata + 2;                                                         \
         const size_t *strides = metadata ? metadata + 2 + num_dims : NULL;                         \
-        const size_t offset = (metadata && num_dims > 0) ? metadata[2 + 2 * num_dims] : 0;         \
+        size_t offset = (metadata && num_dims > 0) ? metadata[2 + 2 * num_dims] : 0;               \
                                                                                                    \
         bool contiguous = (metadata == NULL) || is_contiguous(num_dims, dims, strides);            \
+        UNARY_STAGE_INPUT(TYPE, TYPE);                                                             \
                                                                                                    \
         if (contiguous) {                                                                          \
-            if (in) {                                                                              \
-                for (size_t i = 0; i < num_els; i++) {                                             \
-                    float x = TO_FLOAT(in[offset + i]);                                            \
-                    out[i] = FROM_FLOAT(FUNC);                                                     \
-                }                                                                                  \
-            } else {                                                                               \
-                for (size_t i = 0; i < num_els; i++) {                                             \
-                    float x = TO_FLOAT(out[i]);                                                    \
+            const TYPE *src = in ? in + offset : out;                                              \
+            UNARY_CONVERT_BLOCKS(TYPE_SUFFIX, src, out, num_els, FUNC)                             \
+        } else {                                                                                   \
+            strided_iter_t it;                                                                     \
+            strided_iter_init(&it, num_dims, dims, strides, 0);                                    \
+            for (size_t i = 0; i < num_els;) {                                                     \
+                /* One innermost row per step: unit-stride rows vectorize */                       \
+                const size_t row_len = strided_iter_row(&it);                                      \
+                const size_t row_offset = offset + it.offset;                                      \
+                const size_t row_stride = it.inner_stride;                                         \
+                for (size_t k = 0; k < row_len; k++, i++) {                                        \
+                    size_t strided_i = row_offset + k * row_stride;                                \
+                    float x = in ? TO_FLOAT(in[strided_i]) : TO_FLOAT(out[i]);                     \
                     out[i] = FROM_FLOAT(FUNC);                                                     \
                 }                                                                                  \
-            }                                                                                      \
-        } else {                                                                                   \
-            for (size_t i = 0; i < num_els; i++) {                                                 \
-                size_t strided_i = offset + get_strided_index(i, num_dims, dims, strides);         \
-                float x = in ? TO_FLOAT(in[strided_i]) : TO_FLOAT(out[i]);                         \
-                out[i] = FROM_FLOAT(FUNC);                                                         \
+                strided_iter_advance(&it, row_len);                                                \
             }                                                                                      \
         }                                                                                          \
+        UNARY_RELEASE_INPUT;                                                                       \
     }
 
 #define IMPL_UNARY_TO_BOOL_CONVERT(TYPE, TYPE_SUFFIX, OP_NAME, FUNC, TO_FLOAT)                     \
     void hodu_cpu_##OP_NAME##_##TYPE_SUFFIX(const void *input, void *output,                       \
                                             const size_t *metadata) {                              \
+        HODU_PROFILE_KERNEL(metadata[0] * (sizeof(TYPE) + sizeof(uint8_t)));                       \
         const size_t num_els = metadata[0];                                                        \
         const size_t num_dims = metadata[1];                                                       \
         const TYPE *in = (const TYPE *)input;                                                      \
@@ -395,27 +439,36 @@
                                                                                                    \
         const size_t *dims = metadata + 2;                                                         \
         const size_t *strides = metadata ? metadata + 2 + num_dims : NULL;                         \
-        const size_t offset = (metadata && num_dims > 0) ? metadata[2 + 2 * num_dims] : 0;         \
+        size_t offset = (metadata && num_dims > 0) ? metadata[2 + 2 * num_dims] : 0;               \
                                                                                                    \
         bool contiguous = (metadata == NULL) || is_contiguous(num_dims, dims, strides);            \
+        UNARY_STAGE_INPUT(TYPE, uint8_t);                                                          \
                                                                                                    \
         if (contiguous) {                                                                          \
-            for (size_t i = 0; i < num_els; i++) {                                                 \
-                float x = TO_FLOAT(in[offset + i]);                                                \
-                out[i] = (FUNC) ? 1 : 0;                                                           \
-            }                                                                                      \
+            UNARY_CONVERT_BLOCKS_TO_BOOL(TYPE_SUFFIX, in + offset, out, num_els, FUNC)             \
         } else {                                                                                   \
-            for (size_t i = 0; i < num_els; i++) {                                                 \
-                size_t strided_i = offset + get_strided_index(i, num_dims, dims, strides);         \
-                float x = TO_FLOAT(in[strided_i]);                                                 \
-                out[i] = (FUNC) ? 1 : 0;                                                           \
+            strided_iter_t it;                                                                     \
+            strided_iter_init(&it, num_dims, dims, strides, 0);                                    \
+            for (size_t i = 0; i < num_els;) {                                                     \
+                /* One innermost row per step: unit-stride rows vectorize */                       \
+                const size_t row_len = strided_iter_row(&it);                                      \
+                const size_t row_offset = offset + it.offset;                                      \
+                const size_t row_stride = it.inner_stride;                                         \
+                for (size_t k = 0; k < row_len; k++, i++) {                                        \
+                    size_t strided_i = row_offset + k * row_stride;                                \
+                    float x = TO_FLOAT(in[strided_i]);                                             \
+                    out[i] = (FUNC) ? 1 : 0;                                                       \
+                }                                                                                  \
+                strided_iter_advance(&it, row_len);                                                \
             }                                                                                      \
         }                                                                                          \
+        UNARY_RELEASE_INPUT;                                                                       \
     }
 
 #define IMPL_UNARY_CMP_SCALAR_TO_BOOL_CONVERT(TYPE, TYPE_SUFFIX, OP_NAME, FUNC, TO_FLOAT)          \
     void hodu_cpu_##OP_NAME##_##TYPE_SUFFIX(const void *input, void *output,                       \
                                             const size_t *metadata, const void *scalar) {          \
+        HODU_PROFILE_KERNEL(metadata[0] * (sizeof(TYPE) + sizeof(uint8_t)));                       \
         const size_t num_els = metadata[0];                                                        \
         const size_t num_dims = metadata[1];                                                       \
         const TYPE *in = (const TYPE *)input;                                                      \
@@ -424,22 +477,250 @@
                                                                                                    \
         const size_t *dims = metadata + 2;                                                         \
         const size_t *strides = metadata ? metadata + 2 + num_dims : NULL;                         \
-        const size_t offset = (metadata && num_dims > 0) ? metadata[2 + 2 * num_dims] : 0;         \
+        size_t offset = (metadata && num_dims > 0) ? metadata[2 + 2 * num_dims] : 0;               \
                                                                                                    \
         bool contiguous = (metadata == NULL) || is_contiguous(num_dims, dims, strides);            \
+        UNARY_STAGE_INPUT(TYPE, uint8_t);                                                          \
                                                                                                    \
         if (contiguous) {                                                                          \
-            for (size_t i = 0; i < num_els; i++) {                                                 \
-                float x = in ? TO_FLOAT(in[offset + i]) : TO_FLOAT(((TYPE *)out)[i]);              \
-                out[i] = (FUNC) ? 1 : 0;                                                           \
+            const TYPE *src = in ? in + offset : (const TYPE *)out;                                \
+            UNARY_CONVERT_BLOCKS_TO_BOOL(TYPE_SUFFIX, src, out, num_els, FUNC)                     \
+        } else {                                                                                   \
+            strided_iter_t it;                                                                     \
+            strided_iter_init(&it, num_dims, dims, strides, 0);                                    \
+            for (size_t i = 0; i < num_els;) {                                                     \
+                /* One innermost row per step: unit-stride rows vectorize */                       \
+                const size_t row_len = strided_iter_row(&it);                                      \
+                const size_t row_offset = offset + it.offset;                                      \
+                const size_t row_stride = it.inner_stride;                                         \
+                for (size_t k = 0; k < row_len; k++, i++) {                                        \
+                    size_t strided_i = row_offset + k * row_stride;                                \
+                    float x = in ? TO_FLOAT(in[strided_i]) : TO_FLOAT(((TYPE *)out)[i]);           \
+                    out[i] = (FUNC) ? 1 : 0;                                                       \
+                }                                                                                  \
+                strided_iter_advance(&it, row_len);                                                \
+            }                                                                                      \
+        }                                                                                          \
+        UNARY_RELEASE_INPUT;                                                                       \
+    }
+
+// ============================================================================
+// SIMD TRANSCENDENTAL OPERATION MACROS
+// ============================================================================
+//
+// Activation and transcendental ops evaluate the polynomial approximations from
+// simd_utils.h (simd_f32_exp, simd_f32_tanh, ...) on contiguous runs, tails
+// included (masked partial vectors), so every element of a contiguous tensor
+// gets the same approximation. Strided inputs use the scalar libm expression.
+// The vector forms below share the scalar helpers' definitions (math_utils.h).
+
+#if SIMD_F32_WIDTH > 1
+// Applies SIMD_FUNC (an expression of the simd_f32_t 'v') to SRC[I, END) a vector at a time,
+// the last one partial (masked), and leaves I at END
+#define UNARY_SIMD_F32_LOOP(SRC, DST, I, END, SIMD_FUNC)                                           \
+    HODU_PROFILE_PATH(HODU_CPU_PATH_SIMD);                                                         \
+    for (; I + SIMD_F32_WIDTH <= END; I += SIMD_F32_WIDTH) {                                       \
+        simd_f32_t v = simd_f32_load(SRC + I);                                                     \
+        simd_f32_store(DST + I, SIMD_FUNC);                                                        \
+    }                                                                                              \
+    if (I < END) {                                                                                 \
+        simd_f32_t v = simd_f32_load_partial(SRC + I, END - I, simd_f32_set1(0.0f));               \
+        simd_f32_store_partial(DST + I, SIMD_FUNC, END - I);                                       \
+        I = END;                                                                                   \
+    }
+
+static inline simd_f32_t softplus_simd_f32(simd_f32_t x) {
+    // max(x, 0) + log1p(e^-|x|), with log1p(e) = log(u) * e / (u - 1) for u = 1 + e
+    const simd_f32_t one = simd_f32_set1(1.0f);
+    simd_f32_t e = simd_f32_exp(simd_f32_neg(simd_f32_abs(x)));
+    simd_f32_t u = simd_f32_add(one, e);
+    simd_f32_t l = simd_f32_mul(simd_f32_log(u), simd_f32_div(e, simd_f32_sub(u, one)));
+    l = simd_f32_select(simd_f32_cmpeq(u, one), e, l);
+    return simd_f32_add(simd_f32_max(simd_f32_set1(0.0f), x), l);
+}
+
+static inline simd_f32_t mish_simd_f32(simd_f32_t x) {
+    // tanh(log(1 + e^x)) == n / (n + 2) with n = e^x * (e^x + 2); exactly 1 in f32 past x = 20
+    const simd_f32_t limit = simd_f32_set1(20.0f);
+    simd_f32_t e = simd_f32_exp(simd_f32_min(limit, x));
+    simd_f32_t n = simd_f32_mul(e, simd_f32_add(e, simd_f32_set1(2.0f)));
+    simd_f32_t y = simd_f32_mul(x, simd_f32_div(n, simd_f32_add(n, simd_f32_set1(2.0f))));
+    return simd_f32_select(simd_f32_cmplt(limit, x), x, y);
+}
+
+static inline simd_f32_t selu_simd_f32(simd_f32_t x) {
+    simd_f32_t neg = simd_f32_sub(simd_f32_exp(x), simd_f32_set1(1.0f));
+    neg = simd_f32_mul(neg, simd_f32_set1(SELU_ALPHA_F32));
+    simd_f32_t y = simd_f32_select(simd_f32_cmplt(simd_f32_set1(0.0f), x), x, neg);
+    return simd_f32_mul(y, simd_f32_set1(SELU_SCALE_F32));
+}
+
+static inline simd_f32_t celu_simd_f32(simd_f32_t x) {
+    simd_f32_t neg = simd_f32_sub(simd_f32_exp(x), simd_f32_set1(1.0f));
+    return simd_f32_select(simd_f32_cmplt(simd_f32_set1(0.0f), x), x, neg);
+}
+#else
+#define UNARY_SIMD_F32_LOOP(SRC, DST, I, END, SIMD_FUNC)
+#endif
+
+/**
+ * @brief Macro to implement f32 unary operations with a SIMD kernel
+ *
+ * Same interface as IMPL_UNARY_OP for f32. Contiguous tensors are split across
+ * the thread pool and processed SIMD_F32_WIDTH elements at a time.
+ *
+ * @param OP_NAME Operation name (e.g., exp, gelu)
+ * @param FUNC Scalar expression using variable 'x' (tails and strided inputs)
+ * @param SIMD_FUNC Vector expression using the simd_f32_t variable 'v'
+ */
+#define IMPL_UNARY_OP_SIMD_F32(OP_NAME, FUNC, SIMD_FUNC)                                           \
+    typedef struct {                                                                               \
+        const f32_t *input;                                                                        \
+        f32_t *output;                                                                             \
+    } unary_simd_##OP_NAME##_f32_args_t;                                                           \
+                                                                                                   \
+    static void unary_simd_##OP_NAME##_f32_worker(size_t start, size_t end, void *arg) {           \
+        unary_simd_##OP_NAME##_f32_args_t *args = (unary_simd_##OP_NAME##_f32_args_t *)arg;        \
+        const f32_t *src = args->input;                                                            \
+        f32_t *dst = args->output;                                                                 \
+        size_t i = start;                                                                          \
+        UNARY_SIMD_F32_LOOP(src, dst, i, end, SIMD_FUNC)                                           \
+        for (; i < end; i++) {                                                                     \
+            f32_t x = src[i];                                                                      \
+            dst[i] = FUNC;                                                                         \
+        }                                                                                          \
+    }                                                                                              \
+                                                                                                   \
+    void hodu_cpu_##OP_NAME##_f32(const void *input, void *output, const size_t *metadata) {       \
+        HODU_PROFILE_KERNEL(metadata[0] * 2 * sizeof(f32_t));                                      \
+        const size_t num_els = metadata[0];                                                        \
+        const size_t num_dims = metadata[1];                                                       \
+        const f32_t *in = (const f32_t *)input;                                                    \
+        f32_t *out = (f32_t *)output;                                                              \
+                                                                                                   \
+        const size_t *dims = metadata + 2;                                                         \
+        const size_t *strides = metadata ? metadata + 2 + num_dims : NULL;                         \
+        size_t offset = (metadata && num_dims > 0) ? metadata[2 + 2 * num_dims] : 0;               \
+                                                                                                   \
+        bool contiguous = (metadata == NULL) || is_contiguous(num_dims, dims, strides);            \
+        UNARY_STAGE_INPUT(f32_t, f32_t);                                                           \
+                                                                                                   \
+        if (contiguous) {                                                                          \
+            static hodu_cpu_cost_t cost;                                                           \
+            unary_simd_##OP_NAME##_f32_args_t args = {in ? in + offset : out, out};                \
+            parallel_for_measured(&cost, HODU_CPU_COST_TRANSCENDENTAL, 0, num_els,                 \
+                                  unary_simd_##OP_NAME##_f32_worker, &args);                       \
+        } else {                                                                                   \
+            strided_iter_t it;                                                                     \
+            strided_iter_init(&it, num_dims, dims, strides, 0);                                    \
+            for (size_t i = 0; i < num_els;) {                                                     \
+                /* One innermost row per step: unit-stride rows vectorize */                       \
+                const size_t row_len = strided_iter_row(&it);                                      \
+                const size_t row_offset = offset + it.offset;                                      \
+                const size_t row_stride = it.inner_stride;                                         \
+                if (in && row_stride == 1) {                                                       \
+                    /* Unit-stride row: reuse the vector kernel */                                 \
+                    unary_simd_##OP_NAME##_f32_args_t row_args = {in + row_offset, out + i};       \
+                    unary_simd_##OP_NAME##_f32_worker(0, row_len, &row_args);                      \
+                    i += row_len;                                                                  \
+                } else {                                                                           \
+                    for (size_t k = 0; k < row_len; k++, i++) {                                    \
+                        size_t strided_i = row_offset + k * row_stride;                            \
+                        f32_t x = in ? in[strided_i] : out[i];                                     \
+                        out[i] = FUNC;                                                             \
+                    }                                                                              \
+                }                                                                                  \
+                strided_iter_advance(&it, row_len);                                                \
             }                                                                                      \
+        }                                                                                          \
+        UNARY_RELEASE_INPUT;                                                                       \
+    }
+
+/**
+ * @brief Macro to implement unary operations on exotic float types with a SIMD kernel
+ *
+ * Same interface as IMPL_UNARY_OP_CONVERT. Contiguous tensors are split across
+ * the thread pool; each block of UNARY_CONVERT_BLOCK elements is widened to f32,
+ * processed with SIMD_FUNC and narrowed back.
+ *
+ * @param TYPE C type of the tensor elements
+ * @param TYPE_SUFFIX Suffix for the function name
+ * @param OP_NAME Operation name
+ * @param FUNC Scalar expression using float variable 'x'
+ * @param SIMD_FUNC Vector expression using the simd_f32_t variable 'v'
+ * @param TO_FLOAT Function to convert TYPE to float
+ * @param FROM_FLOAT Function to convert float to TYPE
+ */
+#define IMPL_UNARY_OP_CONVERT_SIMD(TYPE, TYPE_SUFFIX, OP_NAME, FUNC, SIMD_FUNC, TO_FLOAT,          \
+                                   FROM_FLOAT)                                                     \
+    typedef struct {                                                                               \
+        const TYPE *input;                                                                         \
+        TYPE *output;                                                                              \
+    } unary_simd_##OP_NAME##_##TYPE_SUFFIX##_args_t;                                               \
+                                                                                                   \
+    static void unary_simd_##OP_NAME##_##TYPE_SUFFIX##_worker(size_t start, size_t end,            \
+                                                              void *arg) {                         \
+        unary_simd_##OP_NAME##_##TYPE_SUFFIX##_args_t *args =                                      \
+            (unary_simd_##OP_NAME##_##TYPE_SUFFIX##_args_t *)arg;                                  \
+        float buf[UNARY_CONVERT_BLOCK];                                                            \
+        for (size_t b = start; b < end; b += UNARY_CONVERT_BLOCK) {                                \
+            const size_t n = MINIMUM((size_t)UNARY_CONVERT_BLOCK, end - b);                        \
+            simd_widen_##TYPE_SUFFIX(args->input + b, buf, n);                                     \
+            size_t j = 0;                                                                          \
+            UNARY_SIMD_F32_LOOP(buf, buf, j, n, SIMD_FUNC)                                         \
+            for (; j < n; j++) {                                                                   \
+                float x = buf[j];                                                                  \
+                buf[j] = FUNC;                                                                     \
+            }                                                                                      \
+            simd_narrow_##TYPE_SUFFIX(buf, args->output + b, n);                                   \
+        }                                                                                          \
+    }                                                                                              \
+                                                                                                   \
+    void hodu_cpu_##OP_NAME##_##TYPE_SUFFIX(const void *input, void *output,                       \
+                                            const size_t *metadata) {                              \
+        HODU_PROFILE_KERNEL(metadata[0] * 2 * sizeof(TYPE));                                       \
+        const size_t num_els = metadata[0];                                                        \
+        const size_t num_dims = metadata[1];                                                       \
+        const TYPE *in = (const TYPE *)input;                                                      \
+        TYPE *out = (TYPE *)output;                                                                \
+                                                                                                   \
+        const size_t *dims = metadata + 2;                                                         \
+        const size_t *strides = metadata ? metadata + 2 + num_dims : NULL;                         \
+        size_t offset = (metadata && num_dims > 0) ? metadata[2 + 2 * num_dims] : 0;               \
+                                                                                                   \
+        bool contiguous = (metadata == NULL) || is_contiguous(num_dims, dims, strides);            \
+        UNARY_STAGE_INPUT(TYPE, TYPE);                                                             \
+                                                                                                   \
+        if (contiguous) {                                                                          \
+            static hodu_cpu_cost_t cost;                                                           \
+            unary_simd_##OP_NAME##_##TYPE_SUFFIX##_args_t args = {in ? in + offset : out, out};    \
+            parallel_for_measured(&cost, HODU_CPU_COST_TRANSCENDENTAL, 0, num_els,                 \
+                                  unary_simd_##OP_NAME##_##TYPE_SUFFIX##_worker, &args);           \
         } else {                                                                                   \
-            for (size_t i = 0; i < num_els; i++) {                                                 \
-                size_t strided_i = offset + get_strided_index(i, num_dims, dims, strides);         \
-                float x = in ? TO_FLOAT(in[strided_i]) : TO_FLOAT(((TYPE *)out)[i]);               \
-                out[i] = (FUNC) ? 1 : 0;                                                           \
+            strided_iter_t it;                                                                     \
+            strided_iter_init(&it, num_dims, dims, strides, 0);                                    \
+            for (size_t i = 0; i < num_els;) {                                                     \
+                /* One innermost row per step: unit-stride rows vectorize */                       \
+                const size_t row_len = strided_iter_row(&it);                                      \
+                const size_t row_offset = offset + it.offset;                                      \
+                const size_t row_stride = it.inner_stride;                                         \
+                if (in && row_stride == 1) {                                                       \
+                    /* Unit-stride row: reuse the vector kernel */                                 \
+                    unary_simd_##OP_NAME##_##TYPE_SUFFIX##_args_t row_args = {in + row_offset,     \
+                                                                              out + i};            \
+                    unary_simd_##OP_NAME##_##TYPE_SUFFIX##_worker(0, row_len, &row_args);          \
+                    i += row_len;                                                                  \
+                } else {                                                                           \
+                    for (size_t k = 0; k < row_len; k++, i++) {                                    \
+                        size_t strided_i = row_offset + k * row_stride;                            \
+                        float x = in ? TO_FLOAT(in[strided_i]) : TO_FLOAT(out[i]);                 \
+                        out[i] = FROM_FLOAT(FUNC);                                                 \
+                    }                                                                              \
+                }                                                                                  \
+                strided_iter_advance(&it, row_len);                                                \
             }                                                                                      \
         }                                                                                          \
+        UNARY_RELEASE_INPUT;                                                                       \
     }
 
 // ============================================================================
@@ -448,24 +729,29 @@
 // Basic arithmetic operations
 // SIMD-optimized neg_f32
 void hodu_cpu_neg_f32(const void *input, void *output, const size_t *metadata) {
+    HODU_PROFILE_KERNEL(metadata[0] * 2 * sizeof(f32_t));
     const size_t num_els = metadata[0];
     const size_t num_dims = metadata[1];
     const f32_t *in = (const f32_t *)input;
     f32_t *out = (f32_t *)output;
     const size_t *dims = metadata + 2;
     const size_t *strides = metadata ? metadata + 2 + num_dims : NULL;
-    const size_t offset = (metadata && num_dims > 0) ? metadata[2 + 2 * num_dims] : 0;
+    size_t offset = (metadata && num_dims > 0) ? metadata[2 + 2 * num_dims] : 0;
     bool contiguous = (metadata == NULL) || is_contiguous(num_dims, dims, strides);
+    UNARY_STAGE_INPUT(f32_t, f32_t);
 
     if (contiguous && in && offset == 0) {
 #if SIMD_F32_WIDTH > 1
+        HODU_PROFILE_PATH(HODU_CPU_PATH_SIMD);
         const size_t simd_end = (num_els / SIMD_F32_WIDTH) * SIMD_F32_WIDTH;
         for (size_t i = 0; i < simd_end; i += SIMD_F32_WIDTH) {
             simd_f32_t v = simd_f32_load(&in[i]);
             simd_f32_store(&out[i], simd_f32_neg(v));
         }
-        for (size_t i = simd_end; i < num_els; i++) {
-            out[i] = -in[i];
+        if (simd_end < num_els) {
+            const size_t rem = num_els - simd_end;
+            simd_f32_t v = simd_f32_load_partial(&in[simd_end], rem, simd_f32_set1(0.0f));
+            simd_f32_store_partial(&out[simd_end], simd_f32_neg(v), rem);
         }
 #else
         for (size_t i = 0; i < num_els; i++) {
@@ -485,35 +771,50 @@ void hodu_cpu_neg_f32(const void *input, void *output, const size_t *metadata) {
                 }
             }
         } else {
-            for (size_t i = 0; i < num_els; i++) {
-                size_t strided_i = offset + get_strided_index(i, num_dims, dims, strides);
-                f32_t x = in ? in[strided_i] : out[i];
-                out[i] = -x;
+            strided_iter_t it;
+            strided_iter_init(&it, num_dims, dims, strides, 0);
+            for (size_t i = 0; i < num_els;) {
+                // One innermost row per step: unit-stride rows vectorize
+                const size_t row_len = strided_iter_row(&it);
+                const size_t row_offset = offset + it.offset;
+                const size_t row_stride = it.inner_stride;
+                for (size_t k = 0; k < row_len; k++, i++) {
+                    size_t strided_i = row_offset + k * row_stride;
+                    f32_t x = in ? in[strided_i] : out[i];
+                    out[i] = -x;
+                }
+                strided_iter_advance(&it, row_len);
             }
         }
     }
+    UNARY_RELEASE_INPUT;
 }
 
 // SIMD-optimized abs_f32
 void hodu_cpu_abs_f32(const void *input, void *output, const size_t *metadata) {
+    HODU_PROFILE_KERNEL(metadata[0] * 2 * sizeof(f32_t));
     const size_t num_els = metadata[0];
     const size_t num_dims = metadata[1];
     const f32_t *in = (const f32_t *)input;
     f32_t *out = (f32_t *)output;
     const size_t *dims = metadata + 2;
     const size_t *strides = metadata ? metadata + 2 + num_dims : NULL;
-    const size_t offset = (metadata && num_dims > 0) ? metadata[2 + 2 * num_dims] : 0;
+    size_t offset = (metadata && num_dims > 0) ? metadata[2 + 2 * num_dims] : 0;
     bool contiguous = (metadata == NULL) || is_contiguous(num_dims, dims, strides);
+    UNARY_STAGE_INPUT(f32_t, f32_t);
 
     if (contiguous && in && offset == 0) {
 #if SIMD_F32_WIDTH > 1
+        HODU_PROFILE_PATH(HODU_CPU_PATH_SIMD);
         const size_t simd_end = (num_els / SIMD_F32_WIDTH) * SIMD_F32_WIDTH;
         for (size_t i = 0; i < simd_end; i += SIMD_F32_WIDTH) {
             simd_f32_t v = simd_f32_load(&in[i]);
             simd_f32_store(&out[i], simd_f32_abs(v));
         }
-        for (size_t i = simd_end; i < num_els; i++) {
-            out[i] = fabsf(in[i]);
+        if (simd_end < num_els) {
+            const size_t rem = num_els - simd_end;
+            simd_f32_t v = simd_f32_load_partial(&in[simd_end], rem, simd_f32_set1(0.0f));
+            simd_f32_store_partial(&out[simd_end], simd_f32_abs(v), rem);
         }
 #else
         for (size_t i = 0; i < num_els; i++) {
@@ -533,13 +834,23 @@ void hodu_cpu_abs_f32(const void *input, void *output, const size_t *metadata) {
                 }
             }
         } else {
-            for (size_t i = 0; i < num_els; i++) {
-                size_t strided_i = offset + get_strided_index(i, num_dims, dims, strides);
-                f32_t x = in ? in[strided_i] : out[i];
-                out[i] = fabsf(x);
+            strided_iter_t it;
+            strided_iter_init(&it, num_dims, dims, strides, 0);
+            for (size_t i = 0; i < num_els;) {
+                // One innermost row per step: unit-stride rows vectorize
+                const size_t row_len = strided_iter_row(&it);
+                const size_t row_offset = offset + it.offset;
+                const size_t row_stride = it.inner_stride;
+                for (size_t k = 0; k < row_len; k++, i++) {
+                    size_t strided_i = row_offset + k * row_stride;
+                    f32_t x = in ? in[strided_i] : out[i];
+                    out[i] = fabsf(x);
+                }
+                strided_iter_advance(&it, row_len);
             }
         }
     }
+    UNARY_RELEASE_INPUT;
 }
 
 IMPL_UNARY_OP(f32_t, f32, sign, (x > 0.0f) ? 1.0f : ((x < 0.0f) ? -1.0f : 0.0f))
@@ -547,24 +858,29 @@ IMPL_UNARY_OP(f32_t, f32, softsign, softsign_helper_f32(x))
 
 // SIMD-optimized square_f32
 void hodu_cpu_square_f32(const void *input, void *output, const size_t *metadata) {
+    HODU_PROFILE_KERNEL(metadata[0] * 2 * sizeof(f32_t));
     const size_t num_els = metadata[0];
     const size_t num_dims = metadata[1];
     const f32_t *in = (const f32_t *)input;
     f32_t *out = (f32_t *)output;
     const size_t *dims = metadata + 2;
     const size_t *strides = metadata ? metadata + 2 + num_dims : NULL;
-    const size_t offset = (metadata && num_dims > 0) ? metadata[2 + 2 * num_dims] : 0;
+    size_t offset = (metadata && num_dims > 0) ? metadata[2 + 2 * num_dims] : 0;
     bool contiguous = (metadata == NULL) || is_contiguous(num_dims, dims, strides);
+    UNARY_STAGE_INPUT(f32_t, f32_t);
 
     if (contiguous && in && offset == 0) {
 #if SIMD_F32_WIDTH > 1
+        HODU_PROFILE_PATH(HODU_CPU_PATH_SIMD);
         const size_t simd_end = (num_els / SIMD_F32_WIDTH) * SIMD_F32_WIDTH;
         for (size_t i = 0; i < simd_end; i += SIMD_F32_WIDTH) {
             simd_f32_t v = simd_f32_load(&in[i]);
             simd_f32_store(&out[i], simd_f32_mul(v, v));
         }
-        for (size_t i = simd_end; i < num_els; i++) {
-            out[i] = in[i] * in[i];
+        if (simd_end < num_els) {
+            const size_t rem = num_els - simd_end;
+            simd_f32_t v = simd_f32_load_partial(&in[simd_end], rem, simd_f32_set1(0.0f));
+            simd_f32_store_partial(&out[simd_end], simd_f32_mul(v, v), rem);
         }
 #else
         for (size_t i = 0; i < num_els; i++) {
@@ -585,35 +901,50 @@ void hodu_cpu_square_f32(const void *input, void *output, const size_t *metadata
                 }
             }
         } else {
-            for (size_t i = 0; i < num_els; i++) {
-                size_t strided_i = offset + get_strided_index(i, num_dims, dims, strides);
-                f32_t x = in ? in[strided_i] : out[i];
-                out[i] = x * x;
+            strided_iter_t it;
+            strided_iter_init(&it, num_dims, dims, strides, 0);
+            for (size_t i = 0; i < num_els;) {
+                // One innermost row per step: unit-stride rows vectorize
+                const size_t row_len = strided_iter_row(&it);
+                const size_t row_offset = offset + it.offset;
+                const size_t row_stride = it.inner_stride;
+                for (size_t k = 0; k < row_len; k++, i++) {
+                    size_t strided_i = row_offset + k * row_stride;
+                    f32_t x = in ? in[strided_i] : out[i];
+                    out[i] = x * x;
+                }
+                strided_iter_advance(&it, row_len);
             }
         }
     }
+    UNARY_RELEASE_INPUT;
 }
 
 // SIMD-optimized sqrt_f32
 void hodu_cpu_sqrt_f32(const void *input, void *output, const size_t *metadata) {
+    HODU_PROFILE_KERNEL(metadata[0] * 2 * sizeof(f32_t));
     const size_t num_els = metadata[0];
     const size_t num_dims = metadata[1];
     const f32_t *in = (const f32_t *)input;
     f32_t *out = (f32_t *)output;
     const size_t *dims = metadata + 2;
     const size_t *strides = metadata ? metadata + 2 + num_dims : NULL;
-    const size_t offset = (metadata && num_dims > 0) ? metadata[2 + 2 * num_dims] : 0;
+    size_t offset = (metadata && num_dims > 0) ? metadata[2 + 2 * num_dims] : 0;
     bool contiguous = (metadata == NULL) || is_contiguous(num_dims, dims, strides);
+    UNARY_STAGE_INPUT(f32_t, f32_t);
 
     if (contiguous && in && offset == 0) {
 #if SIMD_F32_WIDTH > 1
+        HODU_PROFILE_PATH(HODU_CPU_PATH_SIMD);
         const size_t simd_end = (num_els / SIMD_F32_WIDTH) * SIMD_F32_WIDTH;
         for (size_t i = 0; i < simd_end; i += SIMD_F32_WIDTH) {
             simd_f32_t v = simd_f32_load(&in[i]);
             simd_f32_store(&out[i], simd_f32_sqrt(v));
         }
-        for (size_t i = simd_end; i < num_els; i++) {
-            out[i] = sqrtf(in[i]);
+        if (simd_end < num_els) {
+            const size_t rem = num_els - simd_end;
+            simd_f32_t v = simd_f32_load_partial(&in[simd_end], rem, simd_f32_set1(0.0f));
+            simd_f32_store_partial(&out[simd_end], simd_f32_sqrt(v), rem);
         }
 #else
         for (size_t i = 0; i < num_els; i++) {
@@ -633,13 +964,23 @@ void hodu_cpu_sqrt_f32(const void *input, void *output, const size_t *metadata)
                 }
             }
         } else {
-            for (size_t i = 0; i < num_els; i++) {
-                size_t strided_i = offset + get_strided_index(i, num_dims, dims, strides);
-                f32_t x = in ? in[strided_i] : out[i];
-                out[i] = sqrtf(x);
+            strided_iter_t it;
+            strided_iter_init(&it, num_dims, dims, strides, 0);
+            for (size_t i = 0; i < num_els;) {
+                // One innermost row per step: unit-stride rows vectorize
+                const size_t row_len = strided_iter_row(&it);
+                const size_t row_offset = offset + it.offset;
+                const size_t row_stride = it.inner_stride;
+                for (size_t k = 0; k < row_len; k++, i++) {
+                    size_t strided_i = row_offset + k * row_stride;
+                    f32_t x = in ? in[strided_i] : out[i];
+                    out[i] = sqrtf(x);
+                }
+                strided_iter_advance(&it, row_len);
             }
         }
     }
+    UNARY_RELEASE_INPUT;
 }
 
 IMPL_UNARY_OP(f32_t, f32, recip, 1.0f / x)
@@ -647,26 +988,30 @@ IMPL_UNARY_OP(f32_t, f32, recip, 1.0f / x)
 // Activation functions
 // SIMD-optimized relu_f32
 void hodu_cpu_relu_f32(const void *input, void *output, const size_t *metadata) {
+    HODU_PROFILE_KERNEL(metadata[0] * 2 * sizeof(f32_t));
     const size_t num_els = metadata[0];
     const size_t num_dims = metadata[1];
     const f32_t *in = (const f32_t *)input;
     f32_t *out = (f32_t *)output;
     const size_t *dims = metadata + 2;
     const size_t *strides = metadata ? metadata + 2 + num_dims : NULL;
-    const size_t offset = (metadata && num_dims > 0) ? metadata[2 + 2 * num_dims] : 0;
+    size_t offset = (metadata && num_dims > 0) ? metadata[2 + 2 * num_dims] : 0;
     bool contiguous = (metadata == NULL) || is_contiguous(num_dims, dims, strides);
+    UNARY_STAGE_INPUT(f32_t, f32_t);
 
     if (contiguous && in && offset == 0) {
 #if SIMD_F32_WIDTH > 1
+        HODU_PROFILE_PATH(HODU_CPU_PATH_SIMD);
         simd_f32_t vzero = simd_f32_set1(0.0f);
         const size_t simd_end = (num_els / SIMD_F32_WIDTH) * SIMD_F32_WIDTH;
         for (size_t i = 0; i < simd_end; i += SIMD_F32_WIDTH) {
             simd_f32_t v = simd_f32_load(&in[i]);
             simd_f32_store(&out[i], simd_f32_max(v, vzero));
         }
-        for (size_t i = simd_end; i < num_els; i++) {
-            f32_t x = in[i];
-            out[i] = (x > 0.0f) ? x : 0.0f;
+        if (simd_end < num_els) {
+            const size_t rem = num_els - simd_end;
+            simd_f32_t v = simd_f32_load_partial(&in[simd_end], rem, simd_f32_set1(0.0f));
+            simd_f32_store_partial(&out[simd_end], simd_f32_max(v, vzero), rem);
         }
 #else
         for (size_t i = 0; i < num_els; i++) {
@@ -689,23 +1034,33 @@ void hodu_cpu_relu_f32(const void *input, void *output, const size_t *metadata)
                 }
             }
         } else {
-            for (size_t i = 0; i < num_els; i++) {
-                size_t strided_i = offset + get_strided_index(i, num_dims, dims, strides);
-                f32_t x = in ? in[strided_i] : out[i];
-                out[i] = (x > 0.0f) ? x : 0.0f;
+            strided_iter_t it;
+            strided_iter_init(&it, num_dims, dims, strides, 0);
+            for (size_t i = 0; i < num_els;) {
+                // One innermost row per step: unit-stride rows vectorize
+                const size_t row_len = strided_iter_row(&it);
+                const size_t row_offset = offset + it.offset;
+                const size_t row_stride = it.inner_stride;
+                for (size_t k = 0; k < row_len; k++, i++) {
+                    size_t strided_i = row_offset + k * row_stride;
+                    f32_t x = in ? in[strided_i] : out[i];
+                    out[i] = (x > 0.0f) ? x : 0.0f;
+                }
+                strided_iter_advance(&it, row_len);
             }
         }
     }
+    UNARY_RELEASE_INPUT;
 }
-IMPL_UNARY_OP(f32_t, f32, sigmoid, 1.0f / (1.0f + expf(-x)))
+IMPL_UNARY_OP_SIMD_F32(sigmoid, 1.0f / (1.0f + expf(-x)), simd_f32_sigmoid(v))
 IMPL_UNARY_OP(f32_t, f32, hardsigmoid, hardsigmoid_helper_f32(x))
-IMPL_UNARY_OP(f32_t, f32, gelu, gelu_helper_f32(x))
-IMPL_UNARY_OP(f32_t, f32, softplus, softplus_helper_f32(x))
-IMPL_UNARY_OP(f32_t, f32, silu, silu_helper_f32(x))
+IMPL_UNARY_OP_SIMD_F32(gelu, gelu_helper_f32(x), simd_f32_gelu(v))
+IMPL_UNARY_OP_SIMD_F32(softplus, softplus_helper_f32(x), softplus_simd_f32(v))
+IMPL_UNARY_OP_SIMD_F32(silu, silu_helper_f32(x), simd_f32_silu(v))
 IMPL_UNARY_OP(f32_t, f32, hardsilu, hardsilu_helper_f32(x))
-IMPL_UNARY_OP(f32_t, f32, mish, mish_helper_f32(x))
-IMPL_UNARY_OP(f32_t, f32, selu, selu_helper_f32(x))
-IMPL_UNARY_OP(f32_t, f32, celu, celu_helper_f32(x))
+IMPL_UNARY_OP_SIMD_F32(mish, mish_helper_f32(x), mish_simd_f32(v))
+IMPL_UNARY_OP_SIMD_F32(selu, selu_helper_f32(x), selu_simd_f32(v))
+IMPL_UNARY_OP_SIMD_F32(celu, celu_helper_f32(x), celu_simd_f32(v))
 
 // Trigonometric functions
 IMPL_UNARY_OP(f32_t, f32, sin, sinf(x))
@@ -718,22 +1073,22 @@ IMPL_UNARY_OP(f32_t, f32, atan, atanf(x))
 // Hyperbolic functions
 IMPL_UNARY_OP(f32_t, f32, sinh, sinhf(x))
 IMPL_UNARY_OP(f32_t, f32, cosh, coshf(x))
-IMPL_UNARY_OP(f32_t, f32, tanh, tanhf(x))
+IMPL_UNARY_OP_SIMD_F32(tanh, tanhf(x), simd_f32_tanh(v))
 IMPL_UNARY_OP(f32_t, f32, asinh, asinhf(x))
 IMPL_UNARY_OP(f32_t, f32, acosh, acoshf(x))
 IMPL_UNARY_OP(f32_t, f32, atanh, atanhf(x))
 
 // Exponential and logarithmic functions
-IMPL_UNARY_OP(f32_t, f32, exp, expf(x))
-IMPL_UNARY_OP(f32_t, f32, exp2, exp2f(x))
+IMPL_UNARY_OP_SIMD_F32(exp, expf(x), simd_f32_exp(v))
+IMPL_UNARY_OP_SIMD_F32(exp2, exp2f(x), simd_f32_exp2(v))
 IMPL_UNARY_OP(f32_t, f32, exp10, exp10f_opt(x))
-IMPL_UNARY_OP(f32_t, f32, ln, logf(x))
-IMPL_UNARY_OP(f32_t, f32, log2, log2f(x))
-IMPL_UNARY_OP(f32_t, f32, log10, log10f(x))
+IMPL_UNARY_OP_SIMD_F32(ln, logf(x), simd_f32_log(v))
+IMPL_UNARY_OP_SIMD_F32(log2, log2f(x), simd_f32_log2(v))
+IMPL_UNARY_OP_SIMD_F32(log10, log10f(x), simd_f32_log10(v))
 IMPL_UNARY_OP(f32_t, f32, ceil, ceilf(x))
 IMPL_UNARY_OP(f32_t, f32, floor, floorf(x))
 IMPL_UNARY_OP(f32_t, f32, round, roundf(x))
-IMPL_UNARY_OP(f32_t, f32, erf, erff(x))
+IMPL_UNARY_OP_SIMD_F32(erf, erff(x), simd_f32_erf(v))
 
 // Logical operations
 IMPL_UNARY_TO_BOOL(f32_t, f32, logical_not, x == 0.0f)
@@ -758,9 +1113,10 @@ void hodu_cpu_mul_scalar_f32_fallback(const void *input, void *output, const siz
 
     const size_t *dims = metadata + 2;
     const size_t *strides = metadata ? metadata + 2 + num_dims : NULL;
-    const size_t offset = (metadata && num_dims > 0) ? metadata[2 + 2 * num_dims] : 0;
+    size_t offset = (metadata && num_dims > 0) ? metadata[2 + 2 * num_dims] : 0;
 
     bool contiguous = (metadata == NULL) || is_contiguous(num_dims, dims, strides);
+    UNARY_STAGE_INPUT(f32_t, f32_t);
 
     if (contiguous) {
         if (in) {
@@ -775,18 +1131,29 @@ void hodu_cpu_mul_scalar_f32_fallback(const void *input, void *output, const siz
             }
         }
     } else {
-        for (size_t i = 0; i < num_els; i++) {
-            size_t strided_i = offset + get_strided_index(i, num_dims, dims, strides);
-            f32_t x = in ? in[strided_i] : out[i];
-            out[i] = x * const_val;
+        strided_iter_t it;
+        strided_iter_init(&it, num_dims, dims, strides, 0);
+        for (size_t i = 0; i < num_els;) {
+            // One innermost row per step: unit-stride rows vectorize
+            const size_t row_len = strided_iter_row(&it);
+            const size_t row_offset = offset + it.offset;
+            const size_t row_stride = it.inner_stride;
+            for (size_t k = 0; k < row_len; k++, i++) {
+                size_t strided_i = row_offset + k * row_stride;
+                f32_t x = in ? in[strided_i] : out[i];
+                out[i] = x * const_val;
+            }
+            strided_iter_advance(&it, row_len);
         }
     }
+    UNARY_RELEASE_INPUT;
 }
 
 #ifndef USE_BLAS
 // Non-BLAS version just calls fallback
 void hodu_cpu_mul_scalar_f32(const void *input, void *output, const size_t *metadata,
                              const void *scalar) {
+    HODU_PROFILE_KERNEL(metadata[0] * 2 * sizeof(f32_t));
     hodu_cpu_mul_scalar_f32_fallback(input, output, metadata, scalar);
 }
 #endif
@@ -811,24 +1178,29 @@ IMPL_UNARY_CMP_SCALAR_TO_BOOL(f32_t, f32, ge_scalar, x >= const_val)
 
 // neg_f64: SIMD-optimized version
 void hodu_cpu_neg_f64(const void *input, void *output, const size_t *metadata) {
+    HODU_PROFILE_KERNEL(metadata[0] * 2 * sizeof(f64_t));
     const size_t num_els = metadata[0];
     const size_t num_dims = metadata[1];
     const f64_t *in = (const f64_t *)input;
     f64_t *out = (f64_t *)output;
     const size_t *dims = metadata + 2;
     const size_t *strides = metadata ? metadata + 2 + num_dims : NULL;
-    const size_t offset = (metadata && num_dims > 0) ? metadata[2 + 2 * num_dims] : 0;
+    size_t offset = (metadata && num_dims > 0) ? metadata[2 + 2 * num_dims] : 0;
     bool contiguous = (metadata == NULL) || is_contiguous(num_dims, dims, strides);
+    UNARY_STAGE_INPUT(f64_t, f64_t);
 
     if (contiguous && in && offset == 0) {
 #if SIMD_F64_WIDTH > 1
+        HODU_PROFILE_PATH(HODU_CPU_PATH_SIMD);
         const size_t simd_end = (num_els / SIMD_F64_WIDTH) * SIMD_F64_WIDTH;
         for (size_t i = 0; i < simd_end; i += SIMD_F64_WIDTH) {
             simd_f64_t v = simd_f64_load(&in[i]);
             simd_f64_store(&out[i], simd_f64_neg(v));
         }
-        for (size_t i = simd_end; i < num_els; i++) {
-            out[i] = -in[i];
+        if (simd_end < num_els) {
+            const size_t rem = num_els - simd_end;
+            simd_f64_t v = simd_f64_load_partial(&in[simd_end], rem, simd_f64_set1(0.0));
+            simd_f64_store_partial(&out[simd_end], simd_f64_neg(v), rem);
         }
 #else
         for (size_t i = 0; i < num_els; i++) {
@@ -850,35 +1222,50 @@ void hodu_cpu_neg_f64(const void *input, void *output, const size_t *metadata) {
                 }
             }
         } else {
-            for (size_t i = 0; i < num_els; i++) {
-                size_t strided_i = offset + get_strided_index(i, num_dims, dims, strides);
-                f64_t x = in ? in[strided_i] : out[i];
-                out[i] = -x;
+            strided_iter_t it;
+            strided_iter_init(&it, num_dims, dims, strides, 0);
+            for (size_t i = 0; i < num_els;) {
+                // One innermost row per step: unit-stride rows vectorize
+                const size_t row_len = strided_iter_row(&it);
+                const size_t row_offset = offset + it.offset;
+                const size_t row_stride = it.inner_stride;
+                for (size_t k = 0; k < row_len; k++, i++) {
+                    size_t strided_i = row_offset + k * row_stride;
+                    f64_t x = in ? in[strided_i] : out[i];
+                    out[i] = -x;
+                }
+                strided_iter_advance(&it, row_len);
             }
         }
     }
+    UNARY_RELEASE_INPUT;
 }
 
 // abs_f64: SIMD-optimized version
 void hodu_cpu_abs_f64(const void *input, void *output, const size_t *metadata) {
+    HODU_PROFILE_KERNEL(metadata[0] * 2 * sizeof(f64_t));
     const size_t num_els = metadata[0];
     const size_t num_dims = metadata[1];
     const f64_t *in = (const f64_t *)input;
     f64_t *out = (f64_t *)output;
     const size_t *dims = metadata + 2;
     const size_t *strides = metadata ? metadata + 2 + num_dims : NULL;
-    const size_t offset = (metadata && num_dims > 0) ? metadata[2 + 2 * num_dims] : 0;
+    size_t offset = (metadata && num_dims > 0) ? metadata[2 + 2 * num_dims] : 0;
     bool contiguous = (metadata == NULL) || is_contiguous(num_dims, dims, strides);
+    UNARY_STAGE_INPUT(f64_t, f64_t);
 
     if (contiguous && in && offset == 0) {
 #if SIMD_F64_WIDTH > 1
+        HODU_PROFILE_PATH(HODU_CPU_PATH_SIMD);
         const size_t simd_end = (num_els / SIMD_F64_WIDTH) * SIMD_F64_WIDTH;
         for (size_t i = 0; i < simd_end; i += SIMD_F64_WIDTH) {
             simd_f64_t v = simd_f64_load(&in[i]);
             simd_f64_store(&out[i], simd_f64_abs(v));
         }
-        for (size_t i = simd_end; i < num_els; i++) {
-            out[i] = fabs(in[i]);
+        if (simd_end < num_els) {
+            const size_t rem = num_els - simd_end;
+            simd_f64_t v = simd_f64_load_partial(&in[simd_end], rem, simd_f64_set1(0.0));
+            simd_f64_store_partial(&out[simd_end], simd_f64_abs(v), rem);
         }
 #else
         for (size_t i = 0; i < num_els; i++) {
@@ -900,13 +1287,23 @@ void hodu_cpu_abs_f64(const void *input, void *output, const size_t *metadata) {
                 }
             }
         } else {
-            for (size_t i = 0; i < num_els; i++) {
-                size_t strided_i = offset + get_strided_index(i, num_dims, dims, strides);
-                f64_t x = in ? in[strided_i] : out[i];
-                out[i] = fabs(x);
+            strided_iter_t it;
+            strided_iter_init(&it, num_dims, dims, strides, 0);
+            for (size_t i = 0; i < num_els;) {
+                // One innermost row per step: unit-stride rows vectorize
+                const size_t row_len = strided_iter_row(&it);
+                const size_t row_offset = offset + it.offset;
+                const size_t row_stride = it.inner_stride;
+                for (size_t k = 0; k < row_len; k++, i++) {
+                    size_t strided_i = row_offset + k * row_stride;
+                    f64_t x = in ? in[strided_i] : out[i];
+                    out[i] = fabs(x);
+                }
+                strided_iter_advance(&it, row_len);
             }
         }
     }
+    UNARY_RELEASE_INPUT;
 }
 
 IMPL_UNARY_OP(f64_t, f64, sign, (x > 0.0) ? 1.0 : ((x < 0.0) ? -1.0 : 0.0))
@@ -914,25 +1311,29 @@ IMPL_UNARY_OP(f64_t, f64, softsign, softsign_helper_f64(x))
 
 // square_f64: SIMD-optimized version
 void hodu_cpu_square_f64(const void *input, void *output, const size_t *metadata) {
+    HODU_PROFILE_KERNEL(metadata[0] * 2 * sizeof(f64_t));
     const size_t num_els = metadata[0];
     const size_t num_dims = metadata[1];
     const f64_t *in = (const f64_t *)input;
     f64_t *out = (f64_t *)output;
     const size_t *dims = metadata + 2;
     const size_t *strides = metadata ? metadata + 2 + num_dims : NULL;
-    const size_t offset = (metadata && num_dims > 0) ? metadata[2 + 2 * num_dims] : 0;
+    size_t offset = (metadata && num_dims > 0) ? metadata[2 + 2 * num_dims] : 0;
     bool contiguous = (metadata == NULL) || is_contiguous(num_dims, dims, strides);
+    UNARY_STAGE_INPUT(f64_t, f64_t);
 
     if (contiguous && in && offset == 0) {
 #if SIMD_F64_WIDTH > 1
+        HODU_PROFILE_PATH(HODU_CPU_PATH_SIMD);
         const size_t simd_end = (num_els / SIMD_F64_WIDTH) * SIMD_F64_WIDTH;
         for (size_t i = 0; i < simd_end; i += SIMD_F64_WIDTH) {
             simd_f64_t v = simd_f64_load(&in[i]);
             simd_f64_store(&out[i], simd_f64_mul(v, v));
         }
-        for (size_t i = simd_end; i < num_els; i++) {
-            f64_t x = in[i];
-            out[i] = x * x;
+        if (simd_end < num_els) {
+            const size_t rem = num_els - simd_end;
+            simd_f64_t v = simd_f64_load_partial(&in[simd_end], rem, simd_f64_set1(0.0));
+            simd_f64_store_partial(&out[simd_end], simd_f64_mul(v, v), rem);
         }
 #else
         for (size_t i = 0; i < num_els; i++) {
@@ -955,35 +1356,50 @@ void hodu_cpu_square_f64(const void *input, void *output, const size_t *metadata
                 }
             }
         } else {
-            for (size_t i = 0; i < num_els; i++) {
-                size_t strided_i = offset + get_strided_index(i, num_dims, dims, strides);
-                f64_t x = in ? in[strided_i] : out[i];
-                out[i] = x * x;
+            strided_iter_t it;
+            strided_iter_init(&it, num_dims, dims, strides, 0);
+            for (size_t i = 0; i < num_els;) {
+                // One innermost row per step: unit-stride rows vectorize
+                const size_t row_len = strided_iter_row(&it);
+                const size_t row_offset = offset + it.offset;
+                const size_t row_stride = it.inner_stride;
+                for (size_t k = 0; k < row_len; k++, i++) {
+                    size_t strided_i = row_offset + k * row_stride;
+                    f64_t x = in ? in[strided_i] : out[i];
+                    out[i] = x * x;
+                }
+                strided_iter_advance(&it, row_len);
             }
         }
     }
+    UNARY_RELEASE_INPUT;
 }
 
 // sqrt_f64: SIMD-optimized version
 void hodu_cpu_sqrt_f64(const void *input, void *output, const size_t *metadata) {
+    HODU_PROFILE_KERNEL(metadata[0] * 2 * sizeof(f64_t));
     const size_t num_els = metadata[0];
     const size_t num_dims = metadata[1];
     const f64_t *in = (const f64_t *)input;
     f64_t *out = (f64_t *)output;
     const size_t *dims = metadata + 2;
     const size_t *strides = metadata ? metadata + 2 + num_dims : NULL;
-    const size_t offset = (metadata && num_dims > 0) ? metadata[2 + 2 * num_dims] : 0;
+    size_t offset = (metadata && num_dims > 0) ? metadata[2 + 2 * num_dims] : 0;
     bool contiguous = (metadata == NULL) || is_contiguous(num_dims, dims, strides);
+    UNARY_STAGE_INPUT(f64_t, f64_t);
 
     if (contiguous && in && offset == 0) {
 #if SIMD_F64_WIDTH > 1
+        HODU_PROFILE_PATH(HODU_CPU_PATH_SIMD);
         const size_t simd_end = (num_els / SIMD_F64_WIDTH) * SIMD_F64_WIDTH;
         for (size_t i = 0; i < simd_end; i += SIMD_F64_WIDTH) {
             simd_f64_t v = simd_f64_load(&in[i]);
             simd_f64_store(&out[i], simd_f64_sqrt(v));
         }
-        for (size_t i = simd_end; i < num_els; i++) {
-            out[i] = sqrt(in[i]);
+        if (simd_end < num_els) {
+            const size_t rem = num_els - simd_end;
+            simd_f64_t v = simd_f64_load_partial(&in[simd_end], rem, simd_f64_set1(0.0));
+            simd_f64_store_partial(&out[simd_end], simd_f64_sqrt(v), rem);
         }
 #else
         for (size_t i = 0; i < num_els; i++) {
@@ -1005,39 +1421,53 @@ void hodu_cpu_sqrt_f64(const void *input, void *output, const size_t *metadata)
                 }
             }
         } else {
-            for (size_t i = 0; i < num_els; i++) {
-                size_t strided_i = offset + get_strided_index(i, num_dims, dims, strides);
-                f64_t x = in ? in[strided_i] : out[i];
-                out[i] = sqrt(x);
+            strided_iter_t it;
+            strided_iter_init(&it, num_dims, dims, strides, 0);
+            for (size_t i = 0; i < num_els;) {
+                // One innermost row per step: unit-stride rows vectorize
+                const size_t row_len = strided_iter_row(&it);
+                const size_t row_offset = offset + it.offset;
+                const size_t row_stride = it.inner_stride;
+                for (size_t k = 0; k < row_len; k++, i++) {
+                    size_t strided_i = row_offset + k * row_stride;
+                    f64_t x = in ? in[strided_i] : out[i];
+                    out[i] = sqrt(x);
+                }
+                strided_iter_advance(&it, row_len);
             }
         }
     }
+    UNARY_RELEASE_INPUT;
 }
 
 IMPL_UNARY_OP(f64_t, f64, recip, 1.0 / x)
 
 // relu_f64: SIMD-optimized version
 void hodu_cpu_relu_f64(const void *input, void *output, const size_t *metadata) {
+    HODU_PROFILE_KERNEL(metadata[0] * 2 * sizeof(f64_t));
     const size_t num_els = metadata[0];
     const size_t num_dims = metadata[1];
     const f64_t *in = (const f64_t *)input;
     f64_t *out = (f64_t *)output;
     const size_t *dims = metadata + 2;
     const size_t *strides = metadata ? metadata + 2 + num_dims : NULL;
-    const size_t offset = (metadata && num_dims > 0) ? metadata[2 + 2 * num_dims] : 0;
+    size_t offset = (metadata && num_dims > 0) ? metadata[2 + 2 * num_dims] : 0;
     bool contiguous = (metadata == NULL) || is_contiguous(num_dims, dims, strides);
+    UNARY_STAGE_INPUT(f64_t, f64_t);
 
     if (contiguous && in && offset == 0) {
 #if SIMD_F64_WIDTH > 1
+        HODU_PROFILE_PATH(HODU_CPU_PATH_SIMD);
         simd_f64_t vzero = simd_f64_set1(0.0);
         const size_t simd_end = (num_els / SIMD_F64_WIDTH) * SIMD_F64_WIDTH;
         for (size_t i = 0; i < simd_end; i += SIMD_F64_WIDTH) {
             simd_f64_t v = simd_f64_load(&in[i]);
             simd_f64_store(&out[i], simd_f64_max(v, vzero));
         }
-        for (size_t i = simd_end; i < num_els; i++) {
-            f64_t x = in[i];
-            out[i] = (x > 0.0) ? x : 0.0;
+        if (simd_end < num_els) {
+            const size_t rem = num_els - simd_end;
+            simd_f64_t v = simd_f64_load_partial(&in[simd_end], rem, simd_f64_set1(0.0));
+            simd_f64_store_partial(&out[simd_end], simd_f64_max(v, vzero), rem);
         }
 #else
         for (size_t i = 0; i < num_els; i++) {
@@ -1060,13 +1490,23 @@ void hodu_cpu_relu_f64(const void *input, void *output, const size_t *metadata)
                 }
             }
         } else {
-            for (size_t i = 0; i < num_els; i++) {
-                size_t strided_i = offset + get_strided_index(i, num_dims, dims, strides);
-                f64_t x = in ? in[strided_i] : out[i];
-                out[i] = (x > 0.0) ? x : 0.0;
+            strided_iter_t it;
+            strided_iter_init(&it, num_dims, dims, strides, 0);
+            for (size_t i = 0; i < num_els;) {
+                // One innermost row per step: unit-stride rows vectorize
+                const size_t row_len = strided_iter_row(&it);
+                const size_t row_offset = offset + it.offset;
+                const size_t row_stride = it.inner_stride;
+                for (size_t k = 0; k < row_len; k++, i++) {
+                    size_t strided_i = row_offset + k * row_stride;
+                    f64_t x = in ? in[strided_i] : out[i];
+                    out[i] = (x > 0.0) ? x : 0.0;
+                }
+                strided_iter_advance(&it, row_len);
             }
         }
     }
+    UNARY_RELEASE_INPUT;
 }
 IMPL_UNARY_OP(f64_t, f64, sigmoid, 1.0 / (1.0 + exp(-x)))
 IMPL_UNARY_OP(f64_t, f64, hardsigmoid, hardsigmoid_helper_f64(x))
@@ -1124,9 +1564,10 @@ void hodu_cpu_mul_scalar_f64_fallback(const void *input, void *output, const siz
 
     const size_t *dims = metadata + 2;
     const size_t *strides = metadata ? metadata + 2 + num_dims : NULL;
-    const size_t offset = (metadata && num_dims > 0) ? metadata[2 + 2 * num_dims] : 0;
+    size_t offset = (metadata && num_dims > 0) ? metadata[2 + 2 * num_dims] : 0;
 
     bool contiguous = (metadata == NULL) || is_contiguous(num_dims, dims, strides);
+    UNARY_STAGE_INPUT(f64_t, f64_t);
 
     if (contiguous) {
         if (in) {
@@ -1141,18 +1582,29 @@ void hodu_cpu_mul_scalar_f64_fallback(const void *input, void *output, const siz
             }
         }
     } else {
-        for (size_t i = 0; i < num_els; i++) {
-            size_t strided_i = offset + get_strided_index(i, num_dims, dims, strides);
-            f64_t x = in ? in[strided_i] : out[i];
-            out[i] = x * const_val;
+        strided_iter_t it;
+        strided_iter_init(&it, num_dims, dims, strides, 0);
+        for (size_t i = 0; i < num_els;) {
+            // One innermost row per step: unit-stride rows vectorize
+            const size_t row_len = strided_iter_row(&it);
+            const size_t row_offset = offset + it.offset;
+            const size_t row_stride = it.inner_stride;
+            for (size_t k = 0; k < row_len; k++, i++) {
+                size_t strided_i = row_offset + k * row_stride;
+                f64_t x = in ? in[strided_i] : out[i];
+                out[i] = x * const_val;
+            }
+            strided_iter_advance(&it, row_len);
         }
     }
+    UNARY_RELEASE_INPUT;
 }
 
 #ifndef USE_BLAS
 // Non-BLAS version just calls fallback
 void hodu_cpu_mul_scalar_f64(const void *input, void *output, const size_t *metadata,
                              const void *scalar) {
+    HODU_PROFILE_KERNEL(metadata[0] * 2 * sizeof(f64_t));
     hodu_cpu_mul_scalar_f64_fallback(input, output, metadata, scalar);
 }
 #endif
@@ -1232,19 +1684,24 @@ IMPL_UNARY_OP_CONVERT(f8e4m3_t, f8e4m3, recip, 1.0f / x, f8e4m3_to_float, float_
 
 IMPL_UNARY_OP_CONVERT(f8e4m3_t, f8e4m3, relu, (x > 0.0f) ? x : 0.0f, f8e4m3_to_float,
                       float_to_f8e4m3)
-IMPL_UNARY_OP_CONVERT(f8e4m3_t, f8e4m3, sigmoid, 1.0f / (1.0f + expf(-x)), f8e4m3_to_float,
-                      float_to_f8e4m3)
+IMPL_UNARY_OP_CONVERT_SIMD(f8e4m3_t, f8e4m3, sigmoid, 1.0f / (1.0f + expf(-x)), simd_f32_sigmoid(v),
+                           f8e4m3_to_float, float_to_f8e4m3)
 IMPL_UNARY_OP_CONVERT(f8e4m3_t, f8e4m3, hardsigmoid, hardsigmoid_helper_f32(x), f8e4m3_to_float,
                       float_to_f8e4m3)
-IMPL_UNARY_OP_CONVERT(f8e4m3_t, f8e4m3, gelu, gelu_helper_f32(x), f8e4m3_to_float, float_to_f8e4m3)
-IMPL_UNARY_OP_CONVERT(f8e4m3_t, f8e4m3, softplus, softplus_helper_f32(x), f8e4m3_to_float,
-                      float_to_f8e4m3)
-IMPL_UNARY_OP_CONVERT(f8e4m3_t, f8e4m3, silu, silu_helper_f32(x), f8e4m3_to_float, float_to_f8e4m3)
+IMPL_UNARY_OP_CONVERT_SIMD(f8e4m3_t, f8e4m3, gelu, gelu_helper_f32(x), simd_f32_gelu(v),
+                           f8e4m3_to_float, float_to_f8e4m3)
+IMPL_UNARY_OP_CONVERT_SIMD(f8e4m3_t, f8e4m3, softplus, softplus_helper_f32(x), softplus_simd_f32(v),
+                           f8e4m3_to_float, float_to_f8e4m3)
+IMPL_UNARY_OP_CONVERT_SIMD(f8e4m3_t, f8e4m3, silu, silu_helper_f32(x), simd_f32_silu(v),
+                           f8e4m3_to_float, float_to_f8e4m3)
 IMPL_UNARY_OP_CONVERT(f8e4m3_t, f8e4m3, hardsilu, hardsilu_helper_f32(x), f8e4m3_to_float,
                       float_to_f8e4m3)
-IMPL_UNARY_OP_CONVERT(f8e4m3_t, f8e4m3, mish, mish_helper_f32(x), f8e4m3_to_float, float_to_f8e4m3)
-IMPL_UNARY_OP_CONVERT(f8e4m3_t, f8e4m3, selu, selu_helper_f32(x), f8e4m3_to_float, float_to_f8e4m3)
-IMPL_UNARY_OP_CONVERT(f8e4m3_t, f8e4m3, celu, celu_helper_f32(x), f8e4m3_to_float, float_to_f8e4m3)
+IMPL_UNARY_OP_CONVERT_SIMD(f8e4m3_t, f8e4m3, mish, mish_helper_f32(x), mish_simd_f32(v),
+                           f8e4m3_to_float, float_to_f8e4m3)
+IMPL_UNARY_OP_CONVERT_SIMD(f8e4m3_t, f8e4m3, selu, selu_helper_f32(x), selu_simd_f32(v),
+                           f8e4m3_to_float, float_to_f8e4m3)
+IMPL_UNARY_OP_CONVERT_SIMD(f8e4m3_t, f8e4m3, celu, celu_helper_f32(x), celu_simd_f32(v),
+                           f8e4m3_to_float, float_to_f8e4m3)
 
 IMPL_UNARY_OP_CONVERT(f8e4m3_t, f8e4m3, sin, sinf(x), f8e4m3_to_float, float_to_f8e4m3)
 IMPL_UNARY_OP_CONVERT(f8e4m3_t, f8e4m3, cos, cosf(x), f8e4m3_to_float, float_to_f8e4m3)
@@ -1255,21 +1712,28 @@ IMPL_UNARY_OP_CONVERT(f8e4m3_t, f8e4m3, atan, atanf(x), f8e4m3_to_float, float_t
 
 IMPL_UNARY_OP_CONVERT(f8e4m3_t, f8e4m3, sinh, sinhf(x), f8e4m3_to_float, float_to_f8e4m3)
 IMPL_UNARY_OP_CONVERT(f8e4m3_t, f8e4m3, cosh, coshf(x), f8e4m3_to_float, float_to_f8e4m3)
-IMPL_UNARY_OP_CONVERT(f8e4m3_t, f8e4m3, tanh, tanhf(x), f8e4m3_to_float, float_to_f8e4m3)
+IMPL_UNARY_OP_CONVERT_SIMD(f8e4m3_t, f8e4m3, tanh, tanhf(x), simd_f32_tanh(v), f8e4m3_to_float,
+                           float_to_f8e4m3)
 IMPL_UNARY_OP_CONVERT(f8e4m3_t, f8e4m3, asinh, asinhf(x), f8e4m3_to_float, float_to_f8e4m3)
 IMPL_UNARY_OP_CONVERT(f8e4m3_t, f8e4m3, acosh, acoshf(x), f8e4m3_to_float, float_to_f8e4m3)
 IMPL_UNARY_OP_CONVERT(f8e4m3_t, f8e4m3, atanh, atanhf(x), f8e4m3_to_float, float_to_f8e4m3)
 
-IMPL_UNARY_OP_CONVERT(f8e4m3_t, f8e4m3, exp, expf(x), f8e4m3_to_float, float_to_f8e4m3)
-IMPL_UNARY_OP_CONVERT(f8e4m3_t, f8e4m3, exp2, exp2f(x), f8e4m3_to_float, float_to_f8e4m3)
+IMPL_UNARY_OP_CONVERT_SIMD(f8e4m3_t, f8e4m3, exp, expf(x), simd_f32_exp(v), f8e4m3_to_float,
+                           float_to_f8e4m3)
+IMPL_UNARY_OP_CONVERT_SIMD(f8e4m3_t, f8e4m3, exp2, exp2f(x), simd_f32_exp2(v), f8e4m3_to_float,
+                           float_to_f8e4m3)
 IMPL_UNARY_OP_CONVERT(f8e4m3_t, f8e4m3, exp10, exp10f(x), f8e4m3_to_float, float_to_f8e4m3)
-IMPL_UNARY_OP_CONVERT(f8e4m3_t, f8e4m3, ln, logf(x), f8e4m3_to_float, float_to_f8e4m3)
-IMPL_UNARY_OP_CONVERT(f8e4m3_t, f8e4m3, log2, log2f(x), f8e4m3_to_float, float_to_f8e4m3)
-IMPL_UNARY_OP_CONVERT(f8e4m3_t, f8e4m3, log10, log10f(x), f8e4m3_to_float, float_to_f8e4m3)
+IMPL_UNARY_OP_CONVERT_SIMD(f8e4m3_t, f8e4m3, ln, logf(x), simd_f32_log(v), f8e4m3_to_float,
+                           float_to_f8e4m3)
+IMPL_UNARY_OP_CONVERT_SIMD(f8e4m3_t, f8e4m3, log2, log2f(x), simd_f32_log2(v), f8e4m3_to_float,
+                           float_to_f8e4m3)
+IMPL_UNARY_OP_CONVERT_SIMD(f8e4m3_t, f8e4m3, log10, log10f(x), simd_f32_log10(v), f8e4m3_to_float,
+                           float_to_f8e4m3)
 IMPL_UNARY_OP_CONVERT(f8e4m3_t, f8e4m3, ceil, ceilf(x), f8e4m3_to_float, float_to_f8e4m3)
 IMPL_UNARY_OP_CONVERT(f8e4m3_t, f8e4m3, floor, floorf(x), f8e4m3_to_float, float_to_f8e4m3)
 IMPL_UNARY_OP_CONVERT(f8e4m3_t, f8e4m3, round, roundf(x), f8e4m3_to_float, float_to_f8e4m3)
-IMPL_UNARY_OP_CONVERT(f8e4m3_t, f8e4m3, erf, erff(x), f8e4m3_to_float, float_to_f8e4m3)
+IMPL_UNARY_OP_CONVERT_SIMD(f8e4m3_t, f8e4m3, erf, erff(x), simd_f32_erf(v), f8e4m3_to_float,
+                           float_to_f8e4m3)
 
 IMPL_UNARY_TO_BOOL_CONVERT(f8e4m3_t, f8e4m3, logical_not, x == 0.0f, f8e4m3_to_float)
 
@@ -1318,19 +1782,24 @@ IMPL_UNARY_OP_CONVERT(f8e5m2_t, f8e5m2, recip, 1.0f / x, f8e5m2_to_float, float_
 
 IMPL_UNARY_OP_CONVERT(f8e5m2_t, f8e5m2, relu, (x > 0.0f) ? x : 0.0f, f8e5m2_to_float,
                       float_to_f8e5m2)
-IMPL_UNARY_OP_CONVERT(f8e5m2_t, f8e5m2, sigmoid, 1.0f / (1.0f + expf(-x)), f8e5m2_to_float,
-                      float_to_f8e5m2)
+IMPL_UNARY_OP_CONVERT_SIMD(f8e5m2_t, f8e5m2, sigmoid, 1.0f / (1.0f + expf(-x)), simd_f32_sigmoid(v),
+                           f8e5m2_to_float, float_to_f8e5m2)
 IMPL_UNARY_OP_CONVERT(f8e5m2_t, f8e5m2, hardsigmoid, hardsigmoid_helper_f32(x), f8e5m2_to_float,
                       float_to_f8e5m2)
-IMPL_UNARY_OP_CONVERT(f8e5m2_t, f8e5m2, gelu, gelu_helper_f32(x), f8e5m2_to_float, float_to_f8e5m2)
-IMPL_UNARY_OP_CONVERT(f8e5m2_t, f8e5m2, softplus, softplus_helper_f32(x), f8e5m2_to_float,
-                      float_to_f8e5m2)
-IMPL_UNARY_OP_CONVERT(f8e5m2_t, f8e5m2, silu, silu_helper_f32(x), f8e5m2_to_float, float_to_f8e5m2)
+IMPL_UNARY_OP_CONVERT_SIMD(f8e5m2_t, f8e5m2, gelu, gelu_helper_f32(x), simd_f32_gelu(v),
+                           f8e5m2_to_float, float_to_f8e5m2)
+IMPL_UNARY_OP_CONVERT_SIMD(f8e5m2_t, f8e5m2, softplus, softplus_helper_f32(x), softplus_simd_f32(v),
+                           f8e5m2_to_float, float_to_f8e5m2)
+IMPL_UNARY_OP_CONVERT_SIMD(f8e5m2_t, f8e5m2, silu, silu_helper_f32(x), simd_f32_silu(v),
+                           f8e5m2_to_float, float_to_f8e5m2)
 IMPL_UNARY_OP_CONVERT(f8e5m2_t, f8e5m2, hardsilu, hardsilu_helper_f32(x), f8e5m2_to_float,
                       float_to_f8e5m2)
-IMPL_UNARY_OP_CONVERT(f8e5m2_t, f8e5m2, mish, mish_helper_f32(x), f8e5m2_to_float, float_to_f8e5m2)
-IMPL_UNARY_OP_CONVERT(f8e5m2_t, f8e5m2, selu, selu_helper_f32(x), f8e5m2_to_float, float_to_f8e5m2)
-IMPL_UNARY_OP_CONVERT(f8e5m2_t, f8e5m2, celu, celu_helper_f32(x), f8e5m2_to_float, float_to_f8e5m2)
+IMPL_UNARY_OP_CONVERT_SIMD(f8e5m2_t, f8e5m2, mish, mish_helper_f32(x), mish_simd_f32(v),
+                           f8e5m2_to_float, float_to_f8e5m2)
+IMPL_UNARY_OP_CONVERT_SIMD(f8e5m2_t, f8e5m2, selu, selu_helper_f32(x), selu_simd_f32(v),
+                           f8e5m2_to_float, float_to_f8e5m2)
+IMPL_UNARY_OP_CONVERT_SIMD(f8e5m2_t, f8e5m2, celu, celu_helper_f32(x), celu_simd_f32(v),
+                           f8e5m2_to_float, float_to_f8e5m2)
 
 IMPL_UNARY_OP_CONVERT(f8e5m2_t, f8e5m2, sin, sinf(x), f8e5m2_to_float, float_to_f8e5m2)
 IMPL_UNARY_OP_CONVERT(f8e5m2_t, f8e5m2, cos, cosf(x), f8e5m2_to_float, float_to_f8e5m2)
@@ -1341,21 +1810,28 @@ IMPL_UNARY_OP_CONVERT(f8e5m2_t, f8e5m2, atan, atanf(x), f8e5m2_to_float, float_t
 
 IMPL_UNARY_OP_CONVERT(f8e5m2_t, f8e5m2, sinh, sinhf(x), f8e5m2_to_float, float_to_f8e5m2)
 IMPL_UNARY_OP_CONVERT(f8e5m2_t, f8e5m2, cosh, coshf(x), f8e5m2_to_float, float_to_f8e5m2)
-IMPL_UNARY_OP_CONVERT(f8e5m2_t, f8e5m2, tanh, tanhf(x), f8e5m2_to_float, float_to_f8e5m2)
+IMPL_UNARY_OP_CONVERT_SIMD(f8e5m2_t, f8e5m2, tanh, tanhf(x), simd_f32_tanh(v), f8e5m2_to_float,
+                           float_to_f8e5m2)
 IMPL_UNARY_OP_CONVERT(f8e5m2_t, f8e5m2, asinh, asinhf(x), f8e5m2_to_float, float_to_f8e5m2)
 IMPL_UNARY_OP_CONVERT(f8e5m2_t, f8e5m2, acosh, acoshf(x), f8e5m2_to_float, float_to_f8e5m2)
 IMPL_UNARY_OP_CONVERT(f8e5m2_t, f8e5m2, atanh, atanhf(x), f8e5m2_to_float, float_to_f8e5m2)
 
-IMPL_UNARY_OP_CONVERT(f8e5m2_t, f8e5m2, exp, expf(x), f8e5m2_to_float, float_to_f8e5m2)
-IMPL_UNARY_OP_CONVERT(f8e5m2_t, f8e5m2, exp2, exp2f(x), f8e5m2_to_float, float_to_f8e5m2)
+IMPL_UNARY_OP_CONVERT_SIMD(f8e5m2_t, f8e5m2, exp, expf(x), simd_f32_exp(v), f8e5m2_to_float,
+                           float_to_f8e5m2)
+IMPL_UNARY_OP_CONVERT_SIMD(f8e5m2_t, f8e5m2, exp2, exp2f(x), simd_f32_exp2(v), f8e5m2_to_float,
+                           float_to_f8e5m2)
 IMPL_UNARY_OP_CONVERT(f8e5m2_t, f8e5m2, exp10, exp10f(x), f8e5m2_to_float, float_to_f8e5m2)
-IMPL_UNARY_OP_CONVERT(f8e5m2_t, f8e5m2, ln, logf(x), f8e5m2_to_float, float_to_f8e5m2)
-IMPL_UNARY_OP_CONVERT(f8e5m2_t, f8e5m2, log2, log2f(x), f8e5m2_to_float, float_to_f8e5m2)
-IMPL_UNARY_OP_CONVERT(f8e5m2_t, f8e5m2, log10, log10f(x), f8e5m2_to_float, float_to_f8e5m2)
+IMPL_UNARY_OP_CONVERT_SIMD(f8e5m2_t, f8e5m2, ln, logf(x), simd_f32_log(v), f8e5m2_to_float,
+                           float_to_f8e5m2)
+IMPL_UNARY_OP_CONVERT_SIMD(f8e5m2_t, f8e5m2, log2, log2f(x), simd_f32_log2(v), f8e5m2_to_float,
+                           float_to_f8e5m2)
+IMPL_UNARY_OP_CONVERT_SIMD(f8e5m2_t, f8e5m2, log10, log10f(x), simd_f32_log10(v), f8e5m2_to_float,
+                           float_to_f8e5m2)
 IMPL_UNARY_OP_CONVERT(f8e5m2_t, f8e5m2, ceil, ceilf(x), f8e5m2_to_float, float_to_f8e5m2)
 IMPL_UNARY_OP_CONVERT(f8e5m2_t, f8e5m2, floor, floorf(x), f8e5m2_to_float, float_to_f8e5m2)
 IMPL_UNARY_OP_CONVERT(f8e5m2_t, f8e5m2, round, roundf(x), f8e5m2_to_float, float_to_f8e5m2)
-IMPL_UNARY_OP_CONVERT(f8e5m2_t, f8e5m2, erf, erff(x), f8e5m2_to_float, float_to_f8e5m2)
+IMPL_UNARY_OP_CONVERT_SIMD(f8e5m2_t, f8e5m2, erf, erff(x), simd_f32_erf(v), f8e5m2_to_float,
+                           float_to_f8e5m2)
 
 IMPL_UNARY_TO_BOOL_CONVERT(f8e5m2_t, f8e5m2, logical_not, x == 0.0f, f8e5m2_to_float)
 
@@ -1402,16 +1878,23 @@ IMPL_UNARY_OP_CONVERT(bf16_t, bf16, sqrt, sqrtf(x), bf16_to_float, float_to_bf16
 IMPL_UNARY_OP_CONVERT(bf16_t, bf16, recip, 1.0f / x, bf16_to_float, float_to_bf16)
 
 IMPL_UNARY_OP_CONVERT(bf16_t, bf16, relu, (x > 0.0f) ? x : 0.0f, bf16_to_float, float_to_bf16)
-IMPL_UNARY_OP_CONVERT(bf16_t, bf16, sigmoid, 1.0f / (1.0f + expf(-x)), bf16_to_float, float_to_bf16)
+IMPL_UNARY_OP_CONVERT_SIMD(bf16_t, bf16, sigmoid, 1.0f / (1.0f + expf(-x)), simd_f32_sigmoid(v),
+                           bf16_to_float, float_to_bf16)
 IMPL_UNARY_OP_CONVERT(bf16_t, bf16, hardsigmoid, hardsigmoid_helper_f32(x), bf16_to_float,
                       float_to_bf16)
-IMPL_UNARY_OP_CONVERT(bf16_t, bf16, gelu, gelu_helper_f32(x), bf16_to_float, float_to_bf16)
-IMPL_UNARY_OP_CONVERT(bf16_t, bf16, softplus, softplus_helper_f32(x), bf16_to_float, float_to_bf16)
-IMPL_UNARY_OP_CONVERT(bf16_t, bf16, silu, silu_helper_f32(x), bf16_to_float, float_to_bf16)
+IMPL_UNARY_OP_CONVERT_SIMD(bf16_t, bf16, gelu, gelu_helper_f32(x), simd_f32_gelu(v), bf16_to_float,
+                           float_to_bf16)
+IMPL_UNARY_OP_CONVERT_SIMD(bf16_t, bf16, softplus, softplus_helper_f32(x), softplus_simd_f32(v),
+                           bf16_to_float, float_to_bf16)
+IMPL_UNARY_OP_CONVERT_SIMD(bf16_t, bf16, silu, silu_helper_f32(x), simd_f32_silu(v), bf16_to_float,
+                           float_to_bf16)
 IMPL_UNARY_OP_CONVERT(bf16_t, bf16, hardsilu, hardsilu_helper_f32(x), bf16_to_float, float_to_bf16)
-IMPL_UNARY_OP_CONVERT(bf16_t, bf16, mish, mish_helper_f32(x), bf16_to_float, float_to_bf16)
-IMPL_UNARY_OP_CONVERT(bf16_t, bf16, selu, selu_helper_f32(x), bf16_to_float, float_to_bf16)
-IMPL_UNARY_OP_CONVERT(bf16_t, bf16, celu, celu_helper_f32(x), bf16_to_float, float_to_bf16)
+IMPL_UNARY_OP_CONVERT_SIMD(bf16_t, bf16, mish, mish_helper_f32(x), mish_simd_f32(v), bf16_to_float,
+                           float_to_bf16)
+IMPL_UNARY_OP_CONVERT_SIMD(bf16_t, bf16, selu, selu_helper_f32(x), selu_simd_f32(v), bf16_to_float,
+                           float_to_bf16)
+IMPL_UNARY_OP_CONVERT_SIMD(bf16_t, bf16, celu, celu_helper_f32(x), celu_simd_f32(v), bf16_to_float,
+                           float_to_bf16)
 
 IMPL_UNARY_OP_CONVERT(bf16_t, bf16, sin, sinf(x), bf16_to_float, float_to_bf16)
 IMPL_UNARY_OP_CONVERT(bf16_t, bf16, cos, cosf(x), bf16_to_float, float_to_bf16)
@@ -1422,21 +1905,27 @@ IMPL_UNARY_OP_CONVERT(bf16_t, bf16, atan, atanf(x), bf16_to_float, float_to_bf16
 
 IMPL_UNARY_OP_CONVERT(bf16_t, bf16, sinh, sinhf(x), bf16_to_float, float_to_bf16)
 IMPL_UNARY_OP_CONVERT(bf16_t, bf16, cosh, coshf(x), bf16_to_float, float_to_bf16)
-IMPL_UNARY_OP_CONVERT(bf16_t, bf16, tanh, tanhf(x), bf16_to_float, float_to_bf16)
+IMPL_UNARY_OP_CONVERT_SIMD(bf16_t, bf16, tanh, tanhf(x), simd_f32_tanh(v), bf16_to_float,
+                           float_to_bf16)
 IMPL_UNARY_OP_CONVERT(bf16_t, bf16, asinh, asinhf(x), bf16_to_float, float_to_bf16)
 IMPL_UNARY_OP_CONVERT(bf16_t, bf16, acosh, acoshf(x), bf16_to_float, float_to_bf16)
 IMPL_UNARY_OP_CONVERT(bf16_t, bf16, atanh, atanhf(x), bf16_to_float, float_to_bf16)
 
-IMPL_UNARY_OP_CONVERT(bf16_t, bf16, exp, expf(x), bf16_to_float, float_to_bf16)
-IMPL_UNARY_OP_CONVERT(bf16_t, bf16, exp2, exp2f(x), bf16_to_float, float_to_bf16)
+IMPL_UNARY_OP_CONVERT_SIMD(bf16_t, bf16, exp, expf(x), simd_f32_exp(v), bf16_to_float,
+                           float_to_bf16)
+IMPL_UNARY_OP_CONVERT_SIMD(bf16_t, bf16, exp2, exp2f(x), simd_f32_exp2(v), bf16_to_float,
+                           float_to_bf16)
 IMPL_UNARY_OP_CONVERT(bf16_t, bf16, exp10, exp10f(x), bf16_to_float, float_to_bf16)
-IMPL_UNARY_OP_CONVERT(bf16_t, bf16, ln, logf(x), bf16_to_float, float_to_bf16)
-IMPL_UNARY_OP_CONVERT(bf16_t, bf16, log2, log2f(x), bf16_to_float, float_to_bf16)
-IMPL_UNARY_OP_CONVERT(bf16_t, bf16, log10, log10f(x), bf16_to_float, float_to_bf16)
+IMPL_UNARY_OP_CONVERT_SIMD(bf16_t, bf16, ln, logf(x), simd_f32_log(v), bf16_to_float, float_to_bf16)
+IMPL_UNARY_OP_CONVERT_SIMD(bf16_t, bf16, log2, log2f(x), simd_f32_log2(v), bf16_to_float,
+                           float_to_bf16)
+IMPL_UNARY_OP_CONVERT_SIMD(bf16_t, bf16, log10, log10f(x), simd_f32_log10(v), bf16_to_float,
+                           float_to_bf16)
 IMPL_UNARY_OP_CONVERT(bf16_t, bf16, ceil, ceilf(x), bf16_to_float, float_to_bf16)
 IMPL_UNARY_OP_CONVERT(bf16_t, bf16, floor, floorf(x), bf16_to_float, float_to_bf16)
 IMPL_UNARY_OP_CONVERT(bf16_t, bf16, round, roundf(x), bf16_to_float, float_to_bf16)
-IMPL_UNARY_OP_CONVERT(bf16_t, bf16, erf, erff(x), bf16_to_float, float_to_bf16)
+IMPL_UNARY_OP_CONVERT_SIMD(bf16_t, bf16, erf, erff(x), simd_f32_erf(v), bf16_to_float,
+                           float_to_bf16)
 
 IMPL_UNARY_TO_BOOL_CONVERT(bf16_t, bf16, logical_not, x == 0.0f, bf16_to_float)
 
@@ -1482,16 +1971,23 @@ IMPL_UNARY_OP_CONVERT(f16_t, f16, sqrt, sqrtf(x), f16_to_float, float_to_f16)
 IMPL_UNARY_OP_CONVERT(f16_t, f16, recip, 1.0f / x, f16_to_float, float_to_f16)
 
 IMPL_UNARY_OP_CONVERT(f16_t, f16, relu, (x > 0.0f) ? x : 0.0f, f16_to_float, float_to_f16)
-IMPL_UNARY_OP_CONVERT(f16_t, f16, sigmoid, 1.0f / (1.0f + expf(-x)), f16_to_float, float_to_f16)
+IMPL_UNARY_OP_CONVERT_SIMD(f16_t, f16, sigmoid, 1.0f / (1.0f + expf(-x)), simd_f32_sigmoid(v),
+                           f16_to_float, float_to_f16)
 IMPL_UNARY_OP_CONVERT(f16_t, f16, hardsigmoid, hardsigmoid_helper_f32(x), f16_to_float,
                       float_to_f16)
-IMPL_UNARY_OP_CONVERT(f16_t, f16, gelu, gelu_helper_f32(x), f16_to_float, float_to_f16)
-IMPL_UNARY_OP_CONVERT(f16_t, f16, softplus, softplus_helper_f32(x), f16_to_float, float_to_f16)
-IMPL_UNARY_OP_CONVERT(f16_t, f16, silu, silu_helper_f32(x), f16_to_float, float_to_f16)
+IMPL_UNARY_OP_CONVERT_SIMD(f16_t, f16, gelu, gelu_helper_f32(x), simd_f32_gelu(v), f16_to_float,
+                           float_to_f16)
+IMPL_UNARY_OP_CONVERT_SIMD(f16_t, f16, softplus, softplus_helper_f32(x), softplus_simd_f32(v),
+                           f16_to_float, float_to_f16)
+IMPL_UNARY_OP_CONVERT_SIMD(f16_t, f16, silu, silu_helper_f32(x), simd_f32_silu(v), f16_to_float,
+                           float_to_f16)
 IMPL_UNARY_OP_CONVERT(f16_t, f16, hardsilu, hardsilu_helper_f32(x), f16_to_float, float_to_f16)
-IMPL_UNARY_OP_CONVERT(f16_t, f16, mish, mish_helper_f32(x), f16_to_float, float_to_f16)
-IMPL_UNARY_OP_CONVERT(f16_t, f16, selu, selu_helper_f32(x), f16_to_float, float_to_f16)
-IMPL_UNARY_OP_CONVERT(f16_t, f16, celu, celu_helper_f32(x), f16_to_float, float_to_f16)
+IMPL_UNARY_OP_CONVERT_SIMD(f16_t, f16, mish, mish_helper_f32(x), mish_simd_f32(v), f16_to_float,
+                           float_to_f16)
+IMPL_UNARY_OP_CONVERT_SIMD(f16_t, f16, selu, selu_helper_f32(x), selu_simd_f32(v), f16_to_float,
+                           float_to_f16)
+IMPL_UNARY_OP_CONVERT_SIMD(f16_t, f16, celu, celu_helper_f32(x), celu_simd_f32(v), f16_to_float,
+                           float_to_f16)
 
 IMPL_UNARY_OP_CONVERT(f16_t, f16, sin, sinf(x), f16_to_float, float_to_f16)
 IMPL_UNARY_OP_CONVERT(f16_t, f16, cos, cosf(x), f16_to_float, float_to_f16)
@@ -1502,21 +1998,22 @@ IMPL_UNARY_OP_CONVERT(f16_t, f16, atan, atanf(x), f16_to_float, float_to_f16)
 
 IMPL_UNARY_OP_CONVERT(f16_t, f16, sinh, sinhf(x), f16_to_float, float_to_f16)
 IMPL_UNARY_OP_CONVERT(f16_t, f16, cosh, coshf(x), f16_to_float, float_to_f16)
-IMPL_UNARY_OP_CONVERT(f16_t, f16, tanh, tanhf(x), f16_to_float, float_to_f16)
+IMPL_UNARY_OP_CONVERT_SIMD(f16_t, f16, tanh, tanhf(x), simd_f32_tanh(v), f16_to_float, float_to_f16)
 IMPL_UNARY_OP_CONVERT(f16_t, f16, asinh, asinhf(x), f16_to_float, float_to_f16)
 IMPL_UNARY_OP_CONVERT(f16_t, f16, acosh, acoshf(x), f16_to_float, float_to_f16)
 IMPL_UNARY_OP_CONVERT(f16_t, f16, atanh, atanhf(x), f16_to_float, float_to_f16)
 
-IMPL_UNARY_OP_CONVERT(f16_t, f16, exp, expf(x), f16_to_float, float_to_f16)
-IMPL_UNARY_OP_CONVERT(f16_t, f16, exp2, exp2f(x), f16_to_float, float_to_f16)
+IMPL_UNARY_OP_CONVERT_SIMD(f16_t, f16, exp, expf(x), simd_f32_exp(v), f16_to_float, float_to_f16)
+IMPL_UNARY_OP_CONVERT_SIMD(f16_t, f16, exp2, exp2f(x), simd_f32_exp2(v), f16_to_float, float_to_f16)
 IMPL_UNARY_OP_CONVERT(f16_t, f16, exp10, exp10f(x), f16_to_float, float_to_f16)
-IMPL_UNARY_OP_CONVERT(f16_t, f16, ln, logf(x), f16_to_float, float_to_f16)
-IMPL_UNARY_OP_CONVERT(f16_t, f16, log2, log2f(x), f16_to_float, float_to_f16)
-IMPL_UNARY_OP_CONVERT(f16_t, f16, log10, log10f(x), f16_to_float, float_to_f16)
+IMPL_UNARY_OP_CONVERT_SIMD(f16_t, f16, ln, logf(x), simd_f32_log(v), f16_to_float, float_to_f16)
+IMPL_UNARY_OP_CONVERT_SIMD(f16_t, f16, log2, log2f(x), simd_f32_log2(v), f16_to_float, float_to_f16)
+IMPL_UNARY_OP_CONVERT_SIMD(f16_t, f16, log10, log10f(x), simd_f32_log10(v), f16_to_float,
+                           float_to_f16)
 IMPL_UNARY_OP_CONVERT(f16_t, f16, ceil, ceilf(x), f16_to_float, float_to_f16)
 IMPL_UNARY_OP_CONVERT(f16_t, f16, floor, floorf(x), f16_to_float, float_to_f16)
 IMPL_UNARY_OP_CONVERT(f16_t, f16, round, roundf(x), f16_to_float, float_to_f16)
-IMPL_UNARY_OP_CONVERT(f16_t, f16, erf, erff(x), f16_to_float, float_to_f16)
+IMPL_UNARY_OP_CONVERT_SIMD(f16_t, f16, erf, erff(x), simd_f32_erf(v), f16_to_float, float_to_f16)
 
 IMPL_UNARY_TO_BOOL_CONVERT(f16_t, f16, logical_not, x == 0.0f, f16_to_float)
 
@@ -3,13 +3,16 @@
  * @brief Unary tensor operations header
  *
  * Provides element-wise unary operations for tensors:
- * - Basic arithmetic: neg, abs, sign, square, sqrt, recip
- * - Activation functions: relu, sigmoid, tanh, gelu, softplus, silu, mish
- * - Trigonometric: sin, cos, tan
+ * - Basic arithmetic: neg, abs, sign, softsign, square, sqrt, recip
+ * - Activation functions: relu, sigmoid, hardsigmoid, gelu, softplus, silu, hardsilu, mish, selu,
+ *   celu
+ * - Rounding: ceil, floor, round (and erf)
+ * - Trigonometric and hyperbolic: sin, cos, tan, asin, acos, atan, sinh, cosh, tanh, asinh, acosh,
+ *   atanh
  * - Exponential/logarithmic: exp, exp2, exp10, ln, log2, log10
  * - Logical: logical_not, isnan, isinf, isfinite
- * - Scalar operations: arithmetic (add, sub, mul, div, pow, max, min) and comparison (eq, ne, lt,
- * le, gt, ge)
+ * - Scalar operations: arithmetic (add, sub, mul, div, rem, pow, max, min) and comparison (eq, ne,
+ *   lt, le, gt, ge)
  *
  * All operations support strided tensor access and multiple data types.
  */
@@ -46,18 +49,20 @@ extern "C" {
 // - metadata[2+2*num_dims]: offset
 //
 // Type support:
-// - Basic operations (neg, abs, sign, square, sqrt, recip): all numeric types
-// - Activation functions: float types only (f8e4m3, f8e5m2, bf16, f16, f32, f64)
-// - Trigonometric: float types only
+// - Basic operations (abs, sign, softsign, square, sqrt, recip): all types; neg: all but unsigned
+// - Activation functions and rounding: float types (f8e4m3, f8e5m2, bf16, f16, f32, f64) and bool
+// - Trigonometric/hyperbolic: float types only
 // - Exponential/logarithmic: float types only
 // - Logical: all types (including bool)
 // - Scalar operations: all types
+//
+// In place: output may be the input buffer itself (same offset, row-major view); any other
+// overlap between the input view and the output is staged through a workspace copy first.
 
 /**
  * @brief Macro to declare basic unary operations
  *
  * Declares functions for element-wise basic arithmetic operations:
- * - neg: Negate elements (-x)
  * - abs: Absolute value (|x|)
  * - sign: Sign function (-1, 0, or 1)
  * - softsign: Softsign function (x / (1 + |x|))
@@ -66,7 +71,6 @@ extern "C" {
  * - recip: Reciprocal (1/x)
  */
 #define DECLARE_UNARY_OP(TYPE_SUFFIX)                                                              \
-    void hodu_cpu_neg_##TYPE_SUFFIX(const void *input, void *output, const size_t *metadata);      \
     void hodu_cpu_abs_##TYPE_SUFFIX(const void *input, void *output, const size_t *metadata);      \
     void hodu_cpu_sign_##TYPE_SUFFIX(const void *input, void *output, const size_t *metadata);     \
     void hodu_cpu_softsign_##TYPE_SUFFIX(const void *input, void *output, const size_t *metadata); \
@@ -74,47 +78,83 @@ extern "C" {
     void hodu_cpu_sqrt_##TYPE_SUFFIX(const void *input, void *output, const size_t *metadata);     \
     void hodu_cpu_recip_##TYPE_SUFFIX(const void *input, void *output, const size_t *metadata);
 
+/**
+ * @brief Macro to declare negation
+ *
+ * Declares neg (-x; logical NOT for bool). Not available for unsigned types.
+ */
+#define DECLARE_UNARY_NEG(TYPE_SUFFIX)                                                             \
+    void hodu_cpu_neg_##TYPE_SUFFIX(const void *input, void *output, const size_t *metadata);
+
 /**
  * @brief Macro to declare activation function operations
  *
  * Declares functions for neural network activation functions:
  * - relu: Rectified Linear Unit (max(0, x))
  * - sigmoid: Sigmoid function (1 / (1 + e^(-x)))
- * - tanh: Hyperbolic tangent
+ * - hardsigmoid: Piecewise-linear sigmoid (clamp(x / 6 + 0.5, 0, 1))
  * - gelu: Gaussian Error Linear Unit
  * - softplus: Softplus function (ln(1 + e^x))
  * - silu: Sigmoid Linear Unit (x * sigmoid(x))
+ * - hardsilu: x * hardsigmoid(x)
  * - mish: Mish activation (x * tanh(softplus(x)))
  * - selu: Scaled ELU (scale * (max(0,x) + min(0, alpha*(exp(x)-1))))
  * - celu: Continuous ELU (max(0,x) + min(0, alpha*(exp(x/alpha)-1)))
  *
- * Note: Only available for float types (f8e4m3, f8e5m2, bf16, f16, f32, f64)
+ * Note: Available for float types (f8e4m3, f8e5m2, bf16, f16, f32, f64) and bool (identity)
  */
 #define DECLARE_UNARY_ACTIVATION(TYPE_SUFFIX)                                                      \
     void hodu_cpu_relu_##TYPE_SUFFIX(const void *input, void *output, const size_t *metadata);     \
     void hodu_cpu_sigmoid_##TYPE_SUFFIX(const void *input, void *output, const size_t *metadata);  \
-    void hodu_cpu_tanh_##TYPE_SUFFIX(const void *input, void *output, const size_t *metadata);     \
+    void hodu_cpu_hardsigmoid_##TYPE_SUFFIX(const void *input, void *output,                       \
+                                            const size_t *metadata);                               \
     void hodu_cpu_gelu_##TYPE_SUFFIX(const void *input, void *output, const size_t *metadata);     \
     void hodu_cpu_softplus_##TYPE_SUFFIX(const void *input, void *output, const size_t *metadata); \
     void hodu_cpu_silu_##TYPE_SUFFIX(const void *input, void *output, const size_t *metadata);     \
+    void hodu_cpu_hardsilu_##TYPE_SUFFIX(const void *input, void *output, const size_t *metadata); \
     void hodu_cpu_mish_##TYPE_SUFFIX(const void *input, void *output, const size_t *metadata);     \
     void hodu_cpu_selu_##TYPE_SUFFIX(const void *input, void *output, const size_t *metadata);     \
     void hodu_cpu_celu_##TYPE_SUFFIX(const void *input, void *output, const size_t *metadata);
 
+/**
+ * @brief Macro to declare rounding operations
+ *
+ * Declares functions for rounding and the error function:
+ * - ceil, floor, round: Round up, down, or to nearest (halfway cases away from zero)
+ * - erf: Gauss error function
+ *
+ * Note: Available for float types and bool (identity)
+ */
+#define DECLARE_UNARY_ROUNDING(TYPE_SUFFIX)                                                        \
+    void hodu_cpu_ceil_##TYPE_SUFFIX(const void *input, void *output, const size_t *metadata);     \
+    void hodu_cpu_floor_##TYPE_SUFFIX(const void *input, void *output, const size_t *metadata);    \
+    void hodu_cpu_round_##TYPE_SUFFIX(const void *input, void *output, const size_t *metadata);    \
+    void hodu_cpu_erf_##TYPE_SUFFIX(const void *input, void *output, const size_t *metadata);
+
 /**
  * @brief Macro to declare trigonometric operations
  *
- * Declares functions for trigonometric operations:
- * - sin: Sine function
- * - cos: Cosine function
- * - tan: Tangent function
+ * Declares functions for trigonometric and hyperbolic operations:
+ * - sin, cos, tan: Sine, cosine, tangent
+ * - asin, acos, atan: Inverse trigonometric functions
+ * - sinh, cosh, tanh: Hyperbolic functions
+ * - asinh, acosh, atanh: Inverse hyperbolic functions
  *
  * Note: Only available for float types (f8e4m3, f8e5m2, bf16, f16, f32, f64)
  */
 #define DECLARE_UNARY_TRIG(TYPE_SUFFIX)                                                            \
     void hodu_cpu_sin_##TYPE_SUFFIX(const void *input, void *output, const size_t *metadata);      \
     void hodu_cpu_cos_##TYPE_SUFFIX(const void *input, void *output, const size_t *metadata);      \
-    void hodu_cpu_tan_##TYPE_SUFFIX(const void *input, void *output, const size_t *metadata);
+    void hodu_cpu_tan_##TYPE_SUFFIX(const void *input, void *output, const size_t *metadata);      \
+    void hodu_cpu_asin_##TYPE_SUFFIX(const void *input, void *output, const size_t *metadata);     \
+    void hodu_cpu_acos_##TYPE_SUFFIX(const void *input, void *output, const size_t *metadata);     \
+    void hodu_cpu_atan_##TYPE_SUFFIX(const void *input, void *output, const size_t *metadata);     \
+    void hodu_cpu_sinh_##TYPE_SUFFIX(const void *input, void *output, const size_t *metadata);     \
+    void hodu_cpu_cosh_##TYPE_SUFFIX(const void *input, void *output, const size_t *metadata);     \
+    void hodu_cpu_tanh_##TYPE_SUFFIX(const void *input, void *output, const size_t *metadata);     \
+    void hodu_cpu_asinh_##TYPE_SUFFIX(const void *input, void *output, const size_t *metadata);    \
+    void hodu_cpu_acosh_##TYPE_SUFFIX(const void *input, void *output, const size_t *metadata);    \
+    void hodu_cpu_atanh_##TYPE_SUFFIX(const void *input, void *output, const size_t *metadata);
 
 /**
  * @brief Macro to declare exponential and logarithmic operations
@@ -135,10 +175,7 @@ extern "C" {
     void hodu_cpu_exp10_##TYPE_SUFFIX(const void *input, void *output, const size_t *metadata);    \
     void hodu_cpu_ln_##TYPE_SUFFIX(const void *input, void *output, const size_t *metadata);       \
     void hodu_cpu_log2_##TYPE_SUFFIX(const void *input, void *output, const size_t *metadata);     \
-    void hodu_cpu_log10_##TYPE_SUFFIX(const void *input, void *output, const size_t *metadata);    \
-    void hodu_cpu_ceil_##TYPE_SUFFIX(const void *input, void *output, const size_t *metadata);     \
-    void hodu_cpu_floor_##TYPE_SUFFIX(const void *input, void *output, const size_t *metadata);    \
-    void hodu_cpu_round_##TYPE_SUFFIX(const void *input, void *output, const size_t *metadata);
+    void hodu_cpu_log10_##TYPE_SUFFIX(const void *input, void *output, const size_t *metadata);
 
 /**
  * @brief Macro to declare logical operations
@@ -177,6 +214,7 @@ extern "C" {
  * - sub_scalar: Subtract scalar from each element (x - s)
  * - mul_scalar: Multiply each element by scalar (x * s)
  * - div_scalar: Divide each element by scalar (x / s)
+ * - rem_scalar: Remainder of each element divided by scalar (x % s)
  * - pow_scalar: Raise each element to scalar power (x^s)
  * - maximum_scalar: Element-wise maximum with scalar (max(x, s))
  * - minimum_scalar: Element-wise minimum with scalar (min(x, s))
@@ -193,6 +231,8 @@ extern "C" {
                                            const size_t *metadata, const void *scalar);            \
     void hodu_cpu_div_scalar_##TYPE_SUFFIX(const void *input, void *output,                        \
                                            const size_t *metadata, const void *scalar);            \
+    void hodu_cpu_rem_scalar_##TYPE_SUFFIX(const void *input, void *output,                        \
+                                           const size_t *metadata, const void *scalar);            \
     void hodu_cpu_pow_scalar_##TYPE_SUFFIX(const void *input, void *output,                        \
                                            const size_t *metadata, const void *scalar);            \
     void hodu_cpu_maximum_scalar_##TYPE_SUFFIX(const void *input, void *output,                    \
@@ -231,16 +271,18 @@ extern "C" {
 
 // Bool type
 DECLARE_UNARY_OP(bool)
+DECLARE_UNARY_NEG(bool)
 DECLARE_UNARY_ACTIVATION(bool)
-DECLARE_UNARY_TRIG(bool)
-DECLARE_UNARY_EXP(bool)
+DECLARE_UNARY_ROUNDING(bool)
 DECLARE_UNARY_LOGICAL(bool)
 DECLARE_UNARY_WITH_SCALAR(bool)
 DECLARE_UNARY_CMP_SCALAR(bool)
 
 // Float types (f8e4m3, f8e5m2, bf16, f16, f32, f64)
 DECLARE_UNARY_OP(f8e4m3)
+DECLARE_UNARY_NEG(f8e4m3)
 DECLARE_UNARY_ACTIVATION(f8e4m3)
+DECLARE_UNARY_ROUNDING(f8e4m3)
 DECLARE_UNARY_TRIG(f8e4m3)
 DECLARE_UNARY_EXP(f8e4m3)
 DECLARE_UNARY_LOGICAL(f8e4m3)
@@ -249,7 +291,9 @@ DECLARE_UNARY_WITH_SCALAR(f8e4m3)
 DECLARE_UNARY_CMP_SCALAR(f8e4m3)
 
 DECLARE_UNARY_OP(f8e5m2)
+DECLARE_UNARY_NEG(f8e5m2)
 DECLARE_UNARY_ACTIVATION(f8e5m2)
+DECLARE_UNARY_ROUNDING(f8e5m2)
 DECLARE_UNARY_TRIG(f8e5m2)
 DECLARE_UNARY_EXP(f8e5m2)
 DECLARE_UNARY_LOGICAL(f8e5m2)
@@ -258,7 +302,9 @@ DECLARE_UNARY_WITH_SCALAR(f8e5m2)
 DECLARE_UNARY_CMP_SCALAR(f8e5m2)
 
 DECLARE_UNARY_OP(bf16)
+DECLARE_UNARY_NEG(bf16)
 DECLARE_UNARY_ACTIVATION(bf16)
+DECLARE_UNARY_ROUNDING(bf16)
 DECLARE_UNARY_TRIG(bf16)
 DECLARE_UNARY_EXP(bf16)
 DECLARE_UNARY_LOGICAL(bf16)
@@ -267,7 +313,9 @@ DECLARE_UNARY_WITH_SCALAR(bf16)
 DECLARE_UNARY_CMP_SCALAR(bf16)
 
 DECLARE_UNARY_OP(f16)
+DECLARE_UNARY_NEG(f16)
 DECLARE_UNARY_ACTIVATION(f16)
+DECLARE_UNARY_ROUNDING(f16)
 DECLARE_UNARY_TRIG(f16)
 DECLARE_UNARY_EXP(f16)
 DECLARE_UNARY_LOGICAL(f16)
@@ -276,7 +324,9 @@ DECLARE_UNARY_WITH_SCALAR(f16)
 DECLARE_UNARY_CMP_SCALAR(f16)
 
 DECLARE_UNARY_OP(f32)
+DECLARE_UNARY_NEG(f32)
 DECLARE_UNARY_ACTIVATION(f32)
+DECLARE_UNARY_ROUNDING(f32)
 DECLARE_UNARY_TRIG(f32)
 DECLARE_UNARY_EXP(f32)
 DECLARE_UNARY_LOGICAL(f32)
@@ -285,7 +335,9 @@ DECLARE_UNARY_WITH_SCALAR(f32)
 DECLARE_UNARY_CMP_SCALAR(f32)
 
 DECLARE_UNARY_OP(f64)
+DECLARE_UNARY_NEG(f64)
 DECLARE_UNARY_ACTIVATION(f64)
+DECLARE_UNARY_ROUNDING(f64)
 DECLARE_UNARY_TRIG(f64)
 DECLARE_UNARY_EXP(f64)
 DECLARE_UNARY_LOGICAL(f64)
@@ -315,21 +367,25 @@ DECLARE_UNARY_WITH_SCALAR(u64)
 DECLARE_UNARY_CMP_SCALAR(u64)
 
 DECLARE_UNARY_OP(i8)
+DECLARE_UNARY_NEG(i8)
 DECLARE_UNARY_LOGICAL(i8)
 DECLARE_UNARY_WITH_SCALAR(i8)
 DECLARE_UNARY_CMP_SCALAR(i8)
 
 DECLARE_UNARY_OP(i16)
+DECLARE_UNARY_NEG(i16)
 DECLARE_UNARY_LOGICAL(i16)
 DECLARE_UNARY_WITH_SCALAR(i16)
 DECLARE_UNARY_CMP_SCALAR(i16)
 
 DECLARE_UNARY_OP(i32)
+DECLARE_UNARY_NEG(i32)
 DECLARE_UNARY_LOGICAL(i32)
 DECLARE_UNARY_WITH_SCALAR(i32)
 DECLARE_UNARY_CMP_SCALAR(i32)
 
 DECLARE_UNARY_OP(i64)
+DECLARE_UNARY_NEG(i64)
 DECLARE_UNARY_LOGICAL(i64)
 DECLARE_UNARY_WITH_SCALAR(i64)
 DECLARE_UNARY_CMP_SCALAR(i64)
@@ -1,4 +1,5 @@
 #include "ops_unary.h"
+#include "profile.h"
 #include "types.h"
 #include "utils.h"
 #include <cblas_new.h>
@@ -12,6 +13,7 @@ extern void hodu_cpu_mul_scalar_f64_fallback(const void *input, void *output,
 // mul_scalar_f32: Accelerate BLAS-optimized version
 void hodu_cpu_mul_scalar_f32(const void *input, void *output, const size_t *metadata,
                              const void *scalar) {
+    HODU_PROFILE_KERNEL(metadata[0] * 2 * sizeof(f32_t));
     const size_t num_els = metadata[0];
     const size_t num_dims = metadata[1];
     const f32_t *in = (const f32_t *)input;
@@ -26,6 +28,7 @@ void hodu_cpu_mul_scalar_f32(const void *input, void *output, const size_t *meta
 
     // BLAS path: Use cblas_sscal for in-place scalar multiplication
     if (contiguous && in == NULL) {
+        HODU_PROFILE_PATH(HODU_CPU_PATH_BLAS);
         // In-place operation
         cblas_sscal(num_els, const_val, out, 1);
         return;
@@ -34,6 +37,7 @@ void hodu_cpu_mul_scalar_f32(const void *input, void *output, const size_t *meta
         if (in != out) {
             cblas_scopy(num_els, in, 1, out, 1);
         }
+        HODU_PROFILE_PATH(HODU_CPU_PATH_BLAS);
         cblas_sscal(num_els, const_val, out, 1);
         return;
     }
@@ -45,6 +49,7 @@ void hodu_cpu_mul_scalar_f32(const void *input, void *output, const size_t *meta
 // mul_scalar_f64: Accelerate BLAS-optimized version
 void hodu_cpu_mul_scalar_f64(const void *input, void *output, const size_t *metadata,
                              const void *scalar) {
+    HODU_PROFILE_KERNEL(metadata[0] * 2 * sizeof(f64_t));
     const size_t num_els = metadata[0];
     const size_t num_dims = metadata[1];
     const f64_t *in = (const f64_t *)input;
@@ -59,6 +64,7 @@ void hodu_cpu_mul_scalar_f64(const void *input, void *output, const size_t *meta
 
     // BLAS path: Use cblas_dscal for in-place scalar multiplication
     if (contiguous && in == NULL) {
+        HODU_PROFILE_PATH(HODU_CPU_PATH_BLAS);
         // In-place operation
         cblas_dscal(num_els, const_val, out, 1);
         return;
@@ -67,6 +73,7 @@ void hodu_cpu_mul_scalar_f64(const void *input, void *output, const size_t *meta
         if (in != out) {
             cblas_dcopy(num_els, in, 1, out, 1);
         }
+        HODU_PROFILE_PATH(HODU_CPU_PATH_BLAS);
         cblas_dscal(num_els, const_val, out, 1);
         return;
     }
@@ -1,6 +1,11 @@
 #include "ops_windowing.h"
 #include "math_utils.h"
+#include "profile.h"
+#include "strided_copy.h"
+#include "thread_utils.h"
 #include "types.h"
+#include "utils.h"
+#include "workspace.h"
 #include <float.h>
 #include <math.h>
 #include <stdbool.h>
@@ -11,11 +16,9 @@
 #define MIN(a, b) ((a) < (b) ? (a) : (b))
 
 // ============================================================================
-// WINDOWING OPERATION IMPLEMENTATION MACROS
+// WINDOWING OPERATION IMPLEMENTATION
 // ============================================================================
 //
-// These macros generate sliding window reduction operations for various types.
-//
 // Metadata layout (same for all operations):
 // - metadata[0]: output_size (total number of elements in output)
 // - metadata[1]: num_dims (number of dimensions)
@@ -27,225 +30,675 @@
 // - metadata[3+4*num_dims..3+4*num_dims+2*num_dims]: padding (before and after for each dimension)
 // - metadata[3+6*num_dims..]: output_shape
 //
-// Algorithm:
-// 1. For each output element, compute its coordinates
-// 2. For each position in the window:
-//    - Compute corresponding input coordinates with stride and padding
-//    - Check if position is within bounds (considering padding)
-//    - Apply reduction operation on valid values
-// 3. Out-of-bounds values are treated according to operation:
-//    - max: -infinity, min: +infinity, sum/mean: 0
-
-/**
- * @brief Macro to implement windowing reduction operations (max, min, sum)
- *
- * @param IN_TYPE C type of input elements
- * @param OUT_TYPE C type of output elements
- * @param TYPE_SUFFIX Suffix for function name
- * @param INIT_VAL Initial value for accumulator
- * @param ACCUMULATE Statement to accumulate values (uses 'acc' and 'val')
- */
-#define REDUCE_WINDOW_OP(IN_TYPE, OUT_TYPE, TYPE_SUFFIX, INIT_VAL, ACCUMULATE)                     \
-    void hodu_cpu_reduce_window_##TYPE_SUFFIX(const void *input_ptr, void *output_ptr,             \
-                                              const size_t *metadata) {                            \
-        const IN_TYPE *input = (const IN_TYPE *)input_ptr;                                         \
-        OUT_TYPE *output = (OUT_TYPE *)output_ptr;                                                 \
-                                                                                                   \
-        const size_t num_els = metadata[0];                                                        \
-        const size_t num_dims = metadata[1];                                                       \
-        const size_t *input_shape = metadata + 2;                                                  \
-        const size_t *input_strides = metadata + 2 + num_dims;                                     \
-        const size_t input_offset = metadata[2 + 2 * num_dims];                                    \
-        const size_t *window_shape = metadata + 2 + 2 * num_dims + 1;                              \
-        const size_t *strides = metadata + 2 + 3 * num_dims + 1;                                   \
-        const size_t *padding = metadata + 2 + 4 * num_dims + 1;                                   \
-        const size_t *output_shape = metadata + 2 + 6 * num_dims + 1;                              \
-                                                                                                   \
-        for (size_t out_idx = 0; out_idx < num_els; out_idx++) {                                   \
-            size_t out_coords[16];                                                                 \
-            size_t tmp = out_idx;                                                                  \
-            for (int i = (int)num_dims - 1; i >= 0; i--) {                                         \
-                out_coords[i] = tmp % output_shape[i];                                             \
-                tmp /= output_shape[i];                                                            \
+// Output element (o_0, ..., o_{n-1}) reduces the input positions o_d * stride_d + w_d -
+// pad_before_d for every window offset w_d < window_d; positions outside the input are
+// the identity of the reduction (max: -infinity, min: +infinity, sum/mean: 0).
+//
+// max, min and sum are associative and padding only ever contributes their identity, so an
+// n-d window reduction is a sequence of 1-d window reductions, one pass per windowed dim.
+// The planner first drops and merges dims: dims the window leaves alone (window 1, stride
+// 1, no padding) merge with their neighbours, and adjacent dims reduced as a whole (a single
+// window covering the dim) merge into one global dim. Global pooling of an NCHW tensor is a
+// single pass over rows of H * W elements, and of an NHWC tensor one over H * W rows of C.
+//
+// A pass reduces the middle dim of a dense [outer, n, inner] view to m outputs:
+// - inner == 1 (innermost dim): rows run one per task. Windows are evaluated on a copy of the
+//   row padded with the identity: directly (SIMD across outputs for stride 1), with a running
+//   sum for sum/mean, or with van Herk/Gil-Werman block prefix/suffix maxima for max/min
+//   (three operations per element for any window size). The last two are used once windows
+//   overlap enough that sharing work beats re-reading every window (rw_shared).
+// - inner > 1: the same three schemes combine whole contiguous rows of `inner` elements
+//   (SIMD across width/channels), split into column tiles so that small batches still give
+//   every thread work.
+// Passes run on the thread pool, the most shrinking dim first; intermediates are dense
+// accumulator-typed tensors in the workspace. Non-contiguous inputs are materialised first.
+//
+// Accumulators: max/min keep the element type (bf16/f16/f8 are compared as f32, which is
+// exact). Sums accumulate in f64 for f32/f64, in f32 for bf16/f16/f8 and modulo 2^64 for
+// integers (narrowed at the end, which wraps exactly like a per-type accumulator). f64 sums
+// never use running sums, so they pick up no cancellation error. mean divides the sum by the
+// full window size, padding included.
+
+#define RW_MAX_DIMS 16
+// Column tile bounds for passes over non-innermost dims (elements of one row)
+#define RW_MIN_TILE 64
+#define RW_MAX_TILE 4096
+// Element reads per task
+#define RW_TASK_WORK (1 << 15)
+// Along a row, stride-1 windows up to this size are evaluated directly (SIMD across outputs)
+#define RW_ROW_DIRECT_MAX 16
+
+typedef struct {
+    size_t outer; // product of the dims before the pass dim
+    size_t n;     // input extent of the pass dim
+    size_t inner; // product of the dims after it
+    size_t m;     // output extent
+    size_t k;     // window
+    size_t s;     // stride
+    size_t p;     // padding before
+} rw_pass_t;
+
+typedef struct {
+    size_t num_passes;
+    rw_pass_t passes[RW_MAX_DIMS];
+    size_t max_inter;   // elements of the largest pass output
+    size_t window_size; // product of window_shape (mean divisor)
+} rw_plan_t;
+
+typedef struct {
+    const void *src;
+    void *dst;
+    const rw_pass_t *pass;
+    size_t tile;  // columns per task (inner > 1)
+    size_t tiles; // tasks per outer index
+    bool slide;   // running sums allowed
+} rw_pass_ctx_t;
+
+typedef struct {
+    const void *acc;
+    void *output;
+    size_t window_size;
+} rw_finish_ctx_t;
+
+// Whether running sums / van Herk beat evaluating each window directly: per output they cost
+// about 2 * stride + 2 operations against `window`, but direct stride-1 windows along a row
+// are SIMD across outputs while the shared schemes are sequential there
+static inline bool rw_shared(size_t k, size_t s, bool row) {
+    if (row && s == 1) {
+        return k > RW_ROW_DIRECT_MAX;
+    }
+    return k > 2 * s + 2;
+}
+
+enum { RW_TRIVIAL, RW_GLOBAL, RW_WINDOWED };
+
+static void rw_plan_init(rw_plan_t *plan, size_t num_dims, const size_t *in_shape,
+                         const size_t *window, const size_t *strides, const size_t *padding,
+                         const size_t *out_shape) {
+    size_t n[RW_MAX_DIMS], m[RW_MAX_DIMS], k[RW_MAX_DIMS], s[RW_MAX_DIMS], p[RW_MAX_DIMS];
+    int kind[RW_MAX_DIMS];
+    size_t count = 0;
+
+    plan->window_size = 1;
+    for (size_t d = 0; d < num_dims; d++) {
+        const size_t nd = in_shape[d], md = out_shape[d], kd = window[d];
+        const size_t sd = strides[d], pd = padding[2 * d];
+        plan->window_size *= kd;
+        if (nd == 1 && md == 1 && kd >= 1 && pd == 0) {
+            continue; // the only window holds the only element
+        }
+        int kd_kind = RW_WINDOWED;
+        if (kd == 1 && pd == 0 && md == nd && (sd == 1 || nd <= 1)) {
+            kd_kind = RW_TRIVIAL;
+        } else if (md == 1 && pd == 0 && kd >= nd) {
+            kd_kind = RW_GLOBAL;
+        }
+        if (count > 0 && kd_kind != RW_WINDOWED && kind[count - 1] == kd_kind) {
+            n[count - 1] *= nd;
+            if (kd_kind == RW_TRIVIAL) {
+                m[count - 1] = n[count - 1];
+            } else {
+                k[count - 1] = n[count - 1];
+            }
+            continue;
+        }
+        n[count] = nd;
+        m[count] = md;
+        k[count] = kd_kind == RW_GLOBAL ? nd : kd;
+        s[count] = kd_kind == RW_WINDOWED ? sd : 1;
+        p[count] = pd;
+        kind[count] = kd_kind;
+        count++;
+    }
+    if (count == 0) {
+        n[0] = m[0] = k[0] = s[0] = 1;
+        p[0] = 0;
+        kind[0] = RW_TRIVIAL;
+        count = 1;
+    }
+
+    // Most shrinking dim first (ties: outermost first); a copy pass if nothing is windowed
+    size_t cur[RW_MAX_DIMS];
+    bool done[RW_MAX_DIMS];
+    for (size_t d = 0; d < count; d++) {
+        cur[d] = n[d];
+        done[d] = kind[d] == RW_TRIVIAL;
+    }
+    bool any = false;
+    for (size_t d = 0; d < count; d++) {
+        any |= !done[d];
+    }
+    if (!any) {
+        done[count - 1] = false;
+    }
+    plan->num_passes = 0;
+    plan->max_inter = 0;
+    for (;;) {
+        size_t best = count;
+        for (size_t d = 0; d < count; d++) {
+            if (!done[d] && (best == count || m[d] * n[best] < m[best] * n[d])) {
+                best = d;
+            }
+        }
+        if (best == count) {
+            break;
+        }
+        done[best] = true;
+        rw_pass_t *ps = &plan->passes[plan->num_passes++];
+        ps->outer = 1;
+        ps->inner = 1;
+        for (size_t d = 0; d < best; d++) {
+            ps->outer *= cur[d];
+        }
+        for (size_t d = best + 1; d < count; d++) {
+            ps->inner *= cur[d];
+        }
+        ps->n = n[best];
+        ps->m = m[best];
+        ps->k = k[best];
+        ps->s = s[best];
+        ps->p = p[best];
+        cur[best] = m[best];
+        plan->max_inter = MAXIMUM(plan->max_inter, ps->outer * ps->m * ps->inner);
+    }
+}
+
+// Columns per task for a pass over a non-innermost dim: whole rows when the outer dims
+// already give every thread a few tasks, otherwise rows split into tiles
+static size_t rw_tile(size_t outer, size_t inner) {
+    const size_t target = 4 * get_num_threads();
+    size_t tile = inner;
+    if (outer < target) {
+        const size_t splits = (target + outer - 1) / outer;
+        tile = MAXIMUM((inner + splits - 1) / splits, (size_t)RW_MIN_TILE);
+    }
+    tile = MINIMUM((tile + 15) & ~(size_t)15, (size_t)RW_MAX_TILE);
+    return MINIMUM(tile, inner);
+}
+
+/// Macro for the two pass workers of one (reduction, source, accumulator) combination
+///
+/// rw_rows_NAME handles passes over the innermost dim (one row per task), rw_cols_NAME
+/// passes with inner > 1 (one column tile of one outer index per task).
+///
+/// @param NAME Pass name
+/// @param SRC C type read from the source
+/// @param ACC C type of the accumulators (and of the destination)
+/// @param LOAD Converts a SRC value to ACC
+/// @param IDENT Identity of the reduction
+/// @param COMBINE Reduction of an accumulator and a value
+/// @param INVERSE Removes a value from a sum (running sums)
+/// @param INVERTIBLE Whether running sums apply (sum) or van Herk does (max/min)
+#define RW_PASS(NAME, SRC, ACC, LOAD, IDENT, COMBINE, INVERSE, INVERTIBLE)                         \
+    static void rw_rows_##NAME(size_t start, size_t end, void *ctx_ptr) {                          \
+        const rw_pass_ctx_t *ctx = (const rw_pass_ctx_t *)ctx_ptr;                                 \
+        const size_t n = ctx->pass->n, m = ctx->pass->m, k = ctx->pass->k;                         \
+        const size_t s = ctx->pass->s, p = ctx->pass->p;                                           \
+        const bool global = m == 1 && p == 0 && k >= n;                                            \
+        const bool shared = rw_shared(k, s, true) && (!(INVERTIBLE) || ctx->slide);                \
+        /* Padded positions the windows touch */                                                   \
+        const size_t len = k > 0 ? (m - 1) * s + k : 0;                                            \
+        ACC *buf = NULL;                                                                           \
+        if (!global && len > 0) {                                                                  \
+            buf = (ACC *)workspace_acquire(2 * len * sizeof(ACC));                                 \
+            if (!buf) {                                                                            \
+                return;                                                                            \
             }                                                                                      \
-                                                                                                   \
-            OUT_TYPE acc = INIT_VAL;                                                               \
-                                                                                                   \
-            size_t window_size = 1;                                                                \
-            for (size_t i = 0; i < num_dims; i++) {                                                \
-                window_size *= window_shape[i];                                                    \
+        }                                                                                          \
+        for (size_t o = start; o < end; o++) {                                                     \
+            const SRC *x = (const SRC *)ctx->src + o * n;                                          \
+            ACC *y = (ACC *)ctx->dst + o * m;                                                      \
+            if (global) {                                                                          \
+                /* One window over the whole row: four independent accumulators */                 \
+                ACC a0 = IDENT, a1 = IDENT, a2 = IDENT, a3 = IDENT;                                \
+                size_t i = 0;                                                                      \
+                for (; i + 4 <= n; i += 4) {                                                       \
+                    a0 = COMBINE(a0, LOAD(x[i]));                                                  \
+                    a1 = COMBINE(a1, LOAD(x[i + 1]));                                              \
+                    a2 = COMBINE(a2, LOAD(x[i + 2]));                                              \
+                    a3 = COMBINE(a3, LOAD(x[i + 3]));                                              \
+                }                                                                                  \
+                for (; i < n; i++) {                                                               \
+                    a0 = COMBINE(a0, LOAD(x[i]));                                                  \
+                }                                                                                  \
+                y[0] = COMBINE(COMBINE(a0, a1), COMBINE(a2, a3));                                  \
+                continue;                                                                          \
             }                                                                                      \
-                                                                                                   \
-            for (size_t win_idx = 0; win_idx < window_size; win_idx++) {                           \
-                size_t window_coords[16];                                                          \
-                size_t tmp_win = win_idx;                                                          \
-                for (int i = (int)num_dims - 1; i >= 0; i--) {                                     \
-                    window_coords[i] = tmp_win % window_shape[i];                                  \
-                    tmp_win /= window_shape[i];                                                    \
+            if (len == 0) {                                                                        \
+                for (size_t j = 0; j < m; j++) {                                                   \
+                    y[j] = IDENT;                                                                  \
                 }                                                                                  \
-                                                                                                   \
-                bool in_bounds = true;                                                             \
-                size_t input_coords[16];                                                           \
-                for (size_t i = 0; i < num_dims; i++) {                                            \
-                    size_t padded_pos = out_coords[i] * strides[i] + window_coords[i];             \
-                    size_t pad_before = padding[i * 2];                                            \
-                    if (padded_pos < pad_before) {                                                 \
-                        in_bounds = false;                                                         \
-                        break;                                                                     \
+                continue;                                                                          \
+            }                                                                                      \
+            const size_t lo = MIN(p, len), hi = MIN(p + n, len);                                   \
+            for (size_t i = 0; i < lo; i++) {                                                      \
+                buf[i] = IDENT;                                                                    \
+            }                                                                                      \
+            for (size_t i = lo; i < hi; i++) {                                                     \
+                buf[i] = LOAD(x[i - p]);                                                           \
+            }                                                                                      \
+            for (size_t i = hi; i < len; i++) {                                                    \
+                buf[i] = IDENT;                                                                    \
+            }                                                                                      \
+            if (shared && (INVERTIBLE)) {                                                          \
+                /* Running sum: add the s positions entering the window, drop those leaving */     \
+                ACC acc = IDENT;                                                                   \
+                for (size_t t = 0; t < k; t++) {                                                   \
+                    acc = COMBINE(acc, buf[t]);                                                    \
+                }                                                                                  \
+                y[0] = acc;                                                                        \
+                for (size_t j = 1; j < m; j++) {                                                   \
+                    const ACC *b = buf + (j - 1) * s;                                              \
+                    for (size_t t = 0; t < s; t++) {                                               \
+                        acc = INVERSE(COMBINE(acc, b[k + t]), b[t]);                               \
+                    }                                                                              \
+                    y[j] = acc;                                                                    \
+                }                                                                                  \
+            } else if (shared) {                                                                   \
+                /* van Herk/Gil-Werman: in blocks of k positions, a window [a, a + k) is the */    \
+                /* suffix of a's block joined with the prefix of the next one up to a + k - 1 */   \
+                ACC *suf = buf + len;                                                              \
+                for (size_t b0 = 0; b0 < len; b0 += k) {                                           \
+                    const size_t b1 = MIN(b0 + k, len);                                            \
+                    suf[b1 - 1] = buf[b1 - 1];                                                     \
+                    for (size_t i = b1 - 1; i-- > b0;) {                                           \
+                        suf[i] = COMBINE(suf[i + 1], buf[i]);                                      \
                     }                                                                              \
-                    size_t input_pos = padded_pos - pad_before;                                    \
-                    if (input_pos >= input_shape[i]) {                                             \
-                        in_bounds = false;                                                         \
-                        break;                                                                     \
+                    for (size_t i = b0 + 1; i < b1; i++) {                                         \
+                        buf[i] = COMBINE(buf[i - 1], buf[i]);                                      \
                     }                                                                              \
-                    input_coords[i] = input_pos;                                                   \
                 }                                                                                  \
-                                                                                                   \
-                IN_TYPE val;                                                                       \
-                if (in_bounds) {                                                                   \
-                    size_t idx = input_offset;                                                     \
-                    for (size_t i = 0; i < num_dims; i++) {                                        \
-                        idx += input_coords[i] * input_strides[i];                                 \
+                for (size_t j = 0; j < m; j++) {                                                   \
+                    y[j] = COMBINE(suf[j * s], buf[j * s + k - 1]);                                \
+                }                                                                                  \
+            } else {                                                                               \
+                /* Direct, window offset outermost so stride-1 rows vectorize across outputs */    \
+                for (size_t j = 0; j < m; j++) {                                                   \
+                    y[j] = buf[j * s];                                                             \
+                }                                                                                  \
+                for (size_t t = 1; t < k; t++) {                                                   \
+                    const ACC *b = buf + t;                                                        \
+                    if (s == 1) {                                                                  \
+                        for (size_t j = 0; j < m; j++) {                                           \
+                            y[j] = COMBINE(y[j], b[j]);                                            \
+                        }                                                                          \
+                    } else {                                                                       \
+                        for (size_t j = 0; j < m; j++) {                                           \
+                            y[j] = COMBINE(y[j], b[j * s]);                                        \
+                        }                                                                          \
                     }                                                                              \
-                    val = input[idx];                                                              \
-                } else {                                                                           \
-                    val = (IN_TYPE)INIT_VAL;                                                       \
                 }                                                                                  \
-                                                                                                   \
-                ACCUMULATE;                                                                        \
             }                                                                                      \
-                                                                                                   \
-            output[out_idx] = acc;                                                                 \
         }                                                                                          \
-    }
-
-/**
- * @brief Macro to implement windowing mean operation
- *
- * Computes the average of values in each window. Padding areas are treated as 0.
- * Only available for floating-point types.
- *
- * @param IN_TYPE C type of input elements (float type)
- * @param OUT_TYPE C type of output elements (float type)
- * @param TYPE_SUFFIX Suffix for function name
- */
-#define REDUCE_WINDOW_MEAN_OP(IN_TYPE, OUT_TYPE, TYPE_SUFFIX)                                      \
-    void hodu_cpu_reduce_window_mean_##TYPE_SUFFIX(const void *input_ptr, void *output_ptr,        \
-                                                   const size_t *metadata) {                       \
-        const IN_TYPE *input = (const IN_TYPE *)input_ptr;                                         \
-        OUT_TYPE *output = (OUT_TYPE *)output_ptr;                                                 \
-                                                                                                   \
-        const size_t num_els = metadata[0];                                                        \
-        const size_t num_dims = metadata[1];                                                       \
-                                                                                                   \
-        const size_t *input_shape = metadata + 2;                                                  \
-        const size_t *input_strides = metadata + 2 + num_dims;                                     \
-        const size_t input_offset = metadata[2 + 2 * num_dims];                                    \
-        const size_t *window_shape = metadata + 2 + 2 * num_dims + 1;                              \
-        const size_t *strides = metadata + 2 + 3 * num_dims + 1;                                   \
-        const size_t *padding = metadata + 2 + 4 * num_dims + 1;                                   \
-        const size_t *output_shape = metadata + 2 + 6 * num_dims + 1;                              \
-                                                                                                   \
-        for (size_t out_idx = 0; out_idx < num_els; out_idx++) {                                   \
-            size_t out_coords[16];                                                                 \
-            size_t tmp = out_idx;                                                                  \
-            for (int i = (int)num_dims - 1; i >= 0; i--) {                                         \
-                out_coords[i] = tmp % output_shape[i];                                             \
-                tmp /= output_shape[i];                                                            \
-            }                                                                                      \
+        if (buf) {                                                                                 \
+            workspace_release(buf);                                                                \
+        }                                                                                          \
+    }                                                                                              \
                                                                                                    \
-            OUT_TYPE sum = 0;                                                                      \
-            size_t window_size = 1;                                                                \
-            for (size_t i = 0; i < num_dims; i++) {                                                \
-                window_size *= window_shape[i];                                                    \
+    static void rw_cols_##NAME(size_t start, size_t end, void *ctx_ptr) {                          \
+        const rw_pass_ctx_t *ctx = (const rw_pass_ctx_t *)ctx_ptr;                                 \
+        const size_t n = ctx->pass->n, m = ctx->pass->m, k = ctx->pass->k;                         \
+        const size_t s = ctx->pass->s, p = ctx->pass->p, inner = ctx->pass->inner;                 \
+        const bool shared = rw_shared(k, s, false);                                                \
+        const bool running = shared && (INVERTIBLE) && ctx->slide;                                 \
+        const bool vanherk = shared && !(INVERTIBLE);                                              \
+        ACC *h = NULL;                                                                             \
+        if (vanherk) {                                                                             \
+            h = (ACC *)workspace_acquire(ctx->tile * sizeof(ACC));                                 \
+            if (!h) {                                                                              \
+                return;                                                                            \
             }                                                                                      \
-                                                                                                   \
-            for (size_t win_idx = 0; win_idx < window_size; win_idx++) {                           \
-                size_t window_coords[16];                                                          \
-                size_t tmp_win = win_idx;                                                          \
-                for (int i = (int)num_dims - 1; i >= 0; i--) {                                     \
-                    window_coords[i] = tmp_win % window_shape[i];                                  \
-                    tmp_win /= window_shape[i];                                                    \
+        }                                                                                          \
+        for (size_t task = start; task < end; task++) {                                            \
+            const size_t o = task / ctx->tiles, c0 = (task % ctx->tiles) * ctx->tile;              \
+            const size_t w = MIN(ctx->tile, inner - c0);                                           \
+            const SRC *x = (const SRC *)ctx->src + o * n * inner + c0;                             \
+            ACC *y = (ACC *)ctx->dst + o * m * inner + c0;                                         \
+            if (vanherk) {                                                                         \
+                /* van Herk/Gil-Werman on whole rows: block suffixes are stored at the window */   \
+                /* starts (backwards), then joined with the block prefixes at the window ends */   \
+                const size_t len = (m - 1) * s + k;                                                \
+                for (size_t b1 = len; b1 > 0;) {                                                   \
+                    const size_t b0 = (b1 - 1) / k * k;                                            \
+                    for (size_t i = b1; i-- > b0;) {                                               \
+                        const bool in = i >= p && i - p < n;                                       \
+                        const SRC *xi = in ? x + (i - p) * inner : x;                              \
+                        if (i == b1 - 1) {                                                         \
+                            for (size_t c = 0; c < w; c++) {                                       \
+                                h[c] = in ? LOAD(xi[c]) : IDENT;                                   \
+                            }                                                                      \
+                        } else if (in) {                                                           \
+                            for (size_t c = 0; c < w; c++) {                                       \
+                                h[c] = COMBINE(h[c], LOAD(xi[c]));                                 \
+                            }                                                                      \
+                        }                                                                          \
+                        if (i % s == 0 && i / s < m) {                                             \
+                            memcpy(y + i / s * inner, h, w * sizeof(ACC));                         \
+                        }                                                                          \
+                    }                                                                              \
+                    b1 = b0;                                                                       \
                 }                                                                                  \
-                                                                                                   \
-                bool in_bounds = true;                                                             \
-                size_t input_coords[16];                                                           \
-                for (size_t i = 0; i < num_dims; i++) {                                            \
-                    size_t padded_pos = out_coords[i] * strides[i] + window_coords[i];             \
-                    size_t pad_before = padding[i * 2];                                            \
-                    if (padded_pos < pad_before) {                                                 \
-                        in_bounds = false;                                                         \
-                        break;                                                                     \
+                for (size_t b0 = 0; b0 < len; b0 += k) {                                           \
+                    const size_t b1 = MIN(b0 + k, len);                                            \
+                    for (size_t i = b0; i < b1; i++) {                                             \
+                        const bool in = i >= p && i - p < n;                                       \
+                        const SRC *xi = in ? x + (i - p) * inner : x;                              \
+                        if (i == b0) {                                                             \
+                            for (size_t c = 0; c < w; c++) {                                       \
+                                h[c] = in ? LOAD(xi[c]) : IDENT;                                   \
+                            }                                                                      \
+                        } else if (in) {                                                           \
+                            for (size_t c = 0; c < w; c++) {                                       \
+                                h[c] = COMBINE(h[c], LOAD(xi[c]));                                 \
+                            }                                                                      \
+                        }                                                                          \
+                        if (i + 1 >= k && (i + 1 - k) % s == 0) {                                  \
+                            ACC *yj = y + (i + 1 - k) / s * inner;                                 \
+                            for (size_t c = 0; c < w; c++) {                                       \
+                                yj[c] = COMBINE(yj[c], h[c]);                                      \
+                            }                                                                      \
+                        }                                                                          \
+                    }                                                                              \
+                }                                                                                  \
+                continue;                                                                          \
+            }                                                                                      \
+            for (size_t j = 0; j < m; j++) {                                                       \
+                ACC *yj = y + j * inner;                                                           \
+                /* Input rows [lo, hi) of window j, clipped to the input */                        \
+                const size_t a = j * s;                                                            \
+                const size_t lo = MIN(a > p ? a - p : 0, n);                                       \
+                const size_t hi = MIN(a + k > p ? a + k - p : 0, n);                               \
+                if (running && j > 0) {                                                            \
+                    /* Previous window plus the rows entering, minus the rows leaving */           \
+                    const size_t pa = a - s;                                                       \
+                    const size_t plo = MIN(pa > p ? pa - p : 0, n);                                \
+                    const size_t phi = MIN(pa + k > p ? pa + k - p : 0, n);                        \
+                    memcpy(yj, yj - inner, w * sizeof(ACC));                                       \
+                    for (size_t r = phi; r < hi; r++) {                                            \
+                        const SRC *xr = x + r * inner;                                             \
+                        for (size_t c = 0; c < w; c++) {                                           \
+                            yj[c] = COMBINE(yj[c], LOAD(xr[c]));                                   \
+                        }                                                                          \
                     }                                                                              \
-                    size_t input_pos = padded_pos - pad_before;                                    \
-                    if (input_pos >= input_shape[i]) {                                             \
-                        in_bounds = false;                                                         \
-                        break;                                                                     \
+                    for (size_t r = plo; r < lo; r++) {                                            \
+                        const SRC *xr = x + r * inner;                                             \
+                        for (size_t c = 0; c < w; c++) {                                           \
+                            yj[c] = INVERSE(yj[c], LOAD(xr[c]));                                   \
+                        }                                                                          \
                     }                                                                              \
-                    input_coords[i] = input_pos;                                                   \
+                    continue;                                                                      \
                 }                                                                                  \
-                                                                                                   \
-                if (in_bounds) {                                                                   \
-                    size_t idx = input_offset;                                                     \
-                    for (size_t i = 0; i < num_dims; i++) {                                        \
-                        idx += input_coords[i] * input_strides[i];                                 \
+                if (lo >= hi) {                                                                    \
+                    for (size_t c = 0; c < w; c++) {                                               \
+                        yj[c] = IDENT;                                                             \
+                    }                                                                              \
+                    continue;                                                                      \
+                }                                                                                  \
+                for (size_t c = 0; c < w; c++) {                                                   \
+                    yj[c] = LOAD(x[lo * inner + c]);                                               \
+                }                                                                                  \
+                for (size_t r = lo + 1; r < hi; r++) {                                             \
+                    const SRC *xr = x + r * inner;                                                 \
+                    for (size_t c = 0; c < w; c++) {                                               \
+                        yj[c] = COMBINE(yj[c], LOAD(xr[c]));                                       \
                     }                                                                              \
-                    sum += (OUT_TYPE)input[idx];                                                   \
                 }                                                                                  \
             }                                                                                      \
-                                                                                                   \
-            output[out_idx] = sum / (OUT_TYPE)window_size;                                         \
         }                                                                                          \
+        if (h) {                                                                                   \
+            workspace_release(h);                                                                  \
+        }                                                                                          \
+    }
+
+#define RW_LOAD(x) (x)
+#define RW_SUM_U64(x) ((uint64_t)(x))
+#define RW_ADD(a, b) ((a) + (b))
+#define RW_SUB(a, b) ((a) - (b))
+#define RW_NO_INVERSE(a, b) ((void)(b), (a))
+
+typedef struct {
+    parallel_for_fn rows; // pass over the innermost dim
+    parallel_for_fn cols; // pass over a dim with inner elements
+} rw_pass_fns_t;
+
+typedef struct {
+    rw_pass_fns_t first;    // first pass, reads the element type
+    rw_pass_fns_t rest;     // later passes, read the accumulator type
+    parallel_for_fn finish; // narrows accumulators to the output (NULL: passes write it)
+    size_t elem_size;
+    size_t acc_size;
+    bool slide; // running sums allowed
+} rw_kernel_t;
+
+static void rw_run_pass(const rw_pass_fns_t *fns, const rw_pass_t *ps, const void *src, void *dst,
+                        bool slide) {
+    rw_pass_ctx_t ctx = {src, dst, ps, ps->inner, 1, slide};
+    const size_t k_eff = rw_shared(ps->k, ps->s, ps->inner == 1) ? 3 : MAXIMUM(ps->k, (size_t)1);
+    if (ps->inner == 1) {
+        const size_t work = MAXIMUM(ps->n + ps->m * k_eff, (size_t)1);
+        parallel_for(0, ps->outer, MAXIMUM(RW_TASK_WORK / work, (size_t)1), fns->rows, &ctx);
+        return;
+    }
+    ctx.tile = rw_tile(ps->outer, ps->inner);
+    ctx.tiles = (ps->inner + ctx.tile - 1) / ctx.tile;
+    const size_t work = MAXIMUM((ps->n + ps->m * k_eff) * ctx.tile, (size_t)1);
+    parallel_for(0, ps->outer * ctx.tiles, MAXIMUM(RW_TASK_WORK / work, (size_t)1), fns->cols,
+                 &ctx);
+}
+
+static void reduce_window_run(const void *input, void *output, const size_t *metadata,
+                              const rw_kernel_t *kern) {
+    const size_t num_els = metadata[0];
+    const size_t num_dims = metadata[1];
+    const size_t *input_shape = metadata + 2;
+    const size_t *input_strides = metadata + 2 + num_dims;
+    const size_t input_offset = metadata[2 + 2 * num_dims];
+    const size_t *window_shape = metadata + 2 + 2 * num_dims + 1;
+    const size_t *strides = metadata + 2 + 3 * num_dims + 1;
+    const size_t *padding = metadata + 2 + 4 * num_dims + 1;
+    const size_t *output_shape = metadata + 2 + 6 * num_dims + 1;
+    if (num_els == 0 || num_dims > RW_MAX_DIMS) {
+        return;
+    }
+
+    rw_plan_t plan;
+    rw_plan_init(&plan, num_dims, input_shape, window_shape, strides, padding, output_shape);
+
+    const bool dense = is_contiguous(num_dims, input_shape, input_strides);
+    size_t in_numel = 1;
+    for (size_t d = 0; d < num_dims; d++) {
+        in_numel *= input_shape[d];
+    }
+    const size_t copy_bytes = dense ? 0 : hodu_cpu_workspace_block_size(in_numel * kern->elem_size);
+    // Ping-pong intermediates; the last pass writes the output when there is nothing to narrow
+    const size_t inter_count = plan.num_passes - (kern->finish ? 0 : 1);
+    const size_t inter_bytes =
+        hodu_cpu_workspace_block_size(plan.max_inter * kern->acc_size) * MINIMUM(inter_count, 2);
+    char *ws = NULL;
+    if (copy_bytes + inter_bytes > 0) {
+        ws = (char *)workspace_acquire(copy_bytes + inter_bytes);
+        if (!ws) {
+            return;
+        }
+    }
+
+    const void *src = (const char *)input + input_offset * kern->elem_size;
+    if (!dense) {
+        hodu_cpu_strided_copy(src, ws, kern->elem_size, num_dims, input_shape, input_strides,
+                              NULL);
+        src = ws;
+    }
+    char *inter[2] = {NULL, NULL};
+    if (inter_bytes > 0) {
+        inter[0] = ws + copy_bytes;
+        inter[1] = inter[0] + hodu_cpu_workspace_block_size(plan.max_inter * kern->acc_size);
+    }
+    for (size_t i = 0; i < plan.num_passes; i++) {
+        const bool last = i + 1 == plan.num_passes;
+        void *dst = last && !kern->finish ? output : inter[i & 1];
+        rw_run_pass(i == 0 ? &kern->first : &kern->rest, &plan.passes[i], src, dst, kern->slide);
+        src = dst;
+    }
+    if (kern->finish) {
+        rw_finish_ctx_t ctx = {src, output, plan.window_size};
+        parallel_for(0, num_els, RW_TASK_WORK, kern->finish, &ctx);
+    }
+    if (ws) {
+        workspace_release(ws);
+    }
+}
+
+// Passes: max/min keep the element type (f32 for bf16/f16/f8); sums widen (see above)
+#define RW_MINMAX_PASSES(OP, COMBINE)                                                              \
+    RW_PASS(OP##_f8e4m3, f8e4m3_t, float, f8e4m3_to_float, COMBINE##_IDENT_F32, COMBINE,           \
+            RW_NO_INVERSE, 0)                                                                      \
+    RW_PASS(OP##_f8e5m2, f8e5m2_t, float, f8e5m2_to_float, COMBINE##_IDENT_F32, COMBINE,           \
+            RW_NO_INVERSE, 0)                                                                      \
+    RW_PASS(OP##_bf16, bf16_t, float, bf16_to_float, COMBINE##_IDENT_F32, COMBINE, RW_NO_INVERSE,  \
+            0)                                                                                     \
+    RW_PASS(OP##_f16, f16_t, float, f16_to_float, COMBINE##_IDENT_F32, COMBINE, RW_NO_INVERSE, 0)  \
+    RW_PASS(OP##_f32, float, float, RW_LOAD, COMBINE##_IDENT_F32, COMBINE, RW_NO_INVERSE, 0)       \
+    RW_PASS(OP##_f64, double, double, RW_LOAD, COMBINE##_IDENT_F64, COMBINE, RW_NO_INVERSE, 0)     \
+    RW_PASS(OP##_i8, int8_t, int8_t, RW_LOAD, COMBINE##_IDENT_I8, COMBINE, RW_NO_INVERSE, 0)       \
+    RW_PASS(OP##_i16, int16_t, int16_t, RW_LOAD, COMBINE##_IDENT_I16, COMBINE, RW_NO_INVERSE, 0)   \
+    RW_PASS(OP##_i32, int32_t, int32_t, RW_LOAD, COMBINE##_IDENT_I32, COMBINE, RW_NO_INVERSE, 0)   \
+    RW_PASS(OP##_i64, int64_t, int64_t, RW_LOAD, COMBINE##_IDENT_I64, COMBINE, RW_NO_INVERSE, 0)   \
+    RW_PASS(OP##_u8, uint8_t, uint8_t, RW_LOAD, COMBINE##_IDENT_U8, COMBINE, RW_NO_INVERSE, 0)     \
+    RW_PASS(OP##_u16, uint16_t, uint16_t, RW_LOAD, COMBINE##_IDENT_U16, COMBINE, RW_NO_INVERSE, 0) \
+    RW_PASS(OP##_u32, uint32_t, uint32_t, RW_LOAD, COMBINE##_IDENT_U32, COMBINE, RW_NO_INVERSE, 0) \
+    RW_PASS(OP##_u64, uint64_t, uint64_t, RW_LOAD, COMBINE##_IDENT_U64, COMBINE, RW_NO_INVERSE, 0)
+
+#define MAX_IDENT_F32 (-INFINITY)
+#define MAX_IDENT_F64 (-INFINITY)
+#define MAX_IDENT_I8 INT8_MIN
+#define MAX_IDENT_I16 INT16_MIN
+#define MAX_IDENT_I32 INT32_MIN
+#define MAX_IDENT_I64 INT64_MIN
+#define MAX_IDENT_U8 0u
+#define MAX_IDENT_U16 0u
+#define MAX_IDENT_U32 0u
+#define MAX_IDENT_U64 0u
+#define MIN_IDENT_F32 INFINITY
+#define MIN_IDENT_F64 INFINITY
+#define MIN_IDENT_I8 INT8_MAX
+#define MIN_IDENT_I16 INT16_MAX
+#define MIN_IDENT_I32 INT32_MAX
+#define MIN_IDENT_I64 INT64_MAX
+#define MIN_IDENT_U8 UINT8_MAX
+#define MIN_IDENT_U16 UINT16_MAX
+#define MIN_IDENT_U32 UINT32_MAX
+#define MIN_IDENT_U64 UINT64_MAX
+
+RW_MINMAX_PASSES(max, MAX)
+RW_MINMAX_PASSES(min, MIN)
+
+RW_PASS(sum_f8e4m3, f8e4m3_t, float, f8e4m3_to_float, 0.0f, RW_ADD, RW_SUB, 1)
+RW_PASS(sum_f8e5m2, f8e5m2_t, float, f8e5m2_to_float, 0.0f, RW_ADD, RW_SUB, 1)
+RW_PASS(sum_bf16, bf16_t, float, bf16_to_float, 0.0f, RW_ADD, RW_SUB, 1)
+RW_PASS(sum_f16, f16_t, float, f16_to_float, 0.0f, RW_ADD, RW_SUB, 1)
+RW_PASS(sum_acc_f32, float, float, RW_LOAD, 0.0f, RW_ADD, RW_SUB, 1)
+RW_PASS(sum_f32, float, double, RW_LOAD, 0.0, RW_ADD, RW_SUB, 1)
+RW_PASS(sum_f64, double, double, RW_LOAD, 0.0, RW_ADD, RW_SUB, 1)
+RW_PASS(sum_i8, int8_t, uint64_t, RW_SUM_U64, 0u, RW_ADD, RW_SUB, 1)
+RW_PASS(sum_i16, int16_t, uint64_t, RW_SUM_U64, 0u, RW_ADD, RW_SUB, 1)
+RW_PASS(sum_i32, int32_t, uint64_t, RW_SUM_U64, 0u, RW_ADD, RW_SUB, 1)
+RW_PASS(sum_i64, int64_t, uint64_t, RW_SUM_U64, 0u, RW_ADD, RW_SUB, 1)
+RW_PASS(sum_u8, uint8_t, uint64_t, RW_SUM_U64, 0u, RW_ADD, RW_SUB, 1)
+RW_PASS(sum_u16, uint16_t, uint64_t, RW_SUM_U64, 0u, RW_ADD, RW_SUB, 1)
+RW_PASS(sum_u32, uint32_t, uint64_t, RW_SUM_U64, 0u, RW_ADD, RW_SUB, 1)
+RW_PASS(sum_u64, uint64_t, uint64_t, RW_LOAD, 0u, RW_ADD, RW_SUB, 1)
+
+/// Implements an op whose passes write the output directly (accumulator = element type)
+#define REDUCE_WINDOW_OP(OP, TYPE_SUFFIX)                                                          \
+    void hodu_cpu_reduce_window_##OP##_##TYPE_SUFFIX(const void *input, void *output,              \
+                                                     const size_t *metadata) {                     \
+        HODU_PROFILE_KERNEL((hodu_cpu_profile_numel(metadata + 2, metadata[1]) +                   \
+                             metadata[0]) * sizeof(TYPE_SUFFIX##_t));                              \
+        static const rw_kernel_t kernel = {                                                        \
+            {rw_rows_##OP##_##TYPE_SUFFIX, rw_cols_##OP##_##TYPE_SUFFIX},                          \
+            {rw_rows_##OP##_##TYPE_SUFFIX, rw_cols_##OP##_##TYPE_SUFFIX},                          \
+            NULL,                                                                                  \
+            sizeof(TYPE_SUFFIX##_t),                                                               \
+            sizeof(TYPE_SUFFIX##_t),                                                               \
+            true};                                                                                 \
+        reduce_window_run(input, output, metadata, &kernel);                                       \
+    }
+
+/// Implements an op whose accumulators are narrowed into the output at the end
+///
+/// @param NAME Op and type suffix (max_bf16, sum_i8, mean_f32, ...)
+/// @param TYPE C type of the elements
+/// @param ACC C type of the accumulators
+/// @param FIRST Pass reading the elements
+/// @param REST Pass reading accumulators
+/// @param FROM Converts the accumulator (or mean) to TYPE
+/// @param MEAN Whether the sum is divided by the window size
+/// @param SLIDE Whether running sums are allowed
+#define REDUCE_WINDOW_NARROW_OP(NAME, TYPE, ACC, FIRST, REST, FROM, MEAN, SLIDE)                   \
+    static void rw_finish_##NAME(size_t start, size_t end, void *ctx_ptr) {                        \
+        const rw_finish_ctx_t *ctx = (const rw_finish_ctx_t *)ctx_ptr;                             \
+        const ACC *acc = (const ACC *)ctx->acc;                                                    \
+        TYPE *output = (TYPE *)ctx->output;                                                        \
+        const ACC scale = (ACC)ctx->window_size;                                                   \
+        (void)scale;                                                                               \
+        for (size_t i = start; i < end; i++) {                                                     \
+            output[i] = (TYPE)FROM((MEAN) ? acc[i] / scale : acc[i]);                              \
+        }                                                                                          \
+    }                                                                                              \
+                                                                                                   \
+    void hodu_cpu_reduce_window_##NAME(const void *input, void *output, const size_t *metadata) {  \
+        HODU_PROFILE_KERNEL((hodu_cpu_profile_numel(metadata + 2, metadata[1]) +                   \
+                             metadata[0]) * sizeof(TYPE));                                         \
+        static const rw_kernel_t kernel = {{rw_rows_##FIRST, rw_cols_##FIRST},                     \
+                                           {rw_rows_##REST, rw_cols_##REST},                       \
+                                           rw_finish_##NAME,                                       \
+                                           sizeof(TYPE),                                           \
+                                           sizeof(ACC),                                            \
+                                           SLIDE};                                                 \
+        reduce_window_run(input, output, metadata, &kernel);                                       \
     }
 
-REDUCE_WINDOW_OP(f8e4m3_t, f8e4m3_t, max_f8e4m3, F8E4M3_NEG_INF, acc = f8e4m3_max(acc, val))
-REDUCE_WINDOW_OP(f8e5m2_t, f8e5m2_t, max_f8e5m2, F8E5M2_NEG_INF, acc = f8e5m2_max(acc, val))
-REDUCE_WINDOW_OP(bf16_t, bf16_t, max_bf16, BF16_NEG_INF, acc = bf16_max(acc, val))
-REDUCE_WINDOW_OP(f16_t, f16_t, max_f16, F16_NEG_INF, acc = f16_max(acc, val))
-REDUCE_WINDOW_OP(float, float, max_f32, -INFINITY, acc = MAX(acc, val))
-REDUCE_WINDOW_OP(double, double, max_f64, -INFINITY, acc = MAX(acc, val))
-REDUCE_WINDOW_OP(int8_t, int8_t, max_i8, INT8_MIN, acc = MAX(acc, val))
-REDUCE_WINDOW_OP(int16_t, int16_t, max_i16, INT16_MIN, acc = MAX(acc, val))
-REDUCE_WINDOW_OP(int32_t, int32_t, max_i32, INT32_MIN, acc = MAX(acc, val))
-REDUCE_WINDOW_OP(int64_t, int64_t, max_i64, INT64_MIN, acc = MAX(acc, val))
-REDUCE_WINDOW_OP(uint8_t, uint8_t, max_u8, 0u, acc = MAX(acc, val))
-REDUCE_WINDOW_OP(uint16_t, uint16_t, max_u16, 0u, acc = MAX(acc, val))
-REDUCE_WINDOW_OP(uint32_t, uint32_t, max_u32, 0u, acc = MAX(acc, val))
-REDUCE_WINDOW_OP(uint64_t, uint64_t, max_u64, 0u, acc = MAX(acc, val))
-
-REDUCE_WINDOW_MEAN_OP(f8e4m3_t, f8e4m3_t, f8e4m3)
-REDUCE_WINDOW_MEAN_OP(f8e5m2_t, f8e5m2_t, f8e5m2)
-REDUCE_WINDOW_MEAN_OP(bf16_t, bf16_t, bf16)
-REDUCE_WINDOW_MEAN_OP(f16_t, f16_t, f16)
-REDUCE_WINDOW_MEAN_OP(float, float, f32)
-REDUCE_WINDOW_MEAN_OP(double, double, f64)
-
-REDUCE_WINDOW_OP(f8e4m3_t, f8e4m3_t, sum_f8e4m3, F8E4M3_ZERO, acc = f8e4m3_add(acc, val))
-REDUCE_WINDOW_OP(f8e5m2_t, f8e5m2_t, sum_f8e5m2, F8E5M2_ZERO, acc = f8e5m2_add(acc, val))
-REDUCE_WINDOW_OP(bf16_t, bf16_t, sum_bf16, BF16_ZERO, acc = bf16_add(acc, val))
-REDUCE_WINDOW_OP(f16_t, f16_t, sum_f16, F16_ZERO, acc = f16_add(acc, val))
-REDUCE_WINDOW_OP(float, float, sum_f32, 0.0f, acc += val)
-REDUCE_WINDOW_OP(double, double, sum_f64, 0.0, acc += val)
-REDUCE_WINDOW_OP(int8_t, int8_t, sum_i8, 0, acc += val)
-REDUCE_WINDOW_OP(int16_t, int16_t, sum_i16, 0, acc += val)
-REDUCE_WINDOW_OP(int32_t, int32_t, sum_i32, 0, acc += val)
-REDUCE_WINDOW_OP(int64_t, int64_t, sum_i64, 0, acc += val)
-REDUCE_WINDOW_OP(uint8_t, uint8_t, sum_u8, 0u, acc += val)
-REDUCE_WINDOW_OP(uint16_t, uint16_t, sum_u16, 0u, acc += val)
-REDUCE_WINDOW_OP(uint32_t, uint32_t, sum_u32, 0u, acc += val)
-REDUCE_WINDOW_OP(uint64_t, uint64_t, sum_u64, 0u, acc += val)
-
-REDUCE_WINDOW_OP(f8e4m3_t, f8e4m3_t, min_f8e4m3, F8E4M3_POS_INF, acc = f8e4m3_min(acc, val))
-REDUCE_WINDOW_OP(f8e5m2_t, f8e5m2_t, min_f8e5m2, F8E5M2_POS_INF, acc = f8e5m2_min(acc, val))
-REDUCE_WINDOW_OP(bf16_t, bf16_t, min_bf16, BF16_POS_INF, acc = bf16_min(acc, val))
-REDUCE_WINDOW_OP(f16_t, f16_t, min_f16, F16_POS_INF, acc = f16_min(acc, val))
-REDUCE_WINDOW_OP(float, float, min_f32, INFINITY, acc = MIN(acc, val))
-REDUCE_WINDOW_OP(double, double, min_f64, INFINITY, acc = MIN(acc, val))
-REDUCE_WINDOW_OP(int8_t, int8_t, min_i8, INT8_MAX, acc = MIN(acc, val))
-REDUCE_WINDOW_OP(int16_t, int16_t, min_i16, INT16_MAX, acc = MIN(acc, val))
-REDUCE_WINDOW_OP(int32_t, int32_t, min_i32, INT32_MAX, acc = MIN(acc, val))
-REDUCE_WINDOW_OP(int64_t, int64_t, min_i64, INT64_MAX, acc = MIN(acc, val))
-REDUCE_WINDOW_OP(uint8_t, uint8_t, min_u8, UINT8_MAX, acc = MIN(acc, val))
-REDUCE_WINDOW_OP(uint16_t, uint16_t, min_u16, UINT16_MAX, acc = MIN(acc, val))
-REDUCE_WINDOW_OP(uint32_t, uint32_t, min_u32, UINT32_MAX, acc = MIN(acc, val))
-REDUCE_WINDOW_OP(uint64_t, uint64_t, min_u64, UINT64_MAX, acc = MIN(acc, val))
+#define OPS_MINMAX(OP)                                                                             \
+    REDUCE_WINDOW_NARROW_OP(OP##_f8e4m3, f8e4m3_t, float, OP##_f8e4m3, OP##_f32,                   \
+                            float_to_f8e4m3, 0, true)                                              \
+    REDUCE_WINDOW_NARROW_OP(OP##_f8e5m2, f8e5m2_t, float, OP##_f8e5m2, OP##_f32,                   \
+                            float_to_f8e5m2, 0, true)                                              \
+    REDUCE_WINDOW_NARROW_OP(OP##_bf16, bf16_t, float, OP##_bf16, OP##_f32, float_to_bf16, 0, true) \
+    REDUCE_WINDOW_NARROW_OP(OP##_f16, f16_t, float, OP##_f16, OP##_f32, float_to_f16, 0, true)     \
+    REDUCE_WINDOW_OP(OP, f32)                                                                      \
+    REDUCE_WINDOW_OP(OP, f64)                                                                      \
+    REDUCE_WINDOW_OP(OP, i8)                                                                       \
+    REDUCE_WINDOW_OP(OP, i16)                                                                      \
+    REDUCE_WINDOW_OP(OP, i32)                                                                      \
+    REDUCE_WINDOW_OP(OP, i64)                                                                      \
+    REDUCE_WINDOW_OP(OP, u8)                                                                       \
+    REDUCE_WINDOW_OP(OP, u16)                                                                      \
+    REDUCE_WINDOW_OP(OP, u32)                                                                      \
+    REDUCE_WINDOW_OP(OP, u64)
+
+OPS_MINMAX(max)
+OPS_MINMAX(min)
+
+#define OPS_SUM_FLOAT(OP, MEAN)                                                                    \
+    REDUCE_WINDOW_NARROW_OP(OP##_f8e4m3, f8e4m3_t, float, sum_f8e4m3, sum_acc_f32,                 \
+                            float_to_f8e4m3, MEAN, true)                                           \
+    REDUCE_WINDOW_NARROW_OP(OP##_f8e5m2, f8e5m2_t, float, sum_f8e5m2, sum_acc_f32,                 \
+                            float_to_f8e5m2, MEAN, true)                                           \
+    REDUCE_WINDOW_NARROW_OP(OP##_bf16, bf16_t, float, sum_bf16, sum_acc_f32, float_to_bf16, MEAN,  \
+                            true)                                                                  \
+    REDUCE_WINDOW_NARROW_OP(OP##_f16, f16_t, float, sum_f16, sum_acc_f32, float_to_f16, MEAN,      \
+                            true)                                                                  \
+    REDUCE_WINDOW_NARROW_OP(OP##_f32, float, double, sum_f32, sum_f64, RW_LOAD, MEAN, true)        \
+    REDUCE_WINDOW_NARROW_OP(OP##_f64, double, double, sum_f64, sum_f64, RW_LOAD, MEAN, false)
+
+OPS_SUM_FLOAT(sum, 0)
+OPS_SUM_FLOAT(mean, 1)
+
+REDUCE_WINDOW_NARROW_OP(sum_i8, int8_t, uint64_t, sum_i8, sum_u64, RW_LOAD, 0, true)
+REDUCE_WINDOW_NARROW_OP(sum_i16, int16_t, uint64_t, sum_i16, sum_u64, RW_LOAD, 0, true)
+REDUCE_WINDOW_NARROW_OP(sum_i32, int32_t, uint64_t, sum_i32, sum_u64, RW_LOAD, 0, true)
+REDUCE_WINDOW_NARROW_OP(sum_i64, int64_t, uint64_t, sum_i64, sum_u64, RW_LOAD, 0, true)
+REDUCE_WINDOW_NARROW_OP(sum_u8, uint8_t, uint64_t, sum_u8, sum_u64, RW_LOAD, 0, true)
+REDUCE_WINDOW_NARROW_OP(sum_u16, uint16_t, uint64_t, sum_u16, sum_u64, RW_LOAD, 0, true)
+REDUCE_WINDOW_NARROW_OP(sum_u32, uint32_t, uint64_t, sum_u32, sum_u64, RW_LOAD, 0, true)
+REDUCE_WINDOW_OP(sum, u64)
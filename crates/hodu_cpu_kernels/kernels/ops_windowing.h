@@ -50,6 +50,19 @@ extern "C" {
 // - reduce_window_min: padded areas treated as +infinity
 // - reduce_window_sum/mean: padded areas treated as 0
 //
+// Layouts:
+// - Windows are given per dimension, so any layout is pooled in place: NCHW pooling
+//   uses window [1, 1, kh, kw], channels-last (NHWC) pooling window [1, kh, kw, 1]
+// - The output is written densely in output_shape order, so an NHWC input yields an
+//   NHWC output without any layout conversion
+//
+// Implementation:
+// - Windows are reduced one dim at a time (max/min/sum are separable) on the thread pool: SIMD
+//   over contiguous width/channel rows, running sums for sum/mean and van Herk/Gil-Werman
+//   block maxima for max/min once windows overlap, and one pass for global pooling
+// - sum/mean accumulate in f64 for f32/f64, in f32 for bf16/f16/f8 and modulo 2^64 for
+//   integers (the result wraps like the element type)
+//
 // Type support:
 // - reduce_window_max/min: all numeric types (f8e4m3, f8e5m2, bf16, f16, f32, f64, i8-i64, u8-u64)
 // - reduce_window_sum: all numeric types
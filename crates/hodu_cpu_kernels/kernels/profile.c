@@ -0,0 +1,307 @@
+#if !defined(_WIN32) && !defined(_POSIX_C_SOURCE)
+// clock_gettime / CLOCK_MONOTONIC under -std=c11
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+#include "profile.h"
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#ifdef HODU_PROFILE_ACTIVE
+
+// ============================================================================
+// COUNTER REGISTRY
+// ============================================================================
+//
+// Counters are function-local statics in the kernels. The first call of a
+// kernel pushes its counter onto a lock-free list, which snapshots walk; a
+// counter is never removed. Updates are relaxed atomics, so a snapshot taken
+// while kernels run may mix counts of calls in flight.
+
+static _Atomic(hodu_cpu_profile_counter_t *) profile_counters = NULL;
+static _Thread_local hodu_cpu_profile_scope_t *profile_current = NULL;
+
+static uint64_t profile_now_ns(void) {
+    struct timespec ts;
+#if defined(CLOCK_MONOTONIC)
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+#else
+    timespec_get(&ts, TIME_UTC);
+#endif
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+static void profile_register(hodu_cpu_profile_counter_t *counter, const char *name) {
+    int expected = 0;
+    if (!atomic_compare_exchange_strong(&counter->registered, &expected, 1)) {
+        return;
+    }
+    counter->name = name;
+    hodu_cpu_profile_counter_t *head = atomic_load(&profile_counters);
+    do {
+        counter->next = head;
+    } while (!atomic_compare_exchange_weak(&profile_counters, &head, counter));
+}
+
+static void profile_update_max(_Atomic uint64_t *max, uint64_t value) {
+    uint64_t current = atomic_load_explicit(max, memory_order_relaxed);
+    while (value > current && !atomic_compare_exchange_weak_explicit(max, &current, value,
+                                                                     memory_order_relaxed,
+                                                                     memory_order_relaxed)) {
+    }
+}
+
+// ============================================================================
+// TRACE OUTPUT
+// ============================================================================
+//
+// Chrome trace JSON: {"traceEvents":[ complete ("X") events ]}, timestamps in
+// microseconds since hodu_cpu_profile_trace_begin. Events are formatted on the
+// calling thread and appended under a spin lock.
+
+static FILE *profile_trace = NULL;
+static atomic_bool profile_tracing = false;
+static atomic_flag profile_trace_lock = ATOMIC_FLAG_INIT;
+static uint64_t profile_trace_start_ns = 0;
+static bool profile_trace_first = true;
+static atomic_uint profile_next_tid = 1;
+static _Thread_local unsigned profile_tid = 0;
+
+static void profile_trace_acquire(void) {
+    while (atomic_flag_test_and_set_explicit(&profile_trace_lock, memory_order_acquire)) {
+    }
+}
+
+static void profile_trace_release(void) {
+    atomic_flag_clear_explicit(&profile_trace_lock, memory_order_release);
+}
+
+static const char *const profile_path_names[HODU_CPU_PROFILE_NUM_PATHS] = {"scalar", "simd",
+                                                                           "blas", "threads"};
+
+static void profile_trace_event(const hodu_cpu_profile_scope_t *scope, uint64_t end_ns,
+                                unsigned paths, size_t threads) {
+    if (profile_tid == 0) {
+        profile_tid = atomic_fetch_add(&profile_next_tid, 1);
+    }
+
+    char path_list[64] = "";
+    for (int i = 0; i < HODU_CPU_PROFILE_NUM_PATHS; i++) {
+        if (paths & (1u << i)) {
+            if (path_list[0] != '\0') {
+                strcat(path_list, "|");
+            }
+            strcat(path_list, profile_path_names[i]);
+        }
+    }
+
+    profile_trace_acquire();
+    if (profile_trace) {
+        uint64_t start = scope->start_ns > profile_trace_start_ns
+                             ? scope->start_ns - profile_trace_start_ns
+                             : 0;
+        fprintf(profile_trace,
+                "%s\n{\"name\":\"%s\",\"cat\":\"kernel\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,"
+                "\"pid\":1,\"tid\":%u,\"args\":{\"bytes\":%llu,\"paths\":\"%s\",\"threads\":%zu}}",
+                profile_trace_first ? "" : ",", scope->counter->name, (double)start / 1000.0,
+                (double)(end_ns - scope->start_ns) / 1000.0, profile_tid,
+                (unsigned long long)scope->bytes, path_list, threads);
+        profile_trace_first = false;
+    }
+    profile_trace_release();
+}
+
+// ============================================================================
+// SCOPES
+// ============================================================================
+
+void hodu_cpu_profile_scope_begin(hodu_cpu_profile_scope_t *scope,
+                                  hodu_cpu_profile_counter_t *counter, const char *name,
+                                  uint64_t bytes) {
+    profile_register(counter, name);
+    scope->counter = counter;
+    scope->parent = profile_current;
+    scope->bytes = bytes;
+    atomic_init(&scope->paths, 0);
+    atomic_init(&scope->threads, 1);
+    profile_current = scope;
+    scope->start_ns = profile_now_ns();
+}
+
+void hodu_cpu_profile_scope_end(hodu_cpu_profile_scope_t *scope) {
+    uint64_t end_ns = profile_now_ns();
+    uint64_t elapsed = end_ns - scope->start_ns;
+    hodu_cpu_profile_counter_t *counter = scope->counter;
+    unsigned paths = atomic_load_explicit(&scope->paths, memory_order_relaxed);
+    size_t threads = atomic_load_explicit(&scope->threads, memory_order_relaxed);
+    profile_current = scope->parent;
+    if (!(paths & (HODU_CPU_PATH_SIMD | HODU_CPU_PATH_BLAS))) {
+        paths |= HODU_CPU_PATH_SCALAR;
+    }
+
+    atomic_fetch_add_explicit(&counter->calls, 1, memory_order_relaxed);
+    atomic_fetch_add_explicit(&counter->total_ns, elapsed, memory_order_relaxed);
+    atomic_fetch_add_explicit(&counter->bytes, scope->bytes, memory_order_relaxed);
+    profile_update_max(&counter->max_ns, elapsed);
+    profile_update_max(&counter->max_threads, threads);
+    for (int i = 0; i < HODU_CPU_PROFILE_NUM_PATHS; i++) {
+        if (paths & (1u << i)) {
+            atomic_fetch_add_explicit(&counter->path_calls[i], 1, memory_order_relaxed);
+        }
+    }
+
+    if (atomic_load_explicit(&profile_tracing, memory_order_relaxed)) {
+        profile_trace_event(scope, end_ns, paths, threads);
+    }
+}
+
+hodu_cpu_profile_scope_t *hodu_cpu_profile_current(void) { return profile_current; }
+
+hodu_cpu_profile_scope_t *hodu_cpu_profile_set_current(hodu_cpu_profile_scope_t *scope) {
+    hodu_cpu_profile_scope_t *prev = profile_current;
+    profile_current = scope;
+    return prev;
+}
+
+void hodu_cpu_profile_mark(unsigned paths) {
+    hodu_cpu_profile_scope_t *scope = profile_current;
+    // Marks sit in per-row helpers: skip the read-modify-write once the bits are set
+    if (scope && (atomic_load_explicit(&scope->paths, memory_order_relaxed) & paths) != paths) {
+        atomic_fetch_or_explicit(&scope->paths, paths, memory_order_relaxed);
+    }
+}
+
+void hodu_cpu_profile_threads(size_t threads) {
+    hodu_cpu_profile_scope_t *scope = profile_current;
+    if (!scope || threads <= 1) {
+        return;
+    }
+    atomic_fetch_or_explicit(&scope->paths, HODU_CPU_PATH_THREADS, memory_order_relaxed);
+    size_t current = atomic_load_explicit(&scope->threads, memory_order_relaxed);
+    while (threads > current &&
+           !atomic_compare_exchange_weak_explicit(&scope->threads, &current, threads,
+                                                  memory_order_relaxed, memory_order_relaxed)) {
+    }
+}
+
+// ============================================================================
+// QUERIES
+// ============================================================================
+
+int hodu_cpu_profile_enabled(void) { return 1; }
+
+static int profile_compare_total(const void *a, const void *b) {
+    const hodu_cpu_profile_stats_t *x = (const hodu_cpu_profile_stats_t *)a;
+    const hodu_cpu_profile_stats_t *y = (const hodu_cpu_profile_stats_t *)b;
+    if (x->total_ns != y->total_ns) {
+        return x->total_ns > y->total_ns ? -1 : 1;
+    }
+    return strcmp(x->name, y->name);
+}
+
+size_t hodu_cpu_profile_snapshot(hodu_cpu_profile_stats_t *out, size_t capacity) {
+    size_t count = 0;
+    for (hodu_cpu_profile_counter_t *c = atomic_load(&profile_counters); c; c = c->next) {
+        if (atomic_load_explicit(&c->calls, memory_order_relaxed) > 0) {
+            count++;
+        }
+    }
+    if (!out || capacity == 0 || count == 0) {
+        return count;
+    }
+
+    // The list may have grown since counting; take at most `count` entries
+    hodu_cpu_profile_stats_t *all =
+        (hodu_cpu_profile_stats_t *)malloc(count * sizeof(hodu_cpu_profile_stats_t));
+    if (!all) {
+        return 0;
+    }
+    size_t n = 0;
+    for (hodu_cpu_profile_counter_t *c = atomic_load(&profile_counters); c && n < count;
+         c = c->next) {
+        uint64_t calls = atomic_load_explicit(&c->calls, memory_order_relaxed);
+        if (calls == 0) {
+            continue;
+        }
+        hodu_cpu_profile_stats_t *s = &all[n++];
+        s->name = c->name;
+        s->calls = calls;
+        s->total_ns = atomic_load_explicit(&c->total_ns, memory_order_relaxed);
+        s->max_ns = atomic_load_explicit(&c->max_ns, memory_order_relaxed);
+        s->bytes = atomic_load_explicit(&c->bytes, memory_order_relaxed);
+        s->max_threads = atomic_load_explicit(&c->max_threads, memory_order_relaxed);
+        for (int i = 0; i < HODU_CPU_PROFILE_NUM_PATHS; i++) {
+            s->path_calls[i] = atomic_load_explicit(&c->path_calls[i], memory_order_relaxed);
+        }
+    }
+    qsort(all, n, sizeof(hodu_cpu_profile_stats_t), profile_compare_total);
+    memcpy(out, all, (n < capacity ? n : capacity) * sizeof(hodu_cpu_profile_stats_t));
+    free(all);
+    return n;
+}
+
+void hodu_cpu_profile_reset(void) {
+    for (hodu_cpu_profile_counter_t *c = atomic_load(&profile_counters); c; c = c->next) {
+        atomic_store_explicit(&c->calls, 0, memory_order_relaxed);
+        atomic_store_explicit(&c->total_ns, 0, memory_order_relaxed);
+        atomic_store_explicit(&c->max_ns, 0, memory_order_relaxed);
+        atomic_store_explicit(&c->bytes, 0, memory_order_relaxed);
+        atomic_store_explicit(&c->max_threads, 0, memory_order_relaxed);
+        for (int i = 0; i < HODU_CPU_PROFILE_NUM_PATHS; i++) {
+            atomic_store_explicit(&c->path_calls[i], 0, memory_order_relaxed);
+        }
+    }
+}
+
+int hodu_cpu_profile_trace_begin(const char *path) {
+    hodu_cpu_profile_trace_end();
+    FILE *f = path ? fopen(path, "w") : NULL;
+    if (!f) {
+        return -1;
+    }
+    fputs("{\"traceEvents\":[", f);
+
+    profile_trace_acquire();
+    profile_trace = f;
+    profile_trace_first = true;
+    profile_trace_start_ns = profile_now_ns();
+    atomic_store(&profile_tracing, true);
+    profile_trace_release();
+    return 0;
+}
+
+void hodu_cpu_profile_trace_end(void) {
+    profile_trace_acquire();
+    atomic_store(&profile_tracing, false);
+    FILE *f = profile_trace;
+    profile_trace = NULL;
+    profile_trace_release();
+    if (f) {
+        fputs("\n],\"displayTimeUnit\":\"ns\"}\n", f);
+        fclose(f);
+    }
+}
+
+#else
+
+int hodu_cpu_profile_enabled(void) { return 0; }
+
+size_t hodu_cpu_profile_snapshot(hodu_cpu_profile_stats_t *out, size_t capacity) {
+    (void)out;
+    (void)capacity;
+    return 0;
+}
+
+void hodu_cpu_profile_reset(void) {}
+
+int hodu_cpu_profile_trace_begin(const char *path) {
+    (void)path;
+    return -1;
+}
+
+void hodu_cpu_profile_trace_end(void) {}
+
+#endif
@@ -0,0 +1,201 @@
+/**
+ * @file profile.h
+ * @brief Opt-in per-kernel profiling counters and trace events
+ *
+ * Builds with ENABLE_PROFILE (HODU_ENABLE_PROFILE at build time) record, for
+ * every exported kernel that has been called:
+ * - Call count, total and maximum wall time
+ * - Bytes moved (inputs read plus outputs written, as in the benchmarks)
+ * - The code paths calls took (scalar, SIMD, BLAS, thread pool) and the
+ *   largest number of threads a call ran on
+ *
+ * Counters are read with hodu_cpu_profile_snapshot(). While a trace is open
+ * (hodu_cpu_profile_trace_begin) every call is also written as a complete
+ * event in the Chrome trace JSON format, which chrome://tracing and Perfetto
+ * load directly.
+ *
+ * Without ENABLE_PROFILE the recording macros expand to nothing, so kernels
+ * carry no timer reads, atomics or branches; the query functions still link
+ * and report no kernels. Recording needs GCC or Clang (the scope closes with
+ * a cleanup attribute, on every return path).
+ */
+
+#ifndef HODU_CPU_KERNELS_PROFILE_H
+#define HODU_CPU_KERNELS_PROFILE_H
+
+#include <stdatomic.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// Code paths a kernel call can take (bits of a call's path set)
+typedef enum {
+    HODU_CPU_PATH_SCALAR = 1 << 0,  // no SIMD or BLAS mark (set when the call ends)
+    HODU_CPU_PATH_SIMD = 1 << 1,    // vectorized loop or SIMD micro-kernel
+    HODU_CPU_PATH_BLAS = 1 << 2,    // BLAS / LAPACK library call
+    HODU_CPU_PATH_THREADS = 1 << 3, // work split across more than one pool thread
+} hodu_cpu_path_t;
+
+#define HODU_CPU_PROFILE_NUM_PATHS 4
+
+/// Counters of one kernel, as returned by hodu_cpu_profile_snapshot
+typedef struct {
+    const char *name;   // symbol name, e.g. "hodu_cpu_add_f32"
+    uint64_t calls;     // completed calls
+    uint64_t total_ns;  // wall time summed over calls (nested kernels included)
+    uint64_t max_ns;    // slowest call
+    uint64_t bytes;     // bytes moved over all calls
+    uint64_t max_threads; // most threads one call ran on
+    uint64_t path_calls[HODU_CPU_PROFILE_NUM_PATHS]; // calls that took path bit i
+} hodu_cpu_profile_stats_t;
+
+// ============================================================================
+// QUERIES
+// ============================================================================
+
+/// 1 if the library was built with ENABLE_PROFILE, 0 otherwise
+int hodu_cpu_profile_enabled(void);
+
+/// Copy the counters of up to `capacity` kernels (most total time first) into out
+///
+/// Returns the number of kernels with counters, which may exceed capacity;
+/// pass capacity 0 to query it.
+size_t hodu_cpu_profile_snapshot(hodu_cpu_profile_stats_t *out, size_t capacity);
+
+/// Zero all counters
+void hodu_cpu_profile_reset(void);
+
+/// Start writing trace events to a new file at path (closes an open trace)
+///
+/// Returns 0 on success, -1 if profiling is compiled out or the file cannot
+/// be created.
+int hodu_cpu_profile_trace_begin(const char *path);
+
+/// Finish and close the trace file (no-op without an open trace)
+void hodu_cpu_profile_trace_end(void);
+
+// ============================================================================
+// RECORDING (internal)
+// ============================================================================
+//
+// Each exported kernel starts with
+//
+//   HODU_PROFILE_KERNEL(bytes);
+//
+// which times the call under __func__ into a function-local counter.
+// Helpers mark the paths they run with HODU_PROFILE_PATH(HODU_CPU_PATH_SIMD);
+// marks go to the innermost kernel running on the calling thread, and the
+// thread pool forwards that kernel to its workers for the duration of a
+// parallel_for, which also reports the threads used. Kernels called from
+// other kernels are timed on their own and inside their caller.
+
+#if defined(ENABLE_PROFILE) && (defined(__GNUC__) || defined(__clang__))
+#define HODU_PROFILE_ACTIVE
+#endif
+
+#ifdef HODU_PROFILE_ACTIVE
+
+typedef struct hodu_cpu_profile_counter {
+    const char *name;
+    _Atomic uint64_t calls;
+    _Atomic uint64_t total_ns;
+    _Atomic uint64_t max_ns;
+    _Atomic uint64_t bytes;
+    _Atomic uint64_t max_threads;
+    _Atomic uint64_t path_calls[HODU_CPU_PROFILE_NUM_PATHS];
+    atomic_int registered;
+    struct hodu_cpu_profile_counter *next;
+} hodu_cpu_profile_counter_t;
+
+typedef struct hodu_cpu_profile_scope {
+    hodu_cpu_profile_counter_t *counter;
+    struct hodu_cpu_profile_scope *parent;
+    uint64_t start_ns;
+    uint64_t bytes;
+    atomic_uint paths;
+    atomic_size_t threads;
+} hodu_cpu_profile_scope_t;
+
+void hodu_cpu_profile_scope_begin(hodu_cpu_profile_scope_t *scope,
+                                  hodu_cpu_profile_counter_t *counter, const char *name,
+                                  uint64_t bytes);
+void hodu_cpu_profile_scope_end(hodu_cpu_profile_scope_t *scope);
+
+/// Innermost kernel scope of the calling thread (NULL outside kernels)
+hodu_cpu_profile_scope_t *hodu_cpu_profile_current(void);
+
+/// Make scope the calling thread's current one (thread pool workers); returns the previous one
+hodu_cpu_profile_scope_t *hodu_cpu_profile_set_current(hodu_cpu_profile_scope_t *scope);
+
+/// Add path bits to the current scope
+void hodu_cpu_profile_mark(unsigned paths);
+
+/// Record that the current scope ran a parallel_for on `threads` threads
+void hodu_cpu_profile_threads(size_t threads);
+
+#define HODU_PROFILE_KERNEL(BYTES)                                                                 \
+    static hodu_cpu_profile_counter_t hodu_profile_counter_;                                       \
+    __attribute__((cleanup(hodu_cpu_profile_scope_end))) hodu_cpu_profile_scope_t                  \
+        hodu_profile_scope_;                                                                       \
+    hodu_cpu_profile_scope_begin(&hodu_profile_scope_, &hodu_profile_counter_, __func__,           \
+                                 (uint64_t)(BYTES))
+
+#define HODU_PROFILE_PATH(PATHS) hodu_cpu_profile_mark(PATHS)
+
+// Byte counts shared by kernels of several files (only evaluated when profiling)
+
+/// Product of a shape
+static inline uint64_t hodu_cpu_profile_numel(const size_t *shape, size_t num_dims) {
+    uint64_t n = 1;
+    for (size_t i = 0; i < num_dims; i++) {
+        n *= shape[i];
+    }
+    return n;
+}
+
+/// Input, weight and output bytes of a convolution or its grad_weight (the ops_conv.c
+/// layout: num_els, batch, in/out channels, then input, kernel and output extents)
+static inline uint64_t hodu_cpu_profile_conv_bytes(const size_t *metadata, size_t spatial_dims,
+                                                   size_t elem_size) {
+    const uint64_t in = hodu_cpu_profile_numel(metadata + 4, spatial_dims);
+    const uint64_t kernel = hodu_cpu_profile_numel(metadata + 4 + spatial_dims, spatial_dims);
+    const uint64_t out = hodu_cpu_profile_numel(metadata + 4 + 2 * spatial_dims, spatial_dims);
+    return elem_size * (metadata[1] * metadata[2] * in + metadata[2] * metadata[3] * kernel +
+                        metadata[1] * metadata[3] * out);
+}
+
+/// Operand and output bytes of a matmul (ops_matrix.h layout); the output has the lhs type
+static inline uint64_t hodu_cpu_profile_matmul_bytes(const size_t *metadata, size_t lhs_size,
+                                                     size_t rhs_size) {
+    const uint64_t lhs = hodu_cpu_profile_numel(metadata + 4, metadata[1]);
+    const uint64_t rhs = hodu_cpu_profile_numel(metadata + 4 + metadata[1], metadata[2]);
+    return lhs_size * (lhs + metadata[0]) + rhs_size * rhs;
+}
+
+/// Operand and output bytes of a 2D dot (M, K, N in metadata[0..3])
+static inline uint64_t hodu_cpu_profile_dot_bytes(const size_t *metadata, size_t elem_size) {
+    return elem_size * (metadata[0] * metadata[1] + metadata[1] * metadata[2] +
+                        metadata[0] * metadata[2]);
+}
+
+/// Input, Q and R bytes of a reduced QR decomposition (batch, m, n in metadata[0..3])
+static inline uint64_t hodu_cpu_profile_qr_bytes(const size_t *metadata, size_t elem_size) {
+    const uint64_t m = metadata[1], n = metadata[2], k = m < n ? m : n;
+    return elem_size * metadata[0] * (m * n + m * k + k * n);
+}
+
+#else
+
+#define HODU_PROFILE_KERNEL(BYTES) ((void)0)
+#define HODU_PROFILE_PATH(PATHS) ((void)0)
+
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // HODU_CPU_KERNELS_PROFILE_H
@@ -2,6 +2,7 @@
 #define SIMD_UTILS_H
 
 #include "types.h"
+#include <math.h>
 #include <stddef.h>
 #include <stdint.h>
 
@@ -11,7 +12,7 @@
 //
 // This file provides portable SIMD abstractions that work across platforms:
 // - x86/x86_64: SSE, AVX, AVX2, AVX-512
-// - ARM: NEON
+// - ARM: NEON, fixed-length SVE (-msve-vector-bits=256 or wider)
 // - WASM: SIMD128
 // - Fallback: Auto-vectorization hints for compiler
 //
@@ -26,6 +27,10 @@
 #define SIMD_X86
 #if defined(__AVX512F__)
 #define SIMD_AVX512
+#if defined(__AVX2__)
+// AVX-512 hosts also run the AVX2 primitives below
+#define SIMD_AVX2
+#endif
 #include <immintrin.h>
 #elif defined(__AVX2__)
 #define SIMD_AVX2
@@ -40,6 +45,11 @@
 #elif defined(__ARM_NEON) || defined(__aarch64__)
 #define SIMD_ARM_NEON
 #include <arm_neon.h>
+#if defined(__ARM_FEATURE_SVE) && defined(__ARM_FEATURE_SVE_BITS) && __ARM_FEATURE_SVE_BITS > 128
+// SVE hosts run simd_f32/simd_f64 at the full vector length; other NEON code stays
+#define SIMD_ARM_SVE
+#include <arm_sve.h>
+#endif
 #elif defined(__wasm_simd128__)
 #define SIMD_WASM
 #include <wasm_simd128.h>
@@ -50,7 +60,113 @@
 // F32 SIMD Operations
 // ============================================================================
 
-#ifdef SIMD_AVX2
+#if defined(SIMD_AVX512)
+#define SIMD_F32_WIDTH 16
+typedef __m512 simd_f32_t;
+
+static inline simd_f32_t simd_f32_load(const float *ptr) { return _mm512_loadu_ps(ptr); }
+
+static inline void simd_f32_store(float *ptr, simd_f32_t v) { _mm512_storeu_ps(ptr, v); }
+
+static inline simd_f32_t simd_f32_add(simd_f32_t a, simd_f32_t b) { return _mm512_add_ps(a, b); }
+
+static inline simd_f32_t simd_f32_sub(simd_f32_t a, simd_f32_t b) { return _mm512_sub_ps(a, b); }
+
+static inline simd_f32_t simd_f32_mul(simd_f32_t a, simd_f32_t b) { return _mm512_mul_ps(a, b); }
+
+static inline simd_f32_t simd_f32_div(simd_f32_t a, simd_f32_t b) { return _mm512_div_ps(a, b); }
+
+static inline simd_f32_t simd_f32_set1(float a) { return _mm512_set1_ps(a); }
+
+static inline simd_f32_t simd_f32_fmadd(simd_f32_t a, simd_f32_t b, simd_f32_t c) {
+    return _mm512_fmadd_ps(a, b, c);
+}
+
+// Horizontal sum for matmul dot product
+static inline float simd_f32_reduce_add(simd_f32_t v) { return _mm512_reduce_add_ps(v); }
+
+static inline simd_f32_t simd_f32_max(simd_f32_t a, simd_f32_t b) { return _mm512_max_ps(a, b); }
+
+static inline simd_f32_t simd_f32_min(simd_f32_t a, simd_f32_t b) { return _mm512_min_ps(a, b); }
+
+// Horizontal max for reduction
+static inline float simd_f32_reduce_max(simd_f32_t v) { return _mm512_reduce_max_ps(v); }
+
+// Horizontal min for reduction
+static inline float simd_f32_reduce_min(simd_f32_t v) { return _mm512_reduce_min_ps(v); }
+
+// Additional unary operations (integer forms: the float and/andnot need AVX512DQ)
+static inline simd_f32_t simd_f32_abs(simd_f32_t v) {
+    const __m512i magnitude = _mm512_set1_epi32(0x7fffffff);
+    return _mm512_castsi512_ps(_mm512_and_si512(_mm512_castps_si512(v), magnitude));
+}
+
+static inline simd_f32_t simd_f32_neg(simd_f32_t v) {
+    return _mm512_sub_ps(_mm512_setzero_ps(), v);
+}
+
+static inline simd_f32_t simd_f32_sqrt(simd_f32_t v) { return _mm512_sqrt_ps(v); }
+
+// Comparison masks (all bits set where true) and blending; AVX-512 compares
+// produce k-registers, expanded here so masks keep the vector form of the API
+static inline simd_f32_t simd_f32_mask_from_k(__mmask16 k) {
+    return _mm512_castsi512_ps(_mm512_maskz_set1_epi32(k, -1));
+}
+
+static inline simd_f32_t simd_f32_cmplt(simd_f32_t a, simd_f32_t b) {
+    return simd_f32_mask_from_k(_mm512_cmp_ps_mask(a, b, _CMP_LT_OQ));
+}
+
+static inline simd_f32_t simd_f32_cmple(simd_f32_t a, simd_f32_t b) {
+    return simd_f32_mask_from_k(_mm512_cmp_ps_mask(a, b, _CMP_LE_OQ));
+}
+
+static inline simd_f32_t simd_f32_cmpeq(simd_f32_t a, simd_f32_t b) {
+    return simd_f32_mask_from_k(_mm512_cmp_ps_mask(a, b, _CMP_EQ_OQ));
+}
+
+// mask ? a : b per lane
+static inline simd_f32_t simd_f32_select(simd_f32_t mask, simd_f32_t a, simd_f32_t b) {
+    const __m512i m = _mm512_castps_si512(mask);
+    return _mm512_mask_blend_ps(_mm512_test_epi32_mask(m, m), b, a);
+}
+
+// Round to nearest integer (ties to even)
+static inline simd_f32_t simd_f32_round(simd_f32_t v) {
+    return _mm512_roundscale_ps(v, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+}
+
+// v * 2^n for integral n in [-252, 254] (two exponent steps, so subnormal results round once)
+static inline simd_f32_t simd_f32_ldexp(simd_f32_t v, simd_f32_t n) {
+    const __m512i bias = _mm512_set1_epi32(127);
+    __m512i i = _mm512_cvtps_epi32(n);
+    __m512i h = _mm512_srai_epi32(i, 1);
+    __m512 a = _mm512_castsi512_ps(_mm512_slli_epi32(_mm512_add_epi32(h, bias), 23));
+    __m512i l = _mm512_add_epi32(_mm512_sub_epi32(i, h), bias);
+    __m512 b = _mm512_castsi512_ps(_mm512_slli_epi32(l, 23));
+    return _mm512_mul_ps(_mm512_mul_ps(v, a), b);
+}
+
+// Splits a positive normal v into m * 2^e with m in [0.5, 1)
+static inline simd_f32_t simd_f32_frexp(simd_f32_t v, simd_f32_t *e) {
+    __m512i bits = _mm512_castps_si512(v);
+    __m512i biased = _mm512_srli_epi32(bits, 23);
+    *e = _mm512_cvtepi32_ps(_mm512_sub_epi32(biased, _mm512_set1_epi32(126)));
+    bits = _mm512_and_si512(bits, _mm512_set1_epi32(0x007fffff));
+    return _mm512_castsi512_ps(_mm512_or_si512(bits, _mm512_set1_epi32(0x3f000000)));
+}
+
+// Masked tails: lanes [n, WIDTH) are neither read nor written (no faults past the end)
+#define SIMD_F32_MASKED_TAIL
+static inline simd_f32_t simd_f32_load_partial(const float *ptr, size_t n, simd_f32_t fill) {
+    return _mm512_mask_loadu_ps(fill, (__mmask16)((1u << n) - 1), ptr);
+}
+
+static inline void simd_f32_store_partial(float *ptr, simd_f32_t v, size_t n) {
+    _mm512_mask_storeu_ps(ptr, (__mmask16)((1u << n) - 1), v);
+}
+
+#elif defined(SIMD_AVX2)
 #define SIMD_F32_WIDTH 8
 typedef __m256 simd_f32_t;
 
@@ -130,6 +246,64 @@ static inline simd_f32_t simd_f32_neg(simd_f32_t v) {
 
 static inline simd_f32_t simd_f32_sqrt(simd_f32_t v) { return _mm256_sqrt_ps(v); }
 
+// Comparison masks (all bits set where true) and blending
+static inline simd_f32_t simd_f32_cmplt(simd_f32_t a, simd_f32_t b) {
+    return _mm256_cmp_ps(a, b, _CMP_LT_OQ);
+}
+
+static inline simd_f32_t simd_f32_cmple(simd_f32_t a, simd_f32_t b) {
+    return _mm256_cmp_ps(a, b, _CMP_LE_OQ);
+}
+
+static inline simd_f32_t simd_f32_cmpeq(simd_f32_t a, simd_f32_t b) {
+    return _mm256_cmp_ps(a, b, _CMP_EQ_OQ);
+}
+
+// mask ? a : b per lane
+static inline simd_f32_t simd_f32_select(simd_f32_t mask, simd_f32_t a, simd_f32_t b) {
+    return _mm256_blendv_ps(b, a, mask);
+}
+
+// Round to nearest integer (ties to even)
+static inline simd_f32_t simd_f32_round(simd_f32_t v) {
+    return _mm256_round_ps(v, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+}
+
+// v * 2^n for integral n in [-252, 254] (two exponent steps, so subnormal results round once)
+static inline simd_f32_t simd_f32_ldexp(simd_f32_t v, simd_f32_t n) {
+    const __m256i bias = _mm256_set1_epi32(127);
+    __m256i i = _mm256_cvtps_epi32(n);
+    __m256i h = _mm256_srai_epi32(i, 1);
+    __m256 a = _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_add_epi32(h, bias), 23));
+    __m256i l = _mm256_add_epi32(_mm256_sub_epi32(i, h), bias);
+    __m256 b = _mm256_castsi256_ps(_mm256_slli_epi32(l, 23));
+    return _mm256_mul_ps(_mm256_mul_ps(v, a), b);
+}
+
+// Splits a positive normal v into m * 2^e with m in [0.5, 1)
+static inline simd_f32_t simd_f32_frexp(simd_f32_t v, simd_f32_t *e) {
+    __m256i bits = _mm256_castps_si256(v);
+    __m256i biased = _mm256_srli_epi32(bits, 23);
+    *e = _mm256_cvtepi32_ps(_mm256_sub_epi32(biased, _mm256_set1_epi32(126)));
+    bits = _mm256_and_si256(bits, _mm256_set1_epi32(0x007fffff));
+    return _mm256_castsi256_ps(_mm256_or_si256(bits, _mm256_set1_epi32(0x3f000000)));
+}
+
+// Masked tails: lanes [n, WIDTH) are neither read nor written (no faults past the end)
+#define SIMD_F32_MASKED_TAIL
+static inline __m256i simd_f32_tail_mask(size_t n) {
+    return _mm256_cmpgt_epi32(_mm256_set1_epi32((int)n), _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7));
+}
+
+static inline simd_f32_t simd_f32_load_partial(const float *ptr, size_t n, simd_f32_t fill) {
+    const __m256i mask = simd_f32_tail_mask(n);
+    return _mm256_blendv_ps(fill, _mm256_maskload_ps(ptr, mask), _mm256_castsi256_ps(mask));
+}
+
+static inline void simd_f32_store_partial(float *ptr, simd_f32_t v, size_t n) {
+    _mm256_maskstore_ps(ptr, simd_f32_tail_mask(n), v);
+}
+
 #elif defined(SIMD_SSE2)
 #define SIMD_F32_WIDTH 4
 typedef __m128 simd_f32_t;
@@ -193,6 +367,157 @@ static inline simd_f32_t simd_f32_neg(simd_f32_t v) { return _mm_sub_ps(_mm_setz
 
 static inline simd_f32_t simd_f32_sqrt(simd_f32_t v) { return _mm_sqrt_ps(v); }
 
+// Comparison masks (all bits set where true) and blending
+static inline simd_f32_t simd_f32_cmplt(simd_f32_t a, simd_f32_t b) { return _mm_cmplt_ps(a, b); }
+
+static inline simd_f32_t simd_f32_cmple(simd_f32_t a, simd_f32_t b) { return _mm_cmple_ps(a, b); }
+
+static inline simd_f32_t simd_f32_cmpeq(simd_f32_t a, simd_f32_t b) { return _mm_cmpeq_ps(a, b); }
+
+// mask ? a : b per lane
+static inline simd_f32_t simd_f32_select(simd_f32_t mask, simd_f32_t a, simd_f32_t b) {
+    return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+}
+
+// Round to nearest integer (ties to even, |v| < 2^31)
+static inline simd_f32_t simd_f32_round(simd_f32_t v) {
+    return _mm_cvtepi32_ps(_mm_cvtps_epi32(v));
+}
+
+// v * 2^n for integral n in [-252, 254] (two exponent steps, so subnormal results round once)
+static inline simd_f32_t simd_f32_ldexp(simd_f32_t v, simd_f32_t n) {
+    const __m128i bias = _mm_set1_epi32(127);
+    __m128i i = _mm_cvtps_epi32(n);
+    __m128i h = _mm_srai_epi32(i, 1);
+    __m128 a = _mm_castsi128_ps(_mm_slli_epi32(_mm_add_epi32(h, bias), 23));
+    __m128i l = _mm_add_epi32(_mm_sub_epi32(i, h), bias);
+    __m128 b = _mm_castsi128_ps(_mm_slli_epi32(l, 23));
+    return _mm_mul_ps(_mm_mul_ps(v, a), b);
+}
+
+// Splits a positive normal v into m * 2^e with m in [0.5, 1)
+static inline simd_f32_t simd_f32_frexp(simd_f32_t v, simd_f32_t *e) {
+    __m128i bits = _mm_castps_si128(v);
+    __m128i biased = _mm_srli_epi32(bits, 23);
+    *e = _mm_cvtepi32_ps(_mm_sub_epi32(biased, _mm_set1_epi32(126)));
+    bits = _mm_and_si128(bits, _mm_set1_epi32(0x007fffff));
+    return _mm_castsi128_ps(_mm_or_si128(bits, _mm_set1_epi32(0x3f000000)));
+}
+
+#elif defined(SIMD_ARM_SVE)
+// Fixed-length SVE (-msve-vector-bits): the vector length is a compile-time constant, so
+// vectors can live in arrays and structs like the other backends
+#define SIMD_F32_WIDTH (__ARM_FEATURE_SVE_BITS / 32)
+typedef svfloat32_t simd_f32_t __attribute__((arm_sve_vector_bits(__ARM_FEATURE_SVE_BITS)));
+
+static inline simd_f32_t simd_f32_load(const float *ptr) { return svld1_f32(svptrue_b32(), ptr); }
+
+static inline void simd_f32_store(float *ptr, simd_f32_t v) { svst1_f32(svptrue_b32(), ptr, v); }
+
+static inline simd_f32_t simd_f32_add(simd_f32_t a, simd_f32_t b) {
+    return svadd_f32_x(svptrue_b32(), a, b);
+}
+
+static inline simd_f32_t simd_f32_sub(simd_f32_t a, simd_f32_t b) {
+    return svsub_f32_x(svptrue_b32(), a, b);
+}
+
+static inline simd_f32_t simd_f32_mul(simd_f32_t a, simd_f32_t b) {
+    return svmul_f32_x(svptrue_b32(), a, b);
+}
+
+static inline simd_f32_t simd_f32_div(simd_f32_t a, simd_f32_t b) {
+    return svdiv_f32_x(svptrue_b32(), a, b);
+}
+
+static inline simd_f32_t simd_f32_set1(float a) { return svdup_n_f32(a); }
+
+static inline simd_f32_t simd_f32_fmadd(simd_f32_t a, simd_f32_t b, simd_f32_t c) {
+    return svmla_f32_x(svptrue_b32(), c, a, b); // c + a * b
+}
+
+// Horizontal sum for matmul dot product
+static inline float simd_f32_reduce_add(simd_f32_t v) { return svaddv_f32(svptrue_b32(), v); }
+
+static inline simd_f32_t simd_f32_max(simd_f32_t a, simd_f32_t b) {
+    return svmax_f32_x(svptrue_b32(), a, b);
+}
+
+static inline simd_f32_t simd_f32_min(simd_f32_t a, simd_f32_t b) {
+    return svmin_f32_x(svptrue_b32(), a, b);
+}
+
+// Horizontal max for reduction
+static inline float simd_f32_reduce_max(simd_f32_t v) { return svmaxv_f32(svptrue_b32(), v); }
+
+// Horizontal min for reduction
+static inline float simd_f32_reduce_min(simd_f32_t v) { return svminv_f32(svptrue_b32(), v); }
+
+// Additional unary operations
+static inline simd_f32_t simd_f32_abs(simd_f32_t v) { return svabs_f32_x(svptrue_b32(), v); }
+
+static inline simd_f32_t simd_f32_neg(simd_f32_t v) { return svneg_f32_x(svptrue_b32(), v); }
+
+static inline simd_f32_t simd_f32_sqrt(simd_f32_t v) { return svsqrt_f32_x(svptrue_b32(), v); }
+
+// Comparison masks (all bits set where true) and blending; predicates are expanded to
+// vectors so masks keep the vector form of the API
+static inline simd_f32_t simd_f32_mask_from_pred(svbool_t p) {
+    return svreinterpret_f32_u32(svdup_n_u32_z(p, 0xffffffffu));
+}
+
+static inline simd_f32_t simd_f32_cmplt(simd_f32_t a, simd_f32_t b) {
+    return simd_f32_mask_from_pred(svcmplt_f32(svptrue_b32(), a, b));
+}
+
+static inline simd_f32_t simd_f32_cmple(simd_f32_t a, simd_f32_t b) {
+    return simd_f32_mask_from_pred(svcmple_f32(svptrue_b32(), a, b));
+}
+
+static inline simd_f32_t simd_f32_cmpeq(simd_f32_t a, simd_f32_t b) {
+    return simd_f32_mask_from_pred(svcmpeq_f32(svptrue_b32(), a, b));
+}
+
+// mask ? a : b per lane
+static inline simd_f32_t simd_f32_select(simd_f32_t mask, simd_f32_t a, simd_f32_t b) {
+    return svsel_f32(svcmpne_n_u32(svptrue_b32(), svreinterpret_u32_f32(mask), 0), a, b);
+}
+
+// Round to nearest integer (ties to even)
+static inline simd_f32_t simd_f32_round(simd_f32_t v) { return svrintn_f32_x(svptrue_b32(), v); }
+
+// v * 2^n for integral n in [-252, 254] (two exponent steps, so subnormal results round once)
+static inline simd_f32_t simd_f32_ldexp(simd_f32_t v, simd_f32_t n) {
+    const svbool_t pg = svptrue_b32();
+    svint32_t i = svcvt_s32_f32_x(pg, n);
+    svint32_t h = svasr_n_s32_x(pg, i, 1);
+    svfloat32_t a = svreinterpret_f32_s32(svlsl_n_s32_x(pg, svadd_n_s32_x(pg, h, 127), 23));
+    svint32_t l = svadd_n_s32_x(pg, svsub_s32_x(pg, i, h), 127);
+    svfloat32_t b = svreinterpret_f32_s32(svlsl_n_s32_x(pg, l, 23));
+    return svmul_f32_x(pg, svmul_f32_x(pg, v, a), b);
+}
+
+// Splits a positive normal v into m * 2^e with m in [0.5, 1)
+static inline simd_f32_t simd_f32_frexp(simd_f32_t v, simd_f32_t *e) {
+    const svbool_t pg = svptrue_b32();
+    svuint32_t bits = svreinterpret_u32_f32(v);
+    svint32_t biased = svreinterpret_s32_u32(svlsr_n_u32_x(pg, bits, 23));
+    *e = svcvt_f32_s32_x(pg, svsub_n_s32_x(pg, biased, 126));
+    bits = svand_n_u32_x(pg, bits, 0x007fffff);
+    return svreinterpret_f32_u32(svorr_n_u32_x(pg, bits, 0x3f000000));
+}
+
+// Masked tails: lanes [n, WIDTH) are neither read nor written (no faults past the end)
+#define SIMD_F32_MASKED_TAIL
+static inline simd_f32_t simd_f32_load_partial(const float *ptr, size_t n, simd_f32_t fill) {
+    const svbool_t pg = svwhilelt_b32_u64(0, n);
+    return svsel_f32(pg, svld1_f32(pg, ptr), fill);
+}
+
+static inline void simd_f32_store_partial(float *ptr, simd_f32_t v, size_t n) {
+    svst1_f32(svwhilelt_b32_u64(0, n), ptr, v);
+}
+
 #elif defined(SIMD_ARM_NEON)
 #define SIMD_F32_WIDTH 4
 typedef float32x4_t simd_f32_t;
@@ -207,12 +532,7 @@ static inline simd_f32_t simd_f32_sub(simd_f32_t a, simd_f32_t b) { return vsubq
 
 static inline simd_f32_t simd_f32_mul(simd_f32_t a, simd_f32_t b) { return vmulq_f32(a, b); }
 
-static inline simd_f32_t simd_f32_div(simd_f32_t a, simd_f32_t b) {
-    // ARM NEON doesn't have direct div, use reciprocal estimate + Newton-Raphson
-    float32x4_t recip = vrecpeq_f32(b);
-    recip = vmulq_f32(vrecpsq_f32(b, recip), recip);
-    return vmulq_f32(a, recip);
-}
+static inline simd_f32_t simd_f32_div(simd_f32_t a, simd_f32_t b) { return vdivq_f32(a, b); }
 
 static inline simd_f32_t simd_f32_set1(float a) { return vdupq_n_f32(a); }
 
@@ -242,16 +562,471 @@ static inline simd_f32_t simd_f32_neg(simd_f32_t v) { return vnegq_f32(v); }
 
 static inline simd_f32_t simd_f32_sqrt(simd_f32_t v) { return vsqrtq_f32(v); }
 
+// Comparison masks (all bits set where true) and blending
+static inline simd_f32_t simd_f32_cmplt(simd_f32_t a, simd_f32_t b) {
+    return vreinterpretq_f32_u32(vcltq_f32(a, b));
+}
+
+static inline simd_f32_t simd_f32_cmple(simd_f32_t a, simd_f32_t b) {
+    return vreinterpretq_f32_u32(vcleq_f32(a, b));
+}
+
+static inline simd_f32_t simd_f32_cmpeq(simd_f32_t a, simd_f32_t b) {
+    return vreinterpretq_f32_u32(vceqq_f32(a, b));
+}
+
+// mask ? a : b per lane
+static inline simd_f32_t simd_f32_select(simd_f32_t mask, simd_f32_t a, simd_f32_t b) {
+    return vbslq_f32(vreinterpretq_u32_f32(mask), a, b);
+}
+
+// Round to nearest integer (ties to even)
+static inline simd_f32_t simd_f32_round(simd_f32_t v) { return vrndnq_f32(v); }
+
+// v * 2^n for integral n in [-252, 254] (two exponent steps, so subnormal results round once)
+static inline simd_f32_t simd_f32_ldexp(simd_f32_t v, simd_f32_t n) {
+    const int32x4_t bias = vdupq_n_s32(127);
+    int32x4_t i = vcvtnq_s32_f32(n);
+    int32x4_t h = vshrq_n_s32(i, 1);
+    float32x4_t a = vreinterpretq_f32_s32(vshlq_n_s32(vaddq_s32(h, bias), 23));
+    float32x4_t b = vreinterpretq_f32_s32(vshlq_n_s32(vaddq_s32(vsubq_s32(i, h), bias), 23));
+    return vmulq_f32(vmulq_f32(v, a), b);
+}
+
+// Splits a positive normal v into m * 2^e with m in [0.5, 1)
+static inline simd_f32_t simd_f32_frexp(simd_f32_t v, simd_f32_t *e) {
+    uint32x4_t bits = vreinterpretq_u32_f32(v);
+    int32x4_t biased = vreinterpretq_s32_u32(vshrq_n_u32(bits, 23));
+    *e = vcvtq_f32_s32(vsubq_s32(biased, vdupq_n_s32(126)));
+    bits = vandq_u32(bits, vdupq_n_u32(0x007fffff));
+    return vreinterpretq_f32_u32(vorrq_u32(bits, vdupq_n_u32(0x3f000000)));
+}
+
 #else
 #define SIMD_F32_WIDTH 1
 // No SIMD available, fall back to scalar (compiler may auto-vectorize)
 #endif
 
+// ============================================================================
+// Partial Vectors
+// ============================================================================
+//
+// simd_<type>_load_partial(ptr, n, fill) reads ptr[0, n) into the low lanes and
+// sets the others to fill; simd_<type>_store_partial(ptr, v, n) writes the low
+// n lanes. n <= WIDTH. AVX-512 and SVE use predicated loads/stores and AVX2
+// vmaskmov, neither touching memory past ptr + n; the others go through a
+// stack buffer. Loop tails use them to stay vectorized:
+//   for (; i + WIDTH <= n; i += WIDTH) ... full vectors ...
+//   if (i < n) store_partial(y + i, f(load_partial(x + i, n - i, zero)), n - i);
+
+#if SIMD_F32_WIDTH > 1 && !defined(SIMD_F32_MASKED_TAIL)
+static inline simd_f32_t simd_f32_load_partial(const float *ptr, size_t n, simd_f32_t fill) {
+    float buf[SIMD_F32_WIDTH];
+    simd_f32_store(buf, fill);
+    for (size_t i = 0; i < n; i++)
+        buf[i] = ptr[i];
+    return simd_f32_load(buf);
+}
+
+static inline void simd_f32_store_partial(float *ptr, simd_f32_t v, size_t n) {
+    float buf[SIMD_F32_WIDTH];
+    simd_f32_store(buf, v);
+    for (size_t i = 0; i < n; i++)
+        ptr[i] = buf[i];
+}
+#endif
+
+// ============================================================================
+// F32 SIMD Math Functions
+// ============================================================================
+//
+// Polynomial approximations built only from the primitives above, so every
+// SIMD_F32_WIDTH gets them. Maximum error against a double-precision reference,
+// measured on every 13th f32 bit pattern (AVX2 with FMA and SSE2 without):
+// - simd_f32_exp, simd_f32_exp2: 1.1 ULP
+// - simd_f32_log: 0.9 ULP; simd_f32_log2, simd_f32_log10: 2.1 ULP
+// - simd_f32_tanh: 1.4 ULP
+// - simd_f32_sigmoid: 2.8 ULP (simd_f32_gelu and simd_f32_silu are built on it)
+// - simd_f32_erf: 7.5 ULP (absolute error below 5e-7, largest where erf nears +-1)
+// exp/exp2 overflow to inf like expf but flush results below FLT_MIN to 0, so
+// masked inputs (e.g., -1e9 in a softmax row) never produce subnormals and the
+// microcode stalls that come with them. log follows logf for 0, negative and
+// infinite inputs (subnormal inputs are exact); NaN propagates everywhere.
+
+#if SIMD_F32_WIDTH > 1
+
+// e^r for |r| <= ln(2) / 2 (Cephes expf minimax polynomial)
+static inline simd_f32_t simd_f32_exp_poly(simd_f32_t r) {
+    simd_f32_t p = simd_f32_set1(1.9875691500e-4f);
+    p = simd_f32_fmadd(p, r, simd_f32_set1(1.3981999507e-3f));
+    p = simd_f32_fmadd(p, r, simd_f32_set1(8.3334519073e-3f));
+    p = simd_f32_fmadd(p, r, simd_f32_set1(4.1665795894e-2f));
+    p = simd_f32_fmadd(p, r, simd_f32_set1(1.6666665459e-1f));
+    p = simd_f32_fmadd(p, r, simd_f32_set1(5.0000001201e-1f));
+    p = simd_f32_fmadd(p, simd_f32_mul(r, r), r);
+    return simd_f32_add(p, simd_f32_set1(1.0f));
+}
+
+static inline simd_f32_t simd_f32_exp(simd_f32_t x) {
+    const simd_f32_t lo = simd_f32_set1(-87.3365447505531f); // ln(FLT_MIN)
+    // Clamp so that n stays within simd_f32_ldexp; x is the second operand so NaN passes through
+    simd_f32_t c = simd_f32_max(lo, simd_f32_min(simd_f32_set1(88.8f), x));
+    simd_f32_t n = simd_f32_round(simd_f32_mul(c, simd_f32_set1(1.44269504088896341f)));
+    // r = c - n * ln(2) with ln(2) split so that n * hi is exact
+    simd_f32_t r = simd_f32_fmadd(n, simd_f32_set1(-0.693359375f), c);
+    r = simd_f32_fmadd(n, simd_f32_set1(2.12194440e-4f), r);
+    simd_f32_t y = simd_f32_ldexp(simd_f32_exp_poly(r), n);
+    return simd_f32_select(simd_f32_cmplt(x, lo), simd_f32_set1(0.0f), y);
+}
+
+static inline simd_f32_t simd_f32_exp2(simd_f32_t x) {
+    const simd_f32_t lo = simd_f32_set1(-126.0f);
+    simd_f32_t c = simd_f32_max(lo, simd_f32_min(simd_f32_set1(128.5f), x));
+    simd_f32_t n = simd_f32_round(c);
+    simd_f32_t r = simd_f32_mul(simd_f32_sub(c, n), simd_f32_set1(0.693147180559945309f));
+    simd_f32_t y = simd_f32_ldexp(simd_f32_exp_poly(r), n);
+    return simd_f32_select(simd_f32_cmplt(x, lo), simd_f32_set1(0.0f), y);
+}
+
+// Reduces a positive x to 2^e * (1 + f) with 1 + f in [sqrt(0.5), sqrt(2)); returns f and
+// sets *t so that ln(1 + f) = f + *t (Cephes logf polynomial)
+static inline simd_f32_t simd_f32_log_reduce(simd_f32_t x, simd_f32_t *e, simd_f32_t *t) {
+    const simd_f32_t zero = simd_f32_set1(0.0f);
+    // Scale subnormals into the normal range
+    simd_f32_t sub = simd_f32_cmplt(x, simd_f32_set1(1.17549435e-38f));
+    x = simd_f32_select(sub, simd_f32_mul(x, simd_f32_set1(8388608.0f)), x);
+    simd_f32_t m = simd_f32_frexp(x, e);
+    *e = simd_f32_sub(*e, simd_f32_select(sub, simd_f32_set1(23.0f), zero));
+    simd_f32_t low = simd_f32_cmplt(m, simd_f32_set1(0.707106781186547524f));
+    *e = simd_f32_sub(*e, simd_f32_select(low, simd_f32_set1(1.0f), zero));
+    m = simd_f32_add(m, simd_f32_select(low, m, zero));
+    simd_f32_t f = simd_f32_sub(m, simd_f32_set1(1.0f));
+    simd_f32_t z = simd_f32_mul(f, f);
+    simd_f32_t p = simd_f32_set1(7.0376836292e-2f);
+    p = simd_f32_fmadd(p, f, simd_f32_set1(-1.1514610310e-1f));
+    p = simd_f32_fmadd(p, f, simd_f32_set1(1.1676998740e-1f));
+    p = simd_f32_fmadd(p, f, simd_f32_set1(-1.2420140846e-1f));
+    p = simd_f32_fmadd(p, f, simd_f32_set1(1.4249322787e-1f));
+    p = simd_f32_fmadd(p, f, simd_f32_set1(-1.6668057665e-1f));
+    p = simd_f32_fmadd(p, f, simd_f32_set1(2.0000714765e-1f));
+    p = simd_f32_fmadd(p, f, simd_f32_set1(-2.4999993993e-1f));
+    p = simd_f32_fmadd(p, f, simd_f32_set1(3.3333331174e-1f));
+    *t = simd_f32_fmadd(simd_f32_set1(-0.5f), z, simd_f32_mul(simd_f32_mul(p, f), z));
+    return f;
+}
+
+// log(+inf) = +inf, log(+-0) = -inf, log(x < 0) = log(NaN) = NaN
+static inline simd_f32_t simd_f32_log_special(simd_f32_t x, simd_f32_t y) {
+    const simd_f32_t zero = simd_f32_set1(0.0f);
+    const simd_f32_t inf = simd_f32_set1(INFINITY);
+    y = simd_f32_select(simd_f32_cmpeq(x, inf), inf, y);
+    y = simd_f32_select(simd_f32_cmpeq(x, zero), simd_f32_set1(-INFINITY), y);
+    return simd_f32_select(simd_f32_cmple(zero, x), y, simd_f32_set1(NAN));
+}
+
+static inline simd_f32_t simd_f32_log(simd_f32_t x) {
+    simd_f32_t e, t;
+    simd_f32_t f = simd_f32_log_reduce(x, &e, &t);
+    t = simd_f32_fmadd(e, simd_f32_set1(-2.12194440e-4f), t);
+    simd_f32_t y = simd_f32_fmadd(e, simd_f32_set1(0.693359375f), simd_f32_add(f, t));
+    return simd_f32_log_special(x, y);
+}
+
+static inline simd_f32_t simd_f32_log2(simd_f32_t x) {
+    simd_f32_t e, t;
+    simd_f32_t f = simd_f32_log_reduce(x, &e, &t);
+    simd_f32_t y = simd_f32_fmadd(simd_f32_add(f, t), simd_f32_set1(1.44269504088896341f), e);
+    return simd_f32_log_special(x, y);
+}
+
+static inline simd_f32_t simd_f32_log10(simd_f32_t x) {
+    simd_f32_t e, t;
+    simd_f32_t f = simd_f32_log_reduce(x, &e, &t);
+    simd_f32_t l = simd_f32_add(f, t);
+    // log10(e) and log10(2) split into exact heads and small tails (Cephes log10f)
+    simd_f32_t y = simd_f32_mul(e, simd_f32_set1(2.48745663981195213739e-4f));
+    y = simd_f32_fmadd(l, simd_f32_set1(7.00731903251827651129e-4f), y);
+    y = simd_f32_fmadd(l, simd_f32_set1(4.3359375e-1f), y);
+    y = simd_f32_fmadd(e, simd_f32_set1(3.0078125e-1f), y);
+    return simd_f32_log_special(x, y);
+}
+
+static inline simd_f32_t simd_f32_tanh(simd_f32_t x) {
+    const simd_f32_t one = simd_f32_set1(1.0f);
+    simd_f32_t a = simd_f32_abs(x);
+    // |x| < 0.625: odd polynomial (Cephes tanhf)
+    simd_f32_t z = simd_f32_mul(x, x);
+    simd_f32_t p = simd_f32_set1(-5.70498872745e-3f);
+    p = simd_f32_fmadd(p, z, simd_f32_set1(2.06390887954e-2f));
+    p = simd_f32_fmadd(p, z, simd_f32_set1(-5.37397155531e-2f));
+    p = simd_f32_fmadd(p, z, simd_f32_set1(1.33314422036e-1f));
+    p = simd_f32_fmadd(p, z, simd_f32_set1(-3.33332819422e-1f));
+    simd_f32_t small = simd_f32_fmadd(simd_f32_mul(p, z), x, x);
+    // Otherwise 1 - 2 / (e^(2|x|) + 1) with the sign of x; saturates to 1 as exp overflows
+    simd_f32_t e = simd_f32_exp(simd_f32_add(a, a));
+    simd_f32_t large = simd_f32_sub(one, simd_f32_div(simd_f32_set1(2.0f), simd_f32_add(e, one)));
+    large = simd_f32_select(simd_f32_cmplt(x, simd_f32_set1(0.0f)), simd_f32_neg(large), large);
+    return simd_f32_select(simd_f32_cmplt(a, simd_f32_set1(0.625f)), small, large);
+}
+
+static inline simd_f32_t simd_f32_sigmoid(simd_f32_t x) {
+    // e^-|x| <= 1, so 1 / (1 + e) never overflows and e * r keeps tiny results accurate
+    simd_f32_t e = simd_f32_exp(simd_f32_neg(simd_f32_abs(x)));
+    simd_f32_t r = simd_f32_div(simd_f32_set1(1.0f), simd_f32_add(simd_f32_set1(1.0f), e));
+    return simd_f32_select(simd_f32_cmplt(x, simd_f32_set1(0.0f)), simd_f32_mul(e, r), r);
+}
+
+static inline simd_f32_t simd_f32_erf(simd_f32_t x) {
+    // Odd rational approximation on [-4, 4]; erf rounds to +-1 beyond
+    x = simd_f32_max(simd_f32_set1(-4.0f), simd_f32_min(simd_f32_set1(4.0f), x));
+    simd_f32_t z = simd_f32_mul(x, x);
+    simd_f32_t p = simd_f32_set1(-2.72614225801306e-10f);
+    p = simd_f32_fmadd(p, z, simd_f32_set1(2.77068142495902e-08f));
+    p = simd_f32_fmadd(p, z, simd_f32_set1(-2.10102402082508e-06f));
+    p = simd_f32_fmadd(p, z, simd_f32_set1(-5.69250639462346e-05f));
+    p = simd_f32_fmadd(p, z, simd_f32_set1(-7.34990630326855e-04f));
+    p = simd_f32_fmadd(p, z, simd_f32_set1(-2.95459980854025e-03f));
+    p = simd_f32_fmadd(p, z, simd_f32_set1(-1.60960333262415e-02f));
+    simd_f32_t q = simd_f32_set1(-1.45660718464996e-05f);
+    q = simd_f32_fmadd(q, z, simd_f32_set1(-2.13374055278905e-04f));
+    q = simd_f32_fmadd(q, z, simd_f32_set1(-1.68282697438203e-03f));
+    q = simd_f32_fmadd(q, z, simd_f32_set1(-7.37332916720468e-03f));
+    q = simd_f32_fmadd(q, z, simd_f32_set1(-1.42647390514189e-02f));
+    return simd_f32_mul(x, simd_f32_div(p, q));
+}
+
+// gelu (tanh approximation): 0.5 * (1 + tanh(u)) == sigmoid(2u)
+static inline simd_f32_t simd_f32_gelu(simd_f32_t x) {
+    simd_f32_t x3 = simd_f32_mul(simd_f32_mul(x, x), x);
+    simd_f32_t u = simd_f32_fmadd(simd_f32_set1(0.044715f), x3, x);
+    return simd_f32_mul(x, simd_f32_sigmoid(simd_f32_mul(u, simd_f32_set1(2.0f * 0.7978845608f))));
+}
+
+static inline simd_f32_t simd_f32_silu(simd_f32_t x) {
+    return simd_f32_mul(x, simd_f32_sigmoid(x));
+}
+
+#endif
+
+// ============================================================================
+// Low-Precision Conversion
+// ============================================================================
+//
+// Block converters between the 16/8-bit float storage types and f32, used by
+// the elementwise kernels to widen a block, compute in f32 and narrow back:
+//   simd_widen_<type>(src, dst, n):  <type>[n] -> f32[n]
+//   simd_narrow_<type>(src, dst, n): f32[n] -> <type>[n]
+// Results are bit-identical to the scalar conversions in t_<type>.h on every
+// path, so a tensor never mixes roundings between vector bodies and tails:
+// - bf16: shift (widen) and integer round-to-nearest-even (narrow) on AVX2,
+//   SSE2 and NEON. AVX512-BF16 vcvtneps2bf16 is not used since it flushes
+//   subnormals.
+// - f16: F16C vcvtph2ps/vcvtps2ph on x86 and fcvtl/fcvtn on AArch64; scalar
+//   bit manipulation elsewhere.
+// - f8e4m3/f8e5m2: widening is a 256-entry table lookup (AVX2 gather);
+//   narrowing stays scalar.
+
+static inline void simd_widen_bf16(const bf16_t *src, float *dst, size_t n) {
+    size_t i = 0;
+#if defined(SIMD_AVX2)
+    for (; i + 8 <= n; i += 8) {
+        __m256i h = _mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i *)(src + i)));
+        _mm256_storeu_ps(dst + i, _mm256_castsi256_ps(_mm256_slli_epi32(h, 16)));
+    }
+#elif defined(SIMD_SSE2)
+    const __m128i zero = _mm_setzero_si128();
+    for (; i + 8 <= n; i += 8) {
+        __m128i h = _mm_loadu_si128((const __m128i *)(src + i));
+        _mm_storeu_ps(dst + i, _mm_castsi128_ps(_mm_unpacklo_epi16(zero, h)));
+        _mm_storeu_ps(dst + i + 4, _mm_castsi128_ps(_mm_unpackhi_epi16(zero, h)));
+    }
+#elif defined(SIMD_ARM_NEON)
+    for (; i + 4 <= n; i += 4)
+        vst1q_f32(dst + i, vreinterpretq_f32_u32(vshll_n_u16(vld1_u16(src + i), 16)));
+#endif
+    for (; i < n; i++)
+        dst[i] = bf16_to_float(src[i]);
+}
+
+static inline void simd_narrow_bf16(const float *src, bf16_t *dst, size_t n) {
+    size_t i = 0;
+#if defined(SIMD_AVX2)
+    const __m256i one = _mm256_set1_epi32(1);
+    const __m256i bias = _mm256_set1_epi32(0x7FFF);
+    const __m256i quiet = _mm256_set1_epi32(0x0040);
+    for (; i + 8 <= n; i += 8) {
+        __m256 v = _mm256_loadu_ps(src + i);
+        __m256i bits = _mm256_castps_si256(v);
+        __m256i odd = _mm256_and_si256(_mm256_srli_epi32(bits, 16), one);
+        __m256i r = _mm256_srli_epi32(_mm256_add_epi32(_mm256_add_epi32(bits, bias), odd), 16);
+        __m256i nan = _mm256_or_si256(_mm256_srli_epi32(bits, 16), quiet);
+        r = _mm256_blendv_epi8(r, nan, _mm256_castps_si256(_mm256_cmp_ps(v, v, _CMP_UNORD_Q)));
+        __m128i packed =
+            _mm_packus_epi32(_mm256_castsi256_si128(r), _mm256_extracti128_si256(r, 1));
+        _mm_storeu_si128((__m128i *)(dst + i), packed);
+    }
+#elif defined(SIMD_SSE2)
+    const __m128i one = _mm_set1_epi32(1);
+    const __m128i bias = _mm_set1_epi32(0x7FFF);
+    const __m128i quiet = _mm_set1_epi32(0x0040);
+    for (; i + 8 <= n; i += 8) {
+        __m128i r[2];
+        for (int k = 0; k < 2; k++) {
+            __m128 v = _mm_loadu_ps(src + i + 4 * k);
+            __m128i bits = _mm_castps_si128(v);
+            __m128i odd = _mm_and_si128(_mm_srli_epi32(bits, 16), one);
+            __m128i rn = _mm_srli_epi32(_mm_add_epi32(_mm_add_epi32(bits, bias), odd), 16);
+            __m128i nan = _mm_or_si128(_mm_srli_epi32(bits, 16), quiet);
+            __m128i is_nan = _mm_castps_si128(_mm_cmpunord_ps(v, v));
+            rn = _mm_or_si128(_mm_and_si128(is_nan, nan), _mm_andnot_si128(is_nan, rn));
+            /* Sign-extend the 16-bit results so the signed pack cannot saturate */
+            r[k] = _mm_srai_epi32(_mm_slli_epi32(rn, 16), 16);
+        }
+        _mm_storeu_si128((__m128i *)(dst + i), _mm_packs_epi32(r[0], r[1]));
+    }
+#elif defined(SIMD_ARM_NEON)
+    const uint32x4_t one = vdupq_n_u32(1);
+    const uint32x4_t bias = vdupq_n_u32(0x7FFF);
+    const uint32x4_t quiet = vdupq_n_u32(0x0040);
+    for (; i + 4 <= n; i += 4) {
+        float32x4_t v = vld1q_f32(src + i);
+        uint32x4_t bits = vreinterpretq_u32_f32(v);
+        uint32x4_t odd = vandq_u32(vshrq_n_u32(bits, 16), one);
+        uint32x4_t r = vshrq_n_u32(vaddq_u32(vaddq_u32(bits, bias), odd), 16);
+        uint32x4_t nan = vorrq_u32(vshrq_n_u32(bits, 16), quiet);
+        r = vbslq_u32(vceqq_f32(v, v), r, nan);
+        vst1_u16(dst + i, vmovn_u32(r));
+    }
+#endif
+    for (; i < n; i++)
+        dst[i] = float_to_bf16(src[i]);
+}
+
+static inline void simd_widen_f16(const f16_t *src, float *dst, size_t n) {
+    size_t i = 0;
+#if defined(SIMD_AVX2) && defined(__F16C__)
+    for (; i + 8 <= n; i += 8)
+        _mm256_storeu_ps(dst + i, _mm256_cvtph_ps(_mm_loadu_si128((const __m128i *)(src + i))));
+#elif defined(SIMD_ARM_NEON) && defined(__aarch64__)
+    for (; i + 4 <= n; i += 4)
+        vst1q_f32(dst + i, vcvt_f32_f16(vreinterpret_f16_u16(vld1_u16(src + i))));
+#endif
+    for (; i < n; i++)
+        dst[i] = f16_to_float(src[i]);
+}
+
+static inline void simd_narrow_f16(const float *src, f16_t *dst, size_t n) {
+    size_t i = 0;
+#if defined(SIMD_AVX2) && defined(__F16C__)
+    for (; i + 8 <= n; i += 8) {
+        __m128i h = _mm256_cvtps_ph(_mm256_loadu_ps(src + i),
+                                    _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+        _mm_storeu_si128((__m128i *)(dst + i), h);
+    }
+#elif defined(SIMD_ARM_NEON) && defined(__aarch64__)
+    for (; i + 4 <= n; i += 4)
+        vst1_u16(dst + i, vreinterpret_u16_f16(vcvt_f16_f32(vld1q_f32(src + i))));
+#endif
+    for (; i < n; i++)
+        dst[i] = float_to_f16(src[i]);
+}
+
+static inline void simd_widen_f8e4m3(const f8e4m3_t *src, float *dst, size_t n) {
+    size_t i = 0;
+#if defined(SIMD_AVX2)
+    for (; i + 8 <= n; i += 8) {
+        __m256i idx = _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i *)(src + i)));
+        _mm256_storeu_ps(dst + i, _mm256_i32gather_ps(F8E4M3_TO_FLOAT_LUT, idx, 4));
+    }
+#endif
+    for (; i < n; i++)
+        dst[i] = F8E4M3_TO_FLOAT_LUT[src[i]];
+}
+
+static inline void simd_narrow_f8e4m3(const float *src, f8e4m3_t *dst, size_t n) {
+    for (size_t i = 0; i < n; i++)
+        dst[i] = float_to_f8e4m3(src[i]);
+}
+
+static inline void simd_widen_f8e5m2(const f8e5m2_t *src, float *dst, size_t n) {
+    size_t i = 0;
+#if defined(SIMD_AVX2)
+    for (; i + 8 <= n; i += 8) {
+        __m256i idx = _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i *)(src + i)));
+        _mm256_storeu_ps(dst + i, _mm256_i32gather_ps(F8E5M2_TO_FLOAT_LUT, idx, 4));
+    }
+#endif
+    for (; i < n; i++)
+        dst[i] = F8E5M2_TO_FLOAT_LUT[src[i]];
+}
+
+static inline void simd_narrow_f8e5m2(const float *src, f8e5m2_t *dst, size_t n) {
+    for (size_t i = 0; i < n; i++)
+        dst[i] = float_to_f8e5m2(src[i]);
+}
+
 // ============================================================================
 // F64 SIMD Operations
 // ============================================================================
 
-#ifdef SIMD_AVX2
+#if defined(SIMD_AVX512)
+#define SIMD_F64_WIDTH 8
+typedef __m512d simd_f64_t;
+
+static inline simd_f64_t simd_f64_load(const double *ptr) { return _mm512_loadu_pd(ptr); }
+
+static inline void simd_f64_store(double *ptr, simd_f64_t v) { _mm512_storeu_pd(ptr, v); }
+
+static inline simd_f64_t simd_f64_add(simd_f64_t a, simd_f64_t b) { return _mm512_add_pd(a, b); }
+
+static inline simd_f64_t simd_f64_sub(simd_f64_t a, simd_f64_t b) { return _mm512_sub_pd(a, b); }
+
+static inline simd_f64_t simd_f64_mul(simd_f64_t a, simd_f64_t b) { return _mm512_mul_pd(a, b); }
+
+static inline simd_f64_t simd_f64_div(simd_f64_t a, simd_f64_t b) { return _mm512_div_pd(a, b); }
+
+static inline simd_f64_t simd_f64_set1(double a) { return _mm512_set1_pd(a); }
+
+static inline simd_f64_t simd_f64_fmadd(simd_f64_t a, simd_f64_t b, simd_f64_t c) {
+    return _mm512_fmadd_pd(a, b, c);
+}
+
+// Horizontal sum for matmul dot product
+static inline double simd_f64_reduce_add(simd_f64_t v) { return _mm512_reduce_add_pd(v); }
+
+static inline simd_f64_t simd_f64_max(simd_f64_t a, simd_f64_t b) { return _mm512_max_pd(a, b); }
+
+static inline simd_f64_t simd_f64_min(simd_f64_t a, simd_f64_t b) { return _mm512_min_pd(a, b); }
+
+// Horizontal max for reduction
+static inline double simd_f64_reduce_max(simd_f64_t v) { return _mm512_reduce_max_pd(v); }
+
+// Horizontal min for reduction
+static inline double simd_f64_reduce_min(simd_f64_t v) { return _mm512_reduce_min_pd(v); }
+
+// Additional unary operations for f64 (integer and: the float form needs AVX512DQ)
+static inline simd_f64_t simd_f64_abs(simd_f64_t v) {
+    const __m512i magnitude = _mm512_set1_epi64(0x7fffffffffffffffLL);
+    return _mm512_castsi512_pd(_mm512_and_si512(_mm512_castpd_si512(v), magnitude));
+}
+
+static inline simd_f64_t simd_f64_neg(simd_f64_t v) {
+    return _mm512_sub_pd(_mm512_setzero_pd(), v);
+}
+
+static inline simd_f64_t simd_f64_sqrt(simd_f64_t v) { return _mm512_sqrt_pd(v); }
+
+// Masked tails: lanes [n, WIDTH) are neither read nor written (no faults past the end)
+#define SIMD_F64_MASKED_TAIL
+static inline simd_f64_t simd_f64_load_partial(const double *ptr, size_t n, simd_f64_t fill) {
+    return _mm512_mask_loadu_pd(fill, (__mmask8)((1u << n) - 1), ptr);
+}
+
+static inline void simd_f64_store_partial(double *ptr, simd_f64_t v, size_t n) {
+    _mm512_mask_storeu_pd(ptr, (__mmask8)((1u << n) - 1), v);
+}
+
+#elif defined(SIMD_AVX2)
 #define SIMD_F64_WIDTH 4
 typedef __m256d simd_f64_t;
 
@@ -325,6 +1100,21 @@ static inline simd_f64_t simd_f64_neg(simd_f64_t v) {
 
 static inline simd_f64_t simd_f64_sqrt(simd_f64_t v) { return _mm256_sqrt_pd(v); }
 
+// Masked tails: lanes [n, WIDTH) are neither read nor written (no faults past the end)
+#define SIMD_F64_MASKED_TAIL
+static inline __m256i simd_f64_tail_mask(size_t n) {
+    return _mm256_cmpgt_epi64(_mm256_set1_epi64x((long long)n), _mm256_setr_epi64x(0, 1, 2, 3));
+}
+
+static inline simd_f64_t simd_f64_load_partial(const double *ptr, size_t n, simd_f64_t fill) {
+    const __m256i mask = simd_f64_tail_mask(n);
+    return _mm256_blendv_pd(fill, _mm256_maskload_pd(ptr, mask), _mm256_castsi256_pd(mask));
+}
+
+static inline void simd_f64_store_partial(double *ptr, simd_f64_t v, size_t n) {
+    _mm256_maskstore_pd(ptr, simd_f64_tail_mask(n), v);
+}
+
 #elif defined(SIMD_SSE2)
 #define SIMD_F64_WIDTH 2
 typedef __m128d simd_f64_t;
@@ -382,6 +1172,69 @@ static inline simd_f64_t simd_f64_neg(simd_f64_t v) { return _mm_sub_pd(_mm_setz
 
 static inline simd_f64_t simd_f64_sqrt(simd_f64_t v) { return _mm_sqrt_pd(v); }
 
+#elif defined(SIMD_ARM_SVE)
+#define SIMD_F64_WIDTH (__ARM_FEATURE_SVE_BITS / 64)
+typedef svfloat64_t simd_f64_t __attribute__((arm_sve_vector_bits(__ARM_FEATURE_SVE_BITS)));
+
+static inline simd_f64_t simd_f64_load(const double *ptr) { return svld1_f64(svptrue_b64(), ptr); }
+
+static inline void simd_f64_store(double *ptr, simd_f64_t v) { svst1_f64(svptrue_b64(), ptr, v); }
+
+static inline simd_f64_t simd_f64_add(simd_f64_t a, simd_f64_t b) {
+    return svadd_f64_x(svptrue_b64(), a, b);
+}
+
+static inline simd_f64_t simd_f64_sub(simd_f64_t a, simd_f64_t b) {
+    return svsub_f64_x(svptrue_b64(), a, b);
+}
+
+static inline simd_f64_t simd_f64_mul(simd_f64_t a, simd_f64_t b) {
+    return svmul_f64_x(svptrue_b64(), a, b);
+}
+
+static inline simd_f64_t simd_f64_div(simd_f64_t a, simd_f64_t b) {
+    return svdiv_f64_x(svptrue_b64(), a, b);
+}
+
+static inline simd_f64_t simd_f64_set1(double a) { return svdup_n_f64(a); }
+
+static inline simd_f64_t simd_f64_fmadd(simd_f64_t a, simd_f64_t b, simd_f64_t c) {
+    return svmla_f64_x(svptrue_b64(), c, a, b); // c + a * b
+}
+
+// Horizontal sum for matmul dot product
+static inline double simd_f64_reduce_add(simd_f64_t v) { return svaddv_f64(svptrue_b64(), v); }
+
+static inline simd_f64_t simd_f64_max(simd_f64_t a, simd_f64_t b) {
+    return svmax_f64_x(svptrue_b64(), a, b);
+}
+
+static inline simd_f64_t simd_f64_min(simd_f64_t a, simd_f64_t b) {
+    return svmin_f64_x(svptrue_b64(), a, b);
+}
+
+// Horizontal max for reduction
+static inline double simd_f64_reduce_max(simd_f64_t v) { return svmaxv_f64(svptrue_b64(), v); }
+
+// Horizontal min for reduction
+static inline double simd_f64_reduce_min(simd_f64_t v) { return svminv_f64(svptrue_b64(), v); }
+
+// Additional unary operations for f64
+static inline simd_f64_t simd_f64_abs(simd_f64_t v) { return svabs_f64_x(svptrue_b64(), v); }
+static inline simd_f64_t simd_f64_neg(simd_f64_t v) { return svneg_f64_x(svptrue_b64(), v); }
+static inline simd_f64_t simd_f64_sqrt(simd_f64_t v) { return svsqrt_f64_x(svptrue_b64(), v); }
+
+// Masked tails: lanes [n, WIDTH) are neither read nor written (no faults past the end)
+#define SIMD_F64_MASKED_TAIL
+static inline simd_f64_t simd_f64_load_partial(const double *ptr, size_t n, simd_f64_t fill) {
+    const svbool_t pg = svwhilelt_b64_u64(0, n);
+    return svsel_f64(pg, svld1_f64(pg, ptr), fill);
+}
+
+static inline void simd_f64_store_partial(double *ptr, simd_f64_t v, size_t n) {
+    svst1_f64(svwhilelt_b64_u64(0, n), ptr, v);
+}
+
 #elif defined(SIMD_ARM_NEON)
 #define SIMD_F64_WIDTH 2
 typedef float64x2_t simd_f64_t;
@@ -427,4 +1280,21 @@ static inline simd_f64_t simd_f64_sqrt(simd_f64_t v) { return vsqrtq_f64(v); }
 // No SIMD available
 #endif
 
+#if SIMD_F64_WIDTH > 1 && !defined(SIMD_F64_MASKED_TAIL)
+static inline simd_f64_t simd_f64_load_partial(const double *ptr, size_t n, simd_f64_t fill) {
+    double buf[SIMD_F64_WIDTH];
+    simd_f64_store(buf, fill);
+    for (size_t i = 0; i < n; i++)
+        buf[i] = ptr[i];
+    return simd_f64_load(buf);
+}
+
+static inline void simd_f64_store_partial(double *ptr, simd_f64_t v, size_t n) {
+    double buf[SIMD_F64_WIDTH];
+    simd_f64_store(buf, v);
+    for (size_t i = 0; i < n; i++)
+        ptr[i] = buf[i];
+}
+#endif
+
 #endif // SIMD_UTILS_H
@@ -1,7 +1,16 @@
+#if defined(__linux__) && !defined(_DEFAULT_SOURCE)
+// MAP_ANONYMOUS (not _GNU_SOURCE: it declares exp10, which constants.h defines)
+#define _DEFAULT_SOURCE
+#endif
+
 #include "storage.h"
+#include "profile.h"
 #include "thread_utils.h"
 #include "types.h"
 #include <string.h>
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/mman.h>
+#endif
 
 // ============================================================================
 // STORAGE OPERATION IMPLEMENTATION
@@ -19,21 +28,19 @@
     typedef struct {                                                                               \
         TYPE *output;                                                                              \
         TYPE value;                                                                                \
-        size_t start;                                                                              \
-        size_t end;                                                                                \
         size_t offset;                                                                             \
     } const_set_##TYPE_SUFFIX##_args_t;                                                            \
                                                                                                    \
-    static void *const_set_##TYPE_SUFFIX##_worker(void *arg) {                                     \
+    static void const_set_##TYPE_SUFFIX##_worker(size_t start, size_t end, void *arg) {            \
         const_set_##TYPE_SUFFIX##_args_t *args = (const_set_##TYPE_SUFFIX##_args_t *)arg;          \
-        for (size_t i = args->start; i < args->end; i++) {                                         \
+        for (size_t i = start; i < end; i++) {                                                     \
             args->output[args->offset + i] = args->value;                                          \
         }                                                                                          \
-        return NULL;                                                                               \
     }                                                                                              \
                                                                                                    \
     void hodu_cpu_const_set_##TYPE_SUFFIX(void *output, const size_t *metadata,                    \
                                           const void *value) {                                     \
+        HODU_PROFILE_KERNEL(metadata[0] * sizeof(TYPE));                                           \
         const size_t num_els = metadata[0];                                                        \
         const size_t num_dims = metadata[1];                                                       \
         TYPE *out = (TYPE *)output;                                                                \
@@ -46,37 +53,23 @@
         bool contiguous = is_contiguous(num_dims, dims, strides);                                  \
                                                                                                    \
         if (contiguous) {                                                                          \
-            const size_t min_work_per_thread = 100000;                                             \
-            size_t num_threads = get_optimal_threads(num_els, min_work_per_thread);                \
-                                                                                                   \
-            if (num_threads > 1) {                                                                 \
-                thread_t threads[num_threads];                                                     \
-                const_set_##TYPE_SUFFIX##_args_t args[num_threads];                                \
-                                                                                                   \
-                size_t chunk_size = num_els / num_threads;                                         \
-                size_t remaining = num_els % num_threads;                                          \
-                                                                                                   \
-                for (size_t t = 0; t < num_threads; t++) {                                         \
-                    args[t].output = out;                                                          \
-                    args[t].value = val;                                                           \
-                    args[t].offset = offset;                                                       \
-                    args[t].start = t * chunk_size + (t < remaining ? t : remaining);              \
-                    args[t].end = args[t].start + chunk_size + (t < remaining ? 1 : 0);            \
-                    thread_create(&threads[t], const_set_##TYPE_SUFFIX##_worker, &args[t]);        \
-                }                                                                                  \
-                                                                                                   \
-                for (size_t t = 0; t < num_threads; t++) {                                         \
-                    thread_join(threads[t]);                                                       \
-                }                                                                                  \
-            } else {                                                                               \
-                for (size_t i = 0; i < num_els; i++) {                                             \
-                    out[offset + i] = val;                                                         \
-                }                                                                                  \
-            }                                                                                      \
+            const_set_##TYPE_SUFFIX##_args_t args = {out, val, offset};                            \
+            /* Static slices: first touch places pages where kernels will read them */             \
+            parallel_for_static(0, num_els, task_grain(HODU_CPU_COST_COPY, sizeof(TYPE)),          \
+                                const_set_##TYPE_SUFFIX##_worker, &args);                          \
         } else {                                                                                   \
-            for (size_t i = 0; i < num_els; i++) {                                                 \
-                size_t strided_i = offset + get_strided_index(i, num_dims, dims, strides);         \
-                out[strided_i] = val;                                                              \
+            strided_iter_t it;                                                                     \
+            strided_iter_init(&it, num_dims, dims, strides, 0);                                    \
+            for (size_t i = 0; i < num_els;) {                                                     \
+                /* One innermost row per step: unit-stride rows vectorize */                       \
+                const size_t row_len = strided_iter_row(&it);                                      \
+                const size_t row_offset = offset + it.offset;                                      \
+                const size_t row_stride = it.inner_stride;                                         \
+                for (size_t k = 0; k < row_len; k++, i++) {                                        \
+                    size_t strided_i = row_offset + k * row_stride;                                \
+                    out[strided_i] = val;                                                          \
+                }                                                                                  \
+                strided_iter_advance(&it, row_len);                                                \
             }                                                                                      \
         }                                                                                          \
     }
@@ -100,3 +93,87 @@ IMPL_CONST_SET_OP(i8_t, i8)
 IMPL_CONST_SET_OP(i16_t, i16)
 IMPL_CONST_SET_OP(i32_t, i32)
 IMPL_CONST_SET_OP(i64_t, i64)
+
+// ============================================================================
+// FIRST-TOUCH ALLOCATION
+// ============================================================================
+
+static size_t storage_page_size(void) {
+#if defined(__unix__) || defined(__APPLE__)
+    long page = sysconf(_SC_PAGESIZE);
+    return page > 0 ? (size_t)page : 4096;
+#elif defined(_WIN32)
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return (size_t)info.dwPageSize;
+#else
+    return 4096;
+#endif
+}
+
+typedef struct {
+    uint8_t *base;
+    size_t page_size;
+    size_t bytes;
+} storage_touch_args_t;
+
+static void storage_touch_worker(size_t start, size_t end, void *arg) {
+    const storage_touch_args_t *args = (const storage_touch_args_t *)arg;
+#if defined(__unix__) || defined(__APPLE__) || defined(_WIN32)
+    // Fresh anonymous pages read as zero: one write per page maps it locally
+    for (size_t page = start; page < end; page++) {
+        ((volatile uint8_t *)args->base)[page * args->page_size] = 0;
+    }
+#else
+    size_t begin = start * args->page_size;
+    size_t stop = end * args->page_size < args->bytes ? end * args->page_size : args->bytes;
+    memset(args->base + begin, 0, stop - begin);
+#endif
+}
+
+void *hodu_cpu_storage_alloc(size_t bytes) {
+    HODU_PROFILE_KERNEL(bytes);
+    if (bytes == 0) {
+        return NULL;
+    }
+
+    const size_t page_size = storage_page_size();
+#if defined(__unix__) || defined(__APPLE__)
+    void *base = mmap(NULL, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (base == MAP_FAILED) {
+        return NULL;
+    }
+#elif defined(_WIN32)
+    void *base = VirtualAlloc(NULL, bytes, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+    if (!base) {
+        return NULL;
+    }
+#else
+    size_t rounded = (bytes + page_size - 1) / page_size * page_size;
+    void *base = aligned_alloc(page_size, rounded);
+    if (!base) {
+        return NULL;
+    }
+#endif
+
+    storage_touch_args_t args = {(uint8_t *)base, page_size, bytes};
+    const size_t num_pages = (bytes + page_size - 1) / page_size;
+    parallel_for_static(0, num_pages, task_grain(HODU_CPU_COST_COPY, (double)page_size),
+                        storage_touch_worker, &args);
+    return base;
+}
+
+void hodu_cpu_storage_free(void *ptr, size_t bytes) {
+    if (!ptr) {
+        return;
+    }
+#if defined(__unix__) || defined(__APPLE__)
+    munmap(ptr, bytes);
+#elif defined(_WIN32)
+    (void)bytes;
+    VirtualFree(ptr, 0, MEM_RELEASE);
+#else
+    (void)bytes;
+    free(ptr);
+#endif
+}
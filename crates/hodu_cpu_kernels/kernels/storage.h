@@ -4,8 +4,16 @@
  *
  * Provides storage-level operations for tensors:
  * - const_set: Fill tensor with a constant value
+ * - storage_alloc/storage_free: Zeroed buffers placed by parallel first touch
  *
  * All operations support strided tensor access and multiple data types.
+ *
+ * NUMA placement: a page lands on the node of the thread that first writes it.
+ * storage_alloc touches its pages from the pool, and contiguous const_set
+ * fills, with parallel_for_static: participant p writes the p-th equal slice,
+ * which is where parallel kernels over the same range start their work. On
+ * multi-socket machines (ideally with workers pinned through
+ * hodu_cpu_set_affinity_mask) each worker then mostly reads local memory.
  */
 
 #ifndef HODU_CPU_KERNELS_STORAGE_H
@@ -60,6 +68,23 @@ DECLARE_CONST_SET_OP(i16)
 DECLARE_CONST_SET_OP(i32)
 DECLARE_CONST_SET_OP(i64)
 
+// ============================================================================
+// FIRST-TOUCH ALLOCATION
+// ============================================================================
+//
+// Buffers come from fresh pages (mmap / VirtualAlloc; aligned malloc
+// elsewhere), so no page has been touched before the pool writes it. The
+// split matches kernels of the same thread count: tensors below a few hundred
+// KiB are touched by the caller alone, like the kernels that use them.
+
+/// Allocate `bytes` of zeroed, page-aligned memory first touched across the pool
+///
+/// Returns NULL if bytes is 0 or the allocation fails.
+void *hodu_cpu_storage_alloc(size_t bytes);
+
+/// Free a buffer from hodu_cpu_storage_alloc (`bytes` as passed to it)
+void hodu_cpu_storage_free(void *ptr, size_t bytes);
+
 #ifdef __cplusplus
 }
 #endif
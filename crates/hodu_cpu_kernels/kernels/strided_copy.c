@@ -0,0 +1,449 @@
+#include "strided_copy.h"
+#include "simd_utils.h"
+#include "thread_utils.h"
+#include "workspace.h"
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+// ============================================================================
+// STRIDED COPY ENGINE
+// ============================================================================
+//
+// The view is first planned: size-1 dims are dropped, reversed dims become
+// negative strides from the far end, and neighbouring dims are merged whenever
+// stride[d] == shape[d + 1] * stride[d + 1]. The plan then picks one of:
+// - flat:      a single dim (memcpy when unit-stride), split by elements
+// - transpose: the unit-stride source dim t is not innermost; (t, last) is
+//              copied in COPY_TILE x COPY_TILE tiles so that both the reads
+//              and the writes of a tile stay in L1
+// - rows:      everything else, one inner row at a time (memcpy when the inner
+//              stride is 1, otherwise a strided gather sized to the element)
+
+// Dims the plan can hold after merging (more falls back to per-element indexing)
+#define COPY_MAX_DIMS 16
+
+// Edge of a transpose tile in elements
+#define COPY_TILE 32
+
+/// Merged view: element offsets are base + sum_d idx[d] * strides[d]
+typedef struct {
+    size_t num_dims;
+    size_t shape[COPY_MAX_DIMS];
+    ptrdiff_t strides[COPY_MAX_DIMS];
+    ptrdiff_t base;
+} copy_plan_t;
+
+static bool copy_plan_init(copy_plan_t *plan, size_t num_dims, const size_t *shape,
+                           const size_t *strides, const size_t *reverse) {
+    /* Built innermost first, so contiguous strides and merges need one pass */
+    size_t inner_shape[COPY_MAX_DIMS];
+    ptrdiff_t inner_strides[COPY_MAX_DIMS];
+    size_t nd = 0;
+    size_t contiguous = 1;
+    plan->base = 0;
+    for (size_t d = num_dims; d-- > 0;) {
+        const size_t n = shape[d];
+        ptrdiff_t s = strides ? (ptrdiff_t)strides[d] : (ptrdiff_t)contiguous;
+        contiguous *= n;
+        if (n == 1) {
+            continue;
+        }
+        if (reverse && reverse[d]) {
+            plan->base += (ptrdiff_t)(n - 1) * s;
+            s = -s;
+        }
+        if (nd > 0 && inner_strides[nd - 1] * (ptrdiff_t)inner_shape[nd - 1] == s) {
+            inner_shape[nd - 1] *= n;
+            continue;
+        }
+        if (nd == COPY_MAX_DIMS) {
+            return false;
+        }
+        inner_shape[nd] = n;
+        inner_strides[nd] = s;
+        nd++;
+    }
+    if (nd == 0) {
+        inner_shape[0] = 1;
+        inner_strides[0] = 1;
+        nd = 1;
+    }
+    for (size_t d = 0; d < nd; d++) {
+        plan->shape[d] = inner_shape[nd - 1 - d];
+        plan->strides[d] = inner_strides[nd - 1 - d];
+    }
+    plan->num_dims = nd;
+    return true;
+}
+
+// ============================================================================
+// ROW AND TILE KERNELS
+// ============================================================================
+
+/// Copies n elements: dst[i] = src[i * stride]
+typedef void (*copy_row_fn_t)(const char *src, ptrdiff_t stride, char *dst, size_t n,
+                              size_t elem_size);
+
+/// Copies a rows x cols block: dst[i * dst_rs + j] = src[i + j * src_cs]
+typedef void (*copy_tile_fn_t)(const char *src, ptrdiff_t src_cs, char *dst, size_t dst_rs,
+                               size_t rows, size_t cols, size_t elem_size);
+
+static void copy_row_any(const char *src, ptrdiff_t stride, char *dst, size_t n,
+                         size_t elem_size) {
+    for (size_t i = 0; i < n; i++) {
+        memcpy(dst + i * elem_size, src + (ptrdiff_t)i * stride * (ptrdiff_t)elem_size,
+               elem_size);
+    }
+}
+
+static void copy_tile_any(const char *src, ptrdiff_t src_cs, char *dst, size_t dst_rs,
+                          size_t rows, size_t cols, size_t elem_size) {
+    for (size_t i = 0; i < rows; i++) {
+        copy_row_any(src + i * elem_size, src_cs, dst + i * dst_rs * elem_size, cols, elem_size);
+    }
+}
+
+/**
+ * @brief Macro to implement the row and tile kernels for one element size
+ *
+ * The row kernel special-cases broadcast (stride 0) and reversed (stride -1) rows so
+ * both vectorize; the tile kernel walks the block in COPY_TILE-column strips.
+ */
+#define IMPL_COPY_KERNELS(TYPE, BYTES)                                                             \
+    static void copy_row_##BYTES(const char *src, ptrdiff_t stride, char *dst, size_t n,           \
+                                 size_t elem_size) {                                               \
+        (void)elem_size;                                                                           \
+        const TYPE *s = (const TYPE *)src;                                                         \
+        TYPE *d = (TYPE *)dst;                                                                     \
+        if (stride == 0) {                                                                         \
+            const TYPE v = s[0];                                                                   \
+            for (size_t i = 0; i < n; i++) {                                                       \
+                d[i] = v;                                                                          \
+            }                                                                                      \
+        } else if (stride == -1) {                                                                 \
+            for (size_t i = 0; i < n; i++) {                                                       \
+                d[i] = *(s - i);                                                                   \
+            }                                                                                      \
+        } else {                                                                                   \
+            for (size_t i = 0; i < n; i++) {                                                       \
+                d[i] = s[(ptrdiff_t)i * stride];                                                   \
+            }                                                                                      \
+        }                                                                                          \
+    }                                                                                              \
+                                                                                                   \
+    static void copy_tile_##BYTES##_scalar(const TYPE *s, ptrdiff_t src_cs, TYPE *d,               \
+                                           size_t dst_rs, size_t rows, size_t j0, size_t j1) {     \
+        for (size_t i = 0; i < rows; i++) {                                                        \
+            for (size_t j = j0; j < j1; j++) {                                                     \
+                d[i * dst_rs + j] = s[i + (ptrdiff_t)j * src_cs];                                  \
+            }                                                                                      \
+        }                                                                                          \
+    }
+
+IMPL_COPY_KERNELS(uint8_t, 1)
+IMPL_COPY_KERNELS(uint16_t, 2)
+IMPL_COPY_KERNELS(uint32_t, 4)
+IMPL_COPY_KERNELS(uint64_t, 8)
+
+#define IMPL_COPY_TILE(TYPE, BYTES)                                                                \
+    static void copy_tile_##BYTES(const char *src, ptrdiff_t src_cs, char *dst, size_t dst_rs,     \
+                                  size_t rows, size_t cols, size_t elem_size) {                    \
+        (void)elem_size;                                                                           \
+        for (size_t jb = 0; jb < cols; jb += COPY_TILE) {                                          \
+            const size_t je = (cols - jb < COPY_TILE) ? cols : jb + COPY_TILE;                     \
+            copy_tile_##BYTES##_scalar((const TYPE *)src, src_cs, (TYPE *)dst, dst_rs, rows, jb,   \
+                                       je);                                                        \
+        }                                                                                          \
+    }
+
+IMPL_COPY_TILE(uint8_t, 1)
+IMPL_COPY_TILE(uint16_t, 2)
+IMPL_COPY_TILE(uint64_t, 8)
+
+#if defined(SIMD_AVX2) || defined(SIMD_AVX) || defined(SIMD_SSE2) || defined(SIMD_ARM_NEON)
+/// 4x4 block of 4-byte elements: columns of the source are rows of the destination
+static inline void copy_transpose_4x4(const uint32_t *s, ptrdiff_t src_cs, uint32_t *d,
+                                      size_t dst_rs) {
+#if defined(SIMD_ARM_NEON)
+    float32x4_t c0 = vld1q_f32((const float *)s);
+    float32x4_t c1 = vld1q_f32((const float *)(s + src_cs));
+    float32x4_t c2 = vld1q_f32((const float *)(s + 2 * src_cs));
+    float32x4_t c3 = vld1q_f32((const float *)(s + 3 * src_cs));
+    float32x4x2_t t01 = vtrnq_f32(c0, c1);
+    float32x4x2_t t23 = vtrnq_f32(c2, c3);
+    vst1q_f32((float *)d, vcombine_f32(vget_low_f32(t01.val[0]), vget_low_f32(t23.val[0])));
+    vst1q_f32((float *)(d + dst_rs),
+              vcombine_f32(vget_low_f32(t01.val[1]), vget_low_f32(t23.val[1])));
+    vst1q_f32((float *)(d + 2 * dst_rs),
+              vcombine_f32(vget_high_f32(t01.val[0]), vget_high_f32(t23.val[0])));
+    vst1q_f32((float *)(d + 3 * dst_rs),
+              vcombine_f32(vget_high_f32(t01.val[1]), vget_high_f32(t23.val[1])));
+#else
+    __m128 c0 = _mm_loadu_ps((const float *)s);
+    __m128 c1 = _mm_loadu_ps((const float *)(s + src_cs));
+    __m128 c2 = _mm_loadu_ps((const float *)(s + 2 * src_cs));
+    __m128 c3 = _mm_loadu_ps((const float *)(s + 3 * src_cs));
+    _MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+    _mm_storeu_ps((float *)d, c0);
+    _mm_storeu_ps((float *)(d + dst_rs), c1);
+    _mm_storeu_ps((float *)(d + 2 * dst_rs), c2);
+    _mm_storeu_ps((float *)(d + 3 * dst_rs), c3);
+#endif
+}
+
+static void copy_tile_4(const char *src, ptrdiff_t src_cs, char *dst, size_t dst_rs, size_t rows,
+                        size_t cols, size_t elem_size) {
+    (void)elem_size;
+    const uint32_t *s = (const uint32_t *)src;
+    uint32_t *d = (uint32_t *)dst;
+    for (size_t jb = 0; jb < cols; jb += COPY_TILE) {
+        const size_t je = (cols - jb < COPY_TILE) ? cols : jb + COPY_TILE;
+        const size_t je4 = jb + (je - jb) / 4 * 4;
+        size_t i = 0;
+        for (; i + 4 <= rows; i += 4) {
+            for (size_t j = jb; j < je4; j += 4) {
+                copy_transpose_4x4(s + i + (ptrdiff_t)j * src_cs, src_cs, d + i * dst_rs + j,
+                                   dst_rs);
+            }
+            copy_tile_4_scalar(s + i, src_cs, d + i * dst_rs, dst_rs, 4, je4, je);
+        }
+        copy_tile_4_scalar(s + i, src_cs, d + i * dst_rs, dst_rs, rows - i, jb, je);
+    }
+}
+#else
+IMPL_COPY_TILE(uint32_t, 4)
+#endif
+
+// ============================================================================
+// WORKERS
+// ============================================================================
+
+typedef struct {
+    const copy_plan_t *plan;
+    const char *src; // first byte of the view's base element
+    char *dst;
+    size_t elem_size;
+    copy_row_fn_t row;
+    copy_tile_fn_t tile;
+    size_t tdim;      // transpose: unit-stride source dim
+    size_t row_tiles; // transpose: COPY_TILE row blocks along tdim
+} copy_args_t;
+
+/// Single dim: elements [start, end)
+static void copy_flat_worker(size_t start, size_t end, void *arg) {
+    const copy_args_t *args = (const copy_args_t *)arg;
+    const ptrdiff_t s = args->plan->strides[0];
+    const size_t es = args->elem_size;
+    const char *src = args->src + (ptrdiff_t)start * s * (ptrdiff_t)es;
+    if (s == 1) {
+        memcpy(args->dst + start * es, src, (end - start) * es);
+    } else {
+        args->row(src, s, args->dst + start * es, end - start, es);
+    }
+}
+
+/// Inner rows [start, end): seek once, then carry through the outer dims per row
+static void copy_rows_worker(size_t start, size_t end, void *arg) {
+    const copy_args_t *args = (const copy_args_t *)arg;
+    const copy_plan_t *plan = args->plan;
+    const size_t last = plan->num_dims - 1;
+    const size_t n = plan->shape[last];
+    const ptrdiff_t s = plan->strides[last];
+    const size_t es = args->elem_size;
+
+    size_t idx[COPY_MAX_DIMS];
+    ptrdiff_t off = 0;
+    size_t rem = start;
+    for (size_t d = last; d-- > 0;) {
+        idx[d] = rem % plan->shape[d];
+        rem /= plan->shape[d];
+        off += (ptrdiff_t)idx[d] * plan->strides[d];
+    }
+
+    for (size_t r = start; r < end; r++) {
+        const char *src = args->src + off * (ptrdiff_t)es;
+        char *dst = args->dst + r * n * es;
+        if (s == 1) {
+            memcpy(dst, src, n * es);
+        } else {
+            args->row(src, s, dst, n, es);
+        }
+        for (size_t d = last; d-- > 0;) {
+            off += plan->strides[d];
+            if (++idx[d] < plan->shape[d]) {
+                break;
+            }
+            off -= (ptrdiff_t)plan->shape[d] * plan->strides[d];
+            idx[d] = 0;
+        }
+    }
+}
+
+/// Transpose items [start, end): item = (outer position, COPY_TILE rows of tdim)
+static void copy_transpose_worker(size_t start, size_t end, void *arg) {
+    const copy_args_t *args = (const copy_args_t *)arg;
+    const copy_plan_t *plan = args->plan;
+    const size_t last = plan->num_dims - 1;
+    const size_t t = args->tdim;
+    const size_t rows = plan->shape[t];
+    const size_t cols = plan->shape[last];
+    const ptrdiff_t src_cs = plan->strides[last];
+    const size_t es = args->elem_size;
+
+    /* Destination (row-major) strides of every dim */
+    size_t dst_strides[COPY_MAX_DIMS];
+    size_t acc = 1;
+    for (size_t d = plan->num_dims; d-- > 0;) {
+        dst_strides[d] = acc;
+        acc *= plan->shape[d];
+    }
+
+    for (size_t item = start; item < end; item++) {
+        size_t outer = item / args->row_tiles;
+        const size_t i0 = (item % args->row_tiles) * COPY_TILE;
+        const size_t n = (rows - i0 < COPY_TILE) ? rows - i0 : COPY_TILE;
+
+        ptrdiff_t soff = (ptrdiff_t)i0;
+        size_t doff = i0 * dst_strides[t];
+        for (size_t d = last; d-- > 0;) {
+            if (d == t) {
+                continue;
+            }
+            const size_t i = outer % plan->shape[d];
+            outer /= plan->shape[d];
+            soff += (ptrdiff_t)i * plan->strides[d];
+            doff += i * dst_strides[d];
+        }
+        args->tile(args->src + soff * (ptrdiff_t)es, src_cs, args->dst + doff * es,
+                   dst_strides[t], n, cols, es);
+    }
+}
+
+/// Plans that do not fit COPY_MAX_DIMS: index every element from the original layout
+static void copy_fallback(const char *src, char *dst, size_t elem_size, size_t num_dims,
+                          const size_t *shape, const size_t *strides, const size_t *reverse,
+                          size_t num_els) {
+    for (size_t i = 0; i < num_els; i++) {
+        size_t rem = i;
+        size_t contiguous = 1;
+        ptrdiff_t off = 0;
+        for (size_t d = num_dims; d-- > 0;) {
+            size_t c = rem % shape[d];
+            rem /= shape[d];
+            if (reverse && reverse[d]) {
+                c = shape[d] - 1 - c;
+            }
+            off += (ptrdiff_t)c * (ptrdiff_t)(strides ? strides[d] : contiguous);
+            contiguous *= shape[d];
+        }
+        memcpy(dst + i * elem_size, src + off * (ptrdiff_t)elem_size, elem_size);
+    }
+}
+
+// ============================================================================
+// ENTRY POINT
+// ============================================================================
+
+void hodu_cpu_strided_copy(const void *src, void *dst, size_t elem_size, size_t num_dims,
+                           const size_t *shape, const size_t *strides, const size_t *reverse) {
+    size_t num_els = 1;
+    for (size_t d = 0; d < num_dims; d++) {
+        num_els *= shape[d];
+    }
+    if (num_els == 0) {
+        return;
+    }
+
+    copy_plan_t plan;
+    if (!copy_plan_init(&plan, num_dims, shape, strides, reverse)) {
+        copy_fallback((const char *)src, (char *)dst, elem_size, num_dims, shape, strides,
+                      reverse, num_els);
+        return;
+    }
+
+    copy_args_t args = {&plan, (const char *)src + plan.base * (ptrdiff_t)elem_size,
+                        (char *)dst, elem_size, copy_row_any, copy_tile_any, 0, 0};
+    switch (elem_size) {
+    case 1:
+        args.row = copy_row_1;
+        args.tile = copy_tile_1;
+        break;
+    case 2:
+        args.row = copy_row_2;
+        args.tile = copy_tile_2;
+        break;
+    case 4:
+        args.row = copy_row_4;
+        args.tile = copy_tile_4;
+        break;
+    case 8:
+        args.row = copy_row_8;
+        args.tile = copy_tile_8;
+        break;
+    default:
+        break;
+    }
+
+    const size_t last = plan.num_dims - 1;
+    if (last == 0) {
+        parallel_for(0, num_els, task_grain(HODU_CPU_COST_COPY, elem_size), copy_flat_worker,
+                     &args);
+        return;
+    }
+
+    /* Transpose when the source's unit-stride dim sits further out than the innermost dim */
+    if (plan.strides[last] != 1 && plan.shape[last] >= 4) {
+        for (size_t d = 0; d < last; d++) {
+            if (plan.strides[d] == 1 && plan.shape[d] >= 4) {
+                args.tdim = d;
+                args.row_tiles = (plan.shape[d] + COPY_TILE - 1) / COPY_TILE;
+                const size_t items = num_els / (plan.shape[d] * plan.shape[last]) * args.row_tiles;
+                const size_t item_bytes = COPY_TILE * plan.shape[last] * elem_size;
+                parallel_for(0, items, task_grain(HODU_CPU_COST_COPY, item_bytes),
+                             copy_transpose_worker, &args);
+                return;
+            }
+        }
+    }
+
+    const size_t row_bytes = plan.shape[last] * elem_size;
+    parallel_for(0, num_els / plan.shape[last], task_grain(HODU_CPU_COST_COPY, row_bytes),
+                 copy_rows_worker, &args);
+}
+
+void *hodu_cpu_stage_overlapping_view(const void *src, size_t elem_size, size_t num_dims,
+                                      const size_t *shape, const size_t *strides,
+                                      const void *dst, size_t dst_elem_size) {
+    size_t num_els = 1;
+    size_t extent = 0;
+    bool row_major = true;
+    for (size_t d = num_dims; d-- > 0;) {
+        if (shape[d] == 0) {
+            return NULL;
+        }
+        const size_t s = strides ? strides[d] : num_els;
+        if (shape[d] > 1) {
+            extent += (shape[d] - 1) * s;
+            row_major = row_major && s == num_els;
+        }
+        num_els *= shape[d];
+    }
+
+    const uintptr_t lo = (uintptr_t)src;
+    const uintptr_t hi = lo + (extent + 1) * elem_size;
+    const uintptr_t out_lo = (uintptr_t)dst;
+    const uintptr_t out_hi = out_lo + num_els * dst_elem_size;
+    if (hi <= out_lo || out_hi <= lo) {
+        return NULL;
+    }
+    if (lo == out_lo && row_major && elem_size == dst_elem_size) {
+        return NULL;
+    }
+
+    void *copy = workspace_acquire(num_els * elem_size);
+    if (copy) {
+        hodu_cpu_strided_copy(src, copy, elem_size, num_dims, shape, strides, NULL);
+    }
+    return copy;
+}
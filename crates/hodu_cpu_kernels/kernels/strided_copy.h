@@ -0,0 +1,67 @@
+/**
+ * @file strided_copy.h
+ * @brief Strided copy engine for layout changes
+ *
+ * Copies any strided view (permuted, sliced, broadcast or reversed) into a
+ * contiguous row-major buffer. Used by contiguous and flip, and by any kernel
+ * that needs to materialize a view:
+ * - Adjacent dims whose strides line up are merged and size-1 dims dropped
+ * - Unit-stride inner runs are copied with memcpy
+ * - 2D permutations (the source's unit-stride dim is not innermost) run as a
+ *   cache-blocked transpose with a 4x4 SIMD micro-kernel for 4-byte elements
+ * - Everything else gathers whole inner rows with a per-element-size loop
+ * All paths split the output over the thread pool.
+ */
+
+#ifndef HODU_CPU_KERNELS_STRIDED_COPY_H
+#define HODU_CPU_KERNELS_STRIDED_COPY_H
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// Copy a strided view into contiguous memory
+///
+/// Element (i_0, ..., i_{n-1}) of the view is read from
+///   src + sum_d (reverse && reverse[d] ? shape[d] - 1 - i_d : i_d) * strides[d]
+/// (in elements) and written to dst in row-major order.
+///
+/// @param src First element of the view (offset already applied)
+/// @param dst Contiguous output of prod(shape) elements; must not overlap src
+/// @param elem_size Bytes per element
+/// @param num_dims Number of dimensions
+/// @param shape Extent of each dimension
+/// @param strides Element stride of each dimension, or NULL for a contiguous source
+/// @param reverse Per-dimension flags (nonzero = read backwards), or NULL
+void hodu_cpu_strided_copy(const void *src, void *dst, size_t elem_size, size_t num_dims,
+                           const size_t *shape, const size_t *strides, const size_t *reverse);
+
+/// Copy of an input view that overlaps the output of a kernel, or NULL if it can be read as is
+///
+/// Elementwise kernels write output element i right after reading input element i, and
+/// only from the same thread. They may therefore run in place when the view sits exactly on
+/// the output: it starts at dst, is row-major contiguous, and has the output's element size.
+/// Any other overlap between the view and the prod(shape) output elements would read
+/// elements that were already overwritten; such views are copied into a contiguous
+/// workspace block, which the caller reads instead and returns with workspace_release.
+///
+/// @param src First element of the view (offset already applied)
+/// @param elem_size Bytes per view element
+/// @param num_dims Number of dimensions
+/// @param shape Extent of each dimension (also the output shape)
+/// @param strides Element stride of each dimension, or NULL for a contiguous view
+/// @param dst Output buffer
+/// @param dst_elem_size Bytes per output element
+/// @return NULL when the kernel can read src directly (or no workspace block was available),
+///         otherwise the staged copy
+void *hodu_cpu_stage_overlapping_view(const void *src, size_t elem_size, size_t num_dims,
+                                      const size_t *shape, const size_t *strides,
+                                      const void *dst, size_t dst_elem_size);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // HODU_CPU_KERNELS_STRIDED_COPY_H
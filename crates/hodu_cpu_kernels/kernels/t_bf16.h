@@ -32,9 +32,13 @@ static inline float bf16_to_float(bf16_t val) {
     return result;
 }
 
+// Rounds to nearest even; NaNs stay NaN (quieted, sign kept)
 static inline bf16_t float_to_bf16(float val) {
     uint32_t bits;
     memcpy(&bits, &val, sizeof(float));
+    if ((bits & 0x7FFFFFFF) > 0x7F800000)
+        return (bf16_t)((bits >> 16) | 0x0040);
+    bits += 0x7FFF + ((bits >> 16) & 1);
     return (bf16_t)(bits >> 16);
 }
 
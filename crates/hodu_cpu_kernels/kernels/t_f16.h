@@ -3,6 +3,7 @@
 
 #include <math.h>
 #include <stdint.h>
+#include <string.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -24,56 +25,58 @@ typedef uint16_t f16_t;
 // CONVERSION
 // ============================================================================
 
-static inline float f16_to_float(f16_t val) {
-    uint32_t sign = (val >> 15) & 1;
-    uint32_t exp = (val >> 10) & 0x1F;
-    uint32_t mant = val & 0x3FF;
-
-    if (exp == 0x1F) {
-        if (mant == 0)
-            return sign ? -INFINITY : INFINITY;
-        return NAN;
-    }
+// Both conversions are bit-exact with the hardware ones (F16C vcvtph2ps/vcvtps2ph, ARM
+// fcvt) used by simd_utils.h: round to nearest even, subnormals kept, NaNs quieted with
+// sign and payload kept.
 
-    if (exp == 0) {
-        if (mant == 0)
-            return sign ? -0.0f : 0.0f;
-        return ldexpf((float)mant / 1024.0f, -14) * (sign ? -1.0f : 1.0f);
+static inline float f16_to_float(f16_t val) {
+    uint32_t sign = (uint32_t)(val & 0x8000) << 16;
+    uint32_t abs = val & 0x7FFF;
+    uint32_t bits;
+
+    if (abs >= 0x7C00) {
+        // Inf/NaN: all-ones exponent
+        bits = 0x7F800000 | ((abs & 0x3FF) << 13);
+        if (abs & 0x3FF)
+            bits |= 0x00400000;
+    } else if (abs >= 0x0400) {
+        // Normal: rebias the exponent from 15 to 127
+        bits = (abs << 13) + 0x38000000;
+    } else {
+        // Zero/subnormal: mant * 2^-24 is exact in f32
+        float f = (float)abs * 5.9604644775390625e-8f;
+        memcpy(&bits, &f, sizeof(float));
     }
+    bits |= sign;
 
-    float result = ldexpf(1.0f + (float)mant / 1024.0f, (int)exp - 15);
-    return sign ? -result : result;
+    float result;
+    memcpy(&result, &bits, sizeof(float));
+    return result;
 }
 
 static inline f16_t float_to_f16(float val) {
-    if (val == 0.0f)
-        return 0;
-    if (isnan(val))
-        return 0x7E00;
-
-    uint32_t sign = val < 0 ? 1 : 0;
-    val = fabsf(val);
-
-    if (isinf(val) || val > 65504.0f)
-        return (sign << 15) | 0x7C00;
-    if (val < 0.00006103515625f)
-        return sign << 15;
-
-    int exp;
-    float mant = frexpf(val, &exp);
-    exp += 14;
-
-    if (exp <= 0) {
-        mant = ldexpf(mant, exp);
-        exp = 0;
-    } else if (exp >= 31) {
-        return (sign << 15) | 0x7C00;
+    uint32_t bits;
+    memcpy(&bits, &val, sizeof(float));
+    uint32_t sign = (bits >> 16) & 0x8000;
+    uint32_t abs = bits & 0x7FFFFFFF;
+
+    if (abs > 0x7F800000)
+        return (f16_t)(sign | 0x7E00 | ((abs >> 13) & 0x3FF));
+    if (abs >= 0x477FF000) // >= 65520 rounds to infinity
+        return (f16_t)(sign | 0x7C00);
+    if (abs < 0x38800000) {
+        // Below 2^-14: adding 0.5 aligns the result's subnormal mantissa to the low bits,
+        // and the f32 addition rounds it to nearest even
+        float f;
+        memcpy(&f, &abs, sizeof(float));
+        f += 0.5f;
+        memcpy(&abs, &f, sizeof(float));
+        return (f16_t)(sign | (abs - 0x3F000000));
     }
 
-    int mant_bits = (int)((mant * 2.0f - 1.0f) * 1024.0f + 0.5f);
-    mant_bits = mant_bits > 1023 ? 1023 : mant_bits;
-
-    return (sign << 15) | (exp << 10) | mant_bits;
+    // Normal: rebias the exponent from 127 to 15 and round the dropped 13 bits to even
+    abs += 0xC8000FFF + ((abs >> 13) & 1);
+    return (f16_t)(sign | (abs >> 13));
 }
 
 // ============================================================================
@@ -24,30 +24,38 @@ typedef uint8_t f8e4m3_t;
 // CONVERSION
 // ============================================================================
 
-static inline float f8e4m3_to_float(f8e4m3_t val) {
-    uint32_t sign = (val >> 7) & 1;
-    uint32_t exp = (val >> 3) & 0xF;
-    uint32_t mant = val & 0x7;
-
-    // E4M3 uses bias of 7
-    // Special values: exp=15 is infinity/NaN
-    if (exp == 15) {
-        if (mant == 0)
-            return sign ? -INFINITY : INFINITY;
-        return NAN;
-    }
-
-    if (exp == 0) {
-        if (mant == 0)
-            return sign ? -0.0f : 0.0f;
-        // Subnormal: 2^(-6) * (mant/8)
-        return ldexpf((float)mant / 8.0f, -6) * (sign ? -1.0f : 1.0f);
-    }
-
-    // Normal: 2^(exp-7) * (1 + mant/8)
-    float result = ldexpf(1.0f + (float)mant / 8.0f, (int)exp - 7);
-    return sign ? -result : result;
-}
+// Decoding table, index = encoded byte. Bias 7; exp=15 encodes infinity (mant=0) or NaN;
+// exp=0 encodes zero/subnormals 2^-6 * mant/8; otherwise 2^(exp-7) * (1 + mant/8).
+static const float F8E4M3_TO_FLOAT_LUT[256] = {
+    0.0f, 0.001953125f, 0.00390625f, 0.005859375f, 0.0078125f, 0.009765625f, 0.01171875f,
+    0.013671875f, 0.015625f, 0.017578125f, 0.01953125f, 0.021484375f, 0.0234375f, 0.025390625f,
+    0.02734375f, 0.029296875f, 0.03125f, 0.03515625f, 0.0390625f, 0.04296875f, 0.046875f,
+    0.05078125f, 0.0546875f, 0.05859375f, 0.0625f, 0.0703125f, 0.078125f, 0.0859375f, 0.09375f,
+    0.1015625f, 0.109375f, 0.1171875f, 0.125f, 0.140625f, 0.15625f, 0.171875f, 0.1875f, 0.203125f,
+    0.21875f, 0.234375f, 0.25f, 0.28125f, 0.3125f, 0.34375f, 0.375f, 0.40625f, 0.4375f, 0.46875f,
+    0.5f, 0.5625f, 0.625f, 0.6875f, 0.75f, 0.8125f, 0.875f, 0.9375f, 1.0f, 1.125f, 1.25f, 1.375f,
+    1.5f, 1.625f, 1.75f, 1.875f, 2.0f, 2.25f, 2.5f, 2.75f, 3.0f, 3.25f, 3.5f, 3.75f, 4.0f, 4.5f,
+    5.0f, 5.5f, 6.0f, 6.5f, 7.0f, 7.5f, 8.0f, 9.0f, 10.0f, 11.0f, 12.0f, 13.0f, 14.0f, 15.0f, 16.0f,
+    18.0f, 20.0f, 22.0f, 24.0f, 26.0f, 28.0f, 30.0f, 32.0f, 36.0f, 40.0f, 44.0f, 48.0f, 52.0f,
+    56.0f, 60.0f, 64.0f, 72.0f, 80.0f, 88.0f, 96.0f, 104.0f, 112.0f, 120.0f, 128.0f, 144.0f, 160.0f,
+    176.0f, 192.0f, 208.0f, 224.0f, 240.0f, INFINITY, NAN, NAN, NAN, NAN, NAN, NAN, NAN, -0.0f,
+    -0.001953125f, -0.00390625f, -0.005859375f, -0.0078125f, -0.009765625f, -0.01171875f,
+    -0.013671875f, -0.015625f, -0.017578125f, -0.01953125f, -0.021484375f, -0.0234375f,
+    -0.025390625f, -0.02734375f, -0.029296875f, -0.03125f, -0.03515625f, -0.0390625f, -0.04296875f,
+    -0.046875f, -0.05078125f, -0.0546875f, -0.05859375f, -0.0625f, -0.0703125f, -0.078125f,
+    -0.0859375f, -0.09375f, -0.1015625f, -0.109375f, -0.1171875f, -0.125f, -0.140625f, -0.15625f,
+    -0.171875f, -0.1875f, -0.203125f, -0.21875f, -0.234375f, -0.25f, -0.28125f, -0.3125f, -0.34375f,
+    -0.375f, -0.40625f, -0.4375f, -0.46875f, -0.5f, -0.5625f, -0.625f, -0.6875f, -0.75f, -0.8125f,
+    -0.875f, -0.9375f, -1.0f, -1.125f, -1.25f, -1.375f, -1.5f, -1.625f, -1.75f, -1.875f, -2.0f,
+    -2.25f, -2.5f, -2.75f, -3.0f, -3.25f, -3.5f, -3.75f, -4.0f, -4.5f, -5.0f, -5.5f, -6.0f, -6.5f,
+    -7.0f, -7.5f, -8.0f, -9.0f, -10.0f, -11.0f, -12.0f, -13.0f, -14.0f, -15.0f, -16.0f, -18.0f,
+    -20.0f, -22.0f, -24.0f, -26.0f, -28.0f, -30.0f, -32.0f, -36.0f, -40.0f, -44.0f, -48.0f, -52.0f,
+    -56.0f, -60.0f, -64.0f, -72.0f, -80.0f, -88.0f, -96.0f, -104.0f, -112.0f, -120.0f, -128.0f,
+    -144.0f, -160.0f, -176.0f, -192.0f, -208.0f, -224.0f, -240.0f, -INFINITY, NAN, NAN, NAN, NAN,
+    NAN, NAN, NAN,
+};
+
+static inline float f8e4m3_to_float(f8e4m3_t val) { return F8E4M3_TO_FLOAT_LUT[val]; }
 
 static inline f8e4m3_t float_to_f8e4m3(float val) {
     if (val == 0.0f)
@@ -24,30 +24,44 @@ typedef uint8_t f8e5m2_t;
 // CONVERSION
 // ============================================================================
 
-static inline float f8e5m2_to_float(f8e5m2_t val) {
-    uint32_t sign = (val >> 7) & 1;
-    uint32_t exp = (val >> 2) & 0x1F;
-    uint32_t mant = val & 0x3;
-
-    // E5M2 uses bias of 15 (same as FP16)
-    // Special values: exp=31 is infinity/NaN
-    if (exp == 31) {
-        if (mant == 0)
-            return sign ? -INFINITY : INFINITY;
-        return NAN;
-    }
-
-    if (exp == 0) {
-        if (mant == 0)
-            return sign ? -0.0f : 0.0f;
-        // Subnormal: 2^(-14) * (mant/4)
-        return ldexpf((float)mant / 4.0f, -14) * (sign ? -1.0f : 1.0f);
-    }
-
-    // Normal: 2^(exp-15) * (1 + mant/4)
-    float result = ldexpf(1.0f + (float)mant / 4.0f, (int)exp - 15);
-    return sign ? -result : result;
-}
+// Decoding table, index = encoded byte. Bias 15 (same as FP16); exp=31 encodes infinity
+// (mant=0) or NaN; exp=0 encodes zero/subnormals 2^-14 * mant/4; otherwise
+// 2^(exp-15) * (1 + mant/4).
+static const float F8E5M2_TO_FLOAT_LUT[256] = {
+    0.0f, 1.52587891e-05f, 3.05175781e-05f, 4.57763672e-05f, 6.10351562e-05f, 7.62939453e-05f,
+    9.15527344e-05f, 0.000106811523f, 0.000122070312f, 0.000152587891f, 0.000183105469f,
+    0.000213623047f, 0.000244140625f, 0.000305175781f, 0.000366210938f, 0.000427246094f,
+    0.00048828125f, 0.000610351562f, 0.000732421875f, 0.000854492188f, 0.0009765625f,
+    0.00122070312f, 0.00146484375f, 0.00170898438f, 0.001953125f, 0.00244140625f, 0.0029296875f,
+    0.00341796875f, 0.00390625f, 0.0048828125f, 0.005859375f, 0.0068359375f, 0.0078125f,
+    0.009765625f, 0.01171875f, 0.013671875f, 0.015625f, 0.01953125f, 0.0234375f, 0.02734375f,
+    0.03125f, 0.0390625f, 0.046875f, 0.0546875f, 0.0625f, 0.078125f, 0.09375f, 0.109375f, 0.125f,
+    0.15625f, 0.1875f, 0.21875f, 0.25f, 0.3125f, 0.375f, 0.4375f, 0.5f, 0.625f, 0.75f, 0.875f, 1.0f,
+    1.25f, 1.5f, 1.75f, 2.0f, 2.5f, 3.0f, 3.5f, 4.0f, 5.0f, 6.0f, 7.0f, 8.0f, 10.0f, 12.0f, 14.0f,
+    16.0f, 20.0f, 24.0f, 28.0f, 32.0f, 40.0f, 48.0f, 56.0f, 64.0f, 80.0f, 96.0f, 112.0f, 128.0f,
+    160.0f, 192.0f, 224.0f, 256.0f, 320.0f, 384.0f, 448.0f, 512.0f, 640.0f, 768.0f, 896.0f, 1024.0f,
+    1280.0f, 1536.0f, 1792.0f, 2048.0f, 2560.0f, 3072.0f, 3584.0f, 4096.0f, 5120.0f, 6144.0f,
+    7168.0f, 8192.0f, 10240.0f, 12288.0f, 14336.0f, 16384.0f, 20480.0f, 24576.0f, 28672.0f,
+    32768.0f, 40960.0f, 49152.0f, 57344.0f, INFINITY, NAN, NAN, NAN, -0.0f, -1.52587891e-05f,
+    -3.05175781e-05f, -4.57763672e-05f, -6.10351562e-05f, -7.62939453e-05f, -9.15527344e-05f,
+    -0.000106811523f, -0.000122070312f, -0.000152587891f, -0.000183105469f, -0.000213623047f,
+    -0.000244140625f, -0.000305175781f, -0.000366210938f, -0.000427246094f, -0.00048828125f,
+    -0.000610351562f, -0.000732421875f, -0.000854492188f, -0.0009765625f, -0.00122070312f,
+    -0.00146484375f, -0.00170898438f, -0.001953125f, -0.00244140625f, -0.0029296875f,
+    -0.00341796875f, -0.00390625f, -0.0048828125f, -0.005859375f, -0.0068359375f, -0.0078125f,
+    -0.009765625f, -0.01171875f, -0.013671875f, -0.015625f, -0.01953125f, -0.0234375f, -0.02734375f,
+    -0.03125f, -0.0390625f, -0.046875f, -0.0546875f, -0.0625f, -0.078125f, -0.09375f, -0.109375f,
+    -0.125f, -0.15625f, -0.1875f, -0.21875f, -0.25f, -0.3125f, -0.375f, -0.4375f, -0.5f, -0.625f,
+    -0.75f, -0.875f, -1.0f, -1.25f, -1.5f, -1.75f, -2.0f, -2.5f, -3.0f, -3.5f, -4.0f, -5.0f, -6.0f,
+    -7.0f, -8.0f, -10.0f, -12.0f, -14.0f, -16.0f, -20.0f, -24.0f, -28.0f, -32.0f, -40.0f, -48.0f,
+    -56.0f, -64.0f, -80.0f, -96.0f, -112.0f, -128.0f, -160.0f, -192.0f, -224.0f, -256.0f, -320.0f,
+    -384.0f, -448.0f, -512.0f, -640.0f, -768.0f, -896.0f, -1024.0f, -1280.0f, -1536.0f, -1792.0f,
+    -2048.0f, -2560.0f, -3072.0f, -3584.0f, -4096.0f, -5120.0f, -6144.0f, -7168.0f, -8192.0f,
+    -10240.0f, -12288.0f, -14336.0f, -16384.0f, -20480.0f, -24576.0f, -28672.0f, -32768.0f,
+    -40960.0f, -49152.0f, -57344.0f, -INFINITY, NAN, NAN, NAN,
+};
+
+static inline float f8e5m2_to_float(f8e5m2_t val) { return F8E5M2_TO_FLOAT_LUT[val]; }
 
 static inline f8e5m2_t float_to_f8e5m2(float val) {
     if (val == 0.0f)
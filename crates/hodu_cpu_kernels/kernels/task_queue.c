@@ -0,0 +1,344 @@
+#include "task_queue.h"
+#include "thread_utils.h"
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#if defined(HAVE_PTHREAD)
+#include <sched.h>
+#endif
+
+// ============================================================================
+// TASK QUEUE IMPLEMENTATION
+// ============================================================================
+//
+// One mutex guards the dependency graph and the ready list; tasks are whole
+// kernel calls, so it is taken a few times per kernel rather than per item.
+//
+// - A task counts its unfinished dependencies and sits in the dependents list
+//   of each of them. When a task finishes, every dependent whose count drops
+//   to zero is appended to the ready list (FIFO), and everyone waiting on the
+//   queue is woken through one condition variable.
+// - Executors pop the ready list and run tasks outside the lock. Waiting
+//   threads do the same until their task is done, so a task waiting on
+//   another one keeps the queue moving instead of blocking an executor.
+// - A task holds two references: the submitter's handle and the queue's,
+//   dropped when it finishes. Dependents do not reference their
+//   dependencies: they are only linked while the dependency is unfinished.
+
+struct hodu_cpu_task {
+    hodu_cpu_task_fn fn;
+    void *ctx;
+    atomic_int done;
+    size_t refs;           // guarded by queue.lock
+    size_t remaining_deps; // unfinished dependencies, guarded by queue.lock
+    hodu_cpu_task_t **dependents;
+    size_t num_dependents;
+    size_t cap_dependents;
+    hodu_cpu_task_t *next; // ready list link
+};
+
+static hodu_cpu_task_t *task_alloc(hodu_cpu_task_fn fn, void *ctx, size_t refs) {
+    hodu_cpu_task_t *task = (hodu_cpu_task_t *)calloc(1, sizeof(hodu_cpu_task_t));
+    if (task) {
+        task->fn = fn;
+        task->ctx = ctx;
+        task->refs = refs;
+        atomic_init(&task->done, 0);
+    }
+    return task;
+}
+
+int hodu_cpu_task_poll(const hodu_cpu_task_t *task) {
+    return task ? atomic_load_explicit(&task->done, memory_order_acquire) : 1;
+}
+
+#if defined(HAVE_PTHREAD) || defined(HAVE_WIN32_THREADS)
+
+static inline void queue_yield(void) {
+#if defined(HAVE_PTHREAD)
+    sched_yield();
+#elif defined(HAVE_WIN32_THREADS)
+    SwitchToThread();
+#endif
+}
+
+enum { QUEUE_UNINIT = 0, QUEUE_STARTING, QUEUE_READY, QUEUE_DISABLED };
+
+static struct {
+    mutex_t lock;
+    cond_t changed; // a task became ready or finished
+    hodu_cpu_task_t *head;
+    hodu_cpu_task_t *tail;
+    size_t outstanding; // submitted but unfinished tasks
+    thread_t threads[HODU_CPU_TASK_MAX_EXECUTORS];
+    size_t num_executors;
+    atomic_int state;
+} queue = {.state = QUEUE_UNINIT};
+
+// Must be called while holding queue.lock
+static void queue_push_ready(hodu_cpu_task_t *task) {
+    task->next = NULL;
+    if (queue.tail) {
+        queue.tail->next = task;
+    } else {
+        queue.head = task;
+    }
+    queue.tail = task;
+}
+
+// Must be called while holding queue.lock
+static hodu_cpu_task_t *queue_pop_ready(void) {
+    hodu_cpu_task_t *task = queue.head;
+    if (task) {
+        queue.head = task->next;
+        if (!queue.head) {
+            queue.tail = NULL;
+        }
+    }
+    return task;
+}
+
+// Must be called while holding queue.lock
+static void queue_unref(hodu_cpu_task_t *task) {
+    if (--task->refs == 0) {
+        free(task->dependents);
+        free(task);
+    }
+}
+
+// Run a popped task; called and returns with queue.lock held
+static void queue_run_locked(hodu_cpu_task_t *task) {
+    mutex_unlock(&queue.lock);
+    task->fn(task->ctx);
+    mutex_lock(&queue.lock);
+
+    for (size_t i = 0; i < task->num_dependents; i++) {
+        hodu_cpu_task_t *dependent = task->dependents[i];
+        if (--dependent->remaining_deps == 0) {
+            queue_push_ready(dependent);
+        }
+    }
+    free(task->dependents);
+    task->dependents = NULL;
+    task->num_dependents = 0;
+    task->cap_dependents = 0;
+
+    atomic_store_explicit(&task->done, 1, memory_order_release);
+    queue.outstanding--;
+    queue_unref(task);
+    cond_broadcast(&queue.changed);
+}
+
+static void *queue_executor_main(void *arg) {
+    (void)arg;
+    mutex_lock(&queue.lock);
+    for (;;) {
+        hodu_cpu_task_t *task = queue_pop_ready();
+        if (task) {
+            queue_run_locked(task);
+        } else {
+            cond_wait(&queue.changed, &queue.lock);
+        }
+    }
+    return NULL;
+}
+
+#if defined(HAVE_PTHREAD) && (defined(__unix__) || defined(__APPLE__))
+// Executors do not survive fork(); the child runs its tasks inline. Tasks of
+// the parent are abandoned, waiting on them in the child would block forever.
+static void queue_atfork_child(void) {
+    mutex_init(&queue.lock);
+    cond_init(&queue.changed);
+    queue.head = NULL;
+    queue.tail = NULL;
+    queue.outstanding = 0;
+    queue.num_executors = 0;
+    atomic_store(&queue.state, QUEUE_DISABLED);
+}
+#endif
+
+// Start the executors on first use; false if tasks must run inline
+static bool queue_ensure_started(void) {
+    int state = atomic_load_explicit(&queue.state, memory_order_acquire);
+    if (state == QUEUE_READY || state == QUEUE_DISABLED) {
+        return state == QUEUE_READY;
+    }
+
+    int expected = QUEUE_UNINIT;
+    if (!atomic_compare_exchange_strong(&queue.state, &expected, QUEUE_STARTING)) {
+        // Another thread is starting the executors
+        while ((state = atomic_load_explicit(&queue.state, memory_order_acquire)) ==
+               QUEUE_STARTING) {
+            queue_yield();
+        }
+        return state == QUEUE_READY;
+    }
+
+    mutex_init(&queue.lock);
+    cond_init(&queue.changed);
+
+    size_t num_executors = get_num_threads();
+    if (num_executors > HODU_CPU_TASK_MAX_EXECUTORS) {
+        num_executors = HODU_CPU_TASK_MAX_EXECUTORS;
+    }
+    size_t started = 0;
+    if (num_executors > 1) {
+        for (; started < num_executors; started++) {
+            if (thread_create(&queue.threads[started], queue_executor_main, NULL) != 0) {
+                break;
+            }
+        }
+    }
+    queue.num_executors = started;
+
+#if defined(HAVE_PTHREAD) && (defined(__unix__) || defined(__APPLE__))
+    if (started > 0) {
+        pthread_atfork(NULL, NULL, queue_atfork_child);
+    }
+#endif
+
+    atomic_store_explicit(&queue.state, started > 0 ? QUEUE_READY : QUEUE_DISABLED,
+                          memory_order_release);
+    return started > 0;
+}
+
+// Make room for one more dependent; called with queue.lock held
+static bool task_reserve_dependent(hodu_cpu_task_t *task) {
+    if (task->num_dependents < task->cap_dependents) {
+        return true;
+    }
+    size_t cap = task->cap_dependents ? task->cap_dependents * 2 : 4;
+    hodu_cpu_task_t **dependents =
+        (hodu_cpu_task_t **)realloc(task->dependents, cap * sizeof(hodu_cpu_task_t *));
+    if (!dependents) {
+        return false;
+    }
+    task->dependents = dependents;
+    task->cap_dependents = cap;
+    return true;
+}
+
+hodu_cpu_task_t *hodu_cpu_task_submit(hodu_cpu_task_fn fn, void *ctx,
+                                      hodu_cpu_task_t *const *deps, size_t num_deps) {
+    if (!queue_ensure_started()) {
+        hodu_cpu_task_t *task = task_alloc(fn, ctx, 1);
+        if (task) {
+            fn(ctx);
+            atomic_store_explicit(&task->done, 1, memory_order_release);
+        }
+        return task;
+    }
+
+    hodu_cpu_task_t *task = task_alloc(fn, ctx, 2);
+    if (!task) {
+        return NULL;
+    }
+
+    mutex_lock(&queue.lock);
+
+    // Grow every dependents list first so a failed allocation leaves the graph unchanged
+    for (size_t i = 0; i < num_deps; i++) {
+        hodu_cpu_task_t *dep = deps[i];
+        if (dep && !atomic_load_explicit(&dep->done, memory_order_relaxed) &&
+            !task_reserve_dependent(dep)) {
+            mutex_unlock(&queue.lock);
+            free(task);
+            return NULL;
+        }
+    }
+
+    for (size_t i = 0; i < num_deps; i++) {
+        hodu_cpu_task_t *dep = deps[i];
+        if (dep && !atomic_load_explicit(&dep->done, memory_order_relaxed)) {
+            // A dependency named twice is linked once (task is then its last dependent)
+            if (dep->num_dependents > 0 && dep->dependents[dep->num_dependents - 1] == task) {
+                continue;
+            }
+            dep->dependents[dep->num_dependents++] = task;
+            task->remaining_deps++;
+        }
+    }
+
+    queue.outstanding++;
+    if (task->remaining_deps == 0) {
+        queue_push_ready(task);
+        cond_broadcast(&queue.changed);
+    }
+
+    mutex_unlock(&queue.lock);
+    return task;
+}
+
+void hodu_cpu_task_wait(hodu_cpu_task_t *task) {
+    if (!task || atomic_load_explicit(&task->done, memory_order_acquire)) {
+        return;
+    }
+
+    mutex_lock(&queue.lock);
+    while (!atomic_load_explicit(&task->done, memory_order_acquire)) {
+        hodu_cpu_task_t *ready = queue_pop_ready();
+        if (ready) {
+            queue_run_locked(ready);
+        } else {
+            cond_wait(&queue.changed, &queue.lock);
+        }
+    }
+    mutex_unlock(&queue.lock);
+}
+
+void hodu_cpu_task_wait_all(void) {
+    if (atomic_load_explicit(&queue.state, memory_order_acquire) != QUEUE_READY) {
+        return;
+    }
+
+    mutex_lock(&queue.lock);
+    while (queue.outstanding > 0) {
+        hodu_cpu_task_t *ready = queue_pop_ready();
+        if (ready) {
+            queue_run_locked(ready);
+        } else {
+            cond_wait(&queue.changed, &queue.lock);
+        }
+    }
+    mutex_unlock(&queue.lock);
+}
+
+void hodu_cpu_task_release(hodu_cpu_task_t *task) {
+    if (!task) {
+        return;
+    }
+    if (atomic_load_explicit(&queue.state, memory_order_acquire) != QUEUE_READY) {
+        // Inline tasks are finished and owned by the handle alone
+        free(task->dependents);
+        free(task);
+        return;
+    }
+
+    mutex_lock(&queue.lock);
+    queue_unref(task);
+    mutex_unlock(&queue.lock);
+}
+
+#else
+
+// Without threads every task runs inline at submission
+
+hodu_cpu_task_t *hodu_cpu_task_submit(hodu_cpu_task_fn fn, void *ctx,
+                                      hodu_cpu_task_t *const *deps, size_t num_deps) {
+    (void)deps;
+    (void)num_deps;
+    hodu_cpu_task_t *task = task_alloc(fn, ctx, 1);
+    if (task) {
+        fn(ctx);
+        atomic_store_explicit(&task->done, 1, memory_order_release);
+    }
+    return task;
+}
+
+void hodu_cpu_task_wait(hodu_cpu_task_t *task) { (void)task; }
+
+void hodu_cpu_task_wait_all(void) {}
+
+void hodu_cpu_task_release(hodu_cpu_task_t *task) { free(task); }
+
+#endif
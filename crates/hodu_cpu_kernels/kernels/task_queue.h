@@ -0,0 +1,84 @@
+/**
+ * @file task_queue.h
+ * @brief Asynchronous kernel submission queue header
+ *
+ * Kernels are blocking calls that split their work across the thread pool and
+ * join it before returning. The task queue lets a runtime submit kernel calls
+ * instead, each with the tasks it depends on, and get back a completion handle
+ * to poll or wait on. Tasks whose dependencies are done run concurrently, so
+ * independent branches of a graph (attention heads, towers of a model) overlap
+ * instead of running strictly one after another.
+ *
+ * Tasks run on a few executor threads started on the first submission. A
+ * kernel running on an executor still calls parallel_for: the first one to
+ * reach the idle pool fans out across all its workers, and kernels running
+ * concurrently with it take their ranges on their own executor thread. Small
+ * ops therefore fill the cores next to a large one instead of waiting for it.
+ */
+
+#ifndef HODU_CPU_KERNELS_TASK_QUEUE_H
+#define HODU_CPU_KERNELS_TASK_QUEUE_H
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// Maximum number of executor threads (at most the pool thread count)
+#define HODU_CPU_TASK_MAX_EXECUTORS 4
+
+/// Opaque completion handle of a submitted task
+typedef struct hodu_cpu_task hodu_cpu_task_t;
+
+/// Task body, called once with the ctx given at submission
+typedef void (*hodu_cpu_task_fn)(void *ctx);
+
+// ============================================================================
+// SUBMISSION
+// ============================================================================
+//
+// A task starts once all its dependencies have finished; tasks without
+// pending dependencies start in submission order. Dependencies must be
+// handles the caller still holds (NULL entries are ignored); finished ones
+// are allowed.
+//
+// The executors are started with min(hodu_cpu_get_num_threads(),
+// HODU_CPU_TASK_MAX_EXECUTORS) threads on the first submission. With a single
+// thread, without ENABLE_THREADS, or if no executor can be started, the task
+// runs on the submitting thread before hodu_cpu_task_submit returns (its
+// dependencies have then necessarily finished too).
+//
+// Tasks must not wait on tasks submitted after them.
+
+/// Submit fn(ctx) to run after the num_deps tasks in deps
+///
+/// Returns the completion handle (release it with hodu_cpu_task_release),
+/// or NULL if it cannot be allocated; fn is then not run.
+hodu_cpu_task_t *hodu_cpu_task_submit(hodu_cpu_task_fn fn, void *ctx,
+                                      hodu_cpu_task_t *const *deps, size_t num_deps);
+
+// ============================================================================
+// COMPLETION
+// ============================================================================
+
+/// 1 if the task has finished, 0 otherwise (never blocks)
+int hodu_cpu_task_poll(const hodu_cpu_task_t *task);
+
+/// Block until the task has finished
+///
+/// The waiting thread runs ready tasks of the queue in the meantime, so
+/// waiting from inside a task cannot starve the executors.
+void hodu_cpu_task_wait(hodu_cpu_task_t *task);
+
+/// Block until every task submitted so far has finished
+void hodu_cpu_task_wait_all(void);
+
+/// Drop the caller's handle; the task still runs if it has not finished
+void hodu_cpu_task_release(hodu_cpu_task_t *task);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // HODU_CPU_KERNELS_TASK_QUEUE_H
@@ -0,0 +1,663 @@
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+// sched_getaffinity / sched_setaffinity and the CPU_* macros
+#define _GNU_SOURCE
+#endif
+
+#include "profile.h"
+#include "thread_utils.h"
+#include "workspace.h"
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#if defined(HAVE_PTHREAD) || defined(__linux__)
+#include <sched.h>
+#endif
+
+// ============================================================================
+// PERSISTENT THREAD POOL IMPLEMENTATION
+// ============================================================================
+//
+// A process-wide pool of (num_cpus - 1) workers, started on the first
+// parallel_for() call. Each worker owns a job slot; the dispatcher publishes a
+// pointer to a stack-allocated job into the slots of the workers it needs and
+// takes part in the job itself. Workers spin briefly on their slot before
+// falling back to a condition variable, so back-to-back kernels pay only an
+// atomic store and a cache-line transfer per worker instead of a thread
+// create/join.
+//
+// Scheduling (work stealing):
+// - The range is cut into tasks of at least `grain` items, at most
+//   POOL_TASKS_PER_THREAD per participant.
+// - Every participant (dispatcher + workers) owns a contiguous run of task
+//   indices packed into one 64-bit word (lo | hi << 32). The owner pops from
+//   the front, so it still walks memory in order.
+// - A participant whose run is empty steals the back half of another run and
+//   continues on it. Runs only ever shrink or get replaced by stolen ones, so
+//   an idle participant quits after one sweep finds every run empty.
+// - Uneven items (padded border tiles, mixed-size batches) are then balanced
+//   dynamically instead of the slowest static chunk setting the latency.
+// - parallel_for_static() skips all of this: participant p runs exactly the
+//   p-th of num_participants equal slices, so page placement by first touch
+//   follows the same split as later kernels over the same range.
+//
+// Lifetime of a job:
+// - The dispatcher owns the job; it returns only after `pending` drops to 0.
+// - A worker clears its slot before starting and never touches the job or the
+//   task runs again after decrementing `pending`.
+//
+// Configuration (hodu_cpu_set_num_threads / hodu_cpu_set_affinity_mask) only
+// records the new settings and bumps an epoch. The next parallel_for() that
+// owns the pool sees the changed epoch, joins the old workers and starts a new
+// set, so the setters never block on running kernels.
+
+// ============================================================================
+// THREAD COUNT AND AFFINITY CONFIGURATION
+// ============================================================================
+
+// Maximum number of CPUs addressable through hodu_cpu_set_affinity_mask
+#define POOL_MAX_CPUS 1024
+#define POOL_MASK_WORDS (POOL_MAX_CPUS / 64)
+
+static struct {
+    atomic_size_t requested;  // hodu_cpu_set_num_threads value, 0 = automatic
+    atomic_size_t detected;   // cached default thread count, 0 = not detected yet
+    atomic_size_t mask_cpus;  // number of CPUs in the affinity mask, 0 = no affinity
+    atomic_uint epoch;        // bumped on every configuration change
+    atomic_int deterministic; // 0 = not read from HODU_DETERMINISTIC yet, 1 = off, 2 = on
+    uint64_t mask[POOL_MASK_WORDS];
+} config;
+
+#if defined(ENABLE_THREADS)
+#if defined(__linux__)
+// CPU limit from the cgroup CFS quota (v2 cpu.max, then v1), 0 if unlimited
+static size_t detect_cgroup_cpu_limit(void) {
+    long long quota = -1;
+    long long period = 0;
+
+    FILE *f = fopen("/sys/fs/cgroup/cpu.max", "r");
+    if (f) {
+        char buf[32];
+        if (fscanf(f, "%31s %lld", buf, &period) == 2 && strcmp(buf, "max") != 0) {
+            quota = atoll(buf);
+        }
+        fclose(f);
+    } else {
+        f = fopen("/sys/fs/cgroup/cpu/cpu.cfs_quota_us", "r");
+        if (f) {
+            if (fscanf(f, "%lld", &quota) != 1) {
+                quota = -1;
+            }
+            fclose(f);
+        }
+        f = fopen("/sys/fs/cgroup/cpu/cpu.cfs_period_us", "r");
+        if (f) {
+            if (fscanf(f, "%lld", &period) != 1) {
+                period = 0;
+            }
+            fclose(f);
+        }
+    }
+
+    if (quota <= 0 || period <= 0) {
+        return 0;
+    }
+    return (size_t)((quota + period - 1) / period);
+}
+#endif
+
+// Default thread count: HODU_NUM_THREADS, else online CPUs clamped to the
+// process cpuset and cgroup quota
+static size_t detect_num_threads(void) {
+    const char *env = getenv("HODU_NUM_THREADS");
+    if (env) {
+        long value = strtol(env, NULL, 10);
+        if (value > 0) {
+            return (size_t)value;
+        }
+    }
+
+#if defined(__unix__) || defined(__APPLE__)
+    long nproc = sysconf(_SC_NPROCESSORS_ONLN);
+    size_t n = (nproc > 0) ? (size_t)nproc : 1;
+#elif defined(_WIN32)
+    SYSTEM_INFO sysinfo;
+    GetSystemInfo(&sysinfo);
+    size_t n = (size_t)sysinfo.dwNumberOfProcessors;
+#else
+    size_t n = 1;
+#endif
+
+#if defined(__linux__)
+    cpu_set_t set;
+    if (sched_getaffinity(0, sizeof(set), &set) == 0) {
+        int count = CPU_COUNT(&set);
+        if (count > 0 && (size_t)count < n) {
+            n = (size_t)count;
+        }
+    }
+    size_t quota = detect_cgroup_cpu_limit();
+    if (quota > 0 && quota < n) {
+        n = quota;
+    }
+#endif
+
+    return n > 0 ? n : 1;
+}
+#endif
+
+size_t hodu_cpu_get_num_threads(void) {
+#if defined(ENABLE_THREADS)
+    size_t requested = atomic_load_explicit(&config.requested, memory_order_relaxed);
+    if (requested > 0) {
+        return requested;
+    }
+    size_t mask_cpus = atomic_load_explicit(&config.mask_cpus, memory_order_relaxed);
+    if (mask_cpus > 0) {
+        return mask_cpus;
+    }
+    size_t detected = atomic_load_explicit(&config.detected, memory_order_relaxed);
+    if (detected == 0) {
+        detected = detect_num_threads();
+        atomic_store_explicit(&config.detected, detected, memory_order_relaxed);
+    }
+    return detected;
+#else
+    return 1;
+#endif
+}
+
+void hodu_cpu_set_num_threads(size_t num_threads) {
+    atomic_store(&config.requested, num_threads);
+    atomic_fetch_add(&config.epoch, 1);
+}
+
+int hodu_cpu_get_deterministic(void) {
+    int mode = atomic_load_explicit(&config.deterministic, memory_order_relaxed);
+    if (mode == 0) {
+        const char *env = getenv("HODU_DETERMINISTIC");
+        mode = (env && strtol(env, NULL, 10) > 0) ? 2 : 1;
+        atomic_store_explicit(&config.deterministic, mode, memory_order_relaxed);
+    }
+    return mode == 2;
+}
+
+void hodu_cpu_set_deterministic(int enabled) {
+    atomic_store(&config.deterministic, enabled ? 2 : 1);
+}
+
+int hodu_cpu_set_affinity_mask(const uint64_t *mask, size_t num_words) {
+#if defined(ENABLE_THREADS) && (defined(__linux__) || defined(_WIN32))
+#if defined(_WIN32)
+    // SetThreadAffinityMask only addresses the current processor group
+    const size_t max_words = 1;
+#else
+    const size_t max_words = POOL_MASK_WORDS;
+#endif
+    size_t cpus = 0;
+    uint64_t words[POOL_MASK_WORDS] = {0};
+    for (size_t i = 0; mask && i < num_words; i++) {
+        if (mask[i] != 0 && i >= max_words) {
+            return -1;
+        }
+        if (i < POOL_MASK_WORDS) {
+            words[i] = mask[i];
+        }
+        for (uint64_t w = mask[i]; w; w &= w - 1) {
+            cpus++;
+        }
+    }
+
+    memcpy(config.mask, words, sizeof(words));
+    atomic_store(&config.mask_cpus, cpus);
+    atomic_fetch_add(&config.epoch, 1);
+    return 0;
+#else
+    (void)mask;
+    (void)num_words;
+    return -1;
+#endif
+}
+
+#if defined(HAVE_PTHREAD) || defined(HAVE_WIN32_THREADS)
+
+// Idle spin iterations before a worker goes to sleep on its condition variable
+#define POOL_SPIN_ITERS (1 << 14)
+
+// Upper bound on tasks per participant (bounds scheduling overhead)
+#define POOL_TASKS_PER_THREAD 16
+
+enum { POOL_UNINIT = 0, POOL_READY, POOL_DISABLED };
+
+// Run of task indices [lo, hi) owned by one participant, padded to a cache line
+typedef struct {
+    _Atomic(uint64_t) run;
+    char pad[64 - sizeof(uint64_t)];
+} pool_queue_t;
+
+typedef struct {
+    parallel_for_fn fn;
+    void *ctx;
+    size_t start;
+    size_t end;
+    size_t task_size;
+    size_t num_participants;
+    bool steal; // false: participant p runs only the p-th equal slice
+    atomic_size_t pending;
+#ifdef HODU_PROFILE_ACTIVE
+    hodu_cpu_profile_scope_t *profile; // dispatching kernel, current on workers while they run
+#endif
+} pool_job_t;
+
+typedef struct {
+    thread_t thread;
+    _Atomic(pool_job_t *) job;
+    size_t id;
+    int cpu; // CPU to pin to, -1 = no affinity
+    atomic_int sleeping;
+    mutex_t lock;
+    cond_t cond;
+} pool_worker_t;
+
+static struct {
+    pool_worker_t *workers;
+    pool_queue_t *queues; // [0] = dispatcher, [1 + i] = workers[i]
+    size_t num_workers;
+    unsigned epoch; // configuration epoch the workers were started with
+    atomic_int state;
+    atomic_flag busy;
+} pool = {NULL, NULL, 0, 0, POOL_UNINIT, ATOMIC_FLAG_INIT};
+
+// Published to a worker's slot to make it exit
+static pool_job_t pool_exit_job;
+
+static _Thread_local bool pool_in_worker = false;
+
+static inline void pool_cpu_relax(void) {
+#if defined(_MSC_VER)
+    YieldProcessor();
+#elif defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+    __asm__ __volatile__("yield");
+#endif
+}
+
+// Give up the time slice when spinning for too long (oversubscribed machines)
+static inline void pool_yield(void) {
+#if defined(HAVE_PTHREAD)
+    sched_yield();
+#elif defined(HAVE_WIN32_THREADS)
+    SwitchToThread();
+#endif
+}
+
+static inline uint64_t pool_pack_run(uint32_t lo, uint32_t hi) {
+    return (uint64_t)lo | ((uint64_t)hi << 32);
+}
+
+// Owner side: take the first task of its own run
+static bool pool_pop_front(pool_queue_t *q, uint32_t *task) {
+    uint64_t run = atomic_load_explicit(&q->run, memory_order_acquire);
+    for (;;) {
+        uint32_t lo = (uint32_t)run;
+        uint32_t hi = (uint32_t)(run >> 32);
+        if (lo >= hi) {
+            return false;
+        }
+        if (atomic_compare_exchange_weak_explicit(&q->run, &run, pool_pack_run(lo + 1, hi),
+                                                  memory_order_acq_rel, memory_order_acquire)) {
+            *task = lo;
+            return true;
+        }
+    }
+}
+
+// Thief side: take the back half of another run
+static bool pool_steal_back(pool_queue_t *q, uint32_t *lo_out, uint32_t *hi_out) {
+    uint64_t run = atomic_load_explicit(&q->run, memory_order_acquire);
+    for (;;) {
+        uint32_t lo = (uint32_t)run;
+        uint32_t hi = (uint32_t)(run >> 32);
+        if (lo >= hi) {
+            return false;
+        }
+        uint32_t mid = lo + (hi - lo) / 2;
+        if (atomic_compare_exchange_weak_explicit(&q->run, &run, pool_pack_run(lo, mid),
+                                                  memory_order_acq_rel, memory_order_acquire)) {
+            *lo_out = mid;
+            *hi_out = hi;
+            return true;
+        }
+    }
+}
+
+static inline void pool_run_task(pool_job_t *job, uint32_t task) {
+    size_t begin = job->start + (size_t)task * job->task_size;
+    size_t end = job->end - begin > job->task_size ? begin + job->task_size : job->end;
+    job->fn(begin, end, job->ctx);
+}
+
+// Drain the participant's own run, then steal until every run is empty
+static void pool_participate(pool_job_t *job, size_t id) {
+    pool_queue_t *own = &pool.queues[id];
+    size_t num = job->num_participants;
+    uint32_t task;
+
+    if (!job->steal) {
+        size_t n = job->end - job->start;
+        size_t begin = job->start + n / num * id + (n % num) * id / num;
+        size_t end = job->start + n / num * (id + 1) + (n % num) * (id + 1) / num;
+        if (end > begin) {
+            job->fn(begin, end, job->ctx);
+        }
+        return;
+    }
+
+    for (;;) {
+        while (pool_pop_front(own, &task)) {
+            pool_run_task(job, task);
+        }
+
+        bool stolen = false;
+        for (size_t k = 1; k < num && !stolen; k++) {
+            uint32_t lo, hi;
+            if (pool_steal_back(&pool.queues[(id + k) % num], &lo, &hi)) {
+                // Own run is empty, so nobody can succeed on it concurrently
+                atomic_store_explicit(&own->run, pool_pack_run(lo + 1, hi), memory_order_release);
+                pool_run_task(job, lo);
+                stolen = true;
+            }
+        }
+        if (!stolen) {
+            return;
+        }
+    }
+}
+
+static pool_job_t *pool_wait_job(pool_worker_t *w) {
+    pool_job_t *job;
+    for (int i = 0; i < POOL_SPIN_ITERS; i++) {
+        job = atomic_load_explicit(&w->job, memory_order_acquire);
+        if (job) {
+            return job;
+        }
+        pool_cpu_relax();
+    }
+
+    mutex_lock(&w->lock);
+    atomic_store(&w->sleeping, 1);
+    while ((job = atomic_load(&w->job)) == NULL) {
+        cond_wait(&w->cond, &w->lock);
+    }
+    atomic_store(&w->sleeping, 0);
+    mutex_unlock(&w->lock);
+    return job;
+}
+
+static void pool_pin_current_thread(int cpu) {
+#if defined(__linux__)
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    sched_setaffinity(0, sizeof(set), &set);
+#elif defined(_WIN32)
+    if (cpu < (int)(sizeof(DWORD_PTR) * 8)) {
+        SetThreadAffinityMask(GetCurrentThread(), (DWORD_PTR)1 << cpu);
+    }
+#else
+    (void)cpu;
+#endif
+}
+
+static void *pool_worker_main(void *arg) {
+    pool_worker_t *w = (pool_worker_t *)arg;
+    pool_in_worker = true;
+    if (w->cpu >= 0) {
+        pool_pin_current_thread(w->cpu);
+    }
+
+    for (;;) {
+        pool_job_t *job = pool_wait_job(w);
+        atomic_store_explicit(&w->job, NULL, memory_order_relaxed);
+        if (job == &pool_exit_job) {
+            break;
+        }
+
+#ifdef HODU_PROFILE_ACTIVE
+        hodu_cpu_profile_set_current(job->profile);
+        pool_participate(job, w->id);
+        hodu_cpu_profile_set_current(NULL);
+#else
+        pool_participate(job, w->id);
+#endif
+        atomic_fetch_sub_explicit(&job->pending, 1, memory_order_release);
+    }
+    hodu_cpu_workspace_trim();
+    return NULL;
+}
+
+static void pool_publish(pool_worker_t *w, pool_job_t *job) {
+    atomic_store(&w->job, job);
+    if (atomic_load(&w->sleeping)) {
+        mutex_lock(&w->lock);
+        cond_signal(&w->cond);
+        mutex_unlock(&w->lock);
+    }
+}
+
+#if defined(HAVE_PTHREAD) && (defined(__unix__) || defined(__APPLE__))
+// Worker threads do not survive fork(); let the child start a fresh pool.
+static void pool_atfork_child(void) {
+    pool.workers = NULL;
+    pool.queues = NULL;
+    pool.num_workers = 0;
+    atomic_store(&pool.state, POOL_UNINIT);
+    atomic_flag_clear(&pool.busy);
+}
+
+// Every configuration change restarts the pool, so the handler is registered once (a forked
+// child inherits it along with the once flag)
+static pthread_once_t pool_atfork_once = PTHREAD_ONCE_INIT;
+
+static void pool_register_atfork(void) { pthread_atfork(NULL, NULL, pool_atfork_child); }
+#endif
+
+static bool pool_start(void) {
+    size_t num_threads = get_num_threads();
+    if (num_threads <= 1) {
+        return false;
+    }
+
+    size_t num_workers = num_threads - 1;
+    pool_worker_t *workers = (pool_worker_t *)calloc(num_workers, sizeof(pool_worker_t));
+    pool_queue_t *queues = (pool_queue_t *)calloc(num_workers + 1, sizeof(pool_queue_t));
+    if (!workers || !queues) {
+        free(workers);
+        free(queues);
+        return false;
+    }
+    for (size_t i = 0; i <= num_workers; i++) {
+        atomic_init(&queues[i].run, 0);
+    }
+    pool.queues = queues;
+
+    // With an affinity mask, worker i is pinned to CPU (i + 1) of the mask; the
+    // first CPU is left for the calling thread
+    int cpus[POOL_MAX_CPUS];
+    size_t num_cpus = 0;
+    if (atomic_load(&config.mask_cpus) > 0) {
+        for (int cpu = 0; cpu < POOL_MAX_CPUS; cpu++) {
+            if (config.mask[cpu / 64] & ((uint64_t)1 << (cpu % 64))) {
+                cpus[num_cpus++] = cpu;
+            }
+        }
+    }
+
+    size_t started = 0;
+    for (; started < num_workers; started++) {
+        pool_worker_t *w = &workers[started];
+        atomic_init(&w->job, NULL);
+        w->id = started + 1;
+        w->cpu = num_cpus > 0 ? cpus[(started + 1) % num_cpus] : -1;
+        atomic_init(&w->sleeping, 0);
+        mutex_init(&w->lock);
+        cond_init(&w->cond);
+        if (thread_create(&w->thread, pool_worker_main, w) != 0) {
+            break;
+        }
+    }
+
+    if (started == 0) {
+        free(workers);
+        free(queues);
+        pool.queues = NULL;
+        return false;
+    }
+
+#if defined(HAVE_PTHREAD) && (defined(__unix__) || defined(__APPLE__))
+    pthread_once(&pool_atfork_once, pool_register_atfork);
+#endif
+
+    pool.workers = workers;
+    pool.num_workers = started;
+    return true;
+}
+
+static void pool_stop(void) {
+    for (size_t i = 0; i < pool.num_workers; i++) {
+        pool_publish(&pool.workers[i], &pool_exit_job);
+    }
+    for (size_t i = 0; i < pool.num_workers; i++) {
+        thread_join(pool.workers[i].thread);
+    }
+    free(pool.workers);
+    free(pool.queues);
+    pool.workers = NULL;
+    pool.queues = NULL;
+    pool.num_workers = 0;
+}
+
+// Must be called while holding pool.busy
+static bool pool_ensure_started(void) {
+    unsigned epoch = atomic_load_explicit(&config.epoch, memory_order_acquire);
+    int state = atomic_load_explicit(&pool.state, memory_order_relaxed);
+    if (state != POOL_UNINIT && pool.epoch == epoch) {
+        return state == POOL_READY;
+    }
+
+    // First use, or the configuration changed since the workers were started
+    if (state == POOL_READY) {
+        pool_stop();
+    }
+    pool.epoch = epoch;
+    bool ok = pool_start();
+    atomic_store_explicit(&pool.state, ok ? POOL_READY : POOL_DISABLED, memory_order_relaxed);
+    return ok;
+}
+
+static void pool_dispatch(size_t start, size_t end, size_t grain, parallel_for_fn fn, void *ctx,
+                          bool steal) {
+    if (end <= start) {
+        return;
+    }
+
+    size_t n = end - start;
+    if (grain == 0) {
+        grain = 1;
+    }
+
+    if (n < grain * 2 || pool_in_worker) {
+        fn(start, end, ctx);
+        return;
+    }
+
+    if (atomic_flag_test_and_set_explicit(&pool.busy, memory_order_acquire)) {
+        fn(start, end, ctx);
+        return;
+    }
+
+    if (!pool_ensure_started()) {
+        atomic_flag_clear_explicit(&pool.busy, memory_order_release);
+        fn(start, end, ctx);
+        return;
+    }
+
+    size_t num_participants = n / grain;
+    if (num_participants > pool.num_workers + 1) {
+        num_participants = pool.num_workers + 1;
+    }
+
+    size_t max_tasks = num_participants * POOL_TASKS_PER_THREAD;
+    size_t task_size = (n + max_tasks - 1) / max_tasks;
+    if (task_size < grain) {
+        task_size = grain;
+    }
+    size_t num_tasks = (n + task_size - 1) / task_size;
+
+    pool_job_t job;
+    job.fn = fn;
+    job.ctx = ctx;
+    job.start = start;
+    job.end = end;
+    job.task_size = task_size;
+    job.num_participants = num_participants;
+    job.steal = steal;
+    atomic_init(&job.pending, num_participants - 1);
+#ifdef HODU_PROFILE_ACTIVE
+    job.profile = hodu_cpu_profile_current();
+    hodu_cpu_profile_threads(num_participants);
+#endif
+
+    // Hand out contiguous runs of tasks before waking anyone
+    for (size_t p = 0; p < num_participants; p++) {
+        uint32_t lo = (uint32_t)(num_tasks * p / num_participants);
+        uint32_t hi = (uint32_t)(num_tasks * (p + 1) / num_participants);
+        atomic_store_explicit(&pool.queues[p].run, pool_pack_run(lo, hi), memory_order_relaxed);
+    }
+
+    for (size_t p = 1; p < num_participants; p++) {
+        pool_publish(&pool.workers[p - 1], &job);
+    }
+
+    pool_participate(&job, 0);
+
+    for (int i = 0; atomic_load_explicit(&job.pending, memory_order_acquire) != 0; i++) {
+        if (i < POOL_SPIN_ITERS) {
+            pool_cpu_relax();
+        } else {
+            pool_yield();
+        }
+    }
+
+    atomic_flag_clear_explicit(&pool.busy, memory_order_release);
+}
+
+void hodu_cpu_parallel_for(size_t start, size_t end, size_t grain, parallel_for_fn fn, void *ctx) {
+    pool_dispatch(start, end, grain, fn, ctx, true);
+}
+
+void hodu_cpu_parallel_for_static(size_t start, size_t end, size_t grain, parallel_for_fn fn,
+                                  void *ctx) {
+    pool_dispatch(start, end, grain, fn, ctx, false);
+}
+
+#else
+
+void hodu_cpu_parallel_for(size_t start, size_t end, size_t grain, parallel_for_fn fn, void *ctx) {
+    (void)grain;
+    if (end > start) {
+        fn(start, end, ctx);
+    }
+}
+
+void hodu_cpu_parallel_for_static(size_t start, size_t end, size_t grain, parallel_for_fn fn,
+                                  void *ctx) {
+    (void)grain;
+    if (end > start) {
+        fn(start, end, ctx);
+    }
+}
+
+#endif
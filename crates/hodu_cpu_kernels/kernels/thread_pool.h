@@ -0,0 +1,85 @@
+/**
+ * @file thread_pool.h
+ * @brief Thread pool configuration header
+ *
+ * Provides runtime control over the worker pool used by parallel kernels:
+ * - Thread count (cached, cpuset and cgroup-quota aware default)
+ * - CPU affinity of the pool workers
+ * - Deterministic mode (split sums sized by a fixed thread count)
+ *
+ * Settings take effect on the next parallel kernel; running kernels finish
+ * with the old workers.
+ */
+
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// ============================================================================
+// THREAD COUNT
+// ============================================================================
+//
+// The default thread count is detected once and cached:
+// - HODU_NUM_THREADS environment variable, if set to a positive number
+// - Otherwise online CPUs, clamped to the process cpuset (sched_getaffinity)
+//   and to the cgroup CPU quota (cpu.max, or cpu.cfs_quota_us on cgroup v1)
+//
+// Precedence: hodu_cpu_set_num_threads > affinity mask size > default.
+// Without ENABLE_THREADS the thread count is always 1.
+
+/// Number of threads (including the caller) that parallel kernels use
+size_t hodu_cpu_get_num_threads(void);
+
+/// Set the number of threads for parallel kernels (0 restores the default)
+void hodu_cpu_set_num_threads(size_t num_threads);
+
+// ============================================================================
+// CPU AFFINITY
+// ============================================================================
+//
+// Restricts the pool workers to a CPU set: bit (i % 64) of mask[i / 64] selects
+// CPU i. Worker k is pinned to the (k + 1)-th CPU of the set (wrapping); the
+// first CPU is meant for the calling thread, which is left unpinned so callers
+// can place it themselves. Unless a thread count is set explicitly, the pool
+// uses one thread per CPU in the mask.
+//
+// Pass mask = NULL or an all-zero mask to remove the restriction.
+//
+// Returns 0 on success, -1 if affinity is unsupported on this platform
+// (Linux and Windows processor group 0 only) or the mask addresses CPUs
+// beyond the supported range (1024 on Linux, 64 on Windows).
+
+/// Pin pool workers to the CPUs in mask
+int hodu_cpu_set_affinity_mask(const uint64_t *mask, size_t num_words);
+
+// ============================================================================
+// DETERMINISTIC MODE
+// ============================================================================
+//
+// Kernels that split a sum across threads size the split by a fixed thread
+// count (DETERMINISTIC_THREADS) instead of the pool, so their blocking and
+// merge order only depend on the shape. Covered: the split-K path of the
+// reductions (ops_reduce.c), the batch split of the native conv2d_grad_weight
+// and the KV-cache split of attention decode. Native matmul/GEMM never splits K
+// and needs no change; BLAS backends keep their own threading. With these, a
+// build gives bit-identical results for any pool size. Off by default;
+// HODU_DETERMINISTIC=1 turns it on at startup. Changes take effect on the next
+// kernel.
+
+/// Nonzero when deterministic mode is on
+int hodu_cpu_get_deterministic(void);
+
+/// Turn deterministic mode on (nonzero) or off (0)
+void hodu_cpu_set_deterministic(int enabled);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // THREAD_POOL_H
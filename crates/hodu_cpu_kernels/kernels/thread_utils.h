@@ -1,6 +1,8 @@
 #ifndef THREAD_UTILS_H
 #define THREAD_UTILS_H
 
+#include "thread_pool.h"
+#include "tuning.h"
 #include <stddef.h>
 #include <stdlib.h>
 
@@ -24,35 +26,19 @@
 #endif
 #endif
 
-// Get number of CPU cores
-static inline size_t get_num_threads(void) {
-#if defined(ENABLE_THREADS)
-#if defined(__unix__) || defined(__APPLE__)
-    long nproc = sysconf(_SC_NPROCESSORS_ONLN);
-    return (nproc > 0) ? (size_t)nproc : 1;
-#elif defined(_WIN32)
-    SYSTEM_INFO sysinfo;
-    GetSystemInfo(&sysinfo);
-    return (size_t)sysinfo.dwNumberOfProcessors;
-#else
-    return 1;
-#endif
-#else
-    return 1;
-#endif
-}
+// Get number of threads kernels may use (cached; see hodu_cpu_get_num_threads)
+static inline size_t get_num_threads(void) { return hodu_cpu_get_num_threads(); }
 
-// Determine optimal number of threads for workload
-// Returns 1 for small workloads to avoid threading overhead
-static inline size_t get_optimal_threads(size_t workload_size, size_t min_work_per_thread) {
-    if (workload_size < min_work_per_thread * 2) {
-        return 1; // Too small for parallelization
-    }
+// Nonzero when results must not depend on the thread count (see hodu_cpu_get_deterministic)
+static inline int is_deterministic(void) { return hodu_cpu_get_deterministic(); }
 
-    size_t max_threads = get_num_threads();
-    size_t optimal_threads = workload_size / min_work_per_thread;
+// Thread count assumed by kernels that split a sum in deterministic mode
+#define DETERMINISTIC_THREADS 64
 
-    return (optimal_threads < max_threads) ? optimal_threads : max_threads;
+// Thread count to size a split sum by: the pool size, or DETERMINISTIC_THREADS in deterministic
+// mode so the blocking and the merge order only depend on the shape
+static inline size_t get_split_threads(void) {
+    return is_deterministic() ? DETERMINISTIC_THREADS : get_num_threads();
 }
 
 // Thread abstraction layer
@@ -66,6 +52,17 @@ static inline int thread_create(thread_t *thread, void *(*start_routine)(void *)
 
 static inline int thread_join(thread_t thread) { return pthread_join(thread, NULL); }
 
+typedef pthread_mutex_t mutex_t;
+typedef pthread_cond_t cond_t;
+
+static inline void mutex_init(mutex_t *m) { pthread_mutex_init(m, NULL); }
+static inline void mutex_lock(mutex_t *m) { pthread_mutex_lock(m); }
+static inline void mutex_unlock(mutex_t *m) { pthread_mutex_unlock(m); }
+static inline void cond_init(cond_t *c) { pthread_cond_init(c, NULL); }
+static inline void cond_wait(cond_t *c, mutex_t *m) { pthread_cond_wait(c, m); }
+static inline void cond_signal(cond_t *c) { pthread_cond_signal(c); }
+static inline void cond_broadcast(cond_t *c) { pthread_cond_broadcast(c); }
+
 #elif defined(HAVE_WIN32_THREADS)
 // Windows native threads
 typedef HANDLE thread_t;
@@ -109,6 +106,19 @@ static inline int thread_join(thread_t thread) {
     return 0;
 }
 
+typedef SRWLOCK mutex_t;
+typedef CONDITION_VARIABLE cond_t;
+
+static inline void mutex_init(mutex_t *m) { InitializeSRWLock(m); }
+static inline void mutex_lock(mutex_t *m) { AcquireSRWLockExclusive(m); }
+static inline void mutex_unlock(mutex_t *m) { ReleaseSRWLockExclusive(m); }
+static inline void cond_init(cond_t *c) { InitializeConditionVariable(c); }
+static inline void cond_wait(cond_t *c, mutex_t *m) {
+    SleepConditionVariableSRW(c, m, INFINITE, 0);
+}
+static inline void cond_signal(cond_t *c) { WakeConditionVariable(c); }
+static inline void cond_broadcast(cond_t *c) { WakeAllConditionVariable(c); }
+
 #else
 // No threading support
 typedef int thread_t;
@@ -126,4 +136,73 @@ static inline int thread_join(thread_t thread) {
 }
 #endif
 
+// ============================================================================
+// PERSISTENT THREAD POOL
+// ============================================================================
+//
+// Kernels dispatch parallel work through parallel_for() instead of spawning
+// threads per call. The pool is created lazily on first use and lives for the
+// rest of the process; the calling thread always participates in the work.
+//
+// - Nested calls (from inside a pool task) run inline on the calling thread.
+// - Concurrent calls from different external threads are not queued: if the
+//   pool is busy the second caller runs its range inline.
+// - Without ENABLE_THREADS, parallel_for() simply runs fn(start, end, ctx).
+//
+// The implementation lives in thread_pool.c.
+
+/// Task body for parallel_for: process items in [start, end)
+typedef void (*parallel_for_fn)(size_t start, size_t end, void *ctx);
+
+/// Exported pool entry point (see parallel_for)
+void hodu_cpu_parallel_for(size_t start, size_t end, size_t grain, parallel_for_fn fn, void *ctx);
+
+/// Split [start, end) into chunks of at least `grain` items and run them on the pool
+///
+/// @param start First item index
+/// @param end One past the last item index
+/// @param grain Minimum number of items per chunk (ranges below 2 * grain run inline)
+/// @param fn Task body, called with disjoint sub-ranges
+/// @param ctx Opaque pointer passed to every fn call
+static inline void parallel_for(size_t start, size_t end, size_t grain, parallel_for_fn fn,
+                                void *ctx) {
+    hodu_cpu_parallel_for(start, end, grain, fn, ctx);
+}
+
+/// Exported pool entry point (see parallel_for_static)
+void hodu_cpu_parallel_for_static(size_t start, size_t end, size_t grain, parallel_for_fn fn,
+                                  void *ctx);
+
+/// Split [start, end) into one equal slice per participant, without work stealing
+///
+/// Participant p (the caller for p = 0, pool worker p - 1 otherwise) runs
+/// exactly the p-th slice, so the split matches the initial runs parallel_for
+/// hands out over the same range. Meant for first-touch page placement, where
+/// the thread that writes a page decides its NUMA node; use parallel_for for
+/// compute, since a slow participant is not rebalanced here.
+///
+/// @param grain Minimum number of items per slice (ranges below 2 * grain run inline)
+static inline void parallel_for_static(size_t start, size_t end, size_t grain, parallel_for_fn fn,
+                                       void *ctx) {
+    hodu_cpu_parallel_for_static(start, end, grain, fn, ctx);
+}
+
+/// parallel_for grain for items of `units_per_item` units of cost_class work (see tuning.h)
+///
+/// The pool then runs at most (end - start) / grain threads, so the cost model
+/// sets both the task size and the thread count.
+static inline size_t task_grain(hodu_cpu_cost_class_t cost_class, double units_per_item) {
+    return hodu_cpu_grain(cost_class, units_per_item);
+}
+
+/// parallel_for with tasks sized from the kernel's measured cost per item (see tuning.h)
+///
+/// @param cost Function-local static of the calling kernel
+/// @param cost_class Class used until the kernel has been measured
+static inline void parallel_for_measured(hodu_cpu_cost_t *cost, hodu_cpu_cost_class_t cost_class,
+                                         size_t start, size_t end, parallel_for_fn fn,
+                                         void *ctx) {
+    hodu_cpu_parallel_for_measured(cost, cost_class, start, end, fn, ctx);
+}
+
 #endif // THREAD_UTILS_H
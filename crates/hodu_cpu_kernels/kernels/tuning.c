@@ -0,0 +1,394 @@
+#if !defined(_WIN32) && !defined(_POSIX_C_SOURCE)
+// clock_gettime / CLOCK_MONOTONIC under -std=c11
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+#include "tuning.h"
+#include "simd_utils.h"
+#include "thread_utils.h"
+#include <math.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+// ============================================================================
+// PARAMETERS
+// ============================================================================
+//
+// Defaults assume one core moves ~10 GB/s, runs a cheap elementwise op in
+// 0.5 ns and a vectorized transcendental in 2 ns per element, and a 20 us task
+// hides the pool's wake-up and join. Calibration replaces them with measured
+// values, clamped to sane ranges so one noisy run cannot serialize or shred
+// every kernel.
+
+#define TUNING_DEFAULT_TASK_NS 20000.0
+#define TUNING_MIN_TASK_NS 2000.0
+#define TUNING_MAX_TASK_NS 500000.0
+
+// Calibrated task duration per measured dispatch round trip (overhead <= 1/8 of a task)
+#define TUNING_DISPATCH_RATIO 8.0
+
+static const double tuning_default_cost[HODU_CPU_COST_NUM_CLASSES] = {0.1, 0.5, 2.0, 0.25};
+static const char *const tuning_keys[HODU_CPU_COST_NUM_CLASSES] = {"copy", "elementwise",
+                                                                   "transcendental", "fma"};
+
+static struct {
+    _Atomic double task_ns;
+    _Atomic double ns_per_unit[HODU_CPU_COST_NUM_CLASSES];
+    atomic_int state; // TUNING_UNINIT, TUNING_BUSY, TUNING_READY
+} tuning;
+
+enum { TUNING_UNINIT = 0, TUNING_BUSY, TUNING_READY };
+
+static uint64_t tuning_now_ns(void) {
+    struct timespec ts;
+#if defined(CLOCK_MONOTONIC)
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+#else
+    timespec_get(&ts, TIME_UTC);
+#endif
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+static double tuning_clamp(double v, double lo, double hi) { return v < lo ? lo : v > hi ? hi : v; }
+
+static void tuning_store(const hodu_cpu_tuning_t *t) {
+    if (t->task_ns > 0) {
+        atomic_store_explicit(&tuning.task_ns,
+                              tuning_clamp(t->task_ns, TUNING_MIN_TASK_NS, TUNING_MAX_TASK_NS),
+                              memory_order_relaxed);
+    }
+    for (int c = 0; c < HODU_CPU_COST_NUM_CLASSES; c++) {
+        if (t->ns_per_unit[c] > 0) {
+            atomic_store_explicit(&tuning.ns_per_unit[c], t->ns_per_unit[c],
+                                  memory_order_relaxed);
+        }
+    }
+}
+
+static void tuning_read(hodu_cpu_tuning_t *out) {
+    out->task_ns = atomic_load_explicit(&tuning.task_ns, memory_order_relaxed);
+    for (int c = 0; c < HODU_CPU_COST_NUM_CLASSES; c++) {
+        out->ns_per_unit[c] = atomic_load_explicit(&tuning.ns_per_unit[c], memory_order_relaxed);
+    }
+}
+
+// ============================================================================
+// CALIBRATION
+// ============================================================================
+//
+// Each class runs a loop like the kernels' inner loops on the calling thread
+// and keeps the fastest of a few repetitions; dispatch is the median round trip
+// of a parallel_for with one empty task per thread, with the workers warm as
+// in a sequence of kernels.
+
+#define TUNING_REPS 5
+#define TUNING_DISPATCH_REPS 33
+
+static volatile float tuning_sink;
+
+// Elements of the f32 buffers (3 x 256 KiB: L2 to L3 resident, like large kernel rows)
+#define TUNING_ELEMS (1 << 16)
+#define TUNING_FMA_K 64
+
+static double tuning_measure_class(hodu_cpu_cost_class_t cost_class, float *a, float *b,
+                                   float *c) {
+    const size_t n = TUNING_ELEMS;
+    double best = 0.0;
+    for (int rep = 0; rep < TUNING_REPS; rep++) {
+        uint64_t t0 = tuning_now_ns();
+        double units = 0.0;
+        switch (cost_class) {
+        case HODU_CPU_COST_COPY:
+            memcpy(c, a, n * sizeof(float));
+            memcpy(a, b, n * sizeof(float));
+            units = 2.0 * n * sizeof(float);
+            break;
+        case HODU_CPU_COST_ELEMENTWISE:
+            for (size_t i = 0; i < n; i++) {
+                c[i] = a[i] + b[i];
+            }
+            units = (double)n;
+            break;
+        case HODU_CPU_COST_TRANSCENDENTAL: {
+            size_t i = 0;
+#if SIMD_F32_WIDTH > 1
+            for (; i + SIMD_F32_WIDTH <= n; i += SIMD_F32_WIDTH) {
+                simd_f32_store(c + i, simd_f32_exp(simd_f32_load(a + i)));
+            }
+#endif
+            for (; i < n; i++) {
+                c[i] = expf(a[i]);
+            }
+            units = (double)n;
+            break;
+        }
+        case HODU_CPU_COST_FMA:
+            // Row updates of an i-k-j matmul: c[0:N] += a[k] * b[k, 0:N]
+            for (size_t k = 0; k < TUNING_FMA_K; k++) {
+                const float s = a[k];
+                const float *row = b + k * (n / TUNING_FMA_K);
+                for (size_t j = 0; j < n / TUNING_FMA_K; j++) {
+                    c[j] += s * row[j];
+                }
+            }
+            units = (double)n;
+            break;
+        default:
+            return 0.0;
+        }
+        double ns = (double)(tuning_now_ns() - t0) / units;
+        tuning_sink = c[rep];
+        if (rep == 0 || ns < best) {
+            best = ns;
+        }
+    }
+    return best;
+}
+
+typedef struct {
+    atomic_size_t remote; // tasks run by pool workers
+} tuning_dispatch_args_t;
+
+static _Thread_local bool tuning_is_caller = false;
+
+static void tuning_dispatch_task(size_t start, size_t end, void *arg) {
+    tuning_dispatch_args_t *args = (tuning_dispatch_args_t *)arg;
+    if (!tuning_is_caller) {
+        atomic_fetch_add_explicit(&args->remote, end - start, memory_order_relaxed);
+    }
+}
+
+static int tuning_compare_u64(const void *a, const void *b) {
+    uint64_t x = *(const uint64_t *)a, y = *(const uint64_t *)b;
+    return (x > y) - (x < y);
+}
+
+/// Median parallel_for round trip in ns, 0 if the work never reached a worker
+static double tuning_measure_dispatch(void) {
+    const size_t threads = get_num_threads();
+    if (threads < 2) {
+        return 0.0;
+    }
+    tuning_dispatch_args_t args;
+    atomic_init(&args.remote, 0);
+    uint64_t times[TUNING_DISPATCH_REPS];
+
+    tuning_is_caller = true;
+    parallel_for(0, threads, 1, tuning_dispatch_task, &args); // start the pool
+    for (int rep = 0; rep < TUNING_DISPATCH_REPS; rep++) {
+        uint64_t t0 = tuning_now_ns();
+        parallel_for(0, threads, 1, tuning_dispatch_task, &args);
+        times[rep] = tuning_now_ns() - t0;
+    }
+    tuning_is_caller = false;
+
+    if (atomic_load(&args.remote) == 0) {
+        return 0.0; // ran inline: nested in a kernel, or the pool is busy or unavailable
+    }
+    qsort(times, TUNING_DISPATCH_REPS, sizeof(uint64_t), tuning_compare_u64);
+    return (double)times[TUNING_DISPATCH_REPS / 2];
+}
+
+static int tuning_run_calibration(void) {
+    hodu_cpu_tuning_t t = {0};
+    float *buf = (float *)malloc(3 * TUNING_ELEMS * sizeof(float));
+    if (buf) {
+        for (size_t i = 0; i < 3 * TUNING_ELEMS; i++) {
+            buf[i] = (float)(i % 97) * 0.01f;
+        }
+        for (int c = 0; c < HODU_CPU_COST_NUM_CLASSES; c++) {
+            double ns = tuning_measure_class((hodu_cpu_cost_class_t)c, buf, buf + TUNING_ELEMS,
+                                             buf + 2 * TUNING_ELEMS);
+            // Within 16x of the default either way
+            t.ns_per_unit[c] = tuning_clamp(ns, tuning_default_cost[c] / 16.0,
+                                            tuning_default_cost[c] * 16.0);
+        }
+        free(buf);
+    }
+
+    double dispatch_ns = tuning_measure_dispatch();
+    t.task_ns = dispatch_ns * TUNING_DISPATCH_RATIO;
+    tuning_store(&t);
+    return dispatch_ns > 0 ? 0 : -1;
+}
+
+// ============================================================================
+// FILE FORMAT
+// ============================================================================
+
+static int tuning_parse_file(const char *path, hodu_cpu_tuning_t *t) {
+    FILE *f = path ? fopen(path, "r") : NULL;
+    if (!f) {
+        return -1;
+    }
+    char line[256];
+    while (fgets(line, sizeof(line), f)) {
+        char *hash = strchr(line, '#');
+        if (hash) {
+            *hash = '\0';
+        }
+        char key[64];
+        double value;
+        if (sscanf(line, "%63s %lf", key, &value) != 2) {
+            continue;
+        }
+        if (strcmp(key, "task_ns") == 0) {
+            t->task_ns = value;
+        }
+        for (int c = 0; c < HODU_CPU_COST_NUM_CLASSES; c++) {
+            if (strcmp(key, tuning_keys[c]) == 0) {
+                t->ns_per_unit[c] = value;
+            }
+        }
+    }
+    fclose(f);
+    return 0;
+}
+
+// ============================================================================
+// INITIALIZATION
+// ============================================================================
+
+static void tuning_ensure(void) {
+    if (atomic_load_explicit(&tuning.state, memory_order_acquire) == TUNING_READY) {
+        return;
+    }
+    int expected = TUNING_UNINIT;
+    if (!atomic_compare_exchange_strong(&tuning.state, &expected, TUNING_BUSY)) {
+        while (atomic_load_explicit(&tuning.state, memory_order_acquire) != TUNING_READY) {
+        }
+        return;
+    }
+
+    atomic_store_explicit(&tuning.task_ns, TUNING_DEFAULT_TASK_NS, memory_order_relaxed);
+    for (int c = 0; c < HODU_CPU_COST_NUM_CLASSES; c++) {
+        atomic_store_explicit(&tuning.ns_per_unit[c], tuning_default_cost[c],
+                              memory_order_relaxed);
+    }
+
+    const char *file = getenv("HODU_TUNING_FILE");
+    const char *autotune = getenv("HODU_AUTOTUNE");
+    hodu_cpu_tuning_t t = {0};
+    if (file && tuning_parse_file(file, &t) == 0) {
+        tuning_store(&t);
+    } else if (!autotune || strcmp(autotune, "0") != 0) {
+        tuning_run_calibration();
+    }
+
+    atomic_store_explicit(&tuning.state, TUNING_READY, memory_order_release);
+}
+
+// ============================================================================
+// PUBLIC API
+// ============================================================================
+
+void hodu_cpu_tuning_get(hodu_cpu_tuning_t *out) {
+    tuning_ensure();
+    tuning_read(out);
+}
+
+void hodu_cpu_tuning_set(const hodu_cpu_tuning_t *t) {
+    tuning_ensure();
+    if (t) {
+        tuning_store(t);
+    }
+}
+
+int hodu_cpu_tuning_calibrate(void) {
+    tuning_ensure();
+    return tuning_run_calibration();
+}
+
+int hodu_cpu_tuning_load(const char *path) {
+    tuning_ensure();
+    hodu_cpu_tuning_t t = {0};
+    if (tuning_parse_file(path, &t) != 0) {
+        return -1;
+    }
+    tuning_store(&t);
+    return 0;
+}
+
+int hodu_cpu_tuning_save(const char *path) {
+    hodu_cpu_tuning_t t;
+    hodu_cpu_tuning_get(&t);
+    FILE *f = path ? fopen(path, "w") : NULL;
+    if (!f) {
+        return -1;
+    }
+    fprintf(f, "# hodu_cpu_kernels tuning (ns per unit: byte, element or multiply-add)\n");
+    fprintf(f, "task_ns %.17g\n", t.task_ns);
+    for (int c = 0; c < HODU_CPU_COST_NUM_CLASSES; c++) {
+        fprintf(f, "%s %.17g\n", tuning_keys[c], t.ns_per_unit[c]);
+    }
+    return fclose(f) == 0 ? 0 : -1;
+}
+
+// ============================================================================
+// TASK SIZES
+// ============================================================================
+
+// Items the measured kernels time on the calling thread per probe
+#define TUNING_PROBE_ITEMS 1024
+// Probes per kernel; the lowest result is kept (the first call often runs cold)
+#define TUNING_PROBE_SAMPLES 4
+
+static size_t tuning_items(double task_ns, double ns_per_item) {
+    double items = task_ns / ns_per_item;
+    if (!(items >= 1.0)) {
+        return 1;
+    }
+    return items < (double)(SIZE_MAX / 4) ? (size_t)items : SIZE_MAX / 4;
+}
+
+size_t hodu_cpu_grain(hodu_cpu_cost_class_t cost_class, double units_per_item) {
+    tuning_ensure();
+    if ((unsigned)cost_class >= HODU_CPU_COST_NUM_CLASSES) {
+        cost_class = HODU_CPU_COST_ELEMENTWISE;
+    }
+    double ns = atomic_load_explicit(&tuning.ns_per_unit[cost_class], memory_order_relaxed);
+    return tuning_items(atomic_load_explicit(&tuning.task_ns, memory_order_relaxed),
+                        ns * units_per_item);
+}
+
+void hodu_cpu_parallel_for_measured(hodu_cpu_cost_t *cost, hodu_cpu_cost_class_t cost_class,
+                                    size_t start, size_t end,
+                                    void (*fn)(size_t start, size_t end, void *ctx), void *ctx) {
+    if (end <= start) {
+        return;
+    }
+    uint32_t ps = atomic_load_explicit(&cost->ps_per_item, memory_order_relaxed);
+
+    if (end - start >= 4 * TUNING_PROBE_ITEMS && get_num_threads() > 1 &&
+        atomic_load_explicit(&cost->samples, memory_order_relaxed) < TUNING_PROBE_SAMPLES) {
+        uint64_t t0 = tuning_now_ns();
+        fn(start, start + TUNING_PROBE_ITEMS, ctx);
+        uint64_t probe_ps = (tuning_now_ns() - t0) * 1000 / TUNING_PROBE_ITEMS;
+        start += TUNING_PROBE_ITEMS;
+        atomic_fetch_add_explicit(&cost->samples, 1, memory_order_relaxed);
+
+        uint32_t measured = probe_ps < 1 ? 1 : probe_ps > UINT32_MAX ? UINT32_MAX
+                                                                      : (uint32_t)probe_ps;
+        while ((ps == 0 || measured < ps) &&
+               !atomic_compare_exchange_weak_explicit(&cost->ps_per_item, &ps, measured,
+                                                      memory_order_relaxed,
+                                                      memory_order_relaxed)) {
+        }
+        if (ps == 0 || measured < ps) {
+            ps = measured;
+        }
+    }
+
+    size_t grain;
+    if (ps > 0) {
+        tuning_ensure();
+        grain = tuning_items(atomic_load_explicit(&tuning.task_ns, memory_order_relaxed),
+                             ps / 1000.0);
+    } else {
+        grain = hodu_cpu_grain(cost_class, 1.0);
+    }
+    parallel_for(start, end, grain, fn, ctx);
+}
@@ -0,0 +1,108 @@
+/**
+ * @file tuning.h
+ * @brief Cost model behind the parallel task sizes of the kernels
+ *
+ * Kernels size their parallel_for tasks from a cost model instead of fixed
+ * element counts:
+ * - A target task duration: long enough that waking the pool and joining it
+ *   stays a small fraction of every task
+ * - A cost per unit of work for each op class (bytes copied, cheap
+ *   elementwise ops, transcendental elementwise ops, multiply-adds)
+ *
+ * A task then holds task_ns / (cost of one item) items, so cheap copies get
+ * large tasks and exp/gelu-like ops split across threads at much smaller
+ * sizes. Elementwise kernels refine this with their own measured cost per
+ * element (see hodu_cpu_parallel_for_measured), which separates e.g. `neg`
+ * from `sin` sharing one implementation macro.
+ *
+ * Values come, on first use, from
+ * - the file named by HODU_TUNING_FILE (see hodu_cpu_tuning_load), else
+ * - a micro-benchmark of pool dispatch and of each op class (~1 ms), unless
+ *   HODU_AUTOTUNE=0 keeps the built-in defaults.
+ * Task sizes only change how work is split: results do not depend on them.
+ */
+
+#ifndef HODU_CPU_KERNELS_TUNING_H
+#define HODU_CPU_KERNELS_TUNING_H
+
+#include <stdatomic.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// Op classes of the cost model and the unit their cost is measured in
+typedef enum {
+    HODU_CPU_COST_COPY = 0,       // per byte copied (copies, fills, casts, gathers, padding)
+    HODU_CPU_COST_ELEMENTWISE,    // per element of a cheap arithmetic or logical op
+    HODU_CPU_COST_TRANSCENDENTAL, // per element of an exp/log/erf/tanh-class op
+    HODU_CPU_COST_FMA,            // per multiply-add of the scalar matmul/dot loops
+    HODU_CPU_COST_NUM_CLASSES,
+} hodu_cpu_cost_class_t;
+
+/// Cost model parameters
+typedef struct {
+    double task_ns; // target duration of the smallest parallel task
+    double ns_per_unit[HODU_CPU_COST_NUM_CLASSES]; // single-thread cost of one unit per class
+} hodu_cpu_tuning_t;
+
+// ============================================================================
+// CONFIGURATION
+// ============================================================================
+
+/// Current parameters (initializing them on first use)
+void hodu_cpu_tuning_get(hodu_cpu_tuning_t *out);
+
+/// Replace the parameters; values <= 0 keep the current ones
+///
+/// task_ns is clamped to [2 us, 500 us].
+void hodu_cpu_tuning_set(const hodu_cpu_tuning_t *tuning);
+
+/// Run the micro-benchmarks now and use their results
+///
+/// Returns 0 on success, -1 if pool dispatch could not be measured (one thread,
+/// or called from inside a parallel kernel); the class costs are still updated.
+int hodu_cpu_tuning_calibrate(void);
+
+/// Load parameters from a text file of `key value` lines
+///
+/// Keys: task_ns, copy, elementwise, transcendental, fma (ns per unit).
+/// Missing keys keep their current values; `#` starts a comment.
+/// Returns 0 on success, -1 if the file cannot be read.
+int hodu_cpu_tuning_load(const char *path);
+
+/// Write the current parameters in the format read by hodu_cpu_tuning_load
+///
+/// Returns 0 on success, -1 if the file cannot be written.
+int hodu_cpu_tuning_save(const char *path);
+
+// ============================================================================
+// TASK SIZES (internal)
+// ============================================================================
+
+/// Items per task for items of `units_per_item` units of `cost_class` work
+size_t hodu_cpu_grain(hodu_cpu_cost_class_t cost_class, double units_per_item);
+
+/// Measured cost of one kernel, kept in a function-local static (zero-initialized)
+typedef struct {
+    _Atomic uint32_t ps_per_item; // lowest probe result in picoseconds, 0 = not measured yet
+    atomic_uint samples;          // probes taken
+} hodu_cpu_cost_t;
+
+/// parallel_for with tasks sized from the kernel's measured cost per item
+///
+/// The first few calls large enough to matter run a probe of the leading
+/// items on the calling thread and time it, keeping the lowest result; until
+/// then tasks are sized from `cost_class` at one unit per item. Items must be
+/// independent: the range may be split anywhere.
+void hodu_cpu_parallel_for_measured(hodu_cpu_cost_t *cost, hodu_cpu_cost_class_t cost_class,
+                                    size_t start, size_t end,
+                                    void (*fn)(size_t start, size_t end, void *ctx), void *ctx);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // HODU_CPU_KERNELS_TUNING_H
@@ -37,6 +37,114 @@ static inline size_t get_strided_index(size_t idx, size_t num_dims, const size_t
     return strided_i;
 }
 
+// Dims a strided_iter_t tracks after merging (layouts left with more use get_strided_index)
+#define STRIDED_ITER_MAX_DIMS 16
+
+/// Row-major walk over a strided layout without per-element division
+///
+/// Size-1 dims are dropped and adjacent dims merged where the strides allow. `offset` is the
+/// strided index of the current element; the strided_iter_row() elements from there lie
+/// `inner_stride` apart, and strided_iter_advance() moves along that row and carries into the
+/// outer dims odometer-style. Walking past the last element wraps to the first, like
+/// get_strided_index().
+typedef struct {
+    size_t offset;
+    size_t inner_stride;
+    size_t num_dims;
+    size_t shape[STRIDED_ITER_MAX_DIMS];
+    size_t strides[STRIDED_ITER_MAX_DIMS];
+    size_t idx[STRIDED_ITER_MAX_DIMS];
+    /* Layout that did not fit after merging: offsets come from the linear index */
+    const size_t *fallback_dims;
+    const size_t *fallback_strides;
+    size_t fallback_num_dims;
+    size_t linear;
+} strided_iter_t;
+
+/// Position the iterator on element `start` (row-major) of the layout
+static inline void strided_iter_init(strided_iter_t *it, size_t num_dims, const size_t *dims,
+                                     const size_t *strides, size_t start) {
+    size_t nd = 0;
+    it->fallback_dims = NULL;
+    it->fallback_strides = NULL;
+    it->fallback_num_dims = 0;
+    it->linear = start;
+    for (size_t d = 0; d < num_dims; d++) {
+        if (dims[d] == 1) {
+            continue;
+        }
+        if (nd > 0 && it->strides[nd - 1] == dims[d] * strides[d]) {
+            it->shape[nd - 1] *= dims[d];
+            it->strides[nd - 1] = strides[d];
+            continue;
+        }
+        if (nd == STRIDED_ITER_MAX_DIMS) {
+            it->fallback_dims = dims;
+            it->fallback_strides = strides;
+            it->fallback_num_dims = num_dims;
+            it->num_dims = 0;
+            it->offset = get_strided_index(start, num_dims, dims, strides);
+            it->inner_stride = 0;
+            return;
+        }
+        it->shape[nd] = dims[d];
+        it->strides[nd] = strides[d];
+        nd++;
+    }
+    if (nd == 0) {
+        it->shape[0] = 1;
+        it->strides[0] = 0;
+        nd = 1;
+    }
+    it->num_dims = nd;
+    it->inner_stride = it->strides[nd - 1];
+
+    it->offset = 0;
+    for (size_t d = nd; d-- > 0;) {
+        it->idx[d] = start % it->shape[d];
+        start /= it->shape[d];
+        it->offset += it->idx[d] * it->strides[d];
+    }
+}
+
+/// Elements left in the current innermost row
+static inline size_t strided_iter_row(const strided_iter_t *it) {
+    if (it->fallback_dims) {
+        return 1;
+    }
+    return it->shape[it->num_dims - 1] - it->idx[it->num_dims - 1];
+}
+
+/// Move n elements forward, where n <= strided_iter_row()
+static inline void strided_iter_advance(strided_iter_t *it, size_t n) {
+    if (it->fallback_dims) {
+        it->linear += n;
+        it->offset = get_strided_index(it->linear, it->fallback_num_dims, it->fallback_dims,
+                                       it->fallback_strides);
+        return;
+    }
+    size_t d = it->num_dims - 1;
+    it->idx[d] += n;
+    it->offset += n * it->strides[d];
+    if (it->idx[d] < it->shape[d]) {
+        return;
+    }
+    /* Row done: carry into the outer dims */
+    it->offset -= it->shape[d] * it->strides[d];
+    it->idx[d] = 0;
+    while (d-- > 0) {
+        it->offset += it->strides[d];
+        if (++it->idx[d] < it->shape[d]) {
+            return;
+        }
+        it->offset -= it->shape[d] * it->strides[d];
+        it->idx[d] = 0;
+    }
+}
+
+/// Move to the next element
+static inline void strided_iter_next(strided_iter_t *it) { strided_iter_advance(it, 1); }
+
 // Generic helper functions
 #define MAXIMUM(a, b) ((a) > (b) ? (a) : (b))
 #define MINIMUM(a, b) ((a) < (b) ? (a) : (b))
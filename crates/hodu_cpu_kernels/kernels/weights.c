@@ -0,0 +1,412 @@
+#if defined(__linux__) && !defined(_DEFAULT_SOURCE)
+// open / fstat / mmap (not _GNU_SOURCE: it declares exp10, which constants.h defines)
+#define _DEFAULT_SOURCE
+#endif
+
+#include "weights.h"
+#include "gemm.h"
+#include "ops_conv.h"
+#include "ops_matrix.h"
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#elif defined(_WIN32)
+#include <windows.h>
+#endif
+
+// ============================================================================
+// FILE FORMAT
+// ============================================================================
+
+#define WEIGHTS_MAGIC "HODUPWF"
+#define WEIGHTS_VERSION 1
+#define WEIGHTS_BYTE_ORDER 0x01020304u
+
+typedef struct {
+    char magic[8];         // WEIGHTS_MAGIC, NUL-terminated
+    uint32_t version;      // WEIGHTS_VERSION
+    uint32_t byte_order;   // WEIGHTS_BYTE_ORDER as written by the producing machine
+    uint64_t layout[2];    // hodu_cpu_gemm_packed_layout_f32 / _f64 of the producer
+    uint64_t num_entries;  // entry table records
+    uint64_t table_offset; // file offset of the entry table
+    uint64_t reserved[2];
+} weights_header_t;
+
+// Conv2d metadata with the fields packing reads (see hodu_cpu_conv2d_pack_weight_*)
+static void weights_conv2d_metadata(const uint64_t dims[4], size_t metadata[18]) {
+    memset(metadata, 0, 18 * sizeof(size_t));
+    metadata[2] = (size_t)dims[1];
+    metadata[3] = (size_t)dims[0];
+    metadata[6] = (size_t)dims[2];
+    metadata[7] = (size_t)dims[3];
+}
+
+// Packed bytes of an entry in this build's layout
+static size_t weights_packed_bytes(uint32_t kind, const uint64_t dims[4]) {
+    size_t metadata[18];
+    switch (kind) {
+    case HODU_CPU_WEIGHTS_MATMUL_RHS_F32:
+        return hodu_cpu_matmul_packed_rhs_size_f32((size_t)dims[0], (size_t)dims[1]);
+    case HODU_CPU_WEIGHTS_MATMUL_RHS_F64:
+        return hodu_cpu_matmul_packed_rhs_size_f64((size_t)dims[0], (size_t)dims[1]);
+    case HODU_CPU_WEIGHTS_CONV2D_F32:
+        weights_conv2d_metadata(dims, metadata);
+        return hodu_cpu_conv2d_packed_weight_size_f32(metadata);
+    case HODU_CPU_WEIGHTS_CONV2D_F64:
+        weights_conv2d_metadata(dims, metadata);
+        return hodu_cpu_conv2d_packed_weight_size_f64(metadata);
+    default:
+        return 0;
+    }
+}
+
+// ============================================================================
+// WRITER
+// ============================================================================
+
+struct hodu_cpu_weights_writer {
+    FILE *file;
+    uint64_t pos; // bytes written so far
+    hodu_cpu_weights_entry_t *entries;
+    size_t num_entries;
+    size_t cap_entries;
+    bool failed;
+};
+
+static bool weights_write(hodu_cpu_weights_writer_t *w, const void *data, size_t bytes) {
+    if (bytes > 0 && fwrite(data, 1, bytes, w->file) != bytes) {
+        return false;
+    }
+    w->pos += bytes;
+    return true;
+}
+
+// Zero-fill up to the next multiple of `align`
+static bool weights_pad(hodu_cpu_weights_writer_t *w, size_t align) {
+    static const uint8_t zeros[HODU_CPU_WEIGHTS_ALIGN];
+    size_t pad = (size_t)((align - w->pos % align) % align);
+    return weights_write(w, zeros, pad);
+}
+
+hodu_cpu_weights_writer_t *hodu_cpu_weights_create(const char *path) {
+    hodu_cpu_weights_writer_t *w =
+        (hodu_cpu_weights_writer_t *)calloc(1, sizeof(hodu_cpu_weights_writer_t));
+    if (!w) {
+        return NULL;
+    }
+    w->file = fopen(path, "wb");
+    if (!w->file) {
+        free(w);
+        return NULL;
+    }
+
+    // Placeholder, rewritten by finish once the table offset is known
+    weights_header_t header;
+    memset(&header, 0, sizeof(header));
+    w->failed = !weights_write(w, &header, sizeof(header));
+    return w;
+}
+
+// Reserve the entry for `name`; NULL on a duplicate or too long name
+static hodu_cpu_weights_entry_t *weights_new_entry(hodu_cpu_weights_writer_t *w,
+                                                      const char *name) {
+    size_t len = strlen(name);
+    if (len == 0 || len >= HODU_CPU_WEIGHTS_NAME_MAX) {
+        return NULL;
+    }
+    for (size_t i = 0; i < w->num_entries; i++) {
+        if (strcmp(w->entries[i].name, name) == 0) {
+            return NULL;
+        }
+    }
+    if (w->num_entries == w->cap_entries) {
+        size_t cap = w->cap_entries ? w->cap_entries * 2 : 16;
+        hodu_cpu_weights_entry_t *entries = (hodu_cpu_weights_entry_t *)realloc(
+            w->entries, cap * sizeof(hodu_cpu_weights_entry_t));
+        if (!entries) {
+            return NULL;
+        }
+        w->entries = entries;
+        w->cap_entries = cap;
+    }
+
+    hodu_cpu_weights_entry_t *entry = &w->entries[w->num_entries];
+    memset(entry, 0, sizeof(*entry));
+    memcpy(entry->name, name, len);
+    return entry;
+}
+
+// Pack and append one weight; `pack` fills `bytes` of packed data
+static int weights_add(hodu_cpu_weights_writer_t *w, const char *name, uint32_t kind,
+                       const uint64_t dims[4], const void *src, const size_t *metadata,
+                       void (*pack)(const void *, void *, const size_t *)) {
+    if (w->failed) {
+        return -1;
+    }
+    hodu_cpu_weights_entry_t *entry = weights_new_entry(w, name);
+    if (!entry) {
+        return -1;
+    }
+
+    size_t bytes = weights_packed_bytes(kind, dims);
+    void *packed = malloc(bytes > 0 ? bytes : 1);
+    if (!packed) {
+        return -1;
+    }
+    pack(src, packed, metadata);
+
+    if (!weights_pad(w, HODU_CPU_WEIGHTS_ALIGN)) {
+        free(packed);
+        w->failed = true;
+        return -1;
+    }
+    entry->kind = kind;
+    memcpy(entry->dims, dims, sizeof(entry->dims));
+    entry->offset = w->pos;
+    entry->bytes = bytes;
+    bool ok = weights_write(w, packed, bytes);
+    free(packed);
+    if (!ok) {
+        w->failed = true;
+        return -1;
+    }
+
+    w->num_entries++;
+    return 0;
+}
+
+int hodu_cpu_weights_add_matmul_rhs_f32(hodu_cpu_weights_writer_t *writer, const char *name,
+                                        const void *rhs, const size_t *metadata) {
+    const uint64_t dims[4] = {metadata[0], metadata[1], 0, 0};
+    return weights_add(writer, name, HODU_CPU_WEIGHTS_MATMUL_RHS_F32, dims, rhs, metadata,
+                       hodu_cpu_matmul_pack_rhs_f32);
+}
+
+int hodu_cpu_weights_add_matmul_rhs_f64(hodu_cpu_weights_writer_t *writer, const char *name,
+                                        const void *rhs, const size_t *metadata) {
+    const uint64_t dims[4] = {metadata[0], metadata[1], 0, 0};
+    return weights_add(writer, name, HODU_CPU_WEIGHTS_MATMUL_RHS_F64, dims, rhs, metadata,
+                       hodu_cpu_matmul_pack_rhs_f64);
+}
+
+int hodu_cpu_weights_add_conv2d_f32(hodu_cpu_weights_writer_t *writer, const char *name,
+                                    const void *weight, const size_t *metadata) {
+    const uint64_t dims[4] = {metadata[3], metadata[2], metadata[6], metadata[7]};
+    return weights_add(writer, name, HODU_CPU_WEIGHTS_CONV2D_F32, dims, weight, metadata,
+                       hodu_cpu_conv2d_pack_weight_f32);
+}
+
+int hodu_cpu_weights_add_conv2d_f64(hodu_cpu_weights_writer_t *writer, const char *name,
+                                    const void *weight, const size_t *metadata) {
+    const uint64_t dims[4] = {metadata[3], metadata[2], metadata[6], metadata[7]};
+    return weights_add(writer, name, HODU_CPU_WEIGHTS_CONV2D_F64, dims, weight, metadata,
+                       hodu_cpu_conv2d_pack_weight_f64);
+}
+
+int hodu_cpu_weights_finish(hodu_cpu_weights_writer_t *writer) {
+    hodu_cpu_weights_writer_t *w = writer;
+    bool ok = !w->failed && weights_pad(w, sizeof(uint64_t));
+
+    weights_header_t header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, WEIGHTS_MAGIC, sizeof(WEIGHTS_MAGIC));
+    header.version = WEIGHTS_VERSION;
+    header.byte_order = WEIGHTS_BYTE_ORDER;
+    header.layout[0] = hodu_cpu_gemm_packed_layout_f32();
+    header.layout[1] = hodu_cpu_gemm_packed_layout_f64();
+    header.num_entries = w->num_entries;
+    header.table_offset = w->pos;
+
+    ok = ok && weights_write(w, w->entries, w->num_entries * sizeof(hodu_cpu_weights_entry_t));
+    ok = ok && fseek(w->file, 0, SEEK_SET) == 0 && fwrite(&header, sizeof(header), 1, w->file) == 1;
+    ok = (fclose(w->file) == 0) && ok;
+
+    free(w->entries);
+    free(w);
+    return ok ? 0 : -1;
+}
+
+// ============================================================================
+// READER
+// ============================================================================
+
+struct hodu_cpu_weights {
+    const uint8_t *base;
+    size_t size;
+    const hodu_cpu_weights_entry_t *entries;
+    size_t count;
+#if defined(_WIN32)
+    HANDLE file;
+    HANDLE mapping;
+#endif
+};
+
+// Map (or read) the whole file; false if it cannot be read
+static bool weights_map(hodu_cpu_weights_t *weights, const char *path) {
+#if defined(__unix__) || defined(__APPLE__)
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size < (off_t)sizeof(weights_header_t)) {
+        close(fd);
+        return false;
+    }
+    void *base = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (base == MAP_FAILED) {
+        return false;
+    }
+    weights->base = (const uint8_t *)base;
+    weights->size = (size_t)st.st_size;
+    return true;
+#elif defined(_WIN32)
+    HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING,
+                              FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size) || size.QuadPart < (LONGLONG)sizeof(weights_header_t)) {
+        CloseHandle(file);
+        return false;
+    }
+    HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+    void *base = mapping ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : NULL;
+    if (!base) {
+        if (mapping) {
+            CloseHandle(mapping);
+        }
+        CloseHandle(file);
+        return false;
+    }
+    weights->file = file;
+    weights->mapping = mapping;
+    weights->base = (const uint8_t *)base;
+    weights->size = (size_t)size.QuadPart;
+    return true;
+#else
+    FILE *f = fopen(path, "rb");
+    if (!f) {
+        return false;
+    }
+    bool ok = fseek(f, 0, SEEK_END) == 0;
+    long size = ok ? ftell(f) : -1;
+    ok = ok && size >= (long)sizeof(weights_header_t) && fseek(f, 0, SEEK_SET) == 0;
+    size_t rounded = ok ? ((size_t)size + HODU_CPU_WEIGHTS_ALIGN - 1) / HODU_CPU_WEIGHTS_ALIGN *
+                              HODU_CPU_WEIGHTS_ALIGN
+                        : 0;
+    uint8_t *base = ok ? (uint8_t *)aligned_alloc(HODU_CPU_WEIGHTS_ALIGN, rounded) : NULL;
+    ok = base && fread(base, 1, (size_t)size, f) == (size_t)size;
+    fclose(f);
+    if (!ok) {
+        free(base);
+        return false;
+    }
+    weights->base = base;
+    weights->size = (size_t)size;
+    return true;
+#endif
+}
+
+static void weights_unmap(hodu_cpu_weights_t *weights) {
+#if defined(__unix__) || defined(__APPLE__)
+    munmap((void *)weights->base, weights->size);
+#elif defined(_WIN32)
+    UnmapViewOfFile(weights->base);
+    CloseHandle(weights->mapping);
+    CloseHandle(weights->file);
+#else
+    free((void *)weights->base);
+#endif
+}
+
+// Header and every entry agree with this build and lie inside the file
+static bool weights_validate(const hodu_cpu_weights_t *weights) {
+    weights_header_t header;
+    memcpy(&header, weights->base, sizeof(header));
+    if (memcmp(header.magic, WEIGHTS_MAGIC, sizeof(WEIGHTS_MAGIC)) != 0 ||
+        header.version != WEIGHTS_VERSION || header.byte_order != WEIGHTS_BYTE_ORDER ||
+        header.layout[0] != hodu_cpu_gemm_packed_layout_f32() ||
+        header.layout[1] != hodu_cpu_gemm_packed_layout_f64()) {
+        return false;
+    }
+
+    const uint64_t size = weights->size;
+    const uint64_t entry_size = sizeof(hodu_cpu_weights_entry_t);
+    if (header.table_offset % sizeof(uint64_t) != 0 || header.table_offset > size ||
+        header.num_entries > (size - header.table_offset) / entry_size) {
+        return false;
+    }
+
+    const hodu_cpu_weights_entry_t *entries =
+        (const hodu_cpu_weights_entry_t *)(weights->base + header.table_offset);
+    for (uint64_t i = 0; i < header.num_entries; i++) {
+        const hodu_cpu_weights_entry_t *e = &entries[i];
+        if (memchr(e->name, '\0', HODU_CPU_WEIGHTS_NAME_MAX) == NULL ||
+            e->kind >= HODU_CPU_WEIGHTS_NUM_KINDS || e->offset % HODU_CPU_WEIGHTS_ALIGN != 0 ||
+            e->offset > size || e->bytes > size - e->offset ||
+            e->bytes != weights_packed_bytes(e->kind, e->dims)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+hodu_cpu_weights_t *hodu_cpu_weights_open(const char *path) {
+    hodu_cpu_weights_t *weights = (hodu_cpu_weights_t *)calloc(1, sizeof(hodu_cpu_weights_t));
+    if (!weights) {
+        return NULL;
+    }
+    if (!weights_map(weights, path)) {
+        free(weights);
+        return NULL;
+    }
+    if (!weights_validate(weights)) {
+        weights_unmap(weights);
+        free(weights);
+        return NULL;
+    }
+
+    weights_header_t header;
+    memcpy(&header, weights->base, sizeof(header));
+    weights->entries = (const hodu_cpu_weights_entry_t *)(weights->base + header.table_offset);
+    weights->count = (size_t)header.num_entries;
+    return weights;
+}
+
+size_t hodu_cpu_weights_count(const hodu_cpu_weights_t *weights) { return weights->count; }
+
+const hodu_cpu_weights_entry_t *hodu_cpu_weights_entry(const hodu_cpu_weights_t *weights,
+                                                       size_t index) {
+    return index < weights->count ? &weights->entries[index] : NULL;
+}
+
+const hodu_cpu_weights_entry_t *hodu_cpu_weights_find(const hodu_cpu_weights_t *weights,
+                                                      const char *name) {
+    for (size_t i = 0; i < weights->count; i++) {
+        if (strcmp(weights->entries[i].name, name) == 0) {
+            return &weights->entries[i];
+        }
+    }
+    return NULL;
+}
+
+const void *hodu_cpu_weights_data(const hodu_cpu_weights_t *weights,
+                                  const hodu_cpu_weights_entry_t *entry) {
+    return weights->base + entry->offset;
+}
+
+void hodu_cpu_weights_close(hodu_cpu_weights_t *weights) {
+    if (weights) {
+        weights_unmap(weights);
+        free(weights);
+    }
+}
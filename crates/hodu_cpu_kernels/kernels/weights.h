@@ -0,0 +1,131 @@
+/**
+ * @file weights.h
+ * @brief Pre-packed weight files header
+ *
+ * Stores constant matmul/conv2d weights already packed into the blocked GEMM
+ * layout, so a model loader can map the file read-only and pass the packed
+ * data straight to hodu_cpu_matmul_packed_* / hodu_cpu_conv2d_packed_*:
+ * - No parsing, copying or packing at load time (pages are read on first use)
+ * - Processes mapping the same file share its page cache instead of each
+ *   holding a private heap copy of every weight
+ *
+ * File layout (native byte order, checked on open):
+ * - Header: magic, version, byte-order mark, packed layout ids, entry table
+ * - Packed weights, each at a HODU_CPU_WEIGHTS_ALIGN-aligned file offset
+ * - Entry table (one hodu_cpu_weights_entry_t per weight)
+ *
+ * The packed layout depends on the GEMM blocking of the running ISA variant
+ * (hodu_cpu_gemm_packed_layout_*). Files written by a build with a different
+ * layout are rejected on open and must be regenerated.
+ */
+
+#ifndef HODU_CPU_KERNELS_WEIGHTS_H
+#define HODU_CPU_KERNELS_WEIGHTS_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// Longest weight name, including the terminating NUL
+#define HODU_CPU_WEIGHTS_NAME_MAX 64
+
+/// File offset alignment of every packed weight
+#define HODU_CPU_WEIGHTS_ALIGN 4096
+
+/// What a packed weight is and which kernel consumes it
+typedef enum {
+    HODU_CPU_WEIGHTS_MATMUL_RHS_F32 = 0, // hodu_cpu_matmul_packed_f32
+    HODU_CPU_WEIGHTS_MATMUL_RHS_F64 = 1, // hodu_cpu_matmul_packed_f64
+    HODU_CPU_WEIGHTS_CONV2D_F32 = 2,     // hodu_cpu_conv2d_packed_f32
+    HODU_CPU_WEIGHTS_CONV2D_F64 = 3,     // hodu_cpu_conv2d_packed_f64
+    HODU_CPU_WEIGHTS_NUM_KINDS,
+} hodu_cpu_weights_kind_t;
+
+/// Entry table record, as stored in the file
+typedef struct {
+    char name[HODU_CPU_WEIGHTS_NAME_MAX]; // NUL-terminated
+    uint32_t kind;                        // hodu_cpu_weights_kind_t
+    uint32_t reserved;                    // 0
+    uint64_t dims[4]; // matmul rhs: K, N, 0, 0; conv2d: out_channels, in_channels, kernel_h/w
+    uint64_t offset;  // file offset of the packed data
+    uint64_t bytes;   // packed size
+} hodu_cpu_weights_entry_t;
+
+// ============================================================================
+// WRITING
+// ============================================================================
+//
+//   hodu_cpu_weights_writer_t *w = hodu_cpu_weights_create("model.hpw");
+//   hodu_cpu_weights_add_matmul_rhs_f32(w, "fc1", rhs, pack_metadata);
+//   hodu_cpu_weights_add_conv2d_f32(w, "conv1", weight, conv2d_metadata);
+//   hodu_cpu_weights_finish(w);
+//
+// add_matmul_rhs_* takes the pack metadata of hodu_cpu_matmul_pack_rhs_*, and
+// add_conv2d_* the conv2d metadata of hodu_cpu_conv2d_pack_weight_*. Names
+// must be unique and shorter than HODU_CPU_WEIGHTS_NAME_MAX.
+//
+// The add functions return 0 on success and -1 on a duplicate or too long
+// name, an allocation failure or a write error. A writer that failed keeps
+// failing; finish then returns -1 too and the file should be discarded.
+
+typedef struct hodu_cpu_weights_writer hodu_cpu_weights_writer_t;
+
+/// Start writing a weight file (truncating it); NULL if it cannot be created
+hodu_cpu_weights_writer_t *hodu_cpu_weights_create(const char *path);
+
+int hodu_cpu_weights_add_matmul_rhs_f32(hodu_cpu_weights_writer_t *writer, const char *name,
+                                        const void *rhs, const size_t *metadata);
+int hodu_cpu_weights_add_matmul_rhs_f64(hodu_cpu_weights_writer_t *writer, const char *name,
+                                        const void *rhs, const size_t *metadata);
+int hodu_cpu_weights_add_conv2d_f32(hodu_cpu_weights_writer_t *writer, const char *name,
+                                    const void *weight, const size_t *metadata);
+int hodu_cpu_weights_add_conv2d_f64(hodu_cpu_weights_writer_t *writer, const char *name,
+                                    const void *weight, const size_t *metadata);
+
+/// Write the entry table and close the file, freeing the writer
+///
+/// Returns 0 on success, -1 if any step of the writer failed.
+int hodu_cpu_weights_finish(hodu_cpu_weights_writer_t *writer);
+
+// ============================================================================
+// READING
+// ============================================================================
+//
+// The file is mapped read-only (mmap / MapViewOfFile; read into memory where
+// neither exists) and stays mapped until hodu_cpu_weights_close. Pointers
+// returned by hodu_cpu_weights_data are valid until then.
+
+typedef struct hodu_cpu_weights hodu_cpu_weights_t;
+
+/// Map a weight file
+///
+/// Returns NULL if the file cannot be read, is malformed or truncated, or was
+/// packed with a different layout than this build uses.
+hodu_cpu_weights_t *hodu_cpu_weights_open(const char *path);
+
+/// Number of weights in the file
+size_t hodu_cpu_weights_count(const hodu_cpu_weights_t *weights);
+
+/// Entry `index` (0..count-1), NULL if out of range
+const hodu_cpu_weights_entry_t *hodu_cpu_weights_entry(const hodu_cpu_weights_t *weights,
+                                                       size_t index);
+
+/// Entry named `name`, NULL if there is none
+const hodu_cpu_weights_entry_t *hodu_cpu_weights_find(const hodu_cpu_weights_t *weights,
+                                                      const char *name);
+
+/// Packed data of an entry of this file, ready for the packed kernels
+const void *hodu_cpu_weights_data(const hodu_cpu_weights_t *weights,
+                                  const hodu_cpu_weights_entry_t *entry);
+
+/// Unmap the file
+void hodu_cpu_weights_close(hodu_cpu_weights_t *weights);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // HODU_CPU_KERNELS_WEIGHTS_H
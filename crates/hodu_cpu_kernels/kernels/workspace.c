@@ -0,0 +1,103 @@
+#include "workspace.h"
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+// ============================================================================
+// SCRATCH ARENA IMPLEMENTATION
+// ============================================================================
+//
+// Every thread has a default arena (grow-only, owned) and a binding that points
+// at it or at a caller workspace. Acquire bumps the top of the bound arena:
+// - Fits: return data + used
+// - Does not fit while the owned arena is empty: reallocate it to the peak
+//   request seen so far, so a kernel sequence that once overflowed fits next time
+// - Otherwise: plain malloc for this block; release frees it again
+// Release of an arena block resets the top to that block.
+
+static _Thread_local hodu_cpu_workspace_t workspace_default;
+static _Thread_local hodu_cpu_workspace_t *workspace_bound;
+
+static inline hodu_cpu_workspace_t *workspace_current(void) {
+    return workspace_bound ? workspace_bound : &workspace_default;
+}
+
+static inline uintptr_t workspace_align_up(uintptr_t v) {
+    return (v + HODU_CPU_WORKSPACE_ALIGN - 1) & ~(uintptr_t)(HODU_CPU_WORKSPACE_ALIGN - 1);
+}
+
+void hodu_cpu_workspace_init(hodu_cpu_workspace_t *ws, void *buffer, size_t bytes) {
+    ws->data = NULL;
+    ws->capacity = 0;
+    ws->used = 0;
+    ws->peak = 0;
+    ws->allocation = NULL;
+    if (buffer && bytes > 0) {
+        const uintptr_t start = workspace_align_up((uintptr_t)buffer);
+        const size_t skip = (size_t)(start - (uintptr_t)buffer);
+        if (skip < bytes) {
+            ws->data = (void *)start;
+            ws->capacity = bytes - skip;
+        }
+    }
+}
+
+hodu_cpu_workspace_t *hodu_cpu_workspace_bind(hodu_cpu_workspace_t *ws) {
+    hodu_cpu_workspace_t *prev = workspace_bound;
+    workspace_bound = ws;
+    return prev;
+}
+
+void hodu_cpu_workspace_trim(void) {
+    hodu_cpu_workspace_t *ws = &workspace_default;
+    if (ws->used == 0) {
+        free(ws->allocation);
+        hodu_cpu_workspace_init(ws, NULL, 0);
+    }
+}
+
+/// Replace the (empty) default arena's storage with at least `bytes` usable bytes
+static bool workspace_grow(hodu_cpu_workspace_t *ws, size_t bytes) {
+    void *allocation = malloc(bytes + HODU_CPU_WORKSPACE_ALIGN);
+    if (!allocation) {
+        return false;
+    }
+    free(ws->allocation);
+    const size_t peak = ws->peak;
+    hodu_cpu_workspace_init(ws, allocation, bytes + HODU_CPU_WORKSPACE_ALIGN);
+    ws->allocation = allocation;
+    ws->peak = peak;
+    return true;
+}
+
+void *hodu_cpu_workspace_acquire(size_t bytes) {
+    hodu_cpu_workspace_t *ws = workspace_current();
+    const size_t size = hodu_cpu_workspace_block_size(bytes ? bytes : 1);
+    if (ws->used + size > ws->peak) {
+        ws->peak = ws->used + size;
+    }
+
+    if (ws->used + size > ws->capacity && ws == &workspace_default && ws->used == 0) {
+        workspace_grow(ws, ws->peak);
+    }
+    if (ws->used + size <= ws->capacity) {
+        void *ptr = (char *)ws->data + ws->used;
+        ws->used += size;
+        return ptr;
+    }
+    return malloc(size);
+}
+
+void hodu_cpu_workspace_release(void *ptr) {
+    if (!ptr) {
+        return;
+    }
+    hodu_cpu_workspace_t *ws = workspace_current();
+    const char *p = (const char *)ptr;
+    const char *data = (const char *)ws->data;
+    if (data && p >= data && p < data + ws->capacity) {
+        ws->used = (size_t)(p - data);
+    } else {
+        free(ptr);
+    }
+}
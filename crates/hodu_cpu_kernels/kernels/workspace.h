@@ -0,0 +1,90 @@
+/**
+ * @file workspace.h
+ * @brief Scratch memory arena for kernel temporaries
+ *
+ * Kernels that need temporary buffers (im2col columns, packed weights,
+ * Winograd transforms, sort buffers, LU factors, ...) take them from a
+ * per-thread scratch arena instead of calling malloc/free on every call:
+ * - By default each thread owns an arena that grows to the largest request
+ *   it has seen and is then reused, so steady-state calls do not touch the
+ *   allocator or fault in fresh pages
+ * - A caller can bind its own buffer to the calling thread to cap and
+ *   pre-fault scratch memory; the per-op *_workspace_size queries return
+ *   the bytes a call needs
+ */
+
+#ifndef HODU_CPU_KERNELS_WORKSPACE_H
+#define HODU_CPU_KERNELS_WORKSPACE_H
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Alignment of every scratch block (one cache line, a full AVX-512 vector)
+#define HODU_CPU_WORKSPACE_ALIGN 64
+
+/// Scratch arena: a bump allocator released in LIFO order
+typedef struct {
+    void *data;       // first aligned byte
+    size_t capacity;  // usable bytes from data
+    size_t used;      // bytes in use (top of the stack)
+    size_t peak;      // largest used + request seen, including overflowed requests
+    void *allocation; // owned allocation backing data, NULL for caller buffers
+} hodu_cpu_workspace_t;
+
+// ============================================================================
+// CALLER-SUPPLIED WORKSPACES
+// ============================================================================
+//
+//   size_t bytes = hodu_cpu_conv2d_workspace_size_f32(metadata);
+//   hodu_cpu_workspace_t ws;
+//   hodu_cpu_workspace_init(&ws, buffer, bytes);
+//   hodu_cpu_workspace_t *prev = hodu_cpu_workspace_bind(&ws);
+//   hodu_cpu_conv2d_f32(input, weight, output, metadata); // no malloc
+//   hodu_cpu_workspace_bind(prev);
+//
+// A bound workspace serves the kernels called on that thread. It never grows:
+// requests that do not fit fall back to malloc for that call only, and
+// ws.peak reports the size that would have fit. Kernels running on pool
+// workers draw from the workers' own default arenas.
+
+/// Wrap a caller buffer of `bytes` bytes (any alignment) as a workspace
+void hodu_cpu_workspace_init(hodu_cpu_workspace_t *ws, void *buffer, size_t bytes);
+
+/// Bind ws to the calling thread (NULL restores the default arena); returns the previous binding
+hodu_cpu_workspace_t *hodu_cpu_workspace_bind(hodu_cpu_workspace_t *ws);
+
+/// Free the calling thread's default arena (it regrows on the next request)
+void hodu_cpu_workspace_trim(void);
+
+/// Arena bytes taken by one acquired block (size queries sum these, plus one
+/// HODU_CPU_WORKSPACE_ALIGN of slack for aligning a caller buffer)
+static inline size_t hodu_cpu_workspace_block_size(size_t bytes) {
+    return (bytes + HODU_CPU_WORKSPACE_ALIGN - 1) / HODU_CPU_WORKSPACE_ALIGN *
+           HODU_CPU_WORKSPACE_ALIGN;
+}
+
+// ============================================================================
+// KERNEL-SIDE ALLOCATION
+// ============================================================================
+//
+// Kernels take scratch memory with workspace_acquire() and return it with
+// workspace_release() in reverse order; one acquire per kernel call (carved
+// into sub-buffers) keeps the default arena to a single allocation.
+
+/// Take `bytes` of aligned scratch memory from the calling thread's workspace (NULL on OOM)
+void *hodu_cpu_workspace_acquire(size_t bytes);
+
+/// Return a block from hodu_cpu_workspace_acquire (and every block acquired after it)
+void hodu_cpu_workspace_release(void *ptr);
+
+static inline void *workspace_acquire(size_t bytes) { return hodu_cpu_workspace_acquire(bytes); }
+static inline void workspace_release(void *ptr) { hodu_cpu_workspace_release(ptr); }
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // HODU_CPU_KERNELS_WORKSPACE_H
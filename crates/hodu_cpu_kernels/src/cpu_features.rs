@@ -0,0 +1,23 @@
+//! Runtime CPU feature dispatch
+//!
+//! Portable builds (`HODU_DISABLE_NATIVE`) compile the GEMM engine once per
+//! instruction set and select a variant on first use from cpuid:
+//! - cpu_isa: Level the dispatched kernels run on ("baseline", "avx2" or "avx512")
+//!
+//! The `HODU_CPU_ISA` environment variable caps the level (read once). Native
+//! builds report the level they were compiled for.
+
+use core::ffi::{c_char, CStr};
+
+extern "C" {
+    fn hodu_cpu_isa() -> i32;
+    fn hodu_cpu_isa_name(isa: i32) -> *const c_char;
+}
+
+/// Instruction set level the dispatched kernels run on
+pub fn cpu_isa() -> &'static str {
+    unsafe {
+        let name = CStr::from_ptr(hodu_cpu_isa_name(hodu_cpu_isa()));
+        name.to_str().unwrap_or("baseline")
+    }
+}
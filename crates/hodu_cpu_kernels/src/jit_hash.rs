@@ -0,0 +1,22 @@
+// Kernel name hash for the JIT symbol table
+//
+// Included (include!) by build_jit_symbols.rs, which builds the perfect hash,
+// and by jit_symbols.rs, which looks names up with it, so both sides always
+// agree. FNV-1a over the name with the seed folded into the offset basis,
+// then a 64-bit finalizer so every bit of the result depends on every byte.
+
+#[allow(dead_code)]
+const fn jit_hash(name: &[u8], seed: u64) -> u64 {
+    let mut h = 0xcbf2_9ce4_8422_2325 ^ seed.wrapping_mul(0x9e37_79b9_7f4a_7c15);
+    let mut i = 0;
+    while i < name.len() {
+        h ^= name[i] as u64;
+        h = h.wrapping_mul(0x0100_0000_01b3);
+        i += 1;
+    }
+    h ^= h >> 33;
+    h = h.wrapping_mul(0xff51_afd7_ed55_8ccd);
+    h ^= h >> 33;
+    h = h.wrapping_mul(0xc4ce_b9fe_1a85_ec53);
+    h ^ (h >> 33)
+}
@@ -2,6 +2,56 @@
 //!
 //! This module provides function pointers to C kernel functions
 //! for JIT execution engines
+//!
+//! The table is generated at build time (build_jit_symbols.rs) from every
+//! `hodu_cpu_*` function declared in kernels/*.h, so it always matches the
+//! compiled library. Names are looked up through a minimal perfect hash: one
+//! seeded hash of the name picks a bucket, a second one the slot, and a
+//! single string compare confirms it. Compiled models can bind all their
+//! kernels once at load time by walking `kernels()` or calling
+//! `kernel_info()` per name.
+
+include!("jit_hash.rs");
+
+/// A C entry point exported by the kernel library
+#[derive(Debug, Clone, Copy)]
+pub struct KernelInfo {
+    /// Symbol name (e.g. "hodu_cpu_add_f32")
+    pub name: &'static str,
+    /// Declaring header without the `ops_` prefix (e.g. "binary", "unary", "cast", "gemm",
+    /// "workspace")
+    pub category: &'static str,
+    /// Dtype suffixes of the name in order: `["f32"]` for add_f32, `["f32", "i32"]` for
+    /// cast_f32_to_i32, empty for untyped entry points such as workspace queries
+    pub dtypes: &'static [&'static str],
+    /// The output may be the input buffer itself: unary and binary kernels whose output has
+    /// the input's element size, same-size casts, scatter* and index_put
+    pub in_place: bool,
+    ptr: unsafe extern "C" fn(),
+}
+
+impl KernelInfo {
+    /// Address of the C function; cast it to the signature declared in its header
+    pub fn ptr(&self) -> *const () {
+        self.ptr as *const ()
+    }
+}
+
+// Extern declarations, HASH_SEEDS and KERNELS (in slot order)
+include!(concat!(env!("OUT_DIR"), "/jit_symbols_table.rs"));
+
+/// Every exported kernel symbol, in table order
+pub fn kernels() -> &'static [KernelInfo] {
+    &KERNELS
+}
+
+/// Metadata and address of a kernel symbol by name, in O(1)
+pub fn kernel_info(name: &str) -> Option<&'static KernelInfo> {
+    let bucket = jit_hash(name.as_bytes(), 0) % HASH_SEEDS.len() as u64;
+    let seed = HASH_SEEDS[bucket as usize] as u64;
+    let info = &KERNELS[(jit_hash(name.as_bytes(), seed) % KERNELS.len() as u64) as usize];
+    (info.name == name).then_some(info)
+}
 
 /// Get function pointer for any kernel by name
 /// Returns None if kernel name is not recognized
@@ -13,17 +63,7 @@
 /// - "hodu_cpu_add_f32"
 /// - "hodu_cpu_mul_i32"
 /// - "hodu_cpu_matmul_f64"
+/// - "hodu_cpu_cast_f32_to_bf16"
 pub fn get_kernel_ptr(name: &str) -> Option<*const ()> {
-    // Try each operation category
-    if let Some(ptr) = crate::kernels::ops_binary::get_binary_kernel_ptr(name) {
-        return Some(ptr);
-    }
-
-    // TODO: Add other operation categories as we implement them:
-    // - ops_unary::get_unary_kernel_ptr(name)
-    // - ops_matrix::get_matrix_kernel_ptr(name)
-    // - ops_reduce::get_reduce_kernel_ptr(name)
-    // - etc.
-
-    None
+    kernel_info(name).map(KernelInfo::ptr)
 }
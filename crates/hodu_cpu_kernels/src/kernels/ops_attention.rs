@@ -0,0 +1,187 @@
+//! Fused attention operations
+//!
+//! This module provides scaled dot-product attention as a single kernel:
+//! - Prefill attention (`attention`): tiled over queries with K/V streamed in blocks and an
+//!   online softmax, so the `[q_len, kv_len]` score matrix is never materialized
+//! - Decode attention (`attention_decode`): one query token per sequence against a KV cache,
+//!   split across the cache length when there are fewer (batch, kv head) pairs than threads
+//!
+//! Both support grouped-query attention, causal and padding masks, and accumulate in f32
+//! (bf16, f16, f32).
+
+use crate::{error::Result, kernels::macros::Kernel};
+use core::ffi::c_void;
+
+/// Prefill attention kernels (bf16/f16/f32)
+pub mod attention {
+    use crate::kernels::macros::Kernel;
+    pub const BF16: Kernel = Kernel("hodu_cpu_attention_bf16");
+    pub const F16: Kernel = Kernel("hodu_cpu_attention_f16");
+    pub const F32: Kernel = Kernel("hodu_cpu_attention_f32");
+}
+
+/// KV-cache decode attention kernels (bf16/f16/f32)
+pub mod attention_decode {
+    use crate::kernels::macros::Kernel;
+    pub const BF16: Kernel = Kernel("hodu_cpu_attention_decode_bf16");
+    pub const F16: Kernel = Kernel("hodu_cpu_attention_decode_f16");
+    pub const F32: Kernel = Kernel("hodu_cpu_attention_decode_f32");
+}
+
+extern "C" {
+    fn hodu_cpu_attention_bf16(
+        q: *const c_void,
+        k: *const c_void,
+        v: *const c_void,
+        output: *mut c_void,
+        metadata: *const usize,
+        scale: f32,
+    );
+    fn hodu_cpu_attention_f16(
+        q: *const c_void,
+        k: *const c_void,
+        v: *const c_void,
+        output: *mut c_void,
+        metadata: *const usize,
+        scale: f32,
+    );
+    fn hodu_cpu_attention_f32(
+        q: *const c_void,
+        k: *const c_void,
+        v: *const c_void,
+        output: *mut c_void,
+        metadata: *const usize,
+        scale: f32,
+    );
+    fn hodu_cpu_attention_decode_bf16(
+        q: *const c_void,
+        k_cache: *const c_void,
+        v_cache: *const c_void,
+        output: *mut c_void,
+        metadata: *const usize,
+        scale: f32,
+    );
+    fn hodu_cpu_attention_decode_f16(
+        q: *const c_void,
+        k_cache: *const c_void,
+        v_cache: *const c_void,
+        output: *mut c_void,
+        metadata: *const usize,
+        scale: f32,
+    );
+    fn hodu_cpu_attention_decode_f32(
+        q: *const c_void,
+        k_cache: *const c_void,
+        v_cache: *const c_void,
+        output: *mut c_void,
+        metadata: *const usize,
+        scale: f32,
+    );
+}
+
+/// Execute fused prefill attention
+///
+/// Computes `softmax(scale * Q K^T + mask) V` for every (batch, head) pair. With grouped-query
+/// attention, query head `h` reads key/value head `h / (num_heads / num_kv_heads)`.
+///
+/// # Arguments
+/// * `kernel` - The attention kernel (e.g., attention::F32)
+/// * `q` - Pointer to the `[batch, num_heads, q_len, head_dim]` query view
+/// * `k` - Pointer to the `[batch, num_kv_heads, kv_len, head_dim]` key view
+/// * `v` - Pointer to the `[batch, num_kv_heads, kv_len, head_dim]` value view
+/// * `output` - Pointer to the contiguous `[batch, num_heads, q_len, head_dim]` output
+/// * `metadata` - Shapes, strides, offsets and masks (see below)
+/// * `scale` - Score scale, usually `1 / sqrt(head_dim)`
+///
+/// # Metadata layout
+/// - metadata[0]: batch
+/// - metadata[1]: num_heads
+/// - metadata[2]: num_kv_heads
+/// - metadata[3]: q_len
+/// - metadata[4]: kv_len
+/// - metadata[5]: head_dim
+/// - metadata[6..10]: q strides (batch, head, seq, dim)
+/// - metadata[10..14]: k strides (batch, head, seq, dim)
+/// - metadata[14..18]: v strides (batch, head, seq, dim)
+/// - metadata[18]: q offset
+/// - metadata[19]: k offset
+/// - metadata[20]: v offset
+/// - metadata[21]: causal (query `i` sees keys up to position `kv_len - q_len + i`)
+/// - metadata[22]: has_kv_lens
+/// - metadata[23..23+batch]: kv_lens (valid keys per batch, if has_kv_lens)
+///
+/// Rows that see no key produce zeros.
+///
+/// # Returns
+/// Returns `Ok(())` on success.
+pub fn call_ops_attention(
+    kernel: Kernel,
+    q: *const c_void,
+    k: *const c_void,
+    v: *const c_void,
+    output: *mut c_void,
+    metadata: &[usize],
+    scale: f32,
+) -> Result<()> {
+    unsafe {
+        match kernel {
+            attention::BF16 => hodu_cpu_attention_bf16(q, k, v, output, metadata.as_ptr(), scale),
+            attention::F16 => hodu_cpu_attention_f16(q, k, v, output, metadata.as_ptr(), scale),
+            attention::F32 => hodu_cpu_attention_f32(q, k, v, output, metadata.as_ptr(), scale),
+            _ => panic!("Unsupported attention kernel: {:?}", kernel),
+        }
+    }
+
+    Ok(())
+}
+
+/// Execute single-token attention against a KV cache
+///
+/// The query of sequence `b` attends to cache positions `[0, cache_lens[b])`, which must
+/// already include the token's own key and value.
+///
+/// # Arguments
+/// * `kernel` - The decode kernel (e.g., attention_decode::F32)
+/// * `q` - Pointer to the contiguous `[batch, num_heads, head_dim]` query
+/// * `k_cache` - Pointer to the contiguous `[batch, num_kv_heads, capacity, head_dim]` key cache
+/// * `v_cache` - Pointer to the contiguous `[batch, num_kv_heads, capacity, head_dim]` value cache
+/// * `output` - Pointer to the contiguous `[batch, num_heads, head_dim]` output
+/// * `metadata` - Shapes and cache lengths (see below)
+/// * `scale` - Score scale, usually `1 / sqrt(head_dim)`
+///
+/// # Metadata layout
+/// - metadata[0]: batch
+/// - metadata[1]: num_heads
+/// - metadata[2]: num_kv_heads
+/// - metadata[3]: head_dim
+/// - metadata[4]: capacity (allocated positions per cache head)
+/// - metadata[5..5+batch]: cache_lens (filled positions per batch)
+///
+/// # Returns
+/// Returns `Ok(())` on success.
+pub fn call_ops_attention_decode(
+    kernel: Kernel,
+    q: *const c_void,
+    k_cache: *const c_void,
+    v_cache: *const c_void,
+    output: *mut c_void,
+    metadata: &[usize],
+    scale: f32,
+) -> Result<()> {
+    unsafe {
+        match kernel {
+            attention_decode::BF16 => {
+                hodu_cpu_attention_decode_bf16(q, k_cache, v_cache, output, metadata.as_ptr(), scale)
+            },
+            attention_decode::F16 => {
+                hodu_cpu_attention_decode_f16(q, k_cache, v_cache, output, metadata.as_ptr(), scale)
+            },
+            attention_decode::F32 => {
+                hodu_cpu_attention_decode_f32(q, k_cache, v_cache, output, metadata.as_ptr(), scale)
+            },
+            _ => panic!("Unsupported attention decode kernel: {:?}", kernel),
+        }
+    }
+
+    Ok(())
+}
@@ -59,6 +59,7 @@ ops!(
 /// - Pointers are valid and properly aligned
 /// - Metadata accurately describes tensor layout
 /// - Output buffer has sufficient capacity
+/// - `output` may be `lhs` or `rhs` itself (in place, e.g. `a += b`)
 ///
 /// # Returns
 /// Returns `Ok(())` on success. Currently does not propagate C kernel errors.
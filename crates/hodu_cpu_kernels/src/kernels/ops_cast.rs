@@ -63,6 +63,7 @@ pub mod cast {
 /// - `input` must point to valid tensor data of the source type
 /// - `output` must point to a valid output buffer with sufficient capacity for the destination type
 /// - Metadata must accurately describe the tensor layout
+/// - `output` may be `input` itself for casts between types of the same size (in place)
 pub fn call_ops_cast(
     kernel_name: CastKernel,
     input: *const c_void,
@@ -4,18 +4,26 @@
 //! - Standard convolutions (conv1d, conv2d, conv3d)
 //! - Transposed convolutions (conv_transpose1d, conv_transpose2d, conv_transpose3d)
 //! - Gradient weight computations for backpropagation
+//! - Pre-packed weight conv2d (`conv2d_packed`) for constant inference weights
+//! - Fused-epilogue conv2d (`conv2d_fused`): bias, residual and activation in one pass
+//! - Channels-last conv2d (`conv2d_nhwc`): NHWC input/output with an OHWI weight
+//! - Grouped and depthwise conv2d (`conv2d_grouped`)
 //!
 //! All operations support padding, stride, and dilation parameters.
 
 use crate::{
-    error::Result,
-    kernels::macros::{ops, Kernel},
+    error::{CpuKernelError, Result},
+    kernels::{
+        macros::{ops, Kernel},
+        ops_matrix::Epilogue,
+    },
 };
 use core::ffi::c_void;
 
 ops!(
     conv1d,
     conv2d,
+    conv2d_nhwc,
     conv3d,
     conv_transpose1d,
     conv_transpose2d,
@@ -28,6 +36,76 @@ ops!(
     conv_transpose3d_grad_weight
 );
 
+/// Pre-packed weight conv2d kernels (f32/f64)
+pub mod conv2d_packed {
+    use crate::kernels::macros::Kernel;
+    pub const F32: Kernel = Kernel("hodu_cpu_conv2d_packed_f32");
+    pub const F64: Kernel = Kernel("hodu_cpu_conv2d_packed_f64");
+}
+
+/// Fused-epilogue conv2d kernels (f32/f64)
+pub mod conv2d_fused {
+    use crate::kernels::macros::Kernel;
+    pub const F32: Kernel = Kernel("hodu_cpu_conv2d_fused_f32");
+    pub const F64: Kernel = Kernel("hodu_cpu_conv2d_fused_f64");
+}
+
+/// Grouped / depthwise conv2d kernels (f32/f64)
+pub mod conv2d_grouped {
+    use crate::kernels::macros::Kernel;
+    pub const F32: Kernel = Kernel("hodu_cpu_conv2d_grouped_f32");
+    pub const F64: Kernel = Kernel("hodu_cpu_conv2d_grouped_f64");
+}
+
+extern "C" {
+    fn hodu_cpu_conv2d_grouped_f32(
+        input: *const c_void,
+        weight: *const c_void,
+        output: *mut c_void,
+        metadata: *const usize,
+    );
+    fn hodu_cpu_conv2d_grouped_f64(
+        input: *const c_void,
+        weight: *const c_void,
+        output: *mut c_void,
+        metadata: *const usize,
+    );
+    fn hodu_cpu_conv2d_workspace_size_f32(metadata: *const usize) -> usize;
+    fn hodu_cpu_conv2d_workspace_size_f64(metadata: *const usize) -> usize;
+    fn hodu_cpu_conv2d_packed_weight_size_f32(metadata: *const usize) -> usize;
+    fn hodu_cpu_conv2d_packed_weight_size_f64(metadata: *const usize) -> usize;
+    fn hodu_cpu_conv2d_pack_weight_f32(weight: *const c_void, packed: *mut c_void, metadata: *const usize);
+    fn hodu_cpu_conv2d_pack_weight_f64(weight: *const c_void, packed: *mut c_void, metadata: *const usize);
+    fn hodu_cpu_conv2d_packed_f32(
+        input: *const c_void,
+        packed_weight: *const c_void,
+        output: *mut c_void,
+        metadata: *const usize,
+        epilogue: *const Epilogue,
+    );
+    fn hodu_cpu_conv2d_fused_f32(
+        input: *const c_void,
+        weight: *const c_void,
+        output: *mut c_void,
+        metadata: *const usize,
+        epilogue: *const Epilogue,
+    );
+    fn hodu_cpu_conv2d_packed_f64(
+        input: *const c_void,
+        packed_weight: *const c_void,
+        output: *mut c_void,
+        metadata: *const usize,
+        epilogue: *const Epilogue,
+    );
+    fn hodu_cpu_conv2d_fused_f64(
+        input: *const c_void,
+        weight: *const c_void,
+        output: *mut c_void,
+        metadata: *const usize,
+        epilogue: *const Epilogue,
+    );
+}
+
 extern "C" {
     fn hodu_cpu_conv1d_f8e4m3(input: *const c_void, weight: *const c_void, output: *mut c_void, metadata: *const usize);
     fn hodu_cpu_conv1d_f8e5m2(input: *const c_void, weight: *const c_void, output: *mut c_void, metadata: *const usize);
@@ -41,6 +119,42 @@ extern "C" {
     fn hodu_cpu_conv2d_f16(input: *const c_void, weight: *const c_void, output: *mut c_void, metadata: *const usize);
     fn hodu_cpu_conv2d_f32(input: *const c_void, weight: *const c_void, output: *mut c_void, metadata: *const usize);
     fn hodu_cpu_conv2d_f64(input: *const c_void, weight: *const c_void, output: *mut c_void, metadata: *const usize);
+    fn hodu_cpu_conv2d_nhwc_f8e4m3(
+        input: *const c_void,
+        weight: *const c_void,
+        output: *mut c_void,
+        metadata: *const usize,
+    );
+    fn hodu_cpu_conv2d_nhwc_f8e5m2(
+        input: *const c_void,
+        weight: *const c_void,
+        output: *mut c_void,
+        metadata: *const usize,
+    );
+    fn hodu_cpu_conv2d_nhwc_bf16(
+        input: *const c_void,
+        weight: *const c_void,
+        output: *mut c_void,
+        metadata: *const usize,
+    );
+    fn hodu_cpu_conv2d_nhwc_f16(
+        input: *const c_void,
+        weight: *const c_void,
+        output: *mut c_void,
+        metadata: *const usize,
+    );
+    fn hodu_cpu_conv2d_nhwc_f32(
+        input: *const c_void,
+        weight: *const c_void,
+        output: *mut c_void,
+        metadata: *const usize,
+    );
+    fn hodu_cpu_conv2d_nhwc_f64(
+        input: *const c_void,
+        weight: *const c_void,
+        output: *mut c_void,
+        metadata: *const usize,
+    );
     fn hodu_cpu_conv3d_f8e4m3(input: *const c_void, weight: *const c_void, output: *mut c_void, metadata: *const usize);
     fn hodu_cpu_conv3d_f8e5m2(input: *const c_void, weight: *const c_void, output: *mut c_void, metadata: *const usize);
     fn hodu_cpu_conv3d_bf16(input: *const c_void, weight: *const c_void, output: *mut c_void, metadata: *const usize);
@@ -419,6 +533,10 @@ extern "C" {
 /// - metadata[16]: input_offset
 /// - metadata[17]: weight_offset
 ///
+/// conv2d_nhwc takes the same metadata with channels-last tensors: input
+/// [batch, in_height, in_width, in_channels], weight [out_channels, kernel_height,
+/// kernel_width, in_channels] and output [batch, out_height, out_width, out_channels].
+///
 /// # Metadata layout for conv3d / conv_transpose3d
 /// - metadata[0]: num_els (total number of output elements)
 /// - metadata[1]: batch
@@ -474,6 +592,12 @@ pub fn call_ops_conv(
             conv2d::F16 => hodu_cpu_conv2d_f16(input, weight, output, metadata.as_ptr()),
             conv2d::F32 => hodu_cpu_conv2d_f32(input, weight, output, metadata.as_ptr()),
             conv2d::F64 => hodu_cpu_conv2d_f64(input, weight, output, metadata.as_ptr()),
+            conv2d_nhwc::F8E4M3 => hodu_cpu_conv2d_nhwc_f8e4m3(input, weight, output, metadata.as_ptr()),
+            conv2d_nhwc::F8E5M2 => hodu_cpu_conv2d_nhwc_f8e5m2(input, weight, output, metadata.as_ptr()),
+            conv2d_nhwc::BF16 => hodu_cpu_conv2d_nhwc_bf16(input, weight, output, metadata.as_ptr()),
+            conv2d_nhwc::F16 => hodu_cpu_conv2d_nhwc_f16(input, weight, output, metadata.as_ptr()),
+            conv2d_nhwc::F32 => hodu_cpu_conv2d_nhwc_f32(input, weight, output, metadata.as_ptr()),
+            conv2d_nhwc::F64 => hodu_cpu_conv2d_nhwc_f64(input, weight, output, metadata.as_ptr()),
             conv3d::F8E4M3 => hodu_cpu_conv3d_f8e4m3(input, weight, output, metadata.as_ptr()),
             conv3d::F8E5M2 => hodu_cpu_conv3d_f8e5m2(input, weight, output, metadata.as_ptr()),
             conv3d::BF16 => hodu_cpu_conv3d_bf16(input, weight, output, metadata.as_ptr()),
@@ -505,6 +629,178 @@ pub fn call_ops_conv(
     Ok(())
 }
 
+/// Scratch bytes one conv2d call needs from a caller workspace (see `with_workspace`)
+///
+/// # Arguments
+/// * `kernel` - The conv2d kernel (conv2d::F32 or conv2d::F64)
+/// * `metadata` - conv2d metadata
+pub fn conv2d_workspace_size(kernel: Kernel, metadata: &[usize]) -> usize {
+    unsafe {
+        match kernel {
+            conv2d::F32 => hodu_cpu_conv2d_workspace_size_f32(metadata.as_ptr()),
+            conv2d::F64 => hodu_cpu_conv2d_workspace_size_f64(metadata.as_ptr()),
+            _ => panic!("Unsupported workspace conv kernel: {:?}", kernel),
+        }
+    }
+}
+
+/// Size in bytes of the packed weight buffer for a conv2d layer
+///
+/// # Arguments
+/// * `kernel` - The packed conv kernel (conv2d_packed::F32 or conv2d_packed::F64)
+/// * `metadata` - conv2d metadata (only channels, kernel size and weight_offset are read)
+pub fn conv2d_packed_weight_size(kernel: Kernel, metadata: &[usize]) -> usize {
+    unsafe {
+        match kernel {
+            conv2d_packed::F32 => hodu_cpu_conv2d_packed_weight_size_f32(metadata.as_ptr()),
+            conv2d_packed::F64 => hodu_cpu_conv2d_packed_weight_size_f64(metadata.as_ptr()),
+            _ => panic!("Unsupported packed conv kernel: {:?}", kernel),
+        }
+    }
+}
+
+/// Pack a constant conv2d weight once for `call_ops_conv2d_packed`
+///
+/// # Arguments
+/// * `kernel` - The packed conv kernel (conv2d_packed::F32 or conv2d_packed::F64)
+/// * `weight` - Pointer to the `[out_channels, in_channels, kh, kw]` weight
+/// * `packed` - Pointer to a buffer of `conv2d_packed_weight_size(kernel, metadata)` bytes
+/// * `metadata` - conv2d metadata
+///
+/// The packed layout is specific to the build (SIMD width) and must not be persisted.
+///
+/// # Returns
+/// Returns `Ok(())` on success.
+pub fn call_ops_conv2d_pack_weight(
+    kernel: Kernel,
+    weight: *const c_void,
+    packed: *mut c_void,
+    metadata: &[usize],
+) -> Result<()> {
+    unsafe {
+        match kernel {
+            conv2d_packed::F32 => hodu_cpu_conv2d_pack_weight_f32(weight, packed, metadata.as_ptr()),
+            conv2d_packed::F64 => hodu_cpu_conv2d_pack_weight_f64(weight, packed, metadata.as_ptr()),
+            _ => panic!("Unsupported packed conv kernel: {:?}", kernel),
+        }
+    }
+
+    Ok(())
+}
+
+/// Execute a conv2d against a weight packed by `call_ops_conv2d_pack_weight`
+///
+/// # Arguments
+/// * `kernel` - The packed conv kernel (conv2d_packed::F32 or conv2d_packed::F64)
+/// * `input` - Pointer to input tensor data
+/// * `packed_weight` - Packed weight buffer
+/// * `output` - Pointer to output buffer
+/// * `metadata` - conv2d metadata (same layout as `call_ops_conv`)
+/// * `epilogue` - Optional fused epilogue (see `call_ops_conv2d_fused`)
+///
+/// # Returns
+/// Returns `Ok(())` on success.
+pub fn call_ops_conv2d_packed(
+    kernel: Kernel,
+    input: *const c_void,
+    packed_weight: *const c_void,
+    output: *mut c_void,
+    metadata: &[usize],
+    epilogue: Option<&Epilogue>,
+) -> Result<()> {
+    let epilogue = epilogue.map_or(core::ptr::null(), |e| e as *const Epilogue);
+    unsafe {
+        match kernel {
+            conv2d_packed::F32 => hodu_cpu_conv2d_packed_f32(input, packed_weight, output, metadata.as_ptr(), epilogue),
+            conv2d_packed::F64 => hodu_cpu_conv2d_packed_f64(input, packed_weight, output, metadata.as_ptr(), epilogue),
+            _ => panic!("Unsupported packed conv kernel: {:?}", kernel),
+        }
+    }
+
+    Ok(())
+}
+
+/// Execute a conv2d with a fused epilogue
+///
+/// Computes `output = activation(scale * conv2d(input, weight) + bias + residual)` in one
+/// pass over the output.
+///
+/// # Arguments
+/// * `kernel` - The fused conv kernel (conv2d_fused::F32 or conv2d_fused::F64)
+/// * `input` - Pointer to input tensor data
+/// * `weight` - Pointer to the `[out_channels, in_channels, kh, kw]` weight
+/// * `output` - Pointer to output buffer
+/// * `metadata` - conv2d metadata (same layout as `call_ops_conv`)
+/// * `epilogue` - Bias (out_channels values), residual (output shape) and activation
+///
+/// # Returns
+/// Returns `Ok(())` on success.
+pub fn call_ops_conv2d_fused(
+    kernel: Kernel,
+    input: *const c_void,
+    weight: *const c_void,
+    output: *mut c_void,
+    metadata: &[usize],
+    epilogue: &Epilogue,
+) -> Result<()> {
+    unsafe {
+        match kernel {
+            conv2d_fused::F32 => hodu_cpu_conv2d_fused_f32(input, weight, output, metadata.as_ptr(), epilogue),
+            conv2d_fused::F64 => hodu_cpu_conv2d_fused_f64(input, weight, output, metadata.as_ptr(), epilogue),
+            _ => panic!("Unsupported fused conv kernel: {:?}", kernel),
+        }
+    }
+
+    Ok(())
+}
+
+/// Execute a grouped conv2d
+///
+/// Input channel block `g` (`in_channels / groups` channels) is convolved with output
+/// channels `g * out_channels / groups..` only. `groups == in_channels` is a depthwise
+/// conv (with `out_channels / in_channels` filters per channel) and runs a dedicated SIMD
+/// kernel; other group counts run one GEMM per (batch, group).
+///
+/// # Arguments
+/// * `kernel` - The grouped conv kernel (conv2d_grouped::F32 or conv2d_grouped::F64)
+/// * `input` - Pointer to input tensor data
+/// * `weight` - Pointer to the `[out_channels, in_channels / groups, kh, kw]` weight
+/// * `output` - Pointer to output buffer
+/// * `metadata` - conv2d metadata (same layout as `call_ops_conv`) plus metadata[18]: groups
+///
+/// # Returns
+/// Returns an error if the metadata is too short or groups does not divide both channel counts.
+pub fn call_ops_conv2d_grouped(
+    kernel: Kernel,
+    input: *const c_void,
+    weight: *const c_void,
+    output: *mut c_void,
+    metadata: &[usize],
+) -> Result<()> {
+    if metadata.len() < 19 {
+        return Err(CpuKernelError::InvalidInput(
+            "conv2d_grouped metadata too short".to_string(),
+        ));
+    }
+    let groups = metadata[18];
+    if groups == 0 || metadata[2] % groups != 0 || metadata[3] % groups != 0 {
+        return Err(CpuKernelError::InvalidInput(format!(
+            "{} groups do not divide {} input and {} output channels",
+            groups, metadata[2], metadata[3]
+        )));
+    }
+
+    unsafe {
+        match kernel {
+            conv2d_grouped::F32 => hodu_cpu_conv2d_grouped_f32(input, weight, output, metadata.as_ptr()),
+            conv2d_grouped::F64 => hodu_cpu_conv2d_grouped_f64(input, weight, output, metadata.as_ptr()),
+            _ => panic!("Unsupported grouped conv kernel: {:?}", kernel),
+        }
+    }
+
+    Ok(())
+}
+
 /// Execute a convolution gradient weight operation
 ///
 /// Computes gradients with respect to convolution weights during backpropagation.
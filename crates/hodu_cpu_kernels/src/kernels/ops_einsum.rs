@@ -23,7 +23,7 @@ ops!(einsum);
 /// - input_shape[input_ndim]
 /// - input_strides[input_ndim]
 /// - input_offset
-/// - index_to_dim_map[num_total_indices]
+/// - dim_to_index[input_ndim]: index id of each dim (a repeated id takes the diagonal)
 ///
 /// Index info:
 /// - contraction_index_ids[num_contraction_indices]
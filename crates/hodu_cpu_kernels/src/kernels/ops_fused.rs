@@ -0,0 +1,258 @@
+//! Fused elementwise operations
+//!
+//! This module runs a chain of unary/binary elementwise ops, given as a small register
+//! program, in one tiled pass over the output instead of one kernel (and one full-size
+//! intermediate) per op.
+
+use crate::error::{CpuKernelError, Result};
+use core::ffi::c_void;
+
+/// Fused elementwise kernels, one per element type (computed in f32, or f64 for F64)
+pub mod fused_elementwise {
+    use crate::kernels::macros::Kernel;
+    pub const F8E4M3: Kernel = Kernel("hodu_cpu_fused_elementwise_f8e4m3");
+    pub const F8E5M2: Kernel = Kernel("hodu_cpu_fused_elementwise_f8e5m2");
+    pub const BF16: Kernel = Kernel("hodu_cpu_fused_elementwise_bf16");
+    pub const F16: Kernel = Kernel("hodu_cpu_fused_elementwise_f16");
+    pub const F32: Kernel = Kernel("hodu_cpu_fused_elementwise_f32");
+    pub const F64: Kernel = Kernel("hodu_cpu_fused_elementwise_f64");
+}
+
+/// Maximum number of inputs of a fused program (`HODU_CPU_FUSED_MAX_INPUTS`)
+pub const FUSED_MAX_INPUTS: usize = 8;
+/// Number of registers of a fused program (`HODU_CPU_FUSED_MAX_REGS`)
+pub const FUSED_MAX_REGS: usize = 16;
+/// Maximum number of instructions of a fused program (`HODU_CPU_FUSED_MAX_INSTS`)
+pub const FUSED_MAX_INSTS: usize = 64;
+
+/// Opcode of a fused instruction (mirrors `hodu_cpu_fused_op_t` in ops_fused.h)
+#[repr(i32)]
+#[derive(Debug, Clone, Copy, PartialEq, Eq)]
+pub enum FusedOp {
+    /// `r[dst] = inputs[a]`
+    Load = 0,
+    /// `r[dst] = imm`
+    Const = 1,
+    Neg = 2,
+    Abs = 3,
+    Square = 4,
+    Sqrt = 5,
+    Recip = 6,
+    Relu = 7,
+    Sigmoid = 8,
+    Tanh = 9,
+    /// tanh approximation, as in the unary gelu kernel
+    Gelu = 10,
+    Silu = 11,
+    Exp = 12,
+    Ln = 13,
+    Erf = 14,
+    Add = 15,
+    Sub = 16,
+    Mul = 17,
+    Div = 18,
+    Maximum = 19,
+    Minimum = 20,
+    Pow = 21,
+    /// `r[dst] = r[a] * r[b] + r[c]`
+    MulAdd = 22,
+}
+
+impl FusedOp {
+    /// Number of source registers the op reads
+    pub fn arity(self) -> usize {
+        match self {
+            FusedOp::Load | FusedOp::Const => 0,
+            FusedOp::Neg
+            | FusedOp::Abs
+            | FusedOp::Square
+            | FusedOp::Sqrt
+            | FusedOp::Recip
+            | FusedOp::Relu
+            | FusedOp::Sigmoid
+            | FusedOp::Tanh
+            | FusedOp::Gelu
+            | FusedOp::Silu
+            | FusedOp::Exp
+            | FusedOp::Ln
+            | FusedOp::Erf => 1,
+            FusedOp::MulAdd => 3,
+            _ => 2,
+        }
+    }
+}
+
+/// One instruction of a fused program (mirrors `hodu_cpu_fused_inst_t` in ops_fused.h)
+#[repr(C)]
+#[derive(Debug, Clone, Copy, PartialEq)]
+pub struct FusedInst {
+    pub op: FusedOp,
+    /// Destination register
+    pub dst: i32,
+    /// First source register (`Load`: input index)
+    pub a: i32,
+    pub b: i32,
+    pub c: i32,
+    /// `Const` value
+    pub imm: f64,
+}
+
+impl FusedInst {
+    /// `r[dst] = inputs[input]`
+    pub fn load(dst: i32, input: i32) -> Self {
+        Self::new(FusedOp::Load, dst, input, 0, 0, 0.0)
+    }
+
+    /// `r[dst] = value`
+    pub fn constant(dst: i32, value: f64) -> Self {
+        Self::new(FusedOp::Const, dst, 0, 0, 0, value)
+    }
+
+    /// `r[dst] = op(r[a])`
+    pub fn unary(op: FusedOp, dst: i32, a: i32) -> Self {
+        Self::new(op, dst, a, 0, 0, 0.0)
+    }
+
+    /// `r[dst] = op(r[a], r[b])`
+    pub fn binary(op: FusedOp, dst: i32, a: i32, b: i32) -> Self {
+        Self::new(op, dst, a, b, 0, 0.0)
+    }
+
+    /// `r[dst] = r[a] * r[b] + r[c]`
+    pub fn mul_add(dst: i32, a: i32, b: i32, c: i32) -> Self {
+        Self::new(FusedOp::MulAdd, dst, a, b, c, 0.0)
+    }
+
+    fn new(op: FusedOp, dst: i32, a: i32, b: i32, c: i32, imm: f64) -> Self {
+        Self { op, dst, a, b, c, imm }
+    }
+}
+
+/// Check a program the way the C kernel does, so invalid ones are reported instead of skipped
+fn validate_program(program: &[FusedInst], num_inputs: usize) -> Result<()> {
+    let invalid = |i: usize, what: &str| CpuKernelError::InvalidInput(format!("fused instruction {}: {}", i, what));
+    if program.is_empty() || program.len() > FUSED_MAX_INSTS {
+        return Err(CpuKernelError::InvalidInput(format!(
+            "fused program needs 1..={} instructions, got {}",
+            FUSED_MAX_INSTS,
+            program.len()
+        )));
+    }
+
+    let mut written = 0u32;
+    for (i, inst) in program.iter().enumerate() {
+        if inst.dst < 0 || inst.dst as usize >= FUSED_MAX_REGS {
+            return Err(invalid(i, "destination register out of range"));
+        }
+        if inst.op == FusedOp::Load && (inst.a < 0 || inst.a as usize >= num_inputs) {
+            return Err(invalid(i, "input index out of range"));
+        }
+        for &src in [inst.a, inst.b, inst.c].iter().take(inst.op.arity()) {
+            if src < 0 || src as usize >= FUSED_MAX_REGS || written & (1 << src) == 0 {
+                return Err(invalid(i, "reads a register that was not written"));
+            }
+        }
+        written |= 1 << inst.dst;
+    }
+
+    Ok(())
+}
+
+/// Evaluate a fused elementwise program in one pass over the output
+///
+/// The output is the register written by the last instruction.
+///
+/// # Arguments
+/// * `kernel_name` - The kernel for the element type (e.g. fused_elementwise::F32)
+/// * `inputs` - Input tensors, all of the kernel's element type
+/// * `output` - Contiguous output buffer
+/// * `metadata` - Layouts (see below)
+/// * `program` - Instructions, run in order for every element
+///
+/// # Metadata layout
+/// - metadata[0]: num_els (total number of output elements)
+/// - metadata[1]: num_dims (number of dimensions)
+/// - metadata[2]: num_inputs
+/// - metadata[3..3+num_dims]: output shape
+/// - per input: strides[num_dims], then offset
+///
+/// Broadcast inputs are expanded to the output shape with stride 0 along broadcast dims.
+///
+/// # Returns
+/// Returns an error if the program is invalid or its inputs do not match the metadata.
+pub fn call_ops_fused_elementwise(
+    kernel_name: crate::kernels::macros::Kernel,
+    inputs: &[*const c_void],
+    output: *mut c_void,
+    metadata: &[usize],
+    program: &[FusedInst],
+) -> Result<()> {
+    if metadata.len() < 3 {
+        return Err(CpuKernelError::InvalidInput("fused metadata too short".to_string()));
+    }
+    let num_dims = metadata[1];
+    let num_inputs = metadata[2];
+    if num_inputs != inputs.len() || num_inputs > FUSED_MAX_INPUTS {
+        return Err(CpuKernelError::InvalidInput(format!(
+            "fused kernel takes up to {} inputs as given by metadata[2] ({}), got {}",
+            FUSED_MAX_INPUTS,
+            num_inputs,
+            inputs.len()
+        )));
+    }
+    if metadata.len() < 3 + num_dims + num_inputs * (num_dims + 1) {
+        return Err(CpuKernelError::InvalidInput("fused metadata too short".to_string()));
+    }
+    validate_program(program, num_inputs)?;
+
+    unsafe {
+        dispatch_fused_elementwise(
+            kernel_name.0,
+            inputs.as_ptr(),
+            output,
+            metadata.as_ptr(),
+            program.as_ptr(),
+            program.len(),
+        );
+    }
+
+    Ok(())
+}
+
+macro_rules! declare_and_dispatch_fused_elementwise {
+    ($($dtype:ident),* $(,)?) => {
+        paste::paste! {
+            extern "C" {
+                $(
+                    fn [<hodu_cpu_fused_elementwise_ $dtype>](
+                        inputs: *const *const c_void,
+                        output: *mut c_void,
+                        metadata: *const usize,
+                        program: *const FusedInst,
+                        num_insts: usize,
+                    );
+                )*
+            }
+
+            unsafe fn dispatch_fused_elementwise(
+                kernel_name: &str,
+                inputs: *const *const c_void,
+                output: *mut c_void,
+                metadata: *const usize,
+                program: *const FusedInst,
+                num_insts: usize,
+            ) {
+                match kernel_name {
+                    $(
+                        concat!("hodu_cpu_fused_elementwise_", stringify!($dtype)) => {
+                            [<hodu_cpu_fused_elementwise_ $dtype>](inputs, output, metadata, program, num_insts)
+                        }
+                    )*
+                    _ => panic!("Unsupported fused elementwise kernel: {}", kernel_name),
+                }
+            }
+        }
+    };
+}
+
+declare_and_dispatch_fused_elementwise!(f8e4m3, f8e5m2, bf16, f16, f32, f64);
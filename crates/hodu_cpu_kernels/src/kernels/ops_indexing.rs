@@ -375,6 +375,7 @@ pub fn call_ops_index_select(
 /// - All pointers are valid and properly aligned
 /// - Metadata accurately describes tensor layout
 /// - Output buffer has sufficient capacity
+/// - `output` may be `input` itself (in place); `values` and `indices` must not overlap it
 ///
 /// # Returns
 /// Returns `Ok(())` on success.
@@ -476,6 +477,7 @@ pub fn call_ops_gather(
 /// - All pointers are valid and properly aligned
 /// - Metadata accurately describes tensor layout
 /// - Output buffer has sufficient capacity (same as input)
+/// - `output` may be `input` itself (in place); `src` and `indices` must not overlap it
 /// - src and indices tensors have compatible shapes
 ///
 /// # Returns
@@ -4,12 +4,15 @@
 //! - `det`: Matrix determinant computation using LU decomposition
 //! - `inv`: Matrix inverse computation using Gauss-Jordan elimination
 //! - `trace`: Matrix trace computation (sum of diagonal)
+//! - `solve`: Linear system solve A X = B (f32, f64)
+//! - `cholesky`: Cholesky decomposition A = L L^T (f32, f64)
+//! - `qr`: Reduced QR decomposition A = Q R (f32, f64)
 
 use crate::{error::Result, kernels::macros::ops};
 use core::ffi::c_void;
 
 // Define all linalg operations using the macro
-ops!(det, inv, trace);
+ops!(det, inv, trace, solve, cholesky, qr);
 
 /// Execute a matrix determinant operation
 ///
@@ -133,6 +136,129 @@ pub fn call_ops_trace(
     Ok(())
 }
 
+/// Execute a linear solve
+///
+/// Solves A X = B for square A with optional batch dimensions (f32, f64), using blocked LU
+/// with partial pivoting (LAPACK gesv when built against a LAPACK-enabled OpenBLAS).
+///
+/// # Arguments
+/// * `kernel_name` - The solve kernel to execute (e.g., solve::F32)
+/// * `a` - Pointer to A [..., N, N]
+/// * `b` - Pointer to B [..., N, K]
+/// * `output` - Pointer to the contiguous X [..., N, K] buffer
+/// * `metadata` - Tensor metadata array (see layout below)
+///
+/// # Metadata layout
+/// - metadata[0]: batch_size (product of batch dimensions)
+/// - metadata[1]: n (A is N×N)
+/// - metadata[2]: k (number of right-hand sides)
+/// - metadata[3]: ndim (of A and of B)
+/// - metadata[4..4+ndim]: a_shape
+/// - metadata[4+ndim..4+2*ndim]: a_strides
+/// - metadata[4+2*ndim]: a_offset
+/// - metadata[5+2*ndim..5+3*ndim]: b_shape
+/// - metadata[5+3*ndim..5+4*ndim]: b_strides
+/// - metadata[5+4*ndim]: b_offset
+///
+/// # Safety
+/// This function uses unsafe FFI calls to C kernels. Caller must ensure:
+/// - All pointers are valid and properly aligned
+/// - Metadata accurately describes tensor layout
+/// - Output buffer has sufficient capacity (batch_size * n * k elements)
+/// - A and B share the same batch dimensions
+///
+/// # Returns
+/// Returns `Ok(())` on success. For singular A, the output contains inf/nan values.
+pub fn call_ops_solve(
+    kernel_name: crate::kernels::macros::Kernel,
+    a: *const c_void,
+    b: *const c_void,
+    output: *mut c_void,
+    metadata: &[usize],
+) -> Result<()> {
+    unsafe {
+        dispatch_solve(kernel_name.0, a, b, output, metadata.as_ptr());
+    }
+
+    Ok(())
+}
+
+/// Execute a Cholesky decomposition
+///
+/// Computes the lower factor L of A = L L^T for symmetric positive-definite matrices with
+/// optional batch dimensions (f32, f64). Only the lower triangle of A is read.
+///
+/// # Arguments
+/// * `kernel_name` - The cholesky kernel to execute (e.g., cholesky::F32)
+/// * `input` - Pointer to input tensor
+/// * `output` - Pointer to the contiguous L buffer (zero above the diagonal)
+/// * `metadata` - Tensor metadata array (same layout as det/inv)
+///
+/// # Safety
+/// This function uses unsafe FFI calls to C kernels. Caller must ensure:
+/// - All pointers are valid and properly aligned
+/// - Metadata accurately describes tensor layout
+/// - Output buffer has sufficient capacity (batch_size * n * n elements)
+///
+/// # Returns
+/// Returns `Ok(())` on success. A matrix that is not positive definite yields an all-NaN L.
+pub fn call_ops_cholesky(
+    kernel_name: crate::kernels::macros::Kernel,
+    input: *const c_void,
+    output: *mut c_void,
+    metadata: &[usize],
+) -> Result<()> {
+    unsafe {
+        dispatch_cholesky(kernel_name.0, input, output, metadata.as_ptr());
+    }
+
+    Ok(())
+}
+
+/// Execute a reduced QR decomposition
+///
+/// Factors M×N matrices with optional batch dimensions (f32, f64) as A = Q R with
+/// K = min(M, N), using blocked Householder reflections (LAPACK sign convention, so R may have
+/// negative diagonal entries).
+///
+/// # Arguments
+/// * `kernel_name` - The qr kernel to execute (e.g., qr::F32)
+/// * `input` - Pointer to input tensor [..., M, N]
+/// * `q` - Pointer to the contiguous Q [..., M, K] buffer
+/// * `r` - Pointer to the contiguous R [..., K, N] buffer
+/// * `metadata` - Tensor metadata array (see layout below)
+///
+/// # Metadata layout
+/// - metadata[0]: batch_size (product of batch dimensions)
+/// - metadata[1]: m (rows)
+/// - metadata[2]: n (columns)
+/// - metadata[3]: ndim (total number of dimensions)
+/// - metadata[4..4+ndim]: shape
+/// - metadata[4+ndim..4+2*ndim]: strides
+/// - metadata[4+2*ndim]: offset
+///
+/// # Safety
+/// This function uses unsafe FFI calls to C kernels. Caller must ensure:
+/// - All pointers are valid and properly aligned
+/// - Metadata accurately describes tensor layout
+/// - Q and R buffers hold batch_size * m * k and batch_size * k * n elements
+///
+/// # Returns
+/// Returns `Ok(())` on success.
+pub fn call_ops_qr(
+    kernel_name: crate::kernels::macros::Kernel,
+    input: *const c_void,
+    q: *mut c_void,
+    r: *mut c_void,
+    metadata: &[usize],
+) -> Result<()> {
+    unsafe {
+        dispatch_qr(kernel_name.0, input, q, r, metadata.as_ptr());
+    }
+
+    Ok(())
+}
+
 // Det extern C declarations
 extern "C" {
     fn hodu_cpu_det_f8e4m3(input: *const c_void, output: *mut c_void, metadata: *const usize);
@@ -246,3 +372,37 @@ unsafe fn dispatch_trace(name: &str, input: *const c_void, output: *mut c_void,
         _ => panic!("Unsupported trace kernel: {}", name),
     }
 }
+
+// Solve / Cholesky / QR extern C declarations
+extern "C" {
+    fn hodu_cpu_solve_f32(a: *const c_void, b: *const c_void, output: *mut c_void, metadata: *const usize);
+    fn hodu_cpu_solve_f64(a: *const c_void, b: *const c_void, output: *mut c_void, metadata: *const usize);
+    fn hodu_cpu_cholesky_f32(input: *const c_void, output: *mut c_void, metadata: *const usize);
+    fn hodu_cpu_cholesky_f64(input: *const c_void, output: *mut c_void, metadata: *const usize);
+    fn hodu_cpu_qr_f32(input: *const c_void, q: *mut c_void, r: *mut c_void, metadata: *const usize);
+    fn hodu_cpu_qr_f64(input: *const c_void, q: *mut c_void, r: *mut c_void, metadata: *const usize);
+}
+
+unsafe fn dispatch_solve(name: &str, a: *const c_void, b: *const c_void, output: *mut c_void, metadata: *const usize) {
+    match name {
+        "hodu_cpu_solve_f32" => hodu_cpu_solve_f32(a, b, output, metadata),
+        "hodu_cpu_solve_f64" => hodu_cpu_solve_f64(a, b, output, metadata),
+        _ => panic!("Unsupported solve kernel: {}", name),
+    }
+}
+
+unsafe fn dispatch_cholesky(name: &str, input: *const c_void, output: *mut c_void, metadata: *const usize) {
+    match name {
+        "hodu_cpu_cholesky_f32" => hodu_cpu_cholesky_f32(input, output, metadata),
+        "hodu_cpu_cholesky_f64" => hodu_cpu_cholesky_f64(input, output, metadata),
+        _ => panic!("Unsupported cholesky kernel: {}", name),
+    }
+}
+
+unsafe fn dispatch_qr(name: &str, input: *const c_void, q: *mut c_void, r: *mut c_void, metadata: *const usize) {
+    match name {
+        "hodu_cpu_qr_f32" => hodu_cpu_qr_f32(input, q, r, metadata),
+        "hodu_cpu_qr_f64" => hodu_cpu_qr_f64(input, q, r, metadata),
+        _ => panic!("Unsupported qr kernel: {}", name),
+    }
+}
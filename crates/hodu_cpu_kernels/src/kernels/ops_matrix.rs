@@ -3,15 +3,141 @@
 //! This module provides:
 //! - `matmul`: Batched matrix multiplication with broadcasting support
 //! - `dot`: Optimized 2D matrix multiplication
+//! - `qmatmul`: Quantized u8 x i8 2D matrix multiplication with i32 accumulation
+//! - `matmul_quant`: f32/bf16 activations x group-quantized int4/int8 weights (decode GEMV)
+//! - `matmul_packed`: Batched matmul against a rhs pre-packed once with `call_ops_matmul_pack_rhs`
+//! - `matmul_fused`: Batched matmul with a fused bias/residual/activation epilogue
+//! - `matmul_mixed`: Batched f32 matmul against a bf16/f16/f8 rhs, converted while packing
 //!
-//! Both operations support various numeric types including floating point and integers.
+//! `matmul` and `dot` support various numeric types including floating point and integers.
 
-use crate::{error::Result, kernels::macros::ops};
+use crate::{
+    error::{CpuKernelError, Result},
+    kernels::macros::ops,
+};
 use core::ffi::c_void;
 
 // Define all matrix operations using the macro
 ops!(matmul, dot);
 
+/// Quantized matmul kernels (u8 lhs x i8 rhs), named by output type
+pub mod qmatmul {
+    use crate::kernels::macros::Kernel;
+    pub const U8I8_I32: Kernel = Kernel("hodu_cpu_qmatmul_u8i8_i32");
+    pub const U8I8_F32: Kernel = Kernel("hodu_cpu_qmatmul_u8i8_f32");
+    pub const U8I8_I8: Kernel = Kernel("hodu_cpu_qmatmul_u8i8_i8");
+}
+
+/// Weight-only quantized matmul kernels, named by activation and weight type
+pub mod matmul_quant {
+    use crate::kernels::macros::Kernel;
+    pub const F32_Q4: Kernel = Kernel("hodu_cpu_matmul_f32_q4");
+    pub const F32_Q8: Kernel = Kernel("hodu_cpu_matmul_f32_q8");
+    pub const BF16_Q4: Kernel = Kernel("hodu_cpu_matmul_bf16_q4");
+    pub const BF16_Q8: Kernel = Kernel("hodu_cpu_matmul_bf16_q8");
+}
+
+/// Pre-packed rhs matmul kernels (f32/f64)
+pub mod matmul_packed {
+    use crate::kernels::macros::Kernel;
+    pub const F32: Kernel = Kernel("hodu_cpu_matmul_packed_f32");
+    pub const F64: Kernel = Kernel("hodu_cpu_matmul_packed_f64");
+}
+
+/// Fused-epilogue matmul kernels (f32/f64)
+pub mod matmul_fused {
+    use crate::kernels::macros::Kernel;
+    pub const F32: Kernel = Kernel("hodu_cpu_matmul_fused_f32");
+    pub const F64: Kernel = Kernel("hodu_cpu_matmul_fused_f64");
+}
+
+/// Mixed-precision matmul kernels: f32 lhs and output, rhs in the named type
+///
+/// Run through `call_ops_matmul` with the same metadata as `matmul`; the rhs is widened
+/// to f32 inside the GEMM instead of by a separate cast.
+pub mod matmul_mixed {
+    use crate::kernels::macros::Kernel;
+    pub const F32_BF16: Kernel = Kernel("hodu_cpu_matmul_f32_bf16");
+    pub const F32_F16: Kernel = Kernel("hodu_cpu_matmul_f32_f16");
+    pub const F32_F8E4M3: Kernel = Kernel("hodu_cpu_matmul_f32_f8e4m3");
+    pub const F32_F8E5M2: Kernel = Kernel("hodu_cpu_matmul_f32_f8e5m2");
+}
+
+/// Activation applied last by an `Epilogue` (mirrors `hodu_cpu_activation_t`)
+#[repr(i32)]
+#[derive(Debug, Clone, Copy, PartialEq, Eq, Default)]
+pub enum Activation {
+    #[default]
+    None = 0,
+    Relu = 1,
+    /// tanh approximation, as in the unary gelu kernel
+    Gelu = 2,
+    Silu = 3,
+    Sigmoid = 4,
+    Tanh = 5,
+}
+
+/// Fused output epilogue: `output = activation(scale * product + bias + residual)`
+///
+/// Mirrors `hodu_cpu_epilogue_t` in epilogue.h. `bias` and `residual` use the output
+/// element type; null skips the term.
+#[repr(C)]
+#[derive(Debug, Clone, Copy)]
+pub struct Epilogue {
+    pub scale: f32,
+    /// One value per output column (matmul) or output channel (conv)
+    pub bias: *const c_void,
+    /// Same shape and contiguous layout as the output
+    pub residual: *const c_void,
+    pub activation: Activation,
+}
+
+impl Default for Epilogue {
+    fn default() -> Self {
+        Self {
+            scale: 1.0,
+            bias: core::ptr::null(),
+            residual: core::ptr::null(),
+            activation: Activation::None,
+        }
+    }
+}
+
+/// Quantization parameters for `call_ops_qmatmul` (`real = scale * (q - zero_point)`)
+///
+/// Mirrors `hodu_cpu_qparams_t` in ops_matrix.h.
+#[repr(C)]
+#[derive(Debug, Clone, Copy)]
+pub struct QuantParams {
+    pub lhs_scale: f32,
+    pub lhs_zero_point: i32,
+    /// `rhs_channels` scales (null = 1.0)
+    pub rhs_scales: *const f32,
+    /// `rhs_channels` zero points (null = symmetric weights)
+    pub rhs_zero_points: *const i32,
+    /// 1 = per-tensor, N = per output column
+    pub rhs_channels: usize,
+    /// Requantization scale (i8 output only)
+    pub output_scale: f32,
+    /// Requantization zero point (i8 output only)
+    pub output_zero_point: i32,
+}
+
+/// Per-group weight quantization for `call_ops_matmul_quant`
+///
+/// `weight = scale * (q - zero_point)`, with one scale and zero point per `group_size`
+/// consecutive weights of an output column. Mirrors `hodu_cpu_group_qparams_t` in ops_matrix.h.
+#[repr(C)]
+#[derive(Debug, Clone, Copy)]
+pub struct GroupQuantParams {
+    /// `[n, k / group_size]` scales
+    pub scales: *const half::f16,
+    /// `[n, k / group_size]` zero points (null = 8 for int4, 0 for int8)
+    pub zero_points: *const half::f16,
+    /// Weights per group, a multiple of 32 dividing k
+    pub group_size: usize,
+}
+
 /// Execute a batched matrix multiplication operation with broadcasting
 ///
 /// Performs batched matrix multiplication (C = A @ B) with support for broadcasting
@@ -113,6 +239,312 @@ pub fn call_ops_dot(
     Ok(())
 }
 
+/// Execute a quantized 2D matrix multiplication operation
+///
+/// Multiplies u8 activations (lhs) by i8 weights (rhs) with exact i32 accumulation,
+/// subtracting zero points, then converts to the kernel's output type:
+/// - `qmatmul::U8I8_I32`: zero-point corrected i32 sums (scales ignored)
+/// - `qmatmul::U8I8_F32`: `lhs_scale * rhs_scale[j] * sum`
+/// - `qmatmul::U8I8_I8`: f32 result requantized with `output_scale`/`output_zero_point`
+///
+/// # Arguments
+/// * `kernel_name` - The qmatmul kernel to execute (e.g., qmatmul::U8I8_I32)
+/// * `lhs` - Pointer to u8 left-hand side matrix (A)
+/// * `rhs` - Pointer to i8 right-hand side matrix (B)
+/// * `output` - Pointer to output matrix buffer (C)
+/// * `metadata` - Same layout as `call_ops_dot`
+/// * `params` - Scales and zero points
+///
+/// # Safety
+/// Same requirements as `call_ops_dot`; `params.rhs_scales` / `params.rhs_zero_points`
+/// must be null or point to `params.rhs_channels` values.
+///
+/// # Returns
+/// Returns `Ok(())` on success.
+pub fn call_ops_qmatmul(
+    kernel_name: crate::kernels::macros::Kernel,
+    lhs: *const c_void,
+    rhs: *const c_void,
+    output: *mut c_void,
+    metadata: &[usize],
+    params: &QuantParams,
+) -> Result<()> {
+    unsafe {
+        match kernel_name.0 {
+            "hodu_cpu_qmatmul_u8i8_i32" => hodu_cpu_qmatmul_u8i8_i32(lhs, rhs, output, metadata.as_ptr(), params),
+            "hodu_cpu_qmatmul_u8i8_f32" => hodu_cpu_qmatmul_u8i8_f32(lhs, rhs, output, metadata.as_ptr(), params),
+            "hodu_cpu_qmatmul_u8i8_i8" => hodu_cpu_qmatmul_u8i8_i8(lhs, rhs, output, metadata.as_ptr(), params),
+            _ => panic!("Unsupported qmatmul kernel: {}", kernel_name.0),
+        }
+    }
+
+    Ok(())
+}
+
+extern "C" {
+    fn hodu_cpu_qmatmul_u8i8_i32(
+        lhs: *const c_void,
+        rhs: *const c_void,
+        output: *mut c_void,
+        metadata: *const usize,
+        params: *const QuantParams,
+    );
+    fn hodu_cpu_qmatmul_u8i8_f32(
+        lhs: *const c_void,
+        rhs: *const c_void,
+        output: *mut c_void,
+        metadata: *const usize,
+        params: *const QuantParams,
+    );
+    fn hodu_cpu_qmatmul_u8i8_i8(
+        lhs: *const c_void,
+        rhs: *const c_void,
+        output: *mut c_void,
+        metadata: *const usize,
+        params: *const QuantParams,
+    );
+}
+
+/// Execute a matrix multiplication against group-quantized int4/int8 weights
+///
+/// Weights stay quantized in memory and are dequantized in registers, so a decode GEMV
+/// (`m == 1`) reads 4x (int8) or 8x (int4) fewer bytes than with f32 weights. The
+/// output has the activation type:
+/// - `matmul_quant::F32_Q4` / `F32_Q8`: f32 activations and output
+/// - `matmul_quant::BF16_Q4` / `BF16_Q8`: bf16 activations and output (f32 accumulation)
+///
+/// # Arguments
+/// * `kernel_name` - The quantized matmul kernel (e.g., matmul_quant::F32_Q4)
+/// * `lhs` - Pointer to the `[m, k]` activations
+/// * `rhs` - Pointer to the weights, one row of `k` values per output column: `[n, k]`
+///   i8 (Q8) or `[n, k / 2]` bytes of u4 (Q4, blocks of 32 values in 16 bytes with
+///   value `i` in the low nibble of byte `i % 16` for `i < 16`, else the high nibble)
+/// * `output` - Pointer to the contiguous `[m, n]` output
+/// * `metadata` - `[m, k, n, lhs_stride_m, lhs_stride_k, lhs_offset]`
+/// * `params` - Per-group scales and zero points
+///
+/// # Returns
+/// Returns an error if the metadata is too short or `params.group_size` is not a multiple
+/// of 32 dividing `k`.
+pub fn call_ops_matmul_quant(
+    kernel_name: crate::kernels::macros::Kernel,
+    lhs: *const c_void,
+    rhs: *const c_void,
+    output: *mut c_void,
+    metadata: &[usize],
+    params: &GroupQuantParams,
+) -> Result<()> {
+    if metadata.len() < 6 {
+        return Err(CpuKernelError::InvalidInput(
+            "matmul_quant metadata too short".to_string(),
+        ));
+    }
+    let group_size = params.group_size;
+    if group_size == 0 || group_size % 32 != 0 || metadata[1] % group_size != 0 {
+        return Err(CpuKernelError::InvalidInput(format!(
+            "group size {} must be a multiple of 32 dividing k = {}",
+            group_size, metadata[1]
+        )));
+    }
+    unsafe {
+        match kernel_name.0 {
+            "hodu_cpu_matmul_f32_q4" => hodu_cpu_matmul_f32_q4(lhs, rhs, output, metadata.as_ptr(), params),
+            "hodu_cpu_matmul_f32_q8" => hodu_cpu_matmul_f32_q8(lhs, rhs, output, metadata.as_ptr(), params),
+            "hodu_cpu_matmul_bf16_q4" => hodu_cpu_matmul_bf16_q4(lhs, rhs, output, metadata.as_ptr(), params),
+            "hodu_cpu_matmul_bf16_q8" => hodu_cpu_matmul_bf16_q8(lhs, rhs, output, metadata.as_ptr(), params),
+            _ => panic!("Unsupported quantized matmul kernel: {}", kernel_name.0),
+        }
+    }
+
+    Ok(())
+}
+
+extern "C" {
+    fn hodu_cpu_matmul_f32_q4(
+        lhs: *const c_void,
+        rhs: *const c_void,
+        output: *mut c_void,
+        metadata: *const usize,
+        params: *const GroupQuantParams,
+    );
+    fn hodu_cpu_matmul_f32_q8(
+        lhs: *const c_void,
+        rhs: *const c_void,
+        output: *mut c_void,
+        metadata: *const usize,
+        params: *const GroupQuantParams,
+    );
+    fn hodu_cpu_matmul_bf16_q4(
+        lhs: *const c_void,
+        rhs: *const c_void,
+        output: *mut c_void,
+        metadata: *const usize,
+        params: *const GroupQuantParams,
+    );
+    fn hodu_cpu_matmul_bf16_q8(
+        lhs: *const c_void,
+        rhs: *const c_void,
+        output: *mut c_void,
+        metadata: *const usize,
+        params: *const GroupQuantParams,
+    );
+}
+
+/// Size in bytes of the packed rhs buffer for a `[k, n]` matrix
+///
+/// # Arguments
+/// * `kernel_name` - The packed matmul kernel (matmul_packed::F32 or matmul_packed::F64)
+/// * `k` - Rows of rhs
+/// * `n` - Columns of rhs
+pub fn matmul_packed_rhs_size(kernel_name: crate::kernels::macros::Kernel, k: usize, n: usize) -> usize {
+    unsafe {
+        match kernel_name.0 {
+            "hodu_cpu_matmul_packed_f32" => hodu_cpu_matmul_packed_rhs_size_f32(k, n),
+            "hodu_cpu_matmul_packed_f64" => hodu_cpu_matmul_packed_rhs_size_f64(k, n),
+            _ => panic!("Unsupported packed matmul kernel: {}", kernel_name.0),
+        }
+    }
+}
+
+/// Pack a constant rhs matrix once for `call_ops_matmul_packed`
+///
+/// # Arguments
+/// * `kernel_name` - The packed matmul kernel (matmul_packed::F32 or matmul_packed::F64)
+/// * `rhs` - Pointer to the rhs matrix
+/// * `packed` - Pointer to a buffer of `matmul_packed_rhs_size(kernel_name, k, n)` bytes
+/// * `metadata` - `[k, n, rhs_stride_k, rhs_stride_n, rhs_offset]`
+///
+/// The packed layout is specific to the build (SIMD width); persist it through `PackedWeightsWriter`.
+///
+/// # Returns
+/// Returns `Ok(())` on success.
+pub fn call_ops_matmul_pack_rhs(
+    kernel_name: crate::kernels::macros::Kernel,
+    rhs: *const c_void,
+    packed: *mut c_void,
+    metadata: &[usize],
+) -> Result<()> {
+    unsafe {
+        match kernel_name.0 {
+            "hodu_cpu_matmul_packed_f32" => hodu_cpu_matmul_pack_rhs_f32(rhs, packed, metadata.as_ptr()),
+            "hodu_cpu_matmul_packed_f64" => hodu_cpu_matmul_pack_rhs_f64(rhs, packed, metadata.as_ptr()),
+            _ => panic!("Unsupported packed matmul kernel: {}", kernel_name.0),
+        }
+    }
+
+    Ok(())
+}
+
+/// Execute a batched matrix multiplication against a pre-packed rhs
+///
+/// # Arguments
+/// * `kernel_name` - The packed matmul kernel (matmul_packed::F32 or matmul_packed::F64)
+/// * `lhs` - Pointer to left-hand side tensor (A)
+/// * `packed_rhs` - Buffer filled by `call_ops_matmul_pack_rhs`
+/// * `output` - Pointer to output tensor buffer (C)
+/// * `metadata` - Same layout as `call_ops_matmul`; the packed `[K, N]` matrix is applied to
+///   every batch and the rhs shape, strides and offset are ignored
+/// * `epilogue` - Optional fused epilogue (see `call_ops_matmul_fused`)
+///
+/// # Returns
+/// Returns `Ok(())` on success.
+pub fn call_ops_matmul_packed(
+    kernel_name: crate::kernels::macros::Kernel,
+    lhs: *const c_void,
+    packed_rhs: *const c_void,
+    output: *mut c_void,
+    metadata: &[usize],
+    epilogue: Option<&Epilogue>,
+) -> Result<()> {
+    let epilogue = epilogue.map_or(core::ptr::null(), |e| e as *const Epilogue);
+    unsafe {
+        match kernel_name.0 {
+            "hodu_cpu_matmul_packed_f32" => {
+                hodu_cpu_matmul_packed_f32(lhs, packed_rhs, output, metadata.as_ptr(), epilogue)
+            },
+            "hodu_cpu_matmul_packed_f64" => {
+                hodu_cpu_matmul_packed_f64(lhs, packed_rhs, output, metadata.as_ptr(), epilogue)
+            },
+            _ => panic!("Unsupported packed matmul kernel: {}", kernel_name.0),
+        }
+    }
+
+    Ok(())
+}
+
+/// Execute a batched matrix multiplication with a fused epilogue
+///
+/// Computes `output = activation(scale * (lhs @ rhs) + bias + residual)` in one pass over
+/// the output instead of separate matmul, binary and unary kernels.
+///
+/// # Arguments
+/// * `kernel_name` - The fused matmul kernel (matmul_fused::F32 or matmul_fused::F64)
+/// * `lhs` - Pointer to left-hand side tensor (A)
+/// * `rhs` - Pointer to right-hand side tensor (B)
+/// * `output` - Pointer to output tensor buffer (C)
+/// * `metadata` - Same layout as `call_ops_matmul`
+/// * `epilogue` - Bias (N values), residual (output shape) and activation
+///
+/// # Returns
+/// Returns `Ok(())` on success.
+pub fn call_ops_matmul_fused(
+    kernel_name: crate::kernels::macros::Kernel,
+    lhs: *const c_void,
+    rhs: *const c_void,
+    output: *mut c_void,
+    metadata: &[usize],
+    epilogue: &Epilogue,
+) -> Result<()> {
+    unsafe {
+        match kernel_name.0 {
+            "hodu_cpu_matmul_fused_f32" => hodu_cpu_matmul_fused_f32(lhs, rhs, output, metadata.as_ptr(), epilogue),
+            "hodu_cpu_matmul_fused_f64" => hodu_cpu_matmul_fused_f64(lhs, rhs, output, metadata.as_ptr(), epilogue),
+            _ => panic!("Unsupported fused matmul kernel: {}", kernel_name.0),
+        }
+    }
+
+    Ok(())
+}
+
+extern "C" {
+    fn hodu_cpu_matmul_f32_bf16(lhs: *const c_void, rhs: *const c_void, output: *mut c_void, metadata: *const usize);
+    fn hodu_cpu_matmul_f32_f16(lhs: *const c_void, rhs: *const c_void, output: *mut c_void, metadata: *const usize);
+    fn hodu_cpu_matmul_f32_f8e4m3(lhs: *const c_void, rhs: *const c_void, output: *mut c_void, metadata: *const usize);
+    fn hodu_cpu_matmul_f32_f8e5m2(lhs: *const c_void, rhs: *const c_void, output: *mut c_void, metadata: *const usize);
+    fn hodu_cpu_matmul_packed_rhs_size_f32(k: usize, n: usize) -> usize;
+    fn hodu_cpu_matmul_packed_rhs_size_f64(k: usize, n: usize) -> usize;
+    fn hodu_cpu_matmul_pack_rhs_f32(rhs: *const c_void, packed: *mut c_void, metadata: *const usize);
+    fn hodu_cpu_matmul_pack_rhs_f64(rhs: *const c_void, packed: *mut c_void, metadata: *const usize);
+    fn hodu_cpu_matmul_packed_f32(
+        lhs: *const c_void,
+        packed_rhs: *const c_void,
+        output: *mut c_void,
+        metadata: *const usize,
+        epilogue: *const Epilogue,
+    );
+    fn hodu_cpu_matmul_fused_f32(
+        lhs: *const c_void,
+        rhs: *const c_void,
+        output: *mut c_void,
+        metadata: *const usize,
+        epilogue: *const Epilogue,
+    );
+    fn hodu_cpu_matmul_packed_f64(
+        lhs: *const c_void,
+        packed_rhs: *const c_void,
+        output: *mut c_void,
+        metadata: *const usize,
+        epilogue: *const Epilogue,
+    );
+    fn hodu_cpu_matmul_fused_f64(
+        lhs: *const c_void,
+        rhs: *const c_void,
+        output: *mut c_void,
+        metadata: *const usize,
+        epilogue: *const Epilogue,
+    );
+}
+
 /// Macro to generate extern C declarations and dispatch logic for matrix operations
 ///
 /// This macro generates FFI bindings for all supported numeric types.
@@ -162,6 +594,10 @@ macro_rules! declare_and_dispatch_matrix {
                     "hodu_cpu_matmul_i16" => hodu_cpu_matmul_i16(lhs, rhs, output, metadata.as_ptr()),
                     "hodu_cpu_matmul_i32" => hodu_cpu_matmul_i32(lhs, rhs, output, metadata.as_ptr()),
                     "hodu_cpu_matmul_i64" => hodu_cpu_matmul_i64(lhs, rhs, output, metadata.as_ptr()),
+                    "hodu_cpu_matmul_f32_bf16" => hodu_cpu_matmul_f32_bf16(lhs, rhs, output, metadata.as_ptr()),
+                    "hodu_cpu_matmul_f32_f16" => hodu_cpu_matmul_f32_f16(lhs, rhs, output, metadata.as_ptr()),
+                    "hodu_cpu_matmul_f32_f8e4m3" => hodu_cpu_matmul_f32_f8e4m3(lhs, rhs, output, metadata.as_ptr()),
+                    "hodu_cpu_matmul_f32_f8e5m2" => hodu_cpu_matmul_f32_f8e5m2(lhs, rhs, output, metadata.as_ptr()),
                     _ => panic!("Unsupported matmul kernel: {}", name),
                 }
             }
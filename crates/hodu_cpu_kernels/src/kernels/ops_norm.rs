@@ -0,0 +1,198 @@
+//! Fused normalization operations
+//!
+//! This module provides row-wise normalizations computed in a single kernel:
+//! - softmax, log_softmax: online max and sum with one read of each row
+//! - layer_norm: normalization to zero mean / unit variance with optional affine weight and bias
+//! - rms_norm: normalization by the root mean square with an optional weight
+//!
+//! All operations normalize along one dimension and support float types only
+//! (f8e4m3, f8e5m2, bf16, f16, f32, f64).
+
+use crate::{error::Result, kernels::macros::ops};
+use core::ffi::c_void;
+
+ops!(softmax, log_softmax, layer_norm, rms_norm);
+
+/// Call softmax or log_softmax by kernel name
+///
+/// Computes `exp(x - max) / sum(exp(x - max))` (softmax) or `x - max - log(sum(exp(x - max)))`
+/// (log_softmax) along the specified dimension.
+///
+/// # Metadata layout
+/// - metadata[0]: num_els (total number of elements)
+/// - metadata[1]: num_dims (number of dimensions)
+/// - metadata[2..2+num_dims]: shape
+/// - metadata[2+num_dims..2+2*num_dims]: strides
+/// - metadata[2+2*num_dims]: offset
+/// - metadata[3+2*num_dims]: dim (dimension to normalize along)
+///
+/// The output is contiguous with the input shape.
+///
+/// # Safety
+/// - `input` must point to valid tensor data of the appropriate type
+/// - `output` must point to a valid output buffer with sufficient capacity
+/// - Metadata must accurately describe the tensor layout
+pub fn call_ops_softmax(
+    kernel_name: crate::kernels::macros::Kernel,
+    input: *const c_void,
+    output: *mut c_void,
+    metadata: &[usize],
+) -> Result<()> {
+    unsafe {
+        dispatch_softmax(kernel_name.0, input, output, metadata.as_ptr());
+    }
+    Ok(())
+}
+
+/// Call layer_norm by kernel name
+///
+/// Computes `(x - mean) / sqrt(var + eps) * weight + bias` along the specified dimension
+/// (population variance).
+///
+/// # Arguments
+/// * `weight` - `shape[dim]` values of the tensor type, or null to skip the scale
+/// * `bias` - `shape[dim]` values of the tensor type, or null to skip the shift
+/// * `eps` - Value added to the variance
+///
+/// # Metadata layout
+/// Same as `call_ops_softmax`.
+///
+/// # Safety
+/// - `input` must point to valid tensor data of the appropriate type
+/// - `weight` and `bias` must be null or point to `shape[dim]` elements
+/// - `output` must point to a valid output buffer with sufficient capacity
+/// - Metadata must accurately describe the tensor layout
+pub fn call_ops_layer_norm(
+    kernel_name: crate::kernels::macros::Kernel,
+    input: *const c_void,
+    weight: *const c_void,
+    bias: *const c_void,
+    output: *mut c_void,
+    metadata: &[usize],
+    eps: f32,
+) -> Result<()> {
+    unsafe {
+        dispatch_layer_norm(kernel_name.0, input, weight, bias, output, metadata.as_ptr(), eps);
+    }
+    Ok(())
+}
+
+/// Call rms_norm by kernel name
+///
+/// Computes `x / sqrt(mean(x²) + eps) * weight` along the specified dimension.
+///
+/// # Arguments
+/// * `weight` - `shape[dim]` values of the tensor type, or null to skip the scale
+/// * `eps` - Value added to the mean square
+///
+/// # Metadata layout
+/// Same as `call_ops_softmax`.
+///
+/// # Safety
+/// - `input` must point to valid tensor data of the appropriate type
+/// - `weight` must be null or point to `shape[dim]` elements
+/// - `output` must point to a valid output buffer with sufficient capacity
+/// - Metadata must accurately describe the tensor layout
+pub fn call_ops_rms_norm(
+    kernel_name: crate::kernels::macros::Kernel,
+    input: *const c_void,
+    weight: *const c_void,
+    output: *mut c_void,
+    metadata: &[usize],
+    eps: f32,
+) -> Result<()> {
+    unsafe {
+        dispatch_rms_norm(kernel_name.0, input, weight, output, metadata.as_ptr(), eps);
+    }
+    Ok(())
+}
+
+macro_rules! declare_and_dispatch_norm {
+    ($($dtype:ident),* $(,)?) => {
+        paste::paste! {
+            extern "C" {
+                $(
+                    fn [<hodu_cpu_softmax_ $dtype>](input: *const c_void, output: *mut c_void, metadata: *const usize);
+                    fn [<hodu_cpu_log_softmax_ $dtype>](
+                        input: *const c_void,
+                        output: *mut c_void,
+                        metadata: *const usize,
+                    );
+                    fn [<hodu_cpu_layer_norm_ $dtype>](
+                        input: *const c_void,
+                        weight: *const c_void,
+                        bias: *const c_void,
+                        output: *mut c_void,
+                        metadata: *const usize,
+                        eps: f32,
+                    );
+                    fn [<hodu_cpu_rms_norm_ $dtype>](
+                        input: *const c_void,
+                        weight: *const c_void,
+                        output: *mut c_void,
+                        metadata: *const usize,
+                        eps: f32,
+                    );
+                )*
+            }
+
+            unsafe fn dispatch_softmax(
+                kernel_name: &str,
+                input: *const c_void,
+                output: *mut c_void,
+                metadata: *const usize,
+            ) {
+                match kernel_name {
+                    $(
+                        concat!("hodu_cpu_softmax_", stringify!($dtype)) => {
+                            [<hodu_cpu_softmax_ $dtype>](input, output, metadata)
+                        }
+                        concat!("hodu_cpu_log_softmax_", stringify!($dtype)) => {
+                            [<hodu_cpu_log_softmax_ $dtype>](input, output, metadata)
+                        }
+                    )*
+                    _ => panic!("Unknown kernel: {}", kernel_name),
+                }
+            }
+
+            unsafe fn dispatch_layer_norm(
+                kernel_name: &str,
+                input: *const c_void,
+                weight: *const c_void,
+                bias: *const c_void,
+                output: *mut c_void,
+                metadata: *const usize,
+                eps: f32,
+            ) {
+                match kernel_name {
+                    $(
+                        concat!("hodu_cpu_layer_norm_", stringify!($dtype)) => {
+                            [<hodu_cpu_layer_norm_ $dtype>](input, weight, bias, output, metadata, eps)
+                        }
+                    )*
+                    _ => panic!("Unknown kernel: {}", kernel_name),
+                }
+            }
+
+            unsafe fn dispatch_rms_norm(
+                kernel_name: &str,
+                input: *const c_void,
+                weight: *const c_void,
+                output: *mut c_void,
+                metadata: *const usize,
+                eps: f32,
+            ) {
+                match kernel_name {
+                    $(
+                        concat!("hodu_cpu_rms_norm_", stringify!($dtype)) => {
+                            [<hodu_cpu_rms_norm_ $dtype>](input, weight, output, metadata, eps)
+                        }
+                    )*
+                    _ => panic!("Unknown kernel: {}", kernel_name),
+                }
+            }
+        }
+    };
+}
+
+declare_and_dispatch_norm!(f8e4m3, f8e5m2, bf16, f16, f32, f64);
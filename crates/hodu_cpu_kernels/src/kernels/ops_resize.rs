@@ -10,6 +10,9 @@
 //! - Asymmetric
 //! - AlignCorners
 //! - PytorchHalfPixel
+//!
+//! `resize` takes channels-first tensors ([N, C, spatial...]); `resize_nhwc` takes
+//! channels-last tensors ([N, spatial..., C]) and writes the output channels-last.
 
 use crate::{
     error::Result,
@@ -17,7 +20,7 @@ use crate::{
 };
 use core::ffi::c_void;
 
-ops!(resize);
+ops!(resize, resize_nhwc);
 
 extern "C" {
     fn hodu_cpu_resize_f8e4m3(input: *const c_void, output: *mut c_void, metadata: *const usize);
@@ -26,6 +29,14 @@ extern "C" {
     fn hodu_cpu_resize_f16(input: *const c_void, output: *mut c_void, metadata: *const usize);
     fn hodu_cpu_resize_f32(input: *const c_void, output: *mut c_void, metadata: *const usize);
     fn hodu_cpu_resize_f64(input: *const c_void, output: *mut c_void, metadata: *const usize);
+    fn hodu_cpu_resize_u8(input: *const c_void, output: *mut c_void, metadata: *const usize);
+    fn hodu_cpu_resize_nhwc_f8e4m3(input: *const c_void, output: *mut c_void, metadata: *const usize);
+    fn hodu_cpu_resize_nhwc_f8e5m2(input: *const c_void, output: *mut c_void, metadata: *const usize);
+    fn hodu_cpu_resize_nhwc_bf16(input: *const c_void, output: *mut c_void, metadata: *const usize);
+    fn hodu_cpu_resize_nhwc_f16(input: *const c_void, output: *mut c_void, metadata: *const usize);
+    fn hodu_cpu_resize_nhwc_f32(input: *const c_void, output: *mut c_void, metadata: *const usize);
+    fn hodu_cpu_resize_nhwc_f64(input: *const c_void, output: *mut c_void, metadata: *const usize);
+    fn hodu_cpu_resize_nhwc_u8(input: *const c_void, output: *mut c_void, metadata: *const usize);
 }
 
 /// Call resize operation by kernel name
@@ -34,7 +45,8 @@ extern "C" {
 ///
 /// # Metadata layout
 /// - metadata[0]: output_size (total number of elements in output)
-/// - metadata[1]: num_dims (number of dimensions, typically 4 for NCHW or 5 for NCDHW)
+/// - metadata[1]: num_dims (number of dimensions, typically 4 for NCHW or 5 for NCDHW;
+///   NHWC / NDHWC for `resize_nhwc`, with shapes and strides in that order)
 /// - metadata[2..2+num_dims]: input_shape
 /// - metadata[2+num_dims..2+2*num_dims]: input_strides
 /// - metadata[2+2*num_dims]: offset (starting offset in input)
@@ -48,6 +60,9 @@ extern "C" {
 /// - Linear (1): Bilinear for 2D spatial dims, trilinear for 3D
 /// - Cubic (2): Bicubic interpolation (2D only)
 ///
+/// Float types interpolate in f32; `U8` uses fixed-point weights and rounds to nearest with
+/// saturation.
+///
 /// # Coordinate transformation modes
 /// - HalfPixel (0): out_coord = (in_coord + 0.5) * scale - 0.5
 /// - Asymmetric (1): out_coord = in_coord * scale
@@ -73,6 +88,14 @@ pub fn call_ops_resize(
             "hodu_cpu_resize_f16" => hodu_cpu_resize_f16(input, output, metadata.as_ptr()),
             "hodu_cpu_resize_f32" => hodu_cpu_resize_f32(input, output, metadata.as_ptr()),
             "hodu_cpu_resize_f64" => hodu_cpu_resize_f64(input, output, metadata.as_ptr()),
+            "hodu_cpu_resize_u8" => hodu_cpu_resize_u8(input, output, metadata.as_ptr()),
+            "hodu_cpu_resize_nhwc_f8e4m3" => hodu_cpu_resize_nhwc_f8e4m3(input, output, metadata.as_ptr()),
+            "hodu_cpu_resize_nhwc_f8e5m2" => hodu_cpu_resize_nhwc_f8e5m2(input, output, metadata.as_ptr()),
+            "hodu_cpu_resize_nhwc_bf16" => hodu_cpu_resize_nhwc_bf16(input, output, metadata.as_ptr()),
+            "hodu_cpu_resize_nhwc_f16" => hodu_cpu_resize_nhwc_f16(input, output, metadata.as_ptr()),
+            "hodu_cpu_resize_nhwc_f32" => hodu_cpu_resize_nhwc_f32(input, output, metadata.as_ptr()),
+            "hodu_cpu_resize_nhwc_f64" => hodu_cpu_resize_nhwc_f64(input, output, metadata.as_ptr()),
+            "hodu_cpu_resize_nhwc_u8" => hodu_cpu_resize_nhwc_u8(input, output, metadata.as_ptr()),
             _ => panic!("Unsupported resize kernel: {:?}", kernel_name),
         }
     }
@@ -3,17 +3,39 @@
 //! This module provides scan operations that compute prefix operations:
 //! - cumsum: Cumulative sum along a dimension
 //! - cumprod: Cumulative product along a dimension
+//! - cummax: Cumulative maximum along a dimension (propagates NaN)
+//! - cummin: Cumulative minimum along a dimension (propagates NaN)
 //!
-//! All operations support multiple data types.
+//! Each has `_exclusive` (starts from the identity), `_reverse` (runs from the
+//! end of the dimension) and `_reverse_exclusive` variants with the same
+//! metadata layout. All operations support multiple data types.
 
 use crate::{error::Result, kernels::macros::ops};
 use core::ffi::c_void;
 
-ops!(cumsum, cumprod);
+ops!(
+    cumsum,
+    cumsum_exclusive,
+    cumsum_reverse,
+    cumsum_reverse_exclusive,
+    cumprod,
+    cumprod_exclusive,
+    cumprod_reverse,
+    cumprod_reverse_exclusive,
+    cummax,
+    cummax_exclusive,
+    cummax_reverse,
+    cummax_reverse_exclusive,
+    cummin,
+    cummin_exclusive,
+    cummin_reverse,
+    cummin_reverse_exclusive,
+);
 
-/// Call cumsum operation by kernel name
+/// Call any scan operation or variant by kernel name
 ///
-/// Computes cumulative sum along the specified dimension.
+/// Runs `hodu_cpu_<op>[_reverse][_exclusive]_<dtype>` for op in cumsum,
+/// cumprod, cummax and cummin.
 ///
 /// # Metadata layout
 /// - metadata[0]: num_els (total number of elements)
@@ -27,52 +49,43 @@ ops!(cumsum, cumprod);
 /// - `input` must point to valid tensor data of the appropriate type
 /// - `output` must point to a valid output buffer with sufficient capacity
 /// - Metadata must accurately describe the tensor layout
-pub fn call_ops_cumsum(
+pub fn call_ops_scan(
     kernel_name: crate::kernels::macros::Kernel,
     input: *const c_void,
     output: *mut c_void,
     metadata: &[usize],
 ) -> Result<()> {
     unsafe {
-        dispatch_cumsum(kernel_name.0, input, output, metadata.as_ptr());
+        dispatch_scan(kernel_name.0, input, output, metadata.as_ptr());
     }
     Ok(())
 }
 
-macro_rules! declare_and_dispatch_cumsum {
-    ($($dtype:ident),* $(,)?) => {
-        paste::paste! {
-            extern "C" {
-                $(
-                    fn [<hodu_cpu_cumsum_ $dtype>](
-                        input: *const c_void,
-                        output: *mut c_void,
-                        metadata: *const usize,
-                    );
-                )*
-            }
-
-            unsafe fn dispatch_cumsum(
-                kernel_name: &str,
-                input: *const c_void,
-                output: *mut c_void,
-                metadata: *const usize,
-            ) {
-                match kernel_name {
-                    $(
-                        concat!("hodu_cpu_cumsum_", stringify!($dtype)) => {
-                            [<hodu_cpu_cumsum_ $dtype>](input, output, metadata)
-                        }
-                    )*
-                    _ => panic!("Unknown kernel: {}", kernel_name),
-                }
-            }
-        }
-    };
+/// Call cumsum operation by kernel name
+///
+/// Computes cumulative sum along the specified dimension.
+///
+/// # Metadata layout
+/// - metadata[0]: num_els (total number of elements)
+/// - metadata[1]: num_dims (number of dimensions)
+/// - metadata[2..2+num_dims]: shape
+/// - metadata[2+num_dims..2+2*num_dims]: strides
+/// - metadata[2+2*num_dims]: offset
+/// - metadata[3+2*num_dims]: dim (dimension to scan along)
+///
+/// # Safety
+/// - `input` must point to valid tensor data of the appropriate type
+/// - `output` must point to a valid output buffer with sufficient capacity
+/// - Metadata must accurately describe the tensor layout
+pub fn call_ops_cumsum(
+    kernel_name: crate::kernels::macros::Kernel,
+    input: *const c_void,
+    output: *mut c_void,
+    metadata: &[usize],
+) -> Result<()> {
+    call_ops_scan(kernel_name, input, output, metadata)
 }
 
-declare_and_dispatch_cumsum!(f8e4m3, f8e5m2, bf16, f16, f32, f64, u8, u16, u32, u64, i8, i16, i32, i64);
-
 /// Call cumprod operation by kernel name
 ///
 /// Computes cumulative product along the specified dimension.
@@ -95,26 +108,82 @@ pub fn call_ops_cumprod(
     output: *mut c_void,
     metadata: &[usize],
 ) -> Result<()> {
-    unsafe {
-        dispatch_cumprod(kernel_name.0, input, output, metadata.as_ptr());
-    }
-    Ok(())
+    call_ops_scan(kernel_name, input, output, metadata)
+}
+
+/// Call cummax operation by kernel name
+///
+/// Computes cumulative maximum along the specified dimension.
+///
+/// # Metadata layout
+/// - metadata[0]: num_els (total number of elements)
+/// - metadata[1]: num_dims (number of dimensions)
+/// - metadata[2..2+num_dims]: shape
+/// - metadata[2+num_dims..2+2*num_dims]: strides
+/// - metadata[2+2*num_dims]: offset
+/// - metadata[3+2*num_dims]: dim (dimension to scan along)
+///
+/// # Safety
+/// - `input` must point to valid tensor data of the appropriate type
+/// - `output` must point to a valid output buffer with sufficient capacity
+/// - Metadata must accurately describe the tensor layout
+pub fn call_ops_cummax(
+    kernel_name: crate::kernels::macros::Kernel,
+    input: *const c_void,
+    output: *mut c_void,
+    metadata: &[usize],
+) -> Result<()> {
+    call_ops_scan(kernel_name, input, output, metadata)
+}
+
+/// Call cummin operation by kernel name
+///
+/// Computes cumulative minimum along the specified dimension.
+///
+/// # Metadata layout
+/// - metadata[0]: num_els (total number of elements)
+/// - metadata[1]: num_dims (number of dimensions)
+/// - metadata[2..2+num_dims]: shape
+/// - metadata[2+num_dims..2+2*num_dims]: strides
+/// - metadata[2+2*num_dims]: offset
+/// - metadata[3+2*num_dims]: dim (dimension to scan along)
+///
+/// # Safety
+/// - `input` must point to valid tensor data of the appropriate type
+/// - `output` must point to a valid output buffer with sufficient capacity
+/// - Metadata must accurately describe the tensor layout
+pub fn call_ops_cummin(
+    kernel_name: crate::kernels::macros::Kernel,
+    input: *const c_void,
+    output: *mut c_void,
+    metadata: &[usize],
+) -> Result<()> {
+    call_ops_scan(kernel_name, input, output, metadata)
 }
 
-macro_rules! declare_and_dispatch_cumprod {
-    ($($dtype:ident),* $(,)?) => {
+macro_rules! declare_and_dispatch_scan {
+    ($($op:ident),* $(,)?) => {
         paste::paste! {
             extern "C" {
                 $(
-                    fn [<hodu_cpu_cumprod_ $dtype>](
-                        input: *const c_void,
-                        output: *mut c_void,
-                        metadata: *const usize,
-                    );
+                    fn [<hodu_cpu_ $op _f8e4m3>](input: *const c_void, output: *mut c_void, metadata: *const usize);
+                    fn [<hodu_cpu_ $op _f8e5m2>](input: *const c_void, output: *mut c_void, metadata: *const usize);
+                    fn [<hodu_cpu_ $op _bf16>](input: *const c_void, output: *mut c_void, metadata: *const usize);
+                    fn [<hodu_cpu_ $op _f16>](input: *const c_void, output: *mut c_void, metadata: *const usize);
+                    fn [<hodu_cpu_ $op _f32>](input: *const c_void, output: *mut c_void, metadata: *const usize);
+                    fn [<hodu_cpu_ $op _f64>](input: *const c_void, output: *mut c_void, metadata: *const usize);
+                    fn [<hodu_cpu_ $op _u8>](input: *const c_void, output: *mut c_void, metadata: *const usize);
+                    fn [<hodu_cpu_ $op _u16>](input: *const c_void, output: *mut c_void, metadata: *const usize);
+                    fn [<hodu_cpu_ $op _u32>](input: *const c_void, output: *mut c_void, metadata: *const usize);
+                    fn [<hodu_cpu_ $op _u64>](input: *const c_void, output: *mut c_void, metadata: *const usize);
+                    fn [<hodu_cpu_ $op _i8>](input: *const c_void, output: *mut c_void, metadata: *const usize);
+                    fn [<hodu_cpu_ $op _i16>](input: *const c_void, output: *mut c_void, metadata: *const usize);
+                    fn [<hodu_cpu_ $op _i32>](input: *const c_void, output: *mut c_void, metadata: *const usize);
+                    fn [<hodu_cpu_ $op _i64>](input: *const c_void, output: *mut c_void, metadata: *const usize);
                 )*
             }
 
-            unsafe fn dispatch_cumprod(
+            unsafe fn dispatch_scan(
                 kernel_name: &str,
                 input: *const c_void,
                 output: *mut c_void,
@@ -122,9 +191,20 @@ macro_rules! declare_and_dispatch_cumprod {
             ) {
                 match kernel_name {
                     $(
-                        concat!("hodu_cpu_cumprod_", stringify!($dtype)) => {
-                            [<hodu_cpu_cumprod_ $dtype>](input, output, metadata)
-                        }
+                        concat!("hodu_cpu_", stringify!($op), "_f8e4m3") => [<hodu_cpu_ $op _f8e4m3>](input, output, metadata),
+                        concat!("hodu_cpu_", stringify!($op), "_f8e5m2") => [<hodu_cpu_ $op _f8e5m2>](input, output, metadata),
+                        concat!("hodu_cpu_", stringify!($op), "_bf16") => [<hodu_cpu_ $op _bf16>](input, output, metadata),
+                        concat!("hodu_cpu_", stringify!($op), "_f16") => [<hodu_cpu_ $op _f16>](input, output, metadata),
+                        concat!("hodu_cpu_", stringify!($op), "_f32") => [<hodu_cpu_ $op _f32>](input, output, metadata),
+                        concat!("hodu_cpu_", stringify!($op), "_f64") => [<hodu_cpu_ $op _f64>](input, output, metadata),
+                        concat!("hodu_cpu_", stringify!($op), "_u8") => [<hodu_cpu_ $op _u8>](input, output, metadata),
+                        concat!("hodu_cpu_", stringify!($op), "_u16") => [<hodu_cpu_ $op _u16>](input, output, metadata),
+                        concat!("hodu_cpu_", stringify!($op), "_u32") => [<hodu_cpu_ $op _u32>](input, output, metadata),
+                        concat!("hodu_cpu_", stringify!($op), "_u64") => [<hodu_cpu_ $op _u64>](input, output, metadata),
+                        concat!("hodu_cpu_", stringify!($op), "_i8") => [<hodu_cpu_ $op _i8>](input, output, metadata),
+                        concat!("hodu_cpu_", stringify!($op), "_i16") => [<hodu_cpu_ $op _i16>](input, output, metadata),
+                        concat!("hodu_cpu_", stringify!($op), "_i32") => [<hodu_cpu_ $op _i32>](input, output, metadata),
+                        concat!("hodu_cpu_", stringify!($op), "_i64") => [<hodu_cpu_ $op _i64>](input, output, metadata),
                     )*
                     _ => panic!("Unknown kernel: {}", kernel_name),
                 }
@@ -133,4 +213,21 @@ macro_rules! declare_and_dispatch_cumprod {
     };
 }
 
-declare_and_dispatch_cumprod!(f8e4m3, f8e5m2, bf16, f16, f32, f64, u8, u16, u32, u64, i8, i16, i32, i64);
+declare_and_dispatch_scan!(
+    cumsum,
+    cumsum_exclusive,
+    cumsum_reverse,
+    cumsum_reverse_exclusive,
+    cumprod,
+    cumprod_exclusive,
+    cumprod_reverse,
+    cumprod_reverse_exclusive,
+    cummax,
+    cummax_exclusive,
+    cummax_reverse,
+    cummax_reverse_exclusive,
+    cummin,
+    cummin_exclusive,
+    cummin_reverse,
+    cummin_reverse_exclusive,
+);
@@ -2,13 +2,15 @@
 //!
 //! This module provides sorting operations:
 //! - topk: Get top-k largest or smallest elements along a dimension
+//! - sort: Stable sort along a dimension, returning values and indices
+//! - argsort: Indices of the stable sort along a dimension
 //!
 //! All operations support multiple data types.
 
 use crate::{error::Result, kernels::macros::ops};
 use core::ffi::c_void;
 
-ops!(topk);
+ops!(topk, sort, argsort);
 
 /// Call topk operation by kernel name
 ///
@@ -76,3 +78,113 @@ macro_rules! declare_and_dispatch_topk {
 }
 
 declare_and_dispatch_topk!(f8e4m3, f8e5m2, bf16, f16, f32, f64, u8, u16, u32, u64, i8, i16, i32, i64);
+
+/// Call sort operation by kernel name
+///
+/// Stable sort along one dimension. Equal elements keep their input order,
+/// NaNs sort above +inf and -0 equals +0.
+///
+/// # Metadata layout
+/// - metadata[0]: num_els (total number of elements)
+/// - metadata[1]: num_dims (number of dimensions)
+/// - metadata[2..2+num_dims]: shape
+/// - metadata[2+num_dims..2+2*num_dims]: strides
+/// - metadata[2+2*num_dims]: offset
+/// - metadata[3+2*num_dims]: dim (dimension to sort along)
+/// - metadata[4+2*num_dims]: descending (1 = descending, 0 = ascending)
+///
+/// # Safety
+/// - `input` must point to valid tensor data of the appropriate type
+/// - `values` must point to a contiguous output buffer of num_els elements
+/// - `indices` must point to a contiguous output buffer of num_els i32
+/// - Metadata must accurately describe the tensor layout
+pub fn call_sort(
+    kernel_name: crate::kernels::macros::Kernel,
+    input: *const c_void,
+    values: *mut c_void,
+    indices: *mut c_void,
+    metadata: &[usize],
+) -> Result<()> {
+    unsafe {
+        dispatch_sort(kernel_name.0, input, values, indices, metadata.as_ptr());
+    }
+    Ok(())
+}
+
+/// Call argsort operation by kernel name
+///
+/// Indices (i32) of the stable sort along one dimension; same metadata layout
+/// as [`call_sort`].
+///
+/// # Safety
+/// - `input` must point to valid tensor data of the appropriate type
+/// - `indices` must point to a contiguous output buffer of num_els i32
+/// - Metadata must accurately describe the tensor layout
+pub fn call_argsort(
+    kernel_name: crate::kernels::macros::Kernel,
+    input: *const c_void,
+    indices: *mut c_void,
+    metadata: &[usize],
+) -> Result<()> {
+    unsafe {
+        dispatch_argsort(kernel_name.0, input, indices, metadata.as_ptr());
+    }
+    Ok(())
+}
+
+macro_rules! declare_and_dispatch_sort {
+    ($($dtype:ident),* $(,)?) => {
+        paste::paste! {
+            extern "C" {
+                $(
+                    fn [<hodu_cpu_sort_ $dtype>](
+                        input: *const c_void,
+                        values: *mut c_void,
+                        indices: *mut c_void,
+                        metadata: *const usize,
+                    );
+                    fn [<hodu_cpu_argsort_ $dtype>](
+                        input: *const c_void,
+                        indices: *mut c_void,
+                        metadata: *const usize,
+                    );
+                )*
+            }
+
+            unsafe fn dispatch_sort(
+                kernel_name: &str,
+                input: *const c_void,
+                values: *mut c_void,
+                indices: *mut c_void,
+                metadata: *const usize,
+            ) {
+                match kernel_name {
+                    $(
+                        concat!("hodu_cpu_sort_", stringify!($dtype)) => {
+                            [<hodu_cpu_sort_ $dtype>](input, values, indices, metadata)
+                        }
+                    )*
+                    _ => panic!("Unknown kernel: {}", kernel_name),
+                }
+            }
+
+            unsafe fn dispatch_argsort(
+                kernel_name: &str,
+                input: *const c_void,
+                indices: *mut c_void,
+                metadata: *const usize,
+            ) {
+                match kernel_name {
+                    $(
+                        concat!("hodu_cpu_argsort_", stringify!($dtype)) => {
+                            [<hodu_cpu_argsort_ $dtype>](input, indices, metadata)
+                        }
+                    )*
+                    _ => panic!("Unknown kernel: {}", kernel_name),
+                }
+            }
+        }
+    };
+}
+
+declare_and_dispatch_sort!(bool, f8e4m3, f8e5m2, bf16, f16, f32, f64, u8, u16, u32, u64, i8, i16, i32, i64);
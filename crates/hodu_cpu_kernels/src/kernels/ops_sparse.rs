@@ -0,0 +1,210 @@
+//! Sparse x dense matrix multiplication
+//!
+//! This module provides:
+//! - `sparse_matmul`: `[m, k]` block-sparse (BSR) lhs @ dense `[k, n]` rhs; CSR is the 1x1 block case
+//! - `sparse_from_dense`: Build the BSR/CSR arrays of a dense matrix (`call_ops_sparse_count`,
+//!   `call_ops_sparse_from_dense`)
+//!
+//! Only stored blocks are multiplied, so pruned weights cost in proportion to their
+//! non-zero blocks. Supports f32 and f64.
+
+use crate::error::{CpuKernelError, Result};
+use core::ffi::c_void;
+
+/// Sparse x dense matmul kernels (f32/f64)
+pub mod sparse_matmul {
+    use crate::kernels::macros::Kernel;
+    pub const F32: Kernel = Kernel("hodu_cpu_sparse_matmul_f32");
+    pub const F64: Kernel = Kernel("hodu_cpu_sparse_matmul_f64");
+}
+
+/// Dense to sparse conversion kernels (f32/f64)
+pub mod sparse_from_dense {
+    use crate::kernels::macros::Kernel;
+    pub const F32: Kernel = Kernel("hodu_cpu_sparse_from_dense_f32");
+    pub const F64: Kernel = Kernel("hodu_cpu_sparse_from_dense_f64");
+}
+
+/// Block compressed sparse row (BSR) matrix; 1x1 blocks make it CSR
+///
+/// Block row `i` stores blocks `row_ptr[i]..row_ptr[i + 1]`; block `b` covers columns
+/// `col_idx[b] * block_cols..` and holds `block_rows * block_cols` row-major values at
+/// `values[b * block_rows * block_cols..]`. Both block dims must divide the matrix dims.
+/// Mirrors `hodu_cpu_sparse_t` in ops_sparse.h.
+#[repr(C)]
+#[derive(Debug, Clone, Copy)]
+pub struct SparseMatrix {
+    pub rows: usize,
+    pub cols: usize,
+    pub block_rows: usize,
+    pub block_cols: usize,
+    /// `rows / block_rows + 1` block offsets
+    pub row_ptr: *const u32,
+    /// Block column of every stored block
+    pub col_idx: *const u32,
+    /// Stored block values, in the element type of the kernel
+    pub values: *const c_void,
+}
+
+fn check_blocks(rows: usize, cols: usize, block_rows: usize, block_cols: usize) -> Result<()> {
+    if block_rows == 0 || block_cols == 0 || rows % block_rows != 0 || cols % block_cols != 0 {
+        return Err(CpuKernelError::InvalidInput(format!(
+            "{}x{} blocks do not tile a {}x{} matrix",
+            block_rows, block_cols, rows, cols
+        )));
+    }
+    Ok(())
+}
+
+/// Execute a sparse x dense matmul
+///
+/// # Arguments
+/// * `kernel_name` - The sparse matmul kernel (sparse_matmul::F32 or sparse_matmul::F64)
+/// * `lhs` - The `[m, k]` sparse matrix
+/// * `rhs` - Pointer to the dense `[k, n]` rhs
+/// * `output` - Pointer to the contiguous `[m, n]` output (overwritten)
+/// * `metadata` - `[n, rhs_stride_k, rhs_stride_n, rhs_offset]`
+///
+/// # Safety
+/// `row_ptr`, `col_idx` and `values` must describe a valid matrix: offsets non-decreasing
+/// with `row_ptr[0] = 0`, and block columns below `cols / block_cols`.
+///
+/// # Returns
+/// Returns an error if the metadata is too short or the blocks do not tile the matrix.
+pub fn call_ops_sparse_matmul(
+    kernel_name: crate::kernels::macros::Kernel,
+    lhs: &SparseMatrix,
+    rhs: *const c_void,
+    output: *mut c_void,
+    metadata: &[usize],
+) -> Result<()> {
+    if metadata.len() < 4 {
+        return Err(CpuKernelError::InvalidInput(
+            "sparse_matmul metadata too short".to_string(),
+        ));
+    }
+    check_blocks(lhs.rows, lhs.cols, lhs.block_rows, lhs.block_cols)?;
+    if lhs.row_ptr.is_null() {
+        return Err(CpuKernelError::InvalidInput(
+            "sparse matrix without row_ptr".to_string(),
+        ));
+    }
+
+    unsafe {
+        match kernel_name.0 {
+            "hodu_cpu_sparse_matmul_f32" => hodu_cpu_sparse_matmul_f32(lhs, rhs, output, metadata.as_ptr()),
+            "hodu_cpu_sparse_matmul_f64" => hodu_cpu_sparse_matmul_f64(lhs, rhs, output, metadata.as_ptr()),
+            _ => panic!("Unsupported sparse matmul kernel: {}", kernel_name.0),
+        }
+    }
+
+    Ok(())
+}
+
+fn check_convert_metadata(metadata: &[usize]) -> Result<()> {
+    if metadata.len() < 7 {
+        return Err(CpuKernelError::InvalidInput(
+            "sparse_from_dense metadata too short".to_string(),
+        ));
+    }
+    check_blocks(metadata[0], metadata[1], metadata[5], metadata[6])
+}
+
+/// Number of blocks with a non-zero element, the size of `col_idx` for `call_ops_sparse_from_dense`
+///
+/// # Arguments
+/// * `kernel_name` - The conversion kernel (sparse_from_dense::F32 or sparse_from_dense::F64)
+/// * `dense` - Pointer to the dense matrix
+/// * `metadata` - `[rows, cols, stride_rows, stride_cols, offset, block_rows, block_cols]`
+///
+/// # Returns
+/// Returns an error if the metadata is too short, the blocks do not tile the matrix or
+/// there are more blocks than `u32` offsets can address.
+pub fn call_ops_sparse_count(
+    kernel_name: crate::kernels::macros::Kernel,
+    dense: *const c_void,
+    metadata: &[usize],
+) -> Result<usize> {
+    check_convert_metadata(metadata)?;
+    let count = unsafe {
+        match kernel_name.0 {
+            "hodu_cpu_sparse_from_dense_f32" => hodu_cpu_sparse_count_f32(dense, metadata.as_ptr()),
+            "hodu_cpu_sparse_from_dense_f64" => hodu_cpu_sparse_count_f64(dense, metadata.as_ptr()),
+            _ => panic!("Unsupported sparse conversion kernel: {}", kernel_name.0),
+        }
+    };
+    if count > u32::MAX as usize {
+        return Err(CpuKernelError::InvalidInput(format!(
+            "{} stored blocks exceed u32 offsets",
+            count
+        )));
+    }
+    Ok(count)
+}
+
+/// Convert a dense matrix to BSR (CSR for 1x1 blocks), keeping blocks with a non-zero element
+///
+/// # Arguments
+/// * `kernel_name` - The conversion kernel (sparse_from_dense::F32 or sparse_from_dense::F64)
+/// * `dense` - Pointer to the dense matrix
+/// * `row_ptr` - `rows / block_rows + 1` offsets to fill
+/// * `col_idx` - `call_ops_sparse_count` block columns to fill
+/// * `values` - `call_ops_sparse_count * block_rows * block_cols` values to fill
+/// * `metadata` - `[rows, cols, stride_rows, stride_cols, offset, block_rows, block_cols]`
+///
+/// # Returns
+/// Returns an error if the metadata is too short or the blocks do not tile the matrix.
+pub fn call_ops_sparse_from_dense(
+    kernel_name: crate::kernels::macros::Kernel,
+    dense: *const c_void,
+    row_ptr: *mut u32,
+    col_idx: *mut u32,
+    values: *mut c_void,
+    metadata: &[usize],
+) -> Result<()> {
+    check_convert_metadata(metadata)?;
+    unsafe {
+        match kernel_name.0 {
+            "hodu_cpu_sparse_from_dense_f32" => {
+                hodu_cpu_sparse_from_dense_f32(dense, row_ptr, col_idx, values, metadata.as_ptr())
+            },
+            "hodu_cpu_sparse_from_dense_f64" => {
+                hodu_cpu_sparse_from_dense_f64(dense, row_ptr, col_idx, values, metadata.as_ptr())
+            },
+            _ => panic!("Unsupported sparse conversion kernel: {}", kernel_name.0),
+        }
+    }
+
+    Ok(())
+}
+
+extern "C" {
+    fn hodu_cpu_sparse_matmul_f32(
+        lhs: *const SparseMatrix,
+        rhs: *const c_void,
+        output: *mut c_void,
+        metadata: *const usize,
+    );
+    fn hodu_cpu_sparse_matmul_f64(
+        lhs: *const SparseMatrix,
+        rhs: *const c_void,
+        output: *mut c_void,
+        metadata: *const usize,
+    );
+    fn hodu_cpu_sparse_count_f32(dense: *const c_void, metadata: *const usize) -> usize;
+    fn hodu_cpu_sparse_count_f64(dense: *const c_void, metadata: *const usize) -> usize;
+    fn hodu_cpu_sparse_from_dense_f32(
+        dense: *const c_void,
+        row_ptr: *mut u32,
+        col_idx: *mut u32,
+        values: *mut c_void,
+        metadata: *const usize,
+    );
+    fn hodu_cpu_sparse_from_dense_f64(
+        dense: *const c_void,
+        row_ptr: *mut u32,
+        col_idx: *mut u32,
+        values: *mut c_void,
+        metadata: *const usize,
+    );
+}
@@ -88,6 +88,7 @@ ops!(
 /// - `input` must point to valid tensor data of the appropriate type
 /// - `output` must point to a valid output buffer with sufficient capacity
 /// - Metadata must accurately describe the tensor layout
+/// - `output` may be `input` itself (in place); other overlaps are copied out first
 pub fn call_ops_unary(
     kernel_name: crate::kernels::macros::Kernel,
     input: *const c_void,
@@ -7,7 +7,9 @@
 //! - reduce_window_mean: Mean (average) of values in each window
 //!
 //! These operations apply a reduction function over sliding windows of the input tensor,
-//! with support for configurable window size, stride, and padding.
+//! with support for configurable window size, stride, and padding. Windows are given per
+//! dimension, so channels-last (NHWC) tensors are pooled in place with a `[1, kh, kw, 1]`
+//! window and produce an NHWC output.
 
 use crate::{
     error::Result,
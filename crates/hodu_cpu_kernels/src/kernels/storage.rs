@@ -2,10 +2,19 @@
 //!
 //! This module provides storage-level operations for tensors:
 //! - const_set: Fill tensor with a constant value
+//! - StorageBuffer: Zeroed buffer whose pages are first touched across the pool
 //!
 //! All operations support strided tensor access and multiple data types.
+//!
+//! Pages land on the NUMA node of the thread that first writes them. Contiguous
+//! const_set and StorageBuffer::zeroed write with one equal slice per pool thread,
+//! the split parallel kernels over the same range start from, so on multi-socket
+//! machines each worker mostly reads memory of its own node.
 
-use crate::{error::Result, kernels::macros::ops};
+use crate::{
+    error::{CpuKernelError, Result},
+    kernels::macros::ops,
+};
 use core::ffi::c_void;
 
 // Define const_set operation using the macro
@@ -44,6 +53,73 @@ pub fn call_ops_const_set<T>(
     Ok(())
 }
 
+extern "C" {
+    fn hodu_cpu_storage_alloc(bytes: usize) -> *mut c_void;
+    fn hodu_cpu_storage_free(ptr: *mut c_void, bytes: usize);
+}
+
+/// Zeroed, page-aligned tensor storage placed by parallel first touch
+///
+/// Fresh pages are written by the pool threads with the split of
+/// `parallel_for_static`, so later parallel kernels over the buffer mostly read
+/// pages on their own NUMA node (see `set_affinity` for pinning the workers).
+pub struct StorageBuffer {
+    ptr: *mut c_void,
+    len: usize,
+}
+
+unsafe impl Send for StorageBuffer {}
+unsafe impl Sync for StorageBuffer {}
+
+impl StorageBuffer {
+    /// Allocate `len` zeroed bytes
+    ///
+    /// # Errors
+    /// Returns an error if `len` is 0 or the allocation fails.
+    pub fn zeroed(len: usize) -> Result<Self> {
+        let ptr = unsafe { hodu_cpu_storage_alloc(len) };
+        if ptr.is_null() {
+            return Err(CpuKernelError::InvalidInput(format!(
+                "cannot allocate {} bytes of storage",
+                len
+            )));
+        }
+        Ok(Self { ptr, len })
+    }
+
+    /// Size in bytes
+    pub fn len(&self) -> usize {
+        self.len
+    }
+
+    /// Always false: empty buffers cannot be allocated
+    pub fn is_empty(&self) -> bool {
+        self.len == 0
+    }
+
+    pub fn as_ptr(&self) -> *const c_void {
+        self.ptr
+    }
+
+    pub fn as_mut_ptr(&mut self) -> *mut c_void {
+        self.ptr
+    }
+
+    pub fn as_bytes(&self) -> &[u8] {
+        unsafe { core::slice::from_raw_parts(self.ptr as *const u8, self.len) }
+    }
+
+    pub fn as_bytes_mut(&mut self) -> &mut [u8] {
+        unsafe { core::slice::from_raw_parts_mut(self.ptr as *mut u8, self.len) }
+    }
+}
+
+impl Drop for StorageBuffer {
+    fn drop(&mut self) {
+        unsafe { hodu_cpu_storage_free(self.ptr, self.len) }
+    }
+}
+
 // Macro to automatically generate extern declarations and dispatch for const_set operation
 macro_rules! declare_and_dispatch_const_set {
     ($($type_suffix:ident),* $(,)?) => {
@@ -3,13 +3,30 @@
 //! High-performance CPU kernels for tensor operations with support for
 //! exotic floating-point formats and comprehensive integer types.
 
+// jit_symbols declares every kernel as `fn()` only to take its address
+#![allow(clashing_extern_declarations)]
+
 /// Path to the C kernel source files directory.
 /// Useful for AOT compilation backends that need to compile kernels.
 pub const KERNELS_DIR: &str = concat!(env!("CARGO_MANIFEST_DIR"), "/kernels");
 
+pub mod cpu_features;
 mod error;
 pub mod jit_symbols;
 mod kernels;
+pub mod profile;
+pub mod queue;
+pub mod threading;
+pub mod tuning;
+pub mod weights;
+pub mod workspace;
 
+pub use cpu_features::cpu_isa;
 pub use error::{CpuKernelError, Result};
 pub use kernels::*;
+pub use profile::{profile_enabled, profile_snapshot, reset_profile, start_trace, stop_trace, KernelProfile};
+pub use queue::{submit, submit_unchecked, wait_all, Task};
+pub use threading::{deterministic, num_threads, set_affinity, set_deterministic, set_num_threads};
+pub use tuning::{calibrate_tuning, load_tuning, save_tuning, set_tuning, tuning, Tuning};
+pub use weights::{PackedWeight, PackedWeights, PackedWeightsWriter, WeightKind, WEIGHT_NAME_MAX};
+pub use workspace::{trim_workspace, with_workspace};
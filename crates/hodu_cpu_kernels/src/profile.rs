@@ -0,0 +1,141 @@
+//! Per-kernel profiling
+//!
+//! Builds with `HODU_ENABLE_PROFILE` set count, for every kernel called:
+//! - profile_snapshot: Calls, wall time, bytes moved, code paths and threads
+//! - reset_profile: Zero the counters
+//! - start_trace / stop_trace: Write every call as a Chrome trace event
+//!   (chrome://tracing, Perfetto)
+//!
+//! Other builds compile the recording out: snapshots are empty and tracing
+//! fails. Times of kernels that call other kernels include the nested calls.
+
+use crate::error::{CpuKernelError, Result};
+use core::ffi::{c_char, CStr};
+use std::ffi::CString;
+
+/// Path bits of `hodu_cpu_profile_stats_t::path_calls` (profile.h)
+const NUM_PATHS: usize = 4;
+
+#[repr(C)]
+#[derive(Clone, Copy)]
+struct RawStats {
+    name: *const c_char,
+    calls: u64,
+    total_ns: u64,
+    max_ns: u64,
+    bytes: u64,
+    max_threads: u64,
+    path_calls: [u64; NUM_PATHS],
+}
+
+extern "C" {
+    fn hodu_cpu_profile_enabled() -> i32;
+    fn hodu_cpu_profile_snapshot(out: *mut RawStats, capacity: usize) -> usize;
+    fn hodu_cpu_profile_reset();
+    fn hodu_cpu_profile_trace_begin(path: *const c_char) -> i32;
+    fn hodu_cpu_profile_trace_end();
+}
+
+/// Counters of one kernel since the last reset
+#[derive(Debug, Clone, PartialEq, Eq)]
+pub struct KernelProfile {
+    /// Symbol name, e.g. "hodu_cpu_add_f32"
+    pub name: String,
+    /// Completed calls
+    pub calls: u64,
+    /// Wall time summed over calls, in nanoseconds
+    pub total_ns: u64,
+    /// Slowest call, in nanoseconds
+    pub max_ns: u64,
+    /// Bytes read and written over all calls (main tensors only)
+    pub bytes: u64,
+    /// Most threads one call ran on
+    pub max_threads: u64,
+    /// Calls without a SIMD or BLAS path
+    pub scalar_calls: u64,
+    /// Calls that ran a vectorized loop or SIMD micro-kernel
+    pub simd_calls: u64,
+    /// Calls that went to BLAS / LAPACK
+    pub blas_calls: u64,
+    /// Calls split across more than one thread
+    pub threaded_calls: u64,
+}
+
+impl KernelProfile {
+    /// Achieved bandwidth over all calls, in GB/s
+    pub fn bandwidth_gbs(&self) -> f64 {
+        if self.total_ns == 0 {
+            0.0
+        } else {
+            self.bytes as f64 / self.total_ns as f64
+        }
+    }
+}
+
+/// Whether the library was built with profiling (`HODU_ENABLE_PROFILE`)
+pub fn profile_enabled() -> bool {
+    unsafe { hodu_cpu_profile_enabled() != 0 }
+}
+
+/// Counters of every kernel called since the last reset, most total time first
+pub fn profile_snapshot() -> Vec<KernelProfile> {
+    let mut raw: Vec<RawStats> = Vec::new();
+    loop {
+        let count = unsafe { hodu_cpu_profile_snapshot(raw.as_mut_ptr(), raw.capacity()) };
+        if count <= raw.capacity() {
+            unsafe { raw.set_len(count) };
+            break;
+        }
+        // Kernels called for the first time since counting; ask again
+        raw.reserve(count + 16);
+    }
+
+    raw.iter()
+        .map(|s| KernelProfile {
+            name: unsafe { CStr::from_ptr(s.name) }.to_string_lossy().into_owned(),
+            calls: s.calls,
+            total_ns: s.total_ns,
+            max_ns: s.max_ns,
+            bytes: s.bytes,
+            max_threads: s.max_threads,
+            scalar_calls: s.path_calls[0],
+            simd_calls: s.path_calls[1],
+            blas_calls: s.path_calls[2],
+            threaded_calls: s.path_calls[3],
+        })
+        .collect()
+}
+
+/// Zero the counters of all kernels
+pub fn reset_profile() {
+    unsafe { hodu_cpu_profile_reset() }
+}
+
+/// Start writing a Chrome trace of every kernel call to `path`
+///
+/// An open trace is finished first. The file is complete once [`stop_trace`]
+/// returns.
+///
+/// # Errors
+/// Returns an error if profiling is compiled out or the file cannot be created.
+pub fn start_trace(path: &str) -> Result<()> {
+    let c_path = CString::new(path).map_err(|_| CpuKernelError::InvalidInput(format!("trace path {:?}", path)))?;
+    if !profile_enabled() {
+        return Err(CpuKernelError::Message(
+            "profiling is disabled (build with HODU_ENABLE_PROFILE)".to_string(),
+        ));
+    }
+    if unsafe { hodu_cpu_profile_trace_begin(c_path.as_ptr()) } != 0 {
+        return Err(CpuKernelError::InvalidInput(format!(
+            "cannot create trace file {:?}",
+            path
+        )));
+    }
+
+    Ok(())
+}
+
+/// Finish and close the trace started by [`start_trace`]
+pub fn stop_trace() {
+    unsafe { hodu_cpu_profile_trace_end() }
+}
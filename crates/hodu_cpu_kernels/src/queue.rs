@@ -0,0 +1,132 @@
+//! Asynchronous kernel submission
+//!
+//! Kernel calls block until their parallel work is joined. The task queue runs
+//! closures (typically one or a few kernel calls) on a few executor threads
+//! instead, so independent branches of a graph overlap on the cores:
+//! - submit / submit_unchecked: Enqueue a closure after the tasks it depends on
+//! - Task::is_done / Task::wait: Poll or block on a completion handle
+//! - wait_all: Block until everything submitted so far has finished
+//!
+//! Executors start on the first submission, with up to 4 threads (at most
+//! [`num_threads`](crate::num_threads)). With a single thread, tasks run on the
+//! submitting thread before `submit` returns.
+
+use crate::error::{CpuKernelError, Result};
+use core::ffi::c_void;
+use std::any::Any;
+use std::panic::{self, AssertUnwindSafe};
+use std::sync::{Arc, Mutex};
+
+#[repr(C)]
+struct RawTask {
+    _private: [u8; 0],
+}
+
+extern "C" {
+    fn hodu_cpu_task_submit(
+        f: unsafe extern "C" fn(*mut c_void),
+        ctx: *mut c_void,
+        deps: *const *mut RawTask,
+        num_deps: usize,
+    ) -> *mut RawTask;
+    fn hodu_cpu_task_poll(task: *const RawTask) -> i32;
+    fn hodu_cpu_task_wait(task: *mut RawTask);
+    fn hodu_cpu_task_wait_all();
+    fn hodu_cpu_task_release(task: *mut RawTask);
+}
+
+type PanicSlot = Arc<Mutex<Option<Box<dyn Any + Send>>>>;
+
+/// Completion handle of a submitted task
+///
+/// Dropping the handle does not cancel the task.
+pub struct Task {
+    raw: *mut RawTask,
+    panic: PanicSlot,
+}
+
+// The C handle is reference counted under the queue lock
+unsafe impl Send for Task {}
+unsafe impl Sync for Task {}
+
+impl Task {
+    /// Whether the task has finished (never blocks)
+    pub fn is_done(&self) -> bool {
+        unsafe { hodu_cpu_task_poll(self.raw) != 0 }
+    }
+
+    /// Block until the task has finished
+    ///
+    /// The calling thread runs other ready tasks in the meantime. If the task
+    /// panicked, the panic is resumed here (once).
+    pub fn wait(&self) {
+        unsafe { hodu_cpu_task_wait(self.raw) };
+        let payload = self.panic.lock().unwrap_or_else(|e| e.into_inner()).take();
+        if let Some(payload) = payload {
+            panic::resume_unwind(payload);
+        }
+    }
+}
+
+impl Drop for Task {
+    fn drop(&mut self) {
+        unsafe { hodu_cpu_task_release(self.raw) }
+    }
+}
+
+struct Job<F> {
+    f: F,
+    panic: PanicSlot,
+}
+
+unsafe extern "C" fn run_job<F: FnOnce()>(ctx: *mut c_void) {
+    let job = Box::from_raw(ctx as *mut Job<F>);
+    let Job { f, panic: slot } = *job;
+    if let Err(payload) = panic::catch_unwind(AssertUnwindSafe(f)) {
+        *slot.lock().unwrap_or_else(|e| e.into_inner()) = Some(payload);
+    }
+}
+
+/// Run `f` once every task in `deps` has finished
+///
+/// Tasks without pending dependencies start in submission order and run
+/// concurrently with each other. A panic in `f` is kept for [`Task::wait`];
+/// dependents still run.
+///
+/// # Errors
+/// Returns an error if the task cannot be allocated; `f` is then dropped.
+pub fn submit<F>(deps: &[&Task], f: F) -> Result<Task>
+where
+    F: FnOnce() + Send + 'static,
+{
+    unsafe { submit_unchecked(deps, f) }
+}
+
+/// [`submit`] for closures that capture raw kernel buffers
+///
+/// # Safety
+/// Everything `f` captures must be usable from another thread and stay valid
+/// until the task has finished (e.g. until [`Task::wait`] returns).
+pub unsafe fn submit_unchecked<F: FnOnce()>(deps: &[&Task], f: F) -> Result<Task> {
+    let panic_slot: PanicSlot = Arc::new(Mutex::new(None));
+    let job = Box::into_raw(Box::new(Job {
+        f,
+        panic: panic_slot.clone(),
+    }));
+    let raw_deps: Vec<*mut RawTask> = deps.iter().map(|task| task.raw).collect();
+
+    let raw = hodu_cpu_task_submit(run_job::<F>, job as *mut c_void, raw_deps.as_ptr(), raw_deps.len());
+    if raw.is_null() {
+        drop(Box::from_raw(job));
+        return Err(CpuKernelError::Message("cannot allocate task".to_string()));
+    }
+
+    Ok(Task { raw, panic: panic_slot })
+}
+
+/// Block until every task submitted so far has finished
+///
+/// Panics of the tasks are not resumed; use [`Task::wait`] for that.
+pub fn wait_all() {
+    unsafe { hodu_cpu_task_wait_all() }
+}
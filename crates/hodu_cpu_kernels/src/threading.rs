@@ -0,0 +1,77 @@
+//! Thread pool configuration
+//!
+//! Runtime control over the worker pool used by parallel kernels:
+//! - num_threads / set_num_threads: Pool size (0 restores the detected default)
+//! - set_affinity: Pin pool workers to a set of CPUs
+//! - deterministic / set_deterministic: Fixed split of sums that run across threads
+//!
+//! The default thread count is read once from `HODU_NUM_THREADS`, or detected from
+//! the online CPUs clamped to the process cpuset and cgroup CPU quota.
+//! Changes take effect on the next parallel kernel.
+
+use crate::error::{CpuKernelError, Result};
+
+extern "C" {
+    fn hodu_cpu_get_num_threads() -> usize;
+    fn hodu_cpu_set_num_threads(num_threads: usize);
+    fn hodu_cpu_set_affinity_mask(mask: *const u64, num_words: usize) -> i32;
+    fn hodu_cpu_get_deterministic() -> i32;
+    fn hodu_cpu_set_deterministic(enabled: i32);
+}
+
+/// Number of threads (including the caller) that parallel kernels use
+pub fn num_threads() -> usize {
+    unsafe { hodu_cpu_get_num_threads() }
+}
+
+/// Set the number of threads for parallel kernels
+///
+/// Passing 0 restores the detected default.
+pub fn set_num_threads(num_threads: usize) {
+    unsafe { hodu_cpu_set_num_threads(num_threads) }
+}
+
+/// Pin pool workers to the given CPU indices
+///
+/// Worker k runs on `cpus[(k + 1) % cpus.len()]`; the first CPU is meant for the
+/// calling thread, which is not pinned. Unless a thread count is set, the pool
+/// uses one thread per CPU. An empty slice removes the restriction.
+///
+/// # Errors
+/// Returns an error if CPU affinity is unsupported on this platform or a CPU
+/// index is out of range.
+pub fn set_affinity(cpus: &[usize]) -> Result<()> {
+    let num_words = cpus.iter().max().map_or(0, |&cpu| cpu / 64 + 1);
+    let mut mask = vec![0u64; num_words];
+    for &cpu in cpus {
+        mask[cpu / 64] |= 1u64 << (cpu % 64);
+    }
+
+    let status = unsafe { hodu_cpu_set_affinity_mask(mask.as_ptr(), mask.len()) };
+    if status != 0 {
+        return Err(CpuKernelError::InvalidInput(format!(
+            "cannot set CPU affinity to {:?}",
+            cpus
+        )));
+    }
+
+    Ok(())
+}
+
+/// Whether deterministic mode is on
+pub fn deterministic() -> bool {
+    unsafe { hodu_cpu_get_deterministic() != 0 }
+}
+
+/// Size split sums by a fixed thread count instead of the pool
+///
+/// Covers the kernels that split a sum across threads: reductions with few
+/// outputs and a long reduced extent, the native `conv2d_grad_weight` batch
+/// split and the KV-cache split of attention decode. Their blocking and merge
+/// order then only depend on the shape, so they give bit-identical results
+/// for any thread count. Native matmul never splits the summed dimension and
+/// is unaffected; BLAS backends keep their own threading. Off by default
+/// unless `HODU_DETERMINISTIC=1` is set.
+pub fn set_deterministic(enabled: bool) {
+    unsafe { hodu_cpu_set_deterministic(enabled as i32) }
+}
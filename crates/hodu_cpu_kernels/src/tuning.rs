@@ -0,0 +1,130 @@
+//! Parallel task sizing
+//!
+//! Kernels size their parallel tasks from a cost model: a target task duration
+//! and a single-thread cost per unit of work for each op class.
+//! - tuning / set_tuning: Read or replace the parameters
+//! - calibrate_tuning: Re-run the micro-benchmarks that set them
+//! - load_tuning / save_tuning: Keep them in a `key value` text file
+//!
+//! Parameters are initialized on first use from the file named by
+//! `HODU_TUNING_FILE`, else by a calibration run (about a millisecond) unless
+//! `HODU_AUTOTUNE=0` keeps the built-in defaults. Task sizes only change how
+//! work is split across threads, never the results.
+
+use crate::error::{CpuKernelError, Result};
+use core::ffi::c_char;
+use std::ffi::CString;
+
+/// Op classes of `hodu_cpu_cost_class_t` (tuning.h)
+const NUM_CLASSES: usize = 4;
+
+#[repr(C)]
+#[derive(Clone, Copy, Default)]
+struct RawTuning {
+    task_ns: f64,
+    ns_per_unit: [f64; NUM_CLASSES],
+}
+
+extern "C" {
+    fn hodu_cpu_tuning_get(out: *mut RawTuning);
+    fn hodu_cpu_tuning_set(tuning: *const RawTuning);
+    fn hodu_cpu_tuning_calibrate() -> i32;
+    fn hodu_cpu_tuning_load(path: *const c_char) -> i32;
+    fn hodu_cpu_tuning_save(path: *const c_char) -> i32;
+}
+
+/// Cost model parameters, in nanoseconds
+///
+/// Values <= 0 passed to [`set_tuning`] keep the current ones.
+#[derive(Debug, Clone, Copy, PartialEq)]
+pub struct Tuning {
+    /// Target duration of the smallest parallel task (clamped to 2 us ..= 500 us)
+    pub task_ns: f64,
+    /// Cost of one byte copied (copies, fills, casts, gathers, padding)
+    pub copy_ns_per_byte: f64,
+    /// Cost of one element of a cheap arithmetic or logical op
+    pub elementwise_ns: f64,
+    /// Cost of one element of an exp/log/erf/tanh-class op
+    pub transcendental_ns: f64,
+    /// Cost of one multiply-add of the scalar matmul/dot loops
+    pub fma_ns: f64,
+}
+
+impl From<RawTuning> for Tuning {
+    fn from(raw: RawTuning) -> Self {
+        Tuning {
+            task_ns: raw.task_ns,
+            copy_ns_per_byte: raw.ns_per_unit[0],
+            elementwise_ns: raw.ns_per_unit[1],
+            transcendental_ns: raw.ns_per_unit[2],
+            fma_ns: raw.ns_per_unit[3],
+        }
+    }
+}
+
+fn c_path(path: &str) -> Result<CString> {
+    CString::new(path).map_err(|_| CpuKernelError::InvalidInput(format!("tuning path {:?}", path)))
+}
+
+/// Current cost model parameters
+pub fn tuning() -> Tuning {
+    let mut raw = RawTuning::default();
+    unsafe { hodu_cpu_tuning_get(&mut raw) };
+    raw.into()
+}
+
+/// Replace the cost model parameters; takes effect on the next parallel kernel
+pub fn set_tuning(tuning: &Tuning) {
+    let raw = RawTuning {
+        task_ns: tuning.task_ns,
+        ns_per_unit: [
+            tuning.copy_ns_per_byte,
+            tuning.elementwise_ns,
+            tuning.transcendental_ns,
+            tuning.fma_ns,
+        ],
+    };
+    unsafe { hodu_cpu_tuning_set(&raw) }
+}
+
+/// Run the micro-benchmarks now and use their results
+///
+/// Returns false if pool dispatch could not be measured (a single thread, or
+/// a call from inside a parallel kernel); the op class costs are updated anyway.
+pub fn calibrate_tuning() -> bool {
+    unsafe { hodu_cpu_tuning_calibrate() == 0 }
+}
+
+/// Load parameters from a file written by [`save_tuning`]
+///
+/// Missing keys keep their current values.
+///
+/// # Errors
+/// Returns an error if the file cannot be read.
+pub fn load_tuning(path: &str) -> Result<()> {
+    let c_path = c_path(path)?;
+    if unsafe { hodu_cpu_tuning_load(c_path.as_ptr()) } != 0 {
+        return Err(CpuKernelError::InvalidInput(format!(
+            "cannot read tuning file {:?}",
+            path
+        )));
+    }
+
+    Ok(())
+}
+
+/// Write the current parameters to `path`
+///
+/// # Errors
+/// Returns an error if the file cannot be written.
+pub fn save_tuning(path: &str) -> Result<()> {
+    let c_path = c_path(path)?;
+    if unsafe { hodu_cpu_tuning_save(c_path.as_ptr()) } != 0 {
+        return Err(CpuKernelError::InvalidInput(format!(
+            "cannot write tuning file {:?}",
+            path
+        )));
+    }
+
+    Ok(())
+}
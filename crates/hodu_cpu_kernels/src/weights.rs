@@ -0,0 +1,313 @@
+//! Pre-packed weight files
+//!
+//! Constant matmul/conv2d weights stored already packed into the blocked GEMM
+//! layout, mapped read-only and passed straight to the packed kernels:
+//! - PackedWeightsWriter: Pack weights once and write them to a file
+//! - PackedWeights: Map a file and look up weights by name
+//!
+//! Loading does no parsing, copying or packing, and processes mapping the same
+//! file share its page cache. The packed layout depends on the GEMM blocking of
+//! the build; files from a build with a different layout fail to open and must
+//! be regenerated.
+
+use crate::error::{CpuKernelError, Result};
+use crate::kernels::macros::Kernel;
+use core::ffi::{c_char, c_void};
+use std::ffi::CString;
+use std::marker::PhantomData;
+
+/// Longest weight name in bytes, excluding the terminating NUL
+pub const WEIGHT_NAME_MAX: usize = 63;
+
+#[repr(C)]
+struct RawWriter {
+    _private: [u8; 0],
+}
+
+#[repr(C)]
+struct RawWeights {
+    _private: [u8; 0],
+}
+
+/// Mirrors `hodu_cpu_weights_entry_t` (weights.h)
+#[repr(C)]
+struct RawEntry {
+    name: [u8; WEIGHT_NAME_MAX + 1],
+    kind: u32,
+    reserved: u32,
+    dims: [u64; 4],
+    offset: u64,
+    bytes: u64,
+}
+
+extern "C" {
+    fn hodu_cpu_weights_create(path: *const c_char) -> *mut RawWriter;
+    fn hodu_cpu_weights_add_matmul_rhs_f32(
+        writer: *mut RawWriter,
+        name: *const c_char,
+        rhs: *const c_void,
+        metadata: *const usize,
+    ) -> i32;
+    fn hodu_cpu_weights_add_matmul_rhs_f64(
+        writer: *mut RawWriter,
+        name: *const c_char,
+        rhs: *const c_void,
+        metadata: *const usize,
+    ) -> i32;
+    fn hodu_cpu_weights_add_conv2d_f32(
+        writer: *mut RawWriter,
+        name: *const c_char,
+        weight: *const c_void,
+        metadata: *const usize,
+    ) -> i32;
+    fn hodu_cpu_weights_add_conv2d_f64(
+        writer: *mut RawWriter,
+        name: *const c_char,
+        weight: *const c_void,
+        metadata: *const usize,
+    ) -> i32;
+    fn hodu_cpu_weights_finish(writer: *mut RawWriter) -> i32;
+
+    fn hodu_cpu_weights_open(path: *const c_char) -> *mut RawWeights;
+    fn hodu_cpu_weights_count(weights: *const RawWeights) -> usize;
+    fn hodu_cpu_weights_entry(weights: *const RawWeights, index: usize) -> *const RawEntry;
+    fn hodu_cpu_weights_find(weights: *const RawWeights, name: *const c_char) -> *const RawEntry;
+    fn hodu_cpu_weights_data(weights: *const RawWeights, entry: *const RawEntry) -> *const c_void;
+    fn hodu_cpu_weights_close(weights: *mut RawWeights);
+}
+
+/// What a packed weight is, and the kernel that consumes it
+#[derive(Debug, Clone, Copy, PartialEq, Eq)]
+pub enum WeightKind {
+    /// `matmul_packed::F32` rhs, dims `[k, n, 0, 0]`
+    MatmulRhsF32,
+    /// `matmul_packed::F64` rhs, dims `[k, n, 0, 0]`
+    MatmulRhsF64,
+    /// `conv2d_packed::F32` weight, dims `[out_channels, in_channels, kernel_h, kernel_w]`
+    Conv2dF32,
+    /// `conv2d_packed::F64` weight, dims `[out_channels, in_channels, kernel_h, kernel_w]`
+    Conv2dF64,
+}
+
+impl WeightKind {
+    fn from_raw(kind: u32) -> Self {
+        match kind {
+            0 => WeightKind::MatmulRhsF32,
+            1 => WeightKind::MatmulRhsF64,
+            2 => WeightKind::Conv2dF32,
+            _ => WeightKind::Conv2dF64,
+        }
+    }
+}
+
+fn c_string(what: &str, value: &str) -> Result<CString> {
+    CString::new(value).map_err(|_| CpuKernelError::InvalidInput(format!("{} {:?}", what, value)))
+}
+
+/// Writes weights packed for this build to a file
+///
+/// Dropping the writer without [`finish`](Self::finish) still closes the file.
+pub struct PackedWeightsWriter {
+    raw: *mut RawWriter,
+    path: String,
+}
+
+impl PackedWeightsWriter {
+    /// Create (or truncate) a weight file
+    pub fn create(path: &str) -> Result<Self> {
+        let c_path = c_string("weight file path", path)?;
+        let raw = unsafe { hodu_cpu_weights_create(c_path.as_ptr()) };
+        if raw.is_null() {
+            return Err(CpuKernelError::InvalidInput(format!(
+                "cannot create weight file {:?}",
+                path
+            )));
+        }
+        Ok(Self {
+            raw,
+            path: path.to_string(),
+        })
+    }
+
+    /// Pack a constant matmul rhs and append it
+    ///
+    /// # Arguments
+    /// * `kernel_name` - The packed matmul kernel (matmul_packed::F32 or matmul_packed::F64)
+    /// * `name` - Unique name, at most [`WEIGHT_NAME_MAX`] bytes
+    /// * `rhs` - Pointer to the rhs matrix
+    /// * `metadata` - `[k, n, rhs_stride_k, rhs_stride_n, rhs_offset]`, as for `call_ops_matmul_pack_rhs`
+    pub fn add_matmul_rhs(
+        &mut self,
+        kernel_name: Kernel,
+        name: &str,
+        rhs: *const c_void,
+        metadata: &[usize],
+    ) -> Result<()> {
+        if metadata.len() < 5 {
+            return Err(CpuKernelError::InvalidInput("pack metadata too short".to_string()));
+        }
+        let c_name = c_string("weight name", name)?;
+        let status = unsafe {
+            match kernel_name.0 {
+                "hodu_cpu_matmul_packed_f32" => {
+                    hodu_cpu_weights_add_matmul_rhs_f32(self.raw, c_name.as_ptr(), rhs, metadata.as_ptr())
+                },
+                "hodu_cpu_matmul_packed_f64" => {
+                    hodu_cpu_weights_add_matmul_rhs_f64(self.raw, c_name.as_ptr(), rhs, metadata.as_ptr())
+                },
+                _ => panic!("Unsupported packed matmul kernel: {}", kernel_name.0),
+            }
+        };
+        self.check(status, name)
+    }
+
+    /// Pack a constant conv2d weight and append it
+    ///
+    /// # Arguments
+    /// * `kernel_name` - The packed conv kernel (conv2d_packed::F32 or conv2d_packed::F64)
+    /// * `name` - Unique name, at most [`WEIGHT_NAME_MAX`] bytes
+    /// * `weight` - Pointer to the `[out_channels, in_channels, kernel_h, kernel_w]` weight
+    /// * `metadata` - conv2d metadata, as for `call_ops_conv2d_pack_weight`
+    pub fn add_conv2d(
+        &mut self,
+        kernel_name: Kernel,
+        name: &str,
+        weight: *const c_void,
+        metadata: &[usize],
+    ) -> Result<()> {
+        if metadata.len() < 18 {
+            return Err(CpuKernelError::InvalidInput("conv2d metadata too short".to_string()));
+        }
+        let c_name = c_string("weight name", name)?;
+        let status = unsafe {
+            match kernel_name.0 {
+                "hodu_cpu_conv2d_packed_f32" => {
+                    hodu_cpu_weights_add_conv2d_f32(self.raw, c_name.as_ptr(), weight, metadata.as_ptr())
+                },
+                "hodu_cpu_conv2d_packed_f64" => {
+                    hodu_cpu_weights_add_conv2d_f64(self.raw, c_name.as_ptr(), weight, metadata.as_ptr())
+                },
+                _ => panic!("Unsupported packed conv kernel: {}", kernel_name.0),
+            }
+        };
+        self.check(status, name)
+    }
+
+    /// Write the entry table and close the file
+    pub fn finish(mut self) -> Result<()> {
+        let raw = core::mem::replace(&mut self.raw, core::ptr::null_mut());
+        if unsafe { hodu_cpu_weights_finish(raw) } != 0 {
+            return Err(CpuKernelError::InvalidInput(format!(
+                "cannot write weight file {:?}",
+                self.path
+            )));
+        }
+        Ok(())
+    }
+
+    fn check(&self, status: i32, name: &str) -> Result<()> {
+        if status != 0 {
+            return Err(CpuKernelError::InvalidInput(format!(
+                "cannot add weight {:?} to {:?} (duplicate or too long name, or write error)",
+                name, self.path
+            )));
+        }
+        Ok(())
+    }
+}
+
+impl Drop for PackedWeightsWriter {
+    fn drop(&mut self) {
+        if !self.raw.is_null() {
+            unsafe { hodu_cpu_weights_finish(self.raw) };
+        }
+    }
+}
+
+/// A read-only mapped weight file
+pub struct PackedWeights {
+    raw: *mut RawWeights,
+}
+
+// The mapping is read-only and never changes while open
+unsafe impl Send for PackedWeights {}
+unsafe impl Sync for PackedWeights {}
+
+/// One packed weight of a [`PackedWeights`] file
+#[derive(Debug, Clone, Copy)]
+pub struct PackedWeight<'a> {
+    pub name: &'a str,
+    pub kind: WeightKind,
+    pub dims: [usize; 4],
+    /// Packed size in bytes
+    pub bytes: usize,
+    data: *const c_void,
+    _file: PhantomData<&'a PackedWeights>,
+}
+
+impl PackedWeight<'_> {
+    /// Packed data, for `call_ops_matmul_packed` / `call_ops_conv2d_packed`
+    pub fn as_ptr(&self) -> *const c_void {
+        self.data
+    }
+}
+
+impl PackedWeights {
+    /// Map a weight file
+    ///
+    /// # Errors
+    /// Returns an error if the file cannot be read, is malformed or truncated, or
+    /// was packed with a different layout than this build uses.
+    pub fn open(path: &str) -> Result<Self> {
+        let c_path = c_string("weight file path", path)?;
+        let raw = unsafe { hodu_cpu_weights_open(c_path.as_ptr()) };
+        if raw.is_null() {
+            return Err(CpuKernelError::InvalidInput(format!(
+                "cannot open weight file {:?} (missing, malformed or packed for another build)",
+                path
+            )));
+        }
+        Ok(Self { raw })
+    }
+
+    /// Number of weights
+    pub fn len(&self) -> usize {
+        unsafe { hodu_cpu_weights_count(self.raw) }
+    }
+
+    pub fn is_empty(&self) -> bool {
+        self.len() == 0
+    }
+
+    /// Weight `index` in file order
+    pub fn entry(&self, index: usize) -> Option<PackedWeight<'_>> {
+        let entry = unsafe { hodu_cpu_weights_entry(self.raw, index) };
+        self.weight(entry)
+    }
+
+    /// Weight named `name`
+    pub fn get(&self, name: &str) -> Option<PackedWeight<'_>> {
+        let c_name = CString::new(name).ok()?;
+        let entry = unsafe { hodu_cpu_weights_find(self.raw, c_name.as_ptr()) };
+        self.weight(entry)
+    }
+
+    fn weight(&self, entry: *const RawEntry) -> Option<PackedWeight<'_>> {
+        let raw = unsafe { entry.as_ref()? };
+        let len = raw.name.iter().position(|&c| c == 0).unwrap_or(raw.name.len());
+        Some(PackedWeight {
+            name: core::str::from_utf8(&raw.name[..len]).unwrap_or(""),
+            kind: WeightKind::from_raw(raw.kind),
+            dims: raw.dims.map(|d| d as usize),
+            bytes: raw.bytes as usize,
+            data: unsafe { hodu_cpu_weights_data(self.raw, entry) },
+            _file: PhantomData,
+        })
+    }
+}
+
+impl Drop for PackedWeights {
+    fn drop(&mut self) {
+        unsafe { hodu_cpu_weights_close(self.raw) }
+    }
+}
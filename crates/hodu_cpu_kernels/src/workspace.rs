@@ -0,0 +1,64 @@
+//! Scratch workspace control
+//!
+//! Kernels take temporary buffers (im2col columns, packed weights, sort and LU
+//! scratch) from a per-thread arena instead of allocating on every call:
+//! - trim_workspace: Free the calling thread's default arena
+//! - with_workspace: Run kernels on the calling thread against a caller buffer
+//!
+//! The default arena grows to the largest request seen on a thread and is then
+//! reused. Per-op size queries (e.g. `conv2d_workspace_size`) give the bytes a
+//! single call needs.
+
+use core::ffi::c_void;
+
+#[repr(C)]
+struct RawWorkspace {
+    data: *mut c_void,
+    capacity: usize,
+    used: usize,
+    peak: usize,
+    allocation: *mut c_void,
+}
+
+extern "C" {
+    fn hodu_cpu_workspace_init(ws: *mut RawWorkspace, buffer: *mut c_void, bytes: usize);
+    fn hodu_cpu_workspace_bind(ws: *mut RawWorkspace) -> *mut RawWorkspace;
+    fn hodu_cpu_workspace_trim();
+}
+
+/// Free the calling thread's default scratch arena
+///
+/// The arena is reallocated on the next kernel call that needs scratch memory.
+pub fn trim_workspace() {
+    unsafe { hodu_cpu_workspace_trim() }
+}
+
+/// Run `f` with `buffer` as the scratch workspace of kernels called on this thread
+///
+/// Returns the result of `f` and the peak scratch bytes requested. Requests that
+/// do not fit in `buffer` fall back to a heap allocation for that call, so a peak
+/// above `buffer.len()` means the buffer was too small. Parallel kernels still
+/// use the pool workers' own arenas for per-task scratch.
+pub fn with_workspace<R>(buffer: &mut [u8], f: impl FnOnce() -> R) -> (R, usize) {
+    let mut ws = RawWorkspace {
+        data: core::ptr::null_mut(),
+        capacity: 0,
+        used: 0,
+        peak: 0,
+        allocation: core::ptr::null_mut(),
+    };
+
+    struct Restore(*mut RawWorkspace);
+    impl Drop for Restore {
+        fn drop(&mut self) {
+            unsafe { hodu_cpu_workspace_bind(self.0) };
+        }
+    }
+
+    let result = unsafe {
+        hodu_cpu_workspace_init(&mut ws, buffer.as_mut_ptr() as *mut c_void, buffer.len());
+        let _restore = Restore(hodu_cpu_workspace_bind(&mut ws));
+        f()
+    };
+    (result, ws.peak)
+}
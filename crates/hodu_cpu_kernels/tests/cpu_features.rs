@@ -0,0 +1,11 @@
+use hodu_cpu_kernels::*;
+
+#[test]
+fn test_cpu_isa_is_known_and_cached() {
+    let isa = cpu_isa();
+    assert!(["baseline", "avx2", "avx512"].contains(&isa), "unexpected ISA {}", isa);
+    assert_eq!(cpu_isa(), isa);
+
+    #[cfg(not(target_arch = "x86_64"))]
+    assert_eq!(isa, "baseline");
+}
@@ -0,0 +1,39 @@
+use hodu_cpu_kernels::jit_symbols::{get_kernel_ptr, kernel_info, kernels};
+use hodu_cpu_kernels::*;
+
+#[test]
+fn test_jit_symbols_resolve_every_kernel() {
+    for kernel in kernels() {
+        let info = kernel_info(kernel.name).unwrap();
+        assert!(core::ptr::eq(info, kernel), "{}", kernel.name);
+        assert!(!kernel.ptr().is_null());
+    }
+    for kernel in [add::F32, relu::F16, sum::BF16, matmul::F64, argsort::I32] {
+        assert!(get_kernel_ptr(kernel.0).is_some(), "{}", kernel.0);
+    }
+    assert!(get_kernel_ptr(cast::from_f32::TO_BF16.0).is_some());
+    for name in ["", "hodu_cpu_", "hodu_cpu_add_f33", "hodu_cpu_add_f32_", "add_f32"] {
+        assert!(kernel_info(name).is_none(), "{}", name);
+    }
+}
+
+#[test]
+fn test_jit_symbols_metadata() {
+    let add = kernel_info("hodu_cpu_add_f32").unwrap();
+    assert_eq!((add.category, add.dtypes, add.in_place), ("binary", &["f32"][..], true));
+
+    let eq = kernel_info("hodu_cpu_eq_f32").unwrap();
+    assert!(!eq.in_place, "bool output is narrower than f32");
+
+    let cast = kernel_info("hodu_cpu_cast_f32_to_i32").unwrap();
+    assert_eq!(
+        (cast.category, cast.dtypes, cast.in_place),
+        ("cast", &["f32", "i32"][..], true)
+    );
+    assert!(!kernel_info("hodu_cpu_cast_f32_to_f64").unwrap().in_place);
+
+    assert!(kernel_info("hodu_cpu_scatter_add_f32").unwrap().in_place);
+    assert!(!kernel_info("hodu_cpu_gather_f32").unwrap().in_place);
+    assert!(kernel_info("hodu_cpu_fused_elementwise_bf16").unwrap().in_place);
+    assert!(kernel_info("hodu_cpu_parallel_for").unwrap().dtypes.is_empty());
+}
@@ -0,0 +1,134 @@
+use hodu_cpu_kernels::*;
+
+fn approx(v: Vec<f32>, digits: i32) -> Vec<f32> {
+    let b = 10f32.powi(digits);
+    v.iter().map(|t| f32::round(t * b) / b).collect()
+}
+
+// Helper function to build prefill attention metadata for contiguous BHSD tensors
+// Layout: [batch, heads, kv_heads, q_len, kv_len, head_dim, q/k/v strides, offsets, causal, has_kv_lens]
+fn build_attention_metadata(
+    batch: usize,
+    heads: usize,
+    kv_heads: usize,
+    q_len: usize,
+    kv_len: usize,
+    head_dim: usize,
+    causal: bool,
+) -> Vec<usize> {
+    let mut metadata = vec![batch, heads, kv_heads, q_len, kv_len, head_dim];
+    metadata.extend([heads * q_len * head_dim, q_len * head_dim, head_dim, 1]);
+    for _ in 0..2 {
+        metadata.extend([kv_heads * kv_len * head_dim, kv_len * head_dim, head_dim, 1]);
+    }
+    metadata.extend([0, 0, 0]);
+    metadata.push(causal as usize);
+    metadata.push(0);
+    metadata
+}
+
+const Q: [f32; 4] = [1.0, 0.0, 0.0, 1.0];
+const K: [f32; 6] = [1.0, 0.0, 0.0, 1.0, 1.0, 1.0];
+const V: [f32; 6] = [1.0, 2.0, 3.0, 4.0, 5.0, 6.0];
+
+// attention - q [1, 1, 2, 2] against k/v [1, 1, 3, 2]
+#[test]
+fn test_attention_f32() {
+    let mut output = vec![0.0f32; 4];
+    let metadata = build_attention_metadata(1, 1, 1, 2, 3, 2, false);
+
+    call_ops_attention(
+        attention::F32,
+        Q.as_ptr() as *const core::ffi::c_void,
+        K.as_ptr() as *const core::ffi::c_void,
+        V.as_ptr() as *const core::ffi::c_void,
+        output.as_mut_ptr() as *mut core::ffi::c_void,
+        &metadata,
+        1.0,
+    )
+    .unwrap();
+
+    // Query 0 scores [1, 0, 1] -> (e*[1, 2] + [3, 4] + e*[5, 6]) / (2e + 1)
+    assert_eq!(approx(output, 4), vec![3.0, 4.0, 3.5339, 4.5339]);
+}
+
+// attention - causal mask, bottom-right aligned (query 0 sits at key position 1)
+#[test]
+fn test_attention_causal_f32() {
+    let mut output = vec![0.0f32; 4];
+    let metadata = build_attention_metadata(1, 1, 1, 2, 3, 2, true);
+
+    call_ops_attention(
+        attention::F32,
+        Q.as_ptr() as *const core::ffi::c_void,
+        K.as_ptr() as *const core::ffi::c_void,
+        V.as_ptr() as *const core::ffi::c_void,
+        output.as_mut_ptr() as *mut core::ffi::c_void,
+        &metadata,
+        1.0,
+    )
+    .unwrap();
+
+    // Query 0 sees keys 0..2: (e*[1, 2] + [3, 4]) / (e + 1); query 1 sees all keys
+    assert_eq!(approx(output, 4), vec![1.5379, 2.5379, 3.5339, 4.5339]);
+}
+
+// attention_decode - two query heads sharing one kv head, 3 of 4 cache slots filled
+#[test]
+fn test_attention_decode_f32() {
+    let k_cache = [1.0f32, 0.0, 0.0, 1.0, 1.0, 1.0, 9.0, 9.0];
+    let v_cache = [1.0f32, 2.0, 3.0, 4.0, 5.0, 6.0, 9.0, 9.0];
+    let mut output = vec![0.0f32; 4];
+    // [batch, heads, kv_heads, head_dim, capacity, cache_lens...]
+    let metadata = vec![1, 2, 1, 2, 4, 3];
+
+    call_ops_attention_decode(
+        attention_decode::F32,
+        Q.as_ptr() as *const core::ffi::c_void,
+        k_cache.as_ptr() as *const core::ffi::c_void,
+        v_cache.as_ptr() as *const core::ffi::c_void,
+        output.as_mut_ptr() as *mut core::ffi::c_void,
+        &metadata,
+        1.0,
+    )
+    .unwrap();
+
+    // Same rows as the full prefill case; the unfilled slot is ignored
+    assert_eq!(approx(output, 4), vec![3.0, 4.0, 3.5339, 4.5339]);
+}
+
+// attention_decode with head_dim 64 (specialized task) against a scalar softmax
+#[test]
+fn test_attention_decode_f32_head_dim_64() {
+    let (d, len) = (64, 5);
+    let q: Vec<f32> = (0..2 * d).map(|i| ((i * 7 % 11) as f32 - 5.0) * 0.1).collect();
+    let k_cache: Vec<f32> = (0..len * d).map(|i| ((i * 5 % 13) as f32 - 6.0) * 0.1).collect();
+    let v_cache: Vec<f32> = (0..len * d).map(|i| (i % 9) as f32).collect();
+    let mut output = vec![0.0f32; 2 * d];
+    let metadata = vec![1, 2, 1, d, len, len];
+
+    call_ops_attention_decode(
+        attention_decode::F32,
+        q.as_ptr() as *const core::ffi::c_void,
+        k_cache.as_ptr() as *const core::ffi::c_void,
+        v_cache.as_ptr() as *const core::ffi::c_void,
+        output.as_mut_ptr() as *mut core::ffi::c_void,
+        &metadata,
+        0.125,
+    )
+    .unwrap();
+
+    let mut expected = vec![0.0f32; 2 * d];
+    for h in 0..2 {
+        let scores: Vec<f32> = (0..len)
+            .map(|j| (0..d).map(|c| q[h * d + c] * k_cache[j * d + c]).sum::<f32>() * 0.125)
+            .collect();
+        let max = scores.iter().cloned().fold(f32::NEG_INFINITY, f32::max);
+        let weights: Vec<f32> = scores.iter().map(|s| (s - max).exp()).collect();
+        let sum: f32 = weights.iter().sum();
+        for c in 0..d {
+            expected[h * d + c] = (0..len).map(|j| weights[j] * v_cache[j * d + c]).sum::<f32>() / sum;
+        }
+    }
+    assert_eq!(approx(output, 3), approx(expected, 3));
+}
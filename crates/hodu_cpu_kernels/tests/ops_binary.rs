@@ -215,3 +215,49 @@ fn test_negative_values_f32() {
     let output = run_binary(&lhs, &rhs, add::F32);
     assert_eq!(approx(output, 4), vec![0.0, 0.0, 0.0, 0.0]);
 }
+
+// broadcast: bias [3] over [2, 3] (rhs stride 0 on dim 0) and column [2, 1] over [2, 3]
+#[test]
+fn test_add_broadcast_f32() {
+    let lhs = vec![1.0f32, 2.0, 3.0, 4.0, 5.0, 6.0];
+    let bias = vec![10.0f32, 20.0, 30.0];
+    let col = vec![100.0f32, 200.0];
+    let shape = [2usize, 3];
+    let run = |rhs: &[f32], rhs_strides: [usize; 2]| {
+        let mut output = vec![0.0f32; 6];
+        let mut metadata = vec![6, 2];
+        metadata.extend(&shape); // lhs_shape
+        metadata.extend(&shape); // rhs_shape
+        metadata.extend(&[3, 1]); // lhs_strides
+        metadata.extend(&rhs_strides); // rhs_strides
+        metadata.push(0); // lhs_offset
+        metadata.push(0); // rhs_offset
+        call_ops_binary(
+            add::F32,
+            lhs.as_ptr() as *const core::ffi::c_void,
+            rhs.as_ptr() as *const core::ffi::c_void,
+            output.as_mut_ptr() as *mut core::ffi::c_void,
+            &metadata,
+        )
+        .unwrap();
+        output
+    };
+    assert_eq!(run(&bias, [0, 1]), vec![11.0, 22.0, 33.0, 14.0, 25.0, 36.0]);
+    assert_eq!(run(&col, [1, 0]), vec![101.0, 102.0, 103.0, 204.0, 205.0, 206.0]);
+}
+
+#[test]
+fn test_binary_in_place_f32() {
+    // a += b with the output in lhs, then a = b - a with the output in rhs
+    let mut a = vec![1.0f32, 2.0, 3.0, 4.0];
+    let b = vec![10.0f32, 20.0, 30.0, 40.0];
+    let metadata = [4, 1, 4, 4, 1, 1, 0, 0];
+    let a_ptr = a.as_mut_ptr() as *mut core::ffi::c_void;
+    let b_ptr = b.as_ptr() as *const core::ffi::c_void;
+
+    call_ops_binary(add::F32, a_ptr, b_ptr, a_ptr, &metadata).unwrap();
+    assert_eq!(a, vec![11.0, 22.0, 33.0, 44.0]);
+
+    call_ops_binary(sub::F32, b_ptr, a_ptr, a_ptr, &metadata).unwrap();
+    assert_eq!(a, vec![-1.0, -2.0, -3.0, -4.0]);
+}
@@ -293,3 +293,25 @@ fn test_minimum_f8e5m2() {
     let result = run_binary_f8e5m2(&lhs, &rhs, minimum::F8E5M2);
     assert_eq!(result.len(), 3);
 }
+
+#[test]
+fn test_add_bf16_f16_round_to_nearest_even() {
+    // Long enough to go through the vectorized blocks plus a scalar tail
+    let n = 1000;
+    let a: Vec<f32> = (0..n).map(|i| 1.0 + i as f32 * 0.013).collect();
+    let b: Vec<f32> = (0..n).map(|i| (i % 17) as f32 * -0.37 + 1e-3).collect();
+
+    let lhs: Vec<bf16> = a.iter().map(|&x| bf16::from_f32(x)).collect();
+    let rhs: Vec<bf16> = b.iter().map(|&x| bf16::from_f32(x)).collect();
+    let result = run_binary_bf16(&lhs, &rhs, add::BF16);
+    for i in 0..n {
+        assert_eq!(result[i], bf16::from_f32(lhs[i].to_f32() + rhs[i].to_f32()));
+    }
+
+    let lhs: Vec<f16> = a.iter().map(|&x| f16::from_f32(x)).collect();
+    let rhs: Vec<f16> = b.iter().map(|&x| f16::from_f32(x)).collect();
+    let result = run_binary_f16(&lhs, &rhs, add::F16);
+    for i in 0..n {
+        assert_eq!(result[i], f16::from_f32(lhs[i].to_f32() + rhs[i].to_f32()));
+    }
+}
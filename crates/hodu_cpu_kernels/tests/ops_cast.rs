@@ -0,0 +1,69 @@
+use hodu_cpu_kernels::*;
+
+fn cast_metadata(shape: &[usize], strides: &[usize], offset: usize) -> Vec<usize> {
+    let mut metadata = vec![shape.iter().product(), shape.len()];
+    metadata.extend(shape);
+    metadata.extend(strides);
+    metadata.push(offset);
+    metadata
+}
+
+#[test]
+fn test_cast_f32_to_i32_transposed() {
+    // 3x4 row-major input read as its 4x3 transpose
+    let input: Vec<f32> = (0..12).map(|i| i as f32 + 0.5).collect();
+    let mut output = vec![0i32; 12];
+    call_ops_cast(
+        cast::from_f32::TO_I32,
+        input.as_ptr() as *const core::ffi::c_void,
+        output.as_mut_ptr() as *mut core::ffi::c_void,
+        &cast_metadata(&[4, 3], &[1, 4], 0),
+    )
+    .unwrap();
+
+    assert_eq!(output, vec![0, 4, 8, 1, 5, 9, 2, 6, 10, 3, 7, 11]);
+}
+
+#[test]
+fn test_cast_f32_to_int_saturates() {
+    // Out-of-range values clamp and NaN becomes 0, like Rust `as`
+    let input = [f32::NAN, -1e10, 1e10, -1.5, 3.9, 300.0, f32::INFINITY];
+    let metadata = cast_metadata(&[input.len()], &[1], 0);
+
+    let mut u8_out = vec![0u8; input.len()];
+    call_ops_cast(
+        cast::from_f32::TO_U8,
+        input.as_ptr() as *const core::ffi::c_void,
+        u8_out.as_mut_ptr() as *mut core::ffi::c_void,
+        &metadata,
+    )
+    .unwrap();
+    assert_eq!(u8_out, input.iter().map(|&x| x as u8).collect::<Vec<_>>());
+
+    let mut i32_out = vec![0i32; input.len()];
+    call_ops_cast(
+        cast::from_f32::TO_I32,
+        input.as_ptr() as *const core::ffi::c_void,
+        i32_out.as_mut_ptr() as *mut core::ffi::c_void,
+        &metadata,
+    )
+    .unwrap();
+    assert_eq!(i32_out, input.iter().map(|&x| x as i32).collect::<Vec<_>>());
+}
+
+#[test]
+fn test_cast_f32_to_i32_in_place() {
+    // Same-size cast over its own buffer, contiguous and through a transposed view
+    let mut data: Vec<u32> = (0..6).map(|i| (i as f32 + 0.5).to_bits()).collect();
+    let ptr = data.as_mut_ptr() as *mut core::ffi::c_void;
+
+    call_ops_cast(cast::from_f32::TO_I32, ptr, ptr, &cast_metadata(&[6], &[1], 0)).unwrap();
+    assert_eq!(data, vec![0, 1, 2, 3, 4, 5]);
+
+    for (i, v) in data.iter_mut().enumerate() {
+        *v = (i as f32 * 2.0).to_bits();
+    }
+    let ptr = data.as_mut_ptr() as *mut core::ffi::c_void;
+    call_ops_cast(cast::from_f32::TO_I32, ptr, ptr, &cast_metadata(&[3, 2], &[1, 3], 0)).unwrap();
+    assert_eq!(data, vec![0, 6, 2, 8, 4, 10]);
+}
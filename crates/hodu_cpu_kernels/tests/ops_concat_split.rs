@@ -186,6 +186,48 @@ fn test_concat_3_tensors() {
     );
 }
 
+#[test]
+fn test_concat_f32_large_strided_input() {
+    // KV-cache style append along dim 1: a contiguous [4, 300, 64] cache and a
+    // [4, 2, 64] step stored transposed (dims 1 and 2 swapped in memory)
+    let (heads, len, step, dim) = (4usize, 300usize, 2usize, 64usize);
+    let cache: Vec<f32> = (0..heads * len * dim).map(|i| i as f32).collect();
+    let new: Vec<f32> = (0..heads * step * dim).map(|i| -(i as f32)).collect();
+    let mut input = cache.clone();
+    input.extend(&new);
+
+    let total = len + step;
+    let num_els = heads * total * dim;
+    let mut output = vec![0.0f32; num_els];
+
+    let mut metadata = vec![num_els, 3, heads, total, dim, 1, 2];
+    metadata.extend([heads, len, dim, heads, step, dim]);
+    metadata.extend([len * dim, dim, 1, step * dim, 1, step]);
+    metadata.extend([0, 0]);
+    metadata.extend([0, cache.len()]);
+
+    call_ops_concat(
+        concat::F32,
+        input.as_ptr() as *const core::ffi::c_void,
+        output.as_mut_ptr() as *mut core::ffi::c_void,
+        &metadata,
+    )
+    .unwrap();
+
+    for h in 0..heads {
+        for t in 0..total {
+            for d in 0..dim {
+                let expected = if t < len {
+                    cache[(h * len + t) * dim + d]
+                } else {
+                    new[h * step * dim + d * step + (t - len)]
+                };
+                assert_eq!(output[(h * total + t) * dim + d], expected);
+            }
+        }
+    }
+}
+
 #[test]
 fn test_split_f32_dim0() {
     // Input: 4x2 matrix [[1, 2], [3, 4], [5, 6], [7, 8]]
@@ -201,6 +201,326 @@ fn test_conv2d_f32_with_padding() {
     assert_eq!(approx(output, 4), vec![1.0, 2.0, 3.0, 4.0, 5.0, 6.0, 7.0, 8.0, 9.0]);
 }
 
+#[test]
+fn test_conv2d_f32_multi_channel_3x3() {
+    // 8 -> 8 channels, 3x3 with padding 1 (large enough for the Winograd path)
+    let channels = 8;
+    let size = 10;
+    let input: Vec<f32> = (0..channels * size * size).map(|i| (i % 17) as f32 - 8.0).collect();
+    // Channel identity: only the center tap of filter (c, c) is set
+    let mut weight = vec![0.0f32; channels * channels * 9];
+    for c in 0..channels {
+        weight[(c * channels + c) * 9 + 4] = 1.0;
+    }
+    let mut output = vec![0.0f32; channels * size * size];
+
+    let metadata = vec![
+        channels * size * size,
+        1,
+        channels,
+        channels,
+        size,
+        size,
+        3,
+        3,
+        size,
+        size,
+        1,
+        1,
+        1,
+        1,
+        1,
+        1,
+        0,
+        0,
+    ];
+
+    call_ops_conv(
+        conv2d::F32,
+        input.as_ptr() as *const core::ffi::c_void,
+        weight.as_ptr() as *const core::ffi::c_void,
+        output.as_mut_ptr() as *mut core::ffi::c_void,
+        &metadata,
+    )
+    .unwrap();
+
+    assert_eq!(approx(output, 3), input);
+}
+
+#[test]
+fn test_conv2d_f32_direct_5x5() {
+    // 3 -> 3 channels, 5x5 with padding 2 (direct path, stride-1 5-wide task): only tap
+    // (kh 2, kw 4) of filter (c, c) is set, so each output reads the input two columns right
+    let (channels, size) = (3, 20);
+    let input: Vec<f32> = (0..channels * size * size).map(|i| (i % 23) as f32 - 11.0).collect();
+    let mut weight = vec![0.0f32; channels * channels * 25];
+    for c in 0..channels {
+        weight[(c * channels + c) * 25 + 2 * 5 + 4] = 1.0;
+    }
+    let mut output = vec![0.0f32; channels * size * size];
+    let metadata = vec![
+        channels * size * size,
+        1,
+        channels,
+        channels,
+        size,
+        size,
+        5,
+        5,
+        size,
+        size,
+        1,
+        1,
+        2,
+        2,
+        1,
+        1,
+        0,
+        0,
+    ];
+
+    call_ops_conv(
+        conv2d::F32,
+        input.as_ptr() as *const core::ffi::c_void,
+        weight.as_ptr() as *const core::ffi::c_void,
+        output.as_mut_ptr() as *mut core::ffi::c_void,
+        &metadata,
+    )
+    .unwrap();
+
+    let expected: Vec<f32> = (0..channels * size * size)
+        .map(|i| if i % size + 2 < size { input[i + 2] } else { 0.0 })
+        .collect();
+    assert_eq!(output, expected);
+}
+
+#[test]
+fn test_conv2d_f32_caller_workspace() {
+    // 4 -> 4 channels, 5x5 input, 3x3 box filter without padding
+    let input: Vec<f32> = (0..4 * 25).map(|i| (i % 5) as f32).collect();
+    let weight = vec![1.0f32; 4 * 4 * 9];
+    let mut output = vec![0.0f32; 4 * 9];
+
+    // [num_els, batch, in_c, out_c, in_h, in_w, k_h, k_w, out_h, out_w,
+    //  stride_h, stride_w, pad_h, pad_w, dil_h, dil_w, input_offset, weight_offset]
+    let metadata = vec![36, 1, 4, 4, 5, 5, 3, 3, 3, 3, 1, 1, 0, 0, 1, 1, 0, 0];
+
+    let mut buffer = vec![0u8; conv2d_workspace_size(conv2d::F32, &metadata)];
+    let (result, peak) = with_workspace(&mut buffer, || {
+        call_ops_conv(
+            conv2d::F32,
+            input.as_ptr() as *const core::ffi::c_void,
+            weight.as_ptr() as *const core::ffi::c_void,
+            output.as_mut_ptr() as *mut core::ffi::c_void,
+            &metadata,
+        )
+    });
+    result.unwrap();
+    assert!(peak <= buffer.len());
+
+    // Each window sums 4 channels x 3 rows of (c, c+1, c+2) for column c
+    let expected: Vec<f32> = (0..4 * 9).map(|i| (4 * 3 * (3 * (i % 3) + 3)) as f32).collect();
+    assert_eq!(output, expected);
+}
+
+#[test]
+fn test_conv2d_nhwc_f32() {
+    // 2 -> 3 channels, 5x5 input, 3x3 filter, padding 1, stride 2
+    let (ic, oc, size, out) = (2, 3, 5, 3);
+    let input: Vec<f32> = (0..ic * size * size).map(|i| (i % 7) as f32 - 3.0).collect();
+    let weight: Vec<f32> = (0..oc * ic * 9).map(|i| (i % 5) as f32 - 2.0).collect();
+
+    // [num_els, batch, in_c, out_c, in_h, in_w, k_h, k_w, out_h, out_w,
+    //  stride_h, stride_w, pad_h, pad_w, dil_h, dil_w, input_offset, weight_offset]
+    let metadata = vec![27, 1, 2, 3, 5, 5, 3, 3, 3, 3, 2, 2, 1, 1, 1, 1, 0, 0];
+
+    let mut expected = vec![0.0f32; oc * out * out];
+    call_ops_conv(
+        conv2d::F32,
+        input.as_ptr() as *const core::ffi::c_void,
+        weight.as_ptr() as *const core::ffi::c_void,
+        expected.as_mut_ptr() as *mut core::ffi::c_void,
+        &metadata,
+    )
+    .unwrap();
+
+    // Same tensors channels-last: input HWC, weight OHWI
+    let mut input_nhwc = vec![0.0f32; input.len()];
+    for c in 0..ic {
+        for p in 0..size * size {
+            input_nhwc[p * ic + c] = input[c * size * size + p];
+        }
+    }
+    let mut weight_ohwi = vec![0.0f32; weight.len()];
+    for o in 0..oc {
+        for c in 0..ic {
+            for t in 0..9 {
+                weight_ohwi[(o * 9 + t) * ic + c] = weight[(o * ic + c) * 9 + t];
+            }
+        }
+    }
+    let mut output = vec![0.0f32; oc * out * out];
+    call_ops_conv(
+        conv2d_nhwc::F32,
+        input_nhwc.as_ptr() as *const core::ffi::c_void,
+        weight_ohwi.as_ptr() as *const core::ffi::c_void,
+        output.as_mut_ptr() as *mut core::ffi::c_void,
+        &metadata,
+    )
+    .unwrap();
+
+    for o in 0..oc {
+        for p in 0..out * out {
+            assert!((output[p * oc + o] - expected[o * out * out + p]).abs() < 1e-4);
+        }
+    }
+}
+
+#[test]
+fn test_conv2d_packed_f32() {
+    let input = [1.0f32, 2.0, 3.0, 4.0, 5.0, 6.0, 7.0, 8.0, 9.0];
+    // Two 2x2 filters: diagonal and box
+    let weight = [1.0f32, 0.0, 0.0, 1.0, 1.0, 1.0, 1.0, 1.0];
+    let mut output = vec![0.0f32; 8];
+
+    // [num_els, batch, in_c, out_c, in_h, in_w, k_h, k_w, out_h, out_w,
+    //  stride_h, stride_w, pad_h, pad_w, dil_h, dil_w, input_offset, weight_offset]
+    let metadata = vec![8, 1, 1, 2, 3, 3, 2, 2, 2, 2, 1, 1, 0, 0, 1, 1, 0, 0];
+
+    let size = conv2d_packed_weight_size(conv2d_packed::F32, &metadata);
+    let mut packed = vec![0.0f32; size.div_ceil(4)];
+    call_ops_conv2d_pack_weight(
+        conv2d_packed::F32,
+        weight.as_ptr() as *const core::ffi::c_void,
+        packed.as_mut_ptr() as *mut core::ffi::c_void,
+        &metadata,
+    )
+    .unwrap();
+
+    // The packed weight is reused across calls
+    for _ in 0..2 {
+        call_ops_conv2d_packed(
+            conv2d_packed::F32,
+            input.as_ptr() as *const core::ffi::c_void,
+            packed.as_ptr() as *const core::ffi::c_void,
+            output.as_mut_ptr() as *mut core::ffi::c_void,
+            &metadata,
+            None,
+        )
+        .unwrap();
+
+        assert_eq!(
+            approx(output.clone(), 4),
+            vec![6.0, 8.0, 12.0, 14.0, 12.0, 16.0, 24.0, 28.0]
+        );
+    }
+}
+
+#[test]
+fn test_conv2d_fused_f32() {
+    let input = [1.0f32, 2.0, 3.0, 4.0, 5.0, 6.0, 7.0, 8.0, 9.0];
+    let weight = [1.0f32, 0.0, 0.0, 1.0, 1.0, 1.0, 1.0, 1.0];
+    let bias = [-7.0f32, 1.0];
+    let mut output = vec![0.0f32; 8];
+
+    let metadata = vec![8, 1, 1, 2, 3, 3, 2, 2, 2, 2, 1, 1, 0, 0, 1, 1, 0, 0];
+    let epilogue = Epilogue {
+        bias: bias.as_ptr() as *const core::ffi::c_void,
+        activation: Activation::Relu,
+        ..Default::default()
+    };
+
+    call_ops_conv2d_fused(
+        conv2d_fused::F32,
+        input.as_ptr() as *const core::ffi::c_void,
+        weight.as_ptr() as *const core::ffi::c_void,
+        output.as_mut_ptr() as *mut core::ffi::c_void,
+        &metadata,
+        &epilogue,
+    )
+    .unwrap();
+
+    // relu([6, 8, 12, 14] - 7), [12, 16, 24, 28] + 1
+    assert_eq!(approx(output, 4), vec![0.0, 1.0, 5.0, 7.0, 13.0, 17.0, 25.0, 29.0]);
+}
+
+#[test]
+fn test_conv2d_grouped_f32() {
+    let (batch, in_c, out_c, h, w) = (2, 4, 8, 5, 6);
+    let (oh, ow) = ((h + 2 - 3) / 2 + 1, (w + 2 - 3) / 2 + 1);
+    let input: Vec<f32> = (0..batch * in_c * h * w).map(|i| (i % 13) as f32 - 6.0).collect();
+
+    // groups = 4 is depthwise with two filters per channel, groups = 2 the GEMM path
+    for groups in [2, 4] {
+        let (icpg, ocpg) = (in_c / groups, out_c / groups);
+        let weight: Vec<f32> = (0..out_c * icpg * 9).map(|i| (i % 7) as f32 * 0.5 - 1.5).collect();
+        let metadata = vec![
+            batch * out_c * oh * ow,
+            batch,
+            in_c,
+            out_c,
+            h,
+            w,
+            3,
+            3,
+            oh,
+            ow,
+            2,
+            2,
+            1,
+            1,
+            1,
+            1,
+            0,
+            0,
+            groups,
+        ];
+        let mut output = vec![f32::NAN; batch * out_c * oh * ow];
+        call_ops_conv2d_grouped(
+            conv2d_grouped::F32,
+            input.as_ptr() as *const core::ffi::c_void,
+            weight.as_ptr() as *const core::ffi::c_void,
+            output.as_mut_ptr() as *mut core::ffi::c_void,
+            &metadata,
+        )
+        .unwrap();
+
+        // Reference: one dense conv2d per (batch, group) through the input/weight offsets
+        for b in 0..batch {
+            for g in 0..groups {
+                let mut group_md = metadata[..18].to_vec();
+                group_md[0] = ocpg * oh * ow;
+                group_md[1] = 1;
+                group_md[2] = icpg;
+                group_md[3] = ocpg;
+                group_md[16] = (b * in_c + g * icpg) * h * w;
+                group_md[17] = g * ocpg * icpg * 9;
+                let mut expected = vec![0.0f32; ocpg * oh * ow];
+                call_ops_conv(
+                    conv2d::F32,
+                    input.as_ptr() as *const core::ffi::c_void,
+                    weight.as_ptr() as *const core::ffi::c_void,
+                    expected.as_mut_ptr() as *mut core::ffi::c_void,
+                    &group_md,
+                )
+                .unwrap();
+                let start = (b * out_c + g * ocpg) * oh * ow;
+                assert_eq!(
+                    approx(output[start..start + ocpg * oh * ow].to_vec(), 4),
+                    approx(expected, 4)
+                );
+            }
+        }
+    }
+
+    let mut metadata = vec![0; 19];
+    metadata[2] = 4;
+    metadata[3] = 6;
+    metadata[18] = 4;
+    let null = core::ptr::null();
+    assert!(call_ops_conv2d_grouped(conv2d_grouped::F32, null, null, core::ptr::null_mut(), &metadata).is_err());
+}
+
 #[test]
 fn test_conv3d_f32() {
     let batch = 1;
@@ -317,6 +637,65 @@ fn test_conv_transpose1d_f32() {
     assert_eq!(approx(output, 4), vec![1.0, 2.0, 2.0, 4.0, 3.0, 6.0]);
 }
 
+#[test]
+fn test_conv_transpose1d_f32_adjoint() {
+    // conv_transpose is the adjoint of conv with the same weight: <conv(x), y> = <x, conv_transpose(y)>
+    let (batch, in_c, out_c, in_w, k, stride, padding, dilation) = (3, 4, 5, 23, 3, 2, 1, 2);
+    let out_w = (in_w + 2 * padding - dilation * (k - 1) - 1) / stride + 1;
+    let x: Vec<f32> = (0..batch * in_c * in_w).map(|i| (i % 9) as f32 - 4.0).collect();
+    let y: Vec<f32> = (0..batch * out_c * out_w).map(|i| (i % 5) as f32 * 0.5 - 1.0).collect();
+    let weight: Vec<f32> = (0..out_c * in_c * k).map(|i| (i % 7) as f32 - 3.0).collect();
+
+    let mut conv = vec![0.0f32; y.len()];
+    call_ops_conv(
+        conv1d::F32,
+        x.as_ptr() as *const core::ffi::c_void,
+        weight.as_ptr() as *const core::ffi::c_void,
+        conv.as_mut_ptr() as *mut core::ffi::c_void,
+        &[
+            y.len(),
+            batch,
+            in_c,
+            out_c,
+            in_w,
+            k,
+            out_w,
+            stride,
+            padding,
+            dilation,
+            0,
+            0,
+        ],
+    )
+    .unwrap();
+    let mut transposed = vec![f32::NAN; x.len()];
+    call_ops_conv(
+        conv_transpose1d::F32,
+        y.as_ptr() as *const core::ffi::c_void,
+        weight.as_ptr() as *const core::ffi::c_void,
+        transposed.as_mut_ptr() as *mut core::ffi::c_void,
+        &[
+            x.len(),
+            batch,
+            out_c,
+            in_c,
+            out_w,
+            k,
+            in_w,
+            stride,
+            padding,
+            dilation,
+            0,
+            0,
+        ],
+    )
+    .unwrap();
+
+    let lhs: f32 = conv.iter().zip(&y).map(|(a, b)| a * b).sum();
+    let rhs: f32 = x.iter().zip(&transposed).map(|(a, b)| a * b).sum();
+    assert_eq!(lhs, rhs);
+}
+
 #[test]
 fn test_conv_transpose2d_f32() {
     let batch = 1;
@@ -605,6 +984,66 @@ fn test_conv2d_grad_weight_f32() {
     assert_eq!(approx(grad_weight, 4), vec![12.0, 16.0, 24.0, 28.0]);
 }
 
+#[test]
+fn test_conv2d_grad_weight_f32_batched() {
+    // 8 samples, 2 -> 3 channels, 6x6 input, 3x3 kernel with padding 1 (6x6 output)
+    let (batch, in_channels, out_channels, size) = (8, 2, 3, 6);
+    let input = vec![1.0f32; batch * in_channels * size * size];
+    let grad_output = vec![1.0f32; batch * out_channels * size * size];
+    let mut grad_weight = vec![0.0f32; out_channels * in_channels * 9];
+
+    let plane = size * size;
+    let metadata = vec![
+        out_channels * in_channels * 9, // num_els
+        4,
+        2,
+        batch,
+        in_channels,
+        size,
+        size, // input_shape
+        batch,
+        out_channels,
+        size,
+        size, // grad_output_shape
+        out_channels,
+        in_channels,
+        3,
+        3, // weight_shape
+        in_channels * plane,
+        plane,
+        size,
+        1, // input_strides
+        out_channels * plane,
+        plane,
+        size,
+        1, // grad_output_strides
+        0, // input_offset
+        0, // grad_output_offset
+        1,
+        1, // stride
+        1,
+        1, // padding
+        1,
+        1, // dilation
+    ];
+
+    call_ops_conv_grad_weight(
+        conv2d_grad_weight::F32,
+        input.as_ptr() as *const core::ffi::c_void,
+        grad_output.as_ptr() as *const core::ffi::c_void,
+        grad_weight.as_mut_ptr() as *mut core::ffi::c_void,
+        &metadata,
+    )
+    .unwrap();
+
+    // Each tap sums over the batch and the output positions whose window keeps it inside the input
+    let valid = |k: usize| if k == 1 { size } else { size - 1 };
+    let expected: Vec<f32> = (0..out_channels * in_channels * 9)
+        .map(|i| (batch * valid(i % 9 / 3) * valid(i % 3)) as f32)
+        .collect();
+    assert_eq!(grad_weight, expected);
+}
+
 #[test]
 fn test_conv3d_grad_weight_f32() {
     let batch = 1;
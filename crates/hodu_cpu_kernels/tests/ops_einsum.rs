@@ -389,3 +389,64 @@ fn test_einsum_batch_matmul_f32() {
     let expected = vec![22.0, 28.0, 49.0, 64.0, 220.0, 244.0, 301.0, 334.0];
     assert_eq!(output, expected);
 }
+
+// Test: three-operand chain with a permuted output "ij,jk,kl->li"
+#[test]
+fn test_einsum_chain_permuted_f32() {
+    let (ni, nj, nk, nl) = (3usize, 4usize, 5usize, 2usize);
+    let a: Vec<f32> = (0..ni * nj).map(|x| (x % 5) as f32 - 2.0).collect();
+    let b: Vec<f32> = (0..nj * nk).map(|x| (x % 3) as f32).collect();
+    let c: Vec<f32> = (0..nk * nl).map(|x| (x % 4) as f32 - 1.0).collect();
+    let mut output = vec![0.0f32; nl * ni];
+
+    let a_shape = [ni, nj];
+    let b_shape = [nj, nk];
+    let c_shape = [nk, nl];
+    let output_shape = [nl, ni];
+    let a_strides = calculate_strides(&a_shape);
+    let b_strides = calculate_strides(&b_shape);
+    let c_strides = calculate_strides(&c_shape);
+
+    let all_indices = ['i', 'j', 'k', 'l'];
+    let input_subscripts: [&[char]; 3] = [&['i', 'j'], &['j', 'k'], &['k', 'l']];
+    let output_subscripts = ['l', 'i'];
+    let contraction_indices = ['j', 'k'];
+
+    let metadata = build_einsum_metadata(
+        3,
+        &[&a_shape, &b_shape, &c_shape],
+        &[&a_strides, &b_strides, &c_strides],
+        &[0, 0, 0],
+        &output_shape,
+        &all_indices,
+        &input_subscripts,
+        &output_subscripts,
+        &contraction_indices,
+    );
+
+    let inputs: [*const core::ffi::c_void; 3] = [
+        a.as_ptr() as *const core::ffi::c_void,
+        b.as_ptr() as *const core::ffi::c_void,
+        c.as_ptr() as *const core::ffi::c_void,
+    ];
+
+    call_ops_einsum(
+        einsum::F32,
+        &inputs,
+        output.as_mut_ptr() as *mut core::ffi::c_void,
+        &metadata,
+    )
+    .unwrap();
+
+    let mut expected = vec![0.0f32; nl * ni];
+    for l in 0..nl {
+        for i in 0..ni {
+            for j in 0..nj {
+                for k in 0..nk {
+                    expected[l * ni + i] += a[i * nj + j] * b[j * nk + k] * c[k * nl + l];
+                }
+            }
+        }
+    }
+    assert_eq!(output, expected);
+}
@@ -0,0 +1,128 @@
+use hodu_cpu_kernels::*;
+use std::ffi::c_void;
+
+fn unary(kernel: Kernel, input: &[f32]) -> Vec<f32> {
+    let n = input.len();
+    let mut output = vec![0.0f32; n];
+    call_ops_unary(
+        kernel,
+        input.as_ptr() as *const c_void,
+        output.as_mut_ptr() as *mut c_void,
+        &[n, 1, n, 1, 0],
+    )
+    .unwrap();
+    output
+}
+
+fn binary(kernel: Kernel, lhs: &[f32], rhs: &[f32], metadata: &[usize]) -> Vec<f32> {
+    let mut output = vec![0.0f32; metadata[0]];
+    call_ops_binary(
+        kernel,
+        lhs.as_ptr() as *const c_void,
+        rhs.as_ptr() as *const c_void,
+        output.as_mut_ptr() as *mut c_void,
+        metadata,
+    )
+    .unwrap();
+    output
+}
+
+// (x * scale + bias).sigmoid() * x with bias [C] broadcast over [N, C]
+#[test]
+fn test_fused_chain_matches_separate_kernels() {
+    let (n, c) = (37, 129);
+    let x: Vec<f32> = (0..n * c)
+        .map(|i| ((i * 7919 % 2001) as f32 - 1000.0) * 0.004)
+        .collect();
+    let bias: Vec<f32> = (0..c).map(|i| i as f32 * 0.01 - 0.5).collect();
+    let program = [
+        FusedInst::load(0, 0),
+        FusedInst::constant(1, 1.5),
+        FusedInst::load(2, 1),
+        FusedInst::binary(FusedOp::Mul, 3, 0, 1),
+        FusedInst::binary(FusedOp::Add, 3, 3, 2),
+        FusedInst::unary(FusedOp::Sigmoid, 3, 3),
+        FusedInst::binary(FusedOp::Mul, 3, 3, 0),
+    ];
+    let metadata = vec![n * c, 2, 2, n, c, c, 1, 0, 0, 1, 0];
+    let mut output = vec![0.0f32; n * c];
+    call_ops_fused_elementwise(
+        fused_elementwise::F32,
+        &[x.as_ptr() as *const c_void, bias.as_ptr() as *const c_void],
+        output.as_mut_ptr() as *mut c_void,
+        &metadata,
+        &program,
+    )
+    .unwrap();
+
+    let len = n * c;
+    let scales = vec![1.5f32; len];
+    let scaled = binary(mul::F32, &x, &scales, &[len, 1, len, len, 1, 1, 0, 0]);
+    let shifted = binary(add::F32, &scaled, &bias, &[len, 2, n, c, n, c, c, 1, 0, 1, 0, 0]);
+    let gated = unary(sigmoid::F32, &shifted);
+    let expected = binary(mul::F32, &gated, &x, &[len, 1, len, len, 1, 1, 0, 0]);
+    assert_eq!(output, expected);
+}
+
+#[test]
+fn test_fused_in_place_bf16() {
+    let n = 1000;
+    let mut data: Vec<u16> = (0..n)
+        .map(|i| (((i % 256) as f32 * 0.5 - 64.0).to_bits() >> 16) as u16)
+        .collect();
+    let expected: Vec<f32> = data
+        .iter()
+        .map(|&h| f32::from_bits((h as u32) << 16).max(0.0) - 2.0)
+        .collect();
+    let program = [
+        FusedInst::load(0, 0),
+        FusedInst::unary(FusedOp::Relu, 0, 0),
+        FusedInst::constant(1, 2.0),
+        FusedInst::binary(FusedOp::Sub, 0, 0, 1),
+    ];
+    let ptr = data.as_mut_ptr();
+    call_ops_fused_elementwise(
+        fused_elementwise::BF16,
+        &[ptr as *const c_void],
+        ptr as *mut c_void,
+        &[n, 1, 1, n, 1, 0],
+        &program,
+    )
+    .unwrap();
+
+    // Multiples of 0.5 below 64 in magnitude fit the 8-bit bf16 significand exactly
+    let output: Vec<f32> = data.iter().map(|&h| f32::from_bits((h as u32) << 16)).collect();
+    assert_eq!(output, expected);
+}
+
+#[test]
+fn test_fused_rejects_invalid_programs() {
+    let input = [1.0f32; 4];
+    let mut output = [0.0f32; 4];
+    let run = |program: &[FusedInst], output: &mut [f32]| {
+        call_ops_fused_elementwise(
+            fused_elementwise::F32,
+            &[input.as_ptr() as *const c_void],
+            output.as_mut_ptr() as *mut c_void,
+            &[4, 1, 1, 4, 1, 0],
+            program,
+        )
+    };
+
+    assert!(run(&[], &mut output).is_err());
+    assert!(run(&[FusedInst::load(0, 1)], &mut output).is_err());
+    assert!(run(
+        &[FusedInst::load(0, 0), FusedInst::binary(FusedOp::Add, 1, 0, 2)],
+        &mut output
+    )
+    .is_err());
+    assert!(run(&[FusedInst::load(16, 0)], &mut output).is_err());
+    assert_eq!(output, [0.0; 4]);
+
+    run(
+        &[FusedInst::load(0, 0), FusedInst::unary(FusedOp::Exp, 1, 0)],
+        &mut output,
+    )
+    .unwrap();
+    assert!(output.iter().all(|&v| (v - std::f32::consts::E).abs() < 1e-6));
+}
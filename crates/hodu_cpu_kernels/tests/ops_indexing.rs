@@ -76,6 +76,54 @@ fn test_index_select_f32_2d_dim0() {
     assert_eq!(output, vec![1.0, 2.0, 3.0, 7.0, 8.0, 9.0]);
 }
 
+#[test]
+fn test_index_select_embedding_lookup() {
+    // Embedding table [1000, 64] looked up by 300 ids (rows copied whole), with a
+    // negative id and an out-of-range id that selects zeros
+    let (vocab, width) = (1000usize, 64usize);
+    let table: Vec<f32> = (0..vocab * width).map(|i| i as f32).collect();
+    let mut ids: Vec<i32> = (0..300).map(|i| (i * 37 % vocab) as i32).collect();
+    ids[5] = -1;
+    ids[6] = vocab as i32;
+    let mut output = vec![1.0f32; ids.len() * width];
+
+    let mut metadata = vec![output.len(), 2, vocab, width, width, 1, 0, 0, ids.len()];
+    call_ops_index_select(
+        index_select::F32,
+        table.as_ptr() as *const core::ffi::c_void,
+        ids.as_ptr(),
+        output.as_mut_ptr() as *mut core::ffi::c_void,
+        &metadata,
+    )
+    .unwrap();
+
+    for (j, &id) in ids.iter().enumerate() {
+        let row = match id {
+            -1 => Some(vocab - 1),
+            id if (id as usize) < vocab => Some(id as usize),
+            _ => None,
+        };
+        for k in 0..width {
+            let expected = row.map_or(0.0, |r| table[r * width + k]);
+            assert_eq!(output[j * width + k], expected);
+        }
+    }
+
+    // The same lookup along the inner dim of the transposed table [64, 1000]
+    metadata = vec![width * ids.len(), 2, width, vocab, 1, width, 0, 1, ids.len()];
+    call_ops_index_select(
+        index_select::F32,
+        table.as_ptr() as *const core::ffi::c_void,
+        ids.as_ptr(),
+        output.as_mut_ptr() as *mut core::ffi::c_void,
+        &metadata,
+    )
+    .unwrap();
+    assert_eq!(output[ids.len() + 7], table[(7 * 37) * width + 1]);
+    assert_eq!(output[ids.len() + 5], table[(vocab - 1) * width + 1]);
+    assert_eq!(output[ids.len() + 6], 0.0);
+}
+
 #[test]
 fn test_index_select_f32_2d_dim1() {
     // Input: [[1, 2, 3], [4, 5, 6]]  (2x3)
@@ -278,6 +326,33 @@ fn test_index_put_f32_2d() {
     assert_eq!(output, vec![10.0, 11.0, 12.0, 4.0, 5.0, 6.0, 13.0, 14.0, 15.0]);
 }
 
+#[test]
+fn test_index_put_f32_in_place() {
+    // Columns 2 and 0 of a 2x3 buffer overwritten in place, from column-major values;
+    // the repeated index -1 (column 2) keeps its first value
+    let mut data = vec![1.0f32, 2.0, 3.0, 4.0, 5.0, 6.0];
+    let indices = [-1i32, 0, 2];
+    let values = [10.0f32, 40.0, 20.0, 50.0, 30.0, 60.0];
+
+    let mut metadata = vec![6, 2];
+    metadata.extend([2, 3]); // input_shape
+    metadata.extend([3, 1]); // input_strides
+    metadata.extend([1, 2]); // values_strides
+    metadata.extend([0, 0, 1, 3]); // input_offset, values_offset, dim, num_indices
+
+    call_ops_index_put(
+        index_put::F32,
+        data.as_ptr() as *const core::ffi::c_void,
+        indices.as_ptr(),
+        values.as_ptr() as *const core::ffi::c_void,
+        data.as_mut_ptr() as *mut core::ffi::c_void,
+        &metadata,
+    )
+    .unwrap();
+
+    assert_eq!(data, vec![20.0, 2.0, 10.0, 50.0, 5.0, 40.0]);
+}
+
 #[test]
 fn test_gather_f32_1d() {
     // Input: [1, 2, 3, 4, 5]
@@ -637,6 +712,46 @@ fn test_scatter_add_i32() {
     assert_eq!(output, vec![1, 42, 3, 24, 5]); // 2+10+30=42, 4+20=24
 }
 
+#[test]
+fn test_scatter_add_f32_duplicates_deterministic() {
+    // Embedding-gradient style: 4096 rows of 8 scattered into 100 rows along dim 0, with
+    // many duplicates; large enough to take the partitioned parallel path, which must add
+    // each output's contributions in src order like a serial loop (bit-identical sums)
+    let (rows, width, vocab) = (4096usize, 8usize, 100usize);
+    let input: Vec<f32> = (0..vocab * width).map(|i| i as f32 * 0.25).collect();
+    let src: Vec<f32> = (0..rows * width)
+        .map(|i| ((i * 37 % 101) as f32 - 50.0) * 0.013)
+        .collect();
+    let indices: Vec<i32> = (0..rows * width).map(|i| ((i / width) * 7 % vocab) as i32).collect();
+    let num_els = rows * width;
+
+    let mut metadata = vec![num_els, 2];
+    metadata.extend(&[vocab, width]);
+    metadata.extend(&[width, 1]);
+    metadata.extend(&[rows, width]);
+    metadata.extend(&[width, 1]);
+    metadata.extend(&[width, 1]);
+    metadata.extend(&[0, 0, 0, 0]);
+
+    let mut output = vec![0.0f32; vocab * width];
+    call_ops_scatter(
+        scatter_add::F32,
+        input.as_ptr() as *const core::ffi::c_void,
+        indices.as_ptr(),
+        src.as_ptr() as *const core::ffi::c_void,
+        output.as_mut_ptr() as *mut core::ffi::c_void,
+        &metadata,
+    )
+    .unwrap();
+
+    let mut expected = input.clone();
+    for i in 0..num_els {
+        expected[indices[i] as usize * width + i % width] += src[i];
+    }
+    let bits = |v: &[f32]| v.iter().map(|x| x.to_bits()).collect::<Vec<_>>();
+    assert_eq!(bits(&output), bits(&expected));
+}
+
 #[test]
 fn test_scatter_max_f32_1d() {
     // Input: [1, 2, 3, 4, 5]
@@ -1219,6 +1334,37 @@ fn test_unique_i32_basic() {
     assert_eq!(&counts[..unique_count], &[2, 2, 2, 1]);
 }
 
+#[test]
+fn test_unique_i32_negative_large() {
+    // 10000 values in -7..=7 (enough for the hash path): values come out in numeric order
+    // with negatives first, and inverse/counts agree with the input
+    let num_els = 10000;
+    let input: Vec<i32> = (0..num_els).map(|i| (i * 7919 % 15) as i32 - 7).collect();
+
+    let mut values = vec![0i32; num_els];
+    let mut inverse = vec![0i32; num_els];
+    let mut counts = vec![0i32; num_els];
+    let metadata = vec![num_els, 1, num_els, 1, 0];
+
+    let unique_count = call_unique(
+        unique::I32,
+        input.as_ptr() as *const core::ffi::c_void,
+        values.as_mut_ptr() as *mut core::ffi::c_void,
+        inverse.as_mut_ptr(),
+        counts.as_mut_ptr(),
+        &metadata,
+    );
+
+    assert_eq!(unique_count, 15);
+    assert_eq!(&values[..unique_count], &(-7..=7).collect::<Vec<i32>>()[..]);
+    for (x, &inv) in input.iter().zip(&inverse) {
+        assert_eq!(values[inv as usize], *x);
+    }
+    for (u, &count) in counts[..unique_count].iter().enumerate() {
+        assert_eq!(count as usize, input.iter().filter(|&&x| x == values[u]).count());
+    }
+}
+
 #[test]
 fn test_unique_f32_basic() {
     // Input: [3.0, 1.0, 2.0, 1.0, 3.0]
@@ -374,3 +374,154 @@ fn test_inv_f32_batch() {
     let expected = [0.5, 0.0, 0.0, 0.5, 1.0, -1.0, 0.0, 1.0];
     assert_eq!(approx(output.to_vec(), 4), expected.to_vec());
 }
+
+#[test]
+fn test_inv_f64_batch_5x5() {
+    // 37 matrices (a partial lane group) of 5x5, checked through A @ inv(A) = I
+    let (batch, n) = (37usize, 5usize);
+    let input: Vec<f64> = (0..batch * n * n)
+        .map(|i| ((i * 7919) % 13) as f64 - 6.0 + if i % (n + 1) == 0 { 10.0 } else { 0.0 })
+        .collect();
+    let mut output = vec![0.0f64; batch * n * n];
+    let metadata = vec![batch, n, 3, batch, n, n, n * n, n, 1, 0];
+
+    call_ops_inv(
+        inv::F64,
+        input.as_ptr() as *const core::ffi::c_void,
+        output.as_mut_ptr() as *mut core::ffi::c_void,
+        &metadata,
+    )
+    .unwrap();
+
+    for b in 0..batch {
+        let a = &input[b * n * n..(b + 1) * n * n];
+        let x = &output[b * n * n..(b + 1) * n * n];
+        for i in 0..n {
+            for j in 0..n {
+                let v: f64 = (0..n).map(|k| a[i * n + k] * x[k * n + j]).sum();
+                let expected = if i == j { 1.0 } else { 0.0 };
+                assert!((v - expected).abs() < 1e-9, "batch {} ({}, {}): {}", b, i, j, v);
+            }
+        }
+    }
+}
+
+#[test]
+fn test_det_f64_blocked() {
+    // I + u v^T with u = v = 0.01: det = 1 + n * 1e-4; rows reversed to exercise pivoting
+    let n = 160usize;
+    let mut input = vec![0.0f64; n * n];
+    for i in 0..n {
+        for j in 0..n {
+            input[(n - 1 - i) * n + j] = if i == j { 1.0 } else { 0.0 } + 1e-4;
+        }
+    }
+    let mut output = [0.0f64; 1];
+    let metadata = vec![1, n, 2, n, n, n, 1, 0];
+
+    call_ops_det(
+        det::F64,
+        input.as_ptr() as *const core::ffi::c_void,
+        output.as_mut_ptr() as *mut core::ffi::c_void,
+        &metadata,
+    )
+    .unwrap();
+
+    // Reversing 160 rows is 80 swaps: the sign is unchanged
+    assert!((output[0] - (1.0 + n as f64 * 1e-4)).abs() < 1e-10, "{}", output[0]);
+}
+
+// Solve / Cholesky / QR Tests
+
+#[test]
+fn test_solve_f64_batch() {
+    // [[2, 1], [1, 3]] x = [[3, 5], [4, 10]] -> x = [[1, 1], [1, 3]]; second matrix swapped rows
+    let a = [2.0f64, 1.0, 1.0, 3.0, 1.0, 3.0, 2.0, 1.0];
+    let b = [3.0f64, 5.0, 4.0, 10.0, 4.0, 10.0, 3.0, 5.0];
+    let mut output = [0.0f64; 8];
+    let metadata = vec![2, 2, 2, 3, 2, 2, 2, 4, 2, 1, 0, 2, 2, 2, 4, 2, 1, 0];
+
+    call_ops_solve(
+        solve::F64,
+        a.as_ptr() as *const core::ffi::c_void,
+        b.as_ptr() as *const core::ffi::c_void,
+        output.as_mut_ptr() as *mut core::ffi::c_void,
+        &metadata,
+    )
+    .unwrap();
+
+    for (x, e) in output.iter().zip([1.0, 1.0, 1.0, 3.0, 1.0, 1.0, 1.0, 3.0]) {
+        assert!((x - e).abs() < 1e-12, "{:?}", output);
+    }
+}
+
+#[test]
+fn test_cholesky_f64_blocked() {
+    // A = L L^T for a known lower-triangular L larger than one block
+    let n = 100usize;
+    let mut l = vec![0.0f64; n * n];
+    for i in 0..n {
+        for j in 0..=i {
+            l[i * n + j] = if i == j {
+                2.0
+            } else {
+                ((i * 7 + j * 3) % 11) as f64 / 11.0 - 0.5
+            };
+        }
+    }
+    let mut a = vec![0.0f64; n * n];
+    for i in 0..n {
+        for j in 0..n {
+            a[i * n + j] = (0..n).map(|p| l[i * n + p] * l[j * n + p]).sum();
+        }
+    }
+    let mut output = vec![0.0f64; n * n];
+    let metadata = vec![1, n, 2, n, n, n, 1, 0];
+
+    call_ops_cholesky(
+        cholesky::F64,
+        a.as_ptr() as *const core::ffi::c_void,
+        output.as_mut_ptr() as *mut core::ffi::c_void,
+        &metadata,
+    )
+    .unwrap();
+
+    for (x, e) in output.iter().zip(&l) {
+        assert!((x - e).abs() < 1e-9, "{} vs {}", x, e);
+    }
+}
+
+#[test]
+fn test_qr_f32_tall() {
+    let (m, n) = (5usize, 3usize);
+    let a: Vec<f32> = (0..m * n).map(|i| ((i * 5 + 2) % 7) as f32 - 3.0).collect();
+    let mut q = vec![0.0f32; m * n];
+    let mut r = vec![0.0f32; n * n];
+    let metadata = vec![1, m, n, 2, m, n, n, 1, 0];
+
+    call_ops_qr(
+        qr::F32,
+        a.as_ptr() as *const core::ffi::c_void,
+        q.as_mut_ptr() as *mut core::ffi::c_void,
+        r.as_mut_ptr() as *mut core::ffi::c_void,
+        &metadata,
+    )
+    .unwrap();
+
+    // Q R reconstructs A, Q has orthonormal columns and R is upper triangular
+    for i in 0..m {
+        for j in 0..n {
+            let qr: f32 = (0..n).map(|p| q[i * n + p] * r[p * n + j]).sum();
+            assert!((qr - a[i * n + j]).abs() < 1e-4, "A[{}][{}]", i, j);
+        }
+    }
+    for i in 0..n {
+        for j in 0..n {
+            let qtq: f32 = (0..m).map(|p| q[p * n + i] * q[p * n + j]).sum();
+            assert!((qtq - if i == j { 1.0 } else { 0.0 }).abs() < 1e-5);
+            if j < i {
+                assert_eq!(r[i * n + j], 0.0);
+            }
+        }
+    }
+}
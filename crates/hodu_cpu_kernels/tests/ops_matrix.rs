@@ -145,3 +145,257 @@ fn test_dot_f32_simple() {
     //         = [[58, 64], [139, 154]]
     assert_eq!(approx(output, 4), vec![58.0, 64.0, 139.0, 154.0]);
 }
+
+#[test]
+fn test_matmul_packed_f32() {
+    // Batched A: 2x2x3, shared B: 3x2 = [[7, 8], [9, 10], [11, 12]]
+    let lhs = [1.0f32, 2.0, 3.0, 4.0, 5.0, 6.0, 1.0, 0.0, 0.0, 0.0, 0.0, 1.0];
+    let rhs = [7.0f32, 8.0, 9.0, 10.0, 11.0, 12.0];
+
+    let (batch, m, k, n) = (2, 2, 3, 2);
+    let pack_metadata = vec![k, n, 2, 1, 0];
+    let size = matmul_packed_rhs_size(matmul_packed::F32, k, n);
+    let mut packed = vec![0.0f32; size.div_ceil(4)];
+    call_ops_matmul_pack_rhs(
+        matmul_packed::F32,
+        rhs.as_ptr() as *const core::ffi::c_void,
+        packed.as_mut_ptr() as *mut core::ffi::c_void,
+        &pack_metadata,
+    )
+    .unwrap();
+
+    // Regular matmul metadata: lhs [2, 2, 3] @ rhs [3, 2]
+    let mut metadata = vec![batch * m * n, 3, 2, 1];
+    metadata.extend([batch, m, k]);
+    metadata.extend([k, n]);
+    metadata.push(batch);
+    metadata.extend([m * k, k, 1]);
+    metadata.extend([n, 1]);
+    metadata.extend([0, 0, m, k, n]);
+
+    let mut output = vec![0.0f32; batch * m * n];
+    call_ops_matmul_packed(
+        matmul_packed::F32,
+        lhs.as_ptr() as *const core::ffi::c_void,
+        packed.as_ptr() as *const core::ffi::c_void,
+        output.as_mut_ptr() as *mut core::ffi::c_void,
+        &metadata,
+        None,
+    )
+    .unwrap();
+
+    assert_eq!(approx(output, 4), vec![58.0, 64.0, 139.0, 154.0, 7.0, 8.0, 11.0, 12.0]);
+}
+
+#[test]
+fn test_matmul_mixed_f32_bf16() {
+    // f32 A: 2x3 against bf16 B: 3x2 = [[7, 8], [9, 10], [11, 12]] (exact in bf16)
+    let lhs = [1.0f32, 2.0, 3.0, 4.0, 5.0, 6.0];
+    let rhs: Vec<half::bf16> = [7.0f32, 8.0, 9.0, 10.0, 11.0, 12.0]
+        .iter()
+        .map(|&x| half::bf16::from_f32(x))
+        .collect();
+
+    let (m, k, n) = (2, 3, 2);
+    let mut metadata = vec![m * n, 2, 2, 0];
+    metadata.extend([m, k]);
+    metadata.extend([k, n]);
+    metadata.extend([k, 1]);
+    metadata.extend([n, 1]);
+    metadata.extend([0, 0, m, k, n]);
+
+    let mut output = vec![0.0f32; m * n];
+    call_ops_matmul(
+        matmul_mixed::F32_BF16,
+        lhs.as_ptr() as *const core::ffi::c_void,
+        rhs.as_ptr() as *const core::ffi::c_void,
+        output.as_mut_ptr() as *mut core::ffi::c_void,
+        &metadata,
+    )
+    .unwrap();
+
+    assert_eq!(output, vec![58.0, 64.0, 139.0, 154.0]);
+}
+
+#[test]
+fn test_matmul_fused_f32() {
+    // relu(0.5 * (A @ B) + bias + residual), A @ B = [[58, 64], [139, 154]]
+    let lhs = [1.0f32, 2.0, 3.0, 4.0, 5.0, 6.0];
+    let rhs = [7.0f32, 8.0, 9.0, 10.0, 11.0, 12.0];
+    let bias = [-30.0f32, 1.0];
+    let residual = [0.5f32, 0.0, -40.0, 2.0];
+
+    let (m, k, n) = (2, 3, 2);
+    let metadata = vec![m * n, 2, 2, 0, m, k, k, n, k, 1, n, 1, 0, 0, m, k, n];
+    let epilogue = Epilogue {
+        scale: 0.5,
+        bias: bias.as_ptr() as *const core::ffi::c_void,
+        residual: residual.as_ptr() as *const core::ffi::c_void,
+        activation: Activation::Relu,
+    };
+
+    let mut output = vec![0.0f32; m * n];
+    call_ops_matmul_fused(
+        matmul_fused::F32,
+        lhs.as_ptr() as *const core::ffi::c_void,
+        rhs.as_ptr() as *const core::ffi::c_void,
+        output.as_mut_ptr() as *mut core::ffi::c_void,
+        &metadata,
+        &epilogue,
+    )
+    .unwrap();
+
+    // [[29 - 30 + 0.5, 32 + 1], [69.5 - 30 - 40, 77 + 1 + 2]] -> relu
+    assert_eq!(approx(output, 4), vec![0.0, 33.0, 0.0, 80.0]);
+}
+
+#[test]
+fn test_qmatmul_u8i8_zero_points() {
+    // A (u8, zero point 10): 2x3 = [[11, 12, 13], [14, 15, 16]] -> real [[1, 2, 3], [4, 5, 6]]
+    let lhs = [11u8, 12, 13, 14, 15, 16];
+    // B (i8, per-column zero points [0, 2]): 3x2 -> real [[7, 8], [9, 10], [11, 12]]
+    let rhs = [7i8, 10, 9, 12, 11, 14];
+    let rhs_scales = [1.0f32, 0.5];
+    let rhs_zero_points = [0i32, 2];
+
+    let m = 2;
+    let k = 3;
+    let n = 2;
+    let metadata = vec![m, k, n, 3, 1, 2, 1, 0, 0];
+    let params = QuantParams {
+        lhs_scale: 2.0,
+        lhs_zero_point: 10,
+        rhs_scales: rhs_scales.as_ptr(),
+        rhs_zero_points: rhs_zero_points.as_ptr(),
+        rhs_channels: n,
+        output_scale: 4.0,
+        output_zero_point: 1,
+    };
+
+    let mut acc = vec![0i32; m * n];
+    call_ops_qmatmul(
+        qmatmul::U8I8_I32,
+        lhs.as_ptr() as *const core::ffi::c_void,
+        rhs.as_ptr() as *const core::ffi::c_void,
+        acc.as_mut_ptr() as *mut core::ffi::c_void,
+        &metadata,
+        &params,
+    )
+    .unwrap();
+    assert_eq!(acc, vec![58, 64, 139, 154]);
+
+    // f32: lhs_scale * rhs_scale[j] * acc
+    let mut output = vec![0.0f32; m * n];
+    call_ops_qmatmul(
+        qmatmul::U8I8_F32,
+        lhs.as_ptr() as *const core::ffi::c_void,
+        rhs.as_ptr() as *const core::ffi::c_void,
+        output.as_mut_ptr() as *mut core::ffi::c_void,
+        &metadata,
+        &params,
+    )
+    .unwrap();
+    assert_eq!(approx(output, 4), vec![116.0, 64.0, 278.0, 154.0]);
+
+    // i8: round_half_even(f32 / 4) + 1, saturated
+    let mut quantized = vec![0i8; m * n];
+    call_ops_qmatmul(
+        qmatmul::U8I8_I8,
+        lhs.as_ptr() as *const core::ffi::c_void,
+        rhs.as_ptr() as *const core::ffi::c_void,
+        quantized.as_mut_ptr() as *mut core::ffi::c_void,
+        &metadata,
+        &params,
+    )
+    .unwrap();
+    assert_eq!(quantized, vec![30, 17, 71, 39]);
+}
+
+#[test]
+fn test_matmul_quant_q4_q8() {
+    let (m, k, n, group_size) = (3, 64, 5, 32);
+    let groups = k / group_size;
+    let lhs: Vec<f32> = (0..m * k).map(|i| ((i * 5) % 9) as f32 * 0.25 - 1.0).collect();
+    let scales: Vec<half::f16> = (0..n * groups)
+        .map(|i| half::f16::from_f32(0.5 / (1 + i % 3) as f32))
+        .collect();
+    let zeros: Vec<half::f16> = (0..n * groups).map(|i| half::f16::from_f32((i % 4) as f32)).collect();
+
+    // int8 weights, and int4 weights packed in blocks of 32 (values i and i + 16 share a byte)
+    let q8: Vec<i8> = (0..n * k).map(|i| ((i * 7) % 15) as i8 - 7).collect();
+    let q4: Vec<u8> = (0..n * k).map(|i| ((i * 5) % 16) as u8).collect();
+    let mut q4_packed = vec![0u8; n * k / 2];
+    for block in 0..n * k / 32 {
+        for i in 0..16 {
+            q4_packed[block * 16 + i] = q4[block * 32 + i] | (q4[block * 32 + i + 16] << 4);
+        }
+    }
+
+    let reference = |q: &dyn Fn(usize) -> f32, zero_points: bool, default_zero: f32| -> Vec<f32> {
+        let mut out = vec![0.0f32; m * n];
+        for i in 0..m {
+            for j in 0..n {
+                for kk in 0..k {
+                    let g = j * groups + kk / group_size;
+                    let zero = if zero_points { zeros[g].to_f32() } else { default_zero };
+                    out[i * n + j] += lhs[i * k + kk] * scales[g].to_f32() * (q(j * k + kk) - zero);
+                }
+            }
+        }
+        out
+    };
+
+    let metadata = vec![m, k, n, k, 1, 0];
+    for (kernel, rhs, zero_points) in [
+        (matmul_quant::F32_Q8, q8.as_ptr() as *const core::ffi::c_void, true),
+        (
+            matmul_quant::F32_Q4,
+            q4_packed.as_ptr() as *const core::ffi::c_void,
+            true,
+        ),
+        (
+            matmul_quant::F32_Q4,
+            q4_packed.as_ptr() as *const core::ffi::c_void,
+            false,
+        ),
+    ] {
+        let params = GroupQuantParams {
+            scales: scales.as_ptr(),
+            zero_points: if zero_points { zeros.as_ptr() } else { core::ptr::null() },
+            group_size,
+        };
+        let mut output = vec![0.0f32; m * n];
+        call_ops_matmul_quant(
+            kernel,
+            lhs.as_ptr() as *const core::ffi::c_void,
+            rhs,
+            output.as_mut_ptr() as *mut core::ffi::c_void,
+            &metadata,
+            &params,
+        )
+        .unwrap();
+        let expected = if kernel.0 == matmul_quant::F32_Q8.0 {
+            reference(&|i| q8[i] as f32, zero_points, 0.0)
+        } else {
+            reference(&|i| q4[i] as f32, zero_points, 8.0)
+        };
+        assert_eq!(approx(output, 3), approx(expected, 3));
+    }
+
+    // Groups must be multiples of 32 dividing k
+    let params = GroupQuantParams {
+        scales: scales.as_ptr(),
+        zero_points: core::ptr::null(),
+        group_size: 48,
+    };
+    let mut output = vec![0.0f32; m * n];
+    assert!(call_ops_matmul_quant(
+        matmul_quant::F32_Q8,
+        lhs.as_ptr() as *const core::ffi::c_void,
+        q8.as_ptr() as *const core::ffi::c_void,
+        output.as_mut_ptr() as *mut core::ffi::c_void,
+        &metadata,
+        &params,
+    )
+    .is_err());
+}
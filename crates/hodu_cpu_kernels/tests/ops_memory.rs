@@ -0,0 +1,37 @@
+use hodu_cpu_kernels::*;
+
+#[test]
+fn test_contiguous_f32_permuted_slice() {
+    // Base buffer [4, 37, 45] viewed as permute(2, 0, 1) of the slice [1:4]: shape [45, 3, 37]
+    // with the unit-stride dim outermost (runs as a blocked transpose)
+    let (d0, d1, d2) = (4usize, 37usize, 45usize);
+    let input: Vec<f32> = (0..d0 * d1 * d2).map(|i| i as f32).collect();
+    let shape = [d2, 3, d1];
+    let strides = [1, d1 * d2, d2];
+    let offset = d1 * d2;
+    let num_els = shape.iter().product::<usize>();
+
+    let mut metadata = vec![num_els, shape.len()];
+    metadata.extend(&shape);
+    metadata.extend(&strides);
+    metadata.push(offset);
+
+    let mut output = vec![0.0f32; num_els];
+    call_ops_contiguous(
+        contiguous::F32,
+        input.as_ptr() as *const core::ffi::c_void,
+        output.as_mut_ptr() as *mut core::ffi::c_void,
+        &metadata,
+    )
+    .unwrap();
+
+    let mut expected = Vec::with_capacity(num_els);
+    for k in 0..d2 {
+        for i in 0..3 {
+            for j in 0..d1 {
+                expected.push(input[offset + i * d1 * d2 + j * d2 + k]);
+            }
+        }
+    }
+    assert_eq!(output, expected);
+}
@@ -0,0 +1,134 @@
+use hodu_cpu_kernels::*;
+
+fn approx(v: Vec<f32>, digits: i32) -> Vec<f32> {
+    let b = 10f32.powi(digits);
+    v.iter().map(|t| f32::round(t * b) / b).collect()
+}
+
+// Helper function to calculate strides from shape
+fn calculate_strides(shape: &[usize]) -> Vec<usize> {
+    if shape.is_empty() {
+        return vec![];
+    }
+    let mut strides = vec![1; shape.len()];
+    for i in (0..shape.len() - 1).rev() {
+        strides[i] = strides[i + 1] * shape[i + 1];
+    }
+    strides
+}
+
+// Helper function to build norm metadata
+// Layout: [num_els, num_dims, shape..., strides..., offset, dim]
+fn build_norm_metadata(shape: &[usize], dim: usize) -> Vec<usize> {
+    let num_els: usize = shape.iter().product();
+    let mut metadata = vec![num_els, shape.len()];
+    metadata.extend(shape);
+    metadata.extend(calculate_strides(shape));
+    metadata.push(0);
+    metadata.push(dim);
+    metadata
+}
+
+// softmax - last dim
+#[test]
+fn test_softmax_f32() {
+    let input = [1.0f32, 2.0, 3.0, 1.0, 1.0, 1.0];
+    let mut output = vec![0.0f32; 6];
+    let metadata = build_norm_metadata(&[2, 3], 1);
+
+    call_ops_softmax(
+        softmax::F32,
+        input.as_ptr() as *const core::ffi::c_void,
+        output.as_mut_ptr() as *mut core::ffi::c_void,
+        &metadata,
+    )
+    .unwrap();
+
+    // Row 0: e^x / (e + e^2 + e^3); row 1: uniform
+    assert_eq!(approx(output, 4), vec![0.09, 0.2447, 0.6652, 0.3333, 0.3333, 0.3333]);
+}
+
+// softmax - strided dim (dim 0 of [2, 2])
+#[test]
+fn test_softmax_dim0_f32() {
+    let input = [1.0f32, 2.0, 1.0, 4.0];
+    let mut output = vec![0.0f32; 4];
+    let metadata = build_norm_metadata(&[2, 2], 0);
+
+    call_ops_softmax(
+        softmax::F32,
+        input.as_ptr() as *const core::ffi::c_void,
+        output.as_mut_ptr() as *mut core::ffi::c_void,
+        &metadata,
+    )
+    .unwrap();
+
+    // Column 0: [1, 1] -> [0.5, 0.5]; column 1: [2, 4] -> [0.1192, 0.8808]
+    assert_eq!(approx(output, 4), vec![0.5, 0.1192, 0.5, 0.8808]);
+}
+
+// log_softmax
+#[test]
+fn test_log_softmax_f32() {
+    let input = [1.0f32, 2.0, 3.0];
+    let mut output = vec![0.0f32; 3];
+    let metadata = build_norm_metadata(&[3], 0);
+
+    call_ops_softmax(
+        log_softmax::F32,
+        input.as_ptr() as *const core::ffi::c_void,
+        output.as_mut_ptr() as *mut core::ffi::c_void,
+        &metadata,
+    )
+    .unwrap();
+
+    // x - 3 - log(1 + e^-1 + e^-2)
+    assert_eq!(approx(output, 4), vec![-2.4076, -1.4076, -0.4076]);
+}
+
+// layer_norm - with weight and bias
+#[test]
+fn test_layer_norm_f32() {
+    let input = [1.0f32, 2.0, 3.0, 4.0, 10.0, 20.0, 30.0, 40.0];
+    let weight = [1.0f32, 1.0, 2.0, 2.0];
+    let bias = [0.0f32, 0.0, 0.0, 1.0];
+    let mut output = vec![0.0f32; 8];
+    let metadata = build_norm_metadata(&[2, 4], 1);
+
+    call_ops_layer_norm(
+        layer_norm::F32,
+        input.as_ptr() as *const core::ffi::c_void,
+        weight.as_ptr() as *const core::ffi::c_void,
+        bias.as_ptr() as *const core::ffi::c_void,
+        output.as_mut_ptr() as *mut core::ffi::c_void,
+        &metadata,
+        0.0,
+    )
+    .unwrap();
+
+    // Both rows normalize to [-1.3416, -0.4472, 0.4472, 1.3416] before the affine transform
+    let expected = vec![-1.3416, -0.4472, 0.8944, 3.6833];
+    assert_eq!(approx(output[..4].to_vec(), 4), expected);
+    assert_eq!(approx(output[4..].to_vec(), 4), expected);
+}
+
+// rms_norm - without weight
+#[test]
+fn test_rms_norm_f32() {
+    let input = [1.0f32, 2.0, 3.0, 4.0];
+    let mut output = vec![0.0f32; 4];
+    let metadata = build_norm_metadata(&[1, 4], 1);
+
+    call_ops_rms_norm(
+        rms_norm::F32,
+        input.as_ptr() as *const core::ffi::c_void,
+        core::ptr::null(),
+        output.as_mut_ptr() as *mut core::ffi::c_void,
+        &metadata,
+        0.0,
+    )
+    .unwrap();
+
+    // rms = sqrt(30 / 4) = 2.7386
+    assert_eq!(approx(output, 4), vec![0.3651, 0.7303, 1.0954, 1.4606]);
+}
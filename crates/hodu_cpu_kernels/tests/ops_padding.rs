@@ -435,3 +435,68 @@ fn test_pad_circular_i32() {
 
     assert_eq!(output, vec![30, 40, 10, 20, 30, 40, 10, 20]);
 }
+
+#[test]
+fn test_pad_reflect_and_constant_f32_large_4d() {
+    // [2, 3, 40, 50] padded by (2, 3) on dim 2 and (4, 1) on dim 3
+    let in_shape = [2usize, 3, 40, 50];
+    let before = [0usize, 0, 2, 4];
+    let out_shape = [2usize, 3, 45, 55];
+    let input: Vec<f32> = (0..in_shape.iter().product::<usize>()).map(|i| i as f32).collect();
+    let num_els: usize = out_shape.iter().product();
+
+    let mut metadata = vec![num_els, 4];
+    metadata.extend(&in_shape);
+    metadata.extend(&out_shape);
+    metadata.extend(&before);
+
+    let reflect = |x: isize, n: usize| -> usize {
+        let x = x.unsigned_abs();
+        if x < n {
+            x
+        } else {
+            2 * (n - 1) - x
+        }
+    };
+    let mut reflected = vec![0.0f32; num_els];
+    let mut constant = vec![0.0f32; num_els];
+    let pad_value = 7.5f32;
+    call_ops_pad_reflect(
+        pad_reflect::F32,
+        input.as_ptr() as *const core::ffi::c_void,
+        reflected.as_mut_ptr() as *mut core::ffi::c_void,
+        &metadata,
+    )
+    .unwrap();
+    call_ops_pad_constant(
+        pad_constant::F32,
+        input.as_ptr() as *const core::ffi::c_void,
+        constant.as_mut_ptr() as *mut core::ffi::c_void,
+        &pad_value as *const f32 as *const core::ffi::c_void,
+        &metadata,
+    )
+    .unwrap();
+
+    for plane in 0..6 {
+        for y in 0..out_shape[2] {
+            for x in 0..out_shape[3] {
+                let o = (plane * out_shape[2] + y) * out_shape[3] + x;
+                let iy = y as isize - before[2] as isize;
+                let ix = x as isize - before[3] as isize;
+                let src = |iy: usize, ix: usize| input[(plane * in_shape[2] + iy) * in_shape[3] + ix];
+                let ry = reflect(iy, in_shape[2]);
+                let rx = reflect(ix, in_shape[3]);
+                assert_eq!(reflected[o], src(ry, rx));
+                let inside = iy >= 0 && ix >= 0 && (iy as usize) < in_shape[2] && (ix as usize) < in_shape[3];
+                assert_eq!(
+                    constant[o],
+                    if inside {
+                        src(iy as usize, ix as usize)
+                    } else {
+                        pad_value
+                    }
+                );
+            }
+        }
+    }
+}
@@ -1,3 +1,4 @@
+use half::{bf16, f16};
 use hodu_cpu_kernels::*;
 
 fn approx(v: Vec<f32>, digits: i32) -> Vec<f32> {
@@ -250,6 +251,54 @@ fn test_reduce_mean_f32() {
     assert_eq!(approx(output, 4), vec![4.0, 10.0]);
 }
 
+#[test]
+fn test_reduce_sum_mean_norm_low_precision_long() {
+    // Accumulating in bf16/f16 stalls at 256/2048 once 1.0 falls below half an ulp
+    let n = 100_000;
+    for (shape, dim) in [(vec![2, n], 1usize), (vec![n, 2], 0)] {
+        let strides = calculate_strides(&shape);
+        let output_shape = calculate_output_shape(&shape, &[dim], false);
+        let mut metadata = vec![shape.len()];
+        metadata.extend(&shape);
+        metadata.extend(&strides);
+        metadata.push(0);
+        metadata.push(output_shape.len());
+        metadata.extend(&output_shape);
+        metadata.extend([1, dim, 0, n]);
+
+        let expected = [(n as f32), 1.0, (n as f32).sqrt()];
+        let input = vec![bf16::ONE; 2 * n];
+        for (kernel, want) in [
+            (sum::BF16, expected[0]),
+            (mean::BF16, expected[1]),
+            (norm::BF16, expected[2]),
+        ] {
+            let mut output = vec![bf16::ZERO; 2];
+            call_ops_reduce(
+                kernel,
+                input.as_ptr() as *const core::ffi::c_void,
+                output.as_mut_ptr() as *mut core::ffi::c_void,
+                &metadata,
+            )
+            .unwrap();
+            assert_eq!(output, vec![bf16::from_f32(want); 2], "dim={}", dim);
+        }
+
+        let input = vec![f16::ONE; 2 * n];
+        for (kernel, want) in [(mean::F16, expected[1]), (norm::F16, expected[2])] {
+            let mut output = vec![f16::ZERO; 2];
+            call_ops_reduce(
+                kernel,
+                input.as_ptr() as *const core::ffi::c_void,
+                output.as_mut_ptr() as *mut core::ffi::c_void,
+                &metadata,
+            )
+            .unwrap();
+            assert_eq!(output, vec![f16::from_f32(want); 2], "dim={}", dim);
+        }
+    }
+}
+
 // reduce - max
 #[test]
 fn test_reduce_max_f32() {
@@ -475,6 +524,42 @@ fn test_reduce_var_f32() {
     assert_eq!(approx(output, 2), vec![0.67, 0.67]);
 }
 
+#[test]
+fn test_reduce_var_f32_large_mean() {
+    // Rows of 10000 + [0, 1, 2, 3]: E[X²] - E[X]² loses everything to cancellation in f32,
+    // the central moments keep var = 1.25 exactly
+    let input: Vec<f32> = (0..8).map(|i| 10000.0 + (i % 4) as f32).collect();
+    let shape = vec![2, 4];
+    let reduce_dims = vec![1];
+    let keep_dim = false;
+    let strides = calculate_strides(&shape);
+    let output_shape = calculate_output_shape(&shape, &reduce_dims, keep_dim);
+    let output_size: usize = output_shape.iter().product();
+    let reduce_size: usize = reduce_dims.iter().map(|&d| shape[d]).product();
+    let mut output = vec![0.0f32; output_size];
+
+    let mut metadata = vec![shape.len()];
+    metadata.extend(&shape);
+    metadata.extend(&strides);
+    metadata.push(0);
+    metadata.push(output_shape.len());
+    metadata.extend(&output_shape);
+    metadata.push(reduce_dims.len());
+    metadata.extend(&reduce_dims);
+    metadata.push(if keep_dim { 1 } else { 0 });
+    metadata.push(reduce_size);
+
+    call_ops_reduce(
+        var::F32,
+        input.as_ptr() as *const core::ffi::c_void,
+        output.as_mut_ptr() as *mut core::ffi::c_void,
+        &metadata,
+    )
+    .unwrap();
+
+    assert_eq!(approx(output, 4), vec![1.25, 1.25]);
+}
+
 // reduce - norm
 #[test]
 fn test_reduce_norm_f32() {
@@ -549,6 +634,93 @@ fn test_reduce_argmax_f32() {
     assert_eq!(output, vec![1, 1]);
 }
 
+#[test]
+fn test_reduce_argmax_f32_dim0_wide() {
+    // Reducing the outer dim of a [3, 100] tensor vectorizes across the 100 outputs
+    let input: Vec<f32> = (0..300).map(|i| ((i / 100 + i % 100) % 3) as f32).collect();
+    let shape = vec![3, 100];
+    let reduce_dims = vec![0];
+    let keep_dim = false;
+    let strides = calculate_strides(&shape);
+    let output_shape = calculate_output_shape(&shape, &reduce_dims, keep_dim);
+    let output_size: usize = output_shape.iter().product();
+    let reduce_size: usize = reduce_dims.iter().map(|&d| shape[d]).product();
+    let mut output = vec![0i32; output_size];
+
+    let mut metadata = vec![shape.len()];
+    metadata.extend(&shape);
+    metadata.extend(&strides);
+    metadata.push(0);
+    metadata.push(output_shape.len());
+    metadata.extend(&output_shape);
+    metadata.push(reduce_dims.len());
+    metadata.extend(&reduce_dims);
+    metadata.push(if keep_dim { 1 } else { 0 });
+    metadata.push(reduce_size);
+
+    call_ops_reduce(
+        argmax::F32,
+        input.as_ptr() as *const core::ffi::c_void,
+        output.as_mut_ptr() as *mut core::ffi::c_void,
+        &metadata,
+    )
+    .unwrap();
+
+    // Column j holds (i + j) % 3 in row i, so the max (2) sits in row (2 - j) mod 3
+    let expected: Vec<i32> = (0..100).map(|j| ((5 - j % 3) % 3) as i32).collect();
+    assert_eq!(output, expected);
+}
+
+#[test]
+fn test_reduce_argmax_argmin_f32_long_rows() {
+    // Rows long enough for the vector path: repeated extremes, a leading NaN and scattered NaNs
+    let n = 5000;
+    let mut input: Vec<f32> = (0..n).map(|i| ((i * 7 + 3) % 97) as f32).collect();
+    input.push(f32::NAN);
+    input.extend((1..n).map(|i| i as f32));
+    input.extend((0..n).map(|i| if i % 13 == 5 { f32::NAN } else { 0.5 }));
+    for (i, v) in [(4321, 1000.0), (4900, 1000.0), (777, -1000.0), (3000, -1000.0)] {
+        input[2 * n + i] = v;
+    }
+    let shape = vec![3, n];
+    let reduce_dims = vec![1];
+    let keep_dim = false;
+    let strides = calculate_strides(&shape);
+    let output_shape = calculate_output_shape(&shape, &reduce_dims, keep_dim);
+    let output_size: usize = output_shape.iter().product();
+    let reduce_size: usize = reduce_dims.iter().map(|&d| shape[d]).product();
+    let mut metadata = vec![shape.len()];
+    metadata.extend(&shape);
+    metadata.extend(&strides);
+    metadata.push(0);
+    metadata.push(output_shape.len());
+    metadata.extend(&output_shape);
+    metadata.push(reduce_dims.len());
+    metadata.extend(&reduce_dims);
+    metadata.push(if keep_dim { 1 } else { 0 });
+    metadata.push(reduce_size);
+
+    let mut output = vec![0i32; output_size];
+    call_ops_reduce(
+        argmax::F32,
+        input.as_ptr() as *const core::ffi::c_void,
+        output.as_mut_ptr() as *mut core::ffi::c_void,
+        &metadata,
+    )
+    .unwrap();
+    // 7i + 3 = 96 (mod 97) first at i = 41; a leading NaN is never beaten; first of the ties
+    assert_eq!(output, vec![41, 0, 4321]);
+
+    call_ops_reduce(
+        argmin::F32,
+        input.as_ptr() as *const core::ffi::c_void,
+        output.as_mut_ptr() as *mut core::ffi::c_void,
+        &metadata,
+    )
+    .unwrap();
+    assert_eq!(output, vec![55, 0, 777]);
+}
+
 // reduce - argmin
 #[test]
 fn test_reduce_argmin_f32() {
@@ -797,6 +969,53 @@ fn test_reduce_all_i32() {
     assert_eq!(output, vec![1, 1]);
 }
 
+#[test]
+fn test_reduce_any_all_f32_long_rows() {
+    // The deciding element sits in the tail of a long row, or nowhere
+    let n = 4099;
+    let mut input = vec![0.0f32; 2 * n];
+    input[n - 1] = 1.0;
+    let shape = vec![2, n];
+    let reduce_dims = vec![1];
+    let keep_dim = false;
+    let strides = calculate_strides(&shape);
+    let output_shape = calculate_output_shape(&shape, &reduce_dims, keep_dim);
+    let output_size: usize = output_shape.iter().product();
+    let reduce_size: usize = reduce_dims.iter().map(|&d| shape[d]).product();
+    let mut metadata = vec![shape.len()];
+    metadata.extend(&shape);
+    metadata.extend(&strides);
+    metadata.push(0);
+    metadata.push(output_shape.len());
+    metadata.extend(&output_shape);
+    metadata.push(reduce_dims.len());
+    metadata.extend(&reduce_dims);
+    metadata.push(if keep_dim { 1 } else { 0 });
+    metadata.push(reduce_size);
+
+    let mut output = vec![0u8; output_size];
+    call_ops_reduce(
+        any::F32,
+        input.as_ptr() as *const core::ffi::c_void,
+        output.as_mut_ptr() as *mut core::ffi::c_void,
+        &metadata,
+    )
+    .unwrap();
+    assert_eq!(output, vec![1, 0]);
+
+    // NaN counts as non-zero
+    let mut input: Vec<f32> = (0..2 * n).map(|i| if i % 3 == 0 { f32::NAN } else { 2.0 }).collect();
+    input[n - 1] = 0.0;
+    call_ops_reduce(
+        all::F32,
+        input.as_ptr() as *const core::ffi::c_void,
+        output.as_mut_ptr() as *mut core::ffi::c_void,
+        &metadata,
+    )
+    .unwrap();
+    assert_eq!(output, vec![0, 1]);
+}
+
 // reduce - logsum
 #[test]
 fn test_reduce_logsum_f32() {
@@ -986,3 +1205,49 @@ fn test_reduce_logsumexp_f32_large_values() {
     let expected = vec![102.0 + ((-2.0f32).exp() + (-1.0f32).exp() + 1.0).ln()];
     assert_eq!(approx(output, 4), approx(expected, 4));
 }
+
+#[test]
+fn test_reduce_odd_lengths_f32() {
+    // Rows and lane blocks that end in a partial vector; all values negative so padding the
+    // tail with anything but the identity would show up in max
+    for &n in &[1usize, 7, 77] {
+        let shape = vec![3, n];
+        let input: Vec<f32> = (0..3 * n).map(|i| -((i % 13) as f32) - 1.0).collect();
+        let strides = calculate_strides(&shape);
+        for &dim in &[0usize, 1] {
+            let output_shape = calculate_output_shape(&shape, &[dim], false);
+            let output_size: usize = output_shape.iter().product();
+            let mut metadata = vec![shape.len()];
+            metadata.extend(&shape);
+            metadata.extend(&strides);
+            metadata.push(0);
+            metadata.push(output_shape.len());
+            metadata.extend(&output_shape);
+            metadata.extend([1, dim, 0, shape[dim]]);
+
+            for (kernel, is_max) in [(sum::F32, false), (max::F32, true)] {
+                let mut output = vec![0.0f32; output_size];
+                call_ops_reduce(
+                    kernel,
+                    input.as_ptr() as *const core::ffi::c_void,
+                    output.as_mut_ptr() as *mut core::ffi::c_void,
+                    &metadata,
+                )
+                .unwrap();
+
+                let expected: Vec<f32> = (0..output_size)
+                    .map(|o| {
+                        let at = |k: usize| if dim == 1 { o * n + k } else { k * n + o };
+                        let vals = (0..shape[dim]).map(|k| input[at(k)]);
+                        if is_max {
+                            vals.fold(f32::NEG_INFINITY, f32::max)
+                        } else {
+                            vals.sum()
+                        }
+                    })
+                    .collect();
+                assert_eq!(output, expected, "n={} dim={} max={}", n, dim, is_max);
+            }
+        }
+    }
+}
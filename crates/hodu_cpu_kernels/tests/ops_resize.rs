@@ -261,6 +261,63 @@ fn test_resize_batch_channel_f32() {
     assert!((output[48] - 13.0).abs() < 1e-5); // batch 1, channel 1
 }
 
+// Test channels-last bilinear resize against the channels-first result
+#[test]
+fn test_resize_nhwc_bilinear_f32() {
+    // Input: 1x2x3x3 (NCHW) and the same values as 1x3x3x2 (NHWC)
+    let input: Vec<f32> = (0..18).map(|x| (x * x % 11) as f32).collect();
+    let mut input_nhwc = vec![0.0f32; 18];
+    for c in 0..2 {
+        for p in 0..9 {
+            input_nhwc[p * 2 + c] = input[c * 9 + p];
+        }
+    }
+
+    let mut expected = vec![0.0f32; 2 * 5 * 4];
+    let input_shape = vec![1, 2, 3, 3];
+    let metadata = build_resize_metadata(
+        &input_shape,
+        &calculate_strides(&input_shape),
+        0,
+        &[1, 2, 5, 4],
+        RESIZE_MODE_LINEAR,
+        RESIZE_COORD_HALF_PIXEL,
+        RESIZE_NEAREST_FLOOR,
+    );
+    call_ops_resize(
+        resize::F32,
+        input.as_ptr() as *const core::ffi::c_void,
+        expected.as_mut_ptr() as *mut core::ffi::c_void,
+        &metadata,
+    )
+    .unwrap();
+
+    let mut output = vec![0.0f32; 2 * 5 * 4];
+    let input_shape = vec![1, 3, 3, 2];
+    let metadata = build_resize_metadata(
+        &input_shape,
+        &calculate_strides(&input_shape),
+        0,
+        &[1, 5, 4, 2],
+        RESIZE_MODE_LINEAR,
+        RESIZE_COORD_HALF_PIXEL,
+        RESIZE_NEAREST_FLOOR,
+    );
+    call_ops_resize(
+        resize_nhwc::F32,
+        input_nhwc.as_ptr() as *const core::ffi::c_void,
+        output.as_mut_ptr() as *mut core::ffi::c_void,
+        &metadata,
+    )
+    .unwrap();
+
+    for c in 0..2 {
+        for p in 0..20 {
+            assert_eq!(output[p * 2 + c], expected[c * 20 + p]);
+        }
+    }
+}
+
 // Test identity resize (same size)
 #[test]
 fn test_resize_identity_f32() {
@@ -326,3 +383,75 @@ fn test_resize_nearest_f64() {
     ];
     assert_eq!(output, expected);
 }
+
+#[test]
+fn test_resize_bilinear_u8() {
+    // Two identical rows [0, 100] -> 4 wide with half-pixel centers
+    let input = [0u8, 100, 0, 100];
+    let input_shape = vec![1, 1, 2, 2];
+    let input_strides = calculate_strides(&input_shape);
+    let output_shape = vec![1, 1, 2, 4];
+    let mut output = vec![0u8; 8];
+
+    let metadata = build_resize_metadata(
+        &input_shape,
+        &input_strides,
+        0,
+        &output_shape,
+        RESIZE_MODE_LINEAR,
+        RESIZE_COORD_HALF_PIXEL,
+        RESIZE_NEAREST_FLOOR,
+    );
+
+    call_ops_resize(
+        resize::U8,
+        input.as_ptr() as *const core::ffi::c_void,
+        output.as_mut_ptr() as *mut core::ffi::c_void,
+        &metadata,
+    )
+    .unwrap();
+
+    assert_eq!(output, [0, 25, 75, 100, 0, 25, 75, 100]);
+}
+
+#[test]
+fn test_resize_nhwc_bicubic_u8_matches_f32() {
+    // 1x5x7x3 -> 1x9x4x3: u8 rounds the f32 result (within fixed-point error)
+    let (h, w, c) = (5usize, 7usize, 3usize);
+    let input: Vec<u8> = (0..h * w * c).map(|i| ((i * 37 + 11) % 256) as u8).collect();
+    let input_f32: Vec<f32> = input.iter().map(|&v| v as f32).collect();
+    let input_shape = vec![1, h, w, c];
+    let input_strides = calculate_strides(&input_shape);
+    let output_shape = vec![1, 9, 4, c];
+    let mut output = vec![0u8; 9 * 4 * c];
+    let mut output_f32 = vec![0.0f32; 9 * 4 * c];
+
+    let metadata = build_resize_metadata(
+        &input_shape,
+        &input_strides,
+        0,
+        &output_shape,
+        RESIZE_MODE_CUBIC,
+        RESIZE_COORD_HALF_PIXEL,
+        RESIZE_NEAREST_FLOOR,
+    );
+
+    call_ops_resize(
+        resize_nhwc::U8,
+        input.as_ptr() as *const core::ffi::c_void,
+        output.as_mut_ptr() as *mut core::ffi::c_void,
+        &metadata,
+    )
+    .unwrap();
+    call_ops_resize(
+        resize_nhwc::F32,
+        input_f32.as_ptr() as *const core::ffi::c_void,
+        output_f32.as_mut_ptr() as *mut core::ffi::c_void,
+        &metadata,
+    )
+    .unwrap();
+
+    for (&q, &f) in output.iter().zip(&output_f32) {
+        assert!((q as f32 - f.clamp(0.0, 255.0)).abs() <= 0.6, "{} vs {}", q, f);
+    }
+}
@@ -351,3 +351,71 @@ fn test_cumsum_i8() {
     // [1, 2, 3, -4, 5] -> [1, 3, 6, 2, 7]
     assert_eq!(output, vec![1, 3, 6, 2, 7]);
 }
+
+// cummax - dim 0 of a 2D tensor
+#[test]
+fn test_cummax_2d_dim0_f32() {
+    // [[1, 5], [3, 2], [2, 7]]
+    let input = [1.0f32, 5.0, 3.0, 2.0, 2.0, 7.0];
+    let shape = vec![3, 2];
+    let strides = calculate_strides(&shape);
+    let mut output = vec![0.0f32; 6];
+
+    let metadata = build_cumsum_metadata(&shape, &strides, 0, 0);
+
+    call_ops_cummax(
+        cummax::F32,
+        input.as_ptr() as *const core::ffi::c_void,
+        output.as_mut_ptr() as *mut core::ffi::c_void,
+        &metadata,
+    )
+    .unwrap();
+
+    assert_eq!(output, vec![1.0, 5.0, 3.0, 5.0, 3.0, 7.0]);
+}
+
+// cumsum - reverse exclusive
+#[test]
+fn test_cumsum_reverse_exclusive_i32() {
+    let input = [1i32, 2, 3, 4];
+    let shape = vec![4];
+    let strides = calculate_strides(&shape);
+    let mut output = vec![0i32; 4];
+
+    let metadata = build_cumsum_metadata(&shape, &strides, 0, 0);
+
+    call_ops_scan(
+        cumsum_reverse_exclusive::I32,
+        input.as_ptr() as *const core::ffi::c_void,
+        output.as_mut_ptr() as *mut core::ffi::c_void,
+        &metadata,
+    )
+    .unwrap();
+
+    assert_eq!(output, vec![9, 7, 4, 0]);
+}
+
+// cumsum - long 1D scan (chunked two-pass path)
+#[test]
+fn test_cumsum_long_1d_i64() {
+    let len = 300_000;
+    let input: Vec<i64> = (0..len as i64).collect();
+    let shape = vec![len];
+    let strides = calculate_strides(&shape);
+    let mut output = vec![0i64; len];
+
+    let metadata = build_cumsum_metadata(&shape, &strides, 0, 0);
+
+    call_ops_cumsum(
+        cumsum::I64,
+        input.as_ptr() as *const core::ffi::c_void,
+        output.as_mut_ptr() as *mut core::ffi::c_void,
+        &metadata,
+    )
+    .unwrap();
+
+    for (i, &v) in output.iter().enumerate() {
+        let i = i as i64;
+        assert_eq!(v, i * (i + 1) / 2);
+    }
+}
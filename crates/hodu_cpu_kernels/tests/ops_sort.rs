@@ -361,3 +361,88 @@ fn test_topk_i64() {
     assert_eq!(values, vec![9, 6, 5]);
     assert_eq!(indices, vec![5, 7, 4]);
 }
+
+// topk - i64 values closer together than f32 precision, long row with ties
+#[test]
+fn test_topk_i64_exact_ties() {
+    let base = 1i64 << 53;
+    let last_dim_size = 100_000;
+    let input: Vec<i64> = (0..last_dim_size).map(|i| base + (i % 7) as i64).collect();
+    let k = 4;
+    let outer_size = 1;
+    let mut values = vec![0i64; k];
+    let mut indices = vec![0i32; k];
+
+    let metadata = build_topk_metadata(k, last_dim_size, outer_size, true, true, 0);
+
+    call_topk(
+        topk::I64,
+        input.as_ptr() as *const core::ffi::c_void,
+        values.as_mut_ptr() as *mut core::ffi::c_void,
+        indices.as_mut_ptr() as *mut core::ffi::c_void,
+        &metadata,
+    )
+    .unwrap();
+
+    // Ties go to the lowest indices
+    assert_eq!(values, vec![base + 6; 4]);
+    assert_eq!(indices, vec![6, 13, 20, 27]);
+}
+
+// Helper function to build sort/argsort metadata for a contiguous tensor
+// Layout: [num_els, num_dims, shape..., strides..., offset, dim, descending]
+fn build_sort_metadata(shape: &[usize], dim: usize, descending: bool) -> Vec<usize> {
+    let mut strides = vec![1; shape.len()];
+    for d in (0..shape.len().saturating_sub(1)).rev() {
+        strides[d] = strides[d + 1] * shape[d + 1];
+    }
+    let mut metadata = vec![shape.iter().product(), shape.len()];
+    metadata.extend_from_slice(shape);
+    metadata.extend_from_slice(&strides);
+    metadata.extend_from_slice(&[0, dim, if descending { 1 } else { 0 }]);
+    metadata
+}
+
+// sort - stable, descending, NaN first
+#[test]
+fn test_sort_descending_stable_f32() {
+    let input = [1.0f32, f32::NAN, -0.0, 3.0, 0.0, 1.0, -2.0];
+    let mut values = vec![0.0f32; 7];
+    let mut indices = vec![0i32; 7];
+
+    let metadata = build_sort_metadata(&[7], 0, true);
+
+    call_sort(
+        sort::F32,
+        input.as_ptr() as *const core::ffi::c_void,
+        values.as_mut_ptr() as *mut core::ffi::c_void,
+        indices.as_mut_ptr() as *mut core::ffi::c_void,
+        &metadata,
+    )
+    .unwrap();
+
+    // Equal values (1.0, and -0.0 == 0.0) keep their input order
+    assert_eq!(indices, vec![1, 3, 0, 5, 2, 4, 6]);
+    assert!(values[0].is_nan());
+    assert_eq!(&values[1..], &[3.0, 1.0, 1.0, -0.0, 0.0, -2.0]);
+}
+
+// argsort - along dim 0 of a 2D tensor
+#[test]
+fn test_argsort_dim0_i32() {
+    // [[3, -1], [1, 5], [2, -1]]
+    let input = [3i32, -1, 1, 5, 2, -1];
+    let mut indices = vec![0i32; 6];
+
+    let metadata = build_sort_metadata(&[3, 2], 0, false);
+
+    call_argsort(
+        argsort::I32,
+        input.as_ptr() as *const core::ffi::c_void,
+        indices.as_mut_ptr() as *mut core::ffi::c_void,
+        &metadata,
+    )
+    .unwrap();
+
+    assert_eq!(indices, vec![1, 0, 2, 2, 0, 1]);
+}
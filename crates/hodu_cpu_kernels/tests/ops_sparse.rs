@@ -0,0 +1,127 @@
+use hodu_cpu_kernels::*;
+
+/// Dense [m, k] @ [k, n] reference
+fn dense_matmul(a: &[f32], b: &[f32], m: usize, k: usize, n: usize) -> Vec<f32> {
+    let mut c = vec![0.0f32; m * n];
+    for i in 0..m {
+        for p in 0..k {
+            for j in 0..n {
+                c[i * n + j] += a[i * k + p] * b[p * n + j];
+            }
+        }
+    }
+    c
+}
+
+fn to_sparse(dense: &[f32], rows: usize, cols: usize, block: (usize, usize)) -> (Vec<u32>, Vec<u32>, Vec<f32>) {
+    let metadata = [rows, cols, cols, 1, 0, block.0, block.1];
+    let dense_ptr = dense.as_ptr() as *const core::ffi::c_void;
+    let count = call_ops_sparse_count(sparse_from_dense::F32, dense_ptr, &metadata).unwrap();
+    let mut row_ptr = vec![0u32; rows / block.0 + 1];
+    let mut col_idx = vec![0u32; count];
+    let mut values = vec![0.0f32; count * block.0 * block.1];
+    call_ops_sparse_from_dense(
+        sparse_from_dense::F32,
+        dense_ptr,
+        row_ptr.as_mut_ptr(),
+        col_idx.as_mut_ptr(),
+        values.as_mut_ptr() as *mut core::ffi::c_void,
+        &metadata,
+    )
+    .unwrap();
+    (row_ptr, col_idx, values)
+}
+
+#[test]
+fn test_sparse_matmul_csr_bsr() {
+    let (m, k, n) = (8, 12, 19);
+    // ~80% zeros
+    let a: Vec<f32> = (0..m * k)
+        .map(|i| if i % 5 == 2 { (i % 7) as f32 - 3.0 } else { 0.0 })
+        .collect();
+    let b: Vec<f32> = (0..k * n).map(|i| (i % 11) as f32 * 0.25 - 1.0).collect();
+    let expected = dense_matmul(&a, &b, m, k, n);
+
+    for block in [(1, 1), (1, 4), (4, 4), (2, 3)] {
+        let (row_ptr, col_idx, values) = to_sparse(&a, m, k, block);
+        assert_eq!(row_ptr.len(), m / block.0 + 1);
+        assert_eq!(*row_ptr.last().unwrap() as usize, col_idx.len());
+        let lhs = SparseMatrix {
+            rows: m,
+            cols: k,
+            block_rows: block.0,
+            block_cols: block.1,
+            row_ptr: row_ptr.as_ptr(),
+            col_idx: col_idx.as_ptr(),
+            values: values.as_ptr() as *const core::ffi::c_void,
+        };
+        let mut output = vec![f32::NAN; m * n];
+        call_ops_sparse_matmul(
+            sparse_matmul::F32,
+            &lhs,
+            b.as_ptr() as *const core::ffi::c_void,
+            output.as_mut_ptr() as *mut core::ffi::c_void,
+            &[n, n, 1, 0],
+        )
+        .unwrap();
+        for (got, want) in output.iter().zip(&expected) {
+            assert!((got - want).abs() < 1e-4, "{:?}: {} vs {}", block, got, want);
+        }
+    }
+
+    // CSR of the 1x1 case keeps exactly the non-zeros
+    let (_, col_idx, values) = to_sparse(&a, m, k, (1, 1));
+    assert_eq!(col_idx.len(), a.iter().filter(|&&x| x != 0.0).count());
+    assert!(values.iter().all(|&x| x != 0.0));
+
+    // Blocks must tile the matrix
+    let metadata = [m, k, k, 1, 0, 3, 4];
+    assert!(call_ops_sparse_count(
+        sparse_from_dense::F32,
+        a.as_ptr() as *const core::ffi::c_void,
+        &metadata
+    )
+    .is_err());
+}
+
+#[test]
+fn test_sparse_matvec_strided_rhs() {
+    // [3, 4] CSR @ a column of a transposed [4, 2] rhs
+    let a = [1.0f32, 0.0, 2.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, -1.0, 0.0, 3.0];
+    let (row_ptr, col_idx, values) = to_sparse(&a, 3, 4, (1, 1));
+    assert_eq!(row_ptr, vec![0, 2, 2, 4]);
+    let lhs = SparseMatrix {
+        rows: 3,
+        cols: 4,
+        block_rows: 1,
+        block_cols: 1,
+        row_ptr: row_ptr.as_ptr(),
+        col_idx: col_idx.as_ptr(),
+        values: values.as_ptr() as *const core::ffi::c_void,
+    };
+    // rhs^T = [[1, 2, 3, 4], [5, 6, 7, 8]]
+    let rhs_t = [1.0f32, 2.0, 3.0, 4.0, 5.0, 6.0, 7.0, 8.0];
+    let rhs = rhs_t.as_ptr() as *const core::ffi::c_void;
+
+    let mut output = vec![0.0f32; 3];
+    call_ops_sparse_matmul(
+        sparse_matmul::F32,
+        &lhs,
+        rhs,
+        output.as_mut_ptr() as *mut core::ffi::c_void,
+        &[1, 1, 4, 4],
+    )
+    .unwrap();
+    assert_eq!(output, vec![19.0, 0.0, 18.0]);
+
+    let mut output = vec![0.0f32; 6];
+    call_ops_sparse_matmul(
+        sparse_matmul::F32,
+        &lhs,
+        rhs,
+        output.as_mut_ptr() as *mut core::ffi::c_void,
+        &[2, 1, 4, 0],
+    )
+    .unwrap();
+    assert_eq!(output, vec![7.0, 19.0, 0.0, 0.0, 10.0, 18.0]);
+}
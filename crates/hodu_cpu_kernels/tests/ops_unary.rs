@@ -445,6 +445,69 @@ fn test_erf_f32() {
     assert_eq!(approx(output, 4), expected);
 }
 
+// transcendentals - long enough to run the SIMD polynomial path, plus a scalar tail
+#[test]
+fn test_transcendental_simd_f32() {
+    let input: Vec<f32> = (0..67).map(|i| (i as f32 - 33.0) * 0.37).collect();
+    let positive: Vec<f32> = input.iter().map(|x| x.abs() + 1e-3).collect();
+    let cases: [(Kernel, &[f32], fn(f32) -> f32); 6] = [
+        (exp::F32, &input, |x| x.exp()),
+        (ln::F32, &positive, |x| x.ln()),
+        (tanh::F32, &input, |x| x.tanh()),
+        (sigmoid::F32, &input, |x| 1.0 / (1.0 + (-x).exp())),
+        (silu::F32, &input, |x| x / (1.0 + (-x).exp())),
+        (softplus::F32, &input, |x| x.max(0.0) + (-x.abs()).exp().ln_1p()),
+    ];
+    for (kernel, input, reference) in cases {
+        let output = run_unary(input, kernel);
+        for (x, y) in input.iter().zip(output) {
+            let expected = reference(*x);
+            assert!(
+                (y - expected).abs() <= 1e-6 * expected.abs().max(1.0),
+                "{:?}({}) = {}",
+                kernel,
+                x,
+                y
+            );
+        }
+    }
+}
+
+// strided views - sliced rows (unit-stride inner runs) and a transpose
+#[test]
+fn test_unary_strided_views_f32() {
+    let (rows, cols, pitch) = (5usize, 37usize, 41usize);
+    let base: Vec<f32> = (0..rows * pitch).map(|i| (i as f32 - 100.0) * 0.05).collect();
+    let layouts = [
+        (vec![rows, cols], vec![pitch, 1], 3usize),
+        (vec![cols, rows], vec![1, pitch], 0usize),
+    ];
+    for (shape, strides, offset) in layouts {
+        let num_els: usize = shape.iter().product();
+        let mut metadata = vec![num_els, shape.len()];
+        metadata.extend(&shape);
+        metadata.extend(&strides);
+        metadata.push(offset);
+        for (kernel, reference) in [(exp::F32, f32::exp as fn(f32) -> f32), (neg::F32, |x: f32| -x)] {
+            let mut output = vec![0.0f32; num_els];
+            call_ops_unary(
+                kernel,
+                base.as_ptr() as *const core::ffi::c_void,
+                output.as_mut_ptr() as *mut core::ffi::c_void,
+                &metadata,
+            )
+            .unwrap();
+            for i in 0..shape[0] {
+                for j in 0..shape[1] {
+                    let expected = reference(base[offset + i * strides[0] + j * strides[1]]);
+                    let y = output[i * shape[1] + j];
+                    assert!((y - expected).abs() <= 1e-6 * expected.abs().max(1.0), "{:?}", kernel);
+                }
+            }
+        }
+    }
+}
+
 // unary logical
 #[test]
 fn test_logical_not_f32() {
@@ -576,3 +639,35 @@ fn test_ge_scalar_f32() {
     let output = run_unary_scalar_to_bool(&input, ge_scalar::F32, 3.0);
     assert_eq!(output, vec![0, 0, 1, 1]);
 }
+
+#[test]
+fn test_unary_in_place_f32() {
+    let mut data = vec![-1.0f32, 2.0, -3.0, 4.0, -5.0, 6.0];
+    let ptr = data.as_mut_ptr() as *mut core::ffi::c_void;
+
+    // Exactly in place
+    call_ops_unary(relu::F32, ptr, ptr, &[6, 1, 6, 1, 0]).unwrap();
+    assert_eq!(data, vec![0.0, 2.0, 0.0, 4.0, 0.0, 6.0]);
+
+    // The 2x3 buffer read as its 3x2 transpose and written back over itself
+    call_ops_unary(neg::F32, ptr, ptr, &[6, 2, 3, 2, 1, 3, 0]).unwrap();
+    assert_eq!(data, vec![-0.0, -4.0, -2.0, -0.0, -0.0, -6.0]);
+}
+
+#[test]
+fn test_unary_odd_length_tail_f32() {
+    // 77 elements: whole vectors plus a masked partial one for every SIMD width
+    let input: Vec<f32> = (0..77).map(|i| i as f32 - 38.0).collect();
+    assert_eq!(
+        run_unary(&input, relu::F32),
+        input.iter().map(|&x| x.max(0.0)).collect::<Vec<_>>()
+    );
+    assert_eq!(
+        run_unary(&input, abs::F32),
+        input.iter().map(|x| x.abs()).collect::<Vec<_>>()
+    );
+
+    let squares: Vec<f32> = (0..77).map(|i| (i * i) as f32).collect();
+    let roots = run_unary(&squares, sqrt::F32);
+    assert_eq!(roots, (0..77).map(|i| i as f32).collect::<Vec<_>>());
+}
@@ -332,3 +332,126 @@ fn test_reduce_window_sum_with_padding() {
 
     assert_eq!(result, vec![1.0, 3.0, 5.0, 7.0, 4.0, 0.0]);
 }
+
+#[test]
+fn test_reduce_window_max_2d_nhwc() {
+    // 1x4x4x2 channels-last input: channel 0 counts up, channel 1 counts down
+    let input: Vec<f32> = (0..16).flat_map(|i| [i as f32, -(i as f32)]).collect();
+    let input_shape = vec![1, 4, 4, 2];
+    let window_shape = vec![1, 2, 2, 1];
+    let strides = vec![1, 2, 2, 1];
+    let padding = vec![0; 8];
+    let output_shape = vec![1, 2, 2, 2];
+
+    let result = run_reduce_window_f32(
+        &input,
+        &input_shape,
+        &window_shape,
+        &strides,
+        &padding,
+        &output_shape,
+        reduce_window_max::F32,
+    );
+
+    // 2x2 pooling per channel, output still channels-last
+    assert_eq!(result, vec![5.0, 0.0, 7.0, -2.0, 13.0, -8.0, 15.0, -10.0]);
+}
+
+// Brute-force reference for a 2D [rows, cols] window reduction with padding
+#[allow(clippy::too_many_arguments)]
+fn reference_window_2d(
+    input: &[f32],
+    shape: [usize; 2],
+    window: [usize; 2],
+    stride: [usize; 2],
+    pad: [usize; 2],
+    out_shape: [usize; 2],
+    init: f32,
+    f: impl Fn(f32, f32) -> f32,
+) -> Vec<f32> {
+    let mut out = Vec::new();
+    for oy in 0..out_shape[0] {
+        for ox in 0..out_shape[1] {
+            let mut acc = init;
+            for wy in 0..window[0] {
+                for wx in 0..window[1] {
+                    let y = (oy * stride[0] + wy) as isize - pad[0] as isize;
+                    let x = (ox * stride[1] + wx) as isize - pad[1] as isize;
+                    if y >= 0 && x >= 0 && (y as usize) < shape[0] && (x as usize) < shape[1] {
+                        acc = f(acc, input[y as usize * shape[1] + x as usize]);
+                    }
+                }
+            }
+            out.push(acc);
+        }
+    }
+    out
+}
+
+#[test]
+fn test_reduce_window_large_window_max_mean() {
+    // 21x21 windows with stride 1 take the van Herk (max) and running-sum (mean) paths
+    let shape = [40, 45];
+    let input: Vec<f32> = (0..shape[0] * shape[1])
+        .map(|i| ((i * 37) % 101) as f32 - 50.0)
+        .collect();
+    let (window, stride, pad) = ([21, 21], [1, 1], [10, 10]);
+    let out_shape = [40, 45];
+
+    let max = run_reduce_window_f32(
+        &input,
+        &shape,
+        &window,
+        &stride,
+        &[10, 10, 10, 10],
+        &out_shape,
+        reduce_window_max::F32,
+    );
+    let expected = reference_window_2d(
+        &input,
+        shape,
+        window,
+        stride,
+        pad,
+        out_shape,
+        f32::NEG_INFINITY,
+        f32::max,
+    );
+    assert_eq!(max, expected);
+
+    let mean = run_reduce_window_f32(
+        &input,
+        &shape,
+        &window,
+        &stride,
+        &[10, 10, 10, 10],
+        &out_shape,
+        reduce_window_mean::F32,
+    );
+    let sums = reference_window_2d(&input, shape, window, stride, pad, out_shape, 0.0, |a, b| a + b);
+    for (m, s) in mean.iter().zip(sums.iter()) {
+        assert!((m - s / 441.0).abs() < 1e-4, "{} vs {}", m, s / 441.0);
+    }
+}
+
+#[test]
+fn test_reduce_window_global_mean_nhwc() {
+    // Global average pooling of a 2x5x6x3 channels-last tensor
+    let input: Vec<f32> = (0..2 * 5 * 6 * 3).map(|i| (i % 17) as f32).collect();
+    let result = run_reduce_window_f32(
+        &input,
+        &[2, 5, 6, 3],
+        &[1, 5, 6, 1],
+        &[1, 1, 1, 1],
+        &[0; 8],
+        &[2, 1, 1, 3],
+        reduce_window_mean::F32,
+    );
+
+    for n in 0..2 {
+        for c in 0..3 {
+            let sum: f32 = (0..30).map(|p| input[n * 90 + p * 3 + c]).sum();
+            assert!((result[n * 3 + c] - sum / 30.0).abs() < 1e-5);
+        }
+    }
+}
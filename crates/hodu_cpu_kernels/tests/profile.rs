@@ -0,0 +1,56 @@
+use hodu_cpu_kernels::*;
+
+fn run_add(lhs: &[f32], rhs: &[f32]) -> Vec<f32> {
+    let mut output = vec![0.0f32; lhs.len()];
+    let n = lhs.len();
+    let metadata = vec![n, 1, n, n, 1, 1, 0, 0];
+
+    call_ops_binary(
+        add::F32,
+        lhs.as_ptr() as *const core::ffi::c_void,
+        rhs.as_ptr() as *const core::ffi::c_void,
+        output.as_mut_ptr() as *mut core::ffi::c_void,
+        &metadata,
+    )
+    .unwrap();
+    output
+}
+
+// Counters are process-wide, so all checks live in a single test
+#[test]
+fn test_profile_counters_and_trace() {
+    let n = 4096;
+    let lhs: Vec<f32> = (0..n).map(|i| i as f32).collect();
+    let rhs = vec![1.0f32; n];
+    let trace = std::env::temp_dir().join(format!("hodu_profile_{}.json", std::process::id()));
+    let trace = trace.to_str().unwrap();
+
+    reset_profile();
+    if !profile_enabled() {
+        run_add(&lhs, &rhs);
+        assert!(profile_snapshot().is_empty());
+        assert!(start_trace(trace).is_err());
+        return;
+    }
+
+    start_trace(trace).unwrap();
+    for _ in 0..3 {
+        run_add(&lhs, &rhs);
+    }
+    stop_trace();
+
+    let snapshot = profile_snapshot();
+    let add = snapshot.iter().find(|k| k.name == "hodu_cpu_add_f32").unwrap();
+    assert_eq!(add.calls, 3);
+    assert_eq!(add.bytes, 3 * 3 * (n * 4) as u64);
+    assert!(add.max_ns <= add.total_ns);
+    assert_eq!(add.scalar_calls + add.simd_calls + add.blas_calls, 3);
+
+    let json = std::fs::read_to_string(trace).unwrap();
+    std::fs::remove_file(trace).unwrap();
+    assert!(json.starts_with("{\"traceEvents\":["));
+    assert_eq!(json.matches("\"name\":\"hodu_cpu_add_f32\"").count(), 3);
+
+    reset_profile();
+    assert!(profile_snapshot().iter().all(|k| k.name != "hodu_cpu_add_f32"));
+}
@@ -0,0 +1,72 @@
+use hodu_cpu_kernels::*;
+use std::sync::atomic::{AtomicUsize, Ordering};
+use std::sync::{Arc, Mutex};
+
+// Executors are started once per process, so all checks live in a single test
+#[test]
+fn test_task_queue_dependencies_and_kernels() {
+    set_num_threads(4);
+
+    // Diamond: a -> (b, c) -> d, with d also naming a twice
+    let log = Arc::new(Mutex::new(Vec::new()));
+    let record = |name: &'static str| {
+        let log = log.clone();
+        move || log.lock().unwrap().push(name)
+    };
+    let a = submit(&[], record("a")).unwrap();
+    let b = submit(&[&a], record("b")).unwrap();
+    let c = submit(&[&a], record("c")).unwrap();
+    let d = submit(&[&b, &a, &c, &a], record("d")).unwrap();
+    d.wait();
+    assert!(a.is_done() && b.is_done() && c.is_done() && d.is_done());
+    let order = log.lock().unwrap().clone();
+    assert_eq!(order.len(), 4);
+    assert_eq!(order[0], "a");
+    assert_eq!(order[3], "d");
+
+    // Independent kernel calls on borrowed buffers
+    let n = 1 << 18;
+    let lhs: Vec<f32> = (0..n).map(|i| (i % 1000) as f32).collect();
+    let rhs: Vec<f32> = (0..n).map(|i| (i % 7) as f32).collect();
+    let metadata = vec![n, 1, n, n, 1, 1, 0, 0];
+    let mut sum = vec![0.0f32; n];
+    let mut product = vec![0.0f32; n];
+    let (lhs_ptr, rhs_ptr) = (lhs.as_ptr() as usize, rhs.as_ptr() as usize);
+    let (sum_ptr, product_ptr) = (sum.as_mut_ptr() as usize, product.as_mut_ptr() as usize);
+    let metadata_ref = &metadata;
+    let tasks: Vec<Task> = [(add::F32, sum_ptr), (mul::F32, product_ptr)]
+        .into_iter()
+        .map(|(kernel, out)| unsafe {
+            submit_unchecked(&[], move || {
+                call_ops_binary(
+                    kernel,
+                    lhs_ptr as *const core::ffi::c_void,
+                    rhs_ptr as *const core::ffi::c_void,
+                    out as *mut core::ffi::c_void,
+                    metadata_ref,
+                )
+                .unwrap()
+            })
+            .unwrap()
+        })
+        .collect();
+    tasks.iter().for_each(Task::wait);
+    assert!((0..n).all(|i| sum[i] == lhs[i] + rhs[i] && product[i] == lhs[i] * rhs[i]));
+
+    // Panics are kept for wait(); dependents still run
+    let ran = Arc::new(AtomicUsize::new(0));
+    let failing = submit(&[], || panic!("task failed")).unwrap();
+    let counter = ran.clone();
+    let after = submit(&[&failing], move || {
+        counter.fetch_add(1, Ordering::SeqCst);
+    })
+    .unwrap();
+    wait_all();
+    assert!(after.is_done());
+    assert_eq!(ran.load(Ordering::SeqCst), 1);
+    let result = std::panic::catch_unwind(std::panic::AssertUnwindSafe(|| failing.wait()));
+    assert!(result.is_err());
+    failing.wait();
+
+    set_num_threads(0);
+}
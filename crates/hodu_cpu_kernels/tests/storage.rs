@@ -0,0 +1,20 @@
+use hodu_cpu_kernels::*;
+
+#[test]
+fn test_storage_buffer_zeroed_and_const_set() {
+    set_num_threads(4);
+
+    let n = (1 << 20) + 3;
+    let mut buffer = StorageBuffer::zeroed(n * 4).unwrap();
+    assert_eq!(buffer.len(), n * 4);
+    assert_eq!(buffer.as_ptr() as usize % 4096, 0);
+    assert!(buffer.as_bytes().iter().all(|&b| b == 0));
+
+    let metadata = vec![n, 1, n, 1, 0];
+    call_ops_const_set(const_set::F32, buffer.as_mut_ptr(), &metadata, 1.5f32).unwrap();
+    let values = unsafe { core::slice::from_raw_parts(buffer.as_ptr() as *const f32, n) };
+    assert!(values.iter().all(|&v| v == 1.5));
+
+    assert!(StorageBuffer::zeroed(0).is_err());
+    set_num_threads(0);
+}
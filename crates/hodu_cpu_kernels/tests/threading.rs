@@ -0,0 +1,146 @@
+use hodu_cpu_kernels::*;
+
+fn run_add(lhs: &[f32], rhs: &[f32]) -> Vec<f32> {
+    let mut output = vec![0.0f32; lhs.len()];
+    let n = lhs.len();
+    let metadata = vec![n, 1, n, n, 1, 1, 0, 0];
+
+    call_ops_binary(
+        add::F32,
+        lhs.as_ptr() as *const core::ffi::c_void,
+        rhs.as_ptr() as *const core::ffi::c_void,
+        output.as_mut_ptr() as *mut core::ffi::c_void,
+        &metadata,
+    )
+    .unwrap();
+    output
+}
+
+fn run_reduce(kernel: Kernel, input: &[f32]) -> Vec<f32> {
+    // Two long rows: few outputs, so the reduced elements are split across threads
+    let n = input.len() / 2;
+    let metadata = vec![2, 2, n, n, 1, 0, 1, 2, 1, 1, 0, n];
+    let mut output = vec![0.0f32; 2];
+    call_ops_reduce(
+        kernel,
+        input.as_ptr() as *const core::ffi::c_void,
+        output.as_mut_ptr() as *mut core::ffi::c_void,
+        &metadata,
+    )
+    .unwrap();
+    output
+}
+
+fn run_conv2d_grad_weight(input: &[f32], grad_output: &[f32]) -> Vec<f32> {
+    // 16 samples, 8 -> 8 channels, 16x16 input, 3x3 kernel (14x14 output)
+    let (b, c, o, h, k, oh) = (16, 8, 8, 16, 3, 14);
+    let metadata = vec![
+        o * c * k * k,
+        4,
+        2,
+        b,
+        c,
+        h,
+        h,
+        b,
+        o,
+        oh,
+        oh,
+        o,
+        c,
+        k,
+        k,
+        c * h * h,
+        h * h,
+        h,
+        1,
+        o * oh * oh,
+        oh * oh,
+        oh,
+        1,
+        0,
+        0,
+        1,
+        1,
+        0,
+        0,
+        1,
+        1,
+    ];
+    let mut grad_weight = vec![0.0f32; o * c * k * k];
+    call_ops_conv_grad_weight(
+        conv2d_grad_weight::F32,
+        input.as_ptr() as *const core::ffi::c_void,
+        grad_output.as_ptr() as *const core::ffi::c_void,
+        grad_weight.as_mut_ptr() as *mut core::ffi::c_void,
+        &metadata,
+    )
+    .unwrap();
+    grad_weight
+}
+
+// Thread settings are process-wide, so all checks live in a single test
+#[test]
+fn test_thread_configuration() {
+    let default_threads = num_threads();
+    assert!(default_threads >= 1);
+
+    let n = 1 << 20;
+    let lhs: Vec<f32> = (0..n).map(|i| (i % 1000) as f32).collect();
+    let rhs: Vec<f32> = (0..n).map(|i| (i % 7) as f32).collect();
+    let expected: Vec<f32> = lhs.iter().zip(&rhs).map(|(a, b)| a + b).collect();
+
+    // Builds with HODU_DISABLE_THREADS always report a single thread
+    set_num_threads(2);
+    let threaded = num_threads() == 2;
+
+    for threads in [1, 2, 3, 8] {
+        set_num_threads(threads);
+        if threaded {
+            assert_eq!(num_threads(), threads);
+        }
+        assert_eq!(run_add(&lhs, &rhs), expected);
+    }
+
+    // Deterministic mode: bit-identical reductions for any thread count
+    let values: Vec<f32> = (0..n).map(|i| ((i * 7919) % 10007) as f32 * 1e-3 + 1e3).collect();
+    set_deterministic(true);
+    assert!(deterministic());
+    for kernel in [sum::F32, norm::F32, var::F32, logsumexp::F32] {
+        set_num_threads(1);
+        let expected = run_reduce(kernel, &values);
+        for threads in [2, 3, 8] {
+            set_num_threads(threads);
+            let output = run_reduce(kernel, &values);
+            assert!(output.iter().zip(&expected).all(|(a, b)| a.to_bits() == b.to_bits()));
+        }
+    }
+
+    let input: Vec<f32> = (0..16 * 8 * 16 * 16)
+        .map(|i| ((i * 7919) % 997) as f32 / 997.0 - 0.5)
+        .collect();
+    let grad_output: Vec<f32> = (0..16 * 8 * 14 * 14)
+        .map(|i| ((i * 104729) % 991) as f32 / 991.0 - 0.5)
+        .collect();
+    set_num_threads(1);
+    let expected = run_conv2d_grad_weight(&input, &grad_output);
+    for threads in [2, 3, 5, 8] {
+        set_num_threads(threads);
+        let output = run_conv2d_grad_weight(&input, &grad_output);
+        assert!(output.iter().zip(&expected).all(|(a, b)| a.to_bits() == b.to_bits()));
+    }
+    set_deterministic(false);
+    assert!(!deterministic());
+
+    set_num_threads(0);
+    assert_eq!(num_threads(), default_threads);
+
+    #[cfg(any(target_os = "linux", target_os = "windows"))]
+    if threaded {
+        set_affinity(&[0]).unwrap();
+        assert_eq!(num_threads(), 1);
+        assert_eq!(run_add(&lhs, &rhs), expected);
+        set_affinity(&[]).unwrap();
+        assert_eq!(num_threads(), default_threads);
+    }
+}
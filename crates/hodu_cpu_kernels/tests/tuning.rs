@@ -0,0 +1,57 @@
+use hodu_cpu_kernels::*;
+
+fn run_add(lhs: &[f32], rhs: &[f32]) -> Vec<f32> {
+    let mut output = vec![0.0f32; lhs.len()];
+    let n = lhs.len();
+    let metadata = vec![n, 1, n, n, 1, 1, 0, 0];
+
+    call_ops_binary(
+        add::F32,
+        lhs.as_ptr() as *const core::ffi::c_void,
+        rhs.as_ptr() as *const core::ffi::c_void,
+        output.as_mut_ptr() as *mut core::ffi::c_void,
+        &metadata,
+    )
+    .unwrap();
+    output
+}
+
+// Parameters are process-wide, so all checks live in a single test
+#[test]
+fn test_tuning_round_trip_and_task_sizes() {
+    let initial = tuning();
+    assert!(initial.task_ns >= 2000.0 && initial.task_ns <= 500000.0);
+    assert!(initial.copy_ns_per_byte > 0.0 && initial.fma_ns > 0.0);
+
+    // Tiny tasks and expensive elements: kernels split into many tasks
+    set_tuning(&Tuning {
+        task_ns: 1.0,
+        copy_ns_per_byte: 0.0,
+        elementwise_ns: 100.0,
+        transcendental_ns: 0.0,
+        fma_ns: 0.0,
+    });
+    let current = tuning();
+    assert_eq!(current.task_ns, 2000.0);
+    assert_eq!(current.elementwise_ns, 100.0);
+    assert_eq!(current.copy_ns_per_byte, initial.copy_ns_per_byte);
+
+    let n = 50_000;
+    let lhs: Vec<f32> = (0..n).map(|i| i as f32).collect();
+    let rhs = vec![0.5f32; n];
+    set_num_threads(4);
+    let output = run_add(&lhs, &rhs);
+    set_num_threads(0);
+    assert!(output.iter().enumerate().all(|(i, &v)| v == i as f32 + 0.5));
+
+    let path = std::env::temp_dir().join(format!("hodu_tuning_{}.txt", std::process::id()));
+    let path = path.to_str().unwrap();
+    save_tuning(path).unwrap();
+    set_tuning(&initial);
+    load_tuning(path).unwrap();
+    std::fs::remove_file(path).unwrap();
+    assert_eq!(tuning(), current);
+    assert!(load_tuning(path).is_err());
+
+    set_tuning(&initial);
+}
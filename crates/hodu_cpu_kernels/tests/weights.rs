@@ -0,0 +1,94 @@
+use hodu_cpu_kernels::*;
+
+fn temp_path(name: &str) -> String {
+    let path = std::env::temp_dir().join(format!("hodu_{}_{}.hpw", name, std::process::id()));
+    path.to_str().unwrap().to_string()
+}
+
+#[test]
+fn test_packed_weights_round_trip() {
+    let path = temp_path("weights");
+
+    // rhs [3, 2] = [[7, 8], [9, 10], [11, 12]], stored transposed
+    let rhs_t = [7.0f32, 9.0, 11.0, 8.0, 10.0, 12.0];
+    // Two 2x2 conv filters: diagonal and box
+    let weight = [1.0f32, 0.0, 0.0, 1.0, 1.0, 1.0, 1.0, 1.0];
+    let conv_metadata = vec![8, 1, 1, 2, 3, 3, 2, 2, 2, 2, 1, 1, 0, 0, 1, 1, 0, 0];
+
+    let mut writer = PackedWeightsWriter::create(&path).unwrap();
+    writer
+        .add_matmul_rhs(
+            matmul_packed::F32,
+            "fc",
+            rhs_t.as_ptr() as *const core::ffi::c_void,
+            &[3, 2, 1, 3, 0],
+        )
+        .unwrap();
+    writer
+        .add_conv2d(
+            conv2d_packed::F32,
+            "conv",
+            weight.as_ptr() as *const core::ffi::c_void,
+            &conv_metadata,
+        )
+        .unwrap();
+    assert!(writer
+        .add_matmul_rhs(
+            matmul_packed::F32,
+            "fc",
+            rhs_t.as_ptr() as *const core::ffi::c_void,
+            &[3, 2, 1, 3, 0]
+        )
+        .is_err());
+    writer.finish().unwrap();
+
+    let weights = PackedWeights::open(&path).unwrap();
+    assert_eq!(weights.len(), 2);
+    assert!(weights.get("missing").is_none());
+
+    let fc = weights.get("fc").unwrap();
+    assert_eq!(fc.kind, WeightKind::MatmulRhsF32);
+    assert_eq!(fc.dims, [3, 2, 0, 0]);
+    assert_eq!(fc.as_ptr() as usize % 4096, 0);
+
+    // lhs [2, 3] @ mapped rhs
+    let lhs = [1.0f32, 2.0, 3.0, 4.0, 5.0, 6.0];
+    let (m, k, n) = (2, 3, 2);
+    let mut metadata = vec![m * n, 2, 2, 0];
+    metadata.extend([m, k, k, n, k, 1, n, 1, 0, 0, m, k, n]);
+    let mut output = vec![0.0f32; m * n];
+    call_ops_matmul_packed(
+        matmul_packed::F32,
+        lhs.as_ptr() as *const core::ffi::c_void,
+        fc.as_ptr(),
+        output.as_mut_ptr() as *mut core::ffi::c_void,
+        &metadata,
+        None,
+    )
+    .unwrap();
+    assert_eq!(output, vec![58.0, 64.0, 139.0, 154.0]);
+
+    let conv = weights.get("conv").unwrap();
+    assert_eq!(conv.kind, WeightKind::Conv2dF32);
+    assert_eq!(conv.dims, [2, 1, 2, 2]);
+    let input = [1.0f32, 2.0, 3.0, 4.0, 5.0, 6.0, 7.0, 8.0, 9.0];
+    let mut output = vec![0.0f32; 8];
+    call_ops_conv2d_packed(
+        conv2d_packed::F32,
+        input.as_ptr() as *const core::ffi::c_void,
+        conv.as_ptr(),
+        output.as_mut_ptr() as *mut core::ffi::c_void,
+        &conv_metadata,
+        None,
+    )
+    .unwrap();
+    assert_eq!(output, vec![6.0, 8.0, 12.0, 14.0, 12.0, 16.0, 24.0, 28.0]);
+    drop(weights);
+
+    // Truncated files are rejected
+    let bytes = std::fs::read(&path).unwrap();
+    std::fs::write(&path, &bytes[..bytes.len() - 1]).unwrap();
+    assert!(PackedWeights::open(&path).is_err());
+    std::fs::remove_file(&path).unwrap();
+    assert!(PackedWeights::open(&path).is_err());
+}